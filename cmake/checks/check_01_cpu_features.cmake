@@ -28,6 +28,7 @@
 #   DEAL_II_HAVE_AVX                     *)
 #   DEAL_II_HAVE_AVX512                  *)
 #   DEAL_II_HAVE_ALTIVEC                 *)
+#   DEAL_II_HAVE_NEON                    *)
 #   DEAL_II_HAVE_OPENMP_SIMD             *)
 #   DEAL_II_COMPILER_VECTORIZATION_LEVEL
 #   DEAL_II_OPENMP_SIMD_PRAGMA
@@ -74,6 +75,7 @@ IF(DEAL_II_ALLOW_PLATFORM_INTROSPECTION)
   #
   UNSET_IF_CHANGED(CHECK_CPU_FEATURES_FLAGS_SAVED "${CMAKE_REQUIRED_FLAGS}"
     DEAL_II_HAVE_SSE2 DEAL_II_HAVE_AVX DEAL_II_HAVE_AVX512 DEAL_II_HAVE_ALTIVEC
+    DEAL_II_HAVE_NEON
     )
 
   CHECK_CXX_SOURCE_RUNS(
@@ -246,6 +248,45 @@ IF(DEAL_II_ALLOW_PLATFORM_INTROSPECTION)
     "
     DEAL_II_HAVE_ALTIVEC)
 
+  CHECK_CXX_SOURCE_RUNS(
+    "
+    #if !defined(__ARM_NEON) || !defined(__aarch64__)
+    #error \"__ARM_NEON flag not set, no support for AArch64 NEON\"
+    #endif
+    #include <arm_neon.h>
+    int main()
+    {
+    float64x2_t a, b, data1, data2;
+    const int n_vectors = sizeof(a)/sizeof(double);
+    double * ptr = reinterpret_cast<double*>(&a);
+    ptr[0] = static_cast<volatile double>(1.0);
+    for (int i=1; i<n_vectors; ++i)
+      ptr[i] = 0.0;
+    b = vdupq_n_f64 (static_cast<volatile double>(2.25));
+    data1 = vaddq_f64 (a, b);
+    data2 = vmulq_f64 (b, data1);
+    ptr = reinterpret_cast<double*>(&data2);
+    int return_value = 0;
+    if (ptr[0] != 7.3125)
+      return_value += 1;
+    for (int i=1; i<n_vectors; ++i)
+      if (ptr[i] != 5.0625)
+        return_value += 2;
+    b = vdupq_n_f64 (static_cast<volatile double>(-1.0));
+    data1 = vabsq_f64(vmulq_f64 (b, data2));
+    vst1q_f64(ptr, data1);
+    b = vld1q_f64(ptr);
+    ptr = reinterpret_cast<double*>(&b);
+    if (ptr[0] != 7.3125)
+      return_value += 4;
+    for (int i=1; i<n_vectors; ++i)
+      if (ptr[i] != 5.0625)
+        return_value += 8;
+    return return_value;
+    }
+    "
+    DEAL_II_HAVE_NEON)
+
   #
   # OpenMP 4.0 can be used for vectorization. Only the vectorization
   # instructions are allowed, the threading must be done through TBB.
@@ -286,7 +327,7 @@ ELSE()
   SET(DEAL_II_COMPILER_VECTORIZATION_LEVEL 0)
 ENDIF()
 
-IF(DEAL_II_HAVE_ALTIVEC)
+IF(DEAL_II_HAVE_ALTIVEC OR DEAL_II_HAVE_NEON)
   SET(DEAL_II_COMPILER_VECTORIZATION_LEVEL 1)
 ENDIF()
 
@@ -52,6 +52,10 @@
 #     DEAL_II_WITH_COMPLEX_VALUES
 #     DEAL_II_DOXYGEN_USE_MATHJAX
 #     DEAL_II_COMPILE_EXAMPLES
+#     DEAL_II_MATRIX_FREE_MAX_DEGREE
+#     DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE
+#     DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS
+#     DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR
 #     DEAL_II_CPACK_BUNDLE_NAME
 #     DEAL_II_CPACK_EXTERNAL_LIBS
 #
@@ -396,6 +400,27 @@ OPTION(DEAL_II_DOXYGEN_USE_ONLINE_MATHJAX
   )
 MARK_AS_ADVANCED(DEAL_II_DOXYGEN_USE_ONLINE_MATHJAX)
 
+SET(DEAL_II_MATRIX_FREE_MAX_DEGREE "9" CACHE STRING
+  "The maximal polynomial degree for which FEEvaluation with fe_degree=-1 selects the optimized evaluation kernels at run time. The kernels for all degrees up to this value are compiled into the library, so larger values increase the compile time and the size of the library. Higher degrees use a slower fallback."
+  )
+MARK_AS_ADVANCED(DEAL_II_MATRIX_FREE_MAX_DEGREE)
+
+SET(DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE "0" CACHE STRING
+  "The maximal polynomial degree (at most 9) for which the evaluation kernels of FEEvaluation and FEFaceEvaluation with a fixed degree fe_degree and n_q_points_1d=fe_degree+1 are compiled into the library for VectorizedArray<double> and VectorizedArray<float>. User code then links to these kernels instead of instantiating them in every translation unit, which reduces its compile time and object size. Larger values increase the compile time and the size of the library. The default 0 does not precompile any kernels for fixed degrees."
+  )
+MARK_AS_ADVANCED(DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE)
+
+SET(DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS "1" CACHE STRING
+  "The maximal number of components (between 1 and 3) for which the kernels selected by DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE are compiled into the library."
+  )
+MARK_AS_ADVANCED(DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS)
+
+OPTION(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR
+  "If set to ON, the release version of the library only counts the subscriptions to a Subscriptor object in an atomic counter. The names of the subscribers and the validity flags of the SmartPointer objects are then not recorded, which avoids a global mutex and memory allocations whenever a SmartPointer is created or destroyed. SmartPointer objects are consequently not invalidated when the object they point to is moved from or destroyed. The debug version of the library always records the subscribers."
+  OFF
+  )
+MARK_AS_ADVANCED(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR)
+
 SET(DEAL_II_CPACK_EXTERNAL_LIBS "opt" CACHE STRING
     "A relative path to tree of external libraries that will be installed in bundle package. The path is relative to the /Applications/${DEAL_II_CPACK_BUNDLE_NAME}.app/Contents/Resources directory. It defaults to opt, but you may want to use a different value, for example if you want to distribute a brew based package."
   )
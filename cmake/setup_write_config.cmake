@@ -157,6 +157,10 @@ IF(CMAKE_BUILD_TYPE MATCHES "Debug")
   _detailed("#        DEAL_II_LIBRARIES_DEBUG:      ${BASE_LIBRARIES_DEBUG}\n")
 ENDIF()
 _detailed("#        DEAL_II_COMPILER_VECTORIZATION_LEVEL: ${DEAL_II_COMPILER_VECTORIZATION_LEVEL}\n")
+_detailed("#        DEAL_II_MATRIX_FREE_MAX_DEGREE: ${DEAL_II_MATRIX_FREE_MAX_DEGREE}\n")
+_detailed("#        DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE: ${DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE}\n")
+_detailed("#        DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS: ${DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS}\n")
+_detailed("#        DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR: ${DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR}\n")
 
 _detailed("#\n")
 
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_buffer_helpers_h
+#define dealii_buffer_helpers_h
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/exceptions.h>
+
+#include <boost/python.hpp>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace python
+{
+  namespace internal
+  {
+    /**
+     * The format character of the Python buffer protocol that describes the
+     * type @p Number, see the documentation of the struct module of Python.
+     */
+    template <typename Number>
+    struct BufferFormat;
+
+    template <>
+    struct BufferFormat<double>
+    {
+      static const char *value()
+      {
+        return "d";
+      }
+    };
+
+    template <>
+    struct BufferFormat<float>
+    {
+      static const char *value()
+      {
+        return "f";
+      }
+    };
+
+    template <>
+    struct BufferFormat<unsigned int>
+    {
+      static const char *value()
+      {
+        return "I";
+      }
+    };
+
+
+
+    /**
+     * Give the one-dimensional memoryview @p memory of bytes the type
+     * @p Number and the shape (@p n_rows, @p n_columns). If @p n_columns is
+     * one or there are no rows, the result is a one-dimensional array,
+     * because Python does not allow zero entries in the shape.
+     */
+    template <typename Number>
+    boost::python::object cast_memoryview(const boost::python::object &memory,
+                                          const std::size_t            n_rows,
+                                          const std::size_t            n_columns)
+    {
+      if ((n_columns == 1) || (n_rows == 0))
+        return memory.attr("cast")(BufferFormat<Number>::value());
+      else
+        return memory.attr("cast")(BufferFormat<Number>::value(),
+                                   boost::python::make_tuple(n_rows, n_columns));
+    }
+
+
+
+    /**
+     * Return a memoryview of shape (@p n_rows, @p n_columns) of the array
+     * @p data, stored row by row, without copying the data. numpy.asarray()
+     * turns the memoryview into a NumPy array that shares the memory. The
+     * memoryview does not keep the owner of @p data alive, i.e., it may only
+     * be used as long as @p data is valid. If @p writable is false, the
+     * memoryview is read-only.
+     */
+    template <typename Number>
+    boost::python::object make_memoryview(const Number     *data,
+                                          const std::size_t n_rows,
+                                          const std::size_t n_columns,
+                                          const bool        writable)
+    {
+#if PY_MAJOR_VERSION >= 3
+      PyObject *memory =
+        PyMemoryView_FromMemory(const_cast<char *>(
+                                  reinterpret_cast<const char *>(data)),
+                                n_rows * n_columns * sizeof(Number),
+                                writable ? PyBUF_WRITE : PyBUF_READ);
+      boost::python::object view((boost::python::handle<>(memory)));
+
+      return cast_memoryview<Number>(view, n_rows, n_columns);
+#else
+      (void)data;
+      (void)n_rows;
+      (void)n_columns;
+      (void)writable;
+      AssertThrow(false, ExcMessage("Memoryviews require Python 3."));
+      return boost::python::object();
+#endif
+    }
+
+
+
+    /**
+     * Create a writable memoryview of shape (@p n_rows, @p n_columns) that
+     * owns its memory, and set @p data to the beginning of this memory. This
+     * function is used to return data that is not stored contiguously in
+     * deal.II as a single object, which is filled in C++ and not copied
+     * again.
+     */
+    template <typename Number>
+    boost::python::object create_memoryview(const std::size_t n_rows,
+                                            const std::size_t n_columns,
+                                            Number          *&data)
+    {
+#if PY_MAJOR_VERSION >= 3
+      PyObject *bytes =
+        PyByteArray_FromStringAndSize(nullptr,
+                                      n_rows * n_columns * sizeof(Number));
+      boost::python::object byte_array((boost::python::handle<>(bytes)));
+      data = reinterpret_cast<Number *>(PyByteArray_AsString(bytes));
+
+      // the memoryview holds a reference to the bytearray
+      boost::python::object view(
+        (boost::python::handle<>(PyMemoryView_FromObject(bytes))));
+
+      return cast_memoryview<Number>(view, n_rows, n_columns);
+#else
+      (void)n_rows;
+      (void)n_columns;
+      data = nullptr;
+      AssertThrow(false, ExcMessage("Memoryviews require Python 3."));
+      return boost::python::object();
+#endif
+    }
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -295,6 +295,30 @@ namespace python
      */
     boost::python::list active_cells();
 
+    /**
+     * Return a read-only memoryview of shape (n_vertices, spacedim) of the
+     * coordinates of the vertices of the Triangulation. The coordinates are
+     * not copied, i.e., numpy.asarray() creates an array that shares the
+     * memory with the Triangulation. The memoryview is only valid as long as
+     * the Triangulation is not changed. Note that the array also contains
+     * the vertices that are not used anymore, e.g., after coarsening.
+     */
+    boost::python::object vertices();
+
+    /**
+     * Return a memoryview of shape (n_active_cells, vertices_per_cell) with
+     * the indices of the vertices of the active cells, in the same order as
+     * the cells returned by active_cells(). The indices refer to the rows of
+     * the array returned by vertices().
+     */
+    boost::python::object cell_connectivity() const;
+
+    /**
+     * Return a memoryview with the material ids of the active cells, in the
+     * same order as the cells returned by active_cells().
+     */
+    boost::python::object material_ids() const;
+
     /**
      * Write mesh to the output file @filename according to the given data format.
      */
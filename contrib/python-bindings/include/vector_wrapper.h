@@ -0,0 +1,88 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_vector_wrapper_h
+#define dealii_vector_wrapper_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <boost/python.hpp>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace python
+{
+  class VectorWrapper
+  {
+  public:
+    /**
+     * Constructor. Create a vector of size @p size with all entries set to
+     * zero.
+     */
+    VectorWrapper(const unsigned int size = 0);
+
+    /**
+     * Change the size of the vector to @p size and set all entries to zero.
+     */
+    void reinit(const unsigned int size);
+
+    /**
+     * Return the number of entries of the vector.
+     */
+    unsigned int size() const;
+
+    /**
+     * Return the l2 norm of the vector.
+     */
+    double l2_norm() const;
+
+    /**
+     * Return a writable one-dimensional memoryview of the entries of the
+     * vector. The entries are not copied, i.e., numpy.asarray() creates an
+     * array that shares the memory with the vector and changes of the array
+     * change the vector. The memoryview is only valid as long as the vector
+     * is not reinitialized.
+     */
+    boost::python::object values();
+
+    /**
+     * Return a reference to the underlying Vector.
+     */
+    Vector<double> &get_vector();
+
+  private:
+    /**
+     * The underlying Vector.
+     */
+    Vector<double> vector;
+  };
+
+
+  //--------------------- Inline functions ----------------------//
+
+
+
+  inline
+  Vector<double> &VectorWrapper::get_vector()
+  {
+    return vector;
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
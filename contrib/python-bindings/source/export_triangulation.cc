@@ -293,6 +293,30 @@ namespace python
 
 
 
+  const char vertices_docstring [] =
+    "Return a read-only memoryview of the coordinates of the vertices with  \n"
+    "shape (n_vertices, spacedim). The data is not copied, numpy.asarray()  \n"
+    "creates an array that shares the memory with the Triangulation. The    \n"
+    "memoryview is only valid as long as the Triangulation is not changed.  \n"
+    ;
+
+
+
+  const char cell_connectivity_docstring [] =
+    "Return a memoryview of the vertex indices of the active cells with     \n"
+    "shape (n_active_cells, vertices_per_cell), in the order of the cells   \n"
+    "returned by active_cells()                                             \n"
+    ;
+
+
+
+  const char material_ids_docstring [] =
+    "Return a memoryview of the material ids of the active cells, in the    \n"
+    "order of the cells returned by active_cells()                          \n"
+    ;
+
+
+
   const char write_docstring [] =
     "Write the mesh to the output file according to the given data format.  \n"
     "The possible formats are:                                              \n"
@@ -451,6 +475,19 @@ namespace python
          &TriangulationWrapper::active_cells,
          active_cells_docstring,
          boost::python::args("self"))
+    .def("vertices",
+         &TriangulationWrapper::vertices,
+         vertices_docstring,
+         boost::python::args("self"),
+         boost::python::with_custodian_and_ward_postcall<0, 1>())
+    .def("cell_connectivity",
+         &TriangulationWrapper::cell_connectivity,
+         cell_connectivity_docstring,
+         boost::python::args("self"))
+    .def("material_ids",
+         &TriangulationWrapper::material_ids,
+         material_ids_docstring,
+         boost::python::args("self"))
     .def("write",
          &TriangulationWrapper::write,
          write_docstring,
@@ -0,0 +1,67 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <vector_wrapper.h>
+#include <boost/python.hpp>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace python
+{
+  const char reinit_docstring [] =
+    "Change the size of the vector and set all entries to zero              \n"
+    ;
+
+
+
+  const char size_docstring [] =
+    "Return the number of entries of the vector                             \n"
+    ;
+
+
+
+  const char l2_norm_docstring [] =
+    "Return the l2 norm of the vector                                       \n"
+    ;
+
+
+
+  const char values_docstring [] =
+    "Return a writable memoryview of the entries of the vector. The data is \n"
+    "not copied, numpy.asarray() creates an array that shares the memory    \n"
+    "with the vector. The memoryview is only valid as long as the vector is \n"
+    "not reinitialized.                                                     \n"
+    ;
+
+
+
+  void export_vector()
+  {
+    boost::python::class_<VectorWrapper> ("Vector",
+                                          boost::python::init<boost::python::optional<unsigned int>>())
+    .def("reinit", &VectorWrapper::reinit, reinit_docstring,
+         boost::python::args("self", "size"))
+    .def("size", &VectorWrapper::size, size_docstring,
+         boost::python::args("self"))
+    .def("__len__", &VectorWrapper::size)
+    .def("l2_norm", &VectorWrapper::l2_norm, l2_norm_docstring,
+         boost::python::args("self"))
+    .def("values", &VectorWrapper::values, values_docstring,
+         boost::python::args("self"),
+         boost::python::with_custodian_and_ward_postcall<0, 1>());
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
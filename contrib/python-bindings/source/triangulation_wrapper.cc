@@ -15,7 +15,9 @@
 
 #include <triangulation_wrapper.h>
 #include <cell_accessor_wrapper.h>
+#include <buffer_helpers.h>
 #include <deal.II/base/types.h>
+#include <deal.II/base/geometry_info.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_out.h>
@@ -421,6 +423,61 @@ namespace python
 
 
 
+    template <int dim, int spacedim>
+    boost::python::object vertices(const void *triangulation)
+    {
+      const Triangulation<dim,spacedim> *tria =
+        static_cast<const Triangulation<dim,spacedim>*>(triangulation);
+      const std::vector<Point<spacedim>> &tria_vertices = tria->get_vertices();
+
+      // Point<spacedim> stores its coordinates contiguously, so the vector of
+      // vertices is an array of n_vertices times spacedim doubles
+      static_assert(sizeof(Point<spacedim>) == spacedim*sizeof(double),
+                    "Points need to be stored as an array of doubles.");
+      return make_memoryview(tria_vertices.empty() ? nullptr :
+                             &tria_vertices[0][0],
+                             tria_vertices.size(), spacedim, false);
+    }
+
+
+
+    template <int dim, int spacedim>
+    boost::python::object cell_connectivity(const void *triangulation)
+    {
+      const Triangulation<dim,spacedim> *tria =
+        static_cast<const Triangulation<dim,spacedim>*>(triangulation);
+
+      unsigned int *indices;
+      boost::python::object connectivity =
+        create_memoryview(tria->n_active_cells(),
+                          GeometryInfo<dim>::vertices_per_cell,
+                          indices);
+      for (const auto &cell : tria->active_cell_iterators())
+        for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+          *indices++ = cell->vertex_index(v);
+
+      return connectivity;
+    }
+
+
+
+    template <int dim, int spacedim>
+    boost::python::object material_ids(const void *triangulation)
+    {
+      const Triangulation<dim,spacedim> *tria =
+        static_cast<const Triangulation<dim,spacedim>*>(triangulation);
+
+      types::material_id *ids;
+      boost::python::object cell_material_ids =
+        create_memoryview(tria->n_active_cells(), 1, ids);
+      for (const auto &cell : tria->active_cell_iterators())
+        *ids++ = cell->material_id();
+
+      return cell_material_ids;
+    }
+
+
+
     template <int dim, int spacedim>
     void write(const std::string &filename,
                const std::string &format,
@@ -1072,6 +1129,43 @@ namespace python
   }
 
 
+
+  boost::python::object TriangulationWrapper::vertices()
+  {
+    if ((dim == 2) && (spacedim == 2))
+      return internal::vertices<2,2>(triangulation);
+    else if ((dim == 2) && (spacedim == 3))
+      return internal::vertices<2,3>(triangulation);
+    else
+      return internal::vertices<3,3>(triangulation);
+  }
+
+
+
+  boost::python::object TriangulationWrapper::cell_connectivity() const
+  {
+    if ((dim == 2) && (spacedim == 2))
+      return internal::cell_connectivity<2,2>(triangulation);
+    else if ((dim == 2) && (spacedim == 3))
+      return internal::cell_connectivity<2,3>(triangulation);
+    else
+      return internal::cell_connectivity<3,3>(triangulation);
+  }
+
+
+
+  boost::python::object TriangulationWrapper::material_ids() const
+  {
+    if ((dim == 2) && (spacedim == 2))
+      return internal::material_ids<2,2>(triangulation);
+    else if ((dim == 2) && (spacedim == 3))
+      return internal::material_ids<2,3>(triangulation);
+    else
+      return internal::material_ids<3,3>(triangulation);
+  }
+
+
+
   void TriangulationWrapper::setup(const std::string &dimension,
                                    const std::string &spacedimension)
   {
@@ -0,0 +1,57 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <vector_wrapper.h>
+#include <buffer_helpers.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace python
+{
+  VectorWrapper::VectorWrapper(const unsigned int size)
+    :
+    vector(size)
+  {}
+
+
+
+  void VectorWrapper::reinit(const unsigned int size)
+  {
+    vector.reinit(size);
+  }
+
+
+
+  unsigned int VectorWrapper::size() const
+  {
+    return vector.size();
+  }
+
+
+
+  double VectorWrapper::l2_norm() const
+  {
+    return vector.l2_norm();
+  }
+
+
+
+  boost::python::object VectorWrapper::values()
+  {
+    return internal::make_memoryview(vector.begin(), vector.size(), 1, true);
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
@@ -25,6 +25,7 @@ namespace python
   void export_cell_accessor();
   void export_point();
   void export_triangulation();
+  void export_vector();
 }
 
 DEAL_II_NAMESPACE_CLOSE
@@ -57,6 +58,7 @@ BOOST_PYTHON_MODULE(Debug)
   dealii::python::export_cell_accessor();
   dealii::python::export_point();
   dealii::python::export_triangulation();
+  dealii::python::export_vector();
 }
 
 #else
@@ -73,6 +75,7 @@ BOOST_PYTHON_MODULE(Release)
   dealii::python::export_cell_accessor();
   dealii::python::export_point();
   dealii::python::export_triangulation();
+  dealii::python::export_vector();
 }
 
 #endif
@@ -388,6 +388,47 @@ class TestTriangulationWrapper(unittest.TestCase):
             else:
                 self.assertEqual(n_cells, 8)
 
+    def test_vertices(self):
+        for dim in self.dim:
+            triangulation = self.build_hyper_cube_triangulation(dim)
+            triangulation.refine_global(1)
+            vertices = triangulation.vertices()
+            spacedim = 2 if dim[1] == '2D' else 3
+            n_vertices = 9 if dim[0] == '2D' else 27
+            self.assertEqual(vertices.shape, (n_vertices, spacedim))
+            self.assertTrue(vertices.readonly)
+            for coordinates in vertices.tolist():
+                for x in coordinates:
+                    self.assertTrue(x in [0., 0.5, 1.])
+
+    def test_cell_connectivity(self):
+        for dim in self.dim:
+            triangulation = self.build_hyper_cube_triangulation(dim)
+            triangulation.refine_global(1)
+            connectivity = triangulation.cell_connectivity()
+            vertices = triangulation.vertices().tolist()
+            vertices_per_cell = 4 if dim[0] == '2D' else 8
+            self.assertEqual(connectivity.shape,
+                             (triangulation.n_active_cells(),
+                              vertices_per_cell))
+            for cell, indices in zip(triangulation.active_cells(),
+                                     connectivity.tolist()):
+                barycenter = [sum(vertices[i][d] for i in indices) /
+                              vertices_per_cell for d in range(2)]
+                self.assertAlmostEqual(cell.barycenter().x, barycenter[0])
+                self.assertAlmostEqual(cell.barycenter().y, barycenter[1])
+
+    def test_material_ids(self):
+        for dim in self.dim:
+            triangulation = self.build_hyper_cube_triangulation(dim)
+            triangulation.refine_global(1)
+            material_id = 0
+            for cell in triangulation.active_cells():
+                cell.material_id = material_id
+                material_id += 1
+            self.assertEqual(triangulation.material_ids().tolist(),
+                             list(range(triangulation.n_active_cells())))
+
 
 if __name__ == '__main__':
     unittest.main()
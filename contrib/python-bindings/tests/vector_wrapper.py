@@ -0,0 +1,44 @@
+# ---------------------------------------------------------------------
+#
+# Copyright (C) 2019 by the deal.II authors
+#
+# This file is part of the deal.II library.
+#
+# The deal.II library is free software; you can use it, redistribute
+# it, and/or modify it under the terms of the GNU Lesser General
+# Public License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+# The full text of the license can be found in the file LICENSE.md at
+# the top level directory of deal.II.
+#
+# ---------------------------------------------------------------------
+
+import unittest
+import math
+from PyDealII.Debug import *
+
+
+class TestVectorWrapper(unittest.TestCase):
+
+    def test_size(self):
+        vector = Vector(5)
+        self.assertEqual(vector.size(), 5)
+        self.assertEqual(len(vector), 5)
+        vector.reinit(3)
+        self.assertEqual(vector.size(), 3)
+
+    def test_values(self):
+        vector = Vector(4)
+        values = vector.values()
+        self.assertEqual(values.shape, (4,))
+        self.assertFalse(values.readonly)
+        self.assertEqual(values.tolist(), [0., 0., 0., 0.])
+        for i in range(4):
+            values[i] = 1.
+        self.assertEqual(vector.l2_norm(), 2.)
+        del vector
+        self.assertEqual(math.fsum(values), 4.)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -47,7 +47,35 @@ namespace Algorithms
    * costly, this method applies an adaptive reassembling strategy. Only if
    * the reduction factor for the residual is more than #threshold, the event
    * Algorithms::bad_derivative is submitted to #inverse_derivative. It is up
-   * to this object to implement reassembling accordingly.
+   * to this object to implement reassembling accordingly. In addition, the
+   * event is submitted after the derivative has been used for
+   * #max_reuse_steps steps, if this number is not zero.
+   *
+   * <h3>Inexact Newton steps and line search</h3>
+   *
+   * If #adaptive_forcing is set, the relative accuracy required from the
+   * solution of the linear problem in each step is chosen by the method of
+   * Eisenstat and Walker (choice 2 in their paper with the parameters
+   * $\gamma=0.9$ and $\alpha=2$): starting with #initial_forcing, it is
+   * @f[
+   *   \eta_k = \gamma \left(\frac{\|r_k\|}{\|r_{k-1}\|}\right)^\alpha,
+   * @f]
+   * safeguarded from decreasing too fast far from the solution, bounded by
+   * #max_forcing, and not smaller than necessary to reach the tolerance of
+   * #control. This avoids oversolving the linear problems in the first steps,
+   * where the linearization is not accurate anyway. The value is handed to
+   * #inverse_derivative as described below, and it is up to this object to
+   * use it as the relative tolerance of its linear solver.
+   *
+   * By default, the step size control halves the update until the residual
+   * becomes smaller. If #quadratic_line_search is set, the next step size is
+   * instead the minimizer of the quadratic polynomial interpolating the
+   * squared norms of the residuals at the previous iterate and at the last
+   * trial step, and the derivative of the squared residual along a Newton
+   * step. This only uses the residuals which have already been computed and
+   * usually needs fewer residual evaluations than halving. The step size is
+   * reduced at least by a factor two and at most by a factor ten in each
+   * trial.
    *
    * <h3>Contents of the AnyData objects</h3>
    *
@@ -64,7 +92,10 @@ namespace Algorithms
    * at this point.
    *
    * For the call to (*#inverse_derivative), the vector <tt>"Newton
-   * residual"</tt> is inserted before <tt>"Newton iterate"</tt>.
+   * residual"</tt> is inserted before <tt>"Newton iterate"</tt>. If
+   * #adaptive_forcing is set, an entry of type <tt>const double*</tt> named
+   * <tt>"Newton forcing"</tt> with the relative tolerance for the linear
+   * solver is added at the end.
    *
    * @author Guido Kanschat, 2006, 2010
    */
@@ -167,6 +198,50 @@ namespace Algorithms
      */
     double assemble_threshold;
 
+    /**
+     * The maximal number of Newton steps performed with the same derivative.
+     * After this number of steps, Algorithms::bad_derivative is submitted to
+     * #inverse_derivative, independent of the residual reduction.
+     *
+     * The default value is zero, meaning that the derivative is only
+     * reassembled according to #assemble_threshold.
+     *
+     * @note Controlled by <tt>Maximal reuse steps</tt> in parameter file
+     */
+    unsigned int max_reuse_steps;
+
+    /**
+     * Choose the relative tolerance of the linear solver adaptively by the
+     * method of Eisenstat and Walker, see the class documentation.
+     *
+     * @note Controlled by <tt>Adaptive forcing</tt> in parameter file
+     */
+    bool adaptive_forcing;
+
+    /**
+     * The relative tolerance of the linear solver in the first step if
+     * #adaptive_forcing is set.
+     *
+     * @note Controlled by <tt>Initial forcing</tt> in parameter file
+     */
+    double initial_forcing;
+
+    /**
+     * The upper bound for the relative tolerance of the linear solver if
+     * #adaptive_forcing is set.
+     *
+     * @note Controlled by <tt>Maximal forcing</tt> in parameter file
+     */
+    double max_forcing;
+
+    /**
+     * Use quadratic interpolation of the residuals instead of halving the
+     * step size in the step size control.
+     *
+     * @note Controlled by <tt>Quadratic line search</tt> in parameter file
+     */
+    bool quadratic_line_search;
+
   public:
     /**
      * Print residual, update and updated solution after each step into file
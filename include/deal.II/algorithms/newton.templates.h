@@ -24,6 +24,7 @@
 
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
 #include <iomanip>
 
 
@@ -39,6 +40,11 @@ namespace Algorithms
     , assemble_now(false)
     , n_stepsize_iterations(21)
     , assemble_threshold(0.)
+    , max_reuse_steps(0)
+    , adaptive_forcing(false)
+    , initial_forcing(0.5)
+    , max_forcing(0.9)
+    , quadratic_line_search(false)
     , debug_vectors(false)
     , debug(0)
   {}
@@ -52,6 +58,11 @@ namespace Algorithms
     ReductionControl::declare_parameters(param);
     param.declare_entry("Assemble threshold", "0.", Patterns::Double(0.));
     param.declare_entry("Stepsize iterations", "21", Patterns::Integer(0));
+    param.declare_entry("Maximal reuse steps", "0", Patterns::Integer(0));
+    param.declare_entry("Adaptive forcing", "false", Patterns::Bool());
+    param.declare_entry("Initial forcing", "0.5", Patterns::Double(0., 1.));
+    param.declare_entry("Maximal forcing", "0.9", Patterns::Double(0., 1.));
+    param.declare_entry("Quadratic line search", "false", Patterns::Bool());
     param.declare_entry("Debug level", "0", Patterns::Integer(0));
     param.declare_entry("Debug vectors", "false", Patterns::Bool());
     param.leave_subsection();
@@ -65,6 +76,11 @@ namespace Algorithms
     control.parse_parameters(param);
     assemble_threshold    = param.get_double("Assemble threshold");
     n_stepsize_iterations = param.get_integer("Stepsize iterations");
+    max_reuse_steps       = param.get_integer("Maximal reuse steps");
+    adaptive_forcing      = param.get_bool("Adaptive forcing");
+    initial_forcing       = param.get_double("Initial forcing");
+    max_forcing           = param.get_double("Maximal forcing");
+    quadratic_line_search = param.get_bool("Quadratic line search");
     debug                 = param.get_integer("Debug level");
     debug_vectors         = param.get_bool("Debug vectors");
     param.leave_subsection();
@@ -125,11 +141,18 @@ namespace Algorithms
     AnyData out2;
     out2.add<VectorType *>(Du.get(), "Update");
 
+    // the relative tolerance for the inner solver
+    double forcing = initial_forcing;
+    if (adaptive_forcing)
+      src2.add<const double *>(&forcing, "Newton forcing");
+
     unsigned int step = 0;
     // fill res with (f(u), v)
     (*residual)(out1, src1);
     double resnorm      = res->l2_norm();
     double old_residual = 0.;
+    // the number of steps performed with the current derivative
+    unsigned int n_reuse_steps = 0;
 
     if (debug_vectors)
       {
@@ -147,8 +170,34 @@ namespace Algorithms
     while (control.check(step++, resnorm) == SolverControl::iterate)
       {
         // assemble (Df(u), v)
-        if ((step > 1) && (resnorm / old_residual >= assemble_threshold))
-          inverse_derivative->notify(Events::bad_derivative);
+        if ((step > 1) &&
+            ((resnorm / old_residual >= assemble_threshold) ||
+             ((max_reuse_steps > 0) && (n_reuse_steps >= max_reuse_steps))))
+          {
+            inverse_derivative->notify(Events::bad_derivative);
+            n_reuse_steps = 0;
+          }
+        ++n_reuse_steps;
+
+        // Eisenstat-Walker forcing term, choice 2 with gamma=0.9, alpha=2
+        if (adaptive_forcing && (step > 1))
+          {
+            const double ratio     = resnorm / old_residual;
+            const double safeguard = 0.9 * forcing * forcing;
+            forcing                = 0.9 * ratio * ratio;
+            if (safeguard > 0.1)
+              forcing = std::max(forcing, safeguard);
+            // do not solve more accurately than needed to reach the
+            // tolerance of the Newton iteration (the safeguard of Kelley)
+            const double target =
+              std::max(control.tolerance(),
+                       control.reduction() * control.initial_value());
+            forcing =
+              std::min(max_forcing, std::max(forcing, 0.5 * target / resnorm));
+            if (debug > 0)
+              deallog << "Forcing: " << forcing << std::endl;
+          }
+
 
         Du->reinit(u);
         try
@@ -180,7 +229,8 @@ namespace Algorithms
         resnorm = res->l2_norm();
 
         // Step size control
-        unsigned int step_size = 0;
+        unsigned int step_size   = 0;
+        double       step_length = 1.;
         while (resnorm >= old_residual)
           {
             ++step_size;
@@ -189,10 +239,30 @@ namespace Algorithms
                 deallog << "No smaller stepsize allowed!";
                 break;
               }
-            if (control.log_history())
+
+            double new_step_length = .5 * step_length;
+            if (quadratic_line_search)
+              {
+                // minimize the quadratic polynomial p(t) with p(0) and
+                // p(step_length) the known squared residual norms and
+                // p'(0)=-2p(0), the derivative along an exact Newton step
+                const double r0 = old_residual * old_residual;
+                const double r1 = resnorm * resnorm;
+                new_step_length = r0 * step_length * step_length /
+                                  (r1 - r0 + 2. * r0 * step_length);
+                new_step_length = std::max(.1 * step_length,
+                                           std::min(new_step_length,
+                                                    .5 * step_length));
+                if (control.log_history())
+                  deallog << "Trying step size: " << new_step_length
+                          << " since residual was " << resnorm << std::endl;
+              }
+            else if (control.log_history())
               deallog << "Trying step size: 1/" << (1 << step_size)
                       << " since residual was " << resnorm << std::endl;
-            u.add(1. / (1 << step_size), *Du);
+
+            u.add(step_length - new_step_length, *Du);
+            step_length = new_step_length;
             (*residual)(out1, src1);
             resnorm = res->l2_norm();
           }
@@ -117,6 +117,22 @@ namespace Algorithms
    * current step for #op_explicit and at the end for #op_implicit,
    * respectively.
    *
+   * <h3>Adaptive step size</h3>
+   *
+   * If the strategy of timestep_control() is
+   * TimestepControl::error_control, the local error of each step is
+   * estimated without additional solves by comparing the new solution with
+   * the extrapolation of the previous solutions to the end of the step,
+   * taking into account the leading error term of the theta scheme. For
+   * #theta=½, the solutions of the three previous steps are extrapolated
+   * quadratically, otherwise those of the two previous steps linearly. The
+   * maximum norm of the estimate is handed to TimestepControl::accept_step(),
+   * which chooses the next step size. A rejected step is repeated from the
+   * saved solution at its beginning with a smaller step size. The vectors
+   * needed for this are allocated once at the beginning of operator(). The
+   * first steps, for which not enough previous solutions are available, use
+   * the step size TimestepControl::start_step() and are always accepted.
+   *
    * <h3>Usage of ThetaTimestepping</h3>
    *
    * The use ThetaTimestepping is more complicated than for instance Newton,
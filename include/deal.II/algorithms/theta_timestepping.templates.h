@@ -24,6 +24,9 @@
 
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
+#include <cmath>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Algorithms
@@ -114,6 +117,27 @@ namespace Algorithms
     src2.add<const double *>(&vtheta, "Theta");
     src2.merge(in);
 
+    // For error control, we keep the solution at the beginning of the step
+    // for rejected steps and the two previous solutions for the error
+    // estimate. All vectors are allocated here, such that neither accepted
+    // nor rejected steps allocate memory.
+    const bool error_control =
+      (control.strategy() == TimestepControl::error_control);
+    typename VectorMemory<VectorType>::Pointer previous(mem);
+    typename VectorMemory<VectorType>::Pointer history_0(mem);
+    typename VectorMemory<VectorType>::Pointer history_1(mem);
+    VectorType *history[2] = {history_0.get(), history_1.get()};
+    // the sizes of the steps leading to the vectors in history and their
+    // number
+    double       history_step[2] = {0., 0.};
+    unsigned int n_history       = 0;
+    if (error_control)
+      {
+        previous->reinit(solution);
+        history[0]->reinit(solution);
+        history[1]->reinit(solution);
+      }
+
     if (output != nullptr)
       (*output) << 0U << out;
 
@@ -135,9 +159,65 @@ namespace Algorithms
 
         // Compute
         // (I + (1-theta)dt A) u
+        if (error_control)
+          *previous = solution;
         (*op_explicit)(out1, src1);
         (*op_implicit)(out, src2);
 
+        if (error_control)
+          {
+            // The error estimate compares the solution with the
+            // extrapolation of the previous solutions to the end of the
+            // step, which is computed in aux. The local error of the theta
+            // scheme is (1/2-theta) k^2 u'', while linear extrapolation has
+            // the error k(k+k1)/2 u''. For theta=1/2, the local error is
+            // -k^3/12 u''' and we use quadratic extrapolation with the error
+            // k(k+k1)(k+k1+k2)/6 u'''.
+            const double       k            = control.step();
+            const bool         second_order = (vtheta == 0.5);
+            const unsigned int n_needed     = (second_order ? 2 : 1);
+            if (n_history >= n_needed)
+              {
+                const double k1 = history_step[0];
+                double       factor;
+                *aux = *previous;
+                if (second_order)
+                  {
+                    const double k2 = history_step[1];
+                    aux->sadd((k + k1) * (k + k1 + k2) / (k1 * (k1 + k2)),
+                              -k * (k + k1 + k2) / (k1 * k2),
+                              *history[0]);
+                    aux->add(k * (k + k1) / ((k1 + k2) * k2), *history[1]);
+                    factor = k * k / (2. * (k + k1) * (k + k1 + k2));
+                  }
+                else
+                  {
+                    aux->sadd(1. + k / k1, -k / k1, *history[0]);
+                    factor = std::fabs(0.5 - vtheta) * 2. * k / (k + k1);
+                  }
+                *aux -= solution;
+                const double error = factor * aux->linfty_norm();
+                deallog << "Error estimate:" << error << std::endl;
+
+                if (control.accept_step(error, second_order ? 2 : 1) ==
+                    false)
+                  {
+                    deallog << "Step rejected" << std::endl;
+                    solution = *previous;
+                    --count;
+                    continue;
+                  }
+              }
+
+            // keep the solution at the beginning of the step as the most
+            // recent previous solution
+            std::swap(history[0], history[1]);
+            history_step[1] = history_step[0];
+            history[0]->swap(*previous);
+            history_step[0] = k;
+            n_history       = std::min(n_history + 1, 2U);
+          }
+
         if (output != nullptr && control.print())
           (*output) << count << out;
 
@@ -51,6 +51,14 @@ namespace Algorithms
    *
    * The variable @p print_step can be used to control the amount of output
    * generated by the timestepping scheme.
+   *
+   * With the strategy #error_control, the time stepping scheme computes an
+   * estimate of the local error after each step and hands it to
+   * accept_step(). This function decides whether the step is accepted and
+   * computes the size of the next step, which is then used by advance().
+   * If the step is rejected, now() is reset to the beginning of the step,
+   * and the scheme repeats it with the reduced step size obtained from the
+   * following call to advance().
    */
   class TimestepControl : public Subscriptor
   {
@@ -73,7 +81,14 @@ namespace Algorithms
        * This strategy is intended for pseudo-timestepping schemes computing a
        * stationary limit.
        */
-      doubling
+      doubling,
+      /**
+       * Choose the step size such that the estimate of the local error handed
+       * to accept_step() after each step stays below tolerance(), using a
+       * proportional-integral (PI) controller. The first step has the size
+       * start_step().
+       */
+      error_control
     };
 
     /**
@@ -132,6 +147,34 @@ namespace Algorithms
     bool
     advance();
 
+    /**
+     * For the strategy #error_control, decide whether the step from
+     * now()-step() to now() with the local error estimate @p error is
+     * accepted, and compute the size of the next step. @p order is the order
+     * of the error estimate, i.e., the error is assumed to behave like
+     * <i>step()<sup>order+1</sup></i>.
+     *
+     * The new step size is computed by the PI controller
+     * @f[
+     *   k_{	ext{new}} = 0.9\,k
+     *   \left(rac{	ext{tol}}{e_n}
+ight)^{0.7/(	ext{order}+1)}
+     *   \left(rac{e_{n-1}}{	ext{tol}}
+ight)^{0.4/(	ext{order}+1)},
+     * @f]
+     * where $e_n$ is @p error and $e_{n-1}$ the error estimate of the
+     * previous accepted step. The step size changes at most by a factor of
+     * five in each step and is limited by the maximal step size. It is not
+     * increased directly after a rejected step.
+     *
+     * If @p error exceeds tolerance() and the step is larger than the
+     * minimal step size, the step is rejected, now() is reset to the time at
+     * the beginning of the step and the step size is reduced. The function
+     * returns true if the step was accepted.
+     */
+    bool
+    accept_step(const double error, const unsigned int order);
+
     /**
      * Set start value.
      */
@@ -152,6 +195,12 @@ namespace Algorithms
      */
     void strategy(Strategy);
 
+    /**
+     * The time stepping strategy.
+     */
+    Strategy
+    strategy() const;
+
     /**
      * Set size of the first step. This may be overwritten by the time
      * stepping strategy.
@@ -168,6 +217,13 @@ namespace Algorithms
     void
     max_step(double);
 
+    /**
+     * Set size of the minimum step size. Steps of this size are accepted by
+     * accept_step() regardless of the error estimate.
+     */
+    void
+    min_step(double);
+
     /**
      * Set now() equal to start(). Initialize step() and print() to their
      * initial values.
@@ -206,6 +262,13 @@ namespace Algorithms
     double print_step;
     double next_print_val;
 
+    /**
+     * The error estimate of the last accepted step, divided by the tolerance,
+     * and whether the last step was rejected. Used by accept_step().
+     */
+    double last_error_val;
+    bool   rejected_val;
+
     char format[30];
   };
 
@@ -273,6 +336,13 @@ namespace Algorithms
   }
 
 
+  inline TimestepControl::Strategy
+  TimestepControl::strategy() const
+  {
+    return strategy_val;
+  }
+
+
   inline void
   TimestepControl::start_step(const double t)
   {
@@ -287,12 +357,21 @@ namespace Algorithms
   }
 
 
+  inline void
+  TimestepControl::min_step(double t)
+  {
+    min_step_val = t;
+  }
+
+
   inline void
   TimestepControl::restart()
   {
     now_val          = start_val;
     step_val         = start_step_val;
     current_step_val = step_val;
+    last_error_val   = 1.;
+    rejected_val     = false;
     if (print_step > 0.)
       next_print_val = now_val + print_step;
     else
@@ -124,8 +124,20 @@ public:
    * but does not initialize the newly allocated memory, leaving it in an
    * undefined state.
    *
+   * The exception is memory that has just been obtained from the operating
+   * system because the vector had to grow beyond its capacity: The newly
+   * added part of the vector is then set to zero (or default-constructed for
+   * non-trivial types @p T) in parallel. On systems with non-uniform memory
+   * access (NUMA), the memory pages are placed close to the processor socket
+   * of the thread that first writes to them, so this distributes the pages
+   * among the sockets in a similar way as the subsequent parallel operations
+   * on the vector access them, rather than placing all pages close to the
+   * thread calling this function.
+   *
    * @note This method can only be invoked for classes @p T that define a
    * default constructor, @p T(). Otherwise, compilation will fail.
+   *
+   * @dealiiOperationIsMultithreaded
    */
   void
   resize_fast(const size_type size);
@@ -792,12 +804,17 @@ AlignedVector<T>::resize_fast(const size_type size_in)
       while (data_end != data_begin + size_in)
         (--data_end)->~T();
     }
+  const T *const old_data = data_begin;
   reserve(size_in);
   data_end = data_begin + size_in;
 
   // need to still set the values in case the class is non-trivial because
-  // virtual classes etc. need to run their (default) constructor
-  if (std::is_trivial<T>::value == false && size_in > old_size)
+  // virtual classes etc. need to run their (default) constructor. for
+  // trivial classes, touch the part of newly allocated memory we are going
+  // to use in parallel, in order to have the first-touch policy of the
+  // operating system distribute the memory pages among the NUMA domains
+  if (size_in > old_size &&
+      (std::is_trivial<T>::value == false || data_begin != old_data))
     dealii::internal::AlignedVectorDefaultInitialize<T, true>(
       size_in - old_size, data_begin + old_size);
 }
@@ -23,13 +23,16 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/numerics/data_component_interpretation.h>
 
 // To be able to serialize XDMFEntry
 #include <boost/serialization/map.hpp>
 
+#include <cstdint>
 #include <limits>
+#include <map>
 #include <string>
 #include <tuple>
 #include <typeinfo>
@@ -1163,6 +1166,14 @@ namespace DataOutBase
      * Flag determining whether to write patches as linear cells
      * or as a high-order Lagrange cell.
      *
+     * If this flag is set, each patch is written as a single Lagrange curve,
+     * quadrilateral, or hexahedron whose polynomial degree is the number of
+     * subdivisions of the patch. Calling DataOut::build_patches() with the
+     * polynomial degree of the finite element as the number of subdivisions
+     * then results in one output cell per mesh cell, rather than
+     * <tt>n_subdivisions^dim</tt> linear cells, while the solution is
+     * still represented by the same points.
+     *
      * Default is <tt>false</tt>.
      *
      * @note The ability to write data that corresponds to higher order
@@ -1178,6 +1189,23 @@ namespace DataOutBase
      */
     bool write_higher_order_cells;
 
+    /**
+     * The number of bits of the 23 bit mantissa of the single precision
+     * numbers that are kept when writing the values of the data sets whose
+     * names are keys of this map. The remaining bits are rounded away and
+     * set to zero, which bounds the relative error of the values by
+     * $2^{-(b+1)}$ for $b$ kept bits; for example, 10 bits correspond to the
+     * precision of half precision numbers. Since runs of zero bits are
+     * compressed very well by zlib, this makes the compressed output of data
+     * sets that are not needed at full precision considerably smaller. For
+     * vector-valued and tensor-valued data sets, the key is the name under
+     * which the data set is written.
+     *
+     * Default is an empty map, i.e., all data sets are written at full
+     * single precision.
+     */
+    std::map<std::string, unsigned int> mantissa_bits;
+
     /**
      * Constructor.
      */
@@ -1187,6 +1215,20 @@ namespace DataOutBase
       const bool         print_date_and_time              = true,
       const ZlibCompressionLevel compression_level        = best_compression,
       const bool                 write_higher_order_cells = false);
+
+    /**
+     * Declare the flags of this class that can be set in input files, i.e.,
+     * whether higher order cells are written.
+     */
+    static void
+    declare_parameters(ParameterHandler &prm);
+
+    /**
+     * Read the parameters declared in declare_parameters() and set the flags
+     * for this output format accordingly.
+     */
+    void
+    parse_parameters(const ParameterHandler &prm);
   };
 
 
@@ -2274,6 +2316,103 @@ namespace DataOutBase
     const VtkFlags &flags,
     std::ostream &  out);
 
+  /**
+   * Write the entries of @p data as the contents of a <tt>DataArray</tt>
+   * element of a file in the xml based vtu file format. If deal.II was
+   * configured with zlib, the data is compressed and base64 encoded and the
+   * element needs to have the attribute <tt>format="binary"</tt>, otherwise
+   * the entries are written as text and the attribute needs to be
+   * <tt>format="ascii"</tt>. This function allows writing vtu files whose
+   * contents do not come from patches, together with write_vtu_header() and
+   * write_vtu_footer(), as done by Particles::DataOut.
+   *
+   * The function is instantiated for the types <tt>float</tt>,
+   * <tt>double</tt>, <tt>int</tt>, <tt>unsigned char</tt>, <tt>unsigned
+   * int</tt>, and <tt>unsigned long long int</tt>.
+   */
+  template <typename T>
+  void
+  write_vtu_data_array(const std::vector<T> &data,
+                       const VtkFlags &      flags,
+                       std::ostream &        out);
+
+  /**
+   * A description of a set of patches by the arrays of the unstructured grid
+   * format of VTK, i.e., the same data that write_vtu() writes to a file,
+   * but kept in memory. These arrays are the representation of unstructured
+   * meshes that in-situ visualization and data staging libraries such as
+   * ParaView Catalyst or ADIOS2 accept, so the arrays can be handed to (or
+   * viewed by) such a library to stream the output to visualization or
+   * analysis without writing files. The arrays are filled by
+   * build_vtk_unstructured_grid().
+   */
+  struct VtkUnstructuredGrid
+  {
+    /**
+     * The coordinates of the points, three per point. For <tt>spacedim <
+     * 3</tt>, the missing coordinates are zero.
+     */
+    std::vector<float> points;
+
+    /**
+     * The indices of the points of the cells, one cell after the other in
+     * the order of the vertices expected by VTK.
+     */
+    std::vector<std::int32_t> connectivity;
+
+    /**
+     * For each cell, the position in the array #connectivity after the
+     * last point of the cell.
+     */
+    std::vector<std::int32_t> offsets;
+
+    /**
+     * The VTK cell type of each cell.
+     */
+    std::vector<std::uint8_t> cell_types;
+
+    /**
+     * The names of the data sets. The vector-valued and tensor-valued data
+     * sets given by the nonscalar data ranges come first, followed by the
+     * scalar data sets.
+     */
+    std::vector<std::string> data_names;
+
+    /**
+     * The number of components of each data set, which is one for scalar,
+     * three for vector-valued, and nine for tensor-valued data sets, as VTK
+     * always expects three-dimensional vectors and tensors.
+     */
+    std::vector<unsigned int> data_n_components;
+
+    /**
+     * The values of each data set at the points, with the components of a
+     * point stored contiguously.
+     */
+    std::vector<std::vector<float>> data;
+  };
+
+  /**
+   * Fill the arrays of @p grid with the description of @p patches and the
+   * data sets in the unstructured grid format of VTK. The arguments have the
+   * same meaning as for write_vtu(), and @p flags is used to decide whether
+   * the patches are described by linear cells or by high order Lagrange
+   * cells. Previous contents of @p grid are deleted.
+   */
+  template <int dim, int spacedim>
+  void
+  build_vtk_unstructured_grid(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &                  nonscalar_data_ranges,
+    const VtkFlags &     flags,
+    VtkUnstructuredGrid &grid);
+
   /**
    * Some visualization programs, such as ParaView, can read several separate
    * VTU files that all form part of the same simulation, in order to
@@ -2993,6 +3132,40 @@ public:
   void
   write_vtu_in_parallel(const std::string &filename, MPI_Comm comm) const;
 
+  /**
+   * Fill @p grid with the arrays that describe the data obtained through
+   * get_patches() in the unstructured grid format of VTK, using the flags
+   * set by set_flags(). See DataOutBase::VtkUnstructuredGrid for the use of
+   * these arrays for in-situ visualization and staging, where the data is
+   * passed to another library instead of being written to a file.
+   */
+  void
+  build_vtk_unstructured_grid(DataOutBase::VtkUnstructuredGrid &grid) const;
+
+  /**
+   * Write the data obtained through get_patches() to the file @p filename in
+   * Vtu format on a background task, and return the task immediately. The
+   * patches, the names of the data sets, and the flags are copied before the
+   * function returns, so the object can be modified, e.g., by a new call to
+   * DataOut::build_patches(), or destroyed while the file is being written.
+   * The encoding, compression, and writing of the file then overlap with
+   * whatever the program does next. Call Threads::Task::join() on the
+   * returned object to wait for the output to complete, for example before
+   * writing the next output file. Exceptions thrown while writing the file
+   * are rethrown by Threads::Task::join().
+   *
+   * In parallel computations, every process writes its own file and one
+   * process writes the master record with write_pvtu_record(), see step-40.
+   * Contrary to write_vtu_in_parallel(), the background task does not call
+   * any MPI functions, as this would require MPI to be initialized with
+   * support for concurrent calls from several threads.
+   *
+   * @note The copy of the patches doubles the memory required for the
+   * output until the task has finished.
+   */
+  Threads::Task<>
+  write_vtu_in_background(const std::string &filename) const;
+
   /**
    * Some visualization programs, such as ParaView, can read several separate
    * VTU files that all form part of the same simulation, in order to
@@ -3664,6 +3837,172 @@ private:
 
 
 
+/**
+ * A class that writes the output of a time dependent simulation to a single
+ * HDF5 file and an accompanying XDMF file. In contrast to calling
+ * DataOutInterface::write_hdf5_parallel() for each time step, the mesh is
+ * only written once every time it changes, and the data of all time steps
+ * computed on the same mesh is appended to one extensible dataset for each
+ * data set name.
+ *
+ * The HDF5 file contains one group <tt>/mesh_0</tt>, <tt>/mesh_1</tt>, ...
+ * for each mesh, with the datasets <tt>nodes</tt> and <tt>cells</tt>
+ * describing the mesh and one dataset of size (number of time steps) x
+ * (number of nodes) x (number of components) for each data set. The latter
+ * datasets are chunked such that each chunk holds the data of a block of
+ * nodes in a single time step, and all processes write their part of them
+ * with collective MPI-IO operations if HDF5 has been configured for parallel
+ * output. The XDMF file is updated after each time step by appending a new
+ * entry, so that it can be opened to visualize the time steps written so
+ * far while the simulation is still running.
+ *
+ * The class is used as follows:
+ * @code
+ * XDMFTimeSeriesWriter<dim> writer("solution.h5",
+ *                                  "solution.xdmf",
+ *                                  MPI_COMM_WORLD);
+ * for (...; ...; ++timestep)
+ *   {
+ *     ...
+ *     DataOut<dim> data_out;
+ *     data_out.attach_dof_handler(dof_handler);
+ *     data_out.add_data_vector(solution, "u");
+ *     data_out.build_patches();
+ *
+ *     writer.write_time_step(data_out, time, mesh_has_changed);
+ *   }
+ * @endcode
+ *
+ * All functions of this class need to be called on all processes of the
+ * communicator given to the constructor.
+ */
+template <int dim, int spacedim = dim>
+class XDMFTimeSeriesWriter
+{
+public:
+  /**
+   * Constructor. Create the HDF5 file @p h5_filename and the XDMF file
+   * @p xdmf_filename, overwriting existing files of those names. The name of
+   * the HDF5 file is used verbatim within the XDMF file, so it should be
+   * given relative to the location of the XDMF file.
+   *
+   * The data of each time step is stored in chunks of approximately
+   * @p chunk_size_in_bytes bytes.
+   */
+  XDMFTimeSeriesWriter(const std::string &h5_filename,
+                       const std::string &xdmf_filename,
+                       const MPI_Comm     comm,
+                       const std::size_t  chunk_size_in_bytes = 1 << 20);
+
+  /**
+   * Filter the data of @p data_out, see
+   * DataOutInterface::write_filtered_data(), and write it as a new time
+   * step with the time @p time. See the other version of this function for
+   * the meaning of @p mesh_changed.
+   */
+  void
+  write_time_step(const DataOutInterface<dim, spacedim> &data_out,
+                  const double                           time,
+                  const bool                             mesh_changed);
+
+  /**
+   * Write the data in @p data_filter as a new time step with the time
+   * @p time. If @p mesh_changed is true, or if this is the first time step,
+   * the mesh is written to a new group of the HDF5 file. Otherwise, the mesh
+   * previously written is reused, so the nodes and cells in @p data_filter
+   * as well as the names and dimensions of its data sets need to be the same
+   * as in the last time step.
+   */
+  void
+  write_time_step(const DataOutBase::DataOutFilter &data_filter,
+                  const double                      time,
+                  const bool                        mesh_changed);
+
+  /**
+   * Return the number of time steps written so far.
+   */
+  unsigned int
+  n_time_steps() const;
+
+  /**
+   * Return the number of meshes written so far.
+   */
+  unsigned int
+  n_meshes() const;
+
+private:
+  /**
+   * Append the XDMF entry for the time step just written to the XDMF file.
+   * This function is only called on the root process.
+   */
+  void
+  append_xdmf_entry(const double time);
+
+  /**
+   * The name of the HDF5 file.
+   */
+  const std::string h5_filename;
+
+  /**
+   * The name of the XDMF file.
+   */
+  const std::string xdmf_filename;
+
+  /**
+   * The MPI communicator of all processes writing to the files.
+   */
+  const MPI_Comm comm;
+
+  /**
+   * The approximate size of the chunks of the datasets in bytes.
+   */
+  const std::size_t chunk_size_in_bytes;
+
+  /**
+   * The number of meshes written so far. The current mesh is stored in the
+   * group <tt>/mesh_k</tt> with <tt>k = n_meshes_written - 1</tt>.
+   */
+  unsigned int n_meshes_written;
+
+  /**
+   * The number of time steps written on the current mesh.
+   */
+  unsigned int n_steps_on_current_mesh;
+
+  /**
+   * The total number of time steps written.
+   */
+  unsigned int n_time_steps_written;
+
+  /**
+   * The global number of nodes of the current mesh.
+   */
+  unsigned int global_n_nodes;
+
+  /**
+   * The global number of cells of the current mesh.
+   */
+  unsigned int global_n_cells;
+
+  /**
+   * The number of nodes of the current mesh owned by this process.
+   */
+  unsigned int local_n_nodes;
+
+  /**
+   * The names and dimensions of the data sets written on the current mesh.
+   */
+  std::vector<std::pair<std::string, unsigned int>> data_sets;
+
+  /**
+   * The position in the XDMF file at which the closing tags start, i.e.,
+   * where the next entry is written. Only used on the root process.
+   */
+  std::streampos xdmf_footer_position;
+};
+
+
+
 /* -------------------- inline functions ------------------- */
 
 namespace DataOutBase
@@ -37,6 +37,8 @@ template <typename number>
 class Vector;
 template <int rank, int dim, typename Number>
 class TensorFunction;
+template <typename Number, int width>
+class VectorizedArray;
 #endif
 
 /**
@@ -268,6 +270,32 @@ public:
   vector_values(const std::vector<Point<dim>> &            points,
                 std::vector<std::vector<RangeNumberType>> &values) const;
 
+  /**
+   * Return the values of the specified component of the function at the
+   * points whose coordinates are given by the lanes of the vectorized point
+   * @p p, as used for the quadrature points of a batch of cells in
+   * FEEvaluation. This function calls value() for each lane.
+   */
+  template <typename Number, int width>
+  VectorizedArray<Number, width>
+  vectorized_value(const Point<dim, VectorizedArray<Number, width>> &p,
+                   const unsigned int component = 0) const;
+
+  /**
+   * Set @p values to the values of the specified component of the function
+   * at the vectorized @p points, e.g., all quadrature points of a batch of
+   * cells in FEEvaluation. The lanes of all points are collected into a
+   * single call to value_list(), such that derived classes that evaluate
+   * many points at once in value_list(), like FunctionParser, do so for the
+   * whole batch. The vector @p values is resized to the size of @p points.
+   */
+  template <typename Number, int width>
+  void
+  vectorized_value_list(
+    const std::vector<Point<dim, VectorizedArray<Number, width>>> &points,
+    std::vector<VectorizedArray<Number, width>> &                  values,
+    const unsigned int component = 0) const;
+
   /**
    * Return the gradient of the specified component of the function at the
    * given point.
@@ -1087,6 +1115,51 @@ private:
 // in the declaration.
 template <int dim, typename RangeNumberType>
 inline Function<dim, RangeNumberType>::~Function() = default;
+
+
+
+template <int dim, typename RangeNumberType>
+template <typename Number, int width>
+inline VectorizedArray<Number, width>
+Function<dim, RangeNumberType>::vectorized_value(
+  const Point<dim, VectorizedArray<Number, width>> &p,
+  const unsigned int                                component) const
+{
+  VectorizedArray<Number, width> result;
+  for (unsigned int v = 0; v < width; ++v)
+    {
+      Point<dim> point;
+      for (unsigned int d = 0; d < dim; ++d)
+        point[d] = p[d][v];
+      result[v] = this->value(point, component);
+    }
+  return result;
+}
+
+
+
+template <int dim, typename RangeNumberType>
+template <typename Number, int width>
+inline void
+Function<dim, RangeNumberType>::vectorized_value_list(
+  const std::vector<Point<dim, VectorizedArray<Number, width>>> &points,
+  std::vector<VectorizedArray<Number, width>> &                  values,
+  const unsigned int component) const
+{
+  std::vector<Point<dim>> scalar_points(points.size() * width);
+  for (unsigned int q = 0; q < points.size(); ++q)
+    for (unsigned int v = 0; v < width; ++v)
+      for (unsigned int d = 0; d < dim; ++d)
+        scalar_points[q * width + v][d] = points[q][d][v];
+
+  std::vector<RangeNumberType> scalar_values(scalar_points.size());
+  this->value_list(scalar_points, scalar_values, component);
+
+  values.resize(points.size());
+  for (unsigned int q = 0; q < points.size(); ++q)
+    for (unsigned int v = 0; v < width; ++v)
+      values[q][v] = scalar_values[q * width + v];
+}
 #endif
 
 
@@ -342,6 +342,17 @@ public:
   virtual void
   vector_value(const Point<dim> &p, Vector<double> &values) const override;
 
+  /**
+   * Set @p values to the values of the given @p component of the function at
+   * the @p points. This function evaluates the expression with the bulk mode
+   * of muparser, which processes many points per call and is considerably
+   * faster than calling value() for each point separately.
+   */
+  virtual void
+  value_list(const std::vector<Point<dim>> &points,
+             std::vector<double> &          values,
+             const unsigned int             component = 0) const override;
+
   /**
    * Return an array of function expressions (one per component), used to
    * initialize this function.
@@ -371,7 +382,10 @@ public:
 private:
 #ifdef DEAL_II_WITH_MUPARSER
   /**
-   * Place for the variables for each thread
+   * Place for the variables for each thread. Each variable is stored in an
+   * array of fixed length for the bulk evaluation of several points in
+   * value_list(); the evaluation at a single point uses the first entry of
+   * each array.
    */
   mutable Threads::ThreadLocalStorage<std::vector<double>> vars;
 
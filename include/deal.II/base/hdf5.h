@@ -20,14 +20,31 @@
 
 #ifdef DEAL_II_WITH_HDF5
 
+#  include <deal.II/base/memory_space.h>
+#  include <deal.II/base/mpi.h>
+
 #  include <deal.II/lac/full_matrix.h>
 
 #  include <hdf5.h>
 
+#  include <map>
+#  include <string>
 #  include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declaration
+#  ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#  endif
+
 // It is necessary to turn clang-format off in order to maintain the Doxygen
 // links because they are longer than 80 characters
 // clang-format off
@@ -317,6 +334,37 @@ DEAL_II_NAMESPACE_OPEN
  * active_cells = data.attrs['degrees_of_freedom'])
  * ~~~~~~~~~~~~~
  *
+ * # Chunking, compression, and parallel performance
+ * By default, the elements of a dataset are stored contiguously in the file.
+ * A dataset can instead be stored in chunks of a given shape by creating it
+ * with Group::create_dataset(const std::string &, const std::vector<hsize_t> &, const DataSetCreationProperties &) const,
+ * which is required for compressing the dataset with the filters set in
+ * DataSetCreationProperties:
+ * @code
+ * HDF5::DataSetCreationProperties properties;
+ * properties.chunk_dimensions = {1024, 3};
+ * properties.shuffle          = true;
+ * properties.deflate_level    = 4;
+ * auto dataset = group.create_dataset<double>("positions",
+ *                                             {n_particles, 3},
+ *                                             properties);
+ * @endcode
+ * Parallel writes to compressed datasets require HDF5 1.10.2 or newer and
+ * collective transfers.
+ *
+ * In parallel, all read and write operations use collective MPI-IO by
+ * default. DataSet::set_transfer_mode() selects independent transfers
+ * instead, for example if only some processes access a dataset. Hints for
+ * the MPI-IO layer, e.g., to tune collective buffering, can be passed to the
+ * constructor
+ * File::File(const std::string &, const FileAccessMode, const MPI_Comm, const std::map<std::string, std::string> &).
+ *
+ * Data that is distributed over the processes can be written with a single
+ * collective call of Group::write_distributed_dataset(), which writes the
+ * locally owned range of a LinearAlgebra::distributed::Vector, or the local
+ * rows of an array such as the properties of the locally owned particles,
+ * as a hyperslab of the dataset.
+ *
  * # HDF5 and thread safety
  * By default HDF5 is not thread-safe. The HDF5 library can be configured to be
  * thread-safe, see [the HDF5
@@ -330,6 +378,37 @@ DEAL_II_NAMESPACE_OPEN
 // clang-format on
 namespace HDF5
 {
+  // clang-format off
+  /**
+   * The properties of a dataset that are set when the dataset is created
+   * with
+   * Group::create_dataset(const std::string &, const std::vector<hsize_t> &, const DataSetCreationProperties &) const.
+   */
+  // clang-format on
+  struct DataSetCreationProperties
+  {
+    /**
+     * The dimensions of the chunks in which the dataset is stored. The
+     * number of entries has to be equal to the rank of the dataset. If the
+     * vector is empty, the dataset is stored contiguously, which does not
+     * allow to use the filters below.
+     */
+    std::vector<hsize_t> chunk_dimensions;
+
+    /**
+     * Whether the bytes of the elements of each chunk are shuffled before
+     * the compression, which usually improves the compression ratio of
+     * floating point data.
+     */
+    bool shuffle = false;
+
+    /**
+     * The level between 0 and 9 of the deflate (zlib) compression of the
+     * chunks. The value 0 disables the compression.
+     */
+    unsigned int deflate_level = 0;
+  };
+
   /**
    * Base class for the HDF5 objects.
    *
@@ -428,13 +507,33 @@ namespace HDF5
      * Create dataset. This is an internal constructor. The function
      * Group::create_dataset() should be used to create a dataset.
      */
-    DataSet(const std::string &           name,
-            const hid_t &                 parent_group_id,
-            const std::vector<hsize_t> &  dimensions,
-            const std::shared_ptr<hid_t> &t_type,
-            const bool                    mpi);
+    DataSet(const std::string &              name,
+            const hid_t &                    parent_group_id,
+            const std::vector<hsize_t> &     dimensions,
+            const std::shared_ptr<hid_t> &   t_type,
+            const bool                       mpi,
+            const DataSetCreationProperties &properties =
+              DataSetCreationProperties());
 
   public:
+    /**
+     * The MPI-IO transfer mode of the read and write operations.
+     */
+    enum class TransferMode
+    {
+      /**
+       * All processes of the communicator of the file take part in each
+       * read and write operation, which allows MPI-IO to aggregate the
+       * accesses of the processes. This is the default.
+       */
+      collective,
+      /**
+       * Each process reads and writes independently of the other
+       * processes.
+       */
+      independent
+    };
+
     /**
      * Reads all the data of the dataset.
      *
@@ -757,6 +856,22 @@ namespace HDF5
     bool
     get_query_io_mode() const;
 
+    /**
+     * Set the MPI-IO transfer mode used by the subsequent read and write
+     * operations of this dataset. The transfer mode is only relevant for
+     * files opened in parallel. If the transfer mode is
+     * TransferMode::independent, processes that do not access the dataset
+     * do not need to call read_none() or write_none().
+     */
+    void
+    set_transfer_mode(const TransferMode new_transfer_mode);
+
+    /**
+     * Return the MPI-IO transfer mode set by set_transfer_mode().
+     */
+    TransferMode
+    get_transfer_mode() const;
+
     /**
      * This function sets the boolean query_io_mode.
      */
@@ -940,6 +1055,11 @@ namespace HDF5
      */
     bool query_io_mode;
 
+    /**
+     * The MPI-IO transfer mode of the read and write operations.
+     */
+    TransferMode transfer_mode;
+
     /**
      * I/O mode that was performed on the last parallel I/O call.
      */
@@ -1036,6 +1156,18 @@ namespace HDF5
     create_dataset(const std::string &         name,
                    const std::vector<hsize_t> &dimensions) const;
 
+    /**
+     * Creates a dataset with the given @p properties, e.g., a dataset that
+     * is stored in chunks and compressed. @p number can be `float`,
+     * `double`, `std::complex<float>`, `std::complex<double>`, `int` or
+     * `unsigned int`.
+     */
+    template <typename number>
+    DataSet
+    create_dataset(const std::string &              name,
+                   const std::vector<hsize_t> &     dimensions,
+                   const DataSetCreationProperties &properties) const;
+
     /**
      * Create and write data to a dataset. @p number can be `float`, `double`,
      * `std::complex<float>`, `std::complex<double>`, `int` or `unsigned int`.
@@ -1057,6 +1189,46 @@ namespace HDF5
     template <typename Container>
     void
     write_dataset(const std::string &name, const Container &data) const;
+
+    /**
+     * Create a one-dimensional dataset with the size of the distributed
+     * vector @p data and write the locally owned elements of each process
+     * as a hyperslab of the dataset, using the locally owned range of the
+     * vector as the offset. This is a collective operation on the processes
+     * of the communicator of the file, which has to be the one of the
+     * vector. @p number can be `float`, `double`, `std::complex<float>` or
+     * `std::complex<double>`.
+     */
+    template <typename number>
+    void
+    write_distributed_dataset(
+      const std::string &                                                name,
+      const LinearAlgebra::distributed::Vector<number, MemorySpace::Host> &data,
+      const DataSetCreationProperties &properties =
+        DataSetCreationProperties()) const;
+
+    /**
+     * Create a dataset that consists of the rows of @p local_data of all
+     * processes of @p mpi_communicator, stored in the order of the ranks of
+     * the processes, and write it with a single collective operation. Each
+     * row has @p n_columns entries, so @p local_data has to contain a
+     * multiple of @p n_columns entries, e.g., the properties of the locally
+     * owned particles. The dataset has the dimensions <tt>{n_rows,
+     * n_columns}</tt>, or <tt>{n_rows}</tt> if @p n_columns is one, where
+     * <tt>n_rows</tt> is the total number of rows. This is a collective
+     * operation on the processes of @p mpi_communicator, which has to be the
+     * communicator of the file. @p number can be `float`, `double`,
+     * `std::complex<float>`, `std::complex<double>`, `int` or
+     * `unsigned int`.
+     */
+    template <typename number>
+    void
+    write_distributed_dataset(const std::string &        name,
+                              const std::vector<number> &local_data,
+                              const unsigned int         n_columns,
+                              const MPI_Comm &           mpi_communicator,
+                              const DataSetCreationProperties &properties =
+                                DataSetCreationProperties()) const;
   };
 
   /**
@@ -1100,6 +1272,20 @@ namespace HDF5
          const FileAccessMode mode,
          const MPI_Comm       mpi_communicator);
 
+    /**
+     * Like the previous constructor, but the hints in @p mpi_io_hints are
+     * passed to the MPI-IO layer when the file is opened. The hints are
+     * pairs of keys and values as described in the MPI standard and the
+     * documentation of the MPI implementation, e.g.,
+     * <tt>{{"romio_cb_write", "enable"}, {"cb_buffer_size", "16777216"},
+     * {"cb_nodes", "8"}}</tt> to enable collective buffering for writing
+     * with buffers of 16 MB on 8 aggregator processes.
+     */
+    File(const std::string &                       name,
+         const FileAccessMode                      mode,
+         const MPI_Comm                            mpi_communicator,
+         const std::map<std::string, std::string> &mpi_io_hints);
+
   private:
     /**
      * Delegation internal constructor.
@@ -1108,10 +1294,12 @@ namespace HDF5
      * File(const std::string &, const Mode)
      * should be used to open or create HDF5 files.
      */
-    File(const std::string &  name,
-         const FileAccessMode mode,
-         const bool           mpi,
-         const MPI_Comm       mpi_communicator);
+    File(const std::string &                       name,
+         const FileAccessMode                      mode,
+         const bool                                mpi,
+         const MPI_Comm                            mpi_communicator,
+         const std::map<std::string, std::string> &mpi_io_hints =
+           std::map<std::string, std::string>());
   };
 } // namespace HDF5
 
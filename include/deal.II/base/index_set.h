@@ -954,6 +954,17 @@ private:
    */
   void
   do_compress() const;
+
+  /**
+   * Add the ranges in @p tmp_ranges to this index set. The ranges may
+   * overlap with each other and with the ranges already present. If
+   * @p ranges_are_sorted is false, @p tmp_ranges is sorted first. The ranges
+   * are merged with the present ones in a single pass, rather than inserted
+   * one by one, which would take quadratic time for fragmented sets.
+   */
+  void
+  add_ranges_internal(std::vector<Range> &tmp_ranges,
+                      const bool          ranges_are_sorted);
 };
 
 
@@ -1640,8 +1651,15 @@ template <typename ForwardIterator>
 inline void
 IndexSet::add_indices(const ForwardIterator &begin, const ForwardIterator &end)
 {
-  // insert each element of the range. if some of them happen to be
-  // consecutive, merge them to a range
+  if (begin == end)
+    return;
+
+  // identify ranges in the given iterator range by checking whether some
+  // indices happen to be consecutive. to avoid maintaining the sortedness
+  // of the ranges of this set after every new range, collect them in a
+  // temporary vector first and add them in one go
+  std::vector<Range> tmp_ranges;
+  bool               ranges_are_sorted = true;
   for (ForwardIterator p = begin; p != end;)
     {
       const size_type begin_index = *p;
@@ -1654,9 +1672,16 @@ IndexSet::add_indices(const ForwardIterator &begin, const ForwardIterator &end)
           ++q;
         }
 
-      add_range(begin_index, end_index);
+      tmp_ranges.emplace_back(begin_index, end_index);
       p = q;
+
+      // if the next index is smaller than the present one, the ranges are
+      // not sorted
+      if (p != end && *p < begin_index)
+        ranges_are_sorted = false;
     }
+
+  add_ranges_internal(tmp_ranges, ranges_are_sorted);
 }
 
 
@@ -0,0 +1,237 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_memory_report_h
+#define dealii_memory_report_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A class that collects the memory consumption of the data structures of a
+ * program and reports it per subsystem, summarized over all processes of an
+ * MPI communicator. The purpose is to find out which part of a program
+ * dominates the memory usage and how the memory grows with the problem size
+ * and the number of processes, e.g. to size jobs on a cluster.
+ *
+ * Entries are added with add(), either by an explicit number of bytes or by
+ * an object for which MemoryConsumption::memory_consumption() is defined,
+ * such as vectors and sparsity patterns. The names of the entries can be
+ * structured hierarchically by slashes. Several classes of the library
+ * provide a function <tt>add_memory_consumption(report, name)</tt> that adds
+ * a detailed breakdown of their data structures with @p name as prefix:
+ * Triangulation (per level, faces, vertices), DoFHandler (active and
+ * multigrid indices), MatrixFree (DoFInfo, MappingInfo, ShapeInfo, etc.),
+ * and Particles::ParticleHandler (particle storage and property pool).
+ *
+ * In addition to the estimates of the data structures, which only cover the
+ * memory that is known to the library, the resident set size of the process
+ * as reported by the operating system can be recorded with
+ * sample_process_memory() at any point of the program, e.g., after each
+ * phase of a simulation. This includes the memory of external libraries and
+ * fragmentation, and the peak value shows the high-water mark that determines
+ * whether a job runs out of memory. This information is only available on
+ * Linux, see Utilities::System::get_memory_stats().
+ *
+ * The functions get_summary() and print() compute the minimum, average,
+ * maximum, and sum of every entry over all processes and must be called on
+ * all processes of the communicator. Entries that are only present on some
+ * processes, e.g., for mesh levels that are not present locally, are counted
+ * as zero on the others. A typical use is
+ * @code
+ *   MemoryReport report(MPI_COMM_WORLD);
+ *   triangulation.add_memory_consumption(report, "Triangulation");
+ *   dof_handler.add_memory_consumption(report, "DoFHandler");
+ *   matrix_free.add_memory_consumption(report, "MatrixFree");
+ *   report.add_object("Vectors/solution", solution);
+ *   report.add_object("SparsityPattern", sparsity_pattern);
+ *   report.sample_process_memory("after setup");
+ *   report.print(pcout);
+ * @endcode
+ *
+ * @ingroup utilities
+ */
+class MemoryReport
+{
+public:
+  /**
+   * The summary of one entry of the report over all processes, with the
+   * memory given in bytes.
+   */
+  struct Entry
+  {
+    /**
+     * The name of the entry.
+     */
+    std::string name;
+
+    /**
+     * Minimum, average, maximum, and sum of the memory of this entry over
+     * all processes.
+     */
+    Utilities::MPI::MinMaxAvg memory;
+
+    /**
+     * Whether this entry was recorded by sample_process_memory() rather than
+     * added as the memory consumption of a data structure.
+     */
+    bool is_process_memory;
+  };
+
+  /**
+   * Constructor. The entries are summarized over the processes in
+   * @p mpi_communicator.
+   */
+  explicit MemoryReport(const MPI_Comm &mpi_communicator = MPI_COMM_SELF);
+
+  /**
+   * Add @p memory bytes to the entry called @p name. If the entry already
+   * exists, the memory is added to it.
+   */
+  void
+  add(const std::string &name, const std::size_t memory);
+
+  /**
+   * Add the memory consumption of @p object, as determined by
+   * MemoryConsumption::memory_consumption(), to the entry called @p name.
+   */
+  template <typename T>
+  void
+  add_object(const std::string &name, const T &object);
+
+  /**
+   * Record the current and the peak resident set size of this process as
+   * reported by Utilities::System::get_memory_stats(), as two entries
+   * prefixed by @p label. On systems where this information is not
+   * available, the recorded values are zero.
+   */
+  void
+  sample_process_memory(const std::string &label = "process");
+
+  /**
+   * Return the sum of the entries added for data structures on this process,
+   * in bytes, without the samples of the process memory.
+   */
+  std::size_t
+  local_data_memory() const;
+
+  /**
+   * Compute the minimum, average, maximum, and sum of all entries over the
+   * processes of the communicator given to the constructor. The entries are
+   * returned in the order in which they were added, with the entries of the
+   * first process taking precedence. The entries of the data structures are
+   * followed by an additional entry <tt>Total data</tt> with the sum over
+   * all of them, and then by the samples of the process memory.
+   *
+   * This function must be called on all processes of the communicator.
+   */
+  std::vector<Entry>
+  get_summary() const;
+
+  /**
+   * Write the summary computed by get_summary() as a table to @p out, with
+   * the memory given in MB. Like get_summary(), this function must be called
+   * on all processes; use a ConditionalOStream to print only on one of
+   * them.
+   */
+  template <typename StreamType>
+  void
+  print(StreamType &out) const;
+
+  /**
+   * Remove all entries.
+   */
+  void
+  clear();
+
+private:
+  /**
+   * The communicator over which the entries are summarized.
+   */
+  const MPI_Comm mpi_communicator;
+
+  /**
+   * The names and the memory in bytes of all entries on this process, in
+   * the order in which they were added.
+   */
+  std::vector<std::pair<std::string, std::size_t>> entries;
+
+  /**
+   * The position of each entry in @p entries, by name.
+   */
+  std::map<std::string, unsigned int> entry_indices;
+
+  /**
+   * The names of the entries recorded by sample_process_memory().
+   */
+  std::vector<std::string> process_memory_entries;
+};
+
+
+
+/* ---------------------- inline and template functions ------------------- */
+
+
+template <typename T>
+inline void
+MemoryReport::add_object(const std::string &name, const T &object)
+{
+  add(name, MemoryConsumption::memory_consumption(object));
+}
+
+
+
+template <typename StreamType>
+inline void
+MemoryReport::print(StreamType &out) const
+{
+  const std::vector<Entry> summary = get_summary();
+
+  std::size_t name_width = 10;
+  for (const Entry &entry : summary)
+    name_width = std::max(name_width, entry.name.size());
+
+  std::ostringstream table;
+  table << "Memory consumption in MB over "
+        << Utilities::MPI::n_mpi_processes(mpi_communicator)
+        << " processes:" << std::endl
+        << std::left << std::setw(name_width + 2) << "  Entry" << std::right
+        << std::setw(12) << "min" << std::setw(12) << "avg" << std::setw(12)
+        << "max" << std::setw(14) << "sum" << std::endl;
+  table << std::fixed << std::setprecision(2);
+  for (const Entry &entry : summary)
+    table << "  " << std::left << std::setw(name_width) << entry.name
+          << std::right << std::setw(12) << 1e-6 * entry.memory.min
+          << std::setw(12) << 1e-6 * entry.memory.avg << std::setw(12)
+          << 1e-6 * entry.memory.max << std::setw(14)
+          << 1e-6 * entry.memory.sum << std::endl;
+  out << table.str();
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -22,6 +22,7 @@
 #include <deal.II/base/cuda.h>
 #include <deal.II/base/exceptions.h>
 
+#include <functional>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -129,7 +130,10 @@ namespace MemorySpace
       std::copy(begin, begin + n_elements, values.get());
     }
 
-    std::unique_ptr<Number[], decltype(&std::free)> values;
+    // The deleter is a general function object rather than a plain function
+    // pointer to std::free in order to also support memory that is not
+    // allocated with posix_memalign, such as MPI-3 shared memory windows.
+    std::unique_ptr<Number[], std::function<void(Number *)>> values;
 
     // This is not used but it allows to simplify the code until we start using
     // CUDA-aware MPI.
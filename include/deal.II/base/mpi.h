@@ -21,6 +21,7 @@
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/numbers.h>
 
+#include <functional>
 #include <map>
 #include <numeric>
 #include <set>
@@ -531,6 +532,283 @@ namespace Utilities
     MinMaxAvg
     min_max_avg(const double my_value, const MPI_Comm &mpi_communicator);
 
+    /**
+     * Same as above, but for several values at once. The results for all
+     * entries of @p my_values are computed with a single collective
+     * operation, which is much cheaper than calling the function above for
+     * each value. All processes must pass vectors of the same length.
+     */
+    std::vector<MinMaxAvg>
+    min_max_avg(const std::vector<double> &my_values,
+                const MPI_Comm &           mpi_communicator);
+
+    /**
+     * A class that combines several independent reductions over the
+     * processes of an
+     * @ref GlossMPICommunicator "MPI communicator"
+     * into as few collective operations as possible. Calling sum(), max(),
+     * or min() several times in a row, e.g., for the norms of several
+     * vectors or the integrals of several quantities, results in one
+     * <code>MPI_Allreduce</code> per call, each of which is dominated by the
+     * latency of the network for small amounts of data. Instead, one can
+     * register all values with an object of this class and reduce them
+     * together:
+     * @code
+     *   double norm_u, norm_p, h_min;
+     *   Utilities::MPI::ReductionAggregator reductions(mpi_communicator);
+     *   reductions.add_sum(local_norm_u, norm_u);
+     *   reductions.add_sum(local_norm_p, norm_p);
+     *   reductions.add_min(local_h_min, h_min);
+     *   reductions.reduce();
+     * @endcode
+     *
+     * All sums are computed in one collective operation, and all maxima and
+     * minima in a second one, the minima being computed as the negative
+     * maxima of the negative values. The two operations are started as
+     * non-blocking operations by reduce_start() and run concurrently, so
+     * that the cost is essentially the one of a single reduction. Local work
+     * that does not depend on the results can be placed between
+     * reduce_start() and reduce_finish() to overlap it with the
+     * communication.
+     *
+     * The values are reduced as <code>double</code>. Integers such as counts
+     * of cells are represented exactly up to $2^{53}$.
+     *
+     * Once reduce_finish() has returned, the registered values are cleared
+     * and the object can be used for the next batch of reductions, reusing
+     * the memory allocated before.
+     *
+     * @note All processes of the communicator need to register the same
+     * number of values with the same operations in the same order.
+     *
+     * @note The references given to the add functions need to stay valid
+     * until reduce_finish() has been called, which is the point where the
+     * results are written to them.
+     */
+    class ReductionAggregator
+    {
+    public:
+      /**
+       * Constructor. The reductions are performed over the processes of
+       * @p mpi_communicator.
+       */
+      explicit ReductionAggregator(const MPI_Comm &mpi_communicator);
+
+      /**
+       * Destructor. Waits for a reduction started by reduce_start() that
+       * has not been finished yet.
+       */
+      ~ReductionAggregator();
+
+      /**
+       * Register @p value to be summed over all processes. The sum is
+       * written to @p result by reduce_finish().
+       */
+      void
+      add_sum(const double value, double &result);
+
+      /**
+       * Register @p value for the computation of the maximum over all
+       * processes. The maximum is written to @p result by reduce_finish().
+       */
+      void
+      add_max(const double value, double &result);
+
+      /**
+       * Register @p value for the computation of the minimum over all
+       * processes. The minimum is written to @p result by reduce_finish().
+       */
+      void
+      add_min(const double value, double &result);
+
+      /**
+       * Like the function above, but for each entry of @p values, whose sums
+       * are written to the corresponding entries of @p results. Tensors can
+       * be given by make_array_view().
+       */
+      void
+      add_sum(const ArrayView<const double> &values,
+              const ArrayView<double> &      results);
+
+      /**
+       * Like the function above, but for each entry of @p values, whose
+       * maxima are written to the corresponding entries of @p results.
+       */
+      void
+      add_max(const ArrayView<const double> &values,
+              const ArrayView<double> &      results);
+
+      /**
+       * Like the function above, but for each entry of @p values, whose
+       * minima are written to the corresponding entries of @p results.
+       */
+      void
+      add_min(const ArrayView<const double> &values,
+              const ArrayView<double> &      results);
+
+      /**
+       * Register all entries of the tensor @p local to be summed over all
+       * processes. The sum is written to @p result by reduce_finish().
+       */
+      template <int rank, int dim>
+      void
+      add_sum(const Tensor<rank, dim, double> &local,
+              Tensor<rank, dim, double> &      result);
+
+      /**
+       * Start the reductions of all values registered since the last call
+       * of reduce_finish(). This is a collective operation on the processes
+       * of the communicator given to the constructor.
+       */
+      void
+      reduce_start();
+
+      /**
+       * Wait for the reductions started by reduce_start(), write the results
+       * to the variables given to the add functions, and clear the list of
+       * registered values.
+       */
+      void
+      reduce_finish();
+
+      /**
+       * Call reduce_start() and reduce_finish().
+       */
+      void
+      reduce();
+
+      /**
+       * Return the number of values registered since the last call of
+       * reduce_finish().
+       */
+      unsigned int
+      n_values() const;
+
+    private:
+      /**
+       * The communicator over which the values are reduced.
+       */
+      const MPI_Comm mpi_communicator;
+
+      /**
+       * The values to be summed and the addresses of their results.
+       */
+      std::vector<double>   sum_values;
+      std::vector<double *> sum_results;
+
+      /**
+       * The values for which the maxima are computed, and the addresses of
+       * their results. The values registered by add_min() are stored with
+       * the opposite sign, which is indicated by the flags in
+       * #max_value_is_negated.
+       */
+      std::vector<double>   max_values;
+      std::vector<double *> max_results;
+      std::vector<bool>     max_value_is_negated;
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The requests of the non-blocking reductions of the sums and the
+       * maxima.
+       */
+      MPI_Request requests[2];
+#endif
+
+      /**
+       * Whether reduce_start() has been called without a subsequent call of
+       * reduce_finish().
+       */
+      bool reduction_is_active;
+    };
+
+    /**
+     * A class that represents the result of a non-blocking collective
+     * operation, e.g., a reduction started with <code>MPI_Iallreduce</code>.
+     * The operation runs in the background while the program does other
+     * work, and get() waits for its completion and returns the result:
+     * @code
+     *   Utilities::MPI::Future<double> norm = residual.l2_norm_start();
+     *   ... // local work that does not depend on the norm
+     *   if (norm.get() < tolerance)
+     *     ...
+     * @endcode
+     *
+     * An object of this class is constructed from two functions: The first
+     * one waits for the completion of the operation, e.g., by calling
+     * <code>MPI_Wait</code>, and the second one returns the result and
+     * releases the resources of the operation. If get() is not called, the
+     * destructor waits for the completion of the operation, as the
+     * resources of the operation must not be released while it is still
+     * running.
+     */
+    template <typename T>
+    class Future
+    {
+    public:
+      /**
+       * Constructor. @p wait_operation waits for the completion of the
+       * operation, and @p get_and_cleanup_operation returns its result.
+       */
+      Future(const std::function<void()> &wait_operation,
+             const std::function<T()> &   get_and_cleanup_operation);
+
+      /**
+       * The copy constructor is deleted because the result can only be
+       * obtained once.
+       */
+      Future(const Future &) = delete;
+
+      /**
+       * Move constructor.
+       */
+      Future(Future &&other) noexcept;
+
+      /**
+       * Destructor. Waits for the completion of the operation if get() has
+       * not been called. Since a destructor must not throw, errors during
+       * this wait are only reported in debug mode. Call wait() or get()
+       * before the object goes out of scope to have them thrown as
+       * exceptions.
+       */
+      ~Future();
+
+      /**
+       * Wait for the completion of the operation without obtaining its
+       * result.
+       */
+      void
+      wait();
+
+      /**
+       * Wait for the completion of the operation and return its result.
+       * This function can only be called once.
+       */
+      T
+      get();
+
+    private:
+      /**
+       * The function waiting for the completion of the operation.
+       */
+      std::function<void()> wait_function;
+
+      /**
+       * The function returning the result of the operation.
+       */
+      std::function<T()> get_and_cleanup_function;
+
+      /**
+       * Whether wait() has already been called.
+       */
+      bool is_done;
+
+      /**
+       * Whether get() has already been called. This is also set for objects
+       * that have been moved from.
+       */
+      bool get_was_called;
+    };
+
     /**
      * A class that is used to initialize the MPI system at the beginning of a
      * program and to shut it down again at the end. It also allows you to
@@ -1188,6 +1466,13 @@ namespace Utilities
      * barrier, it reduces the memory consumption significantly. This function
      * is suited for large-scale simulations with >100k MPI ranks.
      *
+     * @note The index sets @p owned_indices need not be contiguous: the
+     * ownership information is set up and queried in terms of the contiguous
+     * ranges of the index sets, such that the cost of this function is
+     * proportional to the number of such ranges rather than to the number of
+     * indices. This makes the function also suitable for index sets that
+     * have been renumbered.
+     *
      * @param[in] owned_indices Index set with indices locally owned by this
      *            process.
      * @param[in] indices_to_look_up Index set containing indices of which the
@@ -1217,6 +1502,98 @@ namespace Utilities
                  const ArrayView<T> &      output);
     }
 
+    template <int rank, int dim>
+    inline void
+    ReductionAggregator::add_sum(const Tensor<rank, dim, double> &local,
+                                 Tensor<rank, dim, double> &      result)
+    {
+      add_sum(make_array_view(local), make_array_view(result));
+    }
+
+
+
+    inline unsigned int
+    ReductionAggregator::n_values() const
+    {
+      return sum_values.size() + max_values.size();
+    }
+
+
+
+    template <typename T>
+    inline Future<T>::Future(
+      const std::function<void()> &wait_operation,
+      const std::function<T()> &   get_and_cleanup_operation)
+      : wait_function(wait_operation)
+      , get_and_cleanup_function(get_and_cleanup_operation)
+      , is_done(false)
+      , get_was_called(false)
+    {}
+
+
+
+    template <typename T>
+    inline Future<T>::Future(Future &&other) noexcept
+      : wait_function(std::move(other.wait_function))
+      , get_and_cleanup_function(std::move(other.get_and_cleanup_function))
+      , is_done(other.is_done)
+      , get_was_called(other.get_was_called)
+    {
+      other.is_done        = true;
+      other.get_was_called = true;
+    }
+
+
+
+    template <typename T>
+    inline Future<T>::~Future()
+    {
+      // waiting may fail with an exception, e.g. from AssertThrowMPI, which
+      // must not leave the destructor. report the error instead
+      if (get_was_called == false)
+        try
+          {
+            wait();
+            get_and_cleanup_function();
+          }
+        catch (...)
+          {
+            AssertNothrow(false,
+                          ExcMessage(
+                            "The operation of a Future that was destroyed "
+                            "without calling get() failed while waiting for "
+                            "its completion."));
+          }
+    }
+
+
+
+    template <typename T>
+    inline void
+    Future<T>::wait()
+    {
+      if (is_done == false)
+        {
+          wait_function();
+          is_done = true;
+        }
+    }
+
+
+
+    template <typename T>
+    inline T
+    Future<T>::get()
+    {
+      Assert(get_was_called == false,
+             ExcMessage("The result of a Future can only be obtained once."));
+      wait();
+      get_was_called = true;
+      return get_and_cleanup_function();
+    }
+
+
+
     // Since these depend on N they must live in the header file
     template <typename T, unsigned int N>
     void
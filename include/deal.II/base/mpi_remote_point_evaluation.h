@@ -0,0 +1,449 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mpi_remote_point_evaluation_h
+#define dealii_mpi_remote_point_evaluation_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    /**
+     * A class that evaluates quantities on a distributed mesh at a fixed set
+     * of arbitrary points that may be owned by other processes. In reinit(),
+     * the points given by each process are located on the mesh with
+     * GridTools::distributed_compute_point_locations(), and the cells and
+     * reference coordinates of the points on the locally owned cells as
+     * well as the communication pattern needed to send the results back to
+     * the processes that asked for the points are stored. Afterwards,
+     * evaluate_and_process() can be called any number of times, e.g., once
+     * per time step, to evaluate a field at the points, which only involves
+     * one point-to-point exchange of the evaluated values with the
+     * processes involved. VectorTools::point_values() uses this class to
+     * evaluate finite element solutions.
+     *
+     * Points that lie on the boundary between cells might be found on more
+     * than one cell or process, in which case several values are returned
+     * for them, and points outside the mesh are not found at all. The
+     * values of point @p i are at the positions
+     * <tt>get_point_ptrs()[i]</tt> to <tt>get_point_ptrs()[i+1]</tt> of the
+     * result of evaluate_and_process(). The functions is_map_unique() and
+     * all_points_found() allow to check for these cases.
+     *
+     * The triangulation and the mapping passed to reinit() need to live as
+     * long as the current object is used, and reinit() needs to be called
+     * again whenever the mesh or the points change. For triangulations that
+     * are not derived from parallel::TriangulationBase, all points are
+     * located on the local triangulation and no communication takes place.
+     */
+    template <int dim, int spacedim = dim>
+    class RemotePointEvaluation
+    {
+    public:
+      /**
+       * The cells and reference points on the locally owned part of the
+       * mesh at which the quantities need to be evaluated, as passed to the
+       * evaluation function of evaluate_and_process().
+       */
+      struct CellData
+      {
+        /**
+         * The level and index of the cells.
+         */
+        std::vector<std::pair<int, int>> cells;
+
+        /**
+         * The range of entries of @p reference_point_values that belongs to
+         * each cell, with cell @p i using the entries starting at
+         * <tt>reference_point_ptrs[i]</tt> up to
+         * <tt>reference_point_ptrs[i+1]</tt>.
+         */
+        std::vector<unsigned int> reference_point_ptrs;
+
+        /**
+         * The reference coordinates of the points within the cells.
+         */
+        std::vector<Point<dim>> reference_point_values;
+      };
+
+      /**
+       * Constructor. Create an empty object that needs to be set up with
+       * reinit() before it can be used.
+       */
+      RemotePointEvaluation();
+
+      /**
+       * Locate the @p points given by the current process on the
+       * triangulation @p tria with the given @p mapping, and set up the
+       * data structures and the communication pattern for the evaluation at
+       * these points. This is a collective operation.
+       */
+      void
+      reinit(const std::vector<Point<spacedim>> &points,
+             const Triangulation<dim, spacedim> &tria,
+             const Mapping<dim, spacedim> &      mapping);
+
+      /**
+       * Evaluate a quantity at the points of all processes that lie on the
+       * locally owned cells, and send the results to the processes that
+       * asked for the points. The @p evaluation_function is called once with
+       * the cell data returned by get_cell_data() and needs to fill the
+       * given array with the values at all reference points of all cells,
+       * in the order of CellData::reference_point_values. After the
+       * exchange, @p output contains the values at the points passed to
+       * reinit() by the current process, arranged as described by
+       * get_point_ptrs(). The array @p buffer is used for the values before
+       * the exchange and can be kept between calls to avoid reallocation.
+       * This is a collective operation.
+       *
+       * The type @p T needs to be serializable by Utilities::pack().
+       */
+      template <typename T>
+      void
+      evaluate_and_process(
+        std::vector<T> &output,
+        std::vector<T> &buffer,
+        const std::function<void(const ArrayView<T> &, const CellData &)>
+          &evaluation_function) const;
+
+      /**
+       * Return the cells and reference points on the locally owned part of
+       * the mesh where quantities need to be evaluated.
+       */
+      const CellData &
+      get_cell_data() const;
+
+      /**
+       * Return the range of entries of the output of evaluate_and_process()
+       * for each of the points passed to reinit(), with the values of
+       * point @p i starting at <tt>get_point_ptrs()[i]</tt> up to
+       * <tt>get_point_ptrs()[i+1]</tt>.
+       */
+      const std::vector<unsigned int> &
+      get_point_ptrs() const;
+
+      /**
+       * Return whether each point of all processes has been found on exactly
+       * one cell.
+       */
+      bool
+      is_map_unique() const;
+
+      /**
+       * Return whether each point of all processes has been found on at
+       * least one cell.
+       */
+      bool
+      all_points_found() const;
+
+      /**
+       * Return the triangulation passed to reinit().
+       */
+      const Triangulation<dim, spacedim> &
+      get_triangulation() const;
+
+      /**
+       * Return the mapping passed to reinit().
+       */
+      const Mapping<dim, spacedim> &
+      get_mapping() const;
+
+      /**
+       * Return whether reinit() has been called.
+       */
+      bool
+      is_ready() const;
+
+    private:
+      /**
+       * The MPI communicator of the triangulation, or MPI_COMM_SELF for
+       * serial triangulations.
+       */
+      MPI_Comm communicator;
+
+      /**
+       * The triangulation passed to reinit().
+       */
+      SmartPointer<const Triangulation<dim, spacedim>> tria;
+
+      /**
+       * The mapping passed to reinit().
+       */
+      SmartPointer<const Mapping<dim, spacedim>> mapping;
+
+      /**
+       * The cells and reference points on the locally owned cells.
+       */
+      CellData cell_data;
+
+      /**
+       * The position in the send buffer, which is sorted by the ranks of
+       * the receiving processes, of each entry of the evaluated values in
+       * the order of @p cell_data.
+       */
+      std::vector<unsigned int> send_permutation;
+
+      /**
+       * The ranks the evaluated values are sent to, in ascending order and
+       * possibly including the own rank.
+       */
+      std::vector<unsigned int> send_ranks;
+
+      /**
+       * The range of entries of the send buffer for each rank in
+       * @p send_ranks.
+       */
+      std::vector<unsigned int> send_ptrs;
+
+      /**
+       * The ranks values are received from, in ascending order and possibly
+       * including the own rank.
+       */
+      std::vector<unsigned int> recv_ranks;
+
+      /**
+       * The range of entries of the receive buffer for each rank in
+       * @p recv_ranks.
+       */
+      std::vector<unsigned int> recv_ptrs;
+
+      /**
+       * The position in the output of each received value.
+       */
+      std::vector<unsigned int> recv_permutation;
+
+      /**
+       * The range of entries of the output for each point.
+       */
+      std::vector<unsigned int> point_ptrs;
+
+      /**
+       * Whether all points have been found on exactly one cell.
+       */
+      bool unique_mapping;
+
+      /**
+       * Whether all points have been found on at least one cell.
+       */
+      bool all_points_found_flag;
+
+      /**
+       * Whether reinit() has been called.
+       */
+      bool ready_flag;
+    };
+
+
+
+    /* ---------------------- template functions ------------------------- */
+
+#ifndef DOXYGEN
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::evaluate_and_process(
+      std::vector<T> &output,
+      std::vector<T> &buffer,
+      const std::function<void(const ArrayView<T> &, const CellData &)>
+        &evaluation_function) const
+    {
+      Assert(ready_flag,
+             ExcMessage("You need to call reinit() before evaluating."));
+
+      buffer.resize(send_permutation.size());
+      evaluation_function(make_array_view(buffer), cell_data);
+
+      // sort the values by the receiving ranks
+      std::vector<T> send_buffer(send_permutation.size());
+      for (unsigned int i = 0; i < send_permutation.size(); ++i)
+        send_buffer[send_permutation[i]] = buffer[i];
+
+      output.resize(point_ptrs.back());
+
+      const unsigned int my_rank = this_mpi_process(communicator);
+
+#  ifdef DEAL_II_WITH_MPI
+      // the communication pattern is known, so post the sends and receive
+      // from the known ranks without any further handshake
+      const int                      mpi_tag = 22;
+      std::vector<std::vector<char>> send_data(send_ranks.size());
+      std::vector<MPI_Request>       send_requests;
+      send_requests.reserve(send_ranks.size());
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        if (send_ranks[i] != my_rank)
+          {
+            send_data[i] = Utilities::pack(
+              std::vector<T>(send_buffer.begin() + send_ptrs[i],
+                             send_buffer.begin() + send_ptrs[i + 1]),
+              false);
+            send_requests.emplace_back();
+            const int ierr = MPI_Isend(send_data[i].data(),
+                                       send_data[i].size(),
+                                       MPI_CHAR,
+                                       send_ranks[i],
+                                       mpi_tag,
+                                       communicator,
+                                       &send_requests.back());
+            AssertThrowMPI(ierr);
+          }
+#  endif
+
+      // the values for the own rank are copied directly
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        if (send_ranks[i] == my_rank)
+          {
+            const auto it =
+              std::lower_bound(recv_ranks.begin(), recv_ranks.end(), my_rank);
+            Assert(it != recv_ranks.end() && *it == my_rank,
+                   ExcInternalError());
+            const unsigned int j = it - recv_ranks.begin();
+            AssertDimension(send_ptrs[i + 1] - send_ptrs[i],
+                            recv_ptrs[j + 1] - recv_ptrs[j]);
+            for (unsigned int k = 0; k < send_ptrs[i + 1] - send_ptrs[i]; ++k)
+              output[recv_permutation[recv_ptrs[j] + k]] =
+                send_buffer[send_ptrs[i] + k];
+          }
+
+#  ifdef DEAL_II_WITH_MPI
+      std::vector<char> recv_data;
+      for (unsigned int j = 0; j < recv_ranks.size(); ++j)
+        if (recv_ranks[j] != my_rank)
+          {
+            MPI_Status status;
+            int        ierr =
+              MPI_Probe(recv_ranks[j], mpi_tag, communicator, &status);
+            AssertThrowMPI(ierr);
+
+            int message_length;
+            ierr = MPI_Get_count(&status, MPI_CHAR, &message_length);
+            AssertThrowMPI(ierr);
+            recv_data.resize(message_length);
+
+            ierr = MPI_Recv(recv_data.data(),
+                            message_length,
+                            MPI_CHAR,
+                            recv_ranks[j],
+                            mpi_tag,
+                            communicator,
+                            MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+
+            const std::vector<T> values =
+              Utilities::unpack<std::vector<T>>(recv_data, false);
+            AssertDimension(values.size(), recv_ptrs[j + 1] - recv_ptrs[j]);
+            for (unsigned int k = 0; k < values.size(); ++k)
+              output[recv_permutation[recv_ptrs[j] + k]] = values[k];
+          }
+
+      const int ierr = MPI_Waitall(send_requests.size(),
+                                   send_requests.data(),
+                                   MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+#  endif
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const typename RemotePointEvaluation<dim, spacedim>::CellData &
+    RemotePointEvaluation<dim, spacedim>::get_cell_data() const
+    {
+      return cell_data;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const std::vector<unsigned int> &
+    RemotePointEvaluation<dim, spacedim>::get_point_ptrs() const
+    {
+      return point_ptrs;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    RemotePointEvaluation<dim, spacedim>::is_map_unique() const
+    {
+      return unique_mapping;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    RemotePointEvaluation<dim, spacedim>::all_points_found() const
+    {
+      return all_points_found_flag;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const Triangulation<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_triangulation() const
+    {
+      return *tria;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const Mapping<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_mapping() const
+    {
+      return *mapping;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    RemotePointEvaluation<dim, spacedim>::is_ready() const
+    {
+      return ready_flag;
+    }
+
+#endif // DOXYGEN
+
+  } // end of namespace MPI
+} // end of namespace Utilities
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
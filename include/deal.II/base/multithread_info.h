@@ -108,6 +108,28 @@ public:
   static bool
   is_running_single_threaded();
 
+  /**
+   * Pin each thread of the TBB thread pool to one of the cores that the
+   * current process is allowed to run on, in a round-robin fashion. The set
+   * of allowed cores is the affinity mask of the process at the time of the
+   * call, which is usually set by the MPI launcher or by tools like
+   * <tt>taskset</tt> and <tt>numactl</tt>. For hybrid MPI and TBB programs
+   * in which each MPI process is bound to a part of a node, e.g., one NUMA
+   * domain, this keeps the worker threads of WorkStream,
+   * parallel::apply_to_subranges(), MatrixFree, etc., on the cores of this
+   * process and prevents the operating system from migrating them between
+   * cores, which destroys the locality of the data in the caches and the
+   * local memory.
+   *
+   * The threads are pinned when they join the scheduler of TBB the next
+   * time, and stay pinned for the rest of the program. The thread calling
+   * this function is pinned as well once it executes tasks. This function
+   * is only implemented on Linux. On other systems, and if deal.II is
+   * configured without multithreading, it does nothing.
+   */
+  static void
+  pin_threads();
+
   /**
    * Make sure the multithreading API is initialized. This normally does not
    * need to be called in usercode.
@@ -31,6 +31,9 @@
 #include <deal.II/lac/vector_operation.h>
 
 #include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -191,6 +194,63 @@ namespace Utilities
       set_ghost_indices(const IndexSet &ghost_indices,
                         const IndexSet &larger_ghost_index_set = IndexSet());
 
+      /**
+       * Select whether the ghost values are exchanged in
+       * export_to_ghosted_array_start() by a single MPI neighborhood
+       * collective (MPI_Ineighbor_alltoallv) on a distributed graph
+       * communicator instead of individual point-to-point messages to each
+       * neighbor. The graph communicator is set up by this function and
+       * again by every later call to set_ghost_indices(). Giving the MPI
+       * implementation the full communication pattern of the exchange
+       * allows it to optimize the pattern, which can reduce the latency of
+       * small and frequent ghost exchanges.
+       *
+       * This function is a collective operation and needs to be called on
+       * all processes of the communicator. The option has no effect if
+       * deal.II is configured with an MPI implementation that does not
+       * support MPI 3.0.
+       *
+       * @note Neighborhood collectives do not have tags. Consequently, all
+       * processes have to start ghost exchanges with this partitioner in the
+       * same order, and the argument @p communication_channel of
+       * export_to_ghosted_array_start() is ignored. The reverse operation
+       * import_from_ghosted_array_start() keeps using point-to-point
+       * messages.
+       */
+      void
+      enable_neighborhood_collectives(const bool enable = true);
+
+      /**
+       * Select whether the point-to-point messages of
+       * export_to_ghosted_array_start() and import_from_ghosted_array_start()
+       * use persistent MPI requests. The requests are created by
+       * MPI_Recv_init() and MPI_Send_init() the first time an exchange is
+       * started with a given ghost array, temporary storage, and
+       * communication channel, and every later exchange with the same arrays
+       * only starts them by MPI_Start(). This avoids setting up the same
+       * messages again in every call, which is a noticeable part of the cost
+       * of small and frequent exchanges as on the coarse levels of a
+       * multigrid method or in explicit time stepping.
+       *
+       * Since the requests are bound to the addresses of the arrays, this
+       * option pays off for vectors that keep their memory between the
+       * exchanges, like LinearAlgebra::distributed::Vector. The requests of
+       * at most a fixed number of array pairs are kept, exchanges with
+       * further arrays use regular non-blocking messages. All requests are
+       * freed when the ghost indices are set again, when the option is
+       * switched off, and with the last copy of this object.
+       *
+       * The option only affects the calling process, as persistent messages
+       * match regular ones. If neighborhood collectives are enabled, they
+       * take precedence for export_to_ghosted_array_start().
+       *
+       * @note The requests are created within the const communication
+       * functions, so exchanges with the same partitioner must not be
+       * started from several threads at the same time.
+       */
+      void
+      enable_persistent_requests(const bool enable = true);
+
       /**
        * Return the global size.
        */
@@ -578,6 +638,35 @@ namespace Utilities
       void
       initialize_import_indices_plain_dev() const;
 
+      /**
+       * Set up neighborhood_communicator and the associated arrays of
+       * message sizes from the current communication pattern if
+       * use_neighborhood_collectives is set, or release it otherwise.
+       */
+      void
+      setup_neighborhood_communicator();
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * Return the persistent requests for the exchange from the import
+       * array @p import_array to the ghost array @p ghost_array if
+       * @p export_to_ghosts is true, or in the reverse direction otherwise,
+       * for entries of @p bytes_per_entry bytes on the channel
+       * @p communication_channel. The requests are created on first use.
+       * The order of the requests is the one used by
+       * export_to_ghosted_array_start() and
+       * import_from_ghosted_array_start(), respectively, i.e., the
+       * receives come first. Return a null pointer if no persistent
+       * requests are used.
+       */
+      const std::vector<MPI_Request> *
+      get_persistent_requests(const bool         export_to_ghosts,
+                              const unsigned int communication_channel,
+                              const unsigned int bytes_per_entry,
+                              void *             ghost_array,
+                              void *             import_array) const;
+#endif
+
       /**
        * The global size of the vector over all processors
        */
@@ -692,6 +781,61 @@ namespace Utilities
        * A variable storing whether the ghost indices have been explicitly set.
        */
       bool have_ghost_indices;
+
+      /**
+       * A variable storing whether the ghost values are exchanged by a
+       * neighborhood collective, see enable_neighborhood_collectives().
+       */
+      bool use_neighborhood_collectives;
+
+      /**
+       * The distributed graph communicator used for neighborhood
+       * collectives, with the ghost targets as sources and the import
+       * targets as destinations. Empty if neighborhood collectives are not
+       * used. The communicator is shared between copies of this object and
+       * freed together with the last one.
+       */
+      std::shared_ptr<MPI_Comm> neighborhood_communicator;
+
+      /**
+       * The number of ghost entries received from each source of
+       * neighborhood_communicator and their offsets in the ghost array.
+       */
+      std::vector<int> neighborhood_ghost_counts;
+      std::vector<int> neighborhood_ghost_displacements;
+
+      /**
+       * The number of entries sent to each destination of
+       * neighborhood_communicator and their offsets in the array of import
+       * data.
+       */
+      std::vector<int> neighborhood_import_counts;
+      std::vector<int> neighborhood_import_displacements;
+
+      /**
+       * A variable storing whether the point-to-point messages use
+       * persistent requests, see enable_persistent_requests().
+       */
+      bool use_persistent_requests;
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The persistent requests created by get_persistent_requests(),
+       * indexed by the direction of the exchange, the communication
+       * channel, the size of the entries, and the addresses of the ghost
+       * array and the import array. Like neighborhood_communicator, the
+       * requests are shared between copies of this object and freed
+       * together with the last one.
+       */
+      mutable std::shared_ptr<
+        std::map<std::tuple<bool,
+                            unsigned int,
+                            unsigned int,
+                            const void *,
+                            const void *>,
+                 std::vector<MPI_Request>>>
+        persistent_requests;
+#endif
     };
 
 
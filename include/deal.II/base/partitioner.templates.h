@@ -65,8 +65,13 @@ namespace Utilities
 
       // Need to send and receive the data. Use non-blocking communication,
       // where it is usually less overhead to first initiate the receive and
-      // then actually send the data
-      requests.resize(n_import_targets + n_ghost_targets);
+      // then actually send the data. With a neighborhood collective, all
+      // messages are started at once after the data has been packed.
+      const bool use_neighborhood_collective =
+        static_cast<bool>(neighborhood_communicator);
+      requests.resize(use_neighborhood_collective ?
+                        1 :
+                        n_import_targets + n_ghost_targets);
 
       // as a ghost array pointer, put the data at the end of the given ghost
       // array in case we want to fill only a subset of the ghosts so that we
@@ -80,22 +85,43 @@ namespace Utilities
         use_larger_set ? ghost_array.data() + n_ghost_indices_in_larger_set -
                            n_ghost_indices() :
                          ghost_array.data();
-
-      for (unsigned int i = 0; i < n_ghost_targets; i++)
+      Number *const ghost_array_start = ghost_array_ptr;
+
+      // with persistent requests, the messages have been set up before and
+      // only need to be started
+      const std::vector<MPI_Request> *persistent =
+        use_neighborhood_collective ?
+          nullptr :
+          get_persistent_requests(true,
+                                  communication_channel,
+                                  sizeof(Number),
+                                  ghost_array_start,
+                                  temporary_storage.data());
+      if (persistent != nullptr)
         {
-          // allow writing into ghost indices even though we are in a
-          // const function
-          const int ierr =
-            MPI_Irecv(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      ghost_targets_data[i].first + communication_channel,
-                      communicator,
-                      &requests[i]);
-          AssertThrowMPI(ierr);
-          ghost_array_ptr += ghost_targets_data[i].second;
+          std::copy(persistent->begin(), persistent->end(), requests.begin());
+          if (n_ghost_targets > 0)
+            {
+              const int ierr = MPI_Startall(n_ghost_targets, requests.data());
+              AssertThrowMPI(ierr);
+            }
         }
+      else if (!use_neighborhood_collective)
+        for (unsigned int i = 0; i < n_ghost_targets; i++)
+          {
+            // allow writing into ghost indices even though we are in a
+            // const function
+            const int ierr =
+              MPI_Irecv(ghost_array_ptr,
+                        ghost_targets_data[i].second * sizeof(Number),
+                        MPI_BYTE,
+                        ghost_targets_data[i].first,
+                        ghost_targets_data[i].first + communication_channel,
+                        communicator,
+                        &requests[i]);
+            AssertThrowMPI(ierr);
+            ghost_array_ptr += ghost_targets_data[i].second;
+          }
 
       Number *temp_array_ptr = temporary_storage.data();
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
@@ -126,6 +152,11 @@ namespace Utilities
                   import_indices_plain_dev[i].first.get(),
                   locally_owned_array.data(),
                   chunk_size);
+
+              // the kernel runs asynchronously, wait until the data is
+              // packed before handing it to MPI
+              const cudaError_t cuda_error = cudaDeviceSynchronize();
+              AssertCuda(cuda_error);
             }
           else
 #    endif
@@ -153,17 +184,57 @@ namespace Utilities
             }
 
           // start the send operations
-          const int ierr =
-            MPI_Isend(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      my_pid + communication_channel,
-                      communicator,
-                      &requests[n_ghost_targets + i]);
-          AssertThrowMPI(ierr);
+          if (persistent != nullptr)
+            {
+              const int ierr = MPI_Start(&requests[n_ghost_targets + i]);
+              AssertThrowMPI(ierr);
+            }
+          else if (!use_neighborhood_collective)
+            {
+              const int ierr =
+                MPI_Isend(temp_array_ptr,
+                          import_targets_data[i].second * sizeof(Number),
+                          MPI_BYTE,
+                          import_targets_data[i].first,
+                          my_pid + communication_channel,
+                          communicator,
+                          &requests[n_ghost_targets + i]);
+              AssertThrowMPI(ierr);
+            }
           temp_array_ptr += import_targets_data[i].second;
         }
+
+#    if DEAL_II_MPI_VERSION_GTE(3, 0)
+      if (use_neighborhood_collective)
+        {
+          // the message sizes are given in units of Number. The data type
+          // may be freed as soon as the operation has been started
+          MPI_Datatype number_type;
+          int ierr =
+            MPI_Type_contiguous(sizeof(Number), MPI_BYTE, &number_type);
+          AssertThrowMPI(ierr);
+          ierr = MPI_Type_commit(&number_type);
+          AssertThrowMPI(ierr);
+
+          ierr = MPI_Ineighbor_alltoallv(
+            temporary_storage.data(),
+            neighborhood_import_counts.data(),
+            neighborhood_import_displacements.data(),
+            number_type,
+            ghost_array_start,
+            neighborhood_ghost_counts.data(),
+            neighborhood_ghost_displacements.data(),
+            number_type,
+            *neighborhood_communicator,
+            &requests[0]);
+          AssertThrowMPI(ierr);
+
+          ierr = MPI_Type_free(&number_type);
+          AssertThrowMPI(ierr);
+        }
+#    else
+      (void)ghost_array_start;
+#    endif
     }
 
 
@@ -182,7 +253,9 @@ namespace Utilities
 
       // wait for both sends and receives to complete, even though only
       // receives are really necessary. this gives (much) better performance
-      AssertDimension(ghost_targets().size() + import_targets().size(),
+      AssertDimension(neighborhood_communicator ?
+                        1 :
+                        ghost_targets().size() + import_targets().size(),
                       requests.size());
       if (requests.size() > 0)
         {
@@ -301,6 +374,17 @@ namespace Utilities
       const unsigned int channel = communication_channel + 401;
       requests.resize(n_import_targets + n_ghost_targets);
 
+      // with persistent requests, the messages have been set up before and
+      // only need to be started
+      const std::vector<MPI_Request> *persistent =
+        get_persistent_requests(false,
+                                communication_channel,
+                                sizeof(Number),
+                                ghost_array.data(),
+                                temporary_storage.data());
+      if (persistent != nullptr)
+        std::copy(persistent->begin(), persistent->end(), requests.begin());
+
       // initiate the receive operations
       Number *temp_array_ptr = temporary_storage.data();
       for (unsigned int i = 0; i < n_import_targets; i++)
@@ -313,13 +397,15 @@ namespace Utilities
                        "The number of ghost entries times the size of 'Number' "
                        "exceeds this value. This is not supported."));
           const int ierr =
-            MPI_Irecv(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      import_targets_data[i].first + channel,
-                      communicator,
-                      &requests[i]);
+            persistent != nullptr ?
+              MPI_Start(&requests[i]) :
+              MPI_Irecv(temp_array_ptr,
+                        import_targets_data[i].second * sizeof(Number),
+                        MPI_BYTE,
+                        import_targets_data[i].first,
+                        import_targets_data[i].first + channel,
+                        communicator,
+                        &requests[i]);
           AssertThrowMPI(ierr);
           temp_array_ptr += import_targets_data[i].second;
         }
@@ -401,13 +487,15 @@ namespace Utilities
                        "The number of ghost entries times the size of 'Number' "
                        "exceeds this value. This is not supported."));
           const int ierr =
-            MPI_Isend(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      this_mpi_process() + channel,
-                      communicator,
-                      &requests[n_import_targets + i]);
+            persistent != nullptr ?
+              MPI_Start(&requests[n_import_targets + i]) :
+              MPI_Isend(ghost_array_ptr,
+                        ghost_targets_data[i].second * sizeof(Number),
+                        MPI_BYTE,
+                        ghost_targets_data[i].first,
+                        this_mpi_process() + channel,
+                        communicator,
+                        &requests[n_import_targets + i]);
           AssertThrowMPI(ierr);
 
           ghost_array_ptr += ghost_targets_data[i].second;
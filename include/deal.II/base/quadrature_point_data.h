@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/std_cxx17/optional.h>
 #include <deal.II/base/subscriptor.h>
@@ -32,6 +33,8 @@
 
 #include <deal.II/lac/vector.h>
 
+#include <cstring>
+#include <functional>
 #include <map>
 #include <type_traits>
 #include <vector>
@@ -254,6 +257,227 @@ private:
 };
 
 
+/**
+ * A class for storing a fixed number of objects of type @p DataType at the
+ * quadrature points of each active cell, as an alternative to
+ * CellDataStorage for the common case where all cells store the same
+ * number of objects of a single, trivially copyable type, such as the
+ * history variables of a plasticity model. Rather than storing a map from
+ * cells to vectors of pointers, this class keeps the data of all cells in
+ * a single contiguous array indexed by the active cell index. Accessing
+ * the data of a cell therefore neither involves a lookup nor any pointer
+ * indirection, and the data of the quadrature points of one cell is
+ * adjacent in memory.
+ *
+ * Since the data is addressed by the active cell index, it can also be
+ * accessed from within a MatrixFree loop by translating a cell batch and
+ * a lane into a cell with MatrixFree::get_cell_iterator(), and passing
+ * the active_cell_index() of that cell to get_data().
+ *
+ * The active cell indices change whenever the triangulation is refined or
+ * coarsened. For a parallel::distributed::Triangulation, the data can be
+ * transferred to the new mesh with prepare_for_coarsening_and_refinement()
+ * and interpolate(), which send the raw bytes of the objects of each cell
+ * without any serialization. Upon refinement, each child receives a copy
+ * of the data of its parent, and upon coarsening, the data of the parent
+ * is determined by a user-provided coarsening strategy, which defaults to
+ * taking the data of the first child. This piecewise constant transfer is
+ * appropriate for data like the history variables mentioned above. For
+ * other triangulations, the data needs to be initialized again after a
+ * change of the mesh.
+ *
+ * @note The data is allocated on all active cells, not only on the locally
+ * owned ones, but is only transferred on the locally owned cells.
+ */
+template <typename CellIteratorType, typename DataType>
+class ContiguousCellDataStorage : public Subscriptor
+{
+public:
+  static_assert(std::is_trivially_copyable<DataType>::value,
+                "ContiguousCellDataStorage can only store trivially "
+                "copyable data types.");
+
+  /**
+   * Number of dimensions
+   */
+  static constexpr unsigned int dimension =
+    CellIteratorType::AccessorType::dimension;
+
+  /**
+   * Number of space dimensions
+   */
+  static constexpr unsigned int space_dimension =
+    CellIteratorType::AccessorType::space_dimension;
+
+  /**
+   * The type of a function that determines the data on the @p n_q_points
+   * quadrature points of a parent cell from the data of its children, see
+   * prepare_for_coarsening_and_refinement(). The data of the children is
+   * given in the order of their child index.
+   */
+  using CoarseningStrategy =
+    std::function<void(const std::vector<ArrayView<const DataType>> &children,
+                       const ArrayView<DataType> &                   parent)>;
+
+  /**
+   * Default constructor.
+   */
+  ContiguousCellDataStorage();
+
+  /**
+   * Allocate @p n_q_points objects on every active cell of @p triangulation
+   * and set them to @p initial_value. Any previously stored data is
+   * discarded. The triangulation is taken by non-const reference because
+   * prepare_for_coarsening_and_refinement() and interpolate() attach the
+   * data transfer to it.
+   */
+  void
+  initialize(Triangulation<dimension, space_dimension> &triangulation,
+             const unsigned int                         n_q_points,
+             const DataType &initial_value = DataType());
+
+  /**
+   * Release all stored data.
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of objects stored on each cell.
+   */
+  unsigned int
+  n_quadrature_points() const;
+
+  /**
+   * Return a view to the objects stored on @p cell.
+   */
+  ArrayView<DataType>
+  get_data(const CellIteratorType &cell);
+
+  /**
+   * Return a view to the objects stored on @p cell.
+   */
+  ArrayView<const DataType>
+  get_data(const CellIteratorType &cell) const;
+
+  /**
+   * Return a view to the objects stored on the cell with the active cell
+   * index @p active_cell_index.
+   */
+  ArrayView<DataType>
+  get_data(const unsigned int active_cell_index);
+
+  /**
+   * Return a view to the objects stored on the cell with the active cell
+   * index @p active_cell_index.
+   */
+  ArrayView<const DataType>
+  get_data(const unsigned int active_cell_index) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+#ifdef DEAL_II_WITH_P4EST
+  /**
+   * Prepare the transfer of the stored data to the mesh that results from
+   * the next call to
+   * parallel::distributed::Triangulation::execute_coarsening_and_refinement()
+   * or parallel::distributed::Triangulation::repartition() of the
+   * triangulation this object was initialized with. The function
+   * @p coarsening_strategy determines the data on cells whose children are
+   * coarsened.
+   */
+  void
+  prepare_for_coarsening_and_refinement(
+    const CoarseningStrategy &coarsening_strategy = CoarseningStrategy());
+
+  /**
+   * Resize the stored data to the current set of active cells, and fill
+   * it with the data that was sent on the previous mesh by the function
+   * prepare_for_coarsening_and_refinement().
+   */
+  void
+  interpolate();
+#endif
+
+private:
+#ifdef DEAL_II_WITH_P4EST
+  /**
+   * Return the triangulation this object was initialized with as a
+   * parallel::distributed::Triangulation, which is required for the
+   * transfer of the data.
+   */
+  parallel::distributed::Triangulation<dimension, space_dimension> &
+  get_distributed_triangulation();
+
+  /**
+   * A callback function used to pack the data of @p cell into the buffer
+   * the triangulation transfers to the new mesh.
+   */
+  std::vector<char>
+  pack_callback(
+    const typename parallel::distributed::
+      Triangulation<dimension, space_dimension>::cell_iterator &cell,
+    const typename parallel::distributed::
+      Triangulation<dimension, space_dimension>::CellStatus status);
+
+  /**
+   * A callback function used to unpack the data of @p cell that has been
+   * packed by pack_callback() on the previous mesh.
+   */
+  void
+  unpack_callback(
+    const typename parallel::distributed::
+      Triangulation<dimension, space_dimension>::cell_iterator &cell,
+    const typename parallel::distributed::
+      Triangulation<dimension, space_dimension>::CellStatus status,
+    const boost::iterator_range<std::vector<char>::const_iterator>
+      &data_range);
+#endif
+
+  /**
+   * The function used to determine the data on coarsened cells.
+   */
+  CoarseningStrategy coarsening_strategy;
+
+  /**
+   * The handle that the parallel::distributed::Triangulation has assigned
+   * to this object while registering the pack_callback function.
+   */
+  unsigned int handle;
+
+  /**
+   * The triangulation on whose active cells the data is stored.
+   */
+  SmartPointer<Triangulation<dimension, space_dimension>,
+               ContiguousCellDataStorage<CellIteratorType, DataType>>
+    tria;
+
+  /**
+   * The number of objects stored on each cell.
+   */
+  unsigned int n_q_points;
+
+  /**
+   * The objects of all cells. The objects of the cell with active cell
+   * index <tt>c</tt> are stored in the range starting at
+   * <tt>c*n_q_points</tt>.
+   */
+  std::vector<DataType> data;
+
+  /**
+   * @addtogroup Exceptions
+   */
+  DeclExceptionMsg(
+    ExcTriangulationMismatch,
+    "The provided cell iterator does not belong to the triangulation that corresponds to the ContiguousCellDataStorage object.");
+};
+
+
 /**
  * An abstract class which specifies requirements for data on
  * a single quadrature point to be transferable during refinement or
@@ -810,6 +1034,298 @@ CellDataStorage<CellIteratorType, DataType>::try_get_data(
     }
 }
 
+//--------------------------------------------------------------------
+//                    ContiguousCellDataStorage
+//--------------------------------------------------------------------
+
+template <typename CellIteratorType, typename DataType>
+inline ContiguousCellDataStorage<CellIteratorType, DataType>::
+  ContiguousCellDataStorage()
+  : handle(numbers::invalid_unsigned_int)
+  , n_q_points(0)
+{}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::initialize(
+  Triangulation<dimension, space_dimension> &triangulation,
+  const unsigned int                         n_q_points,
+  const DataType &                           initial_value)
+{
+  tria             = &triangulation;
+  this->n_q_points = n_q_points;
+
+  // assign a new vector rather than resizing the old one, such that the
+  // memory is released if the new data is smaller
+  std::vector<DataType>(static_cast<std::size_t>(n_q_points) *
+                          triangulation.n_active_cells(),
+                        initial_value)
+    .swap(data);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::clear()
+{
+  tria       = nullptr;
+  n_q_points = 0;
+  std::vector<DataType>().swap(data);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline unsigned int
+ContiguousCellDataStorage<CellIteratorType, DataType>::n_quadrature_points()
+  const
+{
+  return n_q_points;
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline ArrayView<DataType>
+ContiguousCellDataStorage<CellIteratorType, DataType>::get_data(
+  const CellIteratorType &cell)
+{
+  Assert(&cell->get_triangulation() == tria, ExcTriangulationMismatch());
+  return get_data(cell->active_cell_index());
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline ArrayView<const DataType>
+ContiguousCellDataStorage<CellIteratorType, DataType>::get_data(
+  const CellIteratorType &cell) const
+{
+  Assert(&cell->get_triangulation() == tria, ExcTriangulationMismatch());
+  return get_data(cell->active_cell_index());
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline ArrayView<DataType>
+ContiguousCellDataStorage<CellIteratorType, DataType>::get_data(
+  const unsigned int active_cell_index)
+{
+  AssertIndexRange(static_cast<std::size_t>(active_cell_index) * n_q_points,
+                   data.size() + (n_q_points == 0 ? 1 : 0));
+  return ArrayView<DataType>(
+    data.data() + static_cast<std::size_t>(active_cell_index) * n_q_points,
+    n_q_points);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline ArrayView<const DataType>
+ContiguousCellDataStorage<CellIteratorType, DataType>::get_data(
+  const unsigned int active_cell_index) const
+{
+  AssertIndexRange(static_cast<std::size_t>(active_cell_index) * n_q_points,
+                   data.size() + (n_q_points == 0 ? 1 : 0));
+  return ArrayView<const DataType>(
+    data.data() + static_cast<std::size_t>(active_cell_index) * n_q_points,
+    n_q_points);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std::size_t
+ContiguousCellDataStorage<CellIteratorType, DataType>::memory_consumption()
+  const
+{
+  return sizeof(*this) + data.capacity() * sizeof(DataType);
+}
+
+
+
+#  ifdef DEAL_II_WITH_P4EST
+
+template <typename CellIteratorType, typename DataType>
+inline parallel::distributed::Triangulation<
+  ContiguousCellDataStorage<CellIteratorType, DataType>::dimension,
+  ContiguousCellDataStorage<CellIteratorType, DataType>::space_dimension> &
+ContiguousCellDataStorage<CellIteratorType,
+                          DataType>::get_distributed_triangulation()
+{
+  Assert(tria != nullptr, ExcNotInitialized());
+  auto *distributed_tria = dynamic_cast<
+    parallel::distributed::Triangulation<dimension, space_dimension> *>(
+    &*tria);
+  Assert(distributed_tria != nullptr,
+         ExcMessage("The data can only be transferred on a "
+                    "parallel::distributed::Triangulation."));
+  return *distributed_tria;
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::
+  prepare_for_coarsening_and_refinement(
+    const CoarseningStrategy &coarsening_strategy)
+{
+  Assert(handle == numbers::invalid_unsigned_int,
+         ExcMessage("You can only call this function once before calling "
+                    "interpolate()."));
+
+  this->coarsening_strategy = coarsening_strategy;
+
+  handle = get_distributed_triangulation().register_data_attach(
+    std::bind(
+      &ContiguousCellDataStorage<CellIteratorType, DataType>::pack_callback,
+      this,
+      std::placeholders::_1,
+      std::placeholders::_2),
+    /*returns_variable_size_data=*/false);
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::interpolate()
+{
+  Assert(handle != numbers::invalid_unsigned_int,
+         ExcMessage("You need to call prepare_for_coarsening_and_refinement() "
+                    "before you can call interpolate()."));
+
+  // the data on the old mesh has been packed already, so the storage can
+  // be sized for the new set of active cells before unpacking
+  std::vector<DataType>(static_cast<std::size_t>(n_q_points) *
+                        tria->n_active_cells())
+    .swap(data);
+
+  get_distributed_triangulation().notify_ready_to_unpack(
+    handle,
+    std::bind(
+      &ContiguousCellDataStorage<CellIteratorType, DataType>::unpack_callback,
+      this,
+      std::placeholders::_1,
+      std::placeholders::_2,
+      std::placeholders::_3));
+
+  handle = numbers::invalid_unsigned_int;
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline std::vector<char>
+ContiguousCellDataStorage<CellIteratorType, DataType>::pack_callback(
+  const typename parallel::distributed::
+    Triangulation<dimension, space_dimension>::cell_iterator &cell,
+  const typename parallel::distributed::
+    Triangulation<dimension, space_dimension>::CellStatus status)
+{
+  const std::size_t bytes_per_cell = sizeof(DataType) * n_q_points;
+  std::vector<char> buffer(bytes_per_cell);
+  if (bytes_per_cell == 0)
+    return buffer;
+
+  switch (status)
+    {
+      case parallel::distributed::Triangulation<dimension, space_dimension>::
+        CELL_PERSIST:
+      case parallel::distributed::Triangulation<dimension, space_dimension>::
+        CELL_REFINE:
+        // the children of a cell to be refined do not exist yet, so we
+        // send the data of the cell itself
+        std::memcpy(buffer.data(),
+                    get_data(cell->active_cell_index()).data(),
+                    bytes_per_cell);
+        break;
+
+      case parallel::distributed::Triangulation<dimension, space_dimension>::
+        CELL_COARSEN:
+        {
+          std::vector<ArrayView<const DataType>> children_data;
+          children_data.reserve(cell->n_children());
+          for (unsigned int child_index = 0; child_index < cell->n_children();
+               ++child_index)
+            {
+              const auto child = cell->child(child_index);
+              Assert(child->active() && child->coarsen_flag_set(),
+                     typename dealii::Triangulation<
+                       dimension>::ExcInconsistentCoarseningFlags());
+              children_data.push_back(get_data(child->active_cell_index()));
+            }
+
+          if (coarsening_strategy)
+            {
+              std::vector<DataType> parent_data(n_q_points);
+              coarsening_strategy(children_data, make_array_view(parent_data));
+              std::memcpy(buffer.data(), parent_data.data(), bytes_per_cell);
+            }
+          else
+            std::memcpy(buffer.data(), children_data[0].data(), bytes_per_cell);
+          break;
+        }
+
+      default:
+        Assert(false, ExcInternalError());
+        break;
+    }
+
+  return buffer;
+}
+
+
+
+template <typename CellIteratorType, typename DataType>
+inline void
+ContiguousCellDataStorage<CellIteratorType, DataType>::unpack_callback(
+  const typename parallel::distributed::
+    Triangulation<dimension, space_dimension>::cell_iterator &cell,
+  const typename parallel::distributed::
+    Triangulation<dimension, space_dimension>::CellStatus status,
+  const boost::iterator_range<std::vector<char>::const_iterator> &data_range)
+{
+  const std::size_t bytes_per_cell = sizeof(DataType) * n_q_points;
+  AssertDimension(static_cast<std::size_t>(data_range.size()), bytes_per_cell);
+  if (bytes_per_cell == 0)
+    return;
+
+  switch (status)
+    {
+      case parallel::distributed::Triangulation<dimension, space_dimension>::
+        CELL_PERSIST:
+      case parallel::distributed::Triangulation<dimension, space_dimension>::
+        CELL_COARSEN:
+        std::memcpy(get_data(cell->active_cell_index()).data(),
+                    &*data_range.begin(),
+                    bytes_per_cell);
+        break;
+
+      case parallel::distributed::Triangulation<dimension, space_dimension>::
+        CELL_REFINE:
+        // the children inherit the data of their parent
+        for (unsigned int child_index = 0; child_index < cell->n_children();
+             ++child_index)
+          std::memcpy(
+            get_data(cell->child(child_index)->active_cell_index()).data(),
+            &*data_range.begin(),
+            bytes_per_cell);
+        break;
+
+      default:
+        Assert(false, ExcInternalError());
+        break;
+    }
+}
+
+#  endif // DEAL_II_WITH_P4EST
+
 //--------------------------------------------------------------------
 //                    ContinuousQuadratureDataTransfer
 //--------------------------------------------------------------------
@@ -478,6 +478,131 @@ swap(T *&t1, SmartPointer<T, P> &t2)
   t2.swap(t1);
 }
 
+
+
+/**
+ * A non-owning pointer that is checked like a SmartPointer in debug mode, but
+ * is a plain pointer in release mode.
+ *
+ * In debug mode, this class stores a SmartPointer and thus subscribes to the
+ * object pointed to, so that the destruction of the object while it is still
+ * pointed to and the use of a pointer to an object that has been destroyed
+ * or moved from are detected. In release mode, no subscription takes place,
+ * i.e., creating, copying, and destroying an object of this class neither
+ * touches the counter of the Subscriptor nor any lock. This class is meant
+ * for data structures such as the views of FEValues that are created in
+ * large numbers and whose lifetime is known to be nested in the one of the
+ * object they point to. In all other places, SmartPointer should be used.
+ *
+ * The template argument P has the same meaning as for SmartPointer.
+ *
+ * @ingroup memory
+ */
+template <typename T, typename P = void>
+class CheckedPointer
+{
+public:
+  /**
+   * Constructor. Sets the pointer to @p t, which may be a null pointer.
+   */
+  CheckedPointer(T *t = nullptr);
+
+  /**
+   * Assignment operator for normal pointers.
+   */
+  CheckedPointer<T, P> &
+  operator=(T *tt);
+
+  /**
+   * Set the pointer to a null pointer. In contrast to SmartPointer::clear(),
+   * this function does not delete the object pointed to.
+   */
+  void
+  clear();
+
+  /**
+   * Conversion to normal pointer.
+   */
+  operator T *() const;
+
+  /**
+   * Dereferencing operator. In debug mode, this function throws an
+   * exception if the pointer is a null pointer or the object pointed to is
+   * no longer alive.
+   */
+  T &operator*() const;
+
+  /**
+   * Dereferencing operator. In debug mode, this function throws an
+   * exception if the pointer is a null pointer or the object pointed to is
+   * no longer alive.
+   */
+  T *operator->() const;
+
+private:
+  /**
+   * The pointer to the object.
+   */
+#ifdef DEBUG
+  SmartPointer<T, P> t;
+#else
+  T *t;
+#endif
+};
+
+
+
+/* --------------------- inline CheckedPointer functions ------------------- */
+
+
+template <typename T, typename P>
+inline CheckedPointer<T, P>::CheckedPointer(T *t)
+  : t(t)
+{}
+
+
+
+template <typename T, typename P>
+inline CheckedPointer<T, P> &
+CheckedPointer<T, P>::operator=(T *tt)
+{
+  t = tt;
+  return *this;
+}
+
+
+
+template <typename T, typename P>
+inline void
+CheckedPointer<T, P>::clear()
+{
+  t = nullptr;
+}
+
+
+
+template <typename T, typename P>
+inline CheckedPointer<T, P>::operator T *() const
+{
+  return t;
+}
+
+
+
+template <typename T, typename P>
+inline T &CheckedPointer<T, P>::operator*() const
+{
+  return *t;
+}
+
+
+
+template <typename T, typename P>
+inline T *CheckedPointer<T, P>::operator->() const
+{
+  return &(*t);
+}
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
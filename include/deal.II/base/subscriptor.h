@@ -56,6 +56,18 @@ DEAL_II_NAMESPACE_OPEN
  * The current subscribers to this class can be obtained by calling
  * list_subscribers().
  *
+ * Recording the names and validity flags of the subscribers requires a
+ * global mutex and memory allocations on every call of subscribe() and
+ * unsubscribe(), i.e., whenever a SmartPointer is created or destroyed. If
+ * deal.II was configured with <tt>DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR=ON</tt>,
+ * the release version of this class therefore only counts the subscriptions
+ * in an atomic counter. In this mode, the SmartPointer objects subscribing to
+ * an object are not invalidated when that object is moved from or destroyed,
+ * and list_subscribers() only prints the number of subscriptions. Programs
+ * that run without errors in debug mode are not affected by this. Internal
+ * data structures that do not need to subscribe at all in release mode use
+ * CheckedPointer instead of SmartPointer.
+ *
  * @ingroup memory
  * @author Guido Kanschat, Daniel Arndt, 1998 - 2005, 2018
  */
@@ -210,6 +222,7 @@ private:
    */
   mutable std::atomic<unsigned int> counter;
 
+#if !defined(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR) || defined(DEBUG)
   /**
    * In this map, we count subscriptions for each different identification
    * string supplied to subscribe().
@@ -231,6 +244,7 @@ private:
    * objects that subscribe to this class.
    */
   mutable std::vector<std::atomic<bool> *> validity_pointers;
+#endif
 
   /**
    * Pointer to the typeinfo object of this object, from which we can later
@@ -308,11 +322,15 @@ template <typename StreamType>
 inline void
 Subscriptor::list_subscribers(StreamType &stream) const
 {
+#if !defined(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR) || defined(DEBUG)
   std::lock_guard<std::mutex> lock(mutex);
 
   for (const auto &it : counter_map)
     stream << it.second << '/' << counter << " subscriptions from \""
            << it.first << '\"' << std::endl;
+#else
+  stream << counter << " subscriptions" << std::endl;
+#endif
 }
 
 DEAL_II_NAMESPACE_CLOSE
@@ -21,10 +21,12 @@
 #include <deal.II/base/table_indices.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <limits>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -1442,6 +1444,114 @@ namespace internal
       }
     };
 
+
+    // The pivot search of the general implementation above compares the
+    // entries of the tensor, which is not possible for VectorizedArray. Here,
+    // the pivots are searched and the rows are interchanged separately for
+    // each lane, whereas the elimination works on all lanes at once.
+    template <typename Number, int width>
+    struct Inverse<4, 3, VectorizedArray<Number, width>>
+    {
+      static dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>>
+      value(
+        const dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>> &t)
+      {
+        dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>> tmp = t;
+
+        const unsigned int N = 6;
+
+        VectorizedArray<Number, width> diagonal_sum = Number(0.);
+        for (unsigned int i = 0; i < N; ++i)
+          diagonal_sum += std::abs(tmp.data[i][i]);
+        const VectorizedArray<Number, width> typical_diagonal_element =
+          diagonal_sum / Number(N);
+        (void)typical_diagonal_element;
+
+        unsigned int p[width][N];
+        for (unsigned int v = 0; v < width; ++v)
+          for (unsigned int i = 0; i < N; ++i)
+            p[v][i] = i;
+
+        for (unsigned int j = 0; j < N; ++j)
+          {
+            for (unsigned int v = 0; v < width; ++v)
+              {
+                // Pivot search in lane v
+                Number       max = std::abs(tmp.data[j][j][v]);
+                unsigned int r   = j;
+                for (unsigned int i = j + 1; i < N; ++i)
+                  if (std::abs(tmp.data[i][j][v]) > max)
+                    {
+                      max = std::abs(tmp.data[i][j][v]);
+                      r   = i;
+                    }
+
+                // Check whether the pivot is too small
+                Assert(max > 1.e-16 * typical_diagonal_element[v],
+                       ExcMessage("This tensor seems to be noninvertible"));
+
+                // Row interchange in lane v
+                if (r > j)
+                  {
+                    for (unsigned int k = 0; k < N; ++k)
+                      std::swap(tmp.data[j][k][v], tmp.data[r][k][v]);
+
+                    std::swap(p[v][j], p[v][r]);
+                  }
+              }
+
+            // Transformation
+            const VectorizedArray<Number, width> hr =
+              Number(1.) / tmp.data[j][j];
+            tmp.data[j][j] = hr;
+            for (unsigned int k = 0; k < N; ++k)
+              {
+                if (k == j)
+                  continue;
+                for (unsigned int i = 0; i < N; ++i)
+                  {
+                    if (i == j)
+                      continue;
+                    tmp.data[i][k] -= tmp.data[i][j] * tmp.data[j][k] * hr;
+                  }
+              }
+            for (unsigned int i = 0; i < N; ++i)
+              {
+                tmp.data[i][j] *= hr;
+                tmp.data[j][i] *= -hr;
+              }
+            tmp.data[j][j] = hr;
+          }
+
+        // Column interchange
+        Number hv[N];
+        for (unsigned int i = 0; i < N; ++i)
+          for (unsigned int v = 0; v < width; ++v)
+            {
+              for (unsigned int k = 0; k < N; ++k)
+                hv[p[v][k]] = tmp.data[i][k][v];
+              for (unsigned int k = 0; k < N; ++k)
+                tmp.data[i][k][v] = hv[k];
+            }
+
+        // Scale rows and columns. The mult matrix
+        // here is diag[1, 1, 1, 1/2, 1/2, 1/2].
+        for (unsigned int i = 3; i < 6; ++i)
+          for (unsigned int j = 0; j < 3; ++j)
+            tmp.data[i][j] *= Number(0.5);
+
+        for (unsigned int i = 0; i < 3; ++i)
+          for (unsigned int j = 3; j < 6; ++j)
+            tmp.data[i][j] *= Number(0.5);
+
+        for (unsigned int i = 3; i < 6; ++i)
+          for (unsigned int j = 3; j < 6; ++j)
+            tmp.data[i][j] *= Number(0.25);
+
+        return tmp;
+      }
+    };
+
   } // namespace SymmetricTensorImplementation
 } // namespace internal
 
@@ -2798,6 +2908,117 @@ eigenvalues(const SymmetricTensor<2, 3, Number> &T);
 
 
 
+/**
+ * Return the eigenvalues of a symmetric 1x1 tensor of rank 2 whose entries
+ * are of type VectorizedArray, i.e., the eigenvalues of a batch of tensors.
+ *
+ * @relatesalso SymmetricTensor
+ */
+template <typename Number, int width>
+inline std::array<VectorizedArray<Number, width>, 1>
+eigenvalues(const SymmetricTensor<2, 1, VectorizedArray<Number, width>> &T)
+{
+  return {{T[0][0]}};
+}
+
+
+
+/**
+ * Return the eigenvalues of a symmetric 2x2 tensor of rank 2 whose entries
+ * are of type VectorizedArray, i.e., the eigenvalues of a batch of tensors.
+ * The array of eigenvalues is sorted in descending order for each lane.
+ *
+ * In contrast to the implementation for scalar types, the eigenvalues are
+ * computed as $\frac 12 (T_{00}+T_{11}) \pm \sqrt{\frac 14
+ * (T_{00}-T_{11})^2 + T_{01}^2}$, which does not need to distinguish diagonal
+ * tensors and avoids the cancellation in the discriminant of the
+ * characteristic polynomial.
+ *
+ * @relatesalso SymmetricTensor
+ */
+template <typename Number, int width>
+inline std::array<VectorizedArray<Number, width>, 2>
+eigenvalues(const SymmetricTensor<2, 2, VectorizedArray<Number, width>> &T)
+{
+  const VectorizedArray<Number, width> mean =
+    Number(0.5) * (T[0][0] + T[1][1]);
+  const VectorizedArray<Number, width> half_difference =
+    Number(0.5) * (T[0][0] - T[1][1]);
+  const VectorizedArray<Number, width> radius =
+    std::sqrt(half_difference * half_difference + T[0][1] * T[0][1]);
+  return {{mean + radius, mean - radius}};
+}
+
+
+
+/**
+ * Return the eigenvalues of a symmetric 3x3 tensor of rank 2 whose entries
+ * are of type VectorizedArray, i.e., the eigenvalues of a batch of tensors.
+ * The array of eigenvalues is sorted in descending order for each lane.
+ *
+ * The eigenvalues are computed with the same trigonometric solution of the
+ * characteristic equation as for scalar types, but the special cases
+ * (diagonal tensors, arguments of the inverse cosine outside of $[-1,1]$
+ * due to roundoff) are handled without branches such that all lanes are
+ * processed with the same instructions. Only the inverse cosine is
+ * evaluated lane by lane. The same warning about the accuracy for
+ * (nearly) equal eigenvalues applies.
+ *
+ * @relatesalso SymmetricTensor
+ */
+template <typename Number, int width>
+inline std::array<VectorizedArray<Number, width>, 3>
+eigenvalues(const SymmetricTensor<2, 3, VectorizedArray<Number, width>> &T)
+{
+  using VectorizedArrayType = VectorizedArray<Number, width>;
+
+  // Decompose T = p*B + q*I as in the scalar case. If T is a multiple of
+  // the identity, p is zero and B is set to zero, which results in three
+  // equal eigenvalues q.
+  const VectorizedArrayType tr_T = trace(T);
+  const VectorizedArrayType q    = tr_T * Number(1. / 3.);
+  const VectorizedArrayType upp_tri_sq =
+    T[0][1] * T[0][1] + T[0][2] * T[0][2] + T[1][2] * T[1][2];
+  const VectorizedArrayType tmp1 = (T[0][0] - q) * (T[0][0] - q) +
+                                   (T[1][1] - q) * (T[1][1] - q) +
+                                   (T[2][2] - q) * (T[2][2] - q) +
+                                   Number(2.) * upp_tri_sq;
+  const VectorizedArrayType p    = std::sqrt(tmp1 * Number(1. / 6.));
+  const VectorizedArrayType zero = Number(0.);
+  const VectorizedArrayType one  = Number(1.);
+  const VectorizedArrayType inverse_p =
+    compare_and_apply_mask<SIMDComparison::equal>(p, zero, zero, one / p);
+  const SymmetricTensor<2, 3, VectorizedArrayType> B =
+    inverse_p * (T - q * unit_symmetric_tensor<3, VectorizedArrayType>());
+
+  // Clamp the argument of the inverse cosine to [-1,1] to correct for
+  // roundoff errors
+  const VectorizedArrayType tmp_2 =
+    std::max(std::min(Number(0.5) * determinant(B), one), -one);
+  VectorizedArrayType phi;
+  for (unsigned int v = 0; v < width; ++v)
+    phi[v] = std::acos(tmp_2[v]) * Number(1. / 3.);
+
+  std::array<VectorizedArrayType, 3> eig_vals;
+  eig_vals[0] = q + Number(2.) * p * std::cos(phi);
+  eig_vals[2] =
+    q + Number(2.) * p * std::cos(phi + Number(2. / 3. * numbers::PI));
+  eig_vals[1] = tr_T - eig_vals[0] - eig_vals[2];
+
+  // The trigonometric solution returns the eigenvalues in descending order,
+  // but roundoff might swap (nearly) equal eigenvalues
+  const VectorizedArrayType max_01 = std::max(eig_vals[0], eig_vals[1]);
+  const VectorizedArrayType min_01 = std::min(eig_vals[0], eig_vals[1]);
+  eig_vals[0]                      = std::max(max_01, eig_vals[2]);
+  const VectorizedArrayType min_2  = std::min(max_01, eig_vals[2]);
+  eig_vals[1]                      = std::max(min_01, min_2);
+  eig_vals[2]                      = std::min(min_01, min_2);
+
+  return eig_vals;
+}
+
+
+
 namespace internal
 {
   namespace SymmetricTensorImplementation
@@ -3127,6 +3348,191 @@ eigenvectors(const SymmetricTensor<2, dim, Number> &T,
 
 
 
+namespace internal
+{
+  namespace SymmetricTensorImplementation
+  {
+    /**
+     * Compute the eigenvalues and eigenvectors of a batch of real-valued
+     * rank-2 symmetric tensors whose entries are of type VectorizedArray,
+     * using the cyclic Jacobi algorithm. Each rotation is computed without
+     * branches, so that all lanes are processed with the same instructions;
+     * sweeps are performed until the off-diagonal entries of all lanes are
+     * negligible compared to the diagonal ones.
+     *
+     * @param[in] A The tensors of which the eigenvectors and eigenvalues are
+     * to be computed.
+     *
+     * @return An array containing the eigenvectors and the associated
+     * eigenvalues, sorted in descending order of the eigenvalues for each
+     * lane.
+     */
+    template <int dim, typename Number, int width>
+    std::array<std::pair<VectorizedArray<Number, width>,
+                         Tensor<1, dim, VectorizedArray<Number, width>>>,
+               dim>
+    vectorized_jacobi(
+      dealii::SymmetricTensor<2, dim, VectorizedArray<Number, width>> A)
+    {
+      using VectorizedArrayType = VectorizedArray<Number, width>;
+
+      const VectorizedArrayType zero = Number(0.);
+      const VectorizedArrayType one  = Number(1.);
+      const Number              tolerance =
+        std::numeric_limits<Number>::epsilon() *
+        std::numeric_limits<Number>::epsilon();
+
+      // The eigenvectors are the columns of the accumulated rotations
+      Tensor<2, dim, VectorizedArrayType> V;
+      for (unsigned int i = 0; i < dim; ++i)
+        V[i][i] = one;
+
+      const unsigned int max_n_sweeps = 50;
+      for (unsigned int sweep = 0; sweep < max_n_sweeps; ++sweep)
+        {
+          VectorizedArrayType off_diagonal_sq = zero, diagonal_sq = zero;
+          for (unsigned int p = 0; p < dim; ++p)
+            {
+              diagonal_sq += A[p][p] * A[p][p];
+              for (unsigned int q = p + 1; q < dim; ++q)
+                off_diagonal_sq += A[p][q] * A[p][q];
+            }
+          bool converged = true;
+          for (unsigned int v = 0; v < width; ++v)
+            if (off_diagonal_sq[v] > tolerance * diagonal_sq[v])
+              converged = false;
+          if (converged)
+            break;
+
+          for (unsigned int p = 0; p < dim; ++p)
+            for (unsigned int q = p + 1; q < dim; ++q)
+              {
+                // Compute the rotation that annihilates A[p][q]. Lanes in
+                // which A[p][q] is already zero get the identity rotation.
+                const VectorizedArrayType a_pq = A[p][q];
+                const VectorizedArrayType a_pq_nonzero =
+                  compare_and_apply_mask<SIMDComparison::equal>(a_pq,
+                                                                zero,
+                                                                one,
+                                                                a_pq);
+                const VectorizedArrayType theta =
+                  (A[q][q] - A[p][p]) / (Number(2.) * a_pq_nonzero);
+                const VectorizedArrayType t_abs =
+                  one / (std::abs(theta) + std::sqrt(theta * theta + one));
+                const VectorizedArrayType t =
+                  compare_and_apply_mask<SIMDComparison::equal>(
+                    a_pq,
+                    zero,
+                    zero,
+                    compare_and_apply_mask<SIMDComparison::less_than>(
+                      theta, zero, -t_abs, t_abs));
+                const VectorizedArrayType c = one / std::sqrt(t * t + one);
+                const VectorizedArrayType s = t * c;
+
+                A[p][p] -= t * a_pq;
+                A[q][q] += t * a_pq;
+                A[p][q] = zero;
+                for (unsigned int r = 0; r < dim; ++r)
+                  if (r != p && r != q)
+                    {
+                      const VectorizedArrayType a_rp = A[r][p];
+                      const VectorizedArrayType a_rq = A[r][q];
+                      A[r][p]                        = c * a_rp - s * a_rq;
+                      A[r][q]                        = s * a_rp + c * a_rq;
+                    }
+                for (unsigned int r = 0; r < dim; ++r)
+                  {
+                    const VectorizedArrayType v_rp = V[r][p];
+                    const VectorizedArrayType v_rq = V[r][q];
+                    V[r][p]                        = c * v_rp - s * v_rq;
+                    V[r][q]                        = s * v_rp + c * v_rq;
+                  }
+              }
+        }
+
+      std::array<
+        std::pair<VectorizedArrayType, Tensor<1, dim, VectorizedArrayType>>,
+        dim>
+        eig_vals_vecs;
+      for (unsigned int e = 0; e < dim; ++e)
+        {
+          eig_vals_vecs[e].first = A[e][e];
+          for (unsigned int r = 0; r < dim; ++r)
+            eig_vals_vecs[e].second[r] = V[r][e];
+        }
+
+      // Sort the eigenpairs of each lane in descending order of the
+      // eigenvalues with a sorting network of compare-and-swap operations
+      for (unsigned int i = 0; i + 1 < dim; ++i)
+        for (unsigned int j = 0; j + 1 < dim - i; ++j)
+          {
+            const VectorizedArrayType lambda_0 = eig_vals_vecs[j].first;
+            const VectorizedArrayType lambda_1 = eig_vals_vecs[j + 1].first;
+            eig_vals_vecs[j].first =
+              compare_and_apply_mask<SIMDComparison::less_than>(lambda_0,
+                                                                lambda_1,
+                                                                lambda_1,
+                                                                lambda_0);
+            eig_vals_vecs[j + 1].first =
+              compare_and_apply_mask<SIMDComparison::less_than>(lambda_0,
+                                                                lambda_1,
+                                                                lambda_0,
+                                                                lambda_1);
+            for (unsigned int r = 0; r < dim; ++r)
+              {
+                const VectorizedArrayType v_0 = eig_vals_vecs[j].second[r];
+                const VectorizedArrayType v_1 =
+                  eig_vals_vecs[j + 1].second[r];
+                eig_vals_vecs[j].second[r] =
+                  compare_and_apply_mask<SIMDComparison::less_than>(lambda_0,
+                                                                    lambda_1,
+                                                                    v_1,
+                                                                    v_0);
+                eig_vals_vecs[j + 1].second[r] =
+                  compare_and_apply_mask<SIMDComparison::less_than>(lambda_0,
+                                                                    lambda_1,
+                                                                    v_0,
+                                                                    v_1);
+              }
+          }
+
+      return eig_vals_vecs;
+    }
+  } // namespace SymmetricTensorImplementation
+} // namespace internal
+
+
+
+/**
+ * Return the eigenvalues and eigenvectors of a batch of real-valued rank-2
+ * symmetric tensors whose entries are of type VectorizedArray, as they arise
+ * when evaluating constitutive laws on the quadrature points of a batch of
+ * cells with FEEvaluation. The array of matched eigenvalue and eigenvector
+ * pairs is sorted in descending order of the eigenvalues for each lane.
+ *
+ * The algorithms for scalar types branch on the data, which prevents
+ * processing the lanes with the same instructions. This function therefore
+ * always uses a branch-free variant of the Jacobi algorithm, regardless of
+ * the value of @p method, which is only accepted for compatibility with the
+ * function for scalar types. The Jacobi algorithm is the most robust of the
+ * available methods.
+ *
+ * @relatesalso SymmetricTensor
+ */
+template <int dim, typename Number, int width>
+inline std::array<std::pair<VectorizedArray<Number, width>,
+                            Tensor<1, dim, VectorizedArray<Number, width>>>,
+                  std::integral_constant<int, dim>::value>
+eigenvectors(const SymmetricTensor<2, dim, VectorizedArray<Number, width>> &T,
+             const SymmetricTensorEigenvectorMethod method =
+               SymmetricTensorEigenvectorMethod::ql_implicit_shifts)
+{
+  (void)method;
+  return internal::SymmetricTensorImplementation::vectorized_jacobi(T);
+}
+
+
+
 /**
  * Return the transpose of the given symmetric tensor. Since we are working
  * with symmetric objects, the transpose is of course the same as the original
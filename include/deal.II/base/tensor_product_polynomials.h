@@ -19,9 +19,11 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/polynomial.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 #include <deal.II/base/utilities.h>
 
@@ -125,6 +127,30 @@ public:
            std::vector<Tensor<3, dim>> &third_derivatives,
            std::vector<Tensor<4, dim>> &fourth_derivatives) const;
 
+  /**
+   * Compute the values and the first derivatives of all tensor product
+   * polynomials at all points in @p unit_points. The value and the gradient
+   * of the polynomial <tt>i</tt> at the point <tt>q</tt> are stored in
+   * <tt>values(i,q)</tt> and <tt>grads(i,q)</tt>, which is the layout in
+   * which FEValues stores the shape functions.
+   *
+   * The tables must either be empty or have n() rows and as many columns as
+   * there are points. In the first case, the function will not compute these
+   * values.
+   *
+   * The points are processed in batches of
+   * VectorizedArray<double>::n_array_elements points, and the products of
+   * the one-dimensional polynomials are computed for all points of a batch
+   * at once with SIMD instructions. This is considerably faster than calling
+   * the function above for each point, e.g., when the shape functions need
+   * to be set up for a quadrature formula that changes from cell to cell.
+   * The results are the same as the ones of the function above.
+   */
+  void
+  evaluate(const ArrayView<const Point<dim>> &unit_points,
+           Table<2, double> &                 values,
+           Table<2, Tensor<1, dim>> &         grads) const;
+
   /**
    * Compute the value of the <tt>i</tt>th tensor product polynomial at
    * <tt>unit_point</tt>. Here <tt>i</tt> is given in tensor product
@@ -53,6 +53,9 @@ namespace TimeStepping
    *     in MATLAB)
    *   - FEHLBERG (fifth order)
    *   - CASH_KARP (firth order)
+   * - Low-storage explicit methods (see LowStorageRungeKutta::initialize):
+   *   - LOW_STORAGE_RK_STAGE3_ORDER3 (three stages, third order)
+   *   - LOW_STORAGE_RK_STAGE5_ORDER4 (five stages, fourth order)
    */
   enum runge_kutta_method
   {
@@ -68,6 +71,8 @@ namespace TimeStepping
     DOPRI,
     FEHLBERG,
     CASH_KARP,
+    LOW_STORAGE_RK_STAGE3_ORDER3,
+    LOW_STORAGE_RK_STAGE5_ORDER4,
     invalid
   };
 
@@ -324,9 +329,184 @@ namespace TimeStepping
 
 
 
+  /**
+   * LowStorageRungeKutta is derived from RungeKutta and implements explicit
+   * Runge-Kutta methods of the low-storage type introduced by Kennedy,
+   * Carpenter, and Lewis (Appl. Numer. Math. 35, pp. 177-219, 2000).
+   * Rather than keeping all $s$ stage vectors of an $s$-stage method alive,
+   * these schemes choose the Butcher tableau such that, besides the
+   * solution, only two vectors need to be stored: the vector $r_i$ at
+   * which the right hand side is evaluated in stage $i$, and the result
+   * $k_i = f(t+c_i\Delta t, r_i)$ of that evaluation. Each stage then
+   * consists of the updates
+   * @f[
+   *   r_{i+1} = y + a_i \Delta t\, k_i, \qquad y = y + b_i \Delta t\, k_i,
+   * @f]
+   * where the first update is skipped in the last stage. The following
+   * methods are available:
+   * - LOW_STORAGE_RK_STAGE3_ORDER3 (three stages, third order)
+   * - LOW_STORAGE_RK_STAGE5_ORDER4 (five stages, fourth order)
+   *
+   * For large problems, the memory traffic of the vector updates is
+   * comparable to the cost of the evaluation of the right hand side. For
+   * this reason, the class also accepts a stage operator that performs the
+   * evaluation of $k_i$ together with the two updates above, such that an
+   * implementation based on MatrixFree::cell_loop() can combine the updates
+   * with the evaluation of the operator, e.g., in the loop over the entries
+   * of the vector after all cells have been processed.
+   */
+  template <typename VectorType>
+  class LowStorageRungeKutta : public RungeKutta<VectorType>
+  {
+  public:
+    using RungeKutta<VectorType>::evolve_one_time_step;
+
+    /**
+     * The type of a function performing one stage of the method. The
+     * arguments are, in this order, the time $t+c_i\Delta t$ of the stage,
+     * the factor $b_i\Delta t$, the factor $a_i\Delta t$, the vector $r_i$
+     * at which the right hand side is to be evaluated, the vector $k_i$ the
+     * right hand side may be written to, the solution $y$, and the vector
+     * $r_{i+1}$. The function needs to compute $k_i = f(t+c_i\Delta t,
+     * r_i)$ and then perform the updates described in the documentation of
+     * this class, using the value of $y$ before its update to compute
+     * $r_{i+1}$. In the last stage, the factor $a_i\Delta t$ is zero and
+     * $r_{i+1}$ must not be modified. The vector $r_i$ and $r_{i+1}$ may be
+     * the same object, so $r_i$ must not be read once $r_{i+1}$ is written.
+     */
+    using StageOperator = std::function<void(const double,
+                                             const double,
+                                             const double,
+                                             const VectorType &,
+                                             VectorType &,
+                                             VectorType &,
+                                             VectorType &)>;
+
+    /**
+     * Default constructor. This constructor creates an object for which
+     * you will want to call <code>initialize(runge_kutta_method)</code>
+     * before it can be used.
+     */
+    LowStorageRungeKutta() = default;
+
+    /**
+     * Constructor. This function calls initialize(runge_kutta_method).
+     */
+    LowStorageRungeKutta(const runge_kutta_method method);
+
+    /**
+     * Initialize the low-storage explicit Runge-Kutta method.
+     */
+    void
+    initialize(const runge_kutta_method method) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t. @p f
+     * is the function $ f(t,y) $ that should be integrated, the input
+     * parameters are the time t and the vector y and the output is value of f
+     * at this point. @p id_minus_tau_J_inverse is not used for explicit
+     * methods. This function allocates the two auxiliary vectors of the
+     * method in each call; the variant that takes these vectors as arguments
+     * avoids that. evolve_one_time_step returns the time at the end of the
+     * time step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      const std::function<
+        VectorType(const double, const double, const VectorType &)>
+        &         id_minus_tau_J_inverse,
+      double      t,
+      double      delta_t,
+      VectorType &y) override;
+
+    /**
+     * This function is used to advance the @p solution from time @p t to t+
+     * @p delta_t, evaluating the right hand side with @p f. The vectors
+     * @p vec_ri and @p vec_ki are the two auxiliary vectors of the method.
+     * They need to have the same layout as @p solution, but their content is
+     * overwritten. evolve_one_time_step returns the time at the end of the
+     * time step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      double                                                             t,
+      double      delta_t,
+      VectorType &solution,
+      VectorType &vec_ri,
+      VectorType &vec_ki);
+
+    /**
+     * Same as the function above, but every stage of the method is performed
+     * by a single call to @p stage_operator, which is responsible for both
+     * the evaluation of the right hand side and the vector updates of the
+     * stage, see the documentation of StageOperator.
+     */
+    double
+    evolve_one_time_step(const StageOperator &stage_operator,
+                         double               t,
+                         double               delta_t,
+                         VectorType &         solution,
+                         VectorType &         vec_ri,
+                         VectorType &         vec_ki);
+
+    /**
+     * Return the coefficients $a_i$, $b_i$, and $c_i$ of the method, e.g.,
+     * to implement a stage operator. The vector @p a has one element less
+     * than the number of stages.
+     */
+    void
+    get_coefficients(std::vector<double> &a,
+                     std::vector<double> &b,
+                     std::vector<double> &c) const;
+
+    /**
+     * This structure stores the name of the method used.
+     */
+    struct Status : public TimeStepping<VectorType>::Status
+    {
+      Status()
+        : method(invalid)
+      {}
+
+      runge_kutta_method method;
+    };
+
+    /**
+     * Return the status of the current object.
+     */
+    const Status &
+    get_status() const override;
+
+  private:
+    /**
+     * The coefficients $a_i$ of the low-storage form of the method. Note
+     * that these are not the coefficients of the Butcher tableau stored in
+     * the base class, which are not needed by this class.
+     */
+    std::vector<double> low_storage_a;
+
+    /**
+     * Status structure of the object.
+     */
+    Status status;
+  };
+
+
+
   /**
    * This class is derived from RungeKutta and implement the implicit methods.
    * This class works only for Diagonal Implicit Runge-Kutta (DIRK) methods.
+   *
+   * For CRANK_NICOLSON and SDIRK_TWO_STAGES, the time step can be adapted
+   * to a given tolerance, see set_time_adaptation_parameters(). The local
+   * error is then estimated by the difference to an embedded first order
+   * method that uses the same stages, i.e., the implicit Euler method for
+   * CRANK_NICOLSON and $y_n + \Delta t f(t_n+\gamma \Delta t, Y_1)$ for
+   * SDIRK_TWO_STAGES. Steps whose error estimate exceeds the tolerance are
+   * rejected and repeated with a smaller time step, reusing the vectors
+   * allocated for the first attempt.
    */
   template <typename VectorType>
   class ImplicitRungeKutta : public RungeKutta<VectorType>
@@ -385,9 +565,28 @@ namespace TimeStepping
     set_newton_solver_parameters(const unsigned int max_it,
                                  const double       tolerance);
 
+    /**
+     * Enable the adaptation of the time step: evolve_one_time_step() then
+     * rejects steps for which the $l_2$ norm of the error estimate exceeds
+     * @p tolerance and repeats them with a smaller time step, until the
+     * error estimate is small enough or the time step reaches
+     * @p min_delta. The time step actually taken is given by the returned
+     * time, and Status::delta_t_guess contains the time step proposed for
+     * the next step, which is at most @p max_delta. Both are computed by a
+     * proportional-integral (PI) controller. A @p tolerance of zero, the
+     * default, disables the adaptation.
+     */
+    void
+    set_time_adaptation_parameters(const double tolerance,
+                                   const double min_delta = 1e-14,
+                                   const double max_delta = 1e100);
+
     /**
      * Structure that stores the name of the method, the number of Newton
      * iterations and the norm of the residual when exiting the Newton solver.
+     * If the time step is adapted, it also stores the number of rejected
+     * steps, the norm of the error estimate of the accepted step, and a guess
+     * of what the next time step should be.
      */
     struct Status : public TimeStepping<VectorType>::Status
     {
@@ -395,11 +594,17 @@ namespace TimeStepping
         : method(invalid)
         , n_iterations(numbers::invalid_unsigned_int)
         , norm_residual(numbers::signaling_nan<double>())
+        , n_rejected_steps(0)
+        , error_norm(numbers::signaling_nan<double>())
+        , delta_t_guess(numbers::signaling_nan<double>())
       {}
 
       runge_kutta_method method;
       unsigned int       n_iterations;
       double             norm_residual;
+      unsigned int       n_rejected_steps;
+      double             error_norm;
+      double             delta_t_guess;
     };
 
     /**
@@ -463,6 +668,33 @@ namespace TimeStepping
      */
     double tolerance;
 
+    /**
+     * Weights of the embedded first order method used to estimate the
+     * error. Empty if the method has no embedded error estimate.
+     */
+    std::vector<double> b_embedded;
+
+    /**
+     * Tolerance of the error estimate. Zero if the time step is not adapted.
+     */
+    double adaptation_tolerance = 0.;
+
+    /**
+     * Smallest time step allowed.
+     */
+    double min_delta_t = 1e-14;
+
+    /**
+     * Largest time step allowed.
+     */
+    double max_delta_t = 1e100;
+
+    /**
+     * Error estimate of the last accepted step divided by the tolerance,
+     * used by the PI controller.
+     */
+    double last_error = 1.;
+
     /**
      * Status structure of the object.
      */
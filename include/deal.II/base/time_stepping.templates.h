@@ -19,6 +19,8 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/time_stepping.h>
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 
 DEAL_II_NAMESPACE_OPEN
@@ -216,6 +218,189 @@ namespace TimeStepping
 
 
 
+  // ----------------------------------------------------------------------
+  // LowStorageRungeKutta
+  // ----------------------------------------------------------------------
+
+  template <typename VectorType>
+  LowStorageRungeKutta<VectorType>::LowStorageRungeKutta(
+    const runge_kutta_method method)
+  {
+    // virtual functions called in constructors and destructors never use the
+    // override in a derived class
+    // for clarity be explicit on which function is called
+    LowStorageRungeKutta<VectorType>::initialize(method);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::initialize(const runge_kutta_method method)
+  {
+    status.method = method;
+
+    // the coefficients are taken from Kennedy, Carpenter, Lewis, Appl.
+    // Numer. Math. 35, pp. 177-219, 2000
+    switch (method)
+      {
+        case (LOW_STORAGE_RK_STAGE3_ORDER3):
+          {
+            this->n_stages = 3;
+            low_storage_a  = {0.755726351946097, 0.386954477304099};
+            this->b        = {0.245170287303492,
+                              0.184896052186740,
+                              0.569933660509768};
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE5_ORDER4):
+          {
+            this->n_stages = 5;
+            low_storage_a  = {970286171893. / 4311952581923.,
+                             6584761158862. / 12103376702013.,
+                             2251764453980. / 15575788980749.,
+                             26877169314380. / 34165994151039.};
+            this->b        = {1153189308089. / 22510343858157.,
+                              1772645290293. / 4653164025191.,
+                              -1672844663538. / 4480602732383.,
+                              2114624349019. / 3568978502595.,
+                              5198255086312. / 14908931495163.};
+            break;
+          }
+        default:
+          {
+            AssertThrow(
+              false,
+              ExcMessage(
+                "Unimplemented low-storage explicit Runge-Kutta method."));
+          }
+      }
+
+    // the stage i evaluates the right hand side at the sum of the weights
+    // of all previous stages, except for the previous stage whose weight
+    // is a_{i-1} rather than b_{i-1}
+    this->c.assign(this->n_stages, 0.);
+    for (unsigned int i = 1; i < this->n_stages; ++i)
+      {
+        this->c[i] = low_storage_a[i - 1];
+        for (unsigned int j = 0; j + 1 < i; ++j)
+          this->c[i] += this->b[j];
+      }
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    const std::function<
+      VectorType(const double, const double, const VectorType &)>
+      & /*id_minus_tau_J_inverse*/,
+    double      t,
+    double      delta_t,
+    VectorType &y)
+  {
+    VectorType vec_ri(y);
+    VectorType vec_ki(y);
+    return evolve_one_time_step(f, t, delta_t, y, vec_ri, vec_ki);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    double                                                             t,
+    double                                                             delta_t,
+    VectorType &                                                       solution,
+    VectorType &                                                       vec_ri,
+    VectorType &                                                       vec_ki)
+  {
+    const StageOperator stage_operator = [&f](const double      time,
+                                              const double      factor_solution,
+                                              const double      factor_ai,
+                                              const VectorType &current_ri,
+                                              VectorType &      ki,
+                                              VectorType &      y,
+                                              VectorType &      next_ri) {
+      ki = f(time, current_ri);
+
+      // compute the next stage vector from the solution before its update
+      if (factor_ai != 0.)
+        {
+          next_ri = y;
+          next_ri.add(factor_ai, ki);
+        }
+      y.add(factor_solution, ki);
+    };
+
+    return evolve_one_time_step(
+      stage_operator, t, delta_t, solution, vec_ri, vec_ki);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const StageOperator &stage_operator,
+    double               t,
+    double               delta_t,
+    VectorType &         solution,
+    VectorType &         vec_ri,
+    VectorType &         vec_ki)
+  {
+    Assert(status.method != invalid,
+           ExcMessage("You need to call initialize() before you can use "
+                      "this object."));
+
+    for (unsigned int stage = 0; stage < this->n_stages; ++stage)
+      {
+        const bool   last_stage = (stage + 1 == this->n_stages);
+        const double factor_ai =
+          last_stage ? 0. : low_storage_a[stage] * delta_t;
+
+        // the first stage evaluates the right hand side at the solution
+        // itself, the others at the vector computed in the previous stage
+        stage_operator(t + this->c[stage] * delta_t,
+                       this->b[stage] * delta_t,
+                       factor_ai,
+                       stage == 0 ? solution : vec_ri,
+                       vec_ki,
+                       solution,
+                       vec_ri);
+      }
+
+    return (t + delta_t);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::get_coefficients(
+    std::vector<double> &a,
+    std::vector<double> &b,
+    std::vector<double> &c) const
+  {
+    a = low_storage_a;
+    b = this->b;
+    c = this->c;
+  }
+
+
+
+  template <typename VectorType>
+  const typename LowStorageRungeKutta<VectorType>::Status &
+  LowStorageRungeKutta<VectorType>::get_status() const
+  {
+    return status;
+  }
+
+
+
   // ----------------------------------------------------------------------
   // ImplicitRungeKutta
   // ----------------------------------------------------------------------
@@ -243,6 +428,7 @@ namespace TimeStepping
   ImplicitRungeKutta<VectorType>::initialize(const runge_kutta_method method)
   {
     status.method = method;
+    b_embedded.clear();
 
     switch (method)
       {
@@ -275,6 +461,8 @@ namespace TimeStepping
             this->b.push_back(0.5);
             this->c.push_back(0.0);
             this->c.push_back(1.0);
+            // implicit Euler method
+            b_embedded = {0.0, 1.0};
 
             break;
           }
@@ -290,6 +478,8 @@ namespace TimeStepping
             this->a.push_back(this->b);
             this->c.push_back(gamma);
             this->c.push_back(1.0);
+            // first order method using only the first stage
+            b_embedded = {1.0, 0.0};
 
             break;
           }
@@ -314,17 +504,66 @@ namespace TimeStepping
     double                                               delta_t,
     VectorType &                                         y)
   {
+    const bool adapt = (adaptation_tolerance > 0.);
+    Assert(adapt == false || b_embedded.size() == this->n_stages,
+           ExcMessage("The time step can only be adapted for methods with "
+                      "an embedded error estimate."));
+
+    // All vectors are allocated before the first attempt and reused if the
+    // step is rejected.
     VectorType              old_y(y);
+    VectorType              error;
     std::vector<VectorType> f_stages(this->n_stages, y);
-    // Compute the different stages needed.
-    compute_stages(f, id_minus_tau_J_inverse, t, delta_t, y, f_stages);
+    if (adapt)
+      error.reinit(y);
+    status.n_rejected_steps = 0;
 
-    // If necessary, compute the linear combinations of the stages.
-    if (skip_linear_combi == false)
+    while (true)
       {
-        y = old_y;
+        // Compute the different stages needed.
+        compute_stages(f, id_minus_tau_J_inverse, t, delta_t, y, f_stages);
+
+        // If necessary, compute the linear combinations of the stages.
+        if (skip_linear_combi == false || adapt)
+          {
+            y = old_y;
+            for (unsigned int i = 0; i < this->n_stages; ++i)
+              y.sadd(1., delta_t * this->b[i], f_stages[i]);
+          }
+
+        if (adapt == false)
+          break;
+
+        error = 0.;
         for (unsigned int i = 0; i < this->n_stages; ++i)
-          y.sadd(1., delta_t * this->b[i], f_stages[i]);
+          error.sadd(1., delta_t * (this->b[i] - b_embedded[i]), f_stages[i]);
+        status.error_norm = error.l2_norm();
+
+        // The embedded methods are of first order, i.e., the local error
+        // behaves like delta_t^2.
+        const double err = std::max(status.error_norm / adaptation_tolerance,
+                                    1e-10);
+        if (err <= 1. || delta_t <= min_delta_t)
+          {
+            // PI controller, without increasing the time step directly
+            // after a rejection
+            double factor =
+              0.9 * std::pow(err, -0.35) * std::pow(last_error, 0.2);
+            factor = std::min(5., std::max(0.2, factor));
+            if (status.n_rejected_steps > 0)
+              factor = std::min(1., factor);
+            status.delta_t_guess =
+              std::max(std::min(factor * delta_t, max_delta_t), min_delta_t);
+            last_error = err;
+            break;
+          }
+
+        // Reject the step and repeat it with a smaller time step.
+        const double factor =
+          std::min(0.9, std::max(0.2, 0.9 * std::pow(err, -0.5)));
+        delta_t = std::max(factor * delta_t, min_delta_t);
+        y       = old_y;
+        ++status.n_rejected_steps;
       }
 
     return (t + delta_t);
@@ -344,6 +583,21 @@ namespace TimeStepping
 
 
 
+  template <typename VectorType>
+  void
+  ImplicitRungeKutta<VectorType>::set_time_adaptation_parameters(
+    const double tolerance_,
+    const double min_delta_,
+    const double max_delta_)
+  {
+    adaptation_tolerance = tolerance_;
+    min_delta_t          = min_delta_;
+    max_delta_t          = max_delta_;
+    last_error           = 1.;
+  }
+
+
+
   template <typename VectorType>
   const typename ImplicitRungeKutta<VectorType>::Status &
   ImplicitRungeKutta<VectorType>::get_status() const
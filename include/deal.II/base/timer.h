@@ -20,13 +20,16 @@
 
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
 #include <chrono>
+#include <functional>
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -914,6 +917,236 @@ private:
 };
 
 
+/**
+ * A profiler for hierarchically nested regions of a program that is cheap
+ * enough to be used in hot paths and from within threaded loops such as the
+ * workers of WorkStream::run() or the cell operations of MatrixFree loops.
+ *
+ * In contrast to TimerOutput, regions are not identified by their name in
+ * every call, but by a handle of type RegionProfiler::Region that is
+ * obtained once from register_region(). Each thread records its
+ * measurements in its own storage, so entering and leaving a region neither
+ * takes a lock nor involves a lookup by name. Regions that are entered while
+ * another region is active on the same thread are recorded as children of
+ * that region, and print_summary() shows the resulting tree, with the times
+ * of each region summed over all threads and with the minimum, average, and
+ * maximum over all MPI processes.
+ *
+ * Usage could be as follows:
+ * @code
+ *   RegionProfiler profiler;
+ *   const RegionProfiler::Region assembly =
+ *     profiler.register_region("assembly");
+ *   const RegionProfiler::Region cell_worker =
+ *     profiler.register_region("cell worker");
+ *
+ *   {
+ *     RegionProfiler::Scope scope(profiler, assembly);
+ *     WorkStream::run(..., [&](...) {
+ *       RegionProfiler::Scope inner_scope(profiler, cell_worker);
+ *       ...
+ *     }, ...);
+ *   }
+ *
+ *   profiler.print_summary(std::cout, MPI_COMM_WORLD);
+ * @endcode
+ *
+ * The hooks set with set_hooks() are called whenever a region is entered or
+ * left. They can be used to forward the regions to hardware performance
+ * counter tools, e.g., through the marker API of LIKWID or the high-level
+ * API of PAPI.
+ *
+ * @note The nesting of regions is tracked separately on each thread. If a
+ * thread that is inside of a region executes a task of a parallel loop
+ * because of work stealing, the regions of that task appear as children of
+ * the region of the thread. Regions need to be left on the thread on which
+ * they were entered.
+ */
+class RegionProfiler
+{
+public:
+  /**
+   * The type of the handle of a region.
+   */
+  using Region = unsigned int;
+
+  /**
+   * Helper class to enter a region in the constructor and to leave it in
+   * the destructor.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * Enter the region @p region of @p profiler.
+     */
+    Scope(RegionProfiler &profiler, const Region region);
+
+    /**
+     * Leave the region entered in the constructor.
+     */
+    ~Scope();
+
+  private:
+    /**
+     * The profiler the region belongs to.
+     */
+    RegionProfiler &profiler;
+
+    /**
+     * The region entered in the constructor.
+     */
+    const Region region;
+  };
+
+  /**
+   * Return the handle of the region with name @p name, creating the region
+   * if it does not exist yet. This function takes a lock and is meant to be
+   * called once per region, outside of the code that is to be profiled.
+   */
+  Region
+  register_region(const std::string &name);
+
+  /**
+   * Return the name of the region @p region. This function takes a lock.
+   */
+  std::string
+  get_region_name(const Region region) const;
+
+  /**
+   * Enter the region @p region on the current thread. If another region is
+   * active on the current thread, the new region is recorded as its child.
+   */
+  void
+  enter(const Region region);
+
+  /**
+   * Leave the region @p region on the current thread, and add the time
+   * since the matching call to enter() to the region. The region needs to
+   * be the one most recently entered on the current thread.
+   */
+  void
+  leave(const Region region);
+
+  /**
+   * Set functions that are called with the handle of a region right after
+   * the region is entered and right before the region is left, respectively.
+   * Empty functions disable the respective hook. This function must not be
+   * called while any region is active.
+   */
+  void
+  set_hooks(const std::function<void(const Region)> &enter_hook,
+            const std::function<void(const Region)> &leave_hook);
+
+  /**
+   * Print the tree of all regions that have been left at least once, with
+   * the number of calls and the minimum, average, and maximum of the
+   * accumulated wall time over all processes in @p mpi_communicator. The
+   * times of a region are summed over all threads. This function needs to
+   * be called on all processes of @p mpi_communicator, but only the first
+   * process writes to @p out. A region that was not visited on some process
+   * counts with zero time on that process.
+   */
+  void
+  print_summary(std::ostream &  out,
+                const MPI_Comm &mpi_communicator = MPI_COMM_SELF) const;
+
+  /**
+   * Discard all measurements, but keep the registered regions. This
+   * function must not be called while any region is active.
+   */
+  void
+  reset();
+
+private:
+  /**
+   * The clock used for the measurements.
+   */
+  using clock_type = std::chrono::steady_clock;
+
+  /**
+   * A node of the tree of regions of one thread, i.e., a region entered
+   * within a particular chain of parent regions.
+   */
+  struct Node
+  {
+    /**
+     * The region this node measures.
+     */
+    Region region;
+
+    /**
+     * The nodes of the regions entered within this one.
+     */
+    std::vector<unsigned int> children;
+
+    /**
+     * The number of times the region has been left.
+     */
+    unsigned long int n_calls;
+
+    /**
+     * The accumulated time spent in the region.
+     */
+    clock_type::duration time;
+  };
+
+  /**
+   * The measurements of one thread.
+   */
+  struct ThreadData
+  {
+    /**
+     * Constructor. Creates the root node of the tree.
+     */
+    ThreadData();
+
+    /**
+     * The tree of regions of this thread. The first node is the root of the
+     * tree, which does not correspond to a region.
+     */
+    std::vector<Node> nodes;
+
+    /**
+     * The nodes of the currently active regions along with the time at
+     * which they were entered, in the order in which they were entered.
+     */
+    std::vector<std::pair<unsigned int, clock_type::time_point>> active;
+  };
+
+  /**
+   * The names of all registered regions, indexed by their handle.
+   */
+  std::vector<std::string> region_names;
+
+  /**
+   * A map from the names of the regions to their handles.
+   */
+  std::map<std::string, Region> region_handles;
+
+  /**
+   * The measurements taken on each thread.
+   */
+  mutable Threads::ThreadLocalStorage<ThreadData> thread_data;
+
+  /**
+   * The function called when entering a region.
+   */
+  std::function<void(const Region)> enter_hook;
+
+  /**
+   * The function called when leaving a region.
+   */
+  std::function<void(const Region)> leave_hook;
+
+  /**
+   * A lock guarding the registration of regions.
+   */
+  mutable Threads::Mutex mutex;
+};
+
+
+
 
 /* ---------------- inline functions ----------------- */
 
@@ -1037,6 +1270,78 @@ TimerOutput::Scope::stop()
 }
 
 
+
+inline RegionProfiler::Scope::Scope(RegionProfiler &profiler,
+                                    const Region    region)
+  : profiler(profiler)
+  , region(region)
+{
+  profiler.enter(region);
+}
+
+
+
+inline RegionProfiler::Scope::~Scope()
+{
+  profiler.leave(region);
+}
+
+
+
+inline void
+RegionProfiler::enter(const Region region)
+{
+  ThreadData &data = thread_data.get();
+
+  // find the node of the region among the children of the currently active
+  // region, the number of children is typically small
+  const unsigned int parent =
+    data.active.empty() ? 0 : data.active.back().first;
+  unsigned int node = numbers::invalid_unsigned_int;
+  for (const unsigned int child : data.nodes[parent].children)
+    if (data.nodes[child].region == region)
+      {
+        node = child;
+        break;
+      }
+
+  if (node == numbers::invalid_unsigned_int)
+    {
+      node = data.nodes.size();
+      data.nodes.push_back(Node{region, {}, 0, clock_type::duration::zero()});
+      data.nodes[parent].children.push_back(node);
+    }
+
+  if (enter_hook)
+    enter_hook(region);
+
+  data.active.emplace_back(node, clock_type::now());
+}
+
+
+
+inline void
+RegionProfiler::leave(const Region region)
+{
+  const clock_type::time_point end = clock_type::now();
+
+  ThreadData &data = thread_data.get();
+  Assert(!data.active.empty() &&
+           data.nodes[data.active.back().first].region == region,
+         ExcMessage("You can only leave the region most recently entered on "
+                    "the current thread."));
+  (void)region;
+
+  Node &node = data.nodes[data.active.back().first];
+  node.time += end - data.active.back().second;
+  ++node.n_calls;
+  data.active.pop_back();
+
+  if (leave_hook)
+    leave_hook(region);
+}
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -547,6 +547,16 @@ namespace Utilities
    * recommended for reasons of performance to ensure that its capacity is
    * sufficient.
    *
+   * Small objects of a trivially copyable type are copied into the buffer
+   * byte by byte, bypassing boost::serialization. The same holds for
+   * std::vector objects whose elements are of a trivially copyable type if
+   * the data is not compressed: the elements are copied into the buffer as
+   * one contiguous block, without any temporary buffers. The block is
+   * preceded by a small header that stores the size and the number of the
+   * elements. unpack() checks this header and throws an exception if the
+   * data was packed in a different format, for example by
+   * boost::serialization in previous versions of deal.II.
+   *
    * @author Timo Heister, Wolfgang Bangerth, 2017.
    */
   template <typename T>
@@ -678,6 +688,27 @@ namespace Utilities
          T (&unpacked_object)[N],
          const bool allow_compression = true);
 
+  /**
+   * Same unpack function as above, but restores the content of a
+   * std::vector in the object @p unpacked_object provided by the caller
+   * instead of returning a new object. If the elements of the vector are of
+   * a trivially copyable type and the data is not compressed, the elements
+   * are copied directly from the buffer into @p unpacked_object, whose
+   * memory is reused if its capacity is sufficient. Calling this function
+   * repeatedly with the same vector therefore does not allocate memory
+   * once the vector is large enough.
+   *
+   * The @p allow_compression parameter denotes if the buffer to
+   * read from could have been previously compressed with ZLIB, and
+   * is only of effect if ZLIB is enabled.
+   */
+  template <typename T>
+  void
+  unpack(const std::vector<char>::const_iterator &cbegin,
+         const std::vector<char>::const_iterator &cend,
+         std::vector<T> &                         unpacked_object,
+         const bool allow_compression = true);
+
   /**
    * Convert an object of type `std::unique_ptr<From>` to an object of
    * type `std::unique_ptr<To>`, where it is assumed that we can cast
@@ -873,6 +904,11 @@ namespace Utilities
      * @param alignment The minimal alignment of the memory block, in bytes.
      * @param size The size of the memory block to be allocated, in bytes.
      *
+     * On Linux, this function additionally advises the kernel to back the
+     * parts of large memory blocks that span whole huge pages by
+     * transparent huge pages, if these are enabled in the <tt>madvise</tt>
+     * or <tt>always</tt> mode.
+     *
      * @note This function checks internally for error codes, rather than
      * leaving this task to the calling site.
      */
@@ -1026,6 +1062,163 @@ namespace Utilities
 
 // --------------------- inline functions
 
+#ifndef DOXYGEN
+namespace internal
+{
+  namespace PackingImplementation
+  {
+    /**
+     * A type trait that is true for std::vector objects whose elements are
+     * of a trivially copyable type. The elements of such vectors are stored
+     * contiguously and can be packed by copying the raw bytes of the array.
+     * std::vector<bool> does not store its elements as an array of bool and
+     * is consequently excluded.
+     */
+    template <typename T>
+    struct IsVectorOfTriviallyCopyable : std::false_type
+    {};
+
+    template <typename T, typename Alloc>
+    struct IsVectorOfTriviallyCopyable<std::vector<T, Alloc>>
+      : std::integral_constant<bool,
+#  if __GNUG__ && __GNUC__ < 5
+                               __has_trivial_copy(T) &&
+#  else
+                               std::is_trivially_copyable<T>::value &&
+#  endif
+                                 !std::is_same<T, bool>::value>
+    {};
+
+
+
+    /**
+     * Return whether Utilities::pack() and Utilities::unpack() compress the
+     * data when called with the argument @p allow_compression.
+     */
+    inline bool
+    use_compression(const bool allow_compression)
+    {
+#  ifdef DEAL_II_WITH_ZLIB
+      return allow_compression;
+#  else
+      (void)allow_compression;
+      return false;
+#  endif
+    }
+
+
+
+    /**
+     * The header that precedes the elements of a std::vector packed by
+     * pack_raw(). It identifies the format and records the size of the
+     * elements and their number, so that unpack_raw() can reject data
+     * that was packed in a different way, for example by
+     * boost::serialization in previous versions of the library, instead of
+     * silently misinterpreting it.
+     */
+    struct RawVectorHeader
+    {
+      std::uint32_t signature;
+      std::uint32_t element_size;
+      std::uint64_t n_elements;
+    };
+
+    /**
+     * The value of RawVectorHeader::signature.
+     */
+    constexpr std::uint32_t raw_vector_signature = 0xdea1ba5e;
+
+
+
+    /**
+     * Append the elements of @p object to @p dest_buffer as one block of
+     * bytes, preceded by a RawVectorHeader. This is the overload for types
+     * that cannot be packed that way, and it returns false.
+     */
+    template <typename T>
+    inline bool
+    pack_raw(const T &, std::vector<char> &, std::false_type)
+    {
+      return false;
+    }
+
+
+
+    template <typename T, typename Alloc>
+    inline bool
+    pack_raw(const std::vector<T, Alloc> &object,
+             std::vector<char> &          dest_buffer,
+             std::true_type)
+    {
+      const RawVectorHeader header = {raw_vector_signature,
+                                      static_cast<std::uint32_t>(sizeof(T)),
+                                      object.size()};
+
+      const std::size_t previous_size = dest_buffer.size();
+      dest_buffer.resize(previous_size + sizeof(header) +
+                         object.size() * sizeof(T));
+      std::memcpy(dest_buffer.data() + previous_size, &header, sizeof(header));
+      if (object.size() > 0)
+        std::memcpy(dest_buffer.data() + previous_size + sizeof(header),
+                    object.data(),
+                    object.size() * sizeof(T));
+      return true;
+    }
+
+
+
+    /**
+     * The counterpart of pack_raw(): restore @p object from the range of
+     * bytes between @p cbegin and @p cend. An exception is thrown if the
+     * data does not start with a RawVectorHeader that matches @p object.
+     * This is the overload for types that cannot be unpacked that way, and
+     * it returns false.
+     */
+    template <typename T>
+    inline bool
+    unpack_raw(const std::vector<char>::const_iterator &,
+               const std::vector<char>::const_iterator &,
+               T &,
+               std::false_type)
+    {
+      return false;
+    }
+
+
+
+    template <typename T, typename Alloc>
+    inline bool
+    unpack_raw(const std::vector<char>::const_iterator &cbegin,
+               const std::vector<char>::const_iterator &cend,
+               std::vector<T, Alloc> &                  object,
+               std::true_type)
+    {
+      const std::size_t n_bytes = std::distance(cbegin, cend);
+
+      RawVectorHeader header = {0, 0, 0};
+      if (n_bytes >= sizeof(header))
+        std::memcpy(&header, &*cbegin, sizeof(header));
+      AssertThrow(header.signature == raw_vector_signature &&
+                    header.element_size == sizeof(T) &&
+                    n_bytes == sizeof(header) + header.n_elements * sizeof(T),
+                  ExcMessage(
+                    "The data to unpack does not contain a std::vector "
+                    "of the requested type in the format written by "
+                    "Utilities::pack(). It may have been written by a "
+                    "previous version of deal.II that serialized such "
+                    "vectors with boost::serialization."));
+
+      object.resize(header.n_elements);
+      if (header.n_elements > 0)
+        std::memcpy(object.data(),
+                    &*cbegin + sizeof(header),
+                    header.n_elements * sizeof(T));
+      return true;
+    }
+  } // namespace PackingImplementation
+} // namespace internal
+#endif
+
 namespace Utilities
 {
   template <int N, typename T>
@@ -1174,7 +1367,8 @@ namespace Utilities
     // the data is never compressed when we can't use zlib.
     (void)allow_compression;
 
-    std::size_t size = 0;
+    std::size_t       size          = 0;
+    const std::size_t previous_size = dest_buffer.size();
 
     // see if the object is small and copyable via memcpy. if so, use
     // this fast path. otherwise, we have to go through the BOOST
@@ -1193,18 +1387,28 @@ namespace Utilities
 #  endif
 #endif
       {
-        const std::size_t previous_size = dest_buffer.size();
         dest_buffer.resize(previous_size + sizeof(T));
 
         std::memcpy(dest_buffer.data() + previous_size, &object, sizeof(T));
 
         size = sizeof(T);
       }
+    else if (!internal::PackingImplementation::use_compression(
+               allow_compression) &&
+             internal::PackingImplementation::pack_raw(
+               object,
+               dest_buffer,
+               internal::PackingImplementation::IsVectorOfTriviallyCopyable<
+                 T>()))
+      {
+        // vectors of trivially copyable objects are copied as a block of
+        // bytes; the number of elements follows from the size of the data
+        size = dest_buffer.size() - previous_size;
+      }
     else
       {
         // use buffer as the target of a compressing
         // stream into which we serialize the current object
-        const std::size_t previous_size = dest_buffer.size();
 #ifdef DEAL_II_WITH_ZLIB
         if (allow_compression)
           {
@@ -1278,6 +1482,18 @@ namespace Utilities
         Assert(std::distance(cbegin, cend) == sizeof(T), ExcInternalError());
         std::memcpy(&object, &*cbegin, sizeof(T));
       }
+    else if (!internal::PackingImplementation::use_compression(
+               allow_compression) &&
+             internal::PackingImplementation::unpack_raw(
+               cbegin,
+               cend,
+               object,
+               internal::PackingImplementation::IsVectorOfTriviallyCopyable<
+                 T>()))
+      {
+        // vectors of trivially copyable objects have been copied as a
+        // block of bytes, see pack()
+      }
     else
       {
         std::string decompressed_buffer;
@@ -1385,6 +1601,27 @@ namespace Utilities
                  allow_compression);
   }
 
+
+  template <typename T>
+  void
+  unpack(const std::vector<char>::const_iterator &cbegin,
+         const std::vector<char>::const_iterator &cend,
+         std::vector<T> &                         unpacked_object,
+         const bool                               allow_compression)
+  {
+    if (!internal::PackingImplementation::use_compression(allow_compression) &&
+        internal::PackingImplementation::unpack_raw(
+          cbegin,
+          cend,
+          unpacked_object,
+          internal::PackingImplementation::IsVectorOfTriviallyCopyable<
+            std::vector<T>>()))
+      return;
+
+    unpacked_object =
+      unpack<std::vector<T>>(cbegin, cend, allow_compression);
+  }
+
 } // namespace Utilities
 
 
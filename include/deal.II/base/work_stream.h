@@ -33,6 +33,7 @@
 #    include <tbb/pipeline.h>
 #  endif
 
+#  include <algorithm>
 #  include <functional>
 #  include <iterator>
 #  include <memory>
@@ -323,10 +324,14 @@ namespace WorkStream
                                   const CopyData &   sample_copy_data)
           : tbb::filter(/*is_serial=*/true)
           , remaining_iterator_range(begin, end)
+          , n_remaining_items(0)
           , item_buffer(buffer_size)
           , sample_scratch_data(sample_scratch_data)
           , chunk_size(chunk_size)
         {
+          for (Iterator p = begin; p != end; ++p)
+            ++n_remaining_items;
+
           // initialize the elements of the ring buffer
           for (unsigned int element = 0; element < item_buffer.size();
                ++element)
@@ -375,13 +380,20 @@ namespace WorkStream
           Assert(current_item != nullptr,
                  ExcMessage("This can't be. There must be a free item!"));
 
-          // initialize the next item. it may
-          // consist of at most chunk_size
-          // elements
+          // initialize the next item. it may consist of at most chunk_size
+          // elements. towards the end of the range, we hand out smaller
+          // chunks such that the remaining work is spread over all items in
+          // flight rather than being left to a few threads while the others
+          // idle, which matters if the cost per element varies strongly
+          const std::size_t n_items_in_chunk = std::max<std::size_t>(
+            1,
+            std::min<std::size_t>(chunk_size,
+                                  n_remaining_items / item_buffer.size()));
+
           current_item->n_items = 0;
           while ((remaining_iterator_range.first !=
                   remaining_iterator_range.second) &&
-                 (current_item->n_items < chunk_size))
+                 (current_item->n_items < n_items_in_chunk))
             {
               current_item->work_items[current_item->n_items] =
                 remaining_iterator_range.first;
@@ -389,6 +401,7 @@ namespace WorkStream
               ++remaining_iterator_range.first;
               ++current_item->n_items;
             }
+          n_remaining_items -= current_item->n_items;
 
           if (current_item->n_items == 0)
             // there were no items
@@ -405,6 +418,11 @@ namespace WorkStream
          */
         std::pair<Iterator, Iterator> remaining_iterator_range;
 
+        /**
+         * The number of elements in remaining_iterator_range.
+         */
+        std::size_t n_remaining_items;
+
         /**
          * A buffer that will store items.
          */
@@ -451,10 +469,11 @@ namespace WorkStream
         const ScratchData &sample_scratch_data;
 
         /**
-         * Number of elements of the iterator range that each thread should
-         * work on sequentially; a large number makes sure that each thread
-         * gets a significant amount of work before the next task switch
-         * happens, whereas a small number is better for load balancing.
+         * Maximal number of elements of the iterator range that each thread
+         * should work on sequentially; a large number makes sure that each
+         * thread gets a significant amount of work before the next task
+         * switch happens, whereas a small number is better for load
+         * balancing.
          */
         const unsigned int chunk_size;
       };
@@ -907,6 +926,8 @@ namespace WorkStream
    * this function, a set of sets of cells (which are represent as a vector of
    * vectors, for efficiency), is typically constructed by calling
    * GraphColoring::make_graph_coloring(). See there for more information.
+   * The scratch and copy data objects created on each thread are reused for
+   * all colors.
    *
    * This function that can be used for worker and copier objects that are
    * either pointers to non-member functions or objects that allow to be
@@ -967,9 +988,12 @@ namespace WorkStream
    * from the <tt>worker</tt> to the <tt>copier</tt>.
    *
    * The @p queue_length argument indicates the number of items that can be
-   * live at any given time. Each item consists of @p chunk_size elements of
-   * the input stream that will be worked on by the worker and copier
-   * functions one after the other on the same thread.
+   * live at any given time. Each item consists of at most @p chunk_size
+   * elements of the input stream that will be worked on by the worker and
+   * copier functions one after the other on the same thread. Towards the end
+   * of the range, when fewer than @p queue_length times @p chunk_size
+   * elements remain, the items are made smaller such that the remaining work
+   * is distributed over all threads.
    *
    * @note If your data objects are large, or their constructors are
    * expensive, it is helpful to keep in mind that <tt>queue_length</tt>
@@ -1208,20 +1232,21 @@ namespace WorkStream
 #  ifdef DEAL_II_WITH_THREADS
     else // have TBB and use more than one thread
       {
+        using WorkerAndCopier = internal::Implementation3::
+          WorkerAndCopier<Iterator, ScratchData, CopyData>;
+
+        // the object holds the thread-local scratch and copy data objects.
+        // create it only once such that these objects are reused for all
+        // colors instead of being created anew for each color
+        WorkerAndCopier worker_and_copier(worker,
+                                          copier,
+                                          sample_scratch_data,
+                                          sample_copy_data);
+
         // loop over the various colors of what we're given
         for (unsigned int color = 0; color < colored_iterators.size(); ++color)
           if (colored_iterators[color].size() > 0)
             {
-              using WorkerAndCopier = internal::Implementation3::
-                WorkerAndCopier<Iterator, ScratchData, CopyData>;
-
-              using RangeType = typename std::vector<Iterator>::const_iterator;
-
-              WorkerAndCopier worker_and_copier(worker,
-                                                copier,
-                                                sample_scratch_data,
-                                                sample_copy_data);
-
               parallel::internal::parallel_for(
                 colored_iterators[color].begin(),
                 colored_iterators[color].end(),
@@ -447,6 +447,37 @@ namespace Differentiation
               const std::vector<ScalarType> &independent_variables,
               FullMatrix<ScalarType> &       hessian) const;
 
+      /**
+       * Compute the value, the gradient and the Hessian of the scalar field
+       * with respect to all independent variables. The result is the same as
+       * that of separate calls to value(), gradient() and hessian(), but the
+       * tape is only traversed once in the forward and once in the reverse
+       * direction, rather than once per quantity. When the same recorded
+       * function is evaluated at many points, e.g. at all quadrature points of
+       * a cell, this considerably reduces the cost of each evaluation.
+       *
+       * @param[in] active_tape_index The index of the tape on which the
+       *            dependent function is recorded.
+       * @param[in] independent_variables The scalar values of the independent
+       *            variables whose sensitivities were tracked.
+       * @param[out] value The scalar value of the function.
+       * @param[out] gradient The values of the dependent function's
+       *             gradients. It is expected that this vector be of the
+       *             correct size (with length
+       *             <code>n_independent_variables</code>).
+       * @param[out] hessian The values of the dependent function's
+       *             Hessian. It is expected that this matrix be of the correct
+       *             size (with dimensions
+       *             <code>n_independent_variables</code>$\times$<code>n_independent_variables</code>).
+       */
+      void
+      value_gradient_and_hessian(
+        const typename Types<ADNumberType>::tape_index active_tape_index,
+        const std::vector<ScalarType> &                independent_variables,
+        ScalarType &                                   value,
+        Vector<ScalarType> &                           gradient,
+        FullMatrix<ScalarType> &                       hessian) const;
+
       //@}
 
       /**
@@ -862,6 +893,14 @@ namespace Differentiation
               const std::vector<scalar_type> &independent_variables,
               FullMatrix<scalar_type> &       hessian) const;
 
+      void
+      value_gradient_and_hessian(
+        const typename Types<ADNumberType>::tape_index active_tape_index,
+        const std::vector<scalar_type> &               independent_variables,
+        scalar_type &                                  value,
+        Vector<scalar_type> &                          gradient,
+        FullMatrix<scalar_type> &                      hessian) const;
+
       //@}
 
       /**
@@ -1058,6 +1097,13 @@ namespace Differentiation
               const std::vector<scalar_type> &,
               FullMatrix<scalar_type> &) const;
 
+      void
+      value_gradient_and_hessian(const typename Types<ADNumberType>::tape_index,
+                                 const std::vector<scalar_type> &,
+                                 scalar_type &,
+                                 Vector<scalar_type> &,
+                                 FullMatrix<scalar_type> &) const;
+
       //@}
 
       /**
@@ -1181,6 +1227,14 @@ namespace Differentiation
               const std::vector<scalar_type> &independent_variables,
               FullMatrix<scalar_type> &       hessian) const;
 
+      void
+      value_gradient_and_hessian(
+        const typename Types<ADNumberType>::tape_index active_tape_index,
+        const std::vector<scalar_type> &               independent_variables,
+        scalar_type &                                  value,
+        Vector<scalar_type> &                          gradient,
+        FullMatrix<scalar_type> &                      hessian) const;
+
       //@}
 
       /**
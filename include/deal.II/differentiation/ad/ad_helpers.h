@@ -3193,6 +3193,39 @@ namespace Differentiation
       void
       compute_hessian(FullMatrix<scalar_type> &hessian) const;
 
+      /**
+       * Compute the value, the gradient and the Hessian of the scalar field
+       * $\Psi(\mathbf{X})$ at once. The results are the same as those of
+       * compute_value(), compute_gradient() and compute_hessian().
+       *
+       * For taped AD numbers, all three quantities result from a single
+       * forward and a single reverse evaluation of the tape, whereas the
+       * separate functions each evaluate the tape anew. This makes this
+       * function the preferred choice when the same recorded function, such as
+       * a constitutive law, is evaluated at many points: The tape is recorded
+       * only once (e.g. at the first quadrature point), and at all further
+       * points it is activated with activate_recorded_tape(), the new
+       * values of the independent variables are set with
+       * set_independent_variables() or set_independent_variable(), and then
+       * this function is called. For tapeless AD numbers, this function
+       * simply returns the results of the three separate functions.
+       *
+       * @param[out] value The value of the scalar field evaluated at the point
+       * defined by the independent variable values.
+       * @param[out] gradient A Vector with the values for the scalar field
+       * gradient. It is resized to a length corresponding to
+       * @p n_independent_variables if necessary.
+       * @param[out] hessian A FullMatrix with the values for the scalar field
+       * Hessian. It is resized to dimensions corresponding to
+       * <code>n_independent_variables</code>$\times$<code>n_independent_variables</code>
+       * if necessary.
+       */
+      void
+      compute_value_gradient_and_hessian(
+        scalar_type &            value,
+        Vector<scalar_type> &    gradient,
+        FullMatrix<scalar_type> &hessian) const;
+
       /**
        * Extract the function gradient for a subset of independent variables
        * $\mathbf{A} \subset \mathbf{X}$, i.e.
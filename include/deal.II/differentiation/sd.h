@@ -20,6 +20,7 @@
 
 #ifdef DEAL_II_WITH_SYMENGINE
 
+#  include <deal.II/differentiation/sd/symengine_batch_evaluator.h>
 #  include <deal.II/differentiation/sd/symengine_math.h>
 #  include <deal.II/differentiation/sd/symengine_number_traits.h>
 #  include <deal.II/differentiation/sd/symengine_number_types.h>
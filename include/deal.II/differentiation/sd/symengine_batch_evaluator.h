@@ -0,0 +1,251 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_differentiation_sd_symengine_batch_evaluator_h
+#define dealii_differentiation_sd_symengine_batch_evaluator_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_SYMENGINE
+
+#  include <deal.II/base/array_view.h>
+#  include <deal.II/base/exceptions.h>
+#  include <deal.II/base/vectorization.h>
+
+#  include <deal.II/differentiation/sd/symengine_number_types.h>
+#  include <deal.II/differentiation/sd/symengine_types.h>
+
+#  include <functional>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Differentiation
+{
+  namespace SD
+  {
+    /**
+     * A class that converts a set of symbolic expressions into a function
+     * that can be evaluated numerically, and evaluates this function for
+     * many sets of values of the independent variables at once.
+     *
+     * Evaluating a symbolic expression with substitute_and_evaluate()
+     * requires a traversal of the expression tree, the creation of new
+     * symbolic objects and a lookup of each symbol in the substitution map,
+     * all of which is repeated for every set of values. This is prohibitively
+     * expensive when, for instance, a symbolically defined constitutive law
+     * is to be evaluated at all quadrature points of a mesh. This class
+     * instead translates the expressions once into either a tree of
+     * compiled closures (the "lambda" backend of SymEngine) or, if SymEngine
+     * has been built with LLVM support, into machine code generated by the
+     * LLVM just-in-time compiler. The resulting function maps an array of
+     * values of the independent variables to an array of the values of all
+     * dependent functions without any symbolic manipulation.
+     *
+     * The evaluate() functions take the values for an arbitrary number of
+     * points, e.g., all quadrature points of a cell, or the lanes of a
+     * VectorizedArray as used by FEEvaluation, and evaluate the compiled
+     * function for all of them in a single call:
+     * @code
+     *   const Expression x = make_symbol("x");
+     *   const Expression y = make_symbol("y");
+     *   const Expression f = x * y + std::sin(x);
+     *   const Expression g = ...;
+     *
+     *   const Differentiation::SD::BatchEvaluator evaluator({x, y}, {f, g});
+     *
+     *   // The values of x and y at all quadrature points, stored point by
+     *   // point, and the values of f and g that are to be computed.
+     *   std::vector<double> values(2 * n_q_points);
+     *   std::vector<double> results(2 * n_q_points);
+     *   ...
+     *   evaluator.evaluate(make_array_view(values), make_array_view(results));
+     * @endcode
+     *
+     * @warning The functions generated by SymEngine use internal storage for
+     * intermediate results, so an object of this class must not be used to
+     * evaluate the function from several threads concurrently. Use one
+     * object per thread instead.
+     */
+    class BatchEvaluator
+    {
+    public:
+      /**
+       * The backend used to translate the symbolic expressions into a
+       * function that can be evaluated numerically.
+       */
+      enum class Backend
+      {
+        /**
+         * Translate the expressions into a tree of nested closures, one per
+         * operation of the expressions. This backend is always available.
+         */
+        lambda,
+        /**
+         * Translate the expressions into native machine code with the LLVM
+         * just-in-time compiler. The compilation is more expensive than the
+         * creation of the closures, but the evaluation is significantly
+         * faster. This backend requires SymEngine to be built with LLVM
+         * support.
+         */
+        llvm
+      };
+
+      /**
+       * Default constructor. The object has to be initialized with
+       * initialize() before it can be used.
+       */
+      BatchEvaluator();
+
+      /**
+       * Constructor. Calls initialize() with the given arguments.
+       */
+      BatchEvaluator(const types::symbol_vector &independent_variables,
+                     const types::symbol_vector &dependent_functions,
+                     const Backend               backend = Backend::lambda);
+
+      /**
+       * Translate the @p dependent_functions, which are expressions of the
+       * symbols in @p independent_variables, into a function that can be
+       * evaluated numerically using the chosen @p backend. The order of the
+       * symbols and functions in the two vectors determines the order of
+       * the values passed to and returned from evaluate().
+       *
+       * All symbols that appear in the @p dependent_functions must be part of
+       * the @p independent_variables.
+       */
+      void
+      initialize(const types::symbol_vector &independent_variables,
+                 const types::symbol_vector &dependent_functions,
+                 const Backend               backend = Backend::lambda);
+
+      /**
+       * Return whether initialize() has been called on this object.
+       */
+      bool
+      is_initialized() const;
+
+      /**
+       * Return the number of independent variables, i.e., the number of
+       * values per point that are passed to evaluate().
+       */
+      unsigned int
+      n_independent_variables() const;
+
+      /**
+       * Return the number of dependent functions, i.e., the number of
+       * values per point that are returned by evaluate().
+       */
+      unsigned int
+      n_dependent_variables() const;
+
+      /**
+       * Evaluate the dependent functions at a number of points. The values of
+       * the independent variables at each point are stored contiguously in
+       * @p values, point after point, and the results are stored in the same
+       * layout in @p results. The number of points is deduced from the size
+       * of @p values, which must be a multiple of n_independent_variables(),
+       * and @p results must provide the space for n_dependent_variables()
+       * values per point.
+       */
+      void
+      evaluate(const ArrayView<const double> &values,
+               const ArrayView<double> &      results) const;
+
+      /**
+       * Evaluate the dependent functions at a number of batches of points,
+       * with each lane of the VectorizedArray representing one point. This
+       * is the layout of the quadrature point data of FEEvaluation. The
+       * arrays are laid out as for the other evaluate() function, with a
+       * VectorizedArray in place of each value.
+       */
+      void
+      evaluate(const ArrayView<const VectorizedArray<double>> &values,
+               const ArrayView<VectorizedArray<double>> &      results) const;
+
+      /**
+       * Exception denoting that the LLVM backend has been requested, but
+       * SymEngine has been built without LLVM support.
+       */
+      DeclExceptionMsg(ExcLLVMNotAvailable,
+                       "The LLVM backend has been requested, but SymEngine "
+                       "has been built without LLVM support. Use the lambda "
+                       "backend or rebuild SymEngine with LLVM enabled.");
+
+    private:
+      /**
+       * The number of independent variables.
+       */
+      unsigned int n_independent;
+
+      /**
+       * The number of dependent functions.
+       */
+      unsigned int n_dependent;
+
+      /**
+       * The function generated from the symbolic expressions. Its first
+       * argument points to the memory for the results of one point, the
+       * second one to the values of the independent variables at this point.
+       * The object that implements the function is owned by this object.
+       */
+      std::function<void(double *, const double *)> compiled_function;
+    };
+
+  } // namespace SD
+} // namespace Differentiation
+
+
+/* -------------------- inline and template functions ------------------ */
+
+
+#  ifndef DOXYGEN
+
+
+namespace Differentiation
+{
+  namespace SD
+  {
+    inline bool
+    BatchEvaluator::is_initialized() const
+    {
+      return static_cast<bool>(compiled_function);
+    }
+
+
+    inline unsigned int
+    BatchEvaluator::n_independent_variables() const
+    {
+      return n_independent;
+    }
+
+
+    inline unsigned int
+    BatchEvaluator::n_dependent_variables() const
+    {
+      return n_dependent;
+    }
+
+  } // namespace SD
+} // namespace Differentiation
+
+
+#  endif // DOXYGEN
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SYMENGINE
+
+#endif // dealii_differentiation_sd_symengine_batch_evaluator_h
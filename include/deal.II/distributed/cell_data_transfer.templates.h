@@ -360,10 +360,10 @@ namespace parallel
           data_range.end(),
           /*allow_compression=*/transfer_variable_size_data));
       else
-        cell_data = Utilities::unpack<std::vector<value_type>>(
-          data_range.begin(),
-          data_range.end(),
-          /*allow_compression=*/transfer_variable_size_data);
+        Utilities::unpack(data_range.begin(),
+                          data_range.end(),
+                          cell_data,
+                          /*allow_compression=*/transfer_variable_size_data);
 
       // Check if sizes match.
       Assert(cell_data.size() == all_out.size(), ExcInternalError());
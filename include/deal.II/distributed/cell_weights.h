@@ -18,6 +18,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/thread_management.h>
+
 #include <deal.II/distributed/tria_base.h>
 
 #include <deal.II/hp/dof_handler.h>
@@ -67,6 +69,46 @@ namespace parallel
    * of each cell. See Triangulation::Signals::cell_weight for a discussion on
    * this topic.
    *
+   * The cost of a cell depends on how the work on it is done. For
+   * matrix-free operator evaluation with sum factorization, it grows like
+   * $(p+1)^{d+1}$ with the polynomial degree $p$, see
+   * register_matrix_free_weighting(), and for the assembly and application
+   * of sparse matrices like the square of the number of degrees of freedom,
+   * see register_ndofs_squared_weighting(). Since the actual costs also
+   * depend on the hardware and the implementation, they can be measured at
+   * run time instead: The time spent on the cells of each active FE index,
+   * for example in the cell loops of MatrixFree, is recorded with
+   * add_measurement(), and register_measured_weighting() then uses the
+   * measured costs per cell as weights:
+   * @code
+   * matrix_free.cell_loop(
+   *   [&](const MatrixFree<dim, double> &data,
+   *       VectorType &                   dst,
+   *       const VectorType &             src,
+   *       const std::pair<unsigned int, unsigned int> &range) {
+   *     for (unsigned int i = 0; i < fe_collection.size(); ++i)
+   *       {
+   *         const auto subrange =
+   *           data.create_cell_subrange_hp_by_index(range, i);
+   *         if (subrange.second == subrange.first)
+   *           continue;
+   *
+   *         Timer timer;
+   *         apply_cells(data, dst, src, subrange);
+   *         cell_weights.add_measurement(
+   *           i,
+   *           VectorizedArray<double>::n_array_elements *
+   *             (subrange.second - subrange.first),
+   *           timer.wall_time());
+   *       }
+   *   },
+   *   dst,
+   *   src);
+   * ...
+   * cell_weights.register_measured_weighting();
+   * triangulation.repartition();
+   * @endcode
+   *
    * @note Be aware that this class connects the weight function to the
    * Triangulation during its construction. If the Triangulation
    * associated with the DoFHandler changes during the lifetime of the
@@ -114,6 +156,53 @@ namespace parallel
     void
     register_ndofs_squared_weighting(const unsigned int factor = 1000);
 
+    /**
+     * Choose a weight for each cell that is proportional to the cost of
+     * matrix-free operator evaluation with sum factorization on it, i.e.,
+     * to $(p+1)^{d+1}$ for every vector component of the finite element,
+     * where $p$ is the polynomial degree of the respective base element.
+     * The weight is normalized such that cells with a scalar element of
+     * degree one have the weight @p factor.
+     */
+    void
+    register_matrix_free_weighting(const unsigned int factor = 1000);
+
+    /**
+     * Record that the work on @p n_cells cells with the active FE index
+     * @p fe_index took the time @p time. The measurements of all calls are
+     * accumulated until clear_measurements() is called and used by
+     * register_measured_weighting(). This function may be called
+     * concurrently from several threads.
+     */
+    void
+    add_measurement(const unsigned int fe_index,
+                    const unsigned int n_cells,
+                    const double       time);
+
+    /**
+     * Discard all measurements recorded by add_measurement().
+     */
+    void
+    clear_measurements();
+
+    /**
+     * Choose a weight for each cell that is proportional to the measured
+     * cost per cell of its active FE index, as recorded by add_measurement()
+     * on all processes. The cost of FE indices without any measurement is
+     * estimated by the cost model of register_matrix_free_weighting(),
+     * calibrated by the average ratio between the measured costs and the
+     * model for the other FE indices. The weight is normalized such
+     * that the cheapest FE index has the weight @p factor.
+     *
+     * The weights are computed when this function is called, i.e., later
+     * measurements only take effect when this function is called again.
+     * This is a collective operation on the processes of the communicator
+     * of the triangulation, and at least one measurement must have been
+     * recorded by one of the processes.
+     */
+    void
+    register_measured_weighting(const unsigned int factor = 1000);
+
     /**
      * Register a custom weight for each cell by providing a function as a
      * parameter.
@@ -166,11 +255,30 @@ namespace parallel
       const typename hp::DoFHandler<dim, spacedim>::cell_iterator &)>
       weighting_function;
 
+    /**
+     * The accumulated times and numbers of cells recorded by
+     * add_measurement() for each active FE index.
+     */
+    std::vector<double> measured_times;
+    std::vector<double> measured_n_cells;
+
+    /**
+     * A mutex that guards access to the measurements.
+     */
+    Threads::Mutex measurement_mutex;
+
     /**
      * A connection to the Triangulation of the DoFHandler.
      */
     boost::signals2::connection tria_listener;
 
+    /**
+     * Return the index of @p fe within the finite element collection of the
+     * DoFHandler.
+     */
+    unsigned int
+    fe_index_of(const FiniteElement<dim, spacedim> &fe) const;
+
     /**
      * A callback function that will be attached to the cell_weight signal of
      * the Triangulation, that is a member of the DoFHandler. Ultimately
@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_distributed_checkpoint_flusher_h
+#define dealii_distributed_checkpoint_flusher_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/thread_management.h>
+
+#include <string>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  namespace distributed
+  {
+    /**
+     * A class that copies the files of a checkpoint written by
+     * parallel::distributed::Triangulation::save() from a fast staging
+     * location to their final location in the background, while the
+     * simulation continues.
+     *
+     * Writing a checkpoint of a large computation directly to a parallel
+     * file system stalls all processes until the last byte has been
+     * written. Many machines provide a much faster storage tier, e.g., a
+     * burst buffer or the solid state disks of the compute nodes, which is
+     * not suitable for storing checkpoints permanently. With this class,
+     * the checkpoint is written to such a storage first, and a separate
+     * thread on each process then drains the files to the parallel file
+     * system:
+     * @code
+     *   parallel::distributed::CheckpointFlusher flusher(mpi_communicator);
+     *   ...
+     *   // attach solution vectors, particles, etc. as usual
+     *   solution_transfer.prepare_for_serialization(solution);
+     *
+     *   // the previous checkpoint must have left the staging area before
+     *   // it is overwritten
+     *   flusher.wait();
+     *   triangulation.save("/burst_buffer/checkpoint");
+     *   flusher.flush("/burst_buffer/checkpoint", "/scratch/checkpoint");
+     *
+     *   // continue with the simulation
+     * @endcode
+     * Since SolutionTransfer and Particles::ParticleHandler store their data
+     * through the mechanism of
+     * parallel::distributed::Triangulation::register_data_attach(), all of
+     * their data is part of the files of the triangulation and is flushed
+     * as well.
+     *
+     * The files of a checkpoint are distributed among the processes, which
+     * copy them concurrently. Each file is first copied to a temporary file
+     * next to its final location, which is then renamed, so that a file at
+     * the final location is always complete. Since
+     * parallel::distributed::Triangulation::save() writes the files
+     * collectively, the staging location must be visible to all processes
+     * of the communicator.
+     *
+     * @ingroup distributed
+     */
+    class CheckpointFlusher
+    {
+    public:
+      /**
+       * Constructor. The processes of @p mpi_communicator share the work
+       * of copying the files.
+       */
+      explicit CheckpointFlusher(const MPI_Comm &mpi_communicator);
+
+      /**
+       * Destructor. Waits for a pending flush to finish, but does not report
+       * any errors that may have occurred during it. Call wait() explicitly
+       * to get notified about them.
+       */
+      ~CheckpointFlusher();
+
+      /**
+       * Start copying the files of the checkpoint that has been written
+       * with the stem @p staging_filename to the files with the stem
+       * @p target_filename, and return immediately. If a previous flush has
+       * not finished yet, this function waits for it first.
+       *
+       * This is a collective operation that has to be called on all
+       * processes of the communicator after
+       * parallel::distributed::Triangulation::save() has returned.
+       */
+      void
+      flush(const std::string &staging_filename,
+            const std::string &target_filename);
+
+      /**
+       * Wait until the files of the last call to flush() have been copied
+       * to their final location. An exception is thrown if any file could
+       * not be copied by this process.
+       *
+       * The staging files must not be overwritten before this function has
+       * returned.
+       */
+      void
+      wait();
+
+    private:
+      /**
+       * The communicator whose processes copy the files.
+       */
+      MPI_Comm mpi_communicator;
+
+      /**
+       * The thread that copies the files assigned to this process. It
+       * returns an error message, which is empty if all files have been
+       * copied successfully.
+       */
+      Threads::Thread<std::string> flush_thread;
+    };
+  } // namespace distributed
+} // namespace parallel
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
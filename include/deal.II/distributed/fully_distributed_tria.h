@@ -0,0 +1,472 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_distributed_fully_distributed_tria_h
+#define dealii_distributed_fully_distributed_tria_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/cell_id.h>
+#include <deal.II/grid/tria.h>
+
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <array>
+#include <functional>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  /**
+   * A namespace for the fully distributed triangulation.
+   *
+   * @ingroup parallel
+   */
+  namespace fullydistributed
+  {
+    /**
+     * Information about a single locally relevant cell of a fully
+     * distributed triangulation on any level. The cell is identified by its
+     * CellId.
+     */
+    template <int dim>
+    struct CellInfo
+    {
+      /**
+       * Constructor.
+       */
+      CellInfo();
+
+      /**
+       * Write or read the data of this object to or from a stream for the
+       * purpose of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+
+      /**
+       * The binary representation of the CellId of the cell.
+       */
+      CellId::binary_type id;
+
+      /**
+       * The subdomain id of the cell, i.e., the rank owning the cell. For
+       * cells that are not active, this value is ignored.
+       */
+      types::subdomain_id subdomain_id;
+
+      /**
+       * The material id of the cell.
+       */
+      types::material_id material_id;
+
+      /**
+       * The manifold id of the cell.
+       */
+      types::manifold_id manifold_id;
+
+      /**
+       * The manifold ids of the lines of the cell.
+       */
+      std::array<types::manifold_id, GeometryInfo<dim>::lines_per_cell>
+        manifold_line_ids;
+
+      /**
+       * The manifold ids of the quads of the cell (only used in 3D).
+       */
+      std::array<types::manifold_id,
+                 dim == 3 ? GeometryInfo<dim>::quads_per_cell : 1>
+        manifold_quad_ids;
+
+      /**
+       * Pairs of the face number and the boundary id for all the faces of
+       * the cell that are located at the boundary of the domain.
+       */
+      std::vector<std::pair<unsigned int, types::boundary_id>> boundary_ids;
+    };
+
+
+
+    /**
+     * The information each process needs to build its part of a
+     * parallel::fullydistributed::Triangulation: the coarse cells that are
+     * ancestors of the locally relevant cells, i.e., of the locally owned
+     * active cells and the ghost cells around them, and the locally
+     * relevant cells on each level of the mesh hierarchy.
+     *
+     * Objects of this type can be filled directly by an application that
+     * reads a partitioned mesh, or be created from a serial triangulation by
+     * create_construction_data_from_triangulation() and
+     * create_construction_data_on_root().
+     */
+    template <int dim, int spacedim = dim>
+    struct ConstructionData
+    {
+      /**
+       * Write or read the data of this object to or from a stream for the
+       * purpose of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+
+      /**
+       * The locally relevant coarse cells, with vertex indices referring to
+       * @p coarse_cell_vertices.
+       */
+      std::vector<dealii::CellData<dim>> coarse_cells;
+
+      /**
+       * The vertices of the locally relevant coarse cells.
+       */
+      std::vector<Point<spacedim>> coarse_cell_vertices;
+
+      /**
+       * The globally unique id of each entry of @p coarse_cells, see the
+       * glossary entry on @ref GlossCoarseCellId "coarse cell IDs".
+       */
+      std::vector<types::coarse_cell_id> coarse_cell_index_to_coarse_cell_id;
+
+      /**
+       * The locally relevant cells and their ancestors on each level,
+       * starting with the coarse cells on level zero. The parents of the
+       * cells on a level are refined when the triangulation is created.
+       */
+      std::vector<std::vector<CellInfo<dim>>> cell_infos;
+    };
+
+
+
+    /**
+     * Create the construction data for process @p my_rank from a serial
+     * triangulation whose active cells have their subdomain ids set to the
+     * owning process, e.g., by GridTools::partition_triangulation(). The
+     * locally relevant cells are the locally owned cells and all cells that
+     * share a vertex with them. If @p my_rank is numbers::invalid_unsigned_int,
+     * the rank of the current process in @p comm is used.
+     */
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_from_triangulation(
+      const dealii::Triangulation<dim, spacedim> &tria,
+      const MPI_Comm                              comm,
+      const unsigned int my_rank = numbers::invalid_unsigned_int);
+
+    /**
+     * Create the serial triangulation on the root process of @p comm only,
+     * partition it, and send each process its construction data. Thus, the
+     * full mesh is never stored on the other processes.
+     *
+     * The function @p serial_grid_generator fills the given triangulation,
+     * and @p serial_grid_partitioner sets the subdomain ids of its active
+     * cells for the number of processes given as last argument. The default
+     * partitioner uses GridTools::partition_triangulation().
+     */
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_on_root(
+      const std::function<void(dealii::Triangulation<dim, spacedim> &)>
+        &            serial_grid_generator,
+      const MPI_Comm comm,
+      const std::function<void(dealii::Triangulation<dim, spacedim> &,
+                               const MPI_Comm,
+                               const unsigned int)> &serial_grid_partitioner =
+        {});
+
+    /**
+     * Create the construction data for the current process of a mesh of
+     * the rectangular domain spanned by the two corner points @p p1 and
+     * @p p2, subdivided into the number of cells given by @p repetitions in
+     * each coordinate direction, as GridGenerator::subdivided_hyper_rectangle()
+     * does. As opposed to create_construction_data_on_root(), neither the
+     * full mesh nor a partitioning of it is ever created: since the mesh is
+     * structured, each process computes the cells, vertices, and owners of
+     * its part of the mesh directly from the indices of the cells, without
+     * any communication. This allows to set up coarse meshes with far more
+     * cells than would fit into the memory of a single process.
+     *
+     * The cells are numbered lexicographically, with the index running
+     * fastest in $x$ direction, and this index is also used as coarse cell
+     * id. The process with rank $r$ out of $P$ processes in @p comm owns the
+     * cells with indices in the range $[rN/P, (r+1)N/P)$, where $N$ is the
+     * total number of cells. The locally relevant cells are the owned cells
+     * and all cells that share a vertex with them.
+     *
+     * If @p colorize is true, the boundary ids of the faces at the boundary
+     * are set to the number of the face as in
+     * GridGenerator::subdivided_hyper_rectangle(), otherwise they are zero.
+     * If @p transformation is given, it is applied to each vertex of the
+     * rectangle, which allows to create mapped meshes like channels with
+     * graded cells or cylinders directly in distributed form.
+     */
+    template <int dim>
+    ConstructionData<dim, dim>
+    create_construction_data_for_subdivided_hyper_rectangle(
+      const std::vector<unsigned int> &                   repetitions,
+      const Point<dim> &                                  p1,
+      const Point<dim> &                                  p2,
+      const MPI_Comm                                      comm,
+      const bool                                          colorize = false,
+      const std::function<Point<dim>(const Point<dim> &)> &transformation =
+        {});
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+    /**
+     * A distributed triangulation in which each process only stores its
+     * locally relevant cells, i.e., the locally owned cells, one layer of
+     * ghost cells, and their ancestors, including only the coarse cells
+     * these are derived from. This is different from
+     * parallel::distributed::Triangulation, where every process stores the
+     * complete coarse mesh, which limits the size of coarse meshes that can
+     * be used, e.g., for large meshes generated by external tools. The mesh
+     * and its partitioning are given by a ConstructionData object, which
+     * can either be filled directly from a partitioned mesh description or
+     * be created by one of the functions
+     * create_construction_data_from_triangulation() and
+     * create_construction_data_on_root().
+     *
+     * The class can be used with DoFHandler and all classes building on it,
+     * such as FEValues and MatrixFree. The cells of the partitioned mesh
+     * are identified across processes by their CellId, using the coarse
+     * cell ids given in the construction data.
+     *
+     * The following functionality is not supported: (adaptive) refinement
+     * and coarsening after construction, repartitioning, multigrid level
+     * hierarchies, and periodic boundary conditions.
+     *
+     * @ingroup distributed
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation
+      : public parallel::DistributedTriangulationBase<dim, spacedim>
+    {
+    public:
+      /**
+       * Constructor.
+       *
+       * @param mpi_communicator The MPI communicator to be used for the
+       * triangulation.
+       */
+      explicit Triangulation(MPI_Comm mpi_communicator);
+
+      /**
+       * Destructor.
+       */
+      virtual ~Triangulation() override = default;
+
+      /**
+       * Create the triangulation from the locally relevant cells given in
+       * @p construction_data. All manifolds of the mesh need to be attached
+       * before calling this function to place the vertices of the finer
+       * levels correctly.
+       */
+      void
+      create_triangulation(
+        const ConstructionData<dim, spacedim> &construction_data);
+
+      /**
+       * This function is not supported; use the function above instead.
+       */
+      virtual void
+      create_triangulation(const std::vector<Point<spacedim>> &vertices,
+                           const std::vector<dealii::CellData<dim>> &cells,
+                           const SubCellData &subcelldata) override;
+
+      /**
+       * Create this triangulation from the part of @p other_tria that is
+       * relevant for the present process, using the partition given by the
+       * subdomain ids of the active cells of @p other_tria. The argument is
+       * either a parallel::shared::Triangulation on a communicator with the
+       * same number of processes, which keeps the partition computed by its
+       * partitioner (METIS, Zoltan, z-order, or a custom one), or a serial
+       * triangulation partitioned, e.g., by
+       * GridTools::partition_triangulation(). The manifolds of @p other_tria
+       * are copied as well.
+       *
+       * This function is equivalent to calling create_triangulation() with
+       * the result of create_construction_data_from_triangulation(). Since
+       * the present triangulation only stores the locally owned cells and
+       * one layer of ghost cells around them, deleting @p other_tria
+       * afterwards, and setting up the DoFHandler and the matrices on the
+       * present object, lets the memory per process scale with the size of
+       * its partition rather than with the size of the whole mesh.
+       */
+      virtual void
+      copy_triangulation(
+        const dealii::Triangulation<dim, spacedim> &other_tria) override;
+
+      /**
+       * Refinement and coarsening are not supported by this class.
+       */
+      virtual void
+      execute_coarsening_and_refinement() override;
+
+      /**
+       * Return true if the triangulation has hanging nodes on any process.
+       */
+      virtual bool
+      has_hanging_nodes() const override;
+
+      /**
+       * Multigrid level hierarchies are not supported, so this function
+       * always returns false.
+       */
+      virtual bool
+      is_multilevel_hierarchy_constructed() const override;
+
+      /**
+       * Return the memory consumption of this object in bytes.
+       */
+      virtual std::size_t
+      memory_consumption() const override;
+
+      /**
+       * Translate the unique id of a coarse cell to its index in this
+       * triangulation, see the glossary entry on
+       * @ref GlossCoarseCellId "coarse cell IDs".
+       */
+      virtual unsigned int
+      coarse_cell_id_to_coarse_cell_index(
+        const types::coarse_cell_id coarse_cell_id) const override;
+
+      /**
+       * Translate the index of a coarse cell in this triangulation to its
+       * unique id.
+       */
+      virtual types::coarse_cell_id
+      coarse_cell_index_to_coarse_cell_id(
+        const unsigned int coarse_cell_index) const override;
+
+    private:
+      /**
+       * Sorted pairs of the unique id and the index of the locally relevant
+       * coarse cells.
+       */
+      std::vector<std::pair<types::coarse_cell_id, unsigned int>>
+        coarse_cell_id_to_index;
+
+      /**
+       * The unique id of each locally relevant coarse cell.
+       */
+      std::vector<types::coarse_cell_id> coarse_cell_index_to_id;
+    };
+
+#else
+
+    /**
+     * Dummy class the compiler chooses for fully distributed triangulations
+     * if we didn't actually configure deal.II with the MPI library. The
+     * existence of this class allows us to refer to
+     * parallel::fullydistributed::Triangulation objects throughout the
+     * library even if it is disabled.
+     *
+     * Since the constructor of this class is deleted, no such objects
+     * can actually be created as this would be pointless given that
+     * MPI is not available.
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation
+      : public parallel::DistributedTriangulationBase<dim, spacedim>
+    {
+    public:
+      /**
+       * Constructor. Deleted to make sure that objects of this type cannot be
+       * constructed (see also the class documentation).
+       */
+      Triangulation() = delete;
+
+      /**
+       * Dummy replacement to allow for better error messages when compiling
+       * this class.
+       */
+      virtual bool
+      is_multilevel_hierarchy_constructed() const override
+      {
+        return false;
+      }
+    };
+
+#endif
+
+
+
+#ifndef DOXYGEN
+
+    template <int dim>
+    CellInfo<dim>::CellInfo()
+      : subdomain_id(numbers::artificial_subdomain_id)
+      , material_id(0)
+      , manifold_id(numbers::flat_manifold_id)
+    {
+      id.fill(0);
+      manifold_line_ids.fill(numbers::flat_manifold_id);
+      manifold_quad_ids.fill(numbers::flat_manifold_id);
+    }
+
+
+
+    template <int dim>
+    template <class Archive>
+    void
+    CellInfo<dim>::serialize(Archive &ar, const unsigned int /*version*/)
+    {
+      ar &id;
+      ar &subdomain_id;
+      ar &material_id;
+      ar &manifold_id;
+      ar &manifold_line_ids;
+      ar &manifold_quad_ids;
+      ar &boundary_ids;
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <class Archive>
+    void
+    ConstructionData<dim, spacedim>::serialize(Archive &ar,
+                                               const unsigned int /*version*/)
+    {
+      ar &coarse_cells;
+      ar &coarse_cell_vertices;
+      ar &coarse_cell_index_to_coarse_cell_id;
+      ar &cell_infos;
+    }
+
+#endif
+
+  } // namespace fullydistributed
+} // namespace parallel
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -70,6 +70,13 @@ namespace parallel
        * refined at all.
        *
        * The same is true for the fraction of cells that is coarsened.
+       *
+       * The thresholds for refinement and coarsening are determined
+       * together by counting the indicators in a fixed number of buckets
+       * over the range of the indicators, which is then narrowed to the
+       * bucket containing the threshold. This requires a constant number of
+       * global reductions, independent of the number of processes and the
+       * distribution of the indicators.
        */
       template <int dim, typename Number, int spacedim>
       void
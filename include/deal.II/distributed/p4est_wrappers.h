@@ -228,6 +228,9 @@ namespace internal
       static types<2>::ghost *(&ghost_new)(types<2>::forest *     p4est,
                                            types<2>::balance_type btype);
 
+      static void (&ghost_expand)(types<2>::forest *p4est,
+                                  types<2>::ghost * ghost);
+
       static void (&ghost_destroy)(types<2>::ghost *ghost);
 
       static void (&reset_data)(types<2>::forest *p4est,
@@ -397,6 +400,9 @@ namespace internal
       static types<3>::ghost *(&ghost_new)(types<3>::forest *     p4est,
                                            types<3>::balance_type btype);
 
+      static void (&ghost_expand)(types<3>::forest *p4est,
+                                  types<3>::ghost * ghost);
+
       static void (&ghost_destroy)(types<3>::ghost *ghost);
 
       static void (&reset_data)(types<3>::forest *p4est,
@@ -94,6 +94,30 @@ namespace parallel
      * hp::DoFHandler classes know how to enumerate degrees of freedom in ways
      * appropriate for the partitioned mesh.
      *
+     * If the mesh is needed in its entirety only while setting up the
+     * problem, e.g., to partition a complex mesh that cannot be refined,
+     * but the memory for the whole mesh and the degrees of freedom on all
+     * cells is too large for the rest of the computation, an object of
+     * this class can be copied into a parallel::fullydistributed::Triangulation
+     * with parallel::fullydistributed::Triangulation::copy_triangulation().
+     * The copy only contains the locally owned cells and one layer of ghost
+     * cells, i.e., all artificial cells are dropped, but the partition
+     * computed by the partitioner of the present class is kept:
+     * @code
+     *   parallel::shared::Triangulation<dim> shared_tria(
+     *     mpi_communicator,
+     *     Triangulation<dim>::none,
+     *     false,
+     *     parallel::shared::Triangulation<dim>::partition_metis);
+     *   GridIn<dim> grid_in(shared_tria);
+     *   ...
+     *   parallel::fullydistributed::Triangulation<dim> tria(mpi_communicator);
+     *   tria.copy_triangulation(shared_tria);
+     *   shared_tria.clear();
+     * @endcode
+     * The DoFHandler is then set up on the fully distributed triangulation,
+     * so its memory scales with the size of the partition as well.
+     *
      * @author Denis Davydov, 2015
      * @ingroup distributed
      *
@@ -445,6 +445,62 @@ namespace parallel
       virtual bool
       prepare_coarsening_and_refinement() override;
 
+      /**
+       * Set a tolerance for the imbalance of the partition below which
+       * execute_coarsening_and_refinement() and repartition() keep the
+       * current partition instead of computing a new one. The imbalance is
+       * measured as the ratio of the largest load of any process and the
+       * average load, where the load is the sum of the cell weights (see
+       * the cell_weight signal of the dealii::Triangulation class) or the
+       * number of cells if no weights are given. The mesh is repartitioned
+       * only if this ratio exceeds $1+$@p tolerance.
+       *
+       * After adaptive refinement steps that change the load of the
+       * processes only slightly, this avoids moving cells, and all data
+       * attached to them, between processes in exchange for a slightly
+       * worse load balance. If the partition is kept, the families of
+       * cells are not necessarily gathered on one process, which means that
+       * cells at the boundary of the partition may not be coarsened in the
+       * next adaptation step. The default tolerance of zero always
+       * repartitions the mesh.
+       */
+      void
+      set_repartition_tolerance(const double tolerance);
+
+      /**
+       * Set the number of layers of ghost cells around the locally owned
+       * cells. By default, the ghost layer consists of all cells adjacent to
+       * a locally owned cell, i.e., it is one cell wide. With @p n_layers
+       * larger than one, the ghost layer is extended by p4est (using
+       * p4est_ghost_expand()) to include all cells that can be reached from
+       * a locally owned cell in at most @p n_layers steps from a cell to
+       * another one that shares at least a vertex with it. This is useful
+       * for schemes with wider stencils, e.g., limiters or patch-based
+       * reconstructions, which then only need the usual exchange of data
+       * between locally owned and ghost cells, e.g., with
+       * GridTools::exchange_cell_data_to_ghosts() or ghosted vectors built on
+       * the locally relevant degrees of freedom of a DoFHandler.
+       *
+       * The ghost layer is rebuilt with the given width every time the mesh
+       * changes, i.e., in execute_coarsening_and_refinement(), repartition(),
+       * and load(). This function has to be called before the coarse mesh
+       * is created. The width only affects the active cells, i.e., the
+       * level ghost cells used in geometric multigrid are not changed.
+       *
+       * @note The function communicate_locally_moved_vertices() only
+       * updates the vertices of the ghost cells that are adjacent to
+       * locally owned cells.
+       */
+      void
+      set_n_ghost_layers(const unsigned int n_layers);
+
+      /**
+       * Return the number of layers of ghost cells set by
+       * set_n_ghost_layers().
+       */
+      unsigned int
+      n_ghost_layers() const;
+
       /**
        * Manually repartition the active cells between processors. Normally
        * this repartitioning will happen automatically when calling
@@ -577,6 +633,16 @@ namespace parallel
       virtual std::size_t
       memory_consumption_p4est() const;
 
+      /**
+       * Add the memory consumption of this object to @p report. In addition
+       * to the entries of dealii::Triangulation::add_memory_consumption(),
+       * the memory of the p4est data structures is reported separately.
+       */
+      virtual void
+      add_memory_consumption(
+        MemoryReport &     report,
+        const std::string &name = "Triangulation") const override;
+
       /**
        * A collective operation that produces a sequence of output files with
        * the given file base name that contain the mesh in VTK format.
@@ -625,6 +691,25 @@ namespace parallel
       void
       load(const std::string &filename, const bool autopartition = true);
 
+      /**
+       * Set the number of processes per compute node that aggregate the
+       * cell-based data written by save() and read by load(). All
+       * processes access the data files with collective MPI-IO operations,
+       * so that the MPI implementation can collect the data of many
+       * processes on a few aggregators and access the file system in large
+       * contiguous blocks, which is much faster on parallel file systems
+       * than letting every process access its own small part of the files.
+       * By default, or if @p n_aggregators_per_node is zero, the number of
+       * aggregators is chosen by the MPI implementation.
+       *
+       * The number is passed as the <tt>cb_config_list</tt> hint to MPI-IO,
+       * which is understood by ROMIO, the MPI-IO implementation of MPICH
+       * and Open MPI, and ignored by other implementations. The layout of
+       * the files does not depend on this setting.
+       */
+      void
+      set_checkpoint_io_aggregators(const unsigned int n_aggregators_per_node);
+
       /**
        * Register a function that can be used to attach data of fixed size
        * to cells. This is useful for two purposes: (i) Upon refinement and
@@ -1088,6 +1173,14 @@ namespace parallel
         void
         clear();
 
+        /**
+         * Set the number of processes per compute node that aggregate the
+         * data in save() and load(). Zero leaves the choice to the MPI
+         * implementation.
+         */
+        void
+        set_n_io_aggregators_per_node(const unsigned int n_aggregators);
+
       private:
         MPI_Comm mpi_communicator;
 
@@ -1096,6 +1189,19 @@ namespace parallel
          */
         bool variable_size_data_stored;
 
+        /**
+         * The number of aggregating processes per compute node used for the
+         * collective file access in save() and load().
+         */
+        unsigned int n_io_aggregators_per_node;
+
+        /**
+         * Create the MPI_Info object with the hints for the collective file
+         * access in save() and load(). It has to be freed by the caller.
+         */
+        MPI_Info
+        create_io_info() const;
+
         /**
          * Cumulative size in bytes that those functions that have called
          * register_data_attach() want to attach to each cell. This number
@@ -1193,6 +1299,27 @@ namespace parallel
       std::vector<unsigned int>
       get_cell_weights() const;
 
+      /**
+       * The tolerance for the imbalance of the partition set by
+       * set_repartition_tolerance().
+       */
+      double repartition_tolerance;
+
+      /**
+       * The number of layers of ghost cells, see set_n_ghost_layers().
+       */
+      unsigned int n_ghost_cell_layers;
+
+      /**
+       * Return whether the imbalance of the current partition, given the
+       * @p cell_weights returned by get_cell_weights() or an empty vector if
+       * no weights are used, is within the tolerance set by
+       * set_repartition_tolerance(). This is a collective operation.
+       */
+      bool
+      partition_is_balanced(
+        const std::vector<unsigned int> &cell_weights) const;
+
       /**
        * Override the implementation in parallel::TriangulationBase because
        * we can ask p4est about ghost neighbors across periodic boundaries.
@@ -1203,6 +1330,17 @@ namespace parallel
       virtual std::map<unsigned int, std::set<dealii::types::subdomain_id>>
       compute_vertices_with_ghost_neighbors() const override;
 
+      /**
+       * Override the implementation in parallel::TriangulationBase. For
+       * ghost layers wider than one cell, see set_n_ghost_layers(), the
+       * processors on which a locally owned cell is a ghost cell can not be
+       * determined from the vertices of the cell. Instead, this function
+       * uses the lists of mirror quadrants stored by p4est, i.e., of the
+       * local quadrants that are ghosts on other processors.
+       */
+      virtual std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+      compute_ghost_ranks_of_locally_owned_cells() const override;
+
       /**
        * This method returns a bit vector of length tria.n_vertices()
        * indicating the locally active vertices on a level, i.e., the vertices
@@ -1323,6 +1461,27 @@ namespace parallel
       void
       save(const std::string &filename) const;
 
+      /**
+       * This function is not implemented, but needs to be present for the
+       * compiler.
+       */
+      void
+      set_checkpoint_io_aggregators(const unsigned int n_aggregators_per_node);
+
+      /**
+       * This function is not implemented, but needs to be present for the
+       * compiler.
+       */
+      void
+      set_repartition_tolerance(const double tolerance);
+
+      /**
+       * This function is not implemented, but needs to be present for the
+       * compiler.
+       */
+      void
+      set_n_ghost_layers(const unsigned int n_layers);
+
       bool
       is_multilevel_hierarchy_constructed() const override;
 
@@ -169,6 +169,22 @@ namespace parallel
     virtual std::map<unsigned int, std::set<dealii::types::subdomain_id>>
     compute_vertices_with_ghost_neighbors() const;
 
+    /**
+     * Return a map that, for each locally owned cell that is a ghost cell on
+     * other processors, lists the ranks of these processors. The cells are
+     * identified by their active cell index.
+     *
+     * The default implementation considers a locally owned cell a ghost cell
+     * of all processors that are adjacent to one of its vertices, see
+     * compute_vertices_with_ghost_neighbors(), which corresponds to a ghost
+     * layer of one cell. Derived classes with wider ghost layers override
+     * this function. This is the information used by
+     * GridTools::exchange_cell_data_to_ghosts() to determine where to send
+     * the data of each cell.
+     */
+    virtual std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+    compute_ghost_ranks_of_locally_owned_cells() const;
+
   protected:
     /**
      * MPI communicator to be used for the triangulation. We create a unique
@@ -19,6 +19,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
+
 #include <deal.II/dofs/dof_handler.h>
 
 #include <deal.II/grid/tria_accessor.h>
@@ -1825,13 +1827,39 @@ public:
   void
   get_dof_indices(std::vector<types::global_dof_index> &dof_indices) const;
 
+  /**
+   * Return a view to the global indices of the degrees of freedom located on
+   * this active cell, in the same order as get_dof_indices(). The view
+   * points into the cache of DoF indices the DoFHandler stores for all
+   * cells, so no copy is made. It is invalidated when the DoFHandler
+   * distributes or renumbers its degrees of freedom.
+   */
+  ArrayView<const types::global_dof_index>
+  get_dof_indices_view() const;
+
   /**
    * Retrieve the global indices of the degrees of freedom on this cell in the
    * level vector associated to the level of the cell.
+   *
+   * The indices are read from a cache that DoFHandler::distribute_mg_dofs()
+   * and DoFHandler::renumber_dofs() fill for all cells of a level. If the
+   * cache is not available, e.g. because set_mg_dof_indices() has been
+   * called on a cell of the level, the indices are collected from the
+   * vertices, lines, faces, and the interior of the cell.
    */
   void
   get_mg_dof_indices(std::vector<types::global_dof_index> &dof_indices) const;
 
+  /**
+   * Return a view to the global indices of the level degrees of freedom on
+   * this cell, in the same order as get_mg_dof_indices(). This requires the
+   * cache of level DoF indices described in get_mg_dof_indices() to be
+   * available, and the view is invalidated when the level DoFs are
+   * distributed or renumbered again.
+   */
+  ArrayView<const types::global_dof_index>
+  get_mg_dof_indices_view() const;
+
   /**
    * @}
    */
@@ -1928,7 +1956,8 @@ public:
   set_dof_indices(const std::vector<types::global_dof_index> &dof_indices);
 
   /**
-   * Set the Level DoF indices of this cell to the given values.
+   * Set the Level DoF indices of this cell to the given values. This
+   * invalidates the cache of level DoF indices of the level of the cell.
    */
   void
   set_mg_dof_indices(const std::vector<types::global_dof_index> &dof_indices);
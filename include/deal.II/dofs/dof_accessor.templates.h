@@ -2754,6 +2754,73 @@ namespace internal
      */
     struct Implementation
     {
+      /**
+       * Return a pointer to the cached level DoF indices of the cell
+       * described by @p accessor, or a null pointer if the cache of the
+       * level of the cell has not been filled.
+       */
+      template <int dim, int spacedim, bool level_dof_access>
+      static const types::global_dof_index *
+      get_mg_cell_cache_start(
+        const DoFCellAccessor<DoFHandler<dim, spacedim>, level_dof_access>
+          &accessor)
+      {
+        const unsigned int level = accessor.level();
+        if (level >= accessor.dof_handler->mg_levels.size() ||
+            accessor.dof_handler->mg_levels[level]
+              ->cell_dof_indices_cache.empty())
+          return nullptr;
+
+        return accessor.dof_handler->mg_levels[level]->get_cell_cache_start(
+          accessor.present_index, accessor.get_fe().dofs_per_cell);
+      }
+
+
+
+      /**
+       * The hp::DoFHandler does not store level DoF indices, so there is
+       * no cache to return.
+       */
+      template <int dim, int spacedim, bool level_dof_access>
+      static const types::global_dof_index *
+      get_mg_cell_cache_start(
+        const DoFCellAccessor<dealii::hp::DoFHandler<dim, spacedim>,
+                              level_dof_access> &)
+      {
+        return nullptr;
+      }
+
+
+
+      /**
+       * Invalidate the cache of the level DoF indices of the level of the
+       * cell described by @p accessor. This is necessary whenever level DoF
+       * indices of the cell are changed, since the change also affects the
+       * cached indices of the neighbors of the cell.
+       */
+      template <int dim, int spacedim, bool level_dof_access>
+      static void
+      clear_mg_cell_cache(
+        const DoFCellAccessor<DoFHandler<dim, spacedim>, level_dof_access>
+          &accessor)
+      {
+        const unsigned int level = accessor.level();
+        if (level < accessor.dof_handler->mg_levels.size())
+          accessor.dof_handler->mg_levels[level]
+            ->cell_dof_indices_cache.clear();
+      }
+
+
+
+      template <int dim, int spacedim, bool level_dof_access>
+      static void
+      clear_mg_cell_cache(
+        const DoFCellAccessor<dealii::hp::DoFHandler<dim, spacedim>,
+                              level_dof_access> &)
+      {}
+
+
+
       /**
        * Implement the updating of the cache. Currently not implemented for
        * hp::DoFHandler objects.
@@ -3829,13 +3896,61 @@ DoFCellAccessor<DoFHandlerType, level_dof_access>::get_dof_indices(
 
 
 
+template <typename DoFHandlerType, bool level_dof_access>
+inline ArrayView<const types::global_dof_index>
+DoFCellAccessor<DoFHandlerType, level_dof_access>::get_dof_indices_view() const
+{
+  Assert(this->active(),
+         ExcMessage("get_dof_indices_view() only works on active cells."));
+  Assert(this->is_artificial() == false,
+         ExcMessage("Can't ask for DoF indices on artificial cells."));
+
+  const auto dofs_per_cell = this->get_fe().dofs_per_cell;
+  if (dofs_per_cell == 0)
+    return ArrayView<const types::global_dof_index>();
+
+  return ArrayView<const types::global_dof_index>(
+    this->dof_handler->levels[this->present_level]->get_cell_cache_start(
+      this->present_index, dofs_per_cell),
+    dofs_per_cell);
+}
+
+
+
 template <typename DoFHandlerType, bool level_dof_access>
 inline void
 DoFCellAccessor<DoFHandlerType, level_dof_access>::get_mg_dof_indices(
   std::vector<types::global_dof_index> &dof_indices) const
 {
-  DoFAccessor<dim, DoFHandlerType, level_dof_access>::get_mg_dof_indices(
-    this->level(), dof_indices);
+  const types::global_dof_index *cache =
+    dealii::internal::DoFCellAccessorImplementation::Implementation::
+      get_mg_cell_cache_start(*this);
+  if (cache != nullptr)
+    {
+      AssertDimension(dof_indices.size(), this->get_fe().dofs_per_cell);
+      std::copy(cache, cache + dof_indices.size(), dof_indices.begin());
+    }
+  else
+    DoFAccessor<dim, DoFHandlerType, level_dof_access>::get_mg_dof_indices(
+      this->level(), dof_indices);
+}
+
+
+
+template <typename DoFHandlerType, bool level_dof_access>
+inline ArrayView<const types::global_dof_index>
+DoFCellAccessor<DoFHandlerType, level_dof_access>::get_mg_dof_indices_view()
+  const
+{
+  const types::global_dof_index *cache =
+    dealii::internal::DoFCellAccessorImplementation::Implementation::
+      get_mg_cell_cache_start(*this);
+  Assert(cache != nullptr || this->get_fe().dofs_per_cell == 0,
+         ExcMessage("The level DoF indices of this cell are not cached. "
+                    "Call DoFHandler::distribute_mg_dofs() first."));
+
+  return ArrayView<const types::global_dof_index>(
+    cache, cache != nullptr ? this->get_fe().dofs_per_cell : 0);
 }
 
 
@@ -3845,6 +3960,8 @@ inline void
 DoFCellAccessor<DoFHandlerType, level_dof_access>::set_mg_dof_indices(
   const std::vector<types::global_dof_index> &dof_indices)
 {
+  dealii::internal::DoFCellAccessorImplementation::Implementation::
+    clear_mg_cell_cache(*this);
   DoFAccessor<dim, DoFHandlerType, level_dof_access>::set_mg_dof_indices(
     this->level(), dof_indices);
 }
@@ -46,6 +46,8 @@ DEAL_II_NAMESPACE_OPEN
 
 // Forward declarations
 #ifndef DOXYGEN
+class MemoryReport;
+
 template <int dim, int spacedim>
 class FiniteElement;
 template <int dim, int spacedim>
@@ -1180,6 +1182,16 @@ public:
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Add the memory consumption of this object to @p report, split into the
+   * indices of the degrees of freedom on cells and vertices, on faces, and
+   * on the levels of a multigrid hierarchy, with @p name as prefix of the
+   * entries. The memory of the triangulation is not included.
+   */
+  void
+  add_memory_consumption(MemoryReport &     report,
+                         const std::string &name = "DoFHandler") const;
+
   /**
    * Write the data of this object to a stream for the purpose of
    * serialization.
@@ -42,7 +42,11 @@ namespace internal
      * in#cell_dof_indices_cache, since this is a frequently requested
      * operation. The values are set by
      * DoFCellAccessor::update_cell_dof_indices_cache and are used by
-     * DoFCellAccessor::get_dof_indices.
+     * DoFCellAccessor::get_dof_indices. For the objects that store the
+     * level degrees of freedom used by multigrid methods, the cache
+     * contains the level DoF indices of all cells of the level; it is
+     * filled by the DoFHandler after distributing or renumbering the level
+     * degrees of freedom and is used by DoFCellAccessor::get_mg_dof_indices.
      *
      * Note that vertices are separate from, and in fact have nothing to do
      * with cells. The indices of degrees of freedom located on vertices
@@ -30,6 +30,12 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+#ifndef DOXYGEN
+template <int dim, typename Number, typename VectorizedArrayType>
+class MatrixFree;
+#endif
+
 /**
  * Implementation of a number of renumbering algorithms for the degrees of
  * freedom on a triangulation. The functions in this namespace compute
@@ -1222,6 +1228,62 @@ namespace DoFRenumbering
    * @}
    */
 
+  /**
+   * @name Numberings based on the access pattern of matrix-free loops
+   * @{
+   */
+
+  /**
+   * Renumber the degrees of freedom according to the order in which they are
+   * accessed by the cell loop of a MatrixFree object, aiming at good data
+   * locality in vector accesses through FEEvaluation::read_dof_values() or
+   * FEEvaluation::distribute_local_to_global(). The degrees of freedom are
+   * enumerated in the order in which they are first touched when going
+   * through the cell batches from zero to MatrixFree::n_cell_batches(), and
+   * through the lanes of each batch. This way, consecutive cell batches
+   * access consecutive ranges of the vector entries, rather than jumping
+   * through memory according to the (hierarchical) numbering of the
+   * DoFHandler.
+   *
+   * In a parallel setting, the locally owned degrees of freedom that are
+   * ghosts on another MPI process, i.e., the ones that are sent during
+   * LinearAlgebra::distributed::Vector::update_ghost_values() and received
+   * during LinearAlgebra::distributed::Vector::compress(), are grouped
+   * together and placed at the beginning of the locally owned range, again
+   * in the order of their first access. The remaining degrees of freedom,
+   * which are only accessed by the local process, follow this group.
+   *
+   * The MatrixFree object must have been set up with the given @p dof_handler
+   * (as one of the DoFHandler objects passed to MatrixFree::reinit()) on the
+   * active cells, i.e., with MatrixFree::AdditionalData::level_mg_handler
+   * left at its default value. Since the renumbering changes the indices
+   * stored within the MatrixFree object, the latter as well as any
+   * AffineConstraints and vectors based on the DoFHandler need to be set up
+   * again after calling this function.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                   dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free);
+
+  /**
+   * Compute the renumbering vector needed by the matrix_free_data_locality()
+   * function. Does not perform the renumbering on the @p DoFHandler dofs but
+   * returns the renumbering vector, which needs to be of the size of the
+   * locally owned degrees of freedom of @p dof_handler.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &              new_dof_indices,
+    const DoFHandler<dim> &                             dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free);
+
+  /**
+   * @}
+   */
+
 
 
   /**
@@ -566,6 +566,36 @@ namespace DoFTools
     const bool                       keep_constrained_dofs = true,
     const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
 
+  /**
+   * Compute the same sparsity pattern as the previous function, but using
+   * several threads and writing directly into a SparsityPattern without the
+   * need to first build a DynamicSparsityPattern and copy it. The sparsity
+   * pattern is resized to the number of degrees of freedom, and is
+   * compressed upon return, so any previous content is lost.
+   *
+   * The rows of the sparsity pattern are split into blocks of contiguous
+   * rows, which are filled independently of each other by the threads. To
+   * this end, each block first collects the locally owned cells that write
+   * into its rows, directly or through @p constraints, and stores the
+   * entries of its rows only. Since the rows of each block are then known
+   * completely, the SparsityPattern can be allocated with the exact number of
+   * entries for each row. The work per block is smallest if the degrees of
+   * freedom of each cell are close to each other, as is the case for the
+   * default numbering and after DoFRenumbering::Cuthill_McKee().
+   *
+   * See the previous function for the meaning of the arguments.
+   *
+   * @ingroup constraints
+   */
+  template <typename DoFHandlerType, typename number = double>
+  void
+  make_sparsity_pattern_threaded(
+    const DoFHandlerType &           dof_handler,
+    SparsityPattern &                sparsity_pattern,
+    const AffineConstraints<number> &constraints = AffineConstraints<number>(),
+    const bool                       keep_constrained_dofs = true,
+    const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
+
   /**
    * Compute which entries of a matrix built on the given @p dof_handler may
    * possibly be nonzero, and create a sparsity pattern object that represents
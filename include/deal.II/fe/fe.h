@@ -714,6 +714,17 @@ public:
      */
     UpdateFlags update_each;
 
+    /**
+     * Return whether FiniteElement::fill_fe_values() and friends only read
+     * this object, i.e., whether it does not contain scratch arrays that are
+     * written on every cell. In that case, the object can be shared by
+     * several FEValues objects for the same finite element, quadrature
+     * formula, and update flags, even if these are used on different
+     * threads. The default implementation returns false.
+     */
+    virtual bool
+    is_read_only() const;
+
     /**
      * Return an estimate (in bytes) or the memory consumption of this object.
      */
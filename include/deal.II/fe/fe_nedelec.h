@@ -319,6 +319,15 @@ private:
   void
   initialize_restriction();
 
+  /**
+   * Fill the prolongation and restriction matrices. They are taken from the
+   * cache of FETools::get_cached_matrices() if an element of the same name
+   * has computed them before. Called upon the first request of one of these
+   * matrices.
+   */
+  void
+  initialize_prolongation_and_restriction();
+
   /**
    * These are the factors multiplied to a function in the
    * #generalized_face_support_points when computing the integration.
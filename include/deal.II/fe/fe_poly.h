@@ -17,13 +17,53 @@
 #define dealii_fe_poly_h
 
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor_product_polynomials.h>
 
 #include <deal.II/fe/fe.h>
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace internal
+{
+  namespace FE_PolyImplementation
+  {
+    /**
+     * Compute the values and gradients of all polynomials of @p poly_space
+     * at all @p points at once, if the polynomial space provides such a
+     * batched evaluation, and return whether this is the case. Otherwise,
+     * the tables are left untouched and the polynomials need to be
+     * evaluated point by point.
+     */
+    template <class PolynomialType, int dim>
+    inline bool
+    evaluate_values_and_gradients(const PolynomialType &,
+                                  const std::vector<Point<dim>> &,
+                                  Table<2, double> &,
+                                  Table<2, Tensor<1, dim>> &)
+    {
+      return false;
+    }
+
+
+
+    template <int dim, typename PolynomialType>
+    inline bool
+    evaluate_values_and_gradients(
+      const TensorProductPolynomials<dim, PolynomialType> &poly_space,
+      const std::vector<Point<dim>> &                      points,
+      Table<2, double> &                                   values,
+      Table<2, Tensor<1, dim>> &                           grads)
+    {
+      poly_space.evaluate(make_array_view(points), values, grads);
+      return true;
+    }
+  } // namespace FE_PolyImplementation
+} // namespace internal
+
 /*!@addtogroup febase */
 /*@{*/
 
@@ -296,6 +336,35 @@ protected:
     if (update_flags & update_3rd_derivatives)
       data.shape_3rd_derivatives.reinit(this->dofs_per_cell, n_q_points);
 
+    // if only values and gradients are needed, the polynomial space might
+    // be able to compute them for all quadrature points at once, which is
+    // much faster than going through the points one by one below. the
+    // values are put into the same place as below
+    if ((update_flags & (update_values | update_gradients)) &&
+        !(update_flags & (update_hessians | update_3rd_derivatives)))
+      {
+        Table<2, double>         no_values;
+        Table<2, Tensor<1, dim>> no_gradients;
+
+        Table<2, double> &shape_values =
+          ((update_flags & update_values) &&
+               (output_data.shape_values.n_rows() > 0) ?
+             (output_data.shape_values.n_cols() == n_q_points ?
+                output_data.shape_values :
+                data.shape_values) :
+             no_values);
+        Table<2, Tensor<1, dim>> &shape_gradients =
+          (update_flags & update_gradients ? data.shape_gradients :
+                                             no_gradients);
+
+        if (internal::FE_PolyImplementation::evaluate_values_and_gradients(
+              poly_space,
+              quadrature.get_points(),
+              shape_values,
+              shape_gradients))
+          return data_ptr;
+      }
+
     // next already fill those fields of which we have information by
     // now. note that the shape gradients are only those on the unit
     // cell, and need to be transformed when visiting an actual cell
@@ -401,6 +470,15 @@ protected:
   class InternalData : public FiniteElement<dim, spacedim>::InternalDataBase
   {
   public:
+    /**
+     * The fill functions of FE_Poly only read the tables of this class.
+     */
+    virtual bool
+    is_read_only() const override
+    {
+      return true;
+    }
+
     /**
      * Array with shape function values in quadrature points. There is one row
      * for each shape function, containing values for each quadrature point.
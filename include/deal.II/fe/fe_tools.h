@@ -33,6 +33,8 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <functional>
+#include <iosfwd>
 #include <string>
 #include <vector>
 
@@ -431,6 +433,60 @@ namespace FETools
     std::vector<std::vector<FullMatrix<number>>> &matrices,
     const bool                                    isotropic_only = false);
 
+  /**
+   * Return the matrices stored under the name @p key in a cache that is
+   * shared by all finite element objects of the process. If there is no
+   * such entry yet, the matrices are computed by calling @p compute_matrices
+   * and stored in the cache.
+   *
+   * This function is used by finite element classes whose embedding and
+   * interface constraint matrices are expensive to compute, such as
+   * FE_Nedelec, with the name of the element as returned by
+   * FiniteElement::get_name() as part of the key. Creating several objects
+   * of the same element then computes these matrices only once, e.g., for
+   * the elements of an hp::FECollection that appear repeatedly or for
+   * elements that are created anew for each of a sequence of computations.
+   *
+   * The function is thread-safe. The computation is not done while holding
+   * the lock of the cache, so that @p compute_matrices can itself use the
+   * cache. If two threads compute the same entry simultaneously, the result
+   * of the first one is kept.
+   *
+   * Entries are never removed from the cache automatically, not even when
+   * the last finite element object that used them is destroyed. The memory
+   * of the cache is only released by clear_matrix_cache().
+   */
+  std::vector<FullMatrix<double>>
+  get_cached_matrices(
+    const std::string &                                     key,
+    const std::function<std::vector<FullMatrix<double>>()> &compute_matrices);
+
+  /**
+   * Write all entries of the cache used by get_cached_matrices() to @p out
+   * in a binary format.
+   */
+  void
+  save_matrix_cache(std::ostream &out);
+
+  /**
+   * Read entries written by save_matrix_cache() from @p in and add them to
+   * the cache used by get_cached_matrices(), keeping existing entries of the
+   * same name. Loading a file written by a previous run at the start of a
+   * program avoids computing the matrices of the elements again, on every
+   * process. The file must have been written by the same version of the
+   * library.
+   */
+  void
+  load_matrix_cache(std::istream &in);
+
+  /**
+   * Remove all entries of the cache used by get_cached_matrices() and
+   * release their memory. This is the only way to free the cache; finite
+   * element objects created afterwards compute their matrices again.
+   */
+  void
+  clear_matrix_cache();
+
   /**
    * Project scalar data defined in quadrature points to a finite element
    * space on a single cell.
@@ -650,6 +706,13 @@ namespace FETools
    * object as argument, see below, or make the field conforming yourself
    * by calling the @p distribute function of your hanging node constraints
    * object.
+   *
+   * The cells are processed in parallel on the available threads. For the
+   * interpolation from FE_Q elements of a lower polynomial degree to FE_Q
+   * elements of a higher degree on the same mesh (or in the same way between
+   * FE_DGQ elements) with vectors of type LinearAlgebra::distributed::Vector,
+   * MGTwoLevelTransfer::prolongate() computes the same result with sum
+   * factorization, which is considerably faster for high degrees.
    */
   template <int dim,
             int spacedim,
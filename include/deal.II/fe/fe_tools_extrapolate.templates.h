@@ -149,12 +149,14 @@ namespace FETools
                          dim>::quadrant)); // quadrant
         }
 
+        // append the data of this cell to the end of the buffer
         void
         pack_data(std::vector<char> &buffer) const
         {
-          buffer.resize(bytes_for_buffer());
+          const std::size_t offset = buffer.size();
+          buffer.resize(offset + bytes_for_buffer());
 
-          char *ptr = buffer.data();
+          char *ptr = buffer.data() + offset;
 
           unsigned int n_dofs = dof_values.size();
           std::memcpy(ptr, &n_dofs, sizeof(unsigned int));
@@ -175,10 +177,11 @@ namespace FETools
           Assert(ptr == buffer.data() + buffer.size(), ExcInternalError());
         }
 
-        void
-        unpack_data(const std::vector<char> &buffer)
+        // read the data of a cell starting at the position ptr in a buffer
+        // and return the position after the data of the cell
+        const char *
+        unpack_data(const char *ptr)
         {
-          const char * ptr = buffer.data();
           unsigned int n_dofs;
           memcpy(&n_dofs, ptr, sizeof(unsigned int));
           ptr += sizeof(unsigned int);
@@ -196,7 +199,7 @@ namespace FETools
             sizeof(typename dealii::internal::p4est::types<dim>::quadrant));
           ptr += sizeof(typename dealii::internal::p4est::types<dim>::quadrant);
 
-          Assert(ptr == buffer.data() + buffer.size(), ExcInternalError());
+          return ptr;
         }
       };
 
@@ -1143,33 +1146,33 @@ namespace FETools
       const std::vector<CellData> &cells_to_send,
       std::vector<CellData> &      received_cells) const
     {
-      std::vector<std::vector<char>> sendbuffers(cells_to_send.size());
-      std::vector<std::vector<char>>::iterator buffer = sendbuffers.begin();
-      std::vector<MPI_Request>                 requests(cells_to_send.size());
-      std::vector<unsigned int>                destinations;
+      // collect all cells for the same receiver in a single message, such
+      // that each round only exchanges one message between two processes
+      // rather than one message per cell
+      std::map<int, std::vector<char>> sendbuffers;
+      for (const CellData &cell : cells_to_send)
+        cell.pack_data(sendbuffers[cell.receiver]);
+
+      std::vector<MPI_Request>  requests(sendbuffers.size());
+      std::vector<unsigned int> destinations;
 
       // send data
       unsigned int idx = 0;
-      for (typename std::vector<CellData>::const_iterator it =
-             cells_to_send.begin();
-           it != cells_to_send.end();
-           ++it, ++idx)
+      for (const auto &buffer : sendbuffers)
         {
-          destinations.push_back(it->receiver);
+          destinations.push_back(buffer.first);
 
-          it->pack_data(*buffer);
-          const int ierr = MPI_Isend(buffer->data(),
-                                     buffer->size(),
+          const int ierr = MPI_Isend(buffer.second.data(),
+                                     buffer.second.size(),
                                      MPI_BYTE,
-                                     it->receiver,
+                                     buffer.first,
                                      round,
                                      communicator,
                                      &requests[idx]);
           AssertThrowMPI(ierr);
+          ++idx;
         }
 
-      Assert(destinations.size() == cells_to_send.size(), ExcInternalError());
-
       const unsigned int n_senders =
         Utilities::MPI::compute_n_point_to_point_communications(communicator,
                                                                 destinations);
@@ -1197,14 +1200,18 @@ namespace FETools
                           &status);
           AssertThrowMPI(ierr);
 
-          cell_data.unpack_data(receive);
+          const char *ptr = receive.data();
+          while (ptr != receive.data() + receive.size())
+            {
+              ptr = cell_data.unpack_data(ptr);
 
-          // this process has to send this
-          // cell back to the sender
-          // the receiver is the old sender
-          cell_data.receiver = status.MPI_SOURCE;
+              // this process has to send this
+              // cell back to the sender
+              // the receiver is the old sender
+              cell_data.receiver = status.MPI_SOURCE;
 
-          received_cells.push_back(cell_data);
+              received_cells.push_back(cell_data);
+            }
         }
 
       if (requests.size() > 0)
@@ -1334,22 +1341,21 @@ namespace FETools
               cell_data_insert(*comp, available_cells);
 
               // ...and generate a vector of computed cells with correct
-              // receivers, then delete this received need from the list
-              typename std::vector<CellData>::iterator recv =
-                received_needs.begin();
-              while (recv != received_needs.end())
-                {
-                  if (dealii::internal::p4est::quadrant_is_equal<dim>(
-                        recv->quadrant, comp->quadrant))
-                    {
-                      recv->dof_values = comp->dof_values;
-                      cells_to_send.push_back(*recv);
-                      received_needs.erase(recv);
-                      recv = received_needs.begin();
-                    }
-                  else
-                    ++recv;
-                }
+              // receivers, then delete these received needs from the list
+              const auto is_computed = [&comp](const CellData &need) {
+                return dealii::internal::p4est::quadrant_is_equal<dim>(
+                  need.quadrant, comp->quadrant);
+              };
+              for (CellData &need : received_needs)
+                if (is_computed(need))
+                  {
+                    need.dof_values = comp->dof_values;
+                    cells_to_send.push_back(need);
+                  }
+              received_needs.erase(std::remove_if(received_needs.begin(),
+                                                  received_needs.end(),
+                                                  is_computed),
+                                   received_needs.end());
             }
 
           // increase the round counter, such that we are sure to only send
@@ -1358,7 +1364,9 @@ namespace FETools
 
           send_cells(cells_to_send, received_cells);
 
-          // store received cell_data
+          // store received cell_data. the cells sent and received in this
+          // round are not needed any more, so do not send them again in the
+          // next round
           for (typename std::vector<CellData>::const_iterator recv =
                  received_cells.begin();
                recv != received_cells.end();
@@ -1366,6 +1374,8 @@ namespace FETools
             {
               cell_data_insert(*recv, available_cells);
             }
+          cells_to_send.clear();
+          received_cells.clear();
 
           // increase the round counter, such that we are sure to only send
           // and receive data from the correct call
@@ -23,6 +23,7 @@
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_handler.h>
@@ -59,6 +60,49 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace FETools
 {
+  namespace internal
+  {
+    /**
+     * The data of a thread for the cell loop of interpolate(): a vector
+     * for the values on a cell of the first DoFHandler and the
+     * interpolation matrices between the pairs of elements encountered so
+     * far. The matrices are not copied, as each thread computes the ones
+     * it needs.
+     */
+    template <int dim, int spacedim, typename Number>
+    struct InterpolateScratchData
+    {
+      InterpolateScratchData() = default;
+
+      InterpolateScratchData(const InterpolateScratchData &)
+      {}
+
+      Vector<Number> u1_local;
+
+      std::map<std::pair<const FiniteElement<dim, spacedim> *,
+                         const FiniteElement<dim, spacedim> *>,
+               std::unique_ptr<FullMatrix<double>>>
+        interpolation_matrices;
+    };
+
+
+
+    /**
+     * The interpolated values on a cell of the second DoFHandler, together
+     * with the indices of the degrees of freedom of the cell. The indices
+     * are empty for cells that are not locally owned.
+     */
+    template <typename Number>
+    struct InterpolateCopyData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+
+      Vector<Number> values;
+    };
+  } // namespace internal
+
+
+
   template <int dim,
             int spacedim,
             template <int, int> class DoFHandlerType1,
@@ -114,35 +158,6 @@ namespace FETools
                       " index sets."));
 #endif
 
-    // allocate vectors at maximal
-    // size. will be reinited in inner
-    // cell, but Vector makes sure that
-    // this does not lead to
-    // reallocation of memory
-    Vector<typename OutVector::value_type> u1_local(
-      DoFTools::max_dofs_per_cell(dof1));
-    Vector<typename OutVector::value_type> u2_local(
-      DoFTools::max_dofs_per_cell(dof2));
-
-    // have a map for interpolation matrices.
-    // Using a unique_ptr makes sure that the
-    // memory is released again automatically.
-    std::map<const FiniteElement<dim, spacedim> *,
-             std::map<const FiniteElement<dim, spacedim> *,
-                      std::unique_ptr<FullMatrix<double>>>>
-      interpolation_matrices;
-
-    typename DoFHandlerType1<dim, spacedim>::active_cell_iterator
-      cell1 = dof1.begin_active(),
-      endc1 = dof1.end();
-    typename DoFHandlerType2<dim, spacedim>::active_cell_iterator
-      cell2 = dof2.begin_active(),
-      endc2 = dof2.end();
-    (void)endc2;
-
-    std::vector<types::global_dof_index> dofs;
-    dofs.reserve(DoFTools::max_dofs_per_cell(dof2));
-
     u2 = typename OutVector::value_type(0.);
     OutVector touch_count(u2);
     touch_count = typename OutVector::value_type(0.);
@@ -154,83 +169,100 @@ namespace FETools
     const types::subdomain_id subdomain_id =
       dof1.get_triangulation().locally_owned_subdomain();
 
-    for (; cell1 != endc1; ++cell1, ++cell2)
-      if ((cell1->subdomain_id() == subdomain_id) ||
-          (subdomain_id == numbers::invalid_subdomain_id))
-        {
-          Assert(cell1->get_fe().n_components() ==
-                   cell2->get_fe().n_components(),
-                 ExcDimensionMismatch(cell1->get_fe().n_components(),
-                                      cell2->get_fe().n_components()));
-
-          // for continuous elements on
-          // grids with hanging nodes we
-          // need hanging node
-          // constraints. Consequently,
-          // if there are no constraints
-          // then hanging nodes are not
-          // allowed.
-          const bool hanging_nodes_not_allowed =
-            ((cell2->get_fe().dofs_per_vertex != 0) &&
-             (constraints.n_constraints() == 0));
-
-          if (hanging_nodes_not_allowed)
-            for (unsigned int face = 0;
-                 face < GeometryInfo<dim>::faces_per_cell;
-                 ++face)
-              Assert(cell1->at_boundary(face) ||
-                       cell1->neighbor(face)->level() == cell1->level(),
-                     ExcHangingNodesNotAllowed());
-
-
-          const unsigned int dofs_per_cell1 = cell1->get_fe().dofs_per_cell;
-          const unsigned int dofs_per_cell2 = cell2->get_fe().dofs_per_cell;
-          u1_local.reinit(dofs_per_cell1);
-          u2_local.reinit(dofs_per_cell2);
-
-          // check if interpolation
-          // matrix for this particular
-          // pair of elements is already
-          // there
-          if (interpolation_matrices[&cell1->get_fe()][&cell2->get_fe()]
-                .get() == nullptr)
-            {
-              auto interpolation_matrix =
-                std_cxx14::make_unique<FullMatrix<double>>(dofs_per_cell2,
-                                                           dofs_per_cell1);
-
-              get_interpolation_matrix(cell1->get_fe(),
-                                       cell2->get_fe(),
-                                       *interpolation_matrix);
-
-              interpolation_matrices[&cell1->get_fe()][&cell2->get_fe()] =
-                std::move(interpolation_matrix);
-            }
+    using Number = typename OutVector::value_type;
+
+    // the cells are interpolated in parallel, whereas the results are added
+    // into the global vectors one cell after the other
+    auto worker =
+      [&](const typename DoFHandlerType1<dim, spacedim>::active_cell_iterator
+            &                                                cell1,
+          internal::InterpolateScratchData<dim, spacedim, Number> &scratch,
+          internal::InterpolateCopyData<Number> &                copy_data) {
+        copy_data.dof_indices.clear();
+        if ((cell1->subdomain_id() != subdomain_id) &&
+            (subdomain_id != numbers::invalid_subdomain_id))
+          return;
+
+        const typename DoFHandlerType2<dim, spacedim>::active_cell_iterator
+          cell2(&dof2.get_triangulation(),
+                cell1->level(),
+                cell1->index(),
+                &dof2);
+
+        Assert(cell1->get_fe().n_components() ==
+                 cell2->get_fe().n_components(),
+               ExcDimensionMismatch(cell1->get_fe().n_components(),
+                                    cell2->get_fe().n_components()));
+
+        // for continuous elements on
+        // grids with hanging nodes we
+        // need hanging node
+        // constraints. Consequently,
+        // if there are no constraints
+        // then hanging nodes are not
+        // allowed.
+        const bool hanging_nodes_not_allowed =
+          ((cell2->get_fe().dofs_per_vertex != 0) &&
+           (constraints.n_constraints() == 0));
+
+        if (hanging_nodes_not_allowed)
+          for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
+               ++face)
+            Assert(cell1->at_boundary(face) ||
+                     cell1->neighbor(face)->level() == cell1->level(),
+                   ExcHangingNodesNotAllowed());
+
+        const unsigned int dofs_per_cell1 = cell1->get_fe().dofs_per_cell;
+        const unsigned int dofs_per_cell2 = cell2->get_fe().dofs_per_cell;
+
+        // check if interpolation
+        // matrix for this particular
+        // pair of elements is already
+        // there
+        std::unique_ptr<FullMatrix<double>> &interpolation_matrix =
+          scratch.interpolation_matrices[std::make_pair(&cell1->get_fe(),
+                                                        &cell2->get_fe())];
+        if (interpolation_matrix.get() == nullptr)
+          {
+            interpolation_matrix =
+              std_cxx14::make_unique<FullMatrix<double>>(dofs_per_cell2,
+                                                         dofs_per_cell1);
+            get_interpolation_matrix(cell1->get_fe(),
+                                     cell2->get_fe(),
+                                     *interpolation_matrix);
+          }
 
-          cell1->get_dof_values(u1, u1_local);
-          interpolation_matrices[&cell1->get_fe()][&cell2->get_fe()]->vmult(
-            u2_local, u1_local);
+        scratch.u1_local.reinit(dofs_per_cell1);
+        cell1->get_dof_values(u1, scratch.u1_local);
+        copy_data.values.reinit(dofs_per_cell2);
+        interpolation_matrix->vmult(copy_data.values, scratch.u1_local);
 
-          dofs.resize(dofs_per_cell2);
-          cell2->get_dof_indices(dofs);
+        copy_data.dof_indices.resize(dofs_per_cell2);
+        cell2->get_dof_indices(copy_data.dof_indices);
+      };
 
-          for (unsigned int i = 0; i < dofs_per_cell2; ++i)
+    auto copier = [&](const internal::InterpolateCopyData<Number> &copy_data) {
+      for (unsigned int i = 0; i < copy_data.dof_indices.size(); ++i)
+        {
+          // if dof is locally_owned
+          const types::global_dof_index gdi = copy_data.dof_indices[i];
+          if (u2_elements.is_element(gdi))
             {
-              // if dof is locally_owned
-              const types::global_dof_index gdi = dofs[i];
-              if (u2_elements.is_element(gdi))
-                {
-                  ::dealii::internal::ElementAccess<OutVector>::add(u2_local(i),
-                                                                    dofs[i],
-                                                                    u2);
-                  ::dealii::internal::ElementAccess<OutVector>::add(
-                    1, dofs[i], touch_count);
-                }
+              ::dealii::internal::ElementAccess<OutVector>::add(
+                copy_data.values(i), gdi, u2);
+              ::dealii::internal::ElementAccess<OutVector>::add(1,
+                                                                gdi,
+                                                                touch_count);
             }
         }
-    // cell1 is at the end, so should
-    // be cell2
-    Assert(cell2 == endc2, ExcInternalError());
+    };
+
+    WorkStream::run(dof1.begin_active(),
+                    dof1.end(),
+                    worker,
+                    copier,
+                    internal::InterpolateScratchData<dim, spacedim, Number>(),
+                    internal::InterpolateCopyData<Number>());
 
     u2.compress(VectorOperation::add);
     touch_count.compress(VectorOperation::add);
@@ -246,23 +278,22 @@ namespace FETools
     // for parallel vectors check,
     // if this component is owned by
     // this processor.
-    for (types::global_dof_index i = 0; i < dof2.n_dofs(); ++i)
-      if (locally_owned_dofs.is_element(i))
-        {
-          Assert(static_cast<typename OutVector::value_type>(
-                   ::dealii::internal::ElementAccess<OutVector>::get(
-                     touch_count, i)) != typename OutVector::value_type(0),
-                 ExcInternalError());
-
-
-          const typename OutVector::value_type val =
-            ::dealii::internal::ElementAccess<OutVector>::get(u2, i);
-          ::dealii::internal::ElementAccess<OutVector>::set(
-            val /
-              ::dealii::internal::ElementAccess<OutVector>::get(touch_count, i),
-            i,
-            u2);
-        }
+    for (const types::global_dof_index i : locally_owned_dofs)
+      {
+        Assert(static_cast<typename OutVector::value_type>(
+                 ::dealii::internal::ElementAccess<OutVector>::get(
+                   touch_count, i)) != typename OutVector::value_type(0),
+               ExcInternalError());
+
+
+        const typename OutVector::value_type val =
+          ::dealii::internal::ElementAccess<OutVector>::get(u2, i);
+        ::dealii::internal::ElementAccess<OutVector>::set(
+          val /
+            ::dealii::internal::ElementAccess<OutVector>::get(touch_count, i),
+          i,
+          u2);
+      }
 
     // finish the work on parallel vectors
     u2.compress(VectorOperation::insert);
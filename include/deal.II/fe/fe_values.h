@@ -533,7 +533,7 @@ namespace FEValuesViews
     /**
      * A pointer to the FEValuesBase object we operate on.
      */
-    const SmartPointer<const FEValuesBase<dim, spacedim>> fe_values;
+    const CheckedPointer<const FEValuesBase<dim, spacedim>> fe_values;
 
     /**
      * The single scalar component this view represents of the FEValuesBase
@@ -1213,7 +1213,7 @@ namespace FEValuesViews
     /**
      * A pointer to the FEValuesBase object we operate on.
      */
-    const SmartPointer<const FEValuesBase<dim, spacedim>> fe_values;
+    const CheckedPointer<const FEValuesBase<dim, spacedim>> fe_values;
 
     /**
      * The first component of the vector this view represents of the
@@ -1506,7 +1506,7 @@ namespace FEValuesViews
     /**
      * A pointer to the FEValuesBase object we operate on.
      */
-    const SmartPointer<const FEValuesBase<dim, spacedim>> fe_values;
+    const CheckedPointer<const FEValuesBase<dim, spacedim>> fe_values;
 
     /**
      * The first component of the vector this view represents of the
@@ -1853,7 +1853,7 @@ namespace FEValuesViews
     /**
      * A pointer to the FEValuesBase object we operate on.
      */
-    const SmartPointer<const FEValuesBase<dim, spacedim>> fe_values;
+    const CheckedPointer<const FEValuesBase<dim, spacedim>> fe_values;
 
     /**
      * The first component of the vector this view represents of the
@@ -2097,9 +2097,10 @@ public:
   static const unsigned int space_dimension = spacedim;
 
   /**
-   * Number of quadrature points.
+   * Number of quadrature points. For FEValues, this number changes when
+   * reinit() is called with a different quadrature formula.
    */
-  const unsigned int n_quadrature_points;
+  unsigned int n_quadrature_points;
 
   /**
    * Number of shape functions per cell. If we use this base class to evaluate
@@ -3419,9 +3420,12 @@ protected:
   /**
    * A pointer to the internal data object of finite element, obtained from
    * FiniteElement::get_data(), Mapping::get_face_data(), or
-   * FiniteElement::get_subface_data().
+   * FiniteElement::get_subface_data(). If the object is read-only, see
+   * FiniteElement::InternalDataBase::is_read_only(), it may be shared with
+   * copies of this object.
    */
-  std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>
+  std::shared_ptr<
+    const typename FiniteElement<dim, spacedim>::InternalDataBase>
     fe_data;
 
   /**
@@ -3438,6 +3442,48 @@ protected:
    */
   UpdateFlags update_flags;
 
+  /**
+   * The update flags whose finite element data is only computed when it is
+   * first accessed after a reinit(). See FEValues::defer_update_flags().
+   */
+  UpdateFlags deferred_update_flags;
+
+  /**
+   * The internal data object of the finite element that is used to compute
+   * the data of the deferred update flags.
+   */
+  std::shared_ptr<
+    const typename FiniteElement<dim, spacedim>::InternalDataBase>
+    deferred_fe_data;
+
+  /**
+   * Whether the data of the deferred update flags has already been computed
+   * on the present cell.
+   */
+  bool deferred_data_is_current;
+
+  /**
+   * Compute the data of the deferred update flags on the present cell. Only
+   * FEValues supports deferred update flags, so the implementation in this
+   * class throws an exception.
+   */
+  virtual void
+  compute_deferred_data();
+
+  /**
+   * Return the table of the hessians of the shape functions, computing them
+   * first if their computation has been deferred.
+   */
+  const Table<2, Tensor<2, spacedim>> &
+  get_shape_hessians() const;
+
+  /**
+   * Return the table of the third derivatives of the shape functions,
+   * computing them first if their computation has been deferred.
+   */
+  const Table<2, Tensor<3, spacedim>> &
+  get_shape_3rd_derivatives() const;
+
   /**
    * Initialize some update flags. Called from the @p initialize functions of
    * derived classes, which are in turn called from their constructors.
@@ -3523,6 +3569,26 @@ public:
            const Quadrature<dim> &             quadrature,
            const UpdateFlags                   update_flags);
 
+  /**
+   * Copy constructor. Create an object for the same mapping, finite
+   * element, quadrature formula, and (deferred) update flags as @p other,
+   * which is not yet reinitialized to any cell. Such copies are, for
+   * example, created by WorkStream for every thread.
+   *
+   * If the internal data of the finite element is read-only, see
+   * FiniteElement::InternalDataBase::is_read_only(), as is the case for the
+   * elements derived from FE_Poly like FE_Q and FE_DGQ, the tables of the
+   * shape functions on the reference cell that were computed by @p other
+   * are shared with the new object rather than computed again. Only the
+   * data of the mapping, which describes the geometry of the present cell,
+   * and the output arrays are created anew. Otherwise, all data is
+   * computed as in the other constructors.
+   *
+   * The quadrature formula of @p other must not be changed by reinit() on
+   * another thread while this constructor runs.
+   */
+  FEValues(const FEValues<dim, spacedim> &other);
+
   /**
    * Reinitialize the gradients, Jacobi determinants, etc for the given cell
    * of type "iterator into a DoFHandler object", and the finite element
@@ -3550,6 +3616,40 @@ public:
   void
   reinit(const typename Triangulation<dim, spacedim>::cell_iterator &cell);
 
+  /**
+   * Like the function above for iterators into a DoFHandler, but evaluate
+   * the shape functions and the mapping at the points of @p quadrature
+   * rather than the ones of the quadrature formula given to the
+   * constructor. The new quadrature formula replaces the stored one, see
+   * get_quadrature(), and is also used by all following calls to the
+   * reinit() functions without quadrature argument.
+   *
+   * This function is meant for methods that use a different quadrature
+   * formula on every cell, e.g., cut cell methods where the quadrature
+   * formula is generated for the part of the cell inside the domain. If
+   * @p quadrature differs from the stored one, only the data that the finite
+   * element and the mapping precompute for the quadrature points, like the
+   * values and gradients of the shape functions on the reference cell, is
+   * recomputed, and the output arrays are resized, re-using their memory
+   * where possible. This is much cheaper than creating a new FEValues object
+   * on every cell. If @p quadrature is the same as the stored one, this
+   * function is as fast as the one without quadrature argument.
+   */
+  template <template <int, int> class DoFHandlerType, bool level_dof_access>
+  void
+  reinit(const TriaIterator<DoFCellAccessor<DoFHandlerType<dim, spacedim>,
+                                            level_dof_access>> &cell,
+         const Quadrature<dim> &                                 quadrature);
+
+  /**
+   * Like the previous function, but for iterators into a Triangulation, with
+   * the same restrictions as the respective reinit() function without
+   * quadrature argument.
+   */
+  void
+  reinit(const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+         const Quadrature<dim> &quadrature);
+
   /**
    * Return a reference to the copy of the quadrature formula stored by this
    * object.
@@ -3581,11 +3681,47 @@ public:
   const FEValues<dim, spacedim> &
   get_present_fe_values() const;
 
+  /**
+   * Only compute the data of the update flags @p flags when it is first
+   * accessed after a call to reinit(), rather than in reinit() itself. This
+   * is useful if an FEValues object is set up with flags that are only
+   * needed on some of the cells, e.g., because it is shared between several
+   * terms of a weak form that are not active everywhere: the cost of the
+   * deferred data is then only paid on the cells on which it is used.
+   *
+   * Only the shape function data given by the flags update_hessians and
+   * update_3rd_derivatives can be deferred, and @p flags must be a subset
+   * of the update flags passed to the constructor. The corresponding data
+   * of the mapping, which is needed to transform the derivatives of the
+   * shape functions, is still computed by reinit(). When the deferred data
+   * is accessed, it is computed without taking the similarity to the
+   * previous cell into account, and the finite element may recompute the
+   * lower derivatives the deferred data depends on.
+   *
+   * This function has to be called before the first call to reinit().
+   */
+  void
+  defer_update_flags(const UpdateFlags flags);
+
 private:
   /**
    * Store a copy of the quadrature formula here.
    */
-  const Quadrature<dim> quadrature;
+  Quadrature<dim> quadrature;
+
+  /**
+   * Compute the data of the deferred update flags on the present cell.
+   */
+  virtual void
+  compute_deferred_data() override;
+
+  /**
+   * Replace the stored quadrature formula by @p new_quadrature and let the
+   * finite element and the mapping recompute the data they precompute for
+   * the quadrature points.
+   */
+  void
+  change_quadrature(const Quadrature<dim> &new_quadrature);
 
   /**
    * Do work common to the two constructors.
@@ -4014,8 +4150,8 @@ namespace FEValuesViews
     // function except that here we know the component as fixed and we have
     // pre-computed and cached a bunch of information. See the comments there.
     if (shape_function_data[shape_function].is_nonzero_shape_function_component)
-      return fe_values->finite_element_output
-        .shape_hessians[shape_function_data[shape_function].row_index][q_point];
+      return fe_values->get_shape_hessians()
+        [shape_function_data[shape_function].row_index][q_point];
     else
       return hessian_type();
   }
@@ -4037,9 +4173,8 @@ namespace FEValuesViews
     // function except that here we know the component as fixed and we have
     // pre-computed and cached a bunch of information. See the comments there.
     if (shape_function_data[shape_function].is_nonzero_shape_function_component)
-      return fe_values->finite_element_output
-        .shape_3rd_derivatives[shape_function_data[shape_function].row_index]
-                              [q_point];
+      return fe_values->get_shape_3rd_derivatives()
+        [shape_function_data[shape_function].row_index][q_point];
     else
       return third_derivative_type();
   }
@@ -4358,7 +4493,7 @@ namespace FEValuesViews
         hessian_type return_value;
         return_value[shape_function_data[shape_function]
                        .single_nonzero_component_index] =
-          fe_values->finite_element_output.shape_hessians[snc][q_point];
+          fe_values->get_shape_hessians()[snc][q_point];
         return return_value;
       }
     else
@@ -4368,7 +4503,7 @@ namespace FEValuesViews
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
             return_value[d] =
-              fe_values->finite_element_output.shape_hessians
+              fe_values->get_shape_hessians()
                 [shape_function_data[shape_function].row_index[d]][q_point];
 
         return return_value;
@@ -4399,7 +4534,7 @@ namespace FEValuesViews
         third_derivative_type return_value;
         return_value[shape_function_data[shape_function]
                        .single_nonzero_component_index] =
-          fe_values->finite_element_output.shape_3rd_derivatives[snc][q_point];
+          fe_values->get_shape_3rd_derivatives()[snc][q_point];
         return return_value;
       }
     else
@@ -4409,7 +4544,7 @@ namespace FEValuesViews
           if (shape_function_data[shape_function]
                 .is_nonzero_shape_function_component[d])
             return_value[d] =
-              fe_values->finite_element_output.shape_3rd_derivatives
+              fe_values->get_shape_3rd_derivatives()
                 [shape_function_data[shape_function].row_index[d]][q_point];
 
         return return_value;
@@ -5013,6 +5148,29 @@ FEValuesBase<dim, spacedim>::shape_grad_component(
 
 
 
+template <int dim, int spacedim>
+inline const Table<2, Tensor<2, spacedim>> &
+FEValuesBase<dim, spacedim>::get_shape_hessians() const
+{
+  if ((deferred_update_flags & update_hessians) && !deferred_data_is_current)
+    const_cast<FEValuesBase<dim, spacedim> &>(*this).compute_deferred_data();
+  return this->finite_element_output.shape_hessians;
+}
+
+
+
+template <int dim, int spacedim>
+inline const Table<2, Tensor<3, spacedim>> &
+FEValuesBase<dim, spacedim>::get_shape_3rd_derivatives() const
+{
+  if ((deferred_update_flags & update_3rd_derivatives) &&
+      !deferred_data_is_current)
+    const_cast<FEValuesBase<dim, spacedim> &>(*this).compute_deferred_data();
+  return this->finite_element_output.shape_3rd_derivatives;
+}
+
+
+
 template <int dim, int spacedim>
 inline const Tensor<2, spacedim> &
 FEValuesBase<dim, spacedim>::shape_hessian(const unsigned int i,
@@ -5027,7 +5185,7 @@ FEValuesBase<dim, spacedim>::shape_hessian(const unsigned int i,
   // if the entire FE is primitive,
   // then we can take a short-cut:
   if (fe->is_primitive())
-    return this->finite_element_output.shape_hessians[i][j];
+    return this->get_shape_hessians()[i][j];
   else
     {
       // otherwise, use the mapping
@@ -5042,7 +5200,7 @@ FEValuesBase<dim, spacedim>::shape_hessian(const unsigned int i,
         this->finite_element_output
           .shape_function_to_row_table[i * fe->n_components() +
                                        fe->system_to_component_index(i).first];
-      return this->finite_element_output.shape_hessians[row][j];
+      return this->get_shape_hessians()[row][j];
     }
 }
 
@@ -5074,7 +5232,7 @@ FEValuesBase<dim, spacedim>::shape_hessian_component(
   const unsigned int row =
     this->finite_element_output
       .shape_function_to_row_table[i * fe->n_components() + component];
-  return this->finite_element_output.shape_hessians[row][j];
+  return this->get_shape_hessians()[row][j];
 }
 
 
@@ -5093,7 +5251,7 @@ FEValuesBase<dim, spacedim>::shape_3rd_derivative(const unsigned int i,
   // if the entire FE is primitive,
   // then we can take a short-cut:
   if (fe->is_primitive())
-    return this->finite_element_output.shape_3rd_derivatives[i][j];
+    return this->get_shape_3rd_derivatives()[i][j];
   else
     {
       // otherwise, use the mapping
@@ -5108,7 +5266,7 @@ FEValuesBase<dim, spacedim>::shape_3rd_derivative(const unsigned int i,
         this->finite_element_output
           .shape_function_to_row_table[i * fe->n_components() +
                                        fe->system_to_component_index(i).first];
-      return this->finite_element_output.shape_3rd_derivatives[row][j];
+      return this->get_shape_3rd_derivatives()[row][j];
     }
 }
 
@@ -5140,7 +5298,7 @@ FEValuesBase<dim, spacedim>::shape_3rd_derivative_component(
   const unsigned int row =
     this->finite_element_output
       .shape_function_to_row_table[i * fe->n_components() + component];
-  return this->finite_element_output.shape_3rd_derivatives[row][j];
+  return this->get_shape_3rd_derivatives()[row][j];
 }
 
 
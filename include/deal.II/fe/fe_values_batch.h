@@ -0,0 +1,410 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_fe_values_batch_h
+#define dealii_fe_values_batch_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/derivative_form.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <memory>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*!@addtogroup feaccess */
+/*@{*/
+
+
+/**
+ * A class that evaluates finite element shape functions and mapping
+ * information on a batch of cells at once, and stores the results in the
+ * layout used by VectorizedArray: each field holds the values of the
+ * VectorizedArray::n_array_elements cells of the batch at a given
+ * quadrature point in the lanes of one VectorizedArray object. A loop that
+ * assembles a local matrix with this class therefore computes the local
+ * matrices of all cells of the batch with the same instructions,
+ * @code
+ *   FEValuesBatch<dim> fe_batch(fe, quadrature,
+ *                               update_gradients | update_JxW_values);
+ *   std::vector<AlignedVector<VectorizedArray<double>>> cell_matrix(...);
+ *
+ *   fe_batch.reinit(make_array_view(cells));
+ *   for (unsigned int q = 0; q < fe_batch.n_quadrature_points; ++q)
+ *     for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+ *       for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+ *         cell_matrix[i][j] += fe_batch.shape_grad(i, q) *
+ *                              fe_batch.shape_grad(j, q) *
+ *                              fe_batch.JxW(q);
+ * @endcode
+ * after which lane <tt>v</tt> of <tt>cell_matrix[i][j]</tt> is the entry of
+ * the local matrix of the cell <tt>cells[v]</tt>, which is then
+ * distributed into the global matrix as usual. Contrary to MatrixFree,
+ * which never forms matrices, this allows to vectorize the assembly of
+ * matrix-based methods without changing the way the global matrix is
+ * built.
+ *
+ * The information on each cell is computed by one FEValues object per
+ * lane, so all finite elements, mappings, and update flags supported by
+ * FEValues can be used, and each of these objects keeps detecting similar
+ * cells on its own. If the last batch of a loop contains fewer cells than
+ * there are lanes, the data of the unused lanes is set to zero, such that
+ * they do not contribute to sums over quadrature points.
+ *
+ * Since the data is stored for the single nonzero vector component of each
+ * shape function, the class only supports primitive finite elements.
+ */
+template <int dim, int spacedim = dim>
+class FEValuesBatch : public Subscriptor
+{
+public:
+  /**
+   * The vectorized data type in which the values of the cells of a batch
+   * are stored.
+   */
+  using VectorizedArrayType = VectorizedArray<double>;
+
+  /**
+   * The number of cells processed by one call to reinit().
+   */
+  static const unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+
+  /**
+   * Constructor. Sets up one FEValues object per lane with the given
+   * arguments.
+   */
+  FEValuesBatch(const Mapping<dim, spacedim> &      mapping,
+                const FiniteElement<dim, spacedim> &fe,
+                const Quadrature<dim> &             quadrature,
+                const UpdateFlags                   update_flags);
+
+  /**
+   * Constructor. This constructor is equivalent to the other one except that
+   * it makes the object use a $Q_1$ mapping (i.e., an object of type
+   * MappingQGeneric(1)) implicitly.
+   */
+  FEValuesBatch(const FiniteElement<dim, spacedim> &fe,
+                const Quadrature<dim> &             quadrature,
+                const UpdateFlags                   update_flags);
+
+  /**
+   * Compute the information for the cells given in @p cells, whose number
+   * must be positive and at most n_lanes. The cell <tt>cells[v]</tt> is
+   * stored in the lane <tt>v</tt> of the vectorized data. Any cell iterator
+   * accepted by FEValues::reinit() can be used.
+   */
+  template <typename CellIteratorType>
+  void
+  reinit(const ArrayView<const CellIteratorType> &cells);
+
+  /**
+   * Return the number of lanes filled by the last call to reinit().
+   */
+  unsigned int
+  n_filled_lanes() const;
+
+  /**
+   * Return the FEValues object that computed the data of lane @p lane,
+   * e.g. to access the cell of that lane or data not stored by this class.
+   */
+  const FEValues<dim, spacedim> &
+  get_fe_values(const unsigned int lane) const;
+
+  /**
+   * Return the finite element in use.
+   */
+  const FiniteElement<dim, spacedim> &
+  get_fe() const;
+
+  /**
+   * Return the update flags set for this object.
+   */
+  UpdateFlags
+  get_update_flags() const;
+
+  /**
+   * Return the value of the shape function @p i at the quadrature point
+   * @p q_point on all cells of the batch.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  const VectorizedArrayType &
+  shape_value(const unsigned int i, const unsigned int q_point) const;
+
+  /**
+   * Return the gradient of the shape function @p i at the quadrature point
+   * @p q_point on all cells of the batch.
+   *
+   * @dealiiRequiresUpdateFlags{update_gradients}
+   */
+  const Tensor<1, spacedim, VectorizedArrayType> &
+  shape_grad(const unsigned int i, const unsigned int q_point) const;
+
+  /**
+   * Return the product of the determinant of the Jacobian and the
+   * quadrature weight at the quadrature point @p q_point on all cells of the
+   * batch.
+   *
+   * @dealiiRequiresUpdateFlags{update_JxW_values}
+   */
+  const VectorizedArrayType &
+  JxW(const unsigned int q_point) const;
+
+  /**
+   * Return the Jacobian of the transformation at the quadrature point
+   * @p q_point on all cells of the batch.
+   *
+   * @dealiiRequiresUpdateFlags{update_jacobians}
+   */
+  const DerivativeForm<1, dim, spacedim, VectorizedArrayType> &
+  jacobian(const unsigned int q_point) const;
+
+  /**
+   * Return the location of the quadrature point @p q_point in real space on
+   * all cells of the batch.
+   *
+   * @dealiiRequiresUpdateFlags{update_quadrature_points}
+   */
+  const Point<spacedim, VectorizedArrayType> &
+  quadrature_point(const unsigned int q_point) const;
+
+  /**
+   * Return an estimate for the memory consumption, in bytes, of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * The number of quadrature points.
+   */
+  const unsigned int n_quadrature_points;
+
+  /**
+   * The number of shape functions per cell.
+   */
+  const unsigned int dofs_per_cell;
+
+private:
+  /**
+   * Copy the data of the first @p n_cells FEValues objects into the
+   * vectorized fields and set the data of the remaining lanes to zero.
+   */
+  void
+  gather(const unsigned int n_cells);
+
+  /**
+   * The update flags set for this object.
+   */
+  const UpdateFlags update_flags;
+
+  /**
+   * One FEValues object for each lane.
+   */
+  std::vector<std::unique_ptr<FEValues<dim, spacedim>>> fe_values;
+
+  /**
+   * The number of lanes filled by the last call to reinit().
+   */
+  unsigned int n_cells;
+
+  /**
+   * The values of the shape functions, stored with the index of the
+   * quadrature point running fastest.
+   */
+  AlignedVector<VectorizedArrayType> shape_values;
+
+  /**
+   * The gradients of the shape functions, in the same order as
+   * shape_values.
+   */
+  AlignedVector<Tensor<1, spacedim, VectorizedArrayType>> shape_gradients;
+
+  /**
+   * The JxW values at the quadrature points.
+   */
+  AlignedVector<VectorizedArrayType> JxW_values;
+
+  /**
+   * The Jacobians at the quadrature points.
+   */
+  AlignedVector<DerivativeForm<1, dim, spacedim, VectorizedArrayType>>
+    jacobians;
+
+  /**
+   * The locations of the quadrature points in real space.
+   */
+  AlignedVector<Point<spacedim, VectorizedArrayType>> quadrature_points;
+};
+
+/*@}*/
+
+
+/*---------------------------- inline functions ---------------------------*/
+
+#ifndef DOXYGEN
+
+template <int dim, int spacedim>
+template <typename CellIteratorType>
+inline void
+FEValuesBatch<dim, spacedim>::reinit(
+  const ArrayView<const CellIteratorType> &cells)
+{
+  Assert(cells.size() > 0, ExcMessage("The batch of cells is empty."));
+  AssertIndexRange(cells.size(), n_lanes + 1);
+
+  for (unsigned int v = 0; v < cells.size(); ++v)
+    fe_values[v]->reinit(cells[v]);
+
+  gather(cells.size());
+}
+
+
+
+template <int dim, int spacedim>
+inline unsigned int
+FEValuesBatch<dim, spacedim>::n_filled_lanes() const
+{
+  return n_cells;
+}
+
+
+
+template <int dim, int spacedim>
+inline const FEValues<dim, spacedim> &
+FEValuesBatch<dim, spacedim>::get_fe_values(const unsigned int lane) const
+{
+  AssertIndexRange(lane, n_cells);
+  return *fe_values[lane];
+}
+
+
+
+template <int dim, int spacedim>
+inline const FiniteElement<dim, spacedim> &
+FEValuesBatch<dim, spacedim>::get_fe() const
+{
+  return fe_values[0]->get_fe();
+}
+
+
+
+template <int dim, int spacedim>
+inline UpdateFlags
+FEValuesBatch<dim, spacedim>::get_update_flags() const
+{
+  return update_flags;
+}
+
+
+
+template <int dim, int spacedim>
+inline const typename FEValuesBatch<dim, spacedim>::VectorizedArrayType &
+FEValuesBatch<dim, spacedim>::shape_value(const unsigned int i,
+                                          const unsigned int q_point) const
+{
+  AssertIndexRange(i, dofs_per_cell);
+  AssertIndexRange(q_point, n_quadrature_points);
+  Assert(update_flags & update_values,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_values")));
+  return shape_values[i * n_quadrature_points + q_point];
+}
+
+
+
+template <int dim, int spacedim>
+inline const Tensor<1,
+                    spacedim,
+                    typename FEValuesBatch<dim, spacedim>::VectorizedArrayType>
+  &
+  FEValuesBatch<dim, spacedim>::shape_grad(const unsigned int i,
+                                           const unsigned int q_point) const
+{
+  AssertIndexRange(i, dofs_per_cell);
+  AssertIndexRange(q_point, n_quadrature_points);
+  Assert(update_flags & update_gradients,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_gradients")));
+  return shape_gradients[i * n_quadrature_points + q_point];
+}
+
+
+
+template <int dim, int spacedim>
+inline const typename FEValuesBatch<dim, spacedim>::VectorizedArrayType &
+FEValuesBatch<dim, spacedim>::JxW(const unsigned int q_point) const
+{
+  AssertIndexRange(q_point, n_quadrature_points);
+  Assert(update_flags & update_JxW_values,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_JxW_values")));
+  return JxW_values[q_point];
+}
+
+
+
+template <int dim, int spacedim>
+inline const DerivativeForm<
+  1,
+  dim,
+  spacedim,
+  typename FEValuesBatch<dim, spacedim>::VectorizedArrayType> &
+FEValuesBatch<dim, spacedim>::jacobian(const unsigned int q_point) const
+{
+  AssertIndexRange(q_point, n_quadrature_points);
+  Assert(update_flags & update_jacobians,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_jacobians")));
+  return jacobians[q_point];
+}
+
+
+
+template <int dim, int spacedim>
+inline const Point<spacedim,
+                   typename FEValuesBatch<dim, spacedim>::VectorizedArrayType>
+  &
+  FEValuesBatch<dim, spacedim>::quadrature_point(
+    const unsigned int q_point) const
+{
+  AssertIndexRange(q_point, n_quadrature_points);
+  Assert(update_flags & update_quadrature_points,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_quadrature_points")));
+  return quadrature_points[q_point];
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
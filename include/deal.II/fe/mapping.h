@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/derivative_form.h>
 
 #include <deal.II/fe/fe_update_flags.h>
@@ -456,6 +457,26 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &                                     p) const = 0;
 
+  /**
+   * Map the points @p real_points on the real @p cell to the corresponding
+   * points on the unit cell and store them in @p unit_points. The result is
+   * the same as calling transform_real_to_unit_cell() for each point, but
+   * derived classes can set up the data that only depends on the cell, such
+   * as the support points of the mapping, once for all points.
+   *
+   * For points where the inverse mapping fails, i.e., where
+   * transform_real_to_unit_cell() would throw an exception of type
+   * Mapping::ExcTransformationFailed, the first coordinate of the
+   * corresponding entry of @p unit_points is set to
+   * std::numeric_limits<double>::infinity(), which marks the point as
+   * outside of the reference cell for GeometryInfo::is_inside_unit_cell().
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const;
+
   /**
    * Transform the point @p p on the real @p cell to the corresponding point
    * on the unit cell, and then projects it to a dim-1  point on the face with
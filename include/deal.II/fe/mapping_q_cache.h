@@ -26,6 +26,8 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+template <int, int>
+class DoFHandler;
 
 
 /*!@addtogroup mapping */
@@ -38,6 +40,15 @@ DEAL_II_NAMESPACE_OPEN
  * which is used in all operations of MappingQGeneric. The information of the
  * mapping is pre-computed by the MappingQCache::initialize() function.
  *
+ * The cache is kept across a refinement or coarsening of the triangulation:
+ * the entries of cells that have been coarsened away are removed, and the
+ * support points of the newly created cells can be added with
+ * update_after_refinement(), which leaves the data of all other cells
+ * untouched. This makes the mapping suitable for adaptive computations
+ * where the setup of a high-order geometry for all cells would be
+ * expensive. The cache is cleared when the triangulation is created anew,
+ * cleared, or when its vertices are moved.
+ *
  * The use of this class is discussed extensively in step-65.
  *
  * @author Martin Kronbichler, 2019
@@ -78,14 +89,53 @@ public:
 
   /**
    * Initialize the data cache by computing the mapping support points for all
-   * cells (on all levels) of the given triangulation. Note that the cache is
-   * invalidated upon the signal Triangulation::Signals::any_change of the
-   * underlying triangulation.
+   * cells (on all levels) of the given triangulation. The work is split
+   * among the available threads. Note that the cache is invalidated upon the
+   * signals Triangulation::Signals::create, Triangulation::Signals::clear,
+   * and Triangulation::Signals::mesh_movement of the underlying
+   * triangulation. Upon refinement, the cache is kept for the cells that
+   * still exist, see update_after_refinement().
    */
   void
   initialize(const Triangulation<dim, spacedim> &  triangulation,
              const MappingQGeneric<dim, spacedim> &mapping);
 
+  /**
+   * Compute the mapping support points of all cells in the given
+   * triangulation that are not contained in the cache, i.e., the cells that
+   * have been created by a refinement since the last call to initialize()
+   * or this function, using the given @p mapping. The support points of all
+   * other cells are kept. If the cache has been invalidated or never been
+   * set up, this function is equivalent to initialize().
+   */
+  void
+  update_after_refinement(const Triangulation<dim, spacedim> &  triangulation,
+                          const MappingQGeneric<dim, spacedim> &mapping);
+
+  /**
+   * Initialize the data cache by letting the @p mapping describe the
+   * geometry of the active cells of the triangulation underlying @p
+   * dof_handler, displaced by the field given by @p vector. The finite
+   * element of @p dof_handler must have @p spacedim components that
+   * describe the displacement in the respective coordinate directions, as
+   * used for example by MappingQEulerian or MappingFEField. The displacement
+   * is evaluated at the unit support points of this mapping on each cell
+   * and added to the position given by @p mapping, so the computations are
+   * done once, and all subsequent operations with this class only use the
+   * cached points. A distributed @p vector must have the ghost values of
+   * the locally relevant degrees of freedom set.
+   *
+   * As opposed to the other initialize() function, only the active cells of
+   * the triangulation are filled, and the cache is invalidated upon any
+   * change of the triangulation, including refinement, because the
+   * displacement field has to be transferred to the new mesh anyway.
+   */
+  template <typename VectorType>
+  void
+  initialize(const Mapping<dim, spacedim> &   mapping,
+             const DoFHandler<dim, spacedim> &dof_handler,
+             const VectorType &               vector);
+
   /**
    * Return the memory consumption (in bytes) of the cache.
    */
@@ -111,10 +161,20 @@ private:
     support_point_cache;
 
   /**
-   * The connection to Triangulation::signals::any that must be reset once
-   * this class goes out of scope.
+   * Connect to the signals of the given @p triangulation that invalidate
+   * the cache. If @p keep_upon_refinement is true, the cache is only
+   * adjusted to a refinement and coarsening of the mesh rather than
+   * invalidated.
+   */
+  void
+  connect_to_triangulation(const Triangulation<dim, spacedim> &triangulation,
+                           const bool keep_upon_refinement);
+
+  /**
+   * The connections to the signals of the triangulation that must be reset
+   * once this class goes out of scope.
    */
-  boost::signals2::connection clear_signal;
+  std::vector<boost::signals2::connection> tria_listeners;
 };
 
 /*@}*/
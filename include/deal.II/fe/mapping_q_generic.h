@@ -183,6 +183,23 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &p) const override;
 
+  /**
+   * Map several points on the real @p cell to the unit cell. As opposed to
+   * calling transform_real_to_unit_cell() for each point, the support points
+   * of the mapping on the cell are only computed once, and the Newton
+   * iteration is run for VectorizedArray<double>::n_array_elements points at
+   * once, evaluating the mapping with sum factorization over the 1D
+   * polynomials. Points where this iteration does not converge are handled
+   * by the algorithm of transform_real_to_unit_cell() with line search. See
+   * the Mapping base class for the handling of points where the inverse
+   * mapping fails.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const override;
+
   /**
    * @}
    */
@@ -131,6 +131,11 @@ public:
 
   /**
    * Return a cell_iterator to the cell represented by this CellId.
+   *
+   * This function descends from the coarse cell through all levels of the
+   * triangulation. If many active cells need to be found, e.g., for data
+   * received from other processes, GridTools::Cache::get_active_cells()
+   * provides a lookup through a hash map that is kept between the calls.
    */
   template <int dim, int spacedim>
   typename Triangulation<dim, spacedim>::cell_iterator
@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/smartpointer.h>
 
@@ -226,6 +227,12 @@ struct CellData;
  * complex boundary condition surfaces and multiple materials - information
  * which is currently not easily obtained through Cubit's python interface.
  *
+ * <li> <tt>Binary</tt> format: a format of deal.II that stores the coarse
+ * mesh and the refinement state of a triangulation as blocks of binary data,
+ * see GridOut::write_binary() and read_binary(). Since no text has to be
+ * parsed, this format is by far the fastest way to read large meshes that
+ * have been generated or preprocessed by another deal.II program.
+ *
  * </ul>
  *
  * <h3>Structure of input grid data. The GridReordering class</h3>
@@ -335,6 +342,8 @@ public:
     vtk,
     /// Use read_assimp()
     assimp,
+    /// Use read_binary()
+    binary,
   };
 
   /**
@@ -404,6 +413,22 @@ public:
   void
   read_vtk(std::istream &in);
 
+  /**
+   * Read grid data from a file in the binary format of deal.II written by
+   * GridOut::write_binary(). The data is stored in blocks that are read
+   * directly into the arrays describing the mesh, so no text is parsed. The
+   * cells are known to be consistently oriented and are given to the
+   * triangulation as they are. If the file contains the refinement state of
+   * a refined mesh, the triangulation is then refined accordingly, one level
+   * at a time. The stream @p in should be opened in binary mode.
+   *
+   * Any triangulation can be created from the coarse mesh, but the
+   * refinement can only be restored for triangulations that are not derived
+   * from parallel::DistributedTriangulationBase.
+   */
+  void
+  read_binary(std::istream &in);
+
   /**
    * Read grid data from an unv file as generated by the Salome mesh
    * generator. Numerical data is ignored.
@@ -422,10 +447,24 @@ public:
    * the indicators in the file refer to manifolds (flag set to true)
    * or boundaries (flag set to false). If the flag is set, the
    * indicators are used for cells as manifold id, too.
+   *
+   * By default, the cells are checked and, if necessary, reordered by
+   * GridReordering::invert_all_cells_of_negative_grid() and
+   * GridReordering::reorder_cells() before they are passed to the
+   * triangulation. If @p trust_orientation_marker is set and the comments
+   * at the start of the file contain the line
+   * <tt># The cells of this mesh are consistently oriented.</tt>, as
+   * written by GridOut::write_ucd() if GridOutFlags::Ucd::write_preamble is
+   * set, both steps are skipped and the cells are passed to the
+   * triangulation as they are. Only set this flag for files that have been
+   * written by GridOut::write_ucd() and not modified afterwards, since the
+   * cells of a mesh that is not actually consistently oriented are then not
+   * corrected.
    */
   void
   read_ucd(std::istream &in,
-           const bool    apply_all_indicators_to_manifolds = false);
+           const bool    apply_all_indicators_to_manifolds = false,
+           const bool    trust_orientation_marker          = false);
 
   /**
    * Read grid data from an Abaqus file. Numerical and constitutive data is
@@ -494,6 +533,34 @@ public:
   void
   read_msh(std::istream &in);
 
+  /**
+   * Read grid data from an ASCII msh file of version 2 of the Gmsh format
+   * in parallel and feed it into the attached triangulation, which must be
+   * a parallel::fullydistributed::Triangulation on @p comm.
+   *
+   * Contrary to the function above, no process reads the whole file:
+   * every process only parses an equally sized byte range of the node and
+   * element sections. The cells in the byte range of a process become its
+   * locally owned cells, i.e., the mesh is partitioned in the order of the
+   * cells in the file. The vertex coordinates, the ghost cells around the
+   * locally owned cells, and the boundary ids given by the lower-dimensional
+   * elements of the file are then exchanged collectively among the processes
+   * that need them. The material and boundary ids are taken from the first
+   * tag of the elements, as in the function above.
+   *
+   * Since the process-local parts of the mesh are never assembled in one
+   * place, the cells are not reordered by GridReordering::reorder_cells().
+   * The cells in the file must therefore already be oriented consistently,
+   * which is the case for structured meshes and for meshes written by
+   * GridOut. Cells with negative volume are inverted, however.
+   *
+   * If the attached triangulation is not a
+   * parallel::fullydistributed::Triangulation, @p comm must consist of a
+   * single process and the file is read by the function above.
+   */
+  void
+  read_msh(const std::string &filename, const MPI_Comm comm);
+
   /**
    * Read grid data from a NetCDF file. The only data format currently
    * supported is the <tt>TAU grid format</tt>.
@@ -171,6 +171,11 @@ namespace GridOutFlags
      * so the default is to not write a preamble. However, a preamble can be
      * written using this flag.
      *
+     * The preamble also states that the cells are consistently oriented,
+     * which lets GridIn::read_ucd() skip the reordering of the cells when
+     * the file is read again if this is requested through its argument
+     * @p trust_orientation_marker.
+     *
      * Default: <code>false</code>.
      */
     bool write_preamble;
@@ -986,7 +991,9 @@ public:
     /// write() calls write_vtk()
     vtk,
     /// write() calls write_vtu()
-    vtu
+    vtu,
+    /// write() calls write_binary()
+    binary
   };
 
   /**
@@ -1261,6 +1268,34 @@ public:
   void
   write_vtu(const Triangulation<dim, spacedim> &tria, std::ostream &out) const;
 
+  /**
+   * Write the triangulation in the binary format of deal.II, which can be
+   * read with GridIn::read_binary() without parsing any text. Since the data
+   * is written in the native byte order of the machine, the stream @p out
+   * should be opened in binary mode.
+   *
+   * The file contains the coarse mesh of the triangulation as returned by
+   * GridTools::get_coarse_mesh_description(), i.e., the vertices, the
+   * material and manifold ids of the cells, and the boundary and manifold ids
+   * of the faces and, in 3d, the edges, followed by the refinement case of
+   * every cell of the triangulation. The latter are stored in a breadth-first
+   * traversal of the refinement hierarchy, starting from the coarse cells,
+   * so the file does not depend on the history of the triangulation or on
+   * the number of processes it is used with later on.
+   *
+   * The locations of the vertices of refined cells are not stored, but are
+   * computed anew from the manifolds of the triangulation into which the file
+   * is read.
+   *
+   * This function can not be used with triangulations derived from
+   * parallel::DistributedTriangulationBase, since these only know a part of
+   * the mesh on each process.
+   */
+  template <int dim, int spacedim>
+  void
+  write_binary(const Triangulation<dim, spacedim> &tria,
+               std::ostream &                      out) const;
+
   /**
    * Write triangulation in VTU format for each processor, and add a .pvtu file
    * for visualization in Visit or Paraview that describes the collection of VTU
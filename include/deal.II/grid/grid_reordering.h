@@ -640,6 +640,11 @@ public:
    * If a consistent reordering is not possible in dim=3, the original
    * connectivity data is restored.
    *
+   * The function first checks whether the cells are already consistently
+   * oriented, in which case they are left unchanged. This check sorts the
+   * edges of the cells by their vertices and uses multiple threads, so its
+   * cost and memory consumption are linear in the number of cells.
+   *
    * @param original_cells An object that contains the data that describes the
    * mesh.
    * @param use_new_style_ordering If true, then use the standard ordering of
@@ -665,6 +670,8 @@ public:
    * exception is thrown, in case cells are not uniformly oriented.
    *
    * Note, that this function should be called before reorder_cells().
+   *
+   * The cells are checked and inverted in parallel using multiple threads.
    */
   static void
   invert_all_cells_of_negative_grid(
@@ -720,11 +720,16 @@ namespace GridTools
    * Mapping::transform_unit_to_real(qpoints[c][0])
    * returns @p points[a].
    *
-   * The algorithm assumes it's easier to look for a point in the cell that was
-   * used previously. For this reason random points are, computationally
-   * speaking, the worst case scenario while points grouped by the cell to which
-   * they belong are the best case. Pre-sorting points, trying to minimize
-   * distances between them, might make the function extremely faster.
+   * The algorithm first sorts the points along a space-filling curve, so
+   * that consecutive points are likely to fall into the same cell. All
+   * consecutive points inside the bounding box of a candidate cell are then
+   * transformed at once with Mapping::transform_points_real_to_unit_cell(),
+   * which only sets up the mapping of the cell once, and only the points
+   * outside of that cell are searched for with
+   * GridTools::find_active_cell_around_point(). The points are processed in
+   * parallel as described in the @ref threads module. Pre-sorting the
+   * points is therefore not necessary. Within each cell, the points are
+   * listed in ascending order of their index in @p points.
    *
    * @note If a point is not found inside the mesh, or is lying inside an
    * artificial cell of a parallel::TriangulationBase, an exception is thrown.
@@ -1798,6 +1803,12 @@ namespace GridTools
    *
    * The rows and columns refer to the cells as they are traversed in their
    * natural order using cell iterators.
+   *
+   * The cost of this function is linear in the number of active cells. When
+   * a mesh is partitioned repeatedly, e.g., with different weights, the
+   * connectivity can be computed once, copied into a SparsityPattern, and
+   * given to the partition_triangulation() functions that take a connection
+   * graph as argument.
    */
   template <int dim, int spacedim>
   void
@@ -1870,6 +1881,14 @@ namespace GridTools
    * @note If the @p cell_weights vector is empty, then no weighting is taken
    * into consideration. If not then the size of this vector must equal to the
    * number of active cells in the triangulation.
+   *
+   * With METIS, several weights per cell can be balanced at the same time by
+   * giving a vector whose size is a multiple $n_c$ of the number of active
+   * cells, with the $n_c$ weights of the cell with active cell index $i$ at
+   * positions $i n_c$ to $(i+1) n_c-1$, see SparsityTools::partition(). For
+   * example, the weights $(1, n_p)$ with the number of particles $n_p$ in a
+   * cell yield partitions with both a similar number of cells and a similar
+   * number of particles.
    */
   template <int dim, int spacedim>
   void
@@ -2818,6 +2837,11 @@ namespace GridTools
    * you get the idea -- the code could, just as well, have exchanged
    * material ids, user indices, boundary indicators, or any kind of other
    * data with similar calls as the ones above.)
+   *
+   * This function identifies the cells by their CellId and serializes the
+   * data in every call. For data of a fixed size per cell that is exchanged
+   * repeatedly on the same mesh, the class GridTools::GhostCellDataExchanger
+   * sets up the communication pattern once and is considerably faster.
    */
   template <typename DataType, typename MeshType>
   void
@@ -3818,32 +3842,18 @@ namespace GridTools
                CellDataTransferBuffer<dim, DataType>>;
     DestinationToBufferMap destination_to_data_buffer_map;
 
-    std::map<unsigned int, std::set<dealii::types::subdomain_id>>
-      vertices_with_ghost_neighbors =
-        tria->compute_vertices_with_ghost_neighbors();
+    // the processors on which each locally owned cell is a ghost cell
+    const std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+      ghost_ranks_of_cells = tria->compute_ghost_ranks_of_locally_owned_cells();
 
     for (const auto &cell : tria->active_cell_iterators())
       if (cell->is_locally_owned())
         {
           std::set<dealii::types::subdomain_id> send_to;
-          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
-               ++v)
-            {
-              const std::map<unsigned int,
-                             std::set<dealii::types::subdomain_id>>::
-                const_iterator neighbor_subdomains_of_vertex =
-                  vertices_with_ghost_neighbors.find(cell->vertex_index(v));
-
-              if (neighbor_subdomains_of_vertex ==
-                  vertices_with_ghost_neighbors.end())
-                continue;
-
-              Assert(neighbor_subdomains_of_vertex->second.size() != 0,
-                     ExcInternalError());
-
-              send_to.insert(neighbor_subdomains_of_vertex->second.begin(),
-                             neighbor_subdomains_of_vertex->second.end());
-            }
+          const auto ghost_ranks =
+            ghost_ranks_of_cells.find(cell->active_cell_index());
+          if (ghost_ranks != ghost_ranks_of_cells.end())
+            send_to = ghost_ranks->second;
 
           if (send_to.size() > 0)
             {
@@ -25,6 +25,7 @@
 
 #include <deal.II/fe/mapping_q1.h>
 
+#include <deal.II/grid/cell_id.h>
 #include <deal.II/grid/grid_tools_cache_update_flags.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
@@ -36,6 +37,8 @@
 #include <boost/signals2.hpp>
 
 #include <cmath>
+#include <unordered_map>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -62,12 +65,45 @@ namespace GridTools
    * obsolete, and you will have to mark them as outdated, by calling the
    * method mark_for_update() manually.
    *
+   * The bounding boxes of the cells, which are the most expensive part of
+   * the cached data for higher order mappings, are computed in parallel
+   * using the facilities of the @ref threads module. When a serial
+   * Triangulation is adaptively refined or coarsened, the R-tree returned by
+   * get_cell_bounding_boxes_rtree() is not rebuilt. Instead, the entries of
+   * the cells removed by the refinement step are deleted from the tree and
+   * the entries of the new active cells are inserted, using the
+   * Triangulation::Signals::pre_coarsening_on_cell and
+   * Triangulation::Signals::post_refinement_on_cell signals. All other data
+   * structures are recomputed on their next access as before. For
+   * triangulations derived from parallel::TriangulationBase, where refinement
+   * also changes the ghost and artificial cells, all data is recomputed.
+   * The map from CellId objects to the active cells returned by
+   * get_cell_id_to_cell_map() is updated in the same way, by removing the
+   * cells that are no longer active and adding the new active cells.
+   *
    * @author Luca Heltai, 2017.
    */
   template <int dim, int spacedim = dim>
   class Cache : public Subscriptor
   {
   public:
+    /**
+     * A hash function for the binary representation of a CellId, used for
+     * the map returned by get_cell_id_to_cell_map().
+     */
+    struct CellIdHash
+    {
+      std::size_t
+      operator()(const CellId::binary_type &binary_id) const
+      {
+        std::size_t hash = 0;
+        for (const unsigned int entry : binary_id)
+          hash ^= std::hash<unsigned int>()(entry) + 0x9e3779b9 + (hash << 6) +
+                  (hash >> 2);
+        return hash;
+      }
+    };
+
     /**
      * Constructor.
      *
@@ -138,6 +174,56 @@ namespace GridTools
                 typename Triangulation<dim, spacedim>::active_cell_iterator>> &
     get_cell_bounding_boxes_rtree() const;
 
+    /**
+     * Return the cached map from the binary representation of the CellId,
+     * see CellId::to_binary(), of every active cell of the triangulation to
+     * the cell. In contrast to CellId::to_cell(), which descends from the
+     * coarse cell through the levels of the triangulation, a lookup in this
+     * map takes constant time on average.
+     */
+    const std::unordered_map<
+      CellId::binary_type,
+      typename Triangulation<dim, spacedim>::active_cell_iterator,
+      CellIdHash> &
+    get_cell_id_to_cell_map() const;
+
+    /**
+     * Return the active cells with the given @p cell_ids, using the map
+     * returned by get_cell_id_to_cell_map(). For the ids that do not
+     * describe an active cell of the triangulation, the end iterator of the
+     * triangulation is returned.
+     */
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+    get_active_cells(const std::vector<CellId> &cell_ids) const;
+
+    /**
+     * Return an array of all active cells of the triangulation, in the order
+     * in which Triangulation::active_cell_iterators() visits them.
+     *
+     * Iterating over this array avoids advancing through the levels of the
+     * triangulation and skipping the inactive cells, as the increment of the
+     * active cell iterators does. Since the array provides random access
+     * iterators, it can also be split into chunks of cells in constant
+     * time, e.g., by WorkStream::run() when called with
+     * <code>cells.begin()</code> and <code>cells.end()</code>, in which case
+     * the worker function receives an iterator into this array that needs
+     * to be dereferenced to obtain the cell.
+     */
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator> &
+    get_active_cell_iterators() const;
+
+    /**
+     * Like get_active_cell_iterators(), but only for the locally owned active
+     * cells, i.e., the cells that a loop over
+     * <code>filter_iterators(triangulation.active_cell_iterators(),
+     * IteratorFilters::LocallyOwnedCell())</code> visits. For triangulations
+     * that are not parallel ones, these are all active cells.
+     */
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator> &
+    get_locally_owned_active_cell_iterators() const;
+
     /**
      * Return a reference to the stored triangulation.
      */
@@ -187,11 +273,78 @@ namespace GridTools
 #endif
 
   private:
+    /**
+     * Start an adaptation step of the triangulation, called by the
+     * Triangulation::Signals::pre_refinement signal. If the R-tree of the
+     * cell bounding boxes is up to date and can be updated incrementally, the
+     * entries of the cells flagged for refinement are removed from it.
+     */
+    void
+    pre_refinement();
+
+    /**
+     * Record that the children of @p cell are going to be removed
+     * (Triangulation::Signals::pre_coarsening_on_cell) or have been created
+     * (Triangulation::Signals::post_refinement_on_cell). In the former case,
+     * the entries of the children are removed from the R-tree of the cell
+     * bounding boxes.
+     */
+    void
+    record_adapted_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const bool will_be_coarsened);
+
+    /**
+     * Finish an adaptation step of the triangulation, called by the
+     * Triangulation::Signals::post_refinement signal: the entries of the new
+     * active cells are inserted into the R-tree of the cell bounding boxes
+     * and all other data structures are marked for update.
+     */
+    void
+    post_refinement();
+
+    /**
+     * Remove the entry of @p cell from the R-tree of the cell bounding boxes.
+     * If no such entry is found, the tree is marked for a complete update.
+     */
+    void
+    remove_cell_bounding_box(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell);
+
     /**
      * Keep track of what needs to be updated next.
      */
     mutable CacheUpdateFlags update_flags;
 
+    /**
+     * Whether the triangulation is currently between the
+     * Triangulation::Signals::pre_refinement and
+     * Triangulation::Signals::post_refinement signals, in which case the
+     * Triangulation::Signals::any_change signal is left to post_refinement().
+     */
+    bool in_refinement;
+
+    /**
+     * Whether the R-tree of the cell bounding boxes is updated incrementally
+     * in the current adaptation step.
+     */
+    bool update_rtree_incrementally;
+
+    /**
+     * Whether the map from CellId objects to the active cells is updated
+     * incrementally in the current adaptation step.
+     */
+    bool update_cell_id_map_incrementally;
+
+    /**
+     * The cells whose children have been created or removed in the current
+     * adaptation step, whose new active cells need to be inserted into the
+     * R-tree of the cell bounding boxes and the map from CellId objects to
+     * the active cells.
+     */
+    std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+      adapted_cells;
+
     /**
      * A pointer to the Triangulation.
      */
@@ -252,9 +405,28 @@ namespace GridTools
       cell_bounding_boxes_rtree;
 
     /**
-     * Storage for the status of the triangulation signal.
+     * Store the map from the CellId of the active cells to the cells.
+     */
+    mutable std::unordered_map<
+      CellId::binary_type,
+      typename Triangulation<dim, spacedim>::active_cell_iterator,
+      CellIdHash>
+      cell_id_to_cell;
+
+    /**
+     * Store the arrays of the active and the locally owned active cells.
+     */
+    mutable std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator>
+      active_cells;
+    mutable std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator>
+      locally_owned_active_cells;
+
+    /**
+     * Storage for the status of the triangulation signals.
      */
-    boost::signals2::connection tria_signal;
+    std::vector<boost::signals2::connection> tria_signals;
   };
 
 
@@ -83,10 +83,20 @@ namespace GridTools
      */
     update_covering_rtree = 0x040,
 
+    /**
+     * Update the map from the CellId of the active cells to the cells.
+     */
+    update_cell_id_to_cell_map = 0x080,
+
+    /**
+     * Update the arrays of the active and the locally owned active cells.
+     */
+    update_active_cell_iterators = 0x100,
+
     /**
      * Update all objects.
      */
-    update_all = 0x0FF,
+    update_all = 0x1FF,
   };
 
 
@@ -106,6 +116,10 @@ namespace GridTools
       s << "|vertex_to_cells_centers_directions";
     if (u & update_covering_rtree)
       s << "|covering_rtree";
+    if (u & update_cell_id_to_cell_map)
+      s << "|cell_id_to_cell_map";
+    if (u & update_active_cell_iterators)
+      s << "|active_cell_iterators";
 #ifdef DEAL_II_WITH_NANOFLANN
     if (u & update_vertex_kdtree)
       s << "|vertex_kdtree";
@@ -0,0 +1,258 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_grid_grid_tools_ghost_cell_data_exchanger_h
+#define dealii_grid_grid_tools_ghost_cell_data_exchanger_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <cstring>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace GridTools
+{
+  /**
+   * A class that exchanges data stored per active cell from the locally
+   * owned cells to the ghost cells on other processes, like
+   * GridTools::exchange_cell_data_to_ghosts(), but for data that is
+   * exchanged repeatedly on the same mesh, e.g., cell-wise material states
+   * or limiter indicators that change in every time step.
+   *
+   * The communication pattern is computed once by reinit(): For each
+   * process that owns ghost cells of the present one or has ghost cells
+   * owned by the present one, this class records the list of cells whose
+   * data is received from or sent to the respective process, in the same
+   * order on both sides. This is the only step that identifies cells across
+   * processes by their CellId. The function exchange() then only copies the
+   * entries of the cells in these lists from and to contiguous buffers and
+   * sends them as raw bytes, without any serialization and without looking
+   * up cells.
+   *
+   * The data is given as an array indexed by the active cell index, see
+   * CellAccessor::active_cell_index(), with a fixed number of entries per
+   * cell:
+   * @code
+   *   GridTools::GhostCellDataExchanger<dim> exchanger(triangulation);
+   *   Vector<float> indicators(triangulation.n_active_cells());
+   *   for (const auto &cell : triangulation.active_cell_iterators())
+   *     if (cell->is_locally_owned())
+   *       indicators[cell->active_cell_index()] = compute_indicator(cell);
+   *   exchanger.exchange(make_array_view(indicators));
+   * @endcode
+   *
+   * The communication pattern becomes invalid when the triangulation
+   * changes, in which case reinit() needs to be called again. For
+   * triangulations that are not derived from parallel::TriangulationBase
+   * or if deal.II was configured without MPI, there are no ghost cells and
+   * exchange() does nothing.
+   */
+  template <int dim, int spacedim = dim>
+  class GhostCellDataExchanger : public Subscriptor
+  {
+  public:
+    /**
+     * Default constructor. Call reinit() before using this object.
+     */
+    GhostCellDataExchanger() = default;
+
+    /**
+     * Constructor. Calls reinit() with the given triangulation.
+     */
+    explicit GhostCellDataExchanger(
+      const Triangulation<dim, spacedim> &triangulation);
+
+    /**
+     * Compute the lists of cells whose data is sent to and received from
+     * the other processes. This is a collective operation on the processes
+     * of the communicator of the triangulation.
+     */
+    void
+    reinit(const Triangulation<dim, spacedim> &triangulation);
+
+    /**
+     * Send the entries of @p data that belong to locally owned cells to the
+     * processes where these cells are ghost cells, and overwrite the
+     * entries of the ghost cells by the data received from their owners.
+     * The array @p data holds @p n_components entries per active cell,
+     * with the entries of the cell with active cell index <tt>i</tt> at
+     * positions <tt>i*n_components</tt> to <tt>(i+1)*n_components-1</tt>.
+     * The type @p Number needs to be trivially copyable.
+     *
+     * This is a collective operation on the processes of the communicator
+     * of the triangulation given to reinit().
+     */
+    template <typename Number>
+    void
+    exchange(const ArrayView<Number> &data,
+             const unsigned int       n_components = 1) const;
+
+    /**
+     * Return the number of ghost cells whose data is received in
+     * exchange().
+     */
+    unsigned int
+    n_ghost_cells() const;
+
+  private:
+    /**
+     * The number of active cells of the triangulation given to reinit().
+     */
+    unsigned int n_active_cells = 0;
+
+    /**
+     * The communicator of the triangulation.
+     */
+    MPI_Comm communicator = MPI_COMM_SELF;
+
+    /**
+     * The processes to which data is sent, and the active cell indices of
+     * the locally owned cells whose data is sent to each of them.
+     */
+    std::vector<types::subdomain_id>       send_ranks;
+    std::vector<std::vector<unsigned int>> send_cells;
+
+    /**
+     * The processes from which data is received, and the active cell
+     * indices of the ghost cells whose data is received from each of them.
+     */
+    std::vector<types::subdomain_id>       receive_ranks;
+    std::vector<std::vector<unsigned int>> receive_cells;
+
+    /**
+     * Buffers for the data sent and received in exchange(), kept between
+     * the calls to avoid allocating them every time.
+     */
+    mutable std::vector<std::vector<char>> send_buffers;
+    mutable std::vector<std::vector<char>> receive_buffers;
+  };
+
+
+
+  /* ---------------------- inline and template functions ------------------ */
+
+#ifndef DOXYGEN
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  GhostCellDataExchanger<dim, spacedim>::n_ghost_cells() const
+  {
+    unsigned int n_cells = 0;
+    for (const auto &cells : receive_cells)
+      n_cells += cells.size();
+    return n_cells;
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename Number>
+  inline void
+  GhostCellDataExchanger<dim, spacedim>::exchange(
+    const ArrayView<Number> &data,
+    const unsigned int       n_components) const
+  {
+    AssertDimension(data.size(),
+                    static_cast<std::size_t>(n_active_cells) * n_components);
+#  ifdef DEAL_II_WITH_MPI
+    const std::size_t bytes_per_cell = n_components * sizeof(Number);
+
+    // post the receives first, as the sizes of the messages are known
+    std::vector<MPI_Request> receive_requests(receive_ranks.size());
+    receive_buffers.resize(receive_ranks.size());
+    for (unsigned int p = 0; p < receive_ranks.size(); ++p)
+      {
+        receive_buffers[p].resize(receive_cells[p].size() * bytes_per_cell);
+        const int ierr = MPI_Irecv(receive_buffers[p].data(),
+                                   receive_buffers[p].size(),
+                                   MPI_BYTE,
+                                   receive_ranks[p],
+                                   788,
+                                   communicator,
+                                   &receive_requests[p]);
+        AssertThrowMPI(ierr);
+      }
+
+    std::vector<MPI_Request> send_requests(send_ranks.size());
+    send_buffers.resize(send_ranks.size());
+    for (unsigned int p = 0; p < send_ranks.size(); ++p)
+      {
+        send_buffers[p].resize(send_cells[p].size() * bytes_per_cell);
+        char *buffer = send_buffers[p].data();
+        for (const unsigned int cell : send_cells[p])
+          {
+            std::memcpy(buffer,
+                        data.data() + cell * n_components,
+                        bytes_per_cell);
+            buffer += bytes_per_cell;
+          }
+        const int ierr = MPI_Isend(send_buffers[p].data(),
+                                   send_buffers[p].size(),
+                                   MPI_BYTE,
+                                   send_ranks[p],
+                                   788,
+                                   communicator,
+                                   &send_requests[p]);
+        AssertThrowMPI(ierr);
+      }
+
+    for (unsigned int c = 0; c < receive_ranks.size(); ++c)
+      {
+        int       p    = 0;
+        const int ierr = MPI_Waitany(receive_requests.size(),
+                                     receive_requests.data(),
+                                     &p,
+                                     MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+
+        const char *buffer = receive_buffers[p].data();
+        for (const unsigned int cell : receive_cells[p])
+          {
+            std::memcpy(data.data() + cell * n_components,
+                        buffer,
+                        bytes_per_cell);
+            buffer += bytes_per_cell;
+          }
+      }
+
+    if (send_requests.size() > 0)
+      {
+        const int ierr = MPI_Waitall(send_requests.size(),
+                                     send_requests.data(),
+                                     MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+#  else
+    (void)data;
+    (void)n_components;
+#  endif
+  }
+
+#endif // DOXYGEN
+
+} // namespace GridTools
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
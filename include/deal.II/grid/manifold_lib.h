@@ -21,11 +21,14 @@
 
 #include <deal.II/base/function.h>
 #include <deal.II/base/function_parser.h>
+#include <deal.II/base/thread_local_storage.h>
 
 #include <deal.II/grid/manifold.h>
 
 #include <boost/container/small_vector.hpp>
 
+#include <map>
+
 DEAL_II_NAMESPACE_OPEN
 
 /**
@@ -969,6 +972,14 @@ public:
    *
    * @note The triangulation used to construct the manifold must not be
    * destroyed during the usage of this object.
+   *
+   * This class stores the chart coordinates of the points it has pulled
+   * back, such that the Newton iterations are not repeated for vertices
+   * that surround several new points, e.g., during the refinement of all
+   * lines, faces, and cells around a vertex. The cache is kept separately
+   * on each thread and is emptied by this function and whenever the
+   * triangulation signals a change, i.e., after each refinement cycle and
+   * after Triangulation::signals::mesh_movement.
    */
   void
   initialize(const Triangulation<dim, spacedim> &triangulation);
@@ -1126,6 +1137,52 @@ private:
    * this class goes out of scope.
    */
   boost::signals2::connection clear_signal;
+
+  /**
+   * The connection to Triangulation::signals::any_change that empties the
+   * cache of chart points.
+   */
+  boost::signals2::connection change_signal;
+
+  /**
+   * A lexicographic ordering of points, used as the ordering of the keys of
+   * chart_point_cache.
+   */
+  struct PointComparator
+  {
+    bool
+    operator()(const Point<spacedim> &a, const Point<spacedim> &b) const
+    {
+      for (unsigned int d = 0; d < spacedim; ++d)
+        if (a[d] != b[d])
+          return a[d] < b[d];
+      return false;
+    }
+  };
+
+  /**
+   * The type of the cache of chart points, mapping a point to pairs of the
+   * index of the coarse cell and the coordinates on that cell. Points on the
+   * interface between coarse cells may have entries for several cells.
+   */
+  using ChartPointCache = std::map<
+    Point<spacedim>,
+    boost::container::small_vector<std::pair<unsigned int, Point<dim>>, 2>,
+    PointComparator>;
+
+  /**
+   * The chart coordinates of the points pulled back by
+   * compute_chart_points(). Each thread has its own cache, such that new
+   * points can be computed from several threads at once without locking. A
+   * cache is emptied once it holds more than max_chart_point_cache_size
+   * points.
+   */
+  mutable Threads::ThreadLocalStorage<ChartPointCache> chart_point_cache;
+
+  /**
+   * The maximal number of points stored in the cache of one thread.
+   */
+  static const unsigned int max_chart_point_cache_size = 65536;
 };
 
 DEAL_II_NAMESPACE_CLOSE
@@ -46,6 +46,8 @@ DEAL_II_NAMESPACE_OPEN
 
 // Forward declarations
 #ifndef DOXYGEN
+class MemoryReport;
+
 template <int dim, int spacedim>
 class Manifold;
 
@@ -191,6 +193,14 @@ struct CellData
    * - manifold id to numbers::flat_manifold_id
    */
   CellData();
+
+  /**
+   * Write or read the data of this object to or from a stream for the
+   * purpose of serialization.
+   */
+  template <class Archive>
+  void
+  serialize(Archive &ar, const unsigned int version);
 };
 
 
@@ -3424,6 +3434,19 @@ public:
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Add the memory consumption of this object to @p report, split into the
+   * cells of each level, the faces, the vertices, and the remaining data,
+   * with @p name as prefix of the entries. The sum of the entries is equal
+   * to memory_consumption().
+   *
+   * This function is made virtual so that derived classes can report their
+   * additional data separately.
+   */
+  virtual void
+  add_memory_consumption(MemoryReport &     report,
+                         const std::string &name = "Triangulation") const;
+
   /**
    * Write the data of this object to a stream for the purpose of
    * serialization.
@@ -4125,6 +4148,18 @@ inline CellData<structdim>::CellData()
 
 
 
+template <int structdim>
+template <class Archive>
+void
+CellData<structdim>::serialize(Archive &ar, const unsigned int /*version*/)
+{
+  ar &vertices;
+  ar &material_id;
+  ar &manifold_id;
+}
+
+
+
 namespace internal
 {
   namespace TriangulationImplementation
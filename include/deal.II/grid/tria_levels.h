@@ -133,9 +133,20 @@ namespace internal
        * In contrast to the subdomain_id, this number is also used on inactive
        * cells once the mesh has been partitioned also on the lower levels of
        * the multigrid hierarchy.
+       *
+       * Since most programs do not use level subdomain ids, this vector is
+       * only allocated once a nonzero level subdomain id is assigned to a
+       * cell of this level. As long as it is not allocated, all cells of the
+       * level have the level subdomain id zero.
        */
       std::vector<types::subdomain_id> level_subdomain_ids;
 
+      /**
+       * Records whether @p level_subdomain_ids has been allocated, which
+       * allows to set level subdomain ids from several threads at once.
+       */
+      LazyAllocation level_subdomain_ids_allocation;
+
       /**
        * One integer for every consecutive pair of cells to store which index
        * their parent has.
@@ -228,6 +239,7 @@ namespace internal
       std::vector<std::pair<int, int>> neighbors;
       std::vector<types::subdomain_id> subdomain_ids;
       std::vector<types::subdomain_id> level_subdomain_ids;
+      LazyAllocation                   level_subdomain_ids_allocation;
       std::vector<int>                 parents;
 
       // The following is not used
@@ -284,6 +296,8 @@ namespace internal
       ar &neighbors;
       ar &subdomain_ids;
       ar &level_subdomain_ids;
+      if (Archive::is_loading::value)
+        level_subdomain_ids_allocation.set(!level_subdomain_ids.empty());
       ar &parents;
       ar &direction_flags;
       ar &cells;
@@ -304,6 +318,8 @@ namespace internal
       ar &neighbors;
       ar &subdomain_ids;
       ar &level_subdomain_ids;
+      if (Archive::is_loading::value)
+        level_subdomain_ids_allocation.set(!level_subdomain_ids.empty());
       ar &parents;
       ar &direction_flags;
       ar &cells;
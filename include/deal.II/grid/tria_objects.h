@@ -20,9 +20,11 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/grid/tria_object.h>
 
+#include <atomic>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -53,6 +55,97 @@ namespace internal
 {
   namespace TriangulationImplementation
   {
+    /**
+     * A helper class for the arrays of the triangulation that are only
+     * allocated on their first write access, such as TriaObjects::user_data.
+     * The first write access may happen from several threads at once, e.g.
+     * when setting the user data of different cells in parallel. This class
+     * records whether the array has been allocated in an atomic flag, such
+     * that other threads can check it without a data race, and allocates the
+     * array under a mutex. As opposed to std::atomic and std::mutex, objects
+     * of this class can be copied along with the structures holding them.
+     */
+    class LazyAllocation
+    {
+    public:
+      /**
+       * Constructor. The array is not allocated.
+       */
+      LazyAllocation()
+        : is_allocated(false)
+      {}
+
+      /**
+       * Copy constructor, copying the state of the flag.
+       */
+      LazyAllocation(const LazyAllocation &other)
+        : is_allocated(other.allocated())
+      {}
+
+      /**
+       * Copy operator, copying the state of the flag.
+       */
+      LazyAllocation &
+      operator=(const LazyAllocation &other)
+      {
+        is_allocated.store(other.allocated(), std::memory_order_release);
+        return *this;
+      }
+
+      /**
+       * Return whether the array has been allocated. If this function
+       * returns true, the allocation is visible to the calling thread.
+       */
+      bool
+      allocated() const
+      {
+        return is_allocated.load(std::memory_order_acquire);
+      }
+
+      /**
+       * Call @p allocate unless the array has been allocated before. If
+       * several threads call this function at once, only one of them
+       * allocates the array and the others wait until it is done.
+       */
+      template <typename AllocateFunction>
+      void
+      ensure_allocated(const AllocateFunction &allocate)
+      {
+        if (allocated())
+          return;
+
+        std::lock_guard<std::mutex> lock(allocation_mutex);
+        if (is_allocated.load(std::memory_order_relaxed) == false)
+          {
+            allocate();
+            is_allocated.store(true, std::memory_order_release);
+          }
+      }
+
+      /**
+       * Set the state of the flag. This function must not be called
+       * concurrently with other accesses to the array.
+       */
+      void
+      set(const bool allocated)
+      {
+        is_allocated.store(allocated, std::memory_order_release);
+      }
+
+    private:
+      /**
+       * Whether the array has been allocated.
+       */
+      std::atomic<bool> is_allocated;
+
+      /**
+       * The mutex guarding the allocation.
+       */
+      Threads::Mutex allocation_mutex;
+    };
+
+
+
     /**
      * General template for information belonging to the geometrical objects
      * of a triangulation, i.e. lines, quads, hexahedra...  Apart from the
@@ -404,9 +497,21 @@ namespace internal
       /**
        * Pointer which is not used by the library but may be accessed and set
        * by the user to handle data local to a line/quad/etc.
+       *
+       * Since most programs do not use user data, this vector is only
+       * allocated on the first write access to the user pointer or user index
+       * of any object, and released again by clear_user_data(). As long as it
+       * is not allocated, the user data of all objects is zero. The
+       * allocation is guarded by @p user_data_allocation, so the first write
+       * accesses may happen from several threads at once.
        */
       std::vector<UserData> user_data;
 
+      /**
+       * Records whether @p user_data has been allocated.
+       */
+      LazyAllocation user_data_allocation;
+
       /**
        * In order to avoid confusion between user pointers and indices, this
        * enum is set by the first function accessing either and subsequent
@@ -635,6 +740,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
+      user_data_allocation.ensure_allocated(
+        [&]() { user_data.resize(cells.size()); });
+
       Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
       return user_data[i].p;
     }
@@ -648,7 +756,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (user_data_allocation.allocated() == false)
+        return nullptr;
       return user_data[i].p;
     }
 
@@ -661,6 +771,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
+      user_data_allocation.ensure_allocated(
+        [&]() { user_data.resize(cells.size()); });
+
       Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
       return user_data[i].i;
     }
@@ -670,8 +783,9 @@ namespace internal
     inline void
     TriaObjects<G>::clear_user_data(const unsigned int i)
     {
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
-      user_data[i].i = 0;
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (user_data_allocation.allocated())
+        user_data[i].i = 0;
     }
 
 
@@ -692,7 +806,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (user_data_allocation.allocated() == false)
+        return 0;
       return user_data[i].i;
     }
 
@@ -702,8 +818,10 @@ namespace internal
     TriaObjects<G>::clear_user_data()
     {
       user_data_type = data_unknown;
-      for (unsigned int i = 0; i < user_data.size(); ++i)
-        user_data[i].p = nullptr;
+
+      // swap with an empty vector to actually release the memory
+      std::vector<UserData>().swap(user_data);
+      user_data_allocation.set(false);
     }
 
 
@@ -739,6 +857,8 @@ namespace internal
       ar &       manifold_id;
       ar &next_free_single &next_free_pair &reverse_order_next_free_single;
       ar &user_data &user_data_type;
+      if (Archive::is_loading::value)
+        user_data_allocation.set(!user_data.empty());
     }
 
 
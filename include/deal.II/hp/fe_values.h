@@ -48,6 +48,15 @@ namespace hp
    * make things more efficient, however, these FE*Values objects are only
    * created once requested (lazy allocation).
    *
+   * Copies of this class, as created for example by WorkStream for the
+   * scratch data of every thread, have their own FE*Values objects, since
+   * these are modified by every call to reinit(). For ::FEValues, the
+   * objects of a copy are created lazily from the ones the original had
+   * created, using the copy constructor of ::FEValues: The tables of the
+   * shape functions on the reference cell are then shared by all copies and
+   * only the data that depends on the present cell is stored separately
+   * for every copy.
+   *
    * The first template parameter denotes the space dimension we are in, the
    * second the dimensionality of the object that we integrate on, i.e. for
    * usual @p hp::FEValues it is equal to the first one, while for face
@@ -83,6 +92,14 @@ namespace hp
       const QCollection<q_dim> &                              q_collection,
       const UpdateFlags                                       update_flags);
 
+    /**
+     * Copy constructor. The new object does not share any FE*Values object
+     * with @p other, but creates its own ones when they are first requested,
+     * reusing the precomputed data of the objects of @p other as far as
+     * possible.
+     */
+    FEValuesBase(const FEValuesBase<dim, q_dim, FEValuesType> &other);
+
     /**
      * Get a reference to the collection of finite element objects used
      * here.
@@ -165,12 +182,27 @@ namespace hp
      */
     Table<3, std::shared_ptr<FEValuesType>> fe_values_table;
 
+    /**
+     * A table of the same size as the previous one with the FE*Values
+     * objects of the object this one was copied from, from which the
+     * entries of #fe_values_table are created lazily. Empty if this object
+     * was not created by the copy constructor.
+     */
+    Table<3, std::shared_ptr<const FEValuesType>> prototype_table;
+
     /**
      * Set of indices pointing at the fe_values object selected last time
      * the select_fe_value() function was called.
      */
     TableIndices<3> present_fe_values_index;
 
+    /**
+     * The fe_values object selected last time the select_fe_value()
+     * function was called. Used to return it without looking at the table
+     * if the same indices are requested again.
+     */
+    FEValuesType *present_fe_values;
+
     /**
      * Values of the update flags as given to the constructor.
      */
@@ -604,7 +636,9 @@ namespace hp
   inline const FEValuesType &
   FEValuesBase<dim, q_dim, FEValuesType>::get_present_fe_values() const
   {
-    return *fe_values_table(present_fe_values_index);
+    Assert(present_fe_values != nullptr,
+           ExcMessage("No FEValues object has been selected yet."));
+    return *present_fe_values;
   }
 
 
@@ -102,23 +102,37 @@ namespace LocalIntegrators
       AssertDimension(M.n(), n_dofs);
       AssertDimension(M.m(), t_dofs);
 
+      // Collect the weighted directional derivatives of the test functions
+      // and the values of the trial functions in tables with one row per
+      // shape function and one column per quadrature point and component,
+      // such that the matrix is a single matrix-matrix product computed by
+      // FullMatrix::mTmult().
+      const unsigned int n_columns = fe.n_quadrature_points * n_components;
+      FullMatrix<double> derivatives(t_dofs, n_columns);
+      FullMatrix<double> values(n_dofs, n_columns);
       for (unsigned k = 0; k < fe.n_quadrature_points; ++k)
         {
           const double       dx     = factor * fe.JxW(k);
           const unsigned int vindex = k * v_increment;
 
-          for (unsigned j = 0; j < n_dofs; ++j)
-            for (unsigned i = 0; i < t_dofs; ++i)
-              for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int c = 0; c < n_components; ++c)
+            {
+              const unsigned int column = k * n_components + c;
+              for (unsigned i = 0; i < t_dofs; ++i)
                 {
                   double wgradv =
                     velocity[0][vindex] * fe.shape_grad_component(i, k, c)[0];
                   for (unsigned int d = 1; d < dim; ++d)
                     wgradv +=
                       velocity[d][vindex] * fe.shape_grad_component(i, k, c)[d];
-                  M(i, j) -= dx * wgradv * fe.shape_value_component(j, k, c);
+                  derivatives(i, column) = -dx * wgradv;
                 }
+              for (unsigned j = 0; j < n_dofs; ++j)
+                values(j, column) = fe.shape_value_component(j, k, c);
+            }
         }
+
+      derivatives.mTmult(M, values, true);
     }
 
 
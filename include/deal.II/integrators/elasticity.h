@@ -60,19 +60,31 @@ namespace LocalIntegrators
       AssertDimension(M.m(), n_dofs);
       AssertDimension(M.n(), n_dofs);
 
+      // Collect the entries of twice the symmetric gradients of the shape
+      // functions in a table with one row per shape function and one column
+      // per quadrature point and tensor entry, and the weighted entries in a
+      // second table. The matrix is then a single matrix-matrix product,
+      // which FullMatrix::mTmult() computes with BLAS if available.
+      const unsigned int n_columns = fe.n_quadrature_points * dim * dim;
+      FullMatrix<double> gradients(n_dofs, n_columns);
+      FullMatrix<double> weighted_gradients(n_dofs, n_columns);
       for (unsigned int k = 0; k < fe.n_quadrature_points; ++k)
         {
           const double dx = factor * fe.JxW(k);
           for (unsigned int i = 0; i < n_dofs; ++i)
-            for (unsigned int j = 0; j < n_dofs; ++j)
-              for (unsigned int d1 = 0; d1 < dim; ++d1)
-                for (unsigned int d2 = 0; d2 < dim; ++d2)
-                  M(i, j) += dx * .25 *
-                             (fe.shape_grad_component(j, k, d1)[d2] +
-                              fe.shape_grad_component(j, k, d2)[d1]) *
-                             (fe.shape_grad_component(i, k, d1)[d2] +
-                              fe.shape_grad_component(i, k, d2)[d1]);
+            for (unsigned int d1 = 0; d1 < dim; ++d1)
+              for (unsigned int d2 = 0; d2 < dim; ++d2)
+                {
+                  const unsigned int column = (k * dim + d1) * dim + d2;
+                  gradients(i, column) =
+                    fe.shape_grad_component(i, k, d1)[d2] +
+                    fe.shape_grad_component(i, k, d2)[d1];
+                  weighted_gradients(i, column) =
+                    .25 * dx * gradients(i, column);
+                }
         }
+
+      gradients.mTmult(M, weighted_gradients, true);
     }
 
 
@@ -66,31 +66,32 @@ namespace LocalIntegrators
     {
       const unsigned int n_dofs       = fe.dofs_per_cell;
       const unsigned int n_components = fe.get_fe().n_components();
+      const unsigned int n_q_points   = fe.n_quadrature_points;
 
-      for (unsigned int k = 0; k < fe.n_quadrature_points; ++k)
-        {
-          const double dx = fe.JxW(k) * factor;
-          for (unsigned int i = 0; i < n_dofs; ++i)
-            {
-              double Mii = 0.0;
-              for (unsigned int d = 0; d < n_components; ++d)
-                Mii += dx * fe.shape_value_component(i, k, d) *
-                       fe.shape_value_component(i, k, d);
+      AssertDimension(M.m(), n_dofs);
+      AssertDimension(M.n(), n_dofs);
 
-              M(i, i) += Mii;
+      // Collect the values of the shape functions in a table with one row
+      // per shape function and one column per quadrature point and
+      // component, and the weighted values in a second table, such that the
+      // mass matrix is a single matrix-matrix product. FullMatrix::mTmult()
+      // computes it with BLAS if available.
+      const unsigned int n_columns = n_q_points * n_components;
+      FullMatrix<double> values(n_dofs, n_columns);
+      FullMatrix<double> weighted_values(n_dofs, n_columns);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        for (unsigned int k = 0; k < n_q_points; ++k)
+          {
+            const double dx = fe.JxW(k) * factor;
+            for (unsigned int d = 0; d < n_components; ++d)
+              {
+                const unsigned int column = k * n_components + d;
+                values(i, column)          = fe.shape_value_component(i, k, d);
+                weighted_values(i, column) = dx * values(i, column);
+              }
+          }
 
-              for (unsigned int j = i + 1; j < n_dofs; ++j)
-                {
-                  double Mij = 0.0;
-                  for (unsigned int d = 0; d < n_components; ++d)
-                    Mij += dx * fe.shape_value_component(j, k, d) *
-                           fe.shape_value_component(i, k, d);
-
-                  M(i, j) += Mij;
-                  M(j, i) += Mij;
-                }
-            }
-        }
+      values.mTmult(M, weighted_values, true);
     }
 
     /**
@@ -277,29 +278,35 @@ namespace LocalIntegrators
       AssertDimension(M21.n(), n1_dofs);
       AssertDimension(M22.n(), n2_dofs);
 
-      for (unsigned int k = 0; k < fe1.n_quadrature_points; ++k)
-        {
-          const double dx = fe1.JxW(k);
+      // Tables of the scaled shape values on both sides and of the same
+      // values weighted by the quadrature weights, with one row per shape
+      // function and one column per quadrature point and component. Each
+      // of the four matrices is a single matrix-matrix product of them.
+      const unsigned int n_columns = fe1.n_quadrature_points * n_components;
+      FullMatrix<double> values1(n1_dofs, n_columns);
+      FullMatrix<double> values2(n1_dofs, n_columns);
+      FullMatrix<double> weighted_values1(n1_dofs, n_columns);
+      FullMatrix<double> weighted_values2(n1_dofs, n_columns);
+      for (unsigned int i = 0; i < n1_dofs; ++i)
+        for (unsigned int k = 0; k < fe1.n_quadrature_points; ++k)
+          {
+            const double dx = fe1.JxW(k);
+            for (unsigned int d = 0; d < n_components; ++d)
+              {
+                const unsigned int column = k * n_components + d;
+                values1(i, column) =
+                  factor1 * fe1.shape_value_component(i, k, d);
+                values2(i, column) =
+                  -factor2 * fe2.shape_value_component(i, k, d);
+                weighted_values1(i, column) = dx * values1(i, column);
+                weighted_values2(i, column) = dx * values2(i, column);
+              }
+          }
 
-          for (unsigned int i = 0; i < n1_dofs; ++i)
-            for (unsigned int j = 0; j < n1_dofs; ++j)
-              for (unsigned int d = 0; d < n_components; ++d)
-                {
-                  const double u1 =
-                    factor1 * fe1.shape_value_component(j, k, d);
-                  const double u2 =
-                    -factor2 * fe2.shape_value_component(j, k, d);
-                  const double v1 =
-                    factor1 * fe1.shape_value_component(i, k, d);
-                  const double v2 =
-                    -factor2 * fe2.shape_value_component(i, k, d);
-
-                  M11(i, j) += dx * u1 * v1;
-                  M12(i, j) += dx * u2 * v1;
-                  M21(i, j) += dx * u1 * v2;
-                  M22(i, j) += dx * u2 * v2;
-                }
-        }
+      values1.mTmult(M11, weighted_values1, true);
+      values1.mTmult(M12, weighted_values2, true);
+      values2.mTmult(M21, weighted_values1, true);
+      values2.mTmult(M22, weighted_values2, true);
     }
   } // namespace L2
 } // namespace LocalIntegrators
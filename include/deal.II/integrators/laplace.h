@@ -60,31 +60,38 @@ namespace LocalIntegrators
     {
       const unsigned int n_dofs       = fe.dofs_per_cell;
       const unsigned int n_components = fe.get_fe().n_components();
+      const unsigned int n_q_points   = fe.n_quadrature_points;
+
+      AssertDimension(M.m(), n_dofs);
+      AssertDimension(M.n(), n_dofs);
+
+      // Collect the gradients of the shape functions in a table with one row
+      // per shape function and one column per quadrature point, component,
+      // and coordinate direction, and the same gradients weighted by the
+      // quadrature weights in a second table. The cell matrix is then a
+      // single matrix-matrix product, which FullMatrix::mTmult() computes
+      // with BLAS if available.
+      const unsigned int n_columns = n_q_points * n_components * dim;
+      FullMatrix<double> gradients(n_dofs, n_columns);
+      FullMatrix<double> weighted_gradients(n_dofs, n_columns);
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        for (unsigned int k = 0; k < n_q_points; ++k)
+          {
+            const double dx = fe.JxW(k) * factor;
+            for (unsigned int c = 0; c < n_components; ++c)
+              {
+                const Tensor<1, dim> grad = fe.shape_grad_component(i, k, c);
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    const unsigned int column =
+                      (k * n_components + c) * dim + d;
+                    gradients(i, column)          = grad[d];
+                    weighted_gradients(i, column) = dx * grad[d];
+                  }
+              }
+          }
 
-      for (unsigned int k = 0; k < fe.n_quadrature_points; ++k)
-        {
-          const double dx = fe.JxW(k) * factor;
-          for (unsigned int i = 0; i < n_dofs; ++i)
-            {
-              double Mii = 0.0;
-              for (unsigned int d = 0; d < n_components; ++d)
-                Mii += dx * (fe.shape_grad_component(i, k, d) *
-                             fe.shape_grad_component(i, k, d));
-
-              M(i, i) += Mii;
-
-              for (unsigned int j = i + 1; j < n_dofs; ++j)
-                {
-                  double Mij = 0.0;
-                  for (unsigned int d = 0; d < n_components; ++d)
-                    Mij += dx * (fe.shape_grad_component(j, k, d) *
-                                 fe.shape_grad_component(i, k, d));
-
-                  M(i, j) += Mij;
-                  M(j, i) += Mij;
-                }
-            }
-        }
+      gradients.mTmult(M, weighted_gradients, true);
     }
 
     /**
@@ -400,40 +407,63 @@ namespace LocalIntegrators
       const double nue = (factor2 < 0) ? factor1 : factor2;
       const double nu  = .5 * (nui + nue);
 
-      for (unsigned int k = 0; k < fe1.n_quadrature_points; ++k)
+      // All four matrices are sums of products of the values and normal
+      // derivatives of the shape functions on both sides. Collect them in
+      // tables with one row per shape function, holding first the values
+      // and then the normal derivatives for all quadrature points and
+      // components, and combine them with the weights of the bilinear form
+      // in a second set of tables, such that each matrix is a single
+      // matrix-matrix product computed by FullMatrix::mTmult().
+      const unsigned int n_q_points   = fe1.n_quadrature_points;
+      const unsigned int n_components = fe1.get_fe().n_components();
+      const unsigned int n_values     = n_q_points * n_components;
+
+      FullMatrix<double> test1(n_dofs, 2 * n_values);
+      FullMatrix<double> test2(n_dofs, 2 * n_values);
+      FullMatrix<double> trial11(n_dofs, 2 * n_values);
+      FullMatrix<double> trial12(n_dofs, 2 * n_values);
+      FullMatrix<double> trial21(n_dofs, 2 * n_values);
+      FullMatrix<double> trial22(n_dofs, 2 * n_values);
+      for (unsigned int k = 0; k < n_q_points; ++k)
         {
           const double         dx = fe1.JxW(k);
           const Tensor<1, dim> n  = fe1.normal_vector(k);
-          for (unsigned int d = 0; d < fe1.get_fe().n_components(); ++d)
+          for (unsigned int d = 0; d < n_components; ++d)
             {
+              const unsigned int value      = k * n_components + d;
+              const unsigned int derivative = n_values + value;
               for (unsigned int i = 0; i < n_dofs; ++i)
                 {
-                  for (unsigned int j = 0; j < n_dofs; ++j)
-                    {
-                      const double vi   = fe1.shape_value_component(i, k, d);
-                      const double dnvi = n * fe1.shape_grad_component(i, k, d);
-                      const double ve   = fe2.shape_value_component(i, k, d);
-                      const double dnve = n * fe2.shape_grad_component(i, k, d);
-                      const double ui   = fe1.shape_value_component(j, k, d);
-                      const double dnui = n * fe1.shape_grad_component(j, k, d);
-                      const double ue   = fe2.shape_value_component(j, k, d);
-                      const double dnue = n * fe2.shape_grad_component(j, k, d);
-                      M11(i, j) +=
-                        dx * (-.5 * nui * dnvi * ui - .5 * nui * dnui * vi +
-                              nu * penalty * ui * vi);
-                      M12(i, j) +=
-                        dx * (.5 * nui * dnvi * ue - .5 * nue * dnue * vi -
-                              nu * penalty * vi * ue);
-                      M21(i, j) +=
-                        dx * (-.5 * nue * dnve * ui + .5 * nui * dnui * ve -
-                              nu * penalty * ui * ve);
-                      M22(i, j) +=
-                        dx * (.5 * nue * dnve * ue + .5 * nue * dnue * ve +
-                              nu * penalty * ue * ve);
-                    }
+                  const double vi   = fe1.shape_value_component(i, k, d);
+                  const double dnvi = n * fe1.shape_grad_component(i, k, d);
+                  const double ve   = fe2.shape_value_component(i, k, d);
+                  const double dnve = n * fe2.shape_grad_component(i, k, d);
+
+                  test1(i, value)      = vi;
+                  test1(i, derivative) = dnvi;
+                  test2(i, value)      = ve;
+                  test2(i, derivative) = dnve;
+
+                  trial11(i, value) =
+                    dx * (nu * penalty * vi - .5 * nui * dnvi);
+                  trial11(i, derivative) = -.5 * dx * nui * vi;
+                  trial12(i, value) =
+                    dx * (-nu * penalty * ve - .5 * nue * dnve);
+                  trial12(i, derivative) = .5 * dx * nui * ve;
+                  trial21(i, value) =
+                    dx * (-nu * penalty * vi + .5 * nui * dnvi);
+                  trial21(i, derivative) = -.5 * dx * nue * vi;
+                  trial22(i, value) =
+                    dx * (nu * penalty * ve + .5 * nue * dnve);
+                  trial22(i, derivative) = .5 * dx * nue * ve;
                 }
             }
         }
+
+      test1.mTmult(M11, trial11, true);
+      test1.mTmult(M12, trial12, true);
+      test2.mTmult(M21, trial21, true);
+      test2.mTmult(M22, trial22, true);
     }
 
     /**
@@ -20,6 +20,7 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -427,6 +428,12 @@ public:
    * \frac{u_3}{2} + \frac{u_2}{4} + \frac{u_4}{4}$. Note, however, that
    * cycles in this graph of constraints are not allowed, i.e. for example
    * $u_4$ may not be constrained, directly or indirectly, to $u_{13}$ again.
+   *
+   * The work on the individual constraint lines, i.e., the resolution of
+   * chains of constraints as well as the sorting of the entries, is done in
+   * parallel on several threads if this is enabled, see MultithreadInfo.
+   * Finally, this function sets up a copy of the entries of all lines in
+   * compressed row storage that is used by distribute().
    */
   void
   close();
@@ -1074,6 +1081,101 @@ public:
                              VectorType &                  global_vector,
                              bool use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * A structure that stores, for a list of cells, the positions in the array
+   * of values of a SparseMatrix at which the entries of the cell matrices are
+   * to be added. It is set up by compute_sparse_matrix_offsets() and used by
+   * the distribute_local_to_global() function that adds the matrices of a
+   * list of cells at once. As long as neither the sparsity pattern nor the
+   * degrees of freedom of the cells change, for example when the matrix is
+   * assembled on the same mesh in every step of a Newton iteration, the
+   * object can be reused.
+   */
+  struct SparseMatrixOffsets
+  {
+    /**
+     * Whether the entries of the matrix of each cell can be added directly
+     * at the positions stored in @p offsets. This is not the case for cells
+     * with constrained degrees of freedom and for cells that couple to
+     * entries outside the sparsity pattern, whose matrices are added with
+     * the general distribute_local_to_global() function instead.
+     */
+    std::vector<bool> use_offsets;
+
+    /**
+     * The start of the positions of each cell in @p offsets, with one
+     * additional entry for the end of the last cell.
+     */
+    std::vector<std::size_t> cell_start;
+
+    /**
+     * The positions in the array of values of the matrix for the entries of
+     * the cell matrices, stored row by row for each cell.
+     */
+    std::vector<size_type> offsets;
+
+    /**
+     * The sparsity pattern the positions refer to. It is only used to check
+     * that the offsets are applied to a matching matrix.
+     */
+    const SparsityPattern *sparsity_pattern = nullptr;
+
+    /**
+     * Determine an estimate for the memory consumption (in bytes) of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const
+    {
+      return (MemoryConsumption::memory_consumption(use_offsets) +
+              MemoryConsumption::memory_consumption(cell_start) +
+              MemoryConsumption::memory_consumption(offsets));
+    }
+  };
+
+  /**
+   * Compute the positions in the array of values of a SparseMatrix based on
+   * @p sparsity_pattern at which the entries of the matrices of a list of
+   * cells with the given @p local_dof_indices are to be added, and store
+   * them in @p offsets. The positions are found by one binary search per
+   * entry, which is the work the distribute_local_to_global() function for
+   * a single matrix does every time it is called.
+   */
+  void
+  compute_sparse_matrix_offsets(
+    const std::vector<std::vector<size_type>> &local_dof_indices,
+    const SparsityPattern &                    sparsity_pattern,
+    SparseMatrixOffsets &                      offsets) const;
+
+  /**
+   * Add the matrices of a list of cells with the given
+   * @p local_dof_indices to @p global_matrix, using the positions in
+   * @p offsets as computed by compute_sparse_matrix_offsets() for the same
+   * cells and the sparsity pattern of @p global_matrix. The entries of the
+   * cells without constrained degrees of freedom are added directly at
+   * these positions, which avoids the search for the entries in the rows of
+   * the matrix. The matrices of the other cells are passed to the
+   * distribute_local_to_global() function for a single matrix, i.e., the
+   * result is the same as if that function was called for all cells.
+   */
+  void
+  distribute_local_to_global(
+    const std::vector<FullMatrix<number>> &    local_matrices,
+    const std::vector<std::vector<size_type>> &local_dof_indices,
+    const SparseMatrixOffsets &                offsets,
+    SparseMatrix<number> &                     global_matrix) const;
+
+  /**
+   * Like the previous function, but add only the matrix of the cell with
+   * number @p cell in the list of cells for which @p offsets were computed.
+   */
+  void
+  distribute_local_to_global(const FullMatrix<number> &    local_matrix,
+                             const std::vector<size_type> &local_dof_indices,
+                             const SparseMatrixOffsets &   offsets,
+                             const std::size_t             cell,
+                             SparseMatrix<number> &global_matrix) const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
@@ -1195,6 +1297,12 @@ public:
    *
    * @note If this function is called with a parallel vector @p vec, then the
    * vector must not contain ghost elements.
+   *
+   * For vectors whose elements can be accessed from several threads at
+   * once, i.e., for Vector, BlockVector, LinearAlgebra::Vector,
+   * LinearAlgebra::distributed::Vector and
+   * LinearAlgebra::distributed::BlockVector, the constrained entries are
+   * computed in parallel.
    */
   template <class VectorType>
   void
@@ -1493,6 +1601,37 @@ private:
    */
   bool sorted;
 
+  /**
+   * A copy of the entries of all constraint lines in compressed row storage,
+   * set up by close(). The entries of the line <tt>lines[i]</tt> are stored
+   * at the positions <tt>[entries_row_start[i], entries_row_start[i+1])</tt>
+   * of @p entries_column and @p entries_value. Since the entries of all lines
+   * are stored contiguously in memory, distribute() can loop through them
+   * considerably faster than through the separate vectors of the lines. The
+   * inhomogeneities are not copied, as they may still be changed by
+   * set_inhomogeneity() after closing the object.
+   */
+  std::vector<size_type> entries_row_start;
+
+  /**
+   * The column indices of the entries of the constraint lines, see
+   * @p entries_row_start.
+   */
+  std::vector<size_type> entries_column;
+
+  /**
+   * The values of the entries of the constraint lines, see
+   * @p entries_row_start.
+   */
+  std::vector<number> entries_value;
+
+  /**
+   * Set up the compressed row storage of the entries of all lines in
+   * @p entries_row_start, @p entries_column and @p entries_value.
+   */
+  void
+  make_compressed_row_storage();
+
   /**
    * Internal function to calculate the index of line @p line_n in the vector
    * lines_cache using local_lines.
@@ -1611,6 +1750,9 @@ inline AffineConstraints<number>::AffineConstraints(
   , lines_cache(affine_constraints.lines_cache)
   , local_lines(affine_constraints.local_lines)
   , sorted(affine_constraints.sorted)
+  , entries_row_start(affine_constraints.entries_row_start)
+  , entries_column(affine_constraints.entries_column)
+  , entries_value(affine_constraints.entries_value)
 {}
 
 template <typename number>
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -27,6 +28,7 @@
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/chunk_sparse_matrix.h>
+#include <deal.II/lac/compact_dynamic_sparsity_pattern.h>
 #include <deal.II/lac/diagonal_matrix.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
@@ -50,12 +52,17 @@
 #include <boost/serialization/utility.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <complex>
 #include <iomanip>
 #include <numeric>
 #include <ostream>
 #include <set>
 
+#ifdef DEAL_II_WITH_THREADS
+#  include <tbb/parallel_sort.h>
+#endif
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -68,6 +75,10 @@ AffineConstraints<number>::copy_from(const AffineConstraints<number> &other)
   lines_cache = other.lines_cache;
   local_lines = other.local_lines;
   sorted      = other.sorted;
+
+  entries_row_start = other.entries_row_start;
+  entries_column    = other.entries_column;
+  entries_value     = other.entries_value;
 }
 
 
@@ -307,8 +318,16 @@ AffineConstraints<number>::close()
   if (sorted == true)
     return;
 
+  // the work on the individual lines below is independent of each other and
+  // done in parallel, in chunks of this many lines
+  const size_type grainsize = 64;
+
   // sort the lines
+#ifdef DEAL_II_WITH_THREADS
+  tbb::parallel_sort(lines.begin(), lines.end());
+#else
   std::sort(lines.begin(), lines.end());
+#endif
 
   // update list of pointers and give the vector a sharp size since we
   // won't modify the size any more after this point.
@@ -331,17 +350,26 @@ AffineConstraints<number>::close()
              ExcInternalError());
 
   // first, strip zero entries, as we have to do that only once
-  for (ConstraintLine &line : lines)
-    // first remove zero entries. that would mean that in the linear
-    // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times 0
-    // appears. obviously, 0*something can be omitted
-    line.entries.erase(std::remove_if(line.entries.begin(),
-                                      line.entries.end(),
-                                      [](
-                                        const std::pair<size_type, number> &p) {
-                                        return p.second == number(0.);
-                                      }),
-                       line.entries.end());
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [this](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        {
+          // first remove zero entries. that would mean that in the linear
+          // constraint for a node, x_i = ax_1 + bx_2 + ..., another node
+          // times 0 appears. obviously, 0*something can be omitted
+          typename ConstraintLine::Entries &entries = lines[l].entries;
+          entries.erase(std::remove_if(
+                          entries.begin(),
+                          entries.end(),
+                          [](const std::pair<size_type, number> &p) {
+                            return p.second == number(0.);
+                          }),
+                        entries.end());
+        }
+    },
+    grainsize);
 
 
 
@@ -357,6 +385,8 @@ AffineConstraints<number>::close()
   for (const ConstraintLine &line : lines)
     for (const std::pair<size_type, number> &entry : line.entries)
       largest_idx = std::max(largest_idx, entry.first);
+
+  std::atomic<bool> cycle_detected(false);
 #endif
 
   // replace references to dofs that are themselves constrained. note that
@@ -371,204 +401,247 @@ AffineConstraints<number>::close()
   // we sort the list so that throwing out duplicates becomes much more
   // efficient. also, we have to do it only once, rather than in each
   // iteration
-  size_type iteration = 0;
-  while (true)
-    {
-      bool chained_constraint_replaced = false;
-
-      for (ConstraintLine &line : lines)
+  //
+  // in order to work on the lines in parallel, each line is expanded on its
+  // own into a separate list of entries, looking up the unresolved entries
+  // of the other lines. The new lists replace the old ones once all lines
+  // are resolved.
+  std::vector<typename ConstraintLine::Entries> resolved_entries(
+    lines.size());
+  std::vector<number> resolved_inhomogeneity(lines.size());
+  std::vector<char>   line_was_resolved(lines.size(), 0);
+
+  const auto resolve_line = [&](const size_type l) {
+    const ConstraintLine &line = lines[l];
+
+    // we only copy the entries of lines that are actually constrained to
+    // other constrained dofs
+    bool has_chained_constraint = false;
+    for (const std::pair<size_type, number> &entry : line.entries)
+      if (((local_lines.size() == 0) ||
+           (local_lines.is_element(entry.first))) &&
+          is_constrained(entry.first))
         {
-#ifdef DEBUG
-          // we need to keep track of how many replacements we do in this line,
-          // because we can end up in a cycle A->B->C->A without the number of
-          // entries growing.
-          size_type n_replacements = 0;
-#endif
+          has_chained_constraint = true;
+          break;
+        }
+    if (has_chained_constraint == false)
+      return;
 
-          // loop over all entries of this line (including ones that we
-          // have appended in this go around) and see whether they are
-          // further constrained. ignore elements that we don't store on
-          // the current processor
-          size_type entry = 0;
-          while (entry < line.entries.size())
-            if (((local_lines.size() == 0) ||
-                 (local_lines.is_element(line.entries[entry].first))) &&
-                is_constrained(line.entries[entry].first))
-              {
-                // ok, this entry is further constrained:
-                chained_constraint_replaced = true;
+    typename ConstraintLine::Entries entries       = line.entries;
+    number                           inhomogeneity = line.inhomogeneity;
 
-                // look up the chain of constraints for this entry
-                const size_type dof_index = line.entries[entry].first;
-                const number    weight    = line.entries[entry].second;
+#ifdef DEBUG
+    // we need to keep track of how many replacements we do in this line,
+    // because we can end up in a cycle A->B->C->A without the number of
+    // entries growing.
+    size_type n_replacements = 0;
+#endif
 
-                Assert(dof_index != line.index,
+    // loop over all entries of this line (including ones that we have
+    // appended in this go around) and see whether they are further
+    // constrained. ignore elements that we don't store on the current
+    // processor
+    size_type entry = 0;
+    while (entry < entries.size())
+      if (((local_lines.size() == 0) ||
+           (local_lines.is_element(entries[entry].first))) &&
+          is_constrained(entries[entry].first))
+        {
+          // look up the chain of constraints for this entry
+          const size_type dof_index = entries[entry].first;
+          const number    weight    = entries[entry].second;
+
+          Assert(dof_index != line.index,
+                 ExcMessage("Cycle in constraints detected!"));
+
+          const ConstraintLine &constrained_line =
+            lines[lines_cache[calculate_line_index(dof_index)]];
+          Assert(constrained_line.index == dof_index, ExcInternalError());
+
+          // now we have to replace an entry by its expansion. we do that by
+          // overwriting the entry by the first entry of the expansion and
+          // adding the remaining ones to the end, where we will later
+          // process them once more
+          //
+          // we can of course only do that if the DoF that we are currently
+          // handle is constrained by a linear combination of other dofs:
+          if (constrained_line.entries.size() > 0)
+            {
+              for (size_type i = 0; i < constrained_line.entries.size(); ++i)
+                Assert(dof_index != constrained_line.entries[i].first,
                        ExcMessage("Cycle in constraints detected!"));
 
-                const ConstraintLine &constrained_line =
-                  lines[lines_cache[calculate_line_index(dof_index)]];
-                Assert(constrained_line.index == dof_index, ExcInternalError());
-
-                // now we have to replace an entry by its expansion. we do
-                // that by overwriting the entry by the first entry of the
-                // expansion and adding the remaining ones to the end,
-                // where we will later process them once more
-                //
-                // we can of course only do that if the DoF that we are
-                // currently handle is constrained by a linear combination
-                // of other dofs:
-                if (constrained_line.entries.size() > 0)
-                  {
-                    for (size_type i = 0; i < constrained_line.entries.size();
-                         ++i)
-                      Assert(dof_index != constrained_line.entries[i].first,
-                             ExcMessage("Cycle in constraints detected!"));
-
-                    // replace first entry, then tack the rest to the end
-                    // of the list
-                    line.entries[entry] = std::pair<size_type, number>(
-                      constrained_line.entries[0].first,
-                      constrained_line.entries[0].second * weight);
-
-                    for (size_type i = 1; i < constrained_line.entries.size();
-                         ++i)
-                      line.entries.emplace_back(
-                        constrained_line.entries[i].first,
-                        constrained_line.entries[i].second * weight);
+              // replace first entry, then tack the rest to the end of the
+              // list
+              entries[entry] = std::pair<size_type, number>(
+                constrained_line.entries[0].first,
+                constrained_line.entries[0].second * weight);
+
+              for (size_type i = 1; i < constrained_line.entries.size(); ++i)
+                entries.emplace_back(constrained_line.entries[i].first,
+                                     constrained_line.entries[i].second *
+                                       weight);
 
 #ifdef DEBUG
-                    // keep track of how many entries we replace in this
-                    // line. If we do more than there are constraints or
-                    // dofs in our system, we must have a cycle.
-                    ++n_replacements;
-                    Assert(n_replacements / 2 < largest_idx,
-                           ExcMessage("Cycle in constraints detected!"));
-                    if (n_replacements / 2 >= largest_idx)
-                      return; // this enables us to test for this Exception.
+              // keep track of how many entries we replace in this line. If
+              // we do more than there are constraints or dofs in our system,
+              // we must have a cycle.
+              ++n_replacements;
+              Assert(n_replacements / 2 < largest_idx,
+                     ExcMessage("Cycle in constraints detected!"));
+              if (n_replacements / 2 >= largest_idx)
+                {
+                  // this enables us to test for this Exception.
+                  cycle_detected = true;
+                  return;
+                }
 #endif
-                  }
-                else
-                  // the DoF that we encountered is not constrained by a
-                  // linear combination of other dofs but is equal to just
-                  // the inhomogeneity (i.e. its chain of entries is
-                  // empty). in that case, we can't just overwrite the
-                  // current entry, but we have to actually eliminate it
-                  {
-                    line.entries.erase(line.entries.begin() + entry);
-                  }
+            }
+          else
+            // the DoF that we encountered is not constrained by a linear
+            // combination of other dofs but is equal to just the
+            // inhomogeneity (i.e. its chain of entries is empty). in that
+            // case, we can't just overwrite the current entry, but we have
+            // to actually eliminate it
+            {
+              entries.erase(entries.begin() + entry);
+            }
 
-                line.inhomogeneity += constrained_line.inhomogeneity * weight;
+          inhomogeneity += constrained_line.inhomogeneity * weight;
 
-                // now that we're here, do not increase index by one but
-                // rather make another pass for the present entry because
-                // we have replaced the present entry by another one, or
-                // because we have deleted it and shifted all following
-                // ones one forward
-              }
-            else
-              // entry not further constrained. just move ahead by one
-              ++entry;
+          // now that we're here, do not increase index by one but rather
+          // make another pass for the present entry because we have
+          // replaced the present entry by another one, or because we have
+          // deleted it and shifted all following ones one forward
         }
+      else
+        // entry not further constrained. just move ahead by one
+        ++entry;
 
-      // if we didn't do anything in this round, then quit the loop
-      if (chained_constraint_replaced == false)
-        break;
+    resolved_entries[l].swap(entries);
+    resolved_inhomogeneity[l] = inhomogeneity;
+    line_was_resolved[l]      = 1;
+  };
 
-      // increase iteration count. note that we should not iterate more
-      // times than there are constraints, since this puts a natural upper
-      // bound on the length of constraint chains
-      ++iteration;
-      Assert(iteration <= lines.size(), ExcInternalError());
-    }
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [&resolve_line](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        resolve_line(l);
+    },
+    grainsize);
+
+#ifdef DEBUG
+  if (cycle_detected)
+    return;
+#endif
 
   // finally sort the entries and re-scale them if necessary. in this step,
   // we also throw out duplicates as mentioned above. moreover, as some
   // entries might have had zero weights, we replace them by a vector with
   // sharp sizes.
-  for (ConstraintLine &line : lines)
-    {
-      std::sort(line.entries.begin(),
-                line.entries.end(),
-                [](const std::pair<unsigned int, number> &a,
-                   const std::pair<unsigned int, number> &b) -> bool {
-                  // Let's use lexicogrpahic ordering with std::abs for number
-                  // type (it might be complex valued).
-                  return (a.first < b.first) ||
-                         (a.first == b.first &&
-                          std::abs(a.second) < std::abs(b.second));
-                });
-
-      // loop over the now sorted list and see whether any of the entries
-      // references the same dofs more than once in order to find how many
-      // non-duplicate entries we have. This lets us allocate the correct
-      // amount of memory for the constraint entries.
-      size_type duplicates = 0;
-      for (size_type i = 1; i < line.entries.size(); ++i)
-        if (line.entries[i].first == line.entries[i - 1].first)
-          duplicates++;
-
-      if (duplicates > 0 || line.entries.size() < line.entries.capacity())
-        {
-          typename ConstraintLine::Entries new_entries;
-
-          // if we have no duplicates, copy verbatim the entries. this way,
-          // the final size is of the vector is correct.
-          if (duplicates == 0)
-            new_entries = line.entries;
-          else
-            {
-              // otherwise, we need to go through the list and resolve the
-              // duplicates
-              new_entries.reserve(line.entries.size() - duplicates);
-              new_entries.push_back(line.entries[0]);
-              for (size_type j = 1; j < line.entries.size(); ++j)
-                if (line.entries[j].first == line.entries[j - 1].first)
-                  {
-                    Assert(new_entries.back().first == line.entries[j].first,
-                           ExcInternalError());
-                    new_entries.back().second += line.entries[j].second;
-                  }
-                else
-                  new_entries.push_back(line.entries[j]);
+  const auto finalize_line = [&](const size_type l) {
+    ConstraintLine &line = lines[l];
+    if (line_was_resolved[l])
+      {
+        line.entries.swap(resolved_entries[l]);
+        line.inhomogeneity = resolved_inhomogeneity[l];
+        typename ConstraintLine::Entries().swap(resolved_entries[l]);
+      }
 
-              Assert(new_entries.size() == line.entries.size() - duplicates,
-                     ExcInternalError());
+    std::sort(line.entries.begin(),
+              line.entries.end(),
+              [](const std::pair<unsigned int, number> &a,
+                 const std::pair<unsigned int, number> &b) -> bool {
+                // Let's use lexicogrpahic ordering with std::abs for number
+                // type (it might be complex valued).
+                return (a.first < b.first) ||
+                       (a.first == b.first &&
+                        std::abs(a.second) < std::abs(b.second));
+              });
+
+    // loop over the now sorted list and see whether any of the entries
+    // references the same dofs more than once in order to find how many
+    // non-duplicate entries we have. This lets us allocate the correct
+    // amount of memory for the constraint entries.
+    size_type duplicates = 0;
+    for (size_type i = 1; i < line.entries.size(); ++i)
+      if (line.entries[i].first == line.entries[i - 1].first)
+        duplicates++;
+
+    if (duplicates > 0 || line.entries.size() < line.entries.capacity())
+      {
+        typename ConstraintLine::Entries new_entries;
 
-              // make sure there are really no duplicates left and that the
-              // list is still sorted
-              for (size_type j = 1; j < new_entries.size(); ++j)
+        // if we have no duplicates, copy verbatim the entries. this way,
+        // the final size is of the vector is correct.
+        if (duplicates == 0)
+          new_entries = line.entries;
+        else
+          {
+            // otherwise, we need to go through the list and resolve the
+            // duplicates
+            new_entries.reserve(line.entries.size() - duplicates);
+            new_entries.push_back(line.entries[0]);
+            for (size_type j = 1; j < line.entries.size(); ++j)
+              if (line.entries[j].first == line.entries[j - 1].first)
                 {
-                  Assert(new_entries[j].first != new_entries[j - 1].first,
-                         ExcInternalError());
-                  Assert(new_entries[j].first > new_entries[j - 1].first,
+                  Assert(new_entries.back().first == line.entries[j].first,
                          ExcInternalError());
+                  new_entries.back().second += line.entries[j].second;
                 }
-            }
+              else
+                new_entries.push_back(line.entries[j]);
 
-          // replace old list of constraints for this dof by the new one
-          line.entries.swap(new_entries);
-        }
+            Assert(new_entries.size() == line.entries.size() - duplicates,
+                   ExcInternalError());
 
-      // Finally do the following check: if the sum of weights for the
-      // constraints is close to one, but not exactly one, then rescale all
-      // the weights so that they sum up to 1. this adds a little numerical
-      // stability and avoids all sorts of problems where the actual value
-      // is close to, but not quite what we expected
-      //
-      // the case where the weights don't quite sum up happens when we
-      // compute the interpolation weights "on the fly", i.e. not from
-      // precomputed tables. in this case, the interpolation weights are
-      // also subject to round-off
-      number sum = 0.;
-      for (const std::pair<size_type, number> &entry : line.entries)
-        sum += entry.second;
-      if (std::abs(sum - number(1.)) < 1.e-13)
-        {
-          for (std::pair<size_type, number> &entry : line.entries)
-            entry.second /= sum;
-          line.inhomogeneity /= sum;
-        }
-    } // end of loop over all constraint lines
+            // make sure there are really no duplicates left and that the
+            // list is still sorted
+            for (size_type j = 1; j < new_entries.size(); ++j)
+              {
+                Assert(new_entries[j].first != new_entries[j - 1].first,
+                       ExcInternalError());
+                Assert(new_entries[j].first > new_entries[j - 1].first,
+                       ExcInternalError());
+              }
+          }
+
+        // replace old list of constraints for this dof by the new one
+        line.entries.swap(new_entries);
+      }
+
+    // Finally do the following check: if the sum of weights for the
+    // constraints is close to one, but not exactly one, then rescale all
+    // the weights so that they sum up to 1. this adds a little numerical
+    // stability and avoids all sorts of problems where the actual value
+    // is close to, but not quite what we expected
+    //
+    // the case where the weights don't quite sum up happens when we
+    // compute the interpolation weights "on the fly", i.e. not from
+    // precomputed tables. in this case, the interpolation weights are
+    // also subject to round-off
+    number sum = 0.;
+    for (const std::pair<size_type, number> &entry : line.entries)
+      sum += entry.second;
+    if (std::abs(sum - number(1.)) < 1.e-13)
+      {
+        for (std::pair<size_type, number> &entry : line.entries)
+          entry.second /= sum;
+        line.inhomogeneity /= sum;
+      }
+  };
+
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [&finalize_line](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        finalize_line(l);
+    },
+    grainsize);
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -585,11 +658,48 @@ AffineConstraints<number>::close()
         }
 #endif
 
+  make_compressed_row_storage();
+
   sorted = true;
 }
 
 
 
+template <typename number>
+void
+AffineConstraints<number>::make_compressed_row_storage()
+{
+  std::vector<size_type> new_row_start(lines.size() + 1);
+  new_row_start[0] = 0;
+  for (size_type l = 0; l < lines.size(); ++l)
+    new_row_start[l + 1] = new_row_start[l] + lines[l].entries.size();
+
+  std::vector<size_type> new_column(new_row_start.back());
+  std::vector<number>    new_value(new_row_start.back());
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        {
+          size_type index = new_row_start[l];
+          for (const std::pair<size_type, number> &entry : lines[l].entries)
+            {
+              new_column[index] = entry.first;
+              new_value[index]  = entry.second;
+              ++index;
+            }
+        }
+    },
+    64);
+
+  entries_row_start.swap(new_row_start);
+  entries_column.swap(new_column);
+  entries_value.swap(new_value);
+}
+
+
+
 template <typename number>
 void
 AffineConstraints<number>::merge(
@@ -755,6 +865,9 @@ AffineConstraints<number>::shift(const size_type offset)
         entry.first += offset;
     }
 
+  for (size_type &column : entries_column)
+    column += offset;
+
 #ifdef DEBUG
   // make sure that lines, lines_cache and local_lines
   // are still linked correctly
@@ -781,6 +894,14 @@ AffineConstraints<number>::clear()
     lines_cache.swap(tmp);
   }
 
+  {
+    std::vector<size_type> tmp_row_start, tmp_column;
+    std::vector<number>    tmp_value;
+    entries_row_start.swap(tmp_row_start);
+    entries_column.swap(tmp_column);
+    entries_value.swap(tmp_value);
+  }
+
   sorted = false;
 }
 
@@ -944,7 +1065,10 @@ AffineConstraints<number>::memory_consumption() const
   return (MemoryConsumption::memory_consumption(lines) +
           MemoryConsumption::memory_consumption(lines_cache) +
           MemoryConsumption::memory_consumption(sorted) +
-          MemoryConsumption::memory_consumption(local_lines));
+          MemoryConsumption::memory_consumption(local_lines) +
+          MemoryConsumption::memory_consumption(entries_row_start) +
+          MemoryConsumption::memory_consumption(entries_column) +
+          MemoryConsumption::memory_consumption(entries_value));
 }
 
 
@@ -2197,6 +2321,39 @@ namespace internal
     Assert(false, ExcMessage("We shouldn't even get here!"));
   }
 
+  // a flag whether the elements of a vector can be read and written by
+  // several threads at once, as long as they write to different elements,
+  // which allows to distribute the constraints in parallel. this is not the
+  // case for the wrapper classes of the external libraries
+  template <class VectorType>
+  struct SupportsThreadedElementAccess : std::false_type
+  {};
+
+  template <typename Number>
+  struct SupportsThreadedElementAccess<dealii::Vector<Number>>
+    : std::true_type
+  {};
+
+  template <typename Number>
+  struct SupportsThreadedElementAccess<dealii::BlockVector<Number>>
+    : std::true_type
+  {};
+
+  template <typename Number>
+  struct SupportsThreadedElementAccess<LinearAlgebra::Vector<Number>>
+    : std::true_type
+  {};
+
+  template <typename Number>
+  struct SupportsThreadedElementAccess<
+    LinearAlgebra::distributed::Vector<Number>> : std::true_type
+  {};
+
+  template <typename Number>
+  struct SupportsThreadedElementAccess<
+    LinearAlgebra::distributed::BlockVector<Number>> : std::true_type
+  {};
+
   // for block vectors, simply dispatch to the individual blocks
   template <class VectorType>
   void
@@ -2246,6 +2403,48 @@ AffineConstraints<number>::distribute(VectorType &vec) const
   // the last else is for the simple case (sequential vector)
   const IndexSet vec_owned_elements = vec.locally_owned_elements();
 
+  // set the constrained entries of the lines in the range [begin, end) in
+  // @p vec, reading the values of the entries they are constrained to from
+  // @p source. since closing the object resolved all chains of constraints,
+  // the lines do not depend on each other
+  const auto distribute_on_subrange = [&](const VectorType &source,
+                                          const bool only_owned_lines,
+                                          const size_type begin,
+                                          const size_type end) {
+    for (size_type l = begin; l < end; ++l)
+      {
+        const size_type index = lines[l].index;
+        if (only_owned_lines && !vec_owned_elements.is_element(index))
+          continue;
+
+        // fill entry in line index by adding the different contributions
+        typename VectorType::value_type new_value = lines[l].inhomogeneity;
+        for (size_type e = entries_row_start[l]; e < entries_row_start[l + 1];
+             ++e)
+          new_value += (static_cast<typename VectorType::value_type>(
+                          internal::ElementAccess<VectorType>::get(
+                            source, entries_column[e])) *
+                        entries_value[e]);
+        AssertIsFinite(new_value);
+        internal::ElementAccess<VectorType>::set(new_value, index, vec);
+      }
+  };
+
+  const auto distribute_lines = [&](const VectorType &source,
+                                    const bool        only_owned_lines) {
+    AssertDimension(entries_row_start.size(), lines.size() + 1);
+    if (internal::SupportsThreadedElementAccess<VectorType>::value)
+      parallel::apply_to_subranges(
+        size_type(0),
+        lines.size(),
+        [&](const size_type begin, const size_type end) {
+          distribute_on_subrange(source, only_owned_lines, begin, end);
+        },
+        256);
+    else
+      distribute_on_subrange(source, only_owned_lines, 0, lines.size());
+  };
+
   if (dealii::is_serial_vector<VectorType>::value == false)
     {
       // This processor owns only part of the vector. one may think that
@@ -2262,13 +2461,25 @@ AffineConstraints<number>::distribute(VectorType &vec) const
       // own locally, possibly as ghost vector elements, then read from them,
       // and finally throw away the ghosted vector. Implement this in the
       // following.
-      IndexSet needed_elements = vec_owned_elements;
+      //
+      // collect the indices in a sorted list first, which is much cheaper
+      // than adding them to the IndexSet one by one
+      std::vector<size_type> needed_indices;
+      for (size_type l = 0; l < lines.size(); ++l)
+        if (vec_owned_elements.is_element(lines[l].index))
+          for (size_type e = entries_row_start[l];
+               e < entries_row_start[l + 1];
+               ++e)
+            if (!vec_owned_elements.is_element(entries_column[e]))
+              needed_indices.push_back(entries_column[e]);
+      std::sort(needed_indices.begin(), needed_indices.end());
+      needed_indices.erase(std::unique(needed_indices.begin(),
+                                       needed_indices.end()),
+                           needed_indices.end());
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
-          for (const std::pair<size_type, number> &entry : line.entries)
-            if (!vec_owned_elements.is_element(entry.first))
-              needed_elements.add_index(entry.first);
+      IndexSet needed_elements = vec_owned_elements;
+      needed_elements.add_indices(needed_indices.begin(),
+                                  needed_indices.end());
 
       VectorType ghosted_vector;
       internal::import_vector_with_ghost_elements(
@@ -2278,21 +2489,7 @@ AffineConstraints<number>::distribute(VectorType &vec) const
         ghosted_vector,
         std::integral_constant<bool, IsBlockVector<VectorType>::value>());
 
-      for (const ConstraintLine &line : lines)
-        if (vec_owned_elements.is_element(line.index))
-          {
-            typename VectorType::value_type new_value = line.inhomogeneity;
-            for (const std::pair<size_type, number> &entry : line.entries)
-              new_value +=
-                (static_cast<typename VectorType::value_type>(
-                   internal::ElementAccess<VectorType>::get(ghosted_vector,
-                                                            entry.first)) *
-                 entry.second);
-            AssertIsFinite(new_value);
-            internal::ElementAccess<VectorType>::set(new_value,
-                                                     line.index,
-                                                     vec);
-          }
+      distribute_lines(ghosted_vector, true);
 
       // now compress to communicate the entries that we added to
       // and that weren't to local processors to the owner
@@ -2305,26 +2502,7 @@ AffineConstraints<number>::distribute(VectorType &vec) const
     // purely sequential vector (either because the type doesn't
     // support anything else or because it's completely stored
     // locally)
-    {
-      for (const ConstraintLine &next_constraint : lines)
-        {
-          // fill entry in line
-          // next_constraint.index by adding the
-          // different contributions
-          typename VectorType::value_type new_value =
-            next_constraint.inhomogeneity;
-          for (const std::pair<size_type, number> &entry :
-               next_constraint.entries)
-            new_value +=
-              (static_cast<typename VectorType::value_type>(
-                 internal::ElementAccess<VectorType>::get(vec, entry.first)) *
-               entry.second);
-          AssertIsFinite(new_value);
-          internal::ElementAccess<VectorType>::set(new_value,
-                                                   next_constraint.index,
-                                                   vec);
-        }
-    }
+    distribute_lines(vec, false);
 }
 
 // Some helper definitions for the local_to_global functions.
@@ -3998,6 +4176,116 @@ AffineConstraints<number>::distribute_local_to_global(
     }
 }
 
+
+
+template <typename number>
+void
+AffineConstraints<number>::compute_sparse_matrix_offsets(
+  const std::vector<std::vector<size_type>> &local_dof_indices,
+  const SparsityPattern &                    sparsity_pattern,
+  SparseMatrixOffsets &                      offsets) const
+{
+  const std::size_t n_cells = local_dof_indices.size();
+
+  offsets.use_offsets.assign(n_cells, true);
+  offsets.cell_start.resize(n_cells + 1);
+  offsets.cell_start[0] = 0;
+  for (std::size_t c = 0; c < n_cells; ++c)
+    {
+      for (const size_type dof : local_dof_indices[c])
+        if (is_constrained(dof))
+          {
+            offsets.use_offsets[c] = false;
+            break;
+          }
+
+      const std::size_t n_dofs = local_dof_indices[c].size();
+      offsets.cell_start[c + 1] =
+        offsets.cell_start[c] + (offsets.use_offsets[c] ? n_dofs * n_dofs : 0);
+    }
+
+  offsets.offsets.resize(offsets.cell_start[n_cells]);
+  for (std::size_t c = 0; c < n_cells; ++c)
+    if (offsets.use_offsets[c])
+      {
+        const std::vector<size_type> &dofs = local_dof_indices[c];
+        size_type *cell_offsets = &offsets.offsets[offsets.cell_start[c]];
+        for (const size_type row : dofs)
+          for (const size_type col : dofs)
+            {
+              *cell_offsets = sparsity_pattern(row, col);
+
+              // if the cell couples to an entry outside the sparsity
+              // pattern, leave the cell to the general function that
+              // ignores zero entries
+              if (*cell_offsets == SparsityPattern::invalid_entry)
+                offsets.use_offsets[c] = false;
+              ++cell_offsets;
+            }
+      }
+
+  offsets.sparsity_pattern = &sparsity_pattern;
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::distribute_local_to_global(
+  const std::vector<FullMatrix<number>> &    local_matrices,
+  const std::vector<std::vector<size_type>> &local_dof_indices,
+  const SparseMatrixOffsets &                offsets,
+  SparseMatrix<number> &                     global_matrix) const
+{
+  AssertDimension(local_matrices.size(), local_dof_indices.size());
+  AssertDimension(offsets.use_offsets.size(), local_matrices.size());
+  Assert(offsets.sparsity_pattern == &global_matrix.get_sparsity_pattern(),
+         ExcMessage("The offsets were not computed for the sparsity pattern "
+                    "of the given matrix."));
+
+  for (std::size_t c = 0; c < local_matrices.size(); ++c)
+    distribute_local_to_global(
+      local_matrices[c], local_dof_indices[c], offsets, c, global_matrix);
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::distribute_local_to_global(
+  const FullMatrix<number> &    local_matrix,
+  const std::vector<size_type> &local_dof_indices,
+  const SparseMatrixOffsets &   offsets,
+  const std::size_t             cell,
+  SparseMatrix<number> &        global_matrix) const
+{
+  AssertIndexRange(cell, offsets.use_offsets.size());
+  Assert(offsets.sparsity_pattern == &global_matrix.get_sparsity_pattern(),
+         ExcMessage("The offsets were not computed for the sparsity pattern "
+                    "of the given matrix."));
+
+  if (offsets.use_offsets[cell] == false)
+    distribute_local_to_global(local_matrix, local_dof_indices, global_matrix);
+  else if (local_dof_indices.size() > 0)
+    {
+      const std::size_t n_entries =
+        offsets.cell_start[cell + 1] - offsets.cell_start[cell];
+      AssertDimension(local_matrix.m(), local_dof_indices.size());
+      AssertDimension(local_matrix.n(), local_dof_indices.size());
+      AssertDimension(n_entries,
+                      local_dof_indices.size() * local_dof_indices.size());
+
+      // the entries of the cell matrix are stored row by row, just as their
+      // positions in the global matrix
+      number *const          matrix_values = global_matrix.val.get();
+      const number *const    cell_values   = &local_matrix(0, 0);
+      const size_type *const cell_offsets =
+        &offsets.offsets[offsets.cell_start[cell]];
+      for (std::size_t k = 0; k < n_entries; ++k)
+        matrix_values[cell_offsets[k]] += cell_values[k];
+    }
+}
+
 template <typename number>
 template <typename SparsityPatternType>
 void
@@ -19,12 +19,16 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/block_matrix_base.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/sparse_matrix.h>
 
+#include <array>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
@@ -216,6 +220,18 @@ public:
   /**
    * Matrix-vector multiplication: let $dst = M*src$ with $M$ being this
    * matrix.
+   *
+   * Rather than multiplying with one block after the other, each of which
+   * would be split into tasks and synchronized separately, the rows of every
+   * block row are split into chunks with about the same number of nonzero
+   * entries summed over all blocks of that row. Each chunk computes the
+   * products of all blocks of its row range and is scheduled as an
+   * independent task. Since the chunks write to disjoint parts of the
+   * destination vector, no synchronization is necessary besides the final
+   * one. This balances the work among the threads also for matrices with
+   * many small blocks, like the off-diagonal blocks of Stokes systems.
+   *
+   * @dealiiOperationIsMultithreaded
    */
   template <typename block_number>
   void
@@ -396,7 +412,68 @@ inline void
 BlockSparseMatrix<number>::vmult(BlockVector<block_number> &      dst,
                                  const BlockVector<block_number> &src) const
 {
-  BaseClass::vmult_block_block(dst, src);
+  Assert(dst.n_blocks() == this->n_block_rows(),
+         ExcDimensionMismatch(dst.n_blocks(), this->n_block_rows()));
+  Assert(src.n_blocks() == this->n_block_cols(),
+         ExcDimensionMismatch(src.n_blocks(), this->n_block_cols()));
+
+  // with a single block or without threads, there is nothing to gain from
+  // scheduling the blocks ourselves
+  if (this->n_block_rows() * this->n_block_cols() == 1 ||
+      MultithreadInfo::n_threads() == 1)
+    {
+      BaseClass::vmult_block_block(dst, src);
+      return;
+    }
+
+  // split the rows of each block row into chunks, using the average number
+  // of nonzero entries per row of the block row. The minimal number of
+  // entries per chunk is chosen to correspond to the grain size of
+  // SparseMatrix::vmult() for the average row length of the whole matrix.
+  const std::size_t n_rows = std::max<std::size_t>(this->m(), 1);
+  const std::size_t chunk_nnz =
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size *
+    (this->n_nonzero_elements() + n_rows) / n_rows;
+
+  std::vector<std::array<size_type, 3>> chunks;
+  for (unsigned int row = 0; row < this->n_block_rows(); ++row)
+    {
+      const size_type block_size = dst.block(row).size();
+      std::size_t     row_nnz    = 0;
+      for (unsigned int col = 0; col < this->n_block_cols(); ++col)
+        row_nnz += this->block(row, col).n_nonzero_elements();
+
+      const size_type chunk_size = std::max<std::size_t>(
+        std::min<std::size_t>(static_cast<std::size_t>(block_size) *
+                                chunk_nnz / std::max<std::size_t>(row_nnz, 1),
+                              block_size),
+        1);
+      for (size_type begin = 0; begin < block_size; begin += chunk_size)
+        chunks.push_back(
+          {{row, begin, std::min<size_type>(begin + chunk_size, block_size)}});
+    }
+
+  // every chunk writes to a separate range of rows of one block of the
+  // destination vector, so the chunks can run as independent tasks
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    chunks.size(),
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t c = begin; c < end; ++c)
+        {
+          const size_type row = chunks[c][0];
+          this->block(row, 0).vmult_on_subrange(
+            dst.block(row), src.block(0), chunks[c][1], chunks[c][2], false);
+          for (unsigned int col = 1; col < this->n_block_cols(); ++col)
+            if (this->block(row, col).n_nonzero_elements() > 0)
+              this->block(row, col).vmult_on_subrange(dst.block(row),
+                                                      src.block(col),
+                                                      chunks[c][1],
+                                                      chunks[c][2],
+                                                      true);
+        }
+    },
+    1);
 }
 
 
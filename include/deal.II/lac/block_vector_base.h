@@ -1674,7 +1674,7 @@ BlockVectorBase<VectorType>::linfty_norm() const
   real_type sum = 0.;
   for (size_type i = 0; i < n_blocks(); ++i)
     {
-      value_type newval = components[i].linfty_norm();
+      real_type newval = components[i].linfty_norm();
       if (sum < newval)
         sum = newval;
     }
@@ -923,6 +923,26 @@ public:
   void
   Tvmult_add(OutVector &dst, const InVector &src) const;
 
+  /**
+   * Matrix-matrix multiplication with a dense matrix: let $dst = M*src$ with
+   * $M$ being this matrix. Each column of @p src and @p dst is interpreted
+   * as a vector, and all the vectors are processed in a single pass over the
+   * chunks of the matrix, so that each matrix entry is loaded from memory
+   * only once. See SparseMatrix::vmult() for details.
+   */
+  template <typename number2>
+  void
+  vmult(FullMatrix<number2> &dst, const FullMatrix<number2> &src) const;
+
+  /**
+   * Adding matrix-matrix multiplication with a dense matrix: add $M*src$ to
+   * $dst$ with $M$ being this matrix. See the vmult() function taking
+   * FullMatrix arguments for details.
+   */
+  template <typename number2>
+  void
+  vmult_add(FullMatrix<number2> &dst, const FullMatrix<number2> &src) const;
+
   /**
    * Return the square of the norm of the vector $v$ with respect to the norm
    * induced by this matrix, i.e. $\left(v,Mv\right)$. This is useful, e.g. in
@@ -1374,6 +1394,16 @@ public:
                    "two objects are in fact different.");
   //@}
 private:
+  /**
+   * Implementation of the vmult() and vmult_add() functions taking FullMatrix
+   * arguments. If @p add is true, the result is added to @p dst.
+   */
+  template <typename number2>
+  void
+  vmult_multiple(FullMatrix<number2> &      dst,
+                 const FullMatrix<number2> &src,
+                 const bool                 add) const;
+
   /**
    * Pointer to the sparsity pattern used for this matrix. In order to
    * guarantee that it is not deleted while still in use, we subscribe to it
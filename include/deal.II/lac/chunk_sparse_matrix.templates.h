@@ -20,6 +20,7 @@
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/chunk_sparse_matrix.h>
 #include <deal.II/lac/full_matrix.h>
@@ -39,9 +40,10 @@ DEAL_II_NAMESPACE_OPEN
 namespace internal
 {
   // TODO: the goal of the ChunkSparseMatrix class is to stream data and use
-  // the vectorization features of modern processors. to make this happen,
-  // we will have to vectorize the functions in the following namespace, either
-  // by hand or by using, for example, optimized BLAS versions for them.
+  // the vectorization features of modern processors. the matrix-vector
+  // product uses the specialized kernels below for common chunk sizes, the
+  // remaining functions in the following namespace still need to be
+  // vectorized, either by hand or by using optimized BLAS versions for them.
   namespace ChunkSparseMatrixImplementation
   {
     /**
@@ -78,6 +80,166 @@ namespace internal
 
 
 
+    /**
+     * The type of the specialized kernels for chunk_vmult_add() with a
+     * chunk size fixed at compile time.
+     */
+    template <typename number>
+    using chunk_vmult_kernel = void (*)(const number *matrix,
+                                        const number *src,
+                                        number *      dst);
+
+
+
+    /**
+     * Like chunk_vmult_add(), but with the chunk size given as template
+     * argument, so that the compiler can unroll the loops.
+     */
+    template <int chunk_size, typename number>
+    inline void
+    chunk_vmult_add_fixed(const number *matrix, const number *src, number *dst)
+    {
+      for (unsigned int i = 0; i < chunk_size; ++i)
+        {
+          number sum = 0;
+          for (unsigned int j = 0; j < chunk_size; ++j)
+            sum += matrix[i * chunk_size + j] * src[j];
+          dst[i] += sum;
+        }
+    }
+
+
+
+    /**
+     * Like chunk_vmult_add(), but explicitly vectorized for chunks whose size
+     * is @p n_blocks times the number of lanes of VectorizedArray<number>.
+     * The chunk is split into square blocks with as many rows and columns as
+     * there are lanes. Each block is loaded transposed, so that every column
+     * of the block is one VectorizedArray, and the columns are multiplied by
+     * the respective entry of @p src. This way, the lanes hold the sums of
+     * different rows, and no horizontal additions are necessary.
+     */
+    template <int n_blocks, typename number>
+    inline void
+    chunk_vmult_add_vectorized(const number *matrix,
+                               const number *src,
+                               number *      dst)
+    {
+      constexpr unsigned int width = VectorizedArray<number>::n_array_elements;
+      constexpr unsigned int chunk_size = n_blocks * width;
+
+      unsigned int offsets[width];
+      for (unsigned int v = 0; v < width; ++v)
+        offsets[v] = v * chunk_size;
+
+      for (unsigned int ib = 0; ib < n_blocks; ++ib)
+        {
+          VectorizedArray<number> sum = number();
+          for (unsigned int jb = 0; jb < n_blocks; ++jb)
+            {
+              VectorizedArray<number> columns[width];
+              vectorized_load_and_transpose(width,
+                                            matrix + ib * width * chunk_size +
+                                              jb * width,
+                                            offsets,
+                                            columns);
+              for (unsigned int j = 0; j < width; ++j)
+                sum += columns[j] * src[jb * width + j];
+            }
+          VectorizedArray<number> result;
+          result.load(dst + ib * width);
+          result += sum;
+          result.store(dst + ib * width);
+        }
+    }
+
+
+
+    /**
+     * Return the specialized kernel of chunk_vmult_add() for the given chunk
+     * size, or a null pointer if there is none. Chunk sizes that are
+     * multiples (up to four) of the number of lanes of
+     * VectorizedArray<number> use the explicitly vectorized kernel, the
+     * small chunk sizes typical for vector-valued problems, e.g., two or
+     * three components per node, use a kernel with unrolled loops.
+     */
+    template <typename number>
+    inline chunk_vmult_kernel<number>
+    select_chunk_vmult_kernel(const size_type chunk_size)
+    {
+      constexpr unsigned int width = VectorizedArray<number>::n_array_elements;
+      if (width > 1 && chunk_size % width == 0)
+        switch (chunk_size / width)
+          {
+            case 1:
+              return &chunk_vmult_add_vectorized<1, number>;
+            case 2:
+              return &chunk_vmult_add_vectorized<2, number>;
+            case 3:
+              return &chunk_vmult_add_vectorized<3, number>;
+            case 4:
+              return &chunk_vmult_add_vectorized<4, number>;
+            default:
+              break;
+          }
+
+      switch (chunk_size)
+        {
+          case 2:
+            return &chunk_vmult_add_fixed<2, number>;
+          case 3:
+            return &chunk_vmult_add_fixed<3, number>;
+          case 4:
+            return &chunk_vmult_add_fixed<4, number>;
+          case 6:
+            return &chunk_vmult_add_fixed<6, number>;
+          case 8:
+            return &chunk_vmult_add_fixed<8, number>;
+          default:
+            return nullptr;
+        }
+    }
+
+
+
+    /**
+     * Call chunk_vmult_add(). This is the general variant for vectors whose
+     * iterators are not plain pointers to the number type of the matrix,
+     * for which the specialized kernels cannot be used.
+     */
+    template <typename number, typename SrcIterator, typename DstIterator>
+    inline void
+    chunk_vmult_add(const chunk_vmult_kernel<number>,
+                    const size_type     chunk_size,
+                    const number *const matrix,
+                    const SrcIterator   src,
+                    DstIterator         dst)
+    {
+      chunk_vmult_add(chunk_size, matrix, src, dst);
+    }
+
+
+
+    /**
+     * Call the specialized @p kernel if there is one, and the general
+     * chunk_vmult_add() otherwise.
+     */
+    template <typename number>
+    inline void
+    chunk_vmult_add(const chunk_vmult_kernel<number> kernel,
+                    const size_type                  chunk_size,
+                    const number *const              matrix,
+                    const number *const              src,
+                    number *const                    dst)
+    {
+      if (kernel != nullptr)
+        kernel(matrix, src, dst);
+      else
+        chunk_vmult_add(chunk_size, matrix, src, dst);
+    }
+
+
+
     /**
      * Like the previous function, but subtract. We need this for computing
      * the residual.
@@ -198,6 +360,9 @@ namespace internal
           end_row;
       const size_type irregular_col = n / chunk_size;
 
+      const chunk_vmult_kernel<number> kernel =
+        select_chunk_vmult_kernel<number>(chunk_size);
+
       typename OutVector::iterator dst_ptr =
         dst.begin() + chunk_size * begin_row;
       const number *val_ptr =
@@ -211,7 +376,8 @@ namespace internal
           while (val_ptr != val_end_of_row)
             {
               if (*colnum_ptr != irregular_col)
-                chunk_vmult_add(chunk_size,
+                chunk_vmult_add(kernel,
+                                chunk_size,
                                 val_ptr,
                                 src.begin() + *colnum_ptr * chunk_size,
                                 dst_ptr);
@@ -263,6 +429,72 @@ namespace internal
                rowstart[end_row] * chunk_size * chunk_size,
              ExcInternalError());
     }
+
+
+
+    /**
+     * Perform a product of the matrix with the columns of the dense matrix
+     * @p src on a subinterval of the chunk rows. All columns of @p src are
+     * processed while traversing the chunks, so that each matrix entry is
+     * only loaded once. If @p add is false, the rows of @p dst are zeroed
+     * first.
+     */
+    template <typename number, typename number2>
+    void
+    vmult_multiple_on_subrange(const ChunkSparsityPattern &cols,
+                               const unsigned int          begin_row,
+                               const unsigned int          end_row,
+                               const number *              values,
+                               const std::size_t *         rowstart,
+                               const size_type *           colnums,
+                               const FullMatrix<number2> & src,
+                               FullMatrix<number2> &       dst,
+                               const bool                  add)
+    {
+      const size_type m          = cols.n_rows();
+      const size_type n          = cols.n_cols();
+      const size_type chunk_size = cols.get_chunk_size();
+      const size_type n_vectors  = src.n();
+
+      for (size_type chunk_row = begin_row; chunk_row < end_row; ++chunk_row)
+        {
+          // the last chunk row and column might have padding elements that
+          // do not correspond to rows and columns of the matrix
+          const size_type first_row = chunk_row * chunk_size;
+          const size_type n_rows_in_chunk =
+            std::min(chunk_size, m - first_row);
+
+          if (add == false)
+            for (size_type r = 0; r < n_rows_in_chunk; ++r)
+              {
+                number2 *const dst_row = &dst(first_row + r, 0);
+                for (size_type v = 0; v < n_vectors; ++v)
+                  dst_row[v] = number2();
+              }
+
+          for (std::size_t j = rowstart[chunk_row]; j < rowstart[chunk_row + 1];
+               ++j)
+            {
+              const number *const val_ptr =
+                &values[j * chunk_size * chunk_size];
+              const size_type first_col = colnums[j] * chunk_size;
+              const size_type n_cols_in_chunk =
+                std::min(chunk_size, n - first_col);
+
+              for (size_type r = 0; r < n_rows_in_chunk; ++r)
+                {
+                  number2 *const dst_row = &dst(first_row + r, 0);
+                  for (size_type c = 0; c < n_cols_in_chunk; ++c)
+                    {
+                      const number2 a = number2(val_ptr[r * chunk_size + c]);
+                      const number2 *const src_row = &src(first_col + c, 0);
+                      for (size_type v = 0; v < n_vectors; ++v)
+                        dst_row[v] += a * src_row[v];
+                    }
+                }
+            }
+        }
+    }
   } // namespace ChunkSparseMatrixImplementation
 } // namespace internal
 
@@ -723,6 +955,66 @@ ChunkSparseMatrix<number>::vmult_add(OutVector &dst, const InVector &src) const
 }
 
 
+
+template <typename number>
+template <typename number2>
+void
+ChunkSparseMatrix<number>::vmult(FullMatrix<number2> &      dst,
+                                 const FullMatrix<number2> &src) const
+{
+  vmult_multiple(dst, src, false);
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+ChunkSparseMatrix<number>::vmult_add(FullMatrix<number2> &      dst,
+                                     const FullMatrix<number2> &src) const
+{
+  vmult_multiple(dst, src, true);
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+ChunkSparseMatrix<number>::vmult_multiple(FullMatrix<number2> &      dst,
+                                          const FullMatrix<number2> &src,
+                                          const bool add) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(val != nullptr, ExcNotInitialized());
+  Assert(m() == dst.m(), ExcDimensionMismatch(m(), dst.m()));
+  Assert(n() == src.m(), ExcDimensionMismatch(n(), src.m()));
+  Assert(src.n() == dst.n(), ExcDimensionMismatch(src.n(), dst.n()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  if (src.n() == 0)
+    return;
+
+  parallel::apply_to_subranges(
+    0U,
+    cols->sparsity_pattern.n_rows(),
+    std::bind(&internal::ChunkSparseMatrixImplementation::
+                vmult_multiple_on_subrange<number, number2>,
+              std::cref(*cols),
+              std::placeholders::_1,
+              std::placeholders::_2,
+              val.get(),
+              cols->sparsity_pattern.rowstart.get(),
+              cols->sparsity_pattern.colnums.get(),
+              std::cref(src),
+              std::ref(dst),
+              add),
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+        (cols->chunk_size * src.n()) +
+      1);
+}
+
+
 template <typename number>
 template <class OutVector, class InVector>
 void
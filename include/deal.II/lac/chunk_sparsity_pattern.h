@@ -515,6 +515,34 @@ public:
   void
   copy_from(const SparsityPatternType &dsp, const size_type chunk_size);
 
+  /**
+   * Suggest a chunk size for the sparsity pattern @p sparsity, to be used
+   * in copy_from(). Vector-valued problems in which the degrees of freedom
+   * of all components at a node are numbered consecutively, as is the case
+   * for the default numbering of an FESystem of several copies of the same
+   * element, lead to sparsity patterns that consist of dense blocks of size
+   * <tt>n_components</tt> times <tt>n_components</tt>, which are exactly
+   * the chunks this class is made for.
+   *
+   * This function returns the largest chunk size between two and
+   * @p max_chunk_size for which the chunks cover the entries of @p sparsity
+   * with at least the fraction @p min_fill_ratio of nonzero entries, i.e.,
+   * for which at most the fraction <tt>1-min_fill_ratio</tt> of the stored
+   * matrix entries are zeros that are not part of @p sparsity. If there is
+   * no such chunk size, one is returned. Chunk sizes that are small
+   * multiples of the number of lanes of VectorizedArray, or are two, three,
+   * four, six, or eight, use specialized kernels in
+   * ChunkSparseMatrix::vmult().
+   *
+   * The cost of this function is proportional to @p max_chunk_size times
+   * the number of entries of @p sparsity.
+   */
+  template <typename SparsityPatternType>
+  static size_type
+  suggest_chunk_size(const SparsityPatternType &sparsity,
+                     const size_type            max_chunk_size = 8,
+                     const double               min_fill_ratio = 0.9);
+
   /**
    * Take a full matrix and use its nonzero entries to generate a sparse
    * matrix entry pattern for this object.
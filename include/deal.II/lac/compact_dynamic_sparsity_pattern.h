@@ -0,0 +1,407 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_compact_dynamic_sparsity_pattern_h
+#define dealii_compact_dynamic_sparsity_pattern_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/exceptions.h>
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Sparsity
+ * @{
+ */
+
+/**
+ * A class that acts as an intermediate form of a sparsity pattern, just like
+ * DynamicSparsityPattern, but that uses considerably less memory while the
+ * pattern is being built, at the price of a two-stage access: entries are
+ * first added with add() and add_entries(), and can only be read after
+ * calling compress(). A typical use is therefore
+ * @code
+ * CompactDynamicSparsityPattern dsp(dof_handler.n_dofs(),
+ *                                   dof_handler.n_dofs());
+ * DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
+ * dsp.compress();
+ * sparsity_pattern.copy_from(dsp);
+ * @endcode
+ *
+ * DynamicSparsityPattern stores a separate std::vector for the entries of
+ * each row, which costs the vector object itself, the overhead of a separate
+ * memory allocation for each row, and up to a factor of two of unused
+ * capacity since the vectors grow by doubling their size. In contrast, this
+ * class groups the rows into segments of contiguous rows. The entries of
+ * each segment are stored in a compressed row format with one array of
+ * column indices for all rows of the segment. New entries are first appended
+ * to a buffer of each segment, and whenever the buffer has grown to a
+ * certain fraction of the number of entries already stored in the segment,
+ * it is sorted, duplicates are removed, and it is merged into the compressed
+ * storage. This way, the entries added for the same position several times,
+ * as happens when looping over the cells of a mesh, do not accumulate, and
+ * the memory used by the object stays close to the one of the final
+ * SparsityPattern. compress() merges the buffers of all segments in
+ * parallel.
+ *
+ * The class provides the interface needed by the functions that build
+ * sparsity patterns, such as DoFTools::make_sparsity_pattern() and
+ * AffineConstraints::add_entries_local_to_global(), and the functions to
+ * read the entries needed by SparsityPattern::copy_from().
+ */
+class CompactDynamicSparsityPattern : public Subscriptor
+{
+public:
+  /**
+   * Declare the type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Initialize as an empty object. You can make the structure usable by
+   * calling the reinit() function.
+   */
+  CompactDynamicSparsityPattern();
+
+  /**
+   * Initialize a rectangular sparsity pattern with @p m rows and @p n
+   * columns. See reinit() for the meaning of @p rows_per_segment.
+   */
+  CompactDynamicSparsityPattern(const size_type    m,
+                                const size_type    n,
+                                const unsigned int rows_per_segment = 256);
+
+  /**
+   * Reallocate memory and set up data structures for a new sparsity pattern
+   * with @p m rows and @p n columns. The rows are grouped into segments of
+   * @p rows_per_segment rows each, which share their storage.
+   */
+  void
+  reinit(const size_type    m,
+         const size_type    n,
+         const unsigned int rows_per_segment = 256);
+
+  /**
+   * Merge all entries added since the last call to this function into the
+   * compressed storage. This function needs to be called before the entries
+   * can be accessed.
+   */
+  void
+  compress();
+
+  /**
+   * Return whether all added entries have been merged by compress().
+   */
+  bool
+  is_compressed() const;
+
+  /**
+   * Return whether the object is empty. It is empty if no memory is
+   * allocated, which is the same as that both dimensions are zero.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Add a nonzero entry. If the entry already exists, this call does nothing.
+   */
+  void
+  add(const size_type i, const size_type j);
+
+  /**
+   * Add several nonzero entries to the specified row. Already existing
+   * entries are ignored.
+   */
+  template <typename ForwardIterator>
+  void
+  add_entries(const size_type row,
+              ForwardIterator begin,
+              ForwardIterator end,
+              const bool      indices_are_unique_and_sorted = false);
+
+  /**
+   * Check if a value at a certain position may be non-zero. The object must
+   * be compressed.
+   */
+  bool
+  exists(const size_type i, const size_type j) const;
+
+  /**
+   * Return the number of rows, which equals the dimension of the image space.
+   */
+  size_type
+  n_rows() const;
+
+  /**
+   * Return the number of columns, which equals the dimension of the range
+   * space.
+   */
+  size_type
+  n_cols() const;
+
+  /**
+   * Number of entries in a specific row. The object must be compressed.
+   */
+  size_type
+  row_length(const size_type row) const;
+
+  /**
+   * Return the column number of the @p index th entry in @p row, where the
+   * entries of each row are sorted by their column number. The object must
+   * be compressed.
+   */
+  size_type
+  column_number(const size_type row, const size_type index) const;
+
+  /**
+   * Return the maximum number of entries per row. The object must be
+   * compressed.
+   */
+  size_type
+  max_entries_per_row() const;
+
+  /**
+   * Return the number of nonzero elements of this sparsity pattern. The
+   * object must be compressed.
+   */
+  size_type
+  n_nonzero_elements() const;
+
+  /**
+   * Print the sparsity pattern. The output consists of one line per row of
+   * the format <tt>[i,j1,j2,j3,...]</tt>. <i>i</i> is the row number and
+   * <i>jn</i> are the allocated columns in this row. The object must be
+   * compressed.
+   */
+  void
+  print(std::ostream &out) const;
+
+  /**
+   * Return whether this object stores only those entries that have been
+   * added explicitly, which is always the case for the current class.
+   */
+  static bool
+  stores_only_added_elements();
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcNotCompressed,
+                   "The entries of this object can only be accessed after "
+                   "calling compress().");
+
+private:
+  /**
+   * The storage of a segment of contiguous rows.
+   */
+  struct Segment
+  {
+    /**
+     * Sort the entries of the buffer, remove duplicates, and merge them into
+     * the compressed storage.
+     */
+    void
+    merge_buffer();
+
+    /**
+     * Merge the buffer if it has grown too large compared to the compressed
+     * storage.
+     */
+    void
+    merge_buffer_if_full();
+
+    /**
+     * Determine an estimate for the memory consumption (in bytes) of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+    /**
+     * The start of each row of the segment in @p columns, with one
+     * additional entry for the end of the last row.
+     */
+    std::vector<std::size_t> row_start;
+
+    /**
+     * The sorted column indices of the entries of all rows of the segment.
+     */
+    std::vector<size_type> columns;
+
+    /**
+     * Pairs of the row within the segment and the column of the entries
+     * added since the last merge.
+     */
+    std::vector<std::pair<unsigned int, size_type>> buffer;
+  };
+
+  /**
+   * Number of rows that this sparsity structure shall represent.
+   */
+  size_type rows;
+
+  /**
+   * Number of columns that this sparsity structure shall represent.
+   */
+  size_type cols;
+
+  /**
+   * The number of rows in each segment.
+   */
+  unsigned int rows_per_segment;
+
+  /**
+   * Whether all entries have been merged into the compressed storage.
+   */
+  bool compressed;
+
+  /**
+   * The segments of rows.
+   */
+  std::vector<Segment> segments;
+};
+
+/**
+ * @}
+ */
+/*---------------------- Inline functions -----------------------------------*/
+
+
+inline void
+CompactDynamicSparsityPattern::Segment::merge_buffer_if_full()
+{
+  // merge once the buffer has grown to a quarter of the entries stored so
+  // far, which bounds the memory of the buffer and makes the merges cheap
+  // on average
+  if (buffer.size() > columns.size() / 4 + 1024)
+    merge_buffer();
+}
+
+
+
+inline void
+CompactDynamicSparsityPattern::add(const size_type i, const size_type j)
+{
+  AssertIndexRange(i, rows);
+  AssertIndexRange(j, cols);
+
+  Segment &segment = segments[i / rows_per_segment];
+  segment.buffer.emplace_back(i % rows_per_segment, j);
+  segment.merge_buffer_if_full();
+  compressed = false;
+}
+
+
+
+template <typename ForwardIterator>
+inline void
+CompactDynamicSparsityPattern::add_entries(const size_type row,
+                                           ForwardIterator begin,
+                                           ForwardIterator end,
+                                           const bool /*indices_are_sorted*/)
+{
+  AssertIndexRange(row, rows);
+
+  if (begin == end)
+    return;
+
+  Segment &          segment   = segments[row / rows_per_segment];
+  const unsigned int local_row = row % rows_per_segment;
+  for (ForwardIterator it = begin; it != end; ++it)
+    {
+      AssertIndexRange(*it, cols);
+      segment.buffer.emplace_back(local_row, *it);
+    }
+  segment.merge_buffer_if_full();
+  compressed = false;
+}
+
+
+
+inline bool
+CompactDynamicSparsityPattern::is_compressed() const
+{
+  return compressed;
+}
+
+
+
+inline CompactDynamicSparsityPattern::size_type
+CompactDynamicSparsityPattern::n_rows() const
+{
+  return rows;
+}
+
+
+
+inline CompactDynamicSparsityPattern::size_type
+CompactDynamicSparsityPattern::n_cols() const
+{
+  return cols;
+}
+
+
+
+inline CompactDynamicSparsityPattern::size_type
+CompactDynamicSparsityPattern::row_length(const size_type row) const
+{
+  AssertIndexRange(row, rows);
+  Assert(compressed, ExcNotCompressed());
+
+  const Segment &    segment   = segments[row / rows_per_segment];
+  const unsigned int local_row = row % rows_per_segment;
+  return segment.row_start[local_row + 1] - segment.row_start[local_row];
+}
+
+
+
+inline CompactDynamicSparsityPattern::size_type
+CompactDynamicSparsityPattern::column_number(const size_type row,
+                                             const size_type index) const
+{
+  AssertIndexRange(index, row_length(row));
+
+  const Segment &segment = segments[row / rows_per_segment];
+  return segment.columns[segment.row_start[row % rows_per_segment] + index];
+}
+
+
+
+inline bool
+CompactDynamicSparsityPattern::stores_only_added_elements()
+{
+  return true;
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
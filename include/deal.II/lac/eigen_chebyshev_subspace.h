@@ -0,0 +1,613 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_eigen_chebyshev_subspace_h
+#define dealii_eigen_chebyshev_subspace_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * Chebyshev-filtered subspace iteration for computing the smallest
+ * eigenvalues and the associated eigenvectors of a symmetric operator (Y.
+ * Zhou, Y. Saad, M. L. Tiago, J. R. Chelikowsky: Self-consistent-field
+ * calculations using Chebyshev-filtered subspace iteration, J. Comput. Phys.
+ * 219, pp. 172-184, 2006).
+ *
+ * The method works on a block of vectors, stored as the blocks of a
+ * LinearAlgebra::distributed::BlockVector with one block per vector. In
+ * every iteration, a Chebyshev polynomial of the operator is applied to the
+ * block that damps the components of the vectors in the unwanted part of the
+ * spectrum $[a,b]$, where $a$ is the largest Ritz value of the current
+ * subspace and $b$ an upper bound of the spectrum of the operator. The
+ * filtered vectors are orthonormalized and a Rayleigh-Ritz step is performed
+ * with the small projected matrix, whose eigenvectors are used to rotate the
+ * block into the basis of Ritz vectors. The iteration stops when the
+ * residuals $\|A x_i - \theta_i x_i\|$ of all requested Ritz pairs are below
+ * the tolerance of the SolverControl object. The upper bound $b$ is
+ * estimated by a few Lanczos steps at the beginning of solve().
+ *
+ * In contrast to ArpackSolver and PArpackSolver, which work on one vector at
+ * a time, the operator is only accessed through its vmult() function, and
+ * the work of the method is dominated by the matrix-vector products of the
+ * filter, there are neither shifted inverses nor vector conversions, and the
+ * orthogonalization and the Rayleigh-Ritz step are done with operations on
+ * the whole block: The inner products of all pairs of vectors of two blocks
+ * are computed with a single global reduction by
+ * LinearAlgebra::distributed::BlockVector::multivector_inner_product(), and
+ * the linear combinations by LinearAlgebra::distributed::BlockVector::mmult().
+ * The projected problems, whose size is the number of vectors in the block,
+ * are solved redundantly on all processes by LAPACK. This makes the method
+ * well suited for computing tens to hundreds of eigenpairs of large
+ * matrix-free operators, e.g. the MatrixFreeOperators classes, working on
+ * LinearAlgebra::distributed::Vector.
+ *
+ * The number of vectors in the block is the number of requested eigenpairs
+ * plus AdditionalData::n_extra_vectors. The additional vectors separate the
+ * requested part of the spectrum from the unwanted one and speed up the
+ * convergence of the largest requested eigenpairs. The degree of the filter
+ * polynomial is set by AdditionalData::degree, and each iteration costs this
+ * number of matrix-vector products per vector of the block. Besides the
+ * block of eigenvectors, the solver allocates four more blocks of the same
+ * size. A typical use is
+ * @code
+ *   LinearAlgebra::distributed::BlockVector<double> eigenvectors(n_eigenpairs);
+ *   for (unsigned int i = 0; i < n_eigenpairs; ++i)
+ *     matrix_free.initialize_dof_vector(eigenvectors.block(i));
+ *   eigenvectors.collect_sizes();
+ *
+ *   SolverControl                  control(1000, 1e-8);
+ *   EigenChebyshevSubspace<double> solver(control);
+ *   std::vector<double>            eigenvalues;
+ *   solver.solve(laplace_operator, eigenvectors, eigenvalues);
+ * @endcode
+ *
+ * The vectors passed to solve() are used as the initial subspace, and
+ * vectors that are zero are replaced by random vectors. The method only
+ * computes eigenpairs of the standard eigenvalue problem $Ax=\lambda x$ of a
+ * real symmetric operator. For a generalized problem with a mass matrix that
+ * is diagonal, as in the case of mass lumping or of the MatrixFree
+ * operators with Gauss-Lobatto quadrature, the operator $M^{-1/2} A
+ * M^{-1/2}$ can be used instead.
+ */
+template <typename Number = double>
+class EigenChebyshevSubspace
+{
+public:
+  /**
+   * The type of the individual vectors.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * The type of the block of vectors.
+   */
+  using BlockVectorType = LinearAlgebra::distributed::BlockVector<Number>;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, use a filter polynomial of degree 10, 10
+     * additional vectors, and 20 Lanczos steps for the estimate of the
+     * upper bound of the spectrum.
+     */
+    explicit AdditionalData(const unsigned int degree          = 10,
+                            const unsigned int n_extra_vectors = 10,
+                            const unsigned int n_lanczos_steps = 20)
+      : degree(degree)
+      , n_extra_vectors(n_extra_vectors)
+      , n_lanczos_steps(n_lanczos_steps)
+    {}
+
+    /**
+     * The degree of the Chebyshev polynomial applied in every iteration.
+     */
+    unsigned int degree;
+
+    /**
+     * The number of vectors used in addition to the requested eigenpairs.
+     */
+    unsigned int n_extra_vectors;
+
+    /**
+     * The number of Lanczos steps for the estimate of the upper bound of the
+     * spectrum.
+     */
+    unsigned int n_lanczos_steps;
+  };
+
+  /**
+   * Constructor.
+   */
+  EigenChebyshevSubspace(SolverControl &       control,
+                         const AdditionalData &data = AdditionalData());
+
+  /**
+   * Compute the smallest eigenvalues of the symmetric operator @p A and the
+   * associated eigenvectors. The number of eigenpairs is given by the
+   * number of blocks of @p eigenvectors, whose blocks need to be initialized
+   * with the parallel layout of the operator and are used as the initial
+   * subspace. On return, @p eigenvalues contains the eigenvalues in
+   * ascending order, and the blocks of @p eigenvectors the associated
+   * orthonormal eigenvectors.
+   *
+   * The operator needs to provide a function
+   * <tt>vmult(VectorType &dst, const VectorType &src)</tt>, which is applied
+   * to each block of the subspace.
+   */
+  template <typename MatrixType>
+  void
+  solve(const MatrixType &   A,
+        BlockVectorType &    eigenvectors,
+        std::vector<Number> &eigenvalues);
+
+  /**
+   * Return the upper bound of the spectrum of the operator that was
+   * estimated in the last call to solve().
+   */
+  Number
+  get_spectrum_upper_bound() const;
+
+protected:
+  /**
+   * Apply the operator to all blocks of @p src.
+   */
+  template <typename MatrixType>
+  static void
+  apply(const MatrixType &A, BlockVectorType &dst, const BlockVectorType &src);
+
+  /**
+   * Estimate an upper bound of the spectrum of @p A with a few steps of the
+   * Lanczos method started from @p v, which is overwritten.
+   */
+  template <typename MatrixType>
+  Number
+  estimate_upper_bound(const MatrixType &A, VectorType &v) const;
+
+  /**
+   * Orthonormalize the blocks of @p X, using @p tmp as temporary storage.
+   * Return false if the blocks were close to linearly dependent, in which
+   * case the orthonormalization should be repeated.
+   */
+  static bool
+  orthonormalize(BlockVectorType &X, BlockVectorType &tmp);
+
+  /**
+   * Perform the Rayleigh-Ritz step for the orthonormal blocks of @p X: After
+   * this function, the blocks of @p X are the Ritz vectors, @p AX contains
+   * their images under the operator, and @p ritz_values the Ritz values in
+   * ascending order. The blocks @p tmp1 and @p tmp2 are used as temporary
+   * storage.
+   */
+  template <typename MatrixType>
+  static void
+  rayleigh_ritz(const MatrixType &   A,
+                BlockVectorType &    X,
+                BlockVectorType &    AX,
+                BlockVectorType &    tmp1,
+                BlockVectorType &    tmp2,
+                std::vector<Number> &ritz_values);
+
+  /**
+   * Apply the Chebyshev filter to the blocks of @p X, whose images under the
+   * operator are given in @p AX. The filter damps the interval
+   * [@p lower_bound, @p upper_bound] of the spectrum and is scaled by the
+   * value at @p lowest_value. The blocks @p AX and @p tmp are overwritten.
+   */
+  template <typename MatrixType>
+  void
+  chebyshev_filter(const MatrixType &A,
+                   BlockVectorType & X,
+                   BlockVectorType & AX,
+                   BlockVectorType & tmp,
+                   const Number      lower_bound,
+                   const Number      upper_bound,
+                   const Number      lowest_value) const;
+
+  /**
+   * Compute all eigenvalues in ascending order and the eigenvectors of the
+   * small symmetric matrix @p matrix with LAPACK.
+   */
+  static void
+  compute_eigenpairs(const FullMatrix<Number> &matrix,
+                     Vector<Number> &          values,
+                     FullMatrix<Number> &      vectors);
+
+  /**
+   * Fill the vector @p v with random values between -1 and 1, using @p seed
+   * and the index of the process to seed the random number generator.
+   */
+  static void
+  set_random(VectorType &v, const unsigned int seed);
+
+  /**
+   * Reference to the object that controls the convergence.
+   */
+  SolverControl &control;
+
+  /**
+   * The additional data of the solver.
+   */
+  const AdditionalData additional_data;
+
+  /**
+   * The upper bound of the spectrum estimated in the last call to solve().
+   */
+  Number upper_bound;
+};
+
+/*@}*/
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename Number>
+EigenChebyshevSubspace<Number>::EigenChebyshevSubspace(
+  SolverControl &       control,
+  const AdditionalData &data)
+  : control(control)
+  , additional_data(data)
+  , upper_bound(0)
+{}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+void
+EigenChebyshevSubspace<Number>::solve(const MatrixType &   A,
+                                      BlockVectorType &    eigenvectors,
+                                      std::vector<Number> &eigenvalues)
+{
+  const unsigned int n_wanted = eigenvectors.n_blocks();
+  const unsigned int n_vectors =
+    n_wanted > 0 ? n_wanted + additional_data.n_extra_vectors : 0;
+  Assert(n_wanted > 0, ExcEmptyObject());
+  Assert(additional_data.degree > 0,
+         ExcMessage("The degree of the filter must be at least one."));
+  AssertIndexRange(n_vectors, eigenvectors.block(0).size() + 1);
+
+  // set up the block of vectors with the requested vectors first and the
+  // additional ones at the end, and replace vectors that are zero by random
+  // vectors. The blocks are stored contiguously, so that the operations on
+  // the whole block run as a single loop.
+  BlockVectorType X(n_vectors);
+  for (unsigned int i = 0; i < n_vectors; ++i)
+    {
+      X.block(i).reinit(eigenvectors.block(0), true);
+      if (i < n_wanted && eigenvectors.block(i).l2_norm() > 0)
+        X.block(i) = eigenvectors.block(i);
+      else
+        set_random(X.block(i), i);
+    }
+  X.collect_sizes();
+  X.use_contiguous_storage();
+
+  BlockVectorType AX, tmp1, tmp2;
+  AX.reinit(X, true);
+  tmp1.reinit(X, true);
+  tmp2.reinit(X, true);
+
+  VectorType v(eigenvectors.block(0));
+  set_random(v, n_vectors);
+  upper_bound = estimate_upper_bound(A, v);
+
+  bool independent = orthonormalize(X, tmp1);
+  if (independent == false)
+    orthonormalize(X, tmp1);
+
+  std::vector<Number> ritz_values;
+  rayleigh_ritz(A, X, AX, tmp1, tmp2, ritz_values);
+
+  SolverControl::State conv = SolverControl::iterate;
+  for (unsigned int iteration = 0;; ++iteration)
+    {
+      // compute the residuals of the requested Ritz pairs
+      double residual = 0;
+      for (unsigned int i = 0; i < n_wanted; ++i)
+        {
+          tmp1.block(i).equ(-ritz_values[i], X.block(i));
+          tmp1.block(i) += AX.block(i);
+          residual = std::max<double>(residual, tmp1.block(i).l2_norm());
+        }
+
+      conv = control.check(iteration, residual);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // the filter damps the part of the spectrum above the largest Ritz
+      // value of the subspace, which needs to be below the upper bound
+      const Number lower_bound =
+        std::min(ritz_values.back(),
+                 ritz_values[0] + Number(0.9) * (upper_bound - ritz_values[0]));
+      chebyshev_filter(
+        A, X, AX, tmp1, lower_bound, upper_bound, ritz_values[0]);
+
+      independent = orthonormalize(X, tmp1);
+      if (independent == false)
+        orthonormalize(X, tmp1);
+      rayleigh_ritz(A, X, AX, tmp1, tmp2, ritz_values);
+    }
+
+  for (unsigned int i = 0; i < n_wanted; ++i)
+    eigenvectors.block(i) = X.block(i);
+  eigenvalues.assign(ritz_values.begin(), ritz_values.begin() + n_wanted);
+
+  AssertThrow(conv == SolverControl::success,
+              SolverControl::NoConvergence(control.last_step(),
+                                           control.last_value()));
+}
+
+
+
+template <typename Number>
+Number
+EigenChebyshevSubspace<Number>::get_spectrum_upper_bound() const
+{
+  return upper_bound;
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+void
+EigenChebyshevSubspace<Number>::apply(const MatrixType &     A,
+                                      BlockVectorType &      dst,
+                                      const BlockVectorType &src)
+{
+  for (unsigned int i = 0; i < src.n_blocks(); ++i)
+    A.vmult(dst.block(i), src.block(i));
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+Number
+EigenChebyshevSubspace<Number>::estimate_upper_bound(const MatrixType &A,
+                                                     VectorType &v) const
+{
+  // The largest eigenvalue of the tridiagonal Lanczos matrix plus the norm of
+  // the last residual is an upper bound of the spectrum (Zhou et al. 2006)
+  const unsigned int n_steps =
+    std::max<unsigned int>(1,
+                           std::min<types::global_dof_index>(
+                             additional_data.n_lanczos_steps, v.size()));
+  std::vector<Number> diagonal, offdiagonal;
+
+  VectorType f(v), v_old(v);
+  v /= v.l2_norm();
+  A.vmult(f, v);
+  diagonal.push_back(f * v);
+  f.add(-diagonal.back(), v);
+  Number residual_norm = f.l2_norm();
+  for (unsigned int step = 1; step < n_steps; ++step)
+    {
+      if (residual_norm <=
+          std::numeric_limits<Number>::epsilon() * std::abs(diagonal[0]))
+        break;
+      offdiagonal.push_back(residual_norm);
+      v_old.swap(v);
+      v.equ(Number(1.) / residual_norm, f);
+      A.vmult(f, v);
+      f.add(-residual_norm, v_old);
+      diagonal.push_back(f * v);
+      f.add(-diagonal.back(), v);
+      residual_norm = f.l2_norm();
+    }
+
+  const unsigned int n = diagonal.size();
+  FullMatrix<Number> T(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      T(i, i) = diagonal[i];
+      if (i + 1 < n)
+        T(i, i + 1) = T(i + 1, i) = offdiagonal[i];
+    }
+  Vector<Number>     lanczos_values;
+  FullMatrix<Number> lanczos_vectors;
+  compute_eigenpairs(T, lanczos_values, lanczos_vectors);
+
+  return lanczos_values[n - 1] + residual_norm;
+}
+
+
+
+template <typename Number>
+bool
+EigenChebyshevSubspace<Number>::orthonormalize(BlockVectorType &X,
+                                               BlockVectorType &tmp)
+{
+  // orthonormalize by the eigendecomposition of the Gram matrix scaled to
+  // unit diagonal (SVQB, A. Stathopoulos, K. Wu: A block orthogonalization
+  // procedure with constant synchronization requirements, SIAM J. Sci.
+  // Comput. 23, pp. 2165-2182, 2002), which needs a single reduction
+  const unsigned int n = X.n_blocks();
+  FullMatrix<Number> gram(n, n);
+  X.multivector_inner_product(gram, X, true);
+
+  std::vector<Number> scaling(n);
+  for (unsigned int i = 0; i < n; ++i)
+    scaling[i] = gram(i, i) > 0 ? Number(1.) / std::sqrt(gram(i, i)) : 0;
+
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      gram(i, j) *= scaling[i] * scaling[j];
+
+  Vector<Number>     values;
+  FullMatrix<Number> vectors;
+  compute_eigenpairs(gram, values, vectors);
+
+  // bound the eigenvalues from below to keep the transformation well
+  // defined for nearly dependent vectors, which are then not exactly
+  // orthonormal and need a second pass
+  const Number largest = std::max(values[n - 1], Number(1e-30));
+  const Number lower   = largest * std::numeric_limits<Number>::epsilon();
+  FullMatrix<Number> transformation(n, n);
+  for (unsigned int j = 0; j < n; ++j)
+    {
+      const Number factor =
+        Number(1.) / std::sqrt(std::max(values[j], lower));
+      for (unsigned int i = 0; i < n; ++i)
+        transformation(i, j) = scaling[i] * vectors(i, j) * factor;
+    }
+
+  X.mmult(tmp, transformation);
+  X.swap(tmp);
+
+  return values[0] >
+         largest * std::sqrt(std::numeric_limits<Number>::epsilon());
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+void
+EigenChebyshevSubspace<Number>::rayleigh_ritz(const MatrixType &   A,
+                                              BlockVectorType &    X,
+                                              BlockVectorType &    AX,
+                                              BlockVectorType &    tmp1,
+                                              BlockVectorType &    tmp2,
+                                              std::vector<Number> &ritz_values)
+{
+  const unsigned int n = X.n_blocks();
+  apply(A, AX, X);
+
+  FullMatrix<Number> projected(n, n);
+  X.multivector_inner_product(projected, AX, true);
+
+  Vector<Number>     values;
+  FullMatrix<Number> vectors;
+  compute_eigenpairs(projected, values, vectors);
+  ritz_values.assign(values.begin(), values.end());
+
+  // rotate the block and its image into the basis of Ritz vectors
+  X.mmult(tmp1, vectors);
+  AX.mmult(tmp2, vectors);
+  X.swap(tmp1);
+  AX.swap(tmp2);
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+void
+EigenChebyshevSubspace<Number>::chebyshev_filter(
+  const MatrixType &A,
+  BlockVectorType & X,
+  BlockVectorType & AX,
+  BlockVectorType & tmp,
+  const Number      lower_bound,
+  const Number      upper_bound,
+  const Number      lowest_value) const
+{
+  // the scaled three-term recurrence of Chebyshev polynomials on the
+  // interval [lower_bound, upper_bound], see Algorithm 3.2 in Zhou et al.
+  // (2006). The first step uses the image of X that is already available.
+  const Number e     = (upper_bound - lower_bound) / 2;
+  const Number c     = (upper_bound + lower_bound) / 2;
+  Number       sigma = e / (lowest_value - c);
+  const Number gamma = 2 / sigma;
+
+  BlockVectorType &Y = AX;
+  Y.sadd(sigma / e, -c * sigma / e, X);
+  for (unsigned int i = 1; i < additional_data.degree; ++i)
+    {
+      const Number sigma_new = 1 / (gamma - sigma);
+      apply(A, tmp, Y);
+      tmp.sadd(2 * sigma_new / e, -2 * sigma_new * c / e, Y);
+      tmp.add(-sigma * sigma_new, X);
+      X.swap(Y);
+      Y.swap(tmp);
+      sigma = sigma_new;
+    }
+  X.swap(Y);
+}
+
+
+
+template <typename Number>
+void
+EigenChebyshevSubspace<Number>::compute_eigenpairs(
+  const FullMatrix<Number> &matrix,
+  Vector<Number> &          values,
+  FullMatrix<Number> &      vectors)
+{
+  // LAPACK computes the eigenvalues in an interval, which is chosen to
+  // contain all of them by Gershgorin's theorem
+  const unsigned int n     = matrix.m();
+  Number             bound = 0;
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      Number row_sum = 0;
+      for (unsigned int j = 0; j < n; ++j)
+        row_sum += std::abs(matrix(i, j));
+      bound = std::max(bound, row_sum);
+    }
+  bound = 2 * bound + 1;
+
+  LAPACKFullMatrix<Number> lapack_matrix(n, n);
+  lapack_matrix = matrix;
+  lapack_matrix.compute_eigenvalues_symmetric(
+    -bound, bound, Number(), values, vectors);
+  AssertDimension(values.size(), n);
+}
+
+
+
+template <typename Number>
+void
+EigenChebyshevSubspace<Number>::set_random(VectorType &       v,
+                                           const unsigned int seed)
+{
+  std::mt19937 generator(
+    seed + 65537 * Utilities::MPI::this_mpi_process(v.get_mpi_communicator()));
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+  for (unsigned int i = 0; i < v.local_size(); ++i)
+    v.local_element(i) = distribution(generator);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
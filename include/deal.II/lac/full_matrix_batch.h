@@ -0,0 +1,253 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_full_matrix_batch_h
+#define dealii_full_matrix_batch_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+
+/**
+ * A collection of square dense matrices of equal size, stored such that the
+ * matrices can be inverted and applied with SIMD instructions across the
+ * matrices. The matrices are grouped into batches of
+ * VectorizedArray::n_array_elements matrices, and the entries of the
+ * matrices of a batch are stored in the lanes of VectorizedArray objects:
+ * lane <tt>v</tt> of entry <tt>(i,j)</tt> of batch <tt>b</tt> is the entry
+ * <tt>(i,j)</tt> of the matrix with index <tt>b*n_lanes+v</tt>.
+ *
+ * For small matrices, such as the diagonal blocks of block-Jacobi methods
+ * for discontinuous Galerkin discretizations, inverting and applying one
+ * matrix at a time is dominated by the overhead of the individual function
+ * calls and by loops that are too short to be vectorized. Processing all
+ * matrices of a batch with the same instructions avoids both. The layout of
+ * the batches coincides with the layout of the cell batches of MatrixFree,
+ * so the matrices of the cells of a cell batch can be stored in one batch
+ * and applied directly to the values of FEEvaluation:
+ * @code
+ *   FullMatrixBatch<double> cell_inverses(matrix_free.n_macro_cells() *
+ *                                           VectorizedArray<double>::
+ *                                             n_array_elements,
+ *                                         dofs_per_cell);
+ *   // ... set the matrices of all cells with set_matrix() ...
+ *   cell_inverses.invert();
+ *
+ *   // in the cell loop:
+ *   phi.reinit(cell);
+ *   phi.read_dof_values(src);
+ *   cell_inverses.vmult(cell,
+ *                       make_array_view(dst_values),
+ *                       make_array_view(phi.begin_dof_values(),
+ *                                       phi.begin_dof_values() +
+ *                                         dofs_per_cell));
+ * @endcode
+ *
+ * The lanes of the last batch that are not used by any matrix hold identity
+ * matrices, which keeps all operations well-defined for them.
+ */
+template <typename Number>
+class FullMatrixBatch
+{
+public:
+  /**
+   * The vectorized data type in which the entries of the matrices of a batch
+   * are stored.
+   */
+  using VectorizedArrayType = VectorizedArray<Number>;
+
+  /**
+   * The number of matrices in one batch.
+   */
+  static const unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+
+  /**
+   * Default constructor. Creates an empty object.
+   */
+  FullMatrixBatch();
+
+  /**
+   * Constructor. Creates @p n_matrices identity matrices with @p size rows
+   * and columns.
+   */
+  FullMatrixBatch(const unsigned int n_matrices, const unsigned int size);
+
+  /**
+   * Resize the object to hold @p n_matrices identity matrices with @p size
+   * rows and columns.
+   */
+  void
+  reinit(const unsigned int n_matrices, const unsigned int size);
+
+  /**
+   * Return the number of matrices stored in this object.
+   */
+  unsigned int
+  n_matrices() const;
+
+  /**
+   * Return the number of batches, i.e., the number of matrices divided by
+   * n_lanes and rounded up.
+   */
+  unsigned int
+  n_batches() const;
+
+  /**
+   * Return the number of rows and columns of each of the matrices.
+   */
+  unsigned int
+  size() const;
+
+  /**
+   * Copy the matrix @p matrix into the position @p index.
+   */
+  void
+  set_matrix(const unsigned int index, const FullMatrix<Number> &matrix);
+
+  /**
+   * Copy the matrix at the position @p index into @p matrix, which is
+   * resized if necessary.
+   */
+  void
+  get_matrix(const unsigned int index, FullMatrix<Number> &matrix) const;
+
+  /**
+   * Replace all matrices by their inverses. The inverses are computed by
+   * the Gauss-Jordan algorithm with partial pivoting of FullMatrix; the
+   * search for the pivots and the row interchanges are done separately for
+   * each matrix, whereas the elimination itself works on all matrices of a
+   * batch at once.
+   */
+  void
+  invert();
+
+  /**
+   * Multiply the matrices of the batch @p batch with the vectors @p src and
+   * store the result in @p dst, i.e., compute <tt>dst[i][v] =
+   * sum_j A_v(i,j) src[j][v]</tt> for each lane <tt>v</tt>. Both arguments
+   * must have size() entries, and @p src and @p dst must not overlap.
+   */
+  void
+  vmult(const unsigned int                          batch,
+        const ArrayView<VectorizedArrayType> &      dst,
+        const ArrayView<const VectorizedArrayType> &src) const;
+
+  /**
+   * Multiply all matrices with the vectors stored in @p src, the result
+   * being stored in @p dst. Both arguments hold n_batches() consecutive
+   * vectors of size() entries in the layout of the argument of the other
+   * vmult() function.
+   */
+  void
+  vmult(const ArrayView<VectorizedArrayType> &      dst,
+        const ArrayView<const VectorizedArrayType> &src) const;
+
+  /**
+   * Return an estimate for the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The number of matrices.
+   */
+  unsigned int n_stored_matrices;
+
+  /**
+   * The number of rows and columns of each matrix.
+   */
+  unsigned int matrix_size;
+
+  /**
+   * The entries of the matrices. The batches are stored one after another,
+   * and the entries within each batch row by row.
+   */
+  AlignedVector<VectorizedArrayType> data;
+};
+
+/*@}*/
+
+
+/* ----------------------- inline functions ----------------------------- */
+
+
+template <typename Number>
+inline unsigned int
+FullMatrixBatch<Number>::n_matrices() const
+{
+  return n_stored_matrices;
+}
+
+
+
+template <typename Number>
+inline unsigned int
+FullMatrixBatch<Number>::n_batches() const
+{
+  return (n_stored_matrices + n_lanes - 1) / n_lanes;
+}
+
+
+
+template <typename Number>
+inline unsigned int
+FullMatrixBatch<Number>::size() const
+{
+  return matrix_size;
+}
+
+
+
+template <typename Number>
+inline void
+FullMatrixBatch<Number>::vmult(
+  const unsigned int                          batch,
+  const ArrayView<VectorizedArrayType> &      dst,
+  const ArrayView<const VectorizedArrayType> &src) const
+{
+  AssertIndexRange(batch, n_batches());
+  AssertDimension(dst.size(), matrix_size);
+  AssertDimension(src.size(), matrix_size);
+
+  const VectorizedArrayType *matrix =
+    data.begin() + static_cast<std::size_t>(batch) * matrix_size * matrix_size;
+  for (unsigned int i = 0; i < matrix_size; ++i, matrix += matrix_size)
+    {
+      VectorizedArrayType sum = matrix[0] * src[0];
+      for (unsigned int j = 1; j < matrix_size; ++j)
+        sum += matrix[j] * src[j];
+      dst[i] = sum;
+    }
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
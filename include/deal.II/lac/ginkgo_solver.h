@@ -23,6 +23,7 @@
 
 #    include <deal.II/lac/block_sparse_matrix.h>
 #    include <deal.II/lac/exceptions.h>
+#    include <deal.II/lac/la_parallel_vector.h>
 #    include <deal.II/lac/solver_control.h>
 #    include <deal.II/lac/sparse_matrix.h>
 #    include <deal.II/lac/vector.h>
@@ -111,10 +112,39 @@ namespace GinkgoWrappers
 
     /**
      * Initialize the matrix and copy over its data to Ginkgo's data structures.
+     * If the sparsity pattern of @p matrix is the same as in the previous
+     * call to this function, only the values are copied to the executor and
+     * the row pointers and column indices already present there are kept.
+     *
+     * The solver and its preconditioner are generated here, such that
+     * several calls to apply() with the same matrix do not set them up again.
      */
     void
     initialize(const SparseMatrix<ValueType> &matrix);
 
+    /**
+     * Initialize the solver with a matrix that is already stored in Ginkgo's
+     * format, e.g. one that has been assembled on the device or one that is
+     * used by another solver as returned by get_system_matrix(). If the
+     * matrix is stored on the executor of this solver, no data is copied, so
+     * a matrix can be shared between several solvers and preconditioners
+     * without transferring it to the device again. After changing the values
+     * of the matrix, this function needs to be called again to generate the
+     * solver and its preconditioner for the new values.
+     */
+    void
+    initialize(
+      const std::shared_ptr<gko::matrix::Csr<ValueType, IndexType>> &matrix);
+
+    /**
+     * Return the matrix in Ginkgo's format as it is stored on the executor of
+     * this solver. If initialize() is later called with a SparseMatrix with
+     * the same sparsity pattern, the values of the returned matrix are
+     * updated in place.
+     */
+    std::shared_ptr<gko::matrix::Csr<ValueType, IndexType>>
+    get_system_matrix() const;
+
     /**
      * Solve the linear system <tt>Ax=b</tt>. Dependent on the information
      * provided by derived classes one of Ginkgo's linear solvers is
@@ -123,6 +153,22 @@ namespace GinkgoWrappers
     void
     apply(Vector<ValueType> &solution, const Vector<ValueType> &rhs);
 
+#    ifdef DEAL_II_WITH_CUDA
+    /**
+     * Solve the linear system <tt>Ax=b</tt> for vectors stored on the
+     * device. The vectors are used by Ginkgo in place, so that no data is
+     * transferred between host and device besides the norms for the
+     * convergence check. This function requires the "cuda" executor and can
+     * only be used in serial.
+     */
+    void
+    apply(
+      LinearAlgebra::distributed::Vector<ValueType, MemorySpace::CUDA>
+        &solution,
+      const LinearAlgebra::distributed::Vector<ValueType, MemorySpace::CUDA>
+        &rhs);
+#    endif
+
     /**
      * Solve the linear system <tt>Ax=b</tt>. Dependent on the information
      * provided by derived classes one of Ginkgo's linear solvers is
@@ -188,6 +234,14 @@ namespace GinkgoWrappers
     void
     initialize_ginkgo_log();
 
+    /**
+     * Apply the solver to the vectors @p b and @p x, which are stored on the
+     * executor, and pass the final residual to the solver_control object.
+     */
+    void
+    apply_solver(gko::matrix::Dense<ValueType> *b,
+                 gko::matrix::Dense<ValueType> *x);
+
     /**
      * Ginkgo matrix data structure. First template parameter is for storing the
      * array of the non-zeros of the matrix. The second is for the row pointers
@@ -197,6 +251,18 @@ namespace GinkgoWrappers
      */
     std::shared_ptr<gko::matrix::Csr<ValueType, IndexType>> system_matrix;
 
+    /**
+     * A copy of the matrix passed to initialize() on the host, which is used
+     * to detect whether the sparsity pattern has changed in a later call.
+     */
+    std::shared_ptr<gko::matrix::Csr<ValueType, IndexType>> host_matrix;
+
+    /**
+     * The solver generated from solver_gen for the system matrix, including
+     * its preconditioner.
+     */
+    std::shared_ptr<gko::LinOp> solver;
+
     /**
      * The execution paradigm as a string to be set by the user. The choices
      * are between `omp`, `cuda` and `reference` and more details can be found
@@ -71,6 +71,17 @@ namespace LinearAlgebra
      * class handles the actual allocation of vectors and provides functions
      * that are specific to the underlying vector type.
      *
+     * By default, each block allocates its own memory. With
+     * use_contiguous_storage(), the locally stored elements of all blocks
+     * are instead placed in one contiguous array, with the blocks acting as
+     * views into it. The block() access is unchanged. If none of the blocks
+     * has ghost entries, the vector space operations such as add(), sadd(),
+     * the inner product, and the norms then run a single loop over the
+     * locally owned elements of all blocks, rather than one loop per block,
+     * which reduces the overhead for vectors with many or small blocks. As
+     * in the default case, the reductions over the processes are done with
+     * a single MPI call for all blocks together.
+     *
      * @note Instantiations for this template are provided for <tt>@<float@>
      * and @<double@></tt>; others can be generated in application programs
      * (see the section on
@@ -305,6 +316,37 @@ namespace LinearAlgebra
       reinit(const BlockVector<Number2> &V,
              const bool                  omit_zeroing_entries = false);
 
+      /**
+       * Set whether the locally stored elements (including the ghost
+       * entries) of all blocks are allocated in one contiguous array, with
+       * the blocks referring to their part of the array. This allows the
+       * vector space operations to work on all blocks with a single loop if
+       * none of the blocks has ghost entries, see the class documentation.
+       * The current content of the vector is kept.
+       *
+       * The setting is kept by the other reinit() functions and is taken
+       * over from the argument by reinit(const BlockVector<Number2> &, const
+       * bool) and the copy constructor, such that temporary vectors created
+       * from a vector with contiguous storage, e.g., inside the iterative
+       * solvers, use contiguous storage too.
+       *
+       * @note Blocks that allocate their memory in an MPI-3 shared-memory
+       * window keep their own allocation. Calling reinit() on individual
+       * blocks, or swapping the data of a block with another vector, is
+       * allowed but gives the block separate storage until the next
+       * reinit() of the block vector; in that case, the operations fall back
+       * to one loop per block.
+       */
+      void
+      use_contiguous_storage(const bool contiguous_storage = true);
+
+      /**
+       * Return whether the vector has been set to use contiguous storage by
+       * use_contiguous_storage().
+       */
+      bool
+      has_contiguous_storage() const;
+
       /**
        * This function copies the data that has accumulated in the data buffer
        * for ghost indices to the owning processor. For the meaning of the
@@ -719,6 +761,44 @@ namespace LinearAlgebra
        */
       DeclException0(ExcIteratorRangeDoesNotMatchVectorSize);
       //@}
+
+    private:
+      /**
+       * Allocate the contiguous array for the locally stored elements of all
+       * blocks and let the blocks refer to it, unless contiguous storage is
+       * not requested or already set up.
+       */
+      void
+      setup_contiguous_storage();
+
+      /**
+       * Return whether the locally stored elements of all blocks are placed
+       * one after the other in #contiguous_vector.
+       */
+      bool
+      storage_is_contiguous() const;
+
+      /**
+       * Return whether this vector and @p v store the locally owned elements
+       * of all blocks in a contiguous array without ghost entries in
+       * between, and with the same sizes of the blocks, such that an
+       * operation on the two vectors can act on #contiguous_vector.
+       */
+      bool
+      is_contiguous_with(const BlockVector<Number> &v) const;
+
+      /**
+       * Whether contiguous storage has been requested by
+       * use_contiguous_storage().
+       */
+      bool contiguous_storage;
+
+      /**
+       * A vector that owns the contiguous array of the locally stored
+       * elements of all blocks if #contiguous_storage is set, and that is
+       * used for the operations on the whole vector.
+       */
+      Vector<Number> contiguous_vector;
     };
 
     /*@}*/
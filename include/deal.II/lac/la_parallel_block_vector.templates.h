@@ -43,6 +43,7 @@ namespace LinearAlgebra
     template <typename Number>
     BlockVector<Number>::BlockVector(const size_type n_blocks,
                                      const size_type block_size)
+      : contiguous_storage(false)
     {
       reinit(n_blocks, block_size);
     }
@@ -51,6 +52,7 @@ namespace LinearAlgebra
 
     template <typename Number>
     BlockVector<Number>::BlockVector(const std::vector<size_type> &n)
+      : contiguous_storage(false)
     {
       reinit(n, false);
     }
@@ -60,6 +62,7 @@ namespace LinearAlgebra
     BlockVector<Number>::BlockVector(const std::vector<IndexSet> &local_ranges,
                                      const std::vector<IndexSet> &ghost_indices,
                                      const MPI_Comm               communicator)
+      : contiguous_storage(false)
     {
       std::vector<size_type> sizes(local_ranges.size());
       for (unsigned int i = 0; i < local_ranges.size(); ++i)
@@ -76,6 +79,7 @@ namespace LinearAlgebra
     template <typename Number>
     BlockVector<Number>::BlockVector(const std::vector<IndexSet> &local_ranges,
                                      const MPI_Comm               communicator)
+      : contiguous_storage(false)
     {
       std::vector<size_type> sizes(local_ranges.size());
       for (unsigned int i = 0; i < local_ranges.size(); ++i)
@@ -93,12 +97,15 @@ namespace LinearAlgebra
     template <typename Number>
     BlockVector<Number>::BlockVector(const BlockVector<Number> &v)
       : BlockVectorBase<Vector<Number>>()
+      , contiguous_storage(v.contiguous_storage)
     {
       this->components.resize(v.n_blocks());
       this->block_indices = v.block_indices;
 
       for (size_type i = 0; i < this->n_blocks(); ++i)
         this->components[i] = v.components[i];
+
+      setup_contiguous_storage();
     }
 
 
@@ -106,6 +113,7 @@ namespace LinearAlgebra
     template <typename Number>
     template <typename OtherNumber>
     BlockVector<Number>::BlockVector(const BlockVector<OtherNumber> &v)
+      : contiguous_storage(false)
     {
       reinit(v, true);
       *this = v;
@@ -135,6 +143,8 @@ namespace LinearAlgebra
 
       for (size_type i = 0; i < this->n_blocks(); ++i)
         this->components[i].reinit(n[i], omit_zeroing_entries);
+
+      setup_contiguous_storage();
     }
 
 
@@ -151,6 +161,142 @@ namespace LinearAlgebra
 
       for (unsigned int i = 0; i < this->n_blocks(); ++i)
         this->block(i).reinit(v.block(i), omit_zeroing_entries);
+
+      contiguous_storage = v.has_contiguous_storage();
+      setup_contiguous_storage();
+    }
+
+
+
+    template <typename Number>
+    void
+    BlockVector<Number>::use_contiguous_storage(const bool contiguous)
+    {
+      contiguous_storage = contiguous;
+      if (contiguous_storage)
+        setup_contiguous_storage();
+      else if (contiguous_vector.local_size() > 0)
+        {
+          // give the blocks that refer to the contiguous array their own
+          // memory again, and release the array afterwards
+          const Number *const begin = contiguous_vector.data.values.get();
+          const Number *const end   = begin + contiguous_vector.local_size();
+          for (unsigned int b = 0; b < this->n_blocks(); ++b)
+            {
+              BlockType &         block  = this->block(b);
+              const Number *const values = block.data.values.get();
+              if (values >= begin && values < end)
+                {
+                  const size_type size =
+                    block.local_size() + block.n_ghost_entries();
+                  block.data.values.reset();
+                  block.allocated_size = 0;
+                  block.resize_val(size);
+                  std::copy(values, values + size, block.data.values.get());
+                }
+            }
+          contiguous_vector.reinit(0);
+        }
+    }
+
+
+
+    template <typename Number>
+    bool
+    BlockVector<Number>::has_contiguous_storage() const
+    {
+      return contiguous_storage;
+    }
+
+
+
+    template <typename Number>
+    bool
+    BlockVector<Number>::storage_is_contiguous() const
+    {
+      const Number *values = contiguous_vector.data.values.get();
+      size_type     offset = 0;
+      for (unsigned int b = 0; b < this->n_blocks(); ++b)
+        {
+          const BlockType &block = this->block(b);
+          const size_type  size  = block.local_size() + block.n_ghost_entries();
+          if (size > 0 && block.data.values.get() != values + offset)
+            return false;
+          offset += size;
+        }
+      return offset == contiguous_vector.local_size();
+    }
+
+
+
+    template <typename Number>
+    void
+    BlockVector<Number>::setup_contiguous_storage()
+    {
+      if (contiguous_storage == false || storage_is_contiguous())
+        return;
+
+      size_type total_size = 0;
+      for (unsigned int b = 0; b < this->n_blocks(); ++b)
+        {
+#ifdef DEAL_II_WITH_MPI
+          // memory in an MPI-3 shared-memory window can not be moved into
+          // the contiguous array, so such vectors keep separate storage
+          if (this->block(b).sm_data != nullptr)
+            return;
+#endif
+          total_size +=
+            this->block(b).local_size() + this->block(b).n_ghost_entries();
+        }
+
+      // allocate the new array, copy the content of the blocks, and let the
+      // blocks refer to their part of the array with a deleter that does
+      // nothing. The previous array is only released after the copy.
+      Vector<Number> new_vector;
+      new_vector.reinit(total_size, /*omit_zeroing_entries =*/true);
+      Number *const values = new_vector.data.values.get();
+
+      size_type offset = 0;
+      for (unsigned int b = 0; b < this->n_blocks(); ++b)
+        {
+          BlockType &     block = this->block(b);
+          const size_type size  = block.local_size() + block.n_ghost_entries();
+          if (size > 0)
+            {
+              std::copy(block.data.values.get(),
+                        block.data.values.get() + size,
+                        values + offset);
+              block.data.values =
+                decltype(block.data.values)(values + offset, [](Number *) {});
+            }
+          else
+            block.data.values.reset();
+          block.allocated_size = size;
+          offset += size;
+        }
+
+      contiguous_vector.swap(new_vector);
+    }
+
+
+
+    template <typename Number>
+    bool
+    BlockVector<Number>::is_contiguous_with(const BlockVector<Number> &v) const
+    {
+      if (contiguous_storage == false || v.contiguous_storage == false ||
+          this->n_blocks() != v.n_blocks() ||
+          contiguous_vector.local_size() != v.contiguous_vector.local_size())
+        return false;
+
+      for (unsigned int b = 0; b < this->n_blocks(); ++b)
+        if (this->block(b).n_ghost_entries() > 0 ||
+            v.block(b).n_ghost_entries() > 0 ||
+            this->block(b).local_size() != v.block(b).local_size())
+          return false;
+
+      return storage_is_contiguous() &&
+             (&v == this || v.storage_is_contiguous());
     }
 
 
@@ -161,7 +307,10 @@ namespace LinearAlgebra
     {
       AssertIsFinite(s);
 
-      BaseClass::operator=(s);
+      if (is_contiguous_with(*this))
+        contiguous_vector = s;
+      else
+        BaseClass::operator=(s);
       return *this;
     }
 
@@ -179,10 +328,17 @@ namespace LinearAlgebra
       if (this->n_blocks() != v.n_blocks())
         reinit(v.n_blocks(), true);
 
+      if (is_contiguous_with(v))
+        {
+          contiguous_vector = v.contiguous_vector;
+          return *this;
+        }
+
       for (size_type i = 0; i < this->n_blocks(); ++i)
         this->components[i] = v.block(i);
 
       this->collect_sizes();
+      setup_contiguous_storage();
       return *this;
     }
 
@@ -339,8 +495,11 @@ namespace LinearAlgebra
     BlockVector<Number> &
     BlockVector<Number>::operator*=(const Number factor)
     {
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block) *= factor;
+      if (is_contiguous_with(*this))
+        contiguous_vector *= factor;
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block) *= factor;
       return *this;
     }
 
@@ -366,8 +525,11 @@ namespace LinearAlgebra
       const BlockVector<Number> &v =
         dynamic_cast<const BlockVector<Number> &>(vv);
       AssertDimension(this->n_blocks(), v.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).scale(v.block(block));
+      if (is_contiguous_with(v))
+        contiguous_vector.scale(v.contiguous_vector);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).scale(v.block(block));
     }
 
 
@@ -383,8 +545,11 @@ namespace LinearAlgebra
       const BlockVector<Number> &v =
         dynamic_cast<const BlockVector<Number> &>(vv);
       AssertDimension(this->n_blocks(), v.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).equ(a, v.block(block));
+      if (is_contiguous_with(v))
+        contiguous_vector.equ(a, v.contiguous_vector);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).equ(a, v.block(block));
     }
 
 
@@ -398,8 +563,11 @@ namespace LinearAlgebra
     {
       AssertDimension(this->n_blocks(), v.n_blocks());
       AssertDimension(this->n_blocks(), w.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).equ(a, v.block(block), b, w.block(block));
+      if (is_contiguous_with(v) && is_contiguous_with(w))
+        contiguous_vector.equ(a, v.contiguous_vector, b, w.contiguous_vector);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).equ(a, v.block(block), b, w.block(block));
     }
 
 
@@ -414,8 +582,11 @@ namespace LinearAlgebra
       const BlockVector<Number> &v =
         dynamic_cast<const BlockVector<Number> &>(vv);
       AssertDimension(this->n_blocks(), v.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block) += v.block(block);
+      if (is_contiguous_with(v))
+        contiguous_vector += v.contiguous_vector;
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block) += v.block(block);
 
       return *this;
     }
@@ -432,8 +603,11 @@ namespace LinearAlgebra
       const BlockVector<Number> &v =
         dynamic_cast<const BlockVector<Number> &>(vv);
       AssertDimension(this->n_blocks(), v.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block) -= v.block(block);
+      if (is_contiguous_with(v))
+        contiguous_vector -= v.contiguous_vector;
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block) -= v.block(block);
 
       return *this;
     }
@@ -444,8 +618,11 @@ namespace LinearAlgebra
     void
     BlockVector<Number>::add(const Number a)
     {
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).add(a);
+      if (is_contiguous_with(*this))
+        contiguous_vector.add(a);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).add(a);
     }
 
 
@@ -461,8 +638,11 @@ namespace LinearAlgebra
       const BlockVector<Number> &v =
         dynamic_cast<const BlockVector<Number> &>(vv);
       AssertDimension(this->n_blocks(), v.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).add(a, v.block(block));
+      if (is_contiguous_with(v))
+        contiguous_vector.add(a, v.contiguous_vector);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).add(a, v.block(block));
     }
 
 
@@ -486,8 +666,11 @@ namespace LinearAlgebra
         dynamic_cast<const BlockVector<Number> &>(ww);
       AssertDimension(this->n_blocks(), v.n_blocks());
 
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).add(a, v.block(block), b, w.block(block));
+      if (is_contiguous_with(v) && is_contiguous_with(w))
+        contiguous_vector.add(a, v.contiguous_vector, b, w.contiguous_vector);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).add(a, v.block(block), b, w.block(block));
     }
 
 
@@ -504,8 +687,11 @@ namespace LinearAlgebra
       const BlockVector<Number> &v =
         dynamic_cast<const BlockVector<Number> &>(vv);
       AssertDimension(this->n_blocks(), v.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).sadd(x, a, v.block(block));
+      if (is_contiguous_with(v))
+        contiguous_vector.sadd(x, a, v.contiguous_vector);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).sadd(x, a, v.block(block));
     }
 
 
@@ -515,8 +701,11 @@ namespace LinearAlgebra
     BlockVector<Number>::sadd(const Number x, const BlockVector<Number> &v)
     {
       AssertDimension(this->n_blocks(), v.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).sadd(x, v.block(block));
+      if (is_contiguous_with(v))
+        contiguous_vector.sadd(x, v.contiguous_vector);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).sadd(x, v.block(block));
     }
 
 
@@ -531,8 +720,12 @@ namespace LinearAlgebra
     {
       AssertDimension(this->n_blocks(), v.n_blocks());
       AssertDimension(this->n_blocks(), w.n_blocks());
-      for (unsigned int block = 0; block < this->n_blocks(); ++block)
-        this->block(block).sadd(x, a, v.block(block), b, w.block(block));
+      if (is_contiguous_with(v) && is_contiguous_with(w))
+        contiguous_vector.sadd(
+          x, a, v.contiguous_vector, b, w.contiguous_vector);
+      else
+        for (unsigned int block = 0; block < this->n_blocks(); ++block)
+          this->block(block).sadd(x, a, v.block(block), b, w.block(block));
     }
 
 
@@ -572,10 +765,13 @@ namespace LinearAlgebra
       // functions handle this case correctly through the job_supports_mpi()
       // query). this is the same in all the functions below
       int local_result = -1;
-      for (unsigned int i = 0; i < this->n_blocks(); ++i)
-        local_result =
-          std::max(local_result,
-                   (this->block(i).linfty_norm_local() == 0) ? -1 : 0);
+      if (is_contiguous_with(*this))
+        local_result = (contiguous_vector.linfty_norm_local() == 0) ? -1 : 0;
+      else
+        for (unsigned int i = 0; i < this->n_blocks(); ++i)
+          local_result =
+            std::max(local_result,
+                     (this->block(i).linfty_norm_local() == 0) ? -1 : 0);
 
       if (this->block(0).partitioner->n_mpi_processes() > 1)
         return -Utilities::MPI::max(
@@ -600,8 +796,12 @@ namespace LinearAlgebra
       AssertDimension(this->n_blocks(), v.n_blocks());
 
       Number local_result = Number();
-      for (unsigned int i = 0; i < this->n_blocks(); ++i)
-        local_result += this->block(i).inner_product_local(v.block(i));
+      if (is_contiguous_with(v))
+        local_result =
+          contiguous_vector.inner_product_local(v.contiguous_vector);
+      else
+        for (unsigned int i = 0; i < this->n_blocks(); ++i)
+          local_result += this->block(i).inner_product_local(v.block(i));
 
       if (this->block(0).partitioner->n_mpi_processes() > 1)
         return Utilities::MPI::sum(
@@ -619,10 +819,15 @@ namespace LinearAlgebra
       Assert(this->n_blocks() > 0, ExcEmptyObject());
 
       Number local_result = Number();
-      for (unsigned int i = 0; i < this->n_blocks(); ++i)
-        local_result +=
-          this->block(i).mean_value_local() *
-          static_cast<real_type>(this->block(i).partitioner->local_size());
+      if (is_contiguous_with(*this))
+        local_result =
+          contiguous_vector.mean_value_local() *
+          static_cast<real_type>(contiguous_vector.partitioner->local_size());
+      else
+        for (unsigned int i = 0; i < this->n_blocks(); ++i)
+          local_result +=
+            this->block(i).mean_value_local() *
+            static_cast<real_type>(this->block(i).partitioner->local_size());
 
       if (this->block(0).partitioner->n_mpi_processes() > 1)
         return Utilities::MPI::sum(
@@ -641,8 +846,11 @@ namespace LinearAlgebra
       Assert(this->n_blocks() > 0, ExcEmptyObject());
 
       real_type local_result = real_type();
-      for (unsigned int i = 0; i < this->n_blocks(); ++i)
-        local_result += this->block(i).l1_norm_local();
+      if (is_contiguous_with(*this))
+        local_result = contiguous_vector.l1_norm_local();
+      else
+        for (unsigned int i = 0; i < this->n_blocks(); ++i)
+          local_result += this->block(i).l1_norm_local();
 
       if (this->block(0).partitioner->n_mpi_processes() > 1)
         return Utilities::MPI::sum(
@@ -660,8 +868,11 @@ namespace LinearAlgebra
       Assert(this->n_blocks() > 0, ExcEmptyObject());
 
       real_type local_result = real_type();
-      for (unsigned int i = 0; i < this->n_blocks(); ++i)
-        local_result += this->block(i).norm_sqr_local();
+      if (is_contiguous_with(*this))
+        local_result = contiguous_vector.norm_sqr_local();
+      else
+        for (unsigned int i = 0; i < this->n_blocks(); ++i)
+          local_result += this->block(i).norm_sqr_local();
 
       if (this->block(0).partitioner->n_mpi_processes() > 1)
         return Utilities::MPI::sum(
@@ -688,8 +899,11 @@ namespace LinearAlgebra
       Assert(this->n_blocks() > 0, ExcEmptyObject());
 
       real_type local_result = real_type();
-      for (unsigned int i = 0; i < this->n_blocks(); ++i)
-        local_result += std::pow(this->block(i).lp_norm_local(p), p);
+      if (is_contiguous_with(*this))
+        local_result = std::pow(contiguous_vector.lp_norm_local(p), p);
+      else
+        for (unsigned int i = 0; i < this->n_blocks(); ++i)
+          local_result += std::pow(this->block(i).lp_norm_local(p), p);
 
       if (this->block(0).partitioner->n_mpi_processes() > 1)
         return std::pow(
@@ -709,9 +923,12 @@ namespace LinearAlgebra
       Assert(this->n_blocks() > 0, ExcEmptyObject());
 
       real_type local_result = real_type();
-      for (unsigned int i = 0; i < this->n_blocks(); ++i)
-        local_result =
-          std::max(local_result, this->block(i).linfty_norm_local());
+      if (is_contiguous_with(*this))
+        local_result = contiguous_vector.linfty_norm_local();
+      else
+        for (unsigned int i = 0; i < this->n_blocks(); ++i)
+          local_result =
+            std::max(local_result, this->block(i).linfty_norm_local());
 
       if (this->block(0).partitioner->n_mpi_processes() > 1)
         return Utilities::MPI::max(
@@ -743,9 +960,14 @@ namespace LinearAlgebra
       AssertDimension(this->n_blocks(), w.n_blocks());
 
       Number local_result = Number();
-      for (unsigned int i = 0; i < this->n_blocks(); ++i)
-        local_result +=
-          this->block(i).add_and_dot_local(a, v.block(i), w.block(i));
+      if (is_contiguous_with(v) && is_contiguous_with(w))
+        local_result = contiguous_vector.add_and_dot_local(a,
+                                                           v.contiguous_vector,
+                                                           w.contiguous_vector);
+      else
+        for (unsigned int i = 0; i < this->n_blocks(); ++i)
+          local_result +=
+            this->block(i).add_and_dot_local(a, v.block(i), w.block(i));
 
       if (this->block(0).partitioner->n_mpi_processes() > 1)
         return Utilities::MPI::sum(
@@ -766,6 +988,10 @@ namespace LinearAlgebra
       for (size_type i = 0; i < this->n_blocks(); ++i)
         dealii::swap(this->components[i], v.components[i]);
       dealii::swap(this->block_indices, v.block_indices);
+
+      // the blocks refer to the contiguous arrays, so exchange them as well
+      std::swap(contiguous_storage, v.contiguous_storage);
+      contiguous_vector.swap(v.contiguous_vector);
     }
 
 
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/memory_space.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/numbers.h>
@@ -28,6 +29,7 @@
 #include <deal.II/lac/vector_space_vector.h>
 #include <deal.II/lac/vector_type_traits.h>
 
+#include <array>
 #include <iomanip>
 #include <memory>
 
@@ -179,6 +181,34 @@ namespace LinearAlgebra
      * fail in some circumstances. Therefore, it is strongly recommended to
      * not rely on this class to automatically detect the unsupported case.
      *
+     * <h4>Data exchange through shared memory</h4>
+     *
+     * When several MPI processes run on the same compute node, the exchange
+     * of ghost data between them by MPI messages amounts to copying the data
+     * through the MPI library, which is wasted memory bandwidth. To avoid
+     * this, the vector can be initialized with the reinit() function that
+     * takes an additional communicator @p comm_sm as argument, which groups
+     * the processes that can access each other's memory. It is typically
+     * created by
+     * @code
+     * MPI_Comm comm_sm;
+     * MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+     *                     &comm_sm);
+     * @endcode
+     * In that case, the local elements of the vector (including the ghost
+     * entries) are allocated in an MPI-3 shared-memory window, see
+     * MPI_Win_allocate_shared, and update_ghost_values() and compress() read
+     * the entries exchanged with the processes in @p comm_sm directly from
+     * their memory. Only the exchange with processes outside @p comm_sm goes
+     * through MPI messages. The processes in @p comm_sm synchronize with
+     * each other through empty messages, such that only processes that
+     * actually exchange data wait for each other.
+     *
+     * Since the allocation and deallocation of the memory window are
+     * collective operations on @p comm_sm, all processes in @p comm_sm must
+     * initialize, swap, and destroy their vectors together. This option is
+     * only available for MemorySpace::Host.
+     *
      * <h4>CUDA support</h4>
      *
      * This vector class supports two different memory spaces: Host and CUDA. By
@@ -364,6 +394,32 @@ namespace LinearAlgebra
       reinit(
         const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner);
 
+      /**
+       * Initialize the vector given to the parallel partitioning described in
+       * @p partitioner, like the previous function, but allocate the local
+       * elements in a shared-memory window of the processes in the
+       * communicator @p comm_sm. The data exchange in update_ghost_values()
+       * and compress() with processes in @p comm_sm then directly accesses
+       * their memory rather than sending messages, see the section on shared
+       * memory in the general documentation of this class.
+       *
+       * The communicator @p comm_sm must contain a subset of the processes in
+       * the communicator of @p partitioner, and it must remain valid as long
+       * as the vector is alive. If @p comm_sm is MPI_COMM_SELF, this function
+       * is equivalent to the previous one.
+       *
+       * This function is collective on the communicator of @p partitioner,
+       * because the data exchange with the processes outside @p comm_sm is
+       * set up by all processes together. Therefore, either all processes
+       * must pass MPI_COMM_SELF or none of them, also those that are the
+       * only process in their shared-memory communicator, such as a process
+       * running alone on a node.
+       */
+      void
+      reinit(
+        const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner,
+        const MPI_Comm &                                          comm_sm);
+
       /**
        * Swap the contents of this vector and the other vector @p v. One could
        * do this operation with a temporary variable and copying over the data
@@ -777,6 +833,48 @@ namespace LinearAlgebra
       virtual real_type
       linfty_norm() const override;
 
+      /**
+       * Start the computation of the square of the $l_2$ norm of the vector
+       * and return a future for the result. The local part of the norm is
+       * computed immediately, and the sum over all processors is done by a
+       * non-blocking <code>MPI_Iallreduce</code>, which completes when
+       * Utilities::MPI::Future::get() is called. This allows to overlap the
+       * communication with local work that does not depend on the result:
+       * @code
+       *   Utilities::MPI::Future<double> norm = residual.l2_norm_start();
+       *   preconditioner.vmult(z, residual);
+       *   if (norm.get() < tolerance)
+       *     ...
+       * @endcode
+       *
+       * This is a collective operation. As for the other collective
+       * operations, all processes need to start the same non-blocking
+       * reductions in the same order.
+       */
+      Utilities::MPI::Future<real_type>
+      norm_sqr_start() const;
+
+      /**
+       * Like norm_sqr_start(), but the future returns the $l_2$ norm of the
+       * vector, see l2_norm().
+       */
+      Utilities::MPI::Future<real_type>
+      l2_norm_start() const;
+
+      /**
+       * Like norm_sqr_start(), but the future returns the mean value of all
+       * the entries in the vector, see mean_value().
+       */
+      Utilities::MPI::Future<Number>
+      mean_value_start() const;
+
+      /**
+       * Like norm_sqr_start(), but the future returns the scalar product of
+       * this vector and @p V, see operator*().
+       */
+      Utilities::MPI::Future<Number>
+      inner_product_start(const Vector<Number, MemorySpace> &V) const;
+
       /**
        * Perform a combined operation of a vector addition and a subsequent
        * inner product, returning the value of the inner product. In other
@@ -903,6 +1001,93 @@ namespace LinearAlgebra
           const Number                       b,
           const Vector<Number, MemorySpace> &v);
 
+      /**
+       * Compute the inner products of the present vector with all the
+       * vectors given by @p vectors, i.e., <tt>results[j] = (*this) *
+       * (*vectors[j])</tt>, for all entries of @p vectors. As opposed to
+       * calling operator*() for each vector separately, this function goes
+       * through the locally owned entries in blocks, computing the
+       * contribution of all vectors to the inner products for one block
+       * before moving on to the next. This way, the entries of the present
+       * vector are loaded from main memory only once. Furthermore, the global
+       * communication is done with a single reduction for all inner products
+       * rather than one reduction per vector. This is the typical operation
+       * of the classical Gram-Schmidt orthogonalization in Krylov solvers,
+       * see e.g. SolverGMRES.
+       *
+       * The result is independent of the number of threads used, as the
+       * partial sums are computed on blocks of fixed size and accumulated in
+       * a fixed order.
+       *
+       * For complex-valued vectors, the scalar product is implemented as
+       * $\left<v,w\right>=\sum_i v_i \bar{w_i}$, like in operator*().
+       *
+       * @pre The size of @p results must match the size of @p vectors, and
+       * all vectors must have the same parallel layout as the present one.
+       */
+      void
+      multiple_inner_products(
+        const ArrayView<const Vector<Number, MemorySpace> *const> &vectors,
+        const ArrayView<Number> &results) const;
+
+      /**
+       * Add a linear combination of the given vectors to the present vector,
+       * i.e., <tt>*this += sum_j factors[j] * (*vectors[j])</tt>. As opposed
+       * to calling add() for each vector separately, the present vector is
+       * read and written only once.
+       *
+       * @pre The size of @p factors must match the size of @p vectors, and
+       * all vectors must have the same parallel layout as the present one.
+       */
+      void
+      add_multiple(
+        const ArrayView<const Number> &                            factors,
+        const ArrayView<const Vector<Number, MemorySpace> *const> &vectors);
+
+      /**
+       * Perform a combined operation of two vector additions and a
+       * subsequent inner product, returning the value of the inner product.
+       * In other words, the result of this function is the same as if the
+       * user called
+       * @code
+       * this->add(a, V, b, W);
+       * return_value = *this * U;
+       * @endcode
+       *
+       * Like the other add_and_dot() function, this method loads each of the
+       * vectors only once, which saves one load of the present vector
+       * compared to calling the two functions separately (or two if @p U
+       * equals @p this). This is the typical update of the residual in
+       * solvers that combine two search directions.
+       *
+       * For complex-valued vectors, the scalar product in the second step is
+       * implemented as
+       * $\left<v,w\right>=\sum_i v_i \bar{w_i}$.
+       */
+      Number
+      add_and_dot(const Number                       a,
+                  const Vector<Number, MemorySpace> &V,
+                  const Number                       b,
+                  const Vector<Number, MemorySpace> &W,
+                  const Vector<Number, MemorySpace> &U);
+
+      /**
+       * Perform the scaling and vector addition <tt>*this = s*(*this) +
+       * a*V</tt> and return the square of the $l_2$ norm of the result, i.e.,
+       * the same as
+       * @code
+       * this->sadd(s, a, V);
+       * return_value = this->norm_sqr();
+       * @endcode
+       * but with a single pass through the vectors, which saves one load of
+       * the present vector. As a special case with <tt>a = 0</tt>, this
+       * function scales the vector and computes the norm of the result.
+       */
+      real_type
+      sadd_and_norm_sqr(const Number                       s,
+                        const Number                       a,
+                        const Vector<Number, MemorySpace> &V);
+
       //@}
 
 
@@ -1173,6 +1358,14 @@ namespace LinearAlgebra
       const MPI_Comm &
       get_mpi_communicator() const;
 
+      /**
+       * Return a reference to the communicator of the processes that share
+       * the memory of the vector with the present process, as set by
+       * reinit(). If no shared memory is used, this is MPI_COMM_SELF.
+       */
+      const MPI_Comm &
+      shared_mpi_communicator() const;
+
       /**
        * Return the MPI partitioner that describes the parallel layout of the
        * vector. This object can be used to initialize another vector with the
@@ -1327,6 +1520,24 @@ namespace LinearAlgebra
                         const Vector<Number, MemorySpace> &V,
                         const Vector<Number, MemorySpace> &W);
 
+      /**
+       * Local part of the add_and_dot() function with two vector additions.
+       */
+      Number
+      add_and_dot_local(const Number                       a,
+                        const Vector<Number, MemorySpace> &V,
+                        const Number                       b,
+                        const Vector<Number, MemorySpace> &W,
+                        const Vector<Number, MemorySpace> &U);
+
+      /**
+       * Local part of sadd_and_norm_sqr().
+       */
+      real_type
+      sadd_and_norm_sqr_local(const Number                       s,
+                              const Number                       a,
+                              const Vector<Number, MemorySpace> &V);
+
       /**
        * Shared pointer to store the parallel partitioning information. This
        * information can be shared between several vectors that have the same
@@ -1384,8 +1595,97 @@ namespace LinearAlgebra
        * operations. This class uses persistent MPI communicators.
        */
       mutable std::vector<MPI_Request> update_ghost_values_requests;
+
+      /**
+       * Data structures for exchanging data with the processes that share
+       * memory with the present one. The entries owned by those processes are
+       * read directly from their memory, whereas the entries of all other
+       * processes are exchanged through the partitioner @p remote_partitioner,
+       * which only contains the ghost indices owned by processes outside the
+       * shared-memory communicator.
+       */
+      struct SharedMemoryData
+      {
+        /**
+         * Pointers to the start of the local elements of all processes in the
+         * shared-memory communicator.
+         */
+        std::vector<Number *> values;
+
+        /**
+         * Partitioner for the data exchange with processes that do not share
+         * memory with the present one.
+         */
+        std::shared_ptr<const Utilities::MPI::Partitioner> remote_partitioner;
+
+        /**
+         * The ranges of positions in the ghost array of this vector that are
+         * exchanged through @p remote_partitioner.
+         */
+        std::vector<std::pair<unsigned int, unsigned int>> remote_ghost_ranges;
+
+        /**
+         * Temporary storage for the ghost entries exchanged through
+         * @p remote_partitioner, stored contiguously.
+         */
+        std::vector<Number> remote_ghost_values;
+
+        /**
+         * The ranks within the shared-memory communicator that own some of
+         * the ghost entries of this vector.
+         */
+        std::vector<unsigned int> ghost_ranks;
+
+        /**
+         * The ranks within the shared-memory communicator that hold some of
+         * the locally owned entries of this vector as ghosts.
+         */
+        std::vector<unsigned int> import_ranks;
+
+        /**
+         * Contiguous ranges of ghost entries to be read from other processes
+         * in update_ghost_values(). Each entry holds the rank in the
+         * shared-memory communicator, the local index in the array of the
+         * owner, the position in the ghost array of this vector, and the
+         * length of the range.
+         */
+        std::vector<std::array<unsigned int, 4>> ghost_copies;
+
+        /**
+         * Contiguous ranges of ghost entries of other processes to be
+         * accumulated into the locally owned entries in compress(). Each entry
+         * holds the rank in the shared-memory communicator, the position in
+         * the array of that process, the local index in this vector, and the
+         * length of the range.
+         */
+        std::vector<std::array<unsigned int, 4>> import_copies;
+
+        /**
+         * The requests for the synchronization messages between the processes
+         * sharing memory.
+         */
+        std::vector<MPI_Request> requests;
+
+        /**
+         * The communication channel of the ongoing operation.
+         */
+        unsigned int channel;
+      };
+
+      /**
+       * The data for the exchange through shared memory, only set in case the
+       * shared-memory communicator contains more than one process.
+       */
+      std::unique_ptr<SharedMemoryData> sm_data;
 #endif
 
+      /**
+       * The communicator of the processes that share the memory of this
+       * vector, see reinit(). The default MPI_COMM_SELF means that the
+       * memory is not shared with other processes.
+       */
+      MPI_Comm comm_sm = MPI_COMM_SELF;
+
       /**
        * A lock that makes sure that the @p compress and @p
        * update_ghost_values functions give reasonable results also when used
@@ -1401,10 +1701,20 @@ namespace LinearAlgebra
       clear_mpi_requests();
 
       /**
-       * A helper function that is used to resize the val array.
+       * A helper function that is used to resize the val array. If the
+       * communicator @p comm_sm is not MPI_COMM_SELF, the memory is allocated
+       * in a shared-memory window of its processes by setup_shared_memory().
        */
       void
-      resize_val(const size_type new_allocated_size);
+      resize_val(const size_type new_allocated_size,
+                 const MPI_Comm &comm_sm = MPI_COMM_SELF);
+
+      /**
+       * Allocate the local elements in an MPI-3 shared-memory window of the
+       * processes in comm_sm and set up the data structures in sm_data.
+       */
+      void
+      setup_shared_memory(const size_type new_allocated_size);
 
       // Make all other vector types friends.
       template <typename Number2, typename MemorySpace2>
@@ -1827,6 +2137,15 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpace>
+    inline const MPI_Comm &
+    Vector<Number, MemorySpace>::shared_mpi_communicator() const
+    {
+      return comm_sm;
+    }
+
+
+
     template <typename Number, typename MemorySpace>
     inline const std::shared_ptr<const Utilities::MPI::Partitioner> &
     Vector<Number, MemorySpace>::get_partitioner() const
@@ -30,6 +30,9 @@
 #include <deal.II/lac/trilinos_vector.h>
 #include <deal.II/lac/vector_operations_internal.h>
 
+#include <map>
+#include <numeric>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -140,7 +143,7 @@ namespace LinearAlgebra
                 reinterpret_cast<void **>(&new_val),
                 64,
                 sizeof(Number) * new_alloc_size);
-              data.values.reset(new_val);
+              data.values = decltype(data.values)(new_val, &std::free);
 
               allocated_size = new_alloc_size;
             }
@@ -371,6 +374,177 @@ namespace LinearAlgebra
         }
       };
 #endif
+
+#ifdef DEAL_II_WITH_MPI
+      // Post zero-size messages to the processes given by send_ranks and
+      // receive the respective messages from the processes given by
+      // recv_ranks, which is used to signal that the memory of a process
+      // sharing data with others may be accessed or modified again
+      inline void
+      start_shared_memory_signals(const std::vector<unsigned int> &send_ranks,
+                                  const std::vector<unsigned int> &recv_ranks,
+                                  const int                        tag,
+                                  const MPI_Comm &                 comm_sm,
+                                  std::vector<MPI_Request> &       requests)
+      {
+        Assert(requests.empty(),
+               ExcMessage("Another operation seems to still be running. "
+                          "Call update_ghost_values_finish() or "
+                          "compress_finish() first."));
+        requests.resize(recv_ranks.size() + send_ranks.size());
+        for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+          {
+            const int ierr = MPI_Irecv(nullptr,
+                                       0,
+                                       MPI_BYTE,
+                                       recv_ranks[i],
+                                       tag,
+                                       comm_sm,
+                                       &requests[i]);
+            AssertThrowMPI(ierr);
+          }
+        for (unsigned int i = 0; i < send_ranks.size(); ++i)
+          {
+            const int ierr = MPI_Isend(nullptr,
+                                       0,
+                                       MPI_BYTE,
+                                       send_ranks[i],
+                                       tag,
+                                       comm_sm,
+                                       &requests[recv_ranks.size() + i]);
+            AssertThrowMPI(ierr);
+          }
+      }
+
+
+
+      inline void
+      finish_shared_memory_signals(std::vector<MPI_Request> &requests)
+      {
+        if (requests.size() > 0)
+          {
+            const int ierr = MPI_Waitall(requests.size(),
+                                         requests.data(),
+                                         MPI_STATUSES_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+        requests.clear();
+      }
+
+
+
+      // Combine the ghost entries of another process with the locally owned
+      // entries in compress(). Comparisons are not available for complex
+      // numbers, so provide separate functions for them.
+      template <typename Number>
+      inline Number
+      shared_memory_min(const Number a, const Number b)
+      {
+        return std::min(a, b);
+      }
+
+      template <typename Number>
+      inline std::complex<Number>
+      shared_memory_min(const std::complex<Number> a,
+                        const std::complex<Number>)
+      {
+        AssertThrow(false,
+                    ExcMessage("VectorOperation::min not "
+                               "implemented for complex numbers"));
+        return a;
+      }
+
+      template <typename Number>
+      inline Number
+      shared_memory_max(const Number a, const Number b)
+      {
+        return std::max(a, b);
+      }
+
+      template <typename Number>
+      inline std::complex<Number>
+      shared_memory_max(const std::complex<Number> a,
+                        const std::complex<Number>)
+      {
+        AssertThrow(false,
+                    ExcMessage("VectorOperation::max not "
+                               "implemented for complex numbers"));
+        return a;
+      }
+
+      template <typename Number>
+      inline void
+      combine_shared_memory_ghosts(
+        const ::dealii::VectorOperation::values operation,
+        const Number *                          ghost_values,
+        const unsigned int                      n_entries,
+        Number *                                owned_values)
+      {
+        if (operation == ::dealii::VectorOperation::add)
+          for (unsigned int i = 0; i < n_entries; ++i)
+            owned_values[i] += ghost_values[i];
+        else if (operation == ::dealii::VectorOperation::min)
+          for (unsigned int i = 0; i < n_entries; ++i)
+            owned_values[i] =
+              shared_memory_min(owned_values[i], ghost_values[i]);
+        else if (operation == ::dealii::VectorOperation::max)
+          for (unsigned int i = 0; i < n_entries; ++i)
+            owned_values[i] =
+              shared_memory_max(owned_values[i], ghost_values[i]);
+        else
+          Assert(operation == ::dealii::VectorOperation::insert,
+                 ExcNotImplemented());
+      }
+#endif
+
+      // Start the summation of the local contribution @p local_value over
+      // the processes of @p communicator with a non-blocking reduction, and
+      // return a future that applies @p finalize to the sum.
+      template <typename Number, typename ResultType>
+      Utilities::MPI::Future<ResultType>
+      start_sum(const Number                                     local_value,
+                const MPI_Comm &                                 communicator,
+                const bool                                       is_parallel,
+                const std::function<ResultType(const Number &)> &finalize)
+      {
+        // the sum is reduced in place, so it needs to live as long as the
+        // future
+        const auto sum = std::make_shared<Number>(local_value);
+
+#ifdef DEAL_II_WITH_MPI
+        const auto request = std::make_shared<MPI_Request>(MPI_REQUEST_NULL);
+        if (is_parallel)
+          {
+            // sum up the real and imaginary parts separately, which avoids
+            // the need for an MPI data type for complex numbers
+            using real_type = typename numbers::NumberTraits<Number>::real_type;
+            static_assert(std::is_same<real_type, double>::value ||
+                            std::is_same<real_type, float>::value,
+                          "Unsupported number type");
+            const int ierr = MPI_Iallreduce(
+              MPI_IN_PLACE,
+              sum.get(),
+              sizeof(Number) / sizeof(real_type),
+              std::is_same<real_type, double>::value ? MPI_DOUBLE : MPI_FLOAT,
+              MPI_SUM,
+              communicator,
+              request.get());
+            AssertThrowMPI(ierr);
+          }
+
+        return Utilities::MPI::Future<ResultType>(
+          [request]() {
+            const int ierr = MPI_Wait(request.get(), MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+          },
+          [sum, finalize]() { return finalize(*sum); });
+#else
+        (void)communicator;
+        (void)is_parallel;
+        return Utilities::MPI::Future<ResultType>(
+          []() {}, [sum, finalize]() { return finalize(*sum); });
+#endif
+      }
     } // namespace internal
 
 
@@ -379,6 +553,15 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::clear_mpi_requests()
     {
 #ifdef DEAL_II_WITH_MPI
+      if (sm_data != nullptr)
+        {
+          for (auto &request : sm_data->requests)
+            {
+              const int ierr = MPI_Request_free(&request);
+              AssertThrowMPI(ierr);
+            }
+          sm_data->requests.clear();
+        }
       for (size_type j = 0; j < compress_requests.size(); j++)
         {
           const int ierr = MPI_Request_free(&compress_requests[j]);
@@ -398,14 +581,272 @@ namespace LinearAlgebra
 
     template <typename Number, typename MemorySpaceType>
     void
-    Vector<Number, MemorySpaceType>::resize_val(const size_type new_alloc_size)
+    Vector<Number, MemorySpaceType>::resize_val(const size_type new_alloc_size,
+                                                const MPI_Comm &comm_sm)
     {
-      internal::la_parallel_vector_templates_functions<
-        Number,
-        MemorySpaceType>::resize_val(new_alloc_size, allocated_size, data);
+      const Number *const old_values = data.values.get();
+
+#ifdef DEAL_II_WITH_MPI
+      // memory in a shared-memory window can neither be grown nor be reused
+      // for a vector without shared memory, so release it in any case. Note
+      // that this is a collective operation on the old communicator.
+      if (sm_data != nullptr)
+        {
+          data.values.reset();
+          allocated_size = 0;
+          sm_data.reset();
+        }
+#endif
+
+      this->comm_sm = comm_sm;
+
+#ifdef DEAL_II_WITH_MPI
+      // this is also done if comm_sm contains only the present process,
+      // because the partitioner for the exchange with the remaining
+      // processes is set up collectively on all processes
+      if (comm_sm != MPI_COMM_SELF)
+        setup_shared_memory(new_alloc_size);
+      else
+#endif
+        internal::la_parallel_vector_templates_functions<
+          Number,
+          MemorySpaceType>::resize_val(new_alloc_size, allocated_size, data);
 
       thread_loop_partitioner =
         std::make_shared<::dealii::parallel::internal::TBBPartitioner>();
+
+      // on NUMA systems, the memory pages are placed close to the processor
+      // socket of the thread that first writes to them. thus, set newly
+      // allocated memory to zero with the same partitioning of the range
+      // into chunks and the same affinity information that all subsequent
+      // vector operations use, such that the threads later find the data
+      // they work on in their local memory
+      if (std::is_same<MemorySpaceType, ::dealii::MemorySpace::Host>::value &&
+          data.values.get() != old_values && allocated_size > 0)
+        dealii::internal::VectorOperations::
+          functions<Number, Number, MemorySpaceType>::set(
+            thread_loop_partitioner, allocated_size, Number(), data);
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::setup_shared_memory(
+      const size_type new_alloc_size)
+    {
+#ifdef DEAL_II_WITH_MPI
+      Assert(
+        (std::is_same<MemorySpaceType, ::dealii::MemorySpace::Host>::value),
+        ExcMessage("Shared memory is only supported for MemorySpace::Host."));
+      AssertDimension(new_alloc_size,
+                      partitioner->local_size() +
+                        partitioner->n_ghost_indices());
+
+      const MPI_Comm &   communicator = partitioner->get_mpi_communicator();
+      const unsigned int n_sm_procs   = Utilities::MPI::n_mpi_processes(comm_sm);
+
+      sm_data = std_cxx14::make_unique<SharedMemoryData>();
+
+      // translate the ranks in the shared-memory communicator to the ranks
+      // in the communicator of the partitioner
+      std::map<unsigned int, unsigned int> sm_rank_of_rank;
+      {
+        std::vector<int> sm_ranks(n_sm_procs), ranks(n_sm_procs);
+        std::iota(sm_ranks.begin(), sm_ranks.end(), 0);
+        MPI_Group sm_group, group;
+        int       ierr = MPI_Comm_group(comm_sm, &sm_group);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Comm_group(communicator, &group);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Group_translate_ranks(
+          sm_group, n_sm_procs, sm_ranks.data(), group, ranks.data());
+        AssertThrowMPI(ierr);
+        ierr = MPI_Group_free(&sm_group);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Group_free(&group);
+        AssertThrowMPI(ierr);
+        for (unsigned int i = 0; i < n_sm_procs; ++i)
+          {
+            AssertThrow(ranks[i] != MPI_UNDEFINED,
+                        ExcMessage("The shared-memory communicator must "
+                                   "be a subset of the communicator of the "
+                                   "partitioner."));
+            sm_rank_of_rank[ranks[i]] = i;
+          }
+      }
+
+      // get the locally owned range of all processes sharing memory
+      std::vector<types::global_dof_index> sm_range_start(n_sm_procs);
+      std::vector<unsigned int>            sm_local_size(n_sm_procs);
+      {
+        const types::global_dof_index my_start =
+          partitioner->local_range().first;
+        const unsigned int my_size = partitioner->local_size();
+        int                ierr    = MPI_Allgather(&my_start,
+                                     1,
+                                     DEAL_II_DOF_INDEX_MPI_TYPE,
+                                     sm_range_start.data(),
+                                     1,
+                                     DEAL_II_DOF_INDEX_MPI_TYPE,
+                                     comm_sm);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Allgather(&my_size,
+                             1,
+                             MPI_UNSIGNED,
+                             sm_local_size.data(),
+                             1,
+                             MPI_UNSIGNED,
+                             comm_sm);
+        AssertThrowMPI(ierr);
+      }
+
+      // go through the ghost indices: the ones owned by processes sharing
+      // memory are read directly from their array, all others are exchanged
+      // with a separate partitioner
+      std::vector<unsigned int> ghost_offsets(n_sm_procs,
+                                              numbers::invalid_unsigned_int);
+      std::vector<types::global_dof_index> remote_ghosts;
+      IndexSet::ElementIterator ghost = partitioner->ghost_indices().begin();
+      unsigned int              position = 0;
+      for (const auto &target : partitioner->ghost_targets())
+        {
+          const auto sm_rank = sm_rank_of_rank.find(target.first);
+          if (sm_rank == sm_rank_of_rank.end())
+            {
+              auto &ranges = sm_data->remote_ghost_ranges;
+              if (ranges.empty() || ranges.back().second != position)
+                ranges.emplace_back(position, position);
+              ranges.back().second += target.second;
+              for (unsigned int i = 0; i < target.second; ++i, ++ghost)
+                remote_ghosts.push_back(*ghost);
+            }
+          else
+            {
+              const unsigned int sm_proc = sm_rank->second;
+              ghost_offsets[sm_proc]     = position;
+              sm_data->ghost_ranks.push_back(sm_proc);
+              auto &copies = sm_data->ghost_copies;
+              for (unsigned int i = 0; i < target.second; ++i, ++ghost)
+                {
+                  const unsigned int index = *ghost - sm_range_start[sm_proc];
+                  if (!copies.empty() && copies.back()[0] == sm_proc &&
+                      copies.back()[1] + copies.back()[3] == index &&
+                      copies.back()[2] + copies.back()[3] == position + i)
+                    ++copies.back()[3];
+                  else
+                    copies.push_back({{sm_proc, index, position + i, 1U}});
+                }
+            }
+          position += target.second;
+        }
+      AssertDimension(position, partitioner->n_ghost_indices());
+
+      // tell the owners where their entries start in our ghost array
+      std::vector<unsigned int> import_offsets(n_sm_procs);
+      {
+        const int ierr = MPI_Alltoall(ghost_offsets.data(),
+                                      1,
+                                      MPI_UNSIGNED,
+                                      import_offsets.data(),
+                                      1,
+                                      MPI_UNSIGNED,
+                                      comm_sm);
+        AssertThrowMPI(ierr);
+      }
+
+      // go through the import indices and find the ones that are held as
+      // ghosts by processes sharing memory
+      const auto & import_indices = partitioner->import_indices();
+      unsigned int chunk          = 0;
+      unsigned int chunk_position = 0;
+      for (const auto &target : partitioner->import_targets())
+        {
+          const auto sm_rank = sm_rank_of_rank.find(target.first);
+          const unsigned int sm_proc = sm_rank == sm_rank_of_rank.end() ?
+                                         numbers::invalid_unsigned_int :
+                                         sm_rank->second;
+          unsigned int position = 0;
+          if (sm_proc != numbers::invalid_unsigned_int)
+            {
+              Assert(import_offsets[sm_proc] != numbers::invalid_unsigned_int,
+                     ExcInternalError());
+              sm_data->import_ranks.push_back(sm_proc);
+              position = sm_local_size[sm_proc] + import_offsets[sm_proc];
+            }
+          for (unsigned int remaining = target.second; remaining > 0;)
+            {
+              AssertIndexRange(chunk, import_indices.size());
+              const unsigned int begin =
+                import_indices[chunk].first + chunk_position;
+              const unsigned int n_entries =
+                std::min(remaining, import_indices[chunk].second - begin);
+              if (sm_proc != numbers::invalid_unsigned_int)
+                sm_data->import_copies.push_back(
+                  {{sm_proc, position, begin, n_entries}});
+              position += n_entries;
+              remaining -= n_entries;
+              chunk_position += n_entries;
+              if (begin + n_entries == import_indices[chunk].second)
+                {
+                  ++chunk;
+                  chunk_position = 0;
+                }
+            }
+        }
+
+      // set up the partitioner for the processes not sharing memory
+      IndexSet remote_ghost_set(partitioner->size());
+      remote_ghost_set.add_indices(remote_ghosts.begin(), remote_ghosts.end());
+      sm_data->remote_partitioner =
+        std::make_shared<Utilities::MPI::Partitioner>(
+          partitioner->locally_owned_range(), remote_ghost_set, communicator);
+      sm_data->remote_ghost_values.resize(remote_ghosts.size());
+
+      // allocate the memory window. Use at least one entry to get a valid
+      // pointer, as the unique_ptr only calls the deleter for non-null
+      // pointers. The window is freed along with the data.
+      {
+        MPI_Info info;
+        int      ierr = MPI_Info_create(&info);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Info_set(info, "alloc_shared_noncontig", "true");
+        AssertThrowMPI(ierr);
+
+        Number * new_val = nullptr;
+        MPI_Win  window;
+        ierr = MPI_Win_allocate_shared(
+          std::max<size_type>(new_alloc_size, 1) * sizeof(Number),
+          sizeof(Number),
+          info,
+          comm_sm,
+          &new_val,
+          &window);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Info_free(&info);
+        AssertThrowMPI(ierr);
+
+        data.values = decltype(data.values)(new_val, [window](Number *) mutable {
+          int finalized = 0;
+          MPI_Finalized(&finalized);
+          if (finalized == 0)
+            MPI_Win_free(&window);
+        });
+        allocated_size = new_alloc_size;
+
+        sm_data->values.resize(n_sm_procs);
+        for (unsigned int i = 0; i < n_sm_procs; ++i)
+          {
+            MPI_Aint size;
+            int      disp_unit;
+            ierr = MPI_Win_shared_query(
+              window, i, &size, &disp_unit, &sm_data->values[i]);
+            AssertThrowMPI(ierr);
+          }
+      }
+#else
+      (void)new_alloc_size;
+#endif
     }
 
 
@@ -450,12 +891,12 @@ namespace LinearAlgebra
       // different (check only if the are allocated
       // differently, not if the actual data is
       // different)
-      if (partitioner.get() != v.partitioner.get())
+      if (partitioner.get() != v.partitioner.get() || comm_sm != v.comm_sm)
         {
           partitioner = v.partitioner;
           const size_type new_allocated_size =
             partitioner->local_size() + partitioner->n_ghost_indices();
-          resize_val(new_allocated_size);
+          resize_val(new_allocated_size, v.comm_sm);
         }
 
       if (omit_zeroing_entries == false)
@@ -510,6 +951,17 @@ namespace LinearAlgebra
     void
     Vector<Number, MemorySpaceType>::reinit(
       const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner_in)
+    {
+      reinit(partitioner_in, MPI_COMM_SELF);
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::reinit(
+      const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner_in,
+      const MPI_Comm &                                          comm_sm)
     {
       clear_mpi_requests();
       partitioner = partitioner_in;
@@ -517,7 +969,7 @@ namespace LinearAlgebra
       // set vector size and allocate memory
       const size_type new_allocated_size =
         partitioner->local_size() + partitioner->n_ghost_indices();
-      resize_val(new_allocated_size);
+      resize_val(new_allocated_size, comm_sm);
 
       // initialize to zero
       this->operator=(Number());
@@ -938,6 +1390,37 @@ namespace LinearAlgebra
 #  endif
         }
 
+      // with shared memory, only the entries of processes on other nodes go
+      // through the partitioner. The entries held by processes sharing
+      // memory with us are read directly from their ghost arrays in
+      // compress_finish(), once they have signaled that they are ready.
+      if (sm_data != nullptr)
+        {
+          const Utilities::MPI::Partitioner &remote =
+            *sm_data->remote_partitioner;
+          Number *     ghosts = data.values.get() + partitioner->local_size();
+          unsigned int c      = 0;
+          for (const auto &range : sm_data->remote_ghost_ranges)
+            for (unsigned int i = range.first; i < range.second; ++i, ++c)
+              sm_data->remote_ghost_values[c] = ghosts[i];
+          remote.import_from_ghosted_array_start(
+            operation,
+            counter,
+            ArrayView<Number, MemorySpace::Host>(
+              sm_data->remote_ghost_values.data(), remote.n_ghost_indices()),
+            ArrayView<Number, MemorySpace::Host>(import_data.values.get(),
+                                                 remote.n_import_indices()),
+            compress_requests);
+
+          sm_data->channel = counter;
+          internal::start_shared_memory_signals(sm_data->ghost_ranks,
+                                                sm_data->import_ranks,
+                                                counter + 401,
+                                                comm_sm,
+                                                sm_data->requests);
+          return;
+        }
+
 #  if defined DEAL_II_COMPILER_CUDA_AWARE && \
     !defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
       if (std::is_same<MemorySpaceType, dealii::MemorySpace::CUDA>::value)
@@ -966,6 +1449,10 @@ namespace LinearAlgebra
     defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
       if (std::is_same<MemorySpaceType, dealii::MemorySpace::CUDA>::value)
         {
+          // the ghost entries are sent directly from device memory, so wait
+          // for the kernels that may still write into them
+          const cudaError_t cuda_error_code = cudaDeviceSynchronize();
+          AssertCuda(cuda_error_code);
           partitioner->import_from_ghosted_array_start(
             operation,
             counter,
@@ -1008,6 +1495,48 @@ namespace LinearAlgebra
 
       // make this function thread safe
       std::lock_guard<std::mutex> lock(mutex);
+
+      if (sm_data != nullptr)
+        {
+          const Utilities::MPI::Partitioner &remote =
+            *sm_data->remote_partitioner;
+          Assert(remote.n_import_indices() == 0 ||
+                   import_data.values != nullptr,
+                 ExcNotInitialized());
+          remote.import_from_ghosted_array_finish<Number, MemorySpace::Host>(
+            operation,
+            ArrayView<const Number, MemorySpace::Host>(
+              import_data.values.get(), remote.n_import_indices()),
+            ArrayView<Number, MemorySpace::Host>(data.values.get(),
+                                                 partitioner->local_size()),
+            ArrayView<Number, MemorySpace::Host>(
+              sm_data->remote_ghost_values.data(), remote.n_ghost_indices()),
+            compress_requests);
+
+          // wait until the processes sharing memory have filled their ghost
+          // entries, then add them into our locally owned range
+          internal::finish_shared_memory_signals(sm_data->requests);
+          for (const auto &copy : sm_data->import_copies)
+            internal::combine_shared_memory_ghosts(operation,
+                                                   sm_data->values[copy[0]] +
+                                                     copy[1],
+                                                   copy[3],
+                                                   data.values.get() + copy[2]);
+
+          // our ghost entries may only be cleared once their owners are done
+          // reading them
+          internal::start_shared_memory_signals(sm_data->import_ranks,
+                                                sm_data->ghost_ranks,
+                                                sm_data->channel + 601,
+                                                comm_sm,
+                                                sm_data->requests);
+          internal::finish_shared_memory_signals(sm_data->requests);
+          std::fill(data.values.get() + partitioner->local_size(),
+                    data.values.get() + allocated_size,
+                    Number());
+          return;
+        }
+
 #  if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
     defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
       if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
@@ -1114,6 +1643,33 @@ namespace LinearAlgebra
 #  endif
         }
 
+      // with shared memory, only the entries of processes on other nodes go
+      // through the partitioner, while the processes sharing memory with us
+      // read our locally owned entries directly once we signal that they are
+      // ready
+      if (sm_data != nullptr)
+        {
+          const Utilities::MPI::Partitioner &remote =
+            *sm_data->remote_partitioner;
+          remote.export_to_ghosted_array_start<Number, MemorySpace::Host>(
+            counter,
+            ArrayView<const Number, MemorySpace::Host>(
+              data.values.get(), partitioner->local_size()),
+            ArrayView<Number, MemorySpace::Host>(import_data.values.get(),
+                                                 remote.n_import_indices()),
+            ArrayView<Number, MemorySpace::Host>(
+              sm_data->remote_ghost_values.data(), remote.n_ghost_indices()),
+            update_ghost_values_requests);
+
+          sm_data->channel = counter;
+          internal::start_shared_memory_signals(sm_data->import_ranks,
+                                                sm_data->ghost_ranks,
+                                                counter,
+                                                comm_sm,
+                                                sm_data->requests);
+          return;
+        }
+
 #  if defined DEAL_II_COMPILER_CUDA_AWARE && \
     !defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
       // Move the data to the host and then move it back to the
@@ -1171,6 +1727,49 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::update_ghost_values_finish() const
     {
 #ifdef DEAL_II_WITH_MPI
+      if (sm_data != nullptr)
+        {
+          const Utilities::MPI::Partitioner &remote =
+            *sm_data->remote_partitioner;
+          AssertDimension(remote.ghost_targets().size() +
+                            remote.import_targets().size(),
+                          update_ghost_values_requests.size());
+
+          // make this function thread safe
+          std::lock_guard<std::mutex> lock(mutex);
+
+          Number *ghosts = data.values.get() + partitioner->local_size();
+          if (update_ghost_values_requests.size() > 0)
+            {
+              remote.export_to_ghosted_array_finish(
+                ArrayView<Number, MemorySpace::Host>(
+                  sm_data->remote_ghost_values.data(),
+                  remote.n_ghost_indices()),
+                update_ghost_values_requests);
+              unsigned int c = 0;
+              for (const auto &range : sm_data->remote_ghost_ranges)
+                for (unsigned int i = range.first; i < range.second; ++i, ++c)
+                  ghosts[i] = sm_data->remote_ghost_values[c];
+            }
+
+          // wait until the owners have signaled that their entries are
+          // ready, copy them, and tell the owners that we are done reading
+          internal::finish_shared_memory_signals(sm_data->requests);
+          for (const auto &copy : sm_data->ghost_copies)
+            std::copy(sm_data->values[copy[0]] + copy[1],
+                      sm_data->values[copy[0]] + copy[1] + copy[3],
+                      ghosts + copy[2]);
+          internal::start_shared_memory_signals(sm_data->ghost_ranks,
+                                                sm_data->import_ranks,
+                                                sm_data->channel + 201,
+                                                comm_sm,
+                                                sm_data->requests);
+          internal::finish_shared_memory_signals(sm_data->requests);
+
+          vector_is_ghosted = true;
+          return;
+        }
+
       // wait for both sends and receives to complete, even though only
       // receives are really necessary. this gives (much) better performance
       AssertDimension(partitioner->ghost_targets().size() +
@@ -1343,7 +1942,9 @@ namespace LinearAlgebra
 
       std::swap(compress_requests, v.compress_requests);
       std::swap(update_ghost_values_requests, v.update_ghost_values_requests);
+      std::swap(sm_data, v.sm_data);
 #endif
+      std::swap(comm_sm, v.comm_sm);
 
       std::swap(partitioner, v.partitioner);
       std::swap(thread_loop_partitioner, v.thread_loop_partitioner);
@@ -1758,6 +2359,125 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::multiple_inner_products(
+      const ArrayView<const Vector<Number, MemorySpaceType> *const> &vectors,
+      const ArrayView<Number> &results) const
+    {
+      AssertDimension(vectors.size(), results.size());
+      const size_type    vec_size  = partitioner->local_size();
+      const unsigned int n_vectors = vectors.size();
+      for (unsigned int j = 0; j < n_vectors; ++j)
+        AssertDimension(vec_size, vectors[j]->local_size());
+
+      if (std::is_same<MemorySpaceType, ::dealii::MemorySpace::Host>::value)
+        {
+          // Split the locally owned range into blocks of fixed size and
+          // compute the contributions of all vectors within a block while
+          // the entries of the present vector are in cache. The partial sums
+          // of the blocks are added in a fixed order at the end, which makes
+          // the result independent of the subdivision among threads.
+          const size_type block_size = 1024;
+          const size_type n_blocks   = (vec_size + block_size - 1) / block_size;
+          std::vector<Number> partial_sums(n_blocks * n_vectors);
+          const Number *      this_values = data.values.get();
+          parallel::apply_to_subranges(
+            size_type(0),
+            n_blocks,
+            [&](const size_type begin_block, const size_type end_block) {
+              for (size_type block = begin_block; block < end_block; ++block)
+                {
+                  const size_type begin = block * block_size;
+                  const size_type end = std::min(begin + block_size, vec_size);
+                  for (unsigned int j = 0; j < n_vectors; ++j)
+                    {
+                      const Number *other_values =
+                        vectors[j]->data.values.get();
+                      Number sum = Number();
+                      for (size_type i = begin; i < end; ++i)
+                        sum += this_values[i] *
+                               numbers::NumberTraits<Number>::conjugate(
+                                 other_values[i]);
+                      partial_sums[block * n_vectors + j] = sum;
+                    }
+                }
+            },
+            16);
+          for (unsigned int j = 0; j < n_vectors; ++j)
+            {
+              Number sum = Number();
+              for (size_type block = 0; block < n_blocks; ++block)
+                sum += partial_sums[block * n_vectors + j];
+              results[j] = sum;
+            }
+        }
+      else
+        for (unsigned int j = 0; j < n_vectors; ++j)
+          results[j] = inner_product_local(*vectors[j]);
+
+      if (partitioner->n_mpi_processes() > 1)
+        Utilities::MPI::sum(ArrayView<const Number>(results.data(),
+                                                    results.size()),
+                            partitioner->get_mpi_communicator(),
+                            results);
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::add_multiple(
+      const ArrayView<const Number> &                                factors,
+      const ArrayView<const Vector<Number, MemorySpaceType> *const> &vectors)
+    {
+      AssertDimension(vectors.size(), factors.size());
+      const size_type    vec_size  = partitioner->local_size();
+      const unsigned int n_vectors = vectors.size();
+      for (unsigned int j = 0; j < n_vectors; ++j)
+        {
+          AssertIsFinite(factors[j]);
+          AssertDimension(vec_size, vectors[j]->local_size());
+        }
+
+      if (std::is_same<MemorySpaceType, ::dealii::MemorySpace::Host>::value)
+        {
+          // work on blocks of the vector to keep the entries of the present
+          // vector in cache while adding the contributions of all vectors
+          const size_type block_size = 1024;
+          Number *        this_values = data.values.get();
+          parallel::apply_to_subranges(
+            size_type(0),
+            vec_size,
+            [&](const size_type begin_range, const size_type end_range) {
+              for (size_type begin = begin_range; begin < end_range;
+                   begin += block_size)
+                {
+                  const size_type end = std::min(begin + block_size, end_range);
+                  for (unsigned int j = 0; j < n_vectors; ++j)
+                    {
+                      const Number *other_values =
+                        vectors[j]->data.values.get();
+                      const Number factor = factors[j];
+                      DEAL_II_OPENMP_SIMD_PRAGMA
+                      for (size_type i = begin; i < end; ++i)
+                        this_values[i] += factor * other_values[i];
+                    }
+                }
+            },
+            dealii::internal::VectorImplementation::
+              minimum_parallel_grain_size);
+        }
+      else
+        for (unsigned int j = 0; j < n_vectors; ++j)
+          add(factors[j], *vectors[j]);
+
+      if (vector_is_ghosted)
+        update_ghost_values();
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     template <typename Number2>
     Number
@@ -1900,6 +2620,70 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    Utilities::MPI::Future<typename Vector<Number, MemorySpaceType>::real_type>
+    Vector<Number, MemorySpaceType>::norm_sqr_start() const
+    {
+      return internal::start_sum<real_type, real_type>(
+        norm_sqr_local(),
+        partitioner->get_mpi_communicator(),
+        partitioner->n_mpi_processes() > 1,
+        [](const real_type &sum) { return sum; });
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    Utilities::MPI::Future<typename Vector<Number, MemorySpaceType>::real_type>
+    Vector<Number, MemorySpaceType>::l2_norm_start() const
+    {
+      return internal::start_sum<real_type, real_type>(
+        norm_sqr_local(),
+        partitioner->get_mpi_communicator(),
+        partitioner->n_mpi_processes() > 1,
+        [](const real_type &sum) { return std::sqrt(sum); });
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    Utilities::MPI::Future<Number>
+    Vector<Number, MemorySpaceType>::mean_value_start() const
+    {
+      const Number local_result = mean_value_local();
+      if (partitioner->n_mpi_processes() > 1)
+        {
+          const real_type size = partitioner->size();
+          return internal::start_sum<Number, Number>(
+            local_result * static_cast<real_type>(partitioner->local_size()),
+            partitioner->get_mpi_communicator(),
+            true,
+            [size](const Number &sum) { return sum / size; });
+        }
+      else
+        return internal::start_sum<Number, Number>(
+          local_result,
+          partitioner->get_mpi_communicator(),
+          false,
+          [](const Number &sum) { return sum; });
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    Utilities::MPI::Future<Number>
+    Vector<Number, MemorySpaceType>::inner_product_start(
+      const Vector<Number, MemorySpaceType> &v) const
+    {
+      return internal::start_sum<Number, Number>(
+        inner_product_local(v),
+        partitioner->get_mpi_communicator(),
+        partitioner->n_mpi_processes() > 1,
+        [](const Number &sum) { return sum; });
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     typename Vector<Number, MemorySpaceType>::real_type
     Vector<Number, MemorySpaceType>::lp_norm_local(const real_type p) const
@@ -2009,6 +2793,102 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    Number
+    Vector<Number, MemorySpaceType>::add_and_dot_local(
+      const Number                           a,
+      const Vector<Number, MemorySpaceType> &v,
+      const Number                           b,
+      const Vector<Number, MemorySpaceType> &w,
+      const Vector<Number, MemorySpaceType> &u)
+    {
+      AssertIsFinite(a);
+      AssertIsFinite(b);
+
+      const size_type vec_size = partitioner->local_size();
+      AssertDimension(vec_size, v.local_size());
+      AssertDimension(vec_size, w.local_size());
+      AssertDimension(vec_size, u.local_size());
+
+      Number sum = dealii::internal::VectorOperations::
+        functions<Number, Number, MemorySpaceType>::add_avpbw_and_dot(
+          thread_loop_partitioner,
+          vec_size,
+          a,
+          b,
+          v.data,
+          w.data,
+          u.data,
+          data);
+
+      AssertIsFinite(sum);
+
+      return sum;
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    Number
+    Vector<Number, MemorySpaceType>::add_and_dot(
+      const Number                           a,
+      const Vector<Number, MemorySpaceType> &v,
+      const Number                           b,
+      const Vector<Number, MemorySpaceType> &w,
+      const Vector<Number, MemorySpaceType> &u)
+    {
+      Number local_result = add_and_dot_local(a, v, b, w, u);
+      if (partitioner->n_mpi_processes() > 1)
+        return Utilities::MPI::sum(local_result,
+                                   partitioner->get_mpi_communicator());
+      else
+        return local_result;
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    typename Vector<Number, MemorySpaceType>::real_type
+    Vector<Number, MemorySpaceType>::sadd_and_norm_sqr_local(
+      const Number                           x,
+      const Number                           a,
+      const Vector<Number, MemorySpaceType> &v)
+    {
+      AssertIsFinite(x);
+      AssertIsFinite(a);
+
+      const size_type vec_size = partitioner->local_size();
+      AssertDimension(vec_size, v.local_size());
+
+      real_type sum;
+      dealii::internal::VectorOperations::
+        functions<Number, Number, MemorySpaceType>::sadd_xav_and_norm_2(
+          thread_loop_partitioner, vec_size, x, a, sum, v.data, data);
+
+      AssertIsFinite(sum);
+
+      return sum;
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    typename Vector<Number, MemorySpaceType>::real_type
+    Vector<Number, MemorySpaceType>::sadd_and_norm_sqr(
+      const Number                           x,
+      const Number                           a,
+      const Vector<Number, MemorySpaceType> &v)
+    {
+      real_type local_result = sadd_and_norm_sqr_local(x, a, v);
+      if (partitioner->n_mpi_processes() > 1)
+        return Utilities::MPI::sum(local_result,
+                                   partitioner->get_mpi_communicator());
+      else
+        return local_result;
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     inline bool
     Vector<Number, MemorySpaceType>::partitioners_are_compatible(
@@ -2045,6 +2925,16 @@ namespace LinearAlgebra
       if (import_data.values != nullptr || import_data.values_dev != nullptr)
         memory += (static_cast<std::size_t>(partitioner->n_import_indices()) *
                    sizeof(Number));
+#ifdef DEAL_II_WITH_MPI
+      if (sm_data != nullptr)
+        memory +=
+          MemoryConsumption::memory_consumption(sm_data->values) +
+          MemoryConsumption::memory_consumption(sm_data->remote_ghost_ranges) +
+          MemoryConsumption::memory_consumption(sm_data->remote_ghost_values) +
+          MemoryConsumption::memory_consumption(sm_data->ghost_copies) +
+          MemoryConsumption::memory_consumption(sm_data->import_copies) +
+          sm_data->remote_partitioner->memory_consumption();
+#endif
       return memory;
     }
 
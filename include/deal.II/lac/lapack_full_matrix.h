@@ -855,6 +855,16 @@ public:
   std::complex<number>
   eigenvalue(const size_type i) const;
 
+  /**
+   * Return the right eigenvectors after compute_eigenvalues() was called
+   * with the flag for the right eigenvectors set, with the eigenvector of
+   * the eigenvalue returned by eigenvalue(i) in column @p i. For real
+   * matrices, the eigenvectors of pairs of complex-conjugate eigenvalues are
+   * complex conjugates of each other as well.
+   */
+  FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+  get_right_eigenvectors() const;
+
   /**
    * Retrieve singular values after compute_svd() or compute_inverse_svd() was
    * called.
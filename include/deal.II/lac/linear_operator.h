@@ -24,7 +24,10 @@
 
 #include <array>
 #include <functional>
+#include <memory>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -125,6 +128,14 @@ identity_operator(const LinearOperator<Range, Domain, Payload> &);
  * const auto op = (op_a + k * op_b) * op_c;
  * @endcode
  *
+ * Sums and scalar multiples of LinearOperator objects, such as
+ * <code>op_a + k * op_b</code> above, are merged into a single linear
+ * combination whose terms are applied one after the other, adding each
+ * term with a single vector update. The intermediate vectors of
+ * compositions, linear combinations, and inverse operators are kept by the
+ * LinearOperator object (and shared among its copies) rather than obtained
+ * from a GrowingVectorMemory pool in every application.
+ *
  * @note This class makes heavy use of <code>std::function</code> objects and
  * lambda functions. This flexibility comes with a run-time penalty. Only use
  * this object to encapsulate matrix object of medium to large size (as a rule
@@ -361,6 +372,280 @@ public:
 };
 
 
+namespace internal
+{
+  namespace LinearOperatorImplementation
+  {
+    /**
+     * The terms $c_i A_i$ of a LinearOperator representing the linear
+     * combination $\sum_i c_i A_i$ of other LinearOperator objects, together
+     * with the temporary vectors for the results of the individual terms.
+     */
+    template <typename Range, typename Domain, typename Payload>
+    struct LinearCombination
+    {
+      using Term = std::pair<typename Range::value_type,
+                             LinearOperator<Range, Domain, Payload>>;
+
+      /**
+       * The coefficients and the operators of the terms.
+       */
+      std::vector<Term> terms;
+
+      /**
+       * Temporary vectors for the application of the operator and of its
+       * transpose, respectively.
+       */
+      GrowingVectorMemoryImplementation::TemporaryVector<Range>  range_vector;
+      GrowingVectorMemoryImplementation::TemporaryVector<Domain> domain_vector;
+    };
+
+
+    /**
+     * The function object that implements vmult(), vmult_add(), Tvmult(),
+     * and Tvmult_add() of a LinearOperator that represents a
+     * LinearCombination: The first term of vmult() is written directly into
+     * the destination vector, and each further term with a coefficient
+     * different from one is computed in the temporary vector of the
+     * LinearCombination and added with a single vector update, which also
+     * applies the coefficient of the first term. Compared to the
+     * application of nested additions and scalings of LinearOperators, this
+     * saves the rescalings of the destination vector before and after an
+     * addition.
+     *
+     * Since the function objects of the LinearOperator can be retrieved via
+     * <code>std::function::target()</code>, operator+() and the scalar
+     * multiplication identify the operators that represent a
+     * LinearCombination and merge the terms of nested linear combinations
+     * into a single one.
+     */
+    template <typename Range,
+              typename Domain,
+              typename Payload,
+              bool transpose,
+              bool add>
+    class LinearCombinationFunction
+    {
+    public:
+      using Destination =
+        typename std::conditional<transpose, Domain, Range>::type;
+      using Source = typename std::conditional<transpose, Range, Domain>::type;
+
+      /**
+       * Constructor.
+       */
+      LinearCombinationFunction(
+        const std::shared_ptr<LinearCombination<Range, Domain, Payload>>
+          &combination)
+        : combination(combination)
+      {}
+
+      /**
+       * Apply the linear combination to @p u and write the result into, or
+       * add it to, @p v.
+       */
+      void
+      operator()(Destination &v, const Source &u) const
+      {
+        using number = typename Range::value_type;
+        const std::integral_constant<bool, transpose> tag{};
+
+        const auto &terms = combination->terms;
+
+        typename GrowingVectorMemoryImplementation::TemporaryVector<
+          Destination>::Pointer tmp(temporary_vector(tag));
+        bool                    tmp_initialized = false;
+
+        // the scaling of v by the coefficient of the first term, which is
+        // merged into the next vector update
+        number scaling = 1.;
+
+        for (unsigned int i = 0; i < terms.size(); ++i)
+          {
+            const number                                  coefficient =
+              terms[i].first;
+            const LinearOperator<Range, Domain, Payload> &op = terms[i].second;
+
+            if (i == 0 && add == false)
+              {
+                apply(op, v, u, tag);
+                scaling = coefficient;
+              }
+            else if (coefficient == number(1.))
+              {
+                if (scaling != number(1.))
+                  {
+                    v *= scaling;
+                    scaling = 1.;
+                  }
+                apply_add(op, v, u, tag);
+              }
+            else
+              {
+                if (tmp_initialized == false)
+                  {
+                    reinit_vector(op, *tmp, tag);
+                    tmp_initialized = true;
+                  }
+                apply(op, *tmp, u, tag);
+                if (scaling != number(1.))
+                  {
+                    v.sadd(scaling, coefficient, *tmp);
+                    scaling = 1.;
+                  }
+                else
+                  v.add(coefficient, *tmp);
+              }
+          }
+
+        if (scaling != number(1.))
+          v *= scaling;
+      }
+
+      /**
+       * The linear combination.
+       */
+      std::shared_ptr<LinearCombination<Range, Domain, Payload>> combination;
+
+    private:
+      GrowingVectorMemoryImplementation::TemporaryVector<Range> &
+      temporary_vector(std::false_type) const
+      {
+        return combination->range_vector;
+      }
+
+      GrowingVectorMemoryImplementation::TemporaryVector<Domain> &
+      temporary_vector(std::true_type) const
+      {
+        return combination->domain_vector;
+      }
+
+      static void
+      apply(const LinearOperator<Range, Domain, Payload> &op,
+            Range &                                       v,
+            const Domain &                                u,
+            std::false_type)
+      {
+        op.vmult(v, u);
+      }
+
+      static void
+      apply(const LinearOperator<Range, Domain, Payload> &op,
+            Domain &                                      v,
+            const Range &                                 u,
+            std::true_type)
+      {
+        op.Tvmult(v, u);
+      }
+
+      static void
+      apply_add(const LinearOperator<Range, Domain, Payload> &op,
+                Range &                                       v,
+                const Domain &                                u,
+                std::false_type)
+      {
+        op.vmult_add(v, u);
+      }
+
+      static void
+      apply_add(const LinearOperator<Range, Domain, Payload> &op,
+                Domain &                                      v,
+                const Range &                                 u,
+                std::true_type)
+      {
+        op.Tvmult_add(v, u);
+      }
+
+      static void
+      reinit_vector(const LinearOperator<Range, Domain, Payload> &op,
+                    Range &                                       v,
+                    std::false_type)
+      {
+        op.reinit_range_vector(v, /*bool omit_zeroing_entries =*/true);
+      }
+
+      static void
+      reinit_vector(const LinearOperator<Range, Domain, Payload> &op,
+                    Domain &                                      v,
+                    std::true_type)
+      {
+        op.reinit_domain_vector(v, /*bool omit_zeroing_entries =*/true);
+      }
+    };
+
+
+    /**
+     * Return the terms of the linear combination represented by @p op if
+     * its function objects have been set up by make_linear_combination(),
+     * or a single term with coefficient one and @p op otherwise.
+     */
+    template <typename Range, typename Domain, typename Payload>
+    std::vector<typename LinearCombination<Range, Domain, Payload>::Term>
+    linear_combination_terms(const LinearOperator<Range, Domain, Payload> &op)
+    {
+      const auto vmult = op.vmult.template target<
+        LinearCombinationFunction<Range, Domain, Payload, false, false>>();
+      const auto vmult_add = op.vmult_add.template target<
+        LinearCombinationFunction<Range, Domain, Payload, false, true>>();
+      const auto Tvmult = op.Tvmult.template target<
+        LinearCombinationFunction<Range, Domain, Payload, true, false>>();
+      const auto Tvmult_add = op.Tvmult_add.template target<
+        LinearCombinationFunction<Range, Domain, Payload, true, true>>();
+
+      // only merge the terms if none of the function objects has been
+      // replaced after the creation of the linear combination
+      if (vmult != nullptr && vmult_add != nullptr && Tvmult != nullptr &&
+          Tvmult_add != nullptr &&
+          vmult->combination == vmult_add->combination &&
+          vmult->combination == Tvmult->combination &&
+          vmult->combination == Tvmult_add->combination)
+        return vmult->combination->terms;
+      else
+        return {{typename Range::value_type(1.), op}};
+    }
+
+
+    /**
+     * Return a LinearOperator with the payload @p payload and the vector
+     * initialization of @p exemplar that represents the linear combination
+     * of @p terms.
+     */
+    template <typename Range, typename Domain, typename Payload>
+    LinearOperator<Range, Domain, Payload>
+    make_linear_combination(
+      const Payload &                                payload,
+      const LinearOperator<Range, Domain, Payload> &exemplar,
+      std::vector<typename LinearCombination<Range, Domain, Payload>::Term>
+        &&terms)
+    {
+      const auto combination =
+        std::make_shared<LinearCombination<Range, Domain, Payload>>();
+      combination->terms = std::move(terms);
+
+      LinearOperator<Range, Domain, Payload> return_op{payload};
+
+      return_op.reinit_range_vector  = exemplar.reinit_range_vector;
+      return_op.reinit_domain_vector = exemplar.reinit_domain_vector;
+
+      return_op.vmult =
+        LinearCombinationFunction<Range, Domain, Payload, false, false>(
+          combination);
+      return_op.vmult_add =
+        LinearCombinationFunction<Range, Domain, Payload, false, true>(
+          combination);
+      return_op.Tvmult =
+        LinearCombinationFunction<Range, Domain, Payload, true, false>(
+          combination);
+      return_op.Tvmult_add =
+        LinearCombinationFunction<Range, Domain, Payload, true, true>(
+          combination);
+
+      return return_op;
+    }
+  } // namespace LinearOperatorImplementation
+} // namespace internal
+
+
 /**
  * @name Vector space operations
  */
@@ -390,37 +675,23 @@ operator+(const LinearOperator<Range, Domain, Payload> &first_op,
     }
   else
     {
-      LinearOperator<Range, Domain, Payload> return_op{
+      // represent the sum as a linear combination of the terms of both
+      // operators (which are copied, so that we have valid computation
+      // objects), merging nested sums and scalings into a single linear
+      // combination
+      auto terms =
+        internal::LinearOperatorImplementation::linear_combination_terms(
+          first_op);
+      const auto second_terms =
+        internal::LinearOperatorImplementation::linear_combination_terms(
+          second_op);
+      terms.insert(terms.end(), second_terms.begin(), second_terms.end());
+
+      return internal::LinearOperatorImplementation::make_linear_combination(
         static_cast<const Payload &>(first_op) +
-        static_cast<const Payload &>(second_op)};
-
-      return_op.reinit_range_vector  = first_op.reinit_range_vector;
-      return_op.reinit_domain_vector = first_op.reinit_domain_vector;
-
-      // ensure to have valid computation objects by catching first_op and
-      // second_op by value
-
-      return_op.vmult = [first_op, second_op](Range &v, const Domain &u) {
-        first_op.vmult(v, u);
-        second_op.vmult_add(v, u);
-      };
-
-      return_op.vmult_add = [first_op, second_op](Range &v, const Domain &u) {
-        first_op.vmult_add(v, u);
-        second_op.vmult_add(v, u);
-      };
-
-      return_op.Tvmult = [first_op, second_op](Domain &v, const Range &u) {
-        second_op.Tvmult(v, u);
-        first_op.Tvmult_add(v, u);
-      };
-
-      return_op.Tvmult_add = [first_op, second_op](Domain &v, const Range &u) {
-        second_op.Tvmult_add(v, u);
-        first_op.Tvmult_add(v, u);
-      };
-
-      return return_op;
+          static_cast<const Payload &>(second_op),
+        first_op,
+        std::move(terms));
     }
 }
 
@@ -462,14 +733,20 @@ operator-(const LinearOperator<Range, Domain, Payload> &first_op,
  * the left.
  *
  * The @p Domain and @p Range types must implement the following
- * <code>operator*=</code> member functions accepting the appropriate scalar
- * Number type for rescaling:
+ * <code>operator*=</code>, <code>add</code>, and <code>sadd</code> member
+ * functions accepting the appropriate scalar Number type for rescaling:
  *
  * @code
  * Domain & operator *=(Domain::value_type);
  * Range & operator *=(Range::value_type);
+ * void add(Range::value_type, const Range &);
+ * void sadd(Range::value_type, Range::value_type, const Range &);
  * @endcode
  *
+ * (and the same for the @p Domain type). The scaled operator is represented
+ * as a linear combination, such that a sum of scaled operators is applied
+ * with a single vector update per term.
+ *
  * @ingroup LAOperators
  */
 template <typename Range, typename Domain, typename Payload>
@@ -490,36 +767,21 @@ operator*(typename Range::value_type                    number,
     {
       return null_operator(op);
     }
+  else if (number == 1.)
+    {
+      return op;
+    }
   else
     {
-      LinearOperator<Range, Domain, Payload> return_op = op;
-
-      // ensure to have valid computation objects by catching number and op by
-      // value
-
-      return_op.vmult = [number, op](Range &v, const Domain &u) {
-        op.vmult(v, u);
-        v *= number;
-      };
-
-      return_op.vmult_add = [number, op](Range &v, const Domain &u) {
-        v /= number;
-        op.vmult_add(v, u);
-        v *= number;
-      };
-
-      return_op.Tvmult = [number, op](Domain &v, const Range &u) {
-        op.Tvmult(v, u);
-        v *= number;
-      };
-
-      return_op.Tvmult_add = [number, op](Domain &v, const Range &u) {
-        v /= number;
-        op.Tvmult_add(v, u);
-        v *= number;
-      };
-
-      return return_op;
+      // scale the coefficients of the terms of op (which are copied, so that
+      // we have valid computation objects)
+      auto terms =
+        internal::LinearOperatorImplementation::linear_combination_terms(op);
+      for (auto &term : terms)
+        term.first *= number;
+
+      return internal::LinearOperatorImplementation::make_linear_combination(
+        static_cast<const Payload &>(op), op, std::move(terms));
     }
 }
 
@@ -594,43 +856,50 @@ operator*(const LinearOperator<Range, Intermediate, Payload> & first_op,
       return_op.reinit_range_vector  = first_op.reinit_range_vector;
 
       // ensure to have valid computation objects by catching first_op and
-      // second_op by value
-
-      return_op.vmult = [first_op, second_op](Range &v, const Domain &u) {
-        GrowingVectorMemory<Intermediate> vector_memory;
-
-        typename VectorMemory<Intermediate>::Pointer i(vector_memory);
-        second_op.reinit_range_vector(*i, /*bool omit_zeroing_entries =*/true);
-        second_op.vmult(*i, u);
-        first_op.vmult(v, *i);
-      };
-
-      return_op.vmult_add = [first_op, second_op](Range &v, const Domain &u) {
-        GrowingVectorMemory<Intermediate> vector_memory;
-
-        typename VectorMemory<Intermediate>::Pointer i(vector_memory);
-        second_op.reinit_range_vector(*i, /*bool omit_zeroing_entries =*/true);
-        second_op.vmult(*i, u);
-        first_op.vmult_add(v, *i);
-      };
-
-      return_op.Tvmult = [first_op, second_op](Domain &v, const Range &u) {
-        GrowingVectorMemory<Intermediate> vector_memory;
+      // second_op by value. The intermediate vector is kept by the operator
+      // (and shared among its copies) instead of obtaining it from a
+      // GrowingVectorMemory pool in every application.
+
+      using TemporaryVector =
+        internal::GrowingVectorMemoryImplementation::TemporaryVector<
+          Intermediate>;
+      const auto storage = std::make_shared<TemporaryVector>();
+
+      return_op.vmult =
+        [first_op, second_op, storage](Range &v, const Domain &u) {
+          typename TemporaryVector::Pointer i(*storage);
+          second_op.reinit_range_vector(*i,
+                                        /*bool omit_zeroing_entries =*/true);
+          second_op.vmult(*i, u);
+          first_op.vmult(v, *i);
+        };
 
-        typename VectorMemory<Intermediate>::Pointer i(vector_memory);
-        first_op.reinit_domain_vector(*i, /*bool omit_zeroing_entries =*/true);
-        first_op.Tvmult(*i, u);
-        second_op.Tvmult(v, *i);
-      };
+      return_op.vmult_add =
+        [first_op, second_op, storage](Range &v, const Domain &u) {
+          typename TemporaryVector::Pointer i(*storage);
+          second_op.reinit_range_vector(*i,
+                                        /*bool omit_zeroing_entries =*/true);
+          second_op.vmult(*i, u);
+          first_op.vmult_add(v, *i);
+        };
 
-      return_op.Tvmult_add = [first_op, second_op](Domain &v, const Range &u) {
-        GrowingVectorMemory<Intermediate> vector_memory;
+      return_op.Tvmult =
+        [first_op, second_op, storage](Domain &v, const Range &u) {
+          typename TemporaryVector::Pointer i(*storage);
+          first_op.reinit_domain_vector(*i,
+                                        /*bool omit_zeroing_entries =*/true);
+          first_op.Tvmult(*i, u);
+          second_op.Tvmult(v, *i);
+        };
 
-        typename VectorMemory<Intermediate>::Pointer i(vector_memory);
-        first_op.reinit_domain_vector(*i, /*bool omit_zeroing_entries =*/true);
-        first_op.Tvmult(*i, u);
-        second_op.Tvmult_add(v, *i);
-      };
+      return_op.Tvmult_add =
+        [first_op, second_op, storage](Domain &v, const Range &u) {
+          typename TemporaryVector::Pointer i(*storage);
+          first_op.reinit_domain_vector(*i,
+                                        /*bool omit_zeroing_entries =*/true);
+          first_op.Tvmult(*i, u);
+          second_op.Tvmult_add(v, *i);
+        };
 
       return return_op;
     }
@@ -705,11 +974,15 @@ inverse_operator(const LinearOperator<Range, Domain, Payload> &op,
     solver.solve(op, v, u, preconditioner);
   };
 
-  return_op.vmult_add = [op, &solver, &preconditioner](Range &       v,
-                                                       const Domain &u) {
-    GrowingVectorMemory<Range> vector_memory;
+  // the result of vmult_add and Tvmult_add is computed in a vector that is
+  // kept by the operator
+  using TemporaryVector =
+    internal::GrowingVectorMemoryImplementation::TemporaryVector<Range>;
+  const auto storage = std::make_shared<TemporaryVector>();
 
-    typename VectorMemory<Range>::Pointer v2(vector_memory);
+  return_op.vmult_add = [op, &solver, &preconditioner, storage](
+                          Range &v, const Domain &u) {
+    typename TemporaryVector::Pointer v2(*storage);
     op.reinit_range_vector(*v2, /*bool omit_zeroing_entries =*/false);
     solver.solve(op, *v2, u, preconditioner);
     v += *v2;
@@ -720,11 +993,9 @@ inverse_operator(const LinearOperator<Range, Domain, Payload> &op,
     solver.solve(transpose_operator(op), v, u, preconditioner);
   };
 
-  return_op.Tvmult_add = [op, &solver, &preconditioner](Range &       v,
-                                                        const Domain &u) {
-    GrowingVectorMemory<Range> vector_memory;
-
-    typename VectorMemory<Range>::Pointer v2(vector_memory);
+  return_op.Tvmult_add = [op, &solver, &preconditioner, storage](
+                           Range &v, const Domain &u) {
+    typename TemporaryVector::Pointer v2(*storage);
     op.reinit_range_vector(*v2, /*bool omit_zeroing_entries =*/false);
     solver.solve(transpose_operator(op), *v2, u, preconditioner);
     v += *v2;
@@ -762,11 +1033,15 @@ inverse_operator(const LinearOperator<Range, Domain, Payload> &op,
     solver.solve(op, v, u, preconditioner);
   };
 
-  return_op.vmult_add = [op, &solver, preconditioner](Range &       v,
-                                                      const Domain &u) {
-    GrowingVectorMemory<Range> vector_memory;
+  // the result of vmult_add and Tvmult_add is computed in a vector that is
+  // kept by the operator
+  using TemporaryVector =
+    internal::GrowingVectorMemoryImplementation::TemporaryVector<Range>;
+  const auto storage = std::make_shared<TemporaryVector>();
 
-    typename VectorMemory<Range>::Pointer v2(vector_memory);
+  return_op.vmult_add = [op, &solver, preconditioner, storage](
+                          Range &v, const Domain &u) {
+    typename TemporaryVector::Pointer v2(*storage);
     op.reinit_range_vector(*v2, /*bool omit_zeroing_entries =*/false);
     solver.solve(op, *v2, u, preconditioner);
     v += *v2;
@@ -777,11 +1052,9 @@ inverse_operator(const LinearOperator<Range, Domain, Payload> &op,
     solver.solve(transpose_operator(op), v, u, preconditioner);
   };
 
-  return_op.Tvmult_add = [op, &solver, preconditioner](Range &       v,
-                                                       const Domain &u) {
-    GrowingVectorMemory<Range> vector_memory;
-
-    typename VectorMemory<Range>::Pointer v2(vector_memory);
+  return_op.Tvmult_add = [op, &solver, preconditioner, storage](
+                           Range &v, const Domain &u) {
+    typename TemporaryVector::Pointer v2(*storage);
     op.reinit_range_vector(*v2, /*bool omit_zeroing_entries =*/false);
     solver.solve(transpose_operator(op), *v2, u, preconditioner);
     v += *v2;
@@ -1171,17 +1444,18 @@ namespace internal
 
 
     // A helper function to apply a given vmult, or Tvmult to a vector with
-    // intermediate storage
+    // the intermediate storage kept by the LinearOperator
     template <typename Function, typename Range, typename Domain>
     void
-    apply_with_intermediate_storage(Function      function,
-                                    Range &       v,
-                                    const Domain &u,
-                                    bool          add)
+    apply_with_intermediate_storage(
+      GrowingVectorMemoryImplementation::TemporaryVector<Range> &storage,
+      Function                                                   function,
+      Range &                                                    v,
+      const Domain &                                             u,
+      bool                                                       add)
     {
-      GrowingVectorMemory<Range> vector_memory;
-
-      typename VectorMemory<Range>::Pointer i(vector_memory);
+      typename GrowingVectorMemoryImplementation::TemporaryVector<
+        Range>::Pointer i(storage);
       i->reinit(v, /*bool omit_zeroing_entries =*/true);
 
       function(*i, u);
@@ -1204,12 +1478,18 @@ namespace internal
       operator()(LinearOperator<Range, Domain, Payload> &op,
                  const Matrix &                          matrix)
       {
-        op.vmult = [&matrix](Range &v, const Domain &u) {
+        const auto range_storage = std::make_shared<
+          GrowingVectorMemoryImplementation::TemporaryVector<Range>>();
+        const auto domain_storage = std::make_shared<
+          GrowingVectorMemoryImplementation::TemporaryVector<Domain>>();
+
+        op.vmult = [&matrix, range_storage](Range &v, const Domain &u) {
           if (PointerComparison::equal(&v, &u))
             {
               // If v and u are the same memory location use intermediate
               // storage
               apply_with_intermediate_storage(
+                *range_storage,
                 [&matrix](Range &b, const Domain &a) { matrix.vmult(b, a); },
                 v,
                 u,
@@ -1221,21 +1501,23 @@ namespace internal
             }
         };
 
-        op.vmult_add = [&matrix](Range &v, const Domain &u) {
+        op.vmult_add = [&matrix, range_storage](Range &v, const Domain &u) {
           // use intermediate storage to implement vmult_add with vmult
           apply_with_intermediate_storage(
+            *range_storage,
             [&matrix](Range &b, const Domain &a) { matrix.vmult(b, a); },
             v,
             u,
             /*bool add =*/true);
         };
 
-        op.Tvmult = [&matrix](Domain &v, const Range &u) {
+        op.Tvmult = [&matrix, domain_storage](Domain &v, const Range &u) {
           if (PointerComparison::equal(&v, &u))
             {
               // If v and u are the same memory location use intermediate
               // storage
               apply_with_intermediate_storage(
+                *domain_storage,
                 [&matrix](Domain &b, const Range &a) { matrix.Tvmult(b, a); },
                 v,
                 u,
@@ -1247,9 +1529,10 @@ namespace internal
             }
         };
 
-        op.Tvmult_add = [&matrix](Domain &v, const Range &u) {
+        op.Tvmult_add = [&matrix, domain_storage](Domain &v, const Range &u) {
           // use intermediate storage to implement Tvmult_add with Tvmult
           apply_with_intermediate_storage(
+            *domain_storage,
             [&matrix](Domain &b, const Range &a) { matrix.Tvmult(b, a); },
             v,
             u,
@@ -1276,10 +1559,16 @@ namespace internal
 
         // ... but add native vmult_add and Tvmult_add variants:
 
-        op.vmult_add = [&matrix](Range &v, const Domain &u) {
+        const auto range_storage = std::make_shared<
+          GrowingVectorMemoryImplementation::TemporaryVector<Range>>();
+        const auto domain_storage = std::make_shared<
+          GrowingVectorMemoryImplementation::TemporaryVector<Domain>>();
+
+        op.vmult_add = [&matrix, range_storage](Range &v, const Domain &u) {
           if (PointerComparison::equal(&v, &u))
             {
               apply_with_intermediate_storage(
+                *range_storage,
                 [&matrix](Range &b, const Domain &a) { matrix.vmult(b, a); },
                 v,
                 u,
@@ -1291,10 +1580,11 @@ namespace internal
             }
         };
 
-        op.Tvmult_add = [&matrix](Domain &v, const Range &u) {
+        op.Tvmult_add = [&matrix, domain_storage](Domain &v, const Range &u) {
           if (PointerComparison::equal(&v, &u))
             {
               apply_with_intermediate_storage(
+                *domain_storage,
                 [&matrix](Domain &b, const Range &a) { matrix.Tvmult(b, a); },
                 v,
                 u,
@@ -23,6 +23,7 @@
 #include <deal.II/lac/vector_memory.h>
 
 #include <functional>
+#include <memory>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -342,11 +343,19 @@ operator-(const PackagedOperation<Range> &first_comp,
     first_comp.apply_add(v);
   };
 
-  return_comp.apply_add = [first_comp, second_comp](Range &v) {
+  // the result of second_comp is subtracted with a single vector update,
+  // using a temporary vector kept by the PackagedOperation
+  using TemporaryVector =
+    internal::GrowingVectorMemoryImplementation::TemporaryVector<Range>;
+  const auto storage = std::make_shared<TemporaryVector>();
+
+  return_comp.apply_add = [first_comp, second_comp, storage](Range &v) {
     first_comp.apply_add(v);
-    v *= -1.;
-    second_comp.apply_add(v);
-    v *= -1.;
+
+    typename TemporaryVector::Pointer i(*storage);
+    second_comp.reinit_vector(*i, /*bool omit_zeroing_entries =*/true);
+    second_comp.apply(*i);
+    v.add(-1., *i);
   };
 
   return return_comp;
@@ -382,10 +391,17 @@ PackagedOperation<Range> operator*(const PackagedOperation<Range> &comp,
         v *= number;
       };
 
-      return_comp.apply_add = [comp, number](Range &v) {
-        v /= number;
-        comp.apply_add(v);
-        v *= number;
+      // scale and add the result of comp with a single vector update,
+      // using a temporary vector kept by the PackagedOperation
+      using TemporaryVector =
+        internal::GrowingVectorMemoryImplementation::TemporaryVector<Range>;
+      const auto storage = std::make_shared<TemporaryVector>();
+
+      return_comp.apply_add = [comp, number, storage](Range &v) {
+        typename TemporaryVector::Pointer i(*storage);
+        comp.reinit_vector(*i, /*bool omit_zeroing_entries =*/true);
+        comp.apply(*i);
+        v.add(number, *i);
       };
     }
 
@@ -735,23 +751,24 @@ operator*(const LinearOperator<Range, Domain, Payload> &op,
   return_comp.reinit_vector = op.reinit_range_vector;
 
   // ensure to have valid PackagedOperation objects by catching op by value
-  // u is caught by reference
+  // u is caught by reference. The intermediate vector is kept by the
+  // PackagedOperation (and shared among its copies).
 
-  return_comp.apply = [op, comp](Domain &v) {
-    GrowingVectorMemory<Range> vector_memory;
+  using TemporaryVector =
+    internal::GrowingVectorMemoryImplementation::TemporaryVector<Domain>;
+  const auto storage = std::make_shared<TemporaryVector>();
 
-    typename VectorMemory<Range>::Pointer i(vector_memory);
+  return_comp.apply = [op, comp, storage](Range &v) {
+    typename TemporaryVector::Pointer i(*storage);
     op.reinit_domain_vector(*i, /*bool omit_zeroing_entries =*/true);
 
     comp.apply(*i);
     op.vmult(v, *i);
   };
 
-  return_comp.apply_add = [op, comp](Domain &v) {
-    GrowingVectorMemory<Range> vector_memory;
-
-    typename VectorMemory<Range>::Pointer i(vector_memory);
-    op.reinit_range_vector(*i, /*bool omit_zeroing_entries =*/true);
+  return_comp.apply_add = [op, comp, storage](Range &v) {
+    typename TemporaryVector::Pointer i(*storage);
+    op.reinit_domain_vector(*i, /*bool omit_zeroing_entries =*/true);
 
     comp.apply(*i);
     op.vmult_add(v, *i);
@@ -774,27 +791,28 @@ PackagedOperation<Domain>
 operator*(const PackagedOperation<Range> &              comp,
           const LinearOperator<Range, Domain, Payload> &op)
 {
-  PackagedOperation<Range> return_comp;
+  PackagedOperation<Domain> return_comp;
 
   return_comp.reinit_vector = op.reinit_domain_vector;
 
   // ensure to have valid PackagedOperation objects by catching op by value
-  // u is caught by reference
+  // u is caught by reference. The intermediate vector is kept by the
+  // PackagedOperation (and shared among its copies).
 
-  return_comp.apply = [op, comp](Domain &v) {
-    GrowingVectorMemory<Range> vector_memory;
+  using TemporaryVector =
+    internal::GrowingVectorMemoryImplementation::TemporaryVector<Range>;
+  const auto storage = std::make_shared<TemporaryVector>();
 
-    typename VectorMemory<Range>::Pointer i(vector_memory);
+  return_comp.apply = [op, comp, storage](Domain &v) {
+    typename TemporaryVector::Pointer i(*storage);
     op.reinit_range_vector(*i, /*bool omit_zeroing_entries =*/true);
 
     comp.apply(*i);
     op.Tvmult(v, *i);
   };
 
-  return_comp.apply_add = [op, comp](Domain &v) {
-    GrowingVectorMemory<Range> vector_memory;
-
-    typename VectorMemory<Range>::Pointer i(vector_memory);
+  return_comp.apply_add = [op, comp, storage](Domain &v) {
+    typename TemporaryVector::Pointer i(*storage);
     op.reinit_range_vector(*i, /*bool omit_zeroing_entries =*/true);
 
     comp.apply(*i);
@@ -22,6 +22,7 @@
 #  ifdef DEAL_II_WITH_PETSC
 
 #    include <deal.II/lac/exceptions.h>
+#    include <deal.II/lac/la_parallel_vector.h>
 
 #    include <petscpc.h>
 
@@ -80,6 +81,16 @@ namespace PETScWrappers
     void
     vmult(VectorBase &dst, const VectorBase &src) const;
 
+    /**
+     * Apply the preconditioner once to the given src vector, where both
+     * vectors are deal.II vectors. PETSc works directly on the locally owned
+     * elements of @p dst and @p src through vector views, i.e., no data is
+     * copied into intermediate PETSc vectors. The ghost elements of the
+     * vectors are not touched.
+     */
+    void
+    vmult(LinearAlgebra::distributed::Vector<PetscScalar> &      dst,
+          const LinearAlgebra::distributed::Vector<PetscScalar> &src) const;
 
     /**
      * Give access to the underlying PETSc object.
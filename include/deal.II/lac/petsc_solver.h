@@ -22,6 +22,7 @@
 #  ifdef DEAL_II_WITH_PETSC
 
 #    include <deal.II/lac/exceptions.h>
+#    include <deal.II/lac/la_parallel_vector.h>
 #    include <deal.II/lac/solver_control.h>
 
 #    include <petscksp.h>
@@ -142,6 +143,18 @@ namespace PETScWrappers
           const VectorBase &        b,
           const PreconditionerBase &preconditioner);
 
+    /**
+     * Solve the linear system <tt>Ax=b</tt> for deal.II vectors. PETSc works
+     * directly on the locally owned elements of @p x and @p b through vector
+     * views, i.e., no data is copied into intermediate PETSc vectors. The
+     * ghost elements of the vectors are not touched. The parallel layout of
+     * the vectors must match the one of the matrix.
+     */
+    void
+    solve(const MatrixBase &                                     A,
+          LinearAlgebra::distributed::Vector<PetscScalar> &      x,
+          const LinearAlgebra::distributed::Vector<PetscScalar> &b,
+          const PreconditionerBase &preconditioner);
 
     /**
      * Resets the contained preconditioner and solver object. See class
@@ -955,6 +968,16 @@ namespace PETScWrappers
     void
     solve(const MatrixBase &A, VectorBase &x, const VectorBase &b);
 
+    /**
+     * The method to solve the linear system for deal.II vectors. As for the
+     * respective function of the base class, the vectors are passed to PETSc
+     * through views of their locally owned elements without copying them.
+     */
+    void
+    solve(const MatrixBase &                                     A,
+          LinearAlgebra::distributed::Vector<PetscScalar> &      x,
+          const LinearAlgebra::distributed::Vector<PetscScalar> &b);
+
     /**
      * The method allows to take advantage if the system matrix is symmetric
      * by using LDL^T decomposition instead of more expensive LU. The argument
@@ -22,6 +22,7 @@
 #  ifdef DEAL_II_WITH_PETSC
 
 #    include <deal.II/base/index_set.h>
+#    include <deal.II/base/memory_space.h>
 #    include <deal.II/base/subscriptor.h>
 
 #    include <deal.II/lac/exceptions.h>
@@ -40,6 +41,15 @@ DEAL_II_NAMESPACE_OPEN
 template <typename number>
 class Vector;
 
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  }
+} // namespace LinearAlgebra
+
 namespace PETScWrappers
 {
   class VectorBase;
@@ -816,6 +826,35 @@ namespace PETScWrappers
 
 
 
+  namespace internal
+  {
+    /**
+     * A PETSc vector that does not own its elements but works directly on
+     * the locally owned elements of a LinearAlgebra::distributed::Vector.
+     * Constructing an object of this class only creates the PETSc vector
+     * header and no data is copied, so it can be used to pass deal.II
+     * vectors to PETSc solvers and preconditioners without the import and
+     * export through intermediate PETSc vectors. All changes of the
+     * elements through this object are directly visible in the deal.II
+     * vector, which must therefore outlive this object. The ghost elements
+     * of the deal.II vector are not part of the view.
+     */
+    class VectorView : public VectorBase
+    {
+    public:
+      /**
+       * Constructor. Create a view of the locally owned elements of @p v
+       * on the MPI communicator of @p v.
+       */
+      explicit VectorView(
+        const LinearAlgebra::distributed::Vector<PetscScalar,
+                                                 ::dealii::MemorySpace::Host>
+          &v);
+    };
+  } // namespace internal
+
+
+
   // ------------------- inline and template functions --------------
 
   /**
@@ -950,7 +950,56 @@ private:
  * AdditionalData::eig_cg_n_iterations to zero, and provide the variable
  * AdditionalData::max_eigenvalue instead. The minimal eigenvalue is
  * implicitly specified via `max_eigenvalue/smoothing_range`.
-
+ *
+ * <h4>Reusing eigenvalue estimates</h4>
+ *
+ * The estimates of the eigenvalues can be obtained from
+ * estimate_eigenvalues() and handed to another object of this class, or to
+ * the same object after a change of the matrix, by the variant of
+ * initialize() that takes an EigenvalueInformation object. This avoids the
+ * CG iteration for operators that share the same spectrum, e.g. on several
+ * multigrid levels of similar meshes, or whose spectrum changes in a known
+ * way, e.g. for the operator $M + \Delta t A$ of an implicit time stepping
+ * scheme upon a change of the time step $\Delta t$, in which case the
+ * estimates can be scaled accordingly before passing them to initialize():
+ * @code
+ * chebyshev.initialize(matrix, additional_data);
+ * const auto eigenvalue_information = chebyshev.estimate_eigenvalues(rhs);
+ * ...
+ * // later, for a matrix with the same spectrum:
+ * chebyshev.initialize(new_matrix, additional_data, eigenvalue_information);
+ * @endcode
+ *
+ * <h4>Fused vector updates</h4>
+ *
+ * In each step of the Chebyshev iteration, the result of the matrix-vector
+ * product is combined with several vectors. For the vectors
+ * dealii::Vector and dealii::LinearAlgebra::distributed::Vector and the
+ * preconditioner DiagonalMatrix, all vector updates of a step are done in a
+ * single sweep through the vectors. If the matrix furthermore provides a
+ * function
+ * @code
+ * void vmult(VectorType &      dst,
+ *            const VectorType &src,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_before_matrix_vector_product,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_after_matrix_vector_product) const;
+ * @endcode
+ * the vector updates are passed to the matrix-vector product, which allows to
+ * perform them on a range of entries right after the matrix-vector product
+ * has computed their final values, while the data is still in cache. The
+ * two functions work on half-open ranges of locally owned entries in
+ * MPI-local numbering. The matrix must call
+ * `operation_before_matrix_vector_product` on each range before it first
+ * accesses the entries of @p dst or @p src in that range, and
+ * `operation_after_matrix_vector_product` on each range after it has
+ * accessed these entries for the last time. The former sets the entries of
+ * @p dst to zero, so the matrix-vector product must add into @p dst. This
+ * interface matches the variant of MatrixFree::cell_loop() with
+ * `operation_before_loop` and `operation_after_loop`, so a matrix-free
+ * operator can forward the two functions directly to that loop.
+ *
  * <h4>Using the PreconditionChebyshev as a solver</h4>
  *
  * If the range <tt>[max_eigenvalue/smoothing_range, max_eigenvalue]</tt>
@@ -1095,6 +1144,44 @@ public:
     std::shared_ptr<PreconditionerType> preconditioner;
   };
 
+  /**
+   * A struct that contains the information about the eigenvalues the
+   * Chebyshev polynomial is built upon, as computed by
+   * estimate_eigenvalues().
+   */
+  struct EigenvalueInformation
+  {
+    /**
+     * Constructor, setting all variables to invalid values.
+     */
+    EigenvalueInformation();
+
+    /**
+     * Estimate of the smallest eigenvalue of the preconditioned matrix.
+     */
+    double min_eigenvalue_estimate;
+
+    /**
+     * Estimate of the largest eigenvalue of the preconditioned matrix. In
+     * case the estimate has been computed by a CG iteration, it includes a
+     * safety factor of 1.2 because the iteration is in general not
+     * converged.
+     */
+    double max_eigenvalue_estimate;
+
+    /**
+     * The number of CG iterations performed to estimate the eigenvalues, or
+     * zero if the eigenvalues have not been computed.
+     */
+    unsigned int cg_iterations;
+
+    /**
+     * The degree of the Chebyshev polynomial, either the one set in
+     * AdditionalData::degree or the one computed as described there.
+     */
+    unsigned int degree;
+  };
+
 
   PreconditionChebyshev();
 
@@ -1113,6 +1200,29 @@ public:
   initialize(const MatrixType &    matrix,
              const AdditionalData &additional_data = AdditionalData());
 
+  /**
+   * Initialize function. Same as above, but instead of estimating the
+   * eigenvalues by a CG iteration, use the given @p eigenvalue_information,
+   * typically obtained from estimate_eigenvalues() for a similar matrix.
+   * The variables AdditionalData::eig_cg_n_iterations and
+   * AdditionalData::max_eigenvalue are ignored in that case.
+   */
+  void
+  initialize(const MatrixType &           matrix,
+             const AdditionalData &       additional_data,
+             const EigenvalueInformation &eigenvalue_information);
+
+  /**
+   * Compute the estimates of the eigenvalues of the preconditioned matrix
+   * that determine the Chebyshev polynomial, using the layout of @p src for
+   * the internal vectors, and return them. If the eigenvalues have already
+   * been computed or given to initialize(), the stored information is
+   * returned. This function is called by the first invocation of vmult(),
+   * Tvmult(), step(), or Tstep() if it has not been called before.
+   */
+  EigenvalueInformation
+  estimate_eigenvalues(const VectorType &src) const;
+
   /**
    * Compute the action of the preconditioner on <tt>src</tt>, storing the
    * result in <tt>dst</tt>.
@@ -1206,6 +1316,17 @@ private:
    */
   bool eigenvalues_are_initialized;
 
+  /**
+   * Stores whether the eigenvalues have been given to initialize() rather
+   * than being computed by estimate_eigenvalues().
+   */
+  bool eigenvalues_are_given;
+
+  /**
+   * The eigenvalue estimates the Chebyshev polynomial is built upon.
+   */
+  EigenvalueInformation eigenvalue_information;
+
   /**
    * A mutex to avoid that multiple vmult() invocations by different threads
    * overwrite the temporary vectors.
@@ -1213,13 +1334,125 @@ private:
   mutable Threads::Mutex mutex;
 
   /**
-   * Initializes the factors theta and delta based on an eigenvalue
-   * computation. If the user set provided values for the largest eigenvalue
-   * in AdditionalData, no computation is performed and the information given
-   * by the user is used.
+   * Initializes the factors theta and delta, and the degree of the
+   * polynomial if it is to be determined automatically, based on the
+   * eigenvalue estimates in @p info.
    */
   void
-  estimate_eigenvalues(const VectorType &src) const;
+  set_polynomial_coefficients(const EigenvalueInformation &info);
+};
+
+
+
+/**
+ * A preconditioner that applies another preconditioner in a different
+ * precision than the one of the outer solver. The typical use case is an
+ * outer Krylov solver such as SolverCG or SolverGMRES working on vectors of
+ * type <tt>LinearAlgebra::distributed::Vector<double></tt> that is
+ * preconditioned by a geometric multigrid V-cycle or a Chebyshev iteration
+ * whose operators and vectors are set up with <tt>float</tt>. As the
+ * preconditioner is typically limited by the memory bandwidth, this roughly
+ * halves its cost, whereas the accuracy of the outer solver is unaffected as
+ * long as the preconditioner is only an approximation anyway.
+ *
+ * In the vmult() function, the source vector is converted to the vector type
+ * @p InnerVectorType of the inner preconditioner, the inner preconditioner is
+ * applied, and the result is converted back. The conversion is done by a
+ * single sweep through the locally owned entries each.
+ * The internal vectors are set up upon the first call to vmult() and
+ * re-initialized whenever the layout of the outer vectors changes.
+ * @code
+ * using VectorType      = LinearAlgebra::distributed::Vector<double>;
+ * using InnerVectorType = LinearAlgebra::distributed::Vector<float>;
+ *
+ * PreconditionChebyshev<LevelMatrixType, InnerVectorType> chebyshev_float;
+ * ... // set up chebyshev_float
+ *
+ * PreconditionMixedPrecision<InnerVectorType,
+ *                            PreconditionChebyshev<LevelMatrixType,
+ *                                                  InnerVectorType>>
+ *   preconditioner(chebyshev_float);
+ * SolverCG<VectorType> cg(solver_control);
+ * cg.solve(system_matrix, solution, system_rhs, preconditioner);
+ * @endcode
+ *
+ * Note that PreconditionMG already performs the conversion between the
+ * outer vector and the (possibly single precision) level vectors within the
+ * transfer class, so it can be passed to an outer double precision solver
+ * directly.
+ *
+ * <h4>Mixed-precision iterative refinement</h4>
+ *
+ * The inner preconditioner can be any object with a
+ * <tt>vmult(InnerVectorType &, const InnerVectorType &)</tt> function,
+ * including an inner single precision solver, e.g., a SolverGMRES wrapped as
+ * an inverse operator. Combined with SolverFGMRES as the outer solver, which
+ * allows for a preconditioner that changes from one iteration to the next,
+ * this gives a mixed-precision iterative refinement scheme: The residual and
+ * the update of the solution are computed in the precision of the outer
+ * solver, whereas the correction is computed in the reduced precision.
+ *
+ * The preconditioner passed to the constructor or initialize() is held by a
+ * pointer, so it needs to persist during the lifetime of this object.
+ */
+template <typename InnerVectorType, typename PreconditionerType>
+class PreconditionMixedPrecision : public Subscriptor
+{
+public:
+  /**
+   * Constructor. Sets the pointer to the inner preconditioner to zero.
+   */
+  PreconditionMixedPrecision();
+
+  /**
+   * Constructor. Calls initialize() with the given argument.
+   */
+  PreconditionMixedPrecision(const PreconditionerType &preconditioner);
+
+  /**
+   * Set the inner preconditioner that is applied in the precision of
+   * @p InnerVectorType.
+   */
+  void
+  initialize(const PreconditionerType &preconditioner);
+
+  /**
+   * Apply the inner preconditioner to @p src and return the result in @p dst,
+   * converting the vectors to and from @p InnerVectorType.
+   */
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Apply the transpose of the inner preconditioner, converting the vectors
+   * to and from @p InnerVectorType.
+   */
+  template <typename VectorType>
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+private:
+  /**
+   * Pointer to the inner preconditioner.
+   */
+  const PreconditionerType *preconditioner;
+
+  /**
+   * Source vector of the inner preconditioner.
+   */
+  mutable InnerVectorType src_inner;
+
+  /**
+   * Destination vector of the inner preconditioner.
+   */
+  mutable InnerVectorType dst_inner;
+
+  /**
+   * A mutex to avoid that multiple vmult() invocations by different threads
+   * overwrite the temporary vectors.
+   */
+  mutable Threads::Mutex mutex;
 };
 
 
@@ -2002,6 +2235,254 @@ namespace internal
         solution.swap(solution_old);
     }
 
+#  ifdef DEAL_II_COMPILER_CUDA_AWARE
+    // kernel doing the same updates as VectorUpdater::apply_to_subrange() on
+    // the device
+    template <typename Number>
+    __global__ void
+    vector_updates_kernel(const unsigned int size,
+                          const Number *     rhs,
+                          const Number *     matrix_diagonal_inverse,
+                          const unsigned int iteration_index,
+                          const Number       factor1,
+                          const Number       factor2,
+                          Number *           solution_old,
+                          Number *           tmp_vector,
+                          Number *           solution)
+    {
+      const unsigned int i = threadIdx.x + blockDim.x * blockIdx.x;
+      if (i < size)
+        {
+          if (iteration_index == 0)
+            solution[i] = factor2 * matrix_diagonal_inverse[i] * rhs[i];
+          else if (iteration_index == 1)
+            tmp_vector[i] =
+              (1. + factor1) * solution[i] +
+              factor2 * matrix_diagonal_inverse[i] * (rhs[i] - tmp_vector[i]);
+          else
+            solution_old[i] =
+              (1. + factor1) * solution[i] - factor1 * solution_old[i] +
+              factor2 * matrix_diagonal_inverse[i] * (rhs[i] - tmp_vector[i]);
+        }
+    }
+
+    // selection for diagonal matrix around parallel deal.II vector on the
+    // device: do all updates of a step in a single kernel rather than in
+    // several calls to vector operations
+    template <typename Number>
+    inline void
+    vector_updates(
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &rhs,
+      const DiagonalMatrix<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>> &jacobi,
+      const unsigned int iteration_index,
+      const double       factor1,
+      const double       factor2,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>
+        &solution_old,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>
+        &temp_vector1,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &solution)
+    {
+      const unsigned int n_local_elements = rhs.local_size();
+      if (n_local_elements > 0)
+        {
+          const int n_blocks =
+            1 + (n_local_elements - 1) / CUDAWrappers::block_size;
+          vector_updates_kernel<Number>
+            <<<n_blocks, CUDAWrappers::block_size>>>(
+              n_local_elements,
+              rhs.get_values(),
+              jacobi.get_vector().get_values(),
+              iteration_index,
+              factor1,
+              factor2,
+              solution_old.get_values(),
+              temp_vector1.get_values(),
+              solution.get_values());
+
+#    ifdef DEBUG
+          // Check that the kernel was launched correctly
+          AssertCuda(cudaGetLastError());
+          // Check that there was no problem during the execution of the
+          // kernel
+          AssertCuda(cudaDeviceSynchronize());
+#    endif
+        }
+
+      // swap vectors x^{n+1}->x^{n}, given the updates in the function above
+      if (iteration_index == 0)
+        {
+          // nothing to do here because we can immediately write into the
+          // solution vector without remembering any of the other vectors
+        }
+      else if (iteration_index == 1)
+        {
+          solution.swap(temp_vector1);
+          solution_old.swap(temp_vector1);
+        }
+      else
+        solution.swap(solution_old);
+    }
+#  endif // DEAL_II_COMPILER_CUDA_AWARE
+
+    // type trait to detect whether the matrix provides a vmult function that
+    // runs two additional operations on ranges of vector entries before and
+    // after the matrix-vector product touches them
+    template <typename MatrixType, typename VectorType>
+    class has_vmult_with_std_functions
+    {
+      template <typename C>
+      static std::false_type
+      test(...);
+
+      template <typename C>
+      static auto
+      test(VectorType *dst, const VectorType *src)
+        -> decltype(std::declval<const C>().vmult(
+                      *dst,
+                      *src,
+                      std::function<void(const unsigned int,
+                                         const unsigned int)>(),
+                      std::function<void(const unsigned int,
+                                         const unsigned int)>()),
+                    std::true_type());
+
+    public:
+      // value is true if the matrix provides the function with the two
+      // additional operations, otherwise false
+      static const bool value = decltype(test<MatrixType>(nullptr,
+                                                          nullptr))::value;
+    };
+
+    // type trait for the vectors that store their locally owned entries
+    // contiguously in memory accessible with begin() and for which the
+    // VectorUpdater can be used
+    template <typename VectorType>
+    struct supports_vector_updater : std::false_type
+    {};
+
+    template <typename Number>
+    struct supports_vector_updater<::dealii::Vector<Number>> : std::true_type
+    {};
+
+    template <typename Number>
+    struct supports_vector_updater<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+      : std::true_type
+    {};
+
+    // type trait to detect whether the vector updates for a DiagonalMatrix
+    // preconditioner are done in a single pass over the vectors by one of
+    // the vector_updates() functions that do not need a second temporary
+    // vector
+    template <typename VectorType>
+    struct has_fused_vector_updates : supports_vector_updater<VectorType>
+    {};
+
+#  ifdef DEAL_II_COMPILER_CUDA_AWARE
+    template <typename Number>
+    struct has_fused_vector_updates<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>>
+      : std::true_type
+    {};
+#  endif
+
+    // compute the matrix-vector product of a step of the Chebyshev iteration
+    // with index iteration_index > 0 and the vector updates of that step.
+    // this is the general case where the two happen one after the other
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    inline typename std::enable_if<
+      !(has_vmult_with_std_functions<MatrixType, VectorType>::value &&
+        supports_vector_updater<VectorType>::value &&
+        std::is_same<PreconditionerType, DiagonalMatrix<VectorType>>::value)>::
+      type
+      vmult_and_update(const MatrixType &        matrix,
+                       const VectorType &        rhs,
+                       const PreconditionerType &preconditioner,
+                       const unsigned int        iteration_index,
+                       const double              factor1,
+                       const double              factor2,
+                       VectorType &              solution_old,
+                       VectorType &              temp_vector1,
+                       VectorType &              temp_vector2,
+                       VectorType &              solution)
+    {
+      Assert(iteration_index > 0, ExcInternalError());
+      matrix.vmult(temp_vector1, solution);
+      vector_updates(rhs,
+                     preconditioner,
+                     iteration_index,
+                     factor1,
+                     factor2,
+                     solution_old,
+                     temp_vector1,
+                     temp_vector2,
+                     solution);
+    }
+
+    // same as above, but for a matrix that can run the vector updates on
+    // ranges of entries as soon as the matrix-vector product has computed
+    // them, while the data is still in cache
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    inline typename std::enable_if<
+      has_vmult_with_std_functions<MatrixType, VectorType>::value &&
+      supports_vector_updater<VectorType>::value &&
+      std::is_same<PreconditionerType, DiagonalMatrix<VectorType>>::value>::
+      type
+      vmult_and_update(const MatrixType &        matrix,
+                       const VectorType &        rhs,
+                       const PreconditionerType &preconditioner,
+                       const unsigned int        iteration_index,
+                       const double              factor1,
+                       const double              factor2,
+                       VectorType &              solution_old,
+                       VectorType &              temp_vector1,
+                       VectorType &,
+                       VectorType &solution)
+    {
+      Assert(iteration_index > 0, ExcInternalError());
+      using Number = typename VectorType::value_type;
+
+      VectorUpdater<Number> updater(rhs.begin(),
+                                    preconditioner.get_vector().begin(),
+                                    iteration_index,
+                                    factor1,
+                                    factor2,
+                                    solution_old.begin(),
+                                    temp_vector1.begin(),
+                                    solution.begin());
+      matrix.vmult(
+        temp_vector1,
+        solution,
+        [&](const unsigned int begin, const unsigned int end) {
+          // the matrix-vector product adds into the destination vector, so
+          // we need to zero the entries before they are first accessed
+          if (end > begin)
+            std::memset(temp_vector1.begin() + begin,
+                        0,
+                        (end - begin) * sizeof(Number));
+        },
+        [&](const unsigned int begin, const unsigned int end) {
+          if (end > begin)
+            updater.apply_to_subrange(begin, end);
+        });
+
+      // swap vectors x^{n+1}->x^{n}, given the updates in the function above
+      if (iteration_index == 1)
+        {
+          solution.swap(temp_vector1);
+          solution_old.swap(temp_vector1);
+        }
+      else
+        solution.swap(solution_old);
+    }
+
     template <typename MatrixType, typename PreconditionerType>
     inline void
     initialize_preconditioner(
@@ -2185,12 +2666,24 @@ inline typename PreconditionChebyshev<MatrixType,
 
 
 
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  EigenvalueInformation::EigenvalueInformation()
+  : min_eigenvalue_estimate(std::numeric_limits<double>::max())
+  , max_eigenvalue_estimate(std::numeric_limits<double>::lowest())
+  , cg_iterations(0)
+  , degree(0)
+{}
+
+
+
 template <typename MatrixType, typename VectorType, typename PreconditionerType>
 inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   PreconditionChebyshev()
   : theta(1.)
   , delta(1.)
   , eigenvalues_are_initialized(false)
+  , eigenvalues_are_given(false)
 {
   static_assert(
     std::is_same<size_type, typename VectorType::size_type>::value,
@@ -2212,6 +2705,24 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::initialize(
   internal::PreconditionChebyshevImplementation::initialize_preconditioner(
     matrix, data.preconditioner);
   eigenvalues_are_initialized = false;
+  eigenvalues_are_given       = false;
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline void
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::initialize(
+  const MatrixType &           matrix,
+  const AdditionalData &       additional_data,
+  const EigenvalueInformation &eigenvalue_information)
+{
+  Assert(eigenvalue_information.max_eigenvalue_estimate >=
+           eigenvalue_information.min_eigenvalue_estimate,
+         ExcMessage("The given eigenvalue information is not valid."));
+  initialize(matrix, additional_data);
+  this->eigenvalue_information = eigenvalue_information;
+  eigenvalues_are_given        = true;
 }
 
 
@@ -2221,6 +2732,7 @@ inline void
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
 {
   eigenvalues_are_initialized = false;
+  eigenvalues_are_given       = false;
   theta = delta = 1.0;
   matrix_ptr    = nullptr;
   {
@@ -2235,11 +2747,15 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
 
 
 template <typename MatrixType, typename VectorType, typename PreconditionerType>
-inline void
+inline typename PreconditionChebyshev<MatrixType,
+                                      VectorType,
+                                      PreconditionerType>::EigenvalueInformation
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   estimate_eigenvalues(const VectorType &src) const
 {
-  Assert(eigenvalues_are_initialized == false, ExcInternalError());
+  if (eigenvalues_are_initialized)
+    return eigenvalue_information;
+
   Assert(data.preconditioner.get() != nullptr, ExcNotInitialized());
 
   solution_old.reinit(src);
@@ -2248,8 +2764,10 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   // calculate largest eigenvalue using a hand-tuned CG iteration on the
   // matrix weighted by its diagonal. we start with a vector that consists of
   // ones only, weighted by the length.
-  double max_eigenvalue, min_eigenvalue;
-  if (data.eig_cg_n_iterations > 0)
+  EigenvalueInformation info;
+  if (eigenvalues_are_given)
+    info = eigenvalue_information;
+  else if (data.eig_cg_n_iterations > 0)
     {
       Assert(data.eig_cg_n_iterations > 2,
              ExcMessage(
@@ -2288,24 +2806,60 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
       catch (SolverControl::NoConvergence &)
         {}
 
+      info.cg_iterations = control.last_step();
+
       // read the eigenvalues from the attached eigenvalue tracker
       if (eigenvalue_tracker.values.empty())
-        min_eigenvalue = max_eigenvalue = 1;
+        info.min_eigenvalue_estimate = info.max_eigenvalue_estimate = 1;
       else
         {
-          min_eigenvalue = eigenvalue_tracker.values.front();
+          info.min_eigenvalue_estimate = eigenvalue_tracker.values.front();
 
           // include a safety factor since the CG method will in general not
           // be converged
-          max_eigenvalue = 1.2 * eigenvalue_tracker.values.back();
+          info.max_eigenvalue_estimate = 1.2 * eigenvalue_tracker.values.back();
         }
     }
   else
     {
-      max_eigenvalue = data.max_eigenvalue;
-      min_eigenvalue = data.max_eigenvalue / data.smoothing_range;
+      info.max_eigenvalue_estimate = data.max_eigenvalue;
+      info.min_eigenvalue_estimate = data.max_eigenvalue / data.smoothing_range;
     }
 
+  const_cast<
+    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
+    ->set_polynomial_coefficients(info);
+
+  // We do not need the second temporary vector in case we have a
+  // DiagonalMatrix as preconditioner and use deal.II's own vectors
+  if (std::is_same<PreconditionerType, DiagonalMatrix<VectorType>>::value ==
+        false ||
+      internal::PreconditionChebyshevImplementation::has_fused_vector_updates<
+        VectorType>::value == false)
+    temp_vector2.reinit(src, true);
+  else
+    {
+      VectorType empty_vector;
+      temp_vector2.reinit(empty_vector);
+    }
+
+  const_cast<
+    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
+    ->eigenvalues_are_initialized = true;
+
+  return eigenvalue_information;
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline void
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  set_polynomial_coefficients(const EigenvalueInformation &info)
+{
+  const double max_eigenvalue = info.max_eigenvalue_estimate;
+  const double min_eigenvalue = info.min_eigenvalue_estimate;
+
   const double alpha = (data.smoothing_range > 1. ?
                           max_eigenvalue / data.smoothing_range :
                           std::min(0.9 * max_eigenvalue, min_eigenvalue));
@@ -2321,46 +2875,17 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
       const double sigma        = (1. - std::sqrt(1. / actual_range)) /
                            (1. + std::sqrt(1. / actual_range));
       const double eps = data.smoothing_range;
-      const_cast<
-        PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(
-        this)
-        ->data.degree =
+      data.degree =
         1 + static_cast<unsigned int>(
               std::log(1. / eps + std::sqrt(1. / eps / eps - 1)) /
               std::log(1. / sigma));
     }
 
-  const_cast<
-    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
-    ->delta = (max_eigenvalue - alpha) * 0.5;
-  const_cast<
-    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
-    ->theta = (max_eigenvalue + alpha) * 0.5;
+  delta = (max_eigenvalue - alpha) * 0.5;
+  theta = (max_eigenvalue + alpha) * 0.5;
 
-  // We do not need the second temporary vector in case we have a
-  // DiagonalMatrix as preconditioner and use deal.II's own vectors
-  using NumberType = typename VectorType::value_type;
-  if (std::is_same<PreconditionerType, DiagonalMatrix<VectorType>>::value ==
-        false ||
-      (std::is_same<VectorType, dealii::Vector<NumberType>>::value == false &&
-       ((std::is_same<VectorType,
-                      LinearAlgebra::distributed::
-                        Vector<NumberType, MemorySpace::Host>>::value ==
-         false) ||
-        (std::is_same<VectorType,
-                      LinearAlgebra::distributed::
-                        Vector<NumberType, MemorySpace::CUDA>>::value ==
-         false))))
-    temp_vector2.reinit(src, true);
-  else
-    {
-      VectorType empty_vector;
-      temp_vector2.reinit(empty_vector);
-    }
-
-  const_cast<
-    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
-    ->eigenvalues_are_initialized = true;
+  eigenvalue_information        = info;
+  eigenvalue_information.degree = data.degree;
 }
 
 
@@ -2394,11 +2919,11 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::vmult(
   double rhok = delta / theta, sigma = theta / delta;
   for (unsigned int k = 0; k < data.degree - 1; ++k)
     {
-      matrix_ptr->vmult(temp_vector1, solution);
       const double rhokp   = 1. / (2. * sigma - rhok);
       const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
       rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
+      internal::PreconditionChebyshevImplementation::vmult_and_update(
+        *matrix_ptr,
         rhs,
         *data.preconditioner,
         k + 1,
@@ -2469,8 +2994,8 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
   if (eigenvalues_are_initialized == false)
     estimate_eigenvalues(rhs);
 
-  matrix_ptr->vmult(temp_vector1, solution);
-  internal::PreconditionChebyshevImplementation::vector_updates(
+  internal::PreconditionChebyshevImplementation::vmult_and_update(
+    *matrix_ptr,
     rhs,
     *data.preconditioner,
     1,
@@ -2487,11 +3012,11 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
   double rhok = delta / theta, sigma = theta / delta;
   for (unsigned int k = 0; k < data.degree - 1; ++k)
     {
-      matrix_ptr->vmult(temp_vector1, solution);
       const double rhokp   = 1. / (2. * sigma - rhok);
       const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
       rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
+      internal::PreconditionChebyshevImplementation::vmult_and_update(
+        *matrix_ptr,
         rhs,
         *data.preconditioner,
         k + 2,
@@ -2575,6 +3100,135 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::n() const
   return matrix_ptr->n();
 }
 
+
+//---------------------------------------------------------------------------
+
+namespace internal
+{
+  namespace PreconditionMixedPrecisionImplementation
+  {
+    // Set up dst with the layout of src unless it already has that layout
+    template <typename VectorType, typename OtherVectorType>
+    void
+    adjust_layout(const OtherVectorType &src, VectorType &dst)
+    {
+      if (dst.size() != src.size())
+        dst.reinit(src, true);
+    }
+
+
+
+    // For the distributed vector, the global size does not determine the
+    // layout, so compare the partitioners instead
+    template <typename Number, typename Number2>
+    void
+    adjust_layout(
+      const LinearAlgebra::distributed::Vector<Number2, MemorySpace::Host>
+        &                                                          src,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &dst)
+    {
+      if (dst.get_partitioner().get() != src.get_partitioner().get() &&
+          dst.get_partitioner()->is_compatible(*src.get_partitioner()) ==
+            false)
+        dst.reinit(src, true);
+    }
+
+
+
+    // Copy the entries of src into dst, setting up dst with the layout of
+    // src if necessary
+    template <typename VectorType, typename OtherVectorType>
+    void
+    convert_vector(const OtherVectorType &src, VectorType &dst)
+    {
+      adjust_layout(src, dst);
+      dst = src;
+    }
+
+
+
+    // For the distributed vector, only copy the locally owned entries in
+    // order to avoid touching the ghost entries
+    template <typename Number, typename Number2>
+    void
+    convert_vector(
+      const LinearAlgebra::distributed::Vector<Number2, MemorySpace::Host>
+        &                                                          src,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &dst)
+    {
+      adjust_layout(src, dst);
+      dst.copy_locally_owned_data_from(src);
+    }
+  } // namespace PreconditionMixedPrecisionImplementation
+} // namespace internal
+
+
+
+template <typename InnerVectorType, typename PreconditionerType>
+inline PreconditionMixedPrecision<InnerVectorType, PreconditionerType>::
+  PreconditionMixedPrecision()
+  : preconditioner(nullptr)
+{}
+
+
+
+template <typename InnerVectorType, typename PreconditionerType>
+inline PreconditionMixedPrecision<InnerVectorType, PreconditionerType>::
+  PreconditionMixedPrecision(const PreconditionerType &preconditioner)
+{
+  initialize(preconditioner);
+}
+
+
+
+template <typename InnerVectorType, typename PreconditionerType>
+inline void
+PreconditionMixedPrecision<InnerVectorType, PreconditionerType>::initialize(
+  const PreconditionerType &preconditioner)
+{
+  this->preconditioner = &preconditioner;
+}
+
+
+
+template <typename InnerVectorType, typename PreconditionerType>
+template <typename VectorType>
+inline void
+PreconditionMixedPrecision<InnerVectorType, PreconditionerType>::vmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  Assert(preconditioner != nullptr, ExcNotInitialized());
+  std::lock_guard<std::mutex> lock(mutex);
+  internal::PreconditionMixedPrecisionImplementation::convert_vector(
+    src, src_inner);
+  internal::PreconditionMixedPrecisionImplementation::adjust_layout(
+    src_inner, dst_inner);
+  preconditioner->vmult(dst_inner, src_inner);
+  internal::PreconditionMixedPrecisionImplementation::convert_vector(dst_inner,
+                                                                     dst);
+}
+
+
+
+template <typename InnerVectorType, typename PreconditionerType>
+template <typename VectorType>
+inline void
+PreconditionMixedPrecision<InnerVectorType, PreconditionerType>::Tvmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  Assert(preconditioner != nullptr, ExcNotInitialized());
+  std::lock_guard<std::mutex> lock(mutex);
+  internal::PreconditionMixedPrecisionImplementation::convert_vector(
+    src, src_inner);
+  internal::PreconditionMixedPrecisionImplementation::adjust_layout(
+    src_inner, dst_inner);
+  preconditioner->Tvmult(dst_inner, src_inner);
+  internal::PreconditionMixedPrecisionImplementation::convert_vector(dst_inner,
+                                                                     dst);
+}
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
@@ -17,6 +17,7 @@
 #define dealii_relaxation_block_templates_h
 
 #include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/full_matrix_batch.h>
 #include <deal.II/lac/relaxation_block.h>
 #include <deal.II/lac/trilinos_vector.h>
 #include <deal.II/lac/vector_memory.h>
@@ -123,6 +124,20 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::block_kernel(
   const MatrixType &            M = *(this->A);
   FullMatrix<InverseNumberType> M_cell;
 
+  // For the Gauss-Jordan method, the inverses of consecutive blocks of the
+  // same size are computed together, with the blocks interleaved over the
+  // lanes of VectorizedArray. This is much faster than inverting the blocks
+  // one by one for the small blocks of typical applications.
+  FullMatrixBatch<InverseNumberType> batch;
+  std::vector<size_type>             blocks_in_batch;
+
+  const auto invert_batch = [&]() {
+    batch.invert();
+    for (unsigned int i = 0; i < blocks_in_batch.size(); ++i)
+      batch.get_matrix(i, this->inverse(blocks_in_batch[i]));
+    blocks_in_batch.clear();
+  };
+
   for (size_type block = block_begin; block < block_end; ++block)
     {
       const size_type bs = this->additional_data->block_list.row_length(block);
@@ -155,8 +170,14 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::block_kernel(
       switch (this->inversion)
         {
           case PreconditionBlockBase<InverseNumberType>::gauss_jordan:
-            this->inverse(block).reinit(bs, bs);
-            this->inverse(block).invert(M_cell);
+            if (!blocks_in_batch.empty() && batch.size() != bs)
+              invert_batch();
+            if (blocks_in_batch.empty())
+              batch.reinit(FullMatrixBatch<InverseNumberType>::n_lanes, bs);
+            batch.set_matrix(blocks_in_batch.size(), M_cell);
+            blocks_in_batch.push_back(block);
+            if (blocks_in_batch.size() == batch.n_matrices())
+              invert_batch();
             break;
           case PreconditionBlockBase<InverseNumberType>::householder:
             this->inverse_householder(block).initialize(M_cell);
@@ -175,6 +196,9 @@ RelaxationBlock<MatrixType, InverseNumberType, VectorType>::block_kernel(
             Assert(false, ExcNotImplemented());
         }
     }
+
+  if (!blocks_in_batch.empty())
+    invert_batch();
 }
 
 namespace internal
@@ -70,6 +70,32 @@ DEAL_II_NAMESPACE_OPEN
  *
  * @image html scalapack_invert.png
  *
+ * <h3>Asynchronous operations</h3>
+ *
+ * The factorizations, the matrix-matrix multiplication, and the symmetric
+ * eigensolver are also provided as functions with the suffix
+ * <tt>_async</tt>, e.g., compute_cholesky_factorization_async(). They run
+ * the same ScaLAPACK routines on a Threads::Task and return immediately, so
+ * that the dense operation overlaps with other work of the calling thread,
+ * such as the assembly of the next block of a subspace or matrix-vector
+ * products with a sparse or matrix-free operator:
+ * @code
+ *   Threads::Task<std::vector<double>> eigenvalues =
+ *     projected_matrix.eigenpairs_symmetric_by_index_MRRR_async(
+ *       std::make_pair(0, n - 1), true);
+ *   ... // other, purely local work
+ *   const std::vector<double> &lambda = eigenvalues.return_value();
+ * @endcode
+ * All processes of the process grid need to create the task, since the
+ * ScaLAPACK routines involve collective communication. The matrices
+ * involved must neither be accessed nor destroyed until the task has
+ * finished, which is ensured by Threads::Task::join() or
+ * Threads::Task::return_value(). Since MPI is initialized with
+ * <tt>MPI_THREAD_SERIALIZED</tt> by Utilities::MPI::MPI_InitFinalize, the
+ * calling thread must not communicate via MPI while the task is running.
+ * If only one thread is available, see MultithreadInfo::n_threads(), the
+ * operation is performed before the function returns.
+ *
  * @ingroup Matrix1
  * @author Denis Davydov, Benjamin Brands, 2017
  */
@@ -576,6 +602,40 @@ public:
     const std::pair<NumberType, NumberType> &value_limits,
     const bool                               compute_eigenvectors);
 
+  /**
+   * Start compute_cholesky_factorization() on a separate task. See the
+   * section on asynchronous operations in the documentation of this class.
+   */
+  Threads::Task<void>
+  compute_cholesky_factorization_async();
+
+  /**
+   * Start compute_lu_factorization() on a separate task. See the section on
+   * asynchronous operations in the documentation of this class.
+   */
+  Threads::Task<void>
+  compute_lu_factorization_async();
+
+  /**
+   * Start mmult() on a separate task. See the section on asynchronous
+   * operations in the documentation of this class. The matrices @p C and
+   * @p B must stay alive until the task has finished.
+   */
+  Threads::Task<void>
+  mmult_async(ScaLAPACKMatrix<NumberType> &      C,
+              const ScaLAPACKMatrix<NumberType> &B,
+              const bool                         adding = false) const;
+
+  /**
+   * Start eigenpairs_symmetric_by_index_MRRR() on a separate task, whose
+   * return value holds the eigenvalues. See the section on asynchronous
+   * operations in the documentation of this class.
+   */
+  Threads::Task<std::vector<NumberType>>
+  eigenpairs_symmetric_by_index_MRRR_async(
+    const std::pair<unsigned int, unsigned int> &index_limits,
+    const bool                                   compute_eigenvectors);
+
   /**
    * Computing the singular value decomposition (SVD) of a
    * matrix $\mathbf{A} \in \mathbb{R}^{M \times N}$, optionally computing the
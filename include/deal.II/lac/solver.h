@@ -26,6 +26,8 @@
 // Ignore deprecation warnings for auto_ptr.
 #include <boost/signals2.hpp>
 
+#include <chrono>
+
 DEAL_II_NAMESPACE_OPEN
 
 // Forward declaration
@@ -409,7 +411,34 @@ protected:
    */
   VectorMemory<VectorType> &memory;
 
+  /**
+   * Reset the statistics of the SolverControl object given to the
+   * constructor if their collection is enabled. Solvers that collect
+   * statistics call this function at the beginning of each solve.
+   */
+  void
+  reset_statistics() const;
+
+  /**
+   * Execute @p function, which performs an operation of type @p operation
+   * estimated to transfer @p bytes bytes from and to memory. If the
+   * collection of statistics is enabled in the SolverControl object given to
+   * the constructor, the time spent in @p function is recorded, and the
+   * function is simply called otherwise.
+   */
+  template <typename Function>
+  void
+  measure(const SolverStatistics::Operation operation,
+          const double                      bytes,
+          const Function &                  function) const;
+
 private:
+  /**
+   * A pointer to the control object given to the constructor, used for the
+   * collection of statistics.
+   */
+  SolverControl *control;
+
   /**
    * A class whose operator() combines two states indicating whether we should
    * continue iterating or stop, and returns a state that dominates. The rules
@@ -518,6 +547,7 @@ inline SolverBase<VectorType>::SolverBase(
   SolverControl &           solver_control,
   VectorMemory<VectorType> &vector_memory)
   : memory(vector_memory)
+  , control(&solver_control)
 {
   // connect the solver control object to the signal. SolverControl::check
   // only takes two arguments, the iteration and the check_value, and so
@@ -535,6 +565,7 @@ template <class VectorType>
 inline SolverBase<VectorType>::SolverBase(SolverControl &solver_control)
   : // use the static memory object this class owns
   memory(static_vector_memory)
+  , control(&solver_control)
 {
   // connect the solver control object to the signal. SolverControl::check
   // only takes two arguments, the iteration and the check_value, and so
@@ -548,6 +579,38 @@ inline SolverBase<VectorType>::SolverBase(SolverControl &solver_control)
 
 
 
+template <class VectorType>
+inline void
+SolverBase<VectorType>::reset_statistics() const
+{
+  if (control->statistics_enabled())
+    control->get_statistics().reset();
+}
+
+
+
+template <class VectorType>
+template <typename Function>
+inline void
+SolverBase<VectorType>::measure(const SolverStatistics::Operation operation,
+                                const double                      bytes,
+                                const Function &function) const
+{
+  if (!control->statistics_enabled())
+    {
+      function();
+      return;
+    }
+
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const std::chrono::duration<double> time =
+    std::chrono::steady_clock::now() - start;
+  control->get_statistics().add(operation, time.count(), bytes);
+}
+
+
+
 template <class VectorType>
 inline boost::signals2::connection
 SolverBase<VectorType>::connect(
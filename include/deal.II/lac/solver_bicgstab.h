@@ -340,9 +340,19 @@ SolverBicgstab<VectorType>::criterion(const MatrixType &A,
                                       const VectorType &x,
                                       const VectorType &b)
 {
-  A.vmult(*Vt, x);
-  Vt->add(-1., b);
-  res = Vt->l2_norm();
+  // the estimated number of bytes of one vector for the statistics
+  const double vector_bytes =
+    static_cast<double>(x.size()) * sizeof(typename VectorType::value_type);
+
+  this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+    A.vmult(*Vt, x);
+  });
+  this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+    Vt->add(-1., b);
+  });
+  this->measure(SolverStatistics::reduction, vector_bytes, [&]() {
+    res = Vt->l2_norm();
+  });
 
   return res;
 }
@@ -354,9 +364,18 @@ template <typename MatrixType>
 SolverControl::State
 SolverBicgstab<VectorType>::start(const MatrixType &A)
 {
-  A.vmult(*Vr, *Vx);
-  Vr->sadd(-1., 1., *Vb);
-  res = Vr->l2_norm();
+  const double vector_bytes =
+    static_cast<double>(Vx->size()) * sizeof(typename VectorType::value_type);
+
+  this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+    A.vmult(*Vr, *Vx);
+  });
+  this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+    Vr->sadd(-1., 1., *Vb);
+  });
+  this->measure(SolverStatistics::reduction, vector_bytes, [&]() {
+    res = Vr->l2_norm();
+  });
 
   return this->iteration_status(step, res, *Vx);
 }
@@ -392,30 +411,49 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
   VectorType &t    = *Vt;
   VectorType &v    = *Vv;
 
-  rbar         = r;
+  const double vector_bytes =
+    static_cast<double>(r.size()) * sizeof(typename VectorType::value_type);
+
+  this->measure(SolverStatistics::vector_update, 2. * vector_bytes, [&]() {
+    rbar = r;
+  });
   bool startup = true;
 
   do
     {
       ++step;
 
-      rhobar = r * rbar;
-      beta   = rhobar * alpha / (rho * omega);
-      rho    = rhobar;
+      this->measure(SolverStatistics::reduction, 2. * vector_bytes, [&]() {
+        rhobar = r * rbar;
+      });
+      beta = rhobar * alpha / (rho * omega);
+      rho  = rhobar;
       if (startup == true)
         {
-          p       = r;
+          this->measure(SolverStatistics::vector_update,
+                        2. * vector_bytes,
+                        [&]() { p = r; });
           startup = false;
         }
       else
         {
-          p.sadd(beta, 1., r);
-          p.add(-beta * omega, v);
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { p.sadd(beta, 1., r); });
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { p.add(-beta * omega, v); });
         }
 
-      preconditioner.vmult(y, p);
-      A.vmult(v, y);
-      rhobar = rbar * v;
+      this->measure(SolverStatistics::preconditioner_application, 0., [&]() {
+        preconditioner.vmult(y, p);
+      });
+      this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+        A.vmult(v, y);
+      });
+      this->measure(SolverStatistics::reduction, 2. * vector_bytes, [&]() {
+        rhobar = rbar * v;
+      });
 
       alpha = rho / rhobar;
 
@@ -424,7 +462,9 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
       if (std::fabs(alpha) > 1.e10)
         return IterationResult(true, state, step, res);
 
-      res = std::sqrt(r.add_and_dot(-alpha, v, r));
+      this->measure(SolverStatistics::reduction, 3. * vector_bytes, [&]() {
+        res = std::sqrt(r.add_and_dot(-alpha, v, r));
+      });
 
       // check for early success, see the lac/bicgstab_early testcase as to
       // why this is necessary
@@ -434,24 +474,40 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
       // will be x=*Vx + alpha*y
       if (this->iteration_status(step, res, *Vx) == SolverControl::success)
         {
-          Vx->add(alpha, y);
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { Vx->add(alpha, y); });
           print_vectors(step, *Vx, r, y);
           return IterationResult(false, SolverControl::success, step, res);
         }
 
-      preconditioner.vmult(z, r);
-      A.vmult(t, z);
-      rhobar = t * r;
-      omega  = rhobar / (t * t);
-      Vx->add(alpha, y, omega, z);
+      this->measure(SolverStatistics::preconditioner_application, 0., [&]() {
+        preconditioner.vmult(z, r);
+      });
+      this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+        A.vmult(t, z);
+      });
+      this->measure(SolverStatistics::reduction, 2. * vector_bytes, [&]() {
+        rhobar = t * r;
+      });
+      this->measure(SolverStatistics::reduction, vector_bytes, [&]() {
+        omega = rhobar / (t * t);
+      });
+      this->measure(SolverStatistics::vector_update, 4. * vector_bytes, [&]() {
+        Vx->add(alpha, y, omega, z);
+      });
 
       if (additional_data.exact_residual)
         {
-          r.add(-omega, t);
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { r.add(-omega, t); });
           res = criterion(A, *Vx, *Vb);
         }
       else
-        res = std::sqrt(r.add_and_dot(-omega, t, r));
+        this->measure(SolverStatistics::reduction, 3. * vector_bytes, [&]() {
+          res = std::sqrt(r.add_and_dot(-omega, t, r));
+        });
 
       state = this->iteration_status(step, res, *Vx);
       print_vectors(step, *Vx, r, y);
@@ -470,6 +526,7 @@ SolverBicgstab<VectorType>::solve(const MatrixType &        A,
                                   const PreconditionerType &preconditioner)
 {
   LogStream::Prefix prefix("Bicgstab");
+  this->reset_statistics();
   Vr    = typename VectorMemory<VectorType>::Pointer(this->memory);
   Vrbar = typename VectorMemory<VectorType>::Pointer(this->memory);
   Vp    = typename VectorMemory<VectorType>::Pointer(this->memory);
@@ -21,19 +21,34 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
 
+#include <array>
 #include <cmath>
+#include <type_traits>
 
 DEAL_II_NAMESPACE_OPEN
 
 // forward declaration
 #ifndef DOXYGEN
 class PreconditionIdentity;
+namespace MemorySpace
+{
+  struct Host;
+}
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
 #endif
 
 
@@ -234,6 +249,90 @@ protected:
     all_eigenvalues_signal;
 };
 
+
+
+
+/**
+ * This class implements a pipelined variant of the preconditioned Conjugate
+ * Gradients method according to P. Ghysels and W. Vanroose: "Hiding global
+ * synchronization latency in the preconditioned Conjugate Gradient
+ * algorithm", Parallel Computing 40 (2014), pp. 224-238. The method is
+ * mathematically equivalent to SolverCG, but reorganizes the iteration such
+ * that the three inner products needed per iteration (the two for the
+ * coefficients alpha and beta as well as the one for the residual norm used
+ * to check convergence) can be combined into a single global reduction. This
+ * reduction is overlapped with one application of the preconditioner and one
+ * matrix-vector product, hiding the latency of the global communication.
+ *
+ * For vectors of type LinearAlgebra::distributed::Vector, the three inner
+ * products are computed in a single sweep through the vector entries and
+ * then combined with a single non-blocking <code>MPI_Iallreduce</code> call,
+ * which is completed after the preconditioner and the matrix-vector product
+ * have been applied. For all other vector types, the inner products are
+ * computed by the usual functions of the vector class, thus without
+ * overlap, but still following the algorithmic structure described above.
+ *
+ * The price for the overlap are four additional vector updates per
+ * iteration and a total of nine auxiliary vectors as opposed to three for
+ * SolverCG, as well as a somewhat reduced numerical stability due to the
+ * additional recurrences. The method therefore pays off when the global
+ * reductions are expensive, i.e., for large numbers of MPI ranks with
+ * relatively few unknowns per rank.
+ *
+ * The preconditioner must be symmetric, as for SolverCG. The coefficients
+ * of the underlying Lanczos process, and hence the eigenvalue and condition
+ * number estimates, are available through the slots of the SolverCG base
+ * class.
+ *
+ * @note The residual used for checking convergence is the norm of the
+ * unpreconditioned residual vector as computed by the recurrences of the
+ * method, like in SolverCG.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipelinedCG : public SolverCG<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver, the same
+   * as for SolverCG.
+   */
+  using AdditionalData = typename SolverCG<VectorType>::AdditionalData;
+
+  /**
+   * Constructor.
+   */
+  SolverPipelinedCG(SolverControl &           cn,
+                    VectorMemory<VectorType> &mem,
+                    const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipelinedCG(SolverControl &       cn,
+                    const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverPipelinedCG() override = default;
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+};
+
 /*@}*/
 
 /*------------------------- Implementation ----------------------------*/
@@ -329,10 +428,11 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
   LogStream::Prefix prefix("cg");
 
-  // Memory allocation
-  typename VectorMemory<VectorType>::Pointer g_pointer(this->memory);
-  typename VectorMemory<VectorType>::Pointer d_pointer(this->memory);
-  typename VectorMemory<VectorType>::Pointer h_pointer(this->memory);
+  // Memory allocation. the vectors have the layout of x, but their values
+  // are not set since they'd be overwritten soon anyway.
+  typename VectorMemory<VectorType>::Pointer g_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer d_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer h_pointer(this->memory, x);
 
   // define some aliases for simpler access
   VectorType &g = *g_pointer;
@@ -354,26 +454,31 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
   typename VectorType::value_type eigen_beta_alpha = 0;
 
-  // resize the vectors, but do not set
-  // the values since they'd be overwritten
-  // soon anyway.
-  g.reinit(x, true);
-  d.reinit(x, true);
-  h.reinit(x, true);
-
   number gh, beta;
 
+  // the estimated number of bytes of one vector for the statistics
+  this->reset_statistics();
+  const double vector_bytes = static_cast<double>(x.size()) * sizeof(number);
+
   // compute residual. if vector is
   // zero, then short-circuit the
   // full computation
   if (!x.all_zero())
     {
-      A.vmult(g, x);
-      g.add(-1., b);
+      this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+        A.vmult(g, x);
+      });
+      this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+        g.add(-1., b);
+      });
     }
   else
-    g.equ(-1., b);
-  res = g.l2_norm();
+    this->measure(SolverStatistics::vector_update, 2. * vector_bytes, [&]() {
+      g.equ(-1., b);
+    });
+  this->measure(SolverStatistics::reduction, vector_bytes, [&]() {
+    res = g.l2_norm();
+  });
 
   conv = this->iteration_status(0, res, x);
   if (conv != SolverControl::iterate)
@@ -381,29 +486,46 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
   if (std::is_same<PreconditionerType, PreconditionIdentity>::value == false)
     {
-      preconditioner.vmult(h, g);
+      this->measure(SolverStatistics::preconditioner_application, 0., [&]() {
+        preconditioner.vmult(h, g);
+      });
 
-      d.equ(-1., h);
+      this->measure(SolverStatistics::vector_update, 2. * vector_bytes, [&]() {
+        d.equ(-1., h);
+      });
 
-      gh = g * h;
+      this->measure(SolverStatistics::reduction, 2. * vector_bytes, [&]() {
+        gh = g * h;
+      });
     }
   else
     {
-      d.equ(-1., g);
+      this->measure(SolverStatistics::vector_update, 2. * vector_bytes, [&]() {
+        d.equ(-1., g);
+      });
       gh = res * res;
     }
 
   while (conv == SolverControl::iterate)
     {
       it++;
-      A.vmult(h, d);
-
-      number alpha = d * h;
+      this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+        A.vmult(h, d);
+      });
+
+      number alpha = 0;
+      this->measure(SolverStatistics::reduction, 2. * vector_bytes, [&]() {
+        alpha = d * h;
+      });
       Assert(std::abs(alpha) != 0., ExcDivideByZero());
       alpha = gh / alpha;
 
-      x.add(alpha, d);
-      res = std::sqrt(std::abs(g.add_and_dot(alpha, h, g)));
+      this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+        x.add(alpha, d);
+      });
+      this->measure(SolverStatistics::reduction, 3. * vector_bytes, [&]() {
+        res = std::sqrt(std::abs(g.add_and_dot(alpha, h, g)));
+      });
 
       print_vectors(it, x, g, d);
 
@@ -414,20 +536,28 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
       if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
           false)
         {
-          preconditioner.vmult(h, g);
+          this->measure(SolverStatistics::preconditioner_application,
+                        0.,
+                        [&]() { preconditioner.vmult(h, g); });
 
           beta = gh;
           Assert(std::abs(beta) != 0., ExcDivideByZero());
-          gh   = g * h;
+          this->measure(SolverStatistics::reduction,
+                        2. * vector_bytes,
+                        [&]() { gh = g * h; });
           beta = gh / beta;
-          d.sadd(beta, -1., h);
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { d.sadd(beta, -1., h); });
         }
       else
         {
           beta = gh;
           gh   = res * res;
           beta = gh / beta;
-          d.sadd(beta, -1., g);
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { d.sadd(beta, -1., g); });
         }
 
       this->coefficients_signal(alpha, beta);
@@ -460,6 +590,309 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
 
 
+namespace internal
+{
+  namespace SolverCGImplementation
+  {
+    /**
+     * Compute the three inner products $(r,u)$, $(w,u)$ and $(r,r)$ needed
+     * by SolverPipelinedCG. The computation is split into a start() and a
+     * finish() function, which allows other work to be performed while the
+     * global communication is in flight. This general version computes the
+     * inner products by the functions of the vector class upon start().
+     */
+    template <typename VectorType>
+    class PipelinedInnerProducts
+    {
+    public:
+      using value_type = typename VectorType::value_type;
+
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        values[0] = r * u;
+        values[1] = w * u;
+        values[2] = r * r;
+      }
+
+      const std::array<value_type, 3> &
+      finish()
+      {
+        return values;
+      }
+
+    private:
+      std::array<value_type, 3> values;
+    };
+
+
+
+    /**
+     * Specialization for LinearAlgebra::distributed::Vector which computes
+     * the three inner products in a single sweep through the locally owned
+     * vector entries and then combines the results via one non-blocking
+     * global reduction.
+     */
+    template <typename Number>
+    class PipelinedInnerProducts<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+    {
+    public:
+      using value_type = Number;
+
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        AssertDimension(r.local_size(), u.local_size());
+        AssertDimension(r.local_size(), w.local_size());
+
+        const Number *    r_ptr = r.begin();
+        const Number *    u_ptr = u.begin();
+        const Number *    w_ptr = w.begin();
+        const std::size_t size  = r.local_size();
+        Number            ru = Number(), wu = Number(), rr = Number();
+        for (std::size_t i = 0; i < size; ++i)
+          {
+            const Number u_conj = numbers::NumberTraits<Number>::conjugate(
+              u_ptr[i]);
+            ru += r_ptr[i] * u_conj;
+            wu += w_ptr[i] * u_conj;
+            rr += r_ptr[i] *
+                  numbers::NumberTraits<Number>::conjugate(r_ptr[i]);
+          }
+        values[0] = ru;
+        values[1] = wu;
+        values[2] = rr;
+
+#ifdef DEAL_II_WITH_MPI
+        communicator = r.get_mpi_communicator();
+        if (Utilities::MPI::job_supports_mpi() &&
+            Utilities::MPI::n_mpi_processes(communicator) > 1)
+          {
+            // sum up the real and imaginary parts separately, which avoids
+            // the need for an MPI data type for complex numbers
+            using real_type = typename numbers::NumberTraits<Number>::real_type;
+            static_assert(std::is_same<real_type, double>::value ||
+                            std::is_same<real_type, float>::value,
+                          "Unsupported number type");
+            const int ierr = MPI_Iallreduce(
+              MPI_IN_PLACE,
+              values.data(),
+              3 * sizeof(Number) / sizeof(real_type),
+              std::is_same<real_type, double>::value ? MPI_DOUBLE : MPI_FLOAT,
+              MPI_SUM,
+              communicator,
+              &request);
+            AssertThrowMPI(ierr);
+            request_is_active = true;
+          }
+#endif
+      }
+
+      const std::array<Number, 3> &
+      finish()
+      {
+#ifdef DEAL_II_WITH_MPI
+        if (request_is_active)
+          {
+            const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+            request_is_active = false;
+          }
+#endif
+        return values;
+      }
+
+    private:
+      std::array<Number, 3> values;
+
+#ifdef DEAL_II_WITH_MPI
+      MPI_Comm    communicator;
+      MPI_Request request;
+      bool        request_is_active = false;
+#endif
+    };
+  } // namespace SolverCGImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &           cn,
+                                                 VectorMemory<VectorType> &mem,
+                                                 const AdditionalData &data)
+  : SolverCG<VectorType>(cn, mem, data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &       cn,
+                                                 const AdditionalData &data)
+  : SolverCG<VectorType>(cn, data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipelinedCG<VectorType>::solve(const MatrixType &        A,
+                                     VectorType &              x,
+                                     const VectorType &        b,
+                                     const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipelined_cg");
+
+  // Memory allocation. the vectors have the layout of x, but their values
+  // are not set since they'd be overwritten soon anyway.
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory, x);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory, x);
+
+  // define some aliases for simpler access, using the notation of the paper
+  // by Ghysels and Vanroose: r is the residual, u the preconditioned
+  // residual, w = A u, m = P w, n = A m, and p, s, q, z are the search
+  // direction and its images under the recurrences s = A p, q = P s, z = A q
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &z = *z_pointer;
+
+  // Should we build the matrix for eigenvalue computations?
+  const bool do_eigenvalues = !this->condition_number_signal.empty() ||
+                              !this->all_condition_numbers_signal.empty() ||
+                              !this->eigenvalues_signal.empty() ||
+                              !this->all_eigenvalues_signal.empty();
+
+  // vectors used for eigenvalue computations
+  std::vector<number> diagonal;
+  std::vector<number> offdiagonal;
+  number              eigen_beta_alpha = 0;
+
+  int    it  = 0;
+  double res = -std::numeric_limits<double>::max();
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r = b;
+  res = r.l2_norm();
+
+  conv = this->iteration_status(0, res, x);
+  if (conv != SolverControl::iterate)
+    return;
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  internal::SolverCGImplementation::PipelinedInnerProducts<VectorType>
+    inner_products;
+
+  number alpha = 0, beta = 0, gamma_old = 0;
+
+  while (conv == SolverControl::iterate)
+    {
+      // start the global reduction and overlap it with the preconditioner
+      // and the matrix-vector product
+      inner_products.start(r, u, w);
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+      const std::array<number, 3> &products = inner_products.finish();
+
+      const number gamma = products[0];
+      const number delta = products[1];
+
+      if (it > 0)
+        {
+          res  = std::sqrt(std::abs(products[2]));
+          conv = this->iteration_status(it, res, x);
+          if (conv != SolverControl::iterate)
+            break;
+
+          Assert(std::abs(gamma_old) != 0., ExcDivideByZero());
+          beta = gamma / gamma_old;
+
+          this->coefficients_signal(alpha, beta);
+          // set up the vectors containing the diagonal and the off diagonal
+          // of the projected matrix.
+          if (do_eigenvalues)
+            {
+              diagonal.push_back(number(1.) / alpha + eigen_beta_alpha);
+              eigen_beta_alpha = beta / alpha;
+              offdiagonal.push_back(std::sqrt(beta) / alpha);
+            }
+          this->compute_eigs_and_cond(diagonal,
+                                      offdiagonal,
+                                      this->all_eigenvalues_signal,
+                                      this->all_condition_numbers_signal);
+
+          const number denominator = delta - beta * gamma / alpha;
+          Assert(std::abs(denominator) != 0., ExcDivideByZero());
+          alpha = gamma / denominator;
+
+          z.sadd(beta, 1., n);
+          q.sadd(beta, 1., m);
+          s.sadd(beta, 1., w);
+          p.sadd(beta, 1., u);
+        }
+      else
+        {
+          Assert(std::abs(delta) != 0., ExcDivideByZero());
+          alpha = gamma / delta;
+
+          z = n;
+          q = m;
+          s = w;
+          p = u;
+        }
+      gamma_old = gamma;
+
+      x.add(alpha, p);
+      r.add(-alpha, s);
+      u.add(-alpha, q);
+      w.add(-alpha, z);
+
+      it++;
+      this->print_vectors(it, x, r, p);
+    }
+
+  this->compute_eigs_and_cond(diagonal,
+                              offdiagonal,
+                              this->eigenvalues_signal,
+                              this->condition_number_signal);
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+
+
 template <typename VectorType>
 boost::signals2::connection
 SolverCG<VectorType>::connect_coefficients_slot(
@@ -21,6 +21,8 @@
 
 #include <deal.II/base/subscriptor.h>
 
+#include <array>
+#include <ostream>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -32,6 +34,119 @@ class ParameterHandler;
 /*!@addtogroup Solvers */
 /*@{*/
 
+/**
+ * A class that collects the number of calls, the time spent, and an
+ * estimate of the memory traffic of the basic operations of an iterative
+ * solver, namely matrix-vector products, applications of the
+ * preconditioner, reductions like inner products and norms, and vector
+ * updates. Comparing the time per reduction with the time per vector update
+ * allows determining whether a solver is limited by the latency of global
+ * communication rather than by the memory bandwidth.
+ *
+ * The statistics are collected by the solvers if enabled by
+ * SolverControl::enable_statistics(), and are reset at the beginning of
+ * each solve. They are collected by SolverCG, SolverGMRES, SolverFGMRES,
+ * SolverBicgstab, and SolverMinRes; the other solvers leave them
+ * untouched. SolverGMRES and SolverFGMRES record the orthogonalization of
+ * each new basis vector against the previous ones as a single reduction.
+ * The bytes of reductions and vector updates are estimated
+ * from the size of the vectors, i.e., summed over all processes for
+ * parallel vectors. The memory traffic of matrix-vector products and
+ * preconditioners depends on their implementation and is not estimated.
+ */
+class SolverStatistics
+{
+public:
+  /**
+   * The operations distinguished by this class.
+   */
+  enum Operation
+  {
+    /**
+     * Products of the system matrix with a vector.
+     */
+    matrix_vector_product,
+    /**
+     * Applications of the preconditioner.
+     */
+    preconditioner_application,
+    /**
+     * Inner products and norms, including vector updates fused with an
+     * inner product.
+     */
+    reduction,
+    /**
+     * Vector updates without a reduction.
+     */
+    vector_update,
+    /**
+     * The number of operations.
+     */
+    n_operations
+  };
+
+  /**
+   * Constructor. Sets all statistics to zero.
+   */
+  SolverStatistics();
+
+  /**
+   * Set all statistics to zero.
+   */
+  void
+  reset();
+
+  /**
+   * Record a call of @p operation that took @p time seconds and is
+   * estimated to have transferred @p bytes bytes from and to memory.
+   */
+  void
+  add(const Operation operation, const double time, const double bytes);
+
+  /**
+   * Return the number of recorded calls of @p operation.
+   */
+  unsigned long int
+  n_calls(const Operation operation) const;
+
+  /**
+   * Return the accumulated time in seconds of all calls of @p operation.
+   */
+  double
+  time(const Operation operation) const;
+
+  /**
+   * Return the estimated accumulated number of bytes transferred by all
+   * calls of @p operation.
+   */
+  double
+  bytes(const Operation operation) const;
+
+  /**
+   * Print a table with the statistics of all operations to @p out.
+   */
+  void
+  print(std::ostream &out) const;
+
+private:
+  /**
+   * The number of calls of each operation.
+   */
+  std::array<unsigned long int, n_operations> calls;
+
+  /**
+   * The accumulated time of each operation.
+   */
+  std::array<double, n_operations> times;
+
+  /**
+   * The estimated number of bytes transferred by each operation.
+   */
+  std::array<double, n_operations> transferred_bytes;
+};
+
+
+
 /**
  * Control class to determine convergence of iterative solvers.
  *
@@ -268,6 +383,34 @@ public:
   const std::vector<double> &
   get_history_data() const;
 
+  /**
+   * Enables or disables the collection of statistics about the operations
+   * performed by the solvers, see SolverStatistics. Currently, the
+   * statistics are collected by SolverCG, SolverGMRES, SolverFGMRES,
+   * SolverBicgstab, and SolverMinRes.
+   */
+  void
+  enable_statistics(const bool enable = true);
+
+  /**
+   * Return whether the collection of statistics is enabled.
+   */
+  bool
+  statistics_enabled() const;
+
+  /**
+   * Return the statistics collected during the last solve.
+   */
+  const SolverStatistics &
+  get_statistics() const;
+
+  /**
+   * Return the statistics collected during the last solve. This function is
+   * used by the solvers to record their operations.
+   */
+  SolverStatistics &
+  get_statistics();
+
   /**
    * Average error reduction over all steps.
    *
@@ -408,6 +551,16 @@ protected:
    * Use of this vector is enabled by enable_history_data().
    */
   std::vector<double> history_data;
+
+  /**
+   * Control over the collection of statistics. Set by enable_statistics().
+   */
+  bool statistics_data_enabled;
+
+  /**
+   * The statistics about the operations performed during the last solve.
+   */
+  SolverStatistics statistics;
 };
 
 
@@ -0,0 +1,629 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_gcrodr_h
+#define dealii_solver_gcrodr_h
+
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/logstream.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/householder.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * Implementation of the restarted GMRES method with deflated restarting and
+ * recycling of a subspace between subsequent solves, known as GCRO-DR (M. L.
+ * Parks, E. de Sturler, G. Mackey, D. D. Johnson, S. Maiti: Recycling Krylov
+ * subspaces for sequences of linear systems, SIAM J. Sci. Comput. 28, pp.
+ * 1651-1674, 2006).
+ *
+ * Restarted GMRES discards the Krylov space at every restart and at the end
+ * of every solve, and thus has to rebuild the information about the parts of
+ * the spectrum that slow down the convergence, typically the eigenvalues
+ * closest to zero. This solver instead retains a space $U_k$ of dimension
+ * $k$ spanned by approximate eigenvectors to the smallest eigenvalues,
+ * namely harmonic Ritz vectors. At the beginning of each solve, the solution
+ * is first improved by the least-squares solution in $U_k$, and the
+ * subsequent Arnoldi iterations are done on the operator projected onto the
+ * orthogonal complement of the space $C_k = A U_k$, which deflates the
+ * eigenvalues captured by $U_k$. The space $U_k$ is updated with the new
+ * Krylov vectors on every restart and kept in the solver object after
+ * solve() returns, so that the next call to solve() starts from it. This
+ * makes the method particularly effective for sequences of linear systems
+ * with slowly changing matrices and right hand sides such as those arising
+ * in Newton or time stepping schemes, where it typically needs considerably
+ * fewer iterations than restarted GMRES. For the first solve, the method is
+ * equivalent to GMRES with deflated restarting. For changing matrices, the
+ * space $C_k$ is recomputed from the recycled space $U_k$ and the current
+ * matrix at the beginning of each solve, which costs $k$ matrix-vector
+ * products and applications of the preconditioner.
+ *
+ * Like SolverGMRES with right preconditioning, the solver builds the Krylov
+ * space of the preconditioned operator $AP^{-1}$, and the residual used in
+ * the convergence test is the true (unpreconditioned) residual. In order to
+ * stay in a consistent space between solves, the recycled vectors are
+ * stored in the preconditioned space. The preconditioner may change between
+ * solves, but must be the same during one call to solve().
+ *
+ * The parameters are the maximum basis size $m$, which includes the $k$
+ * recycled vectors such that each restart cycle runs $m-k$ Arnoldi
+ * iterations, and the number $k$ of recycled vectors, with the defaults
+ * $m=30$ and $k=10$. The solver stores $m+k+4$ vectors, plus $2k$
+ * temporary vectors during the update of the recycled space. This update
+ * on every restart involves about $(m+k) k$ additional inner products and
+ * vector updates, which is comparable to the cost of the orthogonalization
+ * in the restart cycle. Setting $k=0$ results in plain restarted GMRES.
+ *
+ * The recycled space can be inspected with get_recycled_space(), e.g. in
+ * order to check the quality of the approximate eigenvectors by their
+ * residuals, and discarded with clear_recycled_space() if the next linear
+ * system is unrelated to the previous ones. Since the solver object carries
+ * the recycled space, it must be kept alive between the solves, like in
+ * @code
+ *   SolverControl            control(1000, 1e-10);
+ *   SolverGCRODR<VectorType> solver(control);
+ *   for (unsigned int step = 0; step < n_steps; ++step)
+ *     {
+ *       assemble_system(step);
+ *       solver.solve(system_matrix, solution, rhs, preconditioner);
+ *     }
+ * @endcode
+ *
+ * The coefficients of the projected problems are computed in double
+ * precision, and only real-valued vector types are supported.
+ */
+template <class VectorType = Vector<double>>
+class SolverGCRODR : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, set the maximum basis size to 30 and the
+     * number of recycled vectors to 10.
+     */
+    explicit AdditionalData(const unsigned int max_basis_size     = 30,
+                            const unsigned int n_recycled_vectors = 10)
+      : max_basis_size(max_basis_size)
+      , n_recycled_vectors(n_recycled_vectors)
+    {}
+
+    /**
+     * Maximum basis size, including the recycled vectors.
+     */
+    unsigned int max_basis_size;
+
+    /**
+     * Number of vectors of the recycled space. Must be smaller than
+     * max_basis_size.
+     */
+    unsigned int n_recycled_vectors;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverGCRODR(SolverControl &           cn,
+               VectorMemory<VectorType> &mem,
+               const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverGCRODR(SolverControl &       cn,
+               const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x, starting from the recycled space
+   * of the previous calls to this function, and update the recycled space.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+  /**
+   * Return the vectors spanning the recycled space, i.e., the approximate
+   * eigenvectors of the right-preconditioned operator $AP^{-1}$ computed by
+   * the previous calls to solve(). The vectors are not normalized, and the
+   * list is empty before the first solve.
+   */
+  const std::vector<VectorType> &
+  get_recycled_space() const;
+
+  /**
+   * Discard the recycled space, such that the next call to solve() starts
+   * from scratch.
+   */
+  void
+  clear_recycled_space();
+
+private:
+  /**
+   * Compute the space $C_k = AP^{-1}U_k$ for the current matrix and
+   * preconditioner and orthonormalize it, applying the same transformation
+   * to $U_k$. Vectors that are linearly dependent on the others are removed
+   * from the recycled space.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  setup_recycled_space(const MatrixType &        A,
+                       const PreconditionerType &preconditioner,
+                       VectorType &              tmp);
+
+  /**
+   * Replace the recycled space by the harmonic Ritz vectors to the
+   * harmonic Ritz values of smallest magnitude within the space spanned by
+   * the recycled space and the @p dim Krylov vectors @p v of the present
+   * cycle, using the projected matrices @p H and @p B of the Arnoldi process.
+   */
+  void
+  update_recycled_space(
+    const internal::SolverGMRESImplementation::TmpVectors<VectorType> &v,
+    const unsigned int                                                 dim,
+    const FullMatrix<double> &                                         H,
+    const FullMatrix<double> &                                         B);
+
+  /**
+   * Additional flags.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The recycled space $U_k$, kept between calls to solve().
+   */
+  std::vector<VectorType> recycled_space;
+
+  /**
+   * The orthonormal basis of the image $C_k = AP^{-1}U_k$ of the recycled
+   * space, only valid during solve().
+   */
+  std::vector<VectorType> recycled_image;
+};
+
+/*@}*/
+/* --------------------- Inline and template functions ------------------- */
+
+
+#ifndef DOXYGEN
+
+template <class VectorType>
+SolverGCRODR<VectorType>::SolverGCRODR(SolverControl &           cn,
+                                       VectorMemory<VectorType> &mem,
+                                       const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+SolverGCRODR<VectorType>::SolverGCRODR(SolverControl &       cn,
+                                       const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+inline const std::vector<VectorType> &
+SolverGCRODR<VectorType>::get_recycled_space() const
+{
+  return recycled_space;
+}
+
+
+
+template <class VectorType>
+inline void
+SolverGCRODR<VectorType>::clear_recycled_space()
+{
+  recycled_space.clear();
+  recycled_image.clear();
+}
+
+
+
+template <class VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverGCRODR<VectorType>::setup_recycled_space(
+  const MatrixType &        A,
+  const PreconditionerType &preconditioner,
+  VectorType &              tmp)
+{
+  // modified Gram-Schmidt on the images of the recycled vectors, dropping
+  // the vectors whose image is numerically dependent on the previous ones
+  recycled_image.resize(recycled_space.size());
+  unsigned int n_kept = 0;
+  for (unsigned int i = 0; i < recycled_space.size(); ++i)
+    {
+      if (i != n_kept)
+        recycled_space[n_kept].swap(recycled_space[i]);
+      VectorType &u = recycled_space[n_kept];
+      VectorType &c = recycled_image[n_kept];
+
+      preconditioner.vmult(tmp, u);
+      c.reinit(tmp, true);
+      A.vmult(c, tmp);
+
+      const double initial_norm = c.l2_norm();
+      for (unsigned int j = 0; j < n_kept; ++j)
+        {
+          const double factor = c * recycled_image[j];
+          c.add(-factor, recycled_image[j]);
+          u.add(-factor, recycled_space[j]);
+        }
+      const double norm = c.l2_norm();
+      if (norm > 1e-10 * initial_norm)
+        {
+          c *= 1. / norm;
+          u *= 1. / norm;
+          ++n_kept;
+        }
+    }
+  recycled_space.resize(n_kept);
+  recycled_image.resize(n_kept);
+}
+
+
+
+template <class VectorType>
+void
+SolverGCRODR<VectorType>::update_recycled_space(
+  const internal::SolverGMRESImplementation::TmpVectors<VectorType> &v,
+  const unsigned int                                                 dim,
+  const FullMatrix<double> &                                         H,
+  const FullMatrix<double> &                                         B)
+{
+  const unsigned int k = recycled_space.size();
+  const unsigned int s = k + dim;
+  const unsigned int n_target = std::min(additional_data.n_recycled_vectors, s);
+  if (n_target == 0)
+    return;
+
+  // The relation of the Arnoldi process with the recycled space in
+  // normalized form, U_k D_k with D_k = diag(1/|u_i|), reads
+  //   A P^{-1} [U_k D_k, V_dim] = [C_k, V_{dim+1}] G,
+  //   G = [D_k  B; 0  H].
+  // The harmonic Ritz vectors [U_k D_k, V_dim] z with respect to this space
+  // solve the generalized eigenvalue problem
+  //   G^T G z = theta G^T F z,  F = [C_k, V_{dim+1}]^T [U_k D_k, V_dim].
+  // Since C_k is orthogonal to the Krylov vectors, only the blocks of F
+  // involving U_k need to be computed.
+  std::vector<double> scaling(k);
+  for (unsigned int j = 0; j < k; ++j)
+    scaling[j] = 1. / recycled_space[j].l2_norm();
+
+  FullMatrix<double> G(s + 1, s), F(s + 1, s);
+  for (unsigned int i = 0; i < k; ++i)
+    {
+      G(i, i) = scaling[i];
+      for (unsigned int j = 0; j < dim; ++j)
+        G(i, k + j) = B(i, j);
+      for (unsigned int j = 0; j < k; ++j)
+        F(i, j) = (recycled_image[i] * recycled_space[j]) * scaling[j];
+    }
+  for (unsigned int i = 0; i <= dim; ++i)
+    {
+      for (unsigned int j = 0; j < dim; ++j)
+        G(k + i, k + j) = H(i, j);
+      for (unsigned int j = 0; j < k; ++j)
+        F(k + i, j) = (v[i] * recycled_space[j]) * scaling[j];
+      if (i < dim)
+        F(k + i, k + i) = 1.;
+    }
+
+  // The eigenvalues of G^+ F, computed column by column by least squares,
+  // are the inverse harmonic Ritz values, of which we select the ones with
+  // the largest magnitude. The eigenvectors of complex-conjugate pairs are
+  // represented by their real and imaginary part.
+  LAPACKFullMatrix<double> eigen_matrix(s, s);
+  {
+    Householder<double> house(G);
+    Vector<double>      column(s + 1), solution(s);
+    for (unsigned int j = 0; j < s; ++j)
+      {
+        for (unsigned int i = 0; i <= s; ++i)
+          column(i) = F(i, j);
+        house.least_squares(solution, column);
+        for (unsigned int i = 0; i < s; ++i)
+          eigen_matrix(i, j) = solution(i);
+      }
+  }
+  eigen_matrix.compute_eigenvalues(true, false);
+  const FullMatrix<std::complex<double>> eigenvectors =
+    eigen_matrix.get_right_eigenvectors();
+
+  std::vector<unsigned int> order(s);
+  std::iota(order.begin(), order.end(), 0U);
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [&](const unsigned int a, const unsigned int b) {
+                     return std::abs(eigen_matrix.eigenvalue(a)) >
+                            std::abs(eigen_matrix.eigenvalue(b));
+                   });
+
+  FullMatrix<double> P(s, n_target);
+  unsigned int       n_selected = 0;
+  for (unsigned int e = 0; e < s && n_selected < n_target; ++e)
+    {
+      const unsigned int         index  = order[e];
+      const std::complex<double> lambda = eigen_matrix.eigenvalue(index);
+      if (lambda.imag() < 0.)
+        continue;
+      for (unsigned int i = 0; i < s; ++i)
+        P(i, n_selected) = eigenvectors(i, index).real();
+      ++n_selected;
+      if (lambda.imag() > 0. && n_selected < n_target)
+        {
+          for (unsigned int i = 0; i < s; ++i)
+            P(i, n_selected) = eigenvectors(i, index).imag();
+          ++n_selected;
+        }
+    }
+
+  // QR decomposition G P = Q R by modified Gram-Schmidt, dropping the
+  // columns that are numerically dependent on the previous ones. The new
+  // spaces are C_k = [C_k, V_{dim+1}] Q and U_k = [U_k D_k, V_dim] P R^{-1}.
+  FullMatrix<double> Q(s + 1, n_selected), R(n_selected, n_selected);
+  G.mmult(Q, P);
+  std::vector<unsigned int> kept;
+  for (unsigned int c = 0; c < n_selected; ++c)
+    {
+      double initial_norm = 0.;
+      for (unsigned int i = 0; i <= s; ++i)
+        initial_norm += Q(i, c) * Q(i, c);
+      for (const unsigned int l : kept)
+        {
+          for (unsigned int i = 0; i <= s; ++i)
+            R(l, c) += Q(i, l) * Q(i, c);
+          for (unsigned int i = 0; i <= s; ++i)
+            Q(i, c) -= R(l, c) * Q(i, l);
+        }
+      double norm = 0.;
+      for (unsigned int i = 0; i <= s; ++i)
+        norm += Q(i, c) * Q(i, c);
+      norm = std::sqrt(norm);
+      if (norm <= 1e-10 * std::sqrt(initial_norm))
+        continue;
+
+      R(c, c) = norm;
+      for (unsigned int i = 0; i <= s; ++i)
+        Q(i, c) /= norm;
+      for (unsigned int i = 0; i < s; ++i)
+        {
+          for (const unsigned int l : kept)
+            P(i, c) -= P(i, l) * R(l, c);
+          P(i, c) /= norm;
+        }
+      kept.push_back(c);
+    }
+
+  const unsigned int n_kept = kept.size();
+  typename internal::SolverGMRESImplementation::TmpVectors<VectorType>
+    new_space(n_kept, this->memory), new_image(n_kept, this->memory);
+  for (unsigned int c = 0; c < n_kept; ++c)
+    {
+      VectorType &u = new_space(c, v[0]);
+      VectorType &w = new_image(c, v[0]);
+      u             = 0.;
+      w             = 0.;
+      for (unsigned int j = 0; j < k; ++j)
+        {
+          u.add(P(j, kept[c]) * scaling[j], recycled_space[j]);
+          w.add(Q(j, kept[c]), recycled_image[j]);
+        }
+      for (unsigned int j = 0; j < dim; ++j)
+        u.add(P(k + j, kept[c]), v[j]);
+      for (unsigned int j = 0; j <= dim; ++j)
+        w.add(Q(k + j, kept[c]), v[j]);
+    }
+
+  recycled_space.resize(n_kept);
+  recycled_image.resize(n_kept);
+  for (unsigned int c = 0; c < n_kept; ++c)
+    {
+      recycled_space[c].reinit(v[0], true);
+      recycled_space[c] = new_space[c];
+      recycled_image[c].reinit(v[0], true);
+      recycled_image[c] = new_image[c];
+    }
+}
+
+
+
+template <class VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverGCRODR<VectorType>::solve(const MatrixType &        A,
+                                VectorType &              x,
+                                const VectorType &        b,
+                                const PreconditionerType &preconditioner)
+{
+  LogStream::Prefix prefix("GCRODR");
+
+  const unsigned int basis_size = additional_data.max_basis_size;
+  AssertThrow(additional_data.n_recycled_vectors < basis_size,
+              ExcMessage("The number of recycled vectors must be smaller "
+                         "than the maximum basis size."));
+
+  SolverControl::State iteration_state = SolverControl::iterate;
+
+  // number of the present iteration; this number is not reset to zero upon a
+  // restart
+  unsigned int accumulated_iterations = 0;
+
+  typename VectorMemory<VectorType>::Pointer r(this->memory);
+  typename VectorMemory<VectorType>::Pointer p(this->memory);
+  typename VectorMemory<VectorType>::Pointer aux(this->memory);
+  r->reinit(x);
+  p->reinit(x);
+  aux->reinit(x);
+
+  setup_recycled_space(A, preconditioner, *aux);
+
+  // Generate an object where basis vectors are stored.
+  typename internal::SolverGMRESImplementation::TmpVectors<VectorType> v(
+    basis_size + 1, this->memory);
+
+  FullMatrix<double>              H, H1, B;
+  Vector<double>                  projected_rhs, y, h;
+  std::vector<const VectorType *> basis;
+
+  double res = -std::numeric_limits<double>::max();
+  do
+    {
+      const unsigned int k = recycled_space.size();
+
+      A.vmult(*r, x);
+      r->sadd(-1., 1., b);
+
+      // the least-squares solution in the recycled space is the projection
+      // of the residual onto the orthonormal basis of its image, which is
+      // accumulated in the preconditioned space in p
+      *p = 0.;
+      for (unsigned int i = 0; i < k; ++i)
+        {
+          const double factor = *r * recycled_image[i];
+          r->add(-factor, recycled_image[i]);
+          p->add(factor, recycled_space[i]);
+        }
+
+      const double beta = r->l2_norm();
+      res               = beta;
+      iteration_state = this->iteration_status(accumulated_iterations, res, x);
+      if (iteration_state != SolverControl::iterate)
+        {
+          if (k > 0)
+            {
+              preconditioner.vmult(*aux, *p);
+              x += *aux;
+            }
+          break;
+        }
+
+      // Arnoldi process on the operator projected onto the orthogonal
+      // complement of the recycled image
+      const unsigned int n_steps = basis_size - k;
+      H.reinit(n_steps + 1, n_steps);
+      B.reinit(k, n_steps);
+      v(0, x).equ(1. / beta, *r);
+
+      unsigned int dim = 0;
+      for (unsigned int j = 0; j < n_steps; ++j)
+        {
+          preconditioner.vmult(*aux, v[j]);
+          A.vmult(v(j + 1, x), *aux);
+          VectorType &w = v[j + 1];
+
+          // modified Gram-Schmidt against the recycled image and the Krylov
+          // basis, fusing each update with the next inner product
+          basis.clear();
+          for (unsigned int i = 0; i < k; ++i)
+            basis.push_back(&recycled_image[i]);
+          for (unsigned int i = 0; i <= j; ++i)
+            basis.push_back(&v[i]);
+          h.reinit(basis.size());
+          h(0) = w * *basis[0];
+          for (unsigned int i = 1; i < basis.size(); ++i)
+            h(i) = w.add_and_dot(-h(i - 1), *basis[i - 1], *basis[i]);
+          const double a =
+            std::sqrt(w.add_and_dot(-h(basis.size() - 1), *basis.back(), w));
+          for (unsigned int i = 0; i < k; ++i)
+            B(i, j) = h(i);
+          for (unsigned int i = 0; i <= j; ++i)
+            H(i, j) = h(k + i);
+          H(j + 1, j) = a;
+
+          // treat lucky breakdown
+          if (a != 0)
+            w *= 1. / a;
+          else
+            w = 0.;
+
+          // the least-squares problem decouples into the one of the Krylov
+          // basis with H and the coefficients of the recycled space, which
+          // are determined by B
+          dim = j + 1;
+          H1.reinit(dim + 1, dim);
+          H1.fill(H);
+          projected_rhs.reinit(dim + 1);
+          y.reinit(dim);
+          projected_rhs(0) = beta;
+          Householder<double> house(H1);
+          res = house.least_squares(y, projected_rhs);
+          iteration_state =
+            this->iteration_status(++accumulated_iterations, res, x);
+          if (iteration_state != SolverControl::iterate)
+            break;
+        }
+
+      // update the solution by P^{-1} (V y - U B y), together with the
+      // contribution of the recycled space from above
+      for (unsigned int j = 0; j < dim; ++j)
+        p->add(y(j), v[j]);
+      for (unsigned int i = 0; i < k; ++i)
+        {
+          double factor = 0.;
+          for (unsigned int j = 0; j < dim; ++j)
+            factor += B(i, j) * y(j);
+          p->add(-factor, recycled_space[i]);
+        }
+      preconditioner.vmult(*aux, *p);
+      x += *aux;
+
+      update_recycled_space(v, dim, H, B);
+    }
+  while (iteration_state == SolverControl::iterate);
+
+  // in case of failure: throw exception
+  if (iteration_state != SolverControl::success)
+    AssertThrow(false,
+                SolverControl::NoConvergence(accumulated_iterations, res));
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
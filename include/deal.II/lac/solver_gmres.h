@@ -20,6 +20,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/subscriptor.h>
@@ -37,9 +38,54 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
 /*!@addtogroup Solvers */
 /*@{*/
 
+namespace LinearAlgebra
+{
+  /**
+   * An enum that lists the available strategies to compute the
+   * orthogonalization of a new vector against the Krylov basis in the
+   * Arnoldi process of SolverGMRES and SolverFGMRES.
+   */
+  enum class OrthogonalizationStrategy
+  {
+    /**
+     * Use the modified Gram-Schmidt algorithm. The new vector is
+     * orthogonalized against one basis vector after the other, which
+     * requires as many global reductions as there are basis vectors.
+     */
+    modified_gram_schmidt,
+
+    /**
+     * Use the classical Gram-Schmidt algorithm. All inner products with the
+     * basis vectors are computed from the same vector, so that they can be
+     * computed in a single sweep over the vectors with a single global
+     * reduction, followed by one combined update of the new vector. For
+     * LinearAlgebra::distributed::Vector, this uses the functions
+     * LinearAlgebra::distributed::Vector::multiple_inner_products() and
+     * LinearAlgebra::distributed::Vector::add_multiple(). Since classical
+     * Gram-Schmidt is less stable in terms of roundoff than the modified
+     * variant, it is typically combined with re-orthogonalization, which
+     * is triggered by the same criterion as for the modified Gram-Schmidt
+     * algorithm.
+     */
+    classical_gram_schmidt
+  };
+} // namespace LinearAlgebra
+
 namespace internal
 {
   /**
@@ -104,6 +150,28 @@ namespace internal
        */
       std::vector<typename VectorMemory<VectorType>::Pointer> data;
     };
+
+    /**
+     * Orthogonalize the vector @p vv against the first @p dim vectors of
+     * @p orthogonal_vectors with the classical Gram-Schmidt algorithm,
+     * i.e., all the factors are computed from the input vector @p vv before
+     * any of them is subtracted. The factors are added to the first @p dim
+     * entries of @p h. This function returns the norm of the orthogonalized
+     * vector. If the flag @p re_orthogonalize is set or the loss of
+     * orthogonality is detected every fifth step, the algorithm is applied
+     * twice, like in SolverGMRES::modified_gram_schmidt().
+     */
+    template <typename VectorType>
+    double
+    classical_gram_schmidt(
+      const TmpVectors<VectorType> &            orthogonal_vectors,
+      const unsigned int                        dim,
+      const unsigned int                        accumulated_iterations,
+      VectorType &                              vv,
+      Vector<double> &                          h,
+      bool &                                    re_orthogonalize,
+      const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
+        boost::signals2::signal<void(int)>());
   } // namespace SolverGMRESImplementation
 } // namespace internal
 
@@ -189,10 +257,14 @@ public:
      * left, the residual of the stopping criterion to the default residual,
      * and re-orthogonalization only if necessary.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int max_n_tmp_vectors          = 30,
+      const bool         right_preconditioning      = false,
+      const bool         use_default_residual       = true,
+      const bool         force_re_orthogonalization = false,
+      const LinearAlgebra::OrthogonalizationStrategy
+        orthogonalization_strategy =
+          LinearAlgebra::OrthogonalizationStrategy::modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -223,6 +295,13 @@ public:
      * if necessary.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * Strategy to orthogonalize the new vector against the Krylov basis,
+     * see LinearAlgebra::OrthogonalizationStrategy for the available
+     * options.
+     */
+    LinearAlgebra::OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -468,8 +547,13 @@ public:
     /**
      * Constructor. By default, set the maximum basis size to 30.
      */
-    explicit AdditionalData(const unsigned int max_basis_size = 30)
+    explicit AdditionalData(
+      const unsigned int max_basis_size = 30,
+      const LinearAlgebra::OrthogonalizationStrategy
+        orthogonalization_strategy =
+          LinearAlgebra::OrthogonalizationStrategy::modified_gram_schmidt)
       : max_basis_size(max_basis_size)
+      , orthogonalization_strategy(orthogonalization_strategy)
     {}
 
     /**
@@ -480,6 +564,8 @@ public:
     AdditionalData(const unsigned int max_basis_size,
                    const bool         use_default_residual)
       : max_basis_size(max_basis_size)
+      , orthogonalization_strategy(
+          LinearAlgebra::OrthogonalizationStrategy::modified_gram_schmidt)
     {
       (void)use_default_residual;
     }
@@ -488,6 +574,13 @@ public:
      * Maximum basis size.
      */
     unsigned int max_basis_size;
+
+    /**
+     * Strategy to orthogonalize the new vector against the Krylov basis,
+     * see LinearAlgebra::OrthogonalizationStrategy for the available
+     * options.
+     */
+    LinearAlgebra::OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -586,6 +679,134 @@ namespace internal
 
 
 
+    // Subtract the projection of vv onto the first dim orthogonal vectors
+    // with all factors computed from the same input vector vv, and add the
+    // factors to h. This is the generic version that goes through the
+    // vectors one at a time.
+    template <typename VectorType>
+    inline void
+    classical_gram_schmidt_step(
+      const TmpVectors<VectorType> &orthogonal_vectors,
+      const unsigned int            dim,
+      VectorType &                  vv,
+      Vector<double> &              h)
+    {
+      std::vector<double> factors(dim);
+      for (unsigned int i = 0; i < dim; ++i)
+        factors[i] = vv * orthogonal_vectors[i];
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          vv.add(-factors[i], orthogonal_vectors[i]);
+          h(i) += factors[i];
+        }
+    }
+
+
+
+    // Specialized version for LinearAlgebra::distributed::Vector that
+    // computes all inner products in one sweep over the vectors and a single
+    // global reduction, and performs the update in one sweep as well
+    template <typename Number, typename MemorySpace>
+    inline void
+    classical_gram_schmidt_step(
+      const TmpVectors<LinearAlgebra::distributed::Vector<Number, MemorySpace>>
+        &                orthogonal_vectors,
+      const unsigned int dim,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace> &vv,
+      Vector<double> &                                         h)
+    {
+      std::vector<const LinearAlgebra::distributed::Vector<Number, MemorySpace>
+                    *>
+                          vectors(dim);
+      std::vector<Number> factors(dim);
+      for (unsigned int i = 0; i < dim; ++i)
+        vectors[i] = &orthogonal_vectors[i];
+      vv.multiple_inner_products(make_array_view(vectors),
+                                 make_array_view(factors));
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          h(i) += factors[i];
+          factors[i] = -factors[i];
+        }
+      vv.add_multiple(make_array_view(factors), make_array_view(vectors));
+    }
+
+
+
+    template <typename VectorType>
+    inline double
+    classical_gram_schmidt(
+      const TmpVectors<VectorType> &            orthogonal_vectors,
+      const unsigned int                        dim,
+      const unsigned int                        accumulated_iterations,
+      VectorType &                              vv,
+      Vector<double> &                          h,
+      bool &                                    reorthogonalize,
+      const boost::signals2::signal<void(int)> &reorthogonalize_signal)
+    {
+      Assert(dim > 0, ExcInternalError());
+      const unsigned int inner_iteration = dim - 1;
+
+      // need initial norm for detection of re-orthogonalization, see
+      // SolverGMRES::modified_gram_schmidt()
+      double     norm_vv_start = 0;
+      const bool consider_reorthogonalize =
+        (reorthogonalize == false) && (inner_iteration % 5 == 4);
+      if (consider_reorthogonalize)
+        norm_vv_start = vv.l2_norm();
+
+      for (unsigned int i = 0; i < dim; ++i)
+        h(i) = 0;
+      classical_gram_schmidt_step(orthogonal_vectors, dim, vv, h);
+      double norm_vv = vv.l2_norm();
+
+      if (consider_reorthogonalize)
+        {
+          if (norm_vv >
+              10. * norm_vv_start *
+                std::sqrt(std::numeric_limits<
+                          typename VectorType::value_type>::epsilon()))
+            return norm_vv;
+
+          else
+            {
+              reorthogonalize = true;
+              if (!reorthogonalize_signal.empty())
+                reorthogonalize_signal(accumulated_iterations);
+            }
+        }
+
+      if (reorthogonalize == true)
+        {
+          classical_gram_schmidt_step(orthogonal_vectors, dim, vv, h);
+          norm_vv = vv.l2_norm();
+        }
+
+      return norm_vv;
+    }
+
+
+
+    // The estimated number of vector entries read and written, in units of
+    // the vector size, by the orthogonalization of a new vector against dim
+    // basis vectors without re-orthogonalization, used for the statistics.
+    // The classical Gram-Schmidt method sweeps over all vectors once for
+    // the inner products and once for the update, whereas the modified one
+    // reads and writes the new vector for each basis vector.
+    inline double
+    orthogonalization_vector_accesses(
+      const LinearAlgebra::OrthogonalizationStrategy strategy,
+      const unsigned int                             dim)
+    {
+      if (strategy ==
+          LinearAlgebra::OrthogonalizationStrategy::classical_gram_schmidt)
+        return 2. * dim + 3.;
+      else
+        return 5. * dim + 1.;
+    }
+
+
+
     // A comparator for better printing eigenvalues
     inline bool
     complex_less_pred(const std::complex<double> &x,
@@ -604,11 +825,13 @@ inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
   const unsigned int max_n_tmp_vectors,
   const bool         right_preconditioning,
   const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const bool         force_re_orthogonalization,
+  const LinearAlgebra::OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
@@ -802,6 +1025,7 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
   // size
 
   LogStream::Prefix prefix("GMRES");
+  this->reset_statistics();
 
   // extra call to std::max to placate static analyzers: coverity rightfully
   // complains that data.max_n_tmp_vectors - 2 may overflow
@@ -870,6 +1094,10 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
   bool re_orthogonalize = additional_data.force_re_orthogonalization;
 
+  // the estimated number of bytes of one vector for the statistics
+  const double vector_bytes =
+    static_cast<double>(x.size()) * sizeof(typename VectorType::value_type);
+
   ///////////////////////////////////////////////////////////////////////////
   // outer iteration: loop until we either reach convergence or the maximum
   // number of iterations is exceeded. each cycle of this loop amounts to one
@@ -881,17 +1109,30 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
       if (left_precondition)
         {
-          A.vmult(p, x);
-          p.sadd(-1., 1., b);
-          preconditioner.vmult(v, p);
+          this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+            A.vmult(p, x);
+          });
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { p.sadd(-1., 1., b); });
+          this->measure(SolverStatistics::preconditioner_application,
+                        0.,
+                        [&]() { preconditioner.vmult(v, p); });
         }
       else
         {
-          A.vmult(v, x);
-          v.sadd(-1., 1., b);
+          this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+            A.vmult(v, x);
+          });
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { v.sadd(-1., 1., b); });
         };
 
-      double rho = v.l2_norm();
+      double rho = 0;
+      this->measure(SolverStatistics::reduction, vector_bytes, [&]() {
+        rho = v.l2_norm();
+      });
 
       // check the residual here as well since it may be that we got the exact
       // (or an almost exact) solution vector at the outset. if we wouldn't
@@ -911,14 +1152,23 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           if (left_precondition)
             {
-              A.vmult(*r, x);
-              r->sadd(-1., 1., b);
+              this->measure(SolverStatistics::matrix_vector_product,
+                            0.,
+                            [&]() { A.vmult(*r, x); });
+              this->measure(SolverStatistics::vector_update,
+                            3. * vector_bytes,
+                            [&]() { r->sadd(-1., 1., b); });
             }
           else
-            preconditioner.vmult(*r, v);
-
-          double res = r->l2_norm();
-          last_res   = res;
+            this->measure(SolverStatistics::preconditioner_application,
+                          0.,
+                          [&]() { preconditioner.vmult(*r, v); });
+
+          double res = 0;
+          this->measure(SolverStatistics::reduction, vector_bytes, [&]() {
+            res = r->l2_norm();
+          });
+          last_res = res;
           iteration_state =
             this->iteration_status(accumulated_iterations, res, x);
 
@@ -928,7 +1178,9 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
       gamma(0) = rho;
 
-      v *= 1. / rho;
+      this->measure(SolverStatistics::vector_update, 2. * vector_bytes, [&]() {
+        v *= 1. / rho;
+      });
 
       // inner iteration doing at most as many steps as there are temporary
       // vectors. the number of steps actually been done is propagated outside
@@ -944,30 +1196,66 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           if (left_precondition)
             {
-              A.vmult(p, tmp_vectors[inner_iteration]);
-              preconditioner.vmult(vv, p);
+              this->measure(SolverStatistics::matrix_vector_product,
+                            0.,
+                            [&]() {
+                              A.vmult(p, tmp_vectors[inner_iteration]);
+                            });
+              this->measure(SolverStatistics::preconditioner_application,
+                            0.,
+                            [&]() { preconditioner.vmult(vv, p); });
             }
           else
             {
-              preconditioner.vmult(p, tmp_vectors[inner_iteration]);
-              A.vmult(vv, p);
+              this->measure(SolverStatistics::preconditioner_application,
+                            0.,
+                            [&]() {
+                              preconditioner.vmult(
+                                p, tmp_vectors[inner_iteration]);
+                            });
+              this->measure(SolverStatistics::matrix_vector_product,
+                            0.,
+                            [&]() { A.vmult(vv, p); });
             }
 
           dim = inner_iteration + 1;
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
-                                                 dim,
-                                                 accumulated_iterations,
-                                                 vv,
-                                                 h,
-                                                 re_orthogonalize,
-                                                 re_orthogonalize_signal);
+          // the orthogonalization is recorded as a single reduction
+          double s = 0;
+          this->measure(
+            SolverStatistics::reduction,
+            internal::SolverGMRESImplementation::
+                orthogonalization_vector_accesses(
+                  additional_data.orthogonalization_strategy, dim) *
+              vector_bytes,
+            [&]() {
+              s = (additional_data.orthogonalization_strategy ==
+                       LinearAlgebra::OrthogonalizationStrategy::
+                         classical_gram_schmidt ?
+                     internal::SolverGMRESImplementation::
+                       classical_gram_schmidt(tmp_vectors,
+                                              dim,
+                                              accumulated_iterations,
+                                              vv,
+                                              h,
+                                              re_orthogonalize,
+                                              re_orthogonalize_signal) :
+                     modified_gram_schmidt(tmp_vectors,
+                                           dim,
+                                           accumulated_iterations,
+                                           vv,
+                                           h,
+                                           re_orthogonalize,
+                                           re_orthogonalize_signal));
+            });
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
           // but we must not divide by zero here.
           if (s != 0)
-            vv *= 1. / s;
+            this->measure(SolverStatistics::vector_update,
+                          2. * vector_bytes,
+                          [&]() { vv *= 1. / s; });
 
           // for eigenvalues, get the resulting coefficients from the
           // orthogonalization process
@@ -1060,14 +1348,22 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
       if (left_precondition)
         for (unsigned int i = 0; i < dim; ++i)
-          x.add(h(i), tmp_vectors[i]);
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { x.add(h(i), tmp_vectors[i]); });
       else
         {
           p = 0.;
           for (unsigned int i = 0; i < dim; ++i)
-            p.add(h(i), tmp_vectors[i]);
-          preconditioner.vmult(v, p);
-          x.add(1., v);
+            this->measure(SolverStatistics::vector_update,
+                          3. * vector_bytes,
+                          [&]() { p.add(h(i), tmp_vectors[i]); });
+          this->measure(SolverStatistics::preconditioner_application,
+                        0.,
+                        [&]() { preconditioner.vmult(v, p); });
+          this->measure(SolverStatistics::vector_update,
+                        3. * vector_bytes,
+                        [&]() { x.add(1., v); });
         };
       // end of outer iteration. restart if no convergence and the number of
       // iterations is not exceeded
@@ -1206,6 +1502,7 @@ SolverFGMRES<VectorType>::solve(const MatrixType &        A,
                                 const PreconditionerType &preconditioner)
 {
   LogStream::Prefix prefix("FGMRES");
+  this->reset_statistics();
 
   SolverControl::State iteration_state = SolverControl::iterate;
 
@@ -1228,17 +1525,34 @@ SolverFGMRES<VectorType>::solve(const MatrixType &        A,
   Vector<double> projected_rhs;
   Vector<double> y;
 
+  // column of the orthogonalization coefficients and re-orthogonalization
+  // flag for the classical Gram-Schmidt algorithm. the Gram-Schmidt step
+  // zeroes the first j+1 entries it uses, so the vector can be sized once
+  Vector<double> h(basis_size);
+  bool           re_orthogonalize = false;
+
   // Iteration starts here
   double res = -std::numeric_limits<double>::max();
 
   typename VectorMemory<VectorType>::Pointer aux(this->memory);
   aux->reinit(x);
+
+  // the estimated number of bytes of one vector for the statistics
+  const double vector_bytes =
+    static_cast<double>(x.size()) * sizeof(typename VectorType::value_type);
   do
     {
-      A.vmult(*aux, x);
-      aux->sadd(-1., 1., b);
-
-      double beta     = aux->l2_norm();
+      this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+        A.vmult(*aux, x);
+      });
+      this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+        aux->sadd(-1., 1., b);
+      });
+
+      double beta = 0;
+      this->measure(SolverStatistics::reduction, vector_bytes, [&]() {
+        beta = aux->l2_norm();
+      });
       res             = beta;
       iteration_state = this->iteration_status(accumulated_iterations, res, x);
       if (iteration_state == SolverControl::success)
@@ -1250,19 +1564,52 @@ SolverFGMRES<VectorType>::solve(const MatrixType &        A,
       for (unsigned int j = 0; j < basis_size; ++j)
         {
           if (a != 0) // treat lucky breakdown
-            v(j, x).equ(1. / a, *aux);
+            this->measure(SolverStatistics::vector_update,
+                          2. * vector_bytes,
+                          [&]() { v(j, x).equ(1. / a, *aux); });
           else
             v(j, x) = 0.;
 
 
-          preconditioner.vmult(z(j, x), v[j]);
-          A.vmult(*aux, z[j]);
-
-          // Gram-Schmidt
-          H(0, j) = *aux * v[0];
-          for (unsigned int i = 1; i <= j; ++i)
-            H(i, j) = aux->add_and_dot(-H(i - 1, j), v[i - 1], v[i]);
-          H(j + 1, j) = a = std::sqrt(aux->add_and_dot(-H(j, j), v[j], *aux));
+          this->measure(SolverStatistics::preconditioner_application,
+                        0.,
+                        [&]() { preconditioner.vmult(z(j, x), v[j]); });
+          this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+            A.vmult(*aux, z[j]);
+          });
+
+          // Gram-Schmidt, recorded as a single reduction
+          this->measure(
+            SolverStatistics::reduction,
+            internal::SolverGMRESImplementation::
+                orthogonalization_vector_accesses(
+                  additional_data.orthogonalization_strategy, j + 1) *
+              vector_bytes,
+            [&]() {
+              if (additional_data.orthogonalization_strategy ==
+                  LinearAlgebra::OrthogonalizationStrategy::
+                    classical_gram_schmidt)
+                {
+                  a = internal::SolverGMRESImplementation::
+                    classical_gram_schmidt(v,
+                                           j + 1,
+                                           accumulated_iterations,
+                                           *aux,
+                                           h,
+                                           re_orthogonalize);
+                  for (unsigned int i = 0; i <= j; ++i)
+                    H(i, j) = h(i);
+                  H(j + 1, j) = a;
+                }
+              else
+                {
+                  H(0, j) = *aux * v[0];
+                  for (unsigned int i = 1; i <= j; ++i)
+                    H(i, j) = aux->add_and_dot(-H(i - 1, j), v[i - 1], v[i]);
+                  H(j + 1, j) = a =
+                    std::sqrt(aux->add_and_dot(-H(j, j), v[j], *aux));
+                }
+            });
 
           // Compute projected solution
 
@@ -1289,7 +1636,9 @@ SolverFGMRES<VectorType>::solve(const MatrixType &        A,
 
       // Update solution vector
       for (unsigned int j = 0; j < y.size(); ++j)
-        x.add(y(j), z[j]);
+        this->measure(SolverStatistics::vector_update,
+                      3. * vector_bytes,
+                      [&]() { x.add(y(j), z[j]); });
     }
   while (iteration_state == SolverControl::iterate);
 
@@ -241,18 +241,33 @@ SolverMinRes<VectorType>::solve(const MatrixType &        A,
   unsigned int j = 1;
 
 
+  // the estimated number of bytes of one vector for the statistics
+  this->reset_statistics();
+  const double vector_bytes =
+    static_cast<double>(b.size()) * sizeof(typename VectorType::value_type);
+
   // Start of the solution process
-  A.vmult(*m[0], x);
-  *u[1] = b;
-  *u[1] -= *m[0];
+  this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+    A.vmult(*m[0], x);
+  });
+  this->measure(SolverStatistics::vector_update, 2. * vector_bytes, [&]() {
+    *u[1] = b;
+  });
+  this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+    *u[1] -= *m[0];
+  });
   // Precondition is applied.
   // The preconditioner has to be
   // positive definite and symmetric
 
   // M v = u[1]
-  preconditioner.vmult(v, *u[1]);
+  this->measure(SolverStatistics::preconditioner_application, 0., [&]() {
+    preconditioner.vmult(v, *u[1]);
+  });
 
-  delta[1] = v * (*u[1]);
+  this->measure(SolverStatistics::reduction, 2. * vector_bytes, [&]() {
+    delta[1] = v * (*u[1]);
+  });
   // Preconditioner positive
   Assert(delta[1] >= 0, ExcPreconditionerNotDefinite());
 
@@ -270,23 +285,40 @@ SolverMinRes<VectorType>::solve(const MatrixType &        A,
   while (conv == SolverControl::iterate)
     {
       if (delta[1] != 0)
-        v *= 1. / std::sqrt(delta[1]);
+        this->measure(SolverStatistics::vector_update,
+                      2. * vector_bytes,
+                      [&]() { v *= 1. / std::sqrt(delta[1]); });
       else
         v.reinit(b);
 
-      A.vmult(*u[2], v);
-      u[2]->add(-std::sqrt(delta[1] / delta[0]), *u[0]);
-
-      const double gamma = *u[2] * v;
-      u[2]->add(-gamma / std::sqrt(delta[1]), *u[1]);
-      *m[0] = v;
+      this->measure(SolverStatistics::matrix_vector_product, 0., [&]() {
+        A.vmult(*u[2], v);
+      });
+      this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+        u[2]->add(-std::sqrt(delta[1] / delta[0]), *u[0]);
+      });
+
+      double gamma = 0;
+      this->measure(SolverStatistics::reduction, 2. * vector_bytes, [&]() {
+        gamma = *u[2] * v;
+      });
+      this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+        u[2]->add(-gamma / std::sqrt(delta[1]), *u[1]);
+      });
+      this->measure(SolverStatistics::vector_update, 2. * vector_bytes, [&]() {
+        *m[0] = v;
+      });
 
       // precondition: solve M v = u[2]
       // Preconditioner has to be positive
       // definite and symmetric.
-      preconditioner.vmult(v, *u[2]);
+      this->measure(SolverStatistics::preconditioner_application, 0., [&]() {
+        preconditioner.vmult(v, *u[2]);
+      });
 
-      delta[2] = v * (*u[2]);
+      this->measure(SolverStatistics::reduction, 2. * vector_bytes, [&]() {
+        delta[2] = v * (*u[2]);
+      });
 
       Assert(delta[2] >= 0, ExcPreconditionerNotDefinite());
 
@@ -315,11 +347,19 @@ SolverMinRes<VectorType>::solve(const MatrixType &        A,
       if (j == 1)
         tau = r0 * c;
 
-      m[0]->add(-e[0], *m[1]);
+      this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+        m[0]->add(-e[0], *m[1]);
+      });
       if (j > 1)
-        m[0]->add(-f[0], *m[2]);
-      *m[0] *= 1. / d;
-      x.add(tau, *m[0]);
+        this->measure(SolverStatistics::vector_update,
+                      3. * vector_bytes,
+                      [&]() { m[0]->add(-f[0], *m[2]); });
+      this->measure(SolverStatistics::vector_update, 2. * vector_bytes, [&]() {
+        *m[0] *= 1. / d;
+      });
+      this->measure(SolverStatistics::vector_update, 3. * vector_bytes, [&]() {
+        x.add(tau, *m[0]);
+      });
       r_l2 *= std::fabs(s);
 
       conv = this->iteration_status(j, r_l2, x);
@@ -18,6 +18,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/sparse_matrix.h>
 
 #include <cmath>
@@ -93,6 +95,16 @@ DEAL_II_NAMESPACE_OPEN
  * <code>*use_this_sparsity</code> is used to store the decomposed matrix. For
  * restrictions on the sparsity see section `Fill-in' above).
  *
+ * 5/ By setting <code>use_level_scheduling=true</code>, the rows of the
+ * decomposition are grouped into level sets when initialize() is called,
+ * such that the rows in each level only depend on rows of previous levels in
+ * the forward and backward substitutions of vmult(). The rows within a level
+ * are then processed in parallel on several threads. This pays off for large
+ * matrices whose number of levels is small compared to the number of rows,
+ * e.g., matrices with few entries per row stemming from low order finite
+ * elements. The result is the same as for the sequential substitutions. The
+ * default is <code>false</code>.
+ *
  *
  * <h3>Particular implementations</h3>
  *
@@ -150,7 +162,8 @@ public:
     AdditionalData(const double           strengthen_diagonal   = 0,
                    const unsigned int     extra_off_diagonals   = 0,
                    const bool             use_previous_sparsity = false,
-                   const SparsityPattern *use_this_sparsity     = nullptr);
+                   const SparsityPattern *use_this_sparsity     = nullptr,
+                   const bool             use_level_scheduling  = false);
 
     /**
      * <code>strengthen_diag</code> times the sum of absolute row entries is
@@ -193,6 +206,15 @@ public:
      * matrix.
      */
     const SparsityPattern *use_this_sparsity;
+
+    /**
+     * If this flag is true, the initialize() function groups the rows of the
+     * decomposition into level sets that allow to perform the forward and
+     * backward substitutions of the vmult() function on several threads.
+     *
+     * The transposed application Tvmult() is always performed sequentially.
+     */
+    bool use_level_scheduling;
   };
 
   /**
@@ -328,6 +350,55 @@ protected:
   void
   prebuild_lower_bound();
 
+  /**
+   * Group the rows into level sets for the forward and the backward
+   * substitution, i.e., fill the arrays #forward_level_start,
+   * #forward_level_rows, #backward_level_start, and #backward_level_rows.
+   * The level of a row is one larger than the largest level of the rows it
+   * depends on, namely the columns of the row to the left of the diagonal
+   * for the forward substitution and to the right of the diagonal for the
+   * backward substitution. Requires prebuild_lower_bound() to have been
+   * called before.
+   */
+  void
+  prebuild_level_sets();
+
+  /**
+   * Call @p worker for all the rows in @p level_rows, one level after the
+   * other, where the rows within each level as given by @p level_start are
+   * processed in parallel.
+   */
+  template <typename RowWorker>
+  void
+  apply_on_level_sets(const std::vector<size_type> &level_start,
+                      const std::vector<size_type> &level_rows,
+                      const RowWorker &             worker) const;
+
+  /**
+   * The start of each level set of the forward substitution in
+   * #forward_level_rows, with one additional entry for the end of the last
+   * level. Empty unless level scheduling has been requested through the
+   * AdditionalData object.
+   */
+  std::vector<size_type> forward_level_start;
+
+  /**
+   * The rows sorted by their level in the forward substitution.
+   */
+  std::vector<size_type> forward_level_rows;
+
+  /**
+   * The start of each level set of the backward substitution in
+   * #backward_level_rows, with one additional entry for the end of the last
+   * level.
+   */
+  std::vector<size_type> backward_level_start;
+
+  /**
+   * The rows sorted by their level in the backward substitution.
+   */
+  std::vector<size_type> backward_level_rows;
+
 private:
   /**
    * In general this pointer is zero except for the case that no
@@ -412,6 +483,27 @@ SparseLUDecomposition<number>::Tvmult_add(OutVector &     dst,
   dst += tmp;
 }
 
+
+
+template <typename number>
+template <typename RowWorker>
+inline void
+SparseLUDecomposition<number>::apply_on_level_sets(
+  const std::vector<size_type> &level_start,
+  const std::vector<size_type> &level_rows,
+  const RowWorker &             worker) const
+{
+  for (size_type level = 0; level + 1 < level_start.size(); ++level)
+    parallel::apply_to_subranges(
+      level_start[level],
+      level_start[level + 1],
+      [&](const size_type begin, const size_type end) {
+        for (size_type i = begin; i < end; ++i)
+          worker(level_rows[i]);
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
 //---------------------------------------------------------------------------
 
 
@@ -420,11 +512,13 @@ SparseLUDecomposition<number>::AdditionalData::AdditionalData(
   const double           strengthen_diag,
   const unsigned int     extra_off_diag,
   const bool             use_prev_sparsity,
-  const SparsityPattern *use_this_spars)
+  const SparsityPattern *use_this_spars,
+  const bool             use_level_sched)
   : strengthen_diagonal(strengthen_diag)
   , extra_off_diagonals(extra_off_diag)
   , use_previous_sparsity(use_prev_sparsity)
   , use_this_sparsity(use_this_spars)
+  , use_level_scheduling(use_level_sched)
 {}
 
 
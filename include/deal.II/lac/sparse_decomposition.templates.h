@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -55,6 +56,11 @@ SparseLUDecomposition<number>::clear()
   std::vector<const size_type *> tmp;
   tmp.swap(prebuilt_lower_bound);
 
+  forward_level_start.clear();
+  forward_level_rows.clear();
+  backward_level_start.clear();
+  backward_level_rows.clear();
+
   SparseMatrix<number>::clear();
 
   if (own_sparsity)
@@ -131,6 +137,10 @@ SparseLUDecomposition<number>::initialize(
     std::vector<const size_type *> tmp;
     tmp.swap(prebuilt_lower_bound);
   }
+  forward_level_start.clear();
+  forward_level_rows.clear();
+  backward_level_start.clear();
+  backward_level_rows.clear();
   SparseMatrix<number>::reinit(*sparsity_pattern_to_use);
 }
 
@@ -157,6 +167,70 @@ SparseLUDecomposition<number>::prebuild_lower_bound()
     }
 }
 
+
+
+template <typename number>
+void
+SparseLUDecomposition<number>::prebuild_level_sets()
+{
+  const size_type *const column_numbers =
+    this->get_sparsity_pattern().colnums.get();
+  const std::size_t *const rowstart_indices =
+    this->get_sparsity_pattern().rowstart.get();
+  const size_type N = this->m();
+
+  Assert(prebuilt_lower_bound.size() == N, ExcNotInitialized());
+
+  std::vector<size_type> level(N);
+
+  // sort the rows by their level with a bucket sort, keeping the rows
+  // within each level in ascending order
+  const auto sort_rows_by_level = [&](std::vector<size_type> &level_start,
+                                      std::vector<size_type> &level_rows) {
+    const size_type n_levels =
+      (N > 0 ? *std::max_element(level.begin(), level.end()) + 1 : 0);
+    level_start.assign(n_levels + 1, 0);
+    for (size_type row = 0; row < N; ++row)
+      ++level_start[level[row] + 1];
+    std::partial_sum(level_start.begin(),
+                     level_start.end(),
+                     level_start.begin());
+
+    std::vector<size_type> next_position(level_start.begin(),
+                                         level_start.end() - 1);
+    level_rows.resize(N);
+    for (size_type row = 0; row < N; ++row)
+      level_rows[next_position[level[row]]++] = row;
+  };
+
+  // the forward substitution of a row uses the rows given by the columns
+  // left of the diagonal. these come after the diagonal element, which is
+  // stored first
+  for (size_type row = 0; row < N; ++row)
+    {
+      size_type row_level = 0;
+      for (const size_type *col = &column_numbers[rowstart_indices[row] + 1];
+           col != prebuilt_lower_bound[row];
+           ++col)
+        row_level = std::max(row_level, level[*col] + 1);
+      level[row] = row_level;
+    }
+  sort_rows_by_level(forward_level_start, forward_level_rows);
+
+  // the backward substitution uses the rows given by the columns right of
+  // the diagonal and runs from the last row to the first one
+  for (size_type row = N; row > 0; --row)
+    {
+      size_type row_level = 0;
+      for (const size_type *col = prebuilt_lower_bound[row - 1];
+           col != &column_numbers[rowstart_indices[row]];
+           ++col)
+        row_level = std::max(row_level, level[*col] + 1);
+      level[row - 1] = row_level;
+    }
+  sort_rows_by_level(backward_level_start, backward_level_rows);
+}
+
 template <typename number>
 template <typename somenumber>
 void
@@ -237,7 +311,11 @@ std::size_t
 SparseLUDecomposition<number>::memory_consumption() const
 {
   return (SparseMatrix<number>::memory_consumption() +
-          MemoryConsumption::memory_consumption(prebuilt_lower_bound));
+          MemoryConsumption::memory_consumption(prebuilt_lower_bound) +
+          MemoryConsumption::memory_consumption(forward_level_start) +
+          MemoryConsumption::memory_consumption(forward_level_rows) +
+          MemoryConsumption::memory_consumption(backward_level_start) +
+          MemoryConsumption::memory_consumption(backward_level_rows));
 }
 
 
@@ -69,6 +69,14 @@ namespace types
  * class provides an older interface, consisting of the functions factorize()
  * and solve(). Both interfaces are interchangeable.
  *
+ * When a sequence of matrices with the same sparsity pattern is to be
+ * factorized, for example the Jacobians of a Newton iteration, the function
+ * refactorize() can be used instead of factorize(). It reuses the symbolic
+ * analysis (i.e., the fill-reducing ordering and the structure of the
+ * factors) computed for the previous matrix and only recomputes the
+ * numerical factorization. Several right hand sides can be solved for at
+ * once with the solve() function taking a FullMatrix.
+ *
  * @note This class exists if the <a
  * href="http://faculty.cse.tamu.edu/davis/suitesparse.html">UMFPACK</a>
  * interface was not explicitly disabled during configuration.
@@ -153,6 +161,29 @@ public:
   void
   factorize(const Matrix &matrix);
 
+  /**
+   * Factorize a matrix with the same sparsity pattern as the one previously
+   * factorized by factorize() or refactorize(). Only the numerical
+   * factorization is computed, reusing the symbolic analysis of the previous
+   * call, which saves a significant part of the computing time for
+   * sequences of matrices with the same pattern, such as in Newton
+   * iterations.
+   *
+   * The function compares the sparsity pattern of @p matrix with that of the
+   * previous matrix, and falls back to a full factorize() if no previous
+   * factorization exists or the patterns differ. Note that the fill-reducing
+   * ordering of the symbolic analysis was chosen for the entries of the
+   * matrix given to factorize(); if those of @p matrix are very different,
+   * e.g., the pivoting leads to other choices, calling factorize() might
+   * result in a more efficient factorization.
+   *
+   * Like factorize(), this function copies the contents of the matrix into
+   * its own storage.
+   */
+  template <class Matrix>
+  void
+  refactorize(const Matrix &matrix);
+
   /**
    * Initialize memory and call SparseDirectUMFPACK::factorize.
    */
@@ -253,6 +284,16 @@ public:
   solve(BlockVector<double> &rhs_and_solution,
         const bool           transpose = false) const;
 
+  /**
+   * Same as before, but for several right hand side vectors given as the
+   * columns of @p rhs_and_solution, which must have as many rows as the
+   * matrix. The solutions will be returned in place of the right hand sides.
+   * The work arrays of UMFPACK are allocated only once for all columns.
+   */
+  void
+  solve(FullMatrix<double> &rhs_and_solution,
+        const bool          transpose = false) const;
+
   /**
    * Call the two functions factorize() and solve() in that order, i.e.
    * perform the whole solution process for the given right hand side vector.
@@ -344,6 +385,14 @@ private:
   void
   clear();
 
+  /**
+   * Copy the entries of @p matrix into the arrays Ap, Ai, and Ax in the
+   * format UMFPACK wants.
+   */
+  template <class Matrix>
+  void
+  copy_matrix_to_arrays(const Matrix &matrix);
+
   /**
    * Make sure that the arrays Ai and Ap are sorted in each row. UMFPACK wants
    * it this way. We need to have three versions of this function, one for the
@@ -1156,6 +1156,62 @@ public:
   void
   Tvmult_add(OutVector &dst, const InVector &src) const;
 
+  /**
+   * Matrix-vector multiplication restricted to the rows in the half-open
+   * range [@p begin_row, @p end_row): let <i>dst<sub>i</sub> =
+   * (M*src)<sub>i</sub></i> for these rows, or add the product to
+   * <i>dst<sub>i</sub></i> if @p add is true. All other entries of @p dst are
+   * left untouched.
+   *
+   * In contrast to vmult() and vmult_add(), this function does all of the
+   * work on the calling thread. It is meant as a building block for classes
+   * that schedule the products of several matrices themselves, like
+   * BlockSparseMatrix::vmult(), where it allows different threads to work on
+   * disjoint row ranges of the same destination vector without races.
+   *
+   * Source and destination must not be the same vector.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_on_subrange(OutVector &      dst,
+                    const InVector & src,
+                    const size_type  begin_row,
+                    const size_type  end_row,
+                    const bool       add = false) const;
+
+  /**
+   * Matrix-matrix multiplication with a dense matrix: let $dst = M*src$ with
+   * $M$ being this matrix. Each column of @p src and @p dst is interpreted
+   * as a vector, so that this function computes the matrix-vector products
+   * with several vectors at once. Since all the vectors are processed in a
+   * single pass over the rows of the matrix, each matrix entry and column
+   * index is loaded from memory only once, rather than once for each vector
+   * as when calling the other vmult() function repeatedly. Because the
+   * product is limited by the memory bandwidth, this is considerably faster,
+   * e.g., for block Krylov methods or when computing the action on several
+   * right hand sides.
+   *
+   * @p src must have as many rows as this matrix has columns, and @p dst as
+   * many rows as this matrix. Both need to have the same number of columns,
+   * i.e., vectors. The entries of $M$ are converted to @p number2 before the
+   * multiplication.
+   *
+   * Like the other vmult() function, this function works on the rows of the
+   * matrix in parallel.
+   */
+  template <typename number2>
+  void
+  vmult(FullMatrix<number2> &dst, const FullMatrix<number2> &src) const;
+
+  /**
+   * Adding matrix-matrix multiplication with a dense matrix: add $M*src$ to
+   * $dst$ with $M$ being this matrix. See the vmult() function taking
+   * FullMatrix arguments for details.
+   */
+  template <typename number2>
+  void
+  vmult_add(FullMatrix<number2> &dst, const FullMatrix<number2> &src) const;
+
   /**
    * Return the square of the norm of the vector $v$ with respect to the norm
    * induced by this matrix, i.e. $\left(v,Mv\right)$. This is useful, e.g. in
@@ -1700,6 +1756,16 @@ protected:
   prepare_set();
 
 private:
+  /**
+   * Implementation of the vmult() and vmult_add() functions taking FullMatrix
+   * arguments. If @p add is true, the result is added to @p dst.
+   */
+  template <typename number2>
+  void
+  vmult_multiple(FullMatrix<number2> &      dst,
+                 const FullMatrix<number2> &src,
+                 const bool                 add) const;
+
   /**
    * Pointer to the sparsity pattern used for this matrix. In order to
    * guarantee that it is not deleted while still in use, we subscribe to it
@@ -1732,6 +1798,10 @@ private:
   template <typename>
   friend class SparseILU;
 
+  // To allow adding the entries of cell matrices at precomputed positions.
+  template <typename>
+  friend class AffineConstraints;
+
   // To allow it calling private prepare_add() and prepare_set().
   template <typename>
   friend class BlockMatrixBase;
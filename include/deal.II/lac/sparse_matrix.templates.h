@@ -527,6 +527,42 @@ namespace internal
             *dst_ptr++ = s;
           }
     }
+
+
+
+    /**
+     * Perform a product of the matrix with the columns of the dense matrix
+     * @p src on a subinterval of the row indices. All columns of @p src are
+     * processed while traversing the row, so that each matrix entry is only
+     * loaded once.
+     */
+    template <typename number, typename number2>
+    void
+    vmult_multiple_on_subrange(const size_type            begin_row,
+                               const size_type            end_row,
+                               const number *             values,
+                               const std::size_t *        rowstart,
+                               const size_type *          colnums,
+                               const FullMatrix<number2> &src,
+                               FullMatrix<number2> &      dst,
+                               const bool                 add)
+    {
+      const size_type n_vectors = src.n();
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          number2 *const dst_row = &dst(row, 0);
+          if (add == false)
+            for (size_type c = 0; c < n_vectors; ++c)
+              dst_row[c] = number2();
+          for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+            {
+              const number2        a       = number2(values[j]);
+              const number2 *const src_row = &src(colnums[j], 0);
+              for (size_type c = 0; c < n_vectors; ++c)
+                dst_row[c] += a * src_row[c];
+            }
+        }
+    }
   } // namespace SparseMatrixImplementation
 } // namespace internal
 
@@ -850,6 +886,36 @@ SparseMatrix<number>::vmult_add(OutVector &dst, const InVector &src) const
 
 
 
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrix<number>::vmult_on_subrange(OutVector &      dst,
+                                        const InVector & src,
+                                        const size_type  begin_row,
+                                        const size_type  end_row,
+                                        const bool       add) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(val != nullptr, ExcNotInitialized());
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(begin_row <= end_row && end_row <= m(),
+         ExcIndexRange(end_row, begin_row, m() + 1));
+
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  internal::SparseMatrixImplementation::vmult_on_subrange(begin_row,
+                                                          end_row,
+                                                          val.get(),
+                                                          cols->rowstart.get(),
+                                                          cols->colnums.get(),
+                                                          src,
+                                                          dst,
+                                                          add);
+}
+
+
+
 template <typename number>
 template <class OutVector, class InVector>
 void
@@ -872,6 +938,70 @@ SparseMatrix<number>::Tvmult_add(OutVector &dst, const InVector &src) const
 }
 
 
+
+template <typename number>
+template <typename number2>
+void
+SparseMatrix<number>::vmult(FullMatrix<number2> &      dst,
+                            const FullMatrix<number2> &src) const
+{
+  vmult_multiple(dst, src, false);
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SparseMatrix<number>::vmult_add(FullMatrix<number2> &      dst,
+                                const FullMatrix<number2> &src) const
+{
+  vmult_multiple(dst, src, true);
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SparseMatrix<number>::vmult_multiple(FullMatrix<number2> &      dst,
+                                     const FullMatrix<number2> &src,
+                                     const bool                 add) const
+{
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(val != nullptr, ExcNotInitialized());
+  Assert(m() == dst.m(), ExcDimensionMismatch(m(), dst.m()));
+  Assert(n() == src.m(), ExcDimensionMismatch(n(), src.m()));
+  Assert(src.n() == dst.n(), ExcDimensionMismatch(src.n(), dst.n()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  if (src.n() == 0)
+    return;
+
+  // each row now involves src.n() times as much work, so reduce the grain
+  // size accordingly
+  const size_type grain_size = std::max<size_type>(
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+      src.n(),
+    1);
+
+  parallel::apply_to_subranges(
+    0U,
+    m(),
+    std::bind(&internal::SparseMatrixImplementation::
+                vmult_multiple_on_subrange<number, number2>,
+              std::placeholders::_1,
+              std::placeholders::_2,
+              val.get(),
+              cols->rowstart.get(),
+              cols->colnums.get(),
+              std::cref(src),
+              std::ref(dst),
+              add),
+    grain_size);
+}
+
+
 namespace internal
 {
   namespace SparseMatrixImplementation
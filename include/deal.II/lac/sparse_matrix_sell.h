@@ -0,0 +1,439 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_h
+#define dealii_sparse_matrix_sell_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+class SparsityPattern;
+template <typename number>
+class SparseMatrix;
+#endif
+
+/**
+ * @addtogroup Matrix1
+ * @{
+ */
+
+/**
+ * A sparse matrix stored in the sliced ELLPACK format with sorting, also
+ * known as SELL-C-$\sigma$. In contrast to the compressed row storage used
+ * by SparseMatrix, this format allows to perform matrix-vector products with
+ * the SIMD instructions of the processor, which makes better use of the
+ * memory bandwidth.
+ *
+ * The rows of the matrix are grouped into chunks of <i>C</i> rows, where
+ * <i>C</i> is the width of VectorizedArray, i.e., the number of elements
+ * that fit into one SIMD register (for example, 4 doubles with AVX2 or 8
+ * doubles with AVX-512). Within each chunk, the entries are stored column by
+ * column, i.e., the first entry of all <i>C</i> rows, then the second entry
+ * of all <i>C</i> rows, and so on, where shorter rows are padded with zeros
+ * up to the length of the longest row of the chunk. A matrix-vector product
+ * then processes all rows of a chunk at once with vectorized multiplications
+ * and gather operations for the source vector. To reduce the amount of
+ * padding, the rows within each window of $\sigma$ consecutive rows are
+ * sorted by their length before they are grouped into chunks. The order of
+ * the rows of the matrix as seen from the outside is not affected by this
+ * sorting.
+ *
+ * The matrix is set up from a SparsityPattern, either with all entries
+ * being zero by reinit() and then filled with set() and add(), or by copying
+ * both the sparsity pattern and the entries of a SparseMatrix with
+ * copy_from(). Once set up, the matrix provides the functions vmult(),
+ * Tvmult(), vmult_add(), Tvmult_add(), m(), n(), and el() and can therefore
+ * be used in place of a SparseMatrix in the linear solvers, e.g., SolverCG,
+ * and in PreconditionChebyshev. The function vmult() works on all rows in
+ * parallel, whereas Tvmult() works serially, as does SparseMatrix::Tvmult().
+ *
+ * The matrix-vector products are vectorized if the number type of the
+ * vectors is the same as the one of the matrix; otherwise, a scalar loop
+ * over the stored entries is used. The number of columns of the matrix
+ * must not exceed the range of <tt>unsigned int</tt>.
+ */
+template <typename number>
+class SparseMatrixSELL : public virtual Subscriptor
+{
+public:
+  /**
+   * Declare the type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = number;
+
+  /**
+   * The number of rows in each chunk, i.e., the width of the SIMD registers
+   * used in the matrix-vector products.
+   */
+  static const unsigned int chunk_size =
+    VectorizedArray<number>::n_array_elements;
+
+  /**
+   * Constructor. Create an empty matrix.
+   */
+  SparseMatrixSELL();
+
+  /**
+   * Constructor. Set up the matrix with the entries given by @p sparsity,
+   * all being zero. See reinit() for the meaning of @p sigma.
+   */
+  explicit SparseMatrixSELL(const SparsityPattern &sparsity,
+                            const unsigned int     sigma = 128);
+
+  /**
+   * Set up the matrix with the entries given by @p sparsity, all being
+   * zero. The rows are sorted by their length within windows of @p sigma
+   * rows, which is rounded up to a multiple of @p chunk_size. A value of
+   * one disables the sorting, and a value larger than the number of rows
+   * sorts all rows.
+   */
+  void
+  reinit(const SparsityPattern &sparsity, const unsigned int sigma = 128);
+
+  /**
+   * Set up the matrix with the sparsity pattern and the entries of
+   * @p matrix. See reinit() for the meaning of @p sigma.
+   */
+  template <typename number2>
+  void
+  copy_from(const SparseMatrix<number2> &matrix,
+            const unsigned int           sigma = 128);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return whether the matrix has no rows or no columns.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Return the number of rows of the matrix.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the number of columns of the matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of nonzero entries of the sparsity pattern, not
+   * counting the padding.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of stored entries including the padding of the
+   * chunks. The ratio of n_nonzero_elements() to this number measures the
+   * efficiency of the storage.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Set the entry (<i>i,j</i>) to @p value. The entry must be part of the
+   * sparsity pattern, unless @p value is zero.
+   */
+  void
+  set(const size_type i, const size_type j, const number value);
+
+  /**
+   * Add @p value to the entry (<i>i,j</i>). The entry must be part of the
+   * sparsity pattern, unless @p value is zero.
+   */
+  void
+  add(const size_type i, const size_type j, const number value);
+
+  /**
+   * Return the value of the entry (<i>i,j</i>), or zero if the entry is not
+   * part of the sparsity pattern.
+   */
+  number
+  el(const size_type i, const size_type j) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M*src$ with $M$ being this
+   * matrix.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M^T*src$ with $M$ being this
+   * matrix.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding matrix-vector multiplication: add $M*src$ to $dst$ with $M$ being
+   * this matrix.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding matrix-vector multiplication: add $M^T*src$ to $dst$ with $M$
+   * being this matrix.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * @addtogroup Exceptions
+   * @{
+   */
+
+  /**
+   * Exception
+   */
+  DeclException2(ExcInvalidIndex,
+                 size_type,
+                 size_type,
+                 << "You are trying to access the matrix entry with index <"
+                 << arg1 << ',' << arg2
+                 << ">, but this entry does not exist in the sparsity pattern "
+                    "of this matrix.");
+  //@}
+
+private:
+  /**
+   * The value returned by entry_index() for entries that are not part of
+   * the sparsity pattern.
+   */
+  static const std::size_t invalid_entry = static_cast<std::size_t>(-1);
+
+  /**
+   * Return the index of the slot holding the entry (<i>i,j</i>) in
+   * @p values, multiplied by @p chunk_size and shifted by the position of
+   * row <i>i</i> within its chunk, or @p invalid_entry if the entry is not
+   * part of the sparsity pattern.
+   */
+  std::size_t
+  entry_index(const size_type i, const size_type j) const;
+
+  /**
+   * Compute the matrix-vector product on the chunks in the range
+   * [@p begin_chunk, @p end_chunk). If @p add is true, the result is added
+   * to @p dst.
+   */
+  template <class OutVector, class InVector>
+  void
+  vmult_on_subrange(const unsigned int begin_chunk,
+                    const unsigned int end_chunk,
+                    OutVector &        dst,
+                    const InVector &   src,
+                    const bool         add) const;
+
+  /**
+   * Compute the transposed matrix-vector product and add it to @p dst.
+   */
+  template <class OutVector, class InVector>
+  void
+  Tvmult_add_serial(OutVector &dst, const InVector &src) const;
+
+  /**
+   * The number of rows of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * The number of columns of the matrix.
+   */
+  size_type n_cols;
+
+  /**
+   * The number of nonzero entries of the sparsity pattern.
+   */
+  std::size_t n_nonzeros;
+
+  /**
+   * The first slot of each chunk in @p values and, multiplied by
+   * @p chunk_size, in @p column_indices, with one additional entry for the
+   * end of the last chunk.
+   */
+  std::vector<std::size_t> chunk_start;
+
+  /**
+   * The entries of the matrix. Each element holds one entry of each of the
+   * @p chunk_size rows of a chunk.
+   */
+  AlignedVector<VectorizedArray<number>> values;
+
+  /**
+   * The column indices of the entries in @p values. The padding entries
+   * repeat the column index of the last entry of their row, such that the
+   * gather operations of the matrix-vector product access the source vector
+   * at positions that are already in cache.
+   */
+  std::vector<unsigned int> column_indices;
+
+  /**
+   * The number of entries of each row of the matrix, not counting the
+   * padding.
+   */
+  std::vector<unsigned int> row_lengths;
+
+  /**
+   * The row of the matrix stored at each position within the chunks, or
+   * numbers::invalid_unsigned_int for the positions of the last chunk that
+   * do not belong to any row.
+   */
+  std::vector<unsigned int> row_of_position;
+
+  /**
+   * The position within the chunks at which each row of the matrix is
+   * stored, i.e., the inverse of @p row_of_position.
+   */
+  std::vector<unsigned int> position_of_row;
+};
+
+/**
+ * @}
+ */
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename number>
+inline bool
+SparseMatrixSELL<number>::empty() const
+{
+  return n_rows == 0 || n_cols == 0;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_nonzero_elements() const
+{
+  return n_nonzeros;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_stored_elements() const
+{
+  return values.size() * chunk_size;
+}
+
+
+
+template <typename number>
+inline void
+SparseMatrixSELL<number>::set(const size_type i,
+                              const size_type j,
+                              const number    value)
+{
+  const std::size_t index = entry_index(i, j);
+  if (index != invalid_entry)
+    values[index / chunk_size][index % chunk_size] = value;
+  else
+    Assert(value == number(), ExcInvalidIndex(i, j));
+}
+
+
+
+template <typename number>
+inline void
+SparseMatrixSELL<number>::add(const size_type i,
+                              const size_type j,
+                              const number    value)
+{
+  const std::size_t index = entry_index(i, j);
+  if (index != invalid_entry)
+    values[index / chunk_size][index % chunk_size] += value;
+  else
+    Assert(value == number(), ExcInvalidIndex(i, j));
+}
+
+
+
+template <typename number>
+inline number
+SparseMatrixSELL<number>::el(const size_type i, const size_type j) const
+{
+  const std::size_t index = entry_index(i, j);
+  if (index != invalid_entry)
+    return values[index / chunk_size][index % chunk_size];
+  else
+    return number();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,444 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_templates_h
+#define dealii_sparse_matrix_sell_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace SparseMatrixSELLImplementation
+  {
+    /**
+     * Load the entries of @p src at the positions given by @p indices into a
+     * VectorizedArray. This is the general version that accesses the
+     * entries one by one.
+     */
+    template <typename number, typename VectorType>
+    inline VectorizedArray<number>
+    gather(const VectorType &src, const unsigned int *indices)
+    {
+      VectorizedArray<number> result;
+      for (unsigned int v = 0; v < VectorizedArray<number>::n_array_elements;
+           ++v)
+        result[v] = src(indices[v]);
+      return result;
+    }
+
+
+
+    /**
+     * Same as above, but for Vector, whose entries are contiguous in memory
+     * and can therefore be loaded with the gather instructions of the
+     * processor.
+     */
+    template <typename number>
+    inline VectorizedArray<number>
+    gather(const Vector<number> &src, const unsigned int *indices)
+    {
+      VectorizedArray<number> result;
+      result.gather(src.begin(), indices);
+      return result;
+    }
+  } // namespace SparseMatrixSELLImplementation
+} // namespace internal
+
+
+
+template <typename number>
+const unsigned int SparseMatrixSELL<number>::chunk_size;
+
+
+
+template <typename number>
+const std::size_t SparseMatrixSELL<number>::invalid_entry;
+
+
+
+template <typename number>
+SparseMatrixSELL<number>::SparseMatrixSELL()
+  : n_rows(0)
+  , n_cols(0)
+  , n_nonzeros(0)
+{}
+
+
+
+template <typename number>
+SparseMatrixSELL<number>::SparseMatrixSELL(const SparsityPattern &sparsity,
+                                           const unsigned int     sigma)
+  : SparseMatrixSELL()
+{
+  reinit(sparsity, sigma);
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::reinit(const SparsityPattern &sparsity,
+                                 const unsigned int     sigma)
+{
+  Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+  AssertThrow(sparsity.n_rows() < numbers::invalid_unsigned_int &&
+                sparsity.n_cols() < numbers::invalid_unsigned_int,
+              ExcMessage("The number of rows and columns of this matrix type "
+                         "must fit into an unsigned int."));
+
+  clear();
+
+  n_rows     = sparsity.n_rows();
+  n_cols     = sparsity.n_cols();
+  n_nonzeros = sparsity.n_nonzero_elements();
+
+  row_lengths.resize(n_rows);
+  for (unsigned int row = 0; row < n_rows; ++row)
+    row_lengths[row] = sparsity.row_length(row);
+
+  // sort the rows by decreasing length within windows of sigma rows, where
+  // the window size is a multiple of the chunk size. the stable sort keeps
+  // rows of the same length in their original order
+  const unsigned int n_chunks = (n_rows + chunk_size - 1) / chunk_size;
+  const std::size_t  window_size =
+    std::max<std::size_t>(chunk_size,
+                          (static_cast<std::size_t>(sigma) + chunk_size - 1) /
+                            chunk_size * chunk_size);
+  row_of_position.resize(static_cast<std::size_t>(n_chunks) * chunk_size,
+                         numbers::invalid_unsigned_int);
+  std::iota(row_of_position.begin(), row_of_position.begin() + n_rows, 0U);
+  for (std::size_t start = 0; start < n_rows; start += window_size)
+    std::stable_sort(row_of_position.begin() + start,
+                     row_of_position.begin() +
+                       std::min<std::size_t>(start + window_size, n_rows),
+                     [&](const unsigned int a, const unsigned int b) {
+                       return row_lengths[a] > row_lengths[b];
+                     });
+
+  position_of_row.resize(n_rows);
+  for (unsigned int position = 0; position < n_rows; ++position)
+    position_of_row[row_of_position[position]] = position;
+
+  // each chunk is as wide as its longest row
+  chunk_start.resize(n_chunks + 1);
+  chunk_start[0] = 0;
+  for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+    {
+      unsigned int width = 0;
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        {
+          const unsigned int row = row_of_position[chunk * chunk_size + v];
+          if (row != numbers::invalid_unsigned_int)
+            width = std::max(width, row_lengths[row]);
+        }
+      chunk_start[chunk + 1] = chunk_start[chunk] + width;
+    }
+
+  VectorizedArray<number> zero;
+  zero = number();
+  values.resize(chunk_start.back(), zero);
+  column_indices.resize(chunk_start.back() * chunk_size, 0);
+
+  for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+    for (unsigned int v = 0; v < chunk_size; ++v)
+      {
+        const unsigned int row = row_of_position[chunk * chunk_size + v];
+        if (row == numbers::invalid_unsigned_int)
+          continue;
+
+        unsigned int *column =
+          column_indices.data() + chunk_start[chunk] * chunk_size;
+        unsigned int last_column = 0;
+        for (std::size_t slot = 0;
+             slot < chunk_start[chunk + 1] - chunk_start[chunk];
+             ++slot)
+          {
+            if (slot < row_lengths[row])
+              last_column = sparsity.column_number(row, slot);
+            column[slot * chunk_size + v] = last_column;
+          }
+      }
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SparseMatrixSELL<number>::copy_from(const SparseMatrix<number2> &matrix,
+                                    const unsigned int           sigma)
+{
+  reinit(matrix.get_sparsity_pattern(), sigma);
+
+  // the entries of each row are stored in the same order as in the sparsity
+  // pattern, so we can copy them in one sweep
+  for (unsigned int row = 0; row < n_rows; ++row)
+    {
+      const unsigned int position = position_of_row[row];
+      const unsigned int chunk    = position / chunk_size;
+      const unsigned int v        = position % chunk_size;
+
+      std::size_t slot = chunk_start[chunk];
+      for (auto entry = matrix.begin(row); entry != matrix.end(row);
+           ++entry, ++slot)
+        values[slot][v] = entry->value();
+    }
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::clear()
+{
+  n_rows     = 0;
+  n_cols     = 0;
+  n_nonzeros = 0;
+  chunk_start.clear();
+  values.clear();
+  column_indices.clear();
+  row_lengths.clear();
+  row_of_position.clear();
+  position_of_row.clear();
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixSELL<number>::entry_index(const size_type i,
+                                      const size_type j) const
+{
+  AssertIndexRange(i, n_rows);
+  AssertIndexRange(j, n_cols);
+
+  const unsigned int position = position_of_row[i];
+  const unsigned int chunk    = position / chunk_size;
+  const unsigned int v        = position % chunk_size;
+  for (std::size_t slot = chunk_start[chunk];
+       slot < chunk_start[chunk] + row_lengths[i];
+       ++slot)
+    if (column_indices[slot * chunk_size + v] == j)
+      return slot * chunk_size + v;
+
+  return invalid_entry;
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::vmult_on_subrange(const unsigned int begin_chunk,
+                                            const unsigned int end_chunk,
+                                            OutVector &        dst,
+                                            const InVector &   src,
+                                            const bool         add) const
+{
+  using OutNumber = typename OutVector::value_type;
+
+  // only use the vectorized code path if no conversions between different
+  // number types are involved, otherwise compute with the precision of the
+  // destination vector like SparseMatrix::vmult()
+  const bool vectorize =
+    std::is_same<typename InVector::value_type, number>::value &&
+    std::is_same<OutNumber, number>::value;
+
+  for (unsigned int chunk = begin_chunk; chunk < end_chunk; ++chunk)
+    {
+      const VectorizedArray<number> *val = values.begin() + chunk_start[chunk];
+      const unsigned int *           column =
+        column_indices.data() + chunk_start[chunk] * chunk_size;
+      const unsigned int *rows  = row_of_position.data() + chunk * chunk_size;
+      const std::size_t   width = chunk_start[chunk + 1] - chunk_start[chunk];
+
+      if (vectorize)
+        {
+          VectorizedArray<number> sum;
+          sum = number();
+          for (std::size_t slot = 0; slot < width; ++slot)
+            sum += val[slot] *
+                   internal::SparseMatrixSELLImplementation::gather<number>(
+                     src, column + slot * chunk_size);
+
+          for (unsigned int v = 0; v < chunk_size; ++v)
+            if (rows[v] != numbers::invalid_unsigned_int)
+              {
+                if (add)
+                  dst(rows[v]) += sum[v];
+                else
+                  dst(rows[v]) = sum[v];
+              }
+        }
+      else
+        for (unsigned int v = 0; v < chunk_size; ++v)
+          if (rows[v] != numbers::invalid_unsigned_int)
+            {
+              OutNumber sum = OutNumber();
+              for (std::size_t slot = 0; slot < row_lengths[rows[v]]; ++slot)
+                sum += OutNumber(val[slot][v]) *
+                       OutNumber(src(column[slot * chunk_size + v]));
+              if (add)
+                dst(rows[v]) += sum;
+              else
+                dst(rows[v]) = sum;
+            }
+    }
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::Tvmult_add_serial(OutVector &     dst,
+                                            const InVector &src) const
+{
+  using OutNumber = typename OutVector::value_type;
+
+  for (unsigned int chunk = 0; chunk + 1 < chunk_start.size(); ++chunk)
+    {
+      const unsigned int *rows = row_of_position.data() + chunk * chunk_size;
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        if (rows[v] != numbers::invalid_unsigned_int)
+          {
+            const OutNumber src_row = OutNumber(src(rows[v]));
+            for (std::size_t slot = chunk_start[chunk];
+                 slot < chunk_start[chunk] + row_lengths[rows[v]];
+                 ++slot)
+              dst(column_indices[slot * chunk_size + v]) +=
+                OutNumber(values[slot][v]) * src_row;
+          }
+    }
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::vmult(OutVector &dst, const InVector &src) const
+{
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst),
+         ExcMessage("The source and destination vectors of a matrix-vector "
+                    "product must be different objects."));
+
+  // the rows of each chunk are written by one task only, so the chunks can
+  // be processed in parallel
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>((n_rows + chunk_size - 1) / chunk_size),
+    [&](const unsigned int begin_chunk, const unsigned int end_chunk) {
+      vmult_on_subrange(begin_chunk, end_chunk, dst, src, false);
+    },
+    std::max(1U,
+             internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+               chunk_size));
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::vmult_add(OutVector &dst, const InVector &src) const
+{
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst),
+         ExcMessage("The source and destination vectors of a matrix-vector "
+                    "product must be different objects."));
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>((n_rows + chunk_size - 1) / chunk_size),
+    [&](const unsigned int begin_chunk, const unsigned int end_chunk) {
+      vmult_on_subrange(begin_chunk, end_chunk, dst, src, true);
+    },
+    std::max(1U,
+             internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+               chunk_size));
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::Tvmult(OutVector &dst, const InVector &src) const
+{
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst),
+         ExcMessage("The source and destination vectors of a matrix-vector "
+                    "product must be different objects."));
+
+  dst = 0;
+  Tvmult_add_serial(dst, src);
+}
+
+
+
+template <typename number>
+template <class OutVector, class InVector>
+void
+SparseMatrixSELL<number>::Tvmult_add(OutVector &dst, const InVector &src) const
+{
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst),
+         ExcMessage("The source and destination vectors of a matrix-vector "
+                    "product must be different objects."));
+
+  Tvmult_add_serial(dst, src);
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixSELL<number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(chunk_start) +
+         MemoryConsumption::memory_consumption(values) +
+         MemoryConsumption::memory_consumption(column_indices) +
+         MemoryConsumption::memory_consumption(row_lengths) +
+         MemoryConsumption::memory_consumption(row_of_position) +
+         MemoryConsumption::memory_consumption(position_of_row);
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -77,6 +77,8 @@ SparseMIC<number>::initialize(const SparseMatrix<somenumber> &matrix,
   SparseLUDecomposition<number>::initialize(matrix, data);
   this->strengthen_diagonal = data.strengthen_diagonal;
   this->prebuild_lower_bound();
+  if (data.use_level_scheduling)
+    this->prebuild_level_sets();
   this->copy_from(matrix);
 
   Assert(this->m() == this->n(), ExcNotQuadratic());
@@ -158,38 +160,56 @@ SparseMIC<number>::vmult(Vector<somenumber> &      dst,
   //
   // Solve (X-L)X{-1}(X-U) x = b in 3 steps:
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      // Now: (X-L)u = b
-
-      // get start of this row. skip
-      // the diagonal element
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           (p != this->end(row)) && (p->column() < row);
-           ++p)
-        dst(row) -= p->value() * dst(p->column());
-
-      dst(row) *= inv_diag[row];
-    }
+  const auto forward_row = [&](const size_type row) {
+    // Now: (X-L)u = b
+
+    // get start of this row. skip
+    // the diagonal element
+    somenumber dst_row = dst(row);
+    for (typename SparseMatrix<number>::const_iterator p =
+           this->begin(row) + 1;
+         (p != this->end(row)) && (p->column() < row);
+         ++p)
+      dst_row -= p->value() * dst(p->column());
+
+    dst(row) = dst_row * inv_diag[row];
+  };
+
+  // if level sets are available, all rows of one level only depend on rows
+  // of previous levels and can be worked on in parallel
+  if (this->forward_level_start.empty())
+    for (size_type row = 0; row < N; ++row)
+      forward_row(row);
+  else
+    this->apply_on_level_sets(this->forward_level_start,
+                              this->forward_level_rows,
+                              forward_row);
 
   // Now: v = Xu
   for (size_type row = 0; row < N; row++)
     dst(row) *= diag[row];
 
   // x = (X-U)v
-  for (int row = N - 1; row >= 0; --row)
-    {
-      // get end of this row
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           p != this->end(row);
-           ++p)
-        if (p->column() > static_cast<size_type>(row))
-          dst(row) -= p->value() * dst(p->column());
-
-      dst(row) *= inv_diag[row];
-    }
+  const auto backward_row = [&](const size_type row) {
+    // get end of this row
+    somenumber dst_row = dst(row);
+    for (typename SparseMatrix<number>::const_iterator p =
+           this->begin(row) + 1;
+         p != this->end(row);
+         ++p)
+      if (p->column() > row)
+        dst_row -= p->value() * dst(p->column());
+
+    dst(row) = dst_row * inv_diag[row];
+  };
+
+  if (this->backward_level_start.empty())
+    for (size_type row = N; row > 0; --row)
+      backward_row(row - 1);
+  else
+    this->apply_on_level_sets(this->backward_level_start,
+                              this->backward_level_rows,
+                              backward_row);
 }
 
 
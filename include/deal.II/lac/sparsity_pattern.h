@@ -46,6 +46,7 @@ DEAL_II_NAMESPACE_OPEN
 class SparsityPattern;
 class SparsityPatternBase;
 class DynamicSparsityPattern;
+class CompactDynamicSparsityPattern;
 class ChunkSparsityPattern;
 template <typename number>
 class FullMatrix;
@@ -1110,6 +1111,14 @@ public:
   void
   copy_from(const DynamicSparsityPattern &dsp);
 
+  /**
+   * Copy data from a CompactDynamicSparsityPattern, which must have been
+   * compressed. Previous content of this object is lost, and the sparsity
+   * pattern is in compressed mode afterwards.
+   */
+  void
+  copy_from(const CompactDynamicSparsityPattern &dsp);
+
   /**
    * Copy data from a SparsityPattern. Previous content of this object is
    * lost, and the sparsity pattern is in compressed mode afterwards.
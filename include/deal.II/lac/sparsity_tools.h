@@ -116,6 +116,13 @@ namespace SparsityTools
    * @note If the @p cell_weights vector is empty, then no weighting is taken
    * into consideration. If not then the size of this vector must equal to the
    * number of active cells in the triangulation.
+   *
+   * When METIS is used, the vector @p cell_weights may also contain several
+   * weights per node, stored node by node, i.e., its size may be a multiple
+   * $n_c$ of the number of rows of the sparsity pattern, with the weights
+   * of node $i$ at positions $i n_c$ to $(i+1) n_c-1$. METIS then balances
+   * all $n_c$ weights at the same time, e.g., both the number of cells and
+   * the number of particles in each partition.
    */
   void
   partition(const SparsityPattern &          sparsity_pattern,
@@ -1403,7 +1403,9 @@ namespace TrilinosWrappers
                      const unsigned int smoother_overlap = 0,
                      const bool         output_details   = false,
                      const char *       smoother_type    = "Chebyshev",
-                     const char *       coarse_type      = "Amesos-KLU");
+                     const char *       coarse_type      = "Amesos-KLU",
+                     const unsigned int max_hierarchy_reuses =
+                       numbers::invalid_unsigned_int);
 
       /**
        * Fill in a @p parameter_list that can be used to initialize the
@@ -1598,6 +1600,17 @@ namespace TrilinosWrappers
        * settings as for the smoother type are possible.
        */
       const char *coarse_type;
+
+      /**
+       * The number of calls to PreconditionAMG::reinit_values() that keep
+       * the aggregates of the multilevel hierarchy before the next call
+       * builds the hierarchy from scratch. Recomputing the aggregates from
+       * time to time avoids a deterioration of the coarse spaces when the
+       * matrix entries change considerably, e.g. over many time steps. The
+       * default value numbers::invalid_unsigned_int keeps the aggregates as
+       * long as reinit_values() is called.
+       */
+      unsigned int max_hierarchy_reuses;
     };
 
     /**
@@ -1694,6 +1707,23 @@ namespace TrilinosWrappers
     void
     reinit();
 
+    /**
+     * Update the preconditioner after the entries of @p matrix have
+     * changed while its sparsity pattern has remained the same, as is
+     * typical for time-dependent problems. @p matrix must be the matrix
+     * that the preconditioner has been initialized with. The aggregates of
+     * the multilevel hierarchy are kept, and only the prolongation
+     * operators, the Galerkin coarse-level matrices and the smoothers are
+     * recomputed as in reinit().
+     *
+     * If the preconditioner has been initialized with an AdditionalData
+     * object, the call following AdditionalData::max_hierarchy_reuses calls
+     * that kept the aggregates instead builds the whole hierarchy from
+     * scratch with the settings given to initialize().
+     */
+    void
+    reinit_values(const SparseMatrix &matrix);
+
     /**
      * Destroys the preconditioner, leaving an object like just after having
      * called the constructor.
@@ -1712,6 +1742,20 @@ namespace TrilinosWrappers
      * A copy of the deal.II matrix into Trilinos format.
      */
     std::shared_ptr<SparseMatrix> trilinos_matrix;
+
+    /**
+     * A copy of the settings the multilevel hierarchy has been built with,
+     * used by reinit_values() to rebuild the hierarchy. The pointer is empty
+     * if the preconditioner has been initialized with a
+     * Teuchos::ParameterList.
+     */
+    std::shared_ptr<AdditionalData> hierarchy_data;
+
+    /**
+     * The number of calls to reinit_values() since the multilevel hierarchy
+     * has last been built from scratch.
+     */
+    unsigned int n_hierarchy_reuses;
   };
 
 
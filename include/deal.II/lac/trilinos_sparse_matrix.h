@@ -1411,6 +1411,45 @@ namespace TrilinosWrappers
         const bool            elide_zero_values      = true,
         const bool            col_indices_are_sorted = false);
 
+    /**
+     * Compute the positions of the entries of a local matrix with rows
+     * @p row_indices and columns @p col_indices within the arrays that store
+     * the values of this matrix, for use with add_at_positions(). The
+     * positions are written to @p entry_positions in the row-major order of
+     * the local matrix.
+     *
+     * When a matrix is assembled many times on the same sparsity pattern,
+     * e.g. for the Jacobian in a nonlinear or time-dependent problem, the
+     * positions can be computed once for all cells and stored. Each
+     * subsequent assembly then adds the local matrices directly into the
+     * value arrays, without translating global indices to local ones and
+     * searching the columns in each row as add() does.
+     *
+     * The matrix must have been compressed after its sparsity pattern was
+     * set, and the positions remain valid until the matrix is reinitialized.
+     * Rows that are not locally owned must be part of the writable rows
+     * given to the TrilinosWrappers::SparsityPattern the matrix was
+     * initialized with, as their entries are stored in a separate matrix that
+     * is sent to the owners in compress(). Like add(), this function throws
+     * an exception if an entry does not exist in the sparsity pattern.
+     */
+    void
+    compute_entry_positions(
+      const std::vector<size_type> &row_indices,
+      const std::vector<size_type> &col_indices,
+      std::vector<std::size_t> &    entry_positions) const;
+
+    /**
+     * Add the elements of @p full_matrix to the entries of this matrix at the
+     * positions computed by compute_entry_positions() for the rows and
+     * columns of the local matrix. As for the other add() functions, the
+     * matrix must be compressed with VectorOperation::add afterwards, which
+     * sends the contributions to rows owned by other processors.
+     */
+    void
+    add_at_positions(const std::vector<std::size_t> &  entry_positions,
+                     const FullMatrix<TrilinosScalar> &full_matrix);
+
     /**
      * Multiply the entire matrix by a fixed factor.
      */
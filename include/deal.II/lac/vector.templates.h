@@ -702,7 +702,10 @@ Vector<Number>::equ(const Number a, const Vector<Number> &u)
   Assert(size() == u.size(), ExcDimensionMismatch(size(), u.size()));
 
   internal::VectorOperations::Vectorization_equ_au<Number> vector_equ(
-    values.begin(), u.values.begin(), a);
+    values.begin(),
+    u.values.begin(),
+    a,
+    internal::VectorOperations::use_streaming_stores<Number>(size()));
   internal::VectorOperations::parallel_for(vector_equ,
                                            0,
                                            size(),
@@ -745,7 +748,10 @@ Vector<Number>::ratio(const Vector<Number> &a, const Vector<Number> &b)
   reinit(a.size(), true);
 
   internal::VectorOperations::Vectorization_ratio<Number> vector_ratio(
-    values.begin(), a.begin(), b.begin());
+    values.begin(),
+    a.begin(),
+    b.begin(),
+    internal::VectorOperations::use_streaming_stores<Number>(size()));
   internal::VectorOperations::parallel_for(vector_ratio,
                                            0,
                                            size(),
@@ -1035,11 +1041,12 @@ Vector<Number>::do_reinit(const size_type new_size,
     }
   else
     {
-      // otherwise size() < new_size and we must allocate
+      // otherwise size() < new_size and we must allocate. resize_fast()
+      // sets the newly allocated memory to zero in parallel, which places
+      // the memory pages close to the threads that work on them later on
+      // NUMA systems, so there is no need for another pass over the memory
       AlignedVector<Number> new_values;
       new_values.resize_fast(new_size);
-      if (!omit_zeroing_entries)
-        new_values.fill();
       new_values.swap(values);
     }
 
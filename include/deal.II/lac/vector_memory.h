@@ -21,10 +21,12 @@
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/vector.h>
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -135,6 +137,24 @@ public:
   virtual VectorType *
   alloc() = 0;
 
+  /**
+   * Return a pointer to a new vector that has the same layout as @p model,
+   * i.e., the same size, subdivision into blocks, and parallel partitioning,
+   * as if it had been set up by calling <code>reinit(model, true)</code>.
+   * The contents of the vector are unspecified.
+   *
+   * The default implementation calls alloc() and then reinitializes the
+   * vector. Derived classes may use the information about the layout to
+   * hand out a vector that already has the right layout, which avoids the
+   * cost of setting up the vector again.
+   *
+   * @warning The same remarks as for alloc() apply: You should consider
+   *   using the VectorMemory::Pointer class instead of calling this
+   *   function and free() explicitly.
+   */
+  virtual VectorType *
+  alloc_like(const VectorType &model);
+
   /**
    * Return a vector and indicate that it is not going to be used any further
    * by the place that called alloc() to get a pointer to it.
@@ -221,6 +241,13 @@ public:
      */
     Pointer(VectorMemory<VectorType> &mem);
 
+    /**
+     * Constructor. This constructor automatically allocates a vector from
+     * the given vector memory object @p mem that has the same layout as
+     * @p model, using VectorMemory::alloc_like().
+     */
+    Pointer(VectorMemory<VectorType> &mem, const VectorType &model);
+
     /**
      * Destructor, automatically releasing the vector from the memory #pool.
      */
@@ -314,6 +341,19 @@ public:
  * of creating a new memory pool every time. A drawback of this policy is that
  * vectors once allocated are only released at the end of the program run.
  *
+ * The global pool consists of a separate list of vectors for each thread,
+ * and alloc() and free() only access the list of the calling thread.
+ * Solvers running concurrently on different threads, for example from
+ * different tasks, therefore do not compete for the pool. (A vector may
+ * still be returned by another thread than the one that allocated it, in
+ * which case free() has to search the lists of all threads.) Furthermore,
+ * alloc_like() prefers unused vectors whose layout, i.e., size and parallel
+ * partitioning, already matches the one of the given model vector, so
+ * that solvers working with vectors of different layouts do not have to
+ * reinitialize the vectors they get from the pool each time. The number of
+ * times a suitable vector was found in the pool is available through
+ * n_hits() and n_misses().
+ *
  * @author Guido Kanschat, 1999, 2007; Wolfgang Bangerth, 2017.
  */
 template <typename VectorType = dealii::Vector<double>>
@@ -381,12 +421,37 @@ public:
   virtual void
   free(const VectorType *const) override;
 
+  /**
+   * Return a pointer to a new vector that has the same layout as @p model.
+   * An unused vector of the calling thread that already has this layout is
+   * preferred, otherwise an arbitrary unused vector is reinitialized, or a
+   * new vector is created.
+   */
+  virtual VectorType *
+  alloc_like(const VectorType &model) override;
+
   /**
    * Release all vectors that are not currently in use.
    */
   static void
   release_unused_memory();
 
+  /**
+   * Return the number of calls to alloc() and alloc_like() of this object
+   * that could be served by an unused vector of the pool, in the case of
+   * alloc_like() by one that already had the requested layout.
+   */
+  size_type
+  n_hits() const;
+
+  /**
+   * Return the number of calls to alloc() and alloc_like() of this object
+   * that had to create a new vector or, in the case of alloc_like(), to
+   * reinitialize a vector with a different layout.
+   */
+  size_type
+  n_misses() const;
+
   /**
    * Memory consumed by this class and all currently allocated vectors.
    */
@@ -402,6 +467,24 @@ private:
    */
   using entry_type = std::pair<bool, std::unique_ptr<VectorType>>;
 
+  /**
+   * The vectors of the memory pool owned by one thread.
+   */
+  struct ThreadPool
+  {
+    /**
+     * Mutex to synchronize the access of the owning thread with the rare
+     * accesses of other threads, which is therefore not contended in
+     * general.
+     */
+    Threads::Mutex mutex;
+
+    /**
+     * The vectors of this thread.
+     */
+    std::vector<entry_type> data;
+  };
+
   /**
    * The class providing the actual storage for the memory pool.
    *
@@ -419,20 +502,29 @@ private:
     Pool();
 
     /**
-     * Destructor.
+     * Create @p size vectors in the pool of the calling thread; does nothing
+     * if the pool of the calling thread already contains vectors.
      */
-    ~Pool();
+    void
+    initialize(const size_type size);
 
     /**
-     * Create data vector; does nothing after first initialization
+     * Return the pool of the calling thread, creating it upon the first
+     * call on a thread.
      */
-    void
-    initialize(const size_type size);
+    ThreadPool &
+    get_thread_pool();
 
     /**
-     * Pointer to the storage object
+     * The pools of all threads that have used this object so far. Access
+     * is guarded by GrowingVectorMemory::mutex.
      */
-    std::vector<entry_type> *data;
+    std::vector<std::unique_ptr<ThreadPool>> thread_pools;
+
+    /**
+     * A pointer to the element of @p thread_pools belonging to each thread.
+     */
+    Threads::ThreadLocalStorage<ThreadPool *> thread_pool;
   };
 
   /**
@@ -445,13 +537,19 @@ private:
    * Overall number of allocations. Only used for bookkeeping and to generate
    * output at the end of an object's lifetime.
    */
-  size_type total_alloc;
+  std::atomic<size_type> total_alloc;
 
   /**
    * Number of vectors currently allocated in this object; used for detecting
    * memory leaks.
    */
-  size_type current_alloc;
+  std::atomic<size_type> current_alloc;
+
+  /**
+   * Number of allocations that could be served by a suitable vector of the
+   * pool.
+   */
+  std::atomic<size_type> hits;
 
   /**
    * A flag controlling the logging of statistics by the destructor.
@@ -459,8 +557,7 @@ private:
   bool log_statistics;
 
   /**
-   * Mutex to synchronize access to internal data of this object from multiple
-   * threads.
+   * Mutex to synchronize the access to the list of pools of all threads.
    */
   static Threads::Mutex mutex;
 };
@@ -473,7 +570,91 @@ namespace internal
   {
     void
     release_all_unused_memory();
-  }
+
+    /**
+     * A vector that an object keeps for the intermediate results of its
+     * operations, such as the intermediate vector of the composition of two
+     * LinearOperator objects. In contrast to obtaining a vector from
+     * GrowingVectorMemory in every operation, this avoids the access to the
+     * pool, and the vector keeps its size and layout between the
+     * operations, so that it is not reallocated when the pool hands out
+     * vectors of different sizes in turn.
+     *
+     * The TemporaryVector object is usually shared by the copies of the
+     * object owning it, which may be used recursively or by several threads
+     * at the same time. Therefore, the vector can only be used by one
+     * Pointer object at a time; a Pointer created while the vector is in use
+     * obtains its vector from GrowingVectorMemory instead.
+     */
+    template <typename VectorType>
+    class TemporaryVector
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      TemporaryVector();
+
+      /**
+       * A pointer to the vector of a TemporaryVector object, or to a vector
+       * of GrowingVectorMemory if the former is in use, for the lifetime of
+       * the Pointer object. The size and the content of the vector are
+       * unspecified, i.e., the vector needs to be reinitialized before use.
+       */
+      class Pointer
+      {
+      public:
+        /**
+         * Constructor. Acquire the vector of @p storage.
+         */
+        Pointer(TemporaryVector<VectorType> &storage);
+
+        /**
+         * Destructor. Release the vector again.
+         */
+        ~Pointer();
+
+        /**
+         * Dereferencing operator.
+         */
+        VectorType &operator*() const;
+
+        /**
+         * Dereferencing operator.
+         */
+        VectorType *operator->() const;
+
+      private:
+        /**
+         * The object whose vector is used.
+         */
+        TemporaryVector<VectorType> &storage;
+
+        /**
+         * The memory pool and the vector obtained from it if the vector of
+         * #storage is in use.
+         */
+        std::unique_ptr<GrowingVectorMemory<VectorType>> memory;
+        typename VectorMemory<VectorType>::Pointer       pool_vector;
+
+        /**
+         * The vector this object points to.
+         */
+        VectorType *vector;
+      };
+
+    private:
+      /**
+       * The vector.
+       */
+      VectorType vector;
+
+      /**
+       * Whether the vector is currently used by a Pointer object.
+       */
+      std::atomic<bool> in_use;
+    };
+  } // namespace GrowingVectorMemoryImplementation
 } // namespace internal
 
 /*@}*/
@@ -491,6 +672,81 @@ inline VectorMemory<VectorType>::Pointer::Pointer(VectorMemory<VectorType> &mem)
 
 
 
+template <typename VectorType>
+inline VectorMemory<VectorType>::Pointer::Pointer(VectorMemory<VectorType> &mem,
+                                                  const VectorType &model)
+  : std::unique_ptr<VectorType, std::function<void(VectorType *)>>(
+      mem.alloc_like(model),
+      [&mem](VectorType *v) { mem.free(v); })
+{}
+
+
+
+namespace internal
+{
+  namespace GrowingVectorMemoryImplementation
+  {
+    template <typename VectorType>
+    inline TemporaryVector<VectorType>::TemporaryVector()
+      : in_use(false)
+    {}
+
+
+
+    template <typename VectorType>
+    inline TemporaryVector<VectorType>::Pointer::Pointer(
+      TemporaryVector<VectorType> &storage)
+      : storage(storage)
+      , vector(&storage.vector)
+    {
+      if (storage.in_use.exchange(true, std::memory_order_acquire))
+        {
+          memory.reset(new GrowingVectorMemory<VectorType>());
+          pool_vector = typename VectorMemory<VectorType>::Pointer(*memory);
+          vector      = pool_vector.get();
+        }
+    }
+
+
+
+    template <typename VectorType>
+    inline TemporaryVector<VectorType>::Pointer::~Pointer()
+    {
+      if (vector == &storage.vector)
+        storage.in_use.store(false, std::memory_order_release);
+    }
+
+
+
+    template <typename VectorType>
+    inline VectorType &TemporaryVector<VectorType>::Pointer::operator*() const
+    {
+      return *vector;
+    }
+
+
+
+    template <typename VectorType>
+    inline VectorType *TemporaryVector<VectorType>::Pointer::operator->() const
+    {
+      return vector;
+    }
+  } // namespace GrowingVectorMemoryImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+VectorType *
+VectorMemory<VectorType>::alloc_like(const VectorType &model)
+{
+  VectorType *v = alloc();
+  v->reinit(model, true);
+  return v;
+}
+
+
+
 template <typename VectorType>
 VectorType *
 PrimitiveVectorMemory<VectorType>::alloc()
@@ -20,11 +20,48 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace internal
+{
+  namespace GrowingVectorMemoryImplementation
+  {
+    /**
+     * Return a key that describes the layout of a vector, such that two
+     * vectors with the same key can be reinitialized with the layout of the
+     * other one without allocating memory. In general, this is the size of
+     * the vector.
+     */
+    template <typename VectorType>
+    std::pair<const void *, types::global_dof_index>
+    layout_key(const VectorType &v)
+    {
+      return std::make_pair(nullptr, v.size());
+    }
+
+
+
+    /**
+     * Same as above, but for LinearAlgebra::distributed::Vector, whose
+     * layout is described by the partitioner object it is set up with.
+     */
+    template <typename Number, typename MemorySpace>
+    std::pair<const void *, types::global_dof_index>
+    layout_key(const LinearAlgebra::distributed::Vector<Number, MemorySpace> &v)
+    {
+      return std::make_pair(v.get_partitioner().get(), v.size());
+    }
+  } // namespace GrowingVectorMemoryImplementation
+} // namespace internal
+
+
+
 template <typename VectorType>
 typename GrowingVectorMemory<VectorType>::Pool &
 GrowingVectorMemory<VectorType>::get_pool()
@@ -42,41 +79,36 @@ Threads::Mutex GrowingVectorMemory<VectorType>::mutex;
 
 template <typename VectorType>
 inline GrowingVectorMemory<VectorType>::Pool::Pool()
-  : data(nullptr)
+  : thread_pool(nullptr)
 {}
 
 
 
 template <typename VectorType>
-inline GrowingVectorMemory<VectorType>::Pool::~Pool()
+inline typename GrowingVectorMemory<VectorType>::ThreadPool &
+GrowingVectorMemory<VectorType>::Pool::get_thread_pool()
 {
-  // Nothing to do if memory was unused.
-  if (data == nullptr)
-    return;
-
-  // delete the 'data' object. this also releases all vectors
-  // that are pointed to by the std::unique_ptrs
-  data->clear();
-  delete data;
+  ThreadPool *&pool = thread_pool.get();
+  if (pool == nullptr)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      thread_pools.push_back(std_cxx14::make_unique<ThreadPool>());
+      pool = thread_pools.back().get();
+    }
+  return *pool;
 }
 
 
+
 template <typename VectorType>
 inline void
 GrowingVectorMemory<VectorType>::Pool::initialize(const size_type size)
 {
-  if (data == nullptr)
-    {
-      data = new std::vector<entry_type>(size);
-
-      for (typename std::vector<entry_type>::iterator i = data->begin();
-           i != data->end();
-           ++i)
-        {
-          i->first  = false;
-          i->second = std_cxx14::make_unique<VectorType>();
-        }
-    }
+  ThreadPool &                pool = get_thread_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  if (pool.data.empty())
+    for (size_type i = 0; i < size; ++i)
+      pool.data.emplace_back(false, std_cxx14::make_unique<VectorType>());
 }
 
 
@@ -87,9 +119,9 @@ inline GrowingVectorMemory<VectorType>::GrowingVectorMemory(
 
   : total_alloc(0)
   , current_alloc(0)
+  , hits(0)
   , log_statistics(log_statistics)
 {
-  std::lock_guard<std::mutex> lock(mutex);
   get_pool().initialize(initial_size);
 }
 
@@ -101,10 +133,21 @@ inline GrowingVectorMemory<VectorType>::~GrowingVectorMemory()
                 StandardExceptions::ExcMemoryLeak(current_alloc));
   if (log_statistics)
     {
+      std::size_t n_vectors = 0;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &pool : get_pool().thread_pools)
+          {
+            std::lock_guard<std::mutex> pool_lock(pool->mutex);
+            n_vectors += pool->data.size();
+          }
+      }
       deallog << "GrowingVectorMemory:Overall allocated vectors: "
               << total_alloc << std::endl;
       deallog << "GrowingVectorMemory:Maximum allocated vectors: "
-              << get_pool().data->size() << std::endl;
+              << n_vectors << std::endl;
+      deallog << "GrowingVectorMemory:Pool hits: " << n_hits()
+              << ", misses: " << n_misses() << std::endl;
     }
 }
 
@@ -114,48 +157,104 @@ template <typename VectorType>
 inline VectorType *
 GrowingVectorMemory<VectorType>::alloc()
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ThreadPool &                pool = get_pool().get_thread_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
 
   ++total_alloc;
   ++current_alloc;
   // see if there is a free vector
   // available in our list
-  for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
-       i != get_pool().data->end();
-       ++i)
-    {
-      if (i->first == false)
-        {
-          i->first = true;
-          return i->second.get();
-        }
-    }
+  for (entry_type &entry : pool.data)
+    if (entry.first == false)
+      {
+        ++hits;
+        entry.first = true;
+        return entry.second.get();
+      }
 
   // no free vector found, so let's just allocate a new one
-  get_pool().data->emplace_back(
-    entry_type(true, std_cxx14::make_unique<VectorType>()));
+  pool.data.emplace_back(true, std_cxx14::make_unique<VectorType>());
 
-  return get_pool().data->back().second.get();
+  return pool.data.back().second.get();
 }
 
 
 
 template <typename VectorType>
-inline void
-GrowingVectorMemory<VectorType>::free(const VectorType *const v)
+inline VectorType *
+GrowingVectorMemory<VectorType>::alloc_like(const VectorType &model)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  ThreadPool &                pool = get_pool().get_thread_pool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+
+  ++total_alloc;
+  ++current_alloc;
 
-  for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
-       i != get_pool().data->end();
-       ++i)
+  // look for a free vector that already has the right layout, and remember
+  // the first free vector in case we do not find one
+  const auto key =
+    internal::GrowingVectorMemoryImplementation::layout_key(model);
+  entry_type *free_entry = nullptr;
+  for (entry_type &entry : pool.data)
+    if (entry.first == false)
+      {
+        if (internal::GrowingVectorMemoryImplementation::layout_key(
+              *entry.second) == key)
+          {
+            ++hits;
+            free_entry = &entry;
+            break;
+          }
+        else if (free_entry == nullptr)
+          free_entry = &entry;
+      }
+
+  if (free_entry == nullptr)
     {
-      if (v == i->second.get())
+      pool.data.emplace_back(false, std_cxx14::make_unique<VectorType>());
+      free_entry = &pool.data.back();
+    }
+
+  // even if the layout matches, reinit() is needed to share the
+  // information about the layout with the model vector, but it does not
+  // allocate memory in that case
+  free_entry->first = true;
+  free_entry->second->reinit(model, true);
+  return free_entry->second.get();
+}
+
+
+
+template <typename VectorType>
+inline void
+GrowingVectorMemory<VectorType>::free(const VectorType *const v)
+{
+  // the common case is that the vector is returned on the thread that
+  // allocated it
+  {
+    ThreadPool &                pool = get_pool().get_thread_pool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    for (entry_type &entry : pool.data)
+      if (v == entry.second.get())
         {
-          i->first = false;
+          entry.first = false;
           --current_alloc;
           return;
         }
+  }
+
+  // otherwise, search the pools of all other threads
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const auto &pool : get_pool().thread_pools)
+    {
+      std::lock_guard<std::mutex> pool_lock(pool->mutex);
+      for (entry_type &entry : pool->data)
+        if (v == entry.second.get())
+          {
+            entry.first = false;
+            --current_alloc;
+            return;
+          }
     }
   Assert(false, typename VectorMemory<VectorType>::ExcNotAllocatedHere());
 }
@@ -168,8 +267,34 @@ GrowingVectorMemory<VectorType>::release_unused_memory()
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  if (get_pool().data != nullptr)
-    get_pool().data->clear();
+  for (const auto &pool : get_pool().thread_pools)
+    {
+      std::lock_guard<std::mutex> pool_lock(pool->mutex);
+      pool->data.erase(std::remove_if(pool->data.begin(),
+                                      pool->data.end(),
+                                      [](const entry_type &entry) {
+                                        return entry.first == false;
+                                      }),
+                       pool->data.end());
+    }
+}
+
+
+
+template <typename VectorType>
+inline typename GrowingVectorMemory<VectorType>::size_type
+GrowingVectorMemory<VectorType>::n_hits() const
+{
+  return hits;
+}
+
+
+
+template <typename VectorType>
+inline typename GrowingVectorMemory<VectorType>::size_type
+GrowingVectorMemory<VectorType>::n_misses() const
+{
+  return total_alloc - hits;
 }
 
 
@@ -180,14 +305,14 @@ GrowingVectorMemory<VectorType>::memory_consumption() const
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  std::size_t                                            result = sizeof(*this);
-  const typename std::vector<entry_type>::const_iterator end =
-    get_pool().data->end();
-  for (typename std::vector<entry_type>::const_iterator i =
-         get_pool().data->begin();
-       i != end;
-       ++i)
-    result += sizeof(*i) + MemoryConsumption::memory_consumption(i->second);
+  std::size_t result = sizeof(*this);
+  for (const auto &pool : get_pool().thread_pools)
+    {
+      std::lock_guard<std::mutex> pool_lock(pool->mutex);
+      for (const entry_type &entry : pool->data)
+        result +=
+          sizeof(entry) + MemoryConsumption::memory_consumption(entry.second);
+    }
 
   return result;
 }
@@ -30,6 +30,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <memory>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -213,6 +214,71 @@ namespace internal
     }
 
 
+    /**
+     * The size in bytes of the destination array of an operation that only
+     * writes into that array, like <tt>dst = a * u</tt>, from which on the
+     * result is written with streaming (non-temporal) stores. These bypass
+     * the caches and thus avoid that the old content of the destination is
+     * read from memory before it gets overwritten (write-allocate), which
+     * saves a third of the memory transfer of <tt>dst = a * u</tt>. On the
+     * other hand, the result is evicted from the caches, which is why
+     * streaming stores are only used for arrays that are larger than the
+     * last-level cache of typical processors.
+     */
+    const std::size_t streaming_store_threshold = 16 * 1024 * 1024;
+
+    /**
+     * Return whether an operation that writes @p size entries of type
+     * @p Number without reading them should use streaming stores, see
+     * streaming_store_threshold. Since streaming stores are only available
+     * for the SIMD types, this function always returns false for number
+     * types without vectorization support.
+     */
+    template <typename Number>
+    inline bool
+    use_streaming_stores(const size_type size)
+    {
+      return VectorizedArray<Number>::n_array_elements > 1 &&
+             size * sizeof(Number) >= streaming_store_threshold;
+    }
+
+    /**
+     * Write the entries in the range [begin, end) of @p dst with streaming
+     * stores. The operation @p vectorized_op returns the entries starting at
+     * a given index as a VectorizedArray, and @p scalar_op the
+     * entry at a given index. Since streaming stores require aligned
+     * addresses, the scalar operation is used for the entries before the
+     * first aligned address and for the remainder at the end of the range.
+     */
+    template <typename Number, typename ScalarOp, typename VectorizedOp>
+    inline void
+    streaming_store_loop(Number *const       dst,
+                         const size_type     begin,
+                         const size_type     end,
+                         const ScalarOp &    scalar_op,
+                         const VectorizedOp &vectorized_op)
+    {
+      const unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+
+      size_type i = begin;
+      for (; i < end && reinterpret_cast<std::size_t>(dst + i) %
+                            sizeof(VectorizedArray<Number>) !=
+                          0;
+           ++i)
+        dst[i] = scalar_op(i);
+      for (; i + n_lanes <= end; i += n_lanes)
+        vectorized_op(i).streaming_store(dst + i);
+      for (; i < end; ++i)
+        dst[i] = scalar_op(i);
+
+      // streaming stores are weakly ordered, so make sure they are
+      // completed before the data is accessed by other threads
+#if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)
+      _mm_sfence();
+#endif
+    }
+
+
     // Define the functors necessary to use SIMD with TBB. we also include the
     // simple copy and set operations
 
@@ -614,16 +680,32 @@ namespace internal
     {
       Vectorization_equ_au(Number *const       val,
                            const Number *const u_val,
-                           const Number        a)
+                           const Number        a,
+                           const bool          streaming_stores = false)
         : val(val)
         , u_val(u_val)
         , a(a)
+        , streaming_stores(streaming_stores)
       {}
 
       void
       operator()(const size_type begin, const size_type end) const
       {
-        if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
+        if (streaming_stores)
+          {
+            const VectorizedArray<Number> a_vec = make_vectorized_array(a);
+            streaming_store_loop(
+              val,
+              begin,
+              end,
+              [&](const size_type i) -> Number { return a * u_val[i]; },
+              [&](const size_type i) -> VectorizedArray<Number> {
+                VectorizedArray<Number> u;
+                u.load(u_val + i);
+                return a_vec * u;
+              });
+          }
+        else if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
           {
             DEAL_II_OPENMP_SIMD_PRAGMA
             for (size_type i = begin; i < end; ++i)
@@ -639,6 +721,7 @@ namespace internal
       Number *const       val;
       const Number *const u_val;
       const Number        a;
+      const bool          streaming_stores;
     };
 
     template <typename Number>
@@ -648,18 +731,38 @@ namespace internal
                              const Number *const u_val,
                              const Number *const v_val,
                              const Number        a,
-                             const Number        b)
+                             const Number        b,
+                             const bool          streaming_stores = false)
         : val(val)
         , u_val(u_val)
         , v_val(v_val)
         , a(a)
         , b(b)
+        , streaming_stores(streaming_stores)
       {}
 
       void
       operator()(const size_type begin, const size_type end) const
       {
-        if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
+        if (streaming_stores)
+          {
+            const VectorizedArray<Number> a_vec = make_vectorized_array(a);
+            const VectorizedArray<Number> b_vec = make_vectorized_array(b);
+            streaming_store_loop(
+              val,
+              begin,
+              end,
+              [&](const size_type i) -> Number {
+                return a * u_val[i] + b * v_val[i];
+              },
+              [&](const size_type i) -> VectorizedArray<Number> {
+                VectorizedArray<Number> u, v;
+                u.load(u_val + i);
+                v.load(v_val + i);
+                return a_vec * u + b_vec * v;
+              });
+          }
+        else if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
           {
             DEAL_II_OPENMP_SIMD_PRAGMA
             for (size_type i = begin; i < end; ++i)
@@ -677,6 +780,7 @@ namespace internal
       const Number *const v_val;
       const Number        a;
       const Number        b;
+      const bool          streaming_stores;
     };
 
     template <typename Number>
@@ -688,7 +792,8 @@ namespace internal
                                const Number *w_val,
                                const Number  a,
                                const Number  b,
-                               const Number  c)
+                               const Number  c,
+                               const bool    streaming_stores = false)
         : val(val)
         , u_val(u_val)
         , v_val(v_val)
@@ -696,12 +801,33 @@ namespace internal
         , a(a)
         , b(b)
         , c(c)
+        , streaming_stores(streaming_stores)
       {}
 
       void
       operator()(const size_type begin, const size_type end) const
       {
-        if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
+        if (streaming_stores)
+          {
+            const VectorizedArray<Number> a_vec = make_vectorized_array(a);
+            const VectorizedArray<Number> b_vec = make_vectorized_array(b);
+            const VectorizedArray<Number> c_vec = make_vectorized_array(c);
+            streaming_store_loop(
+              val,
+              begin,
+              end,
+              [&](const size_type i) -> Number {
+                return a * u_val[i] + b * v_val[i] + c * w_val[i];
+              },
+              [&](const size_type i) -> VectorizedArray<Number> {
+                VectorizedArray<Number> u, v, w;
+                u.load(u_val + i);
+                v.load(v_val + i);
+                w.load(w_val + i);
+                return a_vec * u + b_vec * v + c_vec * w;
+              });
+          }
+        else if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
           {
             DEAL_II_OPENMP_SIMD_PRAGMA
             for (size_type i = begin; i < end; ++i)
@@ -721,21 +847,38 @@ namespace internal
       const Number        a;
       const Number        b;
       const Number        c;
+      const bool          streaming_stores;
     };
 
     template <typename Number>
     struct Vectorization_ratio
     {
-      Vectorization_ratio(Number *val, const Number *a_val, const Number *b_val)
+      Vectorization_ratio(Number *      val,
+                          const Number *a_val,
+                          const Number *b_val,
+                          const bool    streaming_stores = false)
         : val(val)
         , a_val(a_val)
         , b_val(b_val)
+        , streaming_stores(streaming_stores)
       {}
 
       void
       operator()(const size_type begin, const size_type end) const
       {
-        if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
+        if (streaming_stores)
+          streaming_store_loop(
+            val,
+            begin,
+            end,
+            [&](const size_type i) -> Number { return a_val[i] / b_val[i]; },
+            [&](const size_type i) -> VectorizedArray<Number> {
+              VectorizedArray<Number> a, b;
+              a.load(a_val + i);
+              b.load(b_val + i);
+              return a / b;
+            });
+        else if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
           {
             DEAL_II_OPENMP_SIMD_PRAGMA
             for (size_type i = begin; i < end; ++i)
@@ -751,6 +894,7 @@ namespace internal
       Number *const       val;
       const Number *const a_val;
       const Number *const b_val;
+      const bool          streaming_stores;
     };
 
 
@@ -966,6 +1110,101 @@ namespace internal
       const Number        a;
     };
 
+    template <typename Number>
+    struct AddTwoAndDot
+    {
+      static const bool vectorizes =
+        VectorizedArray<Number>::n_array_elements > 1;
+
+      AddTwoAndDot(Number *const       X,
+                   const Number *const V,
+                   const Number *const W,
+                   const Number *const U,
+                   const Number        a,
+                   const Number        b)
+        : X(X)
+        , V(V)
+        , W(W)
+        , U(U)
+        , a(a)
+        , b(b)
+      {}
+
+      Number
+      operator()(const size_type i) const
+      {
+        X[i] += a * V[i] + b * W[i];
+        return X[i] * Number(numbers::NumberTraits<Number>::conjugate(U[i]));
+      }
+
+      VectorizedArray<Number>
+      do_vectorized(const size_type i) const
+      {
+        VectorizedArray<Number> x, v, w, u;
+        x.load(X + i);
+        v.load(V + i);
+        w.load(W + i);
+        x += a * v + b * w;
+        x.store(X + i);
+        // may only load from U after storing in X because the pointers might
+        // point to the same memory
+        u.load(U + i);
+
+        // see the comment in AddAndDot about complex-valued numbers
+        static_assert(numbers::NumberTraits<Number>::is_complex == false,
+                      "This operation is not correctly implemented for "
+                      "complex-valued objects.");
+        return x * u;
+      }
+
+      Number *const       X;
+      const Number *const V;
+      const Number *const W;
+      const Number *const U;
+      const Number        a;
+      const Number        b;
+    };
+
+    template <typename Number, typename RealType>
+    struct SaddAndNorm2
+    {
+      static const bool vectorizes =
+        VectorizedArray<Number>::n_array_elements > 1;
+
+      SaddAndNorm2(Number *const       X,
+                   const Number *const V,
+                   const Number        x,
+                   const Number        a)
+        : X(X)
+        , V(V)
+        , x(x)
+        , a(a)
+      {}
+
+      RealType
+      operator()(const size_type i) const
+      {
+        X[i] = x * X[i] + a * V[i];
+        return numbers::NumberTraits<Number>::abs_square(X[i]);
+      }
+
+      VectorizedArray<Number>
+      do_vectorized(const size_type i) const
+      {
+        VectorizedArray<Number> y, v;
+        y.load(X + i);
+        v.load(V + i);
+        y = x * y + a * v;
+        y.store(X + i);
+        return y * y;
+      }
+
+      Number *const       X;
+      const Number *const V;
+      const Number        x;
+      const Number        a;
+    };
+
 
 
     // this is the main working loop for all vector sums using the templated
@@ -1659,6 +1898,38 @@ namespace internal
         return Number();
       }
 
+      static Number
+      add_avpbw_and_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &
+        /*thread_loop_partitioner*/,
+        const size_type /*size*/,
+        const Number /*a*/,
+        const Number /*b*/,
+        const ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace>
+          & /*v_data*/,
+        const ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace>
+          & /*w_data*/,
+        const ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace>
+          & /*u_data*/,
+        ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace> & /*data*/)
+      {
+        return Number();
+      }
+
+      template <typename real_type>
+      static void
+      sadd_xav_and_norm_2(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &
+        /*thread_loop_partitioner*/,
+        const size_type /*size*/,
+        const Number /*x*/,
+        const Number /*a*/,
+        real_type & /*sum*/,
+        const ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace>
+          & /*v_data*/,
+        ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace> & /*data*/)
+      {}
+
       template <typename MemorySpace2>
       static void
       import(
@@ -1888,9 +2159,11 @@ namespace internal
                                                     ::dealii::MemorySpace::Host>
                &data)
       {
-        Vectorization_equ_au<Number> vector_equ(data.values.get(),
-                                                v_data.values.get(),
-                                                a);
+        Vectorization_equ_au<Number> vector_equ(
+          data.values.get(),
+          v_data.values.get(),
+          a,
+          use_streaming_stores<Number>(size));
         parallel_for(vector_equ, 0, size, thread_loop_partitioner);
       }
 
@@ -1910,7 +2183,12 @@ namespace internal
           &data)
       {
         Vectorization_equ_aubv<Number> vector_equ(
-          data.values.get(), v_data.values.get(), w_data.values.get(), a, b);
+          data.values.get(),
+          v_data.values.get(),
+          w_data.values.get(),
+          a,
+          b,
+          use_streaming_stores<Number>(size));
         parallel_for(vector_equ, 0, size, thread_loop_partitioner);
       }
 
@@ -2016,6 +2294,57 @@ namespace internal
         return sum;
       }
 
+      static Number
+      add_avpbw_and_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &             thread_loop_partitioner,
+        const size_type size,
+        const Number    a,
+        const Number    b,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::Host> &v_data,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::Host> &w_data,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::Host> &u_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Host>
+          &data)
+      {
+        Number               sum;
+        AddTwoAndDot<Number> adder(data.values.get(),
+                                   v_data.values.get(),
+                                   w_data.values.get(),
+                                   u_data.values.get(),
+                                   a,
+                                   b);
+        parallel_reduce(adder, 0, size, sum, thread_loop_partitioner);
+
+        return sum;
+      }
+
+      template <typename real_type>
+      static void
+      sadd_xav_and_norm_2(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &             thread_loop_partitioner,
+        const size_type size,
+        const Number    x,
+        const Number    a,
+        real_type &     sum,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::Host> &v_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Host>
+          &data)
+      {
+        SaddAndNorm2<Number, real_type> sadd_norm(data.values.get(),
+                                                  v_data.values.get(),
+                                                  x,
+                                                  a);
+        parallel_reduce(sadd_norm, 0, size, sum, thread_loop_partitioner);
+      }
+
       template <typename MemorySpace2>
       static void
       import(const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
@@ -2088,6 +2417,32 @@ namespace internal
       static const int chunk_size =
         ::dealii::LinearAlgebra::CUDAWrappers::kernel::chunk_size;
 
+      // Return a zeroed device array of length one for the result of a
+      // reduction. The array is kept between calls because cudaMalloc() and
+      // cudaFree() synchronize the device, which would serialize the short
+      // kernels of an iterative solver. Each thread uses its own array.
+      static Number *
+      get_reduction_buffer()
+      {
+        static thread_local std::unique_ptr<Number, void (*)(Number *)>
+          buffer(nullptr, [](Number *ptr) {
+            // ignore the error code here since the CUDA runtime may already
+            // have been shut down at program exit
+            cudaFree(ptr);
+          });
+        if (buffer == nullptr)
+          {
+            Number *    ptr;
+            cudaError_t error_code = cudaMalloc(&ptr, sizeof(Number));
+            AssertCuda(error_code);
+            buffer.reset(ptr);
+          }
+        cudaError_t error_code =
+          cudaMemsetAsync(buffer.get(), 0, sizeof(Number));
+        AssertCuda(error_code);
+        return buffer.get();
+      }
+
       static void
       copy(
         const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &,
@@ -2446,11 +2801,7 @@ namespace internal
                                                  ::dealii::MemorySpace::CUDA>
             &data)
       {
-        Number *    result_device;
-        cudaError_t error_code = cudaMalloc(&result_device, sizeof(Number));
-        AssertCuda(error_code);
-        error_code = cudaMemset(result_device, 0, sizeof(Number));
-        AssertCuda(error_code);
+        Number *result_device = get_reduction_buffer();
 
         const int n_blocks = 1 + size / (chunk_size * block_size);
         ::dealii::LinearAlgebra::CUDAWrappers::kernel::double_vector_reduction<
@@ -2470,14 +2821,11 @@ namespace internal
 #  endif
 
         // Copy the result back to the host
-        Number result;
-        error_code = cudaMemcpy(&result,
-                                result_device,
-                                sizeof(Number),
-                                cudaMemcpyDeviceToHost);
-        AssertCuda(error_code);
-        // Free the memory on the device
-        error_code = cudaFree(result_device);
+        Number            result;
+        const cudaError_t error_code = cudaMemcpy(&result,
+                                                  result_device,
+                                                  sizeof(Number),
+                                                  cudaMemcpyDeviceToHost);
         AssertCuda(error_code);
 
         AssertIsFinite(result);
@@ -2505,10 +2853,7 @@ namespace internal
         const ::dealii::MemorySpace::
           MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &data)
       {
-        Number *    result_device;
-        cudaError_t error_code = cudaMalloc(&result_device, sizeof(Number));
-        AssertCuda(error_code);
-        error_code = cudaMemset(result_device, 0, sizeof(Number));
+        Number *result_device = get_reduction_buffer();
 
         const int n_blocks = 1 + size / (chunk_size * block_size);
         ::dealii::LinearAlgebra::CUDAWrappers::kernel::reduction<
@@ -2519,14 +2864,11 @@ namespace internal
                                                     size);
 
         // Copy the result back to the host
-        Number result;
-        error_code = cudaMemcpy(&result,
-                                result_device,
-                                sizeof(Number),
-                                cudaMemcpyDeviceToHost);
-        AssertCuda(error_code);
-        // Free the memory on the device
-        error_code = cudaFree(result_device);
+        Number            result;
+        const cudaError_t error_code = cudaMemcpy(&result,
+                                                  result_device,
+                                                  sizeof(Number),
+                                                  cudaMemcpyDeviceToHost);
         AssertCuda(error_code);
 
         return result;
@@ -2542,10 +2884,7 @@ namespace internal
                                                ::dealii::MemorySpace::CUDA>
           &data)
       {
-        Number *    result_device;
-        cudaError_t error_code = cudaMalloc(&result_device, sizeof(Number));
-        AssertCuda(error_code);
-        error_code = cudaMemset(result_device, 0, sizeof(Number));
+        Number *result_device = get_reduction_buffer();
 
         const int n_blocks = 1 + size / (chunk_size * block_size);
         ::dealii::LinearAlgebra::CUDAWrappers::kernel::reduction<
@@ -2556,13 +2895,10 @@ namespace internal
                                                     size);
 
         // Copy the result back to the host
-        error_code = cudaMemcpy(&sum,
-                                result_device,
-                                sizeof(Number),
-                                cudaMemcpyDeviceToHost);
-        AssertCuda(error_code);
-        // Free the memory on the device
-        error_code = cudaFree(result_device);
+        const cudaError_t error_code = cudaMemcpy(&sum,
+                                                  result_device,
+                                                  sizeof(Number),
+                                                  cudaMemcpyDeviceToHost);
         AssertCuda(error_code);
       }
 
@@ -2592,11 +2928,7 @@ namespace internal
                                                ::dealii::MemorySpace::CUDA>
           &data)
       {
-        Number *    res_d;
-        cudaError_t error_code = cudaMalloc(&res_d, sizeof(Number));
-        AssertCuda(error_code);
-        error_code = cudaMemset(res_d, 0, sizeof(Number));
-        AssertCuda(error_code);
+        Number *res_d = get_reduction_buffer();
 
         const int n_blocks = 1 + size / (chunk_size * block_size);
         ::dealii::LinearAlgebra::CUDAWrappers::kernel::add_and_dot<Number>
@@ -2607,15 +2939,56 @@ namespace internal
                                                     a,
                                                     size);
 
-        Number res;
-        error_code =
+        Number            res;
+        const cudaError_t error_code =
           cudaMemcpy(&res, res_d, sizeof(Number), cudaMemcpyDeviceToHost);
         AssertCuda(error_code);
-        error_code = cudaFree(res_d);
 
         return res;
       }
 
+      // there are no fused kernels for the following two operations, so
+      // they are composed of the respective update and reduction
+      static Number
+      add_avpbw_and_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &             thread_loop_partitioner,
+        const size_type size,
+        const Number    a,
+        const Number    b,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &v_data,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &w_data,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &u_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::CUDA>
+          &data)
+      {
+        add_avpbw(thread_loop_partitioner, size, a, b, v_data, w_data, data);
+        return dot(thread_loop_partitioner, size, u_data, data);
+      }
+
+      template <typename real_type>
+      static void
+      sadd_xav_and_norm_2(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &             thread_loop_partitioner,
+        const size_type size,
+        const Number    x,
+        const Number    a,
+        real_type &     sum,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &v_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::CUDA>
+          &data)
+      {
+        sadd_xav(thread_loop_partitioner, size, x, a, v_data, data);
+        norm_2(thread_loop_partitioner, size, sum, data);
+      }
+
       template <typename MemorySpace2>
       static void
       import(const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
@@ -506,6 +506,647 @@ namespace CUDAWrappers
 
     __syncthreads();
   }
+
+
+
+  /**
+   * This class provides the functions necessary to evaluate functions at
+   * the quadrature points of a face at the boundary of the domain and to
+   * perform face integrations, in analogy to FEEvaluation for the cells and
+   * similar to FEFaceValues<dim>. The object is used inside the functor
+   * passed to MatrixFree::boundary_face_loop().
+   *
+   * The values on the face are obtained by first evaluating the function at
+   * the quadrature points of the adjacent cell with the same tensor product
+   * kernels as FEEvaluation, and then interpolating them in the direction
+   * normal to the face. Since the polynomial degree of the functions in that
+   * direction does not exceed the number of 1D quadrature points minus one,
+   * this interpolation is exact. The integration applies the transposed
+   * operations. The <tt>n_q_points_1d^(dim-1)</tt> quadrature points on the
+   * face are the tensor product of the 1D quadrature points in the tangential
+   * directions. Only the threads of the thread block of the cell that
+   * correspond to a quadrature point on the face call the functor in
+   * apply_quad_point_operations().
+   *
+   * The template arguments are the same as for FEEvaluation.
+   *
+   * @ingroup CUDAWrappers
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d = fe_degree + 1,
+            int n_components_ = 1,
+            typename Number   = double>
+  class FEFaceEvaluation
+  {
+  public:
+    using value_type    = Number;
+    using gradient_type = Tensor<1, dim, Number>;
+    using data_type     = typename MatrixFree<dim, Number>::Data;
+    static constexpr unsigned int dimension    = dim;
+    static constexpr unsigned int n_components = n_components_;
+    static constexpr unsigned int n_q_points =
+      Utilities::pow(n_q_points_1d, dim - 1);
+    static constexpr unsigned int tensor_dofs_per_cell =
+      Utilities::pow(fe_degree + 1, dim);
+
+    /**
+     * Constructor. @p face_id is the number of the face within the data
+     * returned by MatrixFree::get_boundary_face_data().
+     */
+    __device__
+    FEFaceEvaluation(const unsigned int       face_id,
+                     const data_type *        data,
+                     SharedData<dim, Number> *shdata);
+
+    /**
+     * For the vector @p src, read out the values on the degrees of freedom of
+     * the cell adjacent to the current face, and store them internally,
+     * resolving constraints from hanging nodes.
+     */
+    __device__ void
+    read_dof_values(const Number *src);
+
+    /**
+     * Take the value stored internally on dof values of the cell adjacent to
+     * the current face and sum them into the vector @p dst, applying
+     * constraints from hanging nodes.
+     */
+    __device__ void
+    distribute_local_to_global(Number *dst) const;
+
+    /**
+     * Evaluate the function values and the gradients of the FE function
+     * given at the DoF values in the input vector at the quadrature points
+     * on the face.
+     */
+    __device__ void
+    evaluate(const bool evaluate_val, const bool evaluate_grad);
+
+    /**
+     * Test the values and/or gradients that are stored on the quadrature
+     * points of the face by all the basis functions/gradients of the
+     * adjacent cell and perform the face integration.
+     */
+    __device__ void
+    integrate(const bool integrate_val, const bool integrate_grad);
+
+    /**
+     * Return the value of a finite element function at quadrature point
+     * number @p q_point after a call to @p evaluate(true,...).
+     */
+    __device__ value_type
+               get_value(const unsigned int q_point) const;
+
+    /**
+     * Write a value to the field containing the values on quadrature points
+     * with component @p q_point, which is tested by all basis functions and
+     * integrated over the face.
+     */
+    __device__ void
+    submit_value(const value_type &val_in, const unsigned int q_point);
+
+    /**
+     * Return the gradient of a finite element function at quadrature point
+     * number @p q_point after a call to @p evaluate(...,true).
+     */
+    __device__ gradient_type
+               get_gradient(const unsigned int q_point) const;
+
+    /**
+     * Write a contribution that is tested by the gradient to the field
+     * containing the values on quadrature points with component @p q_point.
+     */
+    __device__ void
+    submit_gradient(const gradient_type &grad_in, const unsigned int q_point);
+
+    /**
+     * Return the derivative of a finite element function in the direction of
+     * the outward normal at quadrature point number @p q_point after a call
+     * to @p evaluate(...,true).
+     */
+    __device__ value_type
+               get_normal_derivative(const unsigned int q_point) const;
+
+    /**
+     * Write a contribution that is tested by the normal derivative of the
+     * basis functions at quadrature point number @p q_point.
+     */
+    __device__ void
+    submit_normal_derivative(const value_type & grad_in,
+                             const unsigned int q_point);
+
+    /**
+     * Return the outward unit normal vector at quadrature point number
+     * @p q_point.
+     */
+    __device__ gradient_type
+               get_normal_vector(const unsigned int q_point) const;
+
+    /**
+     * Return the boundary id of the current face.
+     */
+    __device__ types::boundary_id
+               boundary_id() const;
+
+    // clang-format off
+    /**
+     * Apply the functor @p func on every quadrature point of the face.
+     *
+     * @p func needs to define
+     * \code
+     * __device__ void operator()(
+     *   CUDAWrappers::FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components, Number> *fe_eval,
+     *   const unsigned int                                                                   q_point) const;
+     * \endcode
+     */
+    // clang-format on
+    template <typename Functor>
+    __device__ void
+    apply_quad_point_operations(const Functor &func);
+
+  private:
+    /**
+     * Return the coordinate of the current thread in direction @p d of the
+     * thread block of the cell.
+     */
+    __device__ static unsigned int
+    thread_coordinate(const unsigned int d);
+
+    /**
+     * Return the index of the quadrature point on the face that has the
+     * same tangential coordinates as the current thread.
+     */
+    __device__ unsigned int
+    face_q_point() const;
+
+    /**
+     * Return the index of the quadrature point of the cell that has the same
+     * tangential coordinates as the current thread and the coordinate @p k
+     * in the direction normal to the face.
+     */
+    __device__ unsigned int
+    cell_q_point(const unsigned int k) const;
+
+    types::global_dof_index *local_to_global;
+    unsigned int             n_faces;
+    unsigned int             padding_length;
+
+    const unsigned int constraint_mask;
+
+    const bool use_coloring;
+
+    const unsigned int       face_number;
+    const types::boundary_id face_boundary_id;
+
+    Number *inv_jac;
+    Number *JxW;
+    Number *normal;
+
+    // Internal buffer
+    Number *values;
+    Number *gradients[dim];
+  };
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    FEFaceEvaluation(const unsigned int       face_id,
+                     const data_type *        data,
+                     SharedData<dim, Number> *shdata)
+    : n_faces(data->n_cells)
+    , padding_length(data->padding_length)
+    , constraint_mask(data->constraint_mask[face_id])
+    , use_coloring(data->use_coloring)
+    , face_number(data->face_number[face_id])
+    , face_boundary_id(data->boundary_id[face_id])
+    , values(shdata->values)
+  {
+    local_to_global = data->local_to_global + padding_length * face_id;
+    inv_jac         = data->inv_jacobian + padding_length * face_id;
+    JxW             = data->JxW + padding_length * face_id;
+    normal          = data->normal_vector + padding_length * face_id;
+
+    for (unsigned int i = 0; i < dim; ++i)
+      gradients[i] = shdata->gradients[i];
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ unsigned int
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    thread_coordinate(const unsigned int d)
+  {
+    return d == 0 ? threadIdx.x % n_q_points_1d :
+                    d == 1 ? threadIdx.y : threadIdx.z;
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ unsigned int
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    face_q_point() const
+  {
+    unsigned int q_point = 0;
+    unsigned int stride  = 1;
+    for (unsigned int d = 0; d < dim; ++d)
+      if (d != face_number / 2)
+        {
+          q_point += thread_coordinate(d) * stride;
+          stride *= n_q_points_1d;
+        }
+    return q_point;
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ unsigned int
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    cell_q_point(const unsigned int k) const
+  {
+    unsigned int q_point = 0;
+    unsigned int stride  = 1;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        q_point += (d == face_number / 2 ? k : thread_coordinate(d)) * stride;
+        stride *= n_q_points_1d;
+      }
+    return q_point;
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ void
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    read_dof_values(const Number *src)
+  {
+    static_assert(n_components_ == 1, "This function only supports FE with one \
+                  components");
+    const unsigned int idx = cell_q_point(thread_coordinate(face_number / 2));
+
+    const types::global_dof_index src_idx = local_to_global[idx];
+    // Use the read-only data cache.
+    values[idx] = __ldg(&src[src_idx]);
+
+    __syncthreads();
+
+    internal::resolve_hanging_nodes<dim, fe_degree, false>(constraint_mask,
+                                                           values);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ void
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    distribute_local_to_global(Number *dst) const
+  {
+    static_assert(n_components_ == 1, "This function only supports FE with one \
+                  components");
+    internal::resolve_hanging_nodes<dim, fe_degree, true>(constraint_mask,
+                                                          values);
+
+    const unsigned int idx = cell_q_point(thread_coordinate(face_number / 2));
+    const types::global_dof_index destination_idx = local_to_global[idx];
+
+    if (use_coloring)
+      dst[destination_idx] += values[idx];
+    else
+      LinearAlgebra::CUDAWrappers::atomicAdd_wrapper(&dst[destination_idx],
+                                                     values[idx]);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ void
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    evaluate(const bool evaluate_val, const bool evaluate_grad)
+  {
+    // Evaluate on the quadrature points of the cell first, the gradients
+    // first because they require the values on the degrees of freedom
+    internal::EvaluatorTensorProduct<
+      internal::EvaluatorVariant::evaluate_general,
+      dim,
+      fe_degree,
+      n_q_points_1d,
+      Number>
+      evaluator_tensor_product;
+    if (evaluate_grad == true)
+      {
+        evaluator_tensor_product.gradient_at_quad_pts(values, gradients);
+        __syncthreads();
+      }
+
+    if (evaluate_val == true)
+      {
+        evaluator_tensor_product.value_at_quad_pts(values);
+        __syncthreads();
+      }
+
+    // Then interpolate to the face in the normal direction. The threads
+    // with the first coordinate in that direction do the work.
+    const unsigned int normal_direction = face_number / 2;
+    const double *     interpolation =
+      internal::global_face_interpolation + (face_number % 2) * n_q_points_1d;
+    const bool on_face = (thread_coordinate(normal_direction) == 0);
+
+    Number face_value = 0.;
+    Number face_gradient[dim];
+    for (unsigned int d = 0; d < dim; ++d)
+      face_gradient[d] = 0.;
+    if (on_face)
+      for (unsigned int k = 0; k < n_q_points_1d; ++k)
+        {
+          const unsigned int q_point = cell_q_point(k);
+          const Number       weight  = interpolation[k];
+          if (evaluate_val == true)
+            face_value += weight * values[q_point];
+          if (evaluate_grad == true)
+            for (unsigned int d = 0; d < dim; ++d)
+              face_gradient[d] += weight * gradients[d][q_point];
+        }
+    __syncthreads();
+
+    if (on_face)
+      {
+        const unsigned int q_point = face_q_point();
+        if (evaluate_val == true)
+          values[q_point] = face_value;
+        if (evaluate_grad == true)
+          for (unsigned int d = 0; d < dim; ++d)
+            gradients[d][q_point] = face_gradient[d];
+      }
+    __syncthreads();
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ void
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    integrate(const bool integrate_val, const bool integrate_grad)
+  {
+    // Spread the contributions on the face to the quadrature points of the
+    // cell with the transpose of the interpolation in evaluate()
+    const unsigned int normal_direction = face_number / 2;
+    const unsigned int face_q           = face_q_point();
+
+    Number face_value = 0.;
+    Number face_gradient[dim];
+    if (integrate_val == true)
+      face_value = values[face_q];
+    if (integrate_grad == true)
+      for (unsigned int d = 0; d < dim; ++d)
+        face_gradient[d] = gradients[d][face_q];
+    __syncthreads();
+
+    const Number weight =
+      internal::global_face_interpolation[(face_number % 2) * n_q_points_1d +
+                                          thread_coordinate(normal_direction)];
+    const unsigned int q_point =
+      cell_q_point(thread_coordinate(normal_direction));
+    if (integrate_val == true)
+      values[q_point] = weight * face_value;
+    if (integrate_grad == true)
+      for (unsigned int d = 0; d < dim; ++d)
+        gradients[d][q_point] = weight * face_gradient[d];
+    __syncthreads();
+
+    internal::EvaluatorTensorProduct<
+      internal::EvaluatorVariant::evaluate_general,
+      dim,
+      fe_degree,
+      n_q_points_1d,
+      Number>
+      evaluator_tensor_product;
+    if (integrate_val == true)
+      {
+        evaluator_tensor_product.integrate_value(values);
+        __syncthreads();
+        if (integrate_grad == true)
+          {
+            evaluator_tensor_product.integrate_gradient<true>(values,
+                                                              gradients);
+            __syncthreads();
+          }
+      }
+    else if (integrate_grad == true)
+      {
+        evaluator_tensor_product.integrate_gradient<false>(values, gradients);
+        __syncthreads();
+      }
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ typename FEFaceEvaluation<dim,
+                                       fe_degree,
+                                       n_q_points_1d,
+                                       n_components_,
+                                       Number>::value_type
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    get_value(const unsigned int q_point) const
+  {
+    return values[q_point];
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ void
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    submit_value(const value_type &val_in, const unsigned int q_point)
+  {
+    values[q_point] = val_in * JxW[q_point];
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ typename FEFaceEvaluation<dim,
+                                       fe_degree,
+                                       n_q_points_1d,
+                                       n_components_,
+                                       Number>::gradient_type
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    get_gradient(const unsigned int q_point) const
+  {
+    static_assert(n_components_ == 1, "This function only supports FE with one \
+                  components");
+    const Number *inv_jacobian = &inv_jac[q_point];
+    gradient_type grad;
+    for (int d_1 = 0; d_1 < dim; ++d_1)
+      {
+        Number tmp = 0.;
+        for (int d_2 = 0; d_2 < dim; ++d_2)
+          tmp += inv_jacobian[padding_length * n_faces * (dim * d_2 + d_1)] *
+                 gradients[d_2][q_point];
+        grad[d_1] = tmp;
+      }
+
+    return grad;
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ void
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    submit_gradient(const gradient_type &grad_in, const unsigned int q_point)
+  {
+    const Number *inv_jacobian = &inv_jac[q_point];
+    for (int d_1 = 0; d_1 < dim; ++d_1)
+      {
+        Number tmp = 0.;
+        for (int d_2 = 0; d_2 < dim; ++d_2)
+          tmp += inv_jacobian[n_faces * padding_length * (dim * d_1 + d_2)] *
+                 grad_in[d_2];
+        gradients[d_1][q_point] = tmp * JxW[q_point];
+      }
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ typename FEFaceEvaluation<dim,
+                                       fe_degree,
+                                       n_q_points_1d,
+                                       n_components_,
+                                       Number>::value_type
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    get_normal_derivative(const unsigned int q_point) const
+  {
+    return get_gradient(q_point) * get_normal_vector(q_point);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ void
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    submit_normal_derivative(const value_type & grad_in,
+                             const unsigned int q_point)
+  {
+    submit_gradient(grad_in * get_normal_vector(q_point), q_point);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ typename FEFaceEvaluation<dim,
+                                       fe_degree,
+                                       n_q_points_1d,
+                                       n_components_,
+                                       Number>::gradient_type
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    get_normal_vector(const unsigned int q_point) const
+  {
+    gradient_type normal_vector;
+    for (int d = 0; d < dim; ++d)
+      normal_vector[d] = normal[padding_length * n_faces * d + q_point];
+
+    return normal_vector;
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  __device__ types::boundary_id
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    boundary_id() const
+  {
+    return face_boundary_id;
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components_,
+            typename Number>
+  template <typename Functor>
+  __device__ void
+  FEFaceEvaluation<dim, fe_degree, n_q_points_1d, n_components_, Number>::
+    apply_quad_point_operations(const Functor &func)
+  {
+    if (thread_coordinate(face_number / 2) == 0)
+      func(this, face_q_point());
+
+    __syncthreads();
+  }
 } // namespace CUDAWrappers
 
 DEAL_II_NAMESPACE_CLOSE
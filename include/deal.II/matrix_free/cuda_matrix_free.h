@@ -71,6 +71,19 @@ namespace CUDAWrappers
    * This class traverse the cells in a different order than the usual
    * Triangulation class in deal.II.
    *
+   * For distributed vectors, the cell_loop() exchanges the ghost values of the
+   * source vector while it works on the cells that only access locally owned
+   * degrees of freedom, see AdditionalData::overlap_communication_computation.
+   * If deal.II is configured with DEAL_II_MPI_WITH_CUDA_SUPPORT, the ghost
+   * values are packed and unpacked by kernels on the device and sent directly
+   * from device memory instead of being staged through host memory.
+   *
+   * Integrals over the faces at the boundary of the domain, e.g., for Robin
+   * boundary conditions or Nitsche's method, are computed by
+   * boundary_face_loop() together with the class
+   * CUDAWrappers::FEFaceEvaluation, if
+   * AdditionalData::mapping_update_flags_boundary_faces is set.
+   *
    * @note Only float and double are supported.
    *
    * @ingroup CUDAWrappers
@@ -102,10 +115,15 @@ namespace CUDAWrappers
         const ParallelizationScheme parallelization_scheme = parallel_in_elem,
         const UpdateFlags           mapping_update_flags   = update_gradients |
                                                  update_JxW_values,
-        const bool use_coloring = false)
+        const bool use_coloring                      = false,
+        const bool overlap_communication_computation = true,
+        const UpdateFlags mapping_update_flags_boundary_faces = update_default)
         : parallelization_scheme(parallelization_scheme)
         , mapping_update_flags(mapping_update_flags)
         , use_coloring(use_coloring)
+        , overlap_communication_computation(overlap_communication_computation)
+        , mapping_update_flags_boundary_faces(
+            mapping_update_flags_boundary_faces)
       {}
 
       /**
@@ -134,6 +152,28 @@ namespace CUDAWrappers
        * newer architectures.
        */
       bool use_coloring;
+
+      /**
+       * If true, the cell_loop() on distributed vectors first works on the
+       * cells that only access locally owned degrees of freedom while the
+       * ghost values of the source vector are exchanged, and only then on
+       * the cells at the boundary of the locally owned subdomain. Otherwise,
+       * the exchange is completed before any cell is processed.
+       */
+      bool overlap_communication_computation;
+
+      /**
+       * This flag determines the mapping data on boundary faces to be cached.
+       * If it is different from update_default, the data needed by
+       * FEFaceEvaluation and boundary_face_loop() is set up for all faces at
+       * the boundary of the locally owned cells, i.e., the Jacobian
+       * determinants times the quadrature weights, the normal vectors, and
+       * the inverse Jacobians if @p update_gradients is given. Quadrature
+       * points are only stored if @p update_quadrature_points is given.
+       * Boundary faces are only supported for the parallel_in_elem
+       * parallelization scheme.
+       */
+      UpdateFlags mapping_update_flags_boundary_faces;
     };
 
     /**
@@ -151,6 +191,14 @@ namespace CUDAWrappers
       unsigned int             row_start;
       unsigned int *           constraint_mask;
       bool                     use_coloring;
+      /**
+       * The following fields are only set for the data of boundary faces, in
+       * which case @p n_cells denotes the number of faces and the other
+       * fields refer to the quadrature points on the faces.
+       */
+      Number *            normal_vector;
+      unsigned int *      face_number;
+      types::boundary_id *boundary_id;
     };
 
     /**
@@ -194,6 +242,13 @@ namespace CUDAWrappers
     Data
     get_data(unsigned int color) const;
 
+    /**
+     * Return the Data structure associated with the boundary faces of
+     * @p color.
+     */
+    Data
+    get_boundary_face_data(unsigned int color) const;
+
     // clang-format off
     /**
      * This method runs the loop over all cells and apply the local operation on
@@ -238,6 +293,26 @@ namespace CUDAWrappers
     void
     evaluate_coefficients(Functor func) const;
 
+    /**
+     * This method runs the loop over all faces at the boundary of the locally
+     * owned cells and adds the result of the local operation to @p dst. The
+     * functor @p func has the same interface as the one of cell_loop(), but
+     * it is called with the number of a face instead of a cell and is
+     * expected to use FEFaceEvaluation. Its static members @p n_local_dofs
+     * and @p n_q_points refer to the degrees of freedom and quadrature points
+     * of the adjacent cell, which determine the size of the shared memory.
+     * The faces are colored if AdditionalData::use_coloring is true, and
+     * atomic operations are used otherwise.
+     *
+     * This function requires that
+     * AdditionalData::mapping_update_flags_boundary_faces was set in reinit().
+     */
+    template <typename Functor, typename VectorType>
+    void
+    boundary_face_loop(const Functor &   func,
+                       const VectorType &src,
+                       VectorType &      dst) const;
+
     /**
      * Copy the values of the constrained entries from @p src to @p dst. This is
      * used to impose zero Dirichlet boundary condition.
@@ -329,6 +404,40 @@ namespace CUDAWrappers
       const LinearAlgebra::CUDAWrappers::Vector<Number> &src,
       LinearAlgebra::CUDAWrappers::Vector<Number> &      dst) const;
 
+    /**
+     * Helper function. Loop over all the boundary faces and apply the functor
+     * on each face in parallel. This function is used when MPI is not used.
+     */
+    template <typename Functor, typename VectorType>
+    void
+    serial_boundary_face_loop(const Functor &   func,
+                              const VectorType &src,
+                              VectorType &      dst) const;
+
+    /**
+     * Helper function. Loop over all the boundary faces and apply the functor
+     * on each face in parallel. This function is used when MPI is used.
+     */
+    template <typename Functor>
+    void
+    distributed_boundary_face_loop(
+      const Functor &                                                      func,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &src,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &dst) const;
+
+    /**
+     * This function should never be called. Calling it results in an internal
+     * error. This function exists only because boundary_face_loop needs
+     * distributed_boundary_face_loop() to exist for
+     * LinearAlgebra::CUDAWrappers::Vector.
+     */
+    template <typename Functor>
+    void
+    distributed_boundary_face_loop(
+      const Functor &                                    func,
+      const LinearAlgebra::CUDAWrappers::Vector<Number> &src,
+      LinearAlgebra::CUDAWrappers::Vector<Number> &      dst) const;
+
     /**
      * Helper function. Copy the values of the constrained entries of @p src to
      * @p dst. This function is used when MPI is not used.
@@ -429,6 +538,15 @@ namespace CUDAWrappers
      */
     unsigned int n_colors;
 
+    /**
+     * Number of colors whose cells only access locally owned degrees of
+     * freedom. In parallel, the cells of each color are split into the ones
+     * that only access locally owned degrees of freedom and the ones that
+     * also access ghost entries, and the colors of the former come first so
+     * that they can be processed while the ghost values are exchanged.
+     */
+    unsigned int n_inner_colors;
+
     /**
      * Number of cells in each color.
      */
@@ -476,12 +594,60 @@ namespace CUDAWrappers
      */
     std::vector<dim3> block_dim;
 
+    /**
+     * Number of colors of the boundary faces.
+     */
+    unsigned int n_boundary_face_colors;
+
+    /**
+     * Number of boundary faces in each color.
+     */
+    std::vector<unsigned int> n_boundary_faces;
+
+    /**
+     * The mapping update flags for the boundary faces given to reinit().
+     */
+    UpdateFlags face_update_flags;
+
+    /**
+     * The data of the boundary faces of each color, stored in the same way
+     * as the corresponding data of the cells, except that the quadrature
+     * points are the ones on the face. The degrees of freedom and the
+     * constraint mask are the ones of the adjacent cell.
+     */
+    std::vector<point_type *>              face_q_points;
+    std::vector<types::global_dof_index *> face_local_to_global;
+    std::vector<Number *>                  face_inv_jacobian;
+    std::vector<Number *>                  face_JxW;
+    std::vector<Number *>                  face_normal_vector;
+    std::vector<unsigned int *>            face_number;
+    std::vector<types::boundary_id *>      face_boundary_id;
+    std::vector<unsigned int *>            face_constraint_mask;
+
+    /**
+     * Grid and block dimensions used to launch the CUDA kernels on the
+     * boundary faces of the different colors.
+     */
+    std::vector<dim3> face_grid_dim;
+    std::vector<dim3> face_block_dim;
+
     /**
      * Shared pointer to a Partitioner for distributed Vectors used in
      * cell_loop. When MPI is not used the pointer is null.
      */
     std::shared_ptr<const Utilities::MPI::Partitioner> partitioner;
 
+    /**
+     * Vectors with the ghost layout of @p partitioner into which the source
+     * and the destination of the cell_loop() on distributed vectors are
+     * copied. They are kept between calls to avoid allocating device memory
+     * every time.
+     */
+    mutable LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>
+      ghosted_src;
+    mutable LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>
+      ghosted_dst;
+
     // Parallelization parameters
     unsigned int cells_per_block;
     dim3         constraint_grid_dim;
@@ -23,6 +23,8 @@
 
 #  include <deal.II/base/cuda_size.h>
 #  include <deal.II/base/graph_coloring.h>
+#  include <deal.II/base/polynomial.h>
+#  include <deal.II/base/std_cxx14/memory.h>
 
 #  include <deal.II/dofs/dof_tools.h>
 
@@ -35,6 +37,7 @@
 
 #  include <cuda_runtime_api.h>
 
+#  include <algorithm>
 #  include <functional>
 
 
@@ -51,6 +54,9 @@ namespace CUDAWrappers
       global_shape_values[(max_elem_degree + 1) * (max_elem_degree + 1)];
     __constant__ double
       global_shape_gradients[(max_elem_degree + 1) * (max_elem_degree + 1)];
+    // Interpolation from the 1D quadrature points to the points 0 and 1,
+    // used to evaluate functions on the faces of the unit cell.
+    __constant__ double global_face_interpolation[2 * (max_elem_degree + 1)];
 
     template <typename Number>
     using CUDAVector = ::dealii::LinearAlgebra::CUDAWrappers::Vector<Number>;
@@ -115,6 +121,24 @@ namespace CUDAWrappers
 
 
 
+    /**
+     * Free the device arrays in @p arrays and clear the vector.
+     */
+    template <typename T>
+    void
+    free_device_arrays(std::vector<T *> &arrays)
+    {
+      for (T *array : arrays)
+        if (array != nullptr)
+          {
+            const cudaError_t cuda_error = cudaFree(array);
+            AssertCuda(cuda_error);
+          }
+      arrays.clear();
+    }
+
+
+
     /**
      * Helper class to (re)initialize MatrixFree object.
      */
@@ -148,7 +172,26 @@ namespace CUDAWrappers
       void
       alloc_and_copy_arrays(const unsigned int cell);
 
+      void
+      setup_boundary_face_color_arrays(const unsigned int n_colors);
+
+      template <typename CellFilter>
+      void
+      setup_boundary_face_arrays(
+        const unsigned int                                        color,
+        const std::vector<std::pair<CellFilter, unsigned int>> &  faces,
+        const Quadrature<1> &                                     quad,
+        const UpdateFlags &                                       face_flags,
+        const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner);
+
     private:
+      template <typename CellFilter>
+      void
+      get_dof_data(
+        const CellFilter &                                        cell,
+        const unsigned int                                        id,
+        const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner);
+
       MatrixFree<dim, Number> *data;
       // Host data
       std::vector<types::global_dof_index> local_to_global_host;
@@ -285,25 +328,7 @@ namespace CUDAWrappers
       const unsigned int                                        cell_id,
       const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
     {
-      cell->get_dof_indices(local_dof_indices);
-      // When using MPI, we need to transform the local_dof_indices, which
-      // contains global dof indices, to get local (to the current MPI process)
-      // dof indices.
-      if (partitioner)
-        for (auto &index : local_dof_indices)
-          index = partitioner->global_to_local(index);
-
-      for (unsigned int i = 0; i < dofs_per_cell; ++i)
-        lexicographic_dof_indices[i] = local_dof_indices[lexicographic_inv[i]];
-
-      hanging_nodes.setup_constraints(lexicographic_dof_indices,
-                                      cell,
-                                      partitioner,
-                                      constraint_mask_host[cell_id]);
-
-      memcpy(&local_to_global_host[cell_id * padding_length],
-             lexicographic_dof_indices.data(),
-             dofs_per_cell * sizeof(types::global_dof_index));
+      get_dof_data(cell, cell_id, partitioner);
 
       fe_values.reinit(cell);
 
@@ -337,6 +362,37 @@ namespace CUDAWrappers
 
 
 
+    template <int dim, typename Number>
+    template <typename CellFilter>
+    void
+    ReinitHelper<dim, Number>::get_dof_data(
+      const CellFilter &                                        cell,
+      const unsigned int                                        id,
+      const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
+    {
+      cell->get_dof_indices(local_dof_indices);
+      // When using MPI, we need to transform the local_dof_indices, which
+      // contains global dof indices, to get local (to the current MPI process)
+      // dof indices.
+      if (partitioner)
+        for (auto &index : local_dof_indices)
+          index = partitioner->global_to_local(index);
+
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        lexicographic_dof_indices[i] = local_dof_indices[lexicographic_inv[i]];
+
+      hanging_nodes.setup_constraints(lexicographic_dof_indices,
+                                      cell,
+                                      partitioner,
+                                      constraint_mask_host[id]);
+
+      memcpy(&local_to_global_host[id * padding_length],
+             lexicographic_dof_indices.data(),
+             dofs_per_cell * sizeof(types::global_dof_index));
+    }
+
+
+
     template <int dim, typename Number>
     void
     ReinitHelper<dim, Number>::alloc_and_copy_arrays(const unsigned int color)
@@ -414,6 +470,204 @@ namespace CUDAWrappers
 
 
 
+    template <int dim, typename Number>
+    void
+    ReinitHelper<dim, Number>::setup_boundary_face_color_arrays(
+      const unsigned int n_colors)
+    {
+      data->n_boundary_faces.resize(n_colors);
+      data->face_grid_dim.resize(n_colors);
+      data->face_block_dim.resize(n_colors);
+      data->face_q_points.resize(n_colors, nullptr);
+      data->face_local_to_global.resize(n_colors, nullptr);
+      data->face_inv_jacobian.resize(n_colors, nullptr);
+      data->face_JxW.resize(n_colors, nullptr);
+      data->face_normal_vector.resize(n_colors, nullptr);
+      data->face_number.resize(n_colors, nullptr);
+      data->face_boundary_id.resize(n_colors, nullptr);
+      data->face_constraint_mask.resize(n_colors, nullptr);
+    }
+
+
+
+    template <int dim, typename Number>
+    template <typename CellFilter>
+    void
+    ReinitHelper<dim, Number>::setup_boundary_face_arrays(
+      const unsigned int                                        color,
+      const std::vector<std::pair<CellFilter, unsigned int>> &  faces,
+      const Quadrature<1> &                                     quad,
+      const UpdateFlags &                                       face_flags,
+      const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
+    {
+      const unsigned int n_faces         = faces.size();
+      const unsigned int n_q_points_1d   = quad.size();
+      const unsigned int n_face_q_points = q_points_per_cell / n_q_points_1d;
+      const unsigned int cells_per_block = data->cells_per_block;
+
+      data->n_boundary_faces[color] = n_faces;
+
+      // The kernels on the faces use the same thread layout as the ones on
+      // the cells since they first work on the whole adjacent cell
+      const double apply_n_blocks = std::ceil(
+        static_cast<double>(n_faces) / static_cast<double>(cells_per_block));
+      const unsigned int apply_x_n_blocks =
+        std::round(std::sqrt(apply_n_blocks));
+      const unsigned int apply_y_n_blocks =
+        std::ceil(apply_n_blocks / static_cast<double>(apply_x_n_blocks));
+      data->face_grid_dim[color] = dim3(apply_x_n_blocks, apply_y_n_blocks);
+
+      const unsigned int n_dofs_1d = fe_degree + 1;
+      if (dim == 1)
+        data->face_block_dim[color] = dim3(n_dofs_1d * cells_per_block);
+      else if (dim == 2)
+        data->face_block_dim[color] =
+          dim3(n_dofs_1d * cells_per_block, n_dofs_1d);
+      else
+        data->face_block_dim[color] =
+          dim3(n_dofs_1d * cells_per_block, n_dofs_1d, n_dofs_1d);
+
+      // Set up a quadrature formula on each face of the unit cell whose
+      // points are the tensor product of the 1D quadrature points in the
+      // tangential directions, numbered lexicographically. This is the
+      // numbering used by FEFaceEvaluation.
+      std::vector<std::unique_ptr<FEValues<dim>>> face_values(
+        GeometryInfo<dim>::faces_per_cell);
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        {
+          std::vector<Point<dim>> points(n_face_q_points);
+          std::vector<double>     weights(n_face_q_points, 1.);
+          for (unsigned int q = 0; q < n_face_q_points; ++q)
+            {
+              unsigned int index = q;
+              for (unsigned int d = 0; d < dim; ++d)
+                if (d == f / 2)
+                  points[q][d] = f % 2;
+                else
+                  {
+                    points[q][d] = quad.point(index % n_q_points_1d)[0];
+                    weights[q] *= quad.weight(index % n_q_points_1d);
+                    index /= n_q_points_1d;
+                  }
+            }
+          face_values[f] = std_cxx14::make_unique<FEValues<dim>>(
+            fe_values.get_mapping(),
+            fe_values.get_fe(),
+            Quadrature<dim>(points, weights),
+            update_inverse_jacobians | update_quadrature_points |
+              update_JxW_values);
+        }
+
+      local_to_global_host.resize(n_faces * padding_length);
+      constraint_mask_host.resize(n_faces);
+      JxW_host.assign(n_faces * padding_length, Number());
+      std::vector<Number> normal_host(n_faces * padding_length * dim);
+      if (face_flags & update_quadrature_points)
+        q_points_host.resize(n_faces * padding_length);
+      if (face_flags & update_gradients)
+        inv_jacobian_host.assign(n_faces * padding_length * dim * dim,
+                                 Number());
+      std::vector<unsigned int>       face_number_host(n_faces);
+      std::vector<types::boundary_id> boundary_id_host(n_faces);
+
+      for (unsigned int face_id = 0; face_id < n_faces; ++face_id)
+        {
+          const CellFilter & cell             = faces[face_id].first;
+          const unsigned int f                = faces[face_id].second;
+          const unsigned int normal_direction = f / 2;
+          const double       sign             = (f % 2 == 0) ? -1. : 1.;
+
+          get_dof_data(cell, face_id, partitioner);
+          face_number_host[face_id] = f;
+          boundary_id_host[face_id] = cell->face(f)->boundary_id();
+
+          FEValues<dim> &fe_face_values = *face_values[f];
+          fe_face_values.reinit(cell);
+          const unsigned int offset = face_id * padding_length;
+          for (unsigned int q = 0; q < n_face_q_points; ++q)
+            {
+              // The normal vector is the transformed reference normal
+              // J^{-T} n_ref, and its length the ratio between the surface
+              // element on the real face and the one on the reference face
+              const DerivativeForm<1, dim, dim> &inv_jac =
+                fe_face_values.inverse_jacobian(q);
+              Tensor<1, dim> normal;
+              for (unsigned int d = 0; d < dim; ++d)
+                normal[d] = sign * inv_jac[normal_direction][d];
+              const double norm = normal.norm();
+
+              JxW_host[offset + q] =
+                static_cast<Number>(fe_face_values.JxW(q) * norm);
+              for (unsigned int d = 0; d < dim; ++d)
+                normal_host[(offset + q) * dim + d] =
+                  static_cast<Number>(normal[d] / norm);
+
+              if (face_flags & update_quadrature_points)
+                for (unsigned int d = 0; d < dim; ++d)
+                  q_points_host[offset + q][d] =
+                    fe_face_values.quadrature_point(q)[d];
+
+              if (face_flags & update_gradients)
+                for (unsigned int i = 0; i < dim; ++i)
+                  for (unsigned int j = 0; j < dim; ++j)
+                    inv_jacobian_host[(offset + q) * dim * dim + i * dim + j] =
+                      static_cast<Number>(inv_jac[i][j]);
+            }
+        }
+
+      alloc_and_copy(
+        &data->face_local_to_global[color],
+        ArrayView<const types::global_dof_index>(local_to_global_host.data(),
+                                                 local_to_global_host.size()),
+        n_faces * padding_length);
+
+      alloc_and_copy(&data->face_constraint_mask[color],
+                     ArrayView<const unsigned int>(constraint_mask_host.data(),
+                                                   constraint_mask_host.size()),
+                     n_faces);
+
+      alloc_and_copy(&data->face_JxW[color],
+                     ArrayView<const Number>(JxW_host.data(), JxW_host.size()),
+                     n_faces * padding_length);
+
+      // Use the same structure-of-arrays layout for the normal vectors and
+      // the inverse Jacobians as for the inverse Jacobians on the cells
+      transpose_in_place(normal_host, padding_length * n_faces, dim);
+      alloc_and_copy(&data->face_normal_vector[color],
+                     ArrayView<const Number>(normal_host.data(),
+                                             normal_host.size()),
+                     n_faces * padding_length * dim);
+
+      if (face_flags & update_quadrature_points)
+        alloc_and_copy(&data->face_q_points[color],
+                       ArrayView<const Point<dim, Number>>(
+                         q_points_host.data(), q_points_host.size()),
+                       n_faces * padding_length);
+
+      if (face_flags & update_gradients)
+        {
+          transpose_in_place(inv_jacobian_host,
+                             padding_length * n_faces,
+                             dim * dim);
+          alloc_and_copy(&data->face_inv_jacobian[color],
+                         ArrayView<const Number>(inv_jacobian_host.data(),
+                                                 inv_jacobian_host.size()),
+                         n_faces * dim * dim * padding_length);
+        }
+
+      alloc_and_copy(&data->face_number[color],
+                     ArrayView<const unsigned int>(face_number_host.data(),
+                                                   face_number_host.size()),
+                     n_faces);
+
+      alloc_and_copy(&data->face_boundary_id[color],
+                     ArrayView<const types::boundary_id>(
+                       boundary_id_host.data(), boundary_id_host.size()),
+                     n_faces);
+    }
+
+
+
     template <int dim, typename number>
     std::vector<types::global_dof_index>
     get_conflict_indices(
@@ -529,6 +783,8 @@ namespace CUDAWrappers
   MatrixFree<dim, Number>::MatrixFree()
     : n_dofs(0)
     , constrained_dofs(nullptr)
+    , n_boundary_face_colors(0)
+    , face_update_flags(update_default)
     , padding_length(0)
   {}
 
@@ -590,6 +846,34 @@ namespace CUDAWrappers
     data_copy.padding_length  = padding_length;
     data_copy.row_start       = row_start[color];
     data_copy.use_coloring    = use_coloring;
+    data_copy.normal_vector   = nullptr;
+    data_copy.face_number     = nullptr;
+    data_copy.boundary_id     = nullptr;
+
+    return data_copy;
+  }
+
+
+
+  template <int dim, typename Number>
+  MatrixFree<dim, Number>::Data
+  MatrixFree<dim, Number>::get_boundary_face_data(unsigned int color) const
+  {
+    AssertIndexRange(color, n_boundary_face_colors);
+
+    Data data_copy;
+    data_copy.q_points        = face_q_points[color];
+    data_copy.local_to_global = face_local_to_global[color];
+    data_copy.inv_jacobian    = face_inv_jacobian[color];
+    data_copy.JxW             = face_JxW[color];
+    data_copy.constraint_mask = face_constraint_mask[color];
+    data_copy.n_cells         = n_boundary_faces[color];
+    data_copy.padding_length  = padding_length;
+    data_copy.row_start       = 0;
+    data_copy.use_coloring    = use_coloring;
+    data_copy.normal_vector   = face_normal_vector[color];
+    data_copy.face_number     = face_number[color];
+    data_copy.boundary_id     = face_boundary_id[color];
 
     return data_copy;
   }
@@ -657,6 +941,17 @@ namespace CUDAWrappers
     JxW.clear();
     constraint_mask.clear();
 
+    internal::free_device_arrays(face_q_points);
+    internal::free_device_arrays(face_local_to_global);
+    internal::free_device_arrays(face_inv_jacobian);
+    internal::free_device_arrays(face_JxW);
+    internal::free_device_arrays(face_normal_vector);
+    internal::free_device_arrays(face_number);
+    internal::free_device_arrays(face_boundary_id);
+    internal::free_device_arrays(face_constraint_mask);
+    n_boundary_face_colors = 0;
+    n_boundary_faces.clear();
+
     if (constrained_dofs != nullptr)
       {
         cudaError_t cuda_error = cudaFree(constrained_dofs);
@@ -748,6 +1043,25 @@ namespace CUDAWrappers
 
 
 
+  template <int dim, typename Number>
+  template <typename Functor, typename VectorType>
+  void
+  MatrixFree<dim, Number>::boundary_face_loop(const Functor &   func,
+                                              const VectorType &src,
+                                              VectorType &      dst) const
+  {
+    Assert(face_update_flags != update_default,
+           ExcMessage("The data of the boundary faces has not been set up. "
+                      "Set AdditionalData::mapping_update_flags_boundary_faces "
+                      "in reinit()."));
+    if (partitioner)
+      distributed_boundary_face_loop(func, src, dst);
+    else
+      serial_boundary_face_loop(func, src, dst);
+  }
+
+
+
   template <int dim, typename Number>
   template <typename Functor>
   void
@@ -780,6 +1094,17 @@ namespace CUDAWrappers
                  n_cells[i] * sizeof(unsigned int);
       }
 
+    // For each color of the boundary faces, add the same data as for the
+    // cells plus the normal vectors, the face numbers and the boundary ids.
+    for (unsigned int i = 0; i < n_boundary_face_colors; ++i)
+      {
+        bytes += n_boundary_faces[i] * padding_length *
+                   (sizeof(unsigned int) + dim * dim * sizeof(Number) +
+                    (dim + 1) * sizeof(Number) + sizeof(point_type)) +
+                 n_boundary_faces[i] *
+                   (2 * sizeof(unsigned int) + sizeof(types::boundary_id));
+      }
+
     return bytes;
   }
 
@@ -814,6 +1139,12 @@ namespace CUDAWrappers
 
     const FiniteElement<dim> &fe = dof_handler.get_fe();
 
+    face_update_flags = additional_data.mapping_update_flags_boundary_faces;
+    AssertThrow(face_update_flags == update_default ||
+                  parallelization_scheme == parallel_in_elem,
+                ExcMessage("Boundary faces are only supported for the "
+                           "parallel_in_elem parallelization scheme."));
+
     fe_degree = fe.degree;
     // TODO this should be a templated parameter
     const unsigned int n_dofs_1d     = fe_degree + 1;
@@ -852,6 +1183,26 @@ namespace CUDAWrappers
         AssertCuda(cuda_error);
       }
 
+    if (face_update_flags != update_default)
+      {
+        // Lagrange polynomials in the quadrature points evaluated at the
+        // end points of the unit interval
+        const std::vector<Polynomials::Polynomial<double>> lagrange =
+          Polynomials::generate_complete_Lagrange_basis(quad.get_points());
+        std::vector<double> face_interpolation(2 * n_q_points_1d);
+        for (unsigned int i = 0; i < n_q_points_1d; ++i)
+          {
+            face_interpolation[i]                 = lagrange[i].value(0.);
+            face_interpolation[n_q_points_1d + i] = lagrange[i].value(1.);
+          }
+        cuda_error = cudaMemcpyToSymbol(internal::global_face_interpolation,
+                                        face_interpolation.data(),
+                                        2 * n_q_points_1d * sizeof(double),
+                                        0,
+                                        cudaMemcpyHostToDevice);
+        AssertCuda(cuda_error);
+      }
+
     // Setup the number of cells per CUDA thread block
     cells_per_block = cells_per_block_shmem(dim, fe_degree);
 
@@ -885,9 +1236,6 @@ namespace CUDAWrappers
               graph[0].emplace_back(cell);
           }
       }
-    n_colors = graph.size();
-
-    helper.setup_color_arrays(n_colors);
 
     IndexSet locally_relevant_dofs;
     if (comm)
@@ -896,7 +1244,55 @@ namespace CUDAWrappers
                                                 locally_relevant_dofs);
         partitioner = std::make_shared<Utilities::MPI::Partitioner>(
           dof_handler.locally_owned_dofs(), locally_relevant_dofs, *comm);
+        ghosted_src.reinit(partitioner);
+        ghosted_dst.reinit(partitioner);
       }
+
+    // In parallel, split each color into the cells that only access locally
+    // owned degrees of freedom and the ones that also access ghost entries,
+    // and put the colors of the former first. Since the colors are processed
+    // one after the other, this does not introduce any conflicts, and it
+    // allows distributed_cell_loop() to work on the inner cells while the
+    // ghost values are exchanged.
+    if (partitioner && additional_data.overlap_communication_computation)
+      {
+        std::vector<std::vector<CellFilter>> inner_graph;
+        std::vector<std::vector<CellFilter>> ghost_graph;
+        std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+        for (const auto &color : graph)
+          {
+            std::vector<CellFilter> inner_cells;
+            std::vector<CellFilter> ghost_cells;
+            for (const auto &cell : color)
+              {
+                cell->get_dof_indices(dof_indices);
+                if (std::all_of(dof_indices.begin(),
+                                dof_indices.end(),
+                                [&](const types::global_dof_index index) {
+                                  return partitioner->in_local_range(index);
+                                }))
+                  inner_cells.push_back(cell);
+                else
+                  ghost_cells.push_back(cell);
+              }
+            if (inner_cells.size() > 0)
+              inner_graph.push_back(std::move(inner_cells));
+            if (ghost_cells.size() > 0)
+              ghost_graph.push_back(std::move(ghost_cells));
+          }
+        n_inner_colors = inner_graph.size();
+        graph.swap(inner_graph);
+        graph.insert(graph.end(),
+                     std::make_move_iterator(ghost_graph.begin()),
+                     std::make_move_iterator(ghost_graph.end()));
+      }
+    else
+      n_inner_colors = partitioner ? 0 : graph.size();
+
+    n_colors = graph.size();
+
+    helper.setup_color_arrays(n_colors);
+
     for (unsigned int i = 0; i < n_colors; ++i)
       {
         n_cells[i] = graph[i].size();
@@ -909,6 +1305,49 @@ namespace CUDAWrappers
         helper.alloc_and_copy_arrays(i);
       }
 
+    // Collect the faces at the boundary of the locally owned cells and color
+    // them such that faces whose cells share degrees of freedom are in
+    // different colors
+    if (face_update_flags != update_default)
+      {
+        using FaceInfo = std::pair<CellFilter, unsigned int>;
+        std::vector<FaceInfo> boundary_faces;
+        for (auto cell = begin; cell != end; ++cell)
+          for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+            if (cell->at_boundary(f) && !cell->has_periodic_neighbor(f))
+              boundary_faces.emplace_back(cell, f);
+
+        std::vector<std::vector<FaceInfo>> face_graph;
+        if (boundary_faces.size() > 0)
+          {
+            if (additional_data.use_coloring)
+              {
+                using FaceIterator =
+                  typename std::vector<FaceInfo>::const_iterator;
+                const auto fun = [&](const FaceIterator &face) {
+                  return internal::get_conflict_indices<dim, Number>(
+                    face->first, constraints);
+                };
+                const std::vector<std::vector<FaceIterator>> coloring =
+                  GraphColoring::make_graph_coloring(boundary_faces.cbegin(),
+                                                     boundary_faces.cend(),
+                                                     fun);
+                face_graph.resize(coloring.size());
+                for (unsigned int c = 0; c < coloring.size(); ++c)
+                  for (const auto &face : coloring[c])
+                    face_graph[c].push_back(*face);
+              }
+            else
+              face_graph.push_back(boundary_faces);
+          }
+
+        n_boundary_face_colors = face_graph.size();
+        helper.setup_boundary_face_color_arrays(n_boundary_face_colors);
+        for (unsigned int i = 0; i < n_boundary_face_colors; ++i)
+          helper.setup_boundary_face_arrays(
+            i, face_graph[i], quad, face_update_flags, partitioner);
+      }
+
     // Setup row starts
     if (n_colors > 0)
       row_start[0] = 0;
@@ -1008,15 +1447,27 @@ namespace CUDAWrappers
     const LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &src,
     LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &dst) const
   {
-    // Create the ghosted source and the ghosted destination
-    LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> ghosted_src(
-      partitioner);
-    LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> ghosted_dst(
-      ghosted_src);
-    ghosted_src = src;
+    // Copy the source into the ghosted source and start the exchange of its
+    // ghost values. With CUDA-aware MPI, the data is packed and unpacked on
+    // the device and sent directly from device memory.
+    ghosted_src.copy_locally_owned_data_from(src);
+    ghosted_src.update_ghost_values_start();
+    ghosted_dst = Number();
+
+    // Work on the cells that only access locally owned entries while the
+    // messages are in flight. Kernel launches are asynchronous, so the
+    // exchange proceeds on the host while the device is busy.
+    for (unsigned int i = 0; i < n_inner_colors; ++i)
+      internal::apply_kernel_shmem<dim, Number, Functor>
+        <<<grid_dim[i], block_dim[i]>>>(func,
+                                        get_data(i),
+                                        ghosted_src.get_values(),
+                                        ghosted_dst.get_values());
 
-    // Execute the loop on the cells
-    for (unsigned int i = 0; i < n_colors; ++i)
+    ghosted_src.update_ghost_values_finish();
+
+    // Execute the loop on the remaining cells
+    for (unsigned int i = n_inner_colors; i < n_colors; ++i)
       internal::apply_kernel_shmem<dim, Number, Functor>
         <<<grid_dim[i], block_dim[i]>>>(func,
                                         get_data(i),
@@ -1025,7 +1476,9 @@ namespace CUDAWrappers
 
     // Add the ghosted values
     ghosted_dst.compress(VectorOperation::add);
-    dst = ghosted_dst;
+    dst.copy_locally_owned_data_from(ghosted_dst);
+    if (dst.has_ghost_elements())
+      dst.update_ghost_values();
   }
 
 
@@ -1043,6 +1496,64 @@ namespace CUDAWrappers
 
 
 
+  template <int dim, typename Number>
+  template <typename Functor, typename VectorType>
+  void
+  MatrixFree<dim, Number>::serial_boundary_face_loop(const Functor &   func,
+                                                     const VectorType &src,
+                                                     VectorType &dst) const
+  {
+    for (unsigned int i = 0; i < n_boundary_face_colors; ++i)
+      internal::apply_kernel_shmem<dim, Number, Functor>
+        <<<face_grid_dim[i], face_block_dim[i]>>>(func,
+                                                  get_boundary_face_data(i),
+                                                  src.get_values(),
+                                                  dst.get_values());
+  }
+
+
+
+  template <int dim, typename Number>
+  template <typename Functor>
+  void
+  MatrixFree<dim, Number>::distributed_boundary_face_loop(
+    const Functor &                                                      func,
+    const LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &src,
+    LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> &dst) const
+  {
+    // The degrees of freedom of a cell at the boundary may be owned by
+    // another process, so complete the exchange of the ghost values before
+    // any face is processed
+    ghosted_src.copy_locally_owned_data_from(src);
+    ghosted_src.update_ghost_values();
+    ghosted_dst = Number();
+
+    for (unsigned int i = 0; i < n_boundary_face_colors; ++i)
+      internal::apply_kernel_shmem<dim, Number, Functor>
+        <<<face_grid_dim[i], face_block_dim[i]>>>(func,
+                                                  get_boundary_face_data(i),
+                                                  ghosted_src.get_values(),
+                                                  ghosted_dst.get_values());
+
+    ghosted_dst.compress(VectorOperation::add);
+    dst.add(Number(1.), ghosted_dst);
+  }
+
+
+
+  template <int dim, typename Number>
+  template <typename Functor>
+  void
+  MatrixFree<dim, Number>::distributed_boundary_face_loop(
+    const Functor &,
+    const LinearAlgebra::CUDAWrappers::Vector<Number> &,
+    LinearAlgebra::CUDAWrappers::Vector<Number> &) const
+  {
+    Assert(false, ExcInternalError());
+  }
+
+
+
   template <int dim, typename Number>
   template <typename VectorType>
   void
@@ -105,6 +105,14 @@ namespace internal
       fe_index_from_degree(const unsigned int first_selected_component,
                            const unsigned int fe_degree) const;
 
+      /**
+       * Return whether the cell with index @p cell_no in the layout of @p
+       * row_starts is treated by the fast hanging node algorithm, i.e.,
+       * whether its entry in @p hanging_node_constraint_masks is non-zero.
+       */
+      bool
+      has_hanging_node_constraints(const unsigned int cell_no) const;
+
       /**
        * Populate the vector @p locall_indices with locally owned degrees of freedom
        * stored on the cell block @p cell.
@@ -136,11 +144,20 @@ namespace internal
        * processor, get a temporary number by this function, and will later be
        * assigned the correct index after all the ghost indices have been
        * collected by the call to @p assign_ghosts.
+       *
+       * The indices @p local_indices_resolved are used for the constrained
+       * access, whereas the plain indices are taken from @p local_indices.
+       * The two differ on cells treated by the fast hanging node algorithm,
+       * where the indices on hanging faces have been replaced by the ones of
+       * the parent, see HangingNodes. The mask of such a cell is passed as
+       * @p hanging_node_mask.
        */
       template <typename number>
       void
       read_dof_indices(
+        const std::vector<types::global_dof_index> &local_indices_resolved,
         const std::vector<types::global_dof_index> &local_indices,
+        const unsigned int                          hanging_node_mask,
         const std::vector<unsigned int> &           lexicographic_inv,
         const AffineConstraints<number> &           constraints,
         const unsigned int                          cell_number,
@@ -218,6 +235,12 @@ namespace internal
        * The intent of this pattern is to zero the vector entries in close
        * temporal proximity to the first access and thus keeping the vector
        * entries in cache.
+       *
+       * This function also fills the ranges of the locally owned degrees of
+       * freedom on which the operations before and after the cell loop of
+       * MatrixFree::cell_loop() are run, stored in the member variables @p
+       * cell_loop_pre_list_index, @p cell_loop_pre_list, @p
+       * cell_loop_post_list_index, and @p cell_loop_post_list.
        */
       template <int length>
       void
@@ -427,6 +450,14 @@ namespace internal
       std::vector<std::pair<unsigned short, unsigned short>>
         constraint_indicator;
 
+      /**
+       * Stores the inhomogeneity of each constrained degree of freedom
+       * described by the entry of the same index in @p constraint_indicator.
+       * This field is only filled if @p store_inhomogeneities is set and
+       * empty otherwise.
+       */
+      std::vector<double> constraint_inhomogeneities;
+
       /**
        * Reordered index storage for `IndexStorageVariants::interleaved`.
        */
@@ -507,6 +538,17 @@ namespace internal
        */
       std::vector<unsigned int> plain_dof_indices;
 
+      /**
+       * Stores the masks of the fast hanging node algorithm for each cell,
+       * see HangingNodes and HangingNodeMaskBits, in the same layout as the
+       * cells in @p row_starts. A cell with mask zero reads its indices as
+       * usual, whereas the indices stored in @p dof_indices for the cells
+       * with a non-zero mask refer to the parent's degrees of freedom on the
+       * hanging faces, and FEEvaluation interpolates the values from these.
+       * Empty if the fast hanging node algorithm is not used.
+       */
+      std::vector<unsigned int> hanging_node_constraint_masks;
+
       /**
        * Stores the offset in terms of the number of base elements over all
        * DoFInfo objects.
@@ -565,6 +607,12 @@ namespace internal
        */
       bool store_plain_indices;
 
+      /**
+       * Informs on whether the inhomogeneities of the constraints are
+       * stored in @p constraint_inhomogeneities.
+       */
+      bool store_inhomogeneities;
+
       /**
        * Stores the index of the active finite element in the hp case.
        */
@@ -601,6 +649,39 @@ namespace internal
        * Stores the actual ranges in the vector to be cleared.
        */
       std::vector<unsigned int> vector_zero_range_list;
+
+      /**
+       * Stores an index to each partition in TaskInfo into the array @p
+       * cell_loop_pre_list, pointing to the ranges of locally owned vector
+       * entries that are first accessed by the cells of the partition. The
+       * entry after the last partition collects the ranges that are exchanged
+       * with other processes (or not accessed by any cell), which need to be
+       * processed before the communication starts.
+       */
+      std::vector<unsigned int> cell_loop_pre_list_index;
+
+      /**
+       * Stores the ranges of locally owned vector entries (in MPI-local
+       * numbering) for the operation before the cell loop.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>> cell_loop_pre_list;
+
+      /**
+       * Stores an index to each partition in TaskInfo into the array @p
+       * cell_loop_post_list, pointing to the ranges of locally owned vector
+       * entries that are accessed for the last time by the cells of the
+       * partition. The entry after the last partition collects the ranges
+       * that are exchanged with other processes (or not accessed by any
+       * cell), which can only be processed after the communication has
+       * finished.
+       */
+      std::vector<unsigned int> cell_loop_post_list_index;
+
+      /**
+       * Stores the ranges of locally owned vector entries (in MPI-local
+       * numbering) for the operation after the cell loop.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>> cell_loop_post_list;
     };
 
 
@@ -622,6 +703,15 @@ namespace internal
       return numbers::invalid_unsigned_int;
     }
 
+
+
+    inline bool
+    DoFInfo::has_hanging_node_constraints(const unsigned int cell_no) const
+    {
+      return cell_no < hanging_node_constraint_masks.size() &&
+             hanging_node_constraint_masks[cell_no] != 0;
+    }
+
 #endif // ifndef DOXYGEN
 
   } // end of namespace MatrixFreeFunctions
@@ -155,6 +155,7 @@ namespace internal
       row_starts.clear();
       dof_indices.clear();
       constraint_indicator.clear();
+      constraint_inhomogeneities.clear();
       vector_partitioner.reset();
       ghost_dofs.clear();
       dofs_per_cell.clear();
@@ -167,6 +168,7 @@ namespace internal
       start_components.clear();
       row_starts_plain_indices.clear();
       plain_dof_indices.clear();
+      hanging_node_constraint_masks.clear();
       dof_indices_interleaved.clear();
       for (unsigned int i = 0; i < 3; ++i)
         {
@@ -175,10 +177,17 @@ namespace internal
           dof_indices_interleave_strides[i].clear();
           n_vectorization_lanes_filled[i].clear();
         }
-      store_plain_indices = false;
+      store_plain_indices   = false;
+      store_inhomogeneities = false;
       cell_active_fe_index.clear();
       max_fe_index = 0;
       fe_index_conversion.clear();
+      vector_zero_range_list_index.clear();
+      vector_zero_range_list.clear();
+      cell_loop_pre_list_index.clear();
+      cell_loop_pre_list.clear();
+      cell_loop_post_list_index.clear();
+      cell_loop_post_list.clear();
     }
 
 
@@ -217,7 +226,8 @@ namespace internal
           // shift for this cell within the block as compared to the next
           // one
           const bool has_constraints =
-            row_starts[ib].second != row_starts[ib + n_fe_components].second;
+            row_starts[ib].second != row_starts[ib + n_fe_components].second ||
+            has_hanging_node_constraints(cell * n_vectorization + v);
 
           auto do_copy = [&](const unsigned int *begin,
                              const unsigned int *end) {
@@ -253,7 +263,9 @@ namespace internal
     template <typename number>
     void
     DoFInfo ::read_dof_indices(
+      const std::vector<types::global_dof_index> &local_indices_resolved,
       const std::vector<types::global_dof_index> &local_indices,
+      const unsigned int                          hanging_node_mask,
       const std::vector<unsigned int> &           lexicographic_inv,
       const AffineConstraints<number> &           constraints,
       const unsigned int                          cell_number,
@@ -287,7 +299,7 @@ namespace internal
                i++)
             {
               types::global_dof_index current_dof =
-                local_indices[lexicographic_inv[i]];
+                local_indices_resolved[lexicographic_inv[i]];
               const auto *entries_ptr =
                 constraints.get_constraint_entries(current_dof);
 
@@ -305,12 +317,18 @@ namespace internal
 
                   // check whether this dof is identity constrained to another
                   // dof. then we can simply insert that dof and there is no
-                  // need to actually resolve the constraint entries
+                  // need to actually resolve the constraint entries, unless
+                  // a non-zero inhomogeneity must be recorded
                   const auto &                  entries   = *entries_ptr;
                   const types::global_dof_index n_entries = entries.size();
+                  const double                  inhomogeneity =
+                    store_inhomogeneities ?
+                      constraints.get_inhomogeneity(current_dof) :
+                      0.;
                   if (n_entries == 1 &&
                       std::abs(entries[0].second - 1.) <
-                        100 * std::numeric_limits<double>::epsilon())
+                        100 * std::numeric_limits<double>::epsilon() &&
+                      inhomogeneity == 0.)
                     {
                       current_dof = entries[0].first;
                       goto no_constraint;
@@ -320,6 +338,8 @@ namespace internal
                   constraint_indicator.push_back(constraint_iterator);
                   constraint_indicator.back().second =
                     constraint_values.insert_entries(entries);
+                  if (store_inhomogeneities)
+                    constraint_inhomogeneities.push_back(inhomogeneity);
 
                   // reset constraint iterator for next round
                   constraint_iterator.first = 0;
@@ -387,6 +407,15 @@ namespace internal
             constraint_indicator.size();
         }
 
+      if (hanging_node_mask != 0)
+        {
+          if (hanging_node_constraint_masks.empty())
+            hanging_node_constraint_masks.resize((row_starts.size() - 1) /
+                                                   n_components,
+                                                 0);
+          hanging_node_constraint_masks[cell_number] = hanging_node_mask;
+        }
+
       // now to the plain indices: in case we have constraints on this cell,
       // store the indices without the constraints resolve once again
       if (store_plain_indices == true)
@@ -397,7 +426,8 @@ namespace internal
           row_starts_plain_indices[cell_number] = plain_dof_indices.size();
           const bool cell_has_constraints =
             (row_starts[(cell_number + 1) * n_components].second >
-             row_starts[cell_number * n_components].second);
+             row_starts[cell_number * n_components].second) ||
+            hanging_node_mask != 0;
           if (cell_has_constraints == true)
             {
               for (unsigned int i = 0; i < dofs_this_cell; ++i)
@@ -505,7 +535,9 @@ namespace internal
               if (store_plain_indices == true)
                 {
                   if (row_starts[boundary_cells[i] * n_components].second !=
-                      row_starts[(boundary_cells[i] + 1) * n_components].second)
+                        row_starts[(boundary_cells[i] + 1) * n_components]
+                          .second ||
+                      has_hanging_node_constraints(boundary_cells[i]))
                     {
                       unsigned int *data_ptr =
                         plain_dof_indices.data() +
@@ -592,10 +624,13 @@ namespace internal
       std::vector<unsigned int> new_dof_indices;
       std::vector<std::pair<unsigned short, unsigned short>>
                                 new_constraint_indicator;
+      std::vector<double>       new_constraint_inhomogeneities;
       std::vector<unsigned int> new_plain_indices, new_rowstart_plain;
       unsigned int              position_cell = 0;
       new_dof_indices.reserve(dof_indices.size());
       new_constraint_indicator.reserve(constraint_indicator.size());
+      new_constraint_inhomogeneities.reserve(
+        constraint_inhomogeneities.size());
       if (store_plain_indices == true)
         {
           new_rowstart_plain.resize(vectorization_length *
@@ -640,12 +675,18 @@ namespace internal
                   for (unsigned int index = row_starts[cell_no + comp].second;
                        index != row_starts[cell_no + comp + 1].second;
                        ++index)
-                    new_constraint_indicator.push_back(
-                      constraint_indicator[index]);
+                    {
+                      new_constraint_indicator.push_back(
+                        constraint_indicator[index]);
+                      if (store_inhomogeneities)
+                        new_constraint_inhomogeneities.push_back(
+                          constraint_inhomogeneities[index]);
+                    }
                 }
               if (store_plain_indices &&
-                  row_starts[cell_no].second !=
-                    row_starts[cell_no + n_components].second)
+                  (row_starts[cell_no].second !=
+                     row_starts[cell_no + n_components].second ||
+                   has_hanging_node_constraints(cell_no / n_components)))
                 {
                   new_rowstart_plain[i * vectorization_length + j] =
                     new_plain_indices.size();
@@ -686,9 +727,30 @@ namespace internal
       new_row_starts.swap(row_starts);
       new_dof_indices.swap(dof_indices);
       new_constraint_indicator.swap(constraint_indicator);
+      new_constraint_inhomogeneities.swap(constraint_inhomogeneities);
       new_plain_indices.swap(plain_dof_indices);
       new_rowstart_plain.swap(row_starts_plain_indices);
 
+      if (!hanging_node_constraint_masks.empty())
+        {
+          std::vector<unsigned int> new_masks(
+            vectorization_length * task_info.cell_partition_data.back(), 0);
+          position_cell = 0;
+          for (unsigned int i = 0; i < task_info.cell_partition_data.back();
+               ++i)
+            {
+              const unsigned int n_vect =
+                (irregular_cells[i] > 0 ? irregular_cells[i] :
+                                          vectorization_length);
+              for (unsigned int j = 0; j < n_vect; ++j)
+                new_masks[i * vectorization_length + j] =
+                  hanging_node_constraint_masks[renumbering[position_cell +
+                                                            j]];
+              position_cell += n_vect;
+            }
+          new_masks.swap(hanging_node_constraint_masks);
+        }
+
 #ifdef DEBUG
       // sanity check 1: all indices should be smaller than the number of dofs
       // locally owned plus the number of ghosts
@@ -794,7 +856,8 @@ namespace internal
             {
               const unsigned int cell_no = i * vectorization_length + j;
               if (row_starts[cell_no * n_components].second !=
-                  row_starts[(cell_no + 1) * n_components].second)
+                    row_starts[(cell_no + 1) * n_components].second ||
+                  has_hanging_node_constraints(cell_no))
                 {
                   has_constraints = true;
                   break;
@@ -1217,6 +1280,16 @@ namespace internal
       std::vector<unsigned int> touched_by(
         (n_dofs + chunk_size_zero_vector - 1) / chunk_size_zero_vector,
         numbers::invalid_unsigned_int);
+
+      // for the operations before and after MatrixFree::cell_loop(), also
+      // record the first and last partition in which a chunk of locally
+      // owned degrees of freedom is accessed by a cell
+      const unsigned int n_owned_dofs = vector_partitioner->local_size();
+      std::vector<unsigned int> cell_first_touched_by(
+        (n_owned_dofs + chunk_size_zero_vector - 1) / chunk_size_zero_vector,
+        numbers::invalid_unsigned_int);
+      std::vector<unsigned int> cell_last_touched_by(
+        cell_first_touched_by.size(), numbers::invalid_unsigned_int);
       for (unsigned int part = 0;
            part < task_info.partition_row_index.size() - 2;
            ++part)
@@ -1240,6 +1313,13 @@ namespace internal
                       dof_indices[it] / chunk_size_zero_vector;
                     if (touched_by[myindex] == numbers::invalid_unsigned_int)
                       touched_by[myindex] = chunk;
+                    if (dof_indices[it] < n_owned_dofs)
+                      {
+                        if (cell_first_touched_by[myindex] ==
+                            numbers::invalid_unsigned_int)
+                          cell_first_touched_by[myindex] = chunk;
+                        cell_last_touched_by[myindex] = chunk;
+                      }
                   }
               }
             if (faces.size() > 0)
@@ -1295,6 +1375,62 @@ namespace internal
             vector_zero_range_list_index[chunk + 1] =
               vector_zero_range_list_index[chunk];
         }
+
+      // The entries that are sent to other processes must be processed by
+      // the operation before the loop prior to the start of the ghost
+      // exchange, and receive contributions from other processes in the
+      // compress step, so they can only be processed after the communication
+      // has finished. We collect them, together with entries not touched by
+      // any cell, in an additional range after the last partition.
+      const unsigned int n_partitions =
+        task_info.partition_row_index[task_info.partition_row_index.size() -
+                                      2];
+      for (const auto &range : vector_partitioner->import_indices())
+        if (range.second > range.first)
+          for (unsigned int i = range.first / chunk_size_zero_vector;
+               i <= (range.second - 1) / chunk_size_zero_vector;
+               ++i)
+            cell_first_touched_by[i] = cell_last_touched_by[i] = n_partitions;
+      for (unsigned int i = 0; i < cell_first_touched_by.size(); ++i)
+        if (cell_first_touched_by[i] == numbers::invalid_unsigned_int)
+          cell_first_touched_by[i] = cell_last_touched_by[i] = n_partitions;
+
+      // convert the chunk indices into a list of ranges per partition, in a
+      // sparsity-pattern like structure, merging adjacent chunks
+      const auto fill_range_list =
+        [&](const std::vector<unsigned int> &touched,
+            std::vector<unsigned int> &      range_list_index,
+            std::vector<std::pair<unsigned int, unsigned int>> &range_list) {
+          std::vector<std::vector<unsigned int>> chunks_in_partition(
+            n_partitions + 1);
+          for (unsigned int i = 0; i < touched.size(); ++i)
+            chunks_in_partition[touched[i]].push_back(i);
+
+          range_list_index.resize(n_partitions + 2);
+          range_list.clear();
+          range_list_index[0] = 0;
+          for (unsigned int part = 0; part < n_partitions + 1; ++part)
+            {
+              for (const unsigned int i : chunks_in_partition[part])
+                {
+                  const unsigned int begin = i * chunk_size_zero_vector;
+                  const unsigned int end =
+                    std::min((i + 1) * chunk_size_zero_vector, n_owned_dofs);
+                  if (range_list.size() > range_list_index[part] &&
+                      range_list.back().second == begin)
+                    range_list.back().second = end;
+                  else
+                    range_list.emplace_back(begin, end);
+                }
+              range_list_index[part + 1] = range_list.size();
+            }
+        };
+      fill_range_list(cell_first_touched_by,
+                      cell_loop_pre_list_index,
+                      cell_loop_pre_list);
+      fill_range_list(cell_last_touched_by,
+                      cell_loop_post_list_index,
+                      cell_loop_post_list);
     }
 
 
@@ -1607,7 +1743,43 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(row_starts_plain_indices);
       memory += MemoryConsumption::memory_consumption(plain_dof_indices);
       memory += MemoryConsumption::memory_consumption(constraint_indicator);
-      memory += MemoryConsumption::memory_consumption(*vector_partitioner);
+      memory +=
+        MemoryConsumption::memory_consumption(constraint_inhomogeneities);
+      memory +=
+        MemoryConsumption::memory_consumption(hanging_node_constraint_masks);
+      memory += MemoryConsumption::memory_consumption(dof_indices_interleaved);
+      for (unsigned int i = 0; i < 3; ++i)
+        {
+          memory += index_storage_variants[i].capacity() *
+                    sizeof(IndexStorageVariants);
+          memory +=
+            MemoryConsumption::memory_consumption(dof_indices_contiguous[i]);
+          memory += MemoryConsumption::memory_consumption(
+            dof_indices_interleave_strides[i]);
+          memory += MemoryConsumption::memory_consumption(
+            n_vectorization_lanes_filled[i]);
+        }
+      if (vector_partitioner.get() != nullptr)
+        memory += MemoryConsumption::memory_consumption(*vector_partitioner);
+      memory += MemoryConsumption::memory_consumption(constrained_dofs);
+      memory += MemoryConsumption::memory_consumption(n_components);
+      memory += MemoryConsumption::memory_consumption(start_components);
+      memory += MemoryConsumption::memory_consumption(component_to_base_index);
+      memory +=
+        MemoryConsumption::memory_consumption(component_dof_indices_offset);
+      memory += MemoryConsumption::memory_consumption(dofs_per_cell);
+      memory += MemoryConsumption::memory_consumption(dofs_per_face);
+      memory += MemoryConsumption::memory_consumption(cell_active_fe_index);
+      memory += MemoryConsumption::memory_consumption(fe_index_conversion);
+      memory += MemoryConsumption::memory_consumption(ghost_dofs);
+      memory +=
+        MemoryConsumption::memory_consumption(vector_zero_range_list_index);
+      memory += MemoryConsumption::memory_consumption(vector_zero_range_list);
+      memory += MemoryConsumption::memory_consumption(cell_loop_pre_list_index);
+      memory += MemoryConsumption::memory_consumption(cell_loop_pre_list);
+      memory +=
+        MemoryConsumption::memory_consumption(cell_loop_post_list_index);
+      memory += MemoryConsumption::memory_consumption(cell_loop_post_list);
       return memory;
     }
 
@@ -1633,6 +1805,15 @@ namespace internal
         out,
         MemoryConsumption::memory_consumption(row_starts_plain_indices) +
           MemoryConsumption::memory_consumption(plain_dof_indices));
+      out << "       Memory vectorized indices:    ";
+      std::size_t vectorized_index_memory =
+        MemoryConsumption::memory_consumption(dof_indices_interleaved);
+      for (unsigned int i = 0; i < 3; ++i)
+        vectorized_index_memory +=
+          MemoryConsumption::memory_consumption(dof_indices_contiguous[i]) +
+          MemoryConsumption::memory_consumption(
+            dof_indices_interleave_strides[i]);
+      task_info.print_memory_statistics(out, vectorized_index_memory);
       out << "       Memory vector partitioner:    ";
       task_info.print_memory_statistics(
         out, MemoryConsumption::memory_consumption(*vector_partitioner));
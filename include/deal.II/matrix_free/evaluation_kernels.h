@@ -1352,163 +1352,429 @@ namespace internal
                      Number *                                      values_dofs,
                      Number *                                      values_quad,
                      Number *           gradients_quad,
+                     Number *           hessians_quad,
                      Number *           scratch_data,
                      const bool         evaluate_val,
                      const bool         evaluate_grad,
+                     const bool         evaluate_hess,
+                     const unsigned int subface_index);
+
+    // Computes the Hessians of a single component on the face in the face
+    // coordinate system (normal direction last) from the values, the normal
+    // derivatives, and the second normal derivatives interpolated to the
+    // face, which are stored one after the other in @p values_dofs. The
+    // tangential second derivatives and the mixed derivatives are computed
+    // with the in-face kernels (collocation derivatives if possible) and the
+    // second normal derivative is interpolated, which results in a cost
+    // similar to the evaluation of the gradients.
+    static void
+    evaluate_hessians_in_face(
+      const MatrixFreeFunctions::ShapeInfo<Number> &data,
+      const Number *                                values_dofs,
+      Number *                                      hessians_quad,
+      Number *                                      scratch_data,
+      const unsigned int                            subface_index);
+
+    static void
+    integrate_in_face(const MatrixFreeFunctions::ShapeInfo<Number> &data,
+                      Number *                                      values_dofs,
+                      Number *                                      values_quad,
+                      Number *           gradients_quad,
+                      Number *           scratch_data,
+                      const bool         integrate_val,
+                      const bool         integrate_grad,
+                      const unsigned int subface_index);
+  };
+
+
+
+  template <bool symmetric_evaluate,
+            int  dim,
+            int  fe_degree,
+            int  n_q_points_1d,
+            int  n_components,
+            typename Number>
+  void
+  FEFaceEvaluationImpl<symmetric_evaluate,
+                       dim,
+                       fe_degree,
+                       n_q_points_1d,
+                       n_components,
+                       Number>::
+    evaluate_in_face(const MatrixFreeFunctions::ShapeInfo<Number> &data,
+                     Number *                                      values_dofs,
+                     Number *                                      values_quad,
+                     Number *           gradients_quad,
+                     Number *           hessians_quad,
+                     Number *           scratch_data,
+                     const bool         evaluate_val,
+                     const bool         evaluate_grad,
+                     const bool         evaluate_hess,
                      const unsigned int subface_index)
-    {
-      const AlignedVector<Number> &val1 =
-        symmetric_evaluate ?
-          data.shape_values_eo :
-          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
-             data.shape_values :
-             data.values_within_subface[subface_index % 2]);
-      const AlignedVector<Number> &val2 =
-        symmetric_evaluate ?
-          data.shape_values_eo :
-          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
-             data.shape_values :
-             data.values_within_subface[subface_index / 2]);
-
-      const AlignedVector<Number> &grad1 =
-        symmetric_evaluate ?
-          data.shape_gradients_eo :
-          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
-             data.shape_gradients :
-             data.gradients_within_subface[subface_index % 2]);
-      const AlignedVector<Number> &grad2 =
-        symmetric_evaluate ?
-          data.shape_gradients_eo :
-          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
-             data.shape_gradients :
-             data.gradients_within_subface[subface_index / 2]);
-
-      using Eval =
-        internal::EvaluatorTensorProduct<symmetric_evaluate ?
-                                           internal::evaluate_evenodd :
-                                           internal::evaluate_general,
-                                         dim - 1,
-                                         fe_degree + 1,
-                                         n_q_points_1d,
-                                         Number>;
-      Eval eval1(val1,
-                 grad1,
-                 AlignedVector<Number>(),
-                 data.fe_degree + 1,
-                 data.n_q_points_1d);
-      Eval eval2(val2,
-                 grad2,
-                 AlignedVector<Number>(),
-                 data.fe_degree + 1,
-                 data.n_q_points_1d);
-
-      const unsigned int size_deg =
-        fe_degree > -1 ?
-          Utilities::pow(fe_degree + 1, dim - 1) :
-          (dim > 1 ? Utilities::fixed_power<dim - 1>(data.fe_degree + 1) : 1);
-
-      const unsigned int n_q_points = fe_degree > -1 ?
-                                        Utilities::pow(n_q_points_1d, dim - 1) :
-                                        data.n_q_points_face;
-
-      if (evaluate_grad == false)
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            switch (dim)
-              {
-                case 3:
-                  eval1.template values<0, true, false>(values_dofs,
-                                                        values_quad);
-                  eval2.template values<1, true, false>(values_quad,
-                                                        values_quad);
-                  break;
-                case 2:
+  {
+    const AlignedVector<Number> &val1 =
+      symmetric_evaluate ?
+        data.shape_values_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_values :
+           data.values_within_subface[subface_index % 2]);
+    const AlignedVector<Number> &val2 =
+      symmetric_evaluate ?
+        data.shape_values_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_values :
+           data.values_within_subface[subface_index / 2]);
+
+    const AlignedVector<Number> &grad1 =
+      symmetric_evaluate ?
+        data.shape_gradients_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_gradients :
+           data.gradients_within_subface[subface_index % 2]);
+    const AlignedVector<Number> &grad2 =
+      symmetric_evaluate ?
+        data.shape_gradients_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_gradients :
+           data.gradients_within_subface[subface_index / 2]);
+
+    using Eval =
+      internal::EvaluatorTensorProduct<symmetric_evaluate ?
+                                         internal::evaluate_evenodd :
+                                         internal::evaluate_general,
+                                       dim - 1,
+                                       fe_degree + 1,
+                                       n_q_points_1d,
+                                       Number>;
+    Eval eval1(val1,
+               grad1,
+               AlignedVector<Number>(),
+               data.fe_degree + 1,
+               data.n_q_points_1d);
+    Eval eval2(val2,
+               grad2,
+               AlignedVector<Number>(),
+               data.fe_degree + 1,
+               data.n_q_points_1d);
+
+    const unsigned int size_deg =
+      fe_degree > -1 ?
+        Utilities::pow(fe_degree + 1, dim - 1) :
+        (dim > 1 ? Utilities::fixed_power<dim - 1>(data.fe_degree + 1) : 1);
+
+    const unsigned int n_q_points = fe_degree > -1 ?
+                                      Utilities::pow(n_q_points_1d, dim - 1) :
+                                      data.n_q_points_face;
+
+    // the second normal derivatives are stored after the values and the
+    // normal derivatives in case the Hessians are requested
+    const unsigned int dofs_stride = (evaluate_hess ? 3 : 2) * size_deg;
+    constexpr unsigned int n_hessian_components = (dim * (dim + 1)) / 2;
+
+    if (evaluate_grad == false)
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          switch (dim)
+            {
+              case 3:
+                eval1.template values<0, true, false>(values_dofs,
+                                                      values_quad);
+                eval2.template values<1, true, false>(values_quad,
+                                                      values_quad);
+                break;
+              case 2:
+                eval1.template values<0, true, false>(values_dofs,
+                                                      values_quad);
+                break;
+              case 1:
+                values_quad[0] = values_dofs[0];
+                break;
+              default:
+                Assert(false, ExcNotImplemented());
+            }
+          if (evaluate_hess)
+            {
+              evaluate_hessians_in_face(
+                data, values_dofs, hessians_quad, scratch_data, subface_index);
+              hessians_quad += n_hessian_components * n_q_points;
+            }
+          values_dofs += dofs_stride;
+          values_quad += n_q_points;
+        }
+    else
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          switch (dim)
+            {
+              case 3:
+                if (use_collocation)
+                  {
+                    eval1.template values<0, true, false>(values_dofs,
+                                                          values_quad);
+                    eval1.template values<1, true, false>(values_quad,
+                                                          values_quad);
+                    internal::EvaluatorTensorProduct<
+                      internal::evaluate_evenodd,
+                      dim - 1,
+                      n_q_points_1d,
+                      n_q_points_1d,
+                      Number>
+                      eval_grad(AlignedVector<Number>(),
+                                data.shape_gradients_collocation_eo,
+                                AlignedVector<Number>());
+                    eval_grad.template gradients<0, true, false>(
+                      values_quad, gradients_quad);
+                    eval_grad.template gradients<1, true, false>(
+                      values_quad, gradients_quad + n_q_points);
+                  }
+                else
+                  {
+                    eval1.template gradients<0, true, false>(values_dofs,
+                                                             scratch_data);
+                    eval2.template values<1, true, false>(scratch_data,
+                                                          gradients_quad);
+
+                    eval1.template values<0, true, false>(values_dofs,
+                                                          scratch_data);
+                    eval2.template gradients<1, true, false>(scratch_data,
+                                                             gradients_quad +
+                                                               n_q_points);
+
+                    if (evaluate_val == true)
+                      eval2.template values<1, true, false>(scratch_data,
+                                                            values_quad);
+                  }
+                eval1.template values<0, true, false>(values_dofs + size_deg,
+                                                      scratch_data);
+                eval2.template values<1, true, false>(
+                  scratch_data, gradients_quad + (dim - 1) * n_q_points);
+
+                break;
+              case 2:
+                eval1.template values<0, true, false>(values_dofs + size_deg,
+                                                      gradients_quad +
+                                                        (dim - 1) *
+                                                          n_q_points);
+                eval1.template gradients<0, true, false>(values_dofs,
+                                                         gradients_quad);
+                if (evaluate_val == true)
                   eval1.template values<0, true, false>(values_dofs,
                                                         values_quad);
-                  break;
-                case 1:
-                  values_quad[0] = values_dofs[0];
-                  break;
-                default:
-                  Assert(false, ExcNotImplemented());
-              }
-            values_dofs += 2 * size_deg;
-            values_quad += n_q_points;
-          }
-      else
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            switch (dim)
-              {
-                case 3:
-                  if (use_collocation)
-                    {
-                      eval1.template values<0, true, false>(values_dofs,
-                                                            values_quad);
-                      eval1.template values<1, true, false>(values_quad,
-                                                            values_quad);
-                      internal::EvaluatorTensorProduct<
-                        internal::evaluate_evenodd,
-                        dim - 1,
-                        n_q_points_1d,
-                        n_q_points_1d,
-                        Number>
-                        eval_grad(AlignedVector<Number>(),
-                                  data.shape_gradients_collocation_eo,
-                                  AlignedVector<Number>());
-                      eval_grad.template gradients<0, true, false>(
-                        values_quad, gradients_quad);
-                      eval_grad.template gradients<1, true, false>(
-                        values_quad, gradients_quad + n_q_points);
-                    }
-                  else
-                    {
-                      eval1.template gradients<0, true, false>(values_dofs,
-                                                               scratch_data);
-                      eval2.template values<1, true, false>(scratch_data,
-                                                            gradients_quad);
+                break;
+              case 1:
+                values_quad[0]    = values_dofs[0];
+                gradients_quad[0] = values_dofs[1];
+                break;
+              default:
+                AssertThrow(false, ExcNotImplemented());
+            }
+          if (evaluate_hess)
+            {
+              evaluate_hessians_in_face(
+                data, values_dofs, hessians_quad, scratch_data, subface_index);
+              hessians_quad += n_hessian_components * n_q_points;
+            }
+          values_dofs += dofs_stride;
+          values_quad += n_q_points;
+          gradients_quad += dim * n_q_points;
+        }
+  }
 
-                      eval1.template values<0, true, false>(values_dofs,
-                                                            scratch_data);
-                      eval2.template gradients<1, true, false>(scratch_data,
-                                                               gradients_quad +
-                                                                 n_q_points);
 
-                      if (evaluate_val == true)
-                        eval2.template values<1, true, false>(scratch_data,
-                                                              values_quad);
-                    }
-                  eval1.template values<0, true, false>(values_dofs + size_deg,
-                                                        scratch_data);
-                  eval2.template values<1, true, false>(
-                    scratch_data, gradients_quad + (dim - 1) * n_q_points);
-
-                  break;
-                case 2:
-                  eval1.template values<0, true, false>(values_dofs + size_deg,
-                                                        gradients_quad +
-                                                          (dim - 1) *
+
+
+  template <bool symmetric_evaluate,
+            int  dim,
+            int  fe_degree,
+            int  n_q_points_1d,
+            int  n_components,
+            typename Number>
+  void
+  FEFaceEvaluationImpl<symmetric_evaluate,
+                       dim,
+                       fe_degree,
+                       n_q_points_1d,
+                       n_components,
+                       Number>::
+    evaluate_hessians_in_face(
+      const MatrixFreeFunctions::ShapeInfo<Number> &data,
+      const Number *                                values_dofs,
+      Number *                                      hessians_quad,
+      Number *                                      scratch_data,
+      const unsigned int                            subface_index)
+  {
+    const AlignedVector<Number> &val1 =
+      symmetric_evaluate ?
+        data.shape_values_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_values :
+           data.values_within_subface[subface_index % 2]);
+    const AlignedVector<Number> &val2 =
+      symmetric_evaluate ?
+        data.shape_values_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_values :
+           data.values_within_subface[subface_index / 2]);
+
+    const AlignedVector<Number> &grad1 =
+      symmetric_evaluate ?
+        data.shape_gradients_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_gradients :
+           data.gradients_within_subface[subface_index % 2]);
+    const AlignedVector<Number> &grad2 =
+      symmetric_evaluate ?
+        data.shape_gradients_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_gradients :
+           data.gradients_within_subface[subface_index / 2]);
+
+    const AlignedVector<Number> &hess1 =
+      symmetric_evaluate ?
+        data.shape_hessians_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_hessians :
+           data.hessians_within_subface[subface_index % 2]);
+    const AlignedVector<Number> &hess2 =
+      symmetric_evaluate ?
+        data.shape_hessians_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_hessians :
+           data.hessians_within_subface[subface_index / 2]);
+
+    using Eval =
+      internal::EvaluatorTensorProduct<symmetric_evaluate ?
+                                         internal::evaluate_evenodd :
+                                         internal::evaluate_general,
+                                       dim - 1,
+                                       fe_degree + 1,
+                                       n_q_points_1d,
+                                       Number>;
+    Eval eval1(val1, grad1, hess1, data.fe_degree + 1, data.n_q_points_1d);
+    Eval eval2(val2, grad2, hess2, data.fe_degree + 1, data.n_q_points_1d);
+
+    const unsigned int size_deg =
+      fe_degree > -1 ?
+        Utilities::pow(fe_degree + 1, dim - 1) :
+        (dim > 1 ? Utilities::fixed_power<dim - 1>(data.fe_degree + 1) : 1);
+
+    const unsigned int n_q_points = fe_degree > -1 ?
+                                      Utilities::pow(n_q_points_1d, dim - 1) :
+                                      data.n_q_points_face;
+
+    const Number *normal_derivatives = values_dofs + size_deg;
+    const Number *normal_hessians    = values_dofs + 2 * size_deg;
+
+    // the Hessians are stored with the diagonal entries first, followed by
+    // the entries above the diagonal row by row, i.e., the mixed tangential
+    // derivatives come before the mixed tangential-normal ones
+    switch (dim)
+      {
+        case 3:
+          if (use_collocation)
+            {
+              internal::EvaluatorTensorProduct<internal::evaluate_evenodd,
+                                               dim - 1,
+                                               n_q_points_1d,
+                                               n_q_points_1d,
+                                               Number>
+                eval_grad(AlignedVector<Number>(),
+                          data.shape_gradients_collocation_eo,
+                          data.shape_hessians_collocation_eo);
+
+              // interpolate the values to the quadrature points and compute
+              // all tangential derivatives by the collocation derivative
+              eval1.template values<0, true, false>(values_dofs, scratch_data);
+              eval1.template values<1, true, false>(scratch_data,
+                                                    scratch_data);
+              eval_grad.template hessians<0, true, false>(scratch_data,
+                                                          hessians_quad);
+              eval_grad.template hessians<1, true, false>(scratch_data,
+                                                          hessians_quad +
                                                             n_q_points);
-                  eval1.template gradients<0, true, false>(values_dofs,
-                                                           gradients_quad);
-                  if (evaluate_val == true)
-                    eval1.template values<0, true, false>(values_dofs,
-                                                          values_quad);
-                  break;
-                case 1:
-                  values_quad[0]    = values_dofs[0];
-                  gradients_quad[0] = values_dofs[1];
-                  break;
-                default:
-                  AssertThrow(false, ExcNotImplemented());
-              }
-            values_dofs += 2 * size_deg;
-            values_quad += n_q_points;
-            gradients_quad += dim * n_q_points;
-          }
-    }
+              eval_grad.template gradients<0, true, false>(scratch_data,
+                                                           scratch_data +
+                                                             n_q_points);
+              eval_grad.template gradients<1, true, false>(
+                scratch_data + n_q_points, hessians_quad + 3 * n_q_points);
+
+              // same for the normal derivative
+              eval1.template values<0, true, false>(normal_derivatives,
+                                                    scratch_data);
+              eval1.template values<1, true, false>(scratch_data,
+                                                    scratch_data);
+              eval_grad.template gradients<0, true, false>(scratch_data,
+                                                           hessians_quad +
+                                                             4 * n_q_points);
+              eval_grad.template gradients<1, true, false>(scratch_data,
+                                                           hessians_quad +
+                                                             5 * n_q_points);
+            }
+          else
+            {
+              eval1.template hessians<0, true, false>(values_dofs,
+                                                      scratch_data);
+              eval2.template values<1, true, false>(scratch_data,
+                                                    hessians_quad);
+
+              eval1.template gradients<0, true, false>(values_dofs,
+                                                       scratch_data);
+              eval2.template gradients<1, true, false>(scratch_data,
+                                                       hessians_quad +
+                                                         3 * n_q_points);
 
-    static void
+              eval1.template values<0, true, false>(values_dofs, scratch_data);
+              eval2.template hessians<1, true, false>(scratch_data,
+                                                      hessians_quad +
+                                                        n_q_points);
+
+              eval1.template gradients<0, true, false>(normal_derivatives,
+                                                       scratch_data);
+              eval2.template values<1, true, false>(scratch_data,
+                                                    hessians_quad +
+                                                      4 * n_q_points);
+
+              eval1.template values<0, true, false>(normal_derivatives,
+                                                    scratch_data);
+              eval2.template gradients<1, true, false>(scratch_data,
+                                                       hessians_quad +
+                                                         5 * n_q_points);
+            }
+          eval1.template values<0, true, false>(normal_hessians, scratch_data);
+          eval2.template values<1, true, false>(scratch_data,
+                                                hessians_quad + 2 * n_q_points);
+          break;
+        case 2:
+          eval1.template hessians<0, true, false>(values_dofs, hessians_quad);
+          eval1.template gradients<0, true, false>(normal_derivatives,
+                                                   hessians_quad +
+                                                     2 * n_q_points);
+          eval1.template values<0, true, false>(normal_hessians,
+                                                hessians_quad + n_q_points);
+          break;
+        case 1:
+          hessians_quad[0] = normal_hessians[0];
+          break;
+        default:
+          AssertThrow(false, ExcNotImplemented());
+      }
+  }
+
+
+
+  template <bool symmetric_evaluate,
+            int  dim,
+            int  fe_degree,
+            int  n_q_points_1d,
+            int  n_components,
+            typename Number>
+  void
+  FEFaceEvaluationImpl<symmetric_evaluate,
+                       dim,
+                       fe_degree,
+                       n_q_points_1d,
+                       n_components,
+                       Number>::
     integrate_in_face(const MatrixFreeFunctions::ShapeInfo<Number> &data,
                       Number *                                      values_dofs,
                       Number *                                      values_quad,
@@ -1517,156 +1783,155 @@ namespace internal
                       const bool         integrate_val,
                       const bool         integrate_grad,
                       const unsigned int subface_index)
-    {
-      const AlignedVector<Number> &val1 =
-        symmetric_evaluate ?
-          data.shape_values_eo :
-          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
-             data.shape_values :
-             data.values_within_subface[subface_index % 2]);
-      const AlignedVector<Number> &val2 =
-        symmetric_evaluate ?
-          data.shape_values_eo :
-          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
-             data.shape_values :
-             data.values_within_subface[subface_index / 2]);
-
-      const AlignedVector<Number> &grad1 =
-        symmetric_evaluate ?
-          data.shape_gradients_eo :
-          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
-             data.shape_gradients :
-             data.gradients_within_subface[subface_index % 2]);
-      const AlignedVector<Number> &grad2 =
-        symmetric_evaluate ?
-          data.shape_gradients_eo :
-          (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
-             data.shape_gradients :
-             data.gradients_within_subface[subface_index / 2]);
-
-      using Eval =
-        internal::EvaluatorTensorProduct<symmetric_evaluate ?
-                                           internal::evaluate_evenodd :
-                                           internal::evaluate_general,
-                                         dim - 1,
-                                         fe_degree + 1,
-                                         n_q_points_1d,
-                                         Number>;
-      Eval eval1(val1, grad1, val1, data.fe_degree + 1, data.n_q_points_1d);
-      Eval eval2(val2, grad2, val1, data.fe_degree + 1, data.n_q_points_1d);
-
-      const unsigned int size_deg =
-        fe_degree > -1 ?
-          Utilities::pow(fe_degree + 1, dim - 1) :
-          (dim > 1 ? Utilities::fixed_power<dim - 1>(data.fe_degree + 1) : 1);
-
-      const unsigned int n_q_points = fe_degree > -1 ?
-                                        Utilities::pow(n_q_points_1d, dim - 1) :
-                                        data.n_q_points_face;
-
-      if (integrate_grad == false)
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            switch (dim)
-              {
-                case 3:
-                  eval2.template values<1, false, false>(values_quad,
-                                                         values_quad);
-                  eval1.template values<0, false, false>(values_quad,
-                                                         values_dofs);
-                  break;
-                case 2:
-                  eval1.template values<0, false, false>(values_quad,
-                                                         values_dofs);
-                  break;
-                case 1:
-                  values_dofs[0] = values_quad[0];
-                  break;
-                default:
-                  Assert(false, ExcNotImplemented());
-              }
-            values_dofs += 2 * size_deg;
-            values_quad += n_q_points;
-          }
-      else
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            switch (dim)
-              {
-                case 3:
-                  eval2.template values<1, false, false>(gradients_quad +
-                                                           2 * n_q_points,
-                                                         gradients_quad +
-                                                           2 * n_q_points);
-                  eval1.template values<0, false, false>(
-                    gradients_quad + 2 * n_q_points, values_dofs + size_deg);
-                  if (use_collocation)
-                    {
-                      internal::EvaluatorTensorProduct<
-                        internal::evaluate_evenodd,
-                        dim - 1,
-                        n_q_points_1d,
-                        n_q_points_1d,
-                        Number>
-                        eval_grad(AlignedVector<Number>(),
-                                  data.shape_gradients_collocation_eo,
-                                  AlignedVector<Number>());
-                      if (integrate_val)
-                        eval_grad.template gradients<1, false, true>(
-                          gradients_quad + n_q_points, values_quad);
-                      else
-                        eval_grad.template gradients<1, false, false>(
-                          gradients_quad + n_q_points, values_quad);
-                      eval_grad.template gradients<0, false, true>(
-                        gradients_quad, values_quad);
-                      eval1.template values<1, false, false>(values_quad,
-                                                             values_quad);
-                      eval1.template values<0, false, false>(values_quad,
-                                                             values_dofs);
-                    }
-                  else
-                    {
-                      if (integrate_val)
-                        {
-                          eval2.template values<1, false, false>(values_quad,
-                                                                 scratch_data);
-                          eval2.template gradients<1, false, true>(
-                            gradients_quad + n_q_points, scratch_data);
-                        }
-                      else
-                        eval2.template gradients<1, false, false>(
-                          gradients_quad + n_q_points, scratch_data);
+  {
+    const AlignedVector<Number> &val1 =
+      symmetric_evaluate ?
+        data.shape_values_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_values :
+           data.values_within_subface[subface_index % 2]);
+    const AlignedVector<Number> &val2 =
+      symmetric_evaluate ?
+        data.shape_values_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_values :
+           data.values_within_subface[subface_index / 2]);
+
+    const AlignedVector<Number> &grad1 =
+      symmetric_evaluate ?
+        data.shape_gradients_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_gradients :
+           data.gradients_within_subface[subface_index % 2]);
+    const AlignedVector<Number> &grad2 =
+      symmetric_evaluate ?
+        data.shape_gradients_eo :
+        (subface_index >= GeometryInfo<dim>::max_children_per_cell ?
+           data.shape_gradients :
+           data.gradients_within_subface[subface_index / 2]);
+
+    using Eval =
+      internal::EvaluatorTensorProduct<symmetric_evaluate ?
+                                         internal::evaluate_evenodd :
+                                         internal::evaluate_general,
+                                       dim - 1,
+                                       fe_degree + 1,
+                                       n_q_points_1d,
+                                       Number>;
+    Eval eval1(val1, grad1, val1, data.fe_degree + 1, data.n_q_points_1d);
+    Eval eval2(val2, grad2, val1, data.fe_degree + 1, data.n_q_points_1d);
+
+    const unsigned int size_deg =
+      fe_degree > -1 ?
+        Utilities::pow(fe_degree + 1, dim - 1) :
+        (dim > 1 ? Utilities::fixed_power<dim - 1>(data.fe_degree + 1) : 1);
 
-                      eval1.template values<0, false, false>(scratch_data,
+    const unsigned int n_q_points = fe_degree > -1 ?
+                                      Utilities::pow(n_q_points_1d, dim - 1) :
+                                      data.n_q_points_face;
+
+    if (integrate_grad == false)
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          switch (dim)
+            {
+              case 3:
+                eval2.template values<1, false, false>(values_quad,
+                                                       values_quad);
+                eval1.template values<0, false, false>(values_quad,
+                                                       values_dofs);
+                break;
+              case 2:
+                eval1.template values<0, false, false>(values_quad,
+                                                       values_dofs);
+                break;
+              case 1:
+                values_dofs[0] = values_quad[0];
+                break;
+              default:
+                Assert(false, ExcNotImplemented());
+            }
+          values_dofs += 2 * size_deg;
+          values_quad += n_q_points;
+        }
+    else
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          switch (dim)
+            {
+              case 3:
+                eval2.template values<1, false, false>(gradients_quad +
+                                                         2 * n_q_points,
+                                                       gradients_quad +
+                                                         2 * n_q_points);
+                eval1.template values<0, false, false>(
+                  gradients_quad + 2 * n_q_points, values_dofs + size_deg);
+                if (use_collocation)
+                  {
+                    internal::EvaluatorTensorProduct<
+                      internal::evaluate_evenodd,
+                      dim - 1,
+                      n_q_points_1d,
+                      n_q_points_1d,
+                      Number>
+                      eval_grad(AlignedVector<Number>(),
+                                data.shape_gradients_collocation_eo,
+                                AlignedVector<Number>());
+                    if (integrate_val)
+                      eval_grad.template gradients<1, false, true>(
+                        gradients_quad + n_q_points, values_quad);
+                    else
+                      eval_grad.template gradients<1, false, false>(
+                        gradients_quad + n_q_points, values_quad);
+                    eval_grad.template gradients<0, false, true>(
+                      gradients_quad, values_quad);
+                    eval1.template values<1, false, false>(values_quad,
+                                                           values_quad);
+                    eval1.template values<0, false, false>(values_quad,
+                                                           values_dofs);
+                  }
+                else
+                  {
+                    if (integrate_val)
+                      {
+                        eval2.template values<1, false, false>(values_quad,
+                                                               scratch_data);
+                        eval2.template gradients<1, false, true>(
+                          gradients_quad + n_q_points, scratch_data);
+                      }
+                    else
+                      eval2.template gradients<1, false, false>(
+                        gradients_quad + n_q_points, scratch_data);
+
+                    eval1.template values<0, false, false>(scratch_data,
+                                                           values_dofs);
+                    eval2.template values<1, false, false>(gradients_quad,
+                                                           scratch_data);
+                    eval1.template gradients<0, false, true>(scratch_data,
                                                              values_dofs);
-                      eval2.template values<1, false, false>(gradients_quad,
-                                                             scratch_data);
-                      eval1.template gradients<0, false, true>(scratch_data,
-                                                               values_dofs);
-                    }
-                  break;
-                case 2:
-                  eval1.template values<0, false, false>(
-                    gradients_quad + n_q_points, values_dofs + size_deg);
-                  eval1.template gradients<0, false, false>(gradients_quad,
-                                                            values_dofs);
-                  if (integrate_val == true)
-                    eval1.template values<0, false, true>(values_quad,
+                  }
+                break;
+              case 2:
+                eval1.template values<0, false, false>(
+                  gradients_quad + n_q_points, values_dofs + size_deg);
+                eval1.template gradients<0, false, false>(gradients_quad,
                                                           values_dofs);
-                  break;
-                case 1:
-                  values_dofs[0] = values_quad[0];
-                  values_dofs[1] = gradients_quad[0];
-                  break;
-                default:
-                  AssertThrow(false, ExcNotImplemented());
-              }
-            values_dofs += 2 * size_deg;
-            values_quad += n_q_points;
-            gradients_quad += dim * n_q_points;
-          }
-    }
-  };
+                if (integrate_val == true)
+                  eval1.template values<0, false, true>(values_quad,
+                                                        values_dofs);
+                break;
+              case 1:
+                values_dofs[0] = values_quad[0];
+                values_dofs[1] = gradients_quad[0];
+                break;
+              default:
+                AssertThrow(false, ExcNotImplemented());
+            }
+          values_dofs += 2 * size_deg;
+          values_quad += n_q_points;
+          gradients_quad += dim * n_q_points;
+        }
+  }
 
 
 
@@ -1679,7 +1944,8 @@ namespace internal
                 const Number *                                input,
                 Number *                                      output,
                 const bool                                    do_gradients,
-                const unsigned int                            face_no)
+                const unsigned int                            face_no,
+                const bool                                    do_hessians)
     {
       internal::EvaluatorTensorProduct<internal::evaluate_general,
                                        dim,
@@ -1692,16 +1958,31 @@ namespace internal
               data.fe_degree + 1,
               0);
 
-      const unsigned int in_stride = do_evaluate ?
-                                       data.dofs_per_component_on_cell :
-                                       2 * data.dofs_per_component_on_face;
-      const unsigned int out_stride = do_evaluate ?
-                                        2 * data.dofs_per_component_on_face :
-                                        data.dofs_per_component_on_cell;
+      // the data on the face consists of the values and the normal
+      // derivatives, and additionally the second normal derivatives in case
+      // the Hessians are requested
+      const unsigned int face_stride =
+        (do_hessians ? 3 : 2) * data.dofs_per_component_on_face;
+      const unsigned int in_stride =
+        do_evaluate ? data.dofs_per_component_on_cell : face_stride;
+      const unsigned int out_stride =
+        do_evaluate ? face_stride : data.dofs_per_component_on_cell;
       const unsigned int face_direction = face_no / 2;
       for (unsigned int c = 0; c < n_components; c++)
         {
-          if (do_gradients)
+          if (do_hessians)
+            {
+              if (face_direction == 0)
+                evalf.template apply_face<0, do_evaluate, add_into_output, 2>(
+                  input, output);
+              else if (face_direction == 1)
+                evalf.template apply_face<1, do_evaluate, add_into_output, 2>(
+                  input, output);
+              else
+                evalf.template apply_face<2, do_evaluate, add_into_output, 2>(
+                  input, output);
+            }
+          else if (do_gradients)
             {
               if (face_direction == 0)
                 evalf.template apply_face<0, do_evaluate, add_into_output, 1>(
@@ -33,7 +33,8 @@ namespace internal
     // 1. Start with fe_degree=0, n_q_points_1d=0 and DEPTH=0.
     // 2. If the current assumption on fe_degree doesn't match the runtime
     //    parameter, increase fe_degree  by one and try again.
-    //    If fe_degree==10 use the class Default which serves as a fallback.
+    //    If fe_degree==DEAL_II_MATRIX_FREE_MAX_DEGREE+1 use the class Default
+    //    which serves as a fallback.
     // 3. After fixing the fe_degree, DEPTH is increased (DEPTH=1) and we start
     // with
     //    n_q_points=fe_degree+1.
@@ -123,11 +124,16 @@ namespace internal
     /**
      * This specialization sets the maximal fe_degree for
      * which we want to determine the correct template parameters based at
-     * runtime.
+     * runtime. The value is configured by the CMake variable
+     * DEAL_II_MATRIX_FREE_MAX_DEGREE.
      */
     template <int n_q_points_1d, int dim, int n_components, typename Number>
-    struct Factory<dim, n_components, Number, 0, 10, n_q_points_1d>
-      : Default<dim, n_components, Number>
+    struct Factory<dim,
+                   n_components,
+                   Number,
+                   0,
+                   DEAL_II_MATRIX_FREE_MAX_DEGREE + 1,
+                   n_q_points_1d> : Default<dim, n_components, Number>
     {};
 
     /**
@@ -482,8 +488,22 @@ namespace internal
  * pass these values to the respective template specializations.
  * Otherwise, we perform a runtime matching of the runtime parameters to find
  * the correct specialization. This matching currently supports
- * $0\leq fe\_degree \leq 9$ and $degree+1\leq n\_q\_points\_1d\leq
- * fe\_degree+2$.
+ * $0\leq fe\_degree \leq p_{max}$ and $degree+1\leq n\_q\_points\_1d\leq
+ * fe\_degree+2$, where $p_{max}$ is given by the CMake variable
+ * DEAL_II_MATRIX_FREE_MAX_DEGREE and equals 9 by default.
+ *
+ * The functions of this class, as well as the functions of
+ * internal::FEFaceEvaluationImpl used by FEFaceEvaluation, can be compiled
+ * into the library for $1\leq fe\_degree \leq p_{pre}$,
+ * n_q_points_1d=fe_degree+1, between one and $c_{pre}$ components and
+ * VectorizedArray<double> as well as VectorizedArray<float>, where $p_{pre}$
+ * and $c_{pre}$ are given by the CMake variables
+ * DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE and
+ * DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS, respectively. For these
+ * cases, user code calls the precompiled kernels instead of instantiating
+ * them in every translation unit that uses FEEvaluation, which reduces the
+ * compile time and the size of the object files of user code. By default,
+ * $p_{pre}=0$, i.e., no kernels for fixed degrees are precompiled.
  */
 template <int dim,
           int fe_degree,
@@ -545,9 +565,18 @@ struct SelectEvaluator
  * the selection is done based on the shape_info variable which contains
  * the relevant runtime parameters.
  * In case these parameters do not satisfy
- * $0\leq fe\_degree \leq 9$ and
+ * $0\leq fe\_degree \leq p_{max}$ and
  * $degree+1\leq n\_q\_points\_1d\leq fe\_degree+2$, a non-optimized fallback
- * is used.
+ * is used. The maximal degree $p_{max}$ is set by the CMake variable
+ * DEAL_II_MATRIX_FREE_MAX_DEGREE (9 by default).
+ *
+ * The functions of this class are compiled into the library for
+ * n_q_points_1d=0 (the default of FEEvaluation with fe_degree=-1),
+ * n_components between one and three, and VectorizedArray<double> as well
+ * as VectorizedArray<float>. For these cases, user code calls the
+ * precompiled functions and does not need to instantiate the evaluation
+ * kernels for all degrees up to $p_{max}$, which keeps the compile time
+ * of user code low.
  */
 template <int dim, int n_q_points_1d, int n_components, typename Number>
 struct SelectEvaluator<dim, -1, n_q_points_1d, n_components, Number>
@@ -598,7 +627,7 @@ template <int dim,
           int n_q_points_1d,
           int n_components,
           typename Number>
-inline void
+void
 SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::evaluate(
   const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
   Number *                                                values_dofs_actual,
@@ -734,7 +763,7 @@ template <int dim,
           int n_q_points_1d,
           int n_components,
           typename Number>
-inline void
+void
 SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::integrate(
   const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
   Number *                                                values_dofs_actual,
@@ -859,7 +888,7 @@ SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::integrate(
 
 
 template <int dim, int dummy, int n_components, typename Number>
-inline void
+void
 SelectEvaluator<dim, -1, dummy, n_components, Number>::evaluate(
   const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
   Number *                                                values_dofs_actual,
@@ -941,7 +970,7 @@ SelectEvaluator<dim, -1, dummy, n_components, Number>::evaluate(
 
 
 template <int dim, int dummy, int n_components, typename Number>
-inline void
+void
 SelectEvaluator<dim, -1, dummy, n_components, Number>::integrate(
   const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
   Number *                                                values_dofs_actual,
@@ -1015,6 +1044,155 @@ SelectEvaluator<dim, -1, dummy, n_components, Number>::integrate(
         integrate_gradients,
         sum_into_values_array);
 }
+
+
+
+// The run time selection for the most common cases is compiled into the
+// library, see evaluation_selector.inst.in
+extern template struct SelectEvaluator<1, -1, 0, 1, VectorizedArray<double>>;
+extern template struct SelectEvaluator<1, -1, 0, 1, VectorizedArray<float>>;
+extern template struct SelectEvaluator<1, -1, 0, 2, VectorizedArray<double>>;
+extern template struct SelectEvaluator<1, -1, 0, 2, VectorizedArray<float>>;
+extern template struct SelectEvaluator<1, -1, 0, 3, VectorizedArray<double>>;
+extern template struct SelectEvaluator<1, -1, 0, 3, VectorizedArray<float>>;
+extern template struct SelectEvaluator<2, -1, 0, 1, VectorizedArray<double>>;
+extern template struct SelectEvaluator<2, -1, 0, 1, VectorizedArray<float>>;
+extern template struct SelectEvaluator<2, -1, 0, 2, VectorizedArray<double>>;
+extern template struct SelectEvaluator<2, -1, 0, 2, VectorizedArray<float>>;
+extern template struct SelectEvaluator<2, -1, 0, 3, VectorizedArray<double>>;
+extern template struct SelectEvaluator<2, -1, 0, 3, VectorizedArray<float>>;
+extern template struct SelectEvaluator<3, -1, 0, 1, VectorizedArray<double>>;
+extern template struct SelectEvaluator<3, -1, 0, 1, VectorizedArray<float>>;
+extern template struct SelectEvaluator<3, -1, 0, 2, VectorizedArray<double>>;
+extern template struct SelectEvaluator<3, -1, 0, 2, VectorizedArray<float>>;
+extern template struct SelectEvaluator<3, -1, 0, 3, VectorizedArray<double>>;
+extern template struct SelectEvaluator<3, -1, 0, 3, VectorizedArray<float>>;
+
+
+
+// The kernels for fixed polynomial degrees selected by the CMake variables
+// DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE and
+// DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS are compiled into the
+// library, see evaluation_selector.cc. The macros below create the list of
+// these kernels, prefixed by the argument EXTERN, such that the same list
+// can be used for the declarations here and the instantiations in the
+// library.
+#  define DEAL_II_MATRIX_FREE_PRECOMPILED_KERNEL(                    \
+    EXTERN, dim, degree, n_components, Number)                       \
+    EXTERN template struct SelectEvaluator<dim,                      \
+                                           degree,                   \
+                                           degree + 1,               \
+                                           n_components,             \
+                                           VectorizedArray<Number>>; \
+    EXTERN template struct internal::FEFaceEvaluationImpl<           \
+      true,                                                          \
+      dim,                                                           \
+      degree,                                                        \
+      degree + 1,                                                    \
+      n_components,                                                  \
+      VectorizedArray<Number>>;                                      \
+    EXTERN template struct internal::FEFaceEvaluationImpl<           \
+      false,                                                         \
+      dim,                                                           \
+      degree,                                                        \
+      degree + 1,                                                    \
+      n_components,                                                  \
+      VectorizedArray<Number>>;
+
+#  define DEAL_II_MATRIX_FREE_PRECOMPILED_KERNELS(EXTERN, degree, n_comp)   \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_KERNEL(EXTERN, 1, degree, n_comp, double) \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_KERNEL(EXTERN, 1, degree, n_comp, float)  \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_KERNEL(EXTERN, 2, degree, n_comp, double) \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_KERNEL(EXTERN, 2, degree, n_comp, float)  \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_KERNEL(EXTERN, 3, degree, n_comp, double) \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_KERNEL(EXTERN, 3, degree, n_comp, float)
+
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS >= 3
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, degree) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_KERNELS(EXTERN, degree, 1)   \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_KERNELS(EXTERN, degree, 2)   \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_KERNELS(EXTERN, degree, 3)
+#  elif DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS == 2
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, degree) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_KERNELS(EXTERN, degree, 1)   \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_KERNELS(EXTERN, degree, 2)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, degree) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_KERNELS(EXTERN, degree, 1)
+#  endif
+
+// The list of kernels for the degrees 1 to
+// DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE > 9
+#    error "DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE must not exceed 9"
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 1
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_1(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 1)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_1(EXTERN)
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 2
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_2(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 2)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_2(EXTERN)
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 3
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_3(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 3)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_3(EXTERN)
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 4
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_4(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 4)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_4(EXTERN)
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 5
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_5(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 5)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_5(EXTERN)
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 6
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_6(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 6)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_6(EXTERN)
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 7
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_7(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 7)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_7(EXTERN)
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 8
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_8(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 8)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_8(EXTERN)
+#  endif
+#  if DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE >= 9
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_9(EXTERN) \
+      DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE(EXTERN, 9)
+#  else
+#    define DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_9(EXTERN)
+#  endif
+
+#  define DEAL_II_MATRIX_FREE_PRECOMPILED_ALL_KERNELS(EXTERN) \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_1(EXTERN)          \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_2(EXTERN)          \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_3(EXTERN)          \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_4(EXTERN)          \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_5(EXTERN)          \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_6(EXTERN)          \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_7(EXTERN)          \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_8(EXTERN)          \
+    DEAL_II_MATRIX_FREE_PRECOMPILED_DEGREE_9(EXTERN)
+
+DEAL_II_MATRIX_FREE_PRECOMPILED_ALL_KERNELS(extern)
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
@@ -26,6 +26,14 @@
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/task_info.h>
 
+#ifdef DEAL_II_WITH_THREADS
+#  include <deal.II/base/parallel.h>
+
+DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
+#  include <tbb/concurrent_unordered_map.h>
+DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
+#endif
+
 #include <fstream>
 
 
@@ -746,20 +754,31 @@ namespace internal
       TaskInfo &                                                task_info)
     {
       // step 1: create the inverse map between cell iterators and the
-      // cell_level_index field
+      // cell_level_index field. The entries of cell_level_index are the
+      // level and index of the cells, so we can fill the map without
+      // constructing cell iterators. With threads, we use a concurrent hash
+      // table that can be filled in parallel and gives constant-time
+      // lookups in the loop below
+#ifdef DEAL_II_WITH_THREADS
+      tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,
+                                    unsigned int>
+        map_to_vectorized;
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(cell_levels.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int cell = begin; cell < end; ++cell)
+            if (cell == 0 || cell_levels[cell] != cell_levels[cell - 1])
+              map_to_vectorized.insert(std::make_pair(cell_levels[cell], cell));
+        },
+        1000);
+#else
       std::map<std::pair<unsigned int, unsigned int>, unsigned int>
         map_to_vectorized;
       for (unsigned int cell = 0; cell < cell_levels.size(); ++cell)
         if (cell == 0 || cell_levels[cell] != cell_levels[cell - 1])
-          {
-            typename dealii::Triangulation<dim>::cell_iterator dcell(
-              &triangulation,
-              cell_levels[cell].first,
-              cell_levels[cell].second);
-            std::pair<unsigned int, unsigned int> level_index(dcell->level(),
-                                                              dcell->index());
-            map_to_vectorized[level_index] = cell;
-          }
+          map_to_vectorized[cell_levels[cell]] = cell;
+#endif
 
       // step 2: fill the information about inner faces and boundary faces
       const unsigned int vectorization_length = task_info.vectorization_length;
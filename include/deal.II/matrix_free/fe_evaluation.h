@@ -31,6 +31,7 @@
 
 #include <deal.II/matrix_free/evaluation_kernels.h>
 #include <deal.II/matrix_free/evaluation_selector.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/mapping_data_on_the_fly.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/shape_info.h>
@@ -199,9 +200,10 @@ public:
    * vectors, without taking stored constraints into account. This way of
    * access is appropriate when the constraints have been distributed on the
    * vector by a call to AffineConstraints::distribute previously. This
-   * function is also necessary when inhomogeneous constraints are to be used,
-   * as MatrixFree can only handle homogeneous constraints. Note that if
-   * vectorization is enabled, the DoF values for several cells are set.
+   * function is also necessary when inhomogeneous constraints are to be used
+   * and MatrixFree has not stored them, see
+   * read_dof_values_with_inhomogeneities(). Note that if vectorization is
+   * enabled, the DoF values for several cells are set.
    *
    * If this class was constructed without a MatrixFree object and the
    * information is acquired on the fly through a
@@ -224,6 +226,29 @@ public:
   read_dof_values_plain(const VectorType & src,
                         const unsigned int first_index = 0);
 
+  /**
+   * Same as read_dof_values(), but the values of the constrained degrees of
+   * freedom additionally include the inhomogeneities of the constraints,
+   * i.e., the local values are the ones that AffineConstraints::distribute()
+   * would set in the vector @p src. This allows to evaluate the residual of
+   * a problem with inhomogeneous constraints, e.g. with Dirichlet boundary
+   * values, from a vector holding only the homogeneous part of the solution,
+   * within the same gather operation. The inhomogeneities are added to the
+   * local values after resolving the constraints and before the
+   * interpolation of the fast hanging node algorithm, and only need to touch
+   * the constrained degrees of freedom of the cells in the batch.
+   *
+   * This function requires the flag
+   * MatrixFree::AdditionalData::store_constraint_inhomogeneities to be set
+   * and an object constructed with a MatrixFree object. The matching write
+   * operation is distribute_local_to_global(), which ignores the
+   * inhomogeneities as in AffineConstraints::distribute_local_to_global().
+   */
+  template <typename VectorType>
+  void
+  read_dof_values_with_inhomogeneities(const VectorType & src,
+                                       const unsigned int first_index = 0);
+
   /**
    * Takes the values stored internally on dof values of the current cell and
    * sums them into the vector @p dst. The function also applies constraints
@@ -302,6 +327,77 @@ public:
     const std::bitset<VectorizedArrayType::n_array_elements> &mask =
       std::bitset<VectorizedArrayType::n_array_elements>().flip()) const;
 
+  /**
+   * Same as the read_dof_values() function above, but for a complex-valued
+   * vector @p src. The real parts of the entries are read into the first
+   * component and the imaginary parts into the second component of this
+   * object, i.e., this class must have two components and the underlying
+   * DoFHandler must use a scalar finite element. All operations of this
+   * class, such as evaluate() and integrate(), then work on the real and
+   * imaginary parts in the real and vectorized arithmetic of @p Number,
+   * while the indices and the geometry of the cells are only accessed
+   * once. This way, a complex-valued operator, e.g., for time-harmonic wave
+   * propagation, is applied in a single loop over the cells, rather than by
+   * splitting it into real-valued blocks. Complex coefficients are applied
+   * at the quadrature points by combining the two components, e.g.,
+   * @code
+   *   FEEvaluation<dim, degree, degree + 1, 2, double> phi(matrix_free);
+   *   ...
+   *   phi.read_dof_values(src);
+   *   phi.evaluate(true, false);
+   *   for (unsigned int q = 0; q < phi.n_q_points; ++q)
+   *     {
+   *       const auto u = phi.get_value(q);
+   *       Tensor<1, 2, VectorizedArray<double>> k2u;
+   *       k2u[0] = k2_real * u[0] - k2_imag * u[1];
+   *       k2u[1] = k2_imag * u[0] + k2_real * u[1];
+   *       phi.submit_value(k2u, q);
+   *     }
+   *   phi.integrate(true, false);
+   *   phi.distribute_local_to_global(dst);
+   * @endcode
+   *
+   * The argument @p first_index is ignored.
+   */
+  void
+  read_dof_values(
+    const LinearAlgebra::distributed::Vector<std::complex<Number>> &src,
+    const unsigned int first_index = 0);
+
+  /**
+   * Same as the read_dof_values_plain() function above, but for a
+   * complex-valued vector, see the read_dof_values() function for complex
+   * vectors for the layout of the components.
+   */
+  void
+  read_dof_values_plain(
+    const LinearAlgebra::distributed::Vector<std::complex<Number>> &src,
+    const unsigned int first_index = 0);
+
+  /**
+   * Same as the distribute_local_to_global() function above, but for a
+   * complex-valued vector, whose real and imaginary parts are taken from the
+   * first and second component of this object, respectively.
+   */
+  void
+  distribute_local_to_global(
+    LinearAlgebra::distributed::Vector<std::complex<Number>> &dst,
+    const unsigned int                                        first_index = 0,
+    const std::bitset<VectorizedArrayType::n_array_elements> &mask =
+      std::bitset<VectorizedArrayType::n_array_elements>().flip()) const;
+
+  /**
+   * Same as the set_dof_values() function above, but for a complex-valued
+   * vector, whose real and imaginary parts are taken from the first and
+   * second component of this object, respectively.
+   */
+  void
+  set_dof_values(
+    LinearAlgebra::distributed::Vector<std::complex<Number>> &dst,
+    const unsigned int                                        first_index = 0,
+    const std::bitset<VectorizedArrayType::n_array_elements> &mask =
+      std::bitset<VectorizedArrayType::n_array_elements>().flip()) const;
+
   //@}
 
   /**
@@ -469,6 +565,18 @@ public:
   value_type
   get_laplacian(const unsigned int q_point) const;
 
+  /**
+   * Return the second derivative of a finite element function at quadrature
+   * point number @p q_point after a call to @p evaluate(...,true) in the
+   * direction normal to the face, $\mathbf n(\mathbf x_q)^T \nabla^2
+   * u(\mathbf x_q) \mathbf n(\mathbf x_q)$, as needed for the jump terms of
+   * interior penalty methods for the biharmonic equation.
+   *
+   * @note Only implemented in case `is_face == true`.
+   */
+  value_type
+  get_normal_hessian(const unsigned int q_point) const;
+
 #ifdef DOXYGEN
   // doxygen does not anyhow mention functions coming from partial template
   // specialization of the base class, in this case FEEvaluationAccess<dim,dim>.
@@ -826,6 +934,17 @@ protected:
     const std::bitset<VectorizedArrayType::n_array_elements> &mask,
     const bool apply_constraints = true) const;
 
+  /**
+   * Apply the interpolation of the fast hanging node algorithm of MatrixFree
+   * to the values in @p values_dofs of the cells of the current batch that
+   * have hanging faces, or its transpose if @p transpose is true. A copy of
+   * the values before the interpolation is kept in @p
+   * hanging_nodes_scratch_data. Returns false, without touching any data,
+   * if no cell of the batch is subject to the interpolation.
+   */
+  bool
+  apply_hanging_node_interpolation(const bool transpose) const;
+
   /**
    * A unified function to read from and write into vectors based on the given
    * template operation for DG-type schemes where all degrees of freedom on
@@ -840,6 +959,20 @@ protected:
     VectorType *                                              vectors[],
     const std::bitset<VectorizedArrayType::n_array_elements> &mask) const;
 
+  /**
+   * A unified function to read from and write into vectors based on the given
+   * template operation for the exterior side of the faces of a cell batch,
+   * where the lanes belong to the arbitrary cells stored in @p
+   * neighbor_cells. The degrees of freedom are accessed lane by lane through
+   * the indices of the neighbors, which must not be subject to constraints.
+   */
+  template <typename VectorType, typename VectorOperation>
+  void
+  read_write_operation_neighbors(
+    const VectorOperation &                                   operation,
+    VectorType *                                              vectors[],
+    const std::bitset<VectorizedArrayType::n_array_elements> &mask) const;
+
   /**
    * A unified function to read from and write into vectors based on the given
    * template operation for the case when we do not have an underlying
@@ -864,6 +997,21 @@ protected:
    */
   VectorizedArrayType *scratch_data;
 
+  /**
+   * The part of scratch_data_array that holds the inverse Jacobians and JxW
+   * values of the present cell together with temporary data to compute them
+   * in case they are not stored by MappingInfo for general cells. Set to
+   * nullptr if not used.
+   */
+  VectorizedArrayType *geometry_scratch_data;
+
+  /**
+   * The part of scratch_data_array that holds a copy of the values in @p
+   * values_dofs for the interpolation of the fast hanging node algorithm of
+   * MatrixFree. Set to nullptr if not used.
+   */
+  VectorizedArrayType *hanging_nodes_scratch_data;
+
   /**
    * This field stores the values for local degrees of freedom (e.g. after
    * reading out from a vector but before applying unit cell transformations
@@ -1047,6 +1195,16 @@ protected:
    */
   unsigned int subface_index;
 
+  /**
+   * Stores the numbers of the cells behind the faces in case the exterior
+   * side of the faces of a cell batch has been selected by
+   * FEFaceEvaluation::reinit(cell_batch_number, face_number), with
+   * numbers::invalid_unsigned_int for lanes without a neighbor. Not used
+   * otherwise.
+   */
+  std::array<unsigned int, VectorizedArrayType::n_array_elements>
+    neighbor_cells;
+
   /**
    * Stores the type of the cell we are currently working with after a call to
    * reinit(). Valid values are @p cartesian, @p affine and @p general, which
@@ -1117,6 +1275,15 @@ protected:
    */
   mutable std::vector<types::global_dof_index> local_dof_indices;
 
+  /**
+   * Compute the inverse Jacobians and the JxW values on the quadrature points
+   * of the present cell from MappingInfo::geometry_points by sum
+   * factorization and let @p jacobian and @p J_value point to them. Used on
+   * general cells if MappingInfo does not store these quantities.
+   */
+  void
+  compute_geometry_on_the_fly();
+
 private:
   /**
    * Sets the pointers for values, gradients, hessians to the central
@@ -1303,6 +1470,11 @@ public:
   value_type
   get_laplacian(const unsigned int q_point) const;
 
+  /** @copydoc FEEvaluationBase<dim,1,Number,is_face>::get_normal_hessian()
+   */
+  value_type
+  get_normal_hessian(const unsigned int q_point) const;
+
   /** @copydoc FEEvaluationBase<dim,1,Number,is_face>::integrate_value()
    */
   value_type
@@ -1617,6 +1789,11 @@ public:
   value_type
   get_laplacian(const unsigned int q_point) const;
 
+  /** @copydoc FEEvaluationBase<1,1,Number,is_face>::get_normal_hessian()
+   */
+  value_type
+  get_normal_hessian(const unsigned int q_point) const;
+
   /** @copydoc FEEvaluationBase<1,1,Number,is_face>::integrate_value()
    */
   value_type
@@ -2794,12 +2971,24 @@ public:
    * method is less efficient than the other reinit() method taking a
    * numbering of the faces because it needs to copy the data associated with
    * the faces to the cells in this call.
+   *
+   * If this object has been constructed for the exterior side of faces,
+   * i.e., with `is_interior_face = false`, the lanes refer to the neighbors
+   * behind the given face of the cells in the batch, as used by
+   * MatrixFree::loop_cell_centric(). The neighbors are accessed lane by lane,
+   * and lanes at the boundary are left empty. The quadrature points and
+   * normal vectors are the ones of the cells in the batch, but the exterior
+   * side only provides values and no gradients because the Jacobians of the
+   * neighbors are not stored. This requires all neighbors of a batch to
+   * share the same local face number and orientation, which is the case for
+   * the structured meshes typically created by refinement of a mesh with
+   * consistently oriented cells.
    */
   void
   reinit(const unsigned int cell_batch_number, const unsigned int face_number);
 
   /**
-   * Evaluates the function values, the gradients, and the Laplacians of the
+   * Evaluates the function values, the gradients, and the Hessians of the
    * FE function given at the DoF values stored in the internal data field
    * `dof_values` (that is usually filled by the read_dof_values() method) at
    * the quadrature points on the unit cell.  The function arguments specify
@@ -2807,9 +2996,20 @@ public:
    * functions get_value(), get_gradient() or get_normal_derivative() give
    * useful information (unless these values have been set manually by
    * accessing the internal data pointers).
+   *
+   * The Hessians, accessed by get_hessian(), get_laplacian(), or
+   * get_normal_hessian(), are computed from the values, the normal
+   * derivatives and the second normal derivatives of the cell polynomials
+   * interpolated to the face by sum factorization within the face, using
+   * the even-odd decomposition and collocation derivatives where possible.
+   * They are only available on faces with a constant Jacobian, i.e.,
+   * Cartesian or affine cells adjacent to the face, because the derivatives
+   * of the Jacobian are not stored for faces.
    */
   void
-  evaluate(const bool evaluate_values, const bool evaluate_gradients);
+  evaluate(const bool evaluate_values,
+           const bool evaluate_gradients,
+           const bool evaluate_hessians = false);
 
   /**
    * Evaluates the function values, the gradients, and the Laplacians of the
@@ -2826,7 +3026,8 @@ public:
   void
   evaluate(const VectorizedArrayType *values_array,
            const bool                 evaluate_values,
-           const bool                 evaluate_gradients);
+           const bool                 evaluate_gradients,
+           const bool                 evaluate_hessians = false);
 
   /**
    * Reads from the input vector and evaluates the function values, the
@@ -2928,7 +3129,8 @@ protected:
   void
   adjust_for_face_orientation(const bool integrate,
                               const bool values,
-                              const bool gradients);
+                              const bool gradients,
+                              const bool hessians);
 };
 
 
@@ -3377,9 +3579,30 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
     std::max(tensor_dofs_per_component + 1, dofs_per_component) *
       n_components_ * 3 +
     2 * n_quadrature_points;
+  // space for the inverse Jacobians and JxW values on general cells if they
+  // are computed on the fly, together with the raw Jacobians and three
+  // temporary arrays for the sum factorization
+  unsigned int geometry_size = 0;
+  if (is_face == false && matrix_info != nullptr &&
+      matrix_info->get_mapping_info().n_geometry_points_1d > 0)
+    geometry_size =
+      (2 * dim * dim + 1) * n_quadrature_points +
+      3 * Utilities::fixed_power<dim>(
+            std::max(matrix_info->get_mapping_info().n_geometry_points_1d,
+                     this->data->n_q_points_1d));
+
+  // space for a copy of the values of all components for the interpolation
+  // of the fast hanging node algorithm
+  const unsigned int hanging_nodes_size =
+    (is_face == false && dof_info != nullptr &&
+     !dof_info->hanging_node_constraint_masks.empty()) ?
+      n_components_ * dofs_per_component :
+      0;
+
   const unsigned int allocated_size =
     shift + n_components_ * dofs_per_component +
-    (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points);
+    (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points) +
+    geometry_size + hanging_nodes_size;
   scratch_data_array->resize_fast(allocated_size);
 
   // set the pointers to the correct position in the data array
@@ -3400,11 +3623,132 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
           scratch_data_array->begin() +
           n_components *
             ((dim + 1) * n_quadrature_points + dofs_per_component) +
-          (c * (dim * dim + dim) + d) * n_quadrature_points;
+          (c * (dim * dim + dim) / 2 + d) * n_quadrature_points;
     }
+  geometry_scratch_data =
+    geometry_size > 0 ?
+      scratch_data_array->begin() + n_components_ * dofs_per_component +
+        (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points) :
+      nullptr;
+  hanging_nodes_scratch_data =
+    hanging_nodes_size > 0 ?
+      scratch_data_array->begin() + n_components_ * dofs_per_component +
+        (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points) +
+        geometry_size :
+      nullptr;
   scratch_data =
     scratch_data_array->begin() + n_components_ * dofs_per_component +
-    (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points);
+    (n_components_ * (dim * dim + 2 * dim + 1) * n_quadrature_points) +
+    geometry_size + hanging_nodes_size;
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  compute_geometry_on_the_fly()
+{
+  const internal::MatrixFreeFunctions::
+    MappingInfo<dim, Number, VectorizedArrayType> &mapping_info =
+      matrix_info->get_mapping_info();
+  Assert(geometry_scratch_data != nullptr, ExcInternalError());
+  AssertIndexRange(cell, mapping_info.geometry_points_offsets.size());
+  Assert(mapping_info.geometry_points_offsets[cell] !=
+           numbers::invalid_unsigned_int,
+         ExcInternalError());
+
+  const auto &descriptor = mapping_data->descriptor[active_quad_index];
+  const unsigned int n_points_1d   = mapping_info.n_geometry_points_1d;
+  const unsigned int n_q_points_1d = this->data->n_q_points_1d;
+  const unsigned int n_points      = Utilities::fixed_power<dim>(n_points_1d);
+  const unsigned int n_temp =
+    Utilities::fixed_power<dim>(std::max(n_points_1d, n_q_points_1d));
+
+  // layout of the scratch data: dim*dim arrays with the entries of the
+  // Jacobians, three temporary arrays, the inverse Jacobians and the JxW
+  // values
+  VectorizedArrayType *jacobian_entries = geometry_scratch_data;
+  VectorizedArrayType *temp1 =
+    jacobian_entries + dim * dim * n_quadrature_points;
+  VectorizedArrayType *temp2 = temp1 + n_temp;
+  VectorizedArrayType *temp3 = temp2 + n_temp;
+  Tensor<2, dim, VectorizedArrayType> *inverse_jacobians =
+    reinterpret_cast<Tensor<2, dim, VectorizedArrayType> *>(temp3 + n_temp);
+  VectorizedArrayType *JxW = reinterpret_cast<VectorizedArrayType *>(
+    inverse_jacobians + n_quadrature_points);
+
+  // compute the derivatives of each coordinate with respect to the unit
+  // coordinates, where entry dim*d+e contains the derivative of coordinate
+  // d in direction e
+  internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                   dim,
+                                   0,
+                                   0,
+                                   VectorizedArrayType,
+                                   Number>
+    eval(descriptor.geometry_shape_values,
+         descriptor.geometry_shape_gradients,
+         AlignedVector<Number>(),
+         n_points_1d,
+         n_q_points_1d);
+  const VectorizedArrayType *points =
+    mapping_info.geometry_points.begin() +
+    mapping_info.geometry_points_offsets[cell];
+  for (unsigned int d = 0; d < dim; ++d, points += n_points)
+    {
+      VectorizedArrayType *jac =
+        jacobian_entries + d * dim * n_quadrature_points;
+      switch (dim)
+        {
+          case 1:
+            eval.template gradients<0, true, false>(points, jac);
+            break;
+
+          case 2:
+            eval.template gradients<0, true, false>(points, temp1);
+            eval.template values<1, true, false>(temp1, jac);
+            eval.template values<0, true, false>(points, temp1);
+            eval.template gradients<1, true, false>(temp1,
+                                                    jac + n_quadrature_points);
+            break;
+
+          case 3:
+            eval.template values<0, true, false>(points, temp1);
+            eval.template gradients<0, true, false>(points, temp2);
+            eval.template values<1, true, false>(temp2, temp3);
+            eval.template values<2, true, false>(temp3, jac);
+            eval.template gradients<1, true, false>(temp1, temp3);
+            eval.template values<2, true, false>(temp3,
+                                                 jac + n_quadrature_points);
+            eval.template values<1, true, false>(temp1, temp3);
+            eval.template gradients<2, true, false>(
+              temp3, jac + 2 * n_quadrature_points);
+            break;
+
+          default:
+            AssertThrow(false, ExcNotImplemented());
+        }
+    }
+
+  // invert and transpose the Jacobians as done by MappingInfo for the
+  // stored data
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    {
+      Tensor<2, dim, VectorizedArrayType> jac;
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          jac[d][e] = jacobian_entries[(d * dim + e) * n_quadrature_points + q];
+      JxW[q] = determinant(jac) * descriptor.quadrature_weights[q];
+      inverse_jacobians[q] = transpose(invert(jac));
+    }
+
+  jacobian = inverse_jacobians;
+  J_value  = JxW;
 }
 
 
@@ -4156,7 +4500,7 @@ namespace internal
 
 
 
-    template <typename VectorType, bool booltype>
+    template <typename VectorType>
     void
     process_dofs_vectorized_transpose(const unsigned int   dofs_per_cell,
                                       const unsigned int * dof_indices,
@@ -4310,10 +4654,89 @@ namespace internal
       return vec[component];
     }
   };
+
+
+
+  // A view of the real or imaginary part of the entries of a complex-valued
+  // vector as a vector of real numbers. It provides the local_element()
+  // access used by the vector operations above but no begin(), such that
+  // FEEvaluationBase::read_write_operation() accesses the interleaved real
+  // and imaginary parts entry by entry rather than by vectorized loads. The
+  // standard guarantees that std::complex<Number> can be accessed as an
+  // array of two numbers with the real and the imaginary part
+  template <typename Number>
+  class ComplexVectorPart
+  {
+  public:
+    using value_type = Number;
+
+    ComplexVectorPart(
+      LinearAlgebra::distributed::Vector<std::complex<Number>> &vector,
+      const unsigned int                                        part)
+      : vector(vector)
+      , part(part)
+    {}
+
+    Number &
+    local_element(const unsigned int entry) const
+    {
+      return reinterpret_cast<Number *>(&vector.local_element(entry))[part];
+    }
+
+    Number &
+    operator()(const types::global_dof_index index) const
+    {
+      return reinterpret_cast<Number *>(&vector(index))[part];
+    }
+
+    types::global_dof_index
+    size() const
+    {
+      return vector.size();
+    }
+
+    bool
+    partitioners_are_compatible(
+      const Utilities::MPI::Partitioner &partitioner) const
+    {
+      return vector.partitioners_are_compatible(partitioner);
+    }
+
+  private:
+    LinearAlgebra::distributed::Vector<std::complex<Number>> &vector;
+    const unsigned int                                        part;
+  };
+
+
+
+  // The views of the real and imaginary part of a complex-valued vector as
+  // the two components of an FEEvaluation object
+  template <typename Number>
+  struct ComplexVectorComponents
+  {
+    ComplexVectorComponents(
+      LinearAlgebra::distributed::Vector<std::complex<Number>> &vector)
+      : real_part(vector, 0)
+      , imaginary_part(vector, 1)
+      , components{{&real_part, &imaginary_part}}
+    {}
+
+    ComplexVectorPart<Number>                 real_part;
+    ComplexVectorPart<Number>                 imaginary_part;
+    std::array<ComplexVectorPart<Number> *, 2> components;
+  };
 } // namespace internal
 
 
 
+// the views of complex vectors refer to the locally owned and ghost entries
+// of a distributed vector
+template <typename Number>
+struct is_serial_vector<internal::ComplexVectorPart<Number>> : std::false_type
+{};
+
+
+
 template <int dim,
           int n_components_,
           typename Number,
@@ -4347,7 +4770,17 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       internal::check_vector_compatibility(*src[0], *dof_info);
     }
 
-  // Case 2: contiguous indices which use reduced storage of indices and can
+  // Case 2: exterior side of the faces of a cell batch, where the lanes
+  // belong to neighbor cells in arbitrary batches -> go to separate function
+  if (is_face && is_interior_face == false &&
+      dof_access_index ==
+        internal::MatrixFreeFunctions::DoFInfo::dof_access_cell)
+    {
+      read_write_operation_neighbors(operation, src, mask);
+      return;
+    }
+
+  // Case 3: contiguous indices which use reduced storage of indices and can
   // use vectorized load/store operations -> go to separate function
   AssertIndexRange(cell,
                    dof_info->index_storage_variants[dof_access_index].size());
@@ -4361,10 +4794,21 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       return;
     }
 
-  // Case 3: standard operation with one index per degree of freedom -> go on
+  // Case 4: standard operation with one index per degree of freedom -> go on
   // here
   constexpr unsigned int n_vectorization =
     VectorizedArrayType::n_array_elements;
+
+  // cells treated by the fast hanging node algorithm store the degrees of
+  // freedom of the parent on hanging faces, whose values get interpolated
+  // by apply_hanging_node_interpolation(). Accesses without constraints and
+  // the setter, which must not write the interpolated local values into the
+  // parent's entries, instead use the plain indices of the cell
+  const bool plain_indices_on_hanging_nodes =
+    is_face == false && !dof_info->hanging_node_constraint_masks.empty() &&
+    (apply_constraints == false ||
+     std::is_same<VectorOperation,
+                  internal::VectorSetter<Number, VectorizedArrayType>>::value);
   Assert(mask.count() == n_vectorization,
          ExcNotImplemented("Masking currently not implemented for "
                            "non-contiguous DoF storage"));
@@ -4457,13 +4901,16 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       for (unsigned int v = 0; v < n_vectorization_actual; ++v)
         {
           if (dof_info
-                ->row_starts[(cell * n_vectorization + v) * n_fe_components +
-                             first_selected_component + n_components_read]
-                .second !=
-              dof_info
-                ->row_starts[(cell * n_vectorization + v) * n_fe_components +
-                             first_selected_component]
-                .second)
+                  ->row_starts[(cell * n_vectorization + v) * n_fe_components +
+                               first_selected_component + n_components_read]
+                  .second !=
+                dof_info
+                  ->row_starts[(cell * n_vectorization + v) * n_fe_components +
+                               first_selected_component]
+                  .second ||
+              (plain_indices_on_hanging_nodes &&
+               dof_info->has_hanging_node_constraints(cell * n_vectorization +
+                                                      v)))
             has_constraints = true;
           Assert(
             dof_info
@@ -4504,7 +4951,31 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
         for (unsigned int comp = 0; comp < n_components; ++comp)
           for (unsigned int i = 0; i < dofs_per_component; ++i)
             operation.process_empty(values_dofs[comp][i]);
-      if (n_components == 1 || n_fe_components == 1)
+      // when reading into a completely filled batch of cells, collect the
+      // indices of a degree of freedom on all cells and load the values
+      // with a single gather instruction rather than lane by lane. Writing
+      // operations must stay with the scalar access, as the cells of a batch
+      // can share degrees of freedom, which a scatter cannot handle
+      if ((n_components == 1 || n_fe_components == 1) &&
+          n_vectorization_actual == n_vectorization &&
+          std::is_same<VectorOperation,
+                       internal::VectorReader<Number, VectorizedArrayType>>::
+            value)
+        {
+          unsigned int offsets[n_vectorization];
+          for (unsigned int i = 0; i < dofs_per_component; ++i)
+            {
+              for (unsigned int v = 0; v < n_vectorization; ++v)
+                offsets[v] = dof_indices[v][i];
+              for (unsigned int comp = 0; comp < n_components; ++comp)
+                operation.process_dof_gather(offsets,
+                                             *src[comp],
+                                             0,
+                                             values_dofs[comp][i],
+                                             vector_selector);
+            }
+        }
+      else if (n_components == 1 || n_fe_components == 1)
         {
           for (unsigned int v = 0; v < n_vectorization_actual; ++v)
             for (unsigned int i = 0; i < dofs_per_component; ++i)
@@ -4565,15 +5036,17 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
               .second;
         }
 
-      if (apply_constraints == false &&
-          dof_info
-              ->row_starts[(cell * n_vectorization + v) * n_fe_components +
-                           first_selected_component]
-              .second !=
-            dof_info
-              ->row_starts[(cell * n_vectorization + v) * n_fe_components +
-                           first_selected_component + n_components_read]
-              .second)
+      if ((apply_constraints == false &&
+           dof_info
+               ->row_starts[(cell * n_vectorization + v) * n_fe_components +
+                            first_selected_component]
+               .second !=
+             dof_info
+               ->row_starts[(cell * n_vectorization + v) * n_fe_components +
+                            first_selected_component + n_components_read]
+               .second) ||
+          (plain_indices_on_hanging_nodes &&
+           dof_info->has_hanging_node_constraints(cell * n_vectorization + v)))
         {
           Assert(
             dof_info->row_starts_plain_indices[cell * n_vectorization + v] !=
@@ -4732,6 +5205,61 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
 
 
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline bool
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  apply_hanging_node_interpolation(const bool transpose) const
+{
+  if (is_face || dof_info == nullptr ||
+      dof_info->hanging_node_constraint_masks.empty())
+    return false;
+
+  constexpr unsigned int n_vectorization =
+    VectorizedArrayType::n_array_elements;
+  const unsigned int *masks =
+    dof_info->hanging_node_constraint_masks.data() + cell * n_vectorization;
+  const unsigned int n_lanes =
+    dof_info->n_vectorization_lanes_filled
+      [internal::MatrixFreeFunctions::DoFInfo::dof_access_cell][cell];
+  bool has_hanging_nodes = false;
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    if (masks[v] != 0)
+      has_hanging_nodes = true;
+  if (has_hanging_nodes == false)
+    return false;
+
+  Assert(hanging_nodes_scratch_data != nullptr, ExcInternalError());
+  Assert(this->data->hanging_node_interpolation[0].size() > 0,
+         ExcNotInitialized());
+  const unsigned int dofs_per_component =
+    this->data->dofs_per_component_on_cell;
+  for (unsigned int comp = 0; comp < n_components; ++comp)
+    {
+      VectorizedArrayType *original_values =
+        hanging_nodes_scratch_data + comp * dofs_per_component;
+      std::copy(this->values_dofs[comp],
+                this->values_dofs[comp] + dofs_per_component,
+                original_values);
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        if (masks[v] != 0)
+          internal::MatrixFreeFunctions::apply_hanging_node_interpolation<dim>(
+            this->data->fe_degree + 1,
+            this->data->hanging_node_interpolation,
+            masks[v],
+            v,
+            transpose,
+            original_values,
+            this->values_dofs[comp]);
+    }
+  return true;
+}
+
+
+
 template <int dim,
           int n_components_,
           typename Number,
@@ -5011,6 +5539,81 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
 
 
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+template <typename VectorType, typename VectorOperation>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  read_write_operation_neighbors(
+    const VectorOperation &                                   operation,
+    VectorType *                                              src[],
+    const std::bitset<VectorizedArrayType::n_array_elements> &mask) const
+{
+  // The neighbors of the cells in a batch are generally part of different
+  // cell batches with different storage variants, so we cannot use the
+  // vectorized access of the other functions but use the plain indices of
+  // each neighbor, which are available for all storage variants
+  VectorizedArrayType **values_dofs =
+    const_cast<VectorizedArrayType **>(&this->values_dofs[0]);
+  const unsigned int dofs_per_component =
+    this->data->dofs_per_component_on_cell;
+  const unsigned int n_components_read = n_fe_components > 1 ? n_components : 1;
+  (void)n_components_read;
+
+  for (unsigned int comp = 0; comp < n_components; ++comp)
+    for (unsigned int i = 0; i < dofs_per_component; ++i)
+      operation.process_empty(values_dofs[comp][i]);
+
+  for (unsigned int v = 0; v < VectorizedArrayType::n_array_elements; ++v)
+    {
+      const unsigned int neighbor = neighbor_cells[v];
+      if (neighbor == numbers::invalid_unsigned_int || mask[v] == false)
+        continue;
+
+      AssertIndexRange(neighbor * n_fe_components + first_selected_component +
+                         n_components_read,
+                       dof_info->row_starts.size());
+      Assert(dof_info
+                 ->row_starts[neighbor * n_fe_components +
+                              first_selected_component]
+                 .second ==
+               dof_info
+                 ->row_starts[neighbor * n_fe_components +
+                              first_selected_component + n_components_read]
+                 .second,
+             ExcNotImplemented("The exterior side of the faces of a cell "
+                               "batch does not support constraints on the "
+                               "neighboring cells."));
+      Assert(dof_info->hanging_node_constraint_masks.empty() ||
+               dof_info->has_hanging_node_constraints(neighbor) == false,
+             ExcNotImplemented("The exterior side of the faces of a cell "
+                               "batch does not support constraints on the "
+                               "neighboring cells."));
+      const unsigned int *dof_indices =
+        dof_info->dof_indices.data() +
+        dof_info
+          ->row_starts[neighbor * n_fe_components + first_selected_component]
+          .first;
+      if (n_components == 1 || n_fe_components == 1)
+        for (unsigned int i = 0; i < dofs_per_component; ++i)
+          for (unsigned int comp = 0; comp < n_components; ++comp)
+            operation.process_dof(dof_indices[i],
+                                  *src[comp],
+                                  values_dofs[comp][i][v]);
+      else
+        for (unsigned int comp = 0; comp < n_components; ++comp)
+          for (unsigned int i = 0; i < dofs_per_component; ++i)
+            operation.process_dof(dof_indices[comp * dofs_per_component + i],
+                                  *src[0],
+                                  values_dofs[comp][i][v]);
+    }
+}
+
+
+
 template <int dim,
           int n_components_,
           typename Number,
@@ -5038,6 +5641,98 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
     src_data,
     std::bitset<VectorizedArrayType::n_array_elements>().flip(),
     true);
+  apply_hanging_node_interpolation(false);
+
+#  ifdef DEBUG
+  dof_values_initialized = true;
+#  endif
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+template <typename VectorType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  read_dof_values_with_inhomogeneities(const VectorType & src,
+                                       const unsigned int first_index)
+{
+  Assert(matrix_info != nullptr,
+         ExcMessage("Inhomogeneities can only be applied for FEEvaluation "
+                    "objects constructed with a MatrixFree object."));
+  Assert(dof_info->store_inhomogeneities,
+         ExcMessage("MatrixFree has not stored the inhomogeneities of the "
+                    "constraints. Set the flag "
+                    "AdditionalData::store_constraint_inhomogeneities."));
+
+  typename internal::BlockVectorSelector<
+    VectorType,
+    IsBlockVector<VectorType>::value>::BaseVectorType *src_data[n_components];
+  for (unsigned int d = 0; d < n_components; ++d)
+    src_data[d] =
+      internal::BlockVectorSelector<VectorType,
+                                    IsBlockVector<VectorType>::value>::
+        get_vector_component(const_cast<VectorType &>(src), d + first_index);
+
+  internal::VectorReader<Number, VectorizedArrayType> reader;
+  read_write_operation(
+    reader,
+    src_data,
+    std::bitset<VectorizedArrayType::n_array_elements>().flip(),
+    true);
+
+  // walk through the constraint indicators of the cells in the batch in the
+  // same way as read_write_operation() and add the inhomogeneity on each
+  // constrained dof. cells with contiguous or interleaved storage have empty
+  // ranges of indicators
+  constexpr unsigned int n_vectorization =
+    VectorizedArrayType::n_array_elements;
+  const unsigned int n_components_read = n_fe_components > 1 ? n_components : 1;
+  const unsigned int n_lanes =
+    dof_info->n_vectorization_lanes_filled[dof_access_index][cell];
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    {
+      unsigned int cell_index = cell * n_vectorization + v;
+      if (is_face && is_interior_face == false &&
+          dof_access_index ==
+            internal::MatrixFreeFunctions::DoFInfo::dof_access_cell)
+        cell_index = neighbor_cells[v];
+      else if (is_face &&
+               dof_access_index !=
+                 internal::MatrixFreeFunctions::DoFInfo::dof_access_cell)
+        cell_index =
+          is_interior_face ?
+            this->matrix_info->get_face_info(cell).cells_interior[v] :
+            this->matrix_info->get_face_info(cell).cells_exterior[v];
+      if (cell_index == numbers::invalid_unsigned_int)
+        continue;
+
+      for (unsigned int comp = 0; comp < n_components_read; ++comp)
+        {
+          const unsigned int row =
+            cell_index * n_fe_components + first_selected_component + comp;
+          unsigned int ind_local = 0;
+          for (unsigned int i = dof_info->row_starts[row].second;
+               i < dof_info->row_starts[row + 1].second;
+               ++i, ++ind_local)
+            {
+              ind_local += dof_info->constraint_indicator[i].first;
+              const Number inhomogeneity =
+                dof_info->constraint_inhomogeneities[i];
+              if (n_components_read == 1)
+                for (unsigned int c = 0; c < n_components; ++c)
+                  values_dofs[c][ind_local][v] += inhomogeneity;
+              else
+                values_dofs[comp][ind_local][v] += inhomogeneity;
+            }
+        }
+    }
+
+  apply_hanging_node_interpolation(false);
 
 #  ifdef DEBUG
   dof_values_initialized = true;
@@ -5108,9 +5803,21 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       IsBlockVector<VectorType>::value>::get_vector_component(dst,
                                                               d + first_index);
 
+  // apply the transpose of the hanging node interpolation to the values and
+  // restore the original values after the distribution
+  const bool values_changed = apply_hanging_node_interpolation(true);
+
   internal::VectorDistributorLocalToGlobal<Number, VectorizedArrayType>
     distributor;
   read_write_operation(distributor, dst_data, mask);
+
+  if (values_changed)
+    for (unsigned int comp = 0; comp < n_components; ++comp)
+      std::copy(hanging_nodes_scratch_data +
+                  comp * this->data->dofs_per_component_on_cell,
+                hanging_nodes_scratch_data +
+                  (comp + 1) * this->data->dofs_per_component_on_cell,
+                this->values_dofs[comp]);
 }
 
 
@@ -5148,6 +5855,154 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
 
 
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  read_dof_values(
+    const LinearAlgebra::distributed::Vector<std::complex<Number>> &src,
+    const unsigned int)
+{
+  static_assert(n_components_ == 2,
+                "Complex vectors need an FEEvaluation object with two "
+                "components for the real and imaginary parts.");
+  Assert(matrix_info != nullptr && n_fe_components == 1,
+         ExcMessage("Complex vectors are only supported for objects "
+                    "initialized from a MatrixFree object with a scalar "
+                    "element."));
+
+  internal::ComplexVectorComponents<Number> src_data(
+    const_cast<LinearAlgebra::distributed::Vector<std::complex<Number>> &>(
+      src));
+
+  internal::VectorReader<Number, VectorizedArrayType> reader;
+  read_write_operation(
+    reader,
+    src_data.components.data(),
+    std::bitset<VectorizedArrayType::n_array_elements>().flip(),
+    true);
+  apply_hanging_node_interpolation(false);
+
+#  ifdef DEBUG
+  dof_values_initialized = true;
+#  endif
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  read_dof_values_plain(
+    const LinearAlgebra::distributed::Vector<std::complex<Number>> &src,
+    const unsigned int)
+{
+  static_assert(n_components_ == 2,
+                "Complex vectors need an FEEvaluation object with two "
+                "components for the real and imaginary parts.");
+  Assert(matrix_info != nullptr && n_fe_components == 1,
+         ExcMessage("Complex vectors are only supported for objects "
+                    "initialized from a MatrixFree object with a scalar "
+                    "element."));
+
+  internal::ComplexVectorComponents<Number> src_data(
+    const_cast<LinearAlgebra::distributed::Vector<std::complex<Number>> &>(
+      src));
+
+  internal::VectorReader<Number, VectorizedArrayType> reader;
+  read_write_operation(
+    reader,
+    src_data.components.data(),
+    std::bitset<VectorizedArrayType::n_array_elements>().flip(),
+    false);
+
+#  ifdef DEBUG
+  dof_values_initialized = true;
+#  endif
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  distribute_local_to_global(
+    LinearAlgebra::distributed::Vector<std::complex<Number>> &dst,
+    const unsigned int,
+    const std::bitset<VectorizedArrayType::n_array_elements> &mask) const
+{
+  static_assert(n_components_ == 2,
+                "Complex vectors need an FEEvaluation object with two "
+                "components for the real and imaginary parts.");
+  Assert(matrix_info != nullptr && n_fe_components == 1,
+         ExcMessage("Complex vectors are only supported for objects "
+                    "initialized from a MatrixFree object with a scalar "
+                    "element."));
+  Assert(dof_values_initialized == true,
+         internal::ExcAccessToUninitializedField());
+
+  internal::ComplexVectorComponents<Number> dst_data(dst);
+
+  // apply the transpose of the hanging node interpolation to the values and
+  // restore the original values after the distribution
+  const bool values_changed = apply_hanging_node_interpolation(true);
+
+  internal::VectorDistributorLocalToGlobal<Number, VectorizedArrayType>
+    distributor;
+  read_write_operation(distributor, dst_data.components.data(), mask);
+
+  if (values_changed)
+    for (unsigned int comp = 0; comp < n_components; ++comp)
+      std::copy(hanging_nodes_scratch_data +
+                  comp * this->data->dofs_per_component_on_cell,
+                hanging_nodes_scratch_data +
+                  (comp + 1) * this->data->dofs_per_component_on_cell,
+                this->values_dofs[comp]);
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  set_dof_values(
+    LinearAlgebra::distributed::Vector<std::complex<Number>> &dst,
+    const unsigned int,
+    const std::bitset<VectorizedArrayType::n_array_elements> &mask) const
+{
+  static_assert(n_components_ == 2,
+                "Complex vectors need an FEEvaluation object with two "
+                "components for the real and imaginary parts.");
+  Assert(matrix_info != nullptr && n_fe_components == 1,
+         ExcMessage("Complex vectors are only supported for objects "
+                    "initialized from a MatrixFree object with a scalar "
+                    "element."));
+  Assert(dof_values_initialized == true,
+         internal::ExcAccessToUninitializedField());
+
+  internal::ComplexVectorComponents<Number> dst_data(dst);
+
+  internal::VectorSetter<Number, VectorizedArrayType> setter;
+  read_write_operation(setter, dst_data.components.data(), mask);
+}
+
+
+
 /*------------------------------ access to data fields ----------------------*/
 
 template <int dim,
@@ -5497,7 +6352,6 @@ inline Tensor<1, n_components_, Tensor<2, dim, VectorizedArrayType>>
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   get_hessian(const unsigned int q_point) const
 {
-  Assert(!is_face, ExcNotImplemented());
   Assert(this->hessians_quad_initialized == true,
          internal::ExcAccessToUninitializedField());
   AssertIndexRange(q_point, this->n_quadrature_points);
@@ -5511,7 +6365,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   Tensor<2, dim, VectorizedArrayType> hessian_out[n_components];
 
   // Cartesian cell
-  if (this->cell_type == internal::MatrixFreeFunctions::cartesian)
+  if (!is_face && this->cell_type == internal::MatrixFreeFunctions::cartesian)
     {
       for (unsigned int comp = 0; comp < n_components; comp++)
         for (unsigned int d = 0; d < dim; ++d)
@@ -5546,7 +6400,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
           }
     }
   // cell with general Jacobian, but constant within the cell
-  else if (this->cell_type == internal::MatrixFreeFunctions::affine)
+  else if (this->cell_type <= internal::MatrixFreeFunctions::affine)
     {
       for (unsigned int comp = 0; comp < n_components; comp++)
         {
@@ -5579,6 +6433,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   // cell with general Jacobian
   else
     {
+      // the derivatives of the Jacobian are not available on faces
+      Assert(is_face == false, ExcNotImplemented());
       const Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>
         &jac_grad =
           mapping_data->jacobian_gradients
@@ -5637,7 +6493,6 @@ inline Tensor<1, n_components_, Tensor<1, dim, VectorizedArrayType>>
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   get_hessian_diagonal(const unsigned int q_point) const
 {
-  Assert(!is_face, ExcNotImplemented());
   Assert(this->hessians_quad_initialized == true,
          internal::ExcAccessToUninitializedField());
   AssertIndexRange(q_point, this->n_quadrature_points);
@@ -5651,7 +6506,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   Tensor<1, n_components_, Tensor<1, dim, VectorizedArrayType>> hessian_out;
 
   // Cartesian cell
-  if (this->cell_type == internal::MatrixFreeFunctions::cartesian)
+  if (!is_face && this->cell_type == internal::MatrixFreeFunctions::cartesian)
     {
       for (unsigned int comp = 0; comp < n_components; comp++)
         for (unsigned int d = 0; d < dim; ++d)
@@ -5659,7 +6514,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
             (this->hessians_quad[comp][d][q_point] * jac[d][d] * jac[d][d]);
     }
   // cell with general Jacobian, but constant within the cell
-  else if (this->cell_type == internal::MatrixFreeFunctions::affine)
+  else if (this->cell_type <= internal::MatrixFreeFunctions::affine)
     {
       for (unsigned int comp = 0; comp < n_components; comp++)
         {
@@ -5684,6 +6539,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   // cell with general Jacobian
   else
     {
+      // the derivatives of the Jacobian are not available on faces
+      Assert(is_face == false, ExcNotImplemented());
       const Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>
         &jac_grad =
           mapping_data->jacobian_gradients
@@ -5727,7 +6584,6 @@ inline Tensor<1, n_components_, VectorizedArrayType>
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   get_laplacian(const unsigned int q_point) const
 {
-  Assert(is_face == false, ExcNotImplemented());
   Assert(this->hessians_quad_initialized == true,
          internal::ExcAccessToUninitializedField());
   AssertIndexRange(q_point, this->n_quadrature_points);
@@ -5746,6 +6602,29 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
 
 
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline Tensor<1, n_components_, VectorizedArrayType>
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  get_normal_hessian(const unsigned int q_point) const
+{
+  Assert(is_face == true, ExcNotImplemented());
+
+  const Tensor<1, n_components_, Tensor<2, dim, VectorizedArrayType>> hessian =
+    get_hessian(q_point);
+  const Tensor<1, dim, VectorizedArrayType> normal = get_normal_vector(q_point);
+
+  Tensor<1, n_components_, VectorizedArrayType> hessian_out;
+  for (unsigned int comp = 0; comp < n_components; ++comp)
+    hessian_out[comp] = normal * (hessian[comp] * normal);
+  return hessian_out;
+}
+
+
+
 template <int dim,
           int n_components_,
           typename Number,
@@ -6209,6 +7088,16 @@ FEEvaluationAccess<dim, 1, Number, is_face, VectorizedArrayType>::get_laplacian(
 
 
 
+template <int dim, typename Number, bool is_face, typename VectorizedArrayType>
+inline VectorizedArrayType
+FEEvaluationAccess<dim, 1, Number, is_face, VectorizedArrayType>::
+  get_normal_hessian(const unsigned int q_point) const
+{
+  return BaseClass::get_normal_hessian(q_point)[0];
+}
+
+
+
 template <int dim, typename Number, bool is_face, typename VectorizedArrayType>
 inline void DEAL_II_ALWAYS_INLINE
             FEEvaluationAccess<dim, 1, Number, is_face, VectorizedArrayType>::
@@ -6874,6 +7763,16 @@ inline DEAL_II_ALWAYS_INLINE VectorizedArrayType
 
 
 
+template <typename Number, bool is_face, typename VectorizedArrayType>
+inline VectorizedArrayType
+FEEvaluationAccess<1, 1, Number, is_face, VectorizedArrayType>::
+  get_normal_hessian(const unsigned int q_point) const
+{
+  return BaseClass::get_normal_hessian(q_point)[0];
+}
+
+
+
 template <typename Number, bool is_face, typename VectorizedArrayType>
 inline DEAL_II_ALWAYS_INLINE void DEAL_II_ALWAYS_INLINE
                                   FEEvaluationAccess<1, 1, Number, is_face, VectorizedArrayType>::
@@ -7369,10 +8268,16 @@ FEEvaluation<dim,
   this->cell_type =
     this->matrix_info->get_mapping_info().get_cell_type(cell_index);
 
-  const unsigned int offsets =
-    this->mapping_data->data_index_offsets[cell_index];
-  this->jacobian = &this->mapping_data->jacobians[0][offsets];
-  this->J_value  = &this->mapping_data->JxW_values[offsets];
+  if (this->cell_type == internal::MatrixFreeFunctions::general &&
+      this->matrix_info->get_mapping_info().n_geometry_points_1d > 0)
+    this->compute_geometry_on_the_fly();
+  else
+    {
+      const unsigned int offsets =
+        this->mapping_data->data_index_offsets[cell_index];
+      this->jacobian = &this->mapping_data->jacobians[0][offsets];
+      this->J_value  = &this->mapping_data->JxW_values[offsets];
+    }
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
@@ -7927,10 +8832,6 @@ FEFaceEvaluation<dim,
   Assert(this->mapped_geometry == nullptr,
          ExcMessage("FEEvaluation was initialized without a matrix-free object."
                     " Integer indexing is not possible"));
-  Assert(this->is_interior_face == true,
-         ExcMessage(
-           "Cell-based FEFaceEvaluation::reinit only possible for the "
-           "interior face with second argument to constructor as true"));
   if (this->mapped_geometry != nullptr)
     return;
   Assert(this->matrix_info != nullptr, ExcNotInitialized());
@@ -7943,6 +8844,82 @@ FEFaceEvaluation<dim,
   this->dof_access_index =
     internal::MatrixFreeFunctions::DoFInfo::dof_access_cell;
 
+  if (this->is_interior_face == false)
+    {
+      // identify the neighbors behind the face via the faces stored in
+      // MatrixFree, where the cell of the current batch can be on either
+      // side
+      constexpr unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+      const std::array<unsigned int, n_lanes> faces =
+        this->matrix_info->get_faces_by_cells_face_index(cell_index,
+                                                         face_number);
+      const std::array<types::boundary_id, n_lanes> boundary_ids =
+        this->matrix_info->get_faces_by_cells_boundary_id(cell_index,
+                                                          face_number);
+      (void)boundary_ids;
+      bool neighbor_found = false;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          this->neighbor_cells[v] = numbers::invalid_unsigned_int;
+          if (faces[v] == numbers::invalid_unsigned_int)
+            {
+              Assert(boundary_ids[v] != numbers::invalid_boundary_id ||
+                       v >= this->matrix_info->n_active_entries_per_cell_batch(
+                              cell_index),
+                     ExcMessage(
+                       "The neighbor behind the face is not available. Set "
+                       "MatrixFree::AdditionalData::hold_all_faces_to_owned_"
+                       "cells to access the neighbors behind all faces."));
+              continue;
+            }
+
+          const internal::MatrixFreeFunctions::FaceToCellTopology<n_lanes>
+            &                face = this->matrix_info->get_face_info(faces[v] /
+                                                                     n_lanes);
+          const unsigned int lane = faces[v] % n_lanes;
+          unsigned int       neighbor_face_no, orientation, subface_index;
+          if (face.cells_interior[lane] == cell_index * n_lanes + v)
+            {
+              this->neighbor_cells[v] = face.cells_exterior[lane];
+              neighbor_face_no        = face.exterior_face_no;
+              subface_index           = face.subface_index;
+              Assert(face.face_orientation <= 8, ExcNotImplemented());
+              orientation = face.face_orientation % 8;
+            }
+          else
+            {
+              AssertDimension(face.cells_exterior[lane],
+                              cell_index * n_lanes + v);
+              this->neighbor_cells[v] = face.cells_interior[lane];
+              neighbor_face_no        = face.interior_face_no;
+              subface_index = GeometryInfo<dim>::max_children_per_cell;
+              Assert(face.subface_index ==
+                       GeometryInfo<dim>::max_children_per_cell,
+                     ExcNotImplemented("Neighbors behind hanging faces are "
+                                       "only supported from the refined "
+                                       "side."));
+              Assert(face.face_orientation == 0 || face.face_orientation >= 8,
+                     ExcNotImplemented());
+              orientation = face.face_orientation % 8;
+            }
+
+          if (neighbor_found == false)
+            {
+              this->face_no          = neighbor_face_no;
+              this->face_orientation = orientation;
+              this->subface_index    = subface_index;
+              neighbor_found         = true;
+            }
+          else
+            Assert(this->face_no == neighbor_face_no &&
+                     this->face_orientation == orientation &&
+                     this->subface_index == subface_index,
+                   ExcMessage("The neighbors behind the faces of a cell batch "
+                              "must share the same local face number and "
+                              "orientation."));
+        }
+    }
+
   const unsigned int offsets =
     this->matrix_info->get_mapping_info()
       .face_data_by_cells[this->quad_no]
@@ -7958,12 +8935,21 @@ FEFaceEvaluation<dim,
   this->normal_vectors = &this->matrix_info->get_mapping_info()
                             .face_data_by_cells[this->quad_no]
                             .normal_vectors[offsets];
-  this->jacobian = &this->matrix_info->get_mapping_info()
-                      .face_data_by_cells[this->quad_no]
-                      .jacobians[0][offsets];
-  this->normal_x_jacobian = &this->matrix_info->get_mapping_info()
-                               .face_data_by_cells[this->quad_no]
-                               .normals_times_jacobians[0][offsets];
+  if (this->is_interior_face)
+    {
+      this->jacobian = &this->matrix_info->get_mapping_info()
+                          .face_data_by_cells[this->quad_no]
+                          .jacobians[0][offsets];
+      this->normal_x_jacobian = &this->matrix_info->get_mapping_info()
+                                   .face_data_by_cells[this->quad_no]
+                                   .normals_times_jacobians[0][offsets];
+    }
+  else
+    {
+      // the Jacobians of the neighbors are not available
+      this->jacobian          = nullptr;
+      this->normal_x_jacobian = nullptr;
+    }
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
@@ -7988,11 +8974,15 @@ FEFaceEvaluation<dim,
                  n_components,
                  Number,
                  VectorizedArrayType>::evaluate(const bool evaluate_values,
-                                                const bool evaluate_gradients)
+                                                const bool evaluate_gradients,
+                                                const bool evaluate_hessians)
 {
   Assert(this->dof_values_initialized, ExcNotInitialized());
 
-  evaluate(this->values_dofs[0], evaluate_values, evaluate_gradients);
+  evaluate(this->values_dofs[0],
+           evaluate_values,
+           evaluate_gradients,
+           evaluate_hessians);
 }
 
 
@@ -8012,11 +9002,17 @@ FEFaceEvaluation<dim,
                  VectorizedArrayType>::evaluate(const VectorizedArrayType
                                                   *        values_array,
                                                 const bool evaluate_values,
-                                                const bool evaluate_gradients)
+                                                const bool evaluate_gradients,
+                                                const bool evaluate_hessians)
 {
-  if (!(evaluate_values + evaluate_gradients))
+  if (!(evaluate_values + evaluate_gradients + evaluate_hessians))
     return;
 
+  Assert(evaluate_hessians == false ||
+           this->cell_type <= internal::MatrixFreeFunctions::affine,
+         ExcMessage("The Hessians on faces are only implemented for faces "
+                    "with a constant Jacobian."));
+
   constexpr unsigned int static_dofs_per_face =
     fe_degree > -1 ? Utilities::pow(fe_degree + 1, dim - 1) :
                      numbers::invalid_unsigned_int;
@@ -8032,9 +9028,13 @@ FEFaceEvaluation<dim,
   // variable to not risk a stack overflow.
   constexpr unsigned int stack_array_size_threshold = 100;
 
+  // the Hessians need the second normal derivative on the face in addition
+  // to the values and the first normal derivative
+  const unsigned int n_face_derivatives = evaluate_hessians ? 3 : 2;
+
   VectorizedArrayType
                        temp_data[static_dofs_per_face < stack_array_size_threshold ?
-                n_components * 2 * static_dofs_per_face :
+                n_components * 3 * static_dofs_per_face :
                 1];
   VectorizedArrayType *temp1;
   if (static_dofs_per_face < stack_array_size_threshold)
@@ -8042,15 +9042,16 @@ FEFaceEvaluation<dim,
   else
     temp1 = this->scratch_data;
 
-  internal::FEFaceNormalEvaluationImpl<
-    dim,
-    fe_degree,
-    n_components,
-    VectorizedArrayType>::template interpolate<true, false>(*this->data,
-                                                            values_array,
-                                                            temp1,
-                                                            evaluate_gradients,
-                                                            this->face_no);
+  internal::FEFaceNormalEvaluationImpl<dim,
+                                       fe_degree,
+                                       n_components,
+                                       VectorizedArrayType>::
+    template interpolate<true, false>(*this->data,
+                                      values_array,
+                                      temp1,
+                                      evaluate_gradients || evaluate_hessians,
+                                      this->face_no,
+                                      evaluate_hessians);
 
   const unsigned int n_q_points_1d_actual = fe_degree > -1 ? n_q_points_1d : 0;
   if (fe_degree > -1 &&
@@ -8067,10 +9068,13 @@ FEFaceEvaluation<dim,
                                              temp1,
                                              this->begin_values(),
                                              this->begin_gradients(),
+                                             this->begin_hessians(),
                                              this->scratch_data +
-                                               2 * n_components * dofs_per_face,
+                                               n_face_derivatives *
+                                                 n_components * dofs_per_face,
                                              evaluate_values,
                                              evaluate_gradients,
+                                             evaluate_hessians,
                                              this->subface_index);
   else
     internal::FEFaceEvaluationImpl<
@@ -8083,20 +9087,28 @@ FEFaceEvaluation<dim,
                                              temp1,
                                              this->begin_values(),
                                              this->begin_gradients(),
+                                             this->begin_hessians(),
                                              this->scratch_data +
-                                               2 * n_components * dofs_per_face,
+                                               n_face_derivatives *
+                                                 n_components * dofs_per_face,
                                              evaluate_values,
                                              evaluate_gradients,
+                                             evaluate_hessians,
                                              this->subface_index);
 
   if (this->face_orientation)
-    adjust_for_face_orientation(false, evaluate_values, evaluate_gradients);
+    adjust_for_face_orientation(false,
+                                evaluate_values,
+                                evaluate_gradients,
+                                evaluate_hessians);
 
 #  ifdef DEBUG
   if (evaluate_values == true)
     this->values_quad_initialized = true;
   if (evaluate_gradients == true)
     this->gradients_quad_initialized = true;
+  if (evaluate_hessians == true)
+    this->hessians_quad_initialized = true;
 #  endif
 }
 
@@ -8147,7 +9159,10 @@ FEFaceEvaluation<dim,
     return;
 
   if (this->face_orientation)
-    adjust_for_face_orientation(true, integrate_values, integrate_gradients);
+    adjust_for_face_orientation(true,
+                                integrate_values,
+                                integrate_gradients,
+                                false);
 
   constexpr unsigned int static_dofs_per_face =
     fe_degree > -1 ? Utilities::pow(fe_degree + 1, dim - 1) :
@@ -8211,8 +9226,12 @@ FEFaceEvaluation<dim,
                                        fe_degree,
                                        n_components,
                                        VectorizedArrayType>::
-    template interpolate<false, false>(
-      *this->data, temp1, values_array, integrate_gradients, this->face_no);
+    template interpolate<false, false>(*this->data,
+                                       temp1,
+                                       values_array,
+                                       integrate_gradients,
+                                       this->face_no,
+                                       false);
 }
 
 
@@ -8261,12 +9280,20 @@ FEFaceEvaluation<
                          internal::is_vectorizable<VectorType, Number>::value>
     vector_selector;
 
+  // the lanes of the exterior side of the faces of a cell batch belong to
+  // neighbors with arbitrary storage, which go through the general path
+  const bool lanes_on_neighbors =
+    this->is_interior_face == false &&
+    this->dof_access_index ==
+      internal::MatrixFreeFunctions::DoFInfo::dof_access_cell;
+
   // case 1: contiguous and interleaved indices
   if (((evaluate_gradients == false &&
         this->data->nodal_at_cell_boundaries == true) ||
        (this->data->element_type ==
           internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
         fe_degree > 1)) &&
+      lanes_on_neighbors == false &&
       this->dof_info
           ->index_storage_variants[this->dof_access_index][this->cell] ==
         internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -8353,6 +9380,7 @@ FEFaceEvaluation<
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
              fe_degree > 1)) &&
+           lanes_on_neighbors == false &&
            this->dof_info
                ->index_storage_variants[this->dof_access_index][this->cell] ==
              internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -8450,6 +9478,7 @@ FEFaceEvaluation<
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
              fe_degree > 1)) &&
+           lanes_on_neighbors == false &&
            this->dof_info
                ->index_storage_variants[this->dof_access_index][this->cell] ==
              internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -8598,6 +9627,7 @@ FEFaceEvaluation<
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
              fe_degree > 1)) &&
+           lanes_on_neighbors == false &&
            this->dof_info
                ->index_storage_variants[this->dof_access_index][this->cell] ==
              internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -8687,7 +9717,8 @@ FEFaceEvaluation<
                                           this->values_dofs[0],
                                           temp1,
                                           evaluate_gradients,
-                                          this->face_no);
+                                          this->face_no,
+                                          false);
     }
 
   if (fe_degree > -1 &&
@@ -8704,11 +9735,13 @@ FEFaceEvaluation<
                                              temp1,
                                              this->values_quad[0],
                                              this->gradients_quad[0][0],
+                                             nullptr,
                                              this->scratch_data +
                                                2 * n_components_ *
                                                  dofs_per_face,
                                              evaluate_values,
                                              evaluate_gradients,
+                                             false,
                                              this->subface_index);
   else
     internal::FEFaceEvaluationImpl<
@@ -8721,15 +9754,20 @@ FEFaceEvaluation<
                                              temp1,
                                              this->values_quad[0],
                                              this->gradients_quad[0][0],
+                                             nullptr,
                                              this->scratch_data +
                                                2 * n_components_ *
                                                  dofs_per_face,
                                              evaluate_values,
                                              evaluate_gradients,
+                                             false,
                                              this->subface_index);
 
   if (this->face_orientation)
-    adjust_for_face_orientation(false, evaluate_values, evaluate_gradients);
+    adjust_for_face_orientation(false,
+                                evaluate_values,
+                                evaluate_gradients,
+                                false);
 
 #  ifdef DEBUG
   if (evaluate_values == true)
@@ -8776,7 +9814,10 @@ FEFaceEvaluation<
     temp1 = this->scratch_data;
 
   if (this->face_orientation)
-    adjust_for_face_orientation(true, integrate_values, integrate_gradients);
+    adjust_for_face_orientation(true,
+                                integrate_values,
+                                integrate_gradients,
+                                false);
   if (fe_degree > -1 &&
       this->subface_index >= GeometryInfo<dim>::max_children_per_cell &&
       this->data->element_type <=
@@ -8824,12 +9865,20 @@ FEFaceEvaluation<
                          internal::is_vectorizable<VectorType, Number>::value>
     vector_selector;
 
+  // the lanes of the exterior side of the faces of a cell batch belong to
+  // neighbors with arbitrary storage, which go through the general path
+  const bool lanes_on_neighbors =
+    this->is_interior_face == false &&
+    this->dof_access_index ==
+      internal::MatrixFreeFunctions::DoFInfo::dof_access_cell;
+
   // case 1: contiguous and interleaved indices
   if (((integrate_gradients == false &&
         this->data->nodal_at_cell_boundaries == true) ||
        (this->data->element_type ==
           internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
         fe_degree > 1)) &&
+      lanes_on_neighbors == false &&
       this->dof_info
           ->index_storage_variants[this->dof_access_index][this->cell] ==
         internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -8919,6 +9968,7 @@ FEFaceEvaluation<
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
              fe_degree > 1)) &&
+           lanes_on_neighbors == false &&
            this->dof_info
                ->index_storage_variants[this->dof_access_index][this->cell] ==
              internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -9020,6 +10070,7 @@ FEFaceEvaluation<
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
              fe_degree > 1)) &&
+           lanes_on_neighbors == false &&
            this->dof_info
                ->index_storage_variants[this->dof_access_index][this->cell] ==
              internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -9162,6 +10213,7 @@ FEFaceEvaluation<
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
              fe_degree > 1)) &&
+           lanes_on_neighbors == false &&
            this->dof_info
                ->index_storage_variants[this->dof_access_index][this->cell] ==
              internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -9254,7 +10306,8 @@ FEFaceEvaluation<
                                            temp1,
                                            this->values_dofs[0],
                                            integrate_gradients,
-                                           this->face_no);
+                                           this->face_no,
+                                           false);
       this->distribute_local_to_global(destination);
     }
 }
@@ -9276,7 +10329,8 @@ FEFaceEvaluation<
   Number,
   VectorizedArrayType>::adjust_for_face_orientation(const bool integrate,
                                                     const bool values,
-                                                    const bool gradients)
+                                                    const bool gradients,
+                                                    const bool hessians)
 {
   VectorizedArrayType *tmp_values = this->scratch_data;
   const unsigned int * orientations =
@@ -9307,6 +10361,18 @@ FEFaceEvaluation<
             for (unsigned int q = 0; q < n_q_points; ++q)
               this->gradients_quad[c][d][q] = tmp_values[q];
           }
+      if (hessians == true)
+        for (unsigned int d = 0; d < (dim * (dim + 1)) / 2; ++d)
+          {
+            if (integrate)
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                tmp_values[q] = this->hessians_quad[c][d][orientations[q]];
+            else
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                tmp_values[orientations[q]] = this->hessians_quad[c][d][q];
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              this->hessians_quad[c][d][q] = tmp_values[q];
+          }
     }
 }
 
@@ -0,0 +1,618 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_fe_point_evaluation_h
+#define dealii_fe_point_evaluation_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/matrix_free/shape_info.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <algorithm>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace FEPointEvaluation
+  {
+    /**
+     * A class that defines the types of the values and gradients returned
+     * by FEPointEvaluation for a given number of components, together with
+     * functions to access the individual components.
+     */
+    template <int dim, int n_components, typename Number>
+    struct EvaluatorTypeTraits
+    {
+      using value_type    = Tensor<1, n_components, Number>;
+      using gradient_type = Tensor<1, n_components, Tensor<1, dim, Number>>;
+
+      static Number &
+      access_value(value_type &value, const unsigned int component)
+      {
+        return value[component];
+      }
+
+      static Tensor<1, dim, Number> &
+      access_gradient(gradient_type &gradient, const unsigned int component)
+      {
+        return gradient[component];
+      }
+    };
+
+
+
+    /**
+     * Specialization of the type traits for scalar fields, using plain
+     * numbers for the values and rank-1 tensors for the gradients.
+     */
+    template <int dim, typename Number>
+    struct EvaluatorTypeTraits<dim, 1, Number>
+    {
+      using value_type    = Number;
+      using gradient_type = Tensor<1, dim, Number>;
+
+      static Number &
+      access_value(value_type &value, const unsigned int)
+      {
+        return value;
+      }
+
+      static Tensor<1, dim, Number> &
+      access_gradient(gradient_type &gradient, const unsigned int)
+      {
+        return gradient;
+      }
+    };
+  } // namespace FEPointEvaluation
+} // namespace internal
+
+
+
+/**
+ * This class provides an interface to the evaluation of the values and
+ * gradients of a finite element solution on a cell at an arbitrary set of
+ * points given in reference coordinates. It is an alternative to setting up
+ * an FEValues object with a Quadrature formula consisting of the given
+ * points, which is what VectorTools::point_value() and
+ * Functions::FEFieldFunction do for every single point. Instead, this class
+ * uses the tensor product structure of the finite element as detected by
+ * internal::MatrixFreeFunctions::ShapeInfo, evaluating only the
+ * one-dimensional shape functions at the coordinates of the points and
+ * combining them with sum factorization. Furthermore, the points are
+ * processed in batches of VectorizedArray::n_array_elements points at once.
+ * The typical use is as follows, with the reference coordinates of the
+ * points in a cell obtained, e.g., from
+ * GridTools::compute_point_locations():
+ * @code
+ * FEPointEvaluation<1, dim> evaluator(mapping, dof_handler.get_fe());
+ * Vector<double>            cell_values(fe.dofs_per_cell);
+ * for (cell in cells_with_points)
+ *   {
+ *     evaluator.reinit(cell, unit_points_in_cell);
+ *     cell->get_dof_values(solution, cell_values);
+ *     evaluator.evaluate(make_array_view(cell_values), true, true);
+ *     for (unsigned int q = 0; q < unit_points_in_cell.size(); ++q)
+ *       {
+ *         const double         value    = evaluator.get_value(q);
+ *         const Tensor<1, dim> gradient = evaluator.get_gradient(q);
+ *         ...
+ *       }
+ *   }
+ * @endcode
+ *
+ * The one-dimensional shape functions at the points and the FEValues object
+ * that computes the inverse Jacobians of the mapping are only set up again
+ * in reinit() if the reference points differ from the ones of the previous
+ * call, so evaluating many cells with the same relative point positions is
+ * particularly cheap.
+ *
+ * This class supports the elements that FEEvaluation operates on with a
+ * full tensor product of one-dimensional shape functions, i.e., FE_Q,
+ * FE_DGQ and its variants, and FESystem objects composed of such an
+ * element. For vector-valued elements, the @p n_components components
+ * starting at @p first_selected_component must belong to the same base
+ * element.
+ *
+ * @tparam n_components The number of vector components of the field to be
+ *                      evaluated.
+ * @tparam dim The space dimension.
+ * @tparam Number The number type of the solution values and the results.
+ *
+ * @ingroup matrixfree
+ */
+template <int n_components, int dim, typename Number = double>
+class FEPointEvaluation
+{
+public:
+  using value_type = typename internal::FEPointEvaluation::
+    EvaluatorTypeTraits<dim, n_components, Number>::value_type;
+  using gradient_type = typename internal::FEPointEvaluation::
+    EvaluatorTypeTraits<dim, n_components, Number>::gradient_type;
+
+  /**
+   * Constructor. Sets up the one-dimensional shape functions of the
+   * element @p fe, whose components starting at @p first_selected_component
+   * are evaluated. The mapping is used to compute the inverse Jacobians at
+   * the points when computing gradients.
+   */
+  FEPointEvaluation(const Mapping<dim> &      mapping,
+                    const FiniteElement<dim> &fe,
+                    const unsigned int        first_selected_component = 0);
+
+  /**
+   * Set up the evaluation on the given @p cell at the given @p unit_points
+   * in reference coordinates of the cell.
+   */
+  void
+  reinit(const typename Triangulation<dim>::cell_iterator &cell,
+         const ArrayView<const Point<dim>> &               unit_points);
+
+  /**
+   * Evaluate the finite element field with the coefficients
+   * @p solution_values at the points passed to reinit(). The coefficients
+   * are given in the numbering of the degrees of freedom of the full finite
+   * element passed to the constructor, as returned for example by
+   * DoFCellAccessor::get_dof_values(). The other two arguments select
+   * whether values and gradients are computed.
+   */
+  void
+  evaluate(const ArrayView<const Number> &solution_values,
+           const bool                     evaluate_values,
+           const bool                     evaluate_gradients);
+
+  /**
+   * Return the value at point number @p point_index after a call to
+   * evaluate() with @p evaluate_values set to true.
+   */
+  const value_type &
+  get_value(const unsigned int point_index) const;
+
+  /**
+   * Return the gradient in real coordinates at point number @p point_index
+   * after a call to evaluate() with @p evaluate_gradients set to true.
+   */
+  const gradient_type &
+  get_gradient(const unsigned int point_index) const;
+
+  /**
+   * Write the value @p value at point number @p point_index, to be tested
+   * by the shape functions in a subsequent call to integrate().
+   */
+  void
+  submit_value(const value_type &value, const unsigned int point_index);
+
+  /**
+   * Multiply the values submitted by submit_value() at all points passed to
+   * reinit() by the values of the shape functions at these points and sum
+   * over the points, i.e., perform the transpose of the operation of
+   * evaluate() for the values. The result is written into
+   * @p solution_values in the numbering of the degrees of freedom of the
+   * full finite element. The entries of the components that are not
+   * selected by this class are set to zero. The result can be added into a
+   * global vector, e.g., by AffineConstraints::distribute_local_to_global().
+   */
+  void
+  integrate(const ArrayView<Number> &solution_values);
+
+  /**
+   * Return the number of points passed to the last call of reinit().
+   */
+  unsigned int
+  n_points() const;
+
+private:
+  /**
+   * Evaluate the 1D shape functions and their derivatives at the
+   * coordinates of the points in @p unit_points, filling the field
+   * @p shapes.
+   */
+  void
+  compute_shape_values();
+
+  /**
+   * The mapping used to compute the inverse Jacobians.
+   */
+  SmartPointer<const Mapping<dim>> mapping;
+
+  /**
+   * The number of 1D shape functions in each direction.
+   */
+  unsigned int n_shapes;
+
+  /**
+   * The number of degrees of freedom of the full finite element.
+   */
+  unsigned int dofs_per_cell;
+
+  /**
+   * The Lagrange polynomials on the points of a 1D Gauss formula with
+   * @p n_shapes points.
+   */
+  std::vector<Polynomials::Polynomial<double>> lagrange_basis;
+
+  /**
+   * The values of the 1D shape functions of the element at the points of
+   * @p lagrange_basis, i.e., the coefficients of the shape functions in the
+   * Lagrange basis, with shape function <tt>i</tt> at position
+   * <tt>i*n_shapes</tt>.
+   */
+  std::vector<double> shape_coefficients;
+
+  /**
+   * The position of the coefficients of the selected components in the
+   * numbering of the finite element, with the lexicographic numbering of
+   * the first component first, then the second component, and so on.
+   */
+  std::vector<unsigned int> renumber;
+
+  /**
+   * The reference points of the last call to reinit().
+   */
+  std::vector<Point<dim>> unit_points;
+
+  /**
+   * The values and derivatives of the 1D shape functions at the points in
+   * @p unit_points, for batches of VectorizedArray::n_array_elements points
+   * each in the layout expected by
+   * internal::evaluate_tensor_product_value_and_gradient().
+   */
+  AlignedVector<VectorizedArray<Number>> shapes;
+
+  /**
+   * The FEValues object computing the inverse Jacobians at the points in
+   * @p unit_points. Since only geometric information is needed, it is based
+   * on an FE_Nothing element.
+   */
+  FE_Nothing<dim> fe_nothing;
+
+  std::unique_ptr<FEValues<dim>> fe_values;
+
+  /**
+   * The values at the points computed by the last call to evaluate().
+   */
+  std::vector<value_type> values;
+
+  /**
+   * The gradients at the points computed by the last call to evaluate().
+   */
+  std::vector<gradient_type> gradients;
+
+  /**
+   * Scratch array for the contributions of the points of a batch to the
+   * coefficients in integrate(), in lexicographic numbering for each
+   * component.
+   */
+  AlignedVector<VectorizedArray<Number>> integrated_coefficients;
+};
+
+
+
+/* ---------------------- template functions ----------------------------- */
+
+#ifndef DOXYGEN
+
+template <int n_components, int dim, typename Number>
+FEPointEvaluation<n_components, dim, Number>::FEPointEvaluation(
+  const Mapping<dim> &      mapping,
+  const FiniteElement<dim> &fe,
+  const unsigned int        first_selected_component)
+  : mapping(&mapping)
+  , dofs_per_cell(fe.dofs_per_cell)
+{
+  AssertIndexRange(first_selected_component + n_components - 1,
+                   fe.n_components());
+
+  const unsigned int base_element =
+    fe.component_to_base_index(first_selected_component).first;
+  unsigned int components_before = 0;
+  for (unsigned int e = 0; e < base_element; ++e)
+    components_before += fe.element_multiplicity(e);
+  const unsigned int first_component_in_base =
+    first_selected_component - components_before;
+  Assert(first_component_in_base + n_components <=
+           fe.element_multiplicity(base_element),
+         ExcMessage("The selected components must all belong to the same "
+                    "base element."));
+
+  // ShapeInfo decodes the one-dimensional shape functions and the
+  // lexicographic numbering of the element. Evaluate the shape functions on
+  // a Gauss formula with as many points as there are shape functions per
+  // direction, which makes the values the coefficients of the shape
+  // functions in the Lagrange basis on these points
+  n_shapes = fe.base_element(base_element).degree + 1;
+  const QGauss<1> quadrature(n_shapes);
+  const internal::MatrixFreeFunctions::ShapeInfo<double> shape_info(
+    quadrature, fe, base_element);
+  Assert(shape_info.element_type <=
+           internal::MatrixFreeFunctions::tensor_general,
+         ExcMessage("Only elements with a tensor product structure of the "
+                    "shape functions are supported by FEPointEvaluation."));
+  AssertDimension(shape_info.n_q_points_1d, n_shapes);
+
+  lagrange_basis =
+    Polynomials::generate_complete_Lagrange_basis(quadrature.get_points());
+  shape_coefficients.assign(shape_info.shape_values.begin(),
+                            shape_info.shape_values.end());
+
+  const unsigned int dofs_per_component =
+    shape_info.dofs_per_component_on_cell;
+  renumber.assign(shape_info.lexicographic_numbering.begin() +
+                    first_component_in_base * dofs_per_component,
+                  shape_info.lexicographic_numbering.begin() +
+                    (first_component_in_base + n_components) *
+                      dofs_per_component);
+}
+
+
+
+template <int n_components, int dim, typename Number>
+void
+FEPointEvaluation<n_components, dim, Number>::reinit(
+  const typename Triangulation<dim>::cell_iterator &cell,
+  const ArrayView<const Point<dim>> &               unit_points)
+{
+  // reuse the shape values and the FEValues object if the points are the
+  // same as in the previous call. if they differ, let the FEValues object
+  // only recompute the data that depends on the points rather than
+  // creating a new object
+  if (fe_values.get() == nullptr || unit_points.size() != n_points() ||
+      std::equal(unit_points.begin(),
+                 unit_points.end(),
+                 this->unit_points.begin()) == false)
+    {
+      this->unit_points.assign(unit_points.begin(), unit_points.end());
+      compute_shape_values();
+      if (n_points() == 0)
+        return;
+
+      if (fe_values.get() != nullptr)
+        {
+          fe_values->reinit(cell, Quadrature<dim>(this->unit_points));
+          return;
+        }
+      fe_values = std_cxx14::make_unique<FEValues<dim>>(
+        *mapping,
+        fe_nothing,
+        Quadrature<dim>(this->unit_points),
+        update_inverse_jacobians);
+    }
+
+  if (n_points() > 0)
+    fe_values->reinit(cell);
+}
+
+
+
+template <int n_components, int dim, typename Number>
+void
+FEPointEvaluation<n_components, dim, Number>::compute_shape_values()
+{
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  const unsigned int     n_batches = (n_points() + n_lanes - 1) / n_lanes;
+  const unsigned int     shapes_per_batch = 2 * dim * n_shapes;
+  shapes.resize_fast(n_batches * shapes_per_batch);
+
+  std::vector<double> lagrange_values(2 * n_shapes);
+  for (unsigned int q = 0; q < n_batches * n_lanes; ++q)
+    {
+      // fill the unused lanes of the last batch with the data of the last
+      // point to not work on uninitialized data
+      const Point<dim> &point =
+        unit_points[std::min<unsigned int>(q, n_points() - 1)];
+      VectorizedArray<Number> *batch_shapes =
+        shapes.begin() + (q / n_lanes) * shapes_per_batch;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          for (unsigned int j = 0; j < n_shapes; ++j)
+            lagrange_basis[j].value(point[d], 1, &lagrange_values[2 * j]);
+          for (unsigned int i = 0; i < n_shapes; ++i)
+            {
+              double value = 0, derivative = 0;
+              for (unsigned int j = 0; j < n_shapes; ++j)
+                {
+                  value += shape_coefficients[i * n_shapes + j] *
+                           lagrange_values[2 * j];
+                  derivative += shape_coefficients[i * n_shapes + j] *
+                                lagrange_values[2 * j + 1];
+                }
+              const unsigned int lane = q % n_lanes;
+              batch_shapes[2 * (d * n_shapes + i)][lane]     = value;
+              batch_shapes[2 * (d * n_shapes + i) + 1][lane] = derivative;
+            }
+        }
+    }
+}
+
+
+
+template <int n_components, int dim, typename Number>
+void
+FEPointEvaluation<n_components, dim, Number>::evaluate(
+  const ArrayView<const Number> &solution_values,
+  const bool                     evaluate_values,
+  const bool                     evaluate_gradients)
+{
+  AssertDimension(solution_values.size(), dofs_per_cell);
+  Assert(fe_values.get() != nullptr,
+         ExcMessage("You need to call reinit() before evaluate()."));
+
+  using TypeTraits = internal::FEPointEvaluation::
+    EvaluatorTypeTraits<dim, n_components, Number>;
+
+  if (evaluate_values)
+    values.resize(n_points());
+  if (evaluate_gradients)
+    gradients.resize(n_points());
+
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  const unsigned int dofs_per_component = renumber.size() / n_components;
+  const unsigned int shapes_per_batch   = 2 * dim * n_shapes;
+  for (unsigned int q = 0; q < n_points(); q += n_lanes)
+    {
+      const unsigned int n_filled = std::min(n_lanes, n_points() - q);
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          const auto result =
+            internal::evaluate_tensor_product_value_and_gradient<dim>(
+              shapes.begin() + (q / n_lanes) * shapes_per_batch,
+              n_shapes,
+              solution_values.data(),
+              renumber.data() + c * dofs_per_component);
+
+          for (unsigned int v = 0; v < n_filled; ++v)
+            {
+              if (evaluate_values)
+                TypeTraits::access_value(values[q + v], c) = result.first[v];
+              if (evaluate_gradients)
+                {
+                  // transform the gradient from reference to real
+                  // coordinates
+                  const DerivativeForm<1, dim, dim> &inverse_jacobian =
+                    fe_values->inverse_jacobian(q + v);
+                  Tensor<1, dim, Number> &gradient =
+                    TypeTraits::access_gradient(gradients[q + v], c);
+                  for (unsigned int e = 0; e < dim; ++e)
+                    {
+                      gradient[e] = 0;
+                      for (unsigned int d = 0; d < dim; ++d)
+                        gradient[e] +=
+                          result.second[d][v] * inverse_jacobian[d][e];
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+
+template <int n_components, int dim, typename Number>
+void
+FEPointEvaluation<n_components, dim, Number>::integrate(
+  const ArrayView<Number> &solution_values)
+{
+  AssertDimension(solution_values.size(), dofs_per_cell);
+  AssertDimension(values.size(), n_points());
+
+  using TypeTraits = internal::FEPointEvaluation::
+    EvaluatorTypeTraits<dim, n_components, Number>;
+
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  const unsigned int dofs_per_component = renumber.size() / n_components;
+  const unsigned int shapes_per_batch   = 2 * dim * n_shapes;
+  integrated_coefficients.resize_fast(renumber.size());
+  integrated_coefficients.fill(VectorizedArray<Number>());
+
+  for (unsigned int q = 0; q < n_points(); q += n_lanes)
+    {
+      const unsigned int n_filled = std::min(n_lanes, n_points() - q);
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          // the unused lanes of the last batch must not contribute
+          VectorizedArray<Number> value = Number();
+          for (unsigned int v = 0; v < n_filled; ++v)
+            value[v] = TypeTraits::access_value(values[q + v], c);
+
+          internal::integrate_add_tensor_product_value<dim>(
+            shapes.begin() + (q / n_lanes) * shapes_per_batch,
+            n_shapes,
+            value,
+            integrated_coefficients.begin() + c * dofs_per_component);
+        }
+    }
+
+  std::fill(solution_values.begin(), solution_values.end(), Number());
+  for (unsigned int i = 0; i < renumber.size(); ++i)
+    {
+      Number sum = integrated_coefficients[i][0];
+      for (unsigned int v = 1; v < n_lanes; ++v)
+        sum += integrated_coefficients[i][v];
+      solution_values[renumber[i]] = sum;
+    }
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline void
+FEPointEvaluation<n_components, dim, Number>::submit_value(
+  const value_type & value,
+  const unsigned int point_index)
+{
+  AssertIndexRange(point_index, n_points());
+  if (values.size() != n_points())
+    values.resize(n_points());
+  values[point_index] = value;
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline const typename FEPointEvaluation<n_components, dim, Number>::value_type &
+FEPointEvaluation<n_components, dim, Number>::get_value(
+  const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, values.size());
+  return values[point_index];
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline const typename FEPointEvaluation<n_components, dim, Number>::
+  gradient_type &
+  FEPointEvaluation<n_components, dim, Number>::get_gradient(
+    const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, gradients.size());
+  return gradients[point_index];
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline unsigned int
+FEPointEvaluation<n_components, dim, Number>::n_points() const
+{
+  return unit_points.size();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,345 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_hanging_nodes_internal_h
+#define dealii_matrix_free_hanging_nodes_internal_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    /**
+     * The bits of the mask that describes the hanging node configuration of
+     * a cell in the fast hanging node algorithm of MatrixFree, see
+     * MatrixFree::AdditionalData::use_fast_hanging_node_algorithm. The
+     * first three bits describe the position of the cell within its parent:
+     * the bit of direction @p d is set if the cell is the upper child in
+     * that direction. The next three bits are set if the face of the cell
+     * perpendicular to the respective direction that lies on the boundary
+     * of the parent is hanging, i.e., its neighbor is coarser. A mask of
+     * zero indicates that the cell is not subject to hanging node
+     * constraints, or that they are resolved by the general constraint
+     * algorithm of DoFInfo.
+     *
+     * This is the same layout as used for the positions and faces by
+     * CUDAWrappers::MatrixFree, without the bits for the hanging edges in 3D
+     * which are not supported by this algorithm.
+     */
+    enum HangingNodeMaskBits : unsigned int
+    {
+      hanging_node_position_x = 1 << 0,
+      hanging_node_position_y = 1 << 1,
+      hanging_node_position_z = 1 << 2,
+      hanging_node_face_x     = 1 << 3,
+      hanging_node_face_y     = 1 << 4,
+      hanging_node_face_z     = 1 << 5
+    };
+
+
+
+    /**
+     * A class that sets up the data for handling hanging node constraints of
+     * continuous elements in MatrixFree by interpolation in the tensor
+     * product basis, as an alternative to resolving each constrained degree
+     * of freedom through the constraint pool of DoFInfo.
+     *
+     * On a cell with a hanging face, the degrees of freedom on that face are
+     * replaced by the degrees of freedom on the face of the parent cell at
+     * the same position in the lexicographic numbering, which are the
+     * unconstrained degrees of freedom the constrained ones are interpolated
+     * from. When reading vector entries, FEEvaluation then recovers the
+     * values on the hanging face by interpolating the values of the parent
+     * face to the child face, see apply_hanging_node_interpolation(), and
+     * the transpose operation is applied before distributing values into
+     * vectors. This requires storing neither the constraint weights nor the
+     * indices of the constrained degrees of freedom and gives the same
+     * access pattern as on cells without hanging nodes.
+     *
+     * The algorithm is applicable to FE_Q elements as well as systems of a
+     * single FE_Q base element, on DoFHandler objects with isotropic
+     * refinement. Cells with hanging edges in 3D that are not part of a
+     * hanging face, or cells whose constrained degrees of freedom are not
+     * all covered by the interpolation, keep the general algorithm.
+     */
+    template <int dim>
+    struct HangingNodes
+    {
+      /**
+       * Return whether the fast hanging node algorithm can be applied to the
+       * element @p fe.
+       */
+      static bool
+      is_supported(const FiniteElement<dim> &fe);
+
+      /**
+       * Compute the hanging node mask for the cell @p cell and replace the
+       * degrees of freedom on the hanging faces in @p dof_indices, given in
+       * the numbering of the cell's finite element, by the degrees of
+       * freedom of the parent's faces. If the cell has no hanging faces or
+       * its constraints cannot be represented by the mask, zero is returned
+       * and @p dof_indices is left untouched.
+       */
+      template <typename number>
+      static unsigned int
+      compute_mask_and_dof_indices(
+        const typename DoFHandler<dim>::active_cell_iterator &cell,
+        const AffineConstraints<number> &                     constraints,
+        std::vector<types::global_dof_index> &                dof_indices);
+    };
+
+
+
+    /**
+     * Apply the interpolation from the degrees of freedom of the parent's
+     * face to the hanging faces of a cell with the mask @p mask for the lane
+     * @p lane of an array of @p values in lexicographic numbering. The
+     * argument @p interpolation contains the 1D interpolation matrices from
+     * the parent's degrees of freedom to the lower and upper child, see
+     * ShapeInfo::hanging_node_interpolation, and @p original_values holds a
+     * copy of @p values before the call. If @p transpose is true, the
+     * transpose of the interpolation is applied, as needed before
+     * distributing the values into a vector.
+     */
+    template <int dim, typename VectorizedArrayType>
+    inline void
+    apply_hanging_node_interpolation(
+      const unsigned int                        n_dofs_1d,
+      const AlignedVector<VectorizedArrayType> *interpolation,
+      const unsigned int                        mask,
+      const unsigned int                        lane,
+      const bool                                transpose,
+      const VectorizedArrayType *               original_values,
+      VectorizedArrayType *                     values)
+    {
+      Assert(dim == 2 || dim == 3, ExcNotImplemented());
+      AssertDimension(interpolation[0].size(), n_dofs_1d * n_dofs_1d);
+      AssertDimension(interpolation[1].size(), n_dofs_1d * n_dofs_1d);
+
+      const unsigned int n_dofs = Utilities::fixed_power<dim>(n_dofs_1d);
+      const unsigned int strides[3] = {1, n_dofs_1d, n_dofs_1d * n_dofs_1d};
+
+      // the values on a hanging face are interpolated from the values on
+      // the same face in the tangential directions. positions on several
+      // hanging faces are only assigned to the first of them, which gives
+      // the same result because the interpolation is the identity on the
+      // shared edges
+      const auto find_face = [&](const unsigned int  index,
+                                 unsigned int (&position)[3]) {
+        for (unsigned int d = 0; d < dim; ++d)
+          position[d] = (index / strides[d]) % n_dofs_1d;
+        for (unsigned int d = 0; d < dim; ++d)
+          if ((mask & (hanging_node_face_x << d)) &&
+              position[d] ==
+                ((mask & (hanging_node_position_x << d)) ? n_dofs_1d - 1 : 0))
+            return d;
+        return numbers::invalid_unsigned_int;
+      };
+
+      if (transpose)
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          {
+            unsigned int position[3];
+            if (find_face(i, position) != numbers::invalid_unsigned_int)
+              values[i][lane] = 0;
+          }
+
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          unsigned int       position[3];
+          const unsigned int face = find_face(i, position);
+          if (face == numbers::invalid_unsigned_int)
+            continue;
+
+          const unsigned int t1 = (face + 1) % dim;
+          const unsigned int t2 = (face + 2) % dim;
+          const VectorizedArrayType *weights1 =
+            interpolation[(mask & (hanging_node_position_x << t1)) ? 1 : 0]
+              .begin() +
+            position[t1] * n_dofs_1d;
+          const unsigned int offset = i - position[t1] * strides[t1] -
+                                      (dim == 3 ? position[t2] * strides[t2] :
+                                                  0);
+
+          if (dim == 2)
+            {
+              if (transpose)
+                for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                  values[offset + j * strides[t1]][lane] +=
+                    weights1[j][0] * original_values[i][lane];
+              else
+                {
+                  typename VectorizedArrayType::value_type sum = 0;
+                  for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                    sum += weights1[j][0] *
+                           original_values[offset + j * strides[t1]][lane];
+                  values[i][lane] = sum;
+                }
+            }
+          else
+            {
+              const VectorizedArrayType *weights2 =
+                interpolation[(mask & (hanging_node_position_x << t2)) ? 1 :
+                                                                         0]
+                  .begin() +
+                position[t2] * n_dofs_1d;
+              if (transpose)
+                for (unsigned int k = 0; k < n_dofs_1d; ++k)
+                  for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                    values[offset + j * strides[t1] + k * strides[t2]][lane] +=
+                      weights1[j][0] * weights2[k][0] *
+                      original_values[i][lane];
+              else
+                {
+                  typename VectorizedArrayType::value_type sum = 0;
+                  for (unsigned int k = 0; k < n_dofs_1d; ++k)
+                    for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                      sum += weights1[j][0] * weights2[k][0] *
+                             original_values[offset + j * strides[t1] +
+                                             k * strides[t2]][lane];
+                  values[i][lane] = sum;
+                }
+            }
+        }
+    }
+
+
+
+    /* ----------------------- inline functions --------------------------- */
+
+    template <int dim>
+    inline bool
+    HangingNodes<dim>::is_supported(const FiniteElement<dim> &fe)
+    {
+      return dim > 1 && fe.n_base_elements() == 1 &&
+             dynamic_cast<const FE_Q<dim> *>(&fe.base_element(0)) != nullptr;
+    }
+
+
+
+    template <int dim>
+    template <typename number>
+    inline unsigned int
+    HangingNodes<dim>::compute_mask_and_dof_indices(
+      const typename DoFHandler<dim>::active_cell_iterator &cell,
+      const AffineConstraints<number> &                     constraints,
+      std::vector<types::global_dof_index> &                dof_indices)
+    {
+      if (dim == 1 || cell->level() == 0)
+        return 0;
+
+      const auto parent = cell->parent();
+      if (parent->refinement_case() !=
+          RefinementCase<dim>::isotropic_refinement)
+        return 0;
+
+      unsigned int child = 0;
+      for (; child < GeometryInfo<dim>::max_children_per_cell; ++child)
+        if (parent->child_index(child) == cell->index())
+          break;
+      Assert(child < GeometryInfo<dim>::max_children_per_cell,
+             ExcInternalError());
+
+      const FiniteElement<dim> &fe = cell->get_fe();
+      AssertDimension(dof_indices.size(), fe.dofs_per_cell);
+
+      std::vector<types::global_dof_index> resolved_indices(dof_indices);
+      std::vector<bool> on_hanging_face(fe.dofs_per_cell, false);
+      std::vector<types::global_dof_index> face_dof_indices(fe.dofs_per_face);
+
+      unsigned int mask = 0;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          // the child numbering of isotropic refinement is lexicographic
+          const unsigned int side = (child >> d) & 1;
+          const unsigned int face = 2 * d + side;
+          if (side == 1)
+            mask |= hanging_node_position_x << d;
+          if (cell->at_boundary(face) || !cell->neighbor_is_coarser(face))
+            continue;
+
+          mask |= hanging_node_face_x << d;
+          parent->face(face)->get_dof_indices(face_dof_indices);
+          for (unsigned int i = 0; i < fe.dofs_per_face; ++i)
+            {
+              const unsigned int index =
+                fe.face_to_cell_index(i,
+                                      face,
+                                      parent->face_orientation(face),
+                                      parent->face_flip(face),
+                                      parent->face_rotation(face));
+
+              // positions shared by two hanging faces must get the same
+              // index from both
+              if (on_hanging_face[index] &&
+                  resolved_indices[index] != face_dof_indices[i])
+                return 0;
+              on_hanging_face[index]  = true;
+              resolved_indices[index] = face_dof_indices[i];
+
+              // all replaced degrees of freedom must be constrained, since
+              // their values are recovered by the interpolation from the
+              // parent's face
+              if (resolved_indices[index] != dof_indices[index] &&
+                  !constraints.is_constrained(dof_indices[index]))
+                return 0;
+            }
+        }
+
+      if ((mask & (hanging_node_face_x | hanging_node_face_y |
+                   hanging_node_face_z)) == 0)
+        return 0;
+
+      // the remaining constraints, e.g. on hanging edges in 3D or periodic
+      // boundaries, are not covered by the interpolation. only constraints
+      // without entries, as for Dirichlet boundary conditions, can be
+      // resolved together with the interpolation
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        if (!on_hanging_face[i])
+          {
+            const auto *entries =
+              constraints.get_constraint_entries(dof_indices[i]);
+            if (entries != nullptr && entries->size() > 0)
+              return 0;
+          }
+
+      dof_indices.swap(resolved_indices);
+      return mask;
+    }
+  } // end of namespace MatrixFreeFunctions
+} // end of namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -18,6 +18,7 @@
 #define dealii_matrix_free_helper_functions_h
 
 
+#include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/memory_consumption.h>
@@ -27,5 +28,80 @@
 
 #include <deal.II/matrix_free/task_info.h>
 
+#include <type_traits>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    /**
+     * Convert a number of type @p Number2 to the type @p Number. This and the
+     * following functions are used to set up the data structures of a
+     * MatrixFree object from an existing one with a different number type.
+     */
+    template <typename Number, typename Number2>
+    inline typename std::enable_if<std::is_arithmetic<Number2>::value>::type
+    convert_number_type(const Number2 &in, Number &out)
+    {
+      out = static_cast<Number>(in);
+    }
+
+
+
+    /**
+     * Convert the entries of a VectorizedArray lane by lane. Both arrays must
+     * have the same number of lanes.
+     */
+    template <typename Number, int width, typename Number2, int width2>
+    inline void
+    convert_number_type(const VectorizedArray<Number2, width2> &in,
+                        VectorizedArray<Number, width> &        out)
+    {
+      static_assert(VectorizedArray<Number, width>::n_array_elements ==
+                      VectorizedArray<Number2, width2>::n_array_elements,
+                    "The number of lanes of the arrays must coincide.");
+      for (unsigned int v = 0;
+           v < VectorizedArray<Number, width>::n_array_elements;
+           ++v)
+        out[v] = in[v];
+    }
+
+
+
+    /**
+     * Convert the entries of a tensor, e.g. of a Jacobian stored in
+     * MappingInfo.
+     */
+    template <int rank, int dim, typename Number, typename Number2>
+    inline void
+    convert_number_type(const Tensor<rank, dim, Number2> &in,
+                        Tensor<rank, dim, Number> &       out)
+    {
+      for (unsigned int d = 0; d < dim; ++d)
+        convert_number_type(in[d], out[d]);
+    }
+
+
+
+    /**
+     * Convert all entries of an AlignedVector, resizing the output to the
+     * size of the input.
+     */
+    template <typename T, typename T2>
+    inline void
+    convert_number_type(const AlignedVector<T2> &in, AlignedVector<T> &out)
+    {
+      out.resize_fast(in.size());
+      for (std::size_t i = 0; i < in.size(); ++i)
+        convert_number_type(in[i], out[i]);
+    }
+  } // end of namespace MatrixFreeFunctions
+} // end of namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
 
 #endif
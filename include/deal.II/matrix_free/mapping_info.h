@@ -168,6 +168,23 @@ namespace internal
          * data evaluated on quadrature points to represent the correct order.
          */
         dealii::Table<2, unsigned int> face_orientations;
+
+        /**
+         * The values of the one-dimensional Lagrange polynomials in the
+         * points of MappingInfo::geometry_points, evaluated in the
+         * one-dimensional quadrature points, in the layout of
+         * ShapeInfo::shape_values. Only filled for cells in case the
+         * Jacobians on general cells are computed on the fly.
+         */
+        AlignedVector<Number> geometry_shape_values;
+
+        /**
+         * The derivatives of the one-dimensional Lagrange polynomials in
+         * the points of MappingInfo::geometry_points, evaluated in the
+         * one-dimensional quadrature points, in the same layout as @p
+         * geometry_shape_values.
+         */
+        AlignedVector<Number> geometry_shape_gradients;
       };
 
       /**
@@ -183,7 +200,10 @@ namespace internal
        * Stores the index offset into the arrays @p jxw_values, @p jacobians,
        * @p normal_vectors and the second derivatives. Note that affine cells
        * have shorter fields of length 1, where the others have lengths equal
-       * to the number of quadrature points of the given cell.
+       * to the number of quadrature points of the given cell. General cells
+       * whose Jacobians are computed on the fly from
+       * MappingInfo::geometry_points do not store any data in these arrays
+       * and have the offset numbers::invalid_unsigned_int.
        */
       AlignedVector<unsigned int> data_index_offsets;
 
@@ -286,6 +306,20 @@ namespace internal
        */
       std::size_t
       memory_consumption() const;
+
+      /**
+       * Fill the data fields of this class with the data of @p other, which
+       * has been computed for a different number type, converting the
+       * numbers lane by lane. This avoids the evaluation of the mapping for
+       * the new number type. The number of lanes of the two vectorized
+       * array types must coincide.
+       */
+      template <typename Number2, typename VectorizedArrayType2>
+      void
+      copy_from(const MappingInfoStorage<structdim,
+                                         spacedim,
+                                         Number2,
+                                         VectorizedArrayType2> &other);
     };
 
 
@@ -301,6 +335,11 @@ namespace internal
     template <int dim, typename Number, typename VectorizedArrayType>
     struct MappingInfo
     {
+      /**
+       * Constructor. Does nothing.
+       */
+      MappingInfo();
+
       /**
        * Compute the information in the given cells and faces. The cells are
        * specified by the level and the index within the level (as given by
@@ -308,6 +347,13 @@ namespace internal
        * for different kinds of iterators, e.g. standard DoFHandler,
        * multigrid, etc.)  on a fixed Triangulation. In addition, a mapping
        * and several quadrature formulas are given.
+       *
+       * If @p geometry_degree_on_the_fly is larger than zero, the general
+       * cells only store the positions of the points of a polynomial
+       * representation of this degree of the geometry in @p
+       * geometry_points, rather than the inverse Jacobians and JxW values
+       * in all quadrature points, unless second derivatives are requested
+       * in @p update_flags_cells.
        */
       void
       initialize(
@@ -318,9 +364,25 @@ namespace internal
         const Mapping<dim> &                           mapping,
         const std::vector<dealii::hp::QCollection<1>> &quad,
         const UpdateFlags                              update_flags_cells,
-        const UpdateFlags update_flags_boundary_faces,
-        const UpdateFlags update_flags_inner_faces,
-        const UpdateFlags update_flags_faces_by_cells);
+        const UpdateFlags  update_flags_boundary_faces,
+        const UpdateFlags  update_flags_inner_faces,
+        const UpdateFlags  update_flags_faces_by_cells,
+        const unsigned int geometry_degree_on_the_fly);
+
+      /**
+       * Recompute the geometry data for a new @p mapping on the same cells
+       * and faces, using the quadrature formulas and update flags of the
+       * last call to initialize(). This is used when only the position of
+       * the vertices or the mapping changes but not the topology, e.g. for
+       * MappingQEulerian or MappingFEField in moving mesh problems.
+       */
+      void
+      update_mapping(
+        const dealii::Triangulation<dim> &                        tria,
+        const std::vector<std::pair<unsigned int, unsigned int>> &cells,
+        const FaceInfo<VectorizedArrayType::n_array_elements> &   faces,
+        const std::vector<unsigned int> &active_fe_index,
+        const Mapping<dim> &             mapping);
 
       /**
        * Return the type of a given cell as detected during initialization.
@@ -334,6 +396,19 @@ namespace internal
       void
       clear();
 
+      /**
+       * Fill this object with the geometry data of @p other, which has been
+       * set up for a different number type, e.g., to create the mapping data
+       * in single precision for the levels of a mixed-precision multigrid
+       * method from the data in double precision. The data is converted
+       * entry by entry without evaluating the mapping again. The number of
+       * lanes of the two vectorized array types must coincide.
+       */
+      template <typename Number2, typename VectorizedArrayType2>
+      void
+      copy_from(
+        const MappingInfo<dim, Number2, VectorizedArrayType2> &other);
+
       /**
        * Return the memory consumption of this class in bytes.
        */
@@ -385,6 +460,69 @@ namespace internal
       std::vector<MappingInfoStorage<dim - 1, dim, Number, VectorizedArrayType>>
         face_data_by_cells;
 
+      /**
+       * The number of points per coordinate direction of the polynomial
+       * representation of the geometry of general cells in @p
+       * geometry_points, or zero if the inverse Jacobians and JxW values of
+       * all cells are stored in @p cell_data.
+       */
+      unsigned int n_geometry_points_1d;
+
+      /**
+       * The positions of the tensor product of @p n_geometry_points_1d
+       * Gauss-Lobatto points on the general cells, from which FEEvaluation
+       * computes the Jacobians in the quadrature points by sum
+       * factorization. For each cell batch, all points of the x coordinate
+       * come first in lexicographic ordering, then the points of the y
+       * coordinate, and so on.
+       *
+       * Indexed by @p geometry_points_offsets.
+       */
+      AlignedVector<VectorizedArrayType> geometry_points;
+
+      /**
+       * Stores the index offset of a cell batch into @p geometry_points, or
+       * numbers::invalid_unsigned_int for cells that are not general.
+       */
+      AlignedVector<unsigned int> geometry_points_offsets;
+
+      /**
+       * The quadrature formulas passed to the last call of initialize(),
+       * kept for update_mapping().
+       */
+      std::vector<dealii::hp::QCollection<1>> quadratures;
+
+      /**
+       * The update flags for the cells passed to the last call of
+       * initialize(), kept for update_mapping().
+       */
+      UpdateFlags update_flags_cells;
+
+      /**
+       * The update flags for the boundary faces passed to the last call of
+       * initialize(), kept for update_mapping().
+       */
+      UpdateFlags update_flags_boundary_faces;
+
+      /**
+       * The update flags for the inner faces passed to the last call of
+       * initialize(), kept for update_mapping().
+       */
+      UpdateFlags update_flags_inner_faces;
+
+      /**
+       * The update flags for the faces by cells passed to the last call of
+       * initialize(), kept for update_mapping().
+       */
+      UpdateFlags update_flags_faces_by_cells;
+
+      /**
+       * The degree of the geometry representation for the computation of
+       * the Jacobians on the fly passed to the last call of initialize(),
+       * kept for update_mapping().
+       */
+      unsigned int geometry_degree_on_the_fly;
+
       /**
        * Computes the information in the given cells, called within
        * initialize.
@@ -396,7 +534,20 @@ namespace internal
         const std::vector<unsigned int> &              active_fe_index,
         const Mapping<dim> &                           mapping,
         const std::vector<dealii::hp::QCollection<1>> &quad,
-        const UpdateFlags                              update_flags_cells);
+        const UpdateFlags                              update_flags_cells,
+        const unsigned int geometry_degree_on_the_fly);
+
+      /**
+       * Computes the positions of the points in @p geometry_points on the
+       * general cells and the shape data to evaluate the Jacobians from
+       * them, called within initialize_cells.
+       */
+      void
+      initialize_geometry_points(
+        const dealii::Triangulation<dim> &                        tria,
+        const std::vector<std::pair<unsigned int, unsigned int>> &cells,
+        const Mapping<dim> &                                      mapping,
+        const std::vector<dealii::hp::QCollection<1>> &           quad);
 
       /**
        * Computes the information in the given faces, called within
@@ -529,6 +680,62 @@ namespace internal
 
 
 
+    /**
+     * A class that is used to identify floating point arrays that are the
+     * same up to a given tolerance within a hash table, i.e., as the hash and
+     * key equality functions of a std::unordered_map. As opposed to
+     * FPArrayComparator, which compares the entries of two arrays with a
+     * tolerance, this class rounds each entry to an integer multiple of the
+     * tolerance and considers two arrays as equal if all rounded entries
+     * coincide. This gives a proper equivalence relation that is consistent
+     * with the hash value, at the price that two arrays within the tolerance
+     * but on different sides of a rounding boundary are considered
+     * different. This is not a problem for the compression of the geometry
+     * data, where it only results in a slightly larger storage.
+     */
+    template <typename Number,
+              typename VectorizedArrayType = VectorizedArray<Number>>
+    struct FPArrayHash
+    {
+      FPArrayHash(const Number scaling);
+
+      /**
+       * Compute the hash value of an array based on the rounded entries.
+       */
+      template <int rank, int dim>
+      std::size_t
+      operator()(
+        const Tensor<rank,
+                     dim,
+                     Tensor<1, VectorizedArrayType::n_array_elements, Number>>
+          &t) const;
+
+      /**
+       * Return whether the rounded entries of the two arrays coincide.
+       */
+      template <int rank, int dim>
+      bool
+      operator()(
+        const Tensor<rank,
+                     dim,
+                     Tensor<1, VectorizedArrayType::n_array_elements, Number>>
+          &t1,
+        const Tensor<rank,
+                     dim,
+                     Tensor<1, VectorizedArrayType::n_array_elements, Number>>
+          &t2) const;
+
+      /**
+       * Round the given number to an integer multiple of the tolerance.
+       */
+      Number
+      round(const Number value) const;
+
+      Number tolerance;
+    };
+
+
+
     /* ------------------- inline functions ----------------------------- */
 
     template <int structdim,
@@ -547,6 +754,57 @@ namespace internal
 
 
 
+    template <int structdim,
+              int spacedim,
+              typename Number,
+              typename VectorizedArrayType>
+    template <typename Number2, typename VectorizedArrayType2>
+    inline void
+    MappingInfoStorage<structdim, spacedim, Number, VectorizedArrayType>::
+      copy_from(const MappingInfoStorage<structdim,
+                                         spacedim,
+                                         Number2,
+                                         VectorizedArrayType2> &other)
+    {
+      static_assert(VectorizedArrayType::n_array_elements ==
+                      VectorizedArrayType2::n_array_elements,
+                    "The number of lanes of the arrays must coincide.");
+
+      descriptor.resize(other.descriptor.size());
+      for (unsigned int i = 0; i < descriptor.size(); ++i)
+        {
+          const auto &other_descriptor    = other.descriptor[i];
+          descriptor[i].n_q_points        = other_descriptor.n_q_points;
+          descriptor[i].quadrature        = other_descriptor.quadrature;
+          descriptor[i].face_orientations = other_descriptor.face_orientations;
+          for (unsigned int d = 0; d < structdim; ++d)
+            convert_number_type(other_descriptor.tensor_quadrature_weights[d],
+                                descriptor[i].tensor_quadrature_weights[d]);
+          convert_number_type(other_descriptor.quadrature_weights,
+                              descriptor[i].quadrature_weights);
+          convert_number_type(other_descriptor.geometry_shape_values,
+                              descriptor[i].geometry_shape_values);
+          convert_number_type(other_descriptor.geometry_shape_gradients,
+                              descriptor[i].geometry_shape_gradients);
+        }
+
+      data_index_offsets = other.data_index_offsets;
+      convert_number_type(other.JxW_values, JxW_values);
+      convert_number_type(other.normal_vectors, normal_vectors);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          convert_number_type(other.jacobians[i], jacobians[i]);
+          convert_number_type(other.jacobian_gradients[i],
+                              jacobian_gradients[i]);
+          convert_number_type(other.normals_times_jacobians[i],
+                              normals_times_jacobians[i]);
+        }
+      quadrature_point_offsets = other.quadrature_point_offsets;
+      convert_number_type(other.quadrature_points, quadrature_points);
+    }
+
+
+
     template <int dim, typename Number, typename VectorizedArrayType>
     inline GeometryType
     MappingInfo<dim, Number, VectorizedArrayType>::get_cell_type(
@@ -556,6 +814,41 @@ namespace internal
       return cell_type[cell_no];
     }
 
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    template <typename Number2, typename VectorizedArrayType2>
+    inline void
+    MappingInfo<dim, Number, VectorizedArrayType>::copy_from(
+      const MappingInfo<dim, Number2, VectorizedArrayType2> &other)
+    {
+      clear();
+
+      cell_type = other.cell_type;
+      face_type = other.face_type;
+
+      cell_data.resize(other.cell_data.size());
+      for (unsigned int i = 0; i < cell_data.size(); ++i)
+        cell_data[i].copy_from(other.cell_data[i]);
+      face_data.resize(other.face_data.size());
+      for (unsigned int i = 0; i < face_data.size(); ++i)
+        face_data[i].copy_from(other.face_data[i]);
+      face_data_by_cells.resize(other.face_data_by_cells.size());
+      for (unsigned int i = 0; i < face_data_by_cells.size(); ++i)
+        face_data_by_cells[i].copy_from(other.face_data_by_cells[i]);
+
+      n_geometry_points_1d = other.n_geometry_points_1d;
+      convert_number_type(other.geometry_points, geometry_points);
+      geometry_points_offsets = other.geometry_points_offsets;
+
+      quadratures                 = other.quadratures;
+      update_flags_cells          = other.update_flags_cells;
+      update_flags_boundary_faces = other.update_flags_boundary_faces;
+      update_flags_inner_faces    = other.update_flags_inner_faces;
+      update_flags_faces_by_cells = other.update_flags_faces_by_cells;
+      geometry_degree_on_the_fly  = other.geometry_degree_on_the_fly;
+    }
+
   } // end of namespace MatrixFreeFunctions
 } // end of namespace internal
 
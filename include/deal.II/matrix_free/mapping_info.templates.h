@@ -18,6 +18,9 @@
 
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
@@ -27,6 +30,10 @@
 
 #include <deal.II/matrix_free/mapping_info.h>
 
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -115,7 +122,9 @@ namespace internal
     {
       std::size_t memory = sizeof(this) + quadrature.memory_consumption() +
                            quadrature_weights.memory_consumption() +
-                           face_orientations.memory_consumption();
+                           face_orientations.memory_consumption() +
+                           geometry_shape_values.memory_consumption() +
+                           geometry_shape_gradients.memory_consumption();
       for (unsigned int d = 0; d < structdim; ++d)
         memory += tensor_quadrature_weights[d].memory_consumption();
       return memory;
@@ -208,6 +217,18 @@ namespace internal
 
     /* ------------------------ MappingInfo implementation ----------------- */
 
+    template <int dim, typename Number, typename VectorizedArrayType>
+    MappingInfo<dim, Number, VectorizedArrayType>::MappingInfo()
+      : n_geometry_points_1d(0)
+      , update_flags_cells(update_default)
+      , update_flags_boundary_faces(update_default)
+      , update_flags_inner_faces(update_default)
+      , update_flags_faces_by_cells(update_default)
+      , geometry_degree_on_the_fly(0)
+    {}
+
+
+
     template <int dim, typename Number, typename VectorizedArrayType>
     void
     MappingInfo<dim, Number, VectorizedArrayType>::clear()
@@ -217,6 +238,15 @@ namespace internal
       face_data_by_cells.clear();
       cell_type.clear();
       face_type.clear();
+      n_geometry_points_1d = 0;
+      geometry_points.clear();
+      geometry_points_offsets.clear();
+      quadratures.clear();
+      update_flags_cells          = update_default;
+      update_flags_boundary_faces = update_default;
+      update_flags_inner_faces    = update_default;
+      update_flags_faces_by_cells = update_default;
+      geometry_degree_on_the_fly  = 0;
     }
 
 
@@ -278,16 +308,29 @@ namespace internal
       const Mapping<dim> &                                      mapping,
       const std::vector<dealii::hp::QCollection<1>> &           quad,
       const UpdateFlags update_flags_cells,
-      const UpdateFlags update_flags_boundary_faces,
-      const UpdateFlags update_flags_inner_faces,
-      const UpdateFlags update_flags_faces_by_cells)
+      const UpdateFlags  update_flags_boundary_faces,
+      const UpdateFlags  update_flags_inner_faces,
+      const UpdateFlags  update_flags_faces_by_cells,
+      const unsigned int geometry_degree_on_the_fly)
     {
       clear();
 
+      this->quadratures                 = quad;
+      this->update_flags_cells          = update_flags_cells;
+      this->update_flags_boundary_faces = update_flags_boundary_faces;
+      this->update_flags_inner_faces    = update_flags_inner_faces;
+      this->update_flags_faces_by_cells = update_flags_faces_by_cells;
+      this->geometry_degree_on_the_fly  = geometry_degree_on_the_fly;
+
       // Could call these functions in parallel, but not useful because the
       // work inside is nicely split up already
-      initialize_cells(
-        tria, cells, active_fe_index, mapping, quad, update_flags_cells);
+      initialize_cells(tria,
+                       cells,
+                       active_fe_index,
+                       mapping,
+                       quad,
+                       update_flags_cells,
+                       geometry_degree_on_the_fly);
       initialize_faces(tria,
                        cells,
                        face_info.faces,
@@ -301,6 +344,36 @@ namespace internal
 
 
 
+    template <int dim, typename Number, typename VectorizedArrayType>
+    void
+    MappingInfo<dim, Number, VectorizedArrayType>::update_mapping(
+      const dealii::Triangulation<dim> &                        tria,
+      const std::vector<std::pair<unsigned int, unsigned int>> &cells,
+      const FaceInfo<VectorizedArrayType::n_array_elements> &   face_info,
+      const std::vector<unsigned int> &                         active_fe_index,
+      const Mapping<dim> &                                      mapping)
+    {
+      Assert(quadratures.size() > 0,
+             ExcMessage("The mapping data must have been initialized before "
+                        "the mapping can be updated."));
+
+      // make copies of the settings since initialize() clears them
+      const std::vector<dealii::hp::QCollection<1>> quad = quadratures;
+      initialize(tria,
+                 cells,
+                 face_info,
+                 active_fe_index,
+                 mapping,
+                 quad,
+                 update_flags_cells,
+                 update_flags_boundary_faces,
+                 update_flags_inner_faces,
+                 update_flags_faces_by_cells,
+                 geometry_degree_on_the_fly);
+    }
+
+
+
     /* ------------------------- initialization of cells ------------------- */
 
     // Namespace with implementation of extraction of values on cell
@@ -323,15 +396,21 @@ namespace internal
       struct CompressedCellData
       {
         CompressedCellData(const double expected_size)
-          : data(FPArrayComparator<Number, VectorizedArrayType>(expected_size))
+          : data(0,
+                 FPArrayHash<Number, VectorizedArrayType>(expected_size),
+                 FPArrayHash<Number, VectorizedArrayType>(expected_size))
         {}
 
-        std::map<
+        // Store the constant Jacobians in a hash table, which gives a
+        // constant cost for each lookup as opposed to the logarithmic cost of
+        // a std::map
+        std::unordered_map<
           Tensor<2,
                  dim,
                  Tensor<1, VectorizedArrayType::n_array_elements, Number>>,
           unsigned int,
-          FPArrayComparator<Number, VectorizedArrayType>>
+          FPArrayHash<Number, VectorizedArrayType>,
+          FPArrayHash<Number, VectorizedArrayType>>
           data;
       };
 
@@ -398,8 +477,8 @@ namespace internal
 
         cell_data.const_jac = Tensor<2, dim, VectorizedArrayType>();
 
-        // this should be the same value as used in HashValue::scaling (but we
-        // not have that field here)
+        // this should be the same value as used in FPArrayHash::tolerance (but
+        // we do not have that field here)
         const double zero_tolerance_double =
           cell_data.jac_size * std::numeric_limits<double>::epsilon() * 1024.;
         for (unsigned int j = 0; j < VectorizedArrayType::n_array_elements; ++j)
@@ -726,8 +805,8 @@ namespace internal
               unsigned int insert_position = data.first[my_q].JxW_values.size();
               // Cartesian/affine cell with constant Jacobians throughout the
               // cell. We need to store the data in another data field because
-              // std::map cannot store data based on VectorizedArray directly
-              // (alignment issue).
+              // std::unordered_map cannot store data based on VectorizedArray
+              // directly (alignment issue).
               if (mapping_info.cell_type[cell] <= affine)
                 {
                   if (my_q == 0)
@@ -762,9 +841,11 @@ namespace internal
 
               // general cell case: now go through all quadrature points and
               // collect the data. done for all different quadrature formulas,
-              // so do it outside the above loop.
+              // so do it outside the above loop. if the Jacobians are
+              // computed on the fly, general cells do not store anything here
               data.first[my_q].data_index_offsets.push_back(insert_position);
-              if (mapping_info.get_cell_type(cell) == general)
+              if (mapping_info.get_cell_type(cell) == general &&
+                  mapping_info.n_geometry_points_1d == 0)
                 {
                   for (unsigned int q = 0; q < n_q_points; ++q)
                     {
@@ -917,18 +998,14 @@ namespace internal
                             std::vector<unsigned int> &indices)
       {
         indices.resize(source.size());
-        typename CONTAINER::iterator lookup = destination.begin();
         for (typename CONTAINER::const_iterator it = source.begin();
              it != source.end();
              ++it)
           {
             typename CONTAINER::value_type entry = *it;
             entry.second                         = destination.size();
-            lookup = destination.insert(lookup, entry);
             AssertIndexRange(it->second, indices.size());
-            indices[it->second] = lookup->second;
-            // best guess for insert position of next item
-            ++lookup;
+            indices[it->second] = destination.insert(entry).first->second;
           }
       }
 
@@ -1020,7 +1097,8 @@ namespace internal
       const std::vector<unsigned int> &                         active_fe_index,
       const Mapping<dim> &                                      mapping,
       const std::vector<dealii::hp::QCollection<1>> &           quad,
-      const UpdateFlags update_flags_input)
+      const UpdateFlags  update_flags_input,
+      const unsigned int geometry_degree_on_the_fly)
     {
       const unsigned int n_quads = quad.size();
       const unsigned int n_cells = cells.size();
@@ -1036,6 +1114,13 @@ namespace internal
       // the mapping that are independent of the FE
       UpdateFlags update_flags = compute_update_flags(update_flags_input, quad);
 
+      // the second derivatives of the mapping are not available from the
+      // representation of the geometry, so only compute the Jacobians on the
+      // fly if they are not requested
+      if (geometry_degree_on_the_fly > 0 &&
+          !(update_flags & update_jacobian_grads))
+        n_geometry_points_1d = geometry_degree_on_the_fly + 1;
+
       for (unsigned int my_q = 0; my_q < n_quads; ++my_q)
         {
           const unsigned int n_hp_quads = quad[my_q].size();
@@ -1187,6 +1272,106 @@ namespace internal
           // ... wait for the parallel work to finish
           tasks.join_all();
         }
+
+      if (n_geometry_points_1d > 0)
+        initialize_geometry_points(tria, cells, mapping, quad);
+    }
+
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    void
+    MappingInfo<dim, Number, VectorizedArrayType>::initialize_geometry_points(
+      const dealii::Triangulation<dim> &                        tria,
+      const std::vector<std::pair<unsigned int, unsigned int>> &cells,
+      const Mapping<dim> &                                      mapping,
+      const std::vector<dealii::hp::QCollection<1>> &           quad)
+    {
+      const unsigned int n_points =
+        Utilities::fixed_power<dim>(n_geometry_points_1d);
+      const unsigned int n_macro_cells = cell_type.size();
+
+      // the general cells do not store any data in cell_data, so mark their
+      // offsets as invalid and enumerate them for the geometry points
+      geometry_points_offsets.resize(n_macro_cells,
+                                     numbers::invalid_unsigned_int);
+      std::size_t n_general_cells = 0;
+      for (unsigned int cell = 0; cell < n_macro_cells; ++cell)
+        if (cell_type[cell] == general)
+          {
+            geometry_points_offsets[cell] = n_general_cells * dim * n_points;
+            ++n_general_cells;
+            for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
+              cell_data[my_q].data_index_offsets[cell] =
+                numbers::invalid_unsigned_int;
+          }
+      AssertThrow(n_general_cells * dim * n_points <
+                    static_cast<std::size_t>(
+                      std::numeric_limits<unsigned int>::max()),
+                  ExcMessage(
+                    "Index overflow. Cannot fit data in 32 bit integers"));
+      geometry_points.resize_fast(n_general_cells * dim * n_points);
+
+      // the values and derivatives of the Lagrange polynomials in the
+      // Gauss-Lobatto points on the quadrature points of all formulas
+      const QGaussLobatto<1> points_1d(n_geometry_points_1d);
+      const std::vector<Polynomials::Polynomial<double>> lagrange =
+        Polynomials::generate_complete_Lagrange_basis(points_1d.get_points());
+      std::vector<double> values(2);
+      for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
+        for (unsigned int hpq = 0; hpq < cell_data[my_q].descriptor.size();
+             ++hpq)
+          {
+            auto &descriptor = cell_data[my_q].descriptor[hpq];
+            const unsigned int n_q_points_1d = quad[my_q][hpq].size();
+            descriptor.geometry_shape_values.resize_fast(n_geometry_points_1d *
+                                                         n_q_points_1d);
+            descriptor.geometry_shape_gradients.resize_fast(
+              n_geometry_points_1d * n_q_points_1d);
+            for (unsigned int i = 0; i < n_geometry_points_1d; ++i)
+              for (unsigned int q = 0; q < n_q_points_1d; ++q)
+                {
+                  lagrange[i].value(quad[my_q][hpq].point(q)[0], values);
+                  descriptor.geometry_shape_values[i * n_q_points_1d + q] =
+                    values[0];
+                  descriptor.geometry_shape_gradients[i * n_q_points_1d + q] =
+                    values[1];
+                }
+          }
+
+      // evaluate the positions of the points with the mapping. since we
+      // know the position of each cell batch in the array, we can work on
+      // the cells in parallel
+      const Quadrature<dim> quadrature(points_1d);
+      const unsigned int    vectorization_width =
+        VectorizedArrayType::n_array_elements;
+      parallel::apply_to_subranges(
+        0U,
+        n_macro_cells,
+        [&](const unsigned int begin, const unsigned int end) {
+          FE_Nothing<dim>       dummy_fe;
+          dealii::FEValues<dim> fe_values(mapping,
+                                          dummy_fe,
+                                          quadrature,
+                                          update_quadrature_points);
+          for (unsigned int cell = begin; cell < end; ++cell)
+            if (cell_type[cell] == general)
+              for (unsigned int v = 0; v < vectorization_width; ++v)
+                {
+                  const std::pair<unsigned int, unsigned int> &index =
+                    cells[cell * vectorization_width + v];
+                  typename dealii::Triangulation<dim>::cell_iterator cell_it(
+                    &tria, index.first, index.second);
+                  fe_values.reinit(cell_it);
+                  VectorizedArrayType *points =
+                    geometry_points.begin() + geometry_points_offsets[cell];
+                  for (unsigned int d = 0; d < dim; ++d)
+                    for (unsigned int q = 0; q < n_points; ++q)
+                      points[d * n_points + q][v] =
+                        fe_values.quadrature_point(q)[d];
+                }
+        },
+        8);
     }
 
 
@@ -1200,13 +1385,14 @@ namespace internal
       template <int dim, typename Number, typename VectorizedArrayType>
       struct CompressedFaceData
       {
-        // Constructor. As a scaling factor for the FPArrayComparator, we
-        // select the inverse of the Jacobian (not the Jacobian as in the
+        // Constructor. As a scaling factor for the FPArrayHash, we select the
+        // inverse of the Jacobian (not the Jacobian as in the
         // CompressedCellData) and add another factor of 512 to account for
         // some roundoff effects.
         CompressedFaceData(const Number jacobian_size)
-          : data(FPArrayComparator<Number, VectorizedArrayType>(512. /
-                                                                jacobian_size))
+          : data(0,
+                 FPArrayHash<Number, VectorizedArrayType>(512. / jacobian_size),
+                 FPArrayHash<Number, VectorizedArrayType>(512. / jacobian_size))
           , jacobian_size(jacobian_size)
         {}
 
@@ -1214,14 +1400,15 @@ namespace internal
         // the normal vector (dim entries), and the Jacobian determinant on
         // the face (first tensor) for each entry in the vectorized array
         // (inner tensor). We cannot choose a VectorizedArray type directly
-        // because std::map does not provide the necessary alignment upon
-        // memory allocation.
-        std::map<
+        // because std::unordered_map does not provide the necessary alignment
+        // upon memory allocation.
+        std::unordered_map<
           Tensor<1,
                  2 * dim * dim + dim + 1,
                  Tensor<1, VectorizedArrayType::n_array_elements, Number>>,
           unsigned int,
-          FPArrayComparator<Number, VectorizedArrayType>>
+          FPArrayHash<Number, VectorizedArrayType>,
+          FPArrayHash<Number, VectorizedArrayType>>
           data;
 
         // Store the scaling factor
@@ -2125,6 +2312,8 @@ namespace internal
     {
       std::size_t memory = MemoryConsumption::memory_consumption(cell_data);
       memory += MemoryConsumption::memory_consumption(face_data);
+      memory += MemoryConsumption::memory_consumption(geometry_points);
+      memory += MemoryConsumption::memory_consumption(geometry_points_offsets);
       memory += cell_type.capacity() * sizeof(GeometryType);
       memory += face_type.capacity() * sizeof(GeometryType);
       memory += sizeof(*this);
@@ -2148,6 +2337,14 @@ namespace internal
       task_info.print_memory_statistics(out,
                                         face_type.capacity() *
                                           sizeof(GeometryType));
+      if (n_geometry_points_1d > 0)
+        {
+          out << "    Geometry points:                 ";
+          task_info.print_memory_statistics(
+            out,
+            MemoryConsumption::memory_consumption(geometry_points) +
+              MemoryConsumption::memory_consumption(geometry_points_offsets));
+        }
       for (unsigned int j = 0; j < cell_data.size(); ++j)
         {
           out << "    Data component " << j << std::endl;
@@ -2254,6 +2451,86 @@ namespace internal
       return false;
     }
 
+
+
+    /* ------------------------------------------------------------------ */
+
+    template <typename Number, typename VectorizedArrayType>
+    FPArrayHash<Number, VectorizedArrayType>::FPArrayHash(const Number scaling)
+      : tolerance(scaling * std::numeric_limits<double>::epsilon() * 1024.)
+    {}
+
+
+
+    template <typename Number, typename VectorizedArrayType>
+    inline Number
+    FPArrayHash<Number, VectorizedArrayType>::round(const Number value) const
+    {
+      // add zero to turn a negative zero into a positive one, which gives
+      // the same hash value in any case
+      return std::round(value / tolerance) + Number();
+    }
+
+
+
+    template <typename Number, typename VectorizedArrayType>
+    template <int rank, int dim>
+    std::size_t
+    FPArrayHash<Number, VectorizedArrayType>::operator()(
+      const Tensor<rank,
+                   dim,
+                   Tensor<1, VectorizedArrayType::n_array_elements, Number>> &t)
+      const
+    {
+      using TensorType =
+        Tensor<rank,
+               dim,
+               Tensor<1, VectorizedArrayType::n_array_elements, Number>>;
+      const std::hash<Number> hasher;
+      std::size_t             hash = 0;
+      for (unsigned int i = 0; i < TensorType::n_independent_components; ++i)
+        {
+          const Tensor<1, VectorizedArrayType::n_array_elements, Number>
+            &entry = t[TensorType::unrolled_to_component_indices(i)];
+          for (unsigned int k = 0; k < VectorizedArrayType::n_array_elements;
+               ++k)
+            hash ^= hasher(round(entry[k])) + 0x9e3779b9 + (hash << 6) +
+                    (hash >> 2);
+        }
+      return hash;
+    }
+
+
+
+    template <typename Number, typename VectorizedArrayType>
+    template <int rank, int dim>
+    bool
+    FPArrayHash<Number, VectorizedArrayType>::operator()(
+      const Tensor<rank,
+                   dim,
+                   Tensor<1, VectorizedArrayType::n_array_elements, Number>>
+        &t1,
+      const Tensor<rank,
+                   dim,
+                   Tensor<1, VectorizedArrayType::n_array_elements, Number>>
+        &t2) const
+    {
+      using TensorType =
+        Tensor<rank,
+               dim,
+               Tensor<1, VectorizedArrayType::n_array_elements, Number>>;
+      for (unsigned int i = 0; i < TensorType::n_independent_components; ++i)
+        {
+          const TableIndices<rank> indices =
+            TensorType::unrolled_to_component_indices(i);
+          for (unsigned int k = 0; k < VectorizedArrayType::n_array_elements;
+               ++k)
+            if (round(t1[indices][k]) != round(t2[indices][k]))
+              return false;
+        }
+      return true;
+    }
+
   } // end of namespace MatrixFreeFunctions
 } // end of namespace internal
 
@@ -46,6 +46,7 @@
 #include <deal.II/matrix_free/task_info.h>
 #include <deal.II/matrix_free/type_traits.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <limits>
 #include <list>
@@ -54,6 +55,11 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+#ifndef DOXYGEN
+class MemoryReport;
+#endif
+
 
 
 /**
@@ -157,7 +163,8 @@ public:
    * simultaneously is to be found, the mapping needs not be
    * initialized. Likewise, if the mapping has changed from one iteration to
    * the next but the topology has not (like when using a deforming mesh with
-   * MappingQEulerian), it suffices to initialize the mapping only.
+   * MappingQEulerian), it suffices to initialize the mapping only, which is
+   * most efficiently done by MatrixFree::update_mapping().
    *
    * The two parameters `cell_vectorization_categories` and
    * `cell_vectorization_categories_strict` control the formation of batches
@@ -224,7 +231,10 @@ public:
       const bool         initialize_mapping  = true,
       const bool         overlap_communication_computation    = true,
       const bool         hold_all_faces_to_owned_cells        = false,
-      const bool         cell_vectorization_categories_strict = false)
+      const bool         cell_vectorization_categories_strict = false,
+      const unsigned int geometry_degree_on_the_fly           = 0,
+      const bool         use_fast_hanging_node_algorithm      = false,
+      const bool         store_constraint_inhomogeneities     = false)
       : tasks_parallel_scheme(tasks_parallel_scheme)
       , tasks_block_size(tasks_block_size)
       , mapping_update_flags(mapping_update_flags)
@@ -239,6 +249,9 @@ public:
       , hold_all_faces_to_owned_cells(hold_all_faces_to_owned_cells)
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
+      , geometry_degree_on_the_fly(geometry_degree_on_the_fly)
+      , use_fast_hanging_node_algorithm(use_fast_hanging_node_algorithm)
+      , store_constraint_inhomogeneities(store_constraint_inhomogeneities)
     {}
 
     /**
@@ -356,10 +369,11 @@ public:
      * example for block-Jacobi methods where the full operator to a cell
      * including its faces are evaluated. This data is accessed by
      * <code>FEFaceEvaluation::reinit(cell_batch_index,
-     * face_number)</code>. However, currently no coupling terms to neighbors
-     * can be computed with this approach because the neighbors are not laid
-     * out by the VectorizedArray data layout with an
-     * array-of-struct-of-array-type data structures.
+     * face_number)</code>. Since the neighbors are not laid out by the
+     * VectorizedArray data layout with an array-of-struct-of-array-type data
+     * structures, they are accessed lane by lane by an FEFaceEvaluation
+     * object for the exterior side, providing the values of the neighbors
+     * for coupling terms as in MatrixFree::loop_cell_centric().
      *
      * Note that you should only compute this data field in case you really
      * need it as it more than doubles the memory required by the mapping data
@@ -422,6 +436,24 @@ public:
      * the fabric, it may be faster to not overlap and wait for the data to
      * arrive. The default is true, i.e., communication and computation are
      * overlapped.
+     *
+     * When this option is enabled and the program runs on more than one MPI
+     * process, the cell batches are split into three groups during
+     * reinit(): The batches with at least one cell that accesses vector
+     * entries owned by another process (as determined by the
+     * Utilities::MPI::Partitioner of the respective DoFHandler) and two
+     * groups of interior batches that only access locally owned
+     * entries. Interior cells adjacent to the group with remote access are
+     * placed in the first interior group for better data locality. The
+     * loops cell_loop() and loop() then call update_ghost_values_start() on
+     * the source vector, work on the first interior group, call
+     * update_ghost_values_finish(), work on the batches with remote access,
+     * call compress_start() on the destination vector, and work on the
+     * second interior group before calling compress_finish(). Thus, each of
+     * the two exchanges is hidden behind roughly half of the interior cell
+     * work. If the option is disabled, all cells are put into the group with
+     * remote access, i.e., the exchange is completed before any cell work is
+     * done.
      */
     bool overlap_communication_computation;
 
@@ -462,6 +494,67 @@ public:
      * them in a single vectorized array.
      */
     bool cell_vectorization_categories_strict;
+
+    /**
+     * On general, i.e., curved, cells, MatrixFree by default stores the
+     * inverse Jacobian and the JxW value on every quadrature point, which
+     * for higher polynomial degrees can take more memory and memory
+     * bandwidth than the solution vector itself. If this field is set to a
+     * value larger than zero, only the positions of the $(p+1)^d$
+     * Gauss-Lobatto points of a polynomial representation of degree $p$
+     * equal to this value are stored for each general cell, and
+     * FEEvaluation::reinit() computes the Jacobians in the quadrature points
+     * from them by sum factorization. On Cartesian and affine cells,
+     * nothing changes. For a MappingQGeneric of degree $p$, the
+     * representation is exact if this value is at least $p$. The default
+     * value is zero, i.e., all data is stored.
+     *
+     * This option is ignored if second derivatives are requested in @p
+     * mapping_update_flags, since those need the derivatives of the
+     * Jacobians, and it does not affect the data on faces.
+     */
+    unsigned int geometry_degree_on_the_fly;
+
+    /**
+     * By default, the hanging node constraints of continuous elements on
+     * adaptively refined meshes are resolved like all other constraints,
+     * i.e., each constrained degree of freedom is expressed through the
+     * weights stored in a pool of constraints and the indices of the
+     * degrees of freedom it depends on. If this option is enabled, cells
+     * with hanging faces instead store the degrees of freedom of their
+     * parent's faces together with a small bit mask describing the hanging
+     * node configuration, and FEEvaluation::read_dof_values() and
+     * FEEvaluation::distribute_local_to_global() apply the interpolation
+     * from the parent's face in the tensor product basis. This reduces both
+     * the memory for indices and the number of indirect vector accesses on
+     * adaptively refined meshes.
+     *
+     * The option applies to DoFHandler objects with FE_Q elements or
+     * systems with a single FE_Q base element on the active cells, and
+     * requires @p store_plain_indices. It is ignored if face integrals are
+     * requested via the face update flags, since FEFaceEvaluation does not
+     * apply the interpolation. Cells whose constraints cannot be handled
+     * this way, such as cells with hanging edges in 3D that are not part of
+     * a hanging face, keep the general algorithm. It is the responsibility
+     * of the user to pass an AffineConstraints object that contains the
+     * hanging node constraints, as usual.
+     */
+    bool use_fast_hanging_node_algorithm;
+
+    /**
+     * Controls whether the inhomogeneities of the constraints passed to the
+     * reinit() function are stored alongside the constraint weights. If this
+     * flag is set, FEEvaluationBase::read_dof_values_with_inhomogeneities()
+     * adds the inhomogeneities to the values of the constrained degrees of
+     * freedom while reading from a vector, which allows to evaluate the
+     * residual of a problem with inhomogeneous Dirichlet conditions without
+     * an additional vector holding the boundary values. Degrees of freedom
+     * that are identity-constrained to another one with a non-zero
+     * inhomogeneity are then treated as general constraints. The default
+     * value is false, which ignores the inhomogeneities as in the
+     * distributed case of AffineConstraints::distribute_local_to_global().
+     */
+    bool store_constraint_inhomogeneities;
   };
 
   /**
@@ -612,6 +705,23 @@ public:
          const QuadratureType &                                 quad,
          const AdditionalData &additional_data = AdditionalData());
 
+  /**
+   * Recompute the geometry data for the given @p mapping, keeping the index
+   * data, the partitioning of cells and faces, and the schedule of the last
+   * call to reinit(). The quadrature formulas and update flags of that call
+   * are used again. This is intended for problems where the mesh moves but
+   * its topology does not change, such as ALE methods or shape
+   * optimization with MappingQEulerian or MappingFEField, and is
+   * considerably cheaper than a call to reinit() with
+   * AdditionalData::initialize_indices set to false, as it does not
+   * recompute the shape function data either.
+   *
+   * @note The mapping must have been initialized in the last call to
+   * reinit(), i.e., AdditionalData::initialize_mapping must have been set.
+   */
+  void
+  update_mapping(const Mapping<dim> &mapping);
+
   /**
    * Copy function. Creates a deep copy of all data structures. It is usually
    * enough to keep the data for different operations once, so this function
@@ -621,6 +731,34 @@ public:
   copy_from(
     const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free_base);
 
+  /**
+   * Initialize this object from @p matrix_free_base, an object that has been
+   * set up for the same DoFHandler objects and quadrature formulas but with
+   * a different number type. The index data, the partitioning of cells and
+   * faces, and the schedule are copied, and the geometry data and the shape
+   * functions are converted entry by entry to the number type of this
+   * object. This is much cheaper than a call to reinit(), which evaluates
+   * the mapping on all cells and faces again, and is intended for the
+   * creation of the single-precision operators of a mixed-precision
+   * multigrid preconditioner from the double-precision ones:
+   * @code
+   * MatrixFree<dim, double> matrix_free;
+   * matrix_free.reinit(mapping, dof_handler, constraints, quadrature, data);
+   *
+   * MatrixFree<dim, float, VectorizedArray<float, 4>> matrix_free_float;
+   * matrix_free_float.copy_from(matrix_free);
+   * @endcode
+   *
+   * The data is stored in batches of cells and faces, so the number of lanes
+   * of the two vectorized array types must coincide. With AVX, for
+   * instance, `VectorizedArray<float, 4>` is to be combined with the default
+   * `VectorizedArray<double>` of four lanes.
+   */
+  template <typename OtherNumber, typename OtherVectorizedArrayType>
+  void
+  copy_from(const MatrixFree<dim, OtherNumber, OtherVectorizedArrayType>
+              &matrix_free_base);
+
   /**
    * Clear all data fields and brings the class into a condition similar to
    * after having called the default constructor.
@@ -802,6 +940,153 @@ public:
             const InVector &src,
             const bool      zero_dst_vector = false) const;
 
+  /**
+   * This function is similar to the cell_loop with an std::function object
+   * to specify the operation to be performed on cells, but adds two
+   * additional functors to execute some additional work before and after
+   * the cell integrals are computed.
+   *
+   * The two additional functors work on a range of degrees of freedom,
+   * expressed in terms of the degree-of-freedom numbering of the selected
+   * DoFHandler `dof_handler_index_pre_post` in MPI-local indices. The
+   * arguments to the functors represent a range of degrees of freedom at a
+   * granularity of DoFInfo::chunk_size_zero_vector entries (except for the
+   * last chunk which is set to the number of locally owned entries) in the
+   * form `[first, last)`. The idea of these functors is to bring operations
+   * on vectors closer to the point where they are accessed in a matrix-free
+   * loop, with the goal to increase cache hits by temporal locality. This
+   * loop guarantees that the `operation_before_loop` hits all relevant
+   * unknowns before they are first touched in the cell_operation (including
+   * the MPI data exchange), allowing to execute some vector update that the
+   * `src` vector depends upon. The `operation_after_loop` is similar - it
+   * starts to execute on a range of DoFs once all DoFs in that range have
+   * been touched for the last time by the `cell_operation` (including the
+   * MPI data exchange), allowing e.g. to compute some vector operations that
+   * depend on the result of the current cell loop in `dst` or want to modify
+   * `src`. The efficiency of caching depends on the numbering of the degrees
+   * of freedom because of the granularity of the ranges, see
+   * DoFRenumbering::matrix_free_data_locality().
+   *
+   * The entries that are sent to or received from other MPI processes are
+   * processed by `operation_before_loop` before the ghost exchange of `src`
+   * is started and by `operation_after_loop` after the compress operation
+   * on `dst` has finished. When the loop is run with threads (i.e.,
+   * AdditionalData::tasks_parallel_scheme is not set to
+   * AdditionalData::none), the two operations are not scheduled within the
+   * loop but executed on the full range of locally owned degrees of freedom
+   * before and after the loop, respectively.
+   *
+   * @param cell_operation Pointer to member function of `CLASS` with the
+   * signature <tt>cell_operation (const MatrixFree<dim,Number> &, OutVector &,
+   * InVector &, std::pair<unsigned int,unsigned int> &)</tt> where the first
+   * argument passes the data of the calling class and the last argument
+   * defines the range of cells which should be worked on (typically more than
+   * one cell should be worked on in order to reduce overheads).
+   *
+   * @param owning_class The object which provides the `cell_operation`
+   * call. To be compatible with this interface, the class must allow to call
+   * `owning_class->cell_operation(...)`.
+   *
+   * @param dst Destination vector holding the result. If the vector is of
+   * type LinearAlgebra::distributed::Vector (or composite objects thereof
+   * such as LinearAlgebra::distributed::BlockVector), the loop calls
+   * LinearAlgebra::distributed::Vector::compress() at the end of the call
+   * internally. For other vectors, including parallel Trilinos or PETSc
+   * vectors, no such call is issued. Note that Trilinos/Epetra or PETSc
+   * vectors do currently not work in parallel because the present class uses
+   * MPI-local index addressing, as opposed to the global addressing implied
+   * by those external libraries.
+   *
+   * @param src Input vector. If the vector is of type
+   * LinearAlgebra::distributed::Vector (or composite objects thereof such as
+   * LinearAlgebra::distributed::BlockVector), the loop calls
+   * LinearAlgebra::distributed::Vector::update_ghost_values() at the start of
+   * the call internally to make sure all necessary data is locally
+   * available. Note, however, that the vector is reset to its original state
+   * at the end of the loop, i.e., if the vector was not ghosted upon entry of
+   * the loop, it will not be ghosted upon finishing the loop.
+   *
+   * @param operation_before_loop This functor can be used to perform an
+   * operation on entries of the `src` and `dst` vectors (or other vectors)
+   * before the operation on cells first touches a particular DoF according
+   * to the general description in the text above. This function is passed a
+   * range of the locally owned degrees of freedom on the selected
+   * `dof_handler_index_pre_post` (in MPI-local index numbering).
+   *
+   * @param operation_after_loop This functor can be used to perform an
+   * operation on entries of the `src` and `dst` vectors (or other vectors)
+   * after the operation on cells last touches a particular DoF according to
+   * the general description in the text above. This function is passed a
+   * range of the locally owned degrees of freedom on the selected
+   * `dof_handler_index_pre_post` (in MPI-local index numbering).
+   *
+   * @param dof_handler_index_pre_post Since MatrixFree can be initialized
+   * with a vector of DoFHandler objects, each of them will in general have
+   * vector sizes and thus different ranges returned to
+   * `operation_before_loop` and `operation_after_loop`. Use this variable to
+   * specify which one of the DoFHandler objects the index range should be
+   * associated to. Defaults to the `dof_handler_index` 0.
+   *
+   * @note The close locality of the `operation_before_loop` and
+   * `operation_after_loop` is currently only implemented for the MPI-only
+   * case. In case threading is enabled, the complete `operation_before_loop`
+   * is scheduled before the parallel loop, and `operation_after_loop` is
+   * scheduled strictly afterwards, due to the complicated dependencies.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  cell_loop(void (CLASS::*cell_operation)(
+              const MatrixFree &,
+              OutVector &,
+              const InVector &,
+              const std::pair<unsigned int, unsigned int> &) const,
+            const CLASS *   owning_class,
+            OutVector &     dst,
+            const InVector &src,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &operation_before_loop,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &                operation_after_loop,
+            const unsigned int dof_handler_index_pre_post = 0) const;
+
+  /**
+   * Same as above, but for class member functions which are non-const.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  cell_loop(void (CLASS::*cell_operation)(
+              const MatrixFree &,
+              OutVector &,
+              const InVector &,
+              const std::pair<unsigned int, unsigned int> &),
+            CLASS *         owning_class,
+            OutVector &     dst,
+            const InVector &src,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &operation_before_loop,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &                operation_after_loop,
+            const unsigned int dof_handler_index_pre_post = 0) const;
+
+  /**
+   * Same as above, but taking an `std::function` as the `cell_operation`
+   * rather than a class member function.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  cell_loop(const std::function<void(
+              const MatrixFree<dim, Number, VectorizedArrayType> &,
+              OutVector &,
+              const InVector &,
+              const std::pair<unsigned int, unsigned int> &)> &cell_operation,
+            OutVector &                                        dst,
+            const InVector &                                   src,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &operation_before_loop,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &                operation_after_loop,
+            const unsigned int dof_handler_index_pre_post = 0) const;
+
   /**
    * This method runs a loop over all cells (in parallel) and performs the MPI
    * data exchange on the source vector and destination vector. As opposed to
@@ -1042,6 +1327,93 @@ public:
        const DataAccessOnFaces src_vector_face_access =
          DataAccessOnFaces::unspecified) const;
 
+  /**
+   * This method runs a loop over all cells (in parallel) where the
+   * integrals over the faces of each cell are computed together with the
+   * integral over its interior, as opposed to loop() which runs separate
+   * loops over cells, interior faces, and boundary faces that all access
+   * the vector entries of the two cells adjacent to a face. Within the
+   * @p cell_operation, the faces of a cell batch are visited by
+   * FEFaceEvaluation::reinit(cell_batch_number, face_number): An
+   * FEFaceEvaluation object for the interior side gives access to the
+   * present cells, and an object for the exterior side (constructed with
+   * `is_interior_face = false`) reads the values of the neighbors through
+   * the faces on the fly. Since the face integrals are only accumulated into
+   * the degrees of freedom of the cells of the current batch, the operation
+   * never writes into the entries of neighboring cells. This avoids the
+   * write conflicts of a face-based loop, making the scheme attractive for
+   * explicit time integration of discontinuous Galerkin methods, and
+   * roughly halves the memory transfer because each cell's entries of @p
+   * dst are written only once, at the price of computing each interior face
+   * integral twice, once from either side.
+   *
+   * The MatrixFree object must have been set up with
+   * AdditionalData::hold_all_faces_to_owned_cells set to true, such that the
+   * neighbors behind all faces of the locally owned cells are available,
+   * and with suitable AdditionalData::mapping_update_flags_faces_by_cells.
+   * The source vector is updated with the full set of ghost entries, and
+   * the destination vector is not subject to a compress operation across
+   * processors because no entries of other processors are written.
+   *
+   * @param cell_operation `std::function` with the signature
+   * <tt>cell_operation (const MatrixFree<dim,Number> &, OutVector &,
+   * InVector &, std::pair<unsigned int,unsigned int> &)</tt> as in
+   * cell_loop(), which computes the cell and face integrals of the given
+   * range of cell batches.
+   *
+   * @param dst Destination vector holding the result. See cell_loop() for
+   * details.
+   *
+   * @param src Input vector. See cell_loop() for details.
+   *
+   * @param zero_dst_vector If this flag is set to `true`, the vector `dst`
+   * will be set to zero inside the loop. See cell_loop() for details.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  loop_cell_centric(
+    const std::function<void(
+      const MatrixFree<dim, Number, VectorizedArrayType> &,
+      OutVector &,
+      const InVector &,
+      const std::pair<unsigned int, unsigned int> &)> &cell_operation,
+    OutVector &                                        dst,
+    const InVector &                                   src,
+    const bool zero_dst_vector = false) const;
+
+  /**
+   * Same as above, but for a member function of class @p CLASS with the
+   * signature <tt>cell_operation (const MatrixFree<dim,Number> &,
+   * OutVector &, InVector &, std::pair<unsigned int,unsigned int> &)
+   * const</tt>, called on @p owning_class.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  loop_cell_centric(void (CLASS::*cell_operation)(
+                      const MatrixFree &,
+                      OutVector &,
+                      const InVector &,
+                      const std::pair<unsigned int, unsigned int> &) const,
+                    const CLASS *   owning_class,
+                    OutVector &     dst,
+                    const InVector &src,
+                    const bool      zero_dst_vector = false) const;
+
+  /**
+   * Same as above, but for class member functions which are non-const.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  loop_cell_centric(void (CLASS::*cell_operation)(
+                      const MatrixFree &,
+                      OutVector &,
+                      const InVector &,
+                      const std::pair<unsigned int, unsigned int> &),
+                    CLASS *         owning_class,
+                    OutVector &     dst,
+                    const InVector &src,
+                    const bool      zero_dst_vector = false) const;
+
   /**
    * In the hp adaptive case, a subrange of cells as computed during the cell
    * loop might contain elements of different degrees. Use this function to
@@ -1066,6 +1438,52 @@ public:
     const unsigned int                           fe_index,
     const unsigned int                           dof_handler_index = 0) const;
 
+  /**
+   * In the hp adaptive case, split the given range of cell batches into the
+   * subranges of the individual polynomial degrees between @p min_degree and
+   * @p max_degree as computed by create_cell_subrange_hp() and call
+   * @p operation on each non-empty subrange. The degree is passed to
+   * @p operation as a compile-time constant of type
+   * <tt>std::integral_constant<int, degree></tt>, which allows to select the
+   * FEEvaluation object with the sum factorization kernels for exactly that
+   * degree. FEEvaluation detects the active FE index from the degree given
+   * as template argument, so no further information needs to be passed to
+   * it. Since the cells are grouped by their active FE index upon
+   * initialization, each range of the cell loop contains at most a few
+   * different degrees. A typical use in a cell operation looks as follows:
+   * @code
+   * void
+   * LaplaceOperator::local_apply(
+   *   const MatrixFree<dim, double> &                  data,
+   *   VectorType &                                     dst,
+   *   const VectorType &                               src,
+   *   const std::pair<unsigned int, unsigned int> &cell_range) const
+   * {
+   *   data.template apply_by_fe_degree<1, 6>(
+   *     cell_range,
+   *     [&](auto degree, const std::pair<unsigned int, unsigned int> &range) {
+   *       FEEvaluation<dim, decltype(degree)::value> phi(data);
+   *       for (unsigned int cell = range.first; cell < range.second; ++cell)
+   *         {
+   *           phi.reinit(cell);
+   *           ...
+   *         }
+   *     });
+   * }
+   * @endcode
+   * With C++11, where lambdas cannot be generic, a class with a templated
+   * <tt>operator()(std::integral_constant<int, degree>, const
+   * std::pair<unsigned int, unsigned int> &)</tt> can be used instead.
+   *
+   * All cells in @p range must have a degree between @p min_degree and
+   * @p max_degree, which is checked in debug mode.
+   */
+  template <int min_degree, int max_degree, typename Operation>
+  void
+  apply_by_fe_degree(const std::pair<unsigned int, unsigned int> &range,
+                     const Operation &                            operation,
+                     const unsigned int dof_handler_index = 0) const;
+
   //@}
 
   /**
@@ -1287,6 +1705,19 @@ public:
   get_faces_by_cells_boundary_id(const unsigned int macro_cell,
                                  const unsigned int face_number) const;
 
+  /**
+   * Return the indices of the faces within a cell, using the cells' sorting
+   * by lanes in the VectorizedArray. The index of a face is given as
+   * `face_batch_number * VectorizedArrayType::n_array_elements + lane`
+   * with respect to get_face_info(). Lanes whose face is not held by this
+   * class, e.g. because it is processed by another MPI process and
+   * AdditionalData::hold_all_faces_to_owned_cells is not set, are marked by
+   * numbers::invalid_unsigned_int.
+   */
+  std::array<unsigned int, VectorizedArrayType::n_array_elements>
+  get_faces_by_cells_face_index(const unsigned int macro_cell,
+                                const unsigned int face_number) const;
+
   /**
    * Return the DoFHandler with the index as given to the respective
    * `std::vector` argument in the reinit() function.
@@ -1294,6 +1725,14 @@ public:
   const DoFHandler<dim> &
   get_dof_handler(const unsigned int dof_handler_index = 0) const;
 
+  /**
+   * Return the multigrid level this object was set up for, given by
+   * AdditionalData::level_mg_handler, or numbers::invalid_unsigned_int if
+   * it works on the active cells.
+   */
+  unsigned int
+  get_mg_level() const;
+
   /**
    * Return the cell iterator in deal.II speak to a given cell in the
    * renumbering of this structure.
@@ -1448,11 +1887,23 @@ public:
 
   /**
    * Return an approximation of the memory consumption of this class in
-   * bytes.
+   * bytes, which is the sum of the entries added by
+   * add_memory_consumption().
    */
   std::size_t
   memory_consumption() const;
 
+  /**
+   * Add the memory consumption of this class to @p report, split into the
+   * DoFInfo objects of the individual DoFHandler objects, the MappingInfo,
+   * the ShapeInfo, the FaceInfo, the TaskInfo, the constraint pool, the cell
+   * indices, and the scratch data of the evaluation objects, with @p name as
+   * prefix of the entries.
+   */
+  void
+  add_memory_consumption(MemoryReport &     report,
+                         const std::string &name = "MatrixFree") const;
+
   /**
    * Prints a detailed summary of memory consumption in the different
    * structures of this class to the given output stream.
@@ -1773,6 +2224,10 @@ private:
    */
   mutable std::list<std::pair<bool, AlignedVector<Number>>>
     scratch_pad_non_threadsafe;
+
+  // the conversion from other number types needs to access the data fields
+  template <int, typename, typename>
+  friend class MatrixFree;
 };
 
 
@@ -1831,6 +2286,52 @@ MatrixFree<dim, Number, VectorizedArrayType>::get_constrained_dofs(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OtherNumber, typename OtherVectorizedArrayType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::copy_from(
+  const MatrixFree<dim, OtherNumber, OtherVectorizedArrayType> &v)
+{
+  static_assert(VectorizedArrayType::n_array_elements ==
+                  OtherVectorizedArrayType::n_array_elements,
+                "The cell and face batches can only be shared between "
+                "vectorized array types with the same number of lanes.");
+
+  clear();
+  dof_handlers.dof_handler    = v.dof_handlers.dof_handler;
+  dof_handlers.hp_dof_handler = v.dof_handlers.hp_dof_handler;
+  dof_handlers.active_dof_handler =
+    v.dof_handlers.active_dof_handler ==
+        MatrixFree<dim, OtherNumber, OtherVectorizedArrayType>::DoFHandlers::
+          usual ?
+      DoFHandlers::usual :
+      DoFHandlers::hp;
+  dof_handlers.n_dof_handlers = v.dof_handlers.n_dof_handlers;
+  dof_handlers.level          = v.dof_handlers.level;
+
+  dof_info = v.dof_info;
+  constraint_pool_data.assign(v.constraint_pool_data.begin(),
+                              v.constraint_pool_data.end());
+  constraint_pool_row_index = v.constraint_pool_row_index;
+  mapping_info.copy_from(v.mapping_info);
+
+  shape_info.reinit(v.shape_info.size());
+  for (unsigned int i = 0; i < shape_info.size(0); ++i)
+    for (unsigned int j = 0; j < shape_info.size(1); ++j)
+      for (unsigned int k = 0; k < shape_info.size(2); ++k)
+        for (unsigned int l = 0; l < shape_info.size(3); ++l)
+          shape_info(i, j, k, l).copy_from(v.shape_info(i, j, k, l));
+
+  cell_level_index           = v.cell_level_index;
+  cell_level_index_end_local = v.cell_level_index_end_local;
+  task_info                  = v.task_info;
+  face_info                  = v.face_info;
+  indices_are_initialized    = v.indices_are_initialized;
+  mapping_is_initialized     = v.mapping_is_initialized;
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline unsigned int
 MatrixFree<dim, Number, VectorizedArrayType>::n_components() const
@@ -1898,6 +2399,15 @@ MatrixFree<dim, Number, VectorizedArrayType>::n_cell_batches() const
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+inline unsigned int
+MatrixFree<dim, Number, VectorizedArrayType>::get_mg_level() const
+{
+  return dof_handlers.level;
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline unsigned int
 MatrixFree<dim, Number, VectorizedArrayType>::n_ghost_cell_batches() const
@@ -1976,6 +2486,26 @@ MatrixFree<dim, Number, VectorizedArrayType>::get_faces_by_cells_boundary_id(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+inline std::array<unsigned int, VectorizedArrayType::n_array_elements>
+MatrixFree<dim, Number, VectorizedArrayType>::get_faces_by_cells_face_index(
+  const unsigned int macro_cell,
+  const unsigned int face_number) const
+{
+  AssertIndexRange(macro_cell, n_macro_cells());
+  AssertIndexRange(face_number, GeometryInfo<dim>::faces_per_cell);
+  Assert(face_info.cell_and_face_to_plain_faces.size(0) >= n_macro_cells(),
+         ExcNotInitialized());
+  std::array<unsigned int, VectorizedArrayType::n_array_elements> result;
+  result.fill(numbers::invalid_unsigned_int);
+  for (unsigned int v = 0; v < n_active_entries_per_cell_batch(macro_cell); ++v)
+    result[v] =
+      face_info.cell_and_face_to_plain_faces(macro_cell, face_number, v);
+  return result;
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline const internal::MatrixFreeFunctions::
   MappingInfo<dim, Number, VectorizedArrayType> &
@@ -2063,6 +2593,74 @@ MatrixFree<dim, Number, VectorizedArrayType>::create_cell_subrange_hp(
 
 
 
+namespace internal
+{
+  // Loop over the polynomial degrees from degree to max_degree at compile
+  // time and call the operation on the subrange of cells with each degree.
+  // Returns the number of cell batches the operation was called on.
+  template <int degree, int max_degree, bool done = (degree > max_degree)>
+  struct FEDegreeDispatcher
+  {
+    template <typename MatrixFreeType, typename Operation>
+    static unsigned int
+    run(const MatrixFreeType &                       matrix_free,
+        const std::pair<unsigned int, unsigned int> &range,
+        const Operation &                            operation,
+        const unsigned int                           dof_handler_index)
+    {
+      const std::pair<unsigned int, unsigned int> subrange =
+        matrix_free.create_cell_subrange_hp(range, degree, dof_handler_index);
+      if (subrange.second > subrange.first)
+        operation(std::integral_constant<int, degree>(), subrange);
+      return subrange.second - subrange.first +
+             FEDegreeDispatcher<degree + 1, max_degree>::run(matrix_free,
+                                                             range,
+                                                             operation,
+                                                             dof_handler_index);
+    }
+  };
+
+  template <int degree, int max_degree>
+  struct FEDegreeDispatcher<degree, max_degree, true>
+  {
+    template <typename MatrixFreeType, typename Operation>
+    static unsigned int
+    run(const MatrixFreeType &,
+        const std::pair<unsigned int, unsigned int> &,
+        const Operation &,
+        const unsigned int)
+    {
+      return 0;
+    }
+  };
+} // namespace internal
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <int min_degree, int max_degree, typename Operation>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::apply_by_fe_degree(
+  const std::pair<unsigned int, unsigned int> &range,
+  const Operation &                            operation,
+  const unsigned int                           dof_handler_index) const
+{
+  static_assert(min_degree >= 0 && min_degree <= max_degree,
+                "Invalid range of polynomial degrees");
+  const unsigned int n_cells_visited =
+    internal::FEDegreeDispatcher<min_degree, max_degree>::run(
+      *this, range, operation, dof_handler_index);
+  (void)n_cells_visited;
+  Assert(n_cells_visited == range.second - range.first,
+         ExcMessage("Some cells in the given range have a polynomial degree "
+                    "outside the range [" +
+                    Utilities::to_string(min_degree) + ", " +
+                    Utilities::to_string(max_degree) +
+                    "] passed as template arguments."));
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline bool
 MatrixFree<dim, Number, VectorizedArrayType>::at_irregular_cell(
@@ -2820,7 +3418,7 @@ namespace internal
     template <typename VectorType,
               typename std::enable_if<
                 has_update_ghost_values_start<VectorType>::value &&
-                  !has_exchange_on_subset<VectorType>::value,
+                  !has_exchange_on_subset_of_type<VectorType, Number>::value,
                 VectorType>::type * = nullptr>
     void
     update_ghost_values_start(const unsigned int component_in_block_vector,
@@ -2845,7 +3443,7 @@ namespace internal
     template <typename VectorType,
               typename std::enable_if<
                 has_update_ghost_values_start<VectorType>::value &&
-                  has_exchange_on_subset<VectorType>::value,
+                  has_exchange_on_subset_of_type<VectorType, Number>::value,
                 VectorType>::type * = nullptr>
     void
     update_ghost_values_start(const unsigned int component_in_block_vector,
@@ -2925,7 +3523,7 @@ namespace internal
     template <typename VectorType,
               typename std::enable_if<
                 has_update_ghost_values_start<VectorType>::value &&
-                  !has_exchange_on_subset<VectorType>::value,
+                  !has_exchange_on_subset_of_type<VectorType, Number>::value,
                 VectorType>::type * = nullptr>
     void
     update_ghost_values_finish(const unsigned int component_in_block_vector,
@@ -2946,7 +3544,7 @@ namespace internal
     template <typename VectorType,
               typename std::enable_if<
                 has_update_ghost_values_start<VectorType>::value &&
-                  has_exchange_on_subset<VectorType>::value,
+                  has_exchange_on_subset_of_type<VectorType, Number>::value,
                 VectorType>::type * = nullptr>
     void
     update_ghost_values_finish(const unsigned int component_in_block_vector,
@@ -3037,11 +3635,11 @@ namespace internal
      * the split into _start() and finish() stages, but don't support
      * exchange on a subset of DoFs
      */
-    template <
-      typename VectorType,
-      typename std::enable_if<has_compress_start<VectorType>::value &&
-                                !has_exchange_on_subset<VectorType>::value,
-                              VectorType>::type * = nullptr>
+    template <typename VectorType,
+              typename std::enable_if<
+                has_compress_start<VectorType>::value &&
+                  !has_exchange_on_subset_of_type<VectorType, Number>::value,
+                VectorType>::type * = nullptr>
     void
     compress_start(const unsigned int component_in_block_vector,
                    VectorType &       vec)
@@ -3059,11 +3657,11 @@ namespace internal
      * exchange on a subset of DoFs,
      * i.e. LinearAlgebra::distributed::Vector
      */
-    template <
-      typename VectorType,
-      typename std::enable_if<has_compress_start<VectorType>::value &&
-                                has_exchange_on_subset<VectorType>::value,
-                              VectorType>::type * = nullptr>
+    template <typename VectorType,
+              typename std::enable_if<
+                has_compress_start<VectorType>::value &&
+                  has_exchange_on_subset_of_type<VectorType, Number>::value,
+                VectorType>::type * = nullptr>
     void
     compress_start(const unsigned int component_in_block_vector,
                    VectorType &       vec)
@@ -3134,11 +3732,11 @@ namespace internal
      * the split into _start() and finish() stages, but don't support
      * exchange on a subset of DoFs
      */
-    template <
-      typename VectorType,
-      typename std::enable_if<has_compress_start<VectorType>::value &&
-                                !has_exchange_on_subset<VectorType>::value,
-                              VectorType>::type * = nullptr>
+    template <typename VectorType,
+              typename std::enable_if<
+                has_compress_start<VectorType>::value &&
+                  !has_exchange_on_subset_of_type<VectorType, Number>::value,
+                VectorType>::type * = nullptr>
     void
     compress_finish(const unsigned int component_in_block_vector,
                     VectorType &       vec)
@@ -3155,11 +3753,11 @@ namespace internal
      * exchange on a subset of DoFs,
      * i.e. LinearAlgebra::distributed::Vector
      */
-    template <
-      typename VectorType,
-      typename std::enable_if<has_compress_start<VectorType>::value &&
-                                has_exchange_on_subset<VectorType>::value,
-                              VectorType>::type * = nullptr>
+    template <typename VectorType,
+              typename std::enable_if<
+                has_compress_start<VectorType>::value &&
+                  has_exchange_on_subset_of_type<VectorType, Number>::value,
+                VectorType>::type * = nullptr>
     void
     compress_finish(const unsigned int component_in_block_vector,
                     VectorType &       vec)
@@ -3228,11 +3826,11 @@ namespace internal
      * Reset all ghost values for vector that don't support
      * exchange on a subset of DoFs
      */
-    template <
-      typename VectorType,
-      typename std::enable_if<!has_exchange_on_subset<VectorType>::value &&
-                                !is_serial_or_dummy<VectorType>::value,
-                              VectorType>::type * = nullptr>
+    template <typename VectorType,
+              typename std::enable_if<
+                !has_exchange_on_subset_of_type<VectorType, Number>::value &&
+                  !is_serial_or_dummy<VectorType>::value,
+                VectorType>::type * = nullptr>
     void
     reset_ghost_values(const VectorType &vec) const
     {
@@ -3250,8 +3848,9 @@ namespace internal
      * LinearAlgebra::distributed::Vector
      */
     template <typename VectorType,
-              typename std::enable_if<has_exchange_on_subset<VectorType>::value,
-                                      VectorType>::type * = nullptr>
+              typename std::enable_if<
+                has_exchange_on_subset_of_type<VectorType, Number>::value,
+                VectorType>::type * = nullptr>
     void
     reset_ghost_values(const VectorType &vec) const
     {
@@ -3313,11 +3912,15 @@ namespace internal
     void
     zero_vector_region(const unsigned int range_index, VectorType &vec) const
     {
+      // zeroing only uses the local index ranges of the vector, so also
+      // complex vectors for a MatrixFree object of real numbers are supported
       static_assert(
-        std::is_same<Number, typename VectorType::value_type>::value,
+        std::is_same<Number,
+                     typename numbers::NumberTraits<
+                       typename VectorType::value_type>::real_type>::value,
         "Type mismatch between VectorType and VectorDataExchange");
       if (range_index == numbers::invalid_unsigned_int)
-        vec = Number();
+        vec = typename VectorType::value_type();
       else
         {
           const unsigned int mf_component = find_vector_in_mf(vec, false);
@@ -3344,9 +3947,9 @@ namespace internal
                              chunk_size_zero_vector,
                          dof_info.vector_partitioner->local_size() +
                            dof_info.vector_partitioner->n_ghost_indices());
-              std::memset(vec.begin() + start_pos,
-                          0,
-                          (end_pos - start_pos) * sizeof(Number));
+              std::fill(vec.begin() + start_pos,
+                        vec.begin() + end_pos,
+                        typename VectorType::value_type());
             }
         }
     }
@@ -4066,7 +4669,12 @@ namespace internal
              const typename MF::DataAccessOnFaces src_vector_face_access =
                MF::DataAccessOnFaces::none,
              const typename MF::DataAccessOnFaces dst_vector_face_access =
-               MF::DataAccessOnFaces::none)
+               MF::DataAccessOnFaces::none,
+             const std::function<void(const unsigned int, const unsigned int)>
+               &operation_before_loop = {},
+             const std::function<void(const unsigned int, const unsigned int)>
+               &                operation_after_loop       = {},
+             const unsigned int dof_handler_index_pre_post = 0)
       : matrix_free(matrix_free)
       , container(const_cast<Container &>(container))
       , cell_function(cell_function)
@@ -4083,6 +4691,9 @@ namespace internal
       , src_and_dst_are_same(PointerComparison::equal(&src, &dst))
       , zero_dst_vector_setting(zero_dst_vector_setting &&
                                 !src_and_dst_are_same)
+      , operation_before_loop(operation_before_loop)
+      , operation_after_loop(operation_after_loop)
+      , dof_handler_index_pre_post(dof_handler_index_pre_post)
     {}
 
     // Runs the cell work. If no function is given, nothing is done
@@ -4159,7 +4770,59 @@ namespace internal
         internal::zero_vector_region(range_index, dst, dst_data_exchanger);
     }
 
+    // Runs the operation before the loop on the vector entries first touched
+    // by the cells in the given range
+    virtual void
+    cell_loop_pre_range(const unsigned int range_index) override
+    {
+      if (operation_before_loop)
+        run_on_ranges(range_index,
+                      operation_before_loop,
+                      matrix_free.get_dof_info(dof_handler_index_pre_post)
+                        .cell_loop_pre_list_index,
+                      matrix_free.get_dof_info(dof_handler_index_pre_post)
+                        .cell_loop_pre_list);
+    }
+
+    // Runs the operation after the loop on the vector entries last touched
+    // by the cells in the given range
+    virtual void
+    cell_loop_post_range(const unsigned int range_index) override
+    {
+      if (operation_after_loop)
+        run_on_ranges(range_index,
+                      operation_after_loop,
+                      matrix_free.get_dof_info(dof_handler_index_pre_post)
+                        .cell_loop_post_list_index,
+                      matrix_free.get_dof_info(dof_handler_index_pre_post)
+                        .cell_loop_post_list);
+    }
+
   private:
+    // Calls the given operation on the ranges associated with the range
+    // index, or on the whole locally owned range for an invalid index
+    void
+    run_on_ranges(
+      const unsigned int range_index,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &                                                 operation,
+      const std::vector<unsigned int> &                   range_list_index,
+      const std::vector<std::pair<unsigned int, unsigned int>> &range_list)
+    {
+      if (range_index == numbers::invalid_unsigned_int)
+        operation(0U,
+                  matrix_free.get_dof_info(dof_handler_index_pre_post)
+                    .vector_partitioner->local_size());
+      else
+        {
+          AssertIndexRange(range_index, range_list_index.size() - 1);
+          for (unsigned int id = range_list_index[range_index];
+               id != range_list_index[range_index + 1];
+               ++id)
+            operation(range_list[id].first, range_list[id].second);
+        }
+    }
+
     const MF &    matrix_free;
     Container &   container;
     function_type cell_function;
@@ -4178,6 +4841,11 @@ namespace internal
                dst_data_exchanger;
     const bool src_and_dst_are_same;
     const bool zero_dst_vector_setting;
+    const std::function<void(const unsigned int, const unsigned int)>
+      operation_before_loop;
+    const std::function<void(const unsigned int, const unsigned int)>
+                       operation_after_loop;
+    const unsigned int dof_handler_index_pre_post;
   };
 
 
@@ -4441,6 +5109,134 @@ MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
+  void (CLASS::*function_pointer)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &) const,
+  const CLASS *   owning_class,
+  OutVector &     dst,
+  const InVector &src,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &operation_before_loop,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &                operation_after_loop,
+  const unsigned int dof_handler_index_pre_post) const
+{
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           false,
+           *owning_class,
+           function_pointer,
+           nullptr,
+           nullptr,
+           DataAccessOnFaces::none,
+           DataAccessOnFaces::none,
+           operation_before_loop,
+           operation_after_loop,
+           dof_handler_index_pre_post);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
+  void (CLASS::*function_pointer)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &),
+  CLASS *         owning_class,
+  OutVector &     dst,
+  const InVector &src,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &operation_before_loop,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &                operation_after_loop,
+  const unsigned int dof_handler_index_pre_post) const
+{
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     false>
+    worker(*this,
+           src,
+           dst,
+           false,
+           *owning_class,
+           function_pointer,
+           nullptr,
+           nullptr,
+           DataAccessOnFaces::none,
+           DataAccessOnFaces::none,
+           operation_before_loop,
+           operation_after_loop,
+           dof_handler_index_pre_post);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
+  const std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                           OutVector &,
+                           const InVector &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    &             cell_operation,
+  OutVector &     dst,
+  const InVector &src,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &operation_before_loop,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &                operation_after_loop,
+  const unsigned int dof_handler_index_pre_post) const
+{
+  using Wrapper =
+    internal::MFClassWrapper<MatrixFree<dim, Number, VectorizedArrayType>,
+                             InVector,
+                             OutVector>;
+  Wrapper wrap(cell_operation, nullptr, nullptr);
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     Wrapper,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           false,
+           wrap,
+           &Wrapper::cell_integrator,
+           &Wrapper::face_integrator,
+           &Wrapper::boundary_integrator,
+           DataAccessOnFaces::none,
+           DataAccessOnFaces::none,
+           operation_before_loop,
+           operation_after_loop,
+           dof_handler_index_pre_post);
+
+  task_info.loop(worker);
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 template <typename CLASS, typename OutVector, typename InVector>
 inline void
@@ -4486,6 +5282,116 @@ MatrixFree<dim, Number, VectorizedArrayType>::loop(
 }
 
 
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::loop_cell_centric(
+  const std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                           OutVector &,
+                           const InVector &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    &             cell_operation,
+  OutVector &     dst,
+  const InVector &src,
+  const bool      zero_dst_vector) const
+{
+  using Wrapper =
+    internal::MFClassWrapper<MatrixFree<dim, Number, VectorizedArrayType>,
+                             InVector,
+                             OutVector>;
+  Wrapper wrap(cell_operation, nullptr, nullptr);
+
+  // the neighbors behind all faces of the locally owned cells are read,
+  // which requires the full set of ghost entries in the source vector,
+  // whereas only locally owned entries are written into the destination
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     Wrapper,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           zero_dst_vector,
+           wrap,
+           &Wrapper::cell_integrator,
+           nullptr,
+           nullptr,
+           DataAccessOnFaces::unspecified,
+           DataAccessOnFaces::none);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::loop_cell_centric(
+  void (CLASS::*cell_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &) const,
+  const CLASS *   owning_class,
+  OutVector &     dst,
+  const InVector &src,
+  const bool      zero_dst_vector) const
+{
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           zero_dst_vector,
+           *owning_class,
+           cell_operation,
+           nullptr,
+           nullptr,
+           DataAccessOnFaces::unspecified,
+           DataAccessOnFaces::none);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::loop_cell_centric(
+  void (CLASS::*cell_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &),
+  CLASS *         owning_class,
+  OutVector &     dst,
+  const InVector &src,
+  const bool      zero_dst_vector) const
+{
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     false>
+    worker(*this,
+           src,
+           dst,
+           zero_dst_vector,
+           *owning_class,
+           cell_operation,
+           nullptr,
+           nullptr,
+           DataAccessOnFaces::unspecified,
+           DataAccessOnFaces::none);
+  task_info.loop(worker);
+}
+
+
 #endif // ifndef DOXYGEN
 
 
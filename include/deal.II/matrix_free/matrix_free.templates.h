@@ -18,6 +18,7 @@
 
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/memory_report.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/tensor_product_polynomials.h>
@@ -34,6 +35,7 @@
 #include <deal.II/matrix_free/dof_info.templates.h>
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/face_setup_internal.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/shape_info.templates.h>
 
@@ -221,16 +223,44 @@ MatrixFree<dim, Number, VectorizedArrayType>::copy_from(
   const MatrixFree<dim, Number, VectorizedArrayType> &v)
 {
   clear();
-  dof_handlers              = v.dof_handlers;
-  dof_info                  = v.dof_info;
-  constraint_pool_data      = v.constraint_pool_data;
-  constraint_pool_row_index = v.constraint_pool_row_index;
-  mapping_info              = v.mapping_info;
-  shape_info                = v.shape_info;
-  cell_level_index          = v.cell_level_index;
-  task_info                 = v.task_info;
-  indices_are_initialized   = v.indices_are_initialized;
-  mapping_is_initialized    = v.mapping_is_initialized;
+  dof_handlers               = v.dof_handlers;
+  dof_info                   = v.dof_info;
+  constraint_pool_data       = v.constraint_pool_data;
+  constraint_pool_row_index  = v.constraint_pool_row_index;
+  mapping_info               = v.mapping_info;
+  shape_info                 = v.shape_info;
+  cell_level_index           = v.cell_level_index;
+  cell_level_index_end_local = v.cell_level_index_end_local;
+  task_info                  = v.task_info;
+  face_info                  = v.face_info;
+  indices_are_initialized    = v.indices_are_initialized;
+  mapping_is_initialized     = v.mapping_is_initialized;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::update_mapping(
+  const Mapping<dim> &mapping)
+{
+  Assert(mapping_is_initialized,
+         ExcMessage("The mapping can only be updated if it has been "
+                    "initialized in the last call to reinit()."));
+
+  const bool is_hp = dof_handlers.active_dof_handler == DoFHandlers::hp;
+  const Triangulation<dim> &tria =
+    is_hp ? dof_handlers.hp_dof_handler[0]->get_triangulation() :
+            dof_handlers.dof_handler[0]->get_triangulation();
+
+  // as in internal_reinit(), the active FE indices are only passed on in
+  // the hp case
+  mapping_info.update_mapping(tria,
+                              cell_level_index,
+                              face_info,
+                              is_hp ? dof_info[0].cell_active_fe_index :
+                                      std::vector<unsigned int>(),
+                              mapping);
 }
 
 
@@ -299,6 +329,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         {
           dof_info[no].store_plain_indices =
             additional_data.store_plain_indices;
+          dof_info[no].store_inhomogeneities =
+            additional_data.store_constraint_inhomogeneities;
           dof_info[no].global_base_element_offset =
             no > 0 ? dof_info[no - 1].global_base_element_offset +
                        dof_handler[no - 1]->get_fe().n_base_elements() :
@@ -387,7 +419,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags,
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
-        additional_data.mapping_update_flags_faces_by_cells);
+        additional_data.mapping_update_flags_faces_by_cells,
+        additional_data.geometry_degree_on_the_fly);
 
       mapping_is_initialized = true;
     }
@@ -468,6 +501,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         {
           dof_info[no].store_plain_indices =
             additional_data.store_plain_indices;
+          dof_info[no].store_inhomogeneities =
+            additional_data.store_constraint_inhomogeneities;
           dof_info[no].global_base_element_offset =
             no > 0 ? dof_info[no - 1].global_base_element_offset +
                        dof_handler[no - 1]->get_fe()[0].n_base_elements() :
@@ -554,7 +589,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags,
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
-        additional_data.mapping_update_flags_faces_by_cells);
+        additional_data.mapping_update_flags_faces_by_cells,
+        additional_data.geometry_degree_on_the_fly);
 
       mapping_is_initialized = true;
     }
@@ -778,9 +814,24 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
   AssertDimension(n_fe, locally_owned_set.size());
   AssertDimension(n_fe, constraint.size());
 
-  std::vector<types::global_dof_index>                local_dof_indices;
+  std::vector<types::global_dof_index> local_dof_indices;
+  std::vector<types::global_dof_index> local_dof_indices_resolved;
   std::vector<std::vector<std::vector<unsigned int>>> lexicographic(n_fe);
 
+  // the fast hanging node algorithm is only used on the active cells of
+  // usual DoFHandler objects and without face integrals, as
+  // FEFaceEvaluation does not apply the interpolation
+  std::vector<bool> use_fast_hanging_nodes(n_fe, false);
+  if (additional_data.use_fast_hanging_node_algorithm &&
+      additional_data.store_plain_indices && do_face_integrals == false &&
+      additional_data.mapping_update_flags_faces_by_cells == update_default &&
+      dof_handlers.active_dof_handler == DoFHandlers::usual &&
+      dof_handlers.level == numbers::invalid_unsigned_int)
+    for (unsigned int no = 0; no < n_fe; ++no)
+      use_fast_hanging_nodes[no] =
+        internal::MatrixFreeFunctions::HangingNodes<dim>::is_supported(
+          dof_handlers.dof_handler[no]->get_fe());
+
   internal::MatrixFreeFunctions::ConstraintValues<double> constraint_values;
 
   bool cell_categorization_enabled =
@@ -917,7 +968,19 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                 dofh);
               local_dof_indices.resize(dof_info[no].dofs_per_cell[0]);
               cell_it->get_dof_indices(local_dof_indices);
-              dof_info[no].read_dof_indices(local_dof_indices,
+              unsigned int hanging_node_mask = 0;
+              if (use_fast_hanging_nodes[no])
+                {
+                  local_dof_indices_resolved = local_dof_indices;
+                  hanging_node_mask = internal::MatrixFreeFunctions::
+                    HangingNodes<dim>::compute_mask_and_dof_indices(
+                      cell_it, *constraint[no], local_dof_indices_resolved);
+                }
+              dof_info[no].read_dof_indices(hanging_node_mask != 0 ?
+                                              local_dof_indices_resolved :
+                                              local_dof_indices,
+                                            local_dof_indices,
+                                            hanging_node_mask,
                                             lexicographic[no][0],
                                             *constraint[no],
                                             counter,
@@ -948,6 +1011,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
               local_dof_indices.resize(dof_info[no].dofs_per_cell[0]);
               cell_it->get_mg_dof_indices(local_dof_indices);
               dof_info[no].read_dof_indices(local_dof_indices,
+                                            local_dof_indices,
+                                            0,
                                             lexicographic[no][0],
                                             *constraint[no],
                                             counter,
@@ -979,6 +1044,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
               cell_it->get_dof_indices(local_dof_indices);
               dof_info[no].read_dof_indices(
                 local_dof_indices,
+                local_dof_indices,
+                0,
                 lexicographic[no][cell_it->active_fe_index()],
                 *constraint[no],
                 counter,
@@ -1403,7 +1470,14 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
         true);
       face_info.cell_and_face_boundary_id.fill(numbers::invalid_boundary_id);
 
-      for (unsigned int f = 0; f < task_info.boundary_partition_data.back();
+      // also include the faces to ghost cells that are not processed
+      // locally, as held with AdditionalData::hold_all_faces_to_owned_cells,
+      // such that the neighbors behind all faces of the locally owned cells
+      // can be identified. Only the locally owned cells get an entry.
+      const unsigned int n_owned_cells =
+        task_info.cell_partition_data.back() *
+        VectorizedArrayType::n_array_elements;
+      for (unsigned int f = 0; f < task_info.ghost_face_partition_data.back();
            ++f)
         for (unsigned int v = 0; v < VectorizedArrayType::n_array_elements &&
                                  face_info.faces[f].cells_interior[v] !=
@@ -1419,8 +1493,9 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
             // Assert(cell_and_face_to_plain_faces(index) ==
             // numbers::invalid_unsigned_int,
             //       ExcInternalError("Should only visit each face once"));
-            face_info.cell_and_face_to_plain_faces(index) =
-              f * VectorizedArrayType::n_array_elements + v;
+            if (face_info.faces[f].cells_interior[v] < n_owned_cells)
+              face_info.cell_and_face_to_plain_faces(index) =
+                f * VectorizedArrayType::n_array_elements + v;
             if (face_info.faces[f].cells_exterior[v] !=
                 numbers::invalid_unsigned_int)
               {
@@ -1432,8 +1507,9 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                 // Assert(cell_and_face_to_plain_faces(index) ==
                 // numbers::invalid_unsigned_int,
                 //       ExcInternalError("Should only visit each face once"));
-                face_info.cell_and_face_to_plain_faces(index) =
-                  f * VectorizedArrayType::n_array_elements + v;
+                if (face_info.faces[f].cells_exterior[v] < n_owned_cells)
+                  face_info.cell_and_face_to_plain_faces(index) =
+                    f * VectorizedArrayType::n_array_elements + v;
               }
             else
               face_info.cell_and_face_boundary_id(index) =
@@ -1922,16 +1998,60 @@ template <int dim, typename Number, typename VectorizedArrayType>
 std::size_t
 MatrixFree<dim, Number, VectorizedArrayType>::memory_consumption() const
 {
-  std::size_t memory = MemoryConsumption::memory_consumption(dof_info);
-  memory += MemoryConsumption::memory_consumption(cell_level_index);
-  memory += MemoryConsumption::memory_consumption(face_info);
-  memory += MemoryConsumption::memory_consumption(shape_info);
-  memory += MemoryConsumption::memory_consumption(constraint_pool_data);
-  memory += MemoryConsumption::memory_consumption(constraint_pool_row_index);
-  memory += MemoryConsumption::memory_consumption(task_info);
-  memory += sizeof(*this);
-  memory += mapping_info.memory_consumption();
-  return memory;
+  MemoryReport report;
+  add_memory_consumption(report);
+  return report.local_data_memory();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::add_memory_consumption(
+  MemoryReport &     report,
+  const std::string &name) const
+{
+  for (unsigned int j = 0; j < dof_info.size(); ++j)
+    report.add(name + "/DoFInfo " + Utilities::int_to_string(j),
+               dof_info[j].memory_consumption());
+  report.add(name + "/MappingInfo", mapping_info.memory_consumption());
+  report.add(name + "/ShapeInfo",
+             MemoryConsumption::memory_consumption(shape_info));
+  report.add(name + "/FaceInfo",
+             MemoryConsumption::memory_consumption(face_info));
+  report.add(name + "/TaskInfo",
+             MemoryConsumption::memory_consumption(task_info));
+  report.add(name + "/constraint pool",
+             MemoryConsumption::memory_consumption(constraint_pool_data) +
+               MemoryConsumption::memory_consumption(
+                 constraint_pool_row_index));
+  report.add(name + "/cell index",
+             MemoryConsumption::memory_consumption(cell_level_index));
+
+  // the scratch data is kept in lists of arrays, one list per thread, with
+  // the nodes of the list estimated by the stored pair and two pointers
+  std::size_t scratch_memory = 0;
+#ifdef DEAL_II_WITH_THREADS
+  for (const auto &list : scratch_pad.get_implementation())
+    for (const auto &entry : list)
+      scratch_memory += sizeof(entry) + 2 * sizeof(void *) +
+                        MemoryConsumption::memory_consumption(entry.second);
+#else
+  for (const auto &entry : scratch_pad.get_implementation())
+    scratch_memory += sizeof(entry) + 2 * sizeof(void *) +
+                      MemoryConsumption::memory_consumption(entry.second);
+#endif
+  for (const auto &entry : scratch_pad_non_threadsafe)
+    scratch_memory += sizeof(entry) + 2 * sizeof(void *) +
+                      MemoryConsumption::memory_consumption(entry.second);
+  report.add(name + "/scratch data", scratch_memory);
+
+  report.add(name + "/other",
+             sizeof(*this) +
+               MemoryConsumption::memory_consumption(
+                 dof_handlers.dof_handler) +
+               MemoryConsumption::memory_consumption(
+                 dof_handlers.hp_dof_handler));
 }
 
 
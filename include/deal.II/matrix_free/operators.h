@@ -19,17 +19,22 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/vectorization.h>
 
+#include <deal.II/fe/fe_tools.h>
+
 #include <deal.II/lac/diagonal_matrix.h>
 #include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/tensor_product_matrix.h>
 
 #include <deal.II/matrix_free/fe_evaluation.h>
 #include <deal.II/matrix_free/matrix_free.h>
 
 #include <deal.II/multigrid/mg_constrained_dofs.h>
 
+#include <limits>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -180,6 +185,15 @@ namespace MatrixFreeOperators
    * // proceed with other terms from right hand side...
    * @endcode
    *
+   * Alternatively, a MatrixFree object set up with the flag
+   * MatrixFree::AdditionalData::store_constraint_inhomogeneities keeps the
+   * boundary values of the AffineConstraints object with the Dirichlet
+   * constraints, and a user-defined cell operation calling
+   * FEEvaluationBase::read_dof_values_with_inhomogeneities() in place of
+   * read_dof_values() computes the contribution of the inhomogeneity within
+   * the regular operator evaluation, without the second MatrixFree object
+   * and the additional vector.
+   *
    * @author Denis Davydov, Daniel Arndt, Martin Kronbichler, 2016, 2017
    */
   template <int dim,
@@ -606,6 +620,16 @@ namespace MatrixFreeOperators
    * provide a helper method 'fill_inverse_JxW_values' to get the inverse of a
    * constant-coefficient operator).
    *
+   * The inverse computed by apply() is exact for the mass matrix integrated
+   * with the Gauss quadrature formula underlying @p fe_eval. If the mass
+   * matrix is integrated more accurately, e.g. with over-integration on
+   * curved cells or for a coefficient that varies within the cell, the
+   * function apply_iterative() solves the local systems with a conjugate
+   * gradient method that uses apply() as preconditioner. As the
+   * preconditioner only misses the variation of the Jacobian determinant and
+   * the coefficient that is not resolved by the collocation points, a few
+   * iterations are typically sufficient.
+   *
    * @author Martin Kronbichler, 2014
    */
   template <int dim,
@@ -645,6 +669,44 @@ namespace MatrixFreeOperators
           const VectorizedArrayType *               in_array,
           VectorizedArrayType *                     out_array) const;
 
+    /**
+     * Apply the inverse of the mass matrix integrated with the quadrature
+     * formula of @p phi, which needs to be initialized on the same cell
+     * batch as the FEEvaluation object passed to the constructor. The
+     * local systems of all lanes of the cell batch are solved simultaneously
+     * by a conjugate gradient method, where each lane runs its own
+     * iteration with its own step lengths. The method is preconditioned by
+     * apply() with @p inverse_coefficients, i.e., the inverse of the
+     * coefficient times the JxW values in the collocation points, and
+     * stops when the residual of all lanes has been reduced by the factor
+     * @p relative_tolerance, or after @p max_iterations iterations. The
+     * tolerance is limited from below by a small multiple of the machine
+     * accuracy of @p Number.
+     *
+     * The array @p coefficients holds the coefficient in the quadrature
+     * points of @p phi, and a null pointer denotes a unit coefficient. As in
+     * apply(), the input array holds the integrals of the test functions of
+     * all components, and the output array receives the coefficients in the
+     * basis of the element. Both arrays can be the same.
+     *
+     * Returns the number of iterations.
+     */
+    template <int n_q_points_1d>
+    unsigned int
+    apply_iterative(
+      FEEvaluation<dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   n_components,
+                   Number,
+                   VectorizedArrayType> &      phi,
+      const AlignedVector<VectorizedArrayType> &inverse_coefficients,
+      const VectorizedArrayType *               coefficients,
+      const VectorizedArrayType *               in_array,
+      VectorizedArrayType *                     out_array,
+      const Number                              relative_tolerance = 1e-12,
+      const unsigned int                        max_iterations     = 20) const;
+
     /**
      * This operation performs a projection from the data given in quadrature
      * points to the actual basis underlying this object. This projection can
@@ -706,6 +768,179 @@ namespace MatrixFreeOperators
      * A structure to hold inverse shape functions
      */
     AlignedVector<VectorizedArrayType> inverse_shape;
+
+    /**
+     * Temporary storage for the vectors of the conjugate gradient method in
+     * apply_iterative().
+     */
+    mutable AlignedVector<VectorizedArrayType> cg_vectors;
+  };
+
+
+
+  /**
+   * This class implements a block-Jacobi preconditioner for discontinuous
+   * Galerkin discretizations of the Laplacian with the symmetric interior
+   * penalty method, where the blocks are the matrices of the individual
+   * cells. Instead of storing and factorizing the cell matrices, each block
+   * is approximated by the separable operator
+   * $L_1 \otimes M_0 + M_1 \otimes L_0$ (and the analogous sum of dim
+   * terms in 3D) of one-dimensional mass matrices $M_d$ and one-dimensional
+   * DG Laplace matrices $L_d$ including the cell's own face terms and the
+   * penalty. The inverse is applied with the fast diagonalization method
+   * implemented by TensorProductMatrixSymmetricSum, which uses sum
+   * factorization over all lanes of a cell batch at once. Thus, the cost of
+   * applying the inverse on a cell is similar to the cost of a matrix-free
+   * operator evaluation.
+   *
+   * The one-dimensional matrices are scaled on each cell according to the
+   * extent of the cell in the respective reference direction, computed as
+   * the average of $|\nabla \hat x_d|$ over the quadrature points. For
+   * axis-parallel rectangular cells, the separable operator is the exact
+   * cell matrix except for the terms at Dirichlet and Neumann boundaries;
+   * otherwise it is an approximation of the cell matrix. Cell batches with
+   * Cartesian geometry that share the same mapping data also share the
+   * eigendecompositions.
+   *
+   * The class provides the interface of a preconditioner with vmult() and
+   * Tvmult() and can be used as the relaxation kernel in
+   * MGSmootherPrecondition or as the preconditioner inside
+   * PreconditionChebyshev, which results in much better smoothing than
+   * point-Jacobi methods for high polynomial degrees. It is only meaningful
+   * for elements of type FE_DGQ and its variants, possibly within an FESystem
+   * with @p n_components copies of the same element.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_components = 1,
+            typename Number  = double>
+  class CellwiseInverseLaplaceFDM : public Subscriptor
+  {
+  public:
+    /**
+     * The type of the vectors this class works on.
+     */
+    using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+    /**
+     * Number typedef.
+     */
+    using value_type = Number;
+
+    /**
+     * Collects options for setting up the class.
+     */
+    struct AdditionalData
+    {
+      /**
+       * Constructor.
+       */
+      AdditionalData(const double       penalty_factor = 1.,
+                     const double       relaxation     = 1.,
+                     const unsigned int dof_index      = 0,
+                     const unsigned int quad_index     = 0);
+
+      /**
+       * The penalty parameter of the interior penalty method, scaled by the
+       * extent of the cell perpendicular to the face. The penalty term on a
+       * face is therefore <tt>penalty_factor / h</tt>, where @p h is the
+       * extent of the cell. A typical choice is $(k+1)^2$ for polynomial
+       * degree $k$.
+       */
+      double penalty_factor;
+
+      /**
+       * A relaxation factor that scales the result of vmult().
+       */
+      double relaxation;
+
+      /**
+       * The index of the DoFHandler within the MatrixFree object.
+       */
+      unsigned int dof_index;
+
+      /**
+       * The index of the quadrature formula within the MatrixFree object. The
+       * formula must have <tt>fe_degree+1</tt> points in each direction.
+       */
+      unsigned int quad_index;
+    };
+
+    /**
+     * Compute the one-dimensional matrices and their eigendecompositions for
+     * all cell batches in the given MatrixFree object.
+     */
+    void
+    initialize(const std::shared_ptr<const MatrixFree<dim, Number>> &data,
+               const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Same as above, but take the MatrixFree object from an operator, which
+     * must provide a function <tt>get_matrix_free()</tt> like the classes
+     * derived from MatrixFreeOperators::Base. This is the interface used by
+     * MGSmootherPrecondition::initialize().
+     */
+    template <typename OperatorType>
+    void
+    initialize(const OperatorType &  op,
+               const AdditionalData &additional_data = AdditionalData());
+
+    /**
+     * Release all memory.
+     */
+    void
+    clear();
+
+    /**
+     * Apply the approximate inverse of the cell matrices to @p src, scaled by
+     * the relaxation factor, and store the result in @p dst.
+     */
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Apply the transpose. As the underlying matrices are symmetric, this is
+     * the same as vmult().
+     */
+    void
+    Tvmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return the memory consumption of this class in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * Make sure that the vector has the ghost layout expected by MatrixFree.
+     */
+    void
+    adjust_ghost_range_if_necessary(const VectorType &vec) const;
+
+    /**
+     * The underlying MatrixFree object.
+     */
+    std::shared_ptr<const MatrixFree<dim, Number>> data;
+
+    /**
+     * The settings passed to initialize().
+     */
+    AdditionalData additional_data;
+
+    /**
+     * The tensor product matrices, possibly shared between several cell
+     * batches.
+     */
+    std::vector<TensorProductMatrixSymmetricSum<dim,
+                                                VectorizedArray<Number>,
+                                                fe_degree + 1>>
+      cell_matrices;
+
+    /**
+     * The index into @p cell_matrices for each cell batch.
+     */
+    std::vector<unsigned int> matrix_indices;
   };
 
 
@@ -1076,6 +1311,132 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  template <int n_q_points_1d>
+  inline unsigned int
+  CellwiseInverseMassMatrix<dim,
+                            fe_degree,
+                            n_components,
+                            Number,
+                            VectorizedArrayType>::
+    apply_iterative(
+      FEEvaluation<dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   n_components,
+                   Number,
+                   VectorizedArrayType> &      phi,
+      const AlignedVector<VectorizedArrayType> &inverse_coefficients,
+      const VectorizedArrayType *               coefficients,
+      const VectorizedArrayType *               in_array,
+      VectorizedArrayType *                     out_array,
+      const Number                              relative_tolerance,
+      const unsigned int                        max_iterations) const
+  {
+    constexpr unsigned int dofs_per_cell =
+      Utilities::pow(fe_degree + 1, dim) * n_components;
+    const unsigned int n_q_points = phi.n_q_points;
+
+    cg_vectors.resize_fast(4 * dofs_per_cell);
+    VectorizedArrayType *solution = cg_vectors.data();
+    VectorizedArrayType *residual = solution + dofs_per_cell;
+    VectorizedArrayType *search   = residual + dofs_per_cell;
+    VectorizedArrayType *product  = search + dofs_per_cell;
+
+    const auto inner_product = [](const VectorizedArrayType *a,
+                                  const VectorizedArrayType *b) {
+      VectorizedArrayType sum = a[0] * b[0];
+      for (unsigned int i = 1; i < dofs_per_cell; ++i)
+        sum += a[i] * b[i];
+      return sum;
+    };
+
+    // apply the mass matrix with the quadrature formula of phi
+    const auto apply_mass = [&](const VectorizedArrayType *src,
+                                VectorizedArrayType *      dst) {
+      phi.evaluate(src, true, false);
+      if (coefficients != nullptr)
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          phi.submit_value(coefficients[q] * phi.get_value(q), q);
+      else
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          phi.submit_value(phi.get_value(q), q);
+      phi.integrate(true, false, dst);
+    };
+
+    // the right hand side is kept in the residual vector because in_array
+    // and out_array might be the same
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      residual[i] = in_array[i];
+    const VectorizedArrayType rhs_norm_square =
+      inner_product(residual, residual);
+    const Number tolerance =
+      std::max(relative_tolerance,
+               Number(10) * std::numeric_limits<Number>::epsilon());
+
+    // start with the solution of the preconditioner
+    apply(inverse_coefficients, n_components, residual, solution);
+    apply_mass(solution, product);
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      residual[i] -= product[i];
+
+    // the search direction is initialized with the preconditioned residual
+    // in the first iteration, where all lanes are iterating
+    const VectorizedArrayType tiny = std::numeric_limits<Number>::min();
+    VectorizedArrayType       residual_dot_preconditioned;
+    unsigned int              iteration = 0;
+    for (; iteration < max_iterations; ++iteration)
+      {
+        const VectorizedArrayType residual_norm_square =
+          inner_product(residual, residual);
+        bool converged = true;
+        for (unsigned int v = 0; v < VectorizedArrayType::n_array_elements;
+             ++v)
+          if (residual_norm_square[v] >
+              tolerance * tolerance * rhs_norm_square[v])
+            converged = false;
+        if (converged)
+          break;
+
+        apply(inverse_coefficients, n_components, residual, product);
+        const VectorizedArrayType new_residual_dot_preconditioned =
+          inner_product(residual, product);
+        if (iteration == 0)
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            search[i] = product[i];
+        else
+          {
+            const VectorizedArrayType beta =
+              new_residual_dot_preconditioned /
+              std::max(residual_dot_preconditioned, tiny);
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              search[i] = product[i] + beta * search[i];
+          }
+        residual_dot_preconditioned = new_residual_dot_preconditioned;
+
+        apply_mass(search, product);
+        const VectorizedArrayType alpha =
+          residual_dot_preconditioned /
+          std::max(inner_product(search, product), tiny);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            solution[i] += alpha * search[i];
+            residual[i] -= alpha * product[i];
+          }
+      }
+
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      out_array[i] = solution[i];
+
+    return iteration;
+  }
+
+
+
   template <int dim,
             int fe_degree,
             int n_components,
@@ -1124,6 +1485,283 @@ namespace MatrixFreeOperators
 
 
 
+  //----------------- Cellwise inverse Laplacian -------------------------
+  template <int dim, int fe_degree, int n_components, typename Number>
+  CellwiseInverseLaplaceFDM<dim, fe_degree, n_components, Number>::
+    AdditionalData::AdditionalData(const double       penalty_factor,
+                                   const double       relaxation,
+                                   const unsigned int dof_index,
+                                   const unsigned int quad_index)
+    : penalty_factor(penalty_factor)
+    , relaxation(relaxation)
+    , dof_index(dof_index)
+    , quad_index(quad_index)
+  {}
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  void
+  CellwiseInverseLaplaceFDM<dim, fe_degree, n_components, Number>::initialize(
+    const std::shared_ptr<const MatrixFree<dim, Number>> &data_in,
+    const AdditionalData &                                additional_data_in)
+  {
+    data            = data_in;
+    additional_data = additional_data_in;
+
+    // create the one-dimensional version of the element by replacing the
+    // dimension in the name of the base element; the numbering of all DG
+    // elements in 1D is lexicographic as in FEEvaluation
+    const FiniteElement<dim> &fe =
+      data->get_dof_handler(additional_data.dof_index).get_fe();
+    AssertThrow(fe.n_base_elements() == 1 &&
+                  fe.element_multiplicity(0) == n_components,
+                ExcMessage("Expected a finite element with " +
+                           Utilities::to_string(n_components) +
+                           " copies of a single base element"));
+    std::string name = fe.base_element(0).get_name();
+    name.replace(name.find('<') + 1, 1, "1");
+    const std::unique_ptr<FiniteElement<1>> fe_1d =
+      FETools::get_fe_by_name<1>(name);
+    AssertThrow(fe_1d->dofs_per_vertex == 0 &&
+                  fe_1d->dofs_per_cell == fe_degree + 1,
+                ExcMessage("This class only works for discontinuous elements "
+                           "of degree fe_degree"));
+
+    // assemble the 1D mass and Laplace matrices on the unit interval,
+    // including the terms of the interior penalty method on the two faces
+    // with coefficients 0.5 as for interior faces
+    constexpr unsigned int n = fe_degree + 1;
+    FullMatrix<double>     mass_unscaled(n, n);
+    FullMatrix<double>     laplace_unscaled(n, n);
+    const QGauss<1>        quadrature(n);
+    for (unsigned int i = 0; i < n; ++i)
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          double sum_mass = 0, sum_laplace = 0;
+          for (unsigned int q = 0; q < quadrature.size(); ++q)
+            {
+              sum_mass += fe_1d->shape_value(i, quadrature.point(q)) *
+                          fe_1d->shape_value(j, quadrature.point(q)) *
+                          quadrature.weight(q);
+              sum_laplace += fe_1d->shape_grad(i, quadrature.point(q))[0] *
+                             fe_1d->shape_grad(j, quadrature.point(q))[0] *
+                             quadrature.weight(q);
+            }
+          for (unsigned int f = 0; f < 2; ++f)
+            {
+              const Point<1> point(static_cast<double>(f));
+              const double   normal = f == 0 ? -1. : 1.;
+              sum_laplace +=
+                additional_data.penalty_factor *
+                  fe_1d->shape_value(i, point) * fe_1d->shape_value(j, point) -
+                0.5 * normal *
+                  (fe_1d->shape_grad(i, point)[0] *
+                     fe_1d->shape_value(j, point) +
+                   fe_1d->shape_grad(j, point)[0] *
+                     fe_1d->shape_value(i, point));
+            }
+          mass_unscaled(i, j)    = sum_mass;
+          laplace_unscaled(i, j) = sum_laplace;
+        }
+
+    std::array<Table<2, VectorizedArray<Number>>, dim> mass_matrices;
+    std::array<Table<2, VectorizedArray<Number>>, dim> laplace_matrices;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        mass_matrices[d].reinit(n, n);
+        laplace_matrices[d].reinit(n, n);
+        for (unsigned int i = 0; i < n; ++i)
+          for (unsigned int j = 0; j < n; ++j)
+            mass_matrices[d](i, j) = mass_unscaled(i, j);
+      }
+
+    // go through the cell batches and compute the eigendecompositions of
+    // the scaled matrices. Since the weights of the terms are constant on
+    // each cell, they can be applied to the Laplace matrices only, leaving
+    // the mass matrices unscaled. Cartesian cells with the same geometry
+    // reuse the matrices.
+    cell_matrices.clear();
+    matrix_indices.resize(data->n_cell_batches());
+    std::map<unsigned int, unsigned int> cartesian_matrices;
+    FEEvaluation<dim, fe_degree, fe_degree + 1, n_components, Number> phi(
+      *data, additional_data.dof_index, additional_data.quad_index);
+    for (unsigned int cell = 0; cell < data->n_cell_batches(); ++cell)
+      {
+        phi.reinit(cell);
+
+        const bool is_cartesian =
+          phi.get_cell_type() == internal::MatrixFreeFunctions::cartesian;
+        if (is_cartesian)
+          {
+            const auto it =
+              cartesian_matrices.find(phi.get_mapping_data_index_offset());
+            if (it != cartesian_matrices.end())
+              {
+                matrix_indices[cell] = it->second;
+                continue;
+              }
+            cartesian_matrices[phi.get_mapping_data_index_offset()] =
+              cell_matrices.size();
+          }
+
+        // the inverse extent of the cell in reference direction d is the
+        // length of the gradient of the reference coordinate x_d
+        std::array<VectorizedArray<Number>, dim> inverse_length;
+        for (unsigned int d = 0; d < dim; ++d)
+          inverse_length[d] = Number(0.);
+        VectorizedArray<Number> jacobian_determinant =
+          make_vectorized_array<Number>(0.);
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          {
+            const Tensor<2, dim, VectorizedArray<Number>> inverse_jacobian =
+              phi.inverse_jacobian(q);
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                VectorizedArray<Number> sum =
+                  make_vectorized_array<Number>(0.);
+                for (unsigned int e = 0; e < dim; ++e)
+                  sum += inverse_jacobian[d][e] * inverse_jacobian[d][e];
+                inverse_length[d] += std::sqrt(sum);
+              }
+            jacobian_determinant +=
+              Number(1.) / std::abs(determinant(inverse_jacobian));
+            if (is_cartesian)
+              break;
+          }
+        const Number n_points = is_cartesian ? 1 : phi.n_q_points;
+        jacobian_determinant /= n_points;
+
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            inverse_length[d] /= n_points;
+            const VectorizedArray<Number> scaling_factor =
+              inverse_length[d] * inverse_length[d] * jacobian_determinant;
+            for (unsigned int i = 0; i < n; ++i)
+              for (unsigned int j = 0; j < n; ++j)
+                laplace_matrices[d](i, j) =
+                  scaling_factor * Number(laplace_unscaled(i, j));
+          }
+
+        matrix_indices[cell] = cell_matrices.size();
+        cell_matrices.emplace_back();
+        cell_matrices.back().reinit(mass_matrices, laplace_matrices);
+      }
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  template <typename OperatorType>
+  void
+  CellwiseInverseLaplaceFDM<dim, fe_degree, n_components, Number>::initialize(
+    const OperatorType &  op,
+    const AdditionalData &additional_data)
+  {
+    initialize(op.get_matrix_free(), additional_data);
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  void
+  CellwiseInverseLaplaceFDM<dim, fe_degree, n_components, Number>::clear()
+  {
+    data.reset();
+    cell_matrices.clear();
+    matrix_indices.clear();
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  void
+  CellwiseInverseLaplaceFDM<dim, fe_degree, n_components, Number>::vmult(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    Assert(data.get() != nullptr,
+           ExcMessage("The preconditioner has not been initialized"));
+    adjust_ghost_range_if_necessary(dst);
+    adjust_ghost_range_if_necessary(src);
+
+    FEEvaluation<dim, fe_degree, fe_degree + 1, n_components, Number> phi(
+      *data, additional_data.dof_index, additional_data.quad_index);
+    constexpr unsigned int dofs_per_component =
+      Utilities::pow(fe_degree + 1, dim);
+    AlignedVector<VectorizedArray<Number>> values(dofs_per_component);
+    const VectorizedArray<Number>          relaxation =
+      make_vectorized_array<Number>(additional_data.relaxation);
+    for (unsigned int cell = 0; cell < data->n_cell_batches(); ++cell)
+      {
+        phi.reinit(cell);
+        phi.read_dof_values(src);
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            VectorizedArray<Number> *dof_values =
+              phi.begin_dof_values() + c * dofs_per_component;
+            cell_matrices[matrix_indices[cell]].apply_inverse(
+              ArrayView<VectorizedArray<Number>>(values.begin(),
+                                                 dofs_per_component),
+              ArrayView<const VectorizedArray<Number>>(dof_values,
+                                                       dofs_per_component));
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              dof_values[i] = relaxation * values[i];
+          }
+        phi.set_dof_values(dst);
+      }
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  void
+  CellwiseInverseLaplaceFDM<dim, fe_degree, n_components, Number>::Tvmult(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    vmult(dst, src);
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  std::size_t
+  CellwiseInverseLaplaceFDM<dim, fe_degree, n_components, Number>::
+    memory_consumption() const
+  {
+    // the matrix class does not report its memory consumption, so count the
+    // mass, derivative, and eigenvector matrices and the eigenvalues
+    constexpr unsigned int n = fe_degree + 1;
+    return sizeof(*this) +
+           MemoryConsumption::memory_consumption(matrix_indices) +
+           cell_matrices.size() *
+             (sizeof(cell_matrices[0]) +
+              dim * (3 * n * n + n) * sizeof(VectorizedArray<Number>));
+  }
+
+
+
+  template <int dim, int fe_degree, int n_components, typename Number>
+  void
+  CellwiseInverseLaplaceFDM<dim, fe_degree, n_components, Number>::
+    adjust_ghost_range_if_necessary(const VectorType &vec) const
+  {
+    const auto &partitioner =
+      data->get_dof_info(additional_data.dof_index).vector_partitioner;
+    if (vec.get_partitioner().get() == partitioner.get())
+      return;
+
+    Assert(vec.get_partitioner()->local_size() == partitioner->local_size(),
+           ExcMessage("The vector passed to the vmult() function does not have "
+                      "the correct size for compatibility with MatrixFree."));
+    VectorType copy_vec(vec);
+    const_cast<VectorType &>(vec).reinit(partitioner);
+    const_cast<VectorType &>(vec).copy_locally_owned_data_from(copy_vec);
+  }
+
+
+
   //----------------- Base operator -----------------------------
   template <int dim, typename VectorType>
   Base<dim, VectorType>::Base()
@@ -24,6 +24,8 @@
 
 #include <deal.II/fe/fe.h>
 
+#include <deal.II/matrix_free/helper_functions.h>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -132,6 +134,16 @@ namespace internal
              const FiniteElement<dim> &fe_dim,
              const unsigned int        base_element = 0);
 
+      /**
+       * Fill the data fields of this class with the data of @p other, which
+       * has been computed for a different number type, converting the
+       * numbers entry by entry. This is used to set up a MatrixFree object
+       * in another precision from an existing one.
+       */
+      template <typename Number2>
+      void
+      copy_from(const ShapeInfo<Number2> &other);
+
       /**
        * Return the memory consumption of this class in bytes.
        */
@@ -232,6 +244,16 @@ namespace internal
        */
       AlignedVector<Number> hessians_within_subface[2];
 
+      /**
+       * Stores the one-dimensional interpolation matrices from the degrees of
+       * freedom of a parent cell to the degrees of freedom of its lower (0)
+       * and upper (1) child, with entry <tt>i*n_dofs_1d+j</tt> holding the
+       * value of the parent's basis function @p j in the node @p i of the
+       * child. These matrices are used by the fast hanging node algorithm of
+       * MatrixFree and are only filled for FE_Q elements.
+       */
+      AlignedVector<Number> hanging_node_interpolation[2];
+
       /**
        * Renumbering from deal.II's numbering of cell degrees of freedom to
        * lexicographic numbering used inside the FEEvaluation schemes of the
@@ -394,6 +416,51 @@ namespace internal
       reinit(quad, fe_in, base_element_number);
     }
 
+
+
+    template <typename Number>
+    template <typename Number2>
+    inline void
+    ShapeInfo<Number>::copy_from(const ShapeInfo<Number2> &other)
+    {
+      element_type = other.element_type;
+
+      convert_number_type(other.shape_values, shape_values);
+      convert_number_type(other.shape_gradients, shape_gradients);
+      convert_number_type(other.shape_hessians, shape_hessians);
+      convert_number_type(other.shape_values_eo, shape_values_eo);
+      convert_number_type(other.shape_gradients_eo, shape_gradients_eo);
+      convert_number_type(other.shape_hessians_eo, shape_hessians_eo);
+      convert_number_type(other.shape_gradients_collocation_eo,
+                          shape_gradients_collocation_eo);
+      convert_number_type(other.shape_hessians_collocation_eo,
+                          shape_hessians_collocation_eo);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          convert_number_type(other.shape_data_on_face[i],
+                              shape_data_on_face[i]);
+          convert_number_type(other.values_within_subface[i],
+                              values_within_subface[i]);
+          convert_number_type(other.gradients_within_subface[i],
+                              gradients_within_subface[i]);
+          convert_number_type(other.hessians_within_subface[i],
+                              hessians_within_subface[i]);
+          convert_number_type(other.hanging_node_interpolation[i],
+                              hanging_node_interpolation[i]);
+        }
+
+      lexicographic_numbering    = other.lexicographic_numbering;
+      fe_degree                  = other.fe_degree;
+      n_q_points_1d              = other.n_q_points_1d;
+      n_q_points                 = other.n_q_points;
+      dofs_per_component_on_cell = other.dofs_per_component_on_cell;
+      n_q_points_face            = other.n_q_points_face;
+      dofs_per_component_on_face = other.dofs_per_component_on_face;
+      nodal_at_cell_boundaries   = other.nodal_at_cell_boundaries;
+      face_to_cell_index_nodal   = other.face_to_cell_index_nodal;
+      face_to_cell_index_hermite = other.face_to_cell_index_hermite;
+    }
+
   } // end of namespace MatrixFreeFunctions
 
 } // end of namespace internal
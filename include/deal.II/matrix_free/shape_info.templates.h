@@ -26,6 +26,7 @@
 #include <deal.II/fe/fe_dgp.h>
 #include <deal.II/fe/fe_dgq.h>
 #include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_q_dg0.h>
 
 #include <deal.II/matrix_free/shape_info.h>
@@ -265,6 +266,24 @@ namespace internal
             fe->shape_grad_grad(my_i, q_point)[0][0];
         }
 
+      // interpolation from the nodes of a parent to the nodes of its two
+      // children in 1D for resolving hanging node constraints
+      if (dim > 1 && dynamic_cast<const FE_Q<dim> *>(fe) != nullptr)
+        for (unsigned int c = 0; c < 2; ++c)
+          {
+            hanging_node_interpolation[c].resize(n_dofs_1d * n_dofs_1d);
+            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+              {
+                Point<dim> point = unit_point;
+                point[0] =
+                  0.5 * (c + fe->get_unit_support_points()
+                               [scalar_lexicographic[i]][0]);
+                for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                  hanging_node_interpolation[c][i * n_dofs_1d + j] =
+                    fe->shape_value(scalar_lexicographic[j], point);
+              }
+          }
+
       // get gradient and Hessian transformation matrix for the polynomial
       // space associated with the quadrature rule (collocation space). We
       // need to avoid the case with more than a few hundreds of quadrature
@@ -583,6 +602,8 @@ namespace internal
             MemoryConsumption::memory_consumption(values_within_subface[i]);
           memory +=
             MemoryConsumption::memory_consumption(gradients_within_subface[i]);
+          memory += MemoryConsumption::memory_consumption(
+            hanging_node_interpolation[i]);
         }
       return memory;
     }
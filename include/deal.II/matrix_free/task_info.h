@@ -67,6 +67,18 @@ namespace internal
     virtual void
     zero_dst_vector_range(const unsigned int range_index) = 0;
 
+    /// Runs the operation specified by MatrixFree::cell_loop on the vector
+    /// entries that are touched for the first time by the cells of the given
+    /// range as stored in DoFInfo
+    virtual void
+    cell_loop_pre_range(const unsigned int range_index) = 0;
+
+    /// Runs the operation specified by MatrixFree::cell_loop on the vector
+    /// entries that are touched for the last time by the cells of the given
+    /// range as stored in DoFInfo
+    virtual void
+    cell_loop_post_range(const unsigned int range_index) = 0;
+
     /// Runs the cell work specified by MatrixFree::loop or
     /// MatrixFree::cell_loop
     virtual void
@@ -556,6 +568,29 @@ namespace internal
        */
       std::vector<unsigned char> task_at_mpi_boundary;
 
+      /**
+       * For the coloring schemes with a single partition, the range of cell
+       * batches of each block of cells in the final numbering. The blocks of
+       * a color are contiguous. Empty if the blocks are not scheduled
+       * individually.
+       */
+      std::vector<unsigned int> block_partition_data;
+
+      /**
+       * For each block described by @p block_partition_data, the index into
+       * @p block_predecessors where its list of predecessors starts.
+       */
+      std::vector<unsigned int> block_predecessor_row_index;
+
+      /**
+       * The blocks of earlier colors that share degrees of freedom with a
+       * block and thus need to be finished before the block can be worked
+       * on. These dependencies replace the synchronization of all threads
+       * after each color, so that the blocks of different colors can be
+       * processed concurrently if they are not connected.
+       */
+      std::vector<unsigned int> block_predecessors;
+
       /**
        * MPI communicator
        */
@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/tensor.h>
 #include <deal.II/base/utilities.h>
 
 
@@ -2185,6 +2186,143 @@ namespace internal
       }
   }
 
+
+
+  /**
+   * Compute the value and the gradient in reference coordinates of a
+   * polynomial in the tensor product form at a single point, given the
+   * values and first derivatives of the 1D shape functions at the
+   * coordinates of the point. The coefficients @p values are given in the
+   * numbering of the finite element and @p renumber translates the
+   * lexicographic numbering of the tensor product into that numbering. The
+   * sum over the shape functions is factorized direction by direction,
+   * leading to a cost of $\mathcal O(k^d)$ operations for $k$ shape
+   * functions per direction rather than $\mathcal O(d k^d)$ for the naive
+   * evaluation shape function by shape function.
+   *
+   * @tparam dim Space dimension
+   * @tparam Number Number type of the 1D shape data and the result, which can
+   *                be a VectorizedArray to evaluate several points at once
+   * @tparam Number2 Number type of the coefficients, which must implement
+   *                 operator* with Number
+   *
+   * @param shapes The values and derivatives of the 1D shape functions,
+   *               with the value of shape function <tt>i</tt> in direction
+   *               <tt>d</tt> at position <tt>2*(d*n_shapes+i)</tt> and the
+   *               derivative at the position after it.
+   * @param n_shapes The number of 1D shape functions in each direction.
+   * @param values The coefficients of the polynomial.
+   * @param renumber The position in @p values of the coefficient of each
+   *                 shape function in lexicographic numbering, with
+   *                 <tt>n_shapes^dim</tt> entries.
+   */
+  template <int dim, typename Number, typename Number2>
+  inline std::pair<Number, Tensor<1, dim, Number>>
+  evaluate_tensor_product_value_and_gradient(const Number *      shapes,
+                                             const unsigned int  n_shapes,
+                                             const Number2 *     values,
+                                             const unsigned int *renumber)
+  {
+    static_assert(dim >= 1 && dim <= 3, "Only dim=1,2,3 implemented");
+
+    Number                 value   = Number();
+    Tensor<1, dim, Number> unit_gradient;
+
+    const Number *shapes_y = shapes + 2 * n_shapes * (dim > 1 ? 1 : 0);
+    const Number *shapes_z = shapes + 2 * n_shapes * (dim > 2 ? 2 : 0);
+
+    for (unsigned int i2 = 0, i = 0; i2 < (dim > 2 ? n_shapes : 1); ++i2)
+      {
+        Number value_y = Number(), deriv_x = Number(), deriv_y = Number();
+        for (unsigned int i1 = 0; i1 < (dim > 1 ? n_shapes : 1); ++i1)
+          {
+            // innermost sum over the shape functions in x direction
+            Number value_x = Number(), deriv = Number();
+            for (unsigned int i0 = 0; i0 < n_shapes; ++i0, ++i)
+              {
+                const Number2 coefficient = values[renumber[i]];
+                value_x += shapes[2 * i0] * coefficient;
+                deriv += shapes[2 * i0 + 1] * coefficient;
+              }
+            if (dim > 1)
+              {
+                value_y += shapes_y[2 * i1] * value_x;
+                deriv_x += shapes_y[2 * i1] * deriv;
+                deriv_y += shapes_y[2 * i1 + 1] * value_x;
+              }
+            else
+              {
+                value_y = value_x;
+                deriv_x = deriv;
+              }
+          }
+        if (dim > 2)
+          {
+            value += shapes_z[2 * i2] * value_y;
+            unit_gradient[0] += shapes_z[2 * i2] * deriv_x;
+            unit_gradient[1] += shapes_z[2 * i2] * deriv_y;
+            unit_gradient[dim - 1] += shapes_z[2 * i2 + 1] * value_y;
+          }
+        else
+          {
+            value            = value_y;
+            unit_gradient[0] = deriv_x;
+            if (dim > 1)
+              unit_gradient[dim - 1] = deriv_y;
+          }
+      }
+
+    return std::make_pair(value, unit_gradient);
+  }
+
+
+
+  /**
+   * Multiply the value @p value given at a single point by the values of
+   * all shape functions of a tensor product at this point and add the
+   * results to @p values, i.e., perform the transpose operation of the
+   * value part of evaluate_tensor_product_value_and_gradient(). The
+   * products of the 1D shape functions are factorized direction by
+   * direction like in that function.
+   *
+   * @tparam dim Space dimension
+   * @tparam Number Number type of the 1D shape data, the value, and the
+   *                result, which can be a VectorizedArray to treat several
+   *                points at once
+   *
+   * @param shapes The values and derivatives of the 1D shape functions in
+   *               the layout described for
+   *               evaluate_tensor_product_value_and_gradient().
+   * @param n_shapes The number of 1D shape functions in each direction.
+   * @param value The value at the point.
+   * @param values The <tt>n_shapes^dim</tt> coefficients in lexicographic
+   *               numbering to which the contributions are added.
+   */
+  template <int dim, typename Number>
+  inline void
+  integrate_add_tensor_product_value(const Number *     shapes,
+                                     const unsigned int n_shapes,
+                                     const Number &     value,
+                                     Number *           values)
+  {
+    static_assert(dim >= 1 && dim <= 3, "Only dim=1,2,3 implemented");
+
+    const Number *shapes_y = shapes + 2 * n_shapes * (dim > 1 ? 1 : 0);
+    const Number *shapes_z = shapes + 2 * n_shapes * (dim > 2 ? 2 : 0);
+
+    for (unsigned int i2 = 0, i = 0; i2 < (dim > 2 ? n_shapes : 1); ++i2)
+      {
+        const Number value_z = (dim > 2 ? shapes_z[2 * i2] * value : value);
+        for (unsigned int i1 = 0; i1 < (dim > 1 ? n_shapes : 1); ++i1)
+          {
+            const Number value_y =
+              (dim > 1 ? shapes_y[2 * i1] * value_z : value_z);
+            for (unsigned int i0 = 0; i0 < n_shapes; ++i0, ++i)
+              values[i] += shapes[2 * i0] * value_y;
+          }
+      }
+  }
+
 } // end of namespace internal
 
 
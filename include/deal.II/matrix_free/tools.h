@@ -0,0 +1,755 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_tools_h
+#define dealii_matrix_free_tools_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/template_constraints.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A namespace for utility functions in the context of matrix-free operator
+ * evaluation.
+ */
+namespace MatrixFreeTools
+{
+  /**
+   * Compute the diagonal of a linear operator given by a matrix-free cell
+   * kernel and add it into @p diagonal_global.
+   *
+   * The kernel @p local_vmult receives an FEEvaluation object whose degrees
+   * of freedom are set to the input vector of a cell batch. It must apply
+   * the cell operator to these values and leave the result in the degrees of
+   * freedom of the same object, i.e., it typically calls
+   * FEEvaluation::evaluate(), a loop over quadrature points, and
+   * FEEvaluation::integrate(). This is the same code a cell_loop() of the
+   * operator runs between FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global().
+   *
+   * The cell matrices are computed by applying the kernel to all unit
+   * vectors of a cell, where all lanes of a cell batch are processed at once,
+   * and then condensed with the given @p constraints. In particular, the
+   * entries of degrees of freedom constrained by hanging nodes are
+   * distributed to the constraining degrees of freedom including the
+   * coupling between them, which makes the result the exact diagonal of the
+   * condensed operator. The diagonal entries of constrained degrees of
+   * freedom are not set, which is the case that MatrixFreeOperators::Base
+   * handles by setting them to one.
+   *
+   * The vector @p diagonal_global must be initialized by
+   * MatrixFree::initialize_dof_vector() or contain the ghost entries of the
+   * locally relevant degrees of freedom in some other way. It is set to
+   * zero before the diagonal is computed and compressed at the end.
+   *
+   * The template arguments up to @p n_components need to be specified
+   * explicitly when passing a lambda function as @p local_vmult; the
+   * overload taking a member function pointer deduces them.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType = VectorizedArray<Number>,
+            typename Number2,
+            typename VectorType>
+  void
+  compute_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number2> &                  constraints,
+    VectorType &                                        diagonal_global,
+    const typename identity<
+      std::function<void(FEEvaluation<dim,
+                                      fe_degree,
+                                      n_q_points_1d,
+                                      n_components,
+                                      Number,
+                                      VectorizedArrayType> &)>>::type
+      &local_vmult,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Same as above but with the kernel given as a member function of a class.
+   */
+  template <typename CLASS,
+            int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename Number2,
+            typename VectorType>
+  void
+  compute_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number2> &                  constraints,
+    VectorType &                                        diagonal_global,
+    void (CLASS::*cell_operation)(FEEvaluation<dim,
+                                               fe_degree,
+                                               n_q_points_1d,
+                                               n_components,
+                                               Number,
+                                               VectorizedArrayType> &) const,
+    const CLASS *      owning_class,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Compute the matrix of a linear operator given by a matrix-free cell
+   * kernel and add it into @p matrix. The cell matrices are computed as in
+   * compute_diagonal() and passed to
+   * AffineConstraints::distribute_local_to_global(). Thus, @p matrix must
+   * have a sparsity pattern that contains the couplings of the condensed
+   * operator, e.g. one created by DoFTools::make_sparsity_pattern() with the
+   * same constraints. This allows to assemble the matrix of the coarse-level
+   * problem of a multigrid method for an algebraic solver such as
+   * TrilinosWrappers::PreconditionAMG without writing a separate assembly
+   * routine.
+   *
+   * The matrix is compressed at the end.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType = VectorizedArray<Number>,
+            typename Number2,
+            typename MatrixType>
+  void
+  compute_matrix(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number2> &                  constraints,
+    MatrixType &                                        matrix,
+    const typename identity<
+      std::function<void(FEEvaluation<dim,
+                                      fe_degree,
+                                      n_q_points_1d,
+                                      n_components,
+                                      Number,
+                                      VectorizedArrayType> &)>>::type
+      &local_vmult,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Same as above but with the kernel given as a member function of a class.
+   */
+  template <typename CLASS,
+            int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename Number2,
+            typename MatrixType>
+  void
+  compute_matrix(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number2> &                  constraints,
+    MatrixType &                                        matrix,
+    void (CLASS::*cell_operation)(FEEvaluation<dim,
+                                               fe_degree,
+                                               n_q_points_1d,
+                                               n_components,
+                                               Number,
+                                               VectorizedArrayType> &) const,
+    const CLASS *      owning_class,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+  /**
+   * Compute the error indicator of Kelly, Gago, Zienkiewicz and Babuska for
+   * the scalar field @p solution, i.e., the same quantity as
+   * KellyErrorEstimator::estimate() with the default strategy
+   * KellyErrorEstimator::cell_diameter_over_24, no coefficient, and no
+   * Neumann boundary data:
+   * @f[
+   *   \eta_K^2 = \frac{h_K}{24} \sum_{F\in\partial K \setminus \Gamma}
+   *   \int_F \left[\frac{\partial u_h}{\partial n}\right]^2 \; ds.
+   * @f]
+   *
+   * Rather than integrating over the faces of each cell with FEFaceValues,
+   * which visits each interior face twice, this function loops over the
+   * face batches of @p matrix_free and evaluates the jump of the normal
+   * derivative with a pair of FEFaceEvaluation objects, visiting each face
+   * once and working on several faces at a time through vectorization. The
+   * integral over a face is then added to the cells on both sides of the
+   * face. At hanging nodes, the integral over a subface is added to the
+   * refined cell and, as one part of the face of the coarser cell, to the
+   * coarser cell.
+   *
+   * The object @p matrix_free must have been set up for the active cells
+   * with face data, i.e., with
+   * MatrixFree::AdditionalData::mapping_update_flags_inner_faces containing
+   * at least update_gradients, update_JxW_values and update_normal_vectors.
+   * In parallel, MatrixFree::AdditionalData::hold_all_faces_to_owned_cells
+   * must be set such that the faces to ghost cells are available on both
+   * processors. The vector @p solution must be initialized by
+   * MatrixFree::initialize_dof_vector(); its ghost values are updated by
+   * this function if necessary.
+   *
+   * The vector @p error_per_cell is resized to the number of
+   * active cells of the triangulation and indexed by
+   * CellAccessor::active_cell_index(). The entries of cells that are not
+   * locally owned are set to zero.
+   *
+   * The template arguments @p fe_degree and @p n_q_points_1d are those of
+   * the FEFaceEvaluation objects; pass -1 and 0 to select the degree at run
+   * time. The face quadrature is the one selected by @p quad_no, and
+   * @p first_selected_component selects the base element of an FESystem as
+   * in the constructor of FEFaceEvaluation.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  estimate_kelly_error(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const LinearAlgebra::distributed::Vector<Number> &  solution,
+    Vector<float> &                                     error_per_cell,
+    const unsigned int                                  dof_no  = 0,
+    const unsigned int                                  quad_no = 0,
+    const unsigned int first_selected_component                 = 0);
+
+
+
+#ifndef DOXYGEN
+
+  namespace internal
+  {
+    /**
+     * Compute the matrices of the cells in the given cell batch by applying
+     * the kernel to the unit vectors, and return the global indices of the
+     * degrees of freedom of each lane in the order used by FEEvaluation.
+     * Unused lanes of the batch get empty index arrays.
+     */
+    template <int dim,
+              int fe_degree,
+              int n_q_points_1d,
+              int n_components,
+              typename Number,
+              typename VectorizedArrayType,
+              typename Number2>
+    void
+    compute_cell_matrices(
+      const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+      const unsigned int                                  dof_no,
+      const unsigned int                                  cell,
+      FEEvaluation<dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   n_components,
+                   Number,
+                   VectorizedArrayType> &phi,
+      const std::function<void(FEEvaluation<dim,
+                                            fe_degree,
+                                            n_q_points_1d,
+                                            n_components,
+                                            Number,
+                                            VectorizedArrayType> &)>
+        &                                                local_vmult,
+      const std::vector<unsigned int> &                  lexicographic,
+      const unsigned int                                 first_index,
+      std::vector<FullMatrix<Number2>> &                 cell_matrices,
+      std::vector<std::vector<types::global_dof_index>> &dof_indices)
+    {
+      const unsigned int dofs_per_cell = phi.dofs_per_cell;
+      const unsigned int n_lanes =
+        matrix_free.n_active_entries_per_cell_batch(cell);
+
+      phi.reinit(cell);
+      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+        {
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            phi.begin_dof_values()[i] = Number();
+          phi.begin_dof_values()[j] = Number(1.);
+
+          local_vmult(phi);
+
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              cell_matrices[v](i, j) = phi.begin_dof_values()[i][v];
+        }
+
+      std::vector<types::global_dof_index> cell_dof_indices;
+      for (unsigned int v = 0; v < VectorizedArrayType::n_array_elements; ++v)
+        {
+          dof_indices[v].clear();
+          if (v >= n_lanes)
+            continue;
+
+          const auto cell_iterator =
+            matrix_free.get_cell_iterator(cell, v, dof_no);
+          cell_dof_indices.resize(cell_iterator->get_fe().dofs_per_cell);
+          if (matrix_free.get_mg_level() == numbers::invalid_unsigned_int)
+            cell_iterator->get_dof_indices(cell_dof_indices);
+          else
+            cell_iterator->get_mg_dof_indices(cell_dof_indices);
+
+          dof_indices[v].resize(dofs_per_cell);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            dof_indices[v][i] =
+              cell_dof_indices[lexicographic[first_index + i]];
+        }
+    }
+
+
+
+    template <int dim,
+              int fe_degree,
+              int n_q_points_1d,
+              int n_components,
+              typename Number,
+              typename VectorizedArrayType,
+              typename Number2,
+              typename Operation>
+    void
+    loop_over_cell_matrices(
+      const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+      const std::function<void(FEEvaluation<dim,
+                                            fe_degree,
+                                            n_q_points_1d,
+                                            n_components,
+                                            Number,
+                                            VectorizedArrayType> &)>
+        &                local_vmult,
+      const unsigned int dof_no,
+      const unsigned int quad_no,
+      const unsigned int first_selected_component,
+      const Operation &  operation)
+    {
+      FEEvaluation<dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   n_components,
+                   Number,
+                   VectorizedArrayType>
+        phi(matrix_free, dof_no, quad_no, first_selected_component);
+
+      const FiniteElement<dim> &fe =
+        matrix_free.get_dof_handler(dof_no).get_fe();
+      AssertThrow(fe.n_base_elements() == 1,
+                  ExcMessage("Only finite elements with a single base element "
+                             "are supported"));
+      const std::vector<unsigned int> &lexicographic =
+        matrix_free.get_shape_info(dof_no, quad_no).lexicographic_numbering;
+      const unsigned int first_index =
+        first_selected_component * phi.dofs_per_component;
+      AssertIndexRange(first_index + phi.dofs_per_cell,
+                       lexicographic.size() + 1);
+
+      std::vector<FullMatrix<Number2>> cell_matrices(
+        VectorizedArrayType::n_array_elements,
+        FullMatrix<Number2>(phi.dofs_per_cell, phi.dofs_per_cell));
+      std::vector<std::vector<types::global_dof_index>> dof_indices(
+        VectorizedArrayType::n_array_elements);
+
+      for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+        {
+          compute_cell_matrices(matrix_free,
+                                dof_no,
+                                cell,
+                                phi,
+                                local_vmult,
+                                lexicographic,
+                                first_index,
+                                cell_matrices,
+                                dof_indices);
+          for (unsigned int v = 0;
+               v < matrix_free.n_active_entries_per_cell_batch(cell);
+               ++v)
+            operation(cell_matrices[v], dof_indices[v]);
+        }
+    }
+  } // namespace internal
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename Number2,
+            typename VectorType>
+  void
+  compute_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number2> &                  constraints,
+    VectorType &                                        diagonal_global,
+    const typename identity<
+      std::function<void(FEEvaluation<dim,
+                                      fe_degree,
+                                      n_q_points_1d,
+                                      n_components,
+                                      Number,
+                                      VectorizedArrayType> &)>>::type
+      &local_vmult,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    diagonal_global = 0.;
+
+    // the condensed diagonal entry of a global index g is the sum over the
+    // local entries (i,j) of the cell matrix with weights w_i w_j, where the
+    // pairs (i,w_i) are all local indices that map to g with weight w_i
+    std::vector<std::pair<types::global_dof_index,
+                          std::pair<unsigned int, Number2>>>
+      expanded_indices;
+
+    const auto condense_diagonal =
+      [&](const FullMatrix<Number2> &                 cell_matrix,
+          const std::vector<types::global_dof_index> &dof_indices) {
+        expanded_indices.clear();
+        for (unsigned int i = 0; i < dof_indices.size(); ++i)
+          {
+            const auto *entries =
+              constraints.get_constraint_entries(dof_indices[i]);
+            if (constraints.is_constrained(dof_indices[i]) == false)
+              expanded_indices.emplace_back(dof_indices[i],
+                                            std::make_pair(i, Number2(1.)));
+            else if (entries != nullptr)
+              for (const auto &entry : *entries)
+                expanded_indices.emplace_back(entry.first,
+                                              std::make_pair(i, entry.second));
+          }
+        std::sort(expanded_indices.begin(),
+                  expanded_indices.end(),
+                  [](const std::pair<types::global_dof_index,
+                                     std::pair<unsigned int, Number2>> &a,
+                     const std::pair<types::global_dof_index,
+                                     std::pair<unsigned int, Number2>> &b) {
+                    return a.first < b.first;
+                  });
+
+        for (unsigned int start = 0; start < expanded_indices.size();)
+          {
+            unsigned int end = start + 1;
+            while (end < expanded_indices.size() &&
+                   expanded_indices[end].first == expanded_indices[start].first)
+              ++end;
+
+            Number2 sum = 0.;
+            for (unsigned int i = start; i < end; ++i)
+              for (unsigned int j = start; j < end; ++j)
+                sum += expanded_indices[i].second.second *
+                       expanded_indices[j].second.second *
+                       cell_matrix(expanded_indices[i].second.first,
+                                   expanded_indices[j].second.first);
+            diagonal_global(expanded_indices[start].first) += sum;
+            start = end;
+          }
+      };
+
+    internal::loop_over_cell_matrices<dim,
+                                      fe_degree,
+                                      n_q_points_1d,
+                                      n_components,
+                                      Number,
+                                      VectorizedArrayType,
+                                      Number2>(matrix_free,
+                                               local_vmult,
+                                               dof_no,
+                                               quad_no,
+                                               first_selected_component,
+                                               condense_diagonal);
+
+    diagonal_global.compress(VectorOperation::add);
+  }
+
+
+
+  template <typename CLASS,
+            int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename Number2,
+            typename VectorType>
+  void
+  compute_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number2> &                  constraints,
+    VectorType &                                        diagonal_global,
+    void (CLASS::*cell_operation)(FEEvaluation<dim,
+                                               fe_degree,
+                                               n_q_points_1d,
+                                               n_components,
+                                               Number,
+                                               VectorizedArrayType> &) const,
+    const CLASS *      owning_class,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    compute_diagonal<dim,
+                     fe_degree,
+                     n_q_points_1d,
+                     n_components,
+                     Number,
+                     VectorizedArrayType>(
+      matrix_free,
+      constraints,
+      diagonal_global,
+      [&](FEEvaluation<dim,
+                       fe_degree,
+                       n_q_points_1d,
+                       n_components,
+                       Number,
+                       VectorizedArrayType> &phi) {
+        (owning_class->*cell_operation)(phi);
+      },
+      dof_no,
+      quad_no,
+      first_selected_component);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename Number2,
+            typename MatrixType>
+  void
+  compute_matrix(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number2> &                  constraints,
+    MatrixType &                                        matrix,
+    const typename identity<
+      std::function<void(FEEvaluation<dim,
+                                      fe_degree,
+                                      n_q_points_1d,
+                                      n_components,
+                                      Number,
+                                      VectorizedArrayType> &)>>::type
+      &local_vmult,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    internal::loop_over_cell_matrices<dim,
+                                      fe_degree,
+                                      n_q_points_1d,
+                                      n_components,
+                                      Number,
+                                      VectorizedArrayType,
+                                      Number2>(
+      matrix_free,
+      local_vmult,
+      dof_no,
+      quad_no,
+      first_selected_component,
+      [&](const FullMatrix<Number2> &                 cell_matrix,
+          const std::vector<types::global_dof_index> &dof_indices) {
+        constraints.distribute_local_to_global(cell_matrix,
+                                               dof_indices,
+                                               matrix);
+      });
+
+    matrix.compress(VectorOperation::add);
+  }
+
+
+
+  template <typename CLASS,
+            int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename Number2,
+            typename MatrixType>
+  void
+  compute_matrix(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<Number2> &                  constraints,
+    MatrixType &                                        matrix,
+    void (CLASS::*cell_operation)(FEEvaluation<dim,
+                                               fe_degree,
+                                               n_q_points_1d,
+                                               n_components,
+                                               Number,
+                                               VectorizedArrayType> &) const,
+    const CLASS *      owning_class,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    compute_matrix<dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   n_components,
+                   Number,
+                   VectorizedArrayType>(
+      matrix_free,
+      constraints,
+      matrix,
+      [&](FEEvaluation<dim,
+                       fe_degree,
+                       n_q_points_1d,
+                       n_components,
+                       Number,
+                       VectorizedArrayType> &phi) {
+        (owning_class->*cell_operation)(phi);
+      },
+      dof_no,
+      quad_no,
+      first_selected_component);
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  estimate_kelly_error(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const LinearAlgebra::distributed::Vector<Number> &  solution,
+    Vector<float> &                                     error_per_cell,
+    const unsigned int                                  dof_no,
+    const unsigned int                                  quad_no,
+    const unsigned int first_selected_component)
+  {
+    Assert(matrix_free.get_mg_level() == numbers::invalid_unsigned_int,
+           ExcMessage("The error estimator can only be computed on the "
+                      "active cells."));
+
+    constexpr unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+
+    const bool ghosts_were_set = solution.has_ghost_elements();
+    if (!ghosts_were_set)
+      solution.update_ghost_values();
+
+    using FaceEvaluation = FEFaceEvaluation<dim,
+                                            fe_degree,
+                                            n_q_points_1d,
+                                            1,
+                                            Number,
+                                            VectorizedArrayType>;
+    FaceEvaluation phi_m(
+      matrix_free, true, dof_no, quad_no, first_selected_component);
+    FaceEvaluation phi_p(
+      matrix_free, false, dof_no, quad_no, first_selected_component);
+
+    // the sum of the face integrals for all cells in the numbering of
+    // matrix_free, including the ghost cells adjacent to the faces
+    std::vector<double> squared_jumps(
+      (matrix_free.n_cell_batches() + matrix_free.n_ghost_cell_batches()) *
+        n_lanes,
+      0.);
+
+    // the faces of locally owned cells are the interior faces between
+    // locally owned cells, plus the faces to ghost cells stored on the other
+    // processor; boundary faces do not contribute
+    const unsigned int n_inner_faces = matrix_free.n_inner_face_batches();
+    const unsigned int n_boundary_faces = matrix_free.n_boundary_face_batches();
+    const unsigned int n_ghost_faces = matrix_free.n_ghost_inner_face_batches();
+    for (unsigned int face = 0; face < n_inner_faces + n_ghost_faces; ++face)
+      {
+        const unsigned int face_index =
+          (face < n_inner_faces) ? face : face + n_boundary_faces;
+
+        phi_m.reinit(face_index);
+        phi_m.read_dof_values(solution);
+        phi_m.evaluate(false, true);
+        phi_p.reinit(face_index);
+        phi_p.read_dof_values(solution);
+        phi_p.evaluate(false, true);
+
+        VectorizedArrayType face_integral = VectorizedArrayType();
+        for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+          {
+            const VectorizedArrayType jump =
+              phi_m.get_normal_derivative(q) - phi_p.get_normal_derivative(q);
+            face_integral += jump * jump * phi_m.JxW(q);
+          }
+
+        const auto &face_info = matrix_free.get_face_info(face_index);
+        for (unsigned int v = 0;
+             v < matrix_free.n_active_entries_per_face_batch(face_index);
+             ++v)
+          {
+            squared_jumps[face_info.cells_interior[v]] += face_integral[v];
+            squared_jumps[face_info.cells_exterior[v]] += face_integral[v];
+          }
+      }
+
+    if (!ghosts_were_set)
+      solution.zero_out_ghosts();
+
+    const Triangulation<dim> &tria =
+      matrix_free.get_dof_handler(dof_no).get_triangulation();
+    error_per_cell.reinit(tria.n_active_cells());
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          const typename DoFHandler<dim>::cell_iterator dof_cell =
+            matrix_free.get_cell_iterator(cell, v, dof_no);
+          error_per_cell(dof_cell->active_cell_index()) = std::sqrt(
+            squared_jumps[cell * n_lanes + v] * dof_cell->diameter() / 24.);
+        }
+  }
+
+#endif // DOXYGEN
+
+} // namespace MatrixFreeTools
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+
+#endif
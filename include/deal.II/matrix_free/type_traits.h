@@ -259,6 +259,34 @@ namespace internal
 
 
 
+  // same as above, but additionally check that the entries of the vector T
+  // are of type Number, as the custom data exchange route works on buffers
+  // of that type. Other vectors, e.g., complex-valued vectors used with a
+  // MatrixFree object for real numbers, use the data exchange of the vector
+  // itself
+  template <typename T, typename Number>
+  struct has_exchange_on_subset_of_type
+  {
+  private:
+    static std::false_type
+    detect(...);
+
+    template <typename U>
+    static typename std::is_same<typename U::value_type, Number>::type
+    detect(const U &);
+
+  public:
+    static const bool value =
+      has_exchange_on_subset<T>::value &&
+      decltype(detect(std::declval<T>()))::value;
+  };
+
+  // We need to have a separate declaration for static const members
+  template <typename T, typename Number>
+  const bool has_exchange_on_subset_of_type<T, Number>::value;
+
+
+
   // a helper type-trait that leverage SFINAE to figure out if type T has
   // T::communication_block_size
   template <typename T>
@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/graph_coloring.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/work_stream.h>
 
@@ -96,169 +97,101 @@ namespace MeshWorker
       // remove the template layers to retrieve the underlying iterator type.
       using type = typename CellIteratorBaseType<CellIteratorType>::type;
     };
-  } // namespace internal
-
-  /**
-   * This function extends the WorkStream concept to work on meshes
-   * (cells and/or faces) and handles the complicated logic for
-   * work on adaptively refined faces
-   * and parallel computation (work on faces to ghost neighbors for example).
-   * The @p mesh_loop can be used to simplify operations on cells (for example
-   * assembly), on boundaries (Neumann type boundary conditions), or on
-   * interior faces (for example in discontinuous Galerkin methods).
-   *
-   * For uniformly refined meshes, it would be relatively easy to use
-   * WorkStream::run() with a @p cell_worker that also loops over faces, and
-   * takes care of assembling face terms depending on the current and neighbor
-   * cell. All user codes that do these loops would then need to insert
-   * manually the logic that identifies, for every face of the current cell,
-   * the neighboring cell, and the face index on the neighboring cell that
-   * corresponds to the current face.
-   *
-   * This is more complicated if local refinement is enabled and the current or
-   * neighbor cells have hanging nodes. In this case it is also necessary to
-   * identify the corresponding subface on either the current or the neighbor
-   * faces.
-   *
-   * This method externalises that logic (which is independent from user codes)
-   * and separates the assembly of face terms (internal faces, boundary faces,
-   * or faces between different subdomain ids on parallel computations) from
-   * the assembling on cells, allowing the user to specify two additional
-   * workers (a @p cell_worker, a @p boundary_worker, and a @p face_worker) that
-   * are called automatically in each @p cell, according to the specific
-   * AssembleFlags @p flags that are passed. The @p cell_worker is passed the
-   * cell identifier, a ScratchData object, and a CopyData object, following
-   * the same principles of WorkStream::run. Internally the function passes to
-   * @p boundary_worker, in addition to the above, also a @p face_no parameter
-   * that identifies the face on which the integration should be performed. The
-   * @p face_worker instead needs to identify the current face unambiguously
-   * both on the cell and on the neighboring cell, and it is therefore called
-   * with six arguments (three for each cell: the actual cell, the face index,
-   * and the subface_index. If no subface integration is needed, then the
-   * subface_index is numbers::invalid_unsigned_int) in addition to the usual
-   * ScratchData and CopyData objects.
-   *
-   * If the flag AssembleFlags::assemble_own_cells is passed, then the default
-   * behavior is to first loop over faces and do the work there, and then
-   * compute the actual work on the cell. It is possible to perform the
-   * integration on the cells after working on faces, by adding the flag
-   * AssembleFlags::cells_after_faces.
-   *
-   * If the flag AssembleFlags::assemble_own_interior_faces_once is specified,
-   * then each interior face is visited only once, and the @p face_worker is
-   * assumed to integrate all face terms at once (and add contributions to both
-   * sides of the face in a discontinuous Galerkin setting).
-   *
-   * This method is equivalent to the WorkStream::run() method when
-   * AssembleFlags contains only @p assemble_own_cells, and can be used as a
-   * drop-in replacement for that method.
-   *
-   * The two data types ScratchData and CopyData need to have a working copy
-   * constructor. ScratchData is only used in the worker function, while
-   * CopyData is the object passed from the worker to the copier.
-   *
-   * The queue_length argument indicates the number of items that can be live at
-   * any given time. Each item consists of chunk_size elements of the input
-   * stream that will be worked on by the worker and copier functions one after
-   * the other on the same thread.
-   *
-   * If your data objects are large, or their constructors are expensive, it is
-   * helpful to keep in mind that queue_length copies of the ScratchData object
-   * and queue_length*chunk_size copies of the CopyData object are generated.
-   *
-   * @note More information about requirements on template types and meaning
-   * of @p queue_length and @p chunk_size can be found in the documentation of the
-   * WorkStream namespace and its members.
-   *
-   * @ingroup MeshWorker
-   * @author Luca Heltai and Timo Heister, 2017
-   */
-  template <class CellIteratorType,
-            class ScratchData,
-            class CopyData,
-            class CellIteratorBaseType =
-              typename internal::CellIteratorBaseType<CellIteratorType>::type>
-  void
-  mesh_loop(
-    const CellIteratorType &                         begin,
-    const typename identity<CellIteratorType>::type &end,
 
-    const typename identity<std::function<
-      void(const CellIteratorBaseType &, ScratchData &, CopyData &)>>::type
-      &cell_worker,
-    const typename identity<std::function<void(const CopyData &)>>::type
-      &copier,
-
-    const ScratchData &sample_scratch_data,
-    const CopyData &   sample_copy_data,
+    /**
+     * Check that the @p flags passed to mesh_loop() are consistent with
+     * each other and with the workers that are given.
+     */
+    template <class CellIteratorBaseType, class ScratchData, class CopyData>
+    void
+    check_mesh_loop_arguments(
+      const AssembleFlags flags,
+      const std::function<
+        void(const CellIteratorBaseType &, ScratchData &, CopyData &)>
+        &cell_worker,
+      const std::function<void(const CellIteratorBaseType &,
+                               const unsigned int,
+                               ScratchData &,
+                               CopyData &)> &boundary_worker,
+      const std::function<void(const CellIteratorBaseType &,
+                               const unsigned int,
+                               const unsigned int,
+                               const CellIteratorBaseType &,
+                               const unsigned int,
+                               const unsigned int,
+                               ScratchData &,
+                               CopyData &)> &face_worker)
+    {
+      (void)flags;
+      (void)cell_worker;
+      (void)boundary_worker;
+      (void)face_worker;
+
+      Assert(
+        (!cell_worker) == !(flags & work_on_cells),
+        ExcMessage(
+          "If you specify a cell_worker, you need to set assemble_own_cells or assemble_ghost_cells."));
+
+      Assert(
+        (flags & (assemble_own_interior_faces_once |
+                  assemble_own_interior_faces_both)) !=
+          (assemble_own_interior_faces_once | assemble_own_interior_faces_both),
+        ExcMessage(
+          "You can only specify assemble_own_interior_faces_once OR assemble_own_interior_faces_both."));
+
+      Assert(
+        (flags & (assemble_ghost_faces_once | assemble_ghost_faces_both)) !=
+          (assemble_ghost_faces_once | assemble_ghost_faces_both),
+        ExcMessage(
+          "You can only specify assemble_ghost_faces_once OR assemble_ghost_faces_both."));
+
+      Assert(
+        !(flags & cells_after_faces) ||
+          (flags & (assemble_own_cells | assemble_ghost_cells)),
+        ExcMessage(
+          "The option cells_after_faces only makes sense if you assemble on cells."));
+
+      Assert((!face_worker) == !(flags & work_on_faces),
+             ExcMessage(
+               "If you specify a face_worker, assemble_face_* needs to be set."));
+
+      Assert(
+        (!boundary_worker) == !(flags & assemble_boundary_faces),
+        ExcMessage(
+          "If you specify a boundary_worker, assemble_boundary_faces needs to be set."));
+    }
 
-    const AssembleFlags flags = assemble_own_cells,
 
-    const typename identity<std::function<void(const CellIteratorBaseType &,
-                                               const unsigned int,
-                                               ScratchData &,
-                                               CopyData &)>>::type
-      &boundary_worker = std::function<void(const CellIteratorBaseType &,
-                                            const unsigned int,
-                                            ScratchData &,
-                                            CopyData &)>(),
 
-    const typename identity<std::function<void(const CellIteratorBaseType &,
-                                               const unsigned int,
-                                               const unsigned int,
-                                               const CellIteratorBaseType &,
-                                               const unsigned int,
-                                               const unsigned int,
-                                               ScratchData &,
-                                               CopyData &)>>::type
-      &face_worker = std::function<void(const CellIteratorBaseType &,
-                                        const unsigned int,
-                                        const unsigned int,
-                                        const CellIteratorBaseType &,
-                                        const unsigned int,
-                                        const unsigned int,
-                                        ScratchData &,
-                                        CopyData &)>(),
-
-    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
-    const unsigned int chunk_size   = 8)
-  {
-    Assert(
-      (!cell_worker) == !(flags & work_on_cells),
-      ExcMessage(
-        "If you specify a cell_worker, you need to set assemble_own_cells or assemble_ghost_cells."));
-
-    Assert(
-      (flags &
-       (assemble_own_interior_faces_once | assemble_own_interior_faces_both)) !=
-        (assemble_own_interior_faces_once | assemble_own_interior_faces_both),
-      ExcMessage(
-        "You can only specify assemble_own_interior_faces_once OR assemble_own_interior_faces_both."));
-
-    Assert(
-      (flags & (assemble_ghost_faces_once | assemble_ghost_faces_both)) !=
-        (assemble_ghost_faces_once | assemble_ghost_faces_both),
-      ExcMessage(
-        "You can only specify assemble_ghost_faces_once OR assemble_ghost_faces_both."));
-
-    Assert(
-      !(flags & cells_after_faces) ||
-        (flags & (assemble_own_cells | assemble_ghost_cells)),
-      ExcMessage(
-        "The option cells_after_faces only makes sense if you assemble on cells."));
-
-    Assert((!face_worker) == !(flags & work_on_faces),
-           ExcMessage(
-             "If you specify a face_worker, assemble_face_* needs to be set."));
-
-    Assert(
-      (!boundary_worker) == !(flags & assemble_boundary_faces),
-      ExcMessage(
-        "If you specify a boundary_worker, assemble_boundary_faces needs to be set."));
-
-    auto cell_action = [&](const CellIteratorBaseType &cell,
-                           ScratchData &               scratch,
-                           CopyData &                  copy) {
+    /**
+     * Do the work mesh_loop() has to do on the cell @p cell and its faces,
+     * i.e., reset @p copy to @p sample_copy_data and call the workers
+     * according to @p flags.
+     */
+    template <class CellIteratorBaseType, class ScratchData, class CopyData>
+    void
+    mesh_loop_cell_action(
+      const CellIteratorBaseType &cell,
+      ScratchData &               scratch,
+      CopyData &                  copy,
+      const CopyData &            sample_copy_data,
+      const AssembleFlags         flags,
+      const std::function<
+        void(const CellIteratorBaseType &, ScratchData &, CopyData &)>
+        &cell_worker,
+      const std::function<void(const CellIteratorBaseType &,
+                               const unsigned int,
+                               ScratchData &,
+                               CopyData &)> &boundary_worker,
+      const std::function<void(const CellIteratorBaseType &,
+                               const unsigned int,
+                               const unsigned int,
+                               const CellIteratorBaseType &,
+                               const unsigned int,
+                               const unsigned int,
+                               ScratchData &,
+                               CopyData &)> &face_worker)
+    {
       // First reset the CopyData class to the empty copy_data given by the
       // user.
       copy = sample_copy_data;
@@ -443,6 +376,150 @@ namespace MeshWorker
           (((flags & assemble_own_cells) && own_cell) ||
            ((flags & assemble_ghost_cells) && !own_cell)))
         cell_worker(cell, scratch, copy);
+    }
+  } // namespace internal
+
+  /**
+   * This function extends the WorkStream concept to work on meshes
+   * (cells and/or faces) and handles the complicated logic for
+   * work on adaptively refined faces
+   * and parallel computation (work on faces to ghost neighbors for example).
+   * The @p mesh_loop can be used to simplify operations on cells (for example
+   * assembly), on boundaries (Neumann type boundary conditions), or on
+   * interior faces (for example in discontinuous Galerkin methods).
+   *
+   * For uniformly refined meshes, it would be relatively easy to use
+   * WorkStream::run() with a @p cell_worker that also loops over faces, and
+   * takes care of assembling face terms depending on the current and neighbor
+   * cell. All user codes that do these loops would then need to insert
+   * manually the logic that identifies, for every face of the current cell,
+   * the neighboring cell, and the face index on the neighboring cell that
+   * corresponds to the current face.
+   *
+   * This is more complicated if local refinement is enabled and the current or
+   * neighbor cells have hanging nodes. In this case it is also necessary to
+   * identify the corresponding subface on either the current or the neighbor
+   * faces.
+   *
+   * This method externalises that logic (which is independent from user codes)
+   * and separates the assembly of face terms (internal faces, boundary faces,
+   * or faces between different subdomain ids on parallel computations) from
+   * the assembling on cells, allowing the user to specify two additional
+   * workers (a @p cell_worker, a @p boundary_worker, and a @p face_worker) that
+   * are called automatically in each @p cell, according to the specific
+   * AssembleFlags @p flags that are passed. The @p cell_worker is passed the
+   * cell identifier, a ScratchData object, and a CopyData object, following
+   * the same principles of WorkStream::run. Internally the function passes to
+   * @p boundary_worker, in addition to the above, also a @p face_no parameter
+   * that identifies the face on which the integration should be performed. The
+   * @p face_worker instead needs to identify the current face unambiguously
+   * both on the cell and on the neighboring cell, and it is therefore called
+   * with six arguments (three for each cell: the actual cell, the face index,
+   * and the subface_index. If no subface integration is needed, then the
+   * subface_index is numbers::invalid_unsigned_int) in addition to the usual
+   * ScratchData and CopyData objects.
+   *
+   * If the flag AssembleFlags::assemble_own_cells is passed, then the default
+   * behavior is to first loop over faces and do the work there, and then
+   * compute the actual work on the cell. It is possible to perform the
+   * integration on the cells after working on faces, by adding the flag
+   * AssembleFlags::cells_after_faces.
+   *
+   * If the flag AssembleFlags::assemble_own_interior_faces_once is specified,
+   * then each interior face is visited only once, and the @p face_worker is
+   * assumed to integrate all face terms at once (and add contributions to both
+   * sides of the face in a discontinuous Galerkin setting).
+   *
+   * This method is equivalent to the WorkStream::run() method when
+   * AssembleFlags contains only @p assemble_own_cells, and can be used as a
+   * drop-in replacement for that method.
+   *
+   * The two data types ScratchData and CopyData need to have a working copy
+   * constructor. ScratchData is only used in the worker function, while
+   * CopyData is the object passed from the worker to the copier.
+   *
+   * The queue_length argument indicates the number of items that can be live at
+   * any given time. Each item consists of chunk_size elements of the input
+   * stream that will be worked on by the worker and copier functions one after
+   * the other on the same thread.
+   *
+   * If your data objects are large, or their constructors are expensive, it is
+   * helpful to keep in mind that queue_length copies of the ScratchData object
+   * and queue_length*chunk_size copies of the CopyData object are generated.
+   *
+   * @note More information about requirements on template types and meaning
+   * of @p queue_length and @p chunk_size can be found in the documentation of the
+   * WorkStream namespace and its members.
+   *
+   * @ingroup MeshWorker
+   * @author Luca Heltai and Timo Heister, 2017
+   */
+  template <class CellIteratorType,
+            class ScratchData,
+            class CopyData,
+            class CellIteratorBaseType =
+              typename internal::CellIteratorBaseType<CellIteratorType>::type>
+  void
+  mesh_loop(
+    const CellIteratorType &                         begin,
+    const typename identity<CellIteratorType>::type &end,
+
+    const typename identity<std::function<
+      void(const CellIteratorBaseType &, ScratchData &, CopyData &)>>::type
+      &cell_worker,
+    const typename identity<std::function<void(const CopyData &)>>::type
+      &copier,
+
+    const ScratchData &sample_scratch_data,
+    const CopyData &   sample_copy_data,
+
+    const AssembleFlags flags = assemble_own_cells,
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &boundary_worker = std::function<void(const CellIteratorBaseType &,
+                                            const unsigned int,
+                                            ScratchData &,
+                                            CopyData &)>(),
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &face_worker = std::function<void(const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        ScratchData &,
+                                        CopyData &)>(),
+
+    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+    const unsigned int chunk_size   = 8)
+  {
+    internal::check_mesh_loop_arguments(flags,
+                                        cell_worker,
+                                        boundary_worker,
+                                        face_worker);
+
+    auto cell_action = [&](const CellIteratorBaseType &cell,
+                           ScratchData &               scratch,
+                           CopyData &                  copy) {
+      internal::mesh_loop_cell_action(cell,
+                                      scratch,
+                                      copy,
+                                      sample_copy_data,
+                                      flags,
+                                      cell_worker,
+                                      boundary_worker,
+                                      face_worker);
     };
 
     // Submit to workstream
@@ -590,6 +667,176 @@ namespace MeshWorker
                                     chunk_size);
   }
 
+  /**
+   * Compute a partitioning of the cells in the range from @p begin to @p end
+   * into colors such that mesh_loop() can be called with the same @p flags
+   * on all cells of one color concurrently, including the copier. The
+   * result is meant to be passed to the variant of mesh_loop() that takes
+   * colored iterators.
+   *
+   * Two cells receive different colors if they share a vertex. Since the
+   * copier of a cell may also write into the degrees of freedom of a
+   * neighbor, two cells also receive different colors if one of them shares
+   * a vertex with a neighbor of the other one whose degrees of freedom may
+   * be touched: this is the case for all neighbors across faces that are
+   * worked on if @p flags contains any of the face assembly flags, and for
+   * coarser neighbors in any case, since the constraints of hanging nodes
+   * on the refined side couple to the degrees of freedom of the coarser
+   * neighbor. This covers the global degrees of freedom touched by a copier
+   * that uses AffineConstraints::distribute_local_to_global() with hanging
+   * node constraints. If other constraints couple degrees of freedom over
+   * larger distances, e.g., periodicity constraints, the user has to
+   * compute a suitable coloring with GraphColoring::make_graph_coloring()
+   * instead.
+   *
+   * The computation of the coloring is relatively expensive compared to a
+   * single assembly. The result stays valid as long as the mesh is not
+   * changed, so it should be computed once and stored alongside the
+   * DoFHandler it is used with, rather than being recomputed for every call
+   * to mesh_loop().
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CellIteratorType>
+  std::vector<std::vector<CellIteratorType>>
+  make_colored_iterators(
+    const CellIteratorType &                         begin,
+    const typename identity<CellIteratorType>::type &end,
+    const AssembleFlags                              flags = assemble_own_cells)
+  {
+    if (begin == end)
+      return std::vector<std::vector<CellIteratorType>>();
+
+    const auto get_conflict_indices = [flags](const CellIteratorType &cell) {
+      std::vector<types::global_dof_index> conflict_indices;
+
+      const unsigned int dim =
+        CellIteratorType::AccessorType::Container::dimension;
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        conflict_indices.push_back(cell->vertex_index(v));
+
+      for (unsigned int face_no = 0;
+           face_no < GeometryInfo<dim>::faces_per_cell;
+           ++face_no)
+        if (!cell->at_boundary(face_no) ||
+            cell->has_periodic_neighbor(face_no))
+          {
+            const auto neighbor = cell->neighbor_or_periodic_neighbor(face_no);
+
+            // faces to refined neighbors are worked on from the refined
+            // side when looping over active cells
+            if (dealii::internal::is_active_iterator(cell) &&
+                neighbor->has_children())
+              continue;
+
+            if ((flags & work_on_faces) || (neighbor->level() < cell->level()))
+              for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                   ++v)
+                conflict_indices.push_back(neighbor->vertex_index(v));
+          }
+
+      return conflict_indices;
+    };
+
+    return GraphColoring::make_graph_coloring(begin, end, get_conflict_indices);
+  }
+
+  /**
+   * Same as the mesh_loop() function above, but for cells that have been
+   * partitioned into colors such that no two cells of the same color write
+   * into the same global data, as computed by make_colored_iterators() or
+   * GraphColoring::make_graph_coloring(). The colors are processed one after
+   * the other. Within a color, both the workers and the copier run in
+   * parallel on different cells, i.e., unlike in the other variants of this
+   * function, the copier is not executed sequentially. This avoids the
+   * bottleneck of a single thread copying the local contributions of all
+   * cells into global objects, and therefore scales better to large numbers
+   * of threads. On the other hand, the correctness of the result relies on
+   * the coloring: the @p copier must only touch data that is exclusive to
+   * the cells of one color.
+   *
+   * For the meaning of all other arguments, see the documentation of the
+   * other mesh_loop() variants and of the WorkStream::run() function for
+   * colored iterators.
+   *
+   * @ingroup MeshWorker
+   */
+  template <class CellIteratorType,
+            class ScratchData,
+            class CopyData,
+            class CellIteratorBaseType =
+              typename internal::CellIteratorBaseType<CellIteratorType>::type>
+  void
+  mesh_loop(
+    const std::vector<std::vector<CellIteratorType>> &colored_iterators,
+    const typename identity<std::function<
+      void(const CellIteratorBaseType &, ScratchData &, CopyData &)>>::type
+      &cell_worker,
+    const typename identity<std::function<void(const CopyData &)>>::type
+      &copier,
+
+    const ScratchData &sample_scratch_data,
+    const CopyData &   sample_copy_data,
+
+    const AssembleFlags flags = assemble_own_cells,
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &boundary_worker = std::function<void(const CellIteratorBaseType &,
+                                            const unsigned int,
+                                            ScratchData &,
+                                            CopyData &)>(),
+
+    const typename identity<std::function<void(const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               const CellIteratorBaseType &,
+                                               const unsigned int,
+                                               const unsigned int,
+                                               ScratchData &,
+                                               CopyData &)>>::type
+      &face_worker = std::function<void(const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        const CellIteratorBaseType &,
+                                        const unsigned int,
+                                        const unsigned int,
+                                        ScratchData &,
+                                        CopyData &)>(),
+
+    const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
+    const unsigned int chunk_size   = 8)
+  {
+    internal::check_mesh_loop_arguments(flags,
+                                        cell_worker,
+                                        boundary_worker,
+                                        face_worker);
+
+    auto cell_action = [&](const CellIteratorType &cell,
+                           ScratchData &           scratch,
+                           CopyData &              copy) {
+      internal::mesh_loop_cell_action<CellIteratorBaseType>(cell,
+                                                            scratch,
+                                                            copy,
+                                                            sample_copy_data,
+                                                            flags,
+                                                            cell_worker,
+                                                            boundary_worker,
+                                                            face_worker);
+    };
+
+    // Submit to workstream, the copier is run concurrently within each color
+    WorkStream::run(colored_iterators,
+                    cell_action,
+                    copier,
+                    sample_scratch_data,
+                    sample_copy_data,
+                    queue_length,
+                    chunk_size);
+  }
+
   /**
    * This is a variant of the mesh_loop() function, that can be used for worker
    * and copier functions that are member functions of a class.
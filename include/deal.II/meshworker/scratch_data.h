@@ -22,6 +22,7 @@
 
 #include <deal.II/differentiation/ad.h>
 
+#include <deal.II/fe/fe_interface_values.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
 
@@ -493,6 +494,49 @@ namespace MeshWorker
 
     /** @} */ // NeighborCellMethods
 
+    /**
+     * @name Methods to work on interfaces between cells
+     */
+    /** @{ */ // InterfaceMethods
+
+    /**
+     * Initialize the internal FEInterfaceValues object on the interface of
+     * two cells and return it. The arguments are the ones of the face
+     * worker of MeshWorker::mesh_loop(). The returned object provides the
+     * jumps and averages of the shape functions on the joint set of DoFs of
+     * the two cells, which can be accessed with get_interface_dof_indices().
+     *
+     * The FEInterfaceValues object is set up with the face quadrature and
+     * the face update flags of this object. Contrary to using reinit() and
+     * reinit_neighbor() for the two sides of a face, the geometric data of
+     * the face is only computed once.
+     */
+    const FEInterfaceValues<dim, spacedim> &
+    reinit(
+      const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int                                              face_no,
+      const unsigned int sub_face_no,
+      const typename DoFHandler<dim, spacedim>::active_cell_iterator
+        &                cell_neighbor,
+      const unsigned int face_no_neighbor,
+      const unsigned int sub_face_no_neighbor);
+
+    /**
+     * Get the FEInterfaceValues object initialized by the last call to the
+     * reinit() function for interfaces.
+     */
+    const FEInterfaceValues<dim, spacedim> &
+    get_current_interface_values() const;
+
+    /**
+     * Return the joint DoF indices of the two cells of the interface passed
+     * the last time the reinit() function for interfaces was called.
+     */
+    const std::vector<types::global_dof_index> &
+    get_interface_dof_indices() const;
+
+    /** @} */ // InterfaceMethods
+
     /**
      * Return a GeneralDataStorage object that can be used to store any amount
      * of data, of any type, which is then made accessible by an identifier
@@ -864,6 +908,11 @@ namespace MeshWorker
      */
     std::unique_ptr<FESubfaceValues<dim, spacedim>> neighbor_fe_subface_values;
 
+    /**
+     * Finite element values on the interface of two cells.
+     */
+    std::unique_ptr<FEInterfaceValues<dim, spacedim>> interface_fe_values;
+
     /**
      * Dof indices on the current cell.
      */
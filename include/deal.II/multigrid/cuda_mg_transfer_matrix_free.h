@@ -0,0 +1,415 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_cuda_mg_transfer_matrix_free_h
+#define dealii_cuda_mg_transfer_matrix_free_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_COMPILER_CUDA_AWARE
+
+#  include <deal.II/base/cuda.h>
+#  include <deal.II/base/mg_level_object.h>
+#  include <deal.II/base/smartpointer.h>
+
+#  include <deal.II/dofs/dof_handler.h>
+
+#  include <deal.II/lac/la_parallel_vector.h>
+
+#  include <deal.II/multigrid/mg_base.h>
+#  include <deal.II/multigrid/mg_constrained_dofs.h>
+#  include <deal.II/multigrid/mg_transfer_matrix_free.h>
+
+#  include <memory>
+#  include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace CUDAWrappers
+{
+  /*!@addtogroup mg */
+  /*@{*/
+
+  /**
+   * Implementation of the MGTransferBase interface for vectors stored on the
+   * device, i.e., LinearAlgebra::distributed::Vector with memory space
+   * MemorySpace::CUDA. The transfer is the same as the one of
+   * dealii::MGTransferMatrixFree, and so are the supported elements, the
+   * setup is in fact done by an object of that class on the host in build().
+   * The index arrays and the one-dimensional prolongation matrix are then
+   * copied to the device once, and prolongate() and restrict_and_add() run
+   * on the device: Each CUDA block works on one coarse cell with children,
+   * gathers the degrees of freedom of the cell from the level vector into
+   * shared memory, applies the prolongation matrix (or its transpose)
+   * direction by direction in sum factorization form, and scatters the
+   * result into the other level vector using atomic additions. Together
+   * with CUDAWrappers::MatrixFree for the level operators,
+   * PreconditionChebyshev for the smoothers, and MGCoarseGridOnHost for the
+   * coarse level, a complete V-cycle of the Multigrid class runs on the
+   * device, and only the coarse level vectors are moved to the host:
+   * @code
+   *   using VectorType =
+   *     LinearAlgebra::distributed::Vector<double, MemorySpace::CUDA>;
+   *
+   *   CUDAWrappers::MGTransferMatrixFree<dim, double> mg_transfer(
+   *     mg_constrained_dofs);
+   *   mg_transfer.build(dof_handler);
+   *
+   *   MGCoarseGridHouseholder<double, LinearAlgebra::distributed::Vector<
+   *     double, MemorySpace::Host>> host_coarse(coarse_matrix);
+   *   CUDAWrappers::MGCoarseGridOnHost<double> mg_coarse(host_coarse);
+   *
+   *   mg::Matrix<VectorType> mg_matrix(level_operators);
+   *   Multigrid<VectorType> mg(mg_matrix, mg_coarse, mg_transfer,
+   *                            mg_smoother, mg_smoother);
+   *   PreconditionMG<dim, VectorType,
+   *                  CUDAWrappers::MGTransferMatrixFree<dim, double>>
+   *     preconditioner(dof_handler, mg, mg_transfer);
+   * @endcode
+   * The diagonal needed by the Chebyshev smoother is computed once during
+   * the setup, e.g. on the host, and copied to the device with
+   * LinearAlgebra::distributed::Vector::import().
+   *
+   * The functions copy_to_mg() and copy_from_mg() run on the device if the
+   * mesh is globally refined. On locally refined meshes, they go through
+   * the transfer functions of dealii::MGTransferMatrixFree on the host.
+   *
+   * Because of the size of the shared memory, the kernels are limited to
+   * polynomial degrees up to 6 in 3D for continuous elements.
+   */
+  template <int dim, typename Number>
+  class MGTransferMatrixFree
+    : public MGTransferBase<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>>
+  {
+  public:
+    /**
+     * The vector type of the level vectors.
+     */
+    using VectorType =
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>;
+
+    /**
+     * This class does not support a vector of DoFHandler objects as
+     * PreconditionMG may pass to the copy functions.
+     */
+    static const bool supports_dof_handler_vector = false;
+
+    /**
+     * Constructor without constraint matrices. Use this constructor only
+     * with discontinuous finite elements or with no local refinement.
+     */
+    MGTransferMatrixFree();
+
+    /**
+     * Constructor with constraints. Equivalent to the default constructor
+     * followed by initialize_constraints().
+     */
+    MGTransferMatrixFree(const MGConstrainedDoFs &mg_constrained_dofs);
+
+    /**
+     * Destructor.
+     */
+    virtual ~MGTransferMatrixFree() override = default;
+
+    /**
+     * Initialize the constraints to be used in build().
+     */
+    void
+    initialize_constraints(const MGConstrainedDoFs &mg_constrained_dofs);
+
+    /**
+     * Reset the object to the state it had right after the default
+     * constructor.
+     */
+    void
+    clear();
+
+    /**
+     * Build the information for the transfer on the host and copy it to the
+     * device.
+     */
+    void
+    build(const DoFHandler<dim, dim> &mg_dof);
+
+    /**
+     * Prolongate a vector from level <tt>to_level-1</tt> to level
+     * <tt>to_level</tt> on the device, see
+     * dealii::MGTransferMatrixFree::prolongate(). The previous content of
+     * <tt>dst</tt> is overwritten.
+     */
+    virtual void
+    prolongate(const unsigned int to_level,
+               VectorType &       dst,
+               const VectorType & src) const override;
+
+    /**
+     * Restrict a vector from level <tt>from_level</tt> to level
+     * <tt>from_level-1</tt> on the device and add the result to @p dst, see
+     * dealii::MGTransferMatrixFree::restrict_and_add().
+     */
+    virtual void
+    restrict_and_add(const unsigned int from_level,
+                     VectorType &       dst,
+                     const VectorType & src) const override;
+
+    /**
+     * Transfer from a vector on the global grid to vectors defined on each
+     * of the levels separately for the active degrees of freedom. The level
+     * vectors are resized as needed.
+     */
+    void
+    copy_to_mg(const DoFHandler<dim, dim> &mg_dof,
+               MGLevelObject<VectorType> & dst,
+               const VectorType &          src) const;
+
+    /**
+     * Transfer from multi-level vector to normal vector. Copies data from
+     * active portions of a multilevel vector into the respective positions
+     * of a global vector.
+     */
+    void
+    copy_from_mg(const DoFHandler<dim, dim> &     mg_dof,
+                 VectorType &                     dst,
+                 const MGLevelObject<VectorType> &src) const;
+
+    /**
+     * Add a multi-level vector to a normal vector. Works as the previous
+     * function, but probably not for continuous elements.
+     */
+    void
+    copy_from_mg_add(const DoFHandler<dim, dim> &     mg_dof,
+                     VectorType &                     dst,
+                     const MGLevelObject<VectorType> &src) const;
+
+    /**
+     * Memory used by this object on the host and on the device.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The transfer on the host that sets up the data structures in build()
+     * and that is used for copy_to_mg() and copy_from_mg() on locally
+     * refined meshes.
+     */
+    dealii::MGTransferMatrixFree<dim, Number> host_transfer;
+
+    /**
+     * The degree of the finite element.
+     */
+    unsigned int fe_degree;
+
+    /**
+     * Whether the element is continuous.
+     */
+    bool element_is_continuous;
+
+    /**
+     * The number of components of the finite element.
+     */
+    unsigned int n_components;
+
+    /**
+     * The number of degrees of freedom on all children of a cell.
+     */
+    unsigned int n_child_cell_dofs;
+
+    /**
+     * The number of degrees of freedom on a cell, i.e., on the parent in the
+     * transfer.
+     */
+    unsigned int n_parent_cell_dofs;
+
+    /**
+     * The number of cells with children on each level that are processed by
+     * the transfer to the next finer level.
+     */
+    std::vector<unsigned int> n_owned_level_cells;
+
+    /**
+     * The indices of the degrees of freedom of the children of the cells in
+     * #n_owned_level_cells in the ghosted level vector of the finer level,
+     * stored on the device, with #n_child_cell_dofs entries per cell.
+     */
+    std::vector<std::unique_ptr<unsigned int[], void (*)(unsigned int *)>>
+      child_dof_indices;
+
+    /**
+     * The indices of the degrees of freedom of the cells in
+     * #n_owned_level_cells in the ghosted level vector of the level, in
+     * lexicographic order, stored on the device, with
+     * #n_parent_cell_dofs entries per cell. Degrees of freedom subject to
+     * Dirichlet boundary conditions are marked by
+     * numbers::invalid_unsigned_int.
+     */
+    std::vector<std::unique_ptr<unsigned int[], void (*)(unsigned int *)>>
+      parent_dof_indices;
+
+    /**
+     * The weights of the degrees of freedom on the children for continuous
+     * elements, with <tt>3<sup>dim</sup></tt> entries per cell, stored on
+     * the device.
+     */
+    std::vector<std::unique_ptr<Number[], void (*)(Number *)>> weights;
+
+    /**
+     * The one-dimensional prolongation matrix, stored on the device.
+     */
+    std::unique_ptr<Number[], void (*)(Number *)> prolongation_matrix_1d;
+
+    /**
+     * The level vectors with the ghost entries needed by the transfer.
+     */
+    mutable MGLevelObject<VectorType> ghosted_level_vector;
+
+    /**
+     * Whether the finest level and the global vector have the same
+     * degrees of freedom, in which case copy_to_mg() and copy_from_mg() run
+     * on the device.
+     */
+    bool perform_plain_copy;
+
+    /**
+     * Whether the finest level and the global vector have the same degrees
+     * of freedom, possibly with a different numbering given by
+     * #copy_indices_global and #copy_indices_level.
+     */
+    bool perform_renumbered_plain_copy;
+
+    /**
+     * The local indices of the global vector and the finest level vector
+     * that are copied for a renumbered plain copy, stored on the device.
+     */
+    std::unique_ptr<unsigned int[], void (*)(unsigned int *)>
+      copy_indices_global;
+    std::unique_ptr<unsigned int[], void (*)(unsigned int *)>
+      copy_indices_level;
+
+    /**
+     * The number of entries of #copy_indices_global and
+     * #copy_indices_level.
+     */
+    unsigned int n_copy_indices;
+
+    /**
+     * Host vectors used by the copy functions on locally refined meshes.
+     */
+    mutable MGLevelObject<LinearAlgebra::distributed::Vector<Number>>
+                                                       host_level_vectors;
+    mutable LinearAlgebra::distributed::Vector<Number> host_global_vector;
+  };
+
+
+
+  /**
+   * A coarse grid solver for level vectors on the device that copies the
+   * coarse level vectors to the host and calls a coarse grid solver working
+   * on host vectors there. This way, direct solvers or other solvers that
+   * are not available on the device can be used on the coarse level, which
+   * usually is small enough that the copies are cheap. See
+   * CUDAWrappers::MGTransferMatrixFree for an example.
+   */
+  template <typename Number>
+  class MGCoarseGridOnHost
+    : public MGCoarseGridBase<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>>
+  {
+  public:
+    /**
+     * The vector type on the device.
+     */
+    using VectorType =
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>;
+
+    /**
+     * The vector type on the host.
+     */
+    using HostVectorType =
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+    /**
+     * Constructor. Store a pointer to the coarse grid solver on the host,
+     * which needs to live as long as the current object.
+     */
+    MGCoarseGridOnHost(const MGCoarseGridBase<HostVectorType> &host_solver);
+
+    /**
+     * Copy @p src to the host, call the coarse grid solver on the host, and
+     * copy the result back to @p dst.
+     */
+    virtual void
+    operator()(const unsigned int level,
+               VectorType &       dst,
+               const VectorType & src) const override;
+
+  private:
+    /**
+     * The coarse grid solver on the host.
+     */
+    SmartPointer<const MGCoarseGridBase<HostVectorType>,
+                 MGCoarseGridOnHost<Number>>
+      host_solver;
+
+    /**
+     * The vectors on the host.
+     */
+    mutable HostVectorType host_src;
+    mutable HostVectorType host_dst;
+  };
+
+  /*@}*/
+
+
+
+  /* ---------------------- inline functions ------------------------------- */
+
+#  ifndef DOXYGEN
+
+  template <typename Number>
+  MGCoarseGridOnHost<Number>::MGCoarseGridOnHost(
+    const MGCoarseGridBase<HostVectorType> &host_solver)
+    : host_solver(&host_solver)
+  {}
+
+
+
+  template <typename Number>
+  void
+  MGCoarseGridOnHost<Number>::operator()(const unsigned int level,
+                                         VectorType &       dst,
+                                         const VectorType & src) const
+  {
+    // import() needs identical partitioners
+    if (host_src.get_partitioner().get() != src.get_partitioner().get())
+      host_src.reinit(src.get_partitioner());
+    if (host_dst.get_partitioner().get() != dst.get_partitioner().get())
+      host_dst.reinit(dst.get_partitioner());
+
+    host_src.import(src, VectorOperation::insert);
+    (*host_solver)(level, host_dst, host_src);
+    dst.import(host_dst, VectorOperation::insert);
+  }
+
+#  endif // DOXYGEN
+
+} // namespace CUDAWrappers
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_COMPILER_CUDA_AWARE
+
+#endif
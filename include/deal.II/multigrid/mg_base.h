@@ -216,6 +216,30 @@ public:
   restrict_and_add(const unsigned int from_level,
                    VectorType &       dst,
                    const VectorType & src) const = 0;
+
+  /**
+   * Start the restriction of a vector from level <tt>from_level</tt> to level
+   * <tt>from_level-1</tt> as in restrict_and_add(). The result is only
+   * available in @p dst after restrict_and_add_finish() has been called with
+   * the same level and vector. In between, the caller may perform other
+   * work, e.g. on level <tt>from_level</tt>, that does not involve @p dst
+   * and @p src. Derived classes with distributed vectors can use this split
+   * to overlap the communication of the restriction with this work.
+   *
+   * The default implementation simply calls restrict_and_add().
+   */
+  virtual void
+  restrict_and_add_start(const unsigned int from_level,
+                         VectorType &       dst,
+                         const VectorType & src) const;
+
+  /**
+   * Complete a restriction started with restrict_and_add_start(). The
+   * default implementation does nothing.
+   */
+  virtual void
+  restrict_and_add_finish(const unsigned int from_level,
+                          VectorType &       dst) const;
 };
 
 
@@ -17,13 +17,23 @@
 #define dealii_mg_coarse_h
 
 
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/partitioner.h>
+
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/householder.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/linear_operator.h>
 #include <deal.II/lac/matrix_lib.h>
 
 #include <deal.II/multigrid/mg_base.h>
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 /*!@addtogroup mg */
@@ -328,6 +338,212 @@ private:
   LAPACKFullMatrix<number> matrix;
 };
 
+
+/**
+ * Coarse grid solver that solves the coarse problem on a subset of the MPI
+ * processes. On the coarsest level of a multigrid hierarchy, the number of
+ * unknowns per process is often tiny, so that an iterative or algebraic
+ * multigrid solver on the full communicator is dominated by the latency of
+ * its global communication. This class gathers the coarse vectors onto a
+ * reduced communicator made up of every @p agglomeration_factor -th process
+ * of the original communicator, calls another coarse grid solver on the
+ * reduced communicator, and scatters the solution back to the original
+ * distribution. The unknowns are evenly divided into contiguous ranges
+ * among the processes of the reduced communicator. An agglomeration factor
+ * at least as large as the number of processes collects the whole coarse
+ * problem on the first process, where it can be solved with a direct
+ * solver.
+ *
+ * The solver on the reduced communicator is set with set_reduced_solver(). It
+ * operates on vectors that are distributed according to
+ * get_reduced_partitioner() over get_reduced_communicator() and is only
+ * called on the processes of the reduced communicator. The matrix of the
+ * reduced problem can be collected from the matrix of the coarse level with
+ * gather_matrix_rows(), for example to set up an algebraic multigrid
+ * preconditioner on the reduced communicator:
+ * @code
+ *   MGCoarseGridReducedCommunicator<double> coarse_grid_solver;
+ *   coarse_grid_solver.initialize(coarse_matrix.locally_owned_range_indices(),
+ *                                 mpi_communicator,
+ *                                 agglomeration_factor);
+ *
+ *   std::vector<std::vector<std::pair<types::global_dof_index, double>>>
+ *     rows;
+ *   coarse_grid_solver.gather_matrix_rows(coarse_matrix, rows);
+ *
+ *   if (coarse_grid_solver.get_reduced_partitioner() != nullptr)
+ *     {
+ *       // build a matrix on the reduced communicator from 'rows', set up
+ *       // the reduced solver, and pass it to set_reduced_solver()
+ *     }
+ * @endcode
+ *
+ * The setup of the communication patterns is done once in initialize(), so
+ * each call to operator() only involves one point-to-point exchange from the
+ * original to the reduced distribution and back.
+ */
+template <typename Number>
+class MGCoarseGridReducedCommunicator
+  : public MGCoarseGridBase<LinearAlgebra::distributed::Vector<Number>>
+{
+public:
+  /**
+   * The type of the vectors on the coarse level.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Default constructor.
+   */
+  MGCoarseGridReducedCommunicator();
+
+  /**
+   * Copy constructor. Deleted since the object owns the reduced
+   * communicator.
+   */
+  MGCoarseGridReducedCommunicator(const MGCoarseGridReducedCommunicator &) =
+    delete;
+
+  /**
+   * Copy assignment. Deleted since the object owns the reduced communicator.
+   */
+  MGCoarseGridReducedCommunicator &
+  operator=(const MGCoarseGridReducedCommunicator &) = delete;
+
+  /**
+   * Destructor. Frees the reduced communicator.
+   */
+  ~MGCoarseGridReducedCommunicator() override;
+
+  /**
+   * Set up the reduced communicator and the communication patterns for
+   * vectors on the coarse level whose locally owned indices are
+   * @p locally_owned_indices on the communicator @p communicator. The
+   * reduced communicator consists of the processes whose rank is a multiple
+   * of @p agglomeration_factor. This is a collective operation on
+   * @p communicator.
+   */
+  void
+  initialize(const IndexSet &   locally_owned_indices,
+             const MPI_Comm &   communicator,
+             const unsigned int agglomeration_factor);
+
+  /**
+   * Set the coarse grid solver that is called on the reduced communicator.
+   * Only a reference to the object is stored, and the argument is ignored on
+   * the processes that are not part of the reduced communicator.
+   */
+  void
+  set_reduced_solver(const MGCoarseGridBase<VectorType> &reduced_solver);
+
+  /**
+   * Free the reduced communicator and clear all data.
+   */
+  void
+  clear();
+
+  /**
+   * Return the reduced communicator. On the processes that are not part of
+   * it, MPI_COMM_NULL is returned.
+   */
+  MPI_Comm
+  get_reduced_communicator() const;
+
+  /**
+   * Return the partitioner of the vectors passed to the reduced solver. On
+   * the processes that are not part of the reduced communicator, a null
+   * pointer is returned.
+   */
+  const std::shared_ptr<const Utilities::MPI::Partitioner> &
+  get_reduced_partitioner() const;
+
+  /**
+   * Collect the rows of @p matrix, which is distributed like the vectors on
+   * the coarse level, on the processes of the reduced communicator. On
+   * return, the entry @p i of @p rows holds the pairs of column indices and
+   * values of the @p i th row locally owned by the reduced partitioner. On
+   * the processes that are not part of the reduced communicator, @p rows is
+   * empty. The matrix type must provide access to the entries of the
+   * locally owned rows through the functions <tt>begin(row)</tt> and
+   * <tt>end(row)</tt>, as all deal.II sparse matrix classes do. This is a
+   * collective operation on the original communicator.
+   */
+  template <typename MatrixType>
+  void
+  gather_matrix_rows(
+    const MatrixType &matrix,
+    std::vector<std::vector<std::pair<types::global_dof_index, Number>>>
+      &rows) const;
+
+  /**
+   * Gather @p src onto the reduced communicator, call the reduced solver
+   * there, and scatter the result to @p dst.
+   */
+  virtual void
+  operator()(const unsigned int level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+private:
+  /**
+   * The communicator of the coarse level.
+   */
+  MPI_Comm communicator;
+
+  /**
+   * The reduced communicator, or MPI_COMM_NULL on processes that are not
+   * part of it. Before initialize() has been called, MPI_COMM_SELF.
+   */
+  MPI_Comm reduced_communicator;
+
+  /**
+   * The first index of the range owned by each process of the reduced
+   * communicator, with an additional entry holding the size of the vectors.
+   */
+  std::vector<types::global_dof_index> reduced_range_starts;
+
+  /**
+   * The agglomeration factor passed to initialize().
+   */
+  unsigned int agglomeration_factor;
+
+  /**
+   * A partitioner on the original communicator whose locally owned indices
+   * are the ones of the coarse level and whose ghost indices are the indices
+   * locally owned by the reduced partitioner. It is used for the transfer
+   * between the two distributions.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> transfer_partitioner;
+
+  /**
+   * The partitioner of the vectors on the reduced communicator.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> reduced_partitioner;
+
+  /**
+   * The local indices in the vectors of transfer_partitioner of the entries
+   * locally owned by the reduced partitioner.
+   */
+  std::vector<unsigned int> reduced_to_transfer_indices;
+
+  /**
+   * Vector used for the transfer between the two distributions.
+   */
+  mutable VectorType transfer_vector;
+
+  /**
+   * Right hand side and solution of the reduced problem.
+   */
+  mutable VectorType reduced_src, reduced_dst;
+
+  /**
+   * Reference to the solver on the reduced communicator.
+   */
+  SmartPointer<const MGCoarseGridBase<VectorType>,
+               MGCoarseGridReducedCommunicator<Number>>
+    reduced_solver;
+};
+
 /*@}*/
 
 #ifndef DOXYGEN
@@ -624,6 +840,269 @@ MGCoarseGridSVD<number, VectorType>::log() const
 }
 
 
+/* ------------------ Functions for MGCoarseGridReducedCommunicator ------- */
+
+template <typename Number>
+MGCoarseGridReducedCommunicator<Number>::MGCoarseGridReducedCommunicator()
+  : communicator(MPI_COMM_SELF)
+  , reduced_communicator(MPI_COMM_SELF)
+  , agglomeration_factor(1)
+{}
+
+
+
+template <typename Number>
+MGCoarseGridReducedCommunicator<Number>::~MGCoarseGridReducedCommunicator()
+{
+  clear();
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridReducedCommunicator<Number>::clear()
+{
+#  ifdef DEAL_II_WITH_MPI
+  // only free the communicator created by initialize()
+  if (reduced_communicator != MPI_COMM_NULL &&
+      reduced_communicator != MPI_COMM_SELF)
+    {
+      int finalized = 0;
+      MPI_Finalized(&finalized);
+      if (finalized == 0)
+        MPI_Comm_free(&reduced_communicator);
+    }
+#  endif
+  reduced_communicator = MPI_COMM_SELF;
+  reduced_range_starts.clear();
+  transfer_partitioner.reset();
+  reduced_partitioner.reset();
+  reduced_to_transfer_indices.clear();
+  transfer_vector.reinit(0);
+  reduced_src.reinit(0);
+  reduced_dst.reinit(0);
+  reduced_solver = nullptr;
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridReducedCommunicator<Number>::initialize(
+  const IndexSet &   locally_owned_indices,
+  const MPI_Comm &   communicator,
+  const unsigned int agglomeration_factor)
+{
+  Assert(agglomeration_factor > 0,
+         ExcMessage("The agglomeration factor must be at least one."));
+  clear();
+
+  this->communicator         = communicator;
+  this->agglomeration_factor = agglomeration_factor;
+
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(communicator);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(communicator);
+  const unsigned int n_reduced_procs =
+    (n_procs + agglomeration_factor - 1) / agglomeration_factor;
+  const bool is_reduced_process = (my_rank % agglomeration_factor == 0);
+
+#  ifdef DEAL_II_WITH_MPI
+  const int ierr = MPI_Comm_split(communicator,
+                                  is_reduced_process ? 0 : MPI_UNDEFINED,
+                                  my_rank,
+                                  &reduced_communicator);
+  AssertThrowMPI(ierr);
+#  else
+  reduced_communicator = communicator;
+#  endif
+
+  // divide the indices evenly into contiguous ranges among the processes of
+  // the reduced communicator
+  const types::global_dof_index size = locally_owned_indices.size();
+  reduced_range_starts.resize(n_reduced_procs + 1);
+  for (unsigned int p = 0; p <= n_reduced_procs; ++p)
+    reduced_range_starts[p] = size * p / n_reduced_procs;
+
+  IndexSet reduced_owned_indices(size);
+  if (is_reduced_process)
+    reduced_owned_indices.add_range(
+      reduced_range_starts[my_rank / agglomeration_factor],
+      reduced_range_starts[my_rank / agglomeration_factor + 1]);
+
+  transfer_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    locally_owned_indices, reduced_owned_indices, communicator);
+  transfer_vector.reinit(transfer_partitioner);
+
+  if (is_reduced_process)
+    {
+      reduced_to_transfer_indices.reserve(reduced_owned_indices.n_elements());
+      for (const auto index : reduced_owned_indices)
+        reduced_to_transfer_indices.push_back(
+          transfer_partitioner->global_to_local(index));
+
+      reduced_partitioner =
+        std::make_shared<Utilities::MPI::Partitioner>(reduced_owned_indices,
+                                                      IndexSet(size),
+                                                      reduced_communicator);
+      reduced_src.reinit(reduced_partitioner);
+      reduced_dst.reinit(reduced_partitioner);
+    }
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridReducedCommunicator<Number>::set_reduced_solver(
+  const MGCoarseGridBase<VectorType> &reduced_solver)
+{
+  this->reduced_solver = &reduced_solver;
+}
+
+
+
+template <typename Number>
+MPI_Comm
+MGCoarseGridReducedCommunicator<Number>::get_reduced_communicator() const
+{
+  return reduced_communicator;
+}
+
+
+
+template <typename Number>
+const std::shared_ptr<const Utilities::MPI::Partitioner> &
+MGCoarseGridReducedCommunicator<Number>::get_reduced_partitioner() const
+{
+  return reduced_partitioner;
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+void
+MGCoarseGridReducedCommunicator<Number>::gather_matrix_rows(
+  const MatrixType &matrix,
+  std::vector<std::vector<std::pair<types::global_dof_index, Number>>> &rows)
+  const
+{
+  Assert(transfer_partitioner.get() != nullptr, ExcNotInitialized());
+
+  rows.clear();
+  if (reduced_partitioner.get() != nullptr)
+    rows.resize(reduced_partitioner->local_size());
+
+  // For each target process, collect the row indices followed by the number
+  // of entries and the column indices of each row, and the values
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(communicator);
+  std::map<unsigned int, std::vector<types::global_dof_index>> send_indices;
+  std::map<unsigned int, std::vector<Number>>                  send_values;
+  for (const auto row : transfer_partitioner->locally_owned_range())
+    {
+      const unsigned int target =
+        (std::upper_bound(reduced_range_starts.begin(),
+                          reduced_range_starts.end(),
+                          row) -
+         reduced_range_starts.begin() - 1) *
+        agglomeration_factor;
+
+      if (target == my_rank)
+        {
+          auto &my_row =
+            rows[row - reduced_partitioner->local_range().first];
+          for (auto entry = matrix.begin(row); entry != matrix.end(row);
+               ++entry)
+            my_row.emplace_back(entry->column(), entry->value());
+        }
+      else
+        {
+          std::vector<types::global_dof_index> &indices = send_indices[target];
+          std::vector<Number> &                 values  = send_values[target];
+          indices.push_back(row);
+          const std::size_t n_entries_position = indices.size();
+          indices.push_back(0);
+          for (auto entry = matrix.begin(row); entry != matrix.end(row);
+               ++entry)
+            {
+              indices.push_back(entry->column());
+              values.push_back(entry->value());
+            }
+          indices[n_entries_position] = indices.size() - n_entries_position - 1;
+        }
+    }
+
+  const std::map<unsigned int, std::vector<types::global_dof_index>>
+    received_indices = Utilities::MPI::some_to_some(communicator, send_indices);
+  const std::map<unsigned int, std::vector<Number>> received_values =
+    Utilities::MPI::some_to_some(communicator, send_values);
+
+  for (const auto &indices : received_indices)
+    {
+      const std::vector<Number> &values =
+        received_values.find(indices.first)->second;
+      auto value = values.begin();
+      for (auto index = indices.second.begin(); index != indices.second.end();)
+        {
+          Assert(reduced_partitioner->in_local_range(*index),
+                 ExcInternalError());
+          auto &row = rows[*index - reduced_partitioner->local_range().first];
+          const types::global_dof_index n_entries = *(index + 1);
+          index += 2;
+          for (types::global_dof_index e = 0; e < n_entries;
+               ++e, ++index, ++value)
+            row.emplace_back(*index, *value);
+        }
+      Assert(value == values.end(), ExcInternalError());
+    }
+}
+
+
+
+template <typename Number>
+void
+MGCoarseGridReducedCommunicator<Number>::operator()(
+  const unsigned int level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  Assert(transfer_partitioner.get() != nullptr, ExcNotInitialized());
+  AssertDimension(src.local_size(), transfer_vector.local_size());
+  AssertDimension(dst.local_size(), transfer_vector.local_size());
+
+  // gather the right hand side onto the reduced communicator. the locally
+  // owned part of the transfer vector coincides with the one of the coarse
+  // level, and its ghosts are the entries owned by the reduced partitioner
+  for (unsigned int i = 0; i < src.local_size(); ++i)
+    transfer_vector.local_element(i) = src.local_element(i);
+  transfer_vector.update_ghost_values();
+
+  if (reduced_partitioner.get() != nullptr)
+    {
+      Assert(reduced_solver != nullptr, ExcNotInitialized());
+      for (unsigned int i = 0; i < reduced_to_transfer_indices.size(); ++i)
+        reduced_src.local_element(i) =
+          transfer_vector.local_element(reduced_to_transfer_indices[i]);
+
+      (*reduced_solver)(level, reduced_dst, reduced_src);
+    }
+
+  // scatter the solution back by adding the ghost entries into the zeroed
+  // locally owned entries of their owners
+  transfer_vector.zero_out_ghosts();
+  transfer_vector = Number();
+  if (reduced_partitioner.get() != nullptr)
+    for (unsigned int i = 0; i < reduced_to_transfer_indices.size(); ++i)
+      transfer_vector.local_element(reduced_to_transfer_indices[i]) =
+        reduced_dst.local_element(i);
+  transfer_vector.compress(VectorOperation::add);
+
+  for (unsigned int i = 0; i < dst.local_size(); ++i)
+    dst.local_element(i) = transfer_vector.local_element(i);
+}
+
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
@@ -25,6 +25,7 @@
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
 #include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/petsc_sparse_matrix.h>
 #include <deal.II/lac/petsc_vector.h>
@@ -800,6 +801,181 @@ private:
 };
 
 
+
+/**
+ * Implementation of the MGTransferBase interface for which the transfer
+ * operations are applied cell by cell with the embedding matrices of the
+ * finite element, rather than through assembled sparse matrices. It
+ * implements the same operations as MGTransferPrebuilt for all finite
+ * elements that provide prolongation matrices, including those for which
+ * MGTransferMatrixFree is not available, and for the vector types
+ * Vector, BlockVector, LinearAlgebra::distributed::Vector,
+ * TrilinosWrappers::MPI::Vector, and PETScWrappers::MPI::Vector.
+ *
+ * The setup in build() only collects, for each locally owned cell with
+ * children, the multigrid degrees of freedom of the cell and its children
+ * and translates them into indices of ghosted vectors on the two levels; no
+ * sparsity patterns or matrices need to be assembled or distributed. The
+ * loops over the cells of the individual levels run in parallel tasks. This
+ * makes the setup considerably cheaper than the one of MGTransferPrebuilt,
+ * in particular for vector-valued elements with many degrees of freedom per
+ * cell, which is important when the multigrid hierarchy must be rebuilt
+ * after each adaptive refinement step.
+ *
+ * Since a degree of freedom on the finer level is in general shared between
+ * several children, each contribution is weighted by the inverse of the
+ * number of children it belongs to. This reproduces the operation of
+ * MGTransferPrebuilt for elements for which the coarse basis functions that
+ * are nonzero at a degree of freedom on the interface between two cells are
+ * associated with that interface, which is the case for all conforming
+ * elements of the library as well as for discontinuous elements.
+ */
+template <typename VectorType>
+class MGTransferCellwise : public MGLevelGlobalTransfer<VectorType>
+{
+public:
+  /**
+   * Constructor without constraint matrices. Use this constructor only with
+   * discontinuous finite elements or with no local refinement.
+   */
+  MGTransferCellwise() = default;
+
+  /**
+   * Constructor with constraints. Equivalent to the default constructor
+   * followed by initialize_constraints().
+   */
+  MGTransferCellwise(const MGConstrainedDoFs &mg_constrained_dofs);
+
+  /**
+   * Destructor.
+   */
+  virtual ~MGTransferCellwise() override = default;
+
+  /**
+   * Initialize the constraints to be used in build().
+   */
+  void
+  initialize_constraints(const MGConstrainedDoFs &mg_constrained_dofs);
+
+  /**
+   * Reset the object to the state it had right after the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Set up the index maps for the transfer between all levels.
+   */
+  template <int dim, int spacedim>
+  void
+  build(const DoFHandler<dim, spacedim> &mg_dof);
+
+  /**
+   * Prolongate a vector from level <tt>to_level-1</tt> to level
+   * <tt>to_level</tt> using the embedding matrices of the underlying finite
+   * element. The previous content of <tt>dst</tt> is overwritten.
+   *
+   * @arg src is a vector with as many elements as there are degrees of
+   * freedom on the coarser level involved.
+   *
+   * @arg dst has as many elements as there are degrees of freedom on the
+   * finer level.
+   */
+  virtual void
+  prolongate(const unsigned int to_level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+  /**
+   * Restrict a vector from level <tt>from_level</tt> to level
+   * <tt>from_level-1</tt> using the transpose operation of the @p prolongate
+   * method. If the region covered by cells on level <tt>from_level</tt> is
+   * smaller than that of level <tt>from_level-1</tt> (local refinement), then
+   * some degrees of freedom in <tt>dst</tt> are active and will not be
+   * altered. For the other degrees of freedom, the result of the restriction
+   * is added.
+   *
+   * @arg src is a vector with as many elements as there are degrees of
+   * freedom on the finer level involved.
+   *
+   * @arg dst has as many elements as there are degrees of freedom on the
+   * coarser level.
+   */
+  virtual void
+  restrict_and_add(const unsigned int from_level,
+                   VectorType &       dst,
+                   const VectorType & src) const override;
+
+  /**
+   * Finite element does not provide prolongation matrices.
+   */
+  DeclException0(ExcNoProlongation);
+
+  /**
+   * Memory used by this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The scalar type of the vectors.
+   */
+  using Number = typename VectorType::value_type;
+
+  /**
+   * The number of degrees of freedom per cell of the finite element.
+   */
+  unsigned int dofs_per_cell;
+
+  /**
+   * The prolongation matrices of the finite element for each child, with
+   * the scalar type of the vectors.
+   */
+  std::vector<FullMatrix<Number>> prolongation_matrices;
+
+  /**
+   * For each transfer from level <tt>l</tt> to level <tt>l+1</tt>, the
+   * indices of the degrees of freedom of the locally owned parent cells on
+   * level <tt>l</tt>, cell after cell, as local indices of the vector in
+   * @p coarse_vectors. Degrees of freedom at the boundary are marked by
+   * numbers::invalid_unsigned_int.
+   */
+  std::vector<std::vector<unsigned int>> parent_dof_indices;
+
+  /**
+   * For each transfer from level <tt>l</tt> to level <tt>l+1</tt>, the
+   * indices of the degrees of freedom of all children of the cells in
+   * @p parent_dof_indices, as local indices of the vector in
+   * @p fine_vectors.
+   */
+  std::vector<std::vector<unsigned int>> child_dof_indices;
+
+  /**
+   * For each transfer, the inverse of the number of children that share a
+   * degree of freedom on the finer level, for the locally owned and ghost
+   * entries of the vector in @p fine_vectors.
+   */
+  std::vector<std::vector<Number>> weights;
+
+  /**
+   * Ghosted vectors on level <tt>l</tt> of the transfer from level
+   * <tt>l</tt> to level <tt>l+1</tt>, which hold the values of all degrees
+   * of freedom of the locally owned parent cells.
+   */
+  mutable std::vector<LinearAlgebra::distributed::Vector<Number>>
+    coarse_vectors;
+
+  /**
+   * Ghosted vectors on level <tt>l+1</tt> of the transfer from level
+   * <tt>l</tt> to level <tt>l+1</tt>, which hold the values of all degrees
+   * of freedom of the children of the locally owned parent cells.
+   */
+  mutable std::vector<LinearAlgebra::distributed::Vector<Number>>
+    fine_vectors;
+};
+
+
 /*@}*/
 
 
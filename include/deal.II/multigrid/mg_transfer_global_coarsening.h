@@ -0,0 +1,433 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_transfer_global_coarsening_h
+#define dealii_mg_transfer_global_coarsening_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/mg_level_object.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/multigrid/mg_base.h>
+
+#include <functional>
+#include <memory>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * A class implementing the transfer between two DoFHandler objects that live
+ * on two different triangulations, as opposed to the levels of a single
+ * triangulation used by MGTransferMatrixFree. This allows to set up
+ * multigrid methods with global coarsening, where each level of the
+ * multigrid hierarchy is an independent (and independently partitioned)
+ * triangulation, e.g. obtained by coarsening all cells of the finest
+ * triangulation once, which gives a much better load balance on adaptively
+ * refined meshes than the level partitioning of local smoothing.
+ *
+ * The two triangulations need to be derived from the same coarse mesh. Each
+ * active cell of the coarse triangulation must either be an active cell in
+ * the fine triangulation as well, or be refined exactly once in the fine
+ * triangulation. On the former cells, the transfer interpolates between the
+ * two finite element spaces, which enables polynomial (p-)coarsening between
+ * FE_Q elements of different degrees on the same mesh. On the latter cells,
+ * the embedding matrices of the element are used, in which case both
+ * DoFHandler objects need to use the same element.
+ *
+ * The cell-wise operations are done with sum factorization on the
+ * one-dimensional interpolation matrices, vectorized over several coarse
+ * cells. The work is assigned to the owner of the coarse cells. The indices
+ * of the fine degrees of freedom of these cells, which might be owned by a
+ * different process, are communicated in reinit().
+ *
+ * Like MGTransferMatrixFree, this class currently only works for
+ * tensor-product finite elements based on FE_Q and FE_DGQ elements,
+ * including systems involving multiple components of one of these elements.
+ * The constraints on the coarse space (hanging nodes and homogeneous
+ * Dirichlet conditions) are applied when reading from and writing into the
+ * coarse vector. Constrained degrees of freedom of the fine space are set to
+ * zero in the result of prolongate() and ignored in restrict_and_add().
+ */
+template <int dim, typename Number>
+class MGTwoLevelTransfer : public Subscriptor
+{
+public:
+  /**
+   * The vector type this transfer operates on.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Constructor. The object needs to be set up by reinit() before use.
+   */
+  MGTwoLevelTransfer();
+
+  /**
+   * Set up the transfer between the DoFHandler objects @p dof_handler_fine
+   * and @p dof_handler_coarse. The constraints must contain (at least) the
+   * constraints of the locally relevant degrees of freedom of the respective
+   * DoFHandler.
+   *
+   * This is a collective operation on the communicator of the fine
+   * triangulation, which must coincide with the one of the coarse
+   * triangulation.
+   */
+  void
+  reinit(const DoFHandler<dim> &          dof_handler_fine,
+         const DoFHandler<dim> &          dof_handler_coarse,
+         const AffineConstraints<Number> &constraint_fine =
+           AffineConstraints<Number>(),
+         const AffineConstraints<Number> &constraint_coarse =
+           AffineConstraints<Number>());
+
+  /**
+   * Prolongate the vector @p src on the coarse space into @p dst on the fine
+   * space. The previous content of @p dst is overwritten.
+   */
+  void
+  prolongate(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Restrict the vector @p src on the fine space with the transpose of the
+   * prolongation and add the result to @p dst on the coarse space.
+   */
+  void
+  restrict_and_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Return a partitioner for the locally owned degrees of freedom of the
+   * fine DoFHandler.
+   */
+  const std::shared_ptr<const Utilities::MPI::Partitioner> &
+  get_partitioner_fine() const;
+
+  /**
+   * Return a partitioner for the locally owned degrees of freedom of the
+   * coarse DoFHandler.
+   */
+  const std::shared_ptr<const Utilities::MPI::Partitioner> &
+  get_partitioner_coarse() const;
+
+  /**
+   * Memory used by this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The data of the cell-wise transfer for one class of coarse cells, i.e.,
+   * either the cells that are refined in the fine triangulation or the cells
+   * that are present in both triangulations.
+   */
+  struct CellTransfer
+  {
+    /**
+     * The number of the coarse cells in this class.
+     */
+    unsigned int n_cells;
+
+    /**
+     * The number of one-dimensional basis functions on the coarse cell.
+     */
+    unsigned int n_dofs_1d_coarse;
+
+    /**
+     * The number of one-dimensional basis functions on the fine cell or, in
+     * case of refinement, on all children of the coarse cell together.
+     */
+    unsigned int n_dofs_1d_fine;
+
+    /**
+     * The one-dimensional prolongation matrix, with @p n_dofs_1d_coarse rows
+     * and @p n_dofs_1d_fine columns.
+     */
+    AlignedVector<VectorizedArray<Number>> prolongation_matrix_1d;
+
+    /**
+     * The indices of the degrees of freedom on the coarse cells in
+     * lexicographic order, in terms of the local index in the internal
+     * vector of the coarse space.
+     */
+    std::vector<unsigned int> dof_indices_coarse;
+
+    /**
+     * The indices of the degrees of freedom on the fine cells (or all the
+     * children of a coarse cell) in lexicographic order, in terms of the
+     * local index in the internal vector of the fine space.
+     */
+    std::vector<unsigned int> dof_indices_fine;
+  };
+
+  /**
+   * Perform the prolongation on the cells given by @p transfer from
+   * @p vec_coarse into @p vec_fine.
+   */
+  void
+  do_prolongate_add(const CellTransfer &transfer) const;
+
+  /**
+   * Perform the restriction on the cells given by @p transfer from
+   * @p vec_fine into @p vec_coarse.
+   */
+  void
+  do_restrict_add(const CellTransfer &transfer) const;
+
+  /**
+   * The number of components of the finite element.
+   */
+  unsigned int n_components;
+
+  /**
+   * The transfer on the coarse cells that are refined once in the fine
+   * triangulation and on the cells present in both triangulations.
+   */
+  CellTransfer transfers[2];
+
+  /**
+   * Partitioners for the locally owned degrees of freedom of the fine and
+   * coarse DoFHandler, respectively.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> partitioner_fine;
+  std::shared_ptr<const Utilities::MPI::Partitioner> partitioner_coarse;
+
+  /**
+   * Internal vectors on the fine and coarse space, with all the degrees of
+   * freedom accessed by the cell-wise operations as ghosts.
+   */
+  mutable VectorType vec_fine;
+  mutable VectorType vec_coarse;
+
+  /**
+   * The weights to make the restriction additive for continuous elements,
+   * given by the inverse of the number of coarse cells a degree of freedom
+   * on the fine space is part of. Indexed by the local index in @p vec_fine,
+   * and empty for discontinuous elements.
+   */
+  std::vector<Number> weights_fine;
+
+  /**
+   * The local indices of the locally owned degrees of freedom of the fine
+   * space that are constrained.
+   */
+  std::vector<unsigned int> constrained_indices_fine;
+
+  /**
+   * For each degree of freedom in @p vec_coarse, the number of its
+   * constraint, or numbers::invalid_unsigned_int if it is not constrained.
+   * Empty if there are no constraints on the coarse space.
+   */
+  std::vector<unsigned int> constraint_index_coarse;
+
+  /**
+   * For each constraint of the coarse space, the index into
+   * @p constraint_entries_coarse where its entries start. The last entry
+   * marks the end of the entries of the last constraint.
+   */
+  std::vector<unsigned int> constraint_start_coarse;
+
+  /**
+   * The entries of the constraints of the coarse space, in terms of the
+   * local index in @p vec_coarse and the weight.
+   */
+  std::vector<std::pair<unsigned int, Number>> constraint_entries_coarse;
+
+  /**
+   * A temporary array for the cell-wise evaluation.
+   */
+  mutable AlignedVector<VectorizedArray<Number>> evaluation_data;
+};
+
+
+
+/**
+ * Implementation of the MGTransferBase interface for multigrid methods with
+ * global coarsening, based on a sequence of MGTwoLevelTransfer objects
+ * between the DoFHandler objects of the individual levels. The finest level
+ * refers to the DoFHandler of the actual problem, so copy_to_mg() and
+ * copy_from_mg() only copy between the global vector and the vector on the
+ * finest level.
+ *
+ * The vectors on the levels are set up by the function passed to the
+ * constructor, which typically calls MatrixFree::initialize_dof_vector() of
+ * the operator on the respective level. Without that function, the vectors
+ * are set up with the locally owned degrees of freedom of the levels only.
+ */
+template <int dim, typename Number>
+class MGTransferGlobalCoarsening
+  : public MGTransferBase<LinearAlgebra::distributed::Vector<Number>>
+{
+public:
+  /**
+   * The vector type this transfer operates on.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Constructor. The entry @p transfer[level] of the level object describes
+   * the transfer between the levels <tt>level-1</tt> and @p level; the entry
+   * on the minimal level is not used.
+   */
+  MGTransferGlobalCoarsening(
+    const MGLevelObject<MGTwoLevelTransfer<dim, Number>> &transfer,
+    const std::function<void(const unsigned int, VectorType &)>
+      &initialize_dof_vector =
+        std::function<void(const unsigned int, VectorType &)>());
+
+  /**
+   * Prolongate a vector from level <tt>to_level-1</tt> to level
+   * <tt>to_level</tt>. The previous content of <tt>dst</tt> is overwritten.
+   */
+  virtual void
+  prolongate(const unsigned int to_level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+  /**
+   * Restrict a vector from level <tt>from_level</tt> to level
+   * <tt>from_level-1</tt> and add the result to @p dst.
+   */
+  virtual void
+  restrict_and_add(const unsigned int from_level,
+                   VectorType &       dst,
+                   const VectorType & src) const override;
+
+  /**
+   * Set up the vectors of all levels and copy the vector @p src into the
+   * vector on the finest level.
+   */
+  template <class InVector, int spacedim>
+  void
+  copy_to_mg(const DoFHandler<dim, spacedim> &dof_handler,
+             MGLevelObject<VectorType> &      dst,
+             const InVector &                 src) const;
+
+  /**
+   * Copy the vector on the finest level into @p dst.
+   */
+  template <class OutVector, int spacedim>
+  void
+  copy_from_mg(const DoFHandler<dim, spacedim> &dof_handler,
+               OutVector &                      dst,
+               const MGLevelObject<VectorType> &src) const;
+
+  /**
+   * Add the vector on the finest level to @p dst.
+   */
+  template <class OutVector, int spacedim>
+  void
+  copy_from_mg_add(const DoFHandler<dim, spacedim> &dof_handler,
+                   OutVector &                      dst,
+                   const MGLevelObject<VectorType> &src) const;
+
+  /**
+   * Memory used by this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Set up the vector on the given level.
+   */
+  void
+  initialize_dof_vector(const unsigned int level, VectorType &vector) const;
+
+  /**
+   * The transfer operators between the levels.
+   */
+  SmartPointer<const MGLevelObject<MGTwoLevelTransfer<dim, Number>>,
+               MGTransferGlobalCoarsening<dim, Number>>
+    transfer;
+
+  /**
+   * The function to set up the vectors on the levels.
+   */
+  std::function<void(const unsigned int, VectorType &)> initialize_function;
+};
+
+/*@}*/
+
+
+//------------------------ templated functions -------------------------
+#ifndef DOXYGEN
+
+
+template <int dim, typename Number>
+template <class InVector, int spacedim>
+void
+MGTransferGlobalCoarsening<dim, Number>::copy_to_mg(
+  const DoFHandler<dim, spacedim> &,
+  MGLevelObject<VectorType> &dst,
+  const InVector &           src) const
+{
+  for (unsigned int level = dst.min_level(); level <= dst.max_level(); ++level)
+    {
+      initialize_dof_vector(level, dst[level]);
+      dst[level] = 0.;
+    }
+  dst[dst.max_level()].copy_locally_owned_data_from(src);
+}
+
+
+
+template <int dim, typename Number>
+template <class OutVector, int spacedim>
+void
+MGTransferGlobalCoarsening<dim, Number>::copy_from_mg(
+  const DoFHandler<dim, spacedim> &,
+  OutVector &                      dst,
+  const MGLevelObject<VectorType> &src) const
+{
+  dst.copy_locally_owned_data_from(src[src.max_level()]);
+}
+
+
+
+template <int dim, typename Number>
+template <class OutVector, int spacedim>
+void
+MGTransferGlobalCoarsening<dim, Number>::copy_from_mg_add(
+  const DoFHandler<dim, spacedim> &,
+  OutVector &                      dst,
+  const MGLevelObject<VectorType> &src) const
+{
+  const VectorType &finest = src[src.max_level()];
+  AssertDimension(dst.local_size(), finest.local_size());
+  for (unsigned int i = 0; i < finest.local_size(); ++i)
+    dst.local_element(i) += finest.local_element(i);
+}
+
+
+#endif // DOXYGEN
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
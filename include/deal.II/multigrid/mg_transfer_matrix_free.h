@@ -35,6 +35,14 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+#ifndef DOXYGEN
+namespace CUDAWrappers
+{
+  template <int dim, typename Number>
+  class MGTransferMatrixFree;
+}
+#endif
+
 /*!@addtogroup mg */
 /*@{*/
 
@@ -137,6 +145,28 @@ public:
     LinearAlgebra::distributed::Vector<Number> &      dst,
     const LinearAlgebra::distributed::Vector<Number> &src) const override;
 
+  /**
+   * Perform the cell operations of restrict_and_add() and start the
+   * communication of the contributions to degrees of freedom on level
+   * <tt>from_level-1</tt> owned by other processors. The result is added to
+   * @p dst by restrict_and_add_finish(), which allows other work to be
+   * overlapped with the communication.
+   */
+  virtual void
+  restrict_and_add_start(
+    const unsigned int                                from_level,
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &src) const override;
+
+  /**
+   * Complete the communication started by restrict_and_add_start() and add
+   * the restricted vector to @p dst.
+   */
+  virtual void
+  restrict_and_add_finish(
+    const unsigned int                          from_level,
+    LinearAlgebra::distributed::Vector<Number> &dst) const override;
+
   /**
    * Restrict fine-mesh field @p src to each multigrid level in @p mg_dof and
    * store the result in @p dst.
@@ -163,6 +193,12 @@ public:
   memory_consumption() const;
 
 private:
+  /**
+   * The transfer on the device copies the data set up by build().
+   */
+  template <int, typename>
+  friend class CUDAWrappers::MGTransferMatrixFree;
+
   /**
    * A variable storing the degree of the finite element contained in the
    * DoFHandler passed to build(). The selection of the computational kernel is
@@ -150,16 +150,17 @@ Multigrid<VectorType>::level_v_step(const unsigned int level)
   if (debug > 2)
     deallog << "Residual norm          " << t[level].l2_norm() << std::endl;
 
-  // Get the defect on the next coarser level as part of the (DG) edge matrix
-  // and then the main part by the restriction of the transfer
-  if (edge_down != nullptr)
-    {
-      edge_down->vmult(level, t[level - 1], solution[level]);
-      defect[level - 1] -= t[level - 1];
-    }
-
+  // Get the defect on the next coarser level by the restriction of the
+  // transfer and the (DG) edge matrix. The restriction is split into two
+  // phases such that transfer classes can overlap its communication with
+  // the product by the edge matrix
   this->signals.restriction(true, level);
-  transfer->restrict_and_add(level, defect[level - 1], t[level]);
+  transfer->restrict_and_add_start(level, defect[level - 1], t[level]);
+  if (edge_down != nullptr)
+    edge_down->vmult(level, t[level - 1], solution[level]);
+  transfer->restrict_and_add_finish(level, defect[level - 1]);
+  if (edge_down != nullptr)
+    defect[level - 1] -= t[level - 1];
   this->signals.restriction(false, level);
 
   // do recursion
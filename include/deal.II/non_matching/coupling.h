@@ -157,7 +157,9 @@ namespace NonMatching
    * The corresponding sparsity patterns can be computed by calling the
    * make_coupling_sparsity_pattern function. The elements of the matrix are
    * computed by locating the position of quadrature points defined on elements
-   * of $B$ with respect to the embedding triangulation $\Omega$.
+   * of $B$ with respect to the embedding triangulation $\Omega$. The local
+   * matrices of the cells of $B$ are computed in parallel using the
+   * WorkStream framework.
    *
    * The `space_comps` and `immersed_comps` masks are assumed to be ordered in
    * the same way: the first component of `space_comps` will couple with the
@@ -0,0 +1,301 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_assembly_plan_h
+#define dealii_assembly_plan_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class FullMatrix;
+class SparsityPattern;
+template <typename number>
+class SparseMatrix;
+template <typename number>
+class Vector;
+#endif
+
+/**
+ * A class that stores the information needed to add the contributions of the
+ * cells of a mesh to a global matrix that stays the same as long as neither
+ * the mesh, the enumeration of the degrees of freedom, the constraints, nor
+ * the sparsity pattern change: the list of locally owned active cells, the
+ * global indices of the degrees of freedom of each of these cells, whether
+ * a cell has constrained degrees of freedom, and the positions of the
+ * entries of the cell matrices in the array of values of the global
+ * SparseMatrix as computed by
+ * AffineConstraints::compute_sparse_matrix_offsets().
+ *
+ * In time dependent or nonlinear problems, a matrix is often assembled many
+ * times on the same mesh. Setting up an object of this class once and reusing
+ * it in every assembly avoids looking up the degrees of freedom and the
+ * constraints of each cell again, and in particular avoids searching for
+ * the positions of the entries in the rows of the global matrix every time
+ * a cell matrix is added to it. The functions
+ * MatrixCreator::create_mass_matrix() and
+ * MatrixCreator::create_laplace_matrix() accept an object of this class
+ * instead of a DoFHandler and an AffineConstraints object. In a
+ * user-written assembly loop, for example using MeshWorker::mesh_loop() or
+ * WorkStream::run(), the object is used in the copier as follows:
+ * @code
+ * AssemblyPlan<dim> assembly_plan(dof_handler, constraints, sparsity_pattern);
+ * ...
+ * // in each step of the Newton iteration:
+ * auto cell_worker = [&](const Iterator &cell,
+ *                        ScratchData &   scratch_data,
+ *                        CopyData &      copy_data) {
+ *   copy_data.cell_index = assembly_plan.cell_index(cell);
+ *   ... // compute copy_data.cell_matrix and copy_data.cell_rhs
+ * };
+ * auto copier = [&](const CopyData &copy_data) {
+ *   assembly_plan.distribute_local_to_global(copy_data.cell_index,
+ *                                            copy_data.cell_matrix,
+ *                                            copy_data.cell_rhs,
+ *                                            system_matrix,
+ *                                            system_rhs);
+ * };
+ * MeshWorker::mesh_loop(dof_handler.begin_active(),
+ *                       dof_handler.end(),
+ *                       cell_worker,
+ *                       copier,
+ *                       scratch_data,
+ *                       copy_data,
+ *                       MeshWorker::assemble_own_cells);
+ * @endcode
+ *
+ * The object stores pointers to the DoFHandler and the AffineConstraints
+ * object given to reinit(), which therefore need to live at least as long
+ * as the current object, and the object has to be set up again whenever one
+ * of them or the sparsity pattern changes.
+ *
+ * @ingroup constraints
+ */
+template <int dim, int spacedim = dim, typename number = double>
+class AssemblyPlan : public Subscriptor
+{
+public:
+  /**
+   * Declare the type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * The type of the cell iterators of the DoFHandler.
+   */
+  using active_cell_iterator =
+    typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+  /**
+   * Constructor. Create an empty object that needs to be set up with
+   * reinit() before it can be used.
+   */
+  AssemblyPlan();
+
+  /**
+   * Constructor. Set up the object by calling reinit() with the given
+   * arguments.
+   */
+  AssemblyPlan(const DoFHandler<dim, spacedim> &dof_handler,
+               const AffineConstraints<number> &constraints,
+               const SparsityPattern &          sparsity_pattern);
+
+  /**
+   * Collect the locally owned active cells of @p dof_handler, their degrees
+   * of freedom, and the positions of the entries of their cell matrices in
+   * a SparseMatrix based on @p sparsity_pattern, taking into account the
+   * given @p constraints. The AffineConstraints object must be closed.
+   */
+  void
+  reinit(const DoFHandler<dim, spacedim> &dof_handler,
+         const AffineConstraints<number> &constraints,
+         const SparsityPattern &          sparsity_pattern);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of cells stored in this object.
+   */
+  unsigned int
+  n_cells() const;
+
+  /**
+   * Return the list of locally owned active cells, in the order in which
+   * they are numbered by this object.
+   */
+  const std::vector<active_cell_iterator> &
+  get_cells() const;
+
+  /**
+   * Return the number of the given locally owned active cell within this
+   * object, i.e., the index of @p cell in the list returned by get_cells().
+   */
+  unsigned int
+  cell_index(const active_cell_iterator &cell) const;
+
+  /**
+   * Return the global indices of the degrees of freedom of the cell with
+   * number @p cell_index.
+   */
+  const std::vector<size_type> &
+  get_dof_indices(const unsigned int cell_index) const;
+
+  /**
+   * Return the DoFHandler this object was set up with.
+   */
+  const DoFHandler<dim, spacedim> &
+  get_dof_handler() const;
+
+  /**
+   * Return the AffineConstraints object this object was set up with.
+   */
+  const AffineConstraints<number> &
+  get_affine_constraints() const;
+
+  /**
+   * Add the matrix @p local_matrix of the cell with number @p cell_index to
+   * @p global_matrix, which must be based on the sparsity pattern given to
+   * reinit(). The result is the same as the one of
+   * AffineConstraints::distribute_local_to_global() for the stored
+   * constraints and degrees of freedom of the cell.
+   */
+  void
+  distribute_local_to_global(const unsigned int        cell_index,
+                             const FullMatrix<number> &local_matrix,
+                             SparseMatrix<number> &    global_matrix) const;
+
+  /**
+   * Like the previous function, but also add the vector @p local_vector of
+   * the cell to @p global_vector.
+   */
+  void
+  distribute_local_to_global(const unsigned int        cell_index,
+                             const FullMatrix<number> &local_matrix,
+                             const Vector<number> &    local_vector,
+                             SparseMatrix<number> &    global_matrix,
+                             Vector<number> &          global_vector) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The DoFHandler this object was set up with.
+   */
+  SmartPointer<const DoFHandler<dim, spacedim>> dof_handler;
+
+  /**
+   * The AffineConstraints object this object was set up with.
+   */
+  SmartPointer<const AffineConstraints<number>> constraints;
+
+  /**
+   * The locally owned active cells.
+   */
+  std::vector<active_cell_iterator> cells;
+
+  /**
+   * The position in @p cells of each active cell of the triangulation,
+   * indexed by CellAccessor::active_cell_index(), or
+   * numbers::invalid_unsigned_int for cells that are not locally owned.
+   */
+  std::vector<unsigned int> cell_indices;
+
+  /**
+   * The global indices of the degrees of freedom of each cell.
+   */
+  std::vector<std::vector<size_type>> dof_indices;
+
+  /**
+   * The positions of the entries of the cell matrices in the global matrix.
+   */
+  typename AffineConstraints<number>::SparseMatrixOffsets matrix_offsets;
+};
+
+
+
+/* ---------------------- inline functions ------------------------------- */
+
+#ifndef DOXYGEN
+
+template <int dim, int spacedim, typename number>
+inline unsigned int
+AssemblyPlan<dim, spacedim, number>::n_cells() const
+{
+  return cells.size();
+}
+
+
+
+template <int dim, int spacedim, typename number>
+inline const std::vector<
+  typename AssemblyPlan<dim, spacedim, number>::active_cell_iterator> &
+AssemblyPlan<dim, spacedim, number>::get_cells() const
+{
+  return cells;
+}
+
+
+
+template <int dim, int spacedim, typename number>
+inline unsigned int
+AssemblyPlan<dim, spacedim, number>::cell_index(
+  const active_cell_iterator &cell) const
+{
+  AssertIndexRange(cell->active_cell_index(), cell_indices.size());
+  Assert(cell_indices[cell->active_cell_index()] !=
+           numbers::invalid_unsigned_int,
+         ExcMessage("The given cell is not locally owned."));
+  return cell_indices[cell->active_cell_index()];
+}
+
+
+
+template <int dim, int spacedim, typename number>
+inline const std::vector<types::global_dof_index> &
+AssemblyPlan<dim, spacedim, number>::get_dof_indices(
+  const unsigned int cell_index) const
+{
+  AssertIndexRange(cell_index, dof_indices.size());
+  return dof_indices[cell_index];
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
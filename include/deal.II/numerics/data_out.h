@@ -22,6 +22,7 @@
 
 #include <deal.II/numerics/data_out_dof_data.h>
 
+#include <functional>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -316,6 +317,42 @@ public:
                 const unsigned int     n_subdivisions = 0,
                 const CurvedCellRegion curved_region  = curved_boundary);
 
+  /**
+   * Re-evaluate the data vectors and cell data on the patches created by the
+   * last call to build_patches(), reusing the geometry of the patches, i.e.,
+   * the vertices, the points of curved cells computed through the mapping,
+   * and the neighborship information. This is considerably cheaper than
+   * calling build_patches() again, in particular for higher order mappings
+   * and curved cells, and is intended for programs that write output
+   * frequently on a mesh that does not change, e.g., in every few time
+   * steps.
+   *
+   * Since this class only stores references to the data vectors, it is
+   * sufficient to change the values of the vectors that were added by
+   * add_data_vector() before calling this function. The set of data vectors
+   * and postprocessors must be the same as for the last call to
+   * build_patches().
+   *
+   * @note The triangulation and the DoFHandler objects must not have changed
+   * since the last call to build_patches(). The function uses the number of
+   * subdivisions and the curved cell region given to that call, and
+   * MappingQ1 to evaluate the data vectors, see the function below for other
+   * mappings.
+   */
+  void
+  update_patch_data();
+
+  /**
+   * Same as above, except that the data vectors are evaluated with the given
+   * mapping, which must be the same mapping as passed to the last call to
+   * build_patches(). The vertices and points of the patches are not
+   * recomputed, so this function cannot be used for moving the patches with
+   * an Eulerian mapping.
+   */
+  void
+  update_patch_data(const Mapping<DoFHandlerType::dimension,
+                                  DoFHandlerType::space_dimension> &mapping);
+
   /**
    * Return the first cell which we want output for. The default
    * implementation returns the first active cell, but you might want to
@@ -338,6 +375,28 @@ public:
   virtual cell_iterator
   next_cell(const cell_iterator &cell);
 
+  /**
+   * Restrict the output to the active cells for which @p cell_filter returns
+   * true, e.g., to write only a region of interest of the domain or the
+   * cells of a certain material:
+   * @code
+   *   data_out.set_cell_selection(
+   *     [&](const typename DataOut<dim>::cell_iterator &cell) {
+   *       return bounding_box.point_inside(cell->center());
+   *     });
+   *   data_out.build_patches();
+   * @endcode
+   * The filter is used by the default implementations of first_cell() and
+   * next_cell(), so this function is a simpler alternative to overloading
+   * these functions in a derived class for the common case of selecting a
+   * subset of the active cells. Passing an empty function object, which is
+   * the default, selects all active cells again. The selection takes effect
+   * with the next call to build_patches().
+   */
+  void
+  set_cell_selection(
+    const std::function<bool(const cell_iterator &)> &cell_filter);
+
 private:
   /**
    * Return the first cell produced by the first_cell()/next_cell() function
@@ -363,6 +422,10 @@ private:
    * WorkStream::run(). The function does not take a CopyData object but
    * rather allocates one on its own stack for memory access efficiency
    * reasons.
+   *
+   * If @p reuse_geometry is true, only the data of the patch is recomputed
+   * and the vertices, points, and neighbors of the patch already stored for
+   * this cell are kept.
    */
   void
   build_one_patch(const std::pair<cell_iterator, unsigned int> *cell_and_index,
@@ -370,7 +433,53 @@ private:
                     DoFHandlerType::dimension,
                     DoFHandlerType::space_dimension> &scratch_data,
                   const unsigned int                  n_subdivisions,
-                  const CurvedCellRegion              curved_cell_region);
+                  const CurvedCellRegion              curved_cell_region,
+                  const bool                          reuse_geometry);
+
+  /**
+   * Build the patches for the cells stored in @p all_cells in parallel,
+   * either completely or, if @p reuse_geometry is true, only their data.
+   */
+  void
+  build_patches_on_cells(
+    const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+      &        mapping,
+    const bool reuse_geometry);
+
+  /**
+   * The cells for which the last call to build_patches() created patches,
+   * along with their active cell index.
+   */
+  std::vector<std::pair<cell_iterator, unsigned int>> all_cells;
+
+  /**
+   * The map from the level and index of a cell to the number of its patch,
+   * as filled by the last call to build_patches().
+   */
+  std::vector<std::vector<unsigned int>> cell_to_patch_index_map;
+
+  /**
+   * The number of subdivisions of the patches built by the last call to
+   * build_patches().
+   */
+  unsigned int last_n_subdivisions = 0;
+
+  /**
+   * The region of curved cells used by the last call to build_patches().
+   */
+  CurvedCellRegion last_curved_cell_region = no_curved_cells;
+
+  /**
+   * The number of active cells of the triangulation at the time of the last
+   * call to build_patches(), used to check that the mesh has not changed
+   * when calling update_patch_data().
+   */
+  unsigned int n_active_cells_of_patches = 0;
+
+  /**
+   * The filter set by set_cell_selection().
+   */
+  std::function<bool(const cell_iterator &)> cell_filter;
 };
 
 
@@ -18,6 +18,7 @@
 
 
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/tensor.h>
@@ -468,6 +469,81 @@ public:
   evaluate_vector_field(const DataPostprocessorInputs::Vector<dim> &input_data,
                         std::vector<Vector<double>> &computed_quantities) const;
 
+  /**
+   * Return whether DataOut and DataOutFaces should use the functions
+   * evaluate_scalar_field_contiguous() and evaluate_vector_field_contiguous()
+   * instead of evaluate_scalar_field() and evaluate_vector_field(). The
+   * default implementation returns false. Derived classes that implement
+   * the contiguous variants need to overload this function and return true.
+   */
+  virtual bool
+  supports_contiguous_evaluation() const;
+
+  /**
+   * Same as evaluate_scalar_field(), but the computed quantities are written
+   * into the preallocated array @p computed_quantities, in which the values
+   * of each quantity at all evaluation points are stored one after the
+   * other: the value of the quantity with index <tt>c</tt> at the
+   * evaluation point with index <tt>q</tt> is stored at position
+   * <tt>c*n_points+q</tt>, where the number of evaluation points
+   * <tt>n_points</tt> is the size of @p computed_quantities divided by the
+   * number of quantities given by get_names().
+   *
+   * This is the layout in which DataOut and DataOutFaces store the data of
+   * their patches, so @p computed_quantities refers directly to the memory
+   * of the patch, and neither a vector per evaluation point needs to be
+   * filled nor the results need to be copied. Moreover, an implementation
+   * can loop over the evaluation points in the innermost loop, working on
+   * contiguous arrays of the input and output data, which compilers can
+   * vectorize:
+   * @code
+   * template <int dim>
+   * class GradientMagnitude : public DataPostprocessorScalar<dim>
+   * {
+   * public:
+   *   GradientMagnitude()
+   *     : DataPostprocessorScalar<dim>("gradient_magnitude",
+   *                                    update_gradients)
+   *   {}
+   *
+   *   virtual bool
+   *   supports_contiguous_evaluation() const override
+   *   {
+   *     return true;
+   *   }
+   *
+   *   virtual void
+   *   evaluate_scalar_field_contiguous(
+   *     const DataPostprocessorInputs::Scalar<dim> &inputs,
+   *     const ArrayView<float> &computed_quantities) const override
+   *   {
+   *     for (unsigned int q = 0; q < inputs.solution_gradients.size(); ++q)
+   *       computed_quantities[q] = inputs.solution_gradients[q].norm();
+   *   }
+   * };
+   * @endcode
+   *
+   * Other classes that work with data postprocessors, such as
+   * DataOutRotation and PointValueHistory, call evaluate_scalar_field() and
+   * evaluate_vector_field(), whose default implementations call the
+   * contiguous variants if supports_contiguous_evaluation() returns true and
+   * copy the results. Thus, a derived class only needs to implement one of
+   * the two variants.
+   */
+  virtual void
+  evaluate_scalar_field_contiguous(
+    const DataPostprocessorInputs::Scalar<dim> &input_data,
+    const ArrayView<float> &                    computed_quantities) const;
+
+  /**
+   * Same as evaluate_scalar_field_contiguous(), but for vector-valued
+   * data, see evaluate_vector_field().
+   */
+  virtual void
+  evaluate_vector_field_contiguous(
+    const DataPostprocessorInputs::Vector<dim> &input_data,
+    const ArrayView<float> &                    computed_quantities) const;
+
   /**
    * Return the vector of strings describing the names of the computed
    * quantities.
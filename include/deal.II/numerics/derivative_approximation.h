@@ -147,6 +147,13 @@ DEAL_II_NAMESPACE_OPEN
  * such as finding all active neighbors, or setting up the matrix $Y$ is done
  * in the main function @p approximate.
  *
+ * Since the value at the center of a cell enters the difference quotients of
+ * the cell itself and of all its neighbors, the functions computing the
+ * norms on all cells first evaluate the finite element field at the centers
+ * of all locally owned and ghost cells, using one FEValues object per
+ * thread, and then compute the approximation on each locally owned cell from
+ * these stored values. Both passes run in parallel via WorkStream.
+ *
  * Due to this way of operation, the class may be easily extended for higher
  * order derivatives than are presently implemented. Basically, only an
  * additional class along the lines of the derivative descriptor classes @p
@@ -25,6 +25,7 @@
 #  include <nanoflann.hpp>
 
 #  include <memory>
+#  include <vector>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -56,6 +57,12 @@ DEAL_II_NAMESPACE_OPEN
  * > case, the hyperplane would be set by the $x$-value of the point, and its
  * > normal would be the unit $x$-axis.
  *
+ * Each of the query functions has a variant that takes a vector of target
+ * points and processes the targets in parallel. If the points move by small
+ * amounts, e.g., particles in a time step, the tree does not need to be
+ * rebuilt: after a call to update_points(), the queries account for the
+ * displacement of the points and still return exact results.
+ *
  * @deprecated This class has been deprecated in favor of RTree, which is
  * based on <code>boost::geometry::index::rtree</code>.
  *
@@ -86,7 +93,8 @@ public:
    * set_points() method again. The tree and the index are constructed only once
    * when you pass the points (either at construction time, or when you call
    * set_points()). If you update your points, and do not call set_points()
-   * again, then all following results will likely be wrong.
+   * again, then all following results will likely be wrong. Points that only
+   * moved by small amounts can instead be announced by update_points().
    */
   KDTree(const unsigned int             max_leaf_size = 10,
          const std::vector<Point<dim>> &pts           = {});
@@ -185,6 +193,23 @@ public:
   set_points(const std::vector<Point<dim>> &pts);
 
 
+  /**
+   * Tell this object that the points passed to set_points() have moved in
+   * place, each by at most @p max_displacement from its location at the time
+   * of the last call to set_points(). The tree is not rebuilt. Instead, the
+   * queries enlarge their search radius by @p max_displacement and discard
+   * the additional candidates based on the current locations of the points,
+   * so the results remain exact. The queries become more expensive as the
+   * displacement grows, so call set_points() again once the displacement is
+   * no longer small compared to the distance between the points.
+   *
+   * @param[in] max_displacement An upper bound for the distance between the
+   * current location of each point and its location when the tree was built
+   */
+  void
+  update_points(const double max_displacement);
+
+
   /**
    * A const accessor to the @p i'th one among the underlying points.
    */
@@ -229,6 +254,37 @@ public:
   get_closest_points(const Point<dim> & target,
                      const unsigned int n_points) const;
 
+  /**
+   * Call get_points_within_ball() for each point of @p targets. The targets
+   * are processed in parallel.
+   *
+   * @param[in] targets The target points
+   * @param[in] radius The radius of the balls
+   * @param[in] sorted If @p true, sort the results for each target in
+   * ascending order with respect to distance
+   *
+   * @return For each target, a vector of indices and distances of the
+   * matching points
+   */
+  std::vector<std::vector<std::pair<unsigned int, double>>>
+  get_points_within_ball(const std::vector<Point<dim>> &targets,
+                         const double                   radius,
+                         const bool                     sorted = false) const;
+
+  /**
+   * Call get_closest_points() for each point of @p targets. The targets are
+   * processed in parallel.
+   *
+   * @param[in] targets The target points
+   * @param[in] n_points The number of requested points per target
+   *
+   * @return For each target, a vector of pairs of indices and distances of
+   * the matching points
+   */
+  std::vector<std::vector<std::pair<unsigned int, double>>>
+  get_closest_points(const std::vector<Point<dim>> &targets,
+                     const unsigned int             n_points) const;
+
 private:
   /**
    * Max number of points per leaf as set in the constructor.
@@ -246,6 +302,13 @@ private:
    * The actual kdtree.
    */
   std::unique_ptr<NanoFlannKDTree> kdtree;
+
+
+  /**
+   * The bound for the displacement of the points since the tree was built,
+   * as given to update_points().
+   */
+  double max_displacement;
 };
 
 
@@ -40,6 +40,7 @@
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/vector.h>
 
+#include <deal.II/numerics/assembly_plan.h>
 #include <deal.II/numerics/matrix_tools.h>
 
 #ifdef DEAL_II_WITH_PETSC
@@ -210,6 +211,13 @@ namespace MatrixCreator
         dealii::Vector<number>               cell_rhs;
         const AffineConstraints<number> *    constraints;
       };
+
+
+      template <typename number>
+      struct CopyDataWithCellIndex : public CopyData<number>
+      {
+        unsigned int cell_index;
+      };
     } // namespace AssemblerData
 
 
@@ -771,6 +779,71 @@ namespace MatrixCreator
 
 
 
+  template <int dim, int spacedim, typename number>
+  void
+  create_mass_matrix(const Mapping<dim, spacedim> &             mapping,
+                     const AssemblyPlan<dim, spacedim, number> &assembly_plan,
+                     const Quadrature<dim> &                    q,
+                     SparseMatrix<number> &                     matrix,
+                     const Function<spacedim, number> *const    coefficient)
+  {
+    const DoFHandler<dim, spacedim> &dof = assembly_plan.get_dof_handler();
+    Assert(matrix.m() == dof.n_dofs(),
+           ExcDimensionMismatch(matrix.m(), dof.n_dofs()));
+    Assert(matrix.n() == dof.n_dofs(),
+           ExcDimensionMismatch(matrix.n(), dof.n_dofs()));
+
+    using ScratchData =
+      MatrixCreator::internal::AssemblerData::Scratch<dim, spacedim, number>;
+    using CopyData =
+      MatrixCreator::internal::AssemblerData::CopyDataWithCellIndex<number>;
+    using CellIterator = typename std::vector<
+      typename DoFHandler<dim, spacedim>::active_cell_iterator>::const_iterator;
+
+    hp::FECollection<dim, spacedim>      fe_collection(dof.get_fe());
+    hp::QCollection<dim>                 q_collection(q);
+    hp::MappingCollection<dim, spacedim> mapping_collection(mapping);
+    ScratchData                          assembler_data(
+      fe_collection,
+      update_values | update_JxW_values |
+        (coefficient != nullptr ? update_quadrature_points : UpdateFlags(0)),
+      coefficient,
+      /*rhs_function=*/nullptr,
+      q_collection,
+      mapping_collection);
+
+    CopyData copy_data;
+    copy_data.cell_matrix.reinit(
+      assembler_data.fe_collection.max_dofs_per_cell(),
+      assembler_data.fe_collection.max_dofs_per_cell());
+    copy_data.cell_rhs.reinit(assembler_data.fe_collection.max_dofs_per_cell());
+    copy_data.dof_indices.resize(
+      assembler_data.fe_collection.max_dofs_per_cell());
+    copy_data.constraints = &assembly_plan.get_affine_constraints();
+
+    const CellIterator begin = assembly_plan.get_cells().begin();
+    WorkStream::run(
+      begin,
+      assembly_plan.get_cells().end(),
+      [begin](const CellIterator &cell, ScratchData &data, CopyData &copy) {
+        MatrixCreator::internal::mass_assembler<
+          dim,
+          spacedim,
+          typename DoFHandler<dim, spacedim>::active_cell_iterator,
+          number>(*cell, data, copy);
+        copy.cell_index = cell - begin;
+      },
+      [&assembly_plan, &matrix](const CopyData &copy) {
+        assembly_plan.distribute_local_to_global(copy.cell_index,
+                                                 copy.cell_matrix,
+                                                 matrix);
+      },
+      assembler_data,
+      copy_data);
+  }
+
+
+
   template <int dim, int spacedim, typename number>
   void
   create_mass_matrix(const Mapping<dim, spacedim> &          mapping,
@@ -2010,6 +2083,73 @@ namespace MatrixCreator
 
 
 
+  template <int dim, int spacedim>
+  void
+  create_laplace_matrix(
+    const Mapping<dim, spacedim> &             mapping,
+    const AssemblyPlan<dim, spacedim, double> &assembly_plan,
+    const Quadrature<dim> &                    q,
+    SparseMatrix<double> &                     matrix,
+    const Function<spacedim> *const            coefficient)
+  {
+    const DoFHandler<dim, spacedim> &dof = assembly_plan.get_dof_handler();
+    Assert(matrix.m() == dof.n_dofs(),
+           ExcDimensionMismatch(matrix.m(), dof.n_dofs()));
+    Assert(matrix.n() == dof.n_dofs(),
+           ExcDimensionMismatch(matrix.n(), dof.n_dofs()));
+
+    using ScratchData =
+      MatrixCreator::internal::AssemblerData::Scratch<dim, spacedim, double>;
+    using CopyData =
+      MatrixCreator::internal::AssemblerData::CopyDataWithCellIndex<double>;
+    using CellIterator = typename std::vector<
+      typename DoFHandler<dim, spacedim>::active_cell_iterator>::const_iterator;
+
+    hp::FECollection<dim, spacedim>      fe_collection(dof.get_fe());
+    hp::QCollection<dim>                 q_collection(q);
+    hp::MappingCollection<dim, spacedim> mapping_collection(mapping);
+    ScratchData                          assembler_data(
+      fe_collection,
+      update_gradients | update_JxW_values |
+        (coefficient != nullptr ? update_quadrature_points : UpdateFlags(0)),
+      coefficient,
+      /*rhs_function=*/nullptr,
+      q_collection,
+      mapping_collection);
+
+    CopyData copy_data;
+    copy_data.cell_matrix.reinit(
+      assembler_data.fe_collection.max_dofs_per_cell(),
+      assembler_data.fe_collection.max_dofs_per_cell());
+    copy_data.cell_rhs.reinit(assembler_data.fe_collection.max_dofs_per_cell());
+    copy_data.dof_indices.resize(
+      assembler_data.fe_collection.max_dofs_per_cell());
+    copy_data.constraints = &assembly_plan.get_affine_constraints();
+
+    const CellIterator begin = assembly_plan.get_cells().begin();
+    WorkStream::run(
+      begin,
+      assembly_plan.get_cells().end(),
+      [begin](const CellIterator &cell, ScratchData &data, CopyData &copy) {
+        MatrixCreator::internal::laplace_assembler<
+          dim,
+          spacedim,
+          typename DoFHandler<dim, spacedim>::active_cell_iterator>(*cell,
+                                                                    data,
+                                                                    copy);
+        copy.cell_index = cell - begin;
+      },
+      [&assembly_plan, &matrix](const CopyData &copy) {
+        assembly_plan.distribute_local_to_global(copy.cell_index,
+                                                 copy.cell_matrix,
+                                                 matrix);
+      },
+      assembler_data,
+      copy_data);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   create_laplace_matrix(const Mapping<dim, spacedim> &   mapping,
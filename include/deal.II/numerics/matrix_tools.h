@@ -28,6 +28,7 @@
 #include <deal.II/lac/affine_constraints.h>
 
 #include <map>
+#include <vector>
 
 #ifdef DEAL_II_WITH_PETSC
 #  include <petscsys.h>
@@ -48,6 +49,7 @@ template <typename number>
 class FullMatrix;
 template <typename number>
 class SparseMatrix;
+class SparsityPattern;
 
 template <typename number>
 class BlockSparseMatrix;
@@ -58,6 +60,8 @@ template <int dim, int spacedim>
 class Mapping;
 template <int dim, int spacedim>
 class DoFHandler;
+template <int dim, int spacedim, typename number>
+class AssemblyPlan;
 
 namespace hp
 {
@@ -275,6 +279,22 @@ namespace MatrixCreator
     const Function<spacedim, number> *const a    = nullptr,
     const AffineConstraints<number> &constraints = AffineConstraints<number>());
 
+  /**
+   * Like the create_mass_matrix() function above, but take the degrees of
+   * freedom, the constraints, and the positions of the entries in @p matrix
+   * from an AssemblyPlan that has been set up for the sparsity pattern of
+   * @p matrix. This avoids searching for the entries in the rows of the
+   * matrix and is therefore faster when the matrix needs to be assembled
+   * many times on the same mesh.
+   */
+  template <int dim, int spacedim, typename number>
+  void
+  create_mass_matrix(const Mapping<dim, spacedim> &             mapping,
+                     const AssemblyPlan<dim, spacedim, number> &assembly_plan,
+                     const Quadrature<dim> &                    q,
+                     SparseMatrix<number> &                     matrix,
+                     const Function<spacedim, number> *const    a = nullptr);
+
   /**
    * Assemble the mass matrix and a right hand side vector. If no coefficient
    * is given (i.e., if the pointer to a function object is zero as it is by
@@ -508,6 +528,23 @@ namespace MatrixCreator
     const Function<spacedim> *const  a           = nullptr,
     const AffineConstraints<double> &constraints = AffineConstraints<double>());
 
+  /**
+   * Like the create_laplace_matrix() function above, but take the degrees of
+   * freedom, the constraints, and the positions of the entries in @p matrix
+   * from an AssemblyPlan that has been set up for the sparsity pattern of
+   * @p matrix. This avoids searching for the entries in the rows of the
+   * matrix and is therefore faster when the matrix needs to be assembled
+   * many times on the same mesh.
+   */
+  template <int dim, int spacedim>
+  void
+  create_laplace_matrix(
+    const Mapping<dim, spacedim> &             mapping,
+    const AssemblyPlan<dim, spacedim, double> &assembly_plan,
+    const Quadrature<dim> &                    q,
+    SparseMatrix<double> &                     matrix,
+    const Function<spacedim> *const            a = nullptr);
+
   /**
    * Assemble the Laplace matrix and a right hand side vector. If no
    * coefficient is given, it is assumed to be constant one.
@@ -994,6 +1031,104 @@ namespace MatrixTools
     Vector<number> &                                 local_rhs,
     const bool                                       eliminate_columns);
 
+  /**
+   * A class that applies Dirichlet boundary conditions to a SparseMatrix
+   * and the corresponding vectors in the same way as apply_boundary_values(),
+   * but for a set of constrained degrees of freedom that stays the same over
+   * many applications, e.g., in every step of a Newton iteration or of a
+   * time stepping scheme.
+   *
+   * To eliminate the columns of the constrained degrees of freedom,
+   * apply_boundary_values() looks up the entry of every row that couples
+   * to a constrained degree of freedom by a binary search in that row, once
+   * for every call. This class instead determines the positions of these
+   * entries in reinit(), once for a given sparsity pattern and set of
+   * constrained degrees of freedom, and stores them sorted by rows. The
+   * function apply() then only touches these entries and the rows of the
+   * constrained degrees of freedom. Since every row that is modified is
+   * only accessed by one thread, both the treatment of the constrained rows
+   * and the elimination of the columns are done in parallel.
+   *
+   * The result is the same as the one of apply_boundary_values(). Unlike
+   * that function, this class does not require the sparsity pattern to be
+   * symmetric for the elimination of the columns.
+   * @code
+   *   MatrixTools::BoundaryValueEliminator eliminator;
+   *   eliminator.reinit(sparsity_pattern, boundary_values);
+   *   for (unsigned int step = 0; step < n_steps; ++step)
+   *     {
+   *       assemble_system();
+   *       eliminator.apply(boundary_values, system_matrix, solution,
+   *                        system_rhs);
+   *       ...
+   *     }
+   * @endcode
+   */
+  class BoundaryValueEliminator
+  {
+  public:
+    /**
+     * Compute the positions of the entries of @p sparsity_pattern in the
+     * columns of the constrained degrees of freedom @p boundary_dofs. The
+     * sparsity pattern needs to be square and compressed, and needs to
+     * stay alive as long as this object is used.
+     */
+    void
+    reinit(const SparsityPattern &                     sparsity_pattern,
+           const std::vector<types::global_dof_index> &boundary_dofs);
+
+    /**
+     * Same as above, but take the constrained degrees of freedom from the
+     * keys of @p boundary_values.
+     */
+    template <typename number>
+    void
+    reinit(const SparsityPattern &                          sparsity_pattern,
+           const std::map<types::global_dof_index, number> &boundary_values);
+
+    /**
+     * Apply the boundary values to the system matrix and vectors in the
+     * same way as apply_boundary_values(). The matrix needs to be based on
+     * the sparsity pattern given to reinit(), and @p boundary_values needs
+     * to contain values for exactly the degrees of freedom given to
+     * reinit().
+     */
+    template <typename number>
+    void
+    apply(const std::map<types::global_dof_index, number> &boundary_values,
+          SparseMatrix<number> &                           matrix,
+          Vector<number> &                                 solution,
+          Vector<number> &                                 right_hand_side,
+          const bool eliminate_columns = true) const;
+
+  private:
+    /**
+     * The sparsity pattern given to reinit().
+     */
+    const SparsityPattern *sparsity_pattern = nullptr;
+
+    /**
+     * The sorted list of the constrained degrees of freedom.
+     */
+    std::vector<types::global_dof_index> boundary_dofs;
+
+    /**
+     * The rows of degrees of freedom that are not constrained but couple to
+     * constrained ones, and for each of them the range in the following two
+     * arrays that describes its entries in the columns of the constrained
+     * degrees of freedom.
+     */
+    std::vector<types::global_dof_index> coupled_rows;
+    std::vector<std::size_t>             coupled_row_starts;
+
+    /**
+     * The position of each of these entries within the entries of the
+     * matrix, and the index of its column within @p boundary_dofs.
+     */
+    std::vector<std::size_t>  coupled_entries;
+    std::vector<unsigned int> coupled_entry_boundary_indices;
+  };
+
   /**
    * Exception
    */
@@ -1002,6 +1137,22 @@ namespace MatrixTools
                    "blocks in either row or column direction does not use "
                    "the same blocks sizes as the solution vector or "
                    "right hand side vectors, respectively.");
+
+
+  /* ---------------------- inline and template functions ----------------- */
+
+  template <typename number>
+  inline void
+  BoundaryValueEliminator::reinit(
+    const SparsityPattern &                          sparsity_pattern,
+    const std::map<types::global_dof_index, number> &boundary_values)
+  {
+    std::vector<types::global_dof_index> dofs;
+    dofs.reserve(boundary_values.size());
+    for (const auto &boundary_value : boundary_values)
+      dofs.push_back(boundary_value.first);
+    reinit(sparsity_pattern, dofs);
+  }
 } // namespace MatrixTools
 
 
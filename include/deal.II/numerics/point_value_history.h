@@ -18,9 +18,11 @@
 #define dealii_point_value_history_h
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/dofs/dof_accessor.h>
@@ -41,6 +43,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -114,10 +117,16 @@ namespace internal
  * point will most likely change slightly, making the interpretation of the
  * data difficult, hence this is not implemented currently.)
  *
- * <li> Secondly, @p evaluate_field_at_requested_location calls @p
- * VectorTools::point_value to compute values at the specific point requested.
- * This method is valid for any FE that is supported by @p
- * VectorTools::point_value. Specifically, this method can be called by codes
+ * <li> Secondly, @p evaluate_field_at_requested_location computes values at
+ * the specific points requested. The points are located on the mesh only
+ * once with a Utilities::MPI::RemotePointEvaluation object, which is set up
+ * again automatically after the triangulation has changed, and all points
+ * are then evaluated in one pass over the cells containing them, with one
+ * FEValues object per cell for all points in that cell. On triangulations
+ * derived from parallel::TriangulationBase, the points are evaluated by the
+ * processes owning the cells they lie in and the values are sent to all
+ * processes in a single exchange, so every process stores the complete
+ * history. This method is valid for any FE, and it can be called by codes
  * using adaptive mesh refinement.
  *
  * <li>Finally, the class offers a function @p evaluate_field that takes a @p
@@ -207,6 +216,10 @@ namespace internal
  * node_monitor.write_gnuplot("node"); // write out data files
  *
  * @endcode
+ *
+ * In long computations, the history can also be written periodically while
+ * the computation goes on with write_gnuplot_in_background(), which writes a
+ * copy of the data stored so far on a separate task.
  */
 template <int dim>
 class PointValueHistory
@@ -277,6 +290,9 @@ public:
    * are added to the internal database in the order they appear in the list
    * and there is always a one to one correspondence between the requested
    * point and the added point, even if a point is requested multiple times.
+   * On distributed triangulations, only the locally owned and ghost cells
+   * are searched, so the support points selected on different processes
+   * may differ.
    */
   void
   add_points(const std::vector<Point<dim>> &locations);
@@ -377,13 +393,21 @@ public:
    * Extract values at the points actually requested from the VectorType
    * supplied and add them to the new dataset in vector_name. Unlike the other
    * evaluate_field methods this method does not care if the dof_handler has
-   * been modified because it uses calls to @p VectorTools::point_value to
-   * extract there data. Therefore, if only this method is used, the class is
-   * fully compatible with adaptive refinement. The component_mask supplied
-   * when the field was added is used to select components to extract. If a @p
+   * been modified because the points are located on the mesh again with a
+   * new Utilities::MPI::RemotePointEvaluation object after every change of
+   * the triangulation. Therefore, if only this method is used, the class is
+   * fully compatible with adaptive refinement. All points are evaluated in
+   * one pass over the cells that contain them, and values of points that lie
+   * on several cells are averaged. The component_mask supplied when the
+   * field was added is used to select components to extract. If a @p
    * DoFHandler is used, one (and only one) evaluate_field method must be
    * called for each dataset (time step, iteration, etc) for each vector_name,
    * otherwise a @p ExcDataLostSync error can occur.
+   *
+   * On distributed triangulations, this is a collective operation, all
+   * processes need to have added the same points, and @p solution needs to
+   * provide read access to the degrees of freedom of all locally owned
+   * cells, i.e., it needs to have ghost entries.
    */
   template <class VectorType>
   void
@@ -435,6 +459,32 @@ public:
                 const std::vector<Point<dim>> &postprocessor_locations =
                   std::vector<Point<dim>>());
 
+  /**
+   * Like write_gnuplot(), but write the files on a separate task, so that
+   * the computation can go on while the files are written. The data stored
+   * so far is copied before this function returns, so the current object
+   * can be modified immediately, and the files contain the datasets up to
+   * the time of the call. Before a new write is started, this function
+   * waits for the previous one to finish. The destructor waits for an
+   * unfinished write as well, but the @p DoFHandler needs to live until the
+   * write is finished, see wait_for_background_write().
+   *
+   * On distributed triangulations, every process stores the history of all
+   * points, so it is sufficient to call this function on one process.
+   */
+  void
+  write_gnuplot_in_background(
+    const std::string &            base_name,
+    const std::vector<Point<dim>> &postprocessor_locations =
+      std::vector<Point<dim>>());
+
+  /**
+   * Wait until the files started by write_gnuplot_in_background() have
+   * been written. Returns immediately if no write is going on.
+   */
+  void
+  wait_for_background_write();
+
 
   /**
    * Return a @p Vector with the indices of selected points flagged with a 1.
@@ -672,6 +722,20 @@ private:
    */
   unsigned int n_indep;
 
+  /**
+   * The cells and reference coordinates of the requested locations, used
+   * by evaluate_field_at_requested_location(). The object is created upon
+   * the first call of that function and deleted whenever the triangulation
+   * changes.
+   */
+  std::unique_ptr<Utilities::MPI::RemotePointEvaluation<dim>>
+    requested_location_cache;
+
+  /**
+   * The task started by write_gnuplot_in_background().
+   */
+  Threads::Task<> write_task;
+
 
   /**
    * A function that will be triggered through signals whenever the
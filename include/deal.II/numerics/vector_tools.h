@@ -21,6 +21,7 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/function.h>
+#include <deal.II/base/memory_space.h>
 #include <deal.II/base/patterns.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/quadrature_lib.h>
@@ -64,6 +65,14 @@ namespace hp
 }
 template <typename number>
 class AffineConstraints;
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  }
+} // namespace LinearAlgebra
 #endif
 
 // TODO: Move documentation of functions to the functions!
@@ -1040,6 +1049,29 @@ namespace VectorTools
     VectorType &                                              vec_result,
     const unsigned int                                        fe_component = 0);
 
+  /**
+   * Project the scalar @p function onto the finite element space described
+   * by the MatrixFree object @p data. The function is evaluated at the
+   * quadrature points of the first quadrature formula of @p data, which
+   * must therefore have been set up with update_quadrature_points and be
+   * a QGauss formula with
+   * <code>matrix_free.get_dof_handler().get_fe().degree+1</code> points in
+   * each direction. The projection itself is done as in the function above,
+   * i.e., with a matrix-free mass operator and a conjugate gradient solver,
+   * and thus without assembling a mass matrix.
+   */
+  template <int dim, typename VectorType>
+  void
+  project(
+    std::shared_ptr<
+      const MatrixFree<dim,
+                       typename VectorType::value_type,
+                       VectorizedArray<typename VectorType::value_type>>> data,
+    const AffineConstraints<typename VectorType::value_type> &constraints,
+    const Function<dim, typename VectorType::value_type> &    function,
+    VectorType &                                              vec_result,
+    const unsigned int                                        fe_component = 0);
+
   /**
    * Compute Dirichlet boundary conditions.  This function makes up a map of
    * degrees of freedom subject to Dirichlet boundary conditions and the
@@ -1323,6 +1355,124 @@ namespace VectorTools
     const ComponentMask &      component_mask = ComponentMask());
 
 
+  /**
+   * A class that interpolates boundary values like
+   * interpolate_boundary_values(), but for boundary functions that are
+   * evaluated many times on the same mesh, e.g., time-dependent Dirichlet
+   * data that needs to be re-interpolated in every time step.
+   *
+   * The work that only depends on the mesh and the finite element is done
+   * once by reinit(): This function loops over all faces on the given parts
+   * of the boundary, evaluates the mapping to obtain the locations of the
+   * support points of the degrees of freedom on these faces, and stores the
+   * indices of the degrees of freedom, their support points, and the vector
+   * component they belong to, grouped by boundary indicator. A degree of
+   * freedom that is located on several boundary faces is only stored once.
+   * The function interpolate() then only evaluates the functions with a
+   * single call to Function::value_list() or Function::vector_value_list()
+   * per boundary indicator and writes the results into the output argument:
+   * @code
+   *   VectorTools::BoundaryValueInterpolator<dim> interpolator;
+   *   interpolator.reinit(mapping, dof_handler, {0});
+   *
+   *   std::map<types::boundary_id, const Function<dim> *> function_map;
+   *   function_map[0] = &boundary_function;
+   *   while (time < end_time)
+   *     {
+   *       boundary_function.set_time(time);
+   *       std::map<types::global_dof_index, double> boundary_values;
+   *       interpolator.interpolate(function_map, boundary_values);
+   *       ...
+   *     }
+   * @endcode
+   * The result is the same as the one of interpolate_boundary_values() with
+   * the same arguments. The stored data becomes invalid when the mesh or the
+   * degrees of freedom change, in which case reinit() needs to be called
+   * again.
+   *
+   * @ingroup constraints
+   */
+  template <int dim, int spacedim = dim>
+  class BoundaryValueInterpolator
+  {
+  public:
+    /**
+     * Compute and store the degrees of freedom on the faces of @p dof with
+     * boundary indicators in @p boundary_ids, together with their support
+     * points as given by @p mapping and their vector components. Only the
+     * degrees of freedom of the vector components selected by
+     * @p component_mask are stored. The same restrictions on the finite
+     * element apply as for interpolate_boundary_values().
+     */
+    template <template <int, int> class DoFHandlerType>
+    void
+    reinit(
+      const Mapping<dim, spacedim> &       mapping,
+      const DoFHandlerType<dim, spacedim> &dof,
+      const std::set<types::boundary_id> & boundary_ids,
+      const ComponentMask &                component_mask = ComponentMask());
+
+    /**
+     * Evaluate the functions in @p function_map at the stored support points
+     * and write the values into @p boundary_values, keyed by the index of
+     * the degree of freedom. Entries already present in @p boundary_values
+     * for the stored degrees of freedom are overwritten. @p function_map
+     * needs to contain a function for each of the boundary indicators given
+     * to reinit(), with as many vector components as the finite element.
+     */
+    template <typename number>
+    void
+    interpolate(
+      const std::map<types::boundary_id, const Function<spacedim, number> *>
+        &                                        function_map,
+      std::map<types::global_dof_index, number> &boundary_values) const;
+
+    /**
+     * Like the previous function, but add the values as inhomogeneous
+     * constraints to @p constraints, in the same way as the respective
+     * interpolate_boundary_values() function. Degrees of freedom that are
+     * already constrained are left untouched.
+     */
+    template <typename number>
+    void
+    interpolate(
+      const std::map<types::boundary_id, const Function<spacedim, number> *>
+        &                        function_map,
+      AffineConstraints<number> &constraints) const;
+
+    /**
+     * Return the number of degrees of freedom whose values are set by
+     * interpolate().
+     */
+    types::global_dof_index
+    n_boundary_dofs() const;
+
+  private:
+    /**
+     * The number of vector components of the finite element given to
+     * reinit().
+     */
+    unsigned int n_components = 0;
+
+    /**
+     * The support points, indices and vector components of the degrees of
+     * freedom on the faces with one boundary indicator.
+     */
+    struct BoundaryDoFs
+    {
+      std::vector<Point<spacedim>>         points;
+      std::vector<types::global_dof_index> dof_indices;
+      std::vector<unsigned int>            components;
+    };
+
+    /**
+     * The degrees of freedom for each of the boundary indicators given to
+     * reinit().
+     */
+    std::map<types::boundary_id, BoundaryDoFs> boundary_dofs;
+  };
+
+
   /**
    * Project a function or a set of functions to the boundary of the domain.
    * In other words, compute the solution of the following problem: Find $u_h
@@ -2571,6 +2721,35 @@ namespace VectorTools
                        const Function<spacedim, double> *   weight   = nullptr,
                        const double                         exponent = 2.);
 
+  /**
+   * Same as above, but for a scalar finite element function given on the
+   * cells of the MatrixFree object @p matrix_free. The cell integrals are
+   * evaluated with FEEvaluation on batches of cells, using the quadrature
+   * formula with index @p quad_no of @p matrix_free, which must have been
+   * set up with update_quadrature_points and update_JxW_values as well as
+   * update_gradients for the norms involving gradients. The function
+   * @p exact_solution is evaluated separately for each lane of a cell
+   * batch.
+   *
+   * The norms NormType::L2_norm, NormType::H1_seminorm and NormType::H1_norm
+   * are supported. As for the function above, @p difference is resized to
+   * the number of active cells of the triangulation, the entries of cells
+   * that are not locally owned are set to zero, and the global error can be
+   * computed with compute_global_error(). The ghost values of
+   * @p fe_function are updated by this function if necessary.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+      &                          fe_function,
+    const Function<dim, Number> &exact_solution,
+    Vector<float> &              difference,
+    const NormType &             norm,
+    const unsigned int           dof_no  = 0,
+    const unsigned int           quad_no = 0);
+
   /**
    * Take a Vector @p cellwise_error of errors on each cell with
    * <tt>tria.n_active_cells()</tt> entries and return the global
@@ -2663,10 +2842,12 @@ namespace VectorTools
    * and then evaluate the shape functions there. You probably do not
    * want to use this function to evaluate the solution at <i>many</i>
    * points. For this kind of application, the FEFieldFunction class
-   * offers at least some optimizations. On the other hand, if you
-   * want to evaluate <i>many solutions</i> at the same point, you may
-   * want to look at the VectorTools::create_point_source_vector()
-   * function.
+   * offers at least some optimizations, and VectorTools::point_values()
+   * declared in vector_tools_evaluate.h evaluates a solution at a fixed set
+   * of points on a possibly distributed mesh much more efficiently. On the
+   * other hand, if you want to evaluate <i>many solutions</i> at the same
+   * point, you may want to look at the
+   * VectorTools::create_point_source_vector() function.
    *
    * @note If the cell in which the point is found is not locally owned, an
    *   exception of type VectorTools::ExcPointNotAvailableHere is thrown.
@@ -2729,10 +2910,12 @@ namespace VectorTools
    * and then evaluate the shape functions there. You probably do not
    * want to use this function to evaluate the solution at <i>many</i>
    * points. For this kind of application, the FEFieldFunction class
-   * offers at least some optimizations. On the other hand, if you
-   * want to evaluate <i>many solutions</i> at the same point, you may
-   * want to look at the VectorTools::create_point_source_vector()
-   * function.
+   * offers at least some optimizations, and VectorTools::point_values()
+   * declared in vector_tools_evaluate.h evaluates a solution at a fixed set
+   * of points on a possibly distributed mesh much more efficiently. On the
+   * other hand, if you want to evaluate <i>many solutions</i> at the same
+   * point, you may want to look at the
+   * VectorTools::create_point_source_vector() function.
    *
    * This function is used in the "Possibilities for extensions" part of the
    * results section of
@@ -2796,10 +2979,12 @@ namespace VectorTools
    * and then evaluate the shape functions there. You probably do not
    * want to use this function to evaluate the solution at <i>many</i>
    * points. For this kind of application, the FEFieldFunction class
-   * offers at least some optimizations. On the other hand, if you
-   * want to evaluate <i>many solutions</i> at the same point, you may
-   * want to look at the VectorTools::create_point_source_vector()
-   * function.
+   * offers at least some optimizations, and VectorTools::point_values()
+   * declared in vector_tools_evaluate.h evaluates a solution at a fixed set
+   * of points on a possibly distributed mesh much more efficiently. On the
+   * other hand, if you want to evaluate <i>many solutions</i> at the same
+   * point, you may want to look at the
+   * VectorTools::create_point_source_vector() function.
    *
    * @note If the cell in which the point is found is not locally owned, an
    * exception of type VectorTools::ExcPointNotAvailableHere is thrown.
@@ -2862,10 +3047,12 @@ namespace VectorTools
    * and then evaluate the shape functions there. You probably do not
    * want to use this function to evaluate the solution at <i>many</i>
    * points. For this kind of application, the FEFieldFunction class
-   * offers at least some optimizations. On the other hand, if you
-   * want to evaluate <i>many solutions</i> at the same point, you may
-   * want to look at the VectorTools::create_point_source_vector()
-   * function.
+   * offers at least some optimizations, and VectorTools::point_values()
+   * declared in vector_tools_evaluate.h evaluates a solution at a fixed set
+   * of points on a possibly distributed mesh much more efficiently. On the
+   * other hand, if you want to evaluate <i>many solutions</i> at the same
+   * point, you may want to look at the
+   * VectorTools::create_point_source_vector() function.
    *
    * @note If the cell in which the point is found is not locally owned, an
    * exception of type VectorTools::ExcPointNotAvailableHere is thrown.
@@ -2926,10 +3113,12 @@ namespace VectorTools
    * and then evaluate the shape functions there. You probably do not
    * want to use this function to evaluate the solution at <i>many</i>
    * points. For this kind of application, the FEFieldFunction class
-   * offers at least some optimizations. On the other hand, if you
-   * want to evaluate <i>many solutions</i> at the same point, you may
-   * want to look at the VectorTools::create_point_source_vector()
-   * function.
+   * offers at least some optimizations, and VectorTools::point_values()
+   * declared in vector_tools_evaluate.h evaluates a solution at a fixed set
+   * of points on a possibly distributed mesh much more efficiently. On the
+   * other hand, if you want to evaluate <i>many solutions</i> at the same
+   * point, you may want to look at the
+   * VectorTools::create_point_source_vector() function.
    *
    * @note If the cell in which the point is found is not locally owned, an
    * exception of type VectorTools::ExcPointNotAvailableHere is thrown.
@@ -2990,10 +3179,12 @@ namespace VectorTools
    * and then evaluate the shape functions there. You probably do not
    * want to use this function to evaluate the solution at <i>many</i>
    * points. For this kind of application, the FEFieldFunction class
-   * offers at least some optimizations. On the other hand, if you
-   * want to evaluate <i>many solutions</i> at the same point, you may
-   * want to look at the VectorTools::create_point_source_vector()
-   * function.
+   * offers at least some optimizations, and VectorTools::point_values()
+   * declared in vector_tools_evaluate.h evaluates a solution at a fixed set
+   * of points on a possibly distributed mesh much more efficiently. On the
+   * other hand, if you want to evaluate <i>many solutions</i> at the same
+   * point, you may want to look at the
+   * VectorTools::create_point_source_vector() function.
    *
    * @note If the cell in which the point is found is not locally owned, an
    * exception of type VectorTools::ExcPointNotAvailableHere is thrown.
@@ -3050,10 +3241,12 @@ namespace VectorTools
    * and then evaluate the shape functions there. You probably do not
    * want to use this function to evaluate the solution at <i>many</i>
    * points. For this kind of application, the FEFieldFunction class
-   * offers at least some optimizations. On the other hand, if you
-   * want to evaluate <i>many solutions</i> at the same point, you may
-   * want to look at the VectorTools::create_point_source_vector()
-   * function.
+   * offers at least some optimizations, and VectorTools::point_values()
+   * declared in vector_tools_evaluate.h evaluates a solution at a fixed set
+   * of points on a possibly distributed mesh much more efficiently. On the
+   * other hand, if you want to evaluate <i>many solutions</i> at the same
+   * point, you may want to look at the
+   * VectorTools::create_point_source_vector() function.
    *
    * @note If the cell in which the point is found is not locally owned, an
    * exception of type VectorTools::ExcPointNotAvailableHere is thrown.
@@ -3116,10 +3309,12 @@ namespace VectorTools
    * and then evaluate the shape functions there. You probably do not
    * want to use this function to evaluate the solution at <i>many</i>
    * points. For this kind of application, the FEFieldFunction class
-   * offers at least some optimizations. On the other hand, if you
-   * want to evaluate <i>many solutions</i> at the same point, you may
-   * want to look at the VectorTools::create_point_source_vector()
-   * function.
+   * offers at least some optimizations, and VectorTools::point_values()
+   * declared in vector_tools_evaluate.h evaluates a solution at a fixed set
+   * of points on a possibly distributed mesh much more efficiently. On the
+   * other hand, if you want to evaluate <i>many solutions</i> at the same
+   * point, you may want to look at the
+   * VectorTools::create_point_source_vector() function.
    *
    * @note If the cell in which the point is found is not locally owned, an
    * exception of type VectorTools::ExcPointNotAvailableHere is thrown.
@@ -1787,6 +1787,57 @@ namespace VectorTools
 
 
 
+  template <int dim, typename VectorType>
+  void
+  project(std::shared_ptr<const MatrixFree<
+            dim,
+            typename VectorType::value_type,
+            VectorizedArray<typename VectorType::value_type>>>      matrix_free,
+          const AffineConstraints<typename VectorType::value_type> &constraints,
+          const Function<dim, typename VectorType::value_type> &    function,
+          VectorType &                                              vec_result,
+          const unsigned int fe_component)
+  {
+    using Number = typename VectorType::value_type;
+    Assert(function.n_components == 1,
+           ExcDimensionMismatch(function.n_components, 1));
+
+    // evaluate the function at the quadrature points of all cells once,
+    // lane by lane, and then use the variant taking quadrature point data
+    FEEvaluation<dim, -1, 0, 1, Number> fe_eval(*matrix_free, fe_component);
+    const unsigned int n_cells = matrix_free->n_macro_cells();
+    Table<2, VectorizedArray<Number>> function_values(n_cells,
+                                                      fe_eval.n_q_points);
+    for (unsigned int cell = 0; cell < n_cells; ++cell)
+      {
+        fe_eval.reinit(cell);
+        for (unsigned int q = 0; q < fe_eval.n_q_points; ++q)
+          {
+            const Point<dim, VectorizedArray<Number>> point =
+              fe_eval.quadrature_point(q);
+            for (unsigned int v = 0;
+                 v < matrix_free->n_active_entries_per_cell_batch(cell);
+                 ++v)
+              {
+                Point<dim> p;
+                for (unsigned int d = 0; d < dim; ++d)
+                  p[d] = point[d][v];
+                function_values(cell, q)[v] = function.value(p);
+              }
+          }
+      }
+
+    project(matrix_free,
+            constraints,
+            [&function_values](const unsigned int cell, const unsigned int q) {
+              return function_values(cell, q);
+            },
+            vec_result,
+            fe_component);
+  }
+
+
+
   template <int dim, typename VectorType, int spacedim>
   void
   project(const Mapping<dim, spacedim> &                            mapping,
@@ -3297,6 +3348,288 @@ namespace VectorTools
 
 
 
+  // ----------- BoundaryValueInterpolator --------------------
+
+  template <int dim, int spacedim>
+  template <template <int, int> class DoFHandlerType>
+  void
+  BoundaryValueInterpolator<dim, spacedim>::reinit(
+    const Mapping<dim, spacedim> &       mapping,
+    const DoFHandlerType<dim, spacedim> &dof,
+    const std::set<types::boundary_id> & boundary_ids,
+    const ComponentMask &                component_mask)
+  {
+    Assert(
+      component_mask.represents_n_components(dof.get_fe(0).n_components()),
+      ExcMessage("The number of components in the mask has to be either "
+                 "zero or equal to the number of components in the finite "
+                 "element."));
+    Assert(boundary_ids.find(numbers::internal_face_boundary_id) ==
+             boundary_ids.end(),
+           ExcMessage("You cannot specify the special boundary indicator "
+                      "for interior faces."));
+
+    n_components = DoFTools::n_components(dof);
+    boundary_dofs.clear();
+
+    // first collect the degrees of freedom in the order in which
+    // interpolate_boundary_values() visits them. a degree of freedom on
+    // several boundary faces gets the value computed on the last of them
+    // there, so we do the same by only keeping the last occurrence below
+    struct Entry
+    {
+      types::global_dof_index dof_index;
+      types::boundary_id      boundary_id;
+      unsigned int            component;
+      Point<spacedim>         point;
+    };
+    std::vector<Entry> entries;
+
+    if (dim == 1)
+      {
+        for (const auto &cell : dof.active_cell_iterators())
+          for (unsigned int direction = 0;
+               direction < GeometryInfo<dim>::faces_per_cell;
+               ++direction)
+            if (cell->at_boundary(direction) &&
+                (boundary_ids.find(cell->face(direction)->boundary_id()) !=
+                 boundary_ids.end()))
+              {
+                const FiniteElement<dim, spacedim> &fe = cell->get_fe();
+                Assert(component_mask.n_selected_components(
+                         fe.n_components()) > 0,
+                       ComponentMask::ExcNoComponentSelected());
+
+                for (unsigned int i = 0; i < fe.dofs_per_vertex; ++i)
+                  {
+                    const unsigned int component =
+                      fe.face_system_to_component_index(i).first;
+                    if (component_mask[component])
+                      entries.push_back(
+                        {cell->vertex_dof_index(direction,
+                                                i,
+                                                cell->active_fe_index()),
+                         cell->face(direction)->boundary_id(),
+                         component,
+                         cell->vertex(direction)});
+                  }
+              }
+      }
+    else // dim > 1
+      {
+        const bool fe_is_system = (n_components != 1);
+
+        std::vector<types::global_dof_index> face_dofs;
+        face_dofs.reserve(DoFTools::max_dofs_per_face(dof));
+
+        // create the quadrature rules on the faces from the unit support
+        // points in the same way as interpolate_boundary_values()
+        const dealii::hp::FECollection<dim, spacedim> &finite_elements =
+          dof.get_fe_collection();
+        dealii::hp::QCollection<dim - 1> q_collection;
+        for (unsigned int f = 0; f < finite_elements.size(); ++f)
+          {
+            const FiniteElement<dim, spacedim> &fe = finite_elements[f];
+            if (fe.has_face_support_points())
+              q_collection.push_back(
+                Quadrature<dim - 1>(fe.get_unit_face_support_points()));
+            else
+              {
+                std::vector<Point<dim - 1>> unit_support_points(
+                  fe.dofs_per_face);
+                for (unsigned int i = 0; i < fe.dofs_per_face; ++i)
+                  if (fe.is_primitive(fe.face_to_cell_index(i, 0)))
+                    if (component_mask[fe.face_system_to_component_index(i)
+                                         .first] == true)
+                      unit_support_points[i] = fe.unit_face_support_point(i);
+
+                q_collection.push_back(
+                  Quadrature<dim - 1>(unit_support_points));
+              }
+          }
+
+        const dealii::hp::MappingCollection<dim, spacedim> mapping_collection(
+          mapping);
+        dealii::hp::FEFaceValues<dim, spacedim> x_fe_values(
+          mapping_collection,
+          finite_elements,
+          q_collection,
+          update_quadrature_points);
+
+        for (const auto &cell : dof.active_cell_iterators())
+          if (!cell->is_artificial())
+            for (unsigned int face_no = 0;
+                 face_no < GeometryInfo<dim>::faces_per_cell;
+                 ++face_no)
+              {
+                const FiniteElement<dim, spacedim> &fe = cell->get_fe();
+                const typename DoFHandlerType<dim, spacedim>::face_iterator
+                                         face        = cell->face(face_no);
+                const types::boundary_id boundary_id = face->boundary_id();
+
+                if ((boundary_ids.find(boundary_id) == boundary_ids.end()) ||
+                    (fe.dofs_per_face == 0))
+                  continue;
+
+                x_fe_values.reinit(cell, face_no);
+                const std::vector<Point<spacedim>> &dof_locations =
+                  x_fe_values.get_present_fe_values().get_quadrature_points();
+
+                face_dofs.resize(fe.dofs_per_face);
+                face->get_dof_indices(face_dofs, cell->active_fe_index());
+
+                for (unsigned int i = 0; i < face_dofs.size(); ++i)
+                  {
+                    if (fe_is_system == false)
+                      {
+                        entries.push_back(
+                          {face_dofs[i], boundary_id, 0, dof_locations[i]});
+                        continue;
+                      }
+
+                    unsigned int component;
+                    if (fe.is_primitive())
+                      component = fe.face_system_to_component_index(i).first;
+                    else
+                      {
+                        // non-primitive case. use the usual trick to
+                        // transfer the face dof index to the cell dof index
+                        // and make sure that this shape function is not
+                        // requested unless it is primitive
+                        const unsigned int cell_i =
+                          (dim == 2 ?
+                             (i < 2 * fe.dofs_per_vertex ?
+                                i :
+                                i + 2 * fe.dofs_per_vertex) :
+                             (dim == 3 ?
+                                (i < 4 * fe.dofs_per_vertex ?
+                                   i :
+                                   (i < 4 * fe.dofs_per_vertex +
+                                          4 * fe.dofs_per_line ?
+                                      i + 4 * fe.dofs_per_vertex :
+                                      i + 4 * fe.dofs_per_vertex +
+                                        8 * fe.dofs_per_line)) :
+                                numbers::invalid_unsigned_int));
+                        Assert(cell_i < fe.dofs_per_cell, ExcInternalError());
+
+                        if (!fe.is_primitive(cell_i))
+                          for (unsigned int c = 0; c < n_components; ++c)
+                            if (fe.get_nonzero_components(cell_i)[c])
+                              Assert(component_mask[c] == false,
+                                     FETools::ExcFENotPrimitive());
+
+                        component = fe.get_nonzero_components(cell_i)
+                                      .first_selected_component();
+                      }
+
+                    if (component_mask[component] == true)
+                      entries.push_back({face_dofs[i],
+                                         boundary_id,
+                                         component,
+                                         dof_locations[i]});
+                  }
+              }
+      }
+
+    std::map<types::global_dof_index, unsigned int> last_entry;
+    for (unsigned int e = 0; e < entries.size(); ++e)
+      last_entry[entries[e].dof_index] = e;
+
+    for (const auto &dof_and_entry : last_entry)
+      {
+        const Entry & entry      = entries[dof_and_entry.second];
+        BoundaryDoFs &these_dofs = boundary_dofs[entry.boundary_id];
+        these_dofs.points.push_back(entry.point);
+        these_dofs.dof_indices.push_back(entry.dof_index);
+        these_dofs.components.push_back(entry.component);
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename number>
+  void
+  BoundaryValueInterpolator<dim, spacedim>::interpolate(
+    const std::map<types::boundary_id, const Function<spacedim, number> *>
+      &                                        function_map,
+    std::map<types::global_dof_index, number> &boundary_values) const
+  {
+    std::vector<number>         values_scalar;
+    std::vector<Vector<number>> values_system;
+
+    for (const auto &dofs : boundary_dofs)
+      {
+        const auto function = function_map.find(dofs.first);
+        Assert(function != function_map.end(),
+               ExcMessage("No function is given for one of the boundary "
+                          "indicators passed to reinit()."));
+        Assert(n_components == function->second->n_components,
+               ExcDimensionMismatch(n_components,
+                                    function->second->n_components));
+
+        const BoundaryDoFs &these_dofs = dofs.second;
+        if (n_components == 1)
+          {
+            values_scalar.resize(these_dofs.points.size());
+            function->second->value_list(these_dofs.points, values_scalar, 0);
+            for (unsigned int i = 0; i < these_dofs.dof_indices.size(); ++i)
+              boundary_values[these_dofs.dof_indices[i]] = values_scalar[i];
+          }
+        else
+          {
+            // avoid construction of a memory allocating temporary if
+            // possible
+            if (values_system.size() < these_dofs.points.size())
+              values_system.resize(these_dofs.points.size(),
+                                   Vector<number>(n_components));
+            else
+              values_system.resize(these_dofs.points.size());
+            function->second->vector_value_list(these_dofs.points,
+                                                values_system);
+            for (unsigned int i = 0; i < these_dofs.dof_indices.size(); ++i)
+              boundary_values[these_dofs.dof_indices[i]] =
+                values_system[i](these_dofs.components[i]);
+          }
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename number>
+  void
+  BoundaryValueInterpolator<dim, spacedim>::interpolate(
+    const std::map<types::boundary_id, const Function<spacedim, number> *>
+      &                        function_map,
+    AffineConstraints<number> &constraints) const
+  {
+    std::map<types::global_dof_index, number> boundary_values;
+    interpolate(function_map, boundary_values);
+    for (const auto &boundary_value : boundary_values)
+      if (constraints.can_store_line(boundary_value.first) &&
+          !constraints.is_constrained(boundary_value.first))
+        {
+          constraints.add_line(boundary_value.first);
+          constraints.set_inhomogeneity(boundary_value.first,
+                                        boundary_value.second);
+        }
+  }
+
+
+
+  template <int dim, int spacedim>
+  types::global_dof_index
+  BoundaryValueInterpolator<dim, spacedim>::n_boundary_dofs() const
+  {
+    types::global_dof_index n_dofs = 0;
+    for (const auto &dofs : boundary_dofs)
+      n_dofs += dofs.second.dof_indices.size();
+    return n_dofs;
+  }
+
+
+
   // -------- implementation for project_boundary_values with std::map --------
 
 
@@ -8414,6 +8747,99 @@ namespace VectorTools
       exponent);
   }
 
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const LinearAlgebra::distributed::Vector<Number> &  fe_function,
+    const Function<dim, Number> &                       exact_solution,
+    Vector<float> &                                     difference,
+    const NormType &                                    norm,
+    const unsigned int                                  dof_no,
+    const unsigned int                                  quad_no)
+  {
+    Assert(norm == L2_norm || norm == H1_seminorm || norm == H1_norm,
+           ExcNotImplemented());
+    Assert(exact_solution.n_components == 1,
+           ExcDimensionMismatch(exact_solution.n_components, 1));
+    Assert(matrix_free.get_mg_level() == numbers::invalid_unsigned_int,
+           ExcMessage("The difference can only be computed on the active "
+                      "cells."));
+
+    const bool need_values    = (norm == L2_norm || norm == H1_norm);
+    const bool need_gradients = (norm == H1_seminorm || norm == H1_norm);
+
+    const bool ghosts_were_set = fe_function.has_ghost_elements();
+    if (!ghosts_were_set)
+      fe_function.update_ghost_values();
+
+    FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType> fe_eval(
+      matrix_free, dof_no, quad_no);
+
+    const DoFHandler<dim> &dof = matrix_free.get_dof_handler(dof_no);
+    difference.reinit(dof.get_triangulation().n_active_cells());
+
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      {
+        const unsigned int n_filled_lanes =
+          matrix_free.n_active_entries_per_cell_batch(cell);
+
+        fe_eval.reinit(cell);
+        fe_eval.read_dof_values(fe_function);
+        fe_eval.evaluate(need_values, need_gradients);
+
+        VectorizedArrayType cell_error = VectorizedArrayType();
+        for (unsigned int q = 0; q < fe_eval.n_q_points; ++q)
+          {
+            const Point<dim, VectorizedArrayType> point =
+              fe_eval.quadrature_point(q);
+
+            // evaluate the exact solution lane by lane
+            VectorizedArrayType exact_value = VectorizedArrayType();
+            Tensor<1, dim, VectorizedArrayType> exact_gradient;
+            for (unsigned int v = 0; v < n_filled_lanes; ++v)
+              {
+                Point<dim> p;
+                for (unsigned int d = 0; d < dim; ++d)
+                  p[d] = point[d][v];
+                if (need_values)
+                  exact_value[v] = exact_solution.value(p);
+                if (need_gradients)
+                  {
+                    const Tensor<1, dim, Number> gradient =
+                      exact_solution.gradient(p);
+                    for (unsigned int d = 0; d < dim; ++d)
+                      exact_gradient[d][v] = gradient[d];
+                  }
+              }
+
+            VectorizedArrayType error = VectorizedArrayType();
+            if (need_values)
+              {
+                const VectorizedArrayType value_difference =
+                  fe_eval.get_value(q) - exact_value;
+                error += value_difference * value_difference;
+              }
+            if (need_gradients)
+              {
+                const Tensor<1, dim, VectorizedArrayType> gradient_difference =
+                  fe_eval.get_gradient(q) - exact_gradient;
+                error += gradient_difference * gradient_difference;
+              }
+            cell_error += error * fe_eval.JxW(q);
+          }
+
+        for (unsigned int v = 0; v < n_filled_lanes; ++v)
+          difference(matrix_free.get_cell_iterator(cell, v, dof_no)
+                       ->active_cell_index()) = std::sqrt(cell_error[v]);
+      }
+
+    if (!ghosts_were_set)
+      fe_function.zero_out_ghosts();
+  }
+
   template <int dim, int spacedim, class InVector>
   double
   compute_global_error(const Triangulation<dim, spacedim> &tria,
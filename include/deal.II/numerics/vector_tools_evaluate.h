@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_vector_tools_evaluate_h
+#define dealii_vector_tools_evaluate_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace VectorTools
+{
+  /**
+   * Evaluate the finite element function given by @p dof_handler and
+   * @p vector at the points that have been passed to
+   * Utilities::MPI::RemotePointEvaluation::reinit() of @p cache by the
+   * current process. The locations of the points and the communication
+   * pattern stored in @p cache are reused, so the evaluation of
+   * several vectors, or of the same vector in several time steps, at the
+   * same points involves only the evaluation on the locally owned cells
+   * with FEPointEvaluation and a single exchange of the values.
+   *
+   * For points that have been found on several cells, e.g., on the
+   * interface between cells, the average of the values is returned, and
+   * points that have not been found on the mesh get a zero value. The
+   * @p n_components components of the element starting at
+   * @p first_selected_component are evaluated.
+   *
+   * For distributed vectors, the ghost values of the locally owned cells
+   * need to be available. This is a collective operation.
+   */
+  template <int n_components, int dim, typename VectorType>
+  std::vector<typename FEPointEvaluation<n_components, dim>::value_type>
+  point_values(const Utilities::MPI::RemotePointEvaluation<dim> &cache,
+               const DoFHandler<dim> &                           dof_handler,
+               const VectorType &                                vector,
+               const unsigned int first_selected_component = 0);
+
+
+
+  // ---------------------- template functions ----------------------------
+
+#ifndef DOXYGEN
+
+  template <int n_components, int dim, typename VectorType>
+  std::vector<typename FEPointEvaluation<n_components, dim>::value_type>
+  point_values(const Utilities::MPI::RemotePointEvaluation<dim> &cache,
+               const DoFHandler<dim> &                           dof_handler,
+               const VectorType &                                vector,
+               const unsigned int first_selected_component)
+  {
+    using value_type =
+      typename FEPointEvaluation<n_components, dim>::value_type;
+
+    Assert(cache.is_ready(),
+           ExcMessage("The RemotePointEvaluation object has not been set up "
+                      "with reinit()."));
+    Assert(&cache.get_triangulation() == &dof_handler.get_triangulation(),
+           ExcMessage("The RemotePointEvaluation object has been set up for "
+                      "a different triangulation than the DoFHandler."));
+
+    const auto evaluation_function =
+      [&](const ArrayView<value_type> &values,
+          const typename Utilities::MPI::RemotePointEvaluation<dim>::CellData
+            &cell_data) {
+        FEPointEvaluation<n_components, dim> evaluator(
+          cache.get_mapping(), dof_handler.get_fe(), first_selected_component);
+        std::vector<double> solution_values(
+          dof_handler.get_fe().dofs_per_cell);
+
+        for (unsigned int i = 0; i < cell_data.cells.size(); ++i)
+          {
+            const typename DoFHandler<dim>::active_cell_iterator cell(
+              &cache.get_triangulation(),
+              cell_data.cells[i].first,
+              cell_data.cells[i].second,
+              &dof_handler);
+
+            const unsigned int begin = cell_data.reference_point_ptrs[i];
+            const unsigned int n_points =
+              cell_data.reference_point_ptrs[i + 1] - begin;
+
+            evaluator.reinit(cell,
+                             make_array_view(cell_data.reference_point_values,
+                                             begin,
+                                             n_points));
+            cell->get_dof_values(vector,
+                                 solution_values.begin(),
+                                 solution_values.end());
+            evaluator.evaluate(make_array_view(solution_values), true, false);
+
+            for (unsigned int q = 0; q < n_points; ++q)
+              values[begin + q] = evaluator.get_value(q);
+          }
+      };
+
+    std::vector<value_type> evaluation_results, buffer;
+    cache.template evaluate_and_process<value_type>(evaluation_results,
+                                                    buffer,
+                                                    evaluation_function);
+
+    // average the values of points that have been found on several cells
+    const std::vector<unsigned int> &point_ptrs = cache.get_point_ptrs();
+    std::vector<value_type>          result(point_ptrs.size() - 1);
+    for (unsigned int i = 0; i + 1 < point_ptrs.size(); ++i)
+      if (point_ptrs[i + 1] > point_ptrs[i])
+        {
+          for (unsigned int j = point_ptrs[i]; j < point_ptrs[i + 1]; ++j)
+            result[i] += evaluation_results[j];
+          result[i] /= static_cast<double>(point_ptrs[i + 1] - point_ptrs[i]);
+        }
+
+    return result;
+  }
+
+#endif // DOXYGEN
+
+} // namespace VectorTools
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
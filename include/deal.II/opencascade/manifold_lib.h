@@ -21,8 +21,13 @@
 
 #ifdef DEAL_II_WITH_OPENCASCADE
 
+#  include <deal.II/base/bounding_box.h>
+#  include <deal.II/base/thread_local_storage.h>
+
 #  include <deal.II/grid/manifold.h>
 
+#  include <deal.II/numerics/rtree.h>
+
 #  include <deal.II/opencascade/utilities.h>
 
 // opencascade needs "HAVE_CONFIG_H" to be exported...
@@ -30,8 +35,12 @@
 #  include <Adaptor3d_Curve.hxx>
 #  include <Adaptor3d_HCurve.hxx>
 #  include <BRepAdaptor_Curve.hxx>
+#  include <TopoDS_Face.hxx>
 #  undef HAVE_CONFIG_H
 
+#  include <utility>
+#  include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 /**
@@ -60,6 +69,15 @@ namespace OpenCASCADE
    * face would be collapsed to the edge, and your surrounding points would
    * not be lying on the given shape, raising an exception.
    *
+   * If the shape contains faces, the constructor stores the bounding boxes of
+   * all faces in an RTree. A point is then only projected onto the faces
+   * whose bounding box is closer to the point than the closest projection
+   * found so far, visiting the faces in the order of the distance of their
+   * bounding boxes, and starting with the face that received the last
+   * projected point. Since the points added during the refinement of
+   * neighboring cells are close to each other, typically only a few faces
+   * have to be considered for each point, rather than all faces of the shape.
+   *
    * @author Luca Heltai, Andrea Mola, 2011--2014.
    */
   template <int dim, int spacedim>
@@ -110,6 +128,24 @@ namespace OpenCASCADE
      * Relative tolerance used by this class to compute distances.
      */
     const double tolerance;
+
+  private:
+    /**
+     * The faces of the shape @p sh.
+     */
+    std::vector<TopoDS_Face> faces;
+
+    /**
+     * The bounding boxes of the @p faces, together with the index of the
+     * face, stored in an RTree.
+     */
+    RTree<std::pair<BoundingBox<spacedim>, unsigned int>> face_tree;
+
+    /**
+     * The index of the face onto which the last point was projected, for
+     * each thread that calls project_to_manifold().
+     */
+    mutable Threads::ThreadLocalStorage<unsigned int> last_face;
   };
 
   /**
@@ -131,6 +167,10 @@ namespace OpenCASCADE
    * TopoDS_Shape, or when the direction you use at construction time does not
    * intersect the shape. An exception is thrown when this happens.
    *
+   * If the shape contains faces, the constructor stores the bounding boxes of
+   * all faces in an RTree, and the line along which a point is projected is
+   * only intersected with those faces whose bounding box it crosses.
+   *
    * @author Luca Heltai, Andrea Mola, 2011--2014.
    */
   template <int dim, int spacedim>
@@ -183,6 +223,23 @@ namespace OpenCASCADE
      * Relative tolerance used by this class to compute distances.
      */
     const double tolerance;
+
+  private:
+    /**
+     * The faces of the shape @p sh.
+     */
+    std::vector<TopoDS_Face> faces;
+
+    /**
+     * The bounding boxes of the @p faces, together with the index of the
+     * face, stored in an RTree.
+     */
+    RTree<std::pair<BoundingBox<spacedim>, unsigned int>> face_tree;
+
+    /**
+     * A bounding box of the whole shape @p sh.
+     */
+    BoundingBox<spacedim> shape_box;
   };
 
 
@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_particles_data_out_h
+#define dealii_particles_data_out_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/numerics/data_component_interpretation.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+#ifdef DEAL_II_WITH_P4EST
+
+namespace Particles
+{
+  /**
+   * This class writes the locations, the ids, and a selection of the
+   * properties of the locally owned particles of a ParticleHandler to a file
+   * in the xml based vtu file format of VTK, which can be read by
+   * visualization programs such as ParaView or VisIt. Every particle is
+   * written as a cell of type VTK_VERTEX.
+   *
+   * In contrast to the classes derived from DataOutInterface, this class
+   * does not build one patch per particle. build_output() only records which
+   * properties are written, and the write functions generate the data
+   * arrays of the file one after the other directly from the particle
+   * storage, each array being compressed and written before the next one is
+   * generated. This way, the memory needed for the output is a small
+   * multiple of the size of the largest array, e.g., three floats per
+   * particle for the locations, rather than several hundred bytes per
+   * particle for the patches.
+   *
+   * The class is used as follows:
+   * @code
+   *   Particles::DataOut<dim> particle_output;
+   *   particle_output.build_output(
+   *     particle_handler,
+   *     {"mass", "velocity", "velocity"},
+   *     {DataComponentInterpretation::component_is_scalar,
+   *      DataComponentInterpretation::component_is_part_of_vector,
+   *      DataComponentInterpretation::component_is_part_of_vector});
+   *   particle_output.write_vtu_in_parallel("particles.vtu", mpi_communicator);
+   * @endcode
+   *
+   * The particle handler must not be changed between the call to
+   * build_output() and the calls of the write functions.
+   */
+  template <int dim, int spacedim = dim>
+  class DataOut : public Subscriptor
+  {
+  public:
+    /**
+     * Default constructor.
+     */
+    DataOut() = default;
+
+    /**
+     * Select the particles of @p particle_handler and the properties that
+     * are written by the write functions. The vector
+     * @p data_component_names has either one entry for each property of the
+     * particles or is empty, in which case only the locations and the ids of
+     * the particles are written. Properties with an empty name are not
+     * written. Consecutive properties with the same name whose entry in
+     * @p data_component_interpretations is
+     * DataComponentInterpretation::component_is_part_of_vector are written
+     * as one vector field with at most three components. If
+     * @p data_component_interpretations is empty, all properties are
+     * written as scalar fields.
+     *
+     * This function only stores a pointer to the particle handler, the
+     * particles are read when one of the write functions is called.
+     */
+    void
+    build_output(
+      const ParticleHandler<dim, spacedim> &particle_handler,
+      const std::vector<std::string> &      data_component_names = {},
+      const std::vector<
+        DataComponentInterpretation::DataComponentInterpretation>
+        &data_component_interpretations = {});
+
+    /**
+     * Set the flags used by the write functions, e.g., the compression
+     * level.
+     */
+    void
+    set_flags(const DataOutBase::VtkFlags &flags);
+
+    /**
+     * Write the locally owned particles to @p out in the vtu file format.
+     */
+    void
+    write_vtu(std::ostream &out) const;
+
+    /**
+     * Write the locally owned particles of all processes in @p comm to a
+     * single vtu file with name @p filename, using MPI-IO. Every process
+     * writes the particles it owns as one piece of the file. This is a
+     * collective operation on the processes of @p comm.
+     */
+    void
+    write_vtu_in_parallel(const std::string &filename,
+                          const MPI_Comm &   comm) const;
+
+  private:
+    /**
+     * Write the piece of the vtu file with the locally owned particles.
+     */
+    void
+    write_vtu_piece(std::ostream &out) const;
+
+    /**
+     * The particle handler given to build_output().
+     */
+    SmartPointer<const ParticleHandler<dim, spacedim>, DataOut<dim, spacedim>>
+      particle_handler;
+
+    /**
+     * The fields written for each particle, described by their name, the
+     * index of the first property of the field, and the number of
+     * properties of the field.
+     */
+    std::vector<std::tuple<std::string, unsigned int, unsigned int>> fields;
+
+    /**
+     * The flags used by the write functions.
+     */
+    DataOutBase::VtkFlags vtk_flags;
+  };
+} // namespace Particles
+
+#endif // DEAL_II_WITH_P4EST
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -16,6 +16,8 @@
 #ifndef dealii_particles_particle_generator_h
 #define dealii_particles_particle_generator_h
 
+#include <deal.II/base/function.h>
+
 #include <deal.II/distributed/tria.h>
 
 #include <deal.II/fe/mapping.h>
@@ -42,6 +44,14 @@ namespace Particles
      * locations in @p particle_reference_locations. An optional @p mapping argument
      * can be used to map from @p particle_reference_locations to the real particle locations.
      *
+     * The real locations of the particles are computed in parallel on the
+     * available threads, and all particles are then inserted into the
+     * @p particle_handler at once. The ids of the particles are numbered
+     * consecutively through the locally owned cells, starting at the
+     * number of particles generated on all processes with a lower rank,
+     * which is computed by a single exclusive prefix sum over the
+     * processes.
+     *
      * @param triangulation The triangulation associated with the @p particle_handler.
      *
      * @param particle_reference_locations A vector of positions in the unit cell.
@@ -63,6 +73,74 @@ namespace Particles
       const Mapping<dim, spacedim> &      mapping =
         StaticMappingQ1<dim, spacedim>::mapping);
 
+    /**
+     * A function that generates @p n_particles_to_create particles in the
+     * locally owned cells of the @p triangulation, distributed according to
+     * the given @p probability_density_function. The function does not need
+     * to be normalized: The expected number of particles in a cell is
+     * proportional to the value of the function at the center of the cell
+     * times the measure of the cell. Within each cell, the particles are
+     * placed at random locations that are uniformly distributed in the
+     * reference cell.
+     *
+     * The number of particles of every process follows from the weights of
+     * its locally owned cells relative to the sum of the weights of all
+     * cells, which only requires one exclusive prefix sum and one sum over
+     * the processes. The particles are distributed to the cells in one of
+     * two ways:
+     * - If @p random_cell_selection is false, the number of particles in
+     *   every cell is determined by rounding the weighted share of the cell,
+     *   such that the cumulative number of particles over all cells of all
+     *   processes is as close as possible to the cumulative weight.
+     * - If @p random_cell_selection is true, every particle of a process is
+     *   placed into one of the locally owned cells of that process, chosen
+     *   at random with probabilities proportional to the weights of the
+     *   cells.
+     *
+     * In both cases, the total number of particles is exactly
+     * @p n_particles_to_create, and the ids of the particles are the
+     * numbers from zero to @p n_particles_to_create minus one, numbered
+     * consecutively through the locally owned cells of the processes in the
+     * order of their ranks. The random locations of the particles in a
+     * cell are drawn from a random number generator that is seeded with
+     * @p random_number_seed and the id of the first particle of the cell,
+     * so the result does not depend on the number of threads used to
+     * generate the particles in parallel, and the particles are inserted
+     * into the @p particle_handler at once.
+     *
+     * @param triangulation The triangulation associated with the @p particle_handler.
+     *
+     * @param probability_density_function A non-negative function that
+     * describes the density of the particles.
+     *
+     * @param random_cell_selection Whether the cells of the particles are
+     * selected at random (true) or by the deterministic rounding described
+     * above (false).
+     *
+     * @param n_particles_to_create The number of particles to create on all
+     * processes together.
+     *
+     * @param particle_handler The particle handler that will take ownership
+     * of the generated particles.
+     *
+     * @param mapping An optional mapping object that is used to map the
+     * random reference locations to the real cells of the triangulation. If
+     * no mapping is provided a MappingQ1 is assumed.
+     *
+     * @param random_number_seed The seed of the random number generators.
+     */
+    template <int dim, int spacedim = dim>
+    void
+    probabilistic_locations(
+      const Triangulation<dim, spacedim> &triangulation,
+      const Function<spacedim> &          probability_density_function,
+      const bool                          random_cell_selection,
+      const types::particle_index         n_particles_to_create,
+      ParticleHandler<dim, spacedim> &    particle_handler,
+      const Mapping<dim, spacedim> &      mapping =
+        StaticMappingQ1<dim, spacedim>::mapping,
+      const unsigned int random_number_seed = 5432);
+
   } // namespace Generators
 } // namespace Particles
 
@@ -345,8 +345,16 @@ namespace Particles
 
     if (n_properties > 0)
       {
-        properties = new double[n_properties];
-        ar &boost::serialization::make_array(properties, n_properties);
+        Assert(property_pool != nullptr,
+               ExcMessage("A particle with properties can only be loaded "
+                          "after a property pool has been set with "
+                          "set_property_pool()."));
+        AssertDimension(n_properties, property_pool->n_properties_per_slot());
+
+        if (properties == PropertyPool::invalid_handle)
+          properties = property_pool->allocate_properties_array();
+        ar &boost::serialization::make_array(
+          property_pool->get_properties(properties).data(), n_properties);
       }
   }
 
@@ -363,7 +371,8 @@ namespace Particles
     ar &location &reference_location &id &n_properties;
 
     if (n_properties > 0)
-      ar &boost::serialization::make_array(properties, n_properties);
+      ar &boost::serialization::make_array(get_properties().data(),
+                                           n_properties);
   }
 } // namespace Particles
 
@@ -21,6 +21,7 @@
 #include <deal.II/grid/tria.h>
 
 #include <deal.II/particles/particle.h>
+#include <deal.II/particles/particle_storage.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -35,7 +36,11 @@ namespace Particles
 #endif
 
   /**
-   * Accessor class used by ParticleIterator to access particle data.
+   * Accessor class used by ParticleIterator to access particle data. The
+   * data of the particle is not stored in the accessor, but in the
+   * internal::ParticleStorage object of the ParticleHandler, and the
+   * accessor only identifies the particle by its cell and its index among
+   * the particles of that cell.
    */
   template <int dim, int spacedim = dim>
   class ParticleAccessor
@@ -96,18 +101,18 @@ namespace Particles
     get_id() const;
 
     /**
-     * Tell the particle where to store its properties (even if it does not
-     * own properties). Usually this is only done once per particle, but
-     * since the particle generator does not know about the properties
-     * we want to do it not at construction time. Another use for this
-     * function is after particle transfer to a new process.
+     * Tell the particle where to store its properties. The properties of
+     * particles that are stored in a ParticleHandler always live in the
+     * storage of the handler, so this function does nothing. It is only
+     * kept for compatibility with the interface of the Particle class.
      */
     void
     set_property_pool(PropertyPool &property_pool);
 
     /**
-     * Return whether this particle has a valid property pool and a valid
-     * handle to properties.
+     * Return whether this particle has properties, i.e., whether the
+     * ParticleHandler that stores the particle was set up with a nonzero
+     * number of properties per particle.
      */
     bool
     has_properties() const;
@@ -122,7 +127,9 @@ namespace Particles
     set_properties(const std::vector<double> &new_properties);
 
     /**
-     * Get write-access to properties of this particle.
+     * Get write-access to properties of this particle. The returned view is
+     * invalidated by the insertion of further particles into the
+     * ParticleHandler.
      *
      * @return An ArrayView of the properties of this particle.
      */
@@ -193,29 +200,43 @@ namespace Particles
     ParticleAccessor();
 
     /**
-     * Construct an accessor from a reference to a map and an iterator to the
-     * map. This constructor is protected so that it can only be accessed by
-     * friend classes.
+     * Construct an accessor from a reference to the particle storage, an
+     * iterator to the entry of a cell in the storage, and the index of the
+     * particle among the particles of that cell. This constructor is
+     * protected so that it can only be accessed by friend classes.
      */
     ParticleAccessor(
-      const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-      const typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
-        &particle);
+      const internal::ParticleStorage<dim, spacedim> &storage,
+      const typename internal::ParticleStorage<dim, spacedim>::cell_map_iterator
+        &                cell,
+      const unsigned int index);
 
   private:
+    /**
+     * Return the handle of the particle in the data arrays of the storage.
+     */
+    typename internal::ParticleStorage<dim, spacedim>::Handle
+    get_handle() const;
+
     /**
      * A pointer to the container that stores the particles. Obviously,
      * this accessor is invalidated if the container changes.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> *map;
+    internal::ParticleStorage<dim, spacedim> *storage;
 
     /**
-     * An iterator into the container of particles. Obviously,
-     * this accessor is invalidated if the container changes.
+     * An iterator to the entry of the cell of the particle in the storage,
+     * or the end iterator of the cells of the storage if this accessor
+     * points past the last particle.
+     */
+    typename internal::ParticleStorage<dim, spacedim>::cell_map_iterator cell;
+
+    /**
+     * The index of the particle among the particles of its cell. Inserting
+     * particles does not change this index, but removing a particle
+     * from the same cell does.
      */
-    typename std::multimap<internal::LevelInd,
-                           Particle<dim, spacedim>>::iterator particle;
+    unsigned int index;
 
     // Make ParticleIterator a friend to allow it constructing
     // ParticleAccessors.
@@ -233,7 +254,19 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::serialize(Archive &          ar,
                                              const unsigned int version)
   {
-    return particle->second.serialize(ar, version);
+    (void)version;
+
+    const typename internal::ParticleStorage<dim, spacedim>::Handle handle =
+      get_handle();
+    unsigned int n_properties = storage->n_properties_per_particle();
+
+    ar &storage->get_location(handle) &storage->get_reference_location(handle)
+      &storage->get_id(handle) &n_properties;
+
+    AssertDimension(n_properties, storage->n_properties_per_particle());
+    if (n_properties > 0)
+      ar &boost::serialization::make_array(
+        storage->get_properties(handle).data(), n_properties);
   }
 
 
@@ -25,19 +25,83 @@
 
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/grid/grid_tools_cache.h>
+
 #include <deal.II/particles/particle.h>
 #include <deal.II/particles/particle_iterator.h>
+#include <deal.II/particles/particle_storage.h>
 #include <deal.II/particles/property_pool.h>
 
 #include <boost/range/iterator_range.hpp>
+#include <boost/signals2/connection.hpp>
 #include <boost/serialization/map.hpp>
 
 DEAL_II_NAMESPACE_OPEN
 
 #ifdef DEAL_II_WITH_P4EST
 
+class MemoryReport;
+
 namespace Particles
 {
+  namespace internal
+  {
+    /**
+     * The communication pattern of the last exchange of ghost particles,
+     * stored by ParticleHandler::exchange_ghost_particles() if requested so
+     * that ParticleHandler::update_ghost_particles() can resend the data of
+     * the same ghost particles without determining again which particles
+     * have to be sent, and without communicating the sizes of the messages.
+     */
+    template <int dim, int spacedim>
+    struct GhostParticlePartitioner
+    {
+      /**
+       * Whether the cache describes the current set of ghost particles.
+       */
+      bool valid = false;
+
+      /**
+       * The processes with which ghost particles are exchanged.
+       */
+      std::vector<types::subdomain_id> neighbors;
+
+      /**
+       * The number of particles sent to each process in @p neighbors.
+       */
+      std::vector<unsigned int> n_send_particles;
+
+      /**
+       * The number of particles received from each process in
+       * @p neighbors.
+       */
+      std::vector<unsigned int> n_recv_particles;
+
+      /**
+       * The locally owned particles that are sent to each process, in the
+       * order in which they are sent.
+       */
+      std::map<types::subdomain_id,
+               std::vector<ParticleIterator<dim, spacedim>>>
+        ghost_particles_by_domain;
+
+      /**
+       * The ghost particles in the order in which their data is received.
+       */
+      std::vector<ParticleIterator<dim, spacedim>> ghost_particles_iterators;
+
+      /**
+       * Buffers for the data sent and received in
+       * ParticleHandler::update_ghost_particles(), kept to avoid repeated
+       * allocation.
+       */
+      std::vector<char> send_data;
+      std::vector<char> recv_data;
+    };
+  } // namespace internal
+
+
+
   /**
    * This class manages the storage and handling of particles. It provides
    * the data structures necessary to store particles efficiently, accessor
@@ -48,6 +112,14 @@ namespace Particles
    * and particles that belong to neighbor processes and live in the ghost cells
    * around the locally owned domain "ghost particles".
    *
+   * The particles are stored cell by cell in a structure-of-arrays layout
+   * (see internal::ParticleStorage): the locations, reference locations,
+   * ids, and properties of all particles are kept in one array each, and
+   * after each of the bulk operations of this class, i.e., the insertion of
+   * many particles at once, sort_particles_into_subdomains_and_cells(), and
+   * the transfer of particles during mesh refinement, the data of the
+   * particles of each cell is stored contiguously in these arrays.
+   *
    * @ingroup Particle
    */
   template <int dim, int spacedim = dim>
@@ -191,16 +263,29 @@ namespace Particles
       const;
 
     /**
-     * Remove a particle pointed to by the iterator.
+     * Remove a particle pointed to by the iterator. This invalidates
+     * iterators to the particles that follow the removed particle in the
+     * same cell. To remove many particles, use remove_particles() instead.
      */
     void
     remove_particle(const particle_iterator &particle);
 
+    /**
+     * Remove all particles pointed to by the iterators in
+     * @p particles_to_remove. The
+     * iterators are interpreted with respect to the state before the
+     * removal, and each particle may only be listed once. This function is
+     * of $O(N)$ complexity for the $N$ particles in the affected cells.
+     */
+    void
+    remove_particles(const std::vector<particle_iterator> &particles_to_remove);
+
     /**
      * Insert a particle into the collection of particles. Return an iterator
      * to the new position of the particle. This function involves a copy of
-     * the particle and its properties. Note that this function is of $O(N \log
-     * N)$ complexity for $N$ particles.
+     * the particle and its properties. The new particle is placed after the
+     * particles already present in the cell @p cell, and the function is of
+     * $O(\log C)$ complexity for $C$ cells that contain particles.
      */
     particle_iterator
     insert_particle(
@@ -231,6 +316,33 @@ namespace Particles
     void
     insert_particles(const std::vector<Point<spacedim>> &positions);
 
+    /**
+     * Insert a number of particles whose cells and reference locations are
+     * already known, as is the case for particles created by the functions
+     * in the Particles::Generators namespace. The particles of the cell
+     * <tt>cells[c]</tt> are the ones with the indices from
+     * <tt>cell_start[c]</tt> to <tt>cell_start[c+1]-1</tt> in the arrays
+     * @p positions and @p reference_locations, i.e., @p cell_start needs
+     * to have one more entry than @p cells. The particle with index
+     * <tt>i</tt> in these arrays gets the id <tt>first_particle_index +
+     * i</tt>.
+     *
+     * In contrast to calling insert_particle() for every particle, the
+     * memory for all particles is reserved at once, the particle storage of
+     * each cell is only looked up once, and the particles are sorted by
+     * their cells only once at the end. The function calls
+     * update_cached_numbers() and is therefore a collective operation on the
+     * processes of the communicator of the triangulation.
+     */
+    void
+    insert_particles(
+      const std::vector<
+        typename Triangulation<dim, spacedim>::active_cell_iterator> &cells,
+      const std::vector<unsigned int> &                            cell_start,
+      const std::vector<Point<spacedim>> &                         positions,
+      const std::vector<Point<dim>> &                   reference_locations,
+      const types::particle_index                       first_particle_index);
+
     /**
      * This function allows to register three additional functions that are
      * called every time a particle is transferred to another process
@@ -336,9 +448,33 @@ namespace Particles
      * Exchange all particles that live in cells that are ghost cells to
      * other processes. Clears and re-populates the ghost_neighbors
      * member variable.
+     *
+     * If @p enable_ghost_cache is true, the communication pattern of the
+     * exchange is stored, so that later calls to update_ghost_particles()
+     * can update the ghost particles at a much lower cost.
      */
     void
-    exchange_ghost_particles();
+    exchange_ghost_particles(const bool enable_ghost_cache = false);
+
+    /**
+     * Update the locations, reference locations, and properties of the
+     * ghost particles, as well as the data written by the store callback
+     * registered with register_additional_store_load_functions(), from the
+     * current state of the particles on their owning processes. This
+     * function reuses the communication pattern of the last call of
+     * exchange_ghost_particles() with <tt>enable_ghost_cache = true</tt>
+     * and only sends the particle data in buffers of known size, without the
+     * cell information and without communicating the size of the messages.
+     *
+     * This function can only be used as long as the particles have not
+     * changed their cells or processes, i.e., it must not be called after
+     * sort_particles_into_subdomains_and_cells(), after the insertion or
+     * removal of particles, or after mesh refinement, before the ghost
+     * particles have been exchanged again with exchange_ghost_particles().
+     * This is a collective operation.
+     */
+    void
+    update_ghost_particles();
 
     /**
      * Callback function that should be called before every refinement
@@ -356,6 +492,79 @@ namespace Particles
     void
     register_load_callback_function(const bool serialization);
 
+    /**
+     * Connect a function to the
+     * Triangulation::Signals::cell_weight signal of the triangulation that
+     * adds the weight
+     * @code
+     *   cell_weight + particle_weight * n_particles_in_cell
+     * @endcode
+     * to the weight of each locally owned cell whenever the triangulation
+     * is repartitioned, i.e., during repartition() and
+     * parallel::distributed::Triangulation::repartition(), and during mesh
+     * refinement.
+     * Since the triangulation assigns a weight of 1000 to every cell, a
+     * @p particle_weight of 1000 means that processing a particle is
+     * assumed to be as expensive as processing a cell. The particles of
+     * cells that are going to be coarsened are attributed to their parent
+     * cell.
+     *
+     * This allows to balance the work of particle-laden computations
+     * between the processes without writing a weight function by hand.
+     * Calling this function again replaces the previously connected
+     * function, and the connection is released when this object is
+     * destroyed or reinitialized, or when
+     * disconnect_particle_weights() is called.
+     */
+    void
+    connect_particle_weights(const unsigned int particle_weight,
+                             const unsigned int cell_weight = 0);
+
+    /**
+     * Disconnect the function connected by connect_particle_weights() from
+     * the triangulation, if any.
+     */
+    void
+    disconnect_particle_weights();
+
+    /**
+     * Repartition the triangulation and move the particles to the processes
+     * that own their cells afterwards. This function registers the particles
+     * for transfer with register_store_callback_function(), calls
+     * parallel::distributed::Triangulation::repartition(), and unpacks the
+     * particles with register_load_callback_function(). Together with
+     * connect_particle_weights(), this balances the number of particles
+     * between the processes without refining the mesh.
+     *
+     * Other data attached to the cells of the triangulation, for example
+     * solution vectors transferred by a
+     * parallel::distributed::SolutionTransfer object, has to be prepared
+     * for the transfer before and unpacked after calling this function, as
+     * for every other repartitioning of the triangulation. This is a
+     * collective operation.
+     */
+    void
+    repartition();
+
+    /**
+     * Return an estimate for the memory consumption (in bytes) of this
+     * object, consisting of the storage of the locally owned and the ghost
+     * particles, the property pool, and the cached communication pattern of
+     * the ghost particles.
+     */
+    std::size_t
+    memory_consumption() const;
+
+    /**
+     * Add the memory consumption of the parts of this object listed in
+     * memory_consumption() to @p report, as separate entries with the
+     * prefix @p name.
+     */
+    void
+    add_memory_consumption(
+      MemoryReport &     report,
+      const std::string &name = "ParticleHandler") const;
+
     /**
      * Serialize the contents of this class.
      */
@@ -377,18 +586,33 @@ namespace Particles
     SmartPointer<const Mapping<dim, spacedim>, ParticleHandler<dim, spacedim>>
       mapping;
 
+    /**
+     * A cache of geometric information about the triangulation, in
+     * particular the R-tree of the used vertices, that is used to locate
+     * the cells around particles that have left their previous cell. The
+     * cache is kept between calls and updates itself whenever the
+     * triangulation changes.
+     */
+    std::unique_ptr<GridTools::Cache<dim, spacedim>> triangulation_cache;
+
     /**
      * Set of particles currently living in the local domain, organized by
      * the level/index of the cell they are in.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> particles;
+    internal::ParticleStorage<dim, spacedim> particles;
 
     /**
      * Set of particles that currently live in the ghost cells of the local
      * domain, organized by the level/index of the cell they are in. These
      * particles are equivalent to the ghost entries in distributed vectors.
      */
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>> ghost_particles;
+    internal::ParticleStorage<dim, spacedim> ghost_particles;
+
+    /**
+     * The communication pattern of the last exchange of ghost particles,
+     * used by update_ghost_particles().
+     */
+    internal::GhostParticlePartitioner<dim, spacedim> ghost_particles_cache;
 
     /**
      * This variable stores how many particles are stored globally. It is
@@ -464,20 +688,33 @@ namespace Particles
      */
     unsigned int handle;
 
+    /**
+     * The weight of a particle and the additional weight of a cell set
+     * by connect_particle_weights().
+     */
+    unsigned int particle_weight;
+    unsigned int additional_cell_weight;
+
+    /**
+     * The connection of the cell weight function to the triangulation set
+     * up by connect_particle_weights(). The connection is released
+     * automatically when this object is destroyed.
+     */
+    boost::signals2::scoped_connection cell_weight_connection;
+
 #  ifdef DEAL_II_WITH_MPI
     /**
      * Transfer particles that have crossed subdomain boundaries to other
      * processors.
-     * All received particles and their new cells will be appended to the
-     * @p received_particles vector.
+     * All received particles will be inserted into their new cells in
+     * @p received_particles.
      *
      * @param [in] particles_to_send All particles that should be sent and
      * their new subdomain_ids are in this map.
      *
-     * @param [in,out] received_particles Vector that stores all received
-     * particles. Note that it is not required nor checked that the list
-     * is empty, received particles are simply attached to the end of
-     * the vector.
+     * @param [in,out] received_particles The container that stores all
+     * received particles. Note that it is not required nor checked that the
+     * container is empty, received particles are simply added to it.
      *
      * @param [in] new_cells_for_particles Optional vector of cell
      * iterators with the same structure as @p particles_to_send. If this
@@ -485,13 +722,15 @@ namespace Particles
      * particle to be send in which the particle belongs. This parameter
      * is necessary if the cell information of the particle iterator is
      * outdated (e.g. after particle movement).
+     *
+     * @param [in] build_cache If true, the communication pattern and the
+     * received particles are recorded in ghost_particles_cache.
      */
     void
     send_recv_particles(
       const std::map<types::subdomain_id, std::vector<particle_iterator>>
         &particles_to_send,
-      std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-        &received_particles,
+      internal::ParticleStorage<dim, spacedim> &received_particles,
       const std::map<
         types::subdomain_id,
         std::vector<
@@ -499,9 +738,18 @@ namespace Particles
         &new_cells_for_particles = std::map<
           types::subdomain_id,
           std::vector<
-            typename Triangulation<dim, spacedim>::active_cell_iterator>>());
+            typename Triangulation<dim, spacedim>::active_cell_iterator>>(),
+      const bool build_cache = false);
 #  endif
 
+    /**
+     * Return the number of bytes that update_ghost_particles() sends per
+     * particle, i.e., the serialized size of a particle plus the size of the
+     * data written by the store callback.
+     */
+    std::size_t
+    ghost_particle_update_size() const;
+
     /**
      * Called by listener functions from Triangulation for every cell
      * before a refinement step. All particles have to be attached to their
@@ -512,6 +760,17 @@ namespace Particles
       const typename Triangulation<dim, spacedim>::cell_iterator &cell,
       const typename Triangulation<dim, spacedim>::CellStatus     status) const;
 
+    /**
+     * Called by the triangulation for every locally owned cell when it is
+     * repartitioned, after connect_particle_weights() has been called.
+     * Returns the weight of the particles in the cell @p cell, see
+     * connect_particle_weights().
+     */
+    unsigned int
+    cell_weight(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const typename Triangulation<dim, spacedim>::CellStatus     status) const;
+
     /**
      * Called by listener functions after a refinement step. The local map
      * of particles has to be read from the triangulation user_pointer.
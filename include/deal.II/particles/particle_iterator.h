@@ -46,13 +46,14 @@ namespace Particles
 
     /**
      * Constructor of the iterator. Takes a reference to the particle
-     * container, and an iterator to the cell-particle pair.
+     * container, an iterator to the entry of a cell in the container, and
+     * the index of the particle among the particles of that cell.
      */
     ParticleIterator(
-      const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-      const typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
-        &particle);
+      const internal::ParticleStorage<dim, spacedim> &storage,
+      const typename internal::ParticleStorage<dim, spacedim>::cell_map_iterator
+        &                cell,
+      const unsigned int index);
 
     /**
      * Dereferencing operator, returns a reference to an accessor. Usage is thus
@@ -0,0 +1,494 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_particles_particle_storage_h
+#define dealii_particles_particle_storage_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/point.h>
+
+#include <deal.II/particles/particle.h>
+
+#include <map>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  namespace internal
+  {
+    /**
+     * The container in which a ParticleHandler stores its particles.
+     *
+     * The data of the particles is kept in a structure-of-arrays layout:
+     * the locations, reference locations, ids, and properties of all
+     * particles are stored in one array each, and a particle is identified
+     * by a handle, i.e., its index into these arrays. Slots of removed
+     * particles are recycled by later insertions. The association of
+     * particles with cells is stored as a map from the level and index of a
+     * cell to the list of handles of the particles in that cell; only cells
+     * that contain particles are stored in this map. Iterating over the
+     * map therefore visits the particles in the same order as a
+     * std::multimap keyed by the cell would, and inserting a particle into
+     * a cell does not invalidate the positions of other particles.
+     *
+     * After insertions and removals, the particles of one cell are in
+     * general scattered over the arrays. The function reorder_by_cell()
+     * renumbers the handles such that the data of the particles is stored
+     * in the order of the cells, i.e., the particles of each cell occupy a
+     * contiguous range of the arrays. This makes loops over the particles
+     * of a cell access consecutive memory. The ParticleHandler calls this
+     * function after each of its bulk operations.
+     */
+    template <int dim, int spacedim = dim>
+    class ParticleStorage
+    {
+    public:
+      /**
+       * The type used to identify a particle in the data arrays.
+       */
+      using Handle = unsigned int;
+
+      /**
+       * The type of the map from cells to the particles they contain.
+       */
+      using cell_map = std::map<LevelInd, std::vector<Handle>>;
+
+      /**
+       * An iterator into the map of cells.
+       */
+      using cell_map_iterator = typename cell_map::iterator;
+
+      /**
+       * Constructor. Stores the number of properties per particle.
+       */
+      ParticleStorage(const unsigned int n_properties = 0);
+
+      /**
+       * Remove all particles and set the number of properties per particle
+       * to @p n_properties.
+       */
+      void
+      reinit(const unsigned int n_properties);
+
+      /**
+       * Remove all particles and release the memory they occupy.
+       */
+      void
+      clear();
+
+      /**
+       * Reserve memory for @p n_particles particles.
+       */
+      void
+      reserve(const std::size_t n_particles);
+
+      /**
+       * Return the number of particles stored in this object.
+       */
+      std::size_t
+      n_particles() const;
+
+      /**
+       * Return the number of properties stored per particle.
+       */
+      unsigned int
+      n_properties_per_particle() const;
+
+      /**
+       * Return the number of particles in the cell @p cell.
+       */
+      unsigned int
+      n_particles_in_cell(const LevelInd &cell) const;
+
+      /**
+       * Return the largest number of particles in any cell.
+       */
+      unsigned int
+      max_n_particles_per_cell() const;
+
+      /**
+       * Return an iterator to the first cell that contains particles.
+       */
+      cell_map_iterator
+      begin_cells();
+
+      /**
+       * Return an iterator past the last cell that contains particles.
+       */
+      cell_map_iterator
+      end_cells();
+
+      /**
+       * Return an iterator to the first cell that contains particles and
+       * that is not ordered before @p cell. If @p cell contains particles,
+       * this is the iterator to @p cell itself.
+       */
+      cell_map_iterator
+      lower_bound(const LevelInd &cell);
+
+      /**
+       * Return an iterator to the entry of the cell @p cell, creating an
+       * empty entry if the cell does not contain particles yet. The empty
+       * entry is removed again by erase() and remove(), but it is the
+       * responsibility of the caller to insert particles into it.
+       */
+      cell_map_iterator
+      get_cell(const LevelInd &cell);
+
+      /**
+       * Insert a copy of @p particle into the cell @p cell and return the
+       * index of the new particle within the cell. The properties of the
+       * new particle are copied from @p particle if it has any, and are
+       * set to zero otherwise.
+       */
+      unsigned int
+      insert(const cell_map_iterator &      cell,
+             const Particle<dim, spacedim> &particle);
+
+      /**
+       * Insert a new particle with the given @p location, @p reference_location
+       * and @p id into the cell @p cell and return the index of the new
+       * particle within the cell. The properties of the new particle are set
+       * to zero.
+       */
+      unsigned int
+      insert(const cell_map_iterator &   cell,
+             const Point<spacedim> &     location,
+             const Point<dim> &          reference_location,
+             const types::particle_index id);
+
+      /**
+       * Insert a new particle into the cell @p cell whose data is read from
+       * the memory location @p data in the format written by
+       * Particle::write_data(), and return the index of the new particle
+       * within the cell. The pointer @p data is advanced by the
+       * serialized size of the particle.
+       */
+      unsigned int
+      insert(const cell_map_iterator &cell, const void *&data);
+
+      /**
+       * Overwrite the data of the existing particle @p handle with the data
+       * read from the memory location @p data in the format written by
+       * Particle::write_data(). The pointer @p data is advanced by the
+       * serialized size of the particle.
+       */
+      void
+      read_data(const Handle handle, const void *&data);
+
+      /**
+       * Insert a copy of the particle @p source of this object into the cell
+       * @p cell and return the index of the new particle within the cell.
+       */
+      unsigned int
+      insert_copy(const cell_map_iterator &cell, const Handle source);
+
+      /**
+       * Remove the particle with index @p index within the cell @p cell.
+       * The particles in the same cell that follow the removed particle
+       * move one position forward, and the entry of the cell is removed
+       * if it does not contain any particles anymore.
+       */
+      void
+      erase(const cell_map_iterator &cell, const unsigned int index);
+
+      /**
+       * Remove all particles whose positions, given as the pair of the cell
+       * and the index within the cell, are listed in @p positions. All
+       * positions refer to the state before the removal, and each position
+       * may only appear once. This is more efficient than removing the
+       * particles one by one with erase().
+       */
+      void
+      remove(
+        const std::vector<std::pair<cell_map_iterator, unsigned int>>
+          &positions);
+
+      /**
+       * Renumber the handles of all particles such that the data of the
+       * particles is stored in the order in which they are visited by an
+       * iteration over the cells, i.e., such that the particles of each cell
+       * form a contiguous range of the data arrays. This also releases the
+       * slots of particles that have been removed.
+       */
+      void
+      reorder_by_cell();
+
+      /**
+       * Return the handle of the particle with index @p index within the cell
+       * @p cell.
+       */
+      Handle
+      get_handle(const cell_map_iterator &cell, const unsigned int index) const;
+
+      /**
+       * Return a reference to the location of the particle @p handle.
+       */
+      Point<spacedim> &
+      get_location(const Handle handle);
+
+      /**
+       * Return a reference to the location of the particle @p handle.
+       */
+      const Point<spacedim> &
+      get_location(const Handle handle) const;
+
+      /**
+       * Return a reference to the reference location of the particle
+       * @p handle.
+       */
+      Point<dim> &
+      get_reference_location(const Handle handle);
+
+      /**
+       * Return a reference to the reference location of the particle
+       * @p handle.
+       */
+      const Point<dim> &
+      get_reference_location(const Handle handle) const;
+
+      /**
+       * Return a reference to the id of the particle @p handle.
+       */
+      types::particle_index &
+      get_id(const Handle handle);
+
+      /**
+       * Return the id of the particle @p handle.
+       */
+      types::particle_index
+      get_id(const Handle handle) const;
+
+      /**
+       * Return a view to the properties of the particle @p handle. The view
+       * is invalidated by the insertion of further particles.
+       */
+      ArrayView<double>
+      get_properties(const Handle handle);
+
+      /**
+       * Return a view to the properties of the particle @p handle. The view
+       * is invalidated by the insertion of further particles.
+       */
+      ArrayView<const double>
+      get_properties(const Handle handle) const;
+
+      /**
+       * Return an estimate for the memory consumption of this object in
+       * bytes, including the slots of removed particles that are kept for
+       * reuse and the map from cells to particles.
+       */
+      std::size_t
+      memory_consumption() const;
+
+    private:
+      /**
+       * Return a handle to an unused slot of the data arrays, growing the
+       * arrays if no slot of a removed particle is available. The
+       * properties of the slot are set to zero.
+       */
+      Handle
+      allocate_handle();
+
+      /**
+       * The number of properties stored per particle.
+       */
+      unsigned int n_properties;
+
+      /**
+       * The number of particles stored in this object.
+       */
+      std::size_t n_stored_particles;
+
+      /**
+       * The locations of all particles, indexed by their handle.
+       */
+      std::vector<Point<spacedim>> locations;
+
+      /**
+       * The reference locations of all particles, indexed by their handle.
+       */
+      std::vector<Point<dim>> reference_locations;
+
+      /**
+       * The ids of all particles, indexed by their handle.
+       */
+      std::vector<types::particle_index> ids;
+
+      /**
+       * The properties of all particles. The properties of the particle with
+       * handle <tt>h</tt> are stored in the range starting at
+       * <tt>h*n_properties</tt>.
+       */
+      std::vector<double> properties;
+
+      /**
+       * The slots of removed particles that can be reused.
+       */
+      std::vector<Handle> free_handles;
+
+      /**
+       * The map from cells to the handles of the particles in each cell.
+       */
+      cell_map cells;
+    };
+
+
+
+    /* ------------------------- inline functions ------------------------- */
+
+    template <int dim, int spacedim>
+    inline std::size_t
+    ParticleStorage<dim, spacedim>::n_particles() const
+    {
+      return n_stored_particles;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline unsigned int
+    ParticleStorage<dim, spacedim>::n_properties_per_particle() const
+    {
+      return n_properties;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleStorage<dim, spacedim>::cell_map_iterator
+    ParticleStorage<dim, spacedim>::begin_cells()
+    {
+      return cells.begin();
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleStorage<dim, spacedim>::cell_map_iterator
+    ParticleStorage<dim, spacedim>::end_cells()
+    {
+      return cells.end();
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline typename ParticleStorage<dim, spacedim>::Handle
+    ParticleStorage<dim, spacedim>::get_handle(
+      const cell_map_iterator &cell,
+      const unsigned int       index) const
+    {
+      AssertIndexRange(index, cell->second.size());
+      return cell->second[index];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline Point<spacedim> &
+    ParticleStorage<dim, spacedim>::get_location(const Handle handle)
+    {
+      AssertIndexRange(handle, locations.size());
+      return locations[handle];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const Point<spacedim> &
+    ParticleStorage<dim, spacedim>::get_location(const Handle handle) const
+    {
+      AssertIndexRange(handle, locations.size());
+      return locations[handle];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline Point<dim> &
+    ParticleStorage<dim, spacedim>::get_reference_location(
+      const Handle handle)
+    {
+      AssertIndexRange(handle, reference_locations.size());
+      return reference_locations[handle];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const Point<dim> &
+    ParticleStorage<dim, spacedim>::get_reference_location(
+      const Handle handle) const
+    {
+      AssertIndexRange(handle, reference_locations.size());
+      return reference_locations[handle];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline types::particle_index &
+    ParticleStorage<dim, spacedim>::get_id(const Handle handle)
+    {
+      AssertIndexRange(handle, ids.size());
+      return ids[handle];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline types::particle_index
+    ParticleStorage<dim, spacedim>::get_id(const Handle handle) const
+    {
+      AssertIndexRange(handle, ids.size());
+      return ids[handle];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline ArrayView<double>
+    ParticleStorage<dim, spacedim>::get_properties(const Handle handle)
+    {
+      AssertIndexRange(handle, ids.size());
+      return ArrayView<double>(properties.data() +
+                                 static_cast<std::size_t>(handle) *
+                                   n_properties,
+                               n_properties);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline ArrayView<const double>
+    ParticleStorage<dim, spacedim>::get_properties(const Handle handle) const
+    {
+      AssertIndexRange(handle, ids.size());
+      return ArrayView<const double>(properties.data() +
+                                       static_cast<std::size_t>(handle) *
+                                         n_properties,
+                                     n_properties);
+    }
+  } // namespace internal
+} // namespace Particles
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -18,6 +18,9 @@
 
 #include <deal.II/base/array_view.h>
 
+#include <memory>
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
@@ -28,8 +31,15 @@ namespace Particles
    * needs the same amount, it is more efficient to let this be handled by a
    * central manager that does not need to allocate/deallocate memory every
    * time a particle is constructed/destroyed.
-   * The current implementation uses simple new/delete allocation for every
-   * block. Additionally, the current implementation
+   * The current implementation allocates memory in large blocks, each of
+   * which is subdivided into slots of the same size, and every handle
+   * identifies one slot. The slots of deallocated handles are kept in a
+   * free list and are reused by later allocations, so that constructing and
+   * destroying particles does not allocate memory once the pool has grown
+   * to its working size. Because blocks are never moved or released before
+   * the pool is destroyed, the ArrayView objects returned by
+   * get_properties() stay valid until the corresponding handle is
+   * deallocated. Additionally, the current implementation
    * assumes the same number of properties per particle, but of course the
    * PropertyType could contain a pointer to dynamically allocated memory
    * with varying sizes per particle (this memory would not be managed by this
@@ -46,7 +56,7 @@ namespace Particles
      * uniquely identifies the slot of memory that is reserved for this
      * particle.
      */
-    using Handle = double *;
+    using Handle = unsigned int;
 
     /**
      * Define a default (invalid) value for handles.
@@ -74,6 +84,23 @@ namespace Particles
     void
     deallocate_properties_array(const Handle handle);
 
+    /**
+     * Return @p n_handles new handles, for example for all particles that
+     * are received from another process at once. This is equivalent to
+     * calling allocate_properties_array() @p n_handles times, but grows the
+     * pool at most once. If the number of properties is zero, all returned
+     * handles are invalid.
+     */
+    std::vector<Handle>
+    allocate_properties_arrays(const std::size_t n_handles);
+
+    /**
+     * Mark the properties corresponding to all handles in @p handles as
+     * deleted. Invalid handles are ignored.
+     */
+    void
+    deallocate_properties_arrays(const std::vector<Handle> &handles);
+
     /**
      * Return an ArrayView to the properties that correspond to the given
      * handle @p handle.
@@ -83,7 +110,8 @@ namespace Particles
 
     /**
      * Reserve the dynamic memory needed for storing the properties of
-     * @p size particles.
+     * @p size particles. No further memory is allocated as long as no more
+     * than @p size handles are in use at the same time.
      */
     void
     reserve(const std::size_t size);
@@ -94,11 +122,43 @@ namespace Particles
     unsigned int
     n_properties_per_slot() const;
 
+    /**
+     * Return an estimate for the memory consumption of this object in
+     * bytes, including all blocks of memory that have been allocated for
+     * the properties, whether they are in use or not.
+     */
+    std::size_t
+    memory_consumption() const;
+
   private:
     /**
      * The number of properties that are reserved per particle.
      */
     const unsigned int n_properties;
+
+    /**
+     * The number of slots in every block of memory.
+     */
+    const unsigned int slots_per_block;
+
+    /**
+     * The blocks of memory. The properties of the slot with handle
+     * <tt>h</tt> are stored in the block <tt>h/slots_per_block</tt>,
+     * starting at the position <tt>(h%slots_per_block)*n_properties</tt>.
+     */
+    std::vector<std::unique_ptr<double[]>> blocks;
+
+    /**
+     * The number of slots that have been handed out at least once. All
+     * handles below this number are either in use or contained in
+     * currently_available_handles.
+     */
+    Handle n_touched_slots;
+
+    /**
+     * The handles of deallocated slots that can be reused.
+     */
+    std::vector<Handle> currently_available_handles;
   };
 
 
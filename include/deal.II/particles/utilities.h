@@ -0,0 +1,331 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_particles_utilities_h
+#define dealii_particles_utilities_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/work_stream.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_operation.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+#ifdef DEAL_II_WITH_P4EST
+
+namespace Particles
+{
+  /**
+   * A namespace for functions that transfer data between particles and
+   * finite element fields, i.e., the interpolation of a field to the
+   * particles (often called grid-to-particle or G2P) and the deposition of
+   * particle properties onto the mesh (particle-to-grid or P2G), as needed
+   * in particle-in-cell and material point methods.
+   *
+   * The functions work cell by cell on all particles in a cell at once: The
+   * reference locations of the particles of a cell are collected and the
+   * finite element field is evaluated or tested at all of them with an
+   * FEPointEvaluation object, which uses the tensor product structure of the
+   * element and processes the particles in batches of
+   * VectorizedArray::n_array_elements. The cells are distributed to the
+   * available threads with WorkStream. Consequently, the finite element has
+   * to be one supported by FEPointEvaluation, e.g., FE_Q, FE_DGQ, or an
+   * FESystem of such elements.
+   */
+  namespace Utilities
+  {
+    /**
+     * Interpolate the @p n_components vector components starting at
+     * @p first_component of the finite element field @p field_vector,
+     * defined on @p dof_handler, to the locations of all locally owned
+     * particles of @p particle_handler, and store the values in the
+     * properties of the particles, starting at @p first_property.
+     *
+     * For parallel vectors, @p field_vector needs to provide read access to
+     * all degrees of freedom of the locally owned cells, i.e., it needs to
+     * have ghost entries for the locally relevant degrees of freedom.
+     */
+    template <int n_components, int dim, typename VectorType>
+    void
+    interpolate_field_on_particles(
+      const Mapping<dim> &       mapping,
+      const DoFHandler<dim> &    dof_handler,
+      const VectorType &         field_vector,
+      ParticleHandler<dim, dim> &particle_handler,
+      const unsigned int         first_property,
+      const unsigned int         first_component = 0);
+
+    /**
+     * Deposit @p n_components properties of the locally owned particles of
+     * @p particle_handler, starting at @p first_property, onto the mesh:
+     * For every shape function $\varphi_i$ of the @p n_components vector
+     * components of the finite element starting at @p first_component, the
+     * entry $i$ of @p rhs is set to $\sum_p \varphi_i(\mathbf x_p) q_p$,
+     * where the sum runs over all particles $p$ with locations
+     * $\mathbf x_p$ and $q_p$ is the respective property of the particle.
+     * The local contributions are added into @p rhs with
+     * AffineConstraints::distribute_local_to_global() using the given
+     * @p constraints, and @p rhs is compressed at the end.
+     *
+     * This vector is the right hand side of the $L_2$ projection of the
+     * particle properties onto the finite element space, which is obtained
+     * by solving a linear system with the mass matrix (assembled with the
+     * same constraints) and this right hand side. The mass matrix only
+     * depends on the mesh and can be reused as long as the mesh does not
+     * change.
+     */
+    template <int n_components, int dim, typename VectorType>
+    void
+    deposit_particle_properties(
+      const Mapping<dim> &                                     mapping,
+      const DoFHandler<dim> &                                  dof_handler,
+      const ParticleHandler<dim, dim> &                        particle_handler,
+      const unsigned int                                       first_property,
+      const AffineConstraints<typename VectorType::value_type> &constraints,
+      VectorType &                                             rhs,
+      const unsigned int first_component = 0);
+  } // namespace Utilities
+
+
+
+  /* ---------------------- template functions ----------------------------- */
+
+#  ifndef DOXYGEN
+
+  namespace internal
+  {
+    /**
+     * Scratch data for the particle transfer functions. FEPointEvaluation
+     * stores an FEValues object, so copies of this class create a new
+     * evaluator as needed by WorkStream.
+     */
+    template <int n_components, int dim, typename Number>
+    struct ParticleTransferScratchData
+    {
+      ParticleTransferScratchData(const Mapping<dim> &      mapping,
+                                  const FiniteElement<dim> &fe,
+                                  const unsigned int        first_component)
+        : mapping(mapping)
+        , fe(fe)
+        , first_component(first_component)
+        , evaluator(mapping, fe, first_component)
+        , local_values(fe.dofs_per_cell)
+      {}
+
+      ParticleTransferScratchData(const ParticleTransferScratchData &other)
+        : ParticleTransferScratchData(other.mapping,
+                                      other.fe,
+                                      other.first_component)
+      {}
+
+      const Mapping<dim> &      mapping;
+      const FiniteElement<dim> &fe;
+      const unsigned int        first_component;
+
+      FEPointEvaluation<n_components, dim, Number> evaluator;
+      std::vector<Point<dim>>                      unit_points;
+      std::vector<Number>                          local_values;
+    };
+
+
+
+    /**
+     * Copy data for the particle transfer functions. An empty list of
+     * indices denotes a cell without contributions.
+     */
+    template <typename Number>
+    struct ParticleTransferCopyData
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      Vector<Number>                       local_rhs;
+    };
+  } // namespace internal
+
+
+
+  namespace Utilities
+  {
+    template <int n_components, int dim, typename VectorType>
+    void
+    interpolate_field_on_particles(
+      const Mapping<dim> &       mapping,
+      const DoFHandler<dim> &    dof_handler,
+      const VectorType &         field_vector,
+      ParticleHandler<dim, dim> &particle_handler,
+      const unsigned int         first_property,
+      const unsigned int         first_component)
+    {
+      using Number = typename VectorType::value_type;
+      using TypeTraits = dealii::internal::FEPointEvaluation::
+        EvaluatorTypeTraits<dim, n_components, Number>;
+      using ScratchData =
+        internal::ParticleTransferScratchData<n_components, dim, Number>;
+      using CopyData = internal::ParticleTransferCopyData<Number>;
+
+      AssertIndexRange(first_property + n_components - 1,
+                       particle_handler.n_properties_per_particle());
+
+      // the particles of different cells are disjoint, so the properties
+      // can be written directly by the workers
+      auto worker =
+        [&](const typename DoFHandler<dim>::active_cell_iterator &cell,
+            ScratchData &                                         scratch,
+            CopyData &) {
+          if (cell->is_locally_owned() == false)
+            return;
+          const auto particles = particle_handler.particles_in_cell(cell);
+          if (particles.begin() == particles.end())
+            return;
+
+          scratch.unit_points.clear();
+          for (const auto &particle : particles)
+            scratch.unit_points.push_back(particle.get_reference_location());
+
+          scratch.evaluator.reinit(cell, make_array_view(scratch.unit_points));
+          cell->get_dof_values(field_vector,
+                               scratch.local_values.begin(),
+                               scratch.local_values.end());
+          scratch.evaluator.evaluate(make_array_view(scratch.local_values),
+                                     true,
+                                     false);
+
+          unsigned int q = 0;
+          for (auto particle = particles.begin(); particle != particles.end();
+               ++particle, ++q)
+            {
+              typename TypeTraits::value_type value =
+                scratch.evaluator.get_value(q);
+              const ArrayView<double> properties = particle->get_properties();
+              for (unsigned int c = 0; c < n_components; ++c)
+                properties[first_property + c] =
+                  TypeTraits::access_value(value, c);
+            }
+        };
+
+      WorkStream::run(dof_handler.begin_active(),
+                      dof_handler.end(),
+                      worker,
+                      [](const CopyData &) {},
+                      ScratchData(mapping,
+                                  dof_handler.get_fe(),
+                                  first_component),
+                      CopyData());
+    }
+
+
+
+    template <int n_components, int dim, typename VectorType>
+    void
+    deposit_particle_properties(
+      const Mapping<dim> &                                     mapping,
+      const DoFHandler<dim> &                                  dof_handler,
+      const ParticleHandler<dim, dim> &                        particle_handler,
+      const unsigned int                                       first_property,
+      const AffineConstraints<typename VectorType::value_type> &constraints,
+      VectorType &                                             rhs,
+      const unsigned int first_component)
+    {
+      using Number = typename VectorType::value_type;
+      using TypeTraits = dealii::internal::FEPointEvaluation::
+        EvaluatorTypeTraits<dim, n_components, Number>;
+      using ScratchData =
+        internal::ParticleTransferScratchData<n_components, dim, Number>;
+      using CopyData = internal::ParticleTransferCopyData<Number>;
+
+      AssertIndexRange(first_property + n_components - 1,
+                       particle_handler.n_properties_per_particle());
+
+      auto worker =
+        [&](const typename DoFHandler<dim>::active_cell_iterator &cell,
+            ScratchData &                                         scratch,
+            CopyData &                                            copy) {
+          copy.dof_indices.clear();
+          if (cell->is_locally_owned() == false)
+            return;
+          const auto particles = particle_handler.particles_in_cell(cell);
+          if (particles.begin() == particles.end())
+            return;
+
+          scratch.unit_points.clear();
+          for (const auto &particle : particles)
+            scratch.unit_points.push_back(particle.get_reference_location());
+          scratch.evaluator.reinit(cell, make_array_view(scratch.unit_points));
+
+          unsigned int q = 0;
+          for (auto particle = particles.begin(); particle != particles.end();
+               ++particle, ++q)
+            {
+              const ArrayView<const double> properties =
+                static_cast<const ParticleAccessor<dim, dim> &>(*particle)
+                  .get_properties();
+              typename TypeTraits::value_type value;
+              for (unsigned int c = 0; c < n_components; ++c)
+                TypeTraits::access_value(value, c) =
+                  properties[first_property + c];
+              scratch.evaluator.submit_value(value, q);
+            }
+
+          copy.local_rhs.reinit(scratch.fe.dofs_per_cell);
+          scratch.evaluator.integrate(make_array_view(copy.local_rhs));
+          copy.dof_indices.resize(scratch.fe.dofs_per_cell);
+          cell->get_dof_indices(copy.dof_indices);
+        };
+
+      auto copier = [&](const CopyData &copy) {
+        if (copy.dof_indices.size() > 0)
+          constraints.distribute_local_to_global(copy.local_rhs,
+                                                 copy.dof_indices,
+                                                 rhs);
+      };
+
+      rhs = 0;
+      WorkStream::run(dof_handler.begin_active(),
+                      dof_handler.end(),
+                      worker,
+                      copier,
+                      ScratchData(mapping,
+                                  dof_handler.get_fe(),
+                                  first_component),
+                      CopyData());
+      rhs.compress(VectorOperation::add);
+    }
+  } // namespace Utilities
+
+#  endif // DOXYGEN
+
+} // namespace Particles
+
+#endif // DEAL_II_WITH_P4EST
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -246,6 +246,13 @@ namespace SUNDIALS
    * To produce output at fixed steps, overload the function
    *  - output_step;
    *
+   * The vectors ARKode works on store their elements directly in objects of
+   * type VectorType, so the vectors passed to the functions above are not
+   * copied from or to the internal vectors of SUNDIALS in each call. Besides
+   * the vector types of deal.II, Trilinos and PETSc used with the other
+   * SUNDIALS wrappers, this class can also be used with
+   * LinearAlgebra::distributed::Vector.
+   *
    *
    * To provide a simple example, consider the harmonic oscillator problem:
    * \f[
@@ -186,6 +186,19 @@ namespace SUNDIALS
    * Jacobian. This may be very expensive for large systems. Fixed point
    * iteration does not require the solution of any linear system.
    *
+   * As an alternative for large systems, KINSOL can solve the Newton systems
+   * with its GMRES solver by setting AdditionalData::use_gmres (Jacobian-free
+   * Newton-Krylov method). GMRES only needs the action of the Jacobian on
+   * vectors, so no Jacobian matrix has to be assembled. The user may supply
+   *  - jacobian_times_vector;
+   *
+   * e.g. implemented by a matrix-free operator, and otherwise KINSOL
+   * approximates the products by difference quotients of residual(). A right
+   * preconditioner can be supplied through
+   *  - solve_with_preconditioner;
+   * and optionally
+   *  - setup_preconditioner.
+   *
    * Also the following functions could be rewritten, to provide additional
    * scaling factors for both the solution and the residual evaluation during
    * convergence checks:
@@ -247,6 +260,10 @@ namespace SUNDIALS
        * Newton step
        * @param dq_relative_error Relative error for different quotient
        * computation
+       * @param use_gmres Solve the Newton systems with GMRES unless
+       * solve_jacobian_system() is provided
+       * @param maximum_krylov_subspace_size Maximum dimension of the Krylov
+       * subspace of GMRES
        *
        * Linesearch parameters:
        *
@@ -267,7 +284,9 @@ namespace SUNDIALS
         const double            maximum_newton_step           = 0.0,
         const double            dq_relative_error             = 0.0,
         const unsigned int      maximum_beta_failures         = 0,
-        const unsigned int      anderson_subspace_size        = 0)
+        const unsigned int      anderson_subspace_size        = 0,
+        const bool              use_gmres                     = false,
+        const unsigned int      maximum_krylov_subspace_size  = 0)
         : strategy(strategy)
         , maximum_non_linear_iterations(maximum_non_linear_iterations)
         , function_tolerance(function_tolerance)
@@ -278,6 +297,8 @@ namespace SUNDIALS
         , dq_relative_error(dq_relative_error)
         , maximum_beta_failures(maximum_beta_failures)
         , anderson_subspace_size(anderson_subspace_size)
+        , use_gmres(use_gmres)
+        , maximum_krylov_subspace_size(maximum_krylov_subspace_size)
       {}
 
       /**
@@ -301,8 +322,10 @@ namespace SUNDIALS
        * subsection Newton parameters
        *   set Maximum allowable scaled length of the Newton step = 0
        *   set Maximum iterations without matrix setup            = 0
+       *   set Maximum Krylov subspace size                       = 0
        *   set No initial matrix setup                            = false
        *   set Relative error for different quotient computation  = 0
+       *   set Use GMRES                                          = false
        * end
        * @endcode
        *
@@ -353,6 +376,9 @@ namespace SUNDIALS
                           maximum_newton_step);
         prm.add_parameter("Relative error for different quotient computation",
                           dq_relative_error);
+        prm.add_parameter("Use GMRES", use_gmres);
+        prm.add_parameter("Maximum Krylov subspace size",
+                          maximum_krylov_subspace_size);
         prm.leave_subsection();
 
         prm.enter_subsection("Linesearch parameters");
@@ -445,6 +471,23 @@ namespace SUNDIALS
        * If you set this to 0, no acceleration is used.
        */
       unsigned int anderson_subspace_size;
+
+      /**
+       * Whether the linear systems of the Newton strategies are solved with
+       * the GMRES solver of KINSOL. This flag is ignored if the user
+       * provides the function solve_jacobian_system(). GMRES is given the
+       * products of the Jacobian with vectors by jacobian_times_vector() if
+       * provided, and by difference quotients of residual() otherwise.
+       */
+      bool use_gmres;
+
+      /**
+       * The maximum dimension of the Krylov subspace of GMRES, which is
+       * only used if use_gmres is set.
+       *
+       * If set to zero, default values provided by KINSOL will be used.
+       */
+      unsigned int maximum_krylov_subspace_size;
     };
 
     /**
@@ -594,6 +637,77 @@ namespace SUNDIALS
                       VectorType &      dst)>
       solve_jacobian_system;
 
+    /**
+     * A function object that users may supply and that is intended to
+     * compute the product of the Jacobian $J = \partial F/\partial u$ at
+     * `current_u` with the vector `src`, i.e., `dst = J*src`. This function
+     * is only used if AdditionalData::use_gmres is set, and allows to
+     * solve the Newton systems without ever forming the Jacobian matrix,
+     * e.g. by a matrix-free operator evaluation. If it is not supplied,
+     * KINSOL approximates the product by a difference quotient of
+     * residual().
+     *
+     * @param[in] current_u The current value of u
+     * @param[in] src The vector to multiply the Jacobian with
+     * @param[out] dst The product of the Jacobian with `src`
+     *
+     * This function should return:
+     * - 0: Success
+     * - >0: Recoverable error (KINSOL will try to change its internal
+     * parameters and attempt a new solution step)
+     * - <0: Unrecoverable error the computation will be aborted and an
+     * assertion will be thrown.
+     */
+    std::function<int(const VectorType &current_u,
+                      const VectorType &src,
+                      VectorType &      dst)>
+      jacobian_times_vector;
+
+    /**
+     * A function object that users may supply and that is intended to
+     * prepare the preconditioner applied by solve_with_preconditioner(). As
+     * for setup_jacobian(), KINSOL only calls this function as frequently as
+     * it determines that an update is necessary. This function is only used
+     * if AdditionalData::use_gmres is set and solve_with_preconditioner()
+     * is provided.
+     *
+     * @param[in] current_u The current value of u
+     * @param[in] current_f The current value of F(u)
+     *
+     * This function should return:
+     * - 0: Success
+     * - >0: Recoverable error (KINSOL will try to change its internal
+     * parameters and attempt a new solution step)
+     * - <0: Unrecoverable error the computation will be aborted and an
+     * assertion will be thrown.
+     */
+    std::function<int(const VectorType &current_u, const VectorType &current_f)>
+      setup_preconditioner;
+
+    /**
+     * A function object that users may supply and that is intended to apply
+     * a preconditioner $P \approx J$ in GMRES, i.e., to store in `dst` the
+     * solution of `P*dst = rhs`. KINSOL uses the preconditioner from the
+     * right. This function is only used if AdditionalData::use_gmres is set.
+     *
+     * @param[in] current_u The current value of u
+     * @param[in] current_f The current value of F(u)
+     * @param[in] rhs The vector the preconditioner is applied to
+     * @param[out] dst The result of the application of the preconditioner
+     *
+     * This function should return:
+     * - 0: Success
+     * - >0: Recoverable error (KINSOL will try to change its internal
+     * parameters and attempt a new solution step)
+     * - <0: Unrecoverable error the computation will be aborted and an
+     * assertion will be thrown.
+     */
+    std::function<int(const VectorType &current_u,
+                      const VectorType &current_f,
+                      const VectorType &rhs,
+                      VectorType &      dst)>
+      solve_with_preconditioner;
+
     /**
      * A function object that users may supply and that is intended to return a
      * vector whose components are the weights used by KINSOL to compute the
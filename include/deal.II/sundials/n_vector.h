@@ -0,0 +1,62 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_h
+#define dealii_sundials_n_vector_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <sundials/sundials_nvector.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    /**
+     * Create a SUNDIALS N_Vector whose elements are stored in an object of
+     * type @p VectorType, initialized as a copy of @p vector. As opposed to
+     * the N_Vector objects of the serial and parallel NVECTOR modules of
+     * SUNDIALS, whose elements need to be copied from and to deal.II vectors
+     * in every call of a user function (see copy.h), the deal.II vector
+     * behind the returned N_Vector, and behind all N_Vector objects SUNDIALS
+     * clones from it, can be accessed directly by unwrap_nvector().
+     *
+     * The vector operations of SUNDIALS are implemented on the locally owned
+     * elements of the deal.II vector, with the reductions performed on the
+     * MPI communicator of the vector. The returned object must be released
+     * by N_VDestroy().
+     */
+    template <typename VectorType>
+    N_Vector
+    make_nvector(const VectorType &vector);
+
+    /**
+     * Return the deal.II vector that stores the elements of @p v, which must
+     * have been created by make_nvector() or cloned from such an object.
+     */
+    template <typename VectorType>
+    VectorType &
+    unwrap_nvector(N_Vector v);
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_h
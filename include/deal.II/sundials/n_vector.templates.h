@@ -0,0 +1,643 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_templates_h
+#define dealii_sundials_n_vector_templates_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/sundials/n_vector.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <deal.II/base/exceptions.h>
+#  include <deal.II/base/mpi.h>
+
+#  include <deal.II/lac/block_vector_base.h>
+#  include <deal.II/lac/vector.h>
+#  ifdef DEAL_II_WITH_PETSC
+#    include <deal.II/lac/petsc_vector.h>
+#  endif
+
+#  include <sundials/sundials_types.h>
+
+#  include <algorithm>
+#  include <cmath>
+#  include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    namespace NVectorOperations
+    {
+      /**
+       * Access to the blocks of a vector. Vectors that are not block vectors
+       * are treated as a block vector with a single block.
+       */
+      template <typename VectorType,
+                bool is_block_vector = IsBlockVector<VectorType>::value>
+      struct Blocks
+      {
+        using BlockType = VectorType;
+
+        static unsigned int
+        n_blocks(const VectorType &)
+        {
+          return 1;
+        }
+
+        static BlockType &
+        block(VectorType &vector, const unsigned int)
+        {
+          return vector;
+        }
+      };
+
+
+
+      template <typename VectorType>
+      struct Blocks<VectorType, true>
+      {
+        using BlockType = typename VectorType::BlockType;
+
+        static unsigned int
+        n_blocks(const VectorType &vector)
+        {
+          return vector.n_blocks();
+        }
+
+        static BlockType &
+        block(VectorType &vector, const unsigned int b)
+        {
+          return vector.block(b);
+        }
+      };
+
+
+
+      /**
+       * Access to the contiguous array of the locally owned elements of a
+       * vector that is not a block vector.
+       */
+      template <typename VectorType>
+      class LocalElements
+      {
+      public:
+        explicit LocalElements(VectorType &vector)
+          : values(vector.begin())
+          , n_values(vector.end() - vector.begin())
+        {}
+
+        std::size_t
+        size() const
+        {
+          return n_values;
+        }
+
+        double &operator[](const std::size_t i) const
+        {
+          return values[i];
+        }
+
+      private:
+        double *const     values;
+        const std::size_t n_values;
+      };
+
+
+
+#  if defined(DEAL_II_WITH_PETSC) && !defined(PETSC_USE_COMPLEX)
+      template <>
+      class LocalElements<PETScWrappers::MPI::Vector>
+      {
+      public:
+        explicit LocalElements(PETScWrappers::MPI::Vector &vector)
+          : vector(vector)
+          , n_values(vector.local_size())
+        {
+          const PetscErrorCode ierr = VecGetArray(vector, &values);
+          AssertThrow(ierr == 0, ExcPETScError(ierr));
+        }
+
+        ~LocalElements()
+        {
+          const PetscErrorCode ierr = VecRestoreArray(vector, &values);
+          AssertNothrow(ierr == 0, ExcPETScError(ierr));
+          (void)ierr;
+        }
+
+        std::size_t
+        size() const
+        {
+          return n_values;
+        }
+
+        double &operator[](const std::size_t i) const
+        {
+          return values[i];
+        }
+
+      private:
+        PETScWrappers::MPI::Vector &vector;
+        PetscScalar *               values;
+        const std::size_t           n_values;
+      };
+#  endif
+
+
+
+      /**
+       * Return the MPI communicator of a vector that is not a block vector.
+       */
+      template <typename VectorType>
+      MPI_Comm
+      get_communicator(const VectorType &vector)
+      {
+        return vector.get_mpi_communicator();
+      }
+
+
+
+      inline MPI_Comm
+      get_communicator(const Vector<double> &)
+      {
+        return MPI_COMM_SELF;
+      }
+
+
+
+      template <typename VectorType>
+      MPI_Comm
+      communicator(N_Vector v)
+      {
+        return get_communicator(
+          Blocks<VectorType>::block(unwrap_nvector<VectorType>(v), 0));
+      }
+
+
+
+      inline booleantype
+      to_booleantype(const bool value)
+      {
+#  if DEAL_II_SUNDIALS_VERSION_GTE(2, 0, 0)
+        return value ? SUNTRUE : SUNFALSE;
+#  else
+        return value ? TRUE : FALSE;
+#  endif
+      }
+
+
+
+      /**
+       * Call @p operation for each locally owned element of the vector @p x.
+       */
+      template <typename VectorType, typename Operation>
+      void
+      for_each_element(N_Vector x, const Operation &operation)
+      {
+        using B              = Blocks<VectorType>;
+        VectorType &x_vector = unwrap_nvector<VectorType>(x);
+        for (unsigned int b = 0; b < B::n_blocks(x_vector); ++b)
+          {
+            const LocalElements<typename B::BlockType> x_b(
+              B::block(x_vector, b));
+            for (std::size_t i = 0; i < x_b.size(); ++i)
+              operation(x_b[i]);
+          }
+      }
+
+
+
+      /**
+       * Call @p operation for each pair of locally owned elements of the
+       * vectors @p x and @p y.
+       */
+      template <typename VectorType, typename Operation>
+      void
+      for_each_element(N_Vector x, N_Vector y, const Operation &operation)
+      {
+        using B              = Blocks<VectorType>;
+        VectorType &x_vector = unwrap_nvector<VectorType>(x);
+        VectorType &y_vector = unwrap_nvector<VectorType>(y);
+        AssertDimension(B::n_blocks(x_vector), B::n_blocks(y_vector));
+        for (unsigned int b = 0; b < B::n_blocks(x_vector); ++b)
+          {
+            const LocalElements<typename B::BlockType> x_b(
+              B::block(x_vector, b));
+            const LocalElements<typename B::BlockType> y_b(
+              B::block(y_vector, b));
+            AssertDimension(x_b.size(), y_b.size());
+            for (std::size_t i = 0; i < x_b.size(); ++i)
+              operation(x_b[i], y_b[i]);
+          }
+      }
+
+
+
+      /**
+       * Call @p operation for each triple of locally owned elements of the
+       * vectors @p x, @p y and @p z.
+       */
+      template <typename VectorType, typename Operation>
+      void
+      for_each_element(N_Vector         x,
+                       N_Vector         y,
+                       N_Vector         z,
+                       const Operation &operation)
+      {
+        using B              = Blocks<VectorType>;
+        VectorType &x_vector = unwrap_nvector<VectorType>(x);
+        VectorType &y_vector = unwrap_nvector<VectorType>(y);
+        VectorType &z_vector = unwrap_nvector<VectorType>(z);
+        AssertDimension(B::n_blocks(x_vector), B::n_blocks(y_vector));
+        AssertDimension(B::n_blocks(x_vector), B::n_blocks(z_vector));
+        for (unsigned int b = 0; b < B::n_blocks(x_vector); ++b)
+          {
+            const LocalElements<typename B::BlockType> x_b(
+              B::block(x_vector, b));
+            const LocalElements<typename B::BlockType> y_b(
+              B::block(y_vector, b));
+            const LocalElements<typename B::BlockType> z_b(
+              B::block(z_vector, b));
+            AssertDimension(x_b.size(), y_b.size());
+            AssertDimension(x_b.size(), z_b.size());
+            for (std::size_t i = 0; i < x_b.size(); ++i)
+              operation(x_b[i], y_b[i], z_b[i]);
+          }
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      clone_empty(N_Vector w)
+      {
+        N_Vector v = new _generic_N_Vector;
+        v->ops     = new _generic_N_Vector_Ops(*w->ops);
+        v->content = nullptr;
+        return v;
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      clone(N_Vector w)
+      {
+        N_Vector    v      = clone_empty<VectorType>(w);
+        VectorType *vector = new VectorType();
+        vector->reinit(unwrap_nvector<VectorType>(w));
+        v->content = vector;
+        return v;
+      }
+
+
+
+      template <typename VectorType>
+      void
+      destroy(N_Vector v)
+      {
+        if (v == nullptr)
+          return;
+        delete static_cast<VectorType *>(v->content);
+        delete v->ops;
+        delete v;
+      }
+
+
+
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+      inline N_Vector_ID
+      get_vector_id(N_Vector)
+      {
+        return SUNDIALS_NVEC_CUSTOM;
+      }
+#  endif
+
+
+
+      template <typename VectorType>
+      void
+      linear_sum(realtype a, N_Vector x, realtype b, N_Vector y, N_Vector z)
+      {
+        for_each_element<VectorType>(
+          x, y, z, [a, b](const double x_i, const double y_i, double &z_i) {
+            z_i = a * x_i + b * y_i;
+          });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      set_constant(realtype c, N_Vector z)
+      {
+        for_each_element<VectorType>(z, [c](double &z_i) { z_i = c; });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      prod(N_Vector x, N_Vector y, N_Vector z)
+      {
+        for_each_element<VectorType>(
+          x, y, z, [](const double x_i, const double y_i, double &z_i) {
+            z_i = x_i * y_i;
+          });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      div(N_Vector x, N_Vector y, N_Vector z)
+      {
+        for_each_element<VectorType>(
+          x, y, z, [](const double x_i, const double y_i, double &z_i) {
+            z_i = x_i / y_i;
+          });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      scale(realtype c, N_Vector x, N_Vector z)
+      {
+        for_each_element<VectorType>(
+          x, z, [c](const double x_i, double &z_i) { z_i = c * x_i; });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      abs(N_Vector x, N_Vector z)
+      {
+        for_each_element<VectorType>(
+          x, z, [](const double x_i, double &z_i) { z_i = std::abs(x_i); });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      inv(N_Vector x, N_Vector z)
+      {
+        for_each_element<VectorType>(
+          x, z, [](const double x_i, double &z_i) { z_i = 1. / x_i; });
+      }
+
+
+
+      template <typename VectorType>
+      void
+      add_constant(N_Vector x, realtype b, N_Vector z)
+      {
+        for_each_element<VectorType>(
+          x, z, [b](const double x_i, double &z_i) { z_i = x_i + b; });
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      dot_prod(N_Vector x, N_Vector y)
+      {
+        double sum = 0;
+        for_each_element<VectorType>(
+          x, y, [&sum](const double x_i, const double y_i) {
+            sum += x_i * y_i;
+          });
+        return Utilities::MPI::sum(sum, communicator<VectorType>(x));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      max_norm(N_Vector x)
+      {
+        double max = 0;
+        for_each_element<VectorType>(x, [&max](const double x_i) {
+          max = std::max(max, std::abs(x_i));
+        });
+        return Utilities::MPI::max(max, communicator<VectorType>(x));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      wrms_norm(N_Vector x, N_Vector w)
+      {
+        double sum = 0;
+        for_each_element<VectorType>(
+          x, w, [&sum](const double x_i, const double w_i) {
+            sum += (x_i * w_i) * (x_i * w_i);
+          });
+        return std::sqrt(Utilities::MPI::sum(sum, communicator<VectorType>(x)) /
+                         unwrap_nvector<VectorType>(x).size());
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      wrms_norm_mask(N_Vector x, N_Vector w, N_Vector id)
+      {
+        double sum = 0;
+        for_each_element<VectorType>(
+          x,
+          w,
+          id,
+          [&sum](const double x_i, const double w_i, const double id_i) {
+            if (id_i > 0.)
+              sum += (x_i * w_i) * (x_i * w_i);
+          });
+        return std::sqrt(Utilities::MPI::sum(sum, communicator<VectorType>(x)) /
+                         unwrap_nvector<VectorType>(x).size());
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      min_element(N_Vector x)
+      {
+        double min = std::numeric_limits<double>::max();
+        for_each_element<VectorType>(
+          x, [&min](const double x_i) { min = std::min(min, x_i); });
+        return Utilities::MPI::min(min, communicator<VectorType>(x));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      wl2_norm(N_Vector x, N_Vector w)
+      {
+        double sum = 0;
+        for_each_element<VectorType>(
+          x, w, [&sum](const double x_i, const double w_i) {
+            sum += (x_i * w_i) * (x_i * w_i);
+          });
+        return std::sqrt(
+          Utilities::MPI::sum(sum, communicator<VectorType>(x)));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      l1_norm(N_Vector x)
+      {
+        double sum = 0;
+        for_each_element<VectorType>(
+          x, [&sum](const double x_i) { sum += std::abs(x_i); });
+        return Utilities::MPI::sum(sum, communicator<VectorType>(x));
+      }
+
+
+
+      template <typename VectorType>
+      void
+      compare(realtype c, N_Vector x, N_Vector z)
+      {
+        for_each_element<VectorType>(x, z, [c](const double x_i, double &z_i) {
+          z_i = (std::abs(x_i) >= c) ? 1. : 0.;
+        });
+      }
+
+
+
+      template <typename VectorType>
+      booleantype
+      inv_test(N_Vector x, N_Vector z)
+      {
+        double all_nonzero = 1.;
+        for_each_element<VectorType>(
+          x, z, [&all_nonzero](const double x_i, double &z_i) {
+            if (x_i == 0.)
+              all_nonzero = 0.;
+            else
+              z_i = 1. / x_i;
+          });
+        return to_booleantype(
+          Utilities::MPI::min(all_nonzero, communicator<VectorType>(x)) > 0.);
+      }
+
+
+
+      template <typename VectorType>
+      booleantype
+      constr_mask(N_Vector c, N_Vector x, N_Vector m)
+      {
+        // the constraints are encoded as 2 (x_i > 0), 1 (x_i >= 0),
+        // -1 (x_i <= 0) and -2 (x_i < 0), and 0 means no constraint
+        double all_satisfied = 1.;
+        for_each_element<VectorType>(
+          c,
+          x,
+          m,
+          [&all_satisfied](const double c_i, const double x_i, double &m_i) {
+            const bool violated =
+              (c_i == 2. && x_i <= 0.) || (c_i == 1. && x_i < 0.) ||
+              (c_i == -1. && x_i > 0.) || (c_i == -2. && x_i >= 0.);
+            m_i = violated ? 1. : 0.;
+            if (violated)
+              all_satisfied = 0.;
+          });
+        return to_booleantype(
+          Utilities::MPI::min(all_satisfied, communicator<VectorType>(x)) > 0.);
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      min_quotient(N_Vector num, N_Vector denom)
+      {
+        double min = BIG_REAL;
+        for_each_element<VectorType>(
+          num, denom, [&min](const double num_i, const double denom_i) {
+            if (denom_i != 0.)
+              min = std::min(min, num_i / denom_i);
+          });
+        return Utilities::MPI::min(min, communicator<VectorType>(num));
+      }
+    } // namespace NVectorOperations
+
+
+
+    template <typename VectorType>
+    N_Vector
+    make_nvector(const VectorType &vector)
+    {
+      N_Vector v = new _generic_N_Vector;
+      v->content = new VectorType(vector);
+
+      // value-initialize the operations such that the optional ones that
+      // are not implemented are null pointers
+      v->ops = new _generic_N_Vector_Ops();
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+      v->ops->nvgetvectorid = NVectorOperations::get_vector_id;
+#  endif
+      v->ops->nvclone        = NVectorOperations::clone<VectorType>;
+      v->ops->nvcloneempty   = NVectorOperations::clone_empty<VectorType>;
+      v->ops->nvdestroy      = NVectorOperations::destroy<VectorType>;
+      v->ops->nvlinearsum    = NVectorOperations::linear_sum<VectorType>;
+      v->ops->nvconst        = NVectorOperations::set_constant<VectorType>;
+      v->ops->nvprod         = NVectorOperations::prod<VectorType>;
+      v->ops->nvdiv          = NVectorOperations::div<VectorType>;
+      v->ops->nvscale        = NVectorOperations::scale<VectorType>;
+      v->ops->nvabs          = NVectorOperations::abs<VectorType>;
+      v->ops->nvinv          = NVectorOperations::inv<VectorType>;
+      v->ops->nvaddconst     = NVectorOperations::add_constant<VectorType>;
+      v->ops->nvdotprod      = NVectorOperations::dot_prod<VectorType>;
+      v->ops->nvmaxnorm      = NVectorOperations::max_norm<VectorType>;
+      v->ops->nvwrmsnorm     = NVectorOperations::wrms_norm<VectorType>;
+      v->ops->nvwrmsnormmask = NVectorOperations::wrms_norm_mask<VectorType>;
+      v->ops->nvmin          = NVectorOperations::min_element<VectorType>;
+      v->ops->nvwl2norm      = NVectorOperations::wl2_norm<VectorType>;
+      v->ops->nvl1norm       = NVectorOperations::l1_norm<VectorType>;
+      v->ops->nvcompare      = NVectorOperations::compare<VectorType>;
+      v->ops->nvinvtest      = NVectorOperations::inv_test<VectorType>;
+      v->ops->nvconstrmask   = NVectorOperations::constr_mask<VectorType>;
+      v->ops->nvminquotient  = NVectorOperations::min_quotient<VectorType>;
+
+      return v;
+    }
+
+
+
+    template <typename VectorType>
+    VectorType &
+    unwrap_nvector(N_Vector v)
+    {
+      Assert(v != nullptr && v->content != nullptr, ExcNotInitialized());
+      return *static_cast<VectorType *>(v->content);
+    }
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_templates_h
@@ -18,6 +18,9 @@
 
 #include <deal.II/base/parameter_handler.h>
 
+#include <algorithm>
+#include <cmath>
+
 DEAL_II_NAMESPACE_OPEN
 
 using namespace Algorithms;
@@ -39,12 +42,11 @@ TimestepControl::TimestepControl(double start,
   , step_val(start_step)
   , print_step(print_step)
   , next_print_val(print_step > 0. ? start_val + print_step : start_val - 1.)
+  , last_error_val(1.)
+  , rejected_val(false)
 {
   now_val = start_val;
   strcpy(format, "T.%06.3f");
-
-  // avoid compiler warning
-  (void)min_step_val;
 }
 
 
@@ -60,7 +62,7 @@ TimestepControl::declare_parameters(ParameterHandler &param)
   param.declare_entry("Print step", "-1.", Patterns::Double());
   param.declare_entry("Strategy",
                       "uniform",
-                      Patterns::Selection("uniform|doubling"));
+                      Patterns::Selection("uniform|doubling|error_control"));
 }
 
 
@@ -79,6 +81,8 @@ TimestepControl::parse_parameters(ParameterHandler &param)
     strategy_val = uniform;
   else if (strategy == std::string("doubling"))
     strategy_val = doubling;
+  else if (strategy == std::string("error_control"))
+    strategy_val = error_control;
 }
 
 
@@ -101,7 +105,7 @@ TimestepControl::advance()
 
   // Try incrementing time by s
   double h = now_val + s;
-  changed  = s != step_val;
+  changed  = s != current_step_val;
 
   step_val         = s;
   current_step_val = s;
@@ -125,6 +129,45 @@ TimestepControl::advance()
 }
 
 
+
+bool
+TimestepControl::accept_step(const double error, const unsigned int order)
+{
+  Assert(strategy_val == error_control,
+         ExcMessage("accept_step() requires the strategy error_control."));
+  Assert(tolerance_val > 0., ExcMessage("The tolerance must be positive."));
+
+  const double exponent = 1. / (order + 1.);
+  // avoid division by zero for an exact solution
+  const double err = std::max(error / tolerance_val, 1.e-10);
+
+  if (err > 1. && current_step_val > min_step_val)
+    {
+      // reject the step and repeat it with a smaller size, chosen by the
+      // elementary controller, since the previous error estimate belongs to
+      // a step that was accepted
+      const double factor =
+        std::min(0.9, std::max(0.2, 0.9 * std::pow(err, -exponent)));
+      now_val -= current_step_val;
+      step_val     = std::max(factor * current_step_val, min_step_val);
+      rejected_val = true;
+      return false;
+    }
+
+  double factor = 0.9 * std::pow(err, -0.7 * exponent) *
+                  std::pow(last_error_val, 0.4 * exponent);
+  factor = std::min(5., std::max(0.2, factor));
+  if (rejected_val)
+    factor = std::min(1., factor);
+
+  step_val       = std::max(std::min(factor * current_step_val, max_step_val),
+                      min_step_val);
+  last_error_val = err;
+  rejected_val   = false;
+  return true;
+}
+
+
 bool
 TimestepControl::print()
 {
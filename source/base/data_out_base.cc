@@ -34,6 +34,7 @@
 #include <deal.II/base/data_out_base.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -250,9 +251,22 @@ namespace
       }
   }
 
+  /**
+   * The size in bytes of the blocks in which the data arrays are compressed.
+   * The VTK format allows splitting compressed arrays into blocks of equal
+   * size, which we use to compress the blocks of large arrays in parallel.
+   */
+  constexpr std::size_t compression_block_size = 1 << 20;
+
+
+
   /**
    * Do a zlib compression followed by a base64 encoding of the given data. The
    * result is then written to the given stream.
+   *
+   * The data is split into blocks of size compression_block_size that are
+   * compressed in parallel, and the compression header lists the compressed
+   * size of each block as expected by VTK.
    */
   template <typename T>
   void
@@ -262,37 +276,75 @@ namespace
   {
     if (data.size() != 0)
       {
-        // allocate a buffer for compressing data and do so
-        uLongf compressed_data_length = compressBound(data.size() * sizeof(T));
-        char * compressed_data        = new char[compressed_data_length];
-        int    err =
-          compress2(reinterpret_cast<Bytef *>(compressed_data),
-                    &compressed_data_length,
-                    reinterpret_cast<const Bytef *>(data.data()),
-                    data.size() * sizeof(T),
-                    get_zlib_compression_level(flags.compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
-
-        // now encode the compression header
-        const uint32_t compression_header[4] = {
-          1,                                              /* number of blocks */
-          static_cast<uint32_t>(data.size() * sizeof(T)), /* size of block */
-          static_cast<uint32_t>(data.size() *
-                                sizeof(T)), /* size of last block */
-          static_cast<uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
+        const std::size_t uncompressed_size = data.size() * sizeof(T);
+        const std::size_t n_blocks =
+          (uncompressed_size + compression_block_size - 1) /
+          compression_block_size;
+        const int compression_level =
+          get_zlib_compression_level(flags.compression_level);
+
+        // compress the blocks, possibly in parallel
+        std::vector<std::vector<char>> compressed_blocks(n_blocks);
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_blocks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t block = begin; block < end; ++block)
+              {
+                const std::size_t offset = block * compression_block_size;
+                const std::size_t size =
+                  std::min(compression_block_size, uncompressed_size - offset);
+                uLongf compressed_data_length = compressBound(size);
+                compressed_blocks[block].resize(compressed_data_length);
+                int err = compress2(
+                  reinterpret_cast<Bytef *>(compressed_blocks[block].data()),
+                  &compressed_data_length,
+                  reinterpret_cast<const Bytef *>(data.data()) + offset,
+                  size,
+                  compression_level);
+                (void)err;
+                Assert(err == Z_OK, ExcInternalError());
+                compressed_blocks[block].resize(compressed_data_length);
+              }
+          },
+          1);
+
+        // now encode the compression header, consisting of the number of
+        // blocks, the size of a block, the size of the last block, and the
+        // list of compressed sizes of the blocks
+        std::vector<uint32_t> compression_header(3 + n_blocks);
+        compression_header[0] = static_cast<uint32_t>(n_blocks);
+        compression_header[1] = static_cast<uint32_t>(
+          std::min(compression_block_size, uncompressed_size));
+        compression_header[2] = static_cast<uint32_t>(
+          uncompressed_size - (n_blocks - 1) * compression_block_size);
+        std::size_t compressed_data_length = 0;
+        for (std::size_t block = 0; block < n_blocks; ++block)
+          {
+            compression_header[3 + block] =
+              static_cast<uint32_t>(compressed_blocks[block].size());
+            compressed_data_length += compressed_blocks[block].size();
+          }
 
         char *encoded_header =
           encode_block(reinterpret_cast<const char *>(&compression_header[0]),
-                       4 * sizeof(compression_header[0]));
+                       compression_header.size() *
+                         sizeof(compression_header[0]));
         output_stream << encoded_header;
         delete[] encoded_header;
 
         // next do the compressed data encoding in base64
+        std::vector<char> compressed_data;
+        compressed_data.reserve(compressed_data_length);
+        for (std::vector<char> &block : compressed_blocks)
+          {
+            compressed_data.insert(compressed_data.end(),
+                                   block.begin(),
+                                   block.end());
+            std::vector<char>().swap(block);
+          }
         char *encoded_data =
-          encode_block(compressed_data, compressed_data_length);
-        delete[] compressed_data;
+          encode_block(compressed_data.data(), compressed_data.size());
 
         output_stream << encoded_data;
         delete[] encoded_data;
@@ -784,6 +836,24 @@ namespace
     return node;
   }
 
+  /**
+   * Given the coordinate i within the Lagrange curve, return an offset into
+   * the local connectivity array. The two end points come first, followed by
+   * the interior points.
+   */
+  int
+  vtk_point_index_from_ijk(const unsigned i,
+                           const unsigned,
+                           const unsigned,
+                           const std::array<unsigned, 1> &order)
+  {
+    if (i == 0)
+      return 0;
+    if (i == order[0])
+      return 1;
+    return i + 1;
+  }
+
   /**
    * Given (i,j,k) coordinates within the Lagrange quadrilateral, return an
    * offset into the local connectivity array.
@@ -910,16 +980,6 @@ namespace
     return 0;
   }
 
-  int
-  vtk_point_index_from_ijk(const unsigned,
-                           const unsigned,
-                           const unsigned,
-                           const std::array<unsigned, 1> &)
-  {
-    Assert(false, ExcNotImplemented());
-    return 0;
-  }
-
 
   template <int dim, int spacedim>
   static void
@@ -1735,6 +1795,117 @@ namespace
 
     return stream;
   }
+
+
+
+  /**
+   * A class with the interface of the stream classes above that, instead of
+   * writing to a stream, collects the points and cells of the patches in
+   * the arrays of a DataOutBase::VtkUnstructuredGrid.
+   */
+  class VtkArrayCollector
+  {
+  public:
+    explicit VtkArrayCollector(DataOutBase::VtkUnstructuredGrid &grid)
+      : grid(grid)
+    {}
+
+    template <int dim>
+    void
+    write_point(const unsigned int, const Point<dim> &p)
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+        grid.points.push_back(p[i]);
+      for (unsigned int i = dim; i < 3; ++i)
+        grid.points.push_back(0);
+    }
+
+    void
+    flush_points()
+    {}
+
+    /**
+     * The order of the vertices is the same as in VtuStream::write_cell().
+     */
+    template <int dim>
+    void
+    write_cell(const unsigned int,
+               const unsigned int start,
+               const unsigned int d1,
+               const unsigned int d2,
+               const unsigned int d3)
+    {
+      grid.connectivity.push_back(start);
+      if (dim >= 1)
+        {
+          grid.connectivity.push_back(start + d1);
+          if (dim >= 2)
+            {
+              grid.connectivity.push_back(start + d2 + d1);
+              grid.connectivity.push_back(start + d2);
+              if (dim >= 3)
+                {
+                  grid.connectivity.push_back(start + d3);
+                  grid.connectivity.push_back(start + d3 + d1);
+                  grid.connectivity.push_back(start + d3 + d2 + d1);
+                  grid.connectivity.push_back(start + d3 + d2);
+                }
+            }
+        }
+      grid.offsets.push_back(grid.connectivity.size());
+    }
+
+    template <int dim>
+    void
+    write_high_order_cell(const unsigned int,
+                          const unsigned int           start,
+                          const std::vector<unsigned> &connectivity)
+    {
+      for (const auto &c : connectivity)
+        grid.connectivity.push_back(start + c);
+      grid.offsets.push_back(grid.connectivity.size());
+    }
+
+    void
+    flush_cells()
+    {}
+
+  private:
+    DataOutBase::VtkUnstructuredGrid &grid;
+  };
+
+
+
+  /**
+   * Round the entries of @p data to the number of mantissa bits requested
+   * for the data set @p name in @p flags, see
+   * DataOutBase::VtkFlags::mantissa_bits.
+   */
+  void
+  reduce_vtk_precision(const std::string &          name,
+                       const DataOutBase::VtkFlags &flags,
+                       std::vector<float> &         data)
+  {
+    const auto entry = flags.mantissa_bits.find(name);
+    if (entry == flags.mantissa_bits.end() || entry->second >= 23)
+      return;
+
+    const unsigned int  n_dropped_bits = 23 - entry->second;
+    const std::uint32_t half = std::uint32_t(1) << (n_dropped_bits - 1);
+    const std::uint32_t mask = ~((std::uint32_t(1) << n_dropped_bits) - 1);
+    for (float &value : data)
+      {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(float));
+        // round to nearest, a carry into the exponent is correct; leave
+        // infinities and NaNs alone
+        if ((bits & 0x7f800000u) != 0x7f800000u)
+          {
+            bits = (bits + half) & mask;
+            std::memcpy(&value, &bits, sizeof(float));
+          }
+      }
+  }
 } // namespace
 
 
@@ -2064,6 +2235,29 @@ namespace DataOutBase
 
 
 
+  void
+  VtkFlags::declare_parameters(ParameterHandler &prm)
+  {
+    prm.declare_entry("Write higher order cells",
+                      "false",
+                      Patterns::Bool(),
+                      "A flag indicating whether each patch is written as a "
+                      "single high-order Lagrange cell instead of a set of "
+                      "linear cells. The number of subdivisions of the "
+                      "patches is then used as the polynomial degree of the "
+                      "cells.");
+  }
+
+
+
+  void
+  VtkFlags::parse_parameters(const ParameterHandler &prm)
+  {
+    write_higher_order_cells = prm.get_bool("Write higher order cells");
+  }
+
+
+
   void
   UcdFlags::declare_parameters(ParameterHandler &prm)
   {
@@ -2588,7 +2782,7 @@ namespace DataOutBase
   write_high_order_cells(const std::vector<Patch<dim, spacedim>> &patches,
                          StreamType &                             out)
   {
-    Assert(dim <= 3 && dim > 1, ExcNotImplemented());
+    Assert(dim <= 3 && dim > 0, ExcNotImplemented());
     unsigned int first_vertex_of_patch = 0;
     unsigned int count                 = 0;
     // Array to hold all the node numbers of a cell
@@ -5248,12 +5442,15 @@ namespace DataOutBase
 
     // If a user set to output high order cells, we treat n_subdivisions
     // as a cell order and adjust variables accordingly, otherwise
-    // each patch is written as a linear cell.
-    unsigned int n_points_per_cell = GeometryInfo<dim>::vertices_per_cell;
+    // each patch is written as a linear cell. Since every node belongs to
+    // exactly one high order cell, the connectivity list then has one entry
+    // per node.
+    unsigned int n_cell_entries =
+      n_cells * GeometryInfo<dim>::vertices_per_cell;
     if (flags.write_higher_order_cells)
       {
-        n_cells           = patches.size();
-        n_points_per_cell = n_nodes / n_cells;
+        n_cells        = patches.size();
+        n_cell_entries = n_nodes;
       }
 
     // in gmv format the vertex coordinates and the data have an order that is a
@@ -5285,8 +5482,7 @@ namespace DataOutBase
     out << '\n';
     /////////////////////////////////
     // now for the cells
-    out << "CELLS " << n_cells << ' ' << n_cells * (n_points_per_cell + 1)
-        << '\n';
+    out << "CELLS " << n_cells << ' ' << n_cells + n_cell_entries << '\n';
     if (flags.write_higher_order_cells)
       write_high_order_cells(patches, vtk_out);
     else
@@ -5455,6 +5651,46 @@ namespace DataOutBase
 
 
 
+  template <typename T>
+  void
+  write_vtu_data_array(const std::vector<T> &data,
+                       const VtkFlags &      flags,
+                       std::ostream &        out)
+  {
+    AssertThrow(out, ExcIO());
+    VtuStream vtu_out(out, flags);
+    vtu_out << data;
+  }
+
+
+
+  template void
+  write_vtu_data_array(const std::vector<float> &,
+                       const VtkFlags &,
+                       std::ostream &);
+  template void
+  write_vtu_data_array(const std::vector<double> &,
+                       const VtkFlags &,
+                       std::ostream &);
+  template void
+  write_vtu_data_array(const std::vector<int> &,
+                       const VtkFlags &,
+                       std::ostream &);
+  template void
+  write_vtu_data_array(const std::vector<unsigned char> &,
+                       const VtkFlags &,
+                       std::ostream &);
+  template void
+  write_vtu_data_array(const std::vector<unsigned int> &,
+                       const VtkFlags &,
+                       std::ostream &);
+  template void
+  write_vtu_data_array(const std::vector<unsigned long long int> &,
+                       const VtkFlags &,
+                       std::ostream &);
+
+
+
   template <int dim, int spacedim>
   void
   write_vtu(
@@ -5669,13 +5905,20 @@ namespace DataOutBase
 
     // If a user set to output high order cells, we treat n_subdivisions
     // as a cell order and adjust variables accordingly, otherwise
-    // each patch is written as a linear cell.
-    unsigned int n_points_per_cell = GeometryInfo<dim>::vertices_per_cell;
+    // each patch is written as a linear cell. The patches may have different
+    // numbers of subdivisions, so the number of points is stored for each
+    // cell individually.
+    std::vector<unsigned int> n_points_per_cell;
     if (flags.write_higher_order_cells)
       {
-        n_cells           = patches.size();
-        n_points_per_cell = n_nodes / n_cells;
+        n_cells = patches.size();
+        n_points_per_cell.reserve(n_cells);
+        for (const auto &patch : patches)
+          n_points_per_cell.push_back(
+            Utilities::fixed_power<dim>(patch.n_subdivisions + 1));
       }
+    else
+      n_points_per_cell.resize(n_cells, GeometryInfo<dim>::vertices_per_cell);
 
     // in gmv format the vertex coordinates and the data have an order that is a
     // bit unpleasant (first all x coordinates, then all y coordinate, ...;
@@ -5727,8 +5970,12 @@ namespace DataOutBase
         << ascii_or_binary << "\">\n";
 
     std::vector<int32_t> offsets(n_cells);
+    int32_t              offset = 0;
     for (unsigned int i = 0; i < n_cells; ++i)
-      offsets[i] = (i + 1) * n_points_per_cell;
+      {
+        offset += n_points_per_cell[i];
+        offsets[i] = offset;
+      }
     vtu_out << offsets;
     out << "\n";
     out << "    </DataArray>\n";
@@ -5809,17 +6056,15 @@ namespace DataOutBase
 
         // write the header. concatenate all the component names with double
         // underscores unless a vector name has been specified
-        out << "    <DataArray type=\"Float32\" Name=\"";
-
-        if (!name.empty())
-          out << name;
-        else
+        std::string data_set_name = name;
+        if (name.empty())
           {
             for (unsigned int i = first_component; i < last_component; ++i)
-              out << data_names[i] << "__";
-            out << data_names[last_component];
+              data_set_name += data_names[i] + "__";
+            data_set_name += data_names[last_component];
           }
 
+        out << "    <DataArray type=\"Float32\" Name=\"" << data_set_name;
         out << "\" NumberOfComponents=\"" << n_components << "\" format=\""
             << ascii_or_binary << "\">\n";
 
@@ -5892,6 +6137,7 @@ namespace DataOutBase
               }
           } // loop over nodes
 
+        reduce_vtk_precision(data_set_name, flags, data);
         vtu_out << data;
         out << "    </DataArray>\n";
 
@@ -5907,6 +6153,7 @@ namespace DataOutBase
 
           std::vector<float> data(data_vectors[data_set].begin(),
                                   data_vectors[data_set].end());
+          reduce_vtk_precision(data_names[data_set], flags, data);
           vtu_out << data;
           out << "    </DataArray>\n";
         }
@@ -5925,6 +6172,121 @@ namespace DataOutBase
 
 
 
+  template <int dim, int spacedim>
+  void
+  build_vtk_unstructured_grid(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &                  nonscalar_data_ranges,
+    const VtkFlags &     flags,
+    VtkUnstructuredGrid &grid)
+  {
+    grid = VtkUnstructuredGrid();
+
+    const unsigned int n_data_sets = data_names.size();
+    if (patches.size() > 0)
+      {
+        if (patches[0].points_are_available)
+          {
+            AssertDimension(n_data_sets + spacedim, patches[0].data.n_rows())
+          }
+        else
+          {
+            AssertDimension(n_data_sets, patches[0].data.n_rows())
+          }
+      }
+
+    unsigned int n_nodes;
+    unsigned int n_cells;
+    compute_sizes<dim, spacedim>(patches, n_nodes, n_cells);
+
+    // collect the points and cells in the same order as write_vtu_main()
+    VtkArrayCollector collector(grid);
+    grid.points.reserve(3 * n_nodes);
+    write_nodes(patches, collector);
+    if (flags.write_higher_order_cells)
+      write_high_order_cells(patches, collector);
+    else
+      write_cells(patches, collector);
+    grid.cell_types.resize(grid.offsets.size(),
+                           flags.write_higher_order_cells ?
+                             vtk_lagrange_cell_type[dim] :
+                             vtk_cell_type[dim]);
+
+    Table<2, float> data_vectors(n_data_sets, n_nodes);
+    write_gmv_reorder_data_vectors(patches, data_vectors);
+
+    // first the vector and tensor data sets, padded to three components
+    // and 3x3 tensors, then the remaining scalar data sets
+    std::vector<bool> data_set_written(n_data_sets, false);
+    for (const auto &range : nonscalar_data_ranges)
+      {
+        const unsigned int first_component = std::get<0>(range);
+        const unsigned int last_component  = std::get<1>(range);
+        const bool         is_tensor =
+          (std::get<3>(range) ==
+           DataComponentInterpretation::component_is_part_of_tensor);
+        const unsigned int n_components = (is_tensor ? 9 : 3);
+        const unsigned int size         = last_component - first_component + 1;
+        AssertThrow(last_component >= first_component,
+                    ExcLowerRange(last_component, first_component));
+        AssertThrow(last_component < n_data_sets,
+                    ExcIndexRange(last_component, 0, n_data_sets));
+        AssertThrow(is_tensor ? (size == 1 || size == 4 || size == 9) :
+                                size <= 3,
+                    ExcMessage("VTK only supports vectors with up to three "
+                               "components and tensors with up to nine "
+                               "components."));
+
+        std::string name = std::get<2>(range);
+        if (name.empty())
+          {
+            for (unsigned int i = first_component; i < last_component; ++i)
+              name += data_names[i] + "__";
+            name += data_names[last_component];
+          }
+
+        std::vector<float> data(n_components * n_nodes, 0.f);
+        for (unsigned int c = 0; c < size; ++c)
+          {
+            // the components of a tensor are stored in unrolled order
+            unsigned int vtk_component = c;
+            if (is_tensor && size > 1)
+              {
+                const auto ind =
+                  Tensor<2, dim>::unrolled_to_component_indices(c);
+                vtk_component = 3 * ind[0] + ind[1];
+              }
+            for (unsigned int n = 0; n < n_nodes; ++n)
+              data[n * n_components + vtk_component] =
+                data_vectors(first_component + c, n);
+            data_set_written[first_component + c] = true;
+          }
+        reduce_vtk_precision(name, flags, data);
+
+        grid.data_names.push_back(name);
+        grid.data_n_components.push_back(n_components);
+        grid.data.push_back(std::move(data));
+      }
+
+    for (unsigned int data_set = 0; data_set < n_data_sets; ++data_set)
+      if (data_set_written[data_set] == false)
+        {
+          grid.data_names.push_back(data_names[data_set]);
+          grid.data_n_components.push_back(1);
+          grid.data.emplace_back(data_vectors[data_set].begin(),
+                                 data_vectors[data_set].end());
+          reduce_vtk_precision(data_names[data_set], flags, grid.data.back());
+        }
+  }
+
+
+
   void
   write_pvtu_record(
     std::ostream &                  out,
@@ -7429,6 +7791,33 @@ DataOutInterface<dim, spacedim>::write_vtu(std::ostream &out) const
                          out);
 }
 
+template <int dim, int spacedim>
+Threads::Task<>
+DataOutInterface<dim, spacedim>::write_vtu_in_background(
+  const std::string &filename) const
+{
+  // take a snapshot of all data needed for the output, since the current
+  // object may be changed while the task is running
+  const auto patches =
+    std::make_shared<const std::vector<DataOutBase::Patch<dim, spacedim>>>(
+      get_patches());
+  const std::vector<std::string> dataset_names = get_dataset_names();
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+                              nonscalar_data_ranges = get_nonscalar_data_ranges();
+  const DataOutBase::VtkFlags flags                 = vtk_flags;
+
+  return Threads::new_task([=]() {
+    std::ofstream out(filename);
+    AssertThrow(out, ExcFileNotOpen(filename));
+    DataOutBase::write_vtu(
+      *patches, dataset_names, nonscalar_data_ranges, flags, out);
+  });
+}
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_svg(std::ostream &out) const
@@ -7531,6 +7920,20 @@ DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
 }
 
 
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::build_vtk_unstructured_grid(
+  DataOutBase::VtkUnstructuredGrid &grid) const
+{
+  DataOutBase::build_vtk_unstructured_grid(get_patches(),
+                                           get_dataset_names(),
+                                           get_nonscalar_data_ranges(),
+                                           vtk_flags,
+                                           grid);
+}
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_pvtu_record(
@@ -8964,6 +9367,602 @@ XDMFEntry::get_xdmf_content(const unsigned int indent_level) const
 
 
 
+#ifdef DEAL_II_WITH_HDF5
+namespace
+{
+  /**
+   * Open the HDF5 file @p filename for writing by all processes in @p comm,
+   * creating it if @p create is true. If HDF5 supports parallel output, the
+   * file is accessed through MPI-IO with collective buffering enabled.
+   */
+  hid_t
+  open_hdf5_file(const std::string &filename,
+                 const MPI_Comm     comm,
+                 const bool         create)
+  {
+    const hid_t file_plist_id = H5Pcreate(H5P_FILE_ACCESS);
+    AssertThrow(file_plist_id >= 0, ExcIO());
+    herr_t status;
+    (void)status;
+
+    // If HDF5 is not parallel and we're using multiple processes, abort
+#  ifdef DEAL_II_WITH_MPI
+#    ifdef H5_HAVE_PARALLEL
+    // Ask the MPI-IO layer to aggregate the many small pieces written by the
+    // individual processes into large contiguous writes
+    MPI_Info info;
+    int      ierr = MPI_Info_create(&info);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Info_set(info,
+                        const_cast<char *>("romio_cb_write"),
+                        const_cast<char *>("enable"));
+    AssertThrowMPI(ierr);
+    status = H5Pset_fapl_mpio(file_plist_id, comm, info);
+    AssertThrow(status >= 0, ExcIO());
+    ierr = MPI_Info_free(&info);
+    AssertThrowMPI(ierr);
+#    else
+    AssertThrow(
+      Utilities::MPI::n_mpi_processes(comm) <= 1,
+      ExcMessage(
+        "Serial HDF5 output on multiple processes is not yet supported."));
+#    endif
+#  else
+    (void)comm;
+#  endif
+
+    const hid_t file_id =
+      create ? H5Fcreate(filename.c_str(),
+                         H5F_ACC_TRUNC,
+                         H5P_DEFAULT,
+                         file_plist_id) :
+               H5Fopen(filename.c_str(), H5F_ACC_RDWR, file_plist_id);
+    AssertThrow(file_id >= 0, ExcIO());
+
+    status = H5Pclose(file_plist_id);
+    AssertThrow(status >= 0, ExcIO());
+
+    return file_id;
+  }
+
+
+
+  /**
+   * Create the property list for collective writes, if HDF5 supports
+   * parallel output.
+   */
+  hid_t
+  create_transfer_properties()
+  {
+    const hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
+    AssertThrow(plist_id >= 0, ExcIO());
+#  ifdef DEAL_II_WITH_MPI
+#    ifdef H5_HAVE_PARALLEL
+    const herr_t status = H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+    AssertThrow(status >= 0, ExcIO());
+#    endif
+#  endif
+    return plist_id;
+  }
+
+
+
+  /**
+   * Write the @p n_local_rows rows of @p data, each with @p n_columns
+   * entries of type @p type, to the rows starting at @p row_offset of the
+   * dataset @p dataset_id. If @p time_step is not
+   * numbers::invalid_unsigned_int, the dataset has an additional leading
+   * dimension for the time steps and the data is written to the given time
+   * step. Processes without any rows take part in the collective write with
+   * an empty selection.
+   */
+  void
+  write_rows(const hid_t        dataset_id,
+             const hid_t        type,
+             const hid_t        plist_id,
+             const unsigned int time_step,
+             const hsize_t      row_offset,
+             const hsize_t      n_local_rows,
+             const hsize_t      n_columns,
+             const void *       data)
+  {
+    const bool    with_time = (time_step != numbers::invalid_unsigned_int);
+    const hsize_t offset[3] = {time_step, row_offset, 0};
+    const hsize_t count[3]  = {1, n_local_rows, n_columns};
+
+    const hid_t memory_dataspace =
+      H5Screate_simple(2, count + (with_time ? 1 : 0), nullptr);
+    AssertThrow(memory_dataspace >= 0, ExcIO());
+
+    const hid_t file_dataspace = H5Dget_space(dataset_id);
+    AssertThrow(file_dataspace >= 0, ExcIO());
+
+    herr_t status;
+    if (n_local_rows > 0)
+      status = H5Sselect_hyperslab(file_dataspace,
+                                   H5S_SELECT_SET,
+                                   offset + (with_time ? 0 : 1),
+                                   nullptr,
+                                   count + (with_time ? 0 : 1),
+                                   nullptr);
+    else
+      {
+        status = H5Sselect_none(memory_dataspace);
+        AssertThrow(status >= 0, ExcIO());
+        status = H5Sselect_none(file_dataspace);
+      }
+    AssertThrow(status >= 0, ExcIO());
+
+    status = H5Dwrite(
+      dataset_id, type, memory_dataspace, file_dataspace, plist_id, data);
+    AssertThrow(status >= 0, ExcIO());
+
+    status = H5Sclose(file_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Sclose(memory_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+  }
+
+
+
+  /**
+   * Create the dataset @p name of size @p global_n_rows x @p n_columns in
+   * the group @p group_id and write the local rows to it.
+   */
+  void
+  write_mesh_dataset(const hid_t        group_id,
+                     const std::string &name,
+                     const hid_t        type,
+                     const hid_t        plist_id,
+                     const hsize_t      global_n_rows,
+                     const hsize_t      row_offset,
+                     const hsize_t      n_local_rows,
+                     const hsize_t      n_columns,
+                     const void *       data)
+  {
+    const hsize_t dimensions[2] = {global_n_rows, n_columns};
+    const hid_t   dataspace     = H5Screate_simple(2, dimensions, nullptr);
+    AssertThrow(dataspace >= 0, ExcIO());
+
+#  if H5Gcreate_vers == 1
+    const hid_t dataset =
+      H5Dcreate(group_id, name.c_str(), type, dataspace, H5P_DEFAULT);
+#  else
+    const hid_t dataset = H5Dcreate(group_id,
+                                    name.c_str(),
+                                    type,
+                                    dataspace,
+                                    H5P_DEFAULT,
+                                    H5P_DEFAULT,
+                                    H5P_DEFAULT);
+#  endif
+    AssertThrow(dataset >= 0, ExcIO());
+
+    herr_t status = H5Sclose(dataspace);
+    AssertThrow(status >= 0, ExcIO());
+
+    write_rows(dataset,
+               type,
+               plist_id,
+               numbers::invalid_unsigned_int,
+               row_offset,
+               n_local_rows,
+               n_columns,
+               data);
+
+    status = H5Dclose(dataset);
+    AssertThrow(status >= 0, ExcIO());
+  }
+} // namespace
+#endif
+
+
+
+template <int dim, int spacedim>
+XDMFTimeSeriesWriter<dim, spacedim>::XDMFTimeSeriesWriter(
+  const std::string &h5_filename,
+  const std::string &xdmf_filename,
+  const MPI_Comm     comm,
+  const std::size_t  chunk_size_in_bytes)
+  : h5_filename(h5_filename)
+  , xdmf_filename(xdmf_filename)
+  , comm(comm)
+  , chunk_size_in_bytes(chunk_size_in_bytes)
+  , n_meshes_written(0)
+  , n_steps_on_current_mesh(0)
+  , n_time_steps_written(0)
+  , global_n_nodes(0)
+  , global_n_cells(0)
+  , local_n_nodes(0)
+  , xdmf_footer_position(0)
+{
+  AssertThrow(
+    spacedim >= 2,
+    ExcMessage(
+      "DataOutBase was asked to write HDF5 output for a space dimension of 1. "
+      "HDF5 only supports datasets that live in 2 or 3 dimensions."));
+  Assert(chunk_size_in_bytes > 0, ExcZero());
+
+#ifndef DEAL_II_WITH_HDF5
+  AssertThrow(false, ExcMessage("HDF5 support is disabled."));
+#else
+  const hid_t  file_id = open_hdf5_file(h5_filename, comm, true);
+  const herr_t status  = H5Fclose(file_id);
+  AssertThrow(status >= 0, ExcIO());
+
+  // Write an XDMF file without any entries. The entries of the time steps
+  // are inserted before the closing tags later on
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    {
+      std::ofstream xdmf_file(xdmf_filename.c_str());
+      AssertThrow(xdmf_file, ExcFileNotOpen(xdmf_filename));
+
+      xdmf_file << "<?xml version=\"1.0\" ?>\n";
+      xdmf_file << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n";
+      xdmf_file << "<Xdmf Version=\"2.0\">\n";
+      xdmf_file << "  <Domain>\n";
+      xdmf_file
+        << "    <Grid Name=\"CellTime\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+      xdmf_footer_position = xdmf_file.tellp();
+      xdmf_file << "    </Grid>\n";
+      xdmf_file << "  </Domain>\n";
+      xdmf_file << "</Xdmf>\n";
+
+      AssertThrow(xdmf_file, ExcIO());
+    }
+#endif
+}
+
+
+
+template <int dim, int spacedim>
+void
+XDMFTimeSeriesWriter<dim, spacedim>::write_time_step(
+  const DataOutInterface<dim, spacedim> &data_out,
+  const double                           time,
+  const bool                             mesh_changed)
+{
+  DataOutBase::DataOutFilter data_filter(
+    DataOutBase::DataOutFilterFlags(true, true));
+  data_out.write_filtered_data(data_filter);
+  write_time_step(data_filter, time, mesh_changed);
+}
+
+
+
+template <int dim, int spacedim>
+void
+XDMFTimeSeriesWriter<dim, spacedim>::write_time_step(
+  const DataOutBase::DataOutFilter &data_filter,
+  const double                      time,
+  const bool                        mesh_changed)
+{
+#ifndef DEAL_II_WITH_HDF5
+  // throw an exception, but first make sure the compiler does not warn about
+  // the now unused function arguments
+  (void)data_filter;
+  (void)time;
+  (void)mesh_changed;
+  AssertThrow(false, ExcMessage("HDF5 support is disabled."));
+#else
+  const bool write_mesh = mesh_changed || n_meshes_written == 0;
+
+  // Compute the global number of nodes and cells and the offsets of the data
+  // of this process
+  const unsigned int local_node_cell_count[2] = {data_filter.n_nodes(),
+                                                 data_filter.n_cells()};
+  unsigned int       global_node_cell_count[2]   = {0, 0};
+  unsigned int       global_node_cell_offsets[2] = {0, 0};
+#  ifdef DEAL_II_WITH_MPI
+  int ierr = MPI_Allreduce(local_node_cell_count,
+                           global_node_cell_count,
+                           2,
+                           MPI_UNSIGNED,
+                           MPI_SUM,
+                           comm);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Exscan(local_node_cell_count,
+                    global_node_cell_offsets,
+                    2,
+                    MPI_UNSIGNED,
+                    MPI_SUM,
+                    comm);
+  AssertThrowMPI(ierr);
+  // The result of MPI_Exscan is undefined on the first process
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    global_node_cell_offsets[0] = global_node_cell_offsets[1] = 0;
+#  else
+  global_node_cell_count[0] = local_node_cell_count[0];
+  global_node_cell_count[1] = local_node_cell_count[1];
+#  endif
+
+  std::vector<std::pair<std::string, unsigned int>> new_data_sets;
+  for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+    new_data_sets.emplace_back(data_filter.get_data_set_name(i),
+                               data_filter.get_data_set_dim(i));
+
+  if (write_mesh)
+    {
+      AssertThrow(global_node_cell_count[0] > 0,
+                  ExcMessage("There are no nodes to be written."));
+    }
+  else
+    {
+      AssertThrow(global_node_cell_count[0] == global_n_nodes &&
+                    global_node_cell_count[1] == global_n_cells &&
+                    local_node_cell_count[0] == local_n_nodes,
+                  ExcMessage("The mesh has changed since the last time step. "
+                             "You need to set the argument mesh_changed to "
+                             "true in this case."));
+      AssertThrow(new_data_sets == data_sets,
+                  ExcMessage("The data sets need to be the same for all "
+                             "time steps on the same mesh."));
+    }
+
+  const hid_t file_id  = open_hdf5_file(h5_filename, comm, false);
+  const hid_t plist_id = create_transfer_properties();
+  herr_t      status;
+
+  hid_t group_id;
+  if (write_mesh)
+    {
+      const std::string group_name =
+        "mesh_" + Utilities::int_to_string(n_meshes_written);
+#  if H5Gcreate_vers == 1
+      group_id = H5Gcreate(file_id, group_name.c_str(), 0);
+#  else
+      group_id = H5Gcreate(
+        file_id, group_name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+#  endif
+      AssertThrow(group_id >= 0, ExcIO());
+
+      // Write the nodes and cells. HDF5 only supports 2- or 3-dimensional
+      // coordinates
+      std::vector<double> node_data_vec;
+      data_filter.fill_node_data(node_data_vec);
+      write_mesh_dataset(group_id,
+                         "nodes",
+                         H5T_NATIVE_DOUBLE,
+                         plist_id,
+                         global_node_cell_count[0],
+                         global_node_cell_offsets[0],
+                         local_node_cell_count[0],
+                         (spacedim < 2) ? 2 : spacedim,
+                         node_data_vec.data());
+      node_data_vec.clear();
+
+      std::vector<unsigned int> cell_data_vec;
+      data_filter.fill_cell_data(global_node_cell_offsets[0], cell_data_vec);
+      write_mesh_dataset(group_id,
+                         "cells",
+                         H5T_NATIVE_UINT,
+                         plist_id,
+                         global_node_cell_count[1],
+                         global_node_cell_offsets[1],
+                         local_node_cell_count[1],
+                         GeometryInfo<dim>::vertices_per_cell,
+                         cell_data_vec.data());
+      cell_data_vec.clear();
+
+      // Create the datasets for the point data. They can be extended along
+      // the first dimension, the time steps, and are split into chunks
+      // holding the data of a block of nodes in a single time step
+      for (const auto &data_set : new_data_sets)
+        {
+          const hsize_t dimensions[3]     = {0,
+                                         global_node_cell_count[0],
+                                         data_set.second};
+          const hsize_t max_dimensions[3] = {H5S_UNLIMITED,
+                                             global_node_cell_count[0],
+                                             data_set.second};
+          const hsize_t chunk_dimensions[3] = {
+            1,
+            std::max<hsize_t>(
+              1,
+              std::min<hsize_t>(global_node_cell_count[0],
+                                chunk_size_in_bytes /
+                                  (sizeof(double) * data_set.second))),
+            data_set.second};
+
+          const hid_t dataspace =
+            H5Screate_simple(3, dimensions, max_dimensions);
+          AssertThrow(dataspace >= 0, ExcIO());
+
+          const hid_t dataset_plist_id = H5Pcreate(H5P_DATASET_CREATE);
+          AssertThrow(dataset_plist_id >= 0, ExcIO());
+          status = H5Pset_chunk(dataset_plist_id, 3, chunk_dimensions);
+          AssertThrow(status >= 0, ExcIO());
+
+#  if H5Gcreate_vers == 1
+          const hid_t dataset = H5Dcreate(group_id,
+                                          data_set.first.c_str(),
+                                          H5T_NATIVE_DOUBLE,
+                                          dataspace,
+                                          dataset_plist_id);
+#  else
+          const hid_t dataset = H5Dcreate(group_id,
+                                          data_set.first.c_str(),
+                                          H5T_NATIVE_DOUBLE,
+                                          dataspace,
+                                          H5P_DEFAULT,
+                                          dataset_plist_id,
+                                          H5P_DEFAULT);
+#  endif
+          AssertThrow(dataset >= 0, ExcIO());
+
+          status = H5Pclose(dataset_plist_id);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Sclose(dataspace);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Dclose(dataset);
+          AssertThrow(status >= 0, ExcIO());
+        }
+
+      ++n_meshes_written;
+      n_steps_on_current_mesh = 0;
+      global_n_nodes          = global_node_cell_count[0];
+      global_n_cells          = global_node_cell_count[1];
+      local_n_nodes           = local_node_cell_count[0];
+      data_sets               = new_data_sets;
+    }
+  else
+    {
+      const std::string group_name =
+        "mesh_" + Utilities::int_to_string(n_meshes_written - 1);
+#  if H5Gcreate_vers == 1
+      group_id = H5Gopen(file_id, group_name.c_str());
+#  else
+      group_id = H5Gopen(file_id, group_name.c_str(), H5P_DEFAULT);
+#  endif
+      AssertThrow(group_id >= 0, ExcIO());
+    }
+
+  // Append the point data of this time step to the datasets
+  for (unsigned int i = 0; i < data_sets.size(); ++i)
+    {
+#  if H5Gcreate_vers == 1
+      const hid_t dataset = H5Dopen(group_id, data_sets[i].first.c_str());
+#  else
+      const hid_t dataset =
+        H5Dopen(group_id, data_sets[i].first.c_str(), H5P_DEFAULT);
+#  endif
+      AssertThrow(dataset >= 0, ExcIO());
+
+      const hsize_t dimensions[3] = {n_steps_on_current_mesh + 1,
+                                     global_n_nodes,
+                                     data_sets[i].second};
+      status = H5Dset_extent(dataset, dimensions);
+      AssertThrow(status >= 0, ExcIO());
+
+      write_rows(dataset,
+                 H5T_NATIVE_DOUBLE,
+                 plist_id,
+                 n_steps_on_current_mesh,
+                 global_node_cell_offsets[0],
+                 local_node_cell_count[0],
+                 data_sets[i].second,
+                 data_filter.get_data_set(i));
+
+      status = H5Dclose(dataset);
+      AssertThrow(status >= 0, ExcIO());
+    }
+
+  status = H5Gclose(group_id);
+  AssertThrow(status >= 0, ExcIO());
+  status = H5Pclose(plist_id);
+  AssertThrow(status >= 0, ExcIO());
+  status = H5Fclose(file_id);
+  AssertThrow(status >= 0, ExcIO());
+
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    append_xdmf_entry(time);
+
+  ++n_steps_on_current_mesh;
+  ++n_time_steps_written;
+#endif
+}
+
+
+
+template <int dim, int spacedim>
+void
+XDMFTimeSeriesWriter<dim, spacedim>::append_xdmf_entry(const double time)
+{
+  const std::string mesh_path =
+    h5_filename + ":/mesh_" + Utilities::int_to_string(n_meshes_written - 1);
+
+  std::stringstream ss;
+  ss << indent(3) << "<Grid Name=\"mesh\" GridType=\"Uniform\">\n";
+  ss << indent(4) << "<Time Value=\"" << time << "\"/>\n";
+  ss << indent(4) << "<Geometry GeometryType=\""
+     << (spacedim <= 2 ? "XY" : "XYZ") << "\">\n";
+  ss << indent(5) << "<DataItem Dimensions=\"" << global_n_nodes << " "
+     << (spacedim <= 2 ? 2 : spacedim)
+     << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">\n";
+  ss << indent(6) << mesh_path << "/nodes\n";
+  ss << indent(5) << "</DataItem>\n";
+  ss << indent(4) << "</Geometry>\n";
+
+  ss << indent(4) << "<Topology TopologyType=\"";
+  if (dim == 0)
+    ss << "Polyvertex\" NumberOfElements=\"" << global_n_cells
+       << "\" NodesPerElement=\"1\">\n";
+  else if (dim == 1)
+    ss << "Polyline\" NumberOfElements=\"" << global_n_cells
+       << "\" NodesPerElement=\"2\">\n";
+  else if (dim == 2)
+    ss << "Quadrilateral\" NumberOfElements=\"" << global_n_cells << "\">\n";
+  else if (dim == 3)
+    ss << "Hexahedron\" NumberOfElements=\"" << global_n_cells << "\">\n";
+  ss << indent(5) << "<DataItem Dimensions=\"" << global_n_cells << " "
+     << GeometryInfo<dim>::vertices_per_cell
+     << "\" NumberType=\"UInt\" Format=\"HDF\">\n";
+  ss << indent(6) << mesh_path << "/cells\n";
+  ss << indent(5) << "</DataItem>\n";
+  ss << indent(4) << "</Topology>\n";
+
+  // The data of this time step is a hyperslab of the dataset holding all
+  // time steps on this mesh. The XML data item gives the start, stride, and
+  // count of the hyperslab
+  for (const auto &data_set : data_sets)
+    {
+      ss << indent(4) << "<Attribute Name=\"" << data_set.first
+         << "\" AttributeType=\"" << (data_set.second > 1 ? "Vector" : "Scalar")
+         << "\" Center=\"Node\">\n";
+      ss << indent(5) << "<DataItem ItemType=\"HyperSlab\" Dimensions=\""
+         << global_n_nodes << " " << data_set.second
+         << "\" Type=\"HyperSlab\">\n";
+      ss << indent(6) << "<DataItem Dimensions=\"3 3\" Format=\"XML\">\n";
+      ss << indent(7) << n_steps_on_current_mesh << " 0 0 1 1 1 1 "
+         << global_n_nodes << " " << data_set.second << "\n";
+      ss << indent(6) << "</DataItem>\n";
+      ss << indent(6) << "<DataItem Dimensions=\""
+         << n_steps_on_current_mesh + 1 << " " << global_n_nodes << " "
+         << data_set.second
+         << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">\n";
+      ss << indent(7) << mesh_path << "/" << data_set.first << "\n";
+      ss << indent(6) << "</DataItem>\n";
+      ss << indent(5) << "</DataItem>\n";
+      ss << indent(4) << "</Attribute>\n";
+    }
+  ss << indent(3) << "</Grid>\n";
+
+  // Overwrite the closing tags of the XDMF file by the new entry and write
+  // them again after it. The file only grows, so nothing of the old closing
+  // tags remains
+  std::fstream xdmf_file(xdmf_filename.c_str(),
+                         std::ios::in | std::ios::out);
+  AssertThrow(xdmf_file, ExcFileNotOpen(xdmf_filename));
+  xdmf_file.seekp(xdmf_footer_position);
+  xdmf_file << ss.str();
+  xdmf_footer_position = xdmf_file.tellp();
+  xdmf_file << "    </Grid>\n";
+  xdmf_file << "  </Domain>\n";
+  xdmf_file << "</Xdmf>\n";
+
+  AssertThrow(xdmf_file, ExcIO());
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+XDMFTimeSeriesWriter<dim, spacedim>::n_time_steps() const
+{
+  return n_time_steps_written;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+XDMFTimeSeriesWriter<dim, spacedim>::n_meshes() const
+{
+  return n_meshes_written;
+}
+
+
+
 namespace DataOutBase
 {
   template <int dim, int spacedim>
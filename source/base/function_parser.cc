@@ -23,6 +23,7 @@
 
 #include <boost/random.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 
@@ -153,6 +154,27 @@ FunctionParser<dim>::initialize(const std::string &             variables,
 
 namespace internal
 {
+  // the number of points muparser evaluates at once in bulk mode. each
+  // variable is stored in an array of this length, the first entry of
+  // which is used when evaluating at a single point
+  const unsigned int bulk_size = 128;
+
+  // print the details of an error encountered by muparser and throw the
+  // corresponding exception
+  template <int dim>
+  void
+  report_parser_error(const mu::ParserError &e)
+  {
+    std::cerr << "Message:  <" << e.GetMsg() << ">\n";
+    std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
+    std::cerr << "Token:    <" << e.GetToken() << ">\n";
+    std::cerr << "Position: <" << e.GetPos() << ">\n";
+    std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
+    AssertThrow(false,
+                typename FunctionParser<dim>::ExcParseError(e.GetCode(),
+                                                            e.GetMsg()));
+  }
+
   // convert double into int
   int
   mu_round(double val)
@@ -287,7 +309,7 @@ FunctionParser<dim>::init_muparser() const
   // initialize the objects for the current thread (fp.get() and
   // vars.get())
   fp.get().reserve(this->n_components);
-  vars.get().resize(var_names.size());
+  vars.get().resize(var_names.size() * internal::bulk_size);
   for (unsigned int component = 0; component < this->n_components; ++component)
     {
       fp.get().emplace_back(new mu::Parser());
@@ -301,7 +323,8 @@ FunctionParser<dim>::init_muparser() const
         }
 
       for (unsigned int iv = 0; iv < var_names.size(); ++iv)
-        fp.get()[component]->DefineVar(var_names[iv], &vars.get()[iv]);
+        fp.get()[component]->DefineVar(var_names[iv],
+                                       &vars.get()[iv * internal::bulk_size]);
 
       // define some compatibility functions:
       fp.get()[component]->DefineFun("if", internal::mu_if, true);
@@ -404,12 +427,7 @@ FunctionParser<dim>::init_muparser() const
         }
       catch (mu::ParserError &e)
         {
-          std::cerr << "Message:  <" << e.GetMsg() << ">\n";
-          std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
-          std::cerr << "Token:    <" << e.GetToken() << ">\n";
-          std::cerr << "Position: <" << e.GetPos() << ">\n";
-          std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
-          AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+          internal::report_parser_error<dim>(e);
         }
     }
 }
@@ -445,9 +463,9 @@ FunctionParser<dim>::value(const Point<dim> & p,
     init_muparser();
 
   for (unsigned int i = 0; i < dim; ++i)
-    vars.get()[i] = p(i);
+    vars.get()[i * internal::bulk_size] = p(i);
   if (dim != n_vars)
-    vars.get()[dim] = this->get_time();
+    vars.get()[dim * internal::bulk_size] = this->get_time();
 
   try
     {
@@ -455,12 +473,7 @@ FunctionParser<dim>::value(const Point<dim> & p,
     }
   catch (mu::ParserError &e)
     {
-      std::cerr << "Message:  <" << e.GetMsg() << ">\n";
-      std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
-      std::cerr << "Token:    <" << e.GetToken() << ">\n";
-      std::cerr << "Position: <" << e.GetPos() << ">\n";
-      std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
-      AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+      internal::report_parser_error<dim>(e);
       return 0.0;
     }
 }
@@ -482,14 +495,61 @@ FunctionParser<dim>::vector_value(const Point<dim> &p,
     init_muparser();
 
   for (unsigned int i = 0; i < dim; ++i)
-    vars.get()[i] = p(i);
+    vars.get()[i * internal::bulk_size] = p(i);
   if (dim != n_vars)
-    vars.get()[dim] = this->get_time();
+    vars.get()[dim * internal::bulk_size] = this->get_time();
 
   for (unsigned int component = 0; component < this->n_components; ++component)
     values(component) = fp.get()[component]->Eval();
 }
 
+
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &points,
+                                std::vector<double> &          values,
+                                const unsigned int             component) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(component < this->n_components,
+         ExcIndexRange(component, 0, this->n_components));
+  AssertDimension(values.size(), points.size());
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  std::vector<double> &variables = vars.get();
+  const double         time      = this->get_time();
+
+  // evaluate the points in chunks that fit into the variable arrays, using
+  // the bulk mode of muparser that runs through the byte code once per
+  // point without the overhead of a separate call
+  for (unsigned int start = 0; start < points.size();
+       start += internal::bulk_size)
+    {
+      const unsigned int n_points =
+        std::min<unsigned int>(internal::bulk_size, points.size() - start);
+      for (unsigned int q = 0; q < n_points; ++q)
+        {
+          for (unsigned int i = 0; i < dim; ++i)
+            variables[i * internal::bulk_size + q] = points[start + q][i];
+          if (dim != n_vars)
+            variables[dim * internal::bulk_size + q] = time;
+        }
+
+      try
+        {
+          fp.get()[component]->Eval(&values[start], n_points);
+        }
+      catch (mu::ParserError &e)
+        {
+          internal::report_parser_error<dim>(e);
+        }
+    }
+}
+
 #else
 
 
@@ -532,6 +592,16 @@ FunctionParser<dim>::vector_value(const Point<dim> &, Vector<double> &) const
 }
 
 
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &,
+                                std::vector<double> &,
+                                const unsigned int) const
+{
+  Assert(false, ExcNeedsFunctionparser());
+}
+
+
 #endif
 
 // Explicit Instantiations.
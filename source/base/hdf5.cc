@@ -21,6 +21,7 @@
 #  include <deal.II/base/hdf5.h>
 
 #  include <deal.II/lac/full_matrix.h>
+#  include <deal.II/lac/la_parallel_vector.h>
 #  include <deal.II/lac/vector.h>
 
 #  include <hdf5.h>
@@ -185,6 +186,15 @@ namespace HDF5
 
 
 
+    template <typename number>
+    unsigned int
+    get_container_size(const ArrayView<number> &data)
+    {
+      return static_cast<unsigned int>(data.size());
+    }
+
+
+
     // This function initializes and returns a container of type std::vector,
     // Vector or FullMatrix. The function does not set the values of the
     // elements of the container. The container can store data of a HDF5 dataset
@@ -260,16 +270,20 @@ namespace HDF5
     // This helper function sets the property list of the read and write
     // operations of DataSet. A property list has to be created for the MPI
     // driver. For the serial driver the default H5P_DEFAULT can be used. In
-    // addition H5Pset_dxpl_mpio is used to set the MPI mode to collective.
+    // addition H5Pset_dxpl_mpio is used to set the MPI mode to collective or
+    // independent.
     void
-    set_plist(hid_t &plist, const bool mpi)
+    set_plist(hid_t &plist, const bool mpi, const bool collective)
     {
       if (mpi)
         {
 #  ifdef DEAL_II_WITH_MPI
           plist = H5Pcreate(H5P_DATASET_XFER);
           Assert(plist >= 0, ExcInternalError());
-          const herr_t ret = H5Pset_dxpl_mpio(plist, H5FD_MPIO_COLLECTIVE);
+          const herr_t ret =
+            H5Pset_dxpl_mpio(plist,
+                             collective ? H5FD_MPIO_COLLECTIVE :
+                                          H5FD_MPIO_INDEPENDENT);
           (void)ret;
           Assert(ret >= 0, ExcInternalError());
 #  else
@@ -283,6 +297,7 @@ namespace HDF5
 
       (void)plist;
       (void)mpi;
+      (void)collective;
     }
 
 
@@ -608,6 +623,7 @@ namespace HDF5
                    const bool         mpi)
     : HDF5Object(name, mpi)
     , query_io_mode(false)
+    , transfer_mode(TransferMode::collective)
     , io_mode(H5D_MPIO_NO_COLLECTIVE)
     , local_no_collective_cause(H5D_MPIO_SET_INDEPENDENT)
     , global_no_collective_cause(H5D_MPIO_SET_INDEPENDENT)
@@ -654,15 +670,17 @@ namespace HDF5
 
 
 
-  DataSet::DataSet(const std::string &           name,
-                   const hid_t &                 parent_group_id,
-                   const std::vector<hsize_t> &  dimensions,
-                   const std::shared_ptr<hid_t> &t_type,
-                   const bool                    mpi)
+  DataSet::DataSet(const std::string &              name,
+                   const hid_t &                    parent_group_id,
+                   const std::vector<hsize_t> &     dimensions,
+                   const std::shared_ptr<hid_t> &   t_type,
+                   const bool                       mpi,
+                   const DataSetCreationProperties &properties)
     : HDF5Object(name, mpi)
     , rank(dimensions.size())
     , dimensions(dimensions)
     , query_io_mode(false)
+    , transfer_mode(TransferMode::collective)
     , io_mode(H5D_MPIO_NO_COLLECTIVE)
     , local_no_collective_cause(H5D_MPIO_SET_INDEPENDENT)
     , global_no_collective_cause(H5D_MPIO_SET_INDEPENDENT)
@@ -685,15 +703,53 @@ namespace HDF5
     *dataspace = H5Screate_simple(rank, dimensions.data(), nullptr);
     Assert(*dataspace >= 0, ExcMessage("Error at H5Screate_simple"));
 
+    // the dataset creation property list is only needed for chunked
+    // datasets, the filters can only be applied to chunks
+    hid_t  creation_plist = H5P_DEFAULT;
+    herr_t ret;
+    if (properties.chunk_dimensions.size() > 0)
+      {
+        AssertDimension(properties.chunk_dimensions.size(), rank);
+        AssertIndexRange(properties.deflate_level, 10);
+
+        creation_plist = H5Pcreate(H5P_DATASET_CREATE);
+        Assert(creation_plist >= 0, ExcMessage("Error at H5Pcreate"));
+        ret = H5Pset_chunk(creation_plist,
+                           rank,
+                           properties.chunk_dimensions.data());
+        Assert(ret >= 0, ExcMessage("Error at H5Pset_chunk"));
+        if (properties.shuffle)
+          {
+            ret = H5Pset_shuffle(creation_plist);
+            Assert(ret >= 0, ExcMessage("Error at H5Pset_shuffle"));
+          }
+        if (properties.deflate_level > 0)
+          {
+            ret = H5Pset_deflate(creation_plist, properties.deflate_level);
+            Assert(ret >= 0, ExcMessage("Error at H5Pset_deflate"));
+          }
+      }
+    else
+      Assert(properties.shuffle == false && properties.deflate_level == 0,
+             ExcMessage("Filters can only be applied to chunked datasets. "
+                        "Set DataSetCreationProperties::chunk_dimensions."));
+
     *hdf5_reference = H5Dcreate2(parent_group_id,
                                  name.data(),
                                  *t_type,
                                  *dataspace,
                                  H5P_DEFAULT,
-                                 H5P_DEFAULT,
+                                 creation_plist,
                                  H5P_DEFAULT);
     Assert(*hdf5_reference >= 0, ExcMessage("Error at H5Dcreate2"));
 
+    if (creation_plist != H5P_DEFAULT)
+      {
+        ret = H5Pclose(creation_plist);
+        Assert(ret >= 0, ExcMessage("Error at H5Pclose"));
+      }
+    (void)ret;
+
     size = 1;
     for (const auto &dimension : dimensions)
       {
@@ -714,7 +770,7 @@ namespace HDF5
 
     Container data = internal::initialize_container<Container>(dimensions);
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     ret = H5Dread(*hdf5_reference,
                   *t_type,
@@ -764,7 +820,7 @@ namespace HDF5
                              coordinates.data());
     Assert(ret >= 0, ExcMessage("Error at H5Sselect_elements"));
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     ret = H5Dread(*hdf5_reference,
                   *t_type,
@@ -818,7 +874,7 @@ namespace HDF5
                               nullptr);
     Assert(ret >= 0, ExcMessage("Error at H5Sselect_hyperslab"));
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     ret = H5Dread(*hdf5_reference,
                   *t_type,
@@ -871,7 +927,7 @@ namespace HDF5
                               block.data());
     Assert(ret >= 0, ExcMessage("Error at H5Sselect_hyperslab"));
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     ret = H5Dread(*hdf5_reference,
                   *t_type,
@@ -913,7 +969,7 @@ namespace HDF5
     ret = H5Sselect_none(*dataspace);
     Assert(ret >= 0, ExcMessage("H5Sselect_none"));
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     // The pointer of data can safely be nullptr, see the discussion at the HDF5
     // forum:
@@ -947,7 +1003,7 @@ namespace HDF5
     hid_t  plist;
     herr_t ret;
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     ret = H5Dwrite(*hdf5_reference,
                    *t_type,
@@ -993,7 +1049,7 @@ namespace HDF5
                              coordinates.data());
     Assert(ret >= 0, ExcMessage("Error at H5Sselect_elements"));
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     ret = H5Dwrite(*hdf5_reference,
                    *t_type,
@@ -1029,8 +1085,9 @@ namespace HDF5
                                     1,
                                     std::multiplies<unsigned int>()),
                     internal::get_container_size(data));
-    const std::shared_ptr<hid_t> t_type =
-      internal::get_hdf5_datatype<typename Container::value_type>();
+    // the value type of an ArrayView of constant data is const
+    const std::shared_ptr<hid_t> t_type = internal::get_hdf5_datatype<
+      typename std::remove_const<typename Container::value_type>::type>();
     // In this particular overload of write_hyperslab the data_dimensions are
     // the same as count
     const std::vector<hsize_t> &data_dimensions = count;
@@ -1050,7 +1107,7 @@ namespace HDF5
                               nullptr);
     Assert(ret >= 0, ExcMessage("Error at H5Sselect_hyperslab"));
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     ret = H5Dwrite(*hdf5_reference,
                    *t_type,
@@ -1102,7 +1159,7 @@ namespace HDF5
                               block.data());
     Assert(ret >= 0, ExcMessage("Error at H5Sselect_hyperslab"));
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     ret = H5Dwrite(*hdf5_reference,
                    *t_type,
@@ -1143,7 +1200,7 @@ namespace HDF5
     ret = H5Sselect_none(*dataspace);
     Assert(ret >= 0, ExcMessage("Error at H5PSselect_none"));
 
-    internal::set_plist(plist, mpi);
+    internal::set_plist(plist, mpi, transfer_mode == TransferMode::collective);
 
     // The pointer of data can safely be nullptr, see the discussion at the HDF5
     // forum:
@@ -1175,6 +1232,22 @@ namespace HDF5
 
 
 
+  void
+  DataSet::set_transfer_mode(const TransferMode new_transfer_mode)
+  {
+    transfer_mode = new_transfer_mode;
+  }
+
+
+
+  DataSet::TransferMode
+  DataSet::get_transfer_mode() const
+  {
+    return transfer_mode;
+  }
+
+
+
   std::vector<hsize_t>
   DataSet::get_dimensions() const
   {
@@ -1376,6 +1449,18 @@ namespace HDF5
 
 
 
+  template <typename number>
+  DataSet
+  Group::create_dataset(const std::string &              name,
+                        const std::vector<hsize_t> &     dimensions,
+                        const DataSetCreationProperties &properties) const
+  {
+    std::shared_ptr<hid_t> t_type = internal::get_hdf5_datatype<number>();
+    return {name, *hdf5_reference, dimensions, t_type, mpi, properties};
+  }
+
+
+
   template <typename Container>
   void
   Group::write_dataset(const std::string &name, const Container &data) const
@@ -1388,6 +1473,98 @@ namespace HDF5
 
 
 
+  template <typename number>
+  void
+  Group::write_distributed_dataset(
+    const std::string &                                                  name,
+    const LinearAlgebra::distributed::Vector<number, MemorySpace::Host> &data,
+    const DataSetCreationProperties &properties) const
+  {
+    Assert(mpi || data.get_partitioner()->n_mpi_processes() == 1,
+           ExcMessage("A vector distributed over several processes can only "
+                      "be written to a file opened in parallel."));
+
+    const std::vector<hsize_t> dimensions = {data.size()};
+    DataSet dataset = create_dataset<number>(name, dimensions, properties);
+
+    if (data.local_size() > 0)
+      {
+        const std::vector<hsize_t> offset = {data.local_range().first};
+        const std::vector<hsize_t> count  = {data.local_size()};
+        dataset.write_hyperslab(ArrayView<const number>(data.begin(),
+                                                        data.local_size()),
+                                offset,
+                                count);
+      }
+    else
+      dataset.write_none<number>();
+  }
+
+
+
+  template <typename number>
+  void
+  Group::write_distributed_dataset(
+    const std::string &              name,
+    const std::vector<number> &      local_data,
+    const unsigned int               n_columns,
+    const MPI_Comm &                 mpi_communicator,
+    const DataSetCreationProperties &properties) const
+  {
+    Assert(n_columns > 0, ExcZero());
+    Assert(local_data.size() % n_columns == 0,
+           ExcMessage("The number of local entries has to be a multiple of "
+                      "the number of columns."));
+
+    // the rows of the processes are stored in the order of their ranks, so
+    // the first row of each process is the sum of the numbers of rows of
+    // the processes before it
+    unsigned long long int n_local_rows = local_data.size() / n_columns;
+    unsigned long long int first_row    = 0;
+    unsigned long long int n_rows       = n_local_rows;
+#  ifdef DEAL_II_WITH_MPI
+    if (mpi)
+      {
+        int ierr = MPI_Exscan(&n_local_rows,
+                              &first_row,
+                              1,
+                              MPI_UNSIGNED_LONG_LONG,
+                              MPI_SUM,
+                              mpi_communicator);
+        AssertThrowMPI(ierr);
+        // the result of MPI_Exscan is undefined on the first process
+        if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+          first_row = 0;
+        ierr = MPI_Allreduce(&n_local_rows,
+                             &n_rows,
+                             1,
+                             MPI_UNSIGNED_LONG_LONG,
+                             MPI_SUM,
+                             mpi_communicator);
+        AssertThrowMPI(ierr);
+      }
+#  endif
+    (void)mpi_communicator;
+
+    std::vector<hsize_t> dimensions = {n_rows};
+    std::vector<hsize_t> offset     = {first_row};
+    std::vector<hsize_t> count      = {n_local_rows};
+    if (n_columns > 1)
+      {
+        dimensions.push_back(n_columns);
+        offset.push_back(0);
+        count.push_back(n_columns);
+      }
+
+    DataSet dataset = create_dataset<number>(name, dimensions, properties);
+    if (n_local_rows > 0)
+      dataset.write_hyperslab(local_data, offset, count);
+    else
+      dataset.write_none<number>();
+  }
+
+
+
   File::File(const std::string &name, const FileAccessMode mode)
     : File(name,
            mode,
@@ -1410,10 +1587,20 @@ namespace HDF5
 
 
 
-  File::File(const std::string &  name,
-             const FileAccessMode mode,
-             const bool           mpi,
-             const MPI_Comm       mpi_communicator)
+  File::File(const std::string &                       name,
+             const FileAccessMode                      mode,
+             const MPI_Comm                            mpi_communicator,
+             const std::map<std::string, std::string> &mpi_io_hints)
+    : File(name, mode, true, mpi_communicator, mpi_io_hints)
+  {}
+
+
+
+  File::File(const std::string &                       name,
+             const FileAccessMode                      mode,
+             const bool                                mpi,
+             const MPI_Comm                            mpi_communicator,
+             const std::map<std::string, std::string> &mpi_io_hints)
     : Group(name, mpi)
   {
     hdf5_reference = std::shared_ptr<hid_t>(new hid_t, [](hid_t *pointer) {
@@ -1431,12 +1618,32 @@ namespace HDF5
       {
 #  ifdef DEAL_II_WITH_MPI
 #    ifdef H5_HAVE_PARALLEL
-        const MPI_Info info = MPI_INFO_NULL;
+        MPI_Info info = MPI_INFO_NULL;
+        if (mpi_io_hints.size() > 0)
+          {
+            int ierr = MPI_Info_create(&info);
+            AssertThrowMPI(ierr);
+            for (const auto &hint : mpi_io_hints)
+              {
+                ierr =
+                  MPI_Info_set(info,
+                               DEAL_II_MPI_CONST_CAST(hint.first.c_str()),
+                               DEAL_II_MPI_CONST_CAST(hint.second.c_str()));
+                AssertThrowMPI(ierr);
+              }
+          }
 
         plist = H5Pcreate(H5P_FILE_ACCESS);
         Assert(plist >= 0, ExcMessage("Error at H5Pcreate"));
         ret = H5Pset_fapl_mpio(plist, mpi_communicator, info);
         Assert(ret >= 0, ExcMessage("Error at H5Pset_fapl_mpio"));
+
+        // the file access property list keeps its own copy of the hints
+        if (info != MPI_INFO_NULL)
+          {
+            const int ierr = MPI_Info_free(&info);
+            AssertThrowMPI(ierr);
+          }
 #    else
         AssertThrow(false, ExcMessage("HDF5 parallel support is disabled."));
 #    endif // H5_HAVE_PARALLEL
@@ -1474,6 +1681,7 @@ namespace HDF5
 
     (void)ret;
     (void)mpi_communicator;
+    (void)mpi_io_hints;
   }
 
 
@@ -1596,6 +1804,15 @@ namespace HDF5
   Group::create_dataset<unsigned int>(
     const std::string &         name,
     const std::vector<hsize_t> &dimensions) const;
+  template DataSet
+  Group::create_dataset<int>(const std::string &              name,
+                             const std::vector<hsize_t> &     dimensions,
+                             const DataSetCreationProperties &properties) const;
+  template DataSet
+  Group::create_dataset<unsigned int>(
+    const std::string &              name,
+    const std::vector<hsize_t> &     dimensions,
+    const DataSetCreationProperties &properties) const;
 
   template void
   Group::write_dataset<std::vector<int>>(const std::string &     name,
@@ -1605,6 +1822,21 @@ namespace HDF5
     const std::string &              name,
     const std::vector<unsigned int> &data) const;
 
+  template void
+  Group::write_distributed_dataset<int>(
+    const std::string &              name,
+    const std::vector<int> &         local_data,
+    const unsigned int               n_columns,
+    const MPI_Comm &                 mpi_communicator,
+    const DataSetCreationProperties &properties) const;
+  template void
+  Group::write_distributed_dataset<unsigned int>(
+    const std::string &              name,
+    const std::vector<unsigned int> &local_data,
+    const unsigned int               n_columns,
+    const MPI_Comm &                 mpi_communicator,
+    const DataSetCreationProperties &properties) const;
+
 #  endif // DOXYGEN
 
 } // namespace HDF5
@@ -133,6 +133,11 @@ IndexSet::do_compress() const
   // which itself calls the current function)
   std::lock_guard<std::mutex> lock(compress_mutex);
 
+  // another thread might have compressed the set while we were waiting for
+  // the lock, in which case there is nothing left to do
+  if (is_compressed == true)
+    return;
+
   // see if any of the contiguous ranges can be merged. do not use
   // std::vector::erase in-place as it is quadratic in the number of
   // ranges. since the ranges are sorted by their first index, determining
@@ -214,9 +219,11 @@ IndexSet IndexSet::operator&(const IndexSet &is) const
                    ((r2->begin <= r1->begin) && (r2->end > r1->begin)),
                  ExcInternalError());
 
-          // add the overlapping range to the result
-          result.add_range(std::max(r1->begin, r2->begin),
-                           std::min(r1->end, r2->end));
+          // add the overlapping range to the result. the ranges of both
+          // sets are sorted and disjoint, so the overlaps come in order and
+          // can simply be appended
+          result.ranges.emplace_back(std::max(r1->begin, r2->begin),
+                                     std::min(r1->end, r2->end));
 
           // now move that iterator that ends earlier one up. note that it has
           // to be this one because a subsequent range may still have a chance
@@ -228,6 +235,7 @@ IndexSet IndexSet::operator&(const IndexSet &is) const
         }
     }
 
+  result.is_compressed = false;
   result.compress();
   return result;
 }
@@ -268,68 +276,44 @@ IndexSet::subtract_set(const IndexSet &other)
 {
   compress();
   other.compress();
-  is_compressed = false;
 
-
-  // we save new ranges to be added to our IndexSet in an temporary vector and
-  // add all of them in one go at the end.
+  // both sets are sorted and compressed, so we can determine the remaining
+  // parts of our own ranges in a single pass over both lists of ranges,
+  // collecting them in a new vector rather than erasing and inserting
+  // ranges in place, which would take quadratic time
   std::vector<Range> new_ranges;
+  new_ranges.reserve(ranges.size());
 
-  std::vector<Range>::iterator own_it   = ranges.begin();
-  std::vector<Range>::iterator other_it = other.ranges.begin();
-
-  while (own_it != ranges.end() && other_it != other.ranges.end())
+  std::vector<Range>::const_iterator other_it = other.ranges.begin();
+  for (const Range &own_range : ranges)
     {
-      // advance own iterator until we get an overlap
-      if (own_it->end <= other_it->begin)
-        {
-          ++own_it;
-          continue;
-        }
-      // we are done with other_it, so advance
-      if (own_it->begin >= other_it->end)
-        {
-          ++other_it;
-          continue;
-        }
+      size_type begin = own_range.begin;
 
-      // Now own_it and other_it overlap.  First save the part of own_it that
-      // is before other_it (if not empty).
-      if (own_it->begin < other_it->begin)
-        {
-          Range r(own_it->begin, other_it->begin);
-          r.nth_index_in_set = 0; // fix warning of unused variable
-          new_ranges.push_back(r);
-        }
-      // change own_it to the sub range behind other_it. Do not delete own_it
-      // in any case. As removal would invalidate iterators, we just shrink
-      // the range to an empty one.
-      own_it->begin = other_it->end;
-      if (own_it->begin > own_it->end)
+      // skip the ranges of the other set that end before the current range
+      while (other_it != other.ranges.end() && other_it->end <= begin)
+        ++other_it;
+
+      while (other_it != other.ranges.end() && other_it->begin < own_range.end)
         {
-          own_it->begin = own_it->end;
-          ++own_it;
+          // save the part of the current range before the other range
+          if (other_it->begin > begin)
+            new_ranges.emplace_back(begin, other_it->begin);
+          begin = std::max(begin, other_it->end);
+
+          // the other range might also overlap with the next one of our own
+          // ranges, so do not advance past it in that case
+          if (other_it->end > own_range.end)
+            break;
+          ++other_it;
         }
 
-      // continue without advancing iterators, the right one will be advanced
-      // next.
+      if (begin < own_range.end)
+        new_ranges.emplace_back(begin, own_range.end);
     }
 
-  // Now delete all empty ranges we might
-  // have created.
-  for (std::vector<Range>::iterator it = ranges.begin(); it != ranges.end();)
-    {
-      if (it->begin >= it->end)
-        it = ranges.erase(it);
-      else
-        ++it;
-    }
-
-  // done, now add the temporary ranges
-  const std::vector<Range>::iterator end = new_ranges.end();
-  for (std::vector<Range>::iterator it = new_ranges.begin(); it != end; ++it)
-    add_range(it->begin, it->end);
+  ranges.swap(new_ranges);
 
+  is_compressed = false;
   compress();
 }
 
@@ -375,6 +359,47 @@ IndexSet::pop_front()
 
 
 
+void
+IndexSet::add_ranges_internal(std::vector<Range> &tmp_ranges,
+                              const bool          ranges_are_sorted)
+{
+  if (tmp_ranges.empty())
+    return;
+
+  if (ranges_are_sorted == false)
+    std::sort(tmp_ranges.begin(), tmp_ranges.end());
+
+  // the ranges are sorted by their first index, so the last one need not
+  // have the largest end if ranges overlap. check all of them
+#ifdef DEBUG
+  for (const Range &range : tmp_ranges)
+    Assert(range.end <= index_space_size,
+           ExcIndexRangeType<size_type>(range.end - 1, 0, index_space_size));
+#endif
+
+  // if the new ranges come after the present ones, we can simply append
+  // them; otherwise, merge the two sorted lists of ranges. overlapping
+  // ranges are joined by compress()
+  if (ranges.empty() || !(tmp_ranges.front() < ranges.back()))
+    ranges.insert(ranges.end(), tmp_ranges.begin(), tmp_ranges.end());
+  else
+    {
+      std::vector<Range> new_ranges;
+      new_ranges.reserve(ranges.size() + tmp_ranges.size());
+      std::merge(ranges.begin(),
+                 ranges.end(),
+                 tmp_ranges.begin(),
+                 tmp_ranges.end(),
+                 std::back_inserter(new_ranges));
+      ranges.swap(new_ranges);
+    }
+
+  is_compressed = false;
+  compress();
+}
+
+
+
 void
 IndexSet::add_indices(const IndexSet &other, const unsigned int offset)
 {
@@ -0,0 +1,169 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_report.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <set>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+MemoryReport::MemoryReport(const MPI_Comm &mpi_communicator)
+  : mpi_communicator(mpi_communicator)
+{}
+
+
+
+void
+MemoryReport::add(const std::string &name, const std::size_t memory)
+{
+  const auto position = entry_indices.find(name);
+  if (position != entry_indices.end())
+    entries[position->second].second += memory;
+  else
+    {
+      entry_indices.emplace(name, entries.size());
+      entries.emplace_back(name, memory);
+    }
+}
+
+
+
+void
+MemoryReport::sample_process_memory(const std::string &label)
+{
+  Utilities::System::MemoryStats stats;
+  stats.VmRSS = 0;
+  stats.VmHWM = 0;
+  Utilities::System::get_memory_stats(stats);
+
+  const std::string names[2] = {label + "/resident set size",
+                                label + "/peak resident set size"};
+  const unsigned long int values[2] = {stats.VmRSS, stats.VmHWM};
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      // the values are in kB; a new sample of the same label replaces the
+      // previous one rather than adding to it
+      const std::size_t memory = 1024 * static_cast<std::size_t>(values[i]);
+      const auto        position = entry_indices.find(names[i]);
+      if (position != entry_indices.end())
+        entries[position->second].second = memory;
+      else
+        {
+          entry_indices.emplace(names[i], entries.size());
+          entries.emplace_back(names[i], memory);
+          process_memory_entries.push_back(names[i]);
+        }
+    }
+}
+
+
+
+std::size_t
+MemoryReport::local_data_memory() const
+{
+  std::size_t memory = 0;
+  for (const auto &entry : entries)
+    if (std::find(process_memory_entries.begin(),
+                  process_memory_entries.end(),
+                  entry.first) == process_memory_entries.end())
+      memory += entry.second;
+  return memory;
+}
+
+
+
+std::vector<MemoryReport::Entry>
+MemoryReport::get_summary() const
+{
+  // collect the names of the entries of all processes such that all of them
+  // pass the same entries in the same order to Utilities::MPI::min_max_avg(),
+  // which is the order of the first appearance when going through the
+  // ranks
+  std::vector<std::string> local_names;
+  local_names.reserve(entries.size());
+  for (const auto &entry : entries)
+    local_names.push_back(entry.first);
+  const std::vector<std::vector<std::string>> all_names =
+    Utilities::MPI::all_gather(mpi_communicator, local_names);
+  const std::vector<std::vector<std::string>> all_process_names =
+    Utilities::MPI::all_gather(mpi_communicator, process_memory_entries);
+
+  std::vector<std::string> names;
+  std::set<std::string>    known_names;
+  for (const auto &names_on_rank : all_names)
+    for (const std::string &name : names_on_rank)
+      if (known_names.insert(name).second)
+        names.push_back(name);
+
+  std::set<std::string> process_names;
+  for (const auto &names_on_rank : all_process_names)
+    process_names.insert(names_on_rank.begin(), names_on_rank.end());
+
+  // reduce the memory of all entries and the total of the data structures,
+  // which comes last, with a single collective operation
+  std::vector<double> local_memory(names.size() + 1, 0.);
+  for (unsigned int i = 0; i < names.size(); ++i)
+    {
+      const auto position = entry_indices.find(names[i]);
+      if (position != entry_indices.end())
+        local_memory[i] = entries[position->second].second;
+    }
+  local_memory.back() = local_data_memory();
+  const std::vector<Utilities::MPI::MinMaxAvg> memory =
+    Utilities::MPI::min_max_avg(local_memory, mpi_communicator);
+
+  std::vector<Entry> summary;
+  summary.reserve(names.size() + 1);
+  for (unsigned int i = 0; i < names.size(); ++i)
+    {
+      Entry entry;
+      entry.name              = names[i];
+      entry.memory            = memory[i];
+      entry.is_process_memory = process_names.count(names[i]) > 0;
+      summary.push_back(entry);
+    }
+
+  // put the total of the data structures before the samples of the process
+  // memory
+  const auto first_process_entry =
+    std::stable_partition(summary.begin(),
+                          summary.end(),
+                          [](const Entry &entry) {
+                            return !entry.is_process_memory;
+                          });
+  Entry total;
+  total.name              = "Total data";
+  total.memory            = memory.back();
+  total.is_process_memory = false;
+  summary.insert(first_process_entry, total);
+
+  return summary;
+}
+
+
+
+void
+MemoryReport::clear()
+{
+  entries.clear();
+  entry_indices.clear();
+  process_memory_entries.clear();
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
@@ -25,6 +25,7 @@
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 #include <set>
@@ -392,35 +393,37 @@ namespace Utilities
                  int *       len,
                  MPI_Datatype *)
       {
-        (void)len;
         const MinMaxAvg *in_lhs    = static_cast<const MinMaxAvg *>(in_lhs_);
         MinMaxAvg *      inout_rhs = static_cast<MinMaxAvg *>(inout_rhs_);
 
-        Assert(*len == 1, ExcInternalError());
-
-        inout_rhs->sum += in_lhs->sum;
-        if (inout_rhs->min > in_lhs->min)
-          {
-            inout_rhs->min       = in_lhs->min;
-            inout_rhs->min_index = in_lhs->min_index;
-          }
-        else if (inout_rhs->min == in_lhs->min)
+        for (int i = 0; i < *len; ++i)
           {
-            // choose lower cpu index when tied to make operator commutative
-            if (inout_rhs->min_index > in_lhs->min_index)
-              inout_rhs->min_index = in_lhs->min_index;
-          }
+            inout_rhs[i].sum += in_lhs[i].sum;
+            if (inout_rhs[i].min > in_lhs[i].min)
+              {
+                inout_rhs[i].min       = in_lhs[i].min;
+                inout_rhs[i].min_index = in_lhs[i].min_index;
+              }
+            else if (inout_rhs[i].min == in_lhs[i].min)
+              {
+                // choose lower cpu index when tied to make operator
+                // commutative
+                if (inout_rhs[i].min_index > in_lhs[i].min_index)
+                  inout_rhs[i].min_index = in_lhs[i].min_index;
+              }
 
-        if (inout_rhs->max < in_lhs->max)
-          {
-            inout_rhs->max       = in_lhs->max;
-            inout_rhs->max_index = in_lhs->max_index;
-          }
-        else if (inout_rhs->max == in_lhs->max)
-          {
-            // choose lower cpu index when tied to make operator commutative
-            if (inout_rhs->max_index > in_lhs->max_index)
-              inout_rhs->max_index = in_lhs->max_index;
+            if (inout_rhs[i].max < in_lhs[i].max)
+              {
+                inout_rhs[i].max       = in_lhs[i].max;
+                inout_rhs[i].max_index = in_lhs[i].max_index;
+              }
+            else if (inout_rhs[i].max == in_lhs[i].max)
+              {
+                // choose lower cpu index when tied to make operator
+                // commutative
+                if (inout_rhs[i].max_index > in_lhs[i].max_index)
+                  inout_rhs[i].max_index = in_lhs[i].max_index;
+              }
           }
       }
     } // namespace
@@ -429,30 +432,47 @@ namespace Utilities
 
     MinMaxAvg
     min_max_avg(const double my_value, const MPI_Comm &mpi_communicator)
+    {
+      return min_max_avg(std::vector<double>(1, my_value),
+                         mpi_communicator)[0];
+    }
+
+
+
+    std::vector<MinMaxAvg>
+    min_max_avg(const std::vector<double> &my_values,
+                const MPI_Comm &           mpi_communicator)
     {
       // If MPI was not started, we have a serial computation and cannot run
       // the other MPI commands
       if (job_supports_mpi() == false)
         {
-          MinMaxAvg result;
-          result.sum       = my_value;
-          result.avg       = my_value;
-          result.min       = my_value;
-          result.max       = my_value;
-          result.min_index = 0;
-          result.max_index = 0;
-
-          return result;
+          std::vector<MinMaxAvg> results(my_values.size());
+          for (unsigned int i = 0; i < my_values.size(); ++i)
+            {
+              results[i].sum       = my_values[i];
+              results[i].avg       = my_values[i];
+              results[i].min       = my_values[i];
+              results[i].max       = my_values[i];
+              results[i].min_index = 0;
+              results[i].max_index = 0;
+            }
+
+          return results;
         }
 
       // To avoid uninitialized values on some MPI implementations, provide
       // result with a default value already...
-      MinMaxAvg result = {0.,
-                          std::numeric_limits<double>::max(),
-                          -std::numeric_limits<double>::max(),
-                          0,
-                          0,
-                          0.};
+      const MinMaxAvg initial = {0.,
+                                 std::numeric_limits<double>::max(),
+                                 -std::numeric_limits<double>::max(),
+                                 0,
+                                 0,
+                                 0.};
+
+      std::vector<MinMaxAvg> results(my_values.size(), initial);
+      if (my_values.empty())
+        return results;
 
       const unsigned int my_id =
         dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
@@ -466,21 +486,39 @@ namespace Utilities
                       &op);
       AssertThrowMPI(ierr);
 
-      MinMaxAvg in;
-      in.sum = in.min = in.max = my_value;
-      in.min_index = in.max_index = my_id;
+      std::vector<MinMaxAvg> in(my_values.size());
+      for (unsigned int i = 0; i < my_values.size(); ++i)
+        {
+          in[i].sum = in[i].min = in[i].max = my_values[i];
+          in[i].min_index = in[i].max_index = my_id;
+        }
 
       MPI_Datatype type;
       int          lengths[]       = {3, 2};
       MPI_Aint     displacements[] = {0, offsetof(MinMaxAvg, min_index)};
       MPI_Datatype types[]         = {MPI_DOUBLE, MPI_INT};
 
-      ierr = MPI_Type_create_struct(2, lengths, displacements, types, &type);
+      MPI_Datatype struct_type;
+      ierr =
+        MPI_Type_create_struct(2, lengths, displacements, types, &struct_type);
+      AssertThrowMPI(ierr);
+
+      // the data type does not cover the 'avg' field at the end of the
+      // struct, so set its extent to the size of the struct such that
+      // consecutive elements of an array are found
+      ierr = MPI_Type_create_resized(struct_type, 0, sizeof(MinMaxAvg), &type);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Type_free(&struct_type);
       AssertThrowMPI(ierr);
 
       ierr = MPI_Type_commit(&type);
       AssertThrowMPI(ierr);
-      ierr = MPI_Allreduce(&in, &result, 1, type, op, mpi_communicator);
+      ierr = MPI_Allreduce(in.data(),
+                           results.data(),
+                           static_cast<int>(my_values.size()),
+                           type,
+                           op,
+                           mpi_communicator);
       AssertThrowMPI(ierr);
 
       ierr = MPI_Type_free(&type);
@@ -489,9 +527,10 @@ namespace Utilities
       ierr = MPI_Op_free(&op);
       AssertThrowMPI(ierr);
 
-      result.avg = result.sum / numproc;
+      for (auto &result : results)
+        result.avg = result.sum / numproc;
 
-      return result;
+      return results;
     }
 
 #else
@@ -542,7 +581,193 @@ namespace Utilities
       return result;
     }
 
+
+
+    std::vector<MinMaxAvg>
+    min_max_avg(const std::vector<double> &my_values, const MPI_Comm &)
+    {
+      std::vector<MinMaxAvg> results(my_values.size());
+      for (unsigned int i = 0; i < my_values.size(); ++i)
+        {
+          results[i].sum       = my_values[i];
+          results[i].avg       = my_values[i];
+          results[i].min       = my_values[i];
+          results[i].max       = my_values[i];
+          results[i].min_index = 0;
+          results[i].max_index = 0;
+        }
+
+      return results;
+    }
+
+#endif
+
+
+
+    ReductionAggregator::ReductionAggregator(const MPI_Comm &mpi_communicator)
+      : mpi_communicator(mpi_communicator)
+      , reduction_is_active(false)
+    {}
+
+
+
+    ReductionAggregator::~ReductionAggregator()
+    {
+#ifdef DEAL_II_WITH_MPI
+      // do not leave the requests of a started reduction dangling, but
+      // ignore the results
+      if (reduction_is_active)
+        MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+#endif
+    }
+
+
+
+    void
+    ReductionAggregator::add_sum(const double value, double &result)
+    {
+      Assert(reduction_is_active == false,
+             ExcMessage("Values can not be added while a reduction is "
+                        "running. Call reduce_finish() first."));
+      sum_values.push_back(value);
+      sum_results.push_back(&result);
+    }
+
+
+
+    void
+    ReductionAggregator::add_max(const double value, double &result)
+    {
+      Assert(reduction_is_active == false,
+             ExcMessage("Values can not be added while a reduction is "
+                        "running. Call reduce_finish() first."));
+      max_values.push_back(value);
+      max_results.push_back(&result);
+      max_value_is_negated.push_back(false);
+    }
+
+
+
+    void
+    ReductionAggregator::add_min(const double value, double &result)
+    {
+      Assert(reduction_is_active == false,
+             ExcMessage("Values can not be added while a reduction is "
+                        "running. Call reduce_finish() first."));
+      max_values.push_back(-value);
+      max_results.push_back(&result);
+      max_value_is_negated.push_back(true);
+    }
+
+
+
+    void
+    ReductionAggregator::add_sum(const ArrayView<const double> &values,
+                                 const ArrayView<double> &      results)
+    {
+      AssertDimension(values.size(), results.size());
+      for (unsigned int i = 0; i < values.size(); ++i)
+        add_sum(values[i], results[i]);
+    }
+
+
+
+    void
+    ReductionAggregator::add_max(const ArrayView<const double> &values,
+                                 const ArrayView<double> &      results)
+    {
+      AssertDimension(values.size(), results.size());
+      for (unsigned int i = 0; i < values.size(); ++i)
+        add_max(values[i], results[i]);
+    }
+
+
+
+    void
+    ReductionAggregator::add_min(const ArrayView<const double> &values,
+                                 const ArrayView<double> &      results)
+    {
+      AssertDimension(values.size(), results.size());
+      for (unsigned int i = 0; i < values.size(); ++i)
+        add_min(values[i], results[i]);
+    }
+
+
+
+    void
+    ReductionAggregator::reduce_start()
+    {
+      Assert(reduction_is_active == false,
+             ExcMessage("reduce_start() has already been called."));
+      reduction_is_active = true;
+
+#ifdef DEAL_II_WITH_MPI
+      requests[0] = MPI_REQUEST_NULL;
+      requests[1] = MPI_REQUEST_NULL;
+      if (job_supports_mpi() == false || n_mpi_processes(mpi_communicator) == 1)
+        return;
+
+      std::vector<double> *const values[2] = {&sum_values, &max_values};
+      const MPI_Op               ops[2]    = {MPI_SUM, MPI_MAX};
+      for (unsigned int i = 0; i < 2; ++i)
+        if (values[i]->size() > 0)
+          {
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+            const int ierr = MPI_Iallreduce(MPI_IN_PLACE,
+                                            values[i]->data(),
+                                            values[i]->size(),
+                                            MPI_DOUBLE,
+                                            ops[i],
+                                            mpi_communicator,
+                                            &requests[i]);
+#  else
+            const int ierr = MPI_Allreduce(MPI_IN_PLACE,
+                                           values[i]->data(),
+                                           values[i]->size(),
+                                           MPI_DOUBLE,
+                                           ops[i],
+                                           mpi_communicator);
+#  endif
+            AssertThrowMPI(ierr);
+          }
+#endif
+    }
+
+
+
+    void
+    ReductionAggregator::reduce_finish()
+    {
+      Assert(reduction_is_active,
+             ExcMessage("reduce_start() needs to be called first."));
+
+#ifdef DEAL_II_WITH_MPI
+      const int ierr = MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
 #endif
+      reduction_is_active = false;
+
+      for (unsigned int i = 0; i < sum_values.size(); ++i)
+        *sum_results[i] = sum_values[i];
+      for (unsigned int i = 0; i < max_values.size(); ++i)
+        *max_results[i] =
+          (max_value_is_negated[i] ? -max_values[i] : max_values[i]);
+
+      sum_values.clear();
+      sum_results.clear();
+      max_values.clear();
+      max_results.clear();
+      max_value_is_negated.clear();
+    }
+
+
+
+    void
+    ReductionAggregator::reduce()
+    {
+      reduce_start();
+      reduce_finish();
+    }
 
 
 
@@ -1401,6 +1626,17 @@ namespace Utilities
 
     namespace ComputeIndexOwner
     {
+      /**
+       * The dictionary that stores the owner of each index. The index space
+       * is statically partitioned into contiguous blocks of equal size, and
+       * each process stores the owners of the indices in its block. Since
+       * all data are exchanged in terms of ranges of indices, the cost of
+       * setting up and querying the dictionary is proportional to the number
+       * of contiguous ranges of the owned and the requested index sets
+       * rather than to the number of indices, such that also index sets
+       * that are not contiguous on the owning processes (e.g., after a
+       * renumbering of the degrees of freedom) are handled efficiently.
+       */
       struct Dictionary
       {
         static const unsigned int tag_setup = 11;
@@ -1420,83 +1656,59 @@ namespace Utilities
 #ifdef DEAL_II_WITH_MPI
           unsigned int my_rank = this_mpi_process(comm);
 
-          types::global_dof_index              dic_local_rececived = 0;
-          std::map<unsigned int, unsigned int> relevant_procs_map;
-
-          // 2) collect relevant processes and process local dict entries
-          {
-            std::vector<unsigned int> relevant_procs;
-            for (auto i : owned_indices)
-              {
-                unsigned int other_rank = this->dof_to_dict_rank(i);
-                if (other_rank == my_rank)
-                  {
-                    this->actually_owning_ranks[i - this->local_range.first] =
-                      my_rank;
-                    dic_local_rececived++;
-                  }
-                else if (relevant_procs.empty() ||
-                         relevant_procs.back() != other_rank)
-                  relevant_procs.push_back(other_rank);
-              }
-
+          types::global_dof_index dic_local_rececived = 0;
+
+          // 2) split the owned ranges at the boundaries of the dictionary
+          // partition, process local dict entries and collect the ranges to
+          // be sent to each of the other dictionary processes
+          std::map<unsigned int,
+                   std::vector<std::pair<types::global_dof_index,
+                                         types::global_dof_index>>>
+            buffers;
+          for (auto interval = owned_indices.begin_intervals();
+               interval != owned_indices.end_intervals();
+               ++interval)
             {
-              unsigned int c = 0;
-              for (auto i : relevant_procs)
-                relevant_procs_map[i] = c++;
+              types::global_dof_index       begin = *interval->begin();
+              const types::global_dof_index end   = interval->last() + 1;
+              while (begin < end)
+                {
+                  const unsigned int other_rank =
+                    this->dof_to_dict_rank(begin);
+                  const types::global_dof_index range_end =
+                    std::min(this->dict_range_end(other_rank), end);
+
+                  if (other_rank == my_rank)
+                    {
+                      std::fill(this->actually_owning_ranks.begin() +
+                                  (begin - this->local_range.first),
+                                this->actually_owning_ranks.begin() +
+                                  (range_end - this->local_range.first),
+                                my_rank);
+                      dic_local_rececived += range_end - begin;
+                    }
+                  else
+                    buffers[other_rank].emplace_back(begin, range_end);
+
+                  begin = range_end;
+                }
             }
-          }
-
-          const unsigned int n_relevant_procs = relevant_procs_map.size();
-          std::vector<std::vector<
-            std::pair<types::global_dof_index, types::global_dof_index>>>
-                                   buffers(n_relevant_procs);
-          std::vector<MPI_Request> request(n_relevant_procs);
 
           // 3) send messages with local dofs to the right dict process
-          {
-            std::vector<std::vector<types::global_dof_index>> temp(
-              n_relevant_procs);
-
-            // collect dofs of each dict process
-            for (auto i : owned_indices)
-              {
-                unsigned int other_rank = this->dof_to_dict_rank(i);
-                if (other_rank != my_rank)
-                  temp[relevant_procs_map[other_rank]].push_back(i);
-              }
-
-            // send dofs to each process
-            for (auto rank_pair : relevant_procs_map)
-              {
-                const int rank  = rank_pair.first;
-                const int index = rank_pair.second;
-
-                // create index set and compress data to be sent
-                auto &   indices_i = temp[index];
-                IndexSet is(this->size);
-                is.add_indices(indices_i.begin(), indices_i.end());
-                is.compress();
-
-                // translate index set to a list of pairs
-                auto &buffer = buffers[index];
-                for (auto interval = is.begin_intervals();
-                     interval != is.end_intervals();
-                     interval++)
-                  buffer.emplace_back(*interval->begin(), interval->last() + 1);
-
-                // send data
-                const auto ierr = MPI_Isend(buffer.data(),
-                                            buffer.size() * 2,
-                                            DEAL_II_DOF_INDEX_MPI_TYPE,
-                                            rank,
-                                            tag_setup,
-                                            comm,
-                                            &request[index]);
-                AssertThrowMPI(ierr);
-              }
-          }
-
+          std::vector<MPI_Request> request;
+          request.reserve(buffers.size());
+          for (auto &buffer : buffers)
+            {
+              request.emplace_back();
+              const auto ierr = MPI_Isend(buffer.second.data(),
+                                          buffer.second.size() * 2,
+                                          DEAL_II_DOF_INDEX_MPI_TYPE,
+                                          buffer.first,
+                                          tag_setup,
+                                          comm,
+                                          &request.back());
+              AssertThrowMPI(ierr);
+            }
 
           // 4) receive messages until all dofs in dict are processed
           while (this->local_size != dic_local_rececived)
@@ -1531,19 +1743,25 @@ namespace Utilities
 
               // process message: loop over all intervals
               for (auto interval : buffer)
-                for (types::global_dof_index i = interval.first;
-                     i < interval.second;
-                     i++)
-                  {
-                    this->actually_owning_ranks[i - this->local_range.first] =
-                      other_rank;
-                    dic_local_rececived++;
-                  }
+                {
+                  Assert(interval.first >= this->local_range.first &&
+                           interval.second <= this->local_range.second,
+                         ExcInternalError());
+                  std::fill(this->actually_owning_ranks.begin() +
+                              (interval.first - this->local_range.first),
+                            this->actually_owning_ranks.begin() +
+                              (interval.second - this->local_range.first),
+                            other_rank);
+                  dic_local_rececived += interval.second - interval.first;
+                }
+              Assert(dic_local_rececived <= this->local_size,
+                     ExcMessage("The index sets given as owned indices "
+                                "overlap between processes."));
             }
 
           // 5) make sure that all messages have been sent
           const auto ierr =
-            MPI_Waitall(n_relevant_procs, request.data(), MPI_STATUSES_IGNORE);
+            MPI_Waitall(request.size(), request.data(), MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
 #else
           (void)owned_indices;
@@ -1552,11 +1770,21 @@ namespace Utilities
         }
 
         unsigned int
-        dof_to_dict_rank(const types::global_dof_index i)
+        dof_to_dict_rank(const types::global_dof_index i) const
         {
           return i / dofs_per_process;
         }
 
+        /**
+         * Return the first index past the block of the dictionary stored on
+         * process @p rank.
+         */
+        types::global_dof_index
+        dict_range_end(const unsigned int rank) const
+        {
+          return std::min(dofs_per_process * (rank + 1), size);
+        }
+
       private:
         void
         partition(const IndexSet &owned_indices, const MPI_Comm &comm)
@@ -1607,7 +1835,18 @@ namespace Utilities
 
         Dictionary dict;
 
-        std::map<unsigned int, std::vector<types::global_dof_index>> temp;
+        /**
+         * The ranges of indices requested from each dictionary process.
+         */
+        std::map<unsigned int,
+                 std::vector<std::pair<types::global_dof_index,
+                                       types::global_dof_index>>>
+          requested_ranges;
+
+        /**
+         * For each range in requested_ranges, the position of its first
+         * index within indices_to_look_up.
+         */
         std::map<unsigned int, std::vector<unsigned int>> recv_indices;
 
         virtual void
@@ -1618,56 +1857,61 @@ namespace Utilities
           (void)other_rank;
           Assert(buffer_recv.size() % 2 == 0, ExcInternalError());
           for (unsigned int j = 0; j < buffer_recv.size(); j += 2)
-            for (auto i = buffer_recv[j]; i < buffer_recv[j + 1]; i++)
-              request_buffer.push_back(
-                dict.actually_owning_ranks[i - dict.local_range.first]);
+            {
+              Assert(buffer_recv[j] >= dict.local_range.first &&
+                       buffer_recv[j + 1] <= dict.local_range.second,
+                     ExcInternalError());
+              request_buffer.insert(
+                request_buffer.end(),
+                dict.actually_owning_ranks.begin() +
+                  (buffer_recv[j] - dict.local_range.first),
+                dict.actually_owning_ranks.begin() +
+                  (buffer_recv[j + 1] - dict.local_range.first));
+            }
         }
 
         virtual std::vector<unsigned int>
         compute_targets() override
         {
-          std::vector<unsigned int> targets;
-
-          // 1) collect relevant processes and process local dict entries
-          {
-            unsigned int index = 0;
-            for (auto i : indices_to_look_up)
-              {
-                unsigned int other_rank = dict.dof_to_dict_rank(i);
-                if (other_rank == my_rank)
-                  owning_ranks[index] =
-                    dict.actually_owning_ranks[i - dict.local_range.first];
-                else if (targets.empty() || targets.back() != other_rank)
-                  targets.push_back(other_rank);
-                index++;
-              }
-          }
-
-
-          for (auto i : targets)
+          // 1) split the requested ranges at the boundaries of the dictionary
+          // partition, process local dict entries and collect the ranges to
+          // be requested from each of the other dictionary processes
+          unsigned int index = 0;
+          for (auto interval = indices_to_look_up.begin_intervals();
+               interval != indices_to_look_up.end_intervals();
+               ++interval)
             {
-              recv_indices[i] = {};
-              temp[i]         = {};
+              types::global_dof_index       begin = *interval->begin();
+              const types::global_dof_index end   = interval->last() + 1;
+              while (begin < end)
+                {
+                  const unsigned int other_rank = dict.dof_to_dict_rank(begin);
+                  const types::global_dof_index range_end =
+                    std::min(dict.dict_range_end(other_rank), end);
+
+                  if (other_rank == my_rank)
+                    std::copy(dict.actually_owning_ranks.begin() +
+                                (begin - dict.local_range.first),
+                              dict.actually_owning_ranks.begin() +
+                                (range_end - dict.local_range.first),
+                              owning_ranks.begin() + index);
+                  else
+                    {
+                      requested_ranges[other_rank].emplace_back(begin,
+                                                                range_end);
+                      recv_indices[other_rank].push_back(index);
+                    }
+
+                  index += range_end - begin;
+                  begin = range_end;
+                }
             }
 
-          // 3) collect indices for each process
-          {
-            unsigned int index = 0;
-            for (auto i : indices_to_look_up)
-              {
-                unsigned int other_rank = dict.dof_to_dict_rank(i);
-                if (other_rank != my_rank)
-                  {
-                    recv_indices[other_rank].push_back(index);
-                    temp[other_rank].push_back(i);
-                  }
-                index++;
-              }
-          }
-
-          Assert(targets.size() == recv_indices.size() &&
-                   targets.size() == temp.size(),
-                 ExcMessage("Size does not match!"));
+          // 2) the targets are the keys of the map, i.e., sorted by rank
+          std::vector<unsigned int> targets;
+          targets.reserve(requested_ranges.size());
+          for (const auto &ranges : requested_ranges)
+            targets.push_back(ranges.first);
 
           return targets;
         }
@@ -1677,18 +1921,12 @@ namespace Utilities
           const int                             other_rank,
           std::vector<types::global_dof_index> &send_buffer) override
         {
-          // create index set and compress data to be sent
-          auto &   indices_i = temp[other_rank];
-          IndexSet is(dict.size);
-          is.add_indices(indices_i.begin(), indices_i.end());
-          is.compress();
-
-          for (auto interval = is.begin_intervals();
-               interval != is.end_intervals();
-               interval++)
+          const auto &ranges = requested_ranges[other_rank];
+          send_buffer.reserve(2 * ranges.size());
+          for (const auto &range : ranges)
             {
-              send_buffer.push_back(*interval->begin());
-              send_buffer.push_back(interval->last() + 1);
+              send_buffer.push_back(range.first);
+              send_buffer.push_back(range.second);
             }
         }
 
@@ -1696,7 +1934,10 @@ namespace Utilities
         prepare_recv_buffer(const int                  other_rank,
                             std::vector<unsigned int> &recv_buffer) override
         {
-          recv_buffer.resize(recv_indices[other_rank].size());
+          types::global_dof_index n_indices = 0;
+          for (const auto &range : requested_ranges[other_rank])
+            n_indices += range.second - range.first;
+          recv_buffer.resize(n_indices);
         }
 
         virtual void
@@ -1704,11 +1945,23 @@ namespace Utilities
           const int                        other_rank,
           const std::vector<unsigned int> &recv_buffer) override
         {
-          Assert(recv_indices[other_rank].size() == recv_buffer.size(),
-                 ExcMessage("Sizes do not match!"));
+          const auto &ranges    = requested_ranges[other_rank];
+          const auto &positions = recv_indices[other_rank];
+          AssertDimension(ranges.size(), positions.size());
 
-          for (unsigned int j = 0; j < recv_indices[other_rank].size(); j++)
-            owning_ranks[recv_indices[other_rank][j]] = recv_buffer[j];
+          auto source = recv_buffer.begin();
+          for (unsigned int j = 0; j < ranges.size(); ++j)
+            {
+              const auto n_indices = ranges[j].second - ranges[j].first;
+              Assert(source + n_indices <= recv_buffer.end(),
+                     ExcMessage("Sizes do not match!"));
+              std::copy(source,
+                        source + n_indices,
+                        owning_ranks.begin() + positions[j]);
+              source += n_indices;
+            }
+          Assert(source == recv_buffer.end(),
+                 ExcMessage("Sizes do not match!"));
         }
       };
 
@@ -0,0 +1,215 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    template <int dim, int spacedim>
+    RemotePointEvaluation<dim, spacedim>::RemotePointEvaluation()
+      : communicator(MPI_COMM_SELF)
+      , unique_mapping(false)
+      , all_points_found_flag(false)
+      , ready_flag(false)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::reinit(
+      const std::vector<Point<spacedim>> &points,
+      const Triangulation<dim, spacedim> &tria,
+      const Mapping<dim, spacedim> &      mapping)
+    {
+      this->tria    = &tria;
+      this->mapping = &mapping;
+
+      const GridTools::Cache<dim, spacedim> cache(tria, mapping);
+
+      // the cells with points, the reference coordinates of the points in
+      // these cells, the index of each point on the process that asked for
+      // it, and the rank of this process
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                             cells;
+      std::vector<std::vector<Point<dim>>>   reference_points;
+      std::vector<std::vector<unsigned int>> point_indices;
+      std::vector<std::vector<unsigned int>> owners;
+
+      bool is_distributed = false;
+#ifdef DEAL_II_WITH_MPI
+      if (const auto parallel_tria =
+            dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+              &tria))
+        {
+          is_distributed = true;
+          communicator   = parallel_tria->get_communicator();
+
+          const auto global_bounding_boxes =
+            GridTools::exchange_local_bounding_boxes(
+              GridTools::compute_mesh_predicate_bounding_box(
+                tria, IteratorFilters::LocallyOwnedCell()),
+              communicator);
+
+          auto point_locations =
+            GridTools::distributed_compute_point_locations(
+              cache, points, global_bounding_boxes);
+          cells            = std::move(std::get<0>(point_locations));
+          reference_points = std::move(std::get<1>(point_locations));
+          point_indices    = std::move(std::get<2>(point_locations));
+          owners           = std::move(std::get<4>(point_locations));
+        }
+#endif
+
+      if (is_distributed == false)
+        {
+          communicator = MPI_COMM_SELF;
+
+          auto point_locations =
+            GridTools::compute_point_locations_try_all(cache, points);
+          cells            = std::move(std::get<0>(point_locations));
+          reference_points = std::move(std::get<1>(point_locations));
+          point_indices    = std::move(std::get<2>(point_locations));
+          owners.resize(cells.size());
+          for (unsigned int i = 0; i < cells.size(); ++i)
+            owners[i].assign(point_indices[i].size(), 0U);
+        }
+
+      const unsigned int my_rank = this_mpi_process(communicator);
+
+      // collect the points cell by cell, which is the order in which they
+      // get evaluated
+      cell_data = CellData();
+      cell_data.reference_point_ptrs.push_back(0);
+      std::vector<std::pair<unsigned int, unsigned int>> owner_and_index;
+      for (unsigned int i = 0; i < cells.size(); ++i)
+        {
+          cell_data.cells.emplace_back(cells[i]->level(), cells[i]->index());
+          for (unsigned int j = 0; j < reference_points[i].size(); ++j)
+            {
+              cell_data.reference_point_values.push_back(
+                reference_points[i][j]);
+              owner_and_index.emplace_back(owners[i][j], point_indices[i][j]);
+            }
+          cell_data.reference_point_ptrs.push_back(
+            cell_data.reference_point_values.size());
+        }
+
+      // sort the evaluated values by the rank they need to be sent to,
+      // keeping the order within each rank
+      std::vector<unsigned int> send_order(owner_and_index.size());
+      std::iota(send_order.begin(), send_order.end(), 0U);
+      std::stable_sort(send_order.begin(),
+                       send_order.end(),
+                       [&](const unsigned int a, const unsigned int b) {
+                         return owner_and_index[a].first <
+                                owner_and_index[b].first;
+                       });
+
+      send_permutation.resize(send_order.size());
+      send_ranks.clear();
+      send_ptrs.assign(1, 0U);
+      std::map<unsigned int, std::vector<unsigned int>> indices_to_send;
+      for (unsigned int k = 0; k < send_order.size(); ++k)
+        {
+          const auto &entry = owner_and_index[send_order[k]];
+
+          send_permutation[send_order[k]] = k;
+          if (send_ranks.empty() || send_ranks.back() != entry.first)
+            {
+              send_ranks.push_back(entry.first);
+              send_ptrs.push_back(k);
+            }
+          send_ptrs.back() = k + 1;
+          indices_to_send[entry.first].push_back(entry.second);
+        }
+
+      // tell the processes that asked for the points about the order in
+      // which they will receive the values. This is the only exchange that
+      // needs to determine the communication pattern
+      std::map<unsigned int, std::vector<unsigned int>> received_indices;
+      const auto own_indices = indices_to_send.find(my_rank);
+      if (own_indices != indices_to_send.end())
+        {
+          received_indices[my_rank] = std::move(own_indices->second);
+          indices_to_send.erase(own_indices);
+        }
+      const auto remote_indices =
+        Utilities::MPI::some_to_some(communicator, indices_to_send);
+      received_indices.insert(remote_indices.begin(), remote_indices.end());
+
+      std::vector<unsigned int> n_values_per_point(points.size(), 0U);
+      recv_ranks.clear();
+      recv_ptrs.assign(1, 0U);
+      for (const auto &rank_and_indices : received_indices)
+        {
+          recv_ranks.push_back(rank_and_indices.first);
+          recv_ptrs.push_back(recv_ptrs.back() +
+                              rank_and_indices.second.size());
+          for (const unsigned int index : rank_and_indices.second)
+            {
+              AssertIndexRange(index, points.size());
+              ++n_values_per_point[index];
+            }
+        }
+
+      point_ptrs.assign(points.size() + 1, 0U);
+      for (unsigned int i = 0; i < points.size(); ++i)
+        point_ptrs[i + 1] = point_ptrs[i] + n_values_per_point[i];
+
+      recv_permutation.resize(recv_ptrs.back());
+      std::fill(n_values_per_point.begin(), n_values_per_point.end(), 0U);
+      unsigned int k = 0;
+      for (const auto &rank_and_indices : received_indices)
+        for (const unsigned int index : rank_and_indices.second)
+          recv_permutation[k++] =
+            point_ptrs[index] + n_values_per_point[index]++;
+
+      bool locally_unique = true, locally_all_found = true;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        {
+          const unsigned int n_values = point_ptrs[i + 1] - point_ptrs[i];
+          locally_unique &= (n_values == 1);
+          locally_all_found &= (n_values > 0);
+        }
+      unique_mapping =
+        Utilities::MPI::min(locally_unique ? 1U : 0U, communicator) == 1U;
+      all_points_found_flag =
+        Utilities::MPI::min(locally_all_found ? 1U : 0U, communicator) == 1U;
+
+      ready_flag = true;
+    }
+
+  } // end of namespace MPI
+} // end of namespace Utilities
+
+#include "mpi_remote_point_evaluation.inst"
+
+DEAL_II_NAMESPACE_CLOSE
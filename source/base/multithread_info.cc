@@ -31,6 +31,14 @@
 #  include <deal.II/base/thread_management.h>
 
 #  include <tbb/task_scheduler_init.h>
+#  include <tbb/task_scheduler_observer.h>
+
+#  ifdef __linux__
+#    include <sched.h>
+
+#    include <atomic>
+#    include <vector>
+#  endif
 #endif
 
 DEAL_II_NAMESPACE_OPEN
@@ -173,6 +181,68 @@ MultithreadInfo::n_threads()
 }
 
 
+#  ifdef __linux__
+namespace
+{
+  /**
+   * An observer of the TBB scheduler that pins every thread that joins the
+   * scheduler to one of the cores of the affinity mask of the process, in
+   * the order in which the threads arrive.
+   */
+  class ThreadPinningObserver : public tbb::task_scheduler_observer
+  {
+  public:
+    ThreadPinningObserver()
+      : next_core(0)
+    {
+      cpu_set_t process_mask;
+      CPU_ZERO(&process_mask);
+      if (sched_getaffinity(0, sizeof(process_mask), &process_mask) == 0)
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+          if (CPU_ISSET(cpu, &process_mask))
+            cores.push_back(cpu);
+    }
+
+    virtual void
+    on_scheduler_entry(bool) override
+    {
+      if (cores.empty())
+        return;
+
+      cpu_set_t thread_mask;
+      CPU_ZERO(&thread_mask);
+      CPU_SET(cores[next_core++ % cores.size()], &thread_mask);
+
+      // on Linux, a process id of zero denotes the calling thread. Pinning
+      // is only an optimization, so failures are silently ignored
+      sched_setaffinity(0, sizeof(thread_mask), &thread_mask);
+    }
+
+  private:
+    /**
+     * The cores the process is allowed to run on.
+     */
+    std::vector<int> cores;
+
+    /**
+     * The index within @p cores of the core for the next thread.
+     */
+    std::atomic<unsigned int> next_core;
+  };
+} // namespace
+#  endif
+
+
+void
+MultithreadInfo::pin_threads()
+{
+#  ifdef __linux__
+  static ThreadPinningObserver observer;
+  observer.observe(true);
+#  endif
+}
+
+
 #else // not in MT mode
 
 unsigned int
@@ -197,6 +267,10 @@ void
 MultithreadInfo::set_thread_limit(const unsigned int)
 {}
 
+void
+MultithreadInfo::pin_threads()
+{}
+
 #endif
 
 
@@ -33,6 +33,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , use_neighborhood_collectives(false)
+      , use_persistent_requests(false)
     {}
 
 
@@ -49,6 +51,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , use_neighborhood_collectives(false)
+      , use_persistent_requests(false)
     {
       locally_owned_range_data.add_range(0, size);
       locally_owned_range_data.compress();
@@ -69,6 +73,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , use_neighborhood_collectives(false)
+      , use_persistent_requests(false)
     {
       set_owned_indices(locally_owned_indices);
       set_ghost_indices(ghost_indices_in);
@@ -87,6 +93,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , use_neighborhood_collectives(false)
+      , use_persistent_requests(false)
     {
       set_owned_indices(locally_owned_indices);
     }
@@ -120,6 +128,10 @@ namespace Utilities
           n_procs = 1;
         }
 
+#ifdef DEAL_II_WITH_MPI
+      persistent_requests.reset();
+#endif
+
       // set the local range
       Assert(locally_owned_indices.is_contiguous() == true,
              ExcMessage("The index set specified in locally_owned_indices "
@@ -164,6 +176,9 @@ namespace Utilities
         ghost_indices_data.set_size(locally_owned_range_data.size());
       ghost_indices_data.subtract_set(locally_owned_range_data);
       ghost_indices_data.compress();
+#ifdef DEAL_II_WITH_MPI
+      persistent_requests.reset();
+#endif
       AssertThrow(
         ghost_indices_data.n_elements() <
           static_cast<types::global_dof_index>(
@@ -189,6 +204,7 @@ namespace Utilities
           Assert(ghost_indices_data.n_elements() == 0, ExcInternalError());
           Assert(n_import_indices_data == 0, ExcInternalError());
           Assert(n_ghost_indices_data == 0, ExcInternalError());
+          setup_neighborhood_communicator();
           return;
         }
 
@@ -474,6 +490,183 @@ namespace Utilities
             }
           ghost_indices_subset_data = ghost_indices_subset;
         }
+
+      setup_neighborhood_communicator();
+    }
+
+
+
+    void
+    Partitioner::enable_neighborhood_collectives(const bool enable)
+    {
+      use_neighborhood_collectives = enable;
+      setup_neighborhood_communicator();
+    }
+
+
+
+    void
+    Partitioner::enable_persistent_requests(const bool enable)
+    {
+      use_persistent_requests = enable;
+#ifdef DEAL_II_WITH_MPI
+      persistent_requests.reset();
+#endif
+    }
+
+
+
+#ifdef DEAL_II_WITH_MPI
+    const std::vector<MPI_Request> *
+    Partitioner::get_persistent_requests(
+      const bool         export_to_ghosts,
+      const unsigned int communication_channel,
+      const unsigned int bytes_per_entry,
+      void *             ghost_array,
+      void *             import_array) const
+    {
+      // the number of array pairs for which requests are kept, in order not
+      // to accumulate requests for the arrays of temporary vectors
+      const std::size_t max_n_array_pairs = 32;
+
+      if (use_persistent_requests == false || n_procs < 2)
+        return nullptr;
+
+      using RequestMap =
+        std::remove_reference<decltype(*persistent_requests)>::type;
+      if (persistent_requests == nullptr)
+        persistent_requests.reset(new RequestMap(), [](RequestMap *requests) {
+            int finalized = 0;
+            MPI_Finalized(&finalized);
+            if (finalized == 0)
+              for (auto &entry : *requests)
+                for (MPI_Request &request : entry.second)
+                  MPI_Request_free(&request);
+            delete requests;
+          });
+
+      const auto key = std::make_tuple(export_to_ghosts,
+                                       communication_channel,
+                                       bytes_per_entry,
+                                       static_cast<const void *>(ghost_array),
+                                       static_cast<const void *>(import_array));
+      const auto existing = persistent_requests->find(key);
+      if (existing != persistent_requests->end())
+        return &existing->second;
+      if (persistent_requests->size() >= max_n_array_pairs)
+        return nullptr;
+
+      std::vector<MPI_Request> &requests = (*persistent_requests)[key];
+      requests.resize(import_targets_data.size() + ghost_targets_data.size());
+
+      // the receives come first, followed by the sends. the tags are the
+      // ones of the regular messages, with the channel of the reverse
+      // direction shifted as in import_from_ghosted_array_start()
+      const std::vector<std::pair<unsigned int, unsigned int>>
+        &receive_targets =
+          export_to_ghosts ? ghost_targets_data : import_targets_data;
+      const std::vector<std::pair<unsigned int, unsigned int>> &send_targets =
+        export_to_ghosts ? import_targets_data : ghost_targets_data;
+      char *receive_ptr =
+        static_cast<char *>(export_to_ghosts ? ghost_array : import_array);
+      char *send_ptr =
+        static_cast<char *>(export_to_ghosts ? import_array : ghost_array);
+      const unsigned int channel =
+        export_to_ghosts ? communication_channel : communication_channel + 401;
+
+      for (unsigned int i = 0; i < receive_targets.size(); ++i)
+        {
+          const int ierr =
+            MPI_Recv_init(receive_ptr,
+                          receive_targets[i].second * bytes_per_entry,
+                          MPI_BYTE,
+                          receive_targets[i].first,
+                          receive_targets[i].first + channel,
+                          communicator,
+                          &requests[i]);
+          AssertThrowMPI(ierr);
+          receive_ptr += receive_targets[i].second * bytes_per_entry;
+        }
+      for (unsigned int i = 0; i < send_targets.size(); ++i)
+        {
+          const int ierr =
+            MPI_Send_init(send_ptr,
+                          send_targets[i].second * bytes_per_entry,
+                          MPI_BYTE,
+                          send_targets[i].first,
+                          my_pid + channel,
+                          communicator,
+                          &requests[receive_targets.size() + i]);
+          AssertThrowMPI(ierr);
+          send_ptr += send_targets[i].second * bytes_per_entry;
+        }
+
+      return &requests;
+    }
+#endif
+
+
+
+    void
+    Partitioner::setup_neighborhood_communicator()
+    {
+      neighborhood_communicator.reset();
+      neighborhood_ghost_counts.clear();
+      neighborhood_ghost_displacements.clear();
+      neighborhood_import_counts.clear();
+      neighborhood_import_displacements.clear();
+
+#ifdef DEAL_II_WITH_MPI
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+      if (use_neighborhood_collectives == false || n_procs < 2)
+        return;
+
+      // the ghost targets send data to us, and we send to the import
+      // targets. the order of the neighbors defines the order of the data in
+      // the ghost and import arrays
+      std::vector<int> sources;
+      int              offset = 0;
+      for (const auto &target : ghost_targets_data)
+        {
+          sources.push_back(target.first);
+          neighborhood_ghost_counts.push_back(target.second);
+          neighborhood_ghost_displacements.push_back(offset);
+          offset += target.second;
+        }
+
+      std::vector<int> destinations;
+      offset = 0;
+      for (const auto &target : import_targets_data)
+        {
+          destinations.push_back(target.first);
+          neighborhood_import_counts.push_back(target.second);
+          neighborhood_import_displacements.push_back(offset);
+          offset += target.second;
+        }
+
+      MPI_Comm  graph_communicator;
+      const int ierr = MPI_Dist_graph_create_adjacent(communicator,
+                                                      sources.size(),
+                                                      sources.data(),
+                                                      MPI_UNWEIGHTED,
+                                                      destinations.size(),
+                                                      destinations.data(),
+                                                      MPI_UNWEIGHTED,
+                                                      MPI_INFO_NULL,
+                                                      /*reorder=*/0,
+                                                      &graph_communicator);
+      AssertThrowMPI(ierr);
+
+      neighborhood_communicator.reset(new MPI_Comm(graph_communicator),
+                                      [](MPI_Comm *comm) {
+                                        int finalized = 0;
+                                        MPI_Finalized(&finalized);
+                                        if (finalized == 0)
+                                          MPI_Comm_free(comm);
+                                        delete comm;
+                                      });
+#  endif
+#endif
     }
 
 
@@ -530,6 +723,13 @@ namespace Utilities
       memory +=
         MemoryConsumption::memory_consumption(ghost_indices_subset_data);
       memory += MemoryConsumption::memory_consumption(ghost_indices_data);
+      memory +=
+        MemoryConsumption::memory_consumption(neighborhood_ghost_counts) +
+        MemoryConsumption::memory_consumption(
+          neighborhood_ghost_displacements) +
+        MemoryConsumption::memory_consumption(neighborhood_import_counts) +
+        MemoryConsumption::memory_consumption(
+          neighborhood_import_displacements);
       return memory;
     }
 
@@ -18,6 +18,10 @@
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/table.h>
 
+#include <boost/container/small_vector.hpp>
+
+#include <array>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -252,19 +256,26 @@ PolynomialSpace<dim>::evaluate(
       v_size                 = 5;
     }
 
+  if (v_size == 0)
+    return;
+
   // Store data in a single
   // object. Access is by
   // v[d][n][o]
   //  d: coordinate direction
   //  n: number of 1d polynomial
   //  o: order of derivative
-  Table<2, std::vector<double>> v(dim, n_1d);
-  for (unsigned int d = 0; d < v.size()[0]; ++d)
-    for (unsigned int i = 0; i < v.size()[1]; ++i)
-      {
-        v(d, i).resize(v_size, 0.);
-        polynomials[i].value(p(d), v(d, i));
-      }
+  //
+  // use storage on the stack for the usual number of polynomials, as this
+  // function is called for every single point
+  std::array<boost::container::small_vector<std::array<double, 5>, 20>, dim>
+    v;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      v[d].resize(n_1d);
+      for (unsigned int i = 0; i < n_1d; ++i)
+        polynomials[i].value(p(d), v_size - 1, v[d][i].data());
+    }
 
   if (update_values)
     {
@@ -25,7 +25,9 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+#if !defined(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR) || defined(DEBUG)
 static const char *unknown_subscriber = "unknown subscriber";
+#endif
 
 
 std::mutex Subscriptor::mutex;
@@ -35,16 +37,20 @@ Subscriptor::Subscriptor(Subscriptor &&subscriptor) noexcept
   : counter(0)
   , object_info(subscriptor.object_info)
 {
+#if !defined(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR) || defined(DEBUG)
   for (const auto validity_ptr : subscriptor.validity_pointers)
     *validity_ptr = false;
+#endif
 }
 
 
 
 Subscriptor::~Subscriptor()
 {
+#if !defined(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR) || defined(DEBUG)
   for (const auto validity_ptr : validity_pointers)
     *validity_ptr = false;
+#endif
   object_info = nullptr;
 }
 
@@ -118,8 +124,10 @@ Subscriptor::check_no_subscribers() const noexcept
 Subscriptor &
 Subscriptor::operator=(Subscriptor &&s) noexcept
 {
+#if !defined(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR) || defined(DEBUG)
   for (const auto validity_ptr : s.validity_pointers)
     *validity_ptr = false;
+#endif
   object_info = s.object_info;
   return *this;
 }
@@ -130,6 +138,12 @@ void
 Subscriptor::subscribe(std::atomic<bool> *const validity,
                        const std::string &      id) const
 {
+#if defined(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR) && !defined(DEBUG)
+  // only count the subscription, which does not need the mutex
+  (void)id;
+  ++counter;
+  *validity = true;
+#else
   std::lock_guard<std::mutex> lock(mutex);
 
   if (object_info == nullptr)
@@ -142,6 +156,7 @@ Subscriptor::subscribe(std::atomic<bool> *const validity,
 
   *validity = true;
   validity_pointers.push_back(validity);
+#endif
 }
 
 
@@ -150,6 +165,11 @@ void
 Subscriptor::unsubscribe(std::atomic<bool> *const validity,
                          const std::string &      id) const
 {
+#if defined(DEAL_II_LIGHTWEIGHT_SUBSCRIPTOR) && !defined(DEBUG)
+  (void)validity;
+  (void)id;
+  --counter;
+#else
   const std::string &name = id.empty() ? unknown_subscriber : id;
 
   if (counter == 0)
@@ -190,6 +210,7 @@ Subscriptor::unsubscribe(std::atomic<bool> *const validity,
   validity_pointers.erase(validity_ptr_it);
   --counter;
   --it->second;
+#endif
 }
 
 
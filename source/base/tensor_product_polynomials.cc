@@ -13,12 +13,15 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/vectorization.h>
 
 #include <boost/container/small_vector.hpp>
 
+#include <algorithm>
 #include <array>
 
 DEAL_II_NAMESPACE_OPEN
@@ -405,6 +408,96 @@ TensorProductPolynomials<dim, PolynomialType>::evaluate(
 
 
 
+template <int dim, typename PolynomialType>
+void
+TensorProductPolynomials<dim, PolynomialType>::evaluate(
+  const ArrayView<const Point<dim>> &unit_points,
+  Table<2, double> &                 values,
+  Table<2, Tensor<1, dim>> &         grads) const
+{
+  Assert(dim <= 3, ExcNotImplemented());
+  const unsigned int n_points = unit_points.size();
+  Assert(values.size()[0] == 0 ||
+           (values.size()[0] == n_tensor_pols && values.size()[1] == n_points),
+         ExcMessage("The table of values must either be empty or have n() "
+                    "rows and as many columns as there are points."));
+  Assert(grads.size()[0] == 0 ||
+           (grads.size()[0] == n_tensor_pols && grads.size()[1] == n_points),
+         ExcMessage("The table of gradients must either be empty or have n() "
+                    "rows and as many columns as there are points."));
+
+  const bool update_values = (values.size()[0] == n_tensor_pols),
+             update_grads  = (grads.size()[0] == n_tensor_pols);
+  if (update_values == false && update_grads == false)
+    return;
+
+  // Compute the values (and derivatives, if necessary) of all 1D polynomials
+  // for a batch of points, with the points in the lanes of the vectorized
+  // arrays, and then perform the multiplications for the tensor product for
+  // all points of the batch at once
+  constexpr unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+
+  const unsigned int n_polynomials = polynomials.size();
+  AlignedVector<std::array<std::array<VectorizedArray<double>, 2>, dim>>
+    values_1d(n_polynomials);
+
+  for (unsigned int q0 = 0; q0 < n_points; q0 += n_lanes)
+    {
+      const unsigned int n_filled = std::min(n_points - q0, n_lanes);
+      for (unsigned int i = 0; i < n_polynomials; ++i)
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            values_1d[i][d][0] = 0.;
+            values_1d[i][d][1] = 0.;
+            for (unsigned int v = 0; v < n_filled; ++v)
+              if (update_grads)
+                {
+                  double value_and_derivative[2];
+                  polynomials[i].value(unit_points[q0 + v](d),
+                                       1,
+                                       value_and_derivative);
+                  values_1d[i][d][0][v] = value_and_derivative[0];
+                  values_1d[i][d][1][v] = value_and_derivative[1];
+                }
+              else
+                values_1d[i][d][0][v] =
+                  polynomials[i].value(unit_points[q0 + v](d));
+          }
+
+      unsigned int indices[3];
+      unsigned int ind = 0;
+      for (indices[2] = 0; indices[2] < (dim > 2 ? n_polynomials : 1);
+           ++indices[2])
+        for (indices[1] = 0; indices[1] < (dim > 1 ? n_polynomials : 1);
+             ++indices[1])
+          for (indices[0] = 0; indices[0] < n_polynomials; ++indices[0], ++ind)
+            {
+              const unsigned int i = index_map_inverse[ind];
+
+              if (update_values)
+                {
+                  VectorizedArray<double> value = values_1d[indices[0]][0][0];
+                  for (unsigned int x = 1; x < dim; ++x)
+                    value *= values_1d[indices[x]][x][0];
+                  for (unsigned int v = 0; v < n_filled; ++v)
+                    values(i, q0 + v) = value[v];
+                }
+
+              if (update_grads)
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    VectorizedArray<double> grad = 1.;
+                    for (unsigned int x = 0; x < dim; ++x)
+                      grad *= values_1d[indices[x]][x][(d == x) ? 1 : 0];
+                    for (unsigned int v = 0; v < n_filled; ++v)
+                      grads(i, q0 + v)[d] = grad[v];
+                  }
+            }
+    }
+}
+
+
+
 /* ------------------- AnisotropicPolynomials -------------- */
 
 
@@ -20,8 +20,11 @@
 #include <deal.II/base/timer.h>
 #include <deal.II/base/utilities.h>
 
+#include <boost/serialization/string.hpp>
+
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -891,4 +894,163 @@ TimerOutput::Scope::~Scope()
 }
 
 
+
+RegionProfiler::ThreadData::ThreadData()
+  : nodes(1,
+          Node{numbers::invalid_unsigned_int,
+               {},
+               0,
+               std::chrono::steady_clock::duration::zero()})
+{}
+
+
+
+RegionProfiler::Region
+RegionProfiler::register_region(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  const auto existing = region_handles.find(name);
+  if (existing != region_handles.end())
+    return existing->second;
+
+  const Region region = region_names.size();
+  region_names.push_back(name);
+  region_handles.emplace(name, region);
+  return region;
+}
+
+
+
+std::string
+RegionProfiler::get_region_name(const Region region) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  AssertIndexRange(region, region_names.size());
+  return region_names[region];
+}
+
+
+
+void
+RegionProfiler::set_hooks(const std::function<void(const Region)> &enter_hook,
+                          const std::function<void(const Region)> &leave_hook)
+{
+  this->enter_hook = enter_hook;
+  this->leave_hook = leave_hook;
+}
+
+
+
+void
+RegionProfiler::print_summary(std::ostream &  out,
+                              const MPI_Comm &mpi_communicator) const
+{
+  // Merge the trees of all threads. Regions are identified by the names
+  // along the path from the root of the tree, since the handles of the
+  // regions might differ between processes.
+  std::map<std::vector<std::string>, std::pair<unsigned long int, double>>
+    regions;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<std::string>                                  path;
+    std::function<void(const ThreadData &, const unsigned int)> add_node =
+      [&](const ThreadData &data, const unsigned int node) {
+        for (const unsigned int child : data.nodes[node].children)
+          {
+            const Node &child_node = data.nodes[child];
+            path.push_back(region_names[child_node.region]);
+
+            auto &entry = regions[path];
+            entry.first += child_node.n_calls;
+            entry.second +=
+              std::chrono::duration<double>(child_node.time).count();
+
+            add_node(data, child);
+            path.pop_back();
+          }
+      };
+
+#ifdef DEAL_II_WITH_THREADS
+    for (const ThreadData &data : thread_data.get_implementation())
+      add_node(data, 0);
+#else
+    add_node(thread_data.get_implementation(), 0);
+#endif
+  }
+
+  // make sure that all processes know about all regions
+  if (Utilities::MPI::n_mpi_processes(mpi_communicator) > 1)
+    {
+      std::vector<std::vector<std::string>> my_paths;
+      my_paths.reserve(regions.size());
+      for (const auto &region : regions)
+        my_paths.push_back(region.first);
+
+      const std::vector<std::vector<std::vector<std::string>>> all_paths =
+        Utilities::MPI::all_gather(mpi_communicator, my_paths);
+      for (const auto &paths : all_paths)
+        for (const auto &path : paths)
+          regions.emplace(path, std::make_pair(0ul, 0.));
+    }
+
+  const bool is_first_process =
+    (Utilities::MPI::this_mpi_process(mpi_communicator) == 0);
+
+  // get the maximum width among all regions including their indentation
+  unsigned int max_width = 6;
+  for (const auto &region : regions)
+    max_width =
+      std::max(max_width,
+               static_cast<unsigned int>(2 * (region.first.size() - 1) +
+                                         region.first.back().length()));
+  max_width += 2;
+
+  const std::istream::fmtflags old_flags     = out.flags();
+  const std::streamsize        old_precision = out.precision();
+
+  if (is_first_process)
+    out << std::endl
+        << std::left << std::setw(max_width) << "Region" << std::right
+        << std::setw(12) << "no. calls" << std::setw(12) << "min [s]"
+        << std::setw(8) << "@rank" << std::setw(12) << "avg [s]"
+        << std::setw(12) << "max [s]" << std::setw(8) << "@rank"
+        << std::endl;
+
+  for (const auto &region : regions)
+    {
+      // all processes take part in the reductions, in the same order
+      const unsigned long int n_calls =
+        Utilities::MPI::sum(region.second.first, mpi_communicator);
+      const Utilities::MPI::MinMaxAvg time =
+        Utilities::MPI::min_max_avg(region.second.second, mpi_communicator);
+
+      if (is_first_process)
+        out << std::left << std::setw(max_width)
+            << std::string(2 * (region.first.size() - 1), ' ') +
+                 region.first.back()
+            << std::right << std::setw(12) << n_calls << std::fixed
+            << std::setprecision(3) << std::setw(12) << time.min
+            << std::setw(8) << time.min_index << std::setw(12) << time.avg
+            << std::setw(12) << time.max << std::setw(8) << time.max_index
+            << std::endl;
+    }
+
+  if (is_first_process)
+    out << std::endl;
+
+  out.precision(old_precision);
+  out.flags(old_flags);
+}
+
+
+
+void
+RegionProfiler::reset()
+{
+  thread_data.clear();
+}
+
+
 DEAL_II_NAMESPACE_CLOSE
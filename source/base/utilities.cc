@@ -53,6 +53,10 @@
 #  include <cstdlib>
 #endif
 
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
 
 #ifdef DEAL_II_WITH_TRILINOS
 #  ifdef DEAL_II_WITH_MPI
@@ -1047,6 +1051,28 @@ namespace Utilities
 
       AssertThrow(ierr == 0, ExcOutOfMemory());
       AssertThrow(*memptr != nullptr, ExcOutOfMemory());
+
+#  if defined(__linux__) && defined(MADV_HUGEPAGE)
+      // for large blocks, ask the kernel to back the part of the block
+      // covering whole huge pages by transparent huge pages, which reduces
+      // the number of TLB misses in memory-bound loops. this is only a hint
+      // that takes effect if transparent huge pages are enabled in the
+      // 'madvise' or 'always' mode, so we ignore the return value
+      const std::size_t huge_page_size = 2 * 1024 * 1024;
+      if (size >= 4 * huge_page_size)
+        {
+          const std::size_t begin = reinterpret_cast<std::size_t>(*memptr);
+          const std::size_t end   = begin + size;
+          const std::size_t huge_page_begin =
+            (begin + huge_page_size - 1) / huge_page_size * huge_page_size;
+          const std::size_t huge_page_end =
+            end / huge_page_size * huge_page_size;
+          if (huge_page_end > huge_page_begin)
+            madvise(reinterpret_cast<void *>(huge_page_begin),
+                    huge_page_end - huge_page_begin,
+                    MADV_HUGEPAGE);
+        }
+#  endif
 #else
       // Windows does not appear to have posix_memalign. just use the
       // regular malloc in that case
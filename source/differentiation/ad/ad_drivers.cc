@@ -35,11 +35,13 @@
 DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
 #    include <adolc/adolc_fatalerror.h>
 #    include <adolc/drivers/drivers.h>
+#    include <adolc/interfaces.h>
 #    include <adolc/taping.h>
 DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
 #  endif // DEAL_II_WITH_ADOLC
 
+#  include <algorithm>
 #  include <vector>
 
 
@@ -229,6 +231,19 @@ namespace Differentiation
     }
 
 
+    template <typename ADNumberType, typename ScalarType, typename T>
+    void
+    TapedDrivers<ADNumberType, ScalarType, T>::value_gradient_and_hessian(
+      const typename Types<ADNumberType>::tape_index,
+      const std::vector<ScalarType> &,
+      ScalarType &,
+      Vector<ScalarType> &,
+      FullMatrix<ScalarType> &) const
+    {
+      AssertThrow(false, ExcRequiresADNumberSpecialization());
+    }
+
+
     template <typename ADNumberType, typename ScalarType, typename T>
     void
     TapedDrivers<ADNumberType, ScalarType, T>::values(
@@ -775,6 +790,116 @@ namespace Differentiation
     }
 
 
+    template <typename ADNumberType>
+    void
+    TapedDrivers<
+      ADNumberType,
+      double,
+      typename std::enable_if<ADNumberTraits<ADNumberType>::type_code ==
+                              NumberTypes::adolc_taped>::type>::
+      value_gradient_and_hessian(
+        const typename Types<ADNumberType>::tape_index active_tape_index,
+        const std::vector<scalar_type> &               independent_variables,
+        scalar_type &                                  value,
+        Vector<scalar_type> &                          gradient,
+        FullMatrix<scalar_type> &                      hessian) const
+    {
+      Assert(AD::ADNumberTraits<ADNumberType>::n_supported_derivative_levels >=
+               2,
+             ExcSupportedDerivativeLevels(
+               AD::ADNumberTraits<ADNumberType>::n_supported_derivative_levels,
+               2));
+      Assert(gradient.size() == independent_variables.size(),
+             ExcDimensionMismatch(gradient.size(),
+                                  independent_variables.size()));
+      Assert(hessian.m() == independent_variables.size(),
+             ExcDimensionMismatch(hessian.m(), independent_variables.size()));
+      Assert(hessian.n() == independent_variables.size(),
+             ExcDimensionMismatch(hessian.n(), independent_variables.size()));
+      Assert(is_registered_tape(active_tape_index),
+             ExcMessage("This tape has not yet been recorded."));
+
+      const unsigned int n_independent_variables = independent_variables.size();
+
+      // This is what ADOL-C's ::hess_mat() driver (which ::hessian() is
+      // built on) does: A first-order forward sweep in vector mode, with the
+      // unit vectors as the tangent directions, is followed by one
+      // second-order adjoint sweep. The latter not only yields the Hessian,
+      // but the gradient as well, and the value comes with the forward
+      // sweep. We only have to keep the results of the sweeps rather than
+      // recomputing them in separate calls. The tangents X, the Taylor
+      // coefficients Y of the dependent variable and the adjoints Z are
+      // all stored in flat arrays that the pointer arrays index into.
+      std::vector<scalar_type>    X_data(n_independent_variables *
+                                         n_independent_variables);
+      std::vector<scalar_type *>  X_rows(n_independent_variables *
+                                         n_independent_variables);
+      std::vector<scalar_type **> X(n_independent_variables);
+      for (unsigned int i = 0; i < n_independent_variables; ++i)
+        {
+          X[i] = &X_rows[i * n_independent_variables];
+          for (unsigned int j = 0; j < n_independent_variables; ++j)
+            {
+              X_data[i * n_independent_variables + j] = (i == j ? 1.0 : 0.0);
+              X[i][j] = &X_data[i * n_independent_variables + j];
+            }
+        }
+
+      std::vector<scalar_type>   Y_data(n_independent_variables);
+      std::vector<scalar_type *> Y_rows(n_independent_variables);
+      for (unsigned int j = 0; j < n_independent_variables; ++j)
+        Y_rows[j] = &Y_data[j];
+      scalar_type **Y = Y_rows.data();
+
+      std::vector<scalar_type>    Z_data(n_independent_variables *
+                                         n_independent_variables * 2);
+      std::vector<scalar_type *>  Z_rows(n_independent_variables *
+                                         n_independent_variables);
+      std::vector<scalar_type **> Z(n_independent_variables);
+      for (unsigned int i = 0; i < n_independent_variables; ++i)
+        {
+          Z[i] = &Z_rows[i * n_independent_variables];
+          for (unsigned int j = 0; j < n_independent_variables; ++j)
+            Z[i][j] = &Z_data[(i * n_independent_variables + j) * 2];
+        }
+
+      scalar_type  U_data[2] = {1.0, 0.0};
+      scalar_type *U_rows[1] = {U_data};
+
+      scalar_type *x = const_cast<scalar_type *>(independent_variables.data());
+
+      status[active_tape_index] =
+        ::hov_wk_forward(active_tape_index,
+                         1, // Only one dependent variable
+                         n_independent_variables,
+                         1, // Degree of the Taylor expansion
+                         2, // Keep the data for the second order adjoints
+                         n_independent_variables, // Number of directions
+                         x,
+                         X.data(),
+                         &value,
+                         &Y);
+      status[active_tape_index] =
+        std::min(status[active_tape_index],
+                 ::hos_ov_reverse(active_tape_index,
+                                  1, // Only one dependent variable
+                                  n_independent_variables,
+                                  1, // Degree of the Taylor expansion
+                                  n_independent_variables,
+                                  U_rows,
+                                  Z.data()));
+
+      // Z[i][j][0] holds the adjoint of the independent variable j, i.e.,
+      // the gradient, independent of the direction i, and Z[i][j][1] the
+      // second derivative with respect to the variables i and j.
+      for (unsigned int j = 0; j < n_independent_variables; ++j)
+        gradient[j] = Z[0][j][0];
+      for (unsigned int i = 0; i < n_independent_variables; ++i)
+        for (unsigned int j = 0; j < n_independent_variables; ++j)
+          hessian[i][j] = Z[i][j][1];
+    }
+
+
     template <typename ADNumberType>
     void
     TapedDrivers<
@@ -1096,6 +1221,23 @@ namespace Differentiation
     }
 
 
+    template <typename ADNumberType>
+    void
+    TapedDrivers<
+      ADNumberType,
+      double,
+      typename std::enable_if<ADNumberTraits<ADNumberType>::type_code ==
+                              NumberTypes::adolc_taped>::type>::
+      value_gradient_and_hessian(const typename Types<ADNumberType>::tape_index,
+                                 const std::vector<scalar_type> &,
+                                 scalar_type &,
+                                 Vector<scalar_type> &,
+                                 FullMatrix<scalar_type> &) const
+    {
+      AssertThrow(false, ExcRequiresADOLC());
+    }
+
+
     template <typename ADNumberType>
     void
     TapedDrivers<
@@ -1418,6 +1560,37 @@ namespace Differentiation
     }
 
 
+    template <typename ADNumberType>
+    void
+    TapedDrivers<
+      ADNumberType,
+      float,
+      typename std::enable_if<ADNumberTraits<ADNumberType>::type_code ==
+                              NumberTypes::adolc_taped>::type>::
+      value_gradient_and_hessian(
+        const typename Types<ADNumberType>::tape_index active_tape_index,
+        const std::vector<scalar_type> &               independent_variables,
+        scalar_type &                                  value,
+        Vector<scalar_type> &                          gradient,
+        FullMatrix<scalar_type> &                      hessian) const
+    {
+      double             value_double = 0.0;
+      Vector<double>     gradient_double(gradient.size());
+      FullMatrix<double> hessian_double(hessian.m(), hessian.n());
+      // ADOL-C only supports 'double', not 'float', so we can forward to
+      // the 'double' implementation of this function
+      taped_driver.value_gradient_and_hessian(
+        active_tape_index,
+        vector_float_to_double(independent_variables),
+        value_double,
+        gradient_double,
+        hessian_double);
+      value    = value_double;
+      gradient = gradient_double;
+      hessian  = hessian_double;
+    }
+
+
     template <typename ADNumberType>
     void
     TapedDrivers<
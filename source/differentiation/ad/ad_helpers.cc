@@ -1569,6 +1569,109 @@ namespace Differentiation
 
 
 
+    template <int                  dim,
+              enum AD::NumberTypes ADNumberTypeCode,
+              typename ScalarType>
+    void
+    ScalarFunction<dim, ADNumberTypeCode, ScalarType>::
+      compute_value_gradient_and_hessian(
+        scalar_type &            value,
+        Vector<scalar_type> &    gradient,
+        FullMatrix<scalar_type> &hessian) const
+    {
+      if (ADNumberTraits<ad_type>::is_tapeless == true)
+        {
+          // A tapeless number type computes all derivatives together with
+          // the value, so there is nothing to gain by combining the
+          // separate functions.
+          value = compute_value();
+          compute_gradient(gradient);
+          compute_hessian(hessian);
+          return;
+        }
+
+      Assert(AD::ADNumberTraits<ad_type>::n_supported_derivative_levels >= 2,
+             ExcMessage(
+               "Cannot compute function Hessian: AD number type does "
+               "not support the calculation of second order derivatives."));
+
+      if (this->taped_driver.keep_independent_values() == false)
+        {
+          Assert(
+            this->n_registered_independent_variables() ==
+              this->n_independent_variables(),
+            ExcMessage(
+              "Not all values of sensitivities have been registered or subsequently set!"));
+        }
+      Assert(this->n_registered_dependent_variables() ==
+               this->n_dependent_variables(),
+             ExcMessage("Not all dependent variables have been registered."));
+
+      Assert(
+        this->n_dependent_variables() == 1,
+        ExcMessage(
+          "The ScalarFunction class expects there to be only one dependent variable."));
+
+      Assert(this->active_tape_index() != Numbers<ad_type>::invalid_tape_index,
+             ExcMessage("Invalid tape index"));
+      Assert(this->is_recording() == false,
+             ExcMessage(
+               "Cannot compute Hessian while tape is being recorded."));
+      Assert(this->independent_variable_values.size() ==
+               this->n_independent_variables(),
+             ExcDimensionMismatch(this->independent_variable_values.size(),
+                                  this->n_independent_variables()));
+
+      // We can neglect correctly initializing the entries as
+      // we'll be overwriting them immediately in the succeeding call to
+      // Drivers::value_gradient_and_hessian().
+      if (gradient.size() != this->n_independent_variables())
+        gradient.reinit(this->n_independent_variables(),
+                        true /*omit_zeroing_entries*/);
+      if (hessian.m() != this->n_independent_variables() ||
+          hessian.n() != this->n_independent_variables())
+        hessian.reinit({this->n_independent_variables(),
+                        this->n_independent_variables()},
+                       true /*omit_default_initialization*/);
+
+      this->taped_driver.value_gradient_and_hessian(
+        this->active_tape_index(),
+        this->independent_variable_values,
+        value,
+        gradient,
+        hessian);
+
+      // Account for symmetries of tensor components, in the same way as
+      // compute_gradient() and compute_hessian() do
+      for (unsigned int i = 0; i < this->n_independent_variables(); i++)
+        {
+          if (this->is_symmetric_independent_variable(i) == true)
+            gradient[i] *= 0.5;
+        }
+      for (unsigned int i = 0; i < this->n_independent_variables(); i++)
+        for (unsigned int j = 0; j < i + 1; j++)
+          {
+            if (this->is_symmetric_independent_variable(i) == true &&
+                this->is_symmetric_independent_variable(j) == true)
+              {
+                hessian[i][j] *= 0.25;
+                if (i != j)
+                  hessian[j][i] *= 0.25;
+              }
+            else if ((this->is_symmetric_independent_variable(i) == true &&
+                      this->is_symmetric_independent_variable(j) == false) ||
+                     (this->is_symmetric_independent_variable(j) == true &&
+                      this->is_symmetric_independent_variable(i) == false))
+              {
+                hessian[i][j] *= 0.5;
+                if (i != j)
+                  hessian[j][i] *= 0.5;
+              }
+          }
+    }
+
+
+
     template <int                  dim,
               enum AD::NumberTypes ADNumberTypeCode,
               typename ScalarType>
@@ -0,0 +1,168 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_SYMENGINE
+
+#  include <deal.II/differentiation/sd/symengine_batch_evaluator.h>
+#  include <deal.II/differentiation/sd/symengine_utilities.h>
+
+#  include <symengine/lambda_double.h>
+#  ifdef DEAL_II_SYMENGINE_WITH_LLVM
+#    include <symengine/llvm_double.h>
+#  endif
+
+#  include <memory>
+#  include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Differentiation
+{
+  namespace SD
+  {
+    namespace SE = ::SymEngine;
+
+
+    BatchEvaluator::BatchEvaluator()
+      : n_independent(0)
+      , n_dependent(0)
+    {}
+
+
+
+    BatchEvaluator::BatchEvaluator(
+      const types::symbol_vector &independent_variables,
+      const types::symbol_vector &dependent_functions,
+      const Backend               backend)
+      : BatchEvaluator()
+    {
+      initialize(independent_variables, dependent_functions, backend);
+    }
+
+
+
+    void
+    BatchEvaluator::initialize(
+      const types::symbol_vector &independent_variables,
+      const types::symbol_vector &dependent_functions,
+      const Backend               backend)
+    {
+      Assert(independent_variables.size() > 0,
+             ExcMessage("There must be at least one independent variable."));
+      Assert(dependent_functions.size() > 0,
+             ExcMessage("There must be at least one dependent function."));
+
+      n_independent = independent_variables.size();
+      n_dependent   = dependent_functions.size();
+
+      const SE::vec_basic symbols =
+        Utilities::convert_expression_vector_to_basic_vector(
+          independent_variables);
+      const SE::vec_basic functions =
+        Utilities::convert_expression_vector_to_basic_vector(
+          dependent_functions);
+
+      // The visitors that implement the generated functions are kept alive
+      // through a shared pointer that is owned by the std::function object,
+      // which keeps this class copyable
+      if (backend == Backend::lambda)
+        {
+          const auto visitor = std::make_shared<SE::LambdaRealDoubleVisitor>();
+          visitor->init(symbols, functions);
+          compiled_function = [visitor](double *outputs, const double *inputs) {
+            visitor->call(outputs, inputs);
+          };
+        }
+      else
+        {
+          Assert(backend == Backend::llvm, ExcNotImplemented());
+#  ifdef DEAL_II_SYMENGINE_WITH_LLVM
+          const auto visitor = std::make_shared<SE::LLVMDoubleVisitor>();
+          visitor->init(symbols, functions);
+          compiled_function = [visitor](double *outputs, const double *inputs) {
+            visitor->call(outputs, inputs);
+          };
+#  else
+          AssertThrow(false, ExcLLVMNotAvailable());
+#  endif
+        }
+    }
+
+
+
+    void
+    BatchEvaluator::evaluate(const ArrayView<const double> &values,
+                             const ArrayView<double> &      results) const
+    {
+      Assert(is_initialized(), ExcNotInitialized());
+      Assert(values.size() % n_independent == 0,
+             ExcMessage("The number of values must be a multiple of the "
+                        "number of independent variables."));
+      const std::size_t n_points = values.size() / n_independent;
+      AssertDimension(results.size(), n_points * n_dependent);
+
+      for (std::size_t q = 0; q < n_points; ++q)
+        compiled_function(results.data() + q * n_dependent,
+                          values.data() + q * n_independent);
+    }
+
+
+
+    void
+    BatchEvaluator::evaluate(
+      const ArrayView<const VectorizedArray<double>> &values,
+      const ArrayView<VectorizedArray<double>> &      results) const
+    {
+      constexpr unsigned int n_lanes =
+        VectorizedArray<double>::n_array_elements;
+
+      Assert(is_initialized(), ExcNotInitialized());
+      Assert(values.size() % n_independent == 0,
+             ExcMessage("The number of values must be a multiple of the "
+                        "number of independent variables."));
+      const std::size_t n_batches = values.size() / n_independent;
+      AssertDimension(results.size(), n_batches * n_dependent);
+
+      // The generated function expects the values of one point to be stored
+      // contiguously, so the lanes have to be gathered into (and the results
+      // scattered from) temporary arrays
+      std::vector<double> point_values(n_independent);
+      std::vector<double> point_results(n_dependent);
+      for (std::size_t b = 0; b < n_batches; ++b)
+        {
+          const VectorizedArray<double> *batch_values =
+            values.data() + b * n_independent;
+          VectorizedArray<double> *batch_results =
+            results.data() + b * n_dependent;
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              for (unsigned int i = 0; i < n_independent; ++i)
+                point_values[i] = batch_values[i][v];
+              compiled_function(point_results.data(), point_values.data());
+              for (unsigned int i = 0; i < n_dependent; ++i)
+                batch_results[i][v] = point_results[i];
+            }
+        }
+    }
+
+  } // namespace SD
+} // namespace Differentiation
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SYMENGINE
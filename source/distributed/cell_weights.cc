@@ -14,15 +14,46 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/mpi.h>
+
 #include <deal.II/distributed/cell_weights.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 
 DEAL_II_NAMESPACE_OPEN
 
 namespace parallel
 {
+  namespace
+  {
+    /**
+     * The cost of matrix-free operator evaluation with sum factorization on
+     * a cell with the finite element @p fe, relative to a scalar element of
+     * degree one.
+     */
+    template <int dim, int spacedim>
+    double
+    matrix_free_cost(const FiniteElement<dim, spacedim> &fe)
+    {
+      double cost = 0.;
+      for (unsigned int b = 0; b < fe.n_base_elements(); ++b)
+        {
+          const FiniteElement<dim, spacedim> &base = fe.base_element(b);
+          if (base.dofs_per_cell > 0)
+            cost += fe.element_multiplicity(b) * base.n_components() *
+                    std::pow((base.tensor_degree() + 1.) / 2., dim + 1);
+        }
+      return cost;
+    }
+  } // namespace
+
+
+
   template <int dim, int spacedim>
   CellWeights<dim, spacedim>::CellWeights(
     const hp::DoFHandler<dim, spacedim> &dof_handler)
@@ -99,6 +130,112 @@ namespace parallel
   }
 
 
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::register_matrix_free_weighting(
+    const unsigned int factor)
+  {
+    weighting_function =
+      [factor](const FiniteElement<dim, spacedim> &active_fe,
+               const typename hp::DoFHandler<dim, spacedim>::cell_iterator &)
+      -> unsigned int {
+      return static_cast<unsigned int>(
+        std::round(factor * matrix_free_cost(active_fe)));
+    };
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::add_measurement(const unsigned int fe_index,
+                                              const unsigned int n_cells,
+                                              const double       time)
+  {
+    AssertIndexRange(fe_index, dof_handler->get_fe_collection().size());
+
+    std::lock_guard<std::mutex> lock(measurement_mutex);
+    if (measured_times.size() <= fe_index)
+      {
+        measured_times.resize(fe_index + 1, 0.);
+        measured_n_cells.resize(fe_index + 1, 0.);
+      }
+    measured_times[fe_index] += time;
+    measured_n_cells[fe_index] += n_cells;
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::clear_measurements()
+  {
+    std::lock_guard<std::mutex> lock(measurement_mutex);
+    measured_times.clear();
+    measured_n_cells.clear();
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::register_measured_weighting(
+    const unsigned int factor)
+  {
+    const hp::FECollection<dim, spacedim> &fe_collection =
+      dof_handler->get_fe_collection();
+    const unsigned int n_fe_indices = fe_collection.size();
+
+    // collect the measurements of all processes
+    std::vector<double> times(n_fe_indices, 0.);
+    std::vector<double> n_cells(n_fe_indices, 0.);
+    {
+      std::lock_guard<std::mutex> lock(measurement_mutex);
+      std::copy(measured_times.begin(), measured_times.end(), times.begin());
+      std::copy(measured_n_cells.begin(),
+                measured_n_cells.end(),
+                n_cells.begin());
+    }
+    Utilities::MPI::sum(times, triangulation->get_communicator(), times);
+    Utilities::MPI::sum(n_cells, triangulation->get_communicator(), n_cells);
+
+    // compute the cost per cell where measured, and calibrate the cost
+    // model by the average ratio of measured and modeled costs to
+    // estimate the remaining ones
+    std::vector<double> costs(n_fe_indices, 0.);
+    double              ratio      = 0.;
+    unsigned int        n_measured = 0;
+    for (unsigned int i = 0; i < n_fe_indices; ++i)
+      if (n_cells[i] > 0 && matrix_free_cost(fe_collection[i]) > 0.)
+        {
+          costs[i] = times[i] / n_cells[i];
+          ratio += costs[i] / matrix_free_cost(fe_collection[i]);
+          ++n_measured;
+        }
+    AssertThrow(n_measured > 0,
+                ExcMessage("No measurements have been recorded with "
+                           "add_measurement() on any process."));
+    ratio /= n_measured;
+
+    double min_cost = std::numeric_limits<double>::max();
+    for (unsigned int i = 0; i < n_fe_indices; ++i)
+      {
+        if (n_cells[i] == 0 || matrix_free_cost(fe_collection[i]) == 0.)
+          costs[i] = ratio * matrix_free_cost(fe_collection[i]);
+        if (costs[i] > 0.)
+          min_cost = std::min(min_cost, costs[i]);
+      }
+
+    std::vector<unsigned int> weights(n_fe_indices);
+    for (unsigned int i = 0; i < n_fe_indices; ++i)
+      weights[i] =
+        static_cast<unsigned int>(std::round(factor * costs[i] / min_cost));
+
+    weighting_function =
+      [this, weights](
+        const FiniteElement<dim, spacedim> &active_fe,
+        const typename hp::DoFHandler<dim, spacedim>::cell_iterator &)
+      -> unsigned int { return weights[fe_index_of(active_fe)]; };
+  }
+
+
   template <int dim, int spacedim>
   void
   CellWeights<dim, spacedim>::register_custom_weighting(
@@ -112,6 +249,25 @@ namespace parallel
 
 
 
+  template <int dim, int spacedim>
+  unsigned int
+  CellWeights<dim, spacedim>::fe_index_of(
+    const FiniteElement<dim, spacedim> &fe) const
+  {
+    const hp::FECollection<dim, spacedim> &fe_collection =
+      dof_handler->get_fe_collection();
+    for (unsigned int i = 0; i < fe_collection.size(); ++i)
+      if (&fe_collection[i] == &fe)
+        return i;
+
+    Assert(false,
+           ExcMessage("The finite element is not part of the collection of "
+                      "the DoFHandler."));
+    return 0;
+  }
+
+
+
   template <int dim, int spacedim>
   unsigned int
   CellWeights<dim, spacedim>::weight_callback(
@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/distributed/checkpoint_flusher.h>
+
+#include <cstdio>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace parallel
+{
+  namespace distributed
+  {
+    namespace
+    {
+      /**
+       * Copy the file @p source to @p target through a temporary file that
+       * is renamed once it is complete. Return an error message, or an
+       * empty string on success.
+       */
+      std::string
+      copy_file(const std::string &source, const std::string &target)
+      {
+        const std::string temporary = target + ".tmp";
+        {
+          std::ifstream in(source, std::ios::binary);
+          std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+          if (!out)
+            return "Could not open the file <" + temporary + "> for writing.";
+          out << in.rdbuf();
+          out.flush();
+          if (!out)
+            return "Could not write the file <" + temporary + ">.";
+        }
+
+        if (std::rename(temporary.c_str(), target.c_str()) != 0)
+          return "Could not rename the file <" + temporary + "> to <" +
+                 target + ">.";
+
+        return "";
+      }
+    } // namespace
+
+
+
+    CheckpointFlusher::CheckpointFlusher(const MPI_Comm &mpi_communicator)
+      : mpi_communicator(mpi_communicator)
+    {}
+
+
+
+    CheckpointFlusher::~CheckpointFlusher()
+    {
+      flush_thread.join();
+    }
+
+
+
+    void
+    CheckpointFlusher::flush(const std::string &staging_filename,
+                             const std::string &target_filename)
+    {
+      wait();
+
+      // make sure that all processes have finished writing their parts of
+      // the staging files before anyone starts to copy them
+#ifdef DEAL_II_WITH_MPI
+      const int ierr = MPI_Barrier(mpi_communicator);
+      AssertThrowMPI(ierr);
+#endif
+
+      const unsigned int my_rank =
+        Utilities::MPI::this_mpi_process(mpi_communicator);
+      const unsigned int n_procs =
+        Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+      // the files written by parallel::distributed::Triangulation::save():
+      // the forest of p4est, the information about the attached data, and
+      // the fixed and variable size data, the latter being optional. They
+      // are assigned to the processes in a round-robin fashion
+      const std::vector<std::string> suffixes = {"",
+                                                 ".info",
+                                                 "_fixed.data",
+                                                 "_variable.data"};
+      std::vector<std::pair<std::string, std::string>> files;
+      for (unsigned int i = my_rank; i < suffixes.size(); i += n_procs)
+        if (std::ifstream(staging_filename + suffixes[i]))
+          files.emplace_back(staging_filename + suffixes[i],
+                             target_filename + suffixes[i]);
+
+      flush_thread = Threads::new_thread([files]() -> std::string {
+        for (const auto &file : files)
+          {
+            const std::string error = copy_file(file.first, file.second);
+            if (!error.empty())
+              return error;
+          }
+        return "";
+      });
+    }
+
+
+
+    void
+    CheckpointFlusher::wait()
+    {
+      if (!flush_thread.valid())
+        return;
+
+      const std::string error = flush_thread.return_value();
+      flush_thread            = Threads::Thread<std::string>();
+      AssertThrow(error.empty(), ExcMessage(error));
+    }
+  } // namespace distributed
+} // namespace parallel
+
+
+DEAL_II_NAMESPACE_CLOSE
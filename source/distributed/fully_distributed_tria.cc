@@ -0,0 +1,644 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace parallel
+{
+  namespace fullydistributed
+  {
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_from_triangulation(
+      const dealii::Triangulation<dim, spacedim> &tria,
+      const MPI_Comm                              comm,
+      const unsigned int                          my_rank_in)
+    {
+      const unsigned int my_rank =
+        my_rank_in == numbers::invalid_unsigned_int ?
+          Utilities::MPI::this_mpi_process(comm) :
+          my_rank_in;
+
+      // 1) find the locally relevant active cells, namely those that share a
+      // vertex with a locally owned cell, and mark them and all their
+      // ancestors
+      std::vector<bool> vertex_of_own_cell(tria.n_vertices(), false);
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->subdomain_id() == my_rank)
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            vertex_of_own_cell[cell->vertex_index(v)] = true;
+
+      std::vector<std::vector<bool>> cell_is_relevant(tria.n_levels());
+      for (unsigned int level = 0; level < tria.n_levels(); ++level)
+        cell_is_relevant[level].resize(tria.n_raw_cells(level), false);
+
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          bool is_relevant = false;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            if (vertex_of_own_cell[cell->vertex_index(v)])
+              {
+                is_relevant = true;
+                break;
+              }
+          if (is_relevant == false)
+            continue;
+
+          for (typename dealii::Triangulation<dim, spacedim>::cell_iterator
+                 ancestor = cell;
+               ;
+               ancestor = ancestor->parent())
+            {
+              cell_is_relevant[ancestor->level()][ancestor->index()] = true;
+              if (ancestor->level() == 0)
+                break;
+            }
+        }
+
+      ConstructionData<dim, spacedim> construction_data;
+
+      // 2) collect the coarse cells and renumber their vertices
+      {
+        std::vector<unsigned int> vertex_map(tria.n_vertices(),
+                                             numbers::invalid_unsigned_int);
+        for (const auto &cell : tria.cell_iterators_on_level(0))
+          if (cell_is_relevant[0][cell->index()])
+            {
+              dealii::CellData<dim> cell_data;
+              for (unsigned int v = 0;
+                   v < GeometryInfo<dim>::vertices_per_cell;
+                   ++v)
+                {
+                  unsigned int &vertex = vertex_map[cell->vertex_index(v)];
+                  if (vertex == numbers::invalid_unsigned_int)
+                    {
+                      vertex = construction_data.coarse_cell_vertices.size();
+                      construction_data.coarse_cell_vertices.push_back(
+                        cell->vertex(v));
+                    }
+                  cell_data.vertices[v] = vertex;
+                }
+              cell_data.material_id = cell->material_id();
+              cell_data.manifold_id = cell->manifold_id();
+              construction_data.coarse_cells.push_back(cell_data);
+              construction_data.coarse_cell_index_to_coarse_cell_id.push_back(
+                tria.coarse_cell_index_to_coarse_cell_id(cell->index()));
+            }
+      }
+
+      // 3) collect the information of the relevant cells on all levels
+      for (unsigned int level = 0; level < tria.n_levels(); ++level)
+        {
+          std::vector<CellInfo<dim>> cell_infos;
+          for (const auto &cell : tria.cell_iterators_on_level(level))
+            if (cell_is_relevant[level][cell->index()])
+              {
+                CellInfo<dim> info;
+                info.id = cell->id().template to_binary<dim>();
+                if (cell->active())
+                  info.subdomain_id = cell->subdomain_id();
+                info.material_id = cell->material_id();
+                info.manifold_id = cell->manifold_id();
+                if (dim > 1)
+                  for (unsigned int l = 0;
+                       l < GeometryInfo<dim>::lines_per_cell;
+                       ++l)
+                    info.manifold_line_ids[l] = cell->line(l)->manifold_id();
+                if (dim == 3)
+                  for (unsigned int q = 0;
+                       q < GeometryInfo<dim>::quads_per_cell;
+                       ++q)
+                    info.manifold_quad_ids[q] = cell->quad(q)->manifold_id();
+                for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell;
+                     ++f)
+                  if (cell->face(f)->at_boundary())
+                    info.boundary_ids.emplace_back(
+                      f, cell->face(f)->boundary_id());
+                cell_infos.push_back(info);
+              }
+          if (cell_infos.empty())
+            break;
+          construction_data.cell_infos.push_back(std::move(cell_infos));
+        }
+
+      return construction_data;
+    }
+
+
+
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_on_root(
+      const std::function<void(dealii::Triangulation<dim, spacedim> &)>
+        &            serial_grid_generator,
+      const MPI_Comm comm,
+      const std::function<void(dealii::Triangulation<dim, spacedim> &,
+                               const MPI_Comm,
+                               const unsigned int)> &serial_grid_partitioner)
+    {
+      const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+      const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+      std::map<unsigned int, ConstructionData<dim, spacedim>> data_to_send;
+      ConstructionData<dim, spacedim>                         own_data;
+      if (my_rank == 0)
+        {
+          dealii::Triangulation<dim, spacedim> tria;
+          serial_grid_generator(tria);
+          if (serial_grid_partitioner)
+            serial_grid_partitioner(tria, comm, n_procs);
+          else
+            GridTools::partition_triangulation(n_procs, tria);
+
+          for (unsigned int rank = 1; rank < n_procs; ++rank)
+            data_to_send[rank] =
+              create_construction_data_from_triangulation(tria, comm, rank);
+          own_data = create_construction_data_from_triangulation(tria, comm, 0);
+        }
+
+      if (n_procs > 1)
+        {
+          const std::map<unsigned int, ConstructionData<dim, spacedim>>
+            received_data = Utilities::MPI::some_to_some(comm, data_to_send);
+          if (my_rank > 0)
+            {
+              AssertThrow(received_data.size() == 1 &&
+                            received_data.begin()->first == 0,
+                          ExcInternalError());
+              own_data = received_data.begin()->second;
+            }
+        }
+
+      return own_data;
+    }
+
+
+
+    template <int dim>
+    ConstructionData<dim, dim>
+    create_construction_data_for_subdivided_hyper_rectangle(
+      const std::vector<unsigned int> &                    repetitions,
+      const Point<dim> &                                   p1,
+      const Point<dim> &                                   p2,
+      const MPI_Comm                                       comm,
+      const bool                                           colorize,
+      const std::function<Point<dim>(const Point<dim> &)> &transformation)
+    {
+      AssertDimension(repetitions.size(), dim);
+      for (unsigned int d = 0; d < dim; ++d)
+        Assert(repetitions[d] > 0,
+               ExcMessage("The number of repetitions in each "
+                          "direction must be positive."));
+
+      const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+      const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+      // the strides of the lexicographic numbering of cells and vertices,
+      // in 64 bit to allow for meshes with more than 2^32 cells
+      std::array<std::uint64_t, dim> cell_stride, vertex_stride;
+      std::uint64_t                  n_cells = 1, n_vertices = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          cell_stride[d]   = n_cells;
+          vertex_stride[d] = n_vertices;
+          n_cells *= repetitions[d];
+          n_vertices *= repetitions[d] + 1;
+        }
+
+      const auto owner = [&](const std::uint64_t cell) {
+        return static_cast<unsigned int>(cell * n_procs / n_cells);
+      };
+      const std::uint64_t begin_owned = (n_cells * my_rank) / n_procs;
+      const std::uint64_t end_owned   = (n_cells * (my_rank + 1)) / n_procs;
+
+      // collect the owned cells and their neighbors in the 3^dim stencil
+      // around each of them, which are exactly the cells that share a vertex
+      // with an owned cell. Only the cells at the boundary of the owned
+      // range add neighbors, but checking all of them keeps this simple
+      std::set<std::uint64_t> relevant_cells;
+      for (std::uint64_t cell = begin_owned; cell < end_owned; ++cell)
+        {
+          std::array<unsigned int, dim> index;
+          for (unsigned int d = 0; d < dim; ++d)
+            index[d] = (cell / cell_stride[d]) % repetitions[d];
+
+          const unsigned int n_stencil = Utilities::fixed_power<dim>(3);
+          for (unsigned int s = 0; s < n_stencil; ++s)
+            {
+              std::uint64_t neighbor = 0;
+              bool          inside   = true;
+              for (unsigned int d = 0, t = s; d < dim; ++d, t /= 3)
+                {
+                  const int i = static_cast<int>(index[d]) + int(t % 3) - 1;
+                  if (i < 0 || i >= static_cast<int>(repetitions[d]))
+                    inside = false;
+                  else
+                    neighbor += i * cell_stride[d];
+                }
+              if (inside)
+                relevant_cells.insert(neighbor);
+            }
+        }
+
+      ConstructionData<dim, dim> construction_data;
+      construction_data.cell_infos.resize(1);
+
+      Point<dim> extent;
+      for (unsigned int d = 0; d < dim; ++d)
+        extent[d] = (p2[d] - p1[d]) / repetitions[d];
+
+      std::map<std::uint64_t, unsigned int> vertex_to_local_vertex;
+      for (const std::uint64_t cell : relevant_cells)
+        {
+          std::array<unsigned int, dim> index;
+          for (unsigned int d = 0; d < dim; ++d)
+            index[d] = (cell / cell_stride[d]) % repetitions[d];
+
+          CellData<dim> cell_data;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            {
+              std::uint64_t vertex = 0;
+              for (unsigned int d = 0; d < dim; ++d)
+                vertex += (index[d] + ((v >> d) & 1)) * vertex_stride[d];
+
+              const auto it = vertex_to_local_vertex.find(vertex);
+              if (it != vertex_to_local_vertex.end())
+                cell_data.vertices[v] = it->second;
+              else
+                {
+                  const unsigned int local_vertex =
+                    construction_data.coarse_cell_vertices.size();
+                  vertex_to_local_vertex[vertex] = local_vertex;
+                  cell_data.vertices[v]          = local_vertex;
+
+                  Point<dim> p;
+                  for (unsigned int d = 0; d < dim; ++d)
+                    p[d] = p1[d] + (index[d] + ((v >> d) & 1)) * extent[d];
+                  construction_data.coarse_cell_vertices.push_back(
+                    transformation ? transformation(p) : p);
+                }
+            }
+          construction_data.coarse_cells.push_back(cell_data);
+          construction_data.coarse_cell_index_to_coarse_cell_id.push_back(
+            cell);
+
+          CellInfo<dim> info;
+          info.id =
+            CellId(cell, std::vector<std::uint8_t>()).template to_binary<dim>();
+          info.subdomain_id = owner(cell);
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              if (index[d] == 0)
+                info.boundary_ids.emplace_back(2 * d, colorize ? 2 * d : 0);
+              if (index[d] + 1 == repetitions[d])
+                info.boundary_ids.emplace_back(2 * d + 1,
+                                               colorize ? 2 * d + 1 : 0);
+            }
+          construction_data.cell_infos[0].push_back(info);
+        }
+
+      return construction_data;
+    }
+  } // namespace fullydistributed
+} // namespace parallel
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+namespace parallel
+{
+  namespace fullydistributed
+  {
+    namespace
+    {
+      /**
+       * Return the id of the given child of a cell, independently of whether
+       * the child already exists.
+       */
+      template <int dim, int spacedim>
+      CellId
+      child_cell_id(
+        const typename dealii::Triangulation<dim, spacedim>::cell_iterator
+          &                                         cell,
+        const unsigned int                          child,
+        const dealii::Triangulation<dim, spacedim> &tria)
+      {
+        std::vector<std::uint8_t> child_indices(1, child);
+        auto                      ancestor = cell;
+        while (ancestor->level() > 0)
+          {
+            const auto   parent = ancestor->parent();
+            unsigned int c      = 0;
+            while (parent->child(c) != ancestor)
+              ++c;
+            child_indices.push_back(c);
+            ancestor = parent;
+          }
+        std::reverse(child_indices.begin(), child_indices.end());
+        return CellId(tria.coarse_cell_index_to_coarse_cell_id(
+                        ancestor->index()),
+                      child_indices);
+      }
+    } // namespace
+
+
+
+    template <int dim, int spacedim>
+    Triangulation<dim, spacedim>::Triangulation(MPI_Comm mpi_communicator)
+      : parallel::DistributedTriangulationBase<dim, spacedim>(mpi_communicator)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const ConstructionData<dim, spacedim> &construction_data)
+    {
+      AssertThrow(this->n_levels() == 0,
+                  ExcMessage("The triangulation must be empty before "
+                             "creating it."));
+      AssertDimension(construction_data.coarse_cells.size(),
+                      construction_data.coarse_cell_index_to_coarse_cell_id
+                        .size());
+
+      if (construction_data.coarse_cells.empty())
+        {
+          // this process has no cells: create a single artificial cell to
+          // obtain a valid triangulation
+          std::vector<Point<spacedim>> vertices(
+            GeometryInfo<dim>::vertices_per_cell);
+          std::vector<dealii::CellData<dim>> cells(1);
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            {
+              const Point<dim> unit_vertex =
+                GeometryInfo<dim>::unit_cell_vertex(v);
+              for (unsigned int d = 0; d < dim; ++d)
+                vertices[v][d] = unit_vertex[d];
+              cells[0].vertices[v] = v;
+            }
+          dealii::Triangulation<dim, spacedim>::create_triangulation(
+            vertices, cells, SubCellData());
+          this->begin_active()->set_subdomain_id(
+            numbers::artificial_subdomain_id);
+
+          coarse_cell_index_to_id = {numbers::invalid_coarse_cell_id};
+          coarse_cell_id_to_index = {{numbers::invalid_coarse_cell_id, 0}};
+
+          this->update_number_cache();
+          return;
+        }
+
+      coarse_cell_index_to_id =
+        construction_data.coarse_cell_index_to_coarse_cell_id;
+      coarse_cell_id_to_index.clear();
+      for (unsigned int i = 0; i < coarse_cell_index_to_id.size(); ++i)
+        coarse_cell_id_to_index.emplace_back(coarse_cell_index_to_id[i], i);
+      std::sort(coarse_cell_id_to_index.begin(), coarse_cell_id_to_index.end());
+
+      dealii::Triangulation<dim, spacedim>::create_triangulation(
+        construction_data.coarse_cell_vertices,
+        construction_data.coarse_cells,
+        SubCellData());
+
+      const auto &cell_infos = construction_data.cell_infos;
+      for (unsigned int level = 0; level < cell_infos.size(); ++level)
+        {
+          // set the manifold and boundary ids before refinement such that the
+          // new vertices are placed correctly
+          for (const CellInfo<dim> &info : cell_infos[level])
+            {
+              const auto cell = CellId(info.id).to_cell(*this);
+              cell->set_material_id(info.material_id);
+              cell->set_manifold_id(info.manifold_id);
+              if (dim > 1)
+                for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell;
+                     ++l)
+                  cell->line(l)->set_manifold_id(info.manifold_line_ids[l]);
+              if (dim == 3)
+                for (unsigned int q = 0; q < GeometryInfo<dim>::quads_per_cell;
+                     ++q)
+                  cell->quad(q)->set_manifold_id(info.manifold_quad_ids[q]);
+              for (const auto &boundary_id : info.boundary_ids)
+                cell->face(boundary_id.first)->set_boundary_id(
+                  boundary_id.second);
+            }
+
+          if (level + 1 == cell_infos.size())
+            break;
+
+          // refine the cells with children on the next level. Only the
+          // children close to the locally owned cells are described, which
+          // need not include the first child
+          std::set<CellId> children;
+          for (const CellInfo<dim> &info : cell_infos[level + 1])
+            children.insert(CellId(info.id));
+          for (const auto &cell : this->active_cell_iterators_on_level(level))
+            for (unsigned int c = 0;
+                 c < GeometryInfo<dim>::max_children_per_cell;
+                 ++c)
+              if (children.find(child_cell_id(cell, c, *this)) !=
+                  children.end())
+                {
+                  cell->set_refine_flag();
+                  break;
+                }
+          dealii::Triangulation<dim, spacedim>::
+            execute_coarsening_and_refinement();
+        }
+
+      // all active cells not described by the construction data are
+      // artificial
+      for (const auto &cell : this->active_cell_iterators())
+        cell->set_subdomain_id(numbers::artificial_subdomain_id);
+      for (const auto &level_infos : cell_infos)
+        for (const CellInfo<dim> &info : level_infos)
+          {
+            const auto cell = CellId(info.id).to_cell(*this);
+            if (cell->active())
+              cell->set_subdomain_id(info.subdomain_id);
+          }
+
+      this->update_number_cache();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const std::vector<Point<spacedim>> & /*vertices*/,
+      const std::vector<dealii::CellData<dim>> & /*cells*/,
+      const SubCellData & /*subcelldata*/)
+    {
+      AssertThrow(false,
+                  ExcMessage("This function is not supported by "
+                             "parallel::fullydistributed::Triangulation. Use "
+                             "create_triangulation() with a ConstructionData "
+                             "argument instead."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::copy_triangulation(
+      const dealii::Triangulation<dim, spacedim> &other_tria)
+    {
+      AssertThrow(
+        (dynamic_cast<
+           const dealii::parallel::DistributedTriangulationBase<dim, spacedim>
+             *>(&other_tria) == nullptr),
+        ExcMessage("Only serial triangulations and "
+                   "parallel::shared::Triangulation objects can be copied "
+                   "into a parallel::fullydistributed::Triangulation."));
+      if (const auto other_parallel_tria = dynamic_cast<
+            const dealii::parallel::TriangulationBase<dim, spacedim> *>(
+            &other_tria))
+        AssertThrow(Utilities::MPI::n_mpi_processes(
+                      other_parallel_tria->get_communicator()) ==
+                      Utilities::MPI::n_mpi_processes(this->mpi_communicator),
+                    ExcMessage("The communicators of both triangulations "
+                               "need to have the same number of processes."));
+
+      for (const auto manifold_id : other_tria.get_manifold_ids())
+        if (manifold_id != numbers::flat_manifold_id)
+          this->set_manifold(manifold_id, other_tria.get_manifold(manifold_id));
+
+      create_triangulation(
+        create_construction_data_from_triangulation(other_tria,
+                                                    this->mpi_communicator));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::execute_coarsening_and_refinement()
+    {
+      AssertThrow(false,
+                  ExcMessage("Refinement and coarsening are not supported by "
+                             "parallel::fullydistributed::Triangulation."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    Triangulation<dim, spacedim>::has_hanging_nodes() const
+    {
+      unsigned int has_hanging_nodes = 0;
+      for (const auto &cell : this->active_cell_iterators())
+        if (cell->is_locally_owned())
+          for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+            if (cell->at_boundary(f) == false &&
+                (cell->face(f)->has_children() ||
+                 cell->neighbor_is_coarser(f)))
+              {
+                has_hanging_nodes = 1;
+                break;
+              }
+      return Utilities::MPI::max(has_hanging_nodes, this->mpi_communicator) >
+             0;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    Triangulation<dim, spacedim>::is_multilevel_hierarchy_constructed() const
+    {
+      return false;
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::size_t
+    Triangulation<dim, spacedim>::memory_consumption() const
+    {
+      return dealii::parallel::TriangulationBase<dim, spacedim>::
+               memory_consumption() +
+             MemoryConsumption::memory_consumption(coarse_cell_id_to_index) +
+             MemoryConsumption::memory_consumption(coarse_cell_index_to_id);
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    Triangulation<dim, spacedim>::coarse_cell_id_to_coarse_cell_index(
+      const types::coarse_cell_id coarse_cell_id) const
+    {
+      const auto it =
+        std::lower_bound(coarse_cell_id_to_index.begin(),
+                         coarse_cell_id_to_index.end(),
+                         coarse_cell_id,
+                         [](const std::pair<types::coarse_cell_id,
+                                            unsigned int> &pair,
+                            const types::coarse_cell_id &val) {
+                           return pair.first < val;
+                         });
+      Assert(it != coarse_cell_id_to_index.end() &&
+               it->first == coarse_cell_id,
+             ExcMessage("The coarse cell with the given id is not locally "
+                        "relevant on this process."));
+      return it->second;
+    }
+
+
+
+    template <int dim, int spacedim>
+    types::coarse_cell_id
+    Triangulation<dim, spacedim>::coarse_cell_index_to_coarse_cell_id(
+      const unsigned int coarse_cell_index) const
+    {
+      AssertIndexRange(coarse_cell_index, coarse_cell_index_to_id.size());
+      return coarse_cell_index_to_id[coarse_cell_index];
+    }
+  } // namespace fullydistributed
+} // namespace parallel
+
+#endif
+
+
+/*-------------- Explicit Instantiations -------------------------------*/
+#include "fully_distributed_tria.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
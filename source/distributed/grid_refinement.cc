@@ -31,6 +31,8 @@
 #  include <deal.II/grid/tria_iterator.h>
 
 #  include <algorithm>
+#  include <array>
+#  include <cmath>
 #  include <functional>
 #  include <limits>
 #  include <numeric>
@@ -217,90 +219,143 @@ namespace
   namespace RefineAndCoarsenFixedNumber
   {
     /**
-     * Compute a threshold value so that exactly n_target_cells have a value
-     * that is larger.
+     * Compute threshold values so that for each entry of n_target_cells
+     * approximately this number of cells have a value that is larger.
+     *
+     * Rather than bisecting the range of the indicators with one global
+     * reduction per step, every round splits the current interval of each
+     * threshold into n_buckets buckets and counts the cells above each of the
+     * bucket boundaries in a single reduction over all thresholds. The
+     * interval is then narrowed to the bucket that contains the target
+     * number. With 256 buckets, the three rounds resolve the range of the
+     * indicators as finely as 24 steps of bisection, and the thresholds are
+     * computed in four reductions, including the one for the global minimum
+     * and maximum. Since all processes receive the same counts, no broadcast
+     * of the intervals is necessary.
      */
     template <typename number>
-    number
-    compute_threshold(const dealii::Vector<number> &   criteria,
-                      const std::pair<double, double> &global_min_and_max,
-                      const unsigned int               n_target_cells,
-                      MPI_Comm                         mpi_communicator)
+    std::vector<double>
+    compute_thresholds(
+      const dealii::Vector<number> &              criteria,
+      const std::vector<types::global_dof_index> &n_target_cells,
+      MPI_Comm                                    mpi_communicator)
     {
-      double interesting_range[2] = {global_min_and_max.first,
-                                     global_min_and_max.second};
-      adjust_interesting_range(interesting_range);
+      const unsigned int n_buckets  = 256;
+      const unsigned int n_rounds   = 3;
+      const unsigned int n_searches = n_target_cells.size();
 
-      const unsigned int master_mpi_rank = 0;
-      unsigned int       iteration       = 0;
+      // compute the global minimum and maximum on all processes in one
+      // reduction, in the same way as compute_global_min_and_max_at_root()
+      double interesting_range[2] = {0, 0};
+      {
+        const double comp[2] = {min_element(criteria), -max_element(criteria)};
+        const int    ierr    = MPI_Allreduce(
+          comp, interesting_range, 2, MPI_DOUBLE, MPI_MIN, mpi_communicator);
+        AssertThrowMPI(ierr);
+        interesting_range[1] = -interesting_range[1];
+      }
+      adjust_interesting_range(interesting_range);
 
-      do
+      std::vector<std::array<double, 2>> ranges(
+        n_searches, {{interesting_range[0], interesting_range[1]}});
+      std::vector<double>              thresholds(n_searches);
+      std::vector<bool>                converged(n_searches, false);
+      std::vector<std::vector<double>> edges(
+        n_searches, std::vector<double>(n_buckets + 1));
+      std::vector<unsigned long long int> local_counts(n_searches *
+                                                       (n_buckets + 1));
+      std::vector<unsigned long long int> global_counts(local_counts.size());
+
+      for (unsigned int round = 0; round < n_rounds; ++round)
         {
-          int ierr = MPI_Bcast(interesting_range,
-                               2,
-                               MPI_DOUBLE,
-                               master_mpi_rank,
-                               mpi_communicator);
-          AssertThrowMPI(ierr);
-
-          if (interesting_range[0] == interesting_range[1])
-            return interesting_range[0];
-
-          const double test_threshold =
-            (interesting_range[0] > 0 ?
-               std::sqrt(interesting_range[0] * interesting_range[1]) :
-               (interesting_range[0] + interesting_range[1]) / 2);
-
-          // count how many of our own elements would be above this threshold
-          // and then add to it the number for all the others
-          unsigned int my_count =
-            std::count_if(criteria.begin(),
-                          criteria.end(),
-                          [test_threshold](const double c) {
-                            return c > test_threshold;
-                          });
-
-          unsigned int total_count = 0;
+          // place the boundaries of the buckets in the same way as the test
+          // thresholds of the bisection, i.e., geometrically if the interval
+          // does not contain zero
+          for (unsigned int s = 0; s < n_searches; ++s)
+            {
+              const double lower = ranges[s][0], upper = ranges[s][1];
+              for (unsigned int k = 0; k <= n_buckets; ++k)
+                edges[s][k] =
+                  (lower > 0 ?
+                     lower * std::pow(upper / lower,
+                                      static_cast<double>(k) / n_buckets) :
+                     lower + (upper - lower) * k / n_buckets);
+              edges[s][0]         = lower;
+              edges[s][n_buckets] = upper;
+            }
 
-          ierr = MPI_Reduce(&my_count,
-                            &total_count,
-                            1,
-                            MPI_UNSIGNED,
-                            MPI_SUM,
-                            master_mpi_rank,
-                            mpi_communicator);
+          // for each cell, find the number of boundaries that are smaller
+          // than its indicator, and sum these up to the number of cells
+          // larger than each boundary
+          std::fill(local_counts.begin(), local_counts.end(), 0ULL);
+          for (unsigned int s = 0; s < n_searches; ++s)
+            if (converged[s] == false)
+              {
+                unsigned long long int *counts =
+                  local_counts.data() + s * (n_buckets + 1);
+                for (const number c : criteria)
+                  {
+                    const unsigned int n_smaller_edges =
+                      std::lower_bound(edges[s].begin(),
+                                       edges[s].end(),
+                                       static_cast<double>(c)) -
+                      edges[s].begin();
+                    if (n_smaller_edges > 0)
+                      ++counts[n_smaller_edges - 1];
+                  }
+                for (unsigned int k = n_buckets; k > 0; --k)
+                  counts[k - 1] += counts[k];
+              }
+
+          const int ierr = MPI_Allreduce(local_counts.data(),
+                                         global_counts.data(),
+                                         global_counts.size(),
+                                         MPI_UNSIGNED_LONG_LONG,
+                                         MPI_SUM,
+                                         mpi_communicator);
           AssertThrowMPI(ierr);
 
-          // now adjust the range. if we have too many cells, we take the upper
-          // half of the previous range, otherwise the lower half. if we have
-          // hit the right number, then set the range to the exact value.
-          // slave nodes also update their own interesting_range, however their
-          // results are not significant since the values will be overwritten by
-          // MPI_Bcast from the master node in next loop.
-          if (total_count > n_target_cells)
-            interesting_range[0] = test_threshold;
-          else if (total_count < n_target_cells)
-            interesting_range[1] = test_threshold;
-          else
-            interesting_range[0] = interesting_range[1] = test_threshold;
-
-          // terminate the iteration after 25 go-arounds. this is necessary
-          // because oftentimes error indicators on cells have exactly the
-          // same value, and so there may not be a particular value that cuts
-          // the indicators in such a way that we can achieve the desired
-          // number of cells. using a maximal number of iterations means that
-          // we terminate the iteration after a fixed number N of steps if the
-          // indicators were perfectly badly distributed, and we make at most
-          // a mistake of 1/2^N in the number of cells flagged if indicators
-          // are perfectly equidistributed
-          ++iteration;
-          if (iteration == 25)
-            interesting_range[0] = interesting_range[1] = test_threshold;
+          // narrow the interval of each threshold to the bucket in which the
+          // number of cells above the boundary drops below the target
+          // number, or stop if one of the boundaries hits it exactly
+          for (unsigned int s = 0; s < n_searches; ++s)
+            if (converged[s] == false)
+              {
+                const unsigned long long int *counts =
+                  global_counts.data() + s * (n_buckets + 1);
+                const unsigned long long int target = n_target_cells[s];
+
+                unsigned int k = 0;
+                while (k < n_buckets && counts[k + 1] >= target)
+                  ++k;
+
+                if (counts[k] == target || k == n_buckets)
+                  {
+                    thresholds[s] = edges[s][k];
+                    converged[s]  = true;
+                  }
+                else
+                  {
+                    ranges[s][0] = edges[s][k];
+                    ranges[s][1] = edges[s][k + 1];
+
+                    // pick the boundary whose count is closest to the target
+                    // in case this is the last round
+                    thresholds[s] =
+                      (counts[k] - target <= target - counts[k + 1] ?
+                         edges[s][k] :
+                         edges[s][k + 1]);
+                    if (!(ranges[s][0] < ranges[s][1]))
+                      converged[s] = true;
+                  }
+              }
+
+          if (std::find(converged.begin(), converged.end(), false) ==
+              converged.end())
+            break;
         }
-      while (true);
 
-      Assert(false, ExcInternalError());
-      return -1;
+      return thresholds;
     }
   } // namespace RefineAndCoarsenFixedNumber
 
@@ -460,30 +515,25 @@ namespace parallel
 
         MPI_Comm mpi_communicator = tria.get_communicator();
 
-        // figure out the global max and min of the indicators. we don't need it
-        // here, but it's a collective communication call
-        const std::pair<Number, Number> global_min_and_max =
-          compute_global_min_and_max_at_root(locally_owned_indicators,
-                                             mpi_communicator);
-
+        // compute the top threshold and, if necessary, the bottom threshold
+        // together. otherwise use a threshold lower than the smallest value
+        // we have locally
+        std::vector<types::global_dof_index> n_target_cells(
+          1,
+          static_cast<types::global_dof_index>(adjusted_fractions.first *
+                                               tria.n_global_active_cells()));
+        if (adjusted_fractions.second > 0)
+          n_target_cells.push_back(static_cast<types::global_dof_index>(
+            (1 - adjusted_fractions.second) * tria.n_global_active_cells()));
 
-        double top_threshold, bottom_threshold;
-        top_threshold = RefineAndCoarsenFixedNumber::compute_threshold(
-          locally_owned_indicators,
-          global_min_and_max,
-          static_cast<unsigned int>(adjusted_fractions.first *
-                                    tria.n_global_active_cells()),
-          mpi_communicator);
+        const std::vector<double> thresholds =
+          RefineAndCoarsenFixedNumber::compute_thresholds(
+            locally_owned_indicators, n_target_cells, mpi_communicator);
 
-        // compute bottom threshold only if necessary. otherwise use a threshold
-        // lower than the smallest value we have locally
+        const double top_threshold = thresholds[0];
+        double       bottom_threshold;
         if (adjusted_fractions.second > 0)
-          bottom_threshold = RefineAndCoarsenFixedNumber::compute_threshold(
-            locally_owned_indicators,
-            global_min_and_max,
-            static_cast<unsigned int>((1 - adjusted_fractions.second) *
-                                      tria.n_global_active_cells()),
-            mpi_communicator);
+          bottom_threshold = thresholds[1];
         else
           {
             bottom_threshold =
@@ -459,6 +459,10 @@ namespace internal
                                                 types<2>::balance_type btype) =
       p4est_ghost_new;
 
+    void (&functions<2>::ghost_expand)(types<2>::forest *p4est,
+                                         types<2>::ghost * ghost) =
+      p4est_ghost_expand;
+
     void (&functions<2>::ghost_destroy)(types<2>::ghost *ghost) =
       p4est_ghost_destroy;
 
@@ -698,6 +702,10 @@ namespace internal
                                                 types<3>::balance_type btype) =
       p8est_ghost_new;
 
+    void (&functions<3>::ghost_expand)(types<3>::forest *p4est,
+                                         types<3>::ghost * ghost) =
+      p8est_ghost_expand;
+
     void (&functions<3>::ghost_destroy)(types<3>::ghost *ghost) =
       p8est_ghost_destroy;
 
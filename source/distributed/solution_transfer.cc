@@ -38,6 +38,7 @@
 #  include <deal.II/lac/trilinos_vector.h>
 #  include <deal.II/lac/vector.h>
 
+#  include <cstring>
 #  include <functional>
 #  include <numeric>
 
@@ -50,29 +51,36 @@ namespace
   /**
    * Optimized pack function for values assigned on degrees of freedom.
    *
-   * Given that the elements of @p dof_values are stored in consecutive
-   * locations, we can just memcpy them. Since floating point values don't
-   * compress well, we also forgo the compression the default
+   * The values of all @p input_vectors on @p cell are interpolated one after
+   * the other into a single scratch vector, whose consecutive elements are
+   * then memcpy'd directly into the buffer that is returned. This way, only
+   * the buffer itself is allocated per cell. Since floating point values
+   * don't compress well, we also forgo the compression the default
    * Utilities::pack() and Utilities::unpack() functions offer.
    */
-  template <typename value_type>
+  template <typename value_type, typename CellIterator, typename VectorType>
   std::vector<char>
-  pack_dof_values(std::vector<Vector<value_type>> &dof_values,
-                  const unsigned int               dofs_per_cell)
+  pack_dof_values(const CellIterator &                  cell,
+                  const std::vector<const VectorType *> &input_vectors,
+                  const unsigned int                     fe_index,
+                  const unsigned int                     dofs_per_cell)
   {
-    for (const auto &values : dof_values)
-      {
-        AssertDimension(values.size(), dofs_per_cell);
-        (void)values;
-      }
-
     const std::size_t bytes_per_entry = sizeof(value_type) * dofs_per_cell;
 
-    std::vector<char> buffer(dof_values.size() * bytes_per_entry);
-    for (unsigned int i = 0; i < dof_values.size(); ++i)
-      std::memcpy(&buffer[i * bytes_per_entry],
-                  &dof_values[i](0),
-                  bytes_per_entry);
+    std::vector<char> buffer(input_vectors.size() * bytes_per_entry);
+    if (bytes_per_entry == 0)
+      return buffer;
+
+    Vector<value_type> dof_values(dofs_per_cell);
+    for (unsigned int i = 0; i < input_vectors.size(); ++i)
+      {
+        cell->get_interpolated_dof_values(*input_vectors[i],
+                                          dof_values,
+                                          fe_index);
+        std::memcpy(&buffer[i * bytes_per_entry],
+                    dof_values.begin(),
+                    bytes_per_entry);
+      }
 
     return buffer;
   }
@@ -81,30 +89,43 @@ namespace
 
   /**
    * Optimized unpack function for values assigned on degrees of freedom.
+   * The counterpart of pack_dof_values(): the values of each vector are
+   * copied from @p data_range into a single scratch vector and interpolated
+   * into the corresponding output vector right away.
    */
-  template <typename value_type>
-  std::vector<Vector<value_type>>
+  template <typename value_type, typename CellIterator, typename VectorType>
+  void
   unpack_dof_values(
+    const CellIterator &                                            cell,
     const boost::iterator_range<std::vector<char>::const_iterator> &data_range,
+    const std::vector<VectorType *> &                               all_out,
+    const unsigned int                                              fe_index,
     const unsigned int dofs_per_cell)
   {
-    const std::size_t  bytes_per_entry = sizeof(value_type) * dofs_per_cell;
-    const unsigned int n_elements      = data_range.size() / bytes_per_entry;
+    const std::size_t bytes_per_entry = sizeof(value_type) * dofs_per_cell;
+
+    // check if we have enough dofs provided by the FE object
+    // to interpolate the transferred data correctly
+    Assert(
+      static_cast<std::size_t>(data_range.size()) ==
+        all_out.size() * bytes_per_entry,
+      ExcMessage(
+        "The transferred data was packed with a different number of dofs than the "
+        "currently registered FE object assigned to the DoFHandler has."));
 
-    Assert((data_range.size() % bytes_per_entry == 0), ExcInternalError());
+    if (bytes_per_entry == 0)
+      return;
 
-    std::vector<Vector<value_type>> unpacked_data;
-    unpacked_data.reserve(n_elements);
-    for (unsigned int i = 0; i < n_elements; ++i)
+    Vector<value_type> dof_values(dofs_per_cell);
+    for (unsigned int i = 0; i < all_out.size(); ++i)
       {
-        Vector<value_type> dof_values(dofs_per_cell);
-        std::memcpy(&dof_values(0),
+        std::memcpy(dof_values.begin(),
                     &(*std::next(data_range.begin(), i * bytes_per_entry)),
                     bytes_per_entry);
-        unpacked_data.emplace_back(std::move(dof_values));
+        cell->set_dof_values_by_interpolation(dof_values,
+                                              *all_out[i],
+                                              fe_index);
       }
-
-    return unpacked_data;
   }
 } // namespace
 
@@ -303,10 +324,6 @@ namespace parallel
     {
       typename DoFHandlerType::cell_iterator cell(*cell_, dof_handler);
 
-      // create buffer for each individual object
-      std::vector<::dealii::Vector<typename VectorType::value_type>> dof_values(
-        input_vectors.size());
-
       unsigned int fe_index = 0;
       if (DoFHandlerType::is_hp_dof_handler)
         {
@@ -364,15 +381,9 @@ namespace parallel
       const unsigned int dofs_per_cell =
         dof_handler->get_fe(fe_index).dofs_per_cell;
 
-      auto it_input  = input_vectors.cbegin();
-      auto it_output = dof_values.begin();
-      for (; it_input != input_vectors.cend(); ++it_input, ++it_output)
-        {
-          it_output->reinit(dofs_per_cell);
-          cell->get_interpolated_dof_values(*(*it_input), *it_output, fe_index);
-        }
-
-      return pack_dof_values<typename VectorType::value_type>(dof_values,
+      return pack_dof_values<typename VectorType::value_type>(cell,
+                                                              input_vectors,
+                                                              fe_index,
                                                               dofs_per_cell);
     }
 
@@ -436,32 +447,9 @@ namespace parallel
       const unsigned int dofs_per_cell =
         dof_handler->get_fe(fe_index).dofs_per_cell;
 
-      const std::vector<::dealii::Vector<typename VectorType::value_type>>
-        dof_values =
-          unpack_dof_values<typename VectorType::value_type>(data_range,
-                                                             dofs_per_cell);
-
-      // check if sizes match
-      Assert(dof_values.size() == all_out.size(), ExcInternalError());
-
-      // check if we have enough dofs provided by the FE object
-      // to interpolate the transferred data correctly
-      for (auto it_dof_values = dof_values.begin();
-           it_dof_values != dof_values.end();
-           ++it_dof_values)
-        Assert(
-          dofs_per_cell == it_dof_values->size(),
-          ExcMessage(
-            "The transferred data was packed with a different number of dofs than the "
-            "currently registered FE object assigned to the DoFHandler has."));
-
       // distribute data for each registered vector on mesh
-      auto it_input  = dof_values.cbegin();
-      auto it_output = all_out.begin();
-      for (; it_input != dof_values.cend(); ++it_input, ++it_output)
-        cell->set_dof_values_by_interpolation(*it_input,
-                                              *(*it_output),
-                                              fe_index);
+      unpack_dof_values<typename VectorType::value_type>(
+        cell, data_range, all_out, fe_index, dofs_per_cell);
     }
   } // namespace distributed
 } // namespace parallel
@@ -16,6 +16,7 @@
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/memory_report.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/distributed/p4est_wrappers.h>
@@ -30,6 +31,7 @@
 #include <deal.II/lac/sparsity_tools.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <numeric>
@@ -1137,10 +1139,21 @@ namespace parallel
       MPI_Comm mpi_communicator)
       : mpi_communicator(mpi_communicator)
       , variable_size_data_stored(false)
+      , n_io_aggregators_per_node(0)
     {}
 
 
 
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::DataTransfer::set_n_io_aggregators_per_node(
+      const unsigned int n_aggregators)
+    {
+      n_io_aggregators_per_node = n_aggregators;
+    }
+
+
+
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::DataTransfer::pack_data(
@@ -1770,6 +1783,42 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    MPI_Info
+    Triangulation<dim, spacedim>::DataTransfer::create_io_info() const
+    {
+      MPI_Info info;
+      int      ierr = MPI_Info_create(&info);
+      AssertThrowMPI(ierr);
+
+      // Use collective buffering for all collective reads and writes, and
+      // prescribe the number of aggregating processors per compute node if
+      // requested. These hints are understood by ROMIO, which is the MPI-IO
+      // implementation of both MPICH and Open MPI, and are silently ignored
+      // otherwise.
+      ierr = MPI_Info_set(info,
+                          DEAL_II_MPI_CONST_CAST("romio_cb_write"),
+                          DEAL_II_MPI_CONST_CAST("enable"));
+      AssertThrowMPI(ierr);
+      ierr = MPI_Info_set(info,
+                          DEAL_II_MPI_CONST_CAST("romio_cb_read"),
+                          DEAL_II_MPI_CONST_CAST("enable"));
+      AssertThrowMPI(ierr);
+      if (n_io_aggregators_per_node > 0)
+        {
+          const std::string config_list =
+            "*:" + Utilities::to_string(n_io_aggregators_per_node);
+          ierr = MPI_Info_set(info,
+                              DEAL_II_MPI_CONST_CAST("cb_config_list"),
+                              DEAL_II_MPI_CONST_CAST(config_list.c_str()));
+          AssertThrowMPI(ierr);
+        }
+
+      return info;
+    }
+
+
+
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::DataTransfer::save(
@@ -1780,6 +1829,11 @@ namespace parallel
       // Large fractions of this function have been copied from
       // DataOutInterface::write_vtu_in_parallel.
       // TODO: Write general MPIIO interface.
+      //
+      // All processors write their (contiguous) part of the files with
+      // collective operations, which allows the MPI implementation to gather
+      // the many small pieces of data on a few aggregating processors and to
+      // write them in large blocks, see create_io_info().
 
       Assert(sizes_fixed_cumulative.size() > 0,
              ExcMessage("No data has been packed!"));
@@ -1792,9 +1846,8 @@ namespace parallel
       {
         const std::string fname_fixed = std::string(filename) + "_fixed.data";
 
-        MPI_Info info;
-        int      ierr = MPI_Info_create(&info);
-        AssertThrowMPI(ierr);
+        MPI_Info info = create_io_info();
+        int      ierr;
 
         MPI_File fh;
         ierr = MPI_File_open(mpi_communicator,
@@ -1839,7 +1892,7 @@ namespace parallel
 
         const char *data = src_data_fixed.data();
 
-        ierr = MPI_File_write_at(
+        ierr = MPI_File_write_at_all(
           fh,
           offset_fixed +
             parallel_forest->global_first_quadrant[myrank] *
@@ -1862,9 +1915,8 @@ namespace parallel
           const std::string fname_variable =
             std::string(filename) + "_variable.data";
 
-          MPI_Info info;
-          int      ierr = MPI_Info_create(&info);
-          AssertThrowMPI(ierr);
+          MPI_Info info = create_io_info();
+          int      ierr;
 
           MPI_File fh;
           ierr = MPI_File_open(mpi_communicator,
@@ -1886,30 +1938,32 @@ namespace parallel
           // Write sizes of each cell into file simultaneously.
           {
             const int *data = src_sizes_variable.data();
-            ierr =
-              MPI_File_write_at(fh,
-                                parallel_forest->global_first_quadrant[myrank] *
-                                  sizeof(int), // global position in file
-                                DEAL_II_MPI_CONST_CAST(data),
-                                src_sizes_variable.size(), // local buffer
-                                MPI_INT,
-                                MPI_STATUS_IGNORE);
+            ierr = MPI_File_write_at_all(
+              fh,
+              parallel_forest->global_first_quadrant[myrank] *
+                sizeof(int), // global position in file
+              DEAL_II_MPI_CONST_CAST(data),
+              src_sizes_variable.size(), // local buffer
+              MPI_INT,
+              MPI_STATUS_IGNORE);
             AssertThrowMPI(ierr);
           }
 
 
-          const unsigned int offset_variable =
+          const MPI_Offset offset_variable =
             parallel_forest->global_num_quadrants * sizeof(int);
 
           // Gather size of data in bytes we want to store from this processor.
-          const unsigned int size_on_proc = src_data_variable.size();
+          // The sum over all processors easily exceeds the range of 32 bit
+          // integers for large checkpoints, so use 64 bit offsets.
+          const std::uint64_t size_on_proc = src_data_variable.size();
 
           // Compute prefix sum
-          unsigned int prefix_sum = 0;
+          std::uint64_t prefix_sum = 0;
           ierr = MPI_Exscan(DEAL_II_MPI_CONST_CAST(&size_on_proc),
                             &prefix_sum,
                             1,
-                            MPI_UNSIGNED,
+                            MPI_UINT64_T,
                             MPI_SUM,
                             mpi_communicator);
           AssertThrowMPI(ierr);
@@ -1917,13 +1971,13 @@ namespace parallel
           const char *data = src_data_variable.data();
 
           // Write data consecutively into file.
-          ierr = MPI_File_write_at(fh,
-                                   offset_variable +
-                                     prefix_sum, // global position in file
-                                   DEAL_II_MPI_CONST_CAST(data),
-                                   src_data_variable.size(), // local buffer
-                                   MPI_CHAR,
-                                   MPI_STATUS_IGNORE);
+          ierr = MPI_File_write_at_all(fh,
+                                       offset_variable +
+                                         prefix_sum, // global position in file
+                                       DEAL_II_MPI_CONST_CAST(data),
+                                       src_data_variable.size(), // local buffer
+                                       MPI_CHAR,
+                                       MPI_STATUS_IGNORE);
           AssertThrowMPI(ierr);
 
           ierr = MPI_File_close(&fh);
@@ -1959,9 +2013,8 @@ namespace parallel
       {
         const std::string fname_fixed = std::string(filename) + "_fixed.data";
 
-        MPI_Info info;
-        int      ierr = MPI_Info_create(&info);
-        AssertThrowMPI(ierr);
+        MPI_Info info = create_io_info();
+        int      ierr;
 
         MPI_File fh;
         ierr = MPI_File_open(mpi_communicator,
@@ -1983,12 +2036,12 @@ namespace parallel
         // the file.
         sizes_fixed_cumulative.resize(1 + n_attached_deserialize_fixed +
                                       (variable_size_data_stored ? 1 : 0));
-        ierr = MPI_File_read_at(fh,
-                                0,
-                                sizes_fixed_cumulative.data(),
-                                sizes_fixed_cumulative.size(),
-                                MPI_UNSIGNED,
-                                MPI_STATUS_IGNORE);
+        ierr = MPI_File_read_at_all(fh,
+                                    0,
+                                    sizes_fixed_cumulative.data(),
+                                    sizes_fixed_cumulative.size(),
+                                    MPI_UNSIGNED,
+                                    MPI_STATUS_IGNORE);
         AssertThrowMPI(ierr);
 
         // Allocate sufficient memory.
@@ -1999,7 +2052,7 @@ namespace parallel
         const unsigned int offset =
           sizes_fixed_cumulative.size() * sizeof(unsigned int);
 
-        ierr = MPI_File_read_at(
+        ierr = MPI_File_read_at_all(
           fh,
           offset + parallel_forest->global_first_quadrant[myrank] *
                      sizes_fixed_cumulative.back(), // global position in file
@@ -2021,9 +2074,8 @@ namespace parallel
           const std::string fname_variable =
             std::string(filename) + "_variable.data";
 
-          MPI_Info info;
-          int      ierr = MPI_Info_create(&info);
-          AssertThrowMPI(ierr);
+          MPI_Info info = create_io_info();
+          int      ierr;
 
           MPI_File fh;
           ierr = MPI_File_open(mpi_communicator,
@@ -2038,41 +2090,40 @@ namespace parallel
 
           // Read sizes of all locally owned cells.
           dest_sizes_variable.resize(parallel_forest->local_num_quadrants);
-          ierr =
-            MPI_File_read_at(fh,
-                             parallel_forest->global_first_quadrant[myrank] *
-                               sizeof(int),
-                             dest_sizes_variable.data(),
-                             dest_sizes_variable.size(),
-                             MPI_INT,
-                             MPI_STATUS_IGNORE);
+          ierr = MPI_File_read_at_all(
+            fh,
+            parallel_forest->global_first_quadrant[myrank] * sizeof(int),
+            dest_sizes_variable.data(),
+            dest_sizes_variable.size(),
+            MPI_INT,
+            MPI_STATUS_IGNORE);
           AssertThrowMPI(ierr);
 
-          const unsigned int offset =
+          const MPI_Offset offset =
             parallel_forest->global_num_quadrants * sizeof(int);
 
-          const unsigned int size_on_proc =
+          const std::uint64_t size_on_proc =
             std::accumulate(dest_sizes_variable.begin(),
                             dest_sizes_variable.end(),
-                            0);
+                            std::uint64_t(0));
 
           // share information among all processors by prefix sum
-          unsigned int prefix_sum = 0;
+          std::uint64_t prefix_sum = 0;
           ierr = MPI_Exscan(DEAL_II_MPI_CONST_CAST(&size_on_proc),
                             &prefix_sum,
                             1,
-                            MPI_UNSIGNED,
+                            MPI_UINT64_T,
                             MPI_SUM,
                             mpi_communicator);
           AssertThrowMPI(ierr);
 
           dest_data_variable.resize(size_on_proc);
-          ierr = MPI_File_read_at(fh,
-                                  offset + prefix_sum,
-                                  dest_data_variable.data(),
-                                  dest_data_variable.size(),
-                                  MPI_CHAR,
-                                  MPI_STATUS_IGNORE);
+          ierr = MPI_File_read_at_all(fh,
+                                      offset + prefix_sum,
+                                      dest_data_variable.data(),
+                                      dest_data_variable.size(),
+                                      MPI_CHAR,
+                                      MPI_STATUS_IGNORE);
           AssertThrowMPI(ierr);
 
           ierr = MPI_File_close(&fh);
@@ -2142,6 +2193,8 @@ namespace parallel
       , parallel_forest(nullptr)
       , cell_attached_data({0, 0, {}, {}})
       , data_transfer(mpi_communicator)
+      , repartition_tolerance(0.)
+      , n_ghost_cell_layers(1)
     {
       parallel_ghost = nullptr;
     }
@@ -2748,6 +2801,16 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::set_checkpoint_io_aggregators(
+      const unsigned int n_aggregators_per_node)
+    {
+      data_transfer.set_n_io_aggregators_per_node(n_aggregators_per_node);
+    }
+
+
+
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::load(const std::string &filename,
@@ -3522,6 +3585,11 @@ namespace parallel
 
       Assert(parallel_ghost, ExcInternalError());
 
+      // add the additional layers of ghost cells, if requested
+      for (unsigned int layer = 1; layer < n_ghost_cell_layers; ++layer)
+        dealii::internal::p4est::functions<dim>::ghost_expand(parallel_forest,
+                                                              parallel_ghost);
+
 
       // set all cells to artificial. we will later set it to the correct
       // subdomain in match_tree_recursively
@@ -3935,33 +4003,41 @@ namespace parallel
           // partition the new mesh between all processors. If cell weights have
           // not been given balance the number of cells.
           if (this->signals.cell_weight.num_slots() == 0)
-            dealii::internal::p4est::functions<dim>::partition(
-              parallel_forest,
-              /* prepare coarsening */ 1,
-              /* weight_callback */ nullptr);
+            {
+              if (!partition_is_balanced({}))
+                dealii::internal::p4est::functions<dim>::partition(
+                  parallel_forest,
+                  /* prepare coarsening */ 1,
+                  /* weight_callback */ nullptr);
+            }
           else
             {
               // get cell weights for a weighted repartitioning.
               const std::vector<unsigned int> cell_weights = get_cell_weights();
 
-              PartitionWeights<dim, spacedim> partition_weights(cell_weights);
-
-              // attach (temporarily) a pointer to the cell weights through
-              // p4est's user_pointer object
-              Assert(parallel_forest->user_pointer == this, ExcInternalError());
-              parallel_forest->user_pointer = &partition_weights;
+              if (!partition_is_balanced(cell_weights))
+                {
+                  PartitionWeights<dim, spacedim> partition_weights(
+                    cell_weights);
 
-              dealii::internal::p4est::functions<dim>::partition(
-                parallel_forest,
-                /* prepare coarsening */ 1,
-                /* weight_callback */
-                &PartitionWeights<dim, spacedim>::cell_weight);
+                  // attach (temporarily) a pointer to the cell weights
+                  // through p4est's user_pointer object
+                  Assert(parallel_forest->user_pointer == this,
+                         ExcInternalError());
+                  parallel_forest->user_pointer = &partition_weights;
 
-              // release data
-              dealii::internal::p4est::functions<dim>::reset_data(
-                parallel_forest, 0, nullptr, nullptr);
-              // reset the user pointer to its previous state
-              parallel_forest->user_pointer = this;
+                  dealii::internal::p4est::functions<dim>::partition(
+                    parallel_forest,
+                    /* prepare coarsening */ 1,
+                    /* weight_callback */
+                    &PartitionWeights<dim, spacedim>::cell_weight);
+
+                  // release data
+                  dealii::internal::p4est::functions<dim>::reset_data(
+                    parallel_forest, 0, nullptr, nullptr);
+                  // reset the user pointer to its previous state
+                  parallel_forest->user_pointer = this;
+                }
             }
         }
 
@@ -4109,31 +4185,35 @@ namespace parallel
         {
           // no cell weights given -- call p4est's 'partition' without a
           // callback for cell weights
-          dealii::internal::p4est::functions<dim>::partition(
-            parallel_forest,
-            /* prepare coarsening */ 1,
-            /* weight_callback */ nullptr);
+          if (!partition_is_balanced({}))
+            dealii::internal::p4est::functions<dim>::partition(
+              parallel_forest,
+              /* prepare coarsening */ 1,
+              /* weight_callback */ nullptr);
         }
       else
         {
           // get cell weights for a weighted repartitioning.
           const std::vector<unsigned int> cell_weights = get_cell_weights();
 
-          PartitionWeights<dim, spacedim> partition_weights(cell_weights);
+          if (!partition_is_balanced(cell_weights))
+            {
+              PartitionWeights<dim, spacedim> partition_weights(cell_weights);
 
-          // attach (temporarily) a pointer to the cell weights through p4est's
-          // user_pointer object
-          Assert(parallel_forest->user_pointer == this, ExcInternalError());
-          parallel_forest->user_pointer = &partition_weights;
+              // attach (temporarily) a pointer to the cell weights through
+              // p4est's user_pointer object
+              Assert(parallel_forest->user_pointer == this, ExcInternalError());
+              parallel_forest->user_pointer = &partition_weights;
 
-          dealii::internal::p4est::functions<dim>::partition(
-            parallel_forest,
-            /* prepare coarsening */ 1,
-            /* weight_callback */
-            &PartitionWeights<dim, spacedim>::cell_weight);
+              dealii::internal::p4est::functions<dim>::partition(
+                parallel_forest,
+                /* prepare coarsening */ 1,
+                /* weight_callback */
+                &PartitionWeights<dim, spacedim>::cell_weight);
 
-          // reset the user pointer to its previous state
-          parallel_forest->user_pointer = this;
+              // reset the user pointer to its previous state
+              parallel_forest->user_pointer = this;
+            }
         }
 
       try
@@ -4483,6 +4563,53 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+    Triangulation<dim, spacedim>::compute_ghost_ranks_of_locally_owned_cells()
+      const
+    {
+      // for a ghost layer of one cell, the vertices of a cell tell us where
+      // it is a ghost cell, also across periodic boundaries
+      if (n_ghost_cell_layers == 1)
+        return dealii::parallel::TriangulationBase<dim, spacedim>::
+          compute_ghost_ranks_of_locally_owned_cells();
+
+      Assert(parallel_ghost != nullptr, ExcInternalError());
+
+      // otherwise, walk through the mirror quadrants p4est has determined
+      // for each process and find the deal.II cells they correspond to
+      std::map<unsigned int, std::set<dealii::types::subdomain_id>> result;
+      for (int rank = 0; rank < parallel_ghost->mpisize; ++rank)
+        for (auto m = parallel_ghost->mirror_proc_offsets[rank];
+             m < parallel_ghost->mirror_proc_offsets[rank + 1];
+             ++m)
+          {
+            const auto *mirror = static_cast<
+              const typename dealii::internal::p4est::types<dim>::quadrant *>(
+              sc_array_index(&parallel_ghost->mirrors,
+                             parallel_ghost->mirror_proc_mirrors[m]));
+
+            // descend from the coarse cell of the tree of the quadrant along
+            // the child indices of its ancestors
+            typename dealii::Triangulation<dim, spacedim>::cell_iterator cell(
+              this,
+              0,
+              p4est_tree_to_coarse_cell_permutation[mirror->p.piggy3
+                                                      .which_tree]);
+            for (int level = 1; level <= mirror->level; ++level)
+              cell = cell->child(
+                dealii::internal::p4est::functions<dim>::quadrant_ancestor_id(
+                  mirror, level));
+
+            Assert(cell->is_locally_owned(), ExcInternalError());
+            result[cell->active_cell_index()].insert(rank);
+          }
+
+      return result;
+    }
+
+
+
     template <int dim, int spacedim>
     std::vector<bool>
     Triangulation<dim, spacedim>::mark_locally_active_vertices_on_level(
@@ -4780,6 +4907,25 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::add_memory_consumption(
+      MemoryReport &     report,
+      const std::string &name) const
+    {
+      dealii::Triangulation<dim, spacedim>::add_memory_consumption(report,
+                                                                   name);
+
+      const std::size_t p4est_memory = memory_consumption_p4est();
+      report.add(name + "/p4est", p4est_memory);
+      report.add(name + "/other",
+                 memory_consumption() -
+                   dealii::Triangulation<dim, spacedim>::memory_consumption() -
+                   p4est_memory);
+    }
+
+
+
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::copy_triangulation(
@@ -4884,6 +5030,70 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::set_repartition_tolerance(
+      const double tolerance)
+    {
+      Assert(tolerance >= 0.,
+             ExcMessage("The tolerance for the imbalance of the partition "
+                        "must not be negative."));
+      repartition_tolerance = tolerance;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::set_n_ghost_layers(
+      const unsigned int n_layers)
+    {
+      Assert(n_layers >= 1,
+             ExcMessage("The ghost layer must be at least one cell wide."));
+      Assert(this->n_levels() == 0,
+             ExcMessage("The number of ghost layers has to be set before "
+                        "the coarse mesh is created."));
+      n_ghost_cell_layers = n_layers;
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    Triangulation<dim, spacedim>::n_ghost_layers() const
+    {
+      return n_ghost_cell_layers;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    Triangulation<dim, spacedim>::partition_is_balanced(
+      const std::vector<unsigned int> &cell_weights) const
+    {
+      // without a tolerance, always repartition and avoid the communication
+      if (repartition_tolerance == 0.)
+        return false;
+
+      // the load of this process is the sum of the weights that p4est would
+      // balance, or the number of quadrants if no weights are given
+      const double local_load =
+        cell_weights.empty() ?
+          static_cast<double>(parallel_forest->local_num_quadrants) :
+          std::accumulate(cell_weights.begin(), cell_weights.end(), 0.);
+
+      const double max_load =
+        Utilities::MPI::max(local_load, this->mpi_communicator);
+      const double average_load =
+        Utilities::MPI::sum(local_load, this->mpi_communicator) /
+        Utilities::MPI::n_mpi_processes(this->mpi_communicator);
+
+      return max_load <= (1. + repartition_tolerance) * average_load;
+    }
+
+
+
     template <int dim, int spacedim>
     std::vector<unsigned int>
     Triangulation<dim, spacedim>::get_cell_weights() const
@@ -5107,6 +5317,34 @@ namespace parallel
 
 
 
+    template <int spacedim>
+    void
+    Triangulation<1, spacedim>::set_repartition_tolerance(const double)
+    {
+      Assert(false, ExcNotImplemented());
+    }
+
+
+
+    template <int spacedim>
+    void
+    Triangulation<1, spacedim>::set_n_ghost_layers(const unsigned int)
+    {
+      Assert(false, ExcNotImplemented());
+    }
+
+
+
+    template <int spacedim>
+    void
+    Triangulation<1, spacedim>::set_checkpoint_io_aggregators(
+      const unsigned int)
+    {
+      Assert(false, ExcNotImplemented());
+    }
+
+
+
     template <int spacedim>
     bool
     Triangulation<1, spacedim>::is_multilevel_hierarchy_constructed() const
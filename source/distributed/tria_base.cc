@@ -392,6 +392,36 @@ namespace parallel
     return result;
   }
 
+
+
+  template <int dim, int spacedim>
+  std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+  TriangulationBase<dim, spacedim>::compute_ghost_ranks_of_locally_owned_cells()
+    const
+  {
+    const std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+      vertices_with_ghost_neighbors =
+        this->compute_vertices_with_ghost_neighbors();
+
+    std::map<unsigned int, std::set<dealii::types::subdomain_id>> result;
+    for (const auto &cell : this->active_cell_iterators())
+      if (cell->is_locally_owned())
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            const auto neighbor_subdomains_of_vertex =
+              vertices_with_ghost_neighbors.find(cell->vertex_index(v));
+            if (neighbor_subdomains_of_vertex !=
+                vertices_with_ghost_neighbors.end())
+              result[cell->active_cell_index()].insert(
+                neighbor_subdomains_of_vertex->second.begin(),
+                neighbor_subdomains_of_vertex->second.end());
+          }
+
+    return result;
+  }
+
+
+
   template <int dim, int spacedim>
   DistributedTriangulationBase<dim, spacedim>::DistributedTriangulationBase(
     MPI_Comm mpi_communicator,
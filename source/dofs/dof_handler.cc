@@ -15,10 +15,13 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/memory_report.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
+#include <deal.II/distributed/tria_base.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_faces.h>
@@ -614,6 +617,66 @@ namespace internal
 
 
 
+      /**
+       * Fill the cache of level DoF indices on the given level for all cells
+       * that are not artificial on this level. The cells are processed in
+       * parallel; each of them only writes into its own part of the cache.
+       */
+      template <int dim, int spacedim>
+      static void
+      update_mg_cell_dof_indices_cache(DoFHandler<dim, spacedim> &dof_handler,
+                                       const unsigned int         level)
+      {
+        AssertIndexRange(level, dof_handler.mg_levels.size());
+
+        const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+        const unsigned int n_raw_cells =
+          dof_handler.get_triangulation().n_raw_cells(level);
+
+        std::vector<types::global_dof_index> &cache =
+          dof_handler.mg_levels[level]->cell_dof_indices_cache;
+        cache.clear();
+        if (dofs_per_cell == 0)
+          return;
+
+        std::vector<types::global_dof_index> new_cache(
+          static_cast<std::size_t>(n_raw_cells) * dofs_per_cell,
+          numbers::invalid_dof_index);
+
+        parallel::apply_to_subranges(
+          0U,
+          n_raw_cells,
+          [&](const unsigned int begin, const unsigned int end) {
+            std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+            for (unsigned int index = begin; index < end; ++index)
+              {
+                const typename DoFHandler<dim, spacedim>::level_cell_iterator
+                  cell(&dof_handler.get_triangulation(),
+                       level,
+                       index,
+                       &dof_handler);
+                if (!cell->used() ||
+                    cell->level_subdomain_id() ==
+                      numbers::artificial_subdomain_id)
+                  continue;
+
+                // read the indices from the vertices, lines, faces, and the
+                // interior of the cell since the cache is not set yet
+                cell->DoFAccessor<dim, DoFHandler<dim, spacedim>, true>::
+                  get_mg_dof_indices(level, dof_indices);
+                std::copy(dof_indices.begin(),
+                          dof_indices.end(),
+                          new_cache.begin() +
+                            static_cast<std::size_t>(index) * dofs_per_cell);
+              }
+          },
+          64);
+
+        cache.swap(new_cache);
+      }
+
+
+
       template <int spacedim>
       static types::global_dof_index
       get_dof_index(
@@ -855,7 +918,7 @@ DoFHandler<dim, spacedim>::DoFHandler(const Triangulation<dim, spacedim> &tria)
                                ParallelShared<DoFHandler<dim, spacedim>>>(
         *this);
   else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(
+             const parallel::DistributedTriangulationBase<dim, spacedim> *>(
              &tria) == nullptr)
     policy =
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
@@ -907,8 +970,8 @@ DoFHandler<dim, spacedim>::initialize(const Triangulation<dim, spacedim> &t,
                                ParallelShared<DoFHandler<dim, spacedim>>>(
         *this);
   else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(&t) !=
-           nullptr)
+             const parallel::DistributedTriangulationBase<dim, spacedim> *>(
+             &t) != nullptr)
     policy =
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                ParallelDistributed<DoFHandler<dim, spacedim>>>(
@@ -1197,6 +1260,43 @@ DoFHandler<dim, spacedim>::memory_consumption() const
 
 
 
+template <int dim, int spacedim>
+void
+DoFHandler<dim, spacedim>::add_memory_consumption(
+  MemoryReport &     report,
+  const std::string &name) const
+{
+  std::size_t active_memory =
+    MemoryConsumption::memory_consumption(levels) +
+    MemoryConsumption::memory_consumption(vertex_dofs);
+  for (unsigned int i = 0; i < levels.size(); ++i)
+    active_memory += MemoryConsumption::memory_consumption(*levels[i]);
+  report.add(name + "/cell and vertex dofs", active_memory);
+
+  const std::size_t face_memory =
+    faces ? MemoryConsumption::memory_consumption(*faces) : 0;
+  report.add(name + "/face dofs", face_memory);
+
+  std::size_t mg_memory =
+    MemoryConsumption::memory_consumption(mg_number_cache);
+  for (unsigned int level = 0; level < mg_levels.size(); ++level)
+    mg_memory += mg_levels[level]->memory_consumption();
+  if (mg_faces != nullptr)
+    mg_memory += MemoryConsumption::memory_consumption(*mg_faces);
+  for (unsigned int i = 0; i < mg_vertex_dofs.size(); ++i)
+    mg_memory += sizeof(MGVertexDoFs) +
+                 (1 + mg_vertex_dofs[i].get_finest_level() -
+                  mg_vertex_dofs[i].get_coarsest_level()) *
+                   sizeof(types::global_dof_index);
+  report.add(name + "/multigrid dofs", mg_memory);
+
+  report.add(name + "/other",
+             DoFHandler<dim, spacedim>::memory_consumption() - active_memory -
+               face_memory - mg_memory);
+}
+
+
+
 template <int dim, int spacedim>
 void
 DoFHandler<dim, spacedim>::set_fe(const FiniteElement<dim, spacedim> &ff)
@@ -1251,7 +1351,8 @@ DoFHandler<dim, spacedim>::distribute_dofs(
   // only if this is a sequential
   // triangulation. it doesn't work
   // correctly yet if it is parallel
-  if (dynamic_cast<const parallel::distributed::Triangulation<dim, spacedim> *>(
+  if (dynamic_cast<
+        const parallel::DistributedTriangulationBase<dim, spacedim> *>(
         &*tria) == nullptr)
     block_info_object.initialize(*this, false, true);
 }
@@ -1289,6 +1390,10 @@ DoFHandler<dim, spacedim>::distribute_mg_dofs()
   internal::DoFHandlerImplementation::Implementation::reserve_space_mg(*this);
   mg_number_cache = policy->distribute_mg_dofs();
 
+  for (unsigned int level = 0; level < mg_levels.size(); ++level)
+    internal::DoFHandlerImplementation::Implementation::
+      update_mg_cell_dof_indices_cache(*this, level);
+
   // initialize the block info object
   // only if this is a sequential
   // triangulation. it doesn't work
@@ -1353,7 +1458,7 @@ DoFHandler<dim, spacedim>::renumber_dofs(
              ExcMessage("Incorrect size of the input array."));
     }
   else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(
+             const parallel::DistributedTriangulationBase<dim, spacedim> *>(
              &*tria) != nullptr)
     {
       AssertDimension(new_numbers.size(), n_locally_owned_dofs());
@@ -1427,7 +1532,12 @@ DoFHandler<dim, spacedim>::renumber_dofs(
                "New DoF index is not less than the total number of dofs."));
 #endif
 
+  // the cache is outdated by the renumbering, so don't let the policy
+  // read from it
+  mg_levels[level]->cell_dof_indices_cache.clear();
   mg_number_cache[level] = policy->renumber_mg_dofs(level, new_numbers);
+  internal::DoFHandlerImplementation::Implementation::
+    update_mg_cell_dof_indices_cache(*this, level);
 }
 
 
@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -2420,6 +2421,38 @@ namespace internal
         /* --------------------- renumber_dofs functionality ---------------- */
 
 
+        /**
+         * Apply the renumbering @p new_numbers to all valid entries of the
+         * array @p dof_indices, which stores the DoF indices of all objects of
+         * one kind (vertices, lines, quads, or cells). Since the entries are
+         * independent of each other, they are renumbered in parallel.
+         *
+         * See renumber_dofs() for the meaning of the arguments.
+         */
+        static void
+        renumber_dof_indices(
+          const std::vector<types::global_dof_index> &new_numbers,
+          const IndexSet &                            indices_we_care_about,
+          std::vector<types::global_dof_index> &      dof_indices)
+        {
+          parallel::apply_to_subranges(
+            std::size_t(0),
+            dof_indices.size(),
+            [&](const std::size_t begin, const std::size_t end) {
+              for (std::size_t i = begin; i < end; ++i)
+                if (dof_indices[i] != numbers::invalid_dof_index)
+                  dof_indices[i] =
+                    (indices_we_care_about.size() == 0) ?
+                      new_numbers[dof_indices[i]] :
+                      new_numbers[indices_we_care_about.index_within_set(
+                        dof_indices[i])];
+            },
+            4096);
+        }
+
+
+
+
         /**
          * The part of the renumber_dofs() functionality that is dimension
          * independent because it renumbers the DoF indices on vertices
@@ -2441,21 +2474,22 @@ namespace internal
           // correct but also faster; note, however, that dof numbers
           // may be invalid_dof_index, namely when the appropriate
           // vertex/line/etc is unused
-          for (std::vector<types::global_dof_index>::iterator i =
-                 dof_handler.vertex_dofs.begin();
-               i != dof_handler.vertex_dofs.end();
-               ++i)
-            if (*i != numbers::invalid_dof_index)
-              *i = (indices_we_care_about.size() == 0) ?
-                     (new_numbers[*i]) :
-                     (new_numbers[indices_we_care_about.index_within_set(*i)]);
-            else if (check_validity)
-              // if index is invalid_dof_index: check if this one
-              // really is unused
-              Assert(dof_handler.get_triangulation().vertex_used(
-                       (i - dof_handler.vertex_dofs.begin()) /
-                       dof_handler.get_fe().dofs_per_vertex) == false,
-                     ExcInternalError());
+          if (check_validity)
+            for (std::vector<types::global_dof_index>::iterator i =
+                   dof_handler.vertex_dofs.begin();
+                 i != dof_handler.vertex_dofs.end();
+                 ++i)
+              if (*i == numbers::invalid_dof_index)
+                // if index is invalid_dof_index: check if this one
+                // really is unused
+                Assert(dof_handler.get_triangulation().vertex_used(
+                         (i - dof_handler.vertex_dofs.begin()) /
+                         dof_handler.get_fe().dofs_per_vertex) == false,
+                       ExcInternalError());
+
+          renumber_dof_indices(new_numbers,
+                               indices_we_care_about,
+                               dof_handler.vertex_dofs);
         }
 
 
@@ -2476,15 +2510,9 @@ namespace internal
         {
           for (unsigned int level = 0; level < dof_handler.levels.size();
                ++level)
-            for (std::vector<types::global_dof_index>::iterator i =
-                   dof_handler.levels[level]->dof_object.dofs.begin();
-                 i != dof_handler.levels[level]->dof_object.dofs.end();
-                 ++i)
-              if (*i != numbers::invalid_dof_index)
-                *i =
-                  ((indices_we_care_about.size() == 0) ?
-                     new_numbers[*i] :
-                     new_numbers[indices_we_care_about.index_within_set(*i)]);
+            renumber_dof_indices(new_numbers,
+                                 indices_we_care_about,
+                                 dof_handler.levels[level]->dof_object.dofs);
         }
 
 
@@ -2516,14 +2544,9 @@ namespace internal
           DoFHandler<2, spacedim> &                   dof_handler)
         {
           // treat dofs on lines
-          for (std::vector<types::global_dof_index>::iterator i =
-                 dof_handler.faces->lines.dofs.begin();
-               i != dof_handler.faces->lines.dofs.end();
-               ++i)
-            if (*i != numbers::invalid_dof_index)
-              *i = ((indices_we_care_about.size() == 0) ?
-                      new_numbers[*i] :
-                      new_numbers[indices_we_care_about.index_within_set(*i)]);
+          renumber_dof_indices(new_numbers,
+                               indices_we_care_about,
+                               dof_handler.faces->lines.dofs);
         }
 
 
@@ -2536,24 +2559,14 @@ namespace internal
           DoFHandler<3, spacedim> &                   dof_handler)
         {
           // treat dofs on lines
-          for (std::vector<types::global_dof_index>::iterator i =
-                 dof_handler.faces->lines.dofs.begin();
-               i != dof_handler.faces->lines.dofs.end();
-               ++i)
-            if (*i != numbers::invalid_dof_index)
-              *i = ((indices_we_care_about.size() == 0) ?
-                      new_numbers[*i] :
-                      new_numbers[indices_we_care_about.index_within_set(*i)]);
+          renumber_dof_indices(new_numbers,
+                               indices_we_care_about,
+                               dof_handler.faces->lines.dofs);
 
           // treat dofs on quads
-          for (std::vector<types::global_dof_index>::iterator i =
-                 dof_handler.faces->quads.dofs.begin();
-               i != dof_handler.faces->quads.dofs.end();
-               ++i)
-            if (*i != numbers::invalid_dof_index)
-              *i = ((indices_we_care_about.size() == 0) ?
-                      new_numbers[*i] :
-                      new_numbers[indices_we_care_about.index_within_set(*i)]);
+          renumber_dof_indices(new_numbers,
+                               indices_we_care_about,
+                               dof_handler.faces->quads.dofs);
         }
 
 
@@ -5134,20 +5147,17 @@ namespace internal
               triangulation->compute_vertices_with_ghost_neighbors();
 
           // mark all cells that either have to send data (locally
-          // owned cells that are adjacent to ghost neighbors in some
-          // way) or receive data (all ghost cells) via the user flags
+          // owned cells that are ghost cells on other processors) or
+          // receive data (all ghost cells) via the user flags
+          const std::map<unsigned int, std::set<dealii::types::subdomain_id>>
+            ghost_ranks_of_cells =
+              triangulation->compute_ghost_ranks_of_locally_owned_cells();
           for (const auto &cell : dof_handler->active_cell_iterators())
             if (cell->is_locally_owned())
               {
-                for (unsigned int v = 0;
-                     v < GeometryInfo<dim>::vertices_per_cell;
-                     ++v)
-                  if (vertices_with_ghost_neighbors.find(cell->vertex_index(
-                        v)) != vertices_with_ghost_neighbors.end())
-                    {
-                      cell->set_user_flag();
-                      break;
-                    }
+                if (ghost_ranks_of_cells.find(cell->active_cell_index()) !=
+                    ghost_ranks_of_cells.end())
+                  cell->set_user_flag();
               }
             else if (cell->is_ghost())
               cell->set_user_flag();
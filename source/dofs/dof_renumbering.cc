@@ -13,6 +13,8 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_management.h>
@@ -40,6 +42,8 @@
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/sparsity_tools.h>
 
+#include <deal.II/matrix_free/matrix_free.h>
+
 #include <deal.II/multigrid/mg_tools.h>
 
 #include <boost/config.hpp>
@@ -851,16 +855,25 @@ namespace DoFRenumbering
     // into the first one. The same
     // holds if several components were
     // joined into a single target.
-    for (unsigned int component = 0; component < fe_collection.n_components();
-         ++component)
-      {
-        std::sort(component_to_dof_map[component].begin(),
-                  component_to_dof_map[component].end());
-        component_to_dof_map[component].erase(
-          std::unique(component_to_dof_map[component].begin(),
-                      component_to_dof_map[component].end()),
-          component_to_dof_map[component].end());
-      }
+    //
+    // the buckets are independent of each other, so they are processed in
+    // parallel
+    parallel::apply_to_subranges(
+      0U,
+      fe_collection.n_components(),
+      [&component_to_dof_map](const unsigned int begin,
+                              const unsigned int end) {
+        for (unsigned int component = begin; component < end; ++component)
+          {
+            std::sort(component_to_dof_map[component].begin(),
+                      component_to_dof_map[component].end());
+            component_to_dof_map[component].erase(
+              std::unique(component_to_dof_map[component].begin(),
+                          component_to_dof_map[component].end()),
+              component_to_dof_map[component].end());
+          }
+      },
+      1);
 
     // calculate the number of locally owned
     // DoFs per bucket
@@ -2262,6 +2275,115 @@ namespace DoFRenumbering
            ExcInternalError());
   }
 
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                   dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.n_locally_owned_dofs(), numbers::invalid_dof_index);
+    compute_matrix_free_data_locality(renumbering, dof_handler, matrix_free);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &              new_dof_indices,
+    const DoFHandler<dim> &                             dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    Assert(matrix_free.indices_initialized(),
+           ExcMessage("You need to set up the indices in MatrixFree to be "
+                      "able to compute a renumbering!"));
+
+    // find the given DoFHandler among the ones stored in MatrixFree
+    unsigned int component = 0;
+    for (; component < matrix_free.n_components(); ++component)
+      if (&matrix_free.get_dof_handler(component) == &dof_handler)
+        break;
+    Assert(component < matrix_free.n_components(),
+           ExcMessage("The renumbering only works when the DoFHandler passed "
+                      "to this function has also been used to set up the "
+                      "MatrixFree object."));
+
+    const IndexSet &owned_dofs = dof_handler.locally_owned_dofs();
+
+    const types::global_dof_index n_owned_dofs = owned_dofs.n_elements();
+    AssertDimension(new_dof_indices.size(), n_owned_dofs);
+
+    // Mark the locally owned degrees of freedom that are ghosts on other
+    // processes, i.e., the ones that appear in the import list of the vector
+    // partitioner of MatrixFree. The ranges in the import list are in the
+    // local numbering of the partitioner, which coincides with the position
+    // within the locally owned index set.
+    std::vector<bool> is_exported(n_owned_dofs, false);
+    for (const auto &range :
+         matrix_free.get_vector_partitioner(component)->import_indices())
+      for (unsigned int i = range.first; i < range.second; ++i)
+        is_exported[i] = true;
+
+    // Go through the cell batches in the order of the matrix-free cell loop
+    // and record the order in which the locally owned degrees of freedom are
+    // touched for the first time. We collect the two groups separately and
+    // merge them in the end.
+    std::vector<bool>                    touched(n_owned_dofs, false);
+    std::vector<types::global_dof_index> exported_order, local_order;
+    exported_order.reserve(matrix_free.get_vector_partitioner(component)
+                             ->n_import_indices());
+    local_order.reserve(n_owned_dofs);
+    std::vector<types::global_dof_index> cell_dofs;
+
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          const typename DoFHandler<dim>::cell_iterator dcell =
+            matrix_free.get_cell_iterator(cell, v, component);
+          Assert(dcell->active(),
+                 ExcMessage("This function only works for MatrixFree "
+                            "objects set up on the active cells."));
+
+          cell_dofs.resize(dcell->get_fe().dofs_per_cell);
+          dcell->get_dof_indices(cell_dofs);
+          for (const types::global_dof_index dof : cell_dofs)
+            {
+              const types::global_dof_index local_dof =
+                owned_dofs.index_within_set(dof);
+              if (local_dof != numbers::invalid_dof_index &&
+                  !touched[local_dof])
+                {
+                  touched[local_dof] = true;
+                  if (is_exported[local_dof])
+                    exported_order.push_back(local_dof);
+                  else
+                    local_order.push_back(local_dof);
+                }
+            }
+        }
+
+    // degrees of freedom not touched by any cell (which should not happen for
+    // usual elements) keep their relative order at the end of the range
+    for (types::global_dof_index i = 0; i < n_owned_dofs; ++i)
+      if (!touched[i])
+        local_order.push_back(i);
+
+    AssertDimension(exported_order.size() + local_order.size(), n_owned_dofs);
+
+    types::global_dof_index next_index = 0;
+    for (const types::global_dof_index i : exported_order)
+      new_dof_indices[i] = owned_dofs.nth_index_in_set(next_index++);
+    for (const types::global_dof_index i : local_order)
+      new_dof_indices[i] = owned_dofs.nth_index_in_set(next_index++);
+  }
+
 } // namespace DoFRenumbering
 
 
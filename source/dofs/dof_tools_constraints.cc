@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_management.h>
@@ -47,6 +48,7 @@
 #include <algorithm>
 #include <array>
 #include <memory>
+#include <mutex>
 #include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
@@ -298,6 +300,15 @@ namespace DoFTools
 
 
 
+      /**
+       * A mutex that guards the creation of the cached matrices and masks in
+       * the ensure_existence_of_*() functions below, which are called by
+       * several threads at the same time in make_hp_hanging_node_constraints().
+       */
+      std::mutex interpolation_matrix_cache_mutex;
+
+
+
       /**
        * Make sure that the mask exists that determines which dofs will be the
        * masters on refined faces where an fe1 and a fe2 meet.
@@ -310,6 +321,7 @@ namespace DoFTools
         const FullMatrix<double> &          face_interpolation_matrix,
         std::unique_ptr<std::vector<bool>> &master_dof_mask)
       {
+        std::lock_guard<std::mutex> lock(interpolation_matrix_cache_mutex);
         if (master_dof_mask == nullptr)
           {
             master_dof_mask =
@@ -335,6 +347,7 @@ namespace DoFTools
         const FiniteElement<dim, spacedim> & fe2,
         std::unique_ptr<FullMatrix<double>> &matrix)
       {
+        std::lock_guard<std::mutex> lock(interpolation_matrix_cache_mutex);
         if (matrix == nullptr)
           {
             matrix =
@@ -357,6 +370,7 @@ namespace DoFTools
         const unsigned int                   subface,
         std::unique_ptr<FullMatrix<double>> &matrix)
       {
+        std::lock_guard<std::mutex> lock(interpolation_matrix_cache_mutex);
         if (matrix == nullptr)
           {
             matrix =
@@ -387,6 +401,7 @@ namespace DoFTools
                  static_cast<signed int>(face_interpolation_matrix.n()),
                ExcInternalError());
 
+        std::lock_guard<std::mutex> lock(interpolation_matrix_cache_mutex);
         if (split_matrix == nullptr)
           {
             split_matrix = std_cxx14::make_unique<
@@ -546,10 +561,85 @@ namespace DoFTools
                 }
             }
       }
-
     } // namespace
 
 
+
+    /**
+     * The caches used by make_hp_hanging_node_constraints_on_cells() for
+     * the face and subface interpolation matrices between different (or
+     * the same) finite elements. We compute them only once, namely the
+     * first time they are needed, and then just reuse them.
+     */
+    template <int dim>
+    struct InterpolationMatrixCaches
+    {
+      explicit InterpolationMatrixCaches(const unsigned int n_fes)
+        : face_interpolation_matrices(n_fes, n_fes)
+        , subface_interpolation_matrices(
+            n_fes,
+            n_fes,
+            GeometryInfo<dim>::max_children_per_face)
+        , split_face_interpolation_matrices(n_fes, n_fes)
+        , master_dof_masks(n_fes, n_fes)
+      {}
+
+      Table<2, std::unique_ptr<FullMatrix<double>>> face_interpolation_matrices;
+      Table<3, std::unique_ptr<FullMatrix<double>>>
+        subface_interpolation_matrices;
+
+      /**
+       * The matrices that are split into their master and slave parts,
+       * and for which the master part is inverted. These two matrices are
+       * derived from the face interpolation matrix as described in the
+       * @ref hp_paper "hp paper".
+       */
+      Table<2,
+            std::unique_ptr<std::pair<FullMatrix<double>, FullMatrix<double>>>>
+        split_face_interpolation_matrices;
+
+      /**
+       * For each pair of finite elements, a mask that states which of the
+       * degrees of freedom on the coarse side of a refined face will act
+       * as master dofs.
+       */
+      Table<2, std::unique_ptr<std::vector<bool>>> master_dof_masks;
+    };
+
+
+
+    /**
+     * The constraints between the dofs on the two sides of a face, as
+     * computed by make_hp_hanging_node_constraints_on_cells(), before
+     * they are entered into an AffineConstraints object by
+     * filter_constraints().
+     */
+    struct FaceConstraints
+    {
+      std::vector<types::global_dof_index> master_dofs;
+      std::vector<types::global_dof_index> slave_dofs;
+      FullMatrix<double>                   face_constraints;
+    };
+
+
+
+    /**
+     * Append a copy of the given constraints to @p recorded_constraints.
+     */
+    void
+    record_constraints(
+      const std::vector<types::global_dof_index> &master_dofs,
+      const std::vector<types::global_dof_index> &slave_dofs,
+      const FullMatrix<double> &                  face_constraints,
+      std::vector<FaceConstraints> &              recorded_constraints)
+    {
+      recorded_constraints.emplace_back();
+      recorded_constraints.back().master_dofs      = master_dofs;
+      recorded_constraints.back().slave_dofs       = slave_dofs;
+      recorded_constraints.back().face_constraints = face_constraints;
+    }
+
+
     template <typename number>
     void
     make_hp_hanging_node_constraints(const dealii::DoFHandler<1> &,
@@ -1026,10 +1116,22 @@ namespace DoFTools
 
 
 
-    template <typename DoFHandlerType, typename number>
+    /**
+     * Compute the hanging node constraints on the faces of the cells with
+     * indices from @p begin to @p end in @p cells and append them to
+     * @p face_constraints, in the order in which the cells are visited. The
+     * caches of the interpolation matrices are shared between the threads
+     * calling this function for different ranges of cells.
+     */
+    template <typename DoFHandlerType>
     void
-    make_hp_hanging_node_constraints(const DoFHandlerType &     dof_handler,
-                                     AffineConstraints<number> &constraints)
+    make_hp_hanging_node_constraints_on_cells(
+      const DoFHandlerType &dof_handler,
+      const std::vector<typename DoFHandlerType::active_cell_iterator> &cells,
+      const unsigned int                                 begin,
+      const unsigned int                                 end,
+      InterpolationMatrixCaches<DoFHandlerType::dimension> &caches,
+      std::vector<FaceConstraints> &                        face_constraints)
     {
       // note: this function is going to be hard to understand if you haven't
       // read the hp paper. however, we try to follow the notation laid out
@@ -1051,39 +1153,23 @@ namespace DoFTools
       std::vector<types::global_dof_index> slave_dofs;
       std::vector<types::global_dof_index> scratch_dofs;
 
-      // caches for the face and subface interpolation matrices between
-      // different (or the same) finite elements. we compute them only once,
-      // namely the first time they are needed, and then just reuse them
-      Table<2, std::unique_ptr<FullMatrix<double>>> face_interpolation_matrices(
-        n_finite_elements(dof_handler), n_finite_elements(dof_handler));
-      Table<3, std::unique_ptr<FullMatrix<double>>>
-        subface_interpolation_matrices(
-          n_finite_elements(dof_handler),
-          n_finite_elements(dof_handler),
-          GeometryInfo<dim>::max_children_per_face);
-
-      // similarly have a cache for the matrices that are split into their
-      // master and slave parts, and for which the master part is inverted.
-      // these two matrices are derived from the face interpolation matrix
-      // as described in the @ref hp_paper "hp paper"
-      Table<2,
-            std::unique_ptr<std::pair<FullMatrix<double>, FullMatrix<double>>>>
-        split_face_interpolation_matrices(n_finite_elements(dof_handler),
-                                          n_finite_elements(dof_handler));
-
-      // finally, for each pair of finite elements, have a mask that states
-      // which of the degrees of freedom on the coarse side of a refined face
-      // will act as master dofs.
-      Table<2, std::unique_ptr<std::vector<bool>>> master_dof_masks(
-        n_finite_elements(dof_handler), n_finite_elements(dof_handler));
+      auto &face_interpolation_matrices = caches.face_interpolation_matrices;
+      auto &subface_interpolation_matrices =
+        caches.subface_interpolation_matrices;
+      auto &split_face_interpolation_matrices =
+        caches.split_face_interpolation_matrices;
+      auto &master_dof_masks = caches.master_dof_masks;
 
       // loop over all faces
       //
       // note that even though we may visit a face twice if the neighboring
       // cells are equally refined, we can only visit each face with hanging
       // nodes once
-      for (const auto &cell : dof_handler.active_cell_iterators())
+      for (unsigned int cell_index = begin; cell_index < end; ++cell_index)
         {
+          const typename DoFHandlerType::active_cell_iterator &cell =
+            cells[cell_index];
+
           // artificial cells can at best neighbor ghost cells, but we're not
           // interested in these interfaces
           if (cell->is_artificial())
@@ -1256,12 +1342,12 @@ namespace DoFTools
 
                             // Add constraints to global AffineConstraints
                             // object.
-                            filter_constraints(master_dofs,
+                            record_constraints(master_dofs,
                                                slave_dofs,
                                                *(subface_interpolation_matrices
                                                    [cell->active_fe_index()]
                                                    [subface_fe_index][c]),
-                                               constraints);
+                                               face_constraints);
                           } // loop over subfaces
 
                         break;
@@ -1396,10 +1482,10 @@ namespace DoFTools
                                         cell->get_fe().dofs_per_face -
                                           dominating_fe.dofs_per_face);
 
-                        filter_constraints(master_dofs,
+                        record_constraints(master_dofs,
                                            slave_dofs,
                                            constraint_matrix,
-                                           constraints);
+                                           face_constraints);
 
 
 
@@ -1458,10 +1544,10 @@ namespace DoFTools
                             cell->face(face)->child(sf)->get_dof_indices(
                               slave_dofs, subface_fe_index);
 
-                            filter_constraints(master_dofs,
+                            record_constraints(master_dofs,
                                                slave_dofs,
                                                constraint_matrix,
-                                               constraints);
+                                               face_constraints);
                           } // loop over subfaces
 
                         break;
@@ -1539,13 +1625,13 @@ namespace DoFTools
                                 [neighbor->active_fe_index()]);
 
                             // Add constraints to global constraint matrix.
-                            filter_constraints(
+                            record_constraints(
                               master_dofs,
                               slave_dofs,
                               *(face_interpolation_matrices
                                   [cell->active_fe_index()]
                                   [neighbor->active_fe_index()]),
-                              constraints);
+                              face_constraints);
 
                             break;
                           }
@@ -1707,10 +1793,10 @@ namespace DoFTools
                                             cell->get_fe().dofs_per_face -
                                               dominating_fe.dofs_per_face);
 
-                            filter_constraints(master_dofs,
+                            record_constraints(master_dofs,
                                                slave_dofs,
                                                constraint_matrix,
-                                               constraints);
+                                               face_constraints);
 
                             // now do the same for another FE this is pretty
                             // much the same we do above to resolve h-refinement
@@ -1744,10 +1830,10 @@ namespace DoFTools
                             cell->face(face)->get_dof_indices(
                               slave_dofs, neighbor->active_fe_index());
 
-                            filter_constraints(master_dofs,
+                            record_constraints(master_dofs,
                                                slave_dofs,
                                                constraint_matrix,
-                                               constraints);
+                                               face_constraints);
 
                             break;
                           }
@@ -1766,6 +1852,52 @@ namespace DoFTools
               }
         }
     }
+
+
+
+    template <typename DoFHandlerType, typename number>
+    void
+    make_hp_hanging_node_constraints(const DoFHandlerType &     dof_handler,
+                                     AffineConstraints<number> &constraints)
+    {
+      InterpolationMatrixCaches<DoFHandlerType::dimension> caches(
+        n_finite_elements(dof_handler));
+
+      // split the active cells into chunks that are worked on in parallel.
+      // every chunk records its constraints separately, and these are then
+      // entered into the AffineConstraints object in the order of the cells.
+      // since filter_constraints() skips dofs that are already constrained,
+      // this gives the same result as visiting all cells in a single loop
+      std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+      cells.reserve(dof_handler.get_triangulation().n_active_cells());
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        cells.push_back(cell);
+
+      const unsigned int n_cells  = cells.size();
+      const unsigned int n_chunks = std::max(
+        1U, std::min(4 * MultithreadInfo::n_threads(), n_cells / 256));
+
+      std::vector<std::vector<FaceConstraints>> chunk_constraints(n_chunks);
+      Threads::TaskGroup<void>                  tasks;
+      for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+        tasks += Threads::new_task([&, chunk]() {
+          make_hp_hanging_node_constraints_on_cells(
+            dof_handler,
+            cells,
+            static_cast<std::size_t>(chunk) * n_cells / n_chunks,
+            static_cast<std::size_t>(chunk + 1) * n_cells / n_chunks,
+            caches,
+            chunk_constraints[chunk]);
+        });
+      tasks.join_all();
+
+      for (const auto &recorded_constraints : chunk_constraints)
+        for (const FaceConstraints &face : recorded_constraints)
+          filter_constraints(face.master_dofs,
+                             face.slave_dofs,
+                             face.face_constraints,
+                             constraints);
+    }
   } // namespace internal
 
 
@@ -13,6 +13,8 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -41,6 +43,7 @@
 
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/compact_dynamic_sparsity_pattern.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/trilinos_sparsity_pattern.h>
@@ -209,6 +212,153 @@ namespace DoFTools
 
 
 
+  template <typename DoFHandlerType, typename number>
+  void
+  make_sparsity_pattern_threaded(
+    const DoFHandlerType &           dof,
+    SparsityPattern &                sparsity,
+    const AffineConstraints<number> &constraints,
+    const bool                       keep_constrained_dofs,
+    const types::subdomain_id        subdomain_id)
+  {
+    using size_type = types::global_dof_index;
+
+    const size_type n_dofs = dof.n_dofs();
+
+    // If we have a distributed::Triangulation only allow locally_owned
+    // subdomain. Not setting a subdomain is also okay, because we skip
+    // ghost cells in the loop below.
+    Assert((dof.get_triangulation().locally_owned_subdomain() ==
+            numbers::invalid_subdomain_id) ||
+             (subdomain_id == numbers::invalid_subdomain_id) ||
+             (subdomain_id ==
+              dof.get_triangulation().locally_owned_subdomain()),
+           ExcMessage(
+             "For parallel::distributed::Triangulation objects and "
+             "associated DoF handler objects, asking for any subdomain other "
+             "than the locally owned one does not make sense."));
+
+    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+    for (const auto &cell : dof.active_cell_iterators())
+      if (((subdomain_id == numbers::invalid_subdomain_id) ||
+           (subdomain_id == cell->subdomain_id())) &&
+          cell->is_locally_owned())
+        cells.push_back(cell);
+
+    // split the rows into contiguous blocks, several per thread to balance
+    // the work. each block is filled by exactly one task, so no two tasks
+    // ever write into the same row
+    const size_type rows_per_block =
+      std::max<size_type>((n_dofs + 4 * MultithreadInfo::n_threads() - 1) /
+                            (4 * MultithreadInfo::n_threads()),
+                          1);
+    const unsigned int n_blocks =
+      (n_dofs + rows_per_block - 1) / rows_per_block;
+
+    // first find out which blocks of rows each cell writes into. these are
+    // the ones of the degrees of freedom on the cell and of the degrees of
+    // freedom these are constrained to
+    std::vector<std::vector<unsigned int>> blocks_of_cell(cells.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<size_type> dofs_on_this_cell;
+        for (unsigned int c = begin; c < end; ++c)
+          {
+            dofs_on_this_cell.resize(cells[c]->get_fe().dofs_per_cell);
+            cells[c]->get_dof_indices(dofs_on_this_cell);
+
+            std::vector<unsigned int> &blocks = blocks_of_cell[c];
+            for (const size_type dof_index : dofs_on_this_cell)
+              {
+                blocks.push_back(dof_index / rows_per_block);
+                if (const auto *entries =
+                      constraints.get_constraint_entries(dof_index))
+                  for (const auto &entry : *entries)
+                    blocks.push_back(entry.first / rows_per_block);
+              }
+            std::sort(blocks.begin(), blocks.end());
+            blocks.erase(std::unique(blocks.begin(), blocks.end()),
+                         blocks.end());
+          }
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+
+    std::vector<std::vector<unsigned int>> cells_of_block(n_blocks);
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      for (const unsigned int block : blocks_of_cell[c])
+        cells_of_block[block].push_back(c);
+    blocks_of_cell.clear();
+
+    // then fill a dynamic sparsity pattern storing only the rows of the
+    // respective block for each block of rows. all entries of other rows are
+    // simply dropped by the dynamic sparsity pattern
+    std::vector<DynamicSparsityPattern> block_patterns(n_blocks);
+    std::vector<unsigned int>           row_lengths(n_dofs);
+    parallel::apply_to_subranges(
+      0U,
+      n_blocks,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<size_type> dofs_on_this_cell;
+        for (unsigned int block = begin; block < end; ++block)
+          {
+            const size_type first_row = block * rows_per_block;
+            const size_type last_row =
+              std::min(first_row + rows_per_block, n_dofs);
+
+            IndexSet rows(n_dofs);
+            rows.add_range(first_row, last_row);
+            block_patterns[block].reinit(n_dofs, n_dofs, rows);
+
+            for (const unsigned int c : cells_of_block[block])
+              {
+                dofs_on_this_cell.resize(cells[c]->get_fe().dofs_per_cell);
+                cells[c]->get_dof_indices(dofs_on_this_cell);
+
+                constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                        block_patterns[block],
+                                                        keep_constrained_dofs);
+              }
+
+            for (size_type row = first_row; row < last_row; ++row)
+              row_lengths[row] = block_patterns[block].row_length(row);
+          }
+      },
+      1);
+
+    // finally, allocate the sparsity pattern with the exact row lengths and
+    // copy the rows over, again in parallel over the blocks
+    sparsity.reinit(n_dofs, n_dofs, row_lengths);
+    parallel::apply_to_subranges(
+      0U,
+      n_blocks,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<size_type> columns;
+        for (unsigned int block = begin; block < end; ++block)
+          {
+            const size_type first_row = block * rows_per_block;
+            const size_type last_row =
+              std::min(first_row + rows_per_block, n_dofs);
+            for (size_type row = first_row; row < last_row; ++row)
+              {
+                columns.resize(row_lengths[row]);
+                for (unsigned int k = 0; k < row_lengths[row]; ++k)
+                  columns[k] = block_patterns[block].column_number(row, k);
+                sparsity.add_entries(row, columns.begin(), columns.end(), true);
+              }
+
+            // release the memory of this block as soon as possible
+            block_patterns[block].reinit(0, 0);
+          }
+      },
+      1);
+
+    sparsity.compress();
+  }
+
+
+
   template <typename DoFHandlerType, typename SparsityPatternType>
   void
   make_sparsity_pattern(const DoFHandlerType &dof_row,
@@ -44,6 +44,15 @@ FiniteElement<dim, spacedim>::InternalDataBase::InternalDataBase()
 
 
 
+template <int dim, int spacedim>
+bool
+FiniteElement<dim, spacedim>::InternalDataBase::is_read_only() const
+{
+  return false;
+}
+
+
+
 template <int dim, int spacedim>
 std::size_t
 FiniteElement<dim, spacedim>::InternalDataBase::memory_consumption() const
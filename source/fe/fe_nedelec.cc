@@ -106,17 +106,28 @@ FE_Nedelec<dim>::FE_Nedelec(const unsigned int order)
 #ifdef DEBUG_NEDELEC
   deallog << "Face Embedding" << std::endl;
 #endif
-  FullMatrix<double> face_embeddings[GeometryInfo<dim>::max_children_per_face];
+  // the face embeddings are expensive to compute for higher degrees, so
+  // they are shared between all elements of the same degree
+  const std::vector<FullMatrix<double>> cached_face_embeddings =
+    FETools::get_cached_matrices(get_name() + "/face_embeddings", [&]() {
+      FullMatrix<double>
+        face_embeddings[GeometryInfo<dim>::max_children_per_face];
+
+      for (unsigned int i = 0; i < GeometryInfo<dim>::max_children_per_face;
+           ++i)
+        face_embeddings[i].reinit(this->dofs_per_face, this->dofs_per_face);
 
-  for (unsigned int i = 0; i < GeometryInfo<dim>::max_children_per_face; ++i)
-    face_embeddings[i].reinit(this->dofs_per_face, this->dofs_per_face);
+      FETools::compute_face_embedding_matrices<dim, double>(
+        *this,
+        face_embeddings,
+        0,
+        0,
+        internal::FE_Nedelec::get_embedding_computation_tolerance(order));
 
-  FETools::compute_face_embedding_matrices<dim, double>(
-    *this,
-    face_embeddings,
-    0,
-    0,
-    internal::FE_Nedelec::get_embedding_computation_tolerance(order));
+      return std::vector<FullMatrix<double>>(
+        std::begin(face_embeddings), std::end(face_embeddings));
+    });
+  const FullMatrix<double> *face_embeddings = cached_face_embeddings.data();
 
   switch (dim)
     {
@@ -1995,6 +2006,59 @@ FE_Nedelec<dim>::initialize_restriction()
 
 
 
+template <int dim>
+void
+FE_Nedelec<dim>::initialize_prolongation_and_restriction()
+{
+  // the cache holds the prolongation matrices of all refinement cases and
+  // children, followed by the restriction matrices in the same order
+  const std::vector<FullMatrix<double>> matrices = FETools::get_cached_matrices(
+    get_name() + "/prolongation_and_restriction", [this]() {
+      // Reinit the vectors of
+      // restriction and prolongation
+      // matrices to the right sizes.
+      // Restriction only for isotropic
+      // refinement
+#ifdef DEBUG_NEDELEC
+      deallog << "Embedding" << std::endl;
+#endif
+      this->reinit_restriction_and_prolongation_matrices();
+      // Fill prolongation matrices with embedding operators
+      FETools::compute_embedding_matrices(
+        *this,
+        this->prolongation,
+        true,
+        internal::FE_Nedelec::get_embedding_computation_tolerance(
+          this->degree));
+#ifdef DEBUG_NEDELEC
+      deallog << "Restriction" << std::endl;
+#endif
+      initialize_restriction();
+
+      std::vector<FullMatrix<double>> result;
+      for (const auto &matrices_of_case : this->prolongation)
+        result.insert(result.end(),
+                      matrices_of_case.begin(),
+                      matrices_of_case.end());
+      for (const auto &matrices_of_case : this->restriction)
+        result.insert(result.end(),
+                      matrices_of_case.begin(),
+                      matrices_of_case.end());
+      return result;
+    });
+
+  unsigned int index = 0;
+  for (auto &matrices_of_case : this->prolongation)
+    for (FullMatrix<double> &matrix : matrices_of_case)
+      matrix = matrices[index++];
+  for (auto &matrices_of_case : this->restriction)
+    for (FullMatrix<double> &matrix : matrices_of_case)
+      matrix = matrices[index++];
+  AssertDimension(index, matrices.size());
+}
+
+
+
 template <int dim>
 std::vector<unsigned int>
 FE_Nedelec<dim>::get_dpo_vector(const unsigned int degree, bool dg)
@@ -2984,27 +3048,7 @@ FE_Nedelec<dim>::get_prolongation_matrix(
       // now do the work. need to get a non-const version of data in order to
       // be able to modify them inside a const function
       FE_Nedelec<dim> &this_nonconst = const_cast<FE_Nedelec<dim> &>(*this);
-
-      // Reinit the vectors of
-      // restriction and prolongation
-      // matrices to the right sizes.
-      // Restriction only for isotropic
-      // refinement
-#ifdef DEBUG_NEDELEC
-      deallog << "Embedding" << std::endl;
-#endif
-      this_nonconst.reinit_restriction_and_prolongation_matrices();
-      // Fill prolongation matrices with embedding operators
-      FETools::compute_embedding_matrices(
-        this_nonconst,
-        this_nonconst.prolongation,
-        true,
-        internal::FE_Nedelec::get_embedding_computation_tolerance(
-          this->degree));
-#ifdef DEBUG_NEDELEC
-      deallog << "Restriction" << std::endl;
-#endif
-      this_nonconst.initialize_restriction();
+      this_nonconst.initialize_prolongation_and_restriction();
     }
 
   // we use refinement_case-1 here. the -1 takes care of the origin of the
@@ -3046,27 +3090,7 @@ FE_Nedelec<dim>::get_restriction_matrix(
       // now do the work. need to get a non-const version of data in order to
       // be able to modify them inside a const function
       FE_Nedelec<dim> &this_nonconst = const_cast<FE_Nedelec<dim> &>(*this);
-
-      // Reinit the vectors of
-      // restriction and prolongation
-      // matrices to the right sizes.
-      // Restriction only for isotropic
-      // refinement
-#ifdef DEBUG_NEDELEC
-      deallog << "Embedding" << std::endl;
-#endif
-      this_nonconst.reinit_restriction_and_prolongation_matrices();
-      // Fill prolongation matrices with embedding operators
-      FETools::compute_embedding_matrices(
-        this_nonconst,
-        this_nonconst.prolongation,
-        true,
-        internal::FE_Nedelec::get_embedding_computation_tolerance(
-          this->degree));
-#ifdef DEBUG_NEDELEC
-      deallog << "Restriction" << std::endl;
-#endif
-      this_nonconst.initialize_restriction();
+      this_nonconst.initialize_prolongation_and_restriction();
     }
 
   // we use refinement_case-1 here. the -1 takes care of the origin of the
@@ -14,10 +14,102 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
+
 #include <deal.II/fe/fe_tools.templates.h>
 
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+
 DEAL_II_NAMESPACE_OPEN
 
+
+namespace FETools
+{
+  namespace
+  {
+    /**
+     * The cache of matrices used by get_cached_matrices() and the mutex
+     * protecting it.
+     */
+    std::map<std::string, std::vector<FullMatrix<double>>> matrix_cache;
+    Threads::Mutex                                         matrix_cache_mutex;
+  } // namespace
+
+
+
+  std::vector<FullMatrix<double>>
+  get_cached_matrices(
+    const std::string &                                     key,
+    const std::function<std::vector<FullMatrix<double>>()> &compute_matrices)
+  {
+    {
+      std::lock_guard<Threads::Mutex> lock(matrix_cache_mutex);
+      const auto                      entry = matrix_cache.find(key);
+      if (entry != matrix_cache.end())
+        return entry->second;
+    }
+
+    std::vector<FullMatrix<double>> matrices = compute_matrices();
+
+    std::lock_guard<Threads::Mutex> lock(matrix_cache_mutex);
+    return matrix_cache.emplace(key, std::move(matrices)).first->second;
+  }
+
+
+
+  void
+  save_matrix_cache(std::ostream &out)
+  {
+    std::vector<char> buffer;
+    {
+      std::lock_guard<Threads::Mutex> lock(matrix_cache_mutex);
+      buffer = Utilities::pack(matrix_cache, false);
+    }
+    const std::uint64_t size = buffer.size();
+    out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    out.write(buffer.data(), buffer.size());
+    AssertThrow(out, ExcIO());
+  }
+
+
+
+  void
+  load_matrix_cache(std::istream &in)
+  {
+    std::uint64_t size = 0;
+    in.read(reinterpret_cast<char *>(&size), sizeof(size));
+    std::vector<char> buffer(size);
+    in.read(buffer.data(), size);
+    AssertThrow(in, ExcIO());
+
+    auto entries =
+      Utilities::unpack<std::map<std::string, std::vector<FullMatrix<double>>>>(
+        buffer, false);
+
+    std::lock_guard<Threads::Mutex> lock(matrix_cache_mutex);
+    for (auto &entry : entries)
+      matrix_cache.emplace(entry.first, std::move(entry.second));
+  }
+
+
+
+  void
+  clear_matrix_cache()
+  {
+    std::lock_guard<Threads::Mutex> lock(matrix_cache_mutex);
+    matrix_cache.clear();
+  }
+} // namespace FETools
+
+
 /*-------------- Explicit Instantiations -------------------------------*/
 #include "fe_tools.inst"
 
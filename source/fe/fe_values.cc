@@ -1707,7 +1707,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<2, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->get_shape_hessians(),
       shape_function_data,
       hessians);
   }
@@ -1732,7 +1732,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<2, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->get_shape_hessians(),
       shape_function_data,
       hessians);
   }
@@ -1763,7 +1763,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_laplacians<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->get_shape_hessians(),
       shape_function_data,
       laplacians);
   }
@@ -1788,7 +1788,7 @@ namespace FEValuesViews
 
     internal::do_function_laplacians<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->get_shape_hessians(),
       shape_function_data,
       laplacians);
   }
@@ -1819,7 +1819,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<3, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_3rd_derivatives,
+      fe_values->get_shape_3rd_derivatives(),
       shape_function_data,
       third_derivatives);
   }
@@ -1843,7 +1843,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<3, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_3rd_derivatives,
+      fe_values->get_shape_3rd_derivatives(),
       shape_function_data,
       third_derivatives);
   }
@@ -2154,7 +2154,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<2, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->get_shape_hessians(),
       shape_function_data,
       hessians);
   }
@@ -2179,7 +2179,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<2, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->get_shape_hessians(),
       shape_function_data,
       hessians);
   }
@@ -2215,7 +2215,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_laplacians<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->get_shape_hessians(),
       shape_function_data,
       laplacians);
   }
@@ -2243,7 +2243,7 @@ namespace FEValuesViews
 
     internal::do_function_laplacians<dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_hessians,
+      fe_values->get_shape_hessians(),
       shape_function_data,
       laplacians);
   }
@@ -2274,7 +2274,7 @@ namespace FEValuesViews
                                                          dof_values);
     internal::do_function_derivatives<3, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_3rd_derivatives,
+      fe_values->get_shape_3rd_derivatives(),
       shape_function_data,
       third_derivatives);
   }
@@ -2298,7 +2298,7 @@ namespace FEValuesViews
 
     internal::do_function_derivatives<3, dim, spacedim>(
       make_array_view(dof_values.begin(), dof_values.end()),
-      fe_values->finite_element_output.shape_3rd_derivatives,
+      fe_values->get_shape_3rd_derivatives(),
       shape_function_data,
       third_derivatives);
   }
@@ -3090,6 +3090,8 @@ FEValuesBase<dim, spacedim>::FEValuesBase(
   , dofs_per_cell(dofs_per_cell)
   , mapping(&mapping, typeid(*this).name())
   , fe(&fe, typeid(*this).name())
+  , deferred_update_flags(update_default)
+  , deferred_data_is_current(false)
   , cell_similarity(CellSimilarity::Similarity::none)
   , fe_values_views_cache(*this)
 {
@@ -3102,6 +3104,15 @@ FEValuesBase<dim, spacedim>::FEValuesBase(
 
 
 
+template <int dim, int spacedim>
+void
+FEValuesBase<dim, spacedim>::compute_deferred_data()
+{
+  Assert(false, ExcInternalError());
+}
+
+
+
 template <int dim, int spacedim>
 FEValuesBase<dim, spacedim>::~FEValuesBase()
 {
@@ -3847,7 +3858,7 @@ FEValuesBase<dim, spacedim>::get_function_hessians(
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(dof_values.begin(),
-                                    this->finite_element_output.shape_hessians,
+                                    this->get_shape_hessians(),
                                     hessians);
 }
 
@@ -3872,7 +3883,7 @@ FEValuesBase<dim, spacedim>::get_function_hessians(
   for (unsigned int i = 0; i < dofs_per_cell; ++i)
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(dof_values.data(),
-                                    this->finite_element_output.shape_hessians,
+                                    this->get_shape_hessians(),
                                     hessians);
 }
 
@@ -3900,7 +3911,7 @@ FEValuesBase<dim, spacedim>::get_function_hessians(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(
     dof_values.begin(),
-    this->finite_element_output.shape_hessians,
+    this->get_shape_hessians(),
     *fe,
     this->finite_element_output.shape_function_to_row_table,
     make_array_view(hessians.begin(), hessians.end()),
@@ -3930,7 +3941,7 @@ FEValuesBase<dim, spacedim>::get_function_hessians(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(
     dof_values.data(),
-    this->finite_element_output.shape_hessians,
+    this->get_shape_hessians(),
     *fe,
     this->finite_element_output.shape_function_to_row_table,
     make_array_view(hessians.begin(), hessians.end()),
@@ -3959,7 +3970,7 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_laplacians(dof_values.begin(),
-                                   this->finite_element_output.shape_hessians,
+                                   this->get_shape_hessians(),
                                    laplacians);
 }
 
@@ -3983,7 +3994,7 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
   for (unsigned int i = 0; i < dofs_per_cell; ++i)
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_laplacians(dof_values.data(),
-                                   this->finite_element_output.shape_hessians,
+                                   this->get_shape_hessians(),
                                    laplacians);
 }
 
@@ -4008,7 +4019,7 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_laplacians(
     dof_values.begin(),
-    this->finite_element_output.shape_hessians,
+    this->get_shape_hessians(),
     *fe,
     this->finite_element_output.shape_function_to_row_table,
     laplacians);
@@ -4037,7 +4048,7 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_laplacians(
     dof_values.data(),
-    this->finite_element_output.shape_hessians,
+    this->get_shape_hessians(),
     *fe,
     this->finite_element_output.shape_function_to_row_table,
     laplacians,
@@ -4067,7 +4078,7 @@ FEValuesBase<dim, spacedim>::get_function_laplacians(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_laplacians(
     dof_values.data(),
-    this->finite_element_output.shape_hessians,
+    this->get_shape_hessians(),
     *fe,
     this->finite_element_output.shape_function_to_row_table,
     laplacians,
@@ -4098,7 +4109,7 @@ FEValuesBase<dim, spacedim>::get_function_third_derivatives(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(
     dof_values.begin(),
-    this->finite_element_output.shape_3rd_derivatives,
+    this->get_shape_3rd_derivatives(),
     third_derivatives);
 }
 
@@ -4124,7 +4135,7 @@ FEValuesBase<dim, spacedim>::get_function_third_derivatives(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(
     dof_values.data(),
-    this->finite_element_output.shape_3rd_derivatives,
+    this->get_shape_3rd_derivatives(),
     third_derivatives);
 }
 
@@ -4152,7 +4163,7 @@ FEValuesBase<dim, spacedim>::get_function_third_derivatives(
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
   internal::do_function_derivatives(
     dof_values.begin(),
-    this->finite_element_output.shape_3rd_derivatives,
+    this->get_shape_3rd_derivatives(),
     *fe,
     this->finite_element_output.shape_function_to_row_table,
     make_array_view(third_derivatives.begin(), third_derivatives.end()),
@@ -4182,7 +4193,7 @@ FEValuesBase<dim, spacedim>::get_function_third_derivatives(
     dof_values[i] = internal::get_vector_element(fe_function, indices[i]);
   internal::do_function_derivatives(
     dof_values.data(),
-    this->finite_element_output.shape_3rd_derivatives,
+    this->get_shape_3rd_derivatives(),
     *fe,
     this->finite_element_output.shape_function_to_row_table,
     make_array_view(third_derivatives.begin(), third_derivatives.end()),
@@ -4442,6 +4453,66 @@ FEValues<dim, spacedim>::FEValues(const FiniteElement<dim, spacedim> &fe,
 
 
 
+template <int dim, int spacedim>
+FEValues<dim, spacedim>::FEValues(const FEValues<dim, spacedim> &other)
+  : FEValuesBase<dim, spacedim>(other.n_quadrature_points,
+                                other.dofs_per_cell,
+                                other.update_flags,
+                                other.get_mapping(),
+                                other.get_fe())
+  , quadrature(other.quadrature)
+{
+  const UpdateFlags flags     = this->update_flags;
+  this->deferred_update_flags = other.deferred_update_flags;
+
+  if (flags & update_mapping)
+    this->mapping_output.initialize(this->n_quadrature_points, flags);
+  this->finite_element_output.initialize(this->n_quadrature_points,
+                                         *this->fe,
+                                         flags);
+
+  // share the data of the finite element if its fill functions do not
+  // write into it. the only output that is not computed on every cell in
+  // that case are the shape values, which the element stores directly in
+  // the output object
+  const bool share_fe_data =
+    other.fe_data->is_read_only() &&
+    (other.deferred_fe_data == nullptr ||
+     other.deferred_fe_data->is_read_only());
+  if (share_fe_data)
+    {
+      this->fe_data          = other.fe_data;
+      this->deferred_fe_data = other.deferred_fe_data;
+      this->finite_element_output.shape_values =
+        other.finite_element_output.shape_values;
+    }
+  else
+    {
+      const UpdateFlags eager_flags =
+        static_cast<UpdateFlags>(flags & ~this->deferred_update_flags);
+      this->fe_data = this->get_fe().get_data(eager_flags,
+                                              this->get_mapping(),
+                                              quadrature,
+                                              this->finite_element_output);
+      if (this->deferred_update_flags != update_default)
+        this->deferred_fe_data =
+          this->get_fe().get_data(this->deferred_update_flags,
+                                  this->get_mapping(),
+                                  quadrature,
+                                  this->finite_element_output);
+    }
+
+  // the data of the mapping is modified on every cell and can therefore
+  // not be shared
+  if (flags & update_mapping)
+    this->mapping_data = this->get_mapping().get_data(flags, quadrature);
+  else
+    this->mapping_data = std_cxx14::make_unique<
+      typename Mapping<dim, spacedim>::InternalDataBase>();
+}
+
+
+
 template <int dim, int spacedim>
 void
 FEValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
@@ -4578,6 +4649,80 @@ FEValues<dim, spacedim>::reinit(
 
 
 
+template <int dim, int spacedim>
+void
+FEValues<dim, spacedim>::reinit(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const Quadrature<dim> &                                     quadrature)
+{
+  if (!(quadrature == this->quadrature))
+    change_quadrature(quadrature);
+  reinit(cell);
+}
+
+
+
+template <int dim, int spacedim>
+template <template <int, int> class DoFHandlerType, bool lda>
+void
+FEValues<dim, spacedim>::reinit(
+  const TriaIterator<DoFCellAccessor<DoFHandlerType<dim, spacedim>, lda>> &cell,
+  const Quadrature<dim> &quadrature)
+{
+  if (!(quadrature == this->quadrature))
+    change_quadrature(quadrature);
+  reinit(cell);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEValues<dim, spacedim>::change_quadrature(
+  const Quadrature<dim> &new_quadrature)
+{
+  Assert(new_quadrature.size() > 0,
+         ExcMessage("There is nothing useful you can do with an FEValues "
+                    "object when using a quadrature formula with zero "
+                    "quadrature points!"));
+
+  quadrature                = new_quadrature;
+  this->n_quadrature_points = new_quadrature.size();
+
+  // resize the output arrays, which keeps their memory if possible
+  if (this->update_flags & update_mapping)
+    this->mapping_output.initialize(this->n_quadrature_points,
+                                    this->update_flags);
+  this->finite_element_output.initialize(this->n_quadrature_points,
+                                         *this->fe,
+                                         this->update_flags);
+
+  // then let the finite element and the mapping recompute the data for the
+  // new quadrature points, keeping the split into the eagerly computed and
+  // the deferred data
+  const UpdateFlags eager_flags =
+    static_cast<UpdateFlags>(this->update_flags & ~this->deferred_update_flags);
+  this->fe_data = this->get_fe().get_data(eager_flags,
+                                          this->get_mapping(),
+                                          quadrature,
+                                          this->finite_element_output);
+  if (this->deferred_update_flags != update_default)
+    this->deferred_fe_data =
+      this->get_fe().get_data(this->deferred_update_flags,
+                              this->get_mapping(),
+                              quadrature,
+                              this->finite_element_output);
+  if (this->update_flags & update_mapping)
+    this->mapping_data =
+      this->get_mapping().get_data(this->update_flags, quadrature);
+
+  // the data computed on the previous cell belongs to other quadrature
+  // points, so the next cell cannot make use of its similarity to it
+  this->cell_similarity = CellSimilarity::invalid_next_cell;
+}
+
+
+
 template <int dim, int spacedim>
 void
 FEValues<dim, spacedim>::do_reinit()
@@ -4608,6 +4753,74 @@ FEValues<dim, spacedim>::do_reinit()
                                 this->mapping_output,
                                 *this->fe_data,
                                 this->finite_element_output);
+
+  // the deferred data, if any, is only computed once it is accessed
+  this->deferred_data_is_current = false;
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEValues<dim, spacedim>::defer_update_flags(const UpdateFlags flags)
+{
+  Assert((flags & ~(update_hessians | update_3rd_derivatives)) == 0,
+         ExcMessage("Only the flags update_hessians and "
+                    "update_3rd_derivatives can be deferred."));
+  Assert((flags & this->update_flags) == flags,
+         ExcMessage("Only flags that have been passed to the constructor "
+                    "can be deferred."));
+  Assert(this->present_cell.get() == nullptr,
+         ExcMessage("Update flags can only be deferred before the first "
+                    "call to reinit()."));
+
+  this->deferred_update_flags = flags;
+  this->deferred_data_is_current = false;
+  if (flags == update_default)
+    {
+      this->deferred_fe_data.reset();
+      this->fe_data = this->get_fe().get_data(this->update_flags,
+                                              this->get_mapping(),
+                                              quadrature,
+                                              this->finite_element_output);
+      return;
+    }
+
+  // split the work of the finite element into the part that is done in
+  // reinit() and the part that is done on first access. the mapping keeps
+  // computing everything, since the deferred part needs its data
+  const UpdateFlags eager_flags =
+    static_cast<UpdateFlags>(this->update_flags & ~flags);
+  this->fe_data = this->get_fe().get_data(eager_flags,
+                                          this->get_mapping(),
+                                          quadrature,
+                                          this->finite_element_output);
+  this->deferred_fe_data = this->get_fe().get_data(flags,
+                                                   this->get_mapping(),
+                                                   quadrature,
+                                                   this->finite_element_output);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEValues<dim, spacedim>::compute_deferred_data()
+{
+  Assert(this->present_cell.get() != nullptr,
+         ExcMessage("FEValues object is not reinit'ed to any cell"));
+
+  // the deferred data of the previous cell may not have been computed, so
+  // we cannot make use of the similarity of the cells
+  this->get_fe().fill_fe_values(*this->present_cell,
+                                CellSimilarity::none,
+                                this->quadrature,
+                                this->get_mapping(),
+                                *this->mapping_data,
+                                this->mapping_output,
+                                *this->deferred_fe_data,
+                                this->finite_element_output);
+  this->deferred_data_is_current = true;
 }
 
 
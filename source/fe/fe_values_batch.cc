@@ -0,0 +1,165 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/std_cxx14/memory.h>
+
+#include <deal.II/fe/fe_values_batch.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, int spacedim>
+const unsigned int FEValuesBatch<dim, spacedim>::n_lanes;
+
+
+
+template <int dim, int spacedim>
+FEValuesBatch<dim, spacedim>::FEValuesBatch(
+  const Mapping<dim, spacedim> &      mapping,
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim> &             quadrature,
+  const UpdateFlags                   update_flags)
+  : n_quadrature_points(quadrature.size())
+  , dofs_per_cell(fe.dofs_per_cell)
+  , update_flags(update_flags)
+  , n_cells(0)
+{
+  Assert(fe.is_primitive() ||
+           !(update_flags & (update_values | update_gradients)),
+         ExcMessage("FEValuesBatch only supports shape function values and "
+                    "gradients of primitive finite elements."));
+
+  fe_values.reserve(n_lanes);
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    fe_values.push_back(std_cxx14::make_unique<FEValues<dim, spacedim>>(
+      mapping, fe, quadrature, update_flags));
+
+  if (update_flags & update_values)
+    shape_values.resize(dofs_per_cell * n_quadrature_points);
+  if (update_flags & update_gradients)
+    shape_gradients.resize(dofs_per_cell * n_quadrature_points);
+  if (update_flags & update_JxW_values)
+    JxW_values.resize(n_quadrature_points);
+  if (update_flags & update_jacobians)
+    jacobians.resize(n_quadrature_points);
+  if (update_flags & update_quadrature_points)
+    quadrature_points.resize(n_quadrature_points);
+}
+
+
+
+template <int dim, int spacedim>
+FEValuesBatch<dim, spacedim>::FEValuesBatch(
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim> &             quadrature,
+  const UpdateFlags                   update_flags)
+  : FEValuesBatch(StaticMappingQ1<dim, spacedim>::mapping,
+                  fe,
+                  quadrature,
+                  update_flags)
+{}
+
+
+
+template <int dim, int spacedim>
+void
+FEValuesBatch<dim, spacedim>::gather(const unsigned int n_cells)
+{
+  this->n_cells = n_cells;
+
+  // start from zero such that the lanes without a cell do not contribute
+  // to sums over quadrature points
+  const VectorizedArrayType zero = make_vectorized_array(0.);
+  std::fill(shape_values.begin(), shape_values.end(), zero);
+  std::fill(shape_gradients.begin(),
+            shape_gradients.end(),
+            Tensor<1, spacedim, VectorizedArrayType>());
+  std::fill(JxW_values.begin(), JxW_values.end(), zero);
+  std::fill(jacobians.begin(),
+            jacobians.end(),
+            DerivativeForm<1, dim, spacedim, VectorizedArrayType>());
+  std::fill(quadrature_points.begin(),
+            quadrature_points.end(),
+            Point<spacedim, VectorizedArrayType>());
+
+  for (unsigned int v = 0; v < n_cells; ++v)
+    {
+      const FEValues<dim, spacedim> &fe_v = *fe_values[v];
+
+      if (update_flags & update_values)
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          for (unsigned int q = 0; q < n_quadrature_points; ++q)
+            shape_values[i * n_quadrature_points + q][v] =
+              fe_v.shape_value(i, q);
+
+      if (update_flags & update_gradients)
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          for (unsigned int q = 0; q < n_quadrature_points; ++q)
+            {
+              const Tensor<1, spacedim> &gradient = fe_v.shape_grad(i, q);
+              Tensor<1, spacedim, VectorizedArrayType> &batch_gradient =
+                shape_gradients[i * n_quadrature_points + q];
+              for (unsigned int d = 0; d < spacedim; ++d)
+                batch_gradient[d][v] = gradient[d];
+            }
+
+      if (update_flags & update_JxW_values)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          JxW_values[q][v] = fe_v.JxW(q);
+
+      if (update_flags & update_jacobians)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          {
+            const DerivativeForm<1, dim, spacedim> &jacobian =
+              fe_v.jacobian(q);
+            for (unsigned int d = 0; d < spacedim; ++d)
+              for (unsigned int e = 0; e < dim; ++e)
+                jacobians[q][d][e][v] = jacobian[d][e];
+          }
+
+      if (update_flags & update_quadrature_points)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          {
+            const Point<spacedim> &point = fe_v.quadrature_point(q);
+            for (unsigned int d = 0; d < spacedim; ++d)
+              quadrature_points[q][d][v] = point[d];
+          }
+    }
+}
+
+
+
+template <int dim, int spacedim>
+std::size_t
+FEValuesBatch<dim, spacedim>::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this);
+  for (const auto &fe_v : fe_values)
+    memory += fe_v->memory_consumption();
+  return (memory + MemoryConsumption::memory_consumption(shape_values) +
+          MemoryConsumption::memory_consumption(shape_gradients) +
+          MemoryConsumption::memory_consumption(JxW_values) +
+          MemoryConsumption::memory_consumption(jacobians) +
+          MemoryConsumption::memory_consumption(quadrature_points));
+}
+
+
+#include "fe_values_batch.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -14,10 +14,27 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/thread_local_storage.h>
+#include <deal.II/base/utilities.h>
 #include <deal.II/base/work_stream.h>
 
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_tools.h>
+#include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q_cache.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/la_vector.h>
+#include <deal.II/lac/petsc_vector.h>
+#include <deal.II/lac/trilinos_epetra_vector.h>
+#include <deal.II/lac/trilinos_tpetra_vector.h>
+#include <deal.II/lac/trilinos_vector.h>
+#include <deal.II/lac/vector.h>
+
 #include <functional>
 
 DEAL_II_NAMESPACE_OPEN
@@ -47,7 +64,8 @@ MappingQCache<dim, spacedim>::~MappingQCache()
   // invalid memory that has been left back by freeing an object of this
   // class.
   support_point_cache.reset();
-  clear_signal.disconnect();
+  for (auto &connection : tria_listeners)
+    connection.disconnect();
 }
 
 
@@ -70,31 +88,179 @@ MappingQCache<dim, spacedim>::preserves_vertex_locations() const
 
 
 
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::connect_to_triangulation(
+  const Triangulation<dim, spacedim> &triangulation,
+  const bool                          keep_upon_refinement)
+{
+  for (auto &connection : tria_listeners)
+    connection.disconnect();
+  tria_listeners.clear();
+
+  const auto clear_cache = [this]() -> void {
+    this->support_point_cache.reset();
+  };
+
+  if (keep_upon_refinement == false)
+    {
+      tria_listeners.push_back(
+        triangulation.signals.any_change.connect(clear_cache));
+      return;
+    }
+
+  tria_listeners.push_back(triangulation.signals.create.connect(clear_cache));
+  tria_listeners.push_back(triangulation.signals.clear.connect(clear_cache));
+  tria_listeners.push_back(
+    triangulation.signals.mesh_movement.connect(clear_cache));
+
+  // the children of a coarsened cell are deleted and their slots in the
+  // cache might be re-used by new cells in a later refinement, so clear the
+  // data to mark it as no longer present
+  tria_listeners.push_back(triangulation.signals.pre_coarsening_on_cell.connect(
+    [this](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+      if (this->support_point_cache.get() != nullptr)
+        for (unsigned int c = 0; c < cell->n_children(); ++c)
+          (*this->support_point_cache)[cell->child(c)->level()]
+                                      [cell->child(c)->index()] =
+            std::vector<Point<spacedim>>();
+    }));
+
+  // after refinement, adjust the size of the cache to the new number of
+  // cells, leaving the slots of the new cells empty
+  tria_listeners.push_back(triangulation.signals.post_refinement.connect(
+    [this, &triangulation]() {
+      if (this->support_point_cache.get() != nullptr)
+        {
+          this->support_point_cache->resize(triangulation.n_levels());
+          for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
+            (*this->support_point_cache)[l].resize(
+              triangulation.n_raw_cells(l));
+        }
+    }));
+}
+
+
+
 template <int dim, int spacedim>
 void
 MappingQCache<dim, spacedim>::initialize(
   const Triangulation<dim, spacedim> &  triangulation,
   const MappingQGeneric<dim, spacedim> &mapping)
+{
+  support_point_cache.reset();
+  update_after_refinement(triangulation, mapping);
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::update_after_refinement(
+  const Triangulation<dim, spacedim> &  triangulation,
+  const MappingQGeneric<dim, spacedim> &mapping)
 {
   AssertDimension(this->get_degree(), mapping.get_degree());
 
-  clear_signal = triangulation.signals.any_change.connect(
-    [&]() -> void { this->support_point_cache.reset(); });
+  if (support_point_cache.get() == nullptr)
+    {
+      connect_to_triangulation(triangulation, true);
+      support_point_cache = std::make_shared<
+        std::vector<std::vector<std::vector<Point<spacedim>>>>>();
+    }
 
-  support_point_cache =
-    std::make_shared<std::vector<std::vector<std::vector<Point<spacedim>>>>>(
-      triangulation.n_levels());
+  support_point_cache->resize(triangulation.n_levels());
   for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
     (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
 
+  // only compute the cells whose entry is empty, which are all cells when
+  // coming from initialize() and the new cells after a refinement
   WorkStream::run(
     triangulation.begin(),
     triangulation.end(),
     [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
         void *,
         void *) {
-      (*support_point_cache)[cell->level()][cell->index()] =
-        mapping.compute_mapping_support_points(cell);
+      std::vector<Point<spacedim>> &points =
+        (*support_point_cache)[cell->level()][cell->index()];
+      if (points.empty())
+        points = mapping.compute_mapping_support_points(cell);
+    },
+    /* copier */ std::function<void(void *)>(),
+    /* scratch_data */ nullptr,
+    /* copy_data */ nullptr,
+    2 * MultithreadInfo::n_threads(),
+    /* chunk_size = */ 1);
+}
+
+
+
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+MappingQCache<dim, spacedim>::initialize(
+  const Mapping<dim, spacedim> &   mapping,
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const VectorType &               vector)
+{
+  const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+  AssertDimension(fe.n_components(), spacedim);
+  AssertDimension(vector.size(), dof_handler.n_dofs());
+
+  const Triangulation<dim, spacedim> &triangulation =
+    dof_handler.get_triangulation();
+  connect_to_triangulation(triangulation, false);
+
+  support_point_cache =
+    std::make_shared<std::vector<std::vector<std::vector<Point<spacedim>>>>>(
+      triangulation.n_levels());
+  for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
+    (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
+
+  // The support points of MappingQGeneric are the points of the
+  // Gauss-Lobatto formula in the hierarchical numbering of FE_Q, so evaluate
+  // the displaced geometry in exactly these points
+  const unsigned int degree = this->get_degree();
+  std::vector<unsigned int> hierarchic_to_lexicographic(
+    Utilities::fixed_power<dim>(degree + 1));
+  FETools::hierarchic_to_lexicographic_numbering<dim>(
+    degree, hierarchic_to_lexicographic);
+  const QGaussLobatto<dim> gauss_lobatto(degree + 1);
+  std::vector<Point<dim>>  unit_points;
+  unit_points.reserve(hierarchic_to_lexicographic.size());
+  for (const unsigned int i : hierarchic_to_lexicographic)
+    unit_points.push_back(gauss_lobatto.point(i));
+  const Quadrature<dim> quadrature(unit_points);
+
+  Threads::ThreadLocalStorage<std::unique_ptr<FEValues<dim, spacedim>>>
+    fe_values_storage;
+
+  WorkStream::run(
+    dof_handler.begin_active(),
+    dof_handler.end(),
+    [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+        void *,
+        void *) {
+      if (cell->is_artificial())
+        return;
+
+      std::unique_ptr<FEValues<dim, spacedim>> &fe_values =
+        fe_values_storage.get();
+      if (fe_values.get() == nullptr)
+        fe_values = std_cxx14::make_unique<FEValues<dim, spacedim>>(
+          mapping, fe, quadrature, update_values | update_quadrature_points);
+      fe_values->reinit(cell);
+
+      std::vector<Vector<typename VectorType::value_type>> displacement(
+        quadrature.size(), Vector<typename VectorType::value_type>(spacedim));
+      fe_values->get_function_values(vector, displacement);
+
+      std::vector<Point<spacedim>> &points =
+        (*support_point_cache)[cell->level()][cell->index()];
+      points.resize(quadrature.size());
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          points[q][d] = fe_values->quadrature_point(q)[d] + displacement[q](d);
     },
     /* copier */ std::function<void(void *)>(),
     /* scratch_data */ nullptr,
@@ -129,6 +295,10 @@ MappingQCache<dim, spacedim>::compute_mapping_support_points(
 
   AssertIndexRange(cell->level(), support_point_cache->size());
   AssertIndexRange(cell->index(), (*support_point_cache)[cell->level()].size());
+  Assert((*support_point_cache)[cell->level()][cell->index()].size() > 0,
+         ExcMessage("The cache does not contain the support points of this "
+                    "cell. Call MappingQCache::update_after_refinement() "
+                    "after refining the mesh."));
   return (*support_point_cache)[cell->level()][cell->index()];
 }
 
@@ -45,6 +45,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -1511,6 +1512,166 @@ namespace internal
         return p_unit;
       }
 
+
+
+      /**
+       * A helper class to run the Newton iteration of
+       * do_transform_real_to_unit_cell_internal() with the data of a cell
+       * that has been set up once for several points. Only the case
+       * dim==spacedim is supported; the general template is never called.
+       */
+      template <int dim, int spacedim>
+      struct TransformRealToUnitCellNewton
+      {
+        static Point<dim>
+        run(const typename Triangulation<dim, spacedim>::cell_iterator &,
+            const Point<spacedim> &,
+            const Point<dim> &,
+            typename dealii::MappingQGeneric<dim, spacedim>::InternalData &)
+        {
+          Assert(false, ExcInternalError());
+          return Point<dim>();
+        }
+      };
+
+
+
+      template <int dim>
+      struct TransformRealToUnitCellNewton<dim, dim>
+      {
+        static Point<dim>
+        run(const typename Triangulation<dim, dim>::cell_iterator &cell,
+            const Point<dim> &                                     p,
+            const Point<dim> &initial_p_unit,
+            typename dealii::MappingQGeneric<dim, dim>::InternalData &mdata)
+        {
+          return do_transform_real_to_unit_cell_internal<dim>(cell,
+                                                              p,
+                                                              initial_p_unit,
+                                                              mdata);
+        }
+      };
+
+      /**
+       * Run the Newton iteration of do_transform_real_to_unit_cell_internal()
+       * for the VectorizedArray<double>::n_array_elements points @p p at
+       * once. The mapping is evaluated with sum factorization from the 1D
+       * polynomials @p polynomials_1d and the coordinates of the mapping
+       * support points in @p support_point_coordinates, where component
+       * <tt>d</tt> of support point <tt>i</tt> is stored at position
+       * <tt>d*n_shapes+i</tt> in the numbering of the mapping and @p renumber
+       * translates the lexicographic numbering into that one.
+       *
+       * As opposed to the scalar version, no line search is done. The entries
+       * of @p converged are set to false for the points where the iteration
+       * did not converge or the Jacobian was not positive, which should then
+       * be handled by the scalar version.
+       */
+      template <int dim>
+      Point<dim, VectorizedArray<double>>
+      do_transform_real_to_unit_cell_internal_vectorized(
+        const Point<dim, VectorizedArray<double>> &         p,
+        const Point<dim, VectorizedArray<double>> &         initial_p_unit,
+        const std::vector<Polynomials::Polynomial<double>> &polynomials_1d,
+        const std::vector<double> &      support_point_coordinates,
+        const std::vector<unsigned int> &renumber,
+        std::array<bool, VectorizedArray<double>::n_array_elements>
+          &converged)
+      {
+        using Number = VectorizedArray<double>;
+        constexpr unsigned int n_lanes = Number::n_array_elements;
+
+        const unsigned int n_shapes_1d = polynomials_1d.size();
+        const unsigned int n_shapes    = renumber.size();
+        AssertDimension(support_point_coordinates.size(), dim * n_shapes);
+
+        // same tolerance and iteration limit as in the scalar version
+        const double       eps                    = 1.e-11;
+        const unsigned int newton_iteration_limit = 20;
+
+        std::array<bool, n_lanes> active;
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          {
+            converged[v] = false;
+            active[v]    = true;
+          }
+
+        std::vector<Number> shapes(2 * dim * n_shapes_1d);
+        Point<dim, Number>  p_unit = initial_p_unit;
+        for (unsigned int newton_iteration = 0;
+             newton_iteration <= newton_iteration_limit;
+             ++newton_iteration)
+          {
+            // evaluate the 1D polynomials lane by lane and the mapping and
+            // its Jacobian with sum factorization
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int i = 0; i < n_shapes_1d; ++i)
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  {
+                    double values[2];
+                    polynomials_1d[i].value(p_unit[d][v], 1, values);
+                    shapes[2 * (d * n_shapes_1d + i)][v]     = values[0];
+                    shapes[2 * (d * n_shapes_1d + i) + 1][v] = values[1];
+                  }
+
+            Tensor<1, dim, Number> f;
+            Tensor<2, dim, Number> df;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                const auto value_and_gradient =
+                  internal::evaluate_tensor_product_value_and_gradient<dim>(
+                    shapes.data(),
+                    n_shapes_1d,
+                    support_point_coordinates.data() + d * n_shapes,
+                    renumber.data());
+                f[d]  = value_and_gradient.first - p[d];
+                df[d] = value_and_gradient.second;
+              }
+
+            // switch off the points with a degenerate Jacobian, replacing
+            // their Jacobian by the identity to keep the inverse finite
+            const Number det = determinant(df);
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              if (active[v] && !(det[v] > 0.))
+                active[v] = false;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              if (active[v] == false)
+                for (unsigned int d = 0; d < dim; ++d)
+                  for (unsigned int e = 0; e < dim; ++e)
+                    df[d][e][v] = (d == e) ? 1. : 0.;
+
+            // the Newton update measures the residual in the norm induced
+            // by the Jacobian as in the scalar version
+            const Tensor<1, dim, Number> delta = invert(df) * f;
+            const Number                 delta_norm_square =
+              delta.norm_square();
+
+            bool any_active = false;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              if (active[v])
+                {
+                  if (delta_norm_square[v] < eps * eps)
+                    {
+                      converged[v] = true;
+                      active[v]    = false;
+                    }
+                  else
+                    {
+                      for (unsigned int d = 0; d < dim; ++d)
+                        p_unit[d][v] -= delta[d][v];
+                      any_active = true;
+                    }
+                }
+
+            if (any_active == false)
+              break;
+          }
+
+        return p_unit;
+      }
+
+
+
       /**
        * In case the quadrature formula is a tensor product, this is a
        * replacement for maybe_compute_q_points(), maybe_update_Jacobians() and
@@ -2662,6 +2823,122 @@ MappingQGeneric<dim, spacedim>::transform_real_to_unit_cell(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>> &                    real_points,
+  const ArrayView<Point<dim>> &                               unit_points) const
+{
+  AssertDimension(real_points.size(), unit_points.size());
+
+  // the explicit formulas of linear mappings in 1d and 2d, the codimension
+  // one case and the Eulerian mappings with their special initial guess are
+  // handled point by point
+  if (dim != spacedim || (polynomial_degree == 1 && dim < 3) ||
+      this->preserves_vertex_locations() == false || real_points.size() < 2)
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+
+  // compute the support points of the mapping only once for all points and
+  // arrange their coordinates for the evaluation with sum factorization
+  const std::vector<Point<spacedim>> support_points =
+    this->compute_mapping_support_points(cell);
+  const unsigned int  n_shapes = support_points.size();
+  std::vector<double> support_point_coordinates(spacedim * n_shapes);
+  for (unsigned int d = 0; d < spacedim; ++d)
+    for (unsigned int i = 0; i < n_shapes; ++i)
+      support_point_coordinates[d * n_shapes + i] = support_points[i][d];
+
+  const std::vector<Polynomials::Polynomial<double>> polynomials_1d =
+    Polynomials::generate_complete_Lagrange_basis(
+      line_support_points.get_points());
+  const std::vector<unsigned int> renumber(
+    FETools::lexicographic_to_hierarchic_numbering(FiniteElementData<dim>(
+      internal::MappingQGenericImplementation::get_dpo_vector<dim>(
+        polynomial_degree),
+      1,
+      polynomial_degree)));
+  AssertDimension(renumber.size(), n_shapes);
+
+  // the internal data for the scalar Newton iteration with line search,
+  // which is only set up for points where the vectorized iteration fails
+  std::unique_ptr<InternalData> mdata;
+  const auto transform_point_scalar = [&](const unsigned int i) {
+    if (mdata.get() == nullptr)
+      {
+        const Quadrature<dim> point_quadrature((Point<dim>()));
+        mdata = Utilities::dynamic_unique_cast<InternalData>(
+          get_data(update_quadrature_points | update_jacobians,
+                   point_quadrature));
+        mdata->mapping_support_points = support_points;
+      }
+    try
+      {
+        const Point<dim> initial_p_unit =
+          GeometryInfo<dim>::project_to_unit_cell(
+            cell->real_to_unit_cell_affine_approximation(real_points[i]));
+        unit_points[i] = internal::MappingQGenericImplementation::
+          TransformRealToUnitCellNewton<dim, spacedim>::run(cell,
+                                                            real_points[i],
+                                                            initial_p_unit,
+                                                            *mdata);
+      }
+    catch (const typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+      {
+        unit_points[i]    = Point<dim>();
+        unit_points[i][0] = std::numeric_limits<double>::infinity();
+      }
+  };
+
+  // run the Newton iteration for batches of points with SIMD, filling the
+  // unused lanes of the last batch with its first point
+  constexpr unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+  for (unsigned int i = 0; i < real_points.size(); i += n_lanes)
+    {
+      const unsigned int n_points =
+        std::min<unsigned int>(n_lanes, real_points.size() - i);
+
+      Point<dim, VectorizedArray<double>> p, initial_p_unit;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int j = i + (v < n_points ? v : 0);
+          const Point<dim>   initial =
+            GeometryInfo<dim>::project_to_unit_cell(
+              cell->real_to_unit_cell_affine_approximation(real_points[j]));
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              p[d][v]              = real_points[j][d];
+              initial_p_unit[d][v] = initial[d];
+            }
+        }
+
+      std::array<bool, n_lanes> converged;
+      const Point<dim, VectorizedArray<double>> p_unit =
+        internal::MappingQGenericImplementation::
+          do_transform_real_to_unit_cell_internal_vectorized<dim>(
+            p,
+            initial_p_unit,
+            polynomials_1d,
+            support_point_coordinates,
+            renumber,
+            converged);
+
+      for (unsigned int v = 0; v < n_points; ++v)
+        if (converged[v])
+          for (unsigned int d = 0; d < dim; ++d)
+            unit_points[i + v][d] = p_unit[d][v];
+        else
+          transform_point_scalar(i + v);
+    }
+}
+
+
+
 template <int dim, int spacedim>
 UpdateFlags
 MappingQGeneric<dim, spacedim>::requires_update_flags(
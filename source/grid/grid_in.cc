@@ -15,21 +15,31 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/utilities.h>
 
+#include <deal.II/distributed/fully_distributed_tria.h>
+
 #include <deal.II/grid/grid_in.h>
 #include <deal.II/grid/grid_reordering.h>
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/tria.h>
 
 #include <boost/io/ios_state.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <map>
+#include <numeric>
+#include <set>
 
 
 #ifdef DEAL_II_WITH_NETCDF
@@ -493,6 +503,156 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
 }
 
 
+namespace
+{
+  /**
+   * Read @p n elements of type @p T from @p in as one block of bytes, as
+   * written by GridOut::write_binary().
+   */
+  template <typename T>
+  std::vector<T>
+  read_binary_array(std::istream &in, const std::uint64_t n)
+  {
+    std::vector<T> array(n);
+    in.read(reinterpret_cast<char *>(array.data()), n * sizeof(T));
+    AssertThrow(in, ExcIO());
+    return array;
+  }
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_binary(std::istream &in)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
+  AssertThrow(in, ExcIO());
+
+  std::string line;
+  std::getline(in, line);
+  AssertThrow(line == "deal.II binary mesh",
+              ExcMessage("The stream does not contain a mesh in the binary "
+                         "format written by GridOut::write_binary()."));
+
+  std::uint32_t header[4];
+  std::uint64_t sizes[5];
+  in.read(reinterpret_cast<char *>(header), sizeof(header));
+  in.read(reinterpret_cast<char *>(sizes), sizeof(sizes));
+  AssertThrow(in, ExcIO());
+  AssertThrow(header[0] == 1,
+              ExcMessage("The version of the binary mesh format is not "
+                         "supported."));
+  AssertThrow(header[1] == 0x01020304,
+              ExcMessage("The binary mesh was written on a machine with a "
+                         "different byte order."));
+  AssertThrow(header[2] == dim && header[3] == spacedim,
+              ExcMessage("The binary mesh has dimension " +
+                         Utilities::to_string(header[2]) +
+                         " and space dimension " +
+                         Utilities::to_string(header[3]) +
+                         ", which differ from the ones of the triangulation."));
+
+  const std::vector<double> coordinates =
+    read_binary_array<double>(in, sizes[0] * spacedim);
+  const std::vector<std::uint32_t> cell_data = read_binary_array<std::uint32_t>(
+    in, sizes[1] * (GeometryInfo<dim>::vertices_per_cell + 2));
+  const std::vector<std::uint32_t> line_data =
+    read_binary_array<std::uint32_t>(in, sizes[2] * 4);
+  const std::vector<std::uint32_t> quad_data =
+    read_binary_array<std::uint32_t>(in, sizes[3] * 6);
+  const std::vector<std::uint8_t> refinement_cases =
+    read_binary_array<std::uint8_t>(in, sizes[4]);
+
+  std::vector<Point<spacedim>> vertices(sizes[0]);
+  for (unsigned int v = 0; v < vertices.size(); ++v)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      vertices[v][d] = coordinates[v * spacedim + d];
+
+  std::vector<CellData<dim>> cells(sizes[1]);
+  {
+    auto data = cell_data.begin();
+    for (auto &cell : cells)
+      {
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          cell.vertices[v] = *data++;
+        cell.material_id = *data++;
+        cell.manifold_id = *data++;
+      }
+  }
+
+  SubCellData subcelldata;
+  subcelldata.boundary_lines.resize(sizes[2]);
+  for (unsigned int l = 0; l < sizes[2]; ++l)
+    {
+      subcelldata.boundary_lines[l].vertices[0] = line_data[4 * l];
+      subcelldata.boundary_lines[l].vertices[1] = line_data[4 * l + 1];
+      subcelldata.boundary_lines[l].boundary_id = line_data[4 * l + 2];
+      subcelldata.boundary_lines[l].manifold_id = line_data[4 * l + 3];
+    }
+  subcelldata.boundary_quads.resize(sizes[3]);
+  for (unsigned int q = 0; q < sizes[3]; ++q)
+    {
+      for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+        subcelldata.boundary_quads[q].vertices[v] = quad_data[6 * q + v];
+      subcelldata.boundary_quads[q].boundary_id = quad_data[6 * q + 4];
+      subcelldata.boundary_quads[q].manifold_id = quad_data[6 * q + 5];
+    }
+
+  // the data is already in the format expected by the triangulation, so
+  // neither delete_unused_vertices() nor the reordering of the cells is
+  // necessary
+  tria->create_triangulation(vertices, cells, subcelldata);
+
+  if (refinement_cases.size() == 0)
+    return;
+
+  AssertThrow((dynamic_cast<
+                 parallel::DistributedTriangulationBase<dim, spacedim> *>(
+                 &*tria) == nullptr),
+              ExcMessage("The refinement of a binary mesh can not be restored "
+                         "for distributed triangulations."));
+
+  // restore the refinement level by level, traversing the cells in the
+  // same breadth-first order in which GridOut::write_binary() has written
+  // their refinement cases
+  std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+    current_cells(tria->begin(0), tria->end(0));
+  std::vector<typename Triangulation<dim, spacedim>::cell_iterator> next_cells;
+  std::size_t next_refinement_case = 0;
+  while (current_cells.size() > 0)
+    {
+      AssertThrow(next_refinement_case + current_cells.size() <=
+                    refinement_cases.size(),
+                  ExcIO());
+      const std::uint8_t *level_refinement_cases =
+        refinement_cases.data() + next_refinement_case;
+      next_refinement_case += current_cells.size();
+
+      bool any_cell_refined = false;
+      for (unsigned int i = 0; i < current_cells.size(); ++i)
+        if (level_refinement_cases[i] != RefinementCase<dim>::no_refinement)
+          {
+            Assert(current_cells[i]->active(), ExcInternalError());
+            current_cells[i]->set_refine_flag(
+              RefinementCase<dim>(level_refinement_cases[i]));
+            any_cell_refined = true;
+          }
+      if (any_cell_refined)
+        tria->execute_coarsening_and_refinement();
+
+      next_cells.clear();
+      for (unsigned int i = 0; i < current_cells.size(); ++i)
+        if (level_refinement_cases[i] != RefinementCase<dim>::no_refinement)
+          for (unsigned int c = 0; c < current_cells[i]->n_children(); ++c)
+            next_cells.push_back(current_cells[i]->child(c));
+      current_cells.swap(next_cells);
+    }
+  AssertThrow(next_refinement_case == refinement_cases.size(), ExcIO());
+}
+
+
+
 template <int dim, int spacedim>
 void
 GridIn<dim, spacedim>::read_unv(std::istream &in)
@@ -747,13 +907,26 @@ GridIn<dim, spacedim>::read_unv(std::istream &in)
 template <int dim, int spacedim>
 void
 GridIn<dim, spacedim>::read_ucd(std::istream &in,
-                                const bool    apply_all_indicators_to_manifolds)
+                                const bool    apply_all_indicators_to_manifolds,
+                                const bool    trust_orientation_marker)
 {
   Assert(tria != nullptr, ExcNoTriangulationSelected());
   AssertThrow(in, ExcIO());
 
-  // skip comments at start of file
-  skip_comment_lines(in, '#');
+  // skip comments at start of file. files written by GridOut::write_ucd()
+  // state in these comments that their cells are already consistently
+  // oriented, in which case the reordering at the end can be skipped if
+  // the caller asked us to rely on this statement
+  bool cells_are_oriented = false;
+  while (in.peek() == '#')
+    {
+      std::string line;
+      std::getline(in, line);
+      if (trust_orientation_marker &&
+          line == "# The cells of this mesh are consistently oriented.")
+        cells_are_oriented = true;
+    }
+  skip_empty_lines(in);
 
 
   unsigned int n_vertices;
@@ -979,10 +1152,13 @@ GridIn<dim, spacedim>::read_ucd(std::istream &in,
   // do some clean-up on vertices...
   GridTools::delete_unused_vertices(vertices, cells, subcelldata);
   // ... and cells
-  if (dim == spacedim)
-    GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
-                                                                     cells);
-  GridReordering<dim, spacedim>::reorder_cells(cells);
+  if (cells_are_oriented == false)
+    {
+      if (dim == spacedim)
+        GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(
+          vertices, cells);
+      GridReordering<dim, spacedim>::reorder_cells(cells);
+    }
   tria->create_triangulation_compatibility(vertices, cells, subcelldata);
 }
 
@@ -2034,6 +2210,726 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
 }
 
 
+#ifdef DEAL_II_WITH_MPI
+namespace internal
+{
+  namespace ParallelMshImplementation
+  {
+    /**
+     * Exchange data with the given processes, including the current one,
+     * and clear the send buffers.
+     */
+    template <typename T>
+    std::map<unsigned int, T>
+    exchange_data(const MPI_Comm comm, std::map<unsigned int, T> &send_data)
+    {
+      const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+      std::map<unsigned int, T> received_data;
+      const auto                own_data = send_data.find(my_rank);
+      if (own_data != send_data.end())
+        {
+          received_data[my_rank] = std::move(own_data->second);
+          send_data.erase(own_data);
+        }
+      if (Utilities::MPI::n_mpi_processes(comm) > 1)
+        {
+          const auto other_data = Utilities::MPI::some_to_some(comm, send_data);
+          received_data.insert(other_data.begin(), other_data.end());
+        }
+      send_data.clear();
+      return received_data;
+    }
+
+
+
+    /**
+     * Call @p line_function for all lines of @p in whose first character is
+     * located at an offset in [begin, end). The second argument of the
+     * function is the offset of the start of the line.
+     */
+    void
+    for_each_line(
+      std::ifstream &     in,
+      const std::uint64_t begin,
+      const std::uint64_t end,
+      const std::function<void(const std::string &, const std::uint64_t)>
+        &line_function)
+    {
+      if (begin >= end)
+        return;
+
+      in.clear();
+      std::uint64_t position = begin;
+      std::string   line;
+      if (begin > 0)
+        {
+          // skip the remainder of the line that starts in front of the range
+          in.seekg(begin - 1);
+          char previous = '\n';
+          in.get(previous);
+          if (previous != '\n')
+            {
+              std::getline(in, line);
+              if (!in || in.eof())
+                return;
+              position += line.size() + 1;
+            }
+        }
+      else
+        in.seekg(0);
+
+      while (position < end && std::getline(in, line))
+        {
+          const std::uint64_t line_start = position;
+          position += line.size() + 1;
+          if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+          line_function(line, line_start);
+          if (in.eof())
+            break;
+        }
+    }
+
+
+
+    /**
+     * Return the subrange of [begin, end) this process is responsible for.
+     */
+    std::pair<std::uint64_t, std::uint64_t>
+    local_range(const std::uint64_t begin,
+                const std::uint64_t end,
+                const MPI_Comm      comm)
+    {
+      const std::uint64_t my_rank = Utilities::MPI::this_mpi_process(comm);
+      const std::uint64_t n_procs = Utilities::MPI::n_mpi_processes(comm);
+      const std::uint64_t size    = end - begin;
+      return {begin + size * my_rank / n_procs,
+              begin + size * (my_rank + 1) / n_procs};
+    }
+
+
+
+    /**
+     * Return the position of the first data line of the section starting
+     * with the marker at @p marker_position, skipping the line with the
+     * number of entries.
+     */
+    std::uint64_t
+    section_data_begin(std::ifstream &in, const std::uint64_t marker_position)
+    {
+      in.clear();
+      in.seekg(marker_position);
+      std::string line;
+      std::getline(in, line);
+      std::uint64_t position = marker_position + line.size() + 1;
+      std::getline(in, line);
+      AssertThrow(in, ExcIO());
+      position += line.size() + 1;
+      return position;
+    }
+
+
+
+    /**
+     * Parse a list of whitespace-separated integers from a line.
+     */
+    void
+    parse_integers(const std::string &line, std::vector<long long> &values)
+    {
+      values.clear();
+      const char *ptr = line.c_str();
+      while (true)
+        {
+          char *          end_ptr = nullptr;
+          const long long value   = std::strtoll(ptr, &end_ptr, 10);
+          if (end_ptr == ptr)
+            break;
+          values.push_back(value);
+          ptr = end_ptr;
+        }
+    }
+
+
+
+    /**
+     * Convert the vertex numbering of a cell from the ucd-style numbering
+     * used by Gmsh to the lexicographic numbering of deal.II.
+     */
+    void
+    convert_vertex_numbering(CellData<1> &)
+    {}
+
+
+
+    void
+    convert_vertex_numbering(CellData<2> &cell)
+    {
+      std::swap(cell.vertices[2], cell.vertices[3]);
+    }
+
+
+
+    void
+    convert_vertex_numbering(CellData<3> &cell)
+    {
+      unsigned int tmp[GeometryInfo<3>::vertices_per_cell];
+      for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell; ++i)
+        tmp[i] = cell.vertices[i];
+      for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell; ++i)
+        cell.vertices[GeometryInfo<3>::ucd_to_deal[i]] = tmp[i];
+    }
+
+
+
+    /**
+     * A cell read from the file, with the Gmsh node numbers as vertices.
+     */
+    template <int dim>
+    struct Cell
+    {
+      types::coarse_cell_id index;
+      types::subdomain_id   subdomain_id;
+      types::material_id    material_id;
+      std::array<std::uint64_t, GeometryInfo<dim>::vertices_per_cell> vertices;
+    };
+  } // namespace ParallelMshImplementation
+} // namespace internal
+#endif
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_msh(const std::string &filename,
+                                const MPI_Comm     comm)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
+
+#ifdef DEAL_II_WITH_MPI
+  auto *const fully_distributed_tria =
+    dynamic_cast<parallel::fullydistributed::Triangulation<dim, spacedim> *>(
+      &*tria);
+#else
+  const void *const fully_distributed_tria = nullptr;
+#endif
+
+  if (fully_distributed_tria == nullptr)
+    {
+      AssertThrow(Utilities::MPI::n_mpi_processes(comm) == 1,
+                  ExcMessage("Reading a mesh in parallel requires a "
+                             "parallel::fullydistributed::Triangulation."));
+      std::ifstream in(filename);
+      AssertThrow(in, ExcFileNotOpen(filename));
+      read_msh(in);
+      return;
+    }
+
+#ifdef DEAL_II_WITH_MPI
+  using namespace internal::ParallelMshImplementation;
+
+  constexpr unsigned int vertices_per_cell =
+    GeometryInfo<dim>::vertices_per_cell;
+  constexpr unsigned int vertices_per_face =
+    GeometryInfo<dim>::vertices_per_face;
+  using FaceKey = std::array<std::uint64_t, vertices_per_face>;
+
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+  std::ifstream in(filename, std::ios::binary);
+  AssertThrow(in, ExcFileNotOpen(filename));
+
+  // check the header; this is cheap enough to be done on every process
+  {
+    std::string  line;
+    double       version   = 0;
+    unsigned int file_type = 1, data_size = 0;
+    in >> line;
+    AssertThrow(line == "$MeshFormat", ExcInvalidGMSHInput(line));
+    in >> version >> file_type >> data_size;
+    AssertThrow(version >= 2.0 && version < 3.0 && file_type == 0,
+                ExcMessage("Reading a mesh in parallel is only implemented "
+                           "for ASCII files of version 2 of the Gmsh "
+                           "format."));
+  }
+
+  in.clear();
+  in.seekg(0, std::ios::end);
+  const std::uint64_t file_size = in.tellg();
+
+  // 1) find the sections of nodes and elements: every process scans a
+  // range of the file for the section markers
+  const std::array<std::string, 4> markers = {
+    {"$Nodes", "$EndNodes", "$Elements", "$EndElements"}};
+  std::vector<std::uint64_t> marker_positions(
+    markers.size(), std::numeric_limits<std::uint64_t>::max());
+  {
+    const auto range = local_range(0, file_size, comm);
+    for_each_line(in,
+                  range.first,
+                  range.second,
+                  [&](const std::string &line, const std::uint64_t position) {
+                    if (line.empty() || line[0] != '$')
+                      return;
+                    for (unsigned int m = 0; m < markers.size(); ++m)
+                      if (line == markers[m])
+                        marker_positions[m] =
+                          std::min(marker_positions[m], position);
+                  });
+    Utilities::MPI::min(marker_positions, comm, marker_positions);
+    for (unsigned int m = 0; m < markers.size(); ++m)
+      AssertThrow(marker_positions[m] !=
+                    std::numeric_limits<std::uint64_t>::max(),
+                  ExcInvalidGMSHInput(markers[m]));
+  }
+
+  // 2) parse the local part of the nodes...
+  std::vector<std::pair<std::uint64_t, Point<spacedim>>> local_nodes;
+  {
+    const auto range =
+      local_range(section_data_begin(in, marker_positions[0]),
+                  marker_positions[1],
+                  comm);
+    for_each_line(in,
+                  range.first,
+                  range.second,
+                  [&](const std::string &line, const std::uint64_t) {
+                    const char *ptr     = line.c_str();
+                    char *      end_ptr = nullptr;
+                    const std::uint64_t node = std::strtoull(ptr, &end_ptr, 10);
+                    if (end_ptr == ptr)
+                      return;
+                    Point<spacedim> point;
+                    for (unsigned int d = 0; d < 3; ++d)
+                      {
+                        ptr                = end_ptr;
+                        const double value = std::strtod(ptr, &end_ptr);
+                        AssertThrow(end_ptr != ptr, ExcInvalidGMSHInput(line));
+                        if (d < spacedim)
+                          point[d] = value;
+                      }
+                    local_nodes.emplace_back(node, point);
+                  });
+  }
+
+  // ... and of the elements, where the cells in the range of this process
+  // become its locally owned cells and the lower-dimensional elements
+  // describe boundary ids
+  std::vector<Cell<dim>>                              owned_cells;
+  std::vector<std::pair<FaceKey, types::boundary_id>> local_faces;
+  {
+    const int cell_type = (dim == 1 ? 1 : (dim == 2 ? 3 : 5));
+    const int face_type = (dim == 1 ? 15 : (dim == 2 ? 1 : 3));
+
+    std::vector<long long> values;
+    const auto             range =
+      local_range(section_data_begin(in, marker_positions[2]),
+                  marker_positions[3],
+                  comm);
+    for_each_line(
+      in,
+      range.first,
+      range.second,
+      [&](const std::string &line, const std::uint64_t) {
+        // the format of each element is
+        //   elm-number elm-type number-of-tags < tag > ... node-number-list
+        parse_integers(line, values);
+        if (values.empty())
+          return;
+        AssertThrow(values.size() >= 3 &&
+                      values.size() >= 3 + static_cast<std::size_t>(values[2]),
+                    ExcInvalidGMSHInput(line));
+        const int          type      = values[1];
+        const unsigned int n_tags    = values[2];
+        const unsigned int n_nodes   = values.size() - 3 - n_tags;
+        const long long    first_tag = (n_tags > 0 ? values[3] : 0);
+        const auto         nodes     = values.begin() + 3 + n_tags;
+
+        AssertThrow(type != 2,
+                    ExcMessage("Found triangles while reading a file "
+                               "in gmsh format. deal.II does not "
+                               "support triangles"));
+        AssertThrow(type != 11,
+                    ExcMessage("Found tetrahedra while reading a file "
+                               "in gmsh format. deal.II does not "
+                               "support tetrahedra"));
+
+        if (type == cell_type)
+          {
+            AssertThrow(n_nodes == vertices_per_cell,
+                        ExcMessage("Number of nodes does not coincide with the "
+                                   "number required for this object"));
+            Assert(first_tag >= 0 &&
+                     first_tag < numbers::invalid_material_id,
+                   ExcIndexRange(first_tag, 0, numbers::invalid_material_id));
+            Cell<dim> cell;
+            cell.index        = owned_cells.size();
+            cell.subdomain_id = my_rank;
+            cell.material_id  = static_cast<types::material_id>(first_tag);
+            for (unsigned int v = 0; v < vertices_per_cell; ++v)
+              cell.vertices[v] = nodes[v];
+            owned_cells.push_back(cell);
+          }
+        else if (type == face_type)
+          {
+            AssertThrow(n_nodes == vertices_per_face,
+                        ExcMessage("Number of nodes does not coincide with the "
+                                   "number required for this object"));
+            Assert(first_tag >= 0 &&
+                     first_tag < numbers::internal_face_boundary_id,
+                   ExcIndexRange(first_tag,
+                                 0,
+                                 numbers::internal_face_boundary_id));
+            FaceKey face;
+            for (unsigned int v = 0; v < vertices_per_face; ++v)
+              face[v] = nodes[v];
+            std::sort(face.begin(), face.end());
+            local_faces.emplace_back(face,
+                                     static_cast<types::boundary_id>(
+                                       first_tag));
+          }
+        else
+          // lines in 3d and points in 2d and 3d are ignored as in the
+          // serial reader
+          AssertThrow((type == 1 && dim == 3) || (type == 15 && dim > 1),
+                      ExcGmshUnsupportedGeometry(type));
+      });
+  }
+
+  // number the cells globally in the order of the file
+  {
+    const std::vector<types::coarse_cell_id> n_cells =
+      Utilities::MPI::all_gather(comm,
+                                 static_cast<types::coarse_cell_id>(
+                                   owned_cells.size()));
+    const types::coarse_cell_id offset =
+      std::accumulate(n_cells.begin(), n_cells.begin() + my_rank,
+                      types::coarse_cell_id(0));
+    for (Cell<dim> &cell : owned_cells)
+      cell.index += offset;
+    AssertThrow(std::accumulate(n_cells.begin(),
+                                n_cells.end(),
+                                types::coarse_cell_id(0)) > 0,
+                ExcGmshNoCellInformation());
+  }
+
+  // 3) the nodes are distributed among the processes by contiguous ranges
+  // of node numbers, which serves as a dictionary for the vertex
+  // coordinates and the processes using a vertex
+  std::uint64_t max_node = 0;
+  for (const auto &node : local_nodes)
+    max_node = std::max(max_node, node.first);
+  max_node = Utilities::MPI::max(max_node, comm);
+  const std::uint64_t nodes_per_process = max_node / n_procs + 1;
+  const auto          dictionary_owner  = [&](const std::uint64_t node) {
+    return static_cast<unsigned int>(node / nodes_per_process);
+  };
+
+  std::map<std::uint64_t, Point<spacedim>> dictionary_points;
+  {
+    std::map<unsigned int, std::vector<std::uint64_t>> send_nodes;
+    std::map<unsigned int, std::vector<double>>        send_points;
+    for (const auto &node : local_nodes)
+      {
+        const unsigned int owner = dictionary_owner(node.first);
+        send_nodes[owner].push_back(node.first);
+        for (unsigned int d = 0; d < spacedim; ++d)
+          send_points[owner].push_back(node.second[d]);
+      }
+    local_nodes.clear();
+
+    std::map<unsigned int,
+             std::pair<std::vector<std::uint64_t>, std::vector<double>>>
+      send_data;
+    for (auto &data : send_nodes)
+      {
+        auto &entry = send_data[data.first];
+        entry.first.swap(data.second);
+        entry.second.swap(send_points[data.first]);
+      }
+    for (const auto &data : exchange_data(comm, send_data))
+      for (unsigned int i = 0; i < data.second.first.size(); ++i)
+        {
+          Point<spacedim> &point = dictionary_points[data.second.first[i]];
+          for (unsigned int d = 0; d < spacedim; ++d)
+            point[d] = data.second.second[i * spacedim + d];
+        }
+  }
+
+  // 4) register the vertices of the locally owned cells in the dictionary,
+  // and get their coordinates and the other processes using them
+  std::map<std::uint64_t, Point<spacedim>>           vertex_points;
+  std::map<std::uint64_t, std::vector<unsigned int>> vertex_other_users;
+  {
+    std::map<unsigned int, std::vector<std::uint64_t>> requests;
+    {
+      std::vector<std::uint64_t> used_nodes;
+      for (const Cell<dim> &cell : owned_cells)
+        used_nodes.insert(used_nodes.end(),
+                          cell.vertices.begin(),
+                          cell.vertices.end());
+      std::sort(used_nodes.begin(), used_nodes.end());
+      used_nodes.erase(std::unique(used_nodes.begin(), used_nodes.end()),
+                       used_nodes.end());
+      for (const std::uint64_t node : used_nodes)
+        requests[dictionary_owner(node)].push_back(node);
+    }
+
+    auto       send_requests     = requests;
+    const auto received_requests = exchange_data(comm, send_requests);
+    std::map<std::uint64_t, std::vector<unsigned int>> users;
+    for (const auto &request : received_requests)
+      for (const std::uint64_t node : request.second)
+        users[node].push_back(request.first);
+
+    std::map<unsigned int,
+             std::pair<std::vector<double>, std::vector<unsigned int>>>
+      replies;
+    for (const auto &request : received_requests)
+      {
+        auto &reply = replies[request.first];
+        for (const std::uint64_t node : request.second)
+          {
+            const auto point = dictionary_points.find(node);
+            AssertThrow(point != dictionary_points.end(),
+                        ExcMessage("The node " + Utilities::to_string(node) +
+                                   " used by a cell is not listed in the "
+                                   "$Nodes section of the file."));
+            for (unsigned int d = 0; d < spacedim; ++d)
+              reply.first.push_back(point->second[d]);
+            const std::vector<unsigned int> &node_users = users[node];
+            reply.second.push_back(node_users.size() - 1);
+            for (const unsigned int user : node_users)
+              if (user != request.first)
+                reply.second.push_back(user);
+          }
+      }
+    dictionary_points.clear();
+
+    for (const auto &reply : exchange_data(comm, replies))
+      {
+        const std::vector<std::uint64_t> &nodes = requests[reply.first];
+        unsigned int                      pos   = 0;
+        for (unsigned int i = 0; i < nodes.size(); ++i)
+          {
+            Point<spacedim> &point = vertex_points[nodes[i]];
+            for (unsigned int d = 0; d < spacedim; ++d)
+              point[d] = reply.second.first[i * spacedim + d];
+            const unsigned int n_other_users = reply.second.second[pos++];
+            if (n_other_users > 0)
+              vertex_other_users[nodes[i]].assign(
+                reply.second.second.begin() + pos,
+                reply.second.second.begin() + pos + n_other_users);
+            pos += n_other_users;
+          }
+      }
+  }
+
+  // 5) send the locally owned cells to the processes that own a cell
+  // sharing a vertex with them, along with the vertex coordinates
+  std::vector<Cell<dim>> cells = owned_cells;
+  {
+    std::map<unsigned int,
+             std::pair<std::vector<std::uint64_t>, std::vector<double>>>
+      send_data;
+    std::set<unsigned int> targets;
+    for (const Cell<dim> &cell : owned_cells)
+      {
+        targets.clear();
+        for (const std::uint64_t node : cell.vertices)
+          {
+            const auto other_users = vertex_other_users.find(node);
+            if (other_users != vertex_other_users.end())
+              targets.insert(other_users->second.begin(),
+                             other_users->second.end());
+          }
+        for (const unsigned int target : targets)
+          {
+            auto &data = send_data[target];
+            data.first.push_back(cell.index);
+            data.first.push_back(cell.material_id);
+            for (const std::uint64_t node : cell.vertices)
+              {
+                data.first.push_back(node);
+                const Point<spacedim> &point = vertex_points[node];
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  data.second.push_back(point[d]);
+              }
+          }
+      }
+    owned_cells.clear();
+    vertex_other_users.clear();
+
+    for (const auto &data : exchange_data(comm, send_data))
+      {
+        const std::vector<std::uint64_t> &buffer = data.second.first;
+        const std::vector<double> &       points = data.second.second;
+        unsigned int                      v_pos  = 0;
+        for (unsigned int pos = 0; pos < buffer.size();
+             pos += 2 + vertices_per_cell)
+          {
+            Cell<dim> cell;
+            cell.index        = buffer[pos];
+            cell.subdomain_id = data.first;
+            cell.material_id =
+              static_cast<types::material_id>(buffer[pos + 1]);
+            for (unsigned int v = 0; v < vertices_per_cell; ++v, ++v_pos)
+              {
+                cell.vertices[v] = buffer[pos + 2 + v];
+                Point<spacedim> &point = vertex_points[cell.vertices[v]];
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  point[d] = points[v_pos * spacedim + d];
+              }
+            cells.push_back(cell);
+          }
+      }
+  }
+  std::sort(cells.begin(),
+            cells.end(),
+            [](const Cell<dim> &a, const Cell<dim> &b) {
+              return a.index < b.index;
+            });
+
+  // 6) set up the locally relevant coarse cells with a local numbering of
+  // the vertices
+  parallel::fullydistributed::ConstructionData<dim, spacedim> construction_data;
+  std::vector<std::uint64_t> local_to_node;
+  {
+    std::map<std::uint64_t, unsigned int> node_to_local;
+    for (const Cell<dim> &cell : cells)
+      {
+        CellData<dim> cell_data;
+        for (unsigned int v = 0; v < vertices_per_cell; ++v)
+          {
+            const auto entry =
+              node_to_local.emplace(cell.vertices[v], local_to_node.size());
+            if (entry.second)
+              {
+                local_to_node.push_back(cell.vertices[v]);
+                construction_data.coarse_cell_vertices.push_back(
+                  vertex_points[cell.vertices[v]]);
+              }
+            cell_data.vertices[v] = entry.first->second;
+          }
+        cell_data.material_id = cell.material_id;
+        construction_data.coarse_cells.push_back(cell_data);
+        construction_data.coarse_cell_index_to_coarse_cell_id.push_back(
+          cell.index);
+      }
+    vertex_points.clear();
+
+    if (dim == spacedim)
+      GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(
+        construction_data.coarse_cell_vertices, construction_data.coarse_cells);
+    for (CellData<dim> &cell_data : construction_data.coarse_cells)
+      convert_vertex_numbering(cell_data);
+  }
+
+  // 7) look up the boundary ids of the faces that are not shared by two
+  // locally relevant cells: the faces are collected by the process owning
+  // the smallest node of the face in the dictionary
+  std::vector<std::vector<std::pair<unsigned int, types::boundary_id>>>
+    boundary_ids(cells.size());
+  {
+    std::map<FaceKey, std::pair<unsigned int, unsigned int>> face_to_cell;
+    std::set<FaceKey>                                        shared_faces;
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        {
+          FaceKey face;
+          for (unsigned int v = 0; v < vertices_per_face; ++v)
+            face[v] = local_to_node[construction_data.coarse_cells[c].vertices
+                                      [GeometryInfo<dim>::face_to_cell_vertices(
+                                        f, v)]];
+          std::sort(face.begin(), face.end());
+          if (face_to_cell.emplace(face, std::make_pair(c, f)).second == false)
+            shared_faces.insert(face);
+        }
+    for (const FaceKey &face : shared_faces)
+      face_to_cell.erase(face);
+
+    std::map<unsigned int,
+             std::pair<std::vector<std::uint64_t>, std::vector<std::uint64_t>>>
+      send_data;
+    for (const auto &face : local_faces)
+      {
+        auto &data = send_data[dictionary_owner(face.first[0])].first;
+        data.push_back(face.second);
+        data.insert(data.end(), face.first.begin(), face.first.end());
+      }
+    local_faces.clear();
+    std::map<unsigned int, std::vector<std::pair<unsigned int, unsigned int>>>
+      queried_faces;
+    for (const auto &face : face_to_cell)
+      {
+        const unsigned int owner = dictionary_owner(face.first[0]);
+        auto &             data  = send_data[owner].second;
+        data.insert(data.end(), face.first.begin(), face.first.end());
+        queried_faces[owner].push_back(face.second);
+      }
+
+    const auto received_data = exchange_data(comm, send_data);
+    std::map<FaceKey, types::boundary_id> dictionary_faces;
+    for (const auto &data : received_data)
+      for (unsigned int pos = 0; pos < data.second.first.size();
+           pos += 1 + vertices_per_face)
+        {
+          FaceKey face;
+          std::copy(data.second.first.begin() + pos + 1,
+                    data.second.first.begin() + pos + 1 + vertices_per_face,
+                    face.begin());
+          dictionary_faces[face] = data.second.first[pos];
+        }
+    std::map<unsigned int, std::vector<types::boundary_id>> replies;
+    for (const auto &data : received_data)
+      if (data.second.second.empty() == false)
+        {
+          auto &reply = replies[data.first];
+          for (unsigned int pos = 0; pos < data.second.second.size();
+               pos += vertices_per_face)
+            {
+              FaceKey face;
+              std::copy(data.second.second.begin() + pos,
+                        data.second.second.begin() + pos + vertices_per_face,
+                        face.begin());
+              const auto entry = dictionary_faces.find(face);
+              reply.push_back(entry != dictionary_faces.end() ?
+                                entry->second :
+                                numbers::internal_face_boundary_id);
+            }
+        }
+
+    for (const auto &reply : exchange_data(comm, replies))
+      {
+        const auto &faces = queried_faces[reply.first];
+        AssertDimension(faces.size(), reply.second.size());
+        for (unsigned int i = 0; i < faces.size(); ++i)
+          if (reply.second[i] != numbers::internal_face_boundary_id)
+            boundary_ids[faces[i].first].emplace_back(faces[i].second,
+                                                      reply.second[i]);
+      }
+  }
+
+  // 8) describe the cells on the coarse level and create the triangulation
+  construction_data.cell_infos.resize(1);
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    {
+      parallel::fullydistributed::CellInfo<dim> info;
+      info.id = CellId(cells[c].index, std::vector<std::uint8_t>())
+                  .template to_binary<dim>();
+      info.subdomain_id = cells[c].subdomain_id;
+      info.material_id  = cells[c].material_id;
+      info.boundary_ids = std::move(boundary_ids[c]);
+      construction_data.cell_infos[0].push_back(info);
+    }
+
+  fully_distributed_tria->create_triangulation(construction_data);
+#else
+  (void)fully_distributed_tria;
+#endif
+}
+
+
 template <>
 void
 GridIn<1>::read_netcdf(const std::string &)
@@ -3358,8 +4254,6 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
   else
     name = search.find(filename, default_suffix(format));
 
-  std::ifstream in(name.c_str());
-
   if (format == Default)
     {
       const std::string::size_type slashpos = name.find_last_of('/');
@@ -3371,6 +4265,10 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
           format          = parse_format(ext);
         }
     }
+
+  std::ifstream in(name.c_str(),
+                   format == binary ? std::ios::in | std::ios::binary :
+                                      std::ios::in);
   if (format == netcdf)
     read_netcdf(filename);
   else
@@ -3433,6 +4331,10 @@ GridIn<dim, spacedim>::read(std::istream &in, Format format)
                           "functions, instead."));
         return;
 
+      case binary:
+        read_binary(in);
+        return;
+
       case Default:
         break;
     }
@@ -3466,6 +4368,8 @@ GridIn<dim, spacedim>::default_suffix(const Format format)
         return ".nc";
       case tecplot:
         return ".dat";
+      case binary:
+        return ".dealii";
       default:
         Assert(false, ExcNotImplemented());
         return ".unknown_format";
@@ -3524,6 +4428,12 @@ GridIn<dim, spacedim>::parse_format(const std::string &format_name)
     // and throw an exception, anyway.
     return tecplot;
 
+  if (format_name == "binary")
+    return binary;
+
+  if (format_name == "dealii")
+    return binary;
+
   AssertThrow(false, ExcInvalidState());
   // return something weird
   return Format(Default);
@@ -3535,7 +4445,7 @@ template <int dim, int spacedim>
 std::string
 GridIn<dim, spacedim>::get_format_names()
 {
-  return "dbmesh|msh|unv|vtk|ucd|abaqus|xda|netcdf|tecplot|assimp";
+  return "dbmesh|msh|unv|vtk|ucd|abaqus|xda|netcdf|tecplot|assimp|binary";
 }
 
 
@@ -20,9 +20,12 @@
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature.h>
 
+#include <deal.II/distributed/tria_base.h>
+
 #include <deal.II/fe/mapping.h>
 
 #include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
 #include <deal.II/grid/tria_iterator.h>
@@ -31,6 +34,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <fstream>
@@ -597,6 +601,8 @@ GridOut::default_suffix(const OutputFormat output_format)
         return ".vtk";
       case vtu:
         return ".vtu";
+      case binary:
+        return ".dealii";
       default:
         Assert(false, ExcNotImplemented());
         return "";
@@ -649,6 +655,9 @@ GridOut::parse_output_format(const std::string &format_name)
   if (format_name == "vtu")
     return vtu;
 
+  if (format_name == "binary")
+    return binary;
+
   AssertThrow(false, ExcInvalidState());
   // return something weird
   return OutputFormat(-1);
@@ -659,7 +668,7 @@ GridOut::parse_output_format(const std::string &format_name)
 std::string
 GridOut::get_output_format_names()
 {
-  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|vtk|vtu";
+  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|vtk|vtu|binary";
 }
 
 
@@ -1216,6 +1225,7 @@ GridOut::write_ucd(const Triangulation<dim, spacedim> &tria,
       std::tm *   time  = std::localtime(&time1);
       out
         << "# This file was generated by the deal.II library." << '\n'
+        << "# The cells of this mesh are consistently oriented." << '\n'
         << "# Date =  " << time->tm_year + 1900 << "/" << time->tm_mon + 1
         << "/" << time->tm_mday << '\n'
         << "# Time =  " << time->tm_hour << ":" << std::setw(2) << time->tm_min
@@ -3213,6 +3223,130 @@ GridOut::write_vtu(const Triangulation<dim, spacedim> &tria,
 
 
 
+namespace
+{
+  /**
+   * Write the elements of @p array to @p out as one block of bytes.
+   */
+  template <typename T>
+  void
+  write_binary_array(const std::vector<T> &array, std::ostream &out)
+  {
+    out.write(reinterpret_cast<const char *>(array.data()),
+              array.size() * sizeof(T));
+  }
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+GridOut::write_binary(const Triangulation<dim, spacedim> &tria,
+                      std::ostream &                      out) const
+{
+  AssertThrow(out, ExcIO());
+  Assert((dynamic_cast<
+            const parallel::DistributedTriangulationBase<dim, spacedim> *>(
+            &tria) == nullptr),
+         ExcMessage("This function can not be used with distributed "
+                    "triangulations, since they only store a part of the "
+                    "mesh on each process."));
+
+  // the coarse mesh in the form in which it is given to
+  // Triangulation::create_triangulation()
+  const auto description = GridTools::get_coarse_mesh_description(tria);
+  const std::vector<Point<spacedim>> &vertices = std::get<0>(description);
+  const std::vector<CellData<dim>> &  cells    = std::get<1>(description);
+  const SubCellData &                 subcell_data = std::get<2>(description);
+
+  // the refinement cases of all cells in breadth-first order: first the
+  // coarse cells, then the children of the refined coarse cells in the
+  // order of their parents, etc. in contrast to the order in which the
+  // cells of a level are stored, this order only depends on the mesh and
+  // not on its history
+  std::vector<std::uint8_t> refinement_cases;
+  if (tria.n_levels() > 1)
+    {
+      std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+        current_cells(tria.begin(0), tria.end(0));
+      std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+        next_cells;
+      while (current_cells.size() > 0)
+        {
+          next_cells.clear();
+          for (const auto &cell : current_cells)
+            {
+              refinement_cases.push_back(
+                static_cast<std::uint8_t>(cell->refinement_case()));
+              for (unsigned int c = 0; c < cell->n_children(); ++c)
+                next_cells.push_back(cell->child(c));
+            }
+          current_cells.swap(next_cells);
+        }
+    }
+
+  // flatten the data into arrays of fixed-size integers and doubles that
+  // can be written (and later read) as contiguous blocks of memory
+  std::vector<double> coordinates;
+  coordinates.reserve(vertices.size() * spacedim);
+  for (const auto &vertex : vertices)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      coordinates.push_back(vertex[d]);
+
+  std::vector<std::uint32_t> cell_data;
+  cell_data.reserve(cells.size() * (GeometryInfo<dim>::vertices_per_cell + 2));
+  for (const auto &cell : cells)
+    {
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        cell_data.push_back(cell.vertices[v]);
+      cell_data.push_back(cell.material_id);
+      cell_data.push_back(cell.manifold_id);
+    }
+
+  std::vector<std::uint32_t> line_data;
+  for (const auto &line : subcell_data.boundary_lines)
+    {
+      line_data.push_back(line.vertices[0]);
+      line_data.push_back(line.vertices[1]);
+      line_data.push_back(line.boundary_id);
+      line_data.push_back(line.manifold_id);
+    }
+
+  std::vector<std::uint32_t> quad_data;
+  for (const auto &quad : subcell_data.boundary_quads)
+    {
+      for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell; ++v)
+        quad_data.push_back(quad.vertices[v]);
+      quad_data.push_back(quad.boundary_id);
+      quad_data.push_back(quad.manifold_id);
+    }
+
+  // the header consists of a line of text identifying the format, followed
+  // by the version of the format, a marker that allows to detect files
+  // written on machines with a different byte order, the dimensions, and
+  // the sizes of the arrays that follow
+  out << "deal.II binary mesh\n";
+  const std::uint32_t header[4] = {1, 0x01020304, dim, spacedim};
+  const std::uint64_t sizes[5]  = {vertices.size(),
+                                  cells.size(),
+                                  subcell_data.boundary_lines.size(),
+                                  subcell_data.boundary_quads.size(),
+                                  refinement_cases.size()};
+  out.write(reinterpret_cast<const char *>(header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+
+  write_binary_array(coordinates, out);
+  write_binary_array(cell_data, out);
+  write_binary_array(line_data, out);
+  write_binary_array(quad_data, out);
+  write_binary_array(refinement_cases, out);
+
+  out.flush();
+  AssertThrow(out, ExcIO());
+}
+
+
+
 template <int dim, int spacedim>
 void
 GridOut::write_mesh_per_processor_as_vtu(
@@ -4789,6 +4923,10 @@ GridOut::write(const Triangulation<dim, spacedim> &tria,
       case vtu:
         write_vtu(tria, out);
         return;
+
+      case binary:
+        write_binary(tria, out);
+        return;
     }
 
   Assert(false, ExcInternalError());
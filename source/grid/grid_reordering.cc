@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/timer.h>
 #include <deal.II/base/utilities.h>
 
@@ -31,81 +32,88 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace
 {
-  /**
-   * A simple data structure denoting an edge, i.e., the ordered pair
-   * of its vertex indices. This is only used in the is_consistent()
-   * function.
-   */
-  struct CheapEdge
-  {
-    /**
-     * Construct an edge from the global indices of its two vertices.
-     */
-    CheapEdge(const unsigned int v0, const unsigned int v1)
-      : v0(v0)
-      , v1(v1)
-    {}
-
-    /**
-     * Comparison operator for edges. It compares based on the
-     * lexicographic ordering of the two vertex indices.
-     */
-    bool
-    operator<(const CheapEdge &e) const
-    {
-      return ((v0 < e.v0) || ((v0 == e.v0) && (v1 < e.v1)));
-    }
-
-  private:
-    /**
-     * The global indices of the vertices that define the edge.
-     */
-    const unsigned int v0, v1;
-  };
-
-
   /**
    * A function that determines whether the edges in a mesh are
-   * already consistently oriented. It does so by adding all edges
-   * of all cells into a set (which automatically eliminates
-   * duplicates) but before that checks whether the reverse edge is
-   * already in the set -- which would imply that a neighboring cell
-   * is inconsistently oriented.
+   * already consistently oriented, i.e., whether all cells that share
+   * an edge see it running from the same vertex to the other one.
+   *
+   * To do so, the edges of all cells are sorted into buckets by the
+   * smaller of their two vertex indices, using a counting sort. Every
+   * edge in a bucket is described by its other vertex and a flag that
+   * indicates whether the edge runs from the smaller to the larger
+   * vertex index. The edges of different buckets are independent, so
+   * the buckets are checked in parallel: after sorting a bucket, the
+   * mesh is inconsistent if two adjacent entries refer to the same
+   * edge with different directions. The cost of this function is
+   * linear in the number of cells as long as the number of cells
+   * around a vertex is bounded.
    */
   template <int dim>
   bool
   is_consistent(const std::vector<CellData<dim>> &cells)
   {
-    std::set<CheapEdge> edges;
+    unsigned int n_vertices = 0;
+    for (const auto &cell : cells)
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        n_vertices = std::max(n_vertices, cell.vertices[v] + 1);
+
+    // count the edges in each bucket and compute the start of the buckets
+    std::vector<unsigned int> bucket_start(n_vertices + 1, 0);
+    for (const auto &cell : cells)
+      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+        {
+          const unsigned int v0 =
+            cell.vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)];
+          const unsigned int v1 =
+            cell.vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)];
+          ++bucket_start[std::min(v0, v1) + 1];
+        }
+    for (unsigned int v = 0; v < n_vertices; ++v)
+      bucket_start[v + 1] += bucket_start[v];
 
-    for (typename std::vector<CellData<dim>>::const_iterator c = cells.begin();
-         c != cells.end();
-         ++c)
-      {
-        // construct the edges in reverse order. for each of them,
-        // ensure that the reverse edge is not yet in the list of
-        // edges (return false if the reverse edge already *is* in
-        // the list) and then add the actual edge to it; std::set
-        // eliminates duplicates automatically
+    // then fill the buckets
+    std::vector<std::pair<unsigned int, bool>> edges(bucket_start.back());
+    {
+      std::vector<unsigned int> next_edge(bucket_start.begin(),
+                                          bucket_start.end() - 1);
+      for (const auto &cell : cells)
         for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
           {
-            const CheapEdge reverse_edge(
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)],
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)]);
-            if (edges.find(reverse_edge) != edges.end())
-              return false;
-
-
-            // ok, not. insert edge in correct order
-            const CheapEdge correct_edge(
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)],
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)]);
-            edges.insert(correct_edge);
+            const unsigned int v0 =
+              cell.vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)];
+            const unsigned int v1 =
+              cell.vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)];
+            if (v0 < v1)
+              edges[next_edge[v0]++] = std::make_pair(v1, true);
+            else
+              edges[next_edge[v1]++] = std::make_pair(v0, false);
           }
-      }
+    }
+
+    // finally count the buckets that contain an edge with both
+    // directions. the buckets are disjoint, so they can be sorted by
+    // different threads at the same time
+    const auto count_inconsistent_buckets = [&](const unsigned int begin,
+                                                const unsigned int end) {
+      unsigned int n_inconsistent_buckets = 0;
+      for (unsigned int v = begin; v < end; ++v)
+        {
+          const auto bucket_begin = edges.begin() + bucket_start[v];
+          const auto bucket_end   = edges.begin() + bucket_start[v + 1];
+          std::sort(bucket_begin, bucket_end);
+          for (auto e = bucket_begin; e != bucket_end; ++e)
+            if (e + 1 != bucket_end && e->first == (e + 1)->first &&
+                e->second != (e + 1)->second)
+              {
+                ++n_inconsistent_buckets;
+                break;
+              }
+        }
+      return n_inconsistent_buckets;
+    };
 
-    // no conflicts found, so return true
-    return true;
+    return parallel::accumulate_from_subranges<unsigned int>(
+             count_inconsistent_buckets, 0U, n_vertices, 1000) == 0;
   }
 
 
@@ -1152,30 +1160,44 @@ GridReordering<2>::invert_all_cells_of_negative_grid(
   const std::vector<Point<2>> &all_vertices,
   std::vector<CellData<2>> &   cells)
 {
-  unsigned int vertices_lex[GeometryInfo<2>::vertices_per_cell];
-  unsigned int n_negative_cells = 0;
-  for (auto &cell : cells)
-    {
-      // GridTools::cell_measure
-      // requires the vertices to be
-      // in lexicographic ordering
-      for (unsigned int i = 0; i < GeometryInfo<2>::vertices_per_cell; ++i)
-        vertices_lex[GeometryInfo<2>::ucd_to_deal[i]] = cell.vertices[i];
-      if (GridTools::cell_measure<2>(all_vertices, vertices_lex) < 0)
-        {
-          ++n_negative_cells;
-          std::swap(cell.vertices[1], cell.vertices[3]);
-
-          // Check whether the resulting cell is now ok.
-          // If not, then the grid is seriously broken and
-          // we just give up.
-          for (unsigned int i = 0; i < GeometryInfo<2>::vertices_per_cell; ++i)
-            vertices_lex[GeometryInfo<2>::ucd_to_deal[i]] = cell.vertices[i];
-          AssertThrow(GridTools::cell_measure<2>(all_vertices, vertices_lex) >
-                        0,
-                      ExcInternalError());
-        }
-    }
+  // the cells are independent of each other, so they are checked and
+  // inverted in parallel
+  const auto invert_negative_cells = [&](const unsigned int begin,
+                                         const unsigned int end) {
+    unsigned int vertices_lex[GeometryInfo<2>::vertices_per_cell];
+    unsigned int n_negative_cells = 0;
+    for (unsigned int c = begin; c < end; ++c)
+      {
+        CellData<2> &cell = cells[c];
+        // GridTools::cell_measure
+        // requires the vertices to be
+        // in lexicographic ordering
+        for (unsigned int i = 0; i < GeometryInfo<2>::vertices_per_cell; ++i)
+          vertices_lex[GeometryInfo<2>::ucd_to_deal[i]] = cell.vertices[i];
+        if (GridTools::cell_measure<2>(all_vertices, vertices_lex) < 0)
+          {
+            ++n_negative_cells;
+            std::swap(cell.vertices[1], cell.vertices[3]);
+
+            // Check whether the resulting cell is now ok.
+            // If not, then the grid is seriously broken and
+            // we just give up.
+            for (unsigned int i = 0; i < GeometryInfo<2>::vertices_per_cell;
+                 ++i)
+              vertices_lex[GeometryInfo<2>::ucd_to_deal[i]] = cell.vertices[i];
+            AssertThrow(GridTools::cell_measure<2>(all_vertices,
+                                                   vertices_lex) > 0,
+                        ExcInternalError());
+          }
+      }
+    return n_negative_cells;
+  };
+  const unsigned int n_negative_cells =
+    parallel::accumulate_from_subranges<unsigned int>(
+      invert_negative_cells,
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      1000);
 
   // We assume that all cells of a grid have
   // either positive or negative volumes but
@@ -1219,32 +1241,46 @@ GridReordering<3>::invert_all_cells_of_negative_grid(
   const std::vector<Point<3>> &all_vertices,
   std::vector<CellData<3>> &   cells)
 {
-  unsigned int vertices_lex[GeometryInfo<3>::vertices_per_cell];
-  unsigned int n_negative_cells = 0;
-  for (auto &cell : cells)
-    {
-      // GridTools::cell_measure
-      // requires the vertices to be
-      // in lexicographic ordering
-      for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell; ++i)
-        vertices_lex[GeometryInfo<3>::ucd_to_deal[i]] = cell.vertices[i];
-      if (GridTools::cell_measure<3>(all_vertices, vertices_lex) < 0)
-        {
-          ++n_negative_cells;
-          // reorder vertices: swap front and back face
-          for (unsigned int i = 0; i < 4; ++i)
-            std::swap(cell.vertices[i], cell.vertices[i + 4]);
-
-          // Check whether the resulting cell is now ok.
-          // If not, then the grid is seriously broken and
-          // we just give up.
-          for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell; ++i)
-            vertices_lex[GeometryInfo<3>::ucd_to_deal[i]] = cell.vertices[i];
-          AssertThrow(GridTools::cell_measure<3>(all_vertices, vertices_lex) >
-                        0,
-                      ExcInternalError());
-        }
-    }
+  // the cells are independent of each other, so they are checked and
+  // inverted in parallel
+  const auto invert_negative_cells = [&](const unsigned int begin,
+                                         const unsigned int end) {
+    unsigned int vertices_lex[GeometryInfo<3>::vertices_per_cell];
+    unsigned int n_negative_cells = 0;
+    for (unsigned int c = begin; c < end; ++c)
+      {
+        CellData<3> &cell = cells[c];
+        // GridTools::cell_measure
+        // requires the vertices to be
+        // in lexicographic ordering
+        for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell; ++i)
+          vertices_lex[GeometryInfo<3>::ucd_to_deal[i]] = cell.vertices[i];
+        if (GridTools::cell_measure<3>(all_vertices, vertices_lex) < 0)
+          {
+            ++n_negative_cells;
+            // reorder vertices: swap front and back face
+            for (unsigned int i = 0; i < 4; ++i)
+              std::swap(cell.vertices[i], cell.vertices[i + 4]);
+
+            // Check whether the resulting cell is now ok.
+            // If not, then the grid is seriously broken and
+            // we just give up.
+            for (unsigned int i = 0; i < GeometryInfo<3>::vertices_per_cell;
+                 ++i)
+              vertices_lex[GeometryInfo<3>::ucd_to_deal[i]] = cell.vertices[i];
+            AssertThrow(GridTools::cell_measure<3>(all_vertices,
+                                                   vertices_lex) > 0,
+                        ExcInternalError());
+          }
+      }
+    return n_negative_cells;
+  };
+  const unsigned int n_negative_cells =
+    parallel::accumulate_from_subranges<unsigned int>(
+      invert_negative_cells,
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      1000);
 
   // We assume that all cells of a
   // grid have either positive or
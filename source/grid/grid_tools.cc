@@ -13,8 +13,11 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/bounding_box.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
@@ -56,10 +59,13 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <list>
+#include <map>
 #include <numeric>
 #include <set>
 #include <tuple>
@@ -1608,25 +1614,35 @@ namespace GridTools
     AssertDimension(vertices.size(), n_vertices);
 
 
+    // the vertices are independent of each other, so work on them in
+    // parallel
     std::vector<std::vector<Tensor<1, spacedim>>> vertex_to_cell_centers(
       n_vertices);
-    for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
-      if (mesh.vertex_used(vertex))
-        {
-          const unsigned int n_neighbor_cells = vertex_to_cells[vertex].size();
-          vertex_to_cell_centers[vertex].resize(n_neighbor_cells);
-
-          typename std::set<typename Triangulation<dim, spacedim>::
-                              active_cell_iterator>::iterator it =
-            vertex_to_cells[vertex].begin();
-          for (unsigned int cell = 0; cell < n_neighbor_cells; ++cell, ++it)
+    parallel::apply_to_subranges(
+      0U,
+      n_vertices,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int vertex = begin; vertex < end; ++vertex)
+          if (mesh.vertex_used(vertex))
             {
-              vertex_to_cell_centers[vertex][cell] =
-                (*it)->center() - vertices[vertex];
-              vertex_to_cell_centers[vertex][cell] /=
-                vertex_to_cell_centers[vertex][cell].norm();
+              const unsigned int n_neighbor_cells =
+                vertex_to_cells[vertex].size();
+              vertex_to_cell_centers[vertex].resize(n_neighbor_cells);
+
+              typename std::set<typename Triangulation<dim, spacedim>::
+                                  active_cell_iterator>::iterator it =
+                vertex_to_cells[vertex].begin();
+              for (unsigned int cell = 0; cell < n_neighbor_cells;
+                   ++cell, ++it)
+                {
+                  vertex_to_cell_centers[vertex][cell] =
+                    (*it)->center() - vertices[vertex];
+                  vertex_to_cell_centers[vertex][cell] /=
+                    vertex_to_cell_centers[vertex][cell].norm();
+                }
             }
-        }
+      },
+      256);
     return vertex_to_cell_centers;
   }
 
@@ -2556,24 +2572,15 @@ namespace GridTools
     cell_connectivity.reinit(triangulation.n_active_cells(),
                              triangulation.n_active_cells());
 
-    // create a map pair<lvl,idx> -> SparsityPattern index
-    // TODO: we are no longer using user_indices for this because we can get
-    // pointer/index clashes when saving/restoring them. The following approach
-    // works, but this map can get quite big. Not sure about more efficient
-    // solutions.
-    std::map<std::pair<unsigned int, unsigned int>, unsigned int> indexmap;
-    for (const auto &cell : triangulation.active_cell_iterators())
-      indexmap[std::pair<unsigned int, unsigned int>(cell->level(),
-                                                     cell->index())] =
-        cell->active_cell_index();
-
-    // next loop over all cells and their neighbors to build the sparsity
+    // loop over all cells and their neighbors to build the sparsity
     // pattern. note that it's a bit hard to enter all the connections when a
     // neighbor has children since we would need to find out which of its
     // children is adjacent to the current cell. this problem can be omitted
     // if we only do something if the neighbor has no children -- in that case
     // it is either on the same or a coarser level than we are. in return, we
-    // have to add entries in both directions for both cells
+    // have to add entries in both directions for both cells. since the
+    // neighbor is active, its row in the sparsity pattern is simply given by
+    // its active cell index, so the graph is built in linear time
     for (const auto &cell : triangulation.active_cell_iterators())
       {
         const unsigned int index = cell->active_cell_index();
@@ -2583,10 +2590,7 @@ namespace GridTools
               (cell->neighbor(f)->has_children() == false))
             {
               const unsigned int other_index =
-                indexmap
-                  .find(std::pair<unsigned int, unsigned int>(
-                    cell->neighbor(f)->level(), cell->neighbor(f)->index()))
-                  ->second;
+                cell->neighbor(f)->active_cell_index();
               cell_connectivity.add(index, other_index);
               cell_connectivity.add(other_index, index);
             }
@@ -4308,6 +4312,64 @@ namespace GridTools
 
 
 
+  namespace internal
+  {
+    namespace
+    {
+      // Return the indices of the given points sorted along a Morton
+      // (z-order) curve through their bounding box, such that points
+      // with consecutive indices are typically close to each other and
+      // hence located in the same cell or in neighboring cells
+      template <int spacedim>
+      std::vector<unsigned int>
+      sort_points_along_morton_curve(
+        const std::vector<Point<spacedim>> &points)
+      {
+        std::vector<unsigned int> indices(points.size());
+        if (points.empty())
+          return indices;
+
+        const auto box =
+          BoundingBox<spacedim>(points).get_boundary_points();
+        const unsigned int n_bits = 63 / spacedim;
+        const double       n_intervals =
+          static_cast<double>((std::uint64_t(1) << n_bits) - 1);
+
+        std::vector<std::pair<std::uint64_t, unsigned int>> keys(
+          points.size());
+        for (unsigned int i = 0; i < points.size(); ++i)
+          {
+            std::array<std::uint64_t, spacedim> coordinates;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                const double extent = box.second[d] - box.first[d];
+                const double scaled =
+                  extent > 0. ? (points[i][d] - box.first[d]) / extent : 0.;
+                coordinates[d] = static_cast<std::uint64_t>(
+                  std::max(0., std::min(1., scaled)) * n_intervals);
+              }
+
+            // interleave the bits of the coordinates, most significant
+            // bits first
+            std::uint64_t key = 0;
+            for (int b = n_bits - 1; b >= 0; --b)
+              for (unsigned int d = 0; d < spacedim; ++d)
+                key = (key << 1) | ((coordinates[d] >> b) & 1U);
+
+            keys[i] = std::make_pair(key, i);
+          }
+
+        std::sort(keys.begin(), keys.end());
+        for (unsigned int i = 0; i < keys.size(); ++i)
+          indices[i] = keys[i].second;
+
+        return indices;
+      }
+    } // namespace
+  }   // namespace internal
+
+
+
   template <int dim, int spacedim>
 #ifndef DOXYGEN
   std::tuple<
@@ -4359,11 +4421,13 @@ namespace GridTools
     const typename Triangulation<dim, spacedim>::active_cell_iterator
       &cell_hint)
   {
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
     // How many points are here?
     const unsigned int np = points.size();
 
-    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
-                                           cells_out;
+    std::vector<active_cell_iterator>      cells_out;
     std::vector<std::vector<Point<dim>>>   qpoints_out;
     std::vector<std::vector<unsigned int>> maps_out;
     std::vector<unsigned int>              missing_points_out;
@@ -4375,280 +4439,146 @@ namespace GridTools
                              std::move(maps_out),
                              std::move(missing_points_out));
 
-    // For the search we shall use the following tree
+    // For the search we shall use the following tree. The cache computes its
+    // data structures on first access, so make sure that all of them that
+    // are used by find_active_cell_around_point() are available before the
+    // points are processed in parallel below
     const auto &b_tree = cache.get_cell_bounding_boxes_rtree();
+    cache.get_vertex_to_cell_map();
+    cache.get_vertex_to_cell_centers_directions();
+    cache.get_used_vertices();
+    cache.get_used_vertices_rtree();
+
+    const Mapping<dim, spacedim> &mapping = cache.get_mapping();
+
+    // Sort the points along a space-filling curve, such that consecutive
+    // points are likely to lie in the same cell, which then only needs to be
+    // identified once and allows to transform several points at once
+    const std::vector<unsigned int> sorted_points =
+      internal::sort_points_along_morton_curve(points);
+
+    // The cell and the reference position of each point, and whether it has
+    // been found (not using std::vector<bool> as it is written concurrently)
+    std::vector<active_cell_iterator> point_cells(np);
+    std::vector<Point<dim>>           point_positions(np);
+    std::vector<unsigned char>        point_found(np, 0);
+
+    // try to locate the points with the global search of
+    // find_active_cell_around_point(), starting from the given cell
+    const auto locate_point_with_search =
+      [&](const unsigned int p, const active_cell_iterator &hint) {
+      try
+        {
+          const auto cell_and_position =
+            GridTools::find_active_cell_around_point(cache, points[p], hint);
+          if (cell_and_position.first->is_artificial() == false)
+            {
+              point_cells[p]     = cell_and_position.first;
+              point_positions[p] = cell_and_position.second;
+              point_found[p]     = 1;
+            }
+        }
+      catch (const GridTools::ExcPointNotFound<spacedim> &)
+        {}
+    };
 
-    // We begin by finding the cell/transform of the first point
-    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
-              Point<dim>>
-      my_pair;
-
-    bool         found          = false;
-    unsigned int points_checked = 0;
-
-    // If a hint cell was given, use it
-    if (cell_hint.state() == IteratorState::valid)
-      {
-        try
-          {
-            my_pair = GridTools::find_active_cell_around_point(cache,
-                                                               points[0],
-                                                               cell_hint);
-            found   = true;
-          }
-        catch (const GridTools::ExcPointNotFound<dim> &)
-          {
-            missing_points_out.emplace_back(0);
-          }
-        ++points_checked;
-      }
-
-    // The tree search returns
-    // - a bounding box covering the cell
-    // - the active cell iterator
-    std::vector<
-      std::pair<BoundingBox<spacedim>,
-                typename Triangulation<dim, spacedim>::active_cell_iterator>>
-      box_cell;
-
-    // This is used as an index for box_cell
-    int cell_candidate_idx = -1;
-    // If any of the cells in box_cell is a ghost cell,
-    // an artificial cell or at the boundary,
-    // we want to use try/catch
-    bool use_try = false;
-
-    while (!found && points_checked < np)
-      {
-        box_cell.clear();
-        b_tree.query(boost::geometry::index::intersects(points[points_checked]),
-                     std::back_inserter(box_cell));
-
-        // Checking box_cell result for a suitable candidate
-        cell_candidate_idx = -1;
-        for (unsigned int i = 0; i < box_cell.size(); ++i)
-          {
-            // As a candidate we don't want artificial cells
-            if (!box_cell[i].second->is_artificial())
-              cell_candidate_idx = i;
-
-            // If the cell is not locally owned or at boundary
-            // we check for exceptions
-            if (cell_candidate_idx != -1 &&
-                (!box_cell[i].second->is_locally_owned() ||
-                 box_cell[i].second->at_boundary()))
-              use_try = true;
-
-
-            if (cell_candidate_idx != -1)
-              break;
-          }
-
-        // If a suitable cell was found, use it as hint
-        if (cell_candidate_idx != -1)
-          {
-            if (use_try)
-              {
-                try
-                  {
-                    my_pair = GridTools::find_active_cell_around_point(
-                      cache,
-                      points[points_checked],
-                      box_cell[cell_candidate_idx].second);
-                    found = true;
-                  }
-                catch (const GridTools::ExcPointNotFound<dim> &)
-                  {
-                    missing_points_out.emplace_back(points_checked);
-                  }
-              }
-            else
-              {
-                my_pair = GridTools::find_active_cell_around_point(
-                  cache,
-                  points[points_checked],
-                  box_cell[cell_candidate_idx].second);
-                found = true;
-              }
-          }
-        else
-          {
-            try
-              {
-                my_pair = GridTools::find_active_cell_around_point(
-                  cache, points[points_checked]);
-                // If we arrive here the cell was not among
-                // the candidates returned by the tree, so we're adding it
-                // by hand
-                found              = true;
-                cell_candidate_idx = box_cell.size();
-                box_cell.push_back(
-                  std::make_pair(my_pair.first->bounding_box(), my_pair.first));
-              }
-            catch (const GridTools::ExcPointNotFound<dim> &)
-              {
-                missing_points_out.emplace_back(points_checked);
-              }
-          }
-
-        // Updating the position of the analyzed points
-        ++points_checked;
-      }
-
-    // If the point has been found in a cell, adding it
-    if (found)
-      {
-        cells_out.emplace_back(my_pair.first);
-        qpoints_out.emplace_back(1, my_pair.second);
-        maps_out.emplace_back(1, points_checked - 1);
-      }
+    const auto locate_points = [&](const unsigned int begin,
+                                   const unsigned int end) {
+      active_cell_iterator  candidate = cell_hint;
+      BoundingBox<spacedim> candidate_box;
+      if (candidate.state() == IteratorState::valid)
+        candidate_box = candidate->bounding_box();
+
+      std::vector<std::pair<BoundingBox<spacedim>, active_cell_iterator>>
+                                   box_cell;
+      std::vector<unsigned int>    batch_indices;
+      std::vector<Point<spacedim>> batch_real_points;
+      std::vector<Point<dim>>      batch_unit_points;
+
+      // transform all points collected for the current candidate cell at
+      // once and check whether they are inside; the remaining ones are
+      // searched for in the neighborhood of the candidate cell
+      const auto process_batch = [&]() {
+        if (batch_indices.empty())
+          return;
+        batch_unit_points.resize(batch_indices.size());
+        mapping.transform_points_real_to_unit_cell(
+          candidate,
+          make_array_view(batch_real_points),
+          make_array_view(batch_unit_points));
+        for (unsigned int k = 0; k < batch_indices.size(); ++k)
+          if (GeometryInfo<dim>::is_inside_unit_cell(batch_unit_points[k]))
+            {
+              point_cells[batch_indices[k]]     = candidate;
+              point_positions[batch_indices[k]] = batch_unit_points[k];
+              point_found[batch_indices[k]]     = 1;
+            }
+          else
+            locate_point_with_search(batch_indices[k], candidate);
+        batch_indices.clear();
+        batch_real_points.clear();
+      };
 
-    // Now the second easy case.
-    if (np == qpoints_out.size())
-      return std::make_tuple(std::move(cells_out),
-                             std::move(qpoints_out),
-                             std::move(maps_out),
-                             std::move(missing_points_out));
+      for (unsigned int i = begin; i < end; ++i)
+        {
+          const unsigned int p = sorted_points[i];
 
-    // Cycle over all points left
-    for (unsigned int p = points_checked; p < np; ++p)
-      {
-        // We assume the last used cell contains the point: checking it
-        if (cell_candidate_idx != -1)
-          if (!box_cell[cell_candidate_idx].first.point_inside(points[p]))
-            // Point ouside candidate cell: we have no candidate
-            cell_candidate_idx = -1;
-
-        // If there's no candidate, run a tree search
-        if (cell_candidate_idx == -1)
-          {
-            // Using the b_tree to find new candidates
-            box_cell.clear();
-            b_tree.query(boost::geometry::index::intersects(points[p]),
-                         std::back_inserter(box_cell));
-            // Checking the returned bounding boxes/cells
-            use_try            = false;
-            cell_candidate_idx = -1;
-            for (unsigned int i = 0; i < box_cell.size(); ++i)
-              {
-                // As a candidate we don't want artificial cells
-                if (!box_cell[i].second->is_artificial())
-                  cell_candidate_idx = i;
-
-                // If the cell is not locally owned or at boundary
-                // we check for exceptions
-                if (cell_candidate_idx != -1 &&
-                    (!box_cell[i].second->is_locally_owned() ||
-                     box_cell[i].second->at_boundary()))
-                  use_try = true;
-
-                // If a cell candidate was found we can stop
-                if (cell_candidate_idx != -1)
-                  break;
-              }
-          }
+          // We assume the last used cell contains the point. If it is
+          // outside its bounding box, look for a new candidate in the tree
+          if (candidate.state() != IteratorState::valid ||
+              candidate_box.point_inside(points[p]) == false)
+            {
+              process_batch();
 
-        if (cell_candidate_idx == -1)
-          {
-            // No candidate cell, but the cell might
-            // still be inside the mesh, this is our final check:
-            try
-              {
-                my_pair =
-                  GridTools::find_active_cell_around_point(cache, points[p]);
-                // If we arrive here the cell was not among
-                // the candidates returned by the tree, so we're adding it
-                // by hand
-                cell_candidate_idx = box_cell.size();
-                box_cell.push_back(
-                  std::make_pair(my_pair.first->bounding_box(), my_pair.first));
-              }
-            catch (const GridTools::ExcPointNotFound<dim> &)
-              {
-                missing_points_out.emplace_back(p);
-                continue;
-              }
-          }
-        else
-          {
-            // We have a candidate cell
-            if (use_try)
-              {
-                try
-                  {
-                    my_pair = GridTools::find_active_cell_around_point(
-                      cache, points[p], box_cell[cell_candidate_idx].second);
-                  }
-                catch (const GridTools::ExcPointNotFound<dim> &)
-                  {
-                    missing_points_out.push_back(p);
-                    continue;
-                  }
-              }
-            else
-              {
-                my_pair = GridTools::find_active_cell_around_point(
-                  cache, points[p], box_cell[cell_candidate_idx].second);
-              }
+              box_cell.clear();
+              b_tree.query(boost::geometry::index::intersects(points[p]),
+                           std::back_inserter(box_cell));
 
-            // If the point was found in another cell,
-            // updating cell_candidate_idx
-            if (my_pair.first != box_cell[cell_candidate_idx].second)
-              {
-                for (unsigned int i = 0; i < box_cell.size(); ++i)
+              // As a candidate we don't want artificial cells
+              candidate = active_cell_iterator();
+              for (const auto &box_and_cell : box_cell)
+                if (box_and_cell.second->is_artificial() == false)
                   {
-                    if (my_pair.first == box_cell[i].second)
-                      {
-                        cell_candidate_idx = i;
-                        break;
-                      }
+                    candidate_box = box_and_cell.first;
+                    candidate     = box_and_cell.second;
+                    break;
                   }
 
-                if (my_pair.first != box_cell[cell_candidate_idx].second)
-                  {
-                    // The cell was not among the candidates returned by the
-                    // tree
-                    cell_candidate_idx = box_cell.size();
-                    box_cell.push_back(
-                      std::make_pair(my_pair.first->bounding_box(),
-                                     my_pair.first));
-                  }
-              }
-          }
+              // No candidate cell, but the point might still be inside the
+              // mesh, e.g. in a curved cell: this is our final check
+              if (candidate.state() != IteratorState::valid)
+                {
+                  locate_point_with_search(p, active_cell_iterator());
+                  continue;
+                }
+            }
 
+          batch_indices.push_back(p);
+          batch_real_points.push_back(points[p]);
+        }
+      process_batch();
+    };
 
-        // Assuming the point is more likely to be in the last
-        // used cell
-        if (my_pair.first == cells_out.back())
-          {
-            // Found in the last cell: adding the data
-            qpoints_out.back().emplace_back(my_pair.second);
-            maps_out.back().emplace_back(p);
-          }
-        else
-          {
-            // Check if it is in another cell already found
-            typename std::vector<typename Triangulation<dim, spacedim>::
-                                   active_cell_iterator>::iterator cells_it =
-              std::find(cells_out.begin(), cells_out.end() - 1, my_pair.first);
+    parallel::apply_to_subranges(0U, np, locate_points, 256);
 
-            if (cells_it == cells_out.end() - 1)
-              {
-                // Cell not found: adding a new cell
-                cells_out.emplace_back(my_pair.first);
-                qpoints_out.emplace_back(1, my_pair.second);
-                maps_out.emplace_back(1, p);
-              }
-            else
-              {
-                // Cell found: just adding the point index and qpoint to the
-                // list
-                unsigned int current_cell = cells_it - cells_out.begin();
-                qpoints_out[current_cell].emplace_back(my_pair.second);
-                maps_out[current_cell].emplace_back(p);
-              }
-          }
-      }
+    // Collect the points by cell. The cells are ordered by the first point
+    // they contain and the points of each cell by their index
+    std::map<active_cell_iterator, unsigned int> cell_index;
+    for (unsigned int p = 0; p < np; ++p)
+      if (point_found[p])
+        {
+          const auto it = cell_index.emplace(point_cells[p], cells_out.size());
+          if (it.second)
+            {
+              cells_out.push_back(point_cells[p]);
+              qpoints_out.emplace_back();
+              maps_out.emplace_back();
+            }
+          qpoints_out[it.first->second].push_back(point_positions[p]);
+          maps_out[it.first->second].push_back(p);
+        }
+      else
+        missing_points_out.push_back(p);
 
     // Debug Checking
     Assert(cells_out.size() == maps_out.size(),
@@ -4716,8 +4646,6 @@ namespace GridTools
         const GridTools::Cache<dim, spacedim> &cache,
         const std::vector<Point<spacedim>> &   points)
       {
-        // How many points are here?
-        const unsigned int np = points.size();
         // Creating the output tuple
         std::unordered_map<
           typename Triangulation<dim, spacedim>::active_cell_iterator,
@@ -4725,82 +4653,19 @@ namespace GridTools
           cell_hash<dim, spacedim>>
           cell_qpoint_map;
 
-        // Now the easy case.
-        if (np == 0)
-          return cell_qpoint_map;
-        // We begin by finding the cell/transform of the first point
-        auto my_pair =
-          GridTools::find_active_cell_around_point(cache, points[0]);
-
-        auto last_cell = cell_qpoint_map.emplace(
-          std::make_pair(my_pair.first,
-                         std::make_pair(std::vector<Point<dim>>{my_pair.second},
-                                        std::vector<unsigned int>{0})));
-        // Now the second easy case.
-        if (np == 1)
-          return cell_qpoint_map;
-        // Computing the cell center and diameter
-        Point<spacedim> cell_center   = my_pair.first->center();
-        double          cell_diameter = my_pair.first->diameter() *
-                               (0.5 + std::numeric_limits<double>::epsilon());
-
-        // Cycle over all points left
-        for (unsigned int p = 1; p < np; ++p)
-          {
-            // Checking if the point is close to the cell center, in which
-            // case calling find active cell with a cell hint
-            if (cell_center.distance(points[p]) < cell_diameter)
-              my_pair = GridTools::find_active_cell_around_point(
-                cache, points[p], last_cell.first->first);
-            else
-              my_pair =
-                GridTools::find_active_cell_around_point(cache, points[p]);
-
-            if (last_cell.first->first == my_pair.first)
-              {
-                last_cell.first->second.first.emplace_back(my_pair.second);
-                last_cell.first->second.second.emplace_back(p);
-              }
-            else
-              {
-                // Check if it is in another cell already found
-                last_cell = cell_qpoint_map.emplace(std::make_pair(
-                  my_pair.first,
-                  std::make_pair(std::vector<Point<dim>>{my_pair.second},
-                                 std::vector<unsigned int>{p})));
-
-                if (last_cell.second == false)
-                  {
-                    // Cell already present: adding the new point
-                    last_cell.first->second.first.emplace_back(my_pair.second);
-                    last_cell.first->second.second.emplace_back(p);
-                  }
-                else
-                  {
-                    // New cell was added, updating center and diameter
-                    cell_center = my_pair.first->center();
-                    cell_diameter =
-                      my_pair.first->diameter() *
-                      (0.5 + std::numeric_limits<double>::epsilon());
-                  }
-              }
-          }
+        // Use the batched search of compute_point_locations_try_all(),
+        // which skips points that are not inside the mesh. The callers
+        // discard artificial cells anyway
+        auto cell_qpoint_maps =
+          GridTools::compute_point_locations_try_all(cache, points);
+        auto &cells   = std::get<0>(cell_qpoint_maps);
+        auto &qpoints = std::get<1>(cell_qpoint_maps);
+        auto &maps    = std::get<2>(cell_qpoint_maps);
+        for (unsigned int c = 0; c < cells.size(); ++c)
+          cell_qpoint_map.emplace(cells[c],
+                                  std::make_pair(std::move(qpoints[c]),
+                                                 std::move(maps[c])));
 
-#ifdef DEBUG
-        unsigned int qps = 0;
-        // The number of points in all
-        // the cells must be the same as
-        // the number of points we
-        // started off from.
-        for (const auto &m : cell_qpoint_map)
-          {
-            Assert(m.second.second.size() == m.second.first.size(),
-                   ExcDimensionMismatch(m.second.second.size(),
-                                        m.second.first.size()));
-            qps += m.second.second.size();
-          }
-        Assert(qps == np, ExcDimensionMismatch(qps, np));
-#endif
         return cell_qpoint_map;
       }
 
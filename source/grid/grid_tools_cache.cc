@@ -15,6 +15,9 @@
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/distributed/tria_base.h>
 
 #include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/grid/grid_tools.h>
@@ -30,20 +33,165 @@ namespace GridTools
   Cache<dim, spacedim>::Cache(const Triangulation<dim, spacedim> &tria,
                               const Mapping<dim, spacedim> &      mapping)
     : update_flags(update_all)
+    , in_refinement(false)
+    , update_rtree_incrementally(false)
+    , update_cell_id_map_incrementally(false)
     , tria(&tria)
     , mapping(&mapping)
   {
-    tria_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    tria_signals.push_back(tria.signals.any_change.connect([&]() {
+      if (in_refinement == false)
+        mark_for_update(update_all);
+    }));
+    tria_signals.push_back(
+      tria.signals.pre_refinement.connect([&]() { pre_refinement(); }));
+    tria_signals.push_back(tria.signals.pre_coarsening_on_cell.connect(
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        record_adapted_cell(cell, true);
+      }));
+    tria_signals.push_back(tria.signals.post_refinement_on_cell.connect(
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        record_adapted_cell(cell, false);
+      }));
+    tria_signals.push_back(
+      tria.signals.post_refinement.connect([&]() { post_refinement(); }));
   }
 
   template <int dim, int spacedim>
   Cache<dim, spacedim>::~Cache()
   {
-    // Make sure that the signals that was attached to the triangulation
-    // is removed here.
-    if (tria_signal.connected())
-      tria_signal.disconnect();
+    // Make sure that the signals that were attached to the triangulation
+    // are removed here.
+    for (auto &signal : tria_signals)
+      if (signal.connected())
+        signal.disconnect();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::pre_refinement()
+  {
+    in_refinement = true;
+    adapted_cells.clear();
+
+    // in parallel triangulations, the ghost and artificial cells change as
+    // well, so only update the data of serial triangulations incrementally
+    const bool is_serial =
+      dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+        &*tria) == nullptr;
+    update_rtree_incrementally =
+      (update_flags & update_cell_bounding_boxes_rtree) == 0 && is_serial;
+    update_cell_id_map_incrementally =
+      (update_flags & update_cell_id_to_cell_map) == 0 && is_serial;
+
+    if (update_rtree_incrementally)
+      for (const auto &cell : tria->active_cell_iterators())
+        if (cell->refine_flag_set())
+          remove_cell_bounding_box(cell);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::record_adapted_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const bool will_be_coarsened)
+  {
+    if (update_rtree_incrementally == false &&
+        update_cell_id_map_incrementally == false)
+      return;
+
+    // remove the cells that are no longer active while their ids can still
+    // be computed
+    if (update_cell_id_map_incrementally)
+      {
+        if (will_be_coarsened)
+          for (unsigned int c = 0; c < cell->n_children(); ++c)
+            cell_id_to_cell.erase(
+              cell->child(c)->id().template to_binary<dim>());
+        else
+          cell_id_to_cell.erase(cell->id().template to_binary<dim>());
+      }
+
+    if (will_be_coarsened)
+      for (unsigned int c = 0; c < cell->n_children(); ++c)
+        remove_cell_bounding_box(cell->child(c));
+
+    adapted_cells.push_back(cell);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::remove_cell_bounding_box(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+  {
+    if (update_rtree_incrementally == false)
+      return;
+
+    // the bounding box is computed in the same way as for the construction
+    // of the tree, so the entry is found with exact comparison
+    if (cell_bounding_boxes_rtree.remove(
+          std::make_pair(mapping->get_bounding_box(cell), cell)) == 0)
+      {
+        update_rtree_incrementally = false;
+        update_flags = update_flags | update_cell_bounding_boxes_rtree;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::post_refinement()
+  {
+    in_refinement = false;
+
+    // the children of the refined cells and the coarsened cells are the
+    // active cells that did not exist before
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      new_cells;
+    for (const auto &cell : adapted_cells)
+      if (cell->has_children())
+        for (unsigned int c = 0; c < cell->n_children(); ++c)
+          new_cells.push_back(cell->child(c));
+      else
+        new_cells.push_back(cell);
+
+    CacheUpdateFlags flags = update_all;
+    if (update_rtree_incrementally)
+      {
+        std::vector<std::pair<
+          BoundingBox<spacedim>,
+          typename Triangulation<dim, spacedim>::active_cell_iterator>>
+          boxes(new_cells.size());
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(new_cells.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              boxes[i] = std::make_pair(mapping->get_bounding_box(new_cells[i]),
+                                        new_cells[i]);
+          },
+          64);
+        cell_bounding_boxes_rtree.insert(boxes.begin(), boxes.end());
+        flags = flags & ~update_cell_bounding_boxes_rtree;
+      }
+    if (update_cell_id_map_incrementally)
+      {
+        for (const auto &cell : new_cells)
+          cell_id_to_cell[cell->id().template to_binary<dim>()] = cell;
+        flags = flags & ~update_cell_id_to_cell_map;
+      }
+    mark_for_update(flags);
+
+    adapted_cells.clear();
+    update_rtree_incrementally       = false;
+    update_cell_id_map_incrementally = false;
   }
 
 
@@ -129,13 +277,27 @@ namespace GridTools
   {
     if (update_flags & update_cell_bounding_boxes_rtree)
       {
+        // collect the cells first and then compute their bounding boxes,
+        // which involves the mapping, in parallel
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          cells;
+        cells.reserve(tria->n_active_cells());
+        for (const auto &cell : tria->active_cell_iterators())
+          cells.push_back(cell);
+
         std::vector<std::pair<
           BoundingBox<spacedim>,
           typename Triangulation<dim, spacedim>::active_cell_iterator>>
-                     boxes(tria->n_active_cells());
-        unsigned int i = 0;
-        for (const auto &cell : tria->active_cell_iterators())
-          boxes[i++] = std::make_pair(mapping->get_bounding_box(cell), cell);
+          boxes(cells.size());
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(cells.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              boxes[i] =
+                std::make_pair(mapping->get_bounding_box(cells[i]), cells[i]);
+          },
+          64);
 
         cell_bounding_boxes_rtree = pack_rtree(boxes);
         update_flags = update_flags & ~update_cell_bounding_boxes_rtree;
@@ -144,6 +306,83 @@ namespace GridTools
   }
 
 
+
+  template <int dim, int spacedim>
+  const std::unordered_map<
+    CellId::binary_type,
+    typename Triangulation<dim, spacedim>::active_cell_iterator,
+    typename Cache<dim, spacedim>::CellIdHash> &
+  Cache<dim, spacedim>::get_cell_id_to_cell_map() const
+  {
+    if (update_flags & update_cell_id_to_cell_map)
+      {
+        cell_id_to_cell.clear();
+        cell_id_to_cell.reserve(tria->n_active_cells());
+        for (const auto &cell : tria->active_cell_iterators())
+          cell_id_to_cell.emplace(cell->id().template to_binary<dim>(), cell);
+        update_flags = update_flags & ~update_cell_id_to_cell_map;
+      }
+    return cell_id_to_cell;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+  Cache<dim, spacedim>::get_active_cells(
+    const std::vector<CellId> &cell_ids) const
+  {
+    const auto &map = get_cell_id_to_cell_map();
+
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      cells(cell_ids.size(),
+            typename Triangulation<dim, spacedim>::active_cell_iterator(
+              tria->end()));
+    for (unsigned int i = 0; i < cell_ids.size(); ++i)
+      {
+        const auto it = map.find(cell_ids[i].template to_binary<dim>());
+        if (it != map.end())
+          cells[i] = it->second;
+      }
+    return cells;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<
+    typename Triangulation<dim, spacedim>::active_cell_iterator> &
+  Cache<dim, spacedim>::get_active_cell_iterators() const
+  {
+    if (update_flags & update_active_cell_iterators)
+      {
+        active_cells.clear();
+        active_cells.reserve(tria->n_active_cells());
+        locally_owned_active_cells.clear();
+        for (const auto &cell : tria->active_cell_iterators())
+          {
+            active_cells.push_back(cell);
+            if (cell->is_locally_owned())
+              locally_owned_active_cells.push_back(cell);
+          }
+        update_flags = update_flags & ~update_active_cell_iterators;
+      }
+    return active_cells;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<
+    typename Triangulation<dim, spacedim>::active_cell_iterator> &
+  Cache<dim, spacedim>::get_locally_owned_active_cell_iterators() const
+  {
+    // both arrays are filled at the same time
+    get_active_cell_iterators();
+    return locally_owned_active_cells;
+  }
+
+
 #ifdef DEAL_II_WITH_NANOFLANN
   template <int dim, int spacedim>
   const KDTree<spacedim> &
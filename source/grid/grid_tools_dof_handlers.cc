@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
 
@@ -2059,7 +2060,6 @@ namespace GridTools
     const FullMatrix<double> &matrix)
   {
     static const int space_dim = CellIterator::AccessorType::space_dimension;
-    (void)space_dim;
     Assert(0 <= direction && direction < space_dim,
            ExcIndexRange(direction, 0, space_dim));
 
@@ -2068,37 +2068,140 @@ namespace GridTools
 
     unsigned int n_matches = 0;
 
-    // Match with a complexity of O(n^2). This could be improved...
-    std::bitset<3> orientation;
     using PairIterator =
       typename std::set<std::pair<CellIterator, unsigned int>>::const_iterator;
-    for (PairIterator it1 = pairs1.begin(); it1 != pairs1.end(); ++it1)
-      {
-        for (PairIterator it2 = pairs2.begin(); it2 != pairs2.end(); ++it2)
-          {
-            const CellIterator cell1     = it1->first;
-            const CellIterator cell2     = it2->first;
-            const unsigned int face_idx1 = it1->second;
-            const unsigned int face_idx2 = it2->second;
-            if (GridTools::orthogonal_equality(orientation,
-                                               cell1->face(face_idx1),
-                                               cell2->face(face_idx2),
-                                               direction,
-                                               offset,
-                                               matrix))
+    const std::vector<PairIterator> faces1 = [&]() {
+      std::vector<PairIterator> faces;
+      for (PairIterator it = pairs1.begin(); it != pairs1.end(); ++it)
+        faces.push_back(it);
+      return faces;
+    }();
+    const std::vector<PairIterator> faces2 = [&]() {
+      std::vector<PairIterator> faces;
+      for (PairIterator it = pairs2.begin(); it != pairs2.end(); ++it)
+        faces.push_back(it);
+      return faces;
+    }();
+
+    // Rather than comparing all faces of the two sets with each other, sort
+    // the faces of the second set into bins of a grid over their centers
+    // projected onto the plane orthogonal to the given direction. If two
+    // faces match, their vertices agree up to the tolerance of
+    // orthogonal_equality() in all other coordinates, and so do their
+    // centers. As the bins are much larger than this tolerance, the faces
+    // matching a face of the first set are in the bin of its transformed
+    // center or in one of the neighboring bins.
+    const double bin_size = 1e-8;
+    using BinIndex        = std::array<long long int, space_dim>;
+
+    const auto get_bin = [&](const Point<space_dim> &point) {
+      BinIndex bin;
+      for (int d = 0; d < space_dim; ++d)
+        bin[d] = (d == direction) ?
+                   0 :
+                   static_cast<long long int>(std::floor(point[d] / bin_size));
+      return bin;
+    };
+
+    std::map<BinIndex, std::vector<unsigned int>> bins;
+    for (unsigned int j = 0; j < faces2.size(); ++j)
+      bins[get_bin(faces2[j]->first->face(faces2[j]->second)->center())]
+        .push_back(j);
+
+    // Return the index of the first face of the second set that matches
+    // the face with index i of the first set and is not marked in
+    // face2_used, together with the orientation of the match
+    const auto find_match = [&](const unsigned int       i,
+                                const std::vector<bool> &face2_used,
+                                std::bitset<3> &         orientation) {
+      const auto face1 = faces1[i]->first->face(faces1[i]->second);
+
+      const Point<space_dim> center = face1->center();
+      Point<space_dim>       transformed_center;
+      if (matrix.m() == space_dim)
+        for (int d = 0; d < space_dim; ++d)
+          for (int e = 0; e < space_dim; ++e)
+            transformed_center[d] += matrix(d, e) * center[e];
+      else
+        transformed_center = center;
+      transformed_center += offset;
+      const BinIndex center_bin = get_bin(transformed_center);
+
+      unsigned int match       = numbers::invalid_unsigned_int;
+      unsigned int n_neighbors = 1;
+      for (int d = 0; d < space_dim - 1; ++d)
+        n_neighbors *= 3;
+      for (unsigned int neighbor = 0; neighbor < n_neighbors; ++neighbor)
+        {
+          BinIndex     bin       = center_bin;
+          unsigned int remainder = neighbor;
+          for (int d = 0; d < space_dim; ++d)
+            if (d != direction)
               {
-                // We have a match, so insert the matching pairs and
-                // remove the matched cell in pairs2 to speed up the
-                // matching:
-                const PeriodicFacePair<CellIterator> matched_face = {
-                  {cell1, cell2}, {face_idx1, face_idx2}, orientation, matrix};
-                matched_pairs.push_back(matched_face);
-                pairs2.erase(it2);
-                ++n_matches;
-                break;
+                bin[d] += static_cast<int>(remainder % 3) - 1;
+                remainder /= 3;
               }
-          }
+
+          const auto candidates = bins.find(bin);
+          if (candidates == bins.end())
+            continue;
+          for (const unsigned int j : candidates->second)
+            {
+              std::bitset<3> candidate_orientation;
+              if (j < match && (face2_used.empty() || !face2_used[j]) &&
+                  GridTools::orthogonal_equality(candidate_orientation,
+                                                 face1,
+                                                 faces2[j]->first->face(
+                                                   faces2[j]->second),
+                                                 direction,
+                                                 offset,
+                                                 matrix))
+                {
+                  match       = j;
+                  orientation = candidate_orientation;
+                }
+            }
+        }
+      return match;
+    };
+
+    // find the matches of all faces in parallel
+    std::vector<unsigned int>   matches(faces1.size());
+    std::vector<std::bitset<3>> orientations(faces1.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(faces1.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          matches[i] = find_match(i, std::vector<bool>(), orientations[i]);
+      },
+      256);
+
+    // We have the matches, so insert the matching pairs in the order of the
+    // first set and remove the matched faces from pairs2. In case a face of
+    // the second set was matched more than once, we search again among
+    // the remaining ones.
+    std::vector<bool> face2_used(faces2.size(), false);
+    for (unsigned int i = 0; i < faces1.size(); ++i)
+      {
+        if (matches[i] != numbers::invalid_unsigned_int &&
+            face2_used[matches[i]])
+          matches[i] = find_match(i, face2_used, orientations[i]);
+        if (matches[i] == numbers::invalid_unsigned_int)
+          continue;
+
+        face2_used[matches[i]] = true;
+        const PeriodicFacePair<CellIterator> matched_face = {
+          {faces1[i]->first, faces2[matches[i]]->first},
+          {faces1[i]->second, faces2[matches[i]]->second},
+          orientations[i],
+          matrix};
+        matched_pairs.push_back(matched_face);
+        ++n_matches;
       }
+    for (unsigned int j = 0; j < faces2.size(); ++j)
+      if (face2_used[j])
+        pairs2.erase(faces2[j]);
 
     // Assure that all faces are matched
     AssertThrow(n_matches == pairs1.size() && pairs2.size() == 0,
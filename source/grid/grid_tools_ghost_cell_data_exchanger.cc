@@ -0,0 +1,165 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/cell_id.h>
+#include <deal.II/grid/grid_tools_ghost_cell_data_exchanger.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace GridTools
+{
+  template <int dim, int spacedim>
+  GhostCellDataExchanger<dim, spacedim>::GhostCellDataExchanger(
+    const Triangulation<dim, spacedim> &triangulation)
+  {
+    reinit(triangulation);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  GhostCellDataExchanger<dim, spacedim>::reinit(
+    const Triangulation<dim, spacedim> &triangulation)
+  {
+    n_active_cells = triangulation.n_active_cells();
+    communicator   = MPI_COMM_SELF;
+    send_ranks.clear();
+    send_cells.clear();
+    receive_ranks.clear();
+    receive_cells.clear();
+
+#ifdef DEAL_II_WITH_MPI
+    const auto tria =
+      dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+        &triangulation);
+    if (tria == nullptr)
+      return;
+    communicator = tria->get_communicator();
+
+    // data is exchanged with all processes that own ghost cells, as the
+    // ghost layer is symmetric
+    const std::set<types::subdomain_id> ghost_owners = tria->ghost_owners();
+    send_ranks.assign(ghost_owners.begin(), ghost_owners.end());
+    receive_ranks = send_ranks;
+    send_cells.resize(send_ranks.size());
+    receive_cells.resize(receive_ranks.size());
+
+    // find the processes on which the locally owned cells are ghost cells,
+    // the same way as in GridTools::exchange_cell_data_to_ghosts()
+    const std::map<unsigned int, std::set<types::subdomain_id>>
+      vertices_with_ghost_neighbors =
+        tria->compute_vertices_with_ghost_neighbors();
+
+    std::vector<std::vector<CellId::binary_type>> send_cell_ids(
+      send_ranks.size());
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          std::set<types::subdomain_id> send_to;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            {
+              const auto neighbor_subdomains_of_vertex =
+                vertices_with_ghost_neighbors.find(cell->vertex_index(v));
+              if (neighbor_subdomains_of_vertex !=
+                  vertices_with_ghost_neighbors.end())
+                send_to.insert(neighbor_subdomains_of_vertex->second.begin(),
+                               neighbor_subdomains_of_vertex->second.end());
+            }
+
+          for (const types::subdomain_id rank : send_to)
+            {
+              const unsigned int p =
+                std::lower_bound(send_ranks.begin(), send_ranks.end(), rank) -
+                send_ranks.begin();
+              Assert(p < send_ranks.size() && send_ranks[p] == rank,
+                     ExcInternalError());
+              send_cells[p].push_back(cell->active_cell_index());
+              send_cell_ids[p].push_back(cell->id().template to_binary<dim>());
+            }
+        }
+
+    // send the ids of the cells once, in the order in which their data is
+    // sent in exchange(), and translate the received ids to active cell
+    // indices
+    std::vector<MPI_Request> requests(send_ranks.size());
+    for (unsigned int p = 0; p < send_ranks.size(); ++p)
+      {
+        const int ierr =
+          MPI_Isend(send_cell_ids[p].data(),
+                    send_cell_ids[p].size() * sizeof(CellId::binary_type),
+                    MPI_BYTE,
+                    send_ranks[p],
+                    787,
+                    communicator,
+                    &requests[p]);
+        AssertThrowMPI(ierr);
+      }
+
+    std::vector<CellId::binary_type> received_cell_ids;
+    for (unsigned int p = 0; p < receive_ranks.size(); ++p)
+      {
+        MPI_Status status;
+        int        ierr =
+          MPI_Probe(receive_ranks[p], 787, communicator, &status);
+        AssertThrowMPI(ierr);
+        int n_bytes = 0;
+        ierr        = MPI_Get_count(&status, MPI_BYTE, &n_bytes);
+        AssertThrowMPI(ierr);
+        AssertDimension(n_bytes % sizeof(CellId::binary_type), 0);
+
+        received_cell_ids.resize(n_bytes / sizeof(CellId::binary_type));
+        ierr = MPI_Recv(received_cell_ids.data(),
+                        n_bytes,
+                        MPI_BYTE,
+                        receive_ranks[p],
+                        787,
+                        communicator,
+                        MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+
+        receive_cells[p].reserve(received_cell_ids.size());
+        for (const CellId::binary_type &id : received_cell_ids)
+          {
+            const typename Triangulation<dim, spacedim>::cell_iterator cell =
+              CellId(id).to_cell(*tria);
+            Assert(cell->active() && cell->is_ghost(), ExcInternalError());
+            receive_cells[p].push_back(cell->active_cell_index());
+          }
+      }
+
+    if (requests.size() > 0)
+      {
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+#endif
+  }
+} // namespace GridTools
+
+
+#include "grid_tools_ghost_cell_data_exchanger.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -1568,6 +1568,8 @@ TransfiniteInterpolationManifold<dim,
 {
   if (clear_signal.connected())
     clear_signal.disconnect();
+  if (change_signal.connected())
+    change_signal.disconnect();
 }
 
 
@@ -1590,11 +1592,20 @@ TransfiniteInterpolationManifold<dim, spacedim>::initialize(
   const Triangulation<dim, spacedim> &triangulation)
 {
   this->triangulation = &triangulation;
+  chart_point_cache.clear();
   // in case the triangulatoin is cleared, remove the pointers by a signal
   clear_signal = triangulation.signals.clear.connect([&]() -> void {
     this->triangulation = nullptr;
     this->level_coarse  = -1;
+    chart_point_cache.clear();
   });
+  // the cached chart points are only valid until the next refinement cycle
+  // or movement of the mesh. the signals are sent when no other thread
+  // computes new points, so the caches of all threads can be cleared
+  if (change_signal.connected())
+    change_signal.disconnect();
+  change_signal = triangulation.signals.any_change.connect(
+    [&]() -> void { chart_point_cache.clear(); });
   level_coarse = triangulation.last()->level();
   coarse_cell_is_flat.resize(triangulation.n_cells(level_coarse), false);
   typename Triangulation<dim, spacedim>::active_cell_iterator
@@ -2231,6 +2242,43 @@ TransfiniteInterpolationManifold<dim, spacedim>::compute_chart_points(
          ExcMessage("The chart points array view must be as large as the "
                     "surrounding points array view."));
 
+  // Check whether all surrounding points have been pulled back to a common
+  // coarse cell before, typically when computing other new points around the
+  // same vertices. In that case, we can skip the search for the cell and
+  // the Newton iterations.
+  if (surrounding_points.size() > 0)
+    {
+      const ChartPointCache &cache = chart_point_cache.get();
+
+      const auto first_entry = cache.find(surrounding_points[0]);
+      if (first_entry != cache.end())
+        for (const auto &candidate : first_entry->second)
+          {
+            bool all_points_found = true;
+            for (unsigned int i = 0; i < surrounding_points.size(); ++i)
+              {
+                const auto entry = (i == 0) ?
+                                     first_entry :
+                                     cache.find(surrounding_points[i]);
+                all_points_found = false;
+                if (entry != cache.end())
+                  for (const auto &cell_and_point : entry->second)
+                    if (cell_and_point.first == candidate.first)
+                      {
+                        chart_points[i]  = cell_and_point.second;
+                        all_points_found = true;
+                        break;
+                      }
+                if (all_points_found == false)
+                  break;
+              }
+
+            if (all_points_found)
+              return typename Triangulation<dim, spacedim>::cell_iterator(
+                triangulation, level_coarse, candidate.first);
+          }
+    }
+
   std::array<unsigned int, 20> nearby_cells =
     get_possible_cells_around_points(surrounding_points);
 
@@ -2438,6 +2486,27 @@ TransfiniteInterpolationManifold<dim, spacedim>::compute_chart_points(
         }
       if (inside_unit_cell == true)
         {
+          // store the chart points for later calls, starting over if the
+          // cache of this thread has become too large
+          ChartPointCache &cache = chart_point_cache.get();
+          if (cache.size() + surrounding_points.size() >
+              max_chart_point_cache_size)
+            cache.clear();
+          for (unsigned int i = 0; i < surrounding_points.size(); ++i)
+            {
+              auto &entries = cache[surrounding_points[i]];
+              bool  found   = false;
+              for (const auto &cell_and_point : entries)
+                if (cell_and_point.first ==
+                    static_cast<unsigned int>(cell->index()))
+                  {
+                    found = true;
+                    break;
+                  }
+              if (found == false)
+                entries.emplace_back(cell->index(), chart_points[i]);
+            }
+
           return cell;
         }
 
@@ -16,6 +16,8 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/memory_report.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/fe/mapping_q1.h>
@@ -4666,6 +4668,43 @@ namespace internal
 
 
 
+      /**
+       * Compute the new vertices at the centers of all active lines whose
+       * user flag is set, i.e., that are going to be refined, in the order
+       * in which an iteration over the active lines visits them. Evaluating
+       * the manifold description of the lines is the most expensive part of
+       * refining the lines, and the new points of different lines are
+       * independent of each other, so they are computed in parallel.
+       */
+      template <int dim, int spacedim>
+      static std::vector<Point<spacedim>>
+      compute_centers_of_flagged_lines(
+        const Triangulation<dim, spacedim> &triangulation)
+      {
+        std::vector<typename Triangulation<dim, spacedim>::active_line_iterator>
+          flagged_lines;
+        for (typename Triangulation<dim, spacedim>::active_line_iterator line =
+               triangulation.begin_active_line();
+             line != triangulation.end_line();
+             ++line)
+          if (line->user_flag_set())
+            flagged_lines.push_back(line);
+
+        std::vector<Point<spacedim>> centers(flagged_lines.size());
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(flagged_lines.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              centers[i] = flagged_lines[i]->center(true);
+          },
+          64);
+
+        return centers;
+      }
+
+
+
       /**
        * A function that performs the
        * refinement of a triangulation in 1d.
@@ -5087,6 +5126,12 @@ namespace internal
         // first the refinement of lines.  children are stored
         // pairwise
         {
+          // the new vertices of all lines are computed up front, the lines
+          // below visit them in the same order
+          const std::vector<Point<spacedim>> line_centers =
+            compute_centers_of_flagged_lines(triangulation);
+          unsigned int n_refined_lines = 0;
+
           // only active objects can be refined further
           typename Triangulation<dim, spacedim>::active_line_iterator
             line = triangulation.begin_active_line(),
@@ -5109,7 +5154,9 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                AssertIndexRange(n_refined_lines, line_centers.size());
+                triangulation.vertices[next_unused_vertex] =
+                  line_centers[n_refined_lines++];
 
                 // now that we created the right point, make up the
                 // two child lines.  To this end, find a pair of
@@ -5174,6 +5221,7 @@ namespace internal
                 // refinement
                 line->clear_user_flag();
               }
+          AssertDimension(n_refined_lines, line_centers.size());
         }
 
 
@@ -5569,6 +5617,12 @@ namespace internal
 
         // first for lines
         {
+          // the new vertices of all lines are computed up front, the lines
+          // below visit them in the same order
+          const std::vector<Point<spacedim>> line_centers =
+            compute_centers_of_flagged_lines(triangulation);
+          unsigned int n_refined_lines = 0;
+
           // only active objects can be refined further
           typename Triangulation<dim, spacedim>::active_line_iterator
             line = triangulation.begin_active_line(),
@@ -5591,7 +5645,9 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                AssertIndexRange(n_refined_lines, line_centers.size());
+                triangulation.vertices[next_unused_vertex] =
+                  line_centers[n_refined_lines++];
 
                 // now that we created the right point, make up the
                 // two child lines (++ takes care of the end of the
@@ -5649,6 +5705,7 @@ namespace internal
                 // for refinement
                 line->clear_user_flag();
               }
+          AssertDimension(n_refined_lines, line_centers.size());
         }
 
 
@@ -15103,6 +15160,42 @@ Triangulation<dim, spacedim>::memory_consumption() const
 }
 
 
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::add_memory_consumption(
+  MemoryReport &     report,
+  const std::string &name) const
+{
+  std::size_t parts = 0;
+  for (unsigned int i = 0; i < levels.size(); ++i)
+    {
+      const std::size_t level_memory =
+        MemoryConsumption::memory_consumption(*levels[i]);
+      report.add(name + "/level " + Utilities::int_to_string(i),
+                 level_memory);
+      parts += level_memory;
+    }
+
+  if (faces)
+    {
+      const std::size_t face_memory =
+        MemoryConsumption::memory_consumption(*faces);
+      report.add(name + "/faces", face_memory);
+      parts += face_memory;
+    }
+
+  const std::size_t vertex_memory =
+    MemoryConsumption::memory_consumption(vertices) +
+    MemoryConsumption::memory_consumption(vertices_used);
+  report.add(name + "/vertices", vertex_memory);
+  parts += vertex_memory;
+
+  report.add(name + "/other",
+             Triangulation<dim, spacedim>::memory_consumption() - parts);
+}
+
+
 // explicit instantiations
 #include "tria.inst"
 
@@ -1987,8 +1987,12 @@ types::subdomain_id
 CellAccessor<dim, spacedim>::level_subdomain_id() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->tria->levels[this->present_level]
-    ->level_subdomain_ids[this->present_index];
+
+  // the level subdomain ids are only stored once a nonzero one has been set
+  const auto &level = *this->tria->levels[this->present_level];
+  if (level.level_subdomain_ids_allocation.allocated() == false)
+    return 0;
+  return level.level_subdomain_ids[this->present_index];
 }
 
 
@@ -1999,8 +2003,17 @@ CellAccessor<dim, spacedim>::set_level_subdomain_id(
   const types::subdomain_id new_level_subdomain_id) const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  this->tria->levels[this->present_level]
-    ->level_subdomain_ids[this->present_index] = new_level_subdomain_id;
+
+  auto &level = *this->tria->levels[this->present_level];
+  if (level.level_subdomain_ids_allocation.allocated() == false)
+    {
+      if (new_level_subdomain_id == 0)
+        return;
+      level.level_subdomain_ids_allocation.ensure_allocated([&]() {
+        level.level_subdomain_ids.resize(level.refine_flags.size(), 0);
+      });
+    }
+  level.level_subdomain_ids[this->present_index] = new_level_subdomain_id;
 }
 
 
@@ -58,10 +58,15 @@ namespace internal
                                total_cells - subdomain_ids.size(),
                                0);
 
-          level_subdomain_ids.reserve(total_cells);
-          level_subdomain_ids.insert(level_subdomain_ids.end(),
-                                     total_cells - level_subdomain_ids.size(),
-                                     0);
+          // the level subdomain ids are only allocated once they are used
+          if (level_subdomain_ids_allocation.allocated())
+            {
+              level_subdomain_ids.reserve(total_cells);
+              level_subdomain_ids.insert(level_subdomain_ids.end(),
+                                         total_cells -
+                                           level_subdomain_ids.size(),
+                                         0);
+            }
 
           if (dimension < space_dimension)
             {
@@ -150,10 +155,15 @@ namespace internal
                                total_cells - subdomain_ids.size(),
                                0);
 
-          level_subdomain_ids.reserve(total_cells);
-          level_subdomain_ids.insert(level_subdomain_ids.end(),
-                                     total_cells - level_subdomain_ids.size(),
-                                     0);
+          // the level subdomain ids are only allocated once they are used
+          if (level_subdomain_ids_allocation.allocated())
+            {
+              level_subdomain_ids.reserve(total_cells);
+              level_subdomain_ids.insert(level_subdomain_ids.end(),
+                                         total_cells -
+                                           level_subdomain_ids.size(),
+                                         0);
+            }
 
           if (dimension < space_dimension)
             {
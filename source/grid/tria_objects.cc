@@ -118,8 +118,12 @@ namespace internal
           boundary_or_material_id.reserve(new_size);
           boundary_or_material_id.resize(new_size);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          // the user data is only allocated once it is used
+          if (user_data_allocation.allocated())
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           manifold_id.reserve(new_size);
           manifold_id.insert(manifold_id.end(),
@@ -205,8 +209,12 @@ namespace internal
                              new_size - manifold_id.size(),
                              numbers::flat_manifold_id);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          // the user data is only allocated once it is used
+          if (user_data_allocation.allocated())
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           face_orientations.reserve(new_size * GeometryInfo<3>::faces_per_cell);
           face_orientations.insert(face_orientations.end(),
@@ -319,7 +327,8 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(!user_data_allocation.allocated() ||
+             cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -340,7 +349,8 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(!user_data_allocation.allocated() ||
+             cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -358,7 +368,8 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(!user_data_allocation.allocated() ||
+             cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
       Assert(cells.size() * GeometryInfo<3>::faces_per_cell ==
                face_orientations.size(),
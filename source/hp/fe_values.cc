@@ -21,6 +21,32 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace hp
 {
+  namespace
+  {
+    // Create a new FEValues object from the one of the original hp object
+    // if such an object was copied. Only ::FEValues can be copied, and the
+    // copy shares the precomputed data of the finite element if possible.
+    // For the other classes, return nullptr such that a new object is
+    // created from scratch.
+    template <class FEValuesType>
+    std::shared_ptr<FEValuesType>
+    copy_fe_values(const FEValuesType &)
+    {
+      return std::shared_ptr<FEValuesType>();
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::shared_ptr<dealii::FEValues<dim, spacedim>>
+    copy_fe_values(const dealii::FEValues<dim, spacedim> &prototype)
+    {
+      return std::make_shared<dealii::FEValues<dim, spacedim>>(prototype);
+    }
+  } // namespace
+
+
+
   // -------------------------- FEValuesBase -------------------------
 
   template <int dim, int q_dim, class FEValuesType>
@@ -40,6 +66,7 @@ namespace hp
     , present_fe_values_index(numbers::invalid_unsigned_int,
                               numbers::invalid_unsigned_int,
                               numbers::invalid_unsigned_int)
+    , present_fe_values(nullptr)
     , update_flags(update_flags)
   {}
 
@@ -59,11 +86,43 @@ namespace hp
     , present_fe_values_index(numbers::invalid_unsigned_int,
                               numbers::invalid_unsigned_int,
                               numbers::invalid_unsigned_int)
+    , present_fe_values(nullptr)
     , update_flags(update_flags)
   {}
 
 
 
+  template <int dim, int q_dim, class FEValuesType>
+  FEValuesBase<dim, q_dim, FEValuesType>::FEValuesBase(
+    const FEValuesBase<dim, q_dim, FEValuesType> &other)
+    : fe_collection(other.fe_collection)
+    , mapping_collection(other.mapping_collection)
+    , q_collection(other.q_collection)
+    , fe_values_table(other.fe_values_table.size(0),
+                      other.fe_values_table.size(1),
+                      other.fe_values_table.size(2))
+    , prototype_table(other.fe_values_table.size(0),
+                      other.fe_values_table.size(1),
+                      other.fe_values_table.size(2))
+    , present_fe_values_index(numbers::invalid_unsigned_int,
+                              numbers::invalid_unsigned_int,
+                              numbers::invalid_unsigned_int)
+    , present_fe_values(nullptr)
+    , update_flags(other.update_flags)
+  {
+    // remember the objects of the other object, or the ones it would have
+    // created its objects from, but do not yet create any object
+    for (unsigned int f = 0; f < fe_values_table.size(0); ++f)
+      for (unsigned int m = 0; m < fe_values_table.size(1); ++m)
+        for (unsigned int q = 0; q < fe_values_table.size(2); ++q)
+          if (other.fe_values_table(f, m, q) != nullptr)
+            prototype_table(f, m, q) = other.fe_values_table(f, m, q);
+          else if (other.prototype_table.n_elements() > 0)
+            prototype_table(f, m, q) = other.prototype_table(f, m, q);
+  }
+
+
+
   template <int dim, int q_dim, class FEValuesType>
   FEValuesType &
   FEValuesBase<dim, q_dim, FEValuesType>::select_fe_values(
@@ -71,6 +130,14 @@ namespace hp
     const unsigned int mapping_index,
     const unsigned int q_index)
   {
+    // in the common case of consecutive cells with the same indices, we
+    // can return the object selected last time right away
+    if (present_fe_values != nullptr &&
+        present_fe_values_index[0] == fe_index &&
+        present_fe_values_index[1] == mapping_index &&
+        present_fe_values_index[2] == q_index)
+      return *present_fe_values;
+
     Assert(fe_index < fe_collection->size(),
            ExcIndexRange(fe_index, 0, fe_collection->size()));
     Assert(mapping_index < mapping_collection->size(),
@@ -86,16 +153,25 @@ namespace hp
     // first check whether we
     // already have an object for
     // this particular combination
-    // of indices
-    if (fe_values_table(present_fe_values_index).get() == nullptr)
-      fe_values_table(present_fe_values_index) =
+    // of indices. if not, create it
+    // from the object of the
+    // original if this one is a copy
+    std::shared_ptr<FEValuesType> &fe_values =
+      fe_values_table(present_fe_values_index);
+    if (fe_values.get() == nullptr &&
+        prototype_table.n_elements() > 0 &&
+        prototype_table(present_fe_values_index) != nullptr)
+      fe_values = copy_fe_values(*prototype_table(present_fe_values_index));
+    if (fe_values.get() == nullptr)
+      fe_values =
         std::make_shared<FEValuesType>((*mapping_collection)[mapping_index],
                                        (*fe_collection)[fe_index],
                                        q_collection[q_index],
                                        update_flags);
 
     // now there definitely is one!
-    return *fe_values_table(present_fe_values_index);
+    present_fe_values = fe_values.get();
+    return *present_fe_values;
   }
 } // namespace hp
 
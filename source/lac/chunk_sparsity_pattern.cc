@@ -220,6 +220,62 @@ ChunkSparsityPattern::copy_from(const SparsityPatternType &dsp,
 
 
 
+template <typename SparsityPatternType>
+ChunkSparsityPattern::size_type
+ChunkSparsityPattern::suggest_chunk_size(const SparsityPatternType &sparsity,
+                                         const size_type  max_chunk_size,
+                                         const double     min_fill_ratio)
+{
+  Assert(max_chunk_size > 0, ExcInvalidNumber(max_chunk_size));
+  Assert(min_fill_ratio > 0 && min_fill_ratio <= 1,
+         ExcMessage("The fill ratio must be in the interval (0,1]."));
+
+  const size_type n_entries = sparsity.n_nonzero_elements();
+  if (n_entries == 0)
+    return 1;
+
+  // the chunk row in which each chunk column has been seen last, used to
+  // count the distinct chunks without building the chunk pattern
+  std::vector<size_type> last_chunk_row;
+  for (size_type chunk_size = std::min(max_chunk_size, sparsity.n_rows());
+       chunk_size > 1;
+       --chunk_size)
+    {
+      const size_type n_chunk_cols =
+        (sparsity.n_cols() + chunk_size - 1) / chunk_size;
+      last_chunk_row.assign(n_chunk_cols, numbers::invalid_size_type);
+
+      // stop counting as soon as the chunks are too many for the fill ratio
+      const double max_n_chunks =
+        n_entries / (min_fill_ratio * chunk_size * chunk_size);
+      size_type n_chunks = 0;
+      for (size_type row = 0;
+           row < sparsity.n_rows() && n_chunks <= max_n_chunks;
+           ++row)
+        {
+          const size_type chunk_row = row / chunk_size;
+          for (typename SparsityPatternType::iterator col = sparsity.begin(row);
+               col != sparsity.end(row);
+               ++col)
+            {
+              const size_type chunk_col = col->column() / chunk_size;
+              if (last_chunk_row[chunk_col] != chunk_row)
+                {
+                  last_chunk_row[chunk_col] = chunk_row;
+                  ++n_chunks;
+                }
+            }
+        }
+
+      if (n_chunks <= max_n_chunks)
+        return chunk_size;
+    }
+
+  return 1;
+}
+
+
+
 template <typename number>
 void
 ChunkSparsityPattern::copy_from(const FullMatrix<number> &matrix,
@@ -610,6 +666,16 @@ ChunkSparsityPattern::create_from<DynamicSparsityPattern>(
   const DynamicSparsityPattern &,
   const size_type,
   const bool);
+template ChunkSparsityPattern::size_type
+ChunkSparsityPattern::suggest_chunk_size<SparsityPattern>(
+  const SparsityPattern &,
+  const size_type,
+  const double);
+template ChunkSparsityPattern::size_type
+ChunkSparsityPattern::suggest_chunk_size<DynamicSparsityPattern>(
+  const DynamicSparsityPattern &,
+  const size_type,
+  const double);
 template void
 ChunkSparsityPattern::copy_from<float>(const FullMatrix<float> &,
                                        const size_type);
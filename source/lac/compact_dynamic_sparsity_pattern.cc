@@ -0,0 +1,233 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/compact_dynamic_sparsity_pattern.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+
+void
+CompactDynamicSparsityPattern::Segment::merge_buffer()
+{
+  if (buffer.empty())
+    return;
+
+  std::sort(buffer.begin(), buffer.end());
+  buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+
+  // merge the sorted rows of the compressed storage with the sorted buffer,
+  // row by row
+  const unsigned int       n_local_rows = row_start.size() - 1;
+  std::vector<std::size_t> new_row_start(n_local_rows + 1);
+  std::vector<size_type>   new_columns;
+  new_columns.reserve(columns.size() + buffer.size());
+
+  auto new_entry = buffer.cbegin();
+  for (unsigned int row = 0; row < n_local_rows; ++row)
+    {
+      new_row_start[row] = new_columns.size();
+
+      auto       col     = columns.cbegin() + row_start[row];
+      const auto end_row = columns.cbegin() + row_start[row + 1];
+      for (; new_entry != buffer.cend() && new_entry->first == row;
+           ++new_entry)
+        {
+          for (; col != end_row && *col < new_entry->second; ++col)
+            new_columns.push_back(*col);
+          if (col == end_row || *col != new_entry->second)
+            new_columns.push_back(new_entry->second);
+        }
+      new_columns.insert(new_columns.end(), col, end_row);
+    }
+  new_row_start[n_local_rows] = new_columns.size();
+
+  // the buffer typically contains many entries that already existed, so
+  // release the memory we reserved for them
+  new_columns.shrink_to_fit();
+  columns.swap(new_columns);
+  row_start.swap(new_row_start);
+
+  std::vector<std::pair<unsigned int, size_type>> tmp;
+  buffer.swap(tmp);
+}
+
+
+
+std::size_t
+CompactDynamicSparsityPattern::Segment::memory_consumption() const
+{
+  return (MemoryConsumption::memory_consumption(row_start) +
+          MemoryConsumption::memory_consumption(columns) +
+          buffer.capacity() * sizeof(std::pair<unsigned int, size_type>));
+}
+
+
+
+CompactDynamicSparsityPattern::CompactDynamicSparsityPattern()
+  : rows(0)
+  , cols(0)
+  , rows_per_segment(1)
+  , compressed(true)
+{}
+
+
+
+CompactDynamicSparsityPattern::CompactDynamicSparsityPattern(
+  const size_type    m,
+  const size_type    n,
+  const unsigned int n_rows_per_segment)
+  : CompactDynamicSparsityPattern()
+{
+  reinit(m, n, n_rows_per_segment);
+}
+
+
+
+void
+CompactDynamicSparsityPattern::reinit(const size_type    m,
+                                      const size_type    n,
+                                      const unsigned int n_rows_per_segment)
+{
+  Assert(n_rows_per_segment > 0, ExcMessage("Segments must not be empty."));
+
+  rows             = m;
+  cols             = n;
+  rows_per_segment = n_rows_per_segment;
+  compressed       = true;
+
+  std::vector<Segment> new_segments((m + rows_per_segment - 1) /
+                                    rows_per_segment);
+  for (size_type s = 0; s < new_segments.size(); ++s)
+    new_segments[s].row_start.resize(
+      std::min<size_type>(rows_per_segment, m - s * rows_per_segment) + 1, 0);
+  segments.swap(new_segments);
+}
+
+
+
+void
+CompactDynamicSparsityPattern::compress()
+{
+  if (compressed)
+    return;
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(segments.size()),
+    [this](const unsigned int begin, const unsigned int end) {
+      for (unsigned int s = begin; s < end; ++s)
+        segments[s].merge_buffer();
+    },
+    1);
+
+  compressed = true;
+}
+
+
+
+bool
+CompactDynamicSparsityPattern::empty() const
+{
+  return ((rows == 0) && (cols == 0));
+}
+
+
+
+bool
+CompactDynamicSparsityPattern::exists(const size_type i,
+                                      const size_type j) const
+{
+  AssertIndexRange(i, rows);
+  AssertIndexRange(j, cols);
+  Assert(compressed, ExcNotCompressed());
+
+  const Segment &    segment   = segments[i / rows_per_segment];
+  const unsigned int local_row = i % rows_per_segment;
+  return std::binary_search(segment.columns.begin() +
+                              segment.row_start[local_row],
+                            segment.columns.begin() +
+                              segment.row_start[local_row + 1],
+                            j);
+}
+
+
+
+CompactDynamicSparsityPattern::size_type
+CompactDynamicSparsityPattern::max_entries_per_row() const
+{
+  Assert(compressed, ExcNotCompressed());
+
+  size_type m = 0;
+  for (const Segment &segment : segments)
+    for (unsigned int row = 0; row + 1 < segment.row_start.size(); ++row)
+      m = std::max<size_type>(m,
+                              segment.row_start[row + 1] -
+                                segment.row_start[row]);
+
+  return m;
+}
+
+
+
+CompactDynamicSparsityPattern::size_type
+CompactDynamicSparsityPattern::n_nonzero_elements() const
+{
+  Assert(compressed, ExcNotCompressed());
+
+  size_type n = 0;
+  for (const Segment &segment : segments)
+    n += segment.columns.size();
+
+  return n;
+}
+
+
+
+void
+CompactDynamicSparsityPattern::print(std::ostream &out) const
+{
+  for (size_type row = 0; row < rows; ++row)
+    {
+      out << '[' << row;
+
+      for (size_type index = 0; index < row_length(row); ++index)
+        out << ',' << column_number(row, index);
+
+      out << ']' << std::endl;
+    }
+
+  AssertThrow(out, ExcIO());
+}
+
+
+
+std::size_t
+CompactDynamicSparsityPattern::memory_consumption() const
+{
+  std::size_t mem = sizeof(*this);
+  for (const Segment &segment : segments)
+    mem += segment.memory_consumption();
+
+  return mem;
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,240 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/full_matrix_batch.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <typename Number>
+const unsigned int FullMatrixBatch<Number>::n_lanes;
+
+
+
+template <typename Number>
+FullMatrixBatch<Number>::FullMatrixBatch()
+  : n_stored_matrices(0)
+  , matrix_size(0)
+{}
+
+
+
+template <typename Number>
+FullMatrixBatch<Number>::FullMatrixBatch(const unsigned int n_matrices,
+                                         const unsigned int size)
+  : FullMatrixBatch()
+{
+  reinit(n_matrices, size);
+}
+
+
+
+template <typename Number>
+void
+FullMatrixBatch<Number>::reinit(const unsigned int n_matrices,
+                                const unsigned int size)
+{
+  n_stored_matrices = n_matrices;
+  matrix_size       = size;
+
+  data.resize_fast(static_cast<std::size_t>(n_batches()) * size * size);
+  data.fill(VectorizedArrayType());
+  for (unsigned int batch = 0; batch < n_batches(); ++batch)
+    {
+      VectorizedArrayType *entries =
+        data.begin() + static_cast<std::size_t>(batch) * size * size;
+      for (unsigned int i = 0; i < size; ++i)
+        entries[i * size + i] = Number(1.);
+    }
+}
+
+
+
+template <typename Number>
+void
+FullMatrixBatch<Number>::set_matrix(const unsigned int        index,
+                                    const FullMatrix<Number> &matrix)
+{
+  AssertIndexRange(index, n_stored_matrices);
+  AssertDimension(matrix.m(), matrix_size);
+  AssertDimension(matrix.n(), matrix_size);
+
+  const unsigned int   lane = index % n_lanes;
+  VectorizedArrayType *entries =
+    data.begin() +
+    static_cast<std::size_t>(index / n_lanes) * matrix_size * matrix_size;
+  for (unsigned int i = 0; i < matrix_size; ++i)
+    for (unsigned int j = 0; j < matrix_size; ++j, ++entries)
+      (*entries)[lane] = matrix(i, j);
+}
+
+
+
+template <typename Number>
+void
+FullMatrixBatch<Number>::get_matrix(const unsigned int  index,
+                                    FullMatrix<Number> &matrix) const
+{
+  AssertIndexRange(index, n_stored_matrices);
+
+  if (matrix.m() != matrix_size || matrix.n() != matrix_size)
+    matrix.reinit(matrix_size,
+                  matrix_size,
+                  /*omit_default_initialization=*/true);
+
+  const unsigned int         lane = index % n_lanes;
+  const VectorizedArrayType *entries =
+    data.begin() +
+    static_cast<std::size_t>(index / n_lanes) * matrix_size * matrix_size;
+  for (unsigned int i = 0; i < matrix_size; ++i)
+    for (unsigned int j = 0; j < matrix_size; ++j, ++entries)
+      matrix(i, j) = (*entries)[lane];
+}
+
+
+
+template <typename Number>
+void
+FullMatrixBatch<Number>::invert()
+{
+  // This is the Gauss-Jordan algorithm of FullMatrix::gauss_jordan(), with
+  // the pivot search and the row interchanges done for each lane separately
+  const unsigned int N = matrix_size;
+
+  std::vector<unsigned int> permutation(N * n_lanes);
+  std::vector<Number>       row_buffer(N);
+  for (unsigned int batch = 0; batch < n_batches(); ++batch)
+    {
+      VectorizedArrayType *A =
+        data.begin() + static_cast<std::size_t>(batch) * N * N;
+
+      // get an estimate of the size of the elements of each matrix, for the
+      // checks whether the pivots are large enough
+      Number typical_diagonal_element[n_lanes];
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          Number diagonal_sum = 0;
+          for (unsigned int i = 0; i < N; ++i)
+            diagonal_sum += std::abs(A[i * N + i][v]);
+          typical_diagonal_element[v] = diagonal_sum / N;
+        }
+      (void)typical_diagonal_element;
+
+      for (unsigned int i = 0; i < N; ++i)
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          permutation[i * n_lanes + v] = i;
+
+      for (unsigned int j = 0; j < N; ++j)
+        {
+          // pivot search and row interchange, separately for each lane
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              Number       max = std::abs(A[j * N + j][v]);
+              unsigned int r   = j;
+              for (unsigned int i = j + 1; i < N; ++i)
+                if (std::abs(A[i * N + j][v]) > max)
+                  {
+                    max = std::abs(A[i * N + j][v]);
+                    r   = i;
+                  }
+              Assert(max > 1.e-16 * typical_diagonal_element[v],
+                     LACExceptions::ExcSingular());
+
+              if (r > j)
+                {
+                  for (unsigned int k = 0; k < N; ++k)
+                    std::swap(A[j * N + k][v], A[r * N + k][v]);
+                  std::swap(permutation[j * n_lanes + v],
+                            permutation[r * n_lanes + v]);
+                }
+            }
+
+          // transformation, for all lanes at once
+          const VectorizedArrayType hr = Number(1.) / A[j * N + j];
+          for (unsigned int i = 0; i < N; ++i)
+            {
+              if (i == j)
+                continue;
+              const VectorizedArrayType factor = A[i * N + j] * hr;
+              for (unsigned int k = 0; k < N; ++k)
+                if (k != j)
+                  A[i * N + k] -= factor * A[j * N + k];
+            }
+          for (unsigned int i = 0; i < N; ++i)
+            {
+              A[i * N + j] *= hr;
+              A[j * N + i] *= -hr;
+            }
+          A[j * N + j] = hr;
+        }
+
+      // column interchange, separately for each lane
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        for (unsigned int i = 0; i < N; ++i)
+          {
+            for (unsigned int k = 0; k < N; ++k)
+              row_buffer[permutation[k * n_lanes + v]] = A[i * N + k][v];
+            for (unsigned int k = 0; k < N; ++k)
+              A[i * N + k][v] = row_buffer[k];
+          }
+    }
+}
+
+
+
+template <typename Number>
+void
+FullMatrixBatch<Number>::vmult(
+  const ArrayView<VectorizedArrayType> &      dst,
+  const ArrayView<const VectorizedArrayType> &src) const
+{
+  AssertDimension(dst.size(), static_cast<std::size_t>(n_batches()) *
+                                matrix_size);
+  AssertDimension(src.size(), static_cast<std::size_t>(n_batches()) *
+                                matrix_size);
+
+  for (unsigned int batch = 0; batch < n_batches(); ++batch)
+    vmult(batch,
+          make_array_view(dst.begin() +
+                            static_cast<std::size_t>(batch) * matrix_size,
+                          dst.begin() +
+                            static_cast<std::size_t>(batch + 1) * matrix_size),
+          make_array_view(src.begin() +
+                            static_cast<std::size_t>(batch) * matrix_size,
+                          src.begin() + static_cast<std::size_t>(batch + 1) *
+                                          matrix_size));
+}
+
+
+
+template <typename Number>
+std::size_t
+FullMatrixBatch<Number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(data);
+}
+
+
+template class FullMatrixBatch<float>;
+template class FullMatrixBatch<double>;
+
+DEAL_II_NAMESPACE_CLOSE
@@ -23,6 +23,7 @@
 
 #  include <deal.II/lac/exceptions.h>
 
+#  include <algorithm>
 #  include <cmath>
 
 
@@ -85,42 +86,17 @@ namespace GinkgoWrappers
 
   template <typename ValueType, typename IndexType>
   void
-  SolverBase<ValueType, IndexType>::apply(Vector<ValueType> &      solution,
-                                          const Vector<ValueType> &rhs)
+  SolverBase<ValueType, IndexType>::apply_solver(
+    gko::matrix::Dense<ValueType> *b,
+    gko::matrix::Dense<ValueType> *x)
   {
-    // some shortcuts.
-    using val_array = gko::Array<ValueType>;
-    using vec       = gko::matrix::Dense<ValueType>;
-
-    Assert(system_matrix, ExcNotInitialized());
-    Assert(executor, ExcNotInitialized());
-    Assert(rhs.size() == solution.size(),
-           ExcDimensionMismatch(rhs.size(), solution.size()));
-
-    // Generate the solver from the solver using the system matrix.
-    auto solver = solver_gen->generate(system_matrix);
-
-    // Create the rhs vector in Ginkgo's format.
-    std::vector<ValueType> f(rhs.size());
-    std::copy(rhs.begin(), rhs.begin() + rhs.size(), f.begin());
-    auto b =
-      vec::create(executor,
-                  gko::dim<2>(rhs.size(), 1),
-                  val_array::view(executor->get_master(), rhs.size(), f.data()),
-                  1);
-
-    // Create the solution vector in Ginkgo's format.
-    std::vector<ValueType> u(solution.size());
-    std::copy(solution.begin(), solution.begin() + solution.size(), u.begin());
-    auto x = vec::create(executor,
-                         gko::dim<2>(solution.size(), 1),
-                         val_array::view(executor->get_master(),
-                                         solution.size(),
-                                         u.data()),
-                         1);
+    Assert(solver, ExcNotInitialized());
 
     // Create the logger object to log some data from the solvers to confirm
-    // convergence.
+    // convergence. The logger of a previous solve is removed from the
+    // combined factory first.
+    if (convergence_logger)
+      combined_factory->remove_logger(gko::lend(convergence_logger));
     initialize_ginkgo_log();
 
     Assert(convergence_logger, ExcNotInitialized());
@@ -129,7 +105,7 @@ namespace GinkgoWrappers
     combined_factory->add_logger(convergence_logger);
 
     // Finally, apply the solver to b and get the solution in x.
-    solver->apply(gko::lend(b), gko::lend(x));
+    solver->apply(b, x);
 
     // The convergence_logger object contains the residual vector after the
     // solver has returned. use this vector to compute the residual norm of the
@@ -151,38 +127,70 @@ namespace GinkgoWrappers
 
     // Ginkgo works with a relative residual norm through its
     // ResidualNormReduction criterion. Therefore, to get the normalized
-    // residual, we divide by the norm of the rhs.
-    auto b_norm = gko::matrix::Dense<ValueType>::create(executor->get_master(),
-                                                        gko::dim<2>{1, 1});
-    if (executor != executor->get_master())
-      {
-        auto b_master = vec::create(executor->get_master(),
-                                    gko::dim<2>(rhs.size(), 1),
-                                    val_array::view(executor->get_master(),
-                                                    rhs.size(),
-                                                    f.data()),
-                                    1);
-        b_master->compute_norm2(b_norm.get());
-      }
-    else
-      {
-        b->compute_norm2(b_norm.get());
-      }
+    // residual, we divide by the norm of the rhs, which is computed on the
+    // executor and copied to the host.
+    auto b_norm =
+      gko::matrix::Dense<ValueType>::create(executor, gko::dim<2>{1, 1});
+    b->compute_norm2(b_norm.get());
+    auto b_norm_master =
+      gko::matrix::Dense<ValueType>::create(executor->get_master(),
+                                            gko::dim<2>{1, 1});
+    b_norm_master->copy_from(b_norm.get());
 
-    Assert(b_norm.get()->at(0, 0) != 0.0, ExcDivideByZero());
+    Assert(b_norm_master->at(0, 0) != 0.0, ExcDivideByZero());
     // Pass the number of iterations and residual norm to the solver_control
-    // object. As both `residual_norm_d_master` and `b_norm` are seen as Dense
-    // matrices, we use the `at` function to get the first value here. In case
-    // of multiple right hand sides, this will need to be modified.
+    // object. As both `residual_norm_d_master` and `b_norm_master` are seen
+    // as Dense matrices, we use the `at` function to get the first value
+    // here. In case of multiple right hand sides, this will need to be
+    // modified.
     const SolverControl::State state =
       solver_control.check(num_iteration,
-                           residual_norm_d_master->at(0, 0) / b_norm->at(0, 0));
+                           residual_norm_d_master->at(0, 0) /
+                             b_norm_master->at(0, 0));
 
     // in case of failure: throw exception
     if (state != SolverControl::success)
       AssertThrow(false,
                   SolverControl::NoConvergence(solver_control.last_step(),
                                                solver_control.last_value()));
+  }
+
+
+
+  template <typename ValueType, typename IndexType>
+  void
+  SolverBase<ValueType, IndexType>::apply(Vector<ValueType> &      solution,
+                                          const Vector<ValueType> &rhs)
+  {
+    // some shortcuts.
+    using val_array = gko::Array<ValueType>;
+    using vec       = gko::matrix::Dense<ValueType>;
+
+    Assert(system_matrix, ExcNotInitialized());
+    Assert(executor, ExcNotInitialized());
+    Assert(rhs.size() == solution.size(),
+           ExcDimensionMismatch(rhs.size(), solution.size()));
+
+    // Create the rhs vector in Ginkgo's format.
+    std::vector<ValueType> f(rhs.size());
+    std::copy(rhs.begin(), rhs.begin() + rhs.size(), f.begin());
+    auto b =
+      vec::create(executor,
+                  gko::dim<2>(rhs.size(), 1),
+                  val_array::view(executor->get_master(), rhs.size(), f.data()),
+                  1);
+
+    // Create the solution vector in Ginkgo's format.
+    std::vector<ValueType> u(solution.size());
+    std::copy(solution.begin(), solution.begin() + solution.size(), u.begin());
+    auto x = vec::create(executor,
+                         gko::dim<2>(solution.size(), 1),
+                         val_array::view(executor->get_master(),
+                                         solution.size(),
+                                         u.data()),
+                         1);
+
+    apply_solver(b.get(), x.get());
 
     // Check if the solution is on a CUDA device, if so, copy it over to the
     // host.
@@ -204,6 +212,48 @@ namespace GinkgoWrappers
 
 
 
+#  ifdef DEAL_II_WITH_CUDA
+  template <typename ValueType, typename IndexType>
+  void
+  SolverBase<ValueType, IndexType>::apply(
+    LinearAlgebra::distributed::Vector<ValueType, MemorySpace::CUDA> &solution,
+    const LinearAlgebra::distributed::Vector<ValueType, MemorySpace::CUDA>
+      &rhs)
+  {
+    using val_array = gko::Array<ValueType>;
+    using vec       = gko::matrix::Dense<ValueType>;
+
+    Assert(system_matrix, ExcNotInitialized());
+    Assert(exec_type == "cuda",
+           ExcMessage("Vectors in device memory can only be used with the "
+                      "\"cuda\" executor."));
+    Assert(rhs.size() == solution.size(),
+           ExcDimensionMismatch(rhs.size(), solution.size()));
+    Assert(solution.local_size() == solution.size(),
+           ExcMessage("The Ginkgo solvers can only be used in serial."));
+
+    // Let Ginkgo work on the device memory of the vectors. Ginkgo does not
+    // modify the right hand side, so removing the const qualifier is safe.
+    auto b = vec::create(executor,
+                         gko::dim<2>(rhs.size(), 1),
+                         val_array::view(executor,
+                                         rhs.size(),
+                                         const_cast<ValueType *>(
+                                           rhs.get_values())),
+                         1);
+    auto x = vec::create(executor,
+                         gko::dim<2>(solution.size(), 1),
+                         val_array::view(executor,
+                                         solution.size(),
+                                         solution.get_values()),
+                         1);
+
+    apply_solver(b.get(), x.get());
+  }
+#  endif
+
+
+
   template <typename ValueType, typename IndexType>
   SolverControl &
   SolverBase<ValueType, IndexType>::control() const
@@ -280,9 +330,61 @@ namespace GinkgoWrappers
       for (size_type i = 0; i < N - 1; ++i)
         Assert(row_pointers[i] == mat_row_ptrs[i + 1], ExcInternalError());
     }
-    system_matrix =
-      mtx::create(executor, gko::dim<2>(N), matrix.n_nonzero_elements());
-    system_matrix->copy_from(system_matrix_compute.get());
+
+    // If the sparsity pattern is the same as the one of the previous matrix,
+    // only copy the values to the executor. Otherwise, copy the complete
+    // matrix.
+    const std::size_t n_nonzeros = matrix.n_nonzero_elements();
+    if (system_matrix != nullptr && host_matrix != nullptr &&
+        host_matrix->get_size() == system_matrix_compute->get_size() &&
+        host_matrix->get_num_stored_elements() == n_nonzeros &&
+        std::equal(mat_row_ptrs,
+                   mat_row_ptrs + N + 1,
+                   host_matrix->get_const_row_ptrs()) &&
+        std::equal(mat_col_idxs,
+                   mat_col_idxs + n_nonzeros,
+                   host_matrix->get_const_col_idxs()))
+      executor->copy_from(executor->get_master().get(),
+                          n_nonzeros,
+                          mat_values,
+                          system_matrix->get_values());
+    else
+      {
+        system_matrix = mtx::create(executor, gko::dim<2>(N), n_nonzeros);
+        system_matrix->copy_from(system_matrix_compute.get());
+      }
+    host_matrix = system_matrix_compute;
+
+    solver = solver_gen->generate(system_matrix);
+  }
+
+
+
+  template <typename ValueType, typename IndexType>
+  void
+  SolverBase<ValueType, IndexType>::initialize(
+    const std::shared_ptr<gko::matrix::Csr<ValueType, IndexType>> &matrix)
+  {
+    Assert(matrix, ExcNotInitialized());
+    Assert(matrix->get_size()[0] == matrix->get_size()[1], ExcNotQuadratic());
+
+    // Only copy the matrix if it is stored on a different executor
+    if (matrix->get_executor() == executor)
+      system_matrix = matrix;
+    else
+      system_matrix = gko::clone(executor, matrix);
+    host_matrix.reset();
+
+    solver = solver_gen->generate(system_matrix);
+  }
+
+
+
+  template <typename ValueType, typename IndexType>
+  std::shared_ptr<gko::matrix::Csr<ValueType, IndexType>>
+  SolverBase<ValueType, IndexType>::get_system_matrix() const
+  {
+    return system_matrix;
   }
 
 
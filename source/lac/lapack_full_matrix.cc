@@ -1976,6 +1976,72 @@ LAPACKFullMatrix<number>::compute_eigenvalues(const bool right, const bool left)
 }
 
 
+
+namespace
+{
+  // For real matrices, xGEEV stores the eigenvectors to a pair of
+  // complex-conjugate eigenvalues in two consecutive columns as the real and
+  // the imaginary part of the eigenvector to the eigenvalue with positive
+  // imaginary part.
+  template <typename RealNumber>
+  void
+  unpack_right_eigenvectors(const std::vector<RealNumber> &       vr,
+                            const std::vector<RealNumber> &       wi,
+                            FullMatrix<std::complex<RealNumber>> &result)
+  {
+    const unsigned int n = result.n();
+    for (unsigned int j = 0; j < n; ++j)
+      if (wi[j] == RealNumber())
+        for (unsigned int i = 0; i < n; ++i)
+          result(i, j) = vr[j * n + i];
+      else
+        {
+          AssertIndexRange(j + 1, n);
+          for (unsigned int i = 0; i < n; ++i)
+            {
+              result(i, j) =
+                std::complex<RealNumber>(vr[j * n + i], vr[(j + 1) * n + i]);
+              result(i, j + 1) = std::conj(result(i, j));
+            }
+          ++j;
+        }
+  }
+
+
+
+  // for complex matrices, the eigenvectors are stored as they are
+  template <typename RealNumber>
+  void
+  unpack_right_eigenvectors(const std::vector<std::complex<RealNumber>> &vr,
+                            const std::vector<std::complex<RealNumber>> &,
+                            FullMatrix<std::complex<RealNumber>> &result)
+  {
+    const unsigned int n = result.n();
+    for (unsigned int j = 0; j < n; ++j)
+      for (unsigned int i = 0; i < n; ++i)
+        result(i, j) = vr[j * n + i];
+  }
+} // namespace
+
+
+
+template <typename number>
+FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+LAPACKFullMatrix<number>::get_right_eigenvectors() const
+{
+  Assert(state & LAPACKSupport::eigenvalues, ExcInvalidState());
+  const size_type nn = this->n();
+  Assert(vr.size() == nn * nn,
+         ExcMessage("Right eigenvectors are not available. Did you set the "
+                    "associated flag in compute_eigenvalues()?"));
+
+  FullMatrix<std::complex<typename numbers::NumberTraits<number>::real_type>>
+    result(nn, nn);
+  unpack_right_eigenvectors(vr, wi, result);
+  return result;
+}
+
+
 template <typename number>
 void
 LAPACKFullMatrix<number>::compute_eigenvalues_symmetric(
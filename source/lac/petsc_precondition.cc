@@ -72,6 +72,17 @@ namespace PETScWrappers
   }
 
 
+  void
+  PreconditionerBase::vmult(
+    LinearAlgebra::distributed::Vector<PetscScalar> &      dst,
+    const LinearAlgebra::distributed::Vector<PetscScalar> &src) const
+  {
+    internal::VectorView       petsc_dst(dst);
+    const internal::VectorView petsc_src(src);
+    vmult(petsc_dst, petsc_src);
+  }
+
+
   void
   PreconditionerBase::create_pc()
   {
@@ -150,6 +150,19 @@ namespace PETScWrappers
   }
 
 
+
+  void
+  SolverBase::solve(const MatrixBase &                                     A,
+                    LinearAlgebra::distributed::Vector<PetscScalar> &      x,
+                    const LinearAlgebra::distributed::Vector<PetscScalar> &b,
+                    const PreconditionerBase &preconditioner)
+  {
+    internal::VectorView       petsc_x(x);
+    const internal::VectorView petsc_b(b);
+    solve(A, petsc_x, petsc_b, preconditioner);
+  }
+
+
   void
   SolverBase::set_prefix(const std::string &prefix)
   {
@@ -843,6 +856,19 @@ namespace PETScWrappers
 #  endif
   }
 
+
+
+  void
+  SparseDirectMUMPS::solve(
+    const MatrixBase &                                     A,
+    LinearAlgebra::distributed::Vector<PetscScalar> &      x,
+    const LinearAlgebra::distributed::Vector<PetscScalar> &b)
+  {
+    internal::VectorView       petsc_x(x);
+    const internal::VectorView petsc_b(b);
+    solve(A, petsc_x, petsc_b);
+  }
+
   PetscErrorCode
   SparseDirectMUMPS::convergence_test(KSP /*ksp*/,
                                       const PetscInt      iteration,
@@ -21,6 +21,7 @@
 #  include <deal.II/base/multithread_info.h>
 
 #  include <deal.II/lac/exceptions.h>
+#  include <deal.II/lac/la_parallel_vector.h>
 #  include <deal.II/lac/petsc_compatibility.h>
 #  include <deal.II/lac/petsc_vector.h>
 
@@ -970,6 +971,29 @@ namespace PETScWrappers
     last_action = action;
   }
 
+
+
+  namespace internal
+  {
+    VectorView::VectorView(
+      const LinearAlgebra::distributed::Vector<PetscScalar,
+                                               ::dealii::MemorySpace::Host>
+        &v)
+    {
+      // PETSc does not free the array of a vector created with a
+      // user-provided array, so the base class destructor only releases the
+      // vector header
+      const PetscErrorCode ierr =
+        VecCreateMPIWithArray(v.get_mpi_communicator(),
+                              1,
+                              static_cast<PetscInt>(v.local_size()),
+                              static_cast<PetscInt>(v.size()),
+                              v.begin(),
+                              &vector);
+      AssertThrow(ierr == 0, ExcPETScError(ierr));
+    }
+  } // namespace internal
+
 } // namespace PETScWrappers
 
 DEAL_II_NAMESPACE_CLOSE
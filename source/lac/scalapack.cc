@@ -1302,6 +1302,35 @@ ScaLAPACKMatrix<NumberType>::compute_lu_factorization()
 
 
 
+template <typename NumberType>
+Threads::Task<void>
+ScaLAPACKMatrix<NumberType>::compute_cholesky_factorization_async()
+{
+  return Threads::new_task([this]() { compute_cholesky_factorization(); });
+}
+
+
+
+template <typename NumberType>
+Threads::Task<void>
+ScaLAPACKMatrix<NumberType>::compute_lu_factorization_async()
+{
+  return Threads::new_task([this]() { compute_lu_factorization(); });
+}
+
+
+
+template <typename NumberType>
+Threads::Task<void>
+ScaLAPACKMatrix<NumberType>::mmult_async(ScaLAPACKMatrix<NumberType> &      C,
+                                         const ScaLAPACKMatrix<NumberType> &B,
+                                         const bool adding) const
+{
+  return Threads::new_task([this, &C, &B, adding]() { mmult(C, B, adding); });
+}
+
+
+
 template <typename NumberType>
 void
 ScaLAPACKMatrix<NumberType>::invert()
@@ -1792,6 +1821,20 @@ ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_by_value_MRRR(
 
 
 
+template <typename NumberType>
+Threads::Task<std::vector<NumberType>>
+ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_by_index_MRRR_async(
+  const std::pair<unsigned int, unsigned int> &index_limits,
+  const bool                                   compute_eigenvectors)
+{
+  return Threads::new_task([this, index_limits, compute_eigenvectors]() {
+    return eigenpairs_symmetric_by_index_MRRR(index_limits,
+                                              compute_eigenvectors);
+  });
+}
+
+
+
 template <typename NumberType>
 std::vector<NumberType>
 ScaLAPACKMatrix<NumberType>::eigenpairs_symmetric_MRRR(
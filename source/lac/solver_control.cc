@@ -20,10 +20,110 @@
 #include <deal.II/lac/solver_control.h>
 
 #include <cmath>
+#include <iomanip>
 #include <sstream>
 
 DEAL_II_NAMESPACE_OPEN
 
+/*----------------------- SolverStatistics ---------------------------*/
+
+
+SolverStatistics::SolverStatistics()
+{
+  reset();
+}
+
+
+
+void
+SolverStatistics::reset()
+{
+  calls.fill(0);
+  times.fill(0.);
+  transferred_bytes.fill(0.);
+}
+
+
+
+void
+SolverStatistics::add(const Operation operation,
+                      const double    time,
+                      const double    bytes)
+{
+  AssertIndexRange(static_cast<unsigned int>(operation),
+                   static_cast<unsigned int>(n_operations));
+  ++calls[operation];
+  times[operation] += time;
+  transferred_bytes[operation] += bytes;
+}
+
+
+
+unsigned long int
+SolverStatistics::n_calls(const Operation operation) const
+{
+  AssertIndexRange(static_cast<unsigned int>(operation),
+                   static_cast<unsigned int>(n_operations));
+  return calls[operation];
+}
+
+
+
+double
+SolverStatistics::time(const Operation operation) const
+{
+  AssertIndexRange(static_cast<unsigned int>(operation),
+                   static_cast<unsigned int>(n_operations));
+  return times[operation];
+}
+
+
+
+double
+SolverStatistics::bytes(const Operation operation) const
+{
+  AssertIndexRange(static_cast<unsigned int>(operation),
+                   static_cast<unsigned int>(n_operations));
+  return transferred_bytes[operation];
+}
+
+
+
+void
+SolverStatistics::print(std::ostream &out) const
+{
+  static const char *const names[n_operations] = {"matrix-vector product",
+                                                  "preconditioner",
+                                                  "reduction",
+                                                  "vector update"};
+
+  const std::ios::fmtflags old_flags     = out.flags();
+  const std::streamsize    old_precision = out.precision();
+
+  out << std::left << std::setw(24) << "Operation" << std::right
+      << std::setw(10) << "no. calls" << std::setw(12) << "time [s]"
+      << std::setw(14) << "time/call [s]" << std::setw(12) << "GB/s"
+      << std::endl;
+  for (unsigned int op = 0; op < n_operations; ++op)
+    {
+      out << std::left << std::setw(24) << names[op] << std::right
+          << std::setw(10) << calls[op] << std::scientific
+          << std::setprecision(3) << std::setw(12) << times[op]
+          << std::setw(14) << (calls[op] > 0 ? times[op] / calls[op] : 0.);
+      if (transferred_bytes[op] > 0 && times[op] > 0)
+        out << std::fixed << std::setprecision(2) << std::setw(12)
+            << 1e-9 * transferred_bytes[op] / times[op];
+      else
+        out << std::setw(12) << "-";
+      out << std::endl;
+    }
+
+  out.precision(old_precision);
+  out.flags(old_flags);
+}
+
+
+
 /*----------------------- SolverControl ---------------------------------*/
 
 
@@ -44,6 +144,7 @@ SolverControl::SolverControl(const unsigned int maxiter,
   , m_log_frequency(1)
   , m_log_result(m_log_result)
   , history_data_enabled(false)
+  , statistics_data_enabled(false)
 {}
 
 
@@ -149,6 +250,38 @@ SolverControl::enable_history_data()
 
 
 
+void
+SolverControl::enable_statistics(const bool enable)
+{
+  statistics_data_enabled = enable;
+}
+
+
+
+bool
+SolverControl::statistics_enabled() const
+{
+  return statistics_data_enabled;
+}
+
+
+
+const SolverStatistics &
+SolverControl::get_statistics() const
+{
+  return statistics;
+}
+
+
+
+SolverStatistics &
+SolverControl::get_statistics()
+{
+  return statistics;
+}
+
+
+
 const std::vector<double> &
 SolverControl::get_history_data() const
 {
@@ -17,6 +17,7 @@
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/sparse_direct.h>
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/vector.h>
@@ -202,6 +203,90 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   _m = matrix.m();
   _n = matrix.n();
 
+  copy_matrix_to_arrays(matrix);
+
+  const size_type N = matrix.m();
+
+  int status;
+  status = umfpack_dl_symbolic(N,
+                               N,
+                               Ap.data(),
+                               Ai.data(),
+                               Ax.data(),
+                               &symbolic_decomposition,
+                               control.data(),
+                               nullptr);
+  AssertThrow(status == UMFPACK_OK,
+              ExcUMFPACKError("umfpack_dl_symbolic", status));
+
+  status = umfpack_dl_numeric(Ap.data(),
+                              Ai.data(),
+                              Ax.data(),
+                              symbolic_decomposition,
+                              &numeric_decomposition,
+                              control.data(),
+                              nullptr);
+  AssertThrow(status == UMFPACK_OK,
+              ExcUMFPACKError("umfpack_dl_numeric", status));
+
+  // keep the symbolic decomposition around for subsequent calls to
+  // refactorize()
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::refactorize(const Matrix &matrix)
+{
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+
+  // without a previous factorization of a matrix of the same size, there is
+  // nothing we could reuse
+  if (symbolic_decomposition == nullptr || matrix.m() != _m ||
+      matrix.n_nonzero_elements() != Ai.size())
+    {
+      factorize(matrix);
+      return;
+    }
+
+  // copy the new matrix, keeping the previous arrays to detect whether the
+  // sparsity pattern has changed
+  std::vector<types::suitesparse_index> old_Ap, old_Ai;
+  old_Ap.swap(Ap);
+  old_Ai.swap(Ai);
+  copy_matrix_to_arrays(matrix);
+
+  if (Ap != old_Ap || Ai != old_Ai)
+    {
+      factorize(matrix);
+      return;
+    }
+
+  // the pattern is unchanged, so only redo the numeric factorization
+  if (numeric_decomposition != nullptr)
+    {
+      umfpack_dl_free_numeric(&numeric_decomposition);
+      numeric_decomposition = nullptr;
+    }
+
+  const int status = umfpack_dl_numeric(Ap.data(),
+                                        Ai.data(),
+                                        Ax.data(),
+                                        symbolic_decomposition,
+                                        &numeric_decomposition,
+                                        control.data(),
+                                        nullptr);
+  AssertThrow(status == UMFPACK_OK,
+              ExcUMFPACKError("umfpack_dl_numeric", status));
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::copy_matrix_to_arrays(const Matrix &matrix)
+{
   const size_type N = matrix.m();
 
   // copy over the data from the matrix to the data structures UMFPACK
@@ -267,30 +352,6 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   // careful for block sparse matrices, so ship this task out to a
   // different function
   sort_arrays(matrix);
-
-  int status;
-  status = umfpack_dl_symbolic(N,
-                               N,
-                               Ap.data(),
-                               Ai.data(),
-                               Ax.data(),
-                               &symbolic_decomposition,
-                               control.data(),
-                               nullptr);
-  AssertThrow(status == UMFPACK_OK,
-              ExcUMFPACKError("umfpack_dl_symbolic", status));
-
-  status = umfpack_dl_numeric(Ap.data(),
-                              Ai.data(),
-                              Ax.data(),
-                              symbolic_decomposition,
-                              &numeric_decomposition,
-                              control.data(),
-                              nullptr);
-  AssertThrow(status == UMFPACK_OK,
-              ExcUMFPACKError("umfpack_dl_numeric", status));
-
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
 }
 
 
@@ -342,6 +403,53 @@ SparseDirectUMFPACK::solve(BlockVector<double> &rhs_and_solution,
 
 
 
+void
+SparseDirectUMFPACK::solve(FullMatrix<double> &rhs_and_solution,
+                           bool                transpose /*=false*/) const
+{
+  // make sure that some kind of factorize() call has happened before
+  Assert(Ap.size() != 0, ExcNotInitialized());
+  Assert(Ai.size() != 0, ExcNotInitialized());
+  Assert(Ai.size() == Ax.size(), ExcNotInitialized());
+  AssertDimension(rhs_and_solution.m(), _m);
+
+  const size_type N = rhs_and_solution.m();
+
+  // UMFPACK solves for one right hand side at a time and wants it stored
+  // contiguously. reuse this storage as well as the work arrays for all
+  // columns, rather than letting umfpack_dl_solve allocate them anew for
+  // each column
+  Vector<double>                        rhs(N), solution(N);
+  std::vector<types::suitesparse_index> Wi(N);
+  std::vector<double>                   W(5 * N);
+
+  for (size_type column = 0; column < rhs_and_solution.n(); ++column)
+    {
+      for (size_type i = 0; i < N; ++i)
+        rhs(i) = rhs_and_solution(i, column);
+
+      // see the function above for the choice of the system to solve
+      const int status = umfpack_dl_wsolve(transpose ? UMFPACK_A : UMFPACK_At,
+                                           Ap.data(),
+                                           Ai.data(),
+                                           Ax.data(),
+                                           solution.begin(),
+                                           rhs.begin(),
+                                           numeric_decomposition,
+                                           control.data(),
+                                           nullptr,
+                                           Wi.data(),
+                                           W.data());
+      AssertThrow(status == UMFPACK_OK,
+                  ExcUMFPACKError("umfpack_dl_wsolve", status));
+
+      for (size_type i = 0; i < N; ++i)
+        rhs_and_solution(i, column) = solution(i);
+    }
+}
+
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &  matrix,
@@ -392,6 +500,17 @@ SparseDirectUMFPACK::factorize(const Matrix &)
 }
 
 
+template <class Matrix>
+void
+SparseDirectUMFPACK::refactorize(const Matrix &)
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
 void
 SparseDirectUMFPACK::solve(Vector<double> &, bool) const
 {
@@ -413,6 +532,17 @@ SparseDirectUMFPACK::solve(BlockVector<double> &, bool) const
 }
 
 
+
+void
+SparseDirectUMFPACK::solve(FullMatrix<double> &, bool) const
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &, Vector<double> &, bool)
@@ -498,15 +628,16 @@ SparseDirectUMFPACK::n() const
 
 
 // explicit instantiations for SparseMatrixUMFPACK
-#define InstantiateUMFPACK(MatrixType)                              \
-  template void SparseDirectUMFPACK::factorize(const MatrixType &); \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,      \
-                                           Vector<double> &,        \
-                                           bool);                   \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,      \
-                                           BlockVector<double> &,   \
-                                           bool);                   \
-  template void SparseDirectUMFPACK::initialize(const MatrixType &, \
+#define InstantiateUMFPACK(MatrixType)                                \
+  template void SparseDirectUMFPACK::factorize(const MatrixType &);   \
+  template void SparseDirectUMFPACK::refactorize(const MatrixType &); \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,        \
+                                           Vector<double> &,          \
+                                           bool);                     \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,        \
+                                           BlockVector<double> &,     \
+                                           bool);                     \
+  template void SparseDirectUMFPACK::initialize(const MatrixType &,   \
                                                 const AdditionalData)
 
 InstantiateUMFPACK(SparseMatrix<double>);
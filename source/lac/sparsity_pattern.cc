@@ -17,6 +17,7 @@
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/utilities.h>
 
+#include <deal.II/lac/compact_dynamic_sparsity_pattern.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/sparsity_pattern.h>
@@ -545,6 +546,43 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
 
 
 
+// Same as above, but for the CompactDynamicSparsityPattern which stores all
+// rows
+void
+SparsityPattern::copy_from(const CompactDynamicSparsityPattern &dsp)
+{
+  Assert(dsp.is_compressed(),
+         CompactDynamicSparsityPattern::ExcNotCompressed());
+
+  const bool do_diag_optimize = (dsp.n_rows() == dsp.n_cols());
+
+  std::vector<unsigned int> row_lengths(dsp.n_rows());
+  for (size_type i = 0; i < dsp.n_rows(); ++i)
+    {
+      row_lengths[i] = dsp.row_length(i);
+      if (do_diag_optimize && !dsp.exists(i, i))
+        ++row_lengths[i];
+    }
+  reinit(dsp.n_rows(), dsp.n_cols(), row_lengths);
+
+  if (n_rows() != 0 && n_cols() != 0)
+    for (size_type row = 0; row < dsp.n_rows(); ++row)
+      {
+        size_type *cols = &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
+        const unsigned int row_length = dsp.row_length(row);
+        for (unsigned int index = 0; index < row_length; ++index)
+          {
+            const size_type col = dsp.column_number(row, index);
+            if ((col != row) || !do_diag_optimize)
+              *cols++ = col;
+          }
+      }
+
+  compressed = true;
+}
+
+
+
 template <typename number>
 void
 SparsityPattern::copy_from(const FullMatrix<number> &matrix)
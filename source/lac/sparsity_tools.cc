@@ -73,9 +73,15 @@ namespace SparsityTools
       // METIS. Note that this is particularly
       // simple, since METIS wants exactly our
       // compressed row storage format. we only
-      // have to set up a few auxiliary arrays
+      // have to set up a few auxiliary arrays. the weights of the
+      // vertices are stored vertex by vertex, so their number determines
+      // the number of balancing constraints
+      const idx_t n_constraints =
+        (cell_weights.size() > 0 ?
+           cell_weights.size() / sparsity_pattern.n_rows() :
+           1);
       idx_t n    = static_cast<signed int>(sparsity_pattern.n_rows()),
-            ncon = 1, // number of balancing constraints (should be >0)
+            ncon = n_constraints, // number of balancing constraints (> 0)
         nparts =
           static_cast<int>(n_partitions), // number of subdomains to create
         dummy;                            // the numbers of edges cut by the
@@ -114,9 +120,10 @@ namespace SparsityTools
       std::vector<idx_t> int_cell_weights;
       if (cell_weights.size() > 0)
         {
-          Assert(cell_weights.size() == sparsity_pattern.n_rows(),
-                 ExcDimensionMismatch(cell_weights.size(),
-                                      sparsity_pattern.n_rows()));
+          Assert(cell_weights.size() % sparsity_pattern.n_rows() == 0,
+                 ExcMessage("The number of cell weights must be a multiple "
+                            "of the number of rows of the sparsity "
+                            "pattern."));
           int_cell_weights.resize(cell_weights.size());
           std::copy(cell_weights.begin(),
                     cell_weights.end(),
@@ -626,42 +633,53 @@ namespace SparsityTools
          ++i)
       new_indices[last_round_dofs[i]] = next_free_number++;
 
+    // mark the dofs of a front while it is being collected, such that each
+    // dof is only added once
+    std::vector<bool> is_in_next_round(sparsity.n_rows(), false);
+
+    // store the indices of the dofs to be renumbered in the next round
+    std::vector<DynamicSparsityPattern::size_type> next_round_dofs;
+
+    // the dofs of the next round together with their coordination number
+    std::vector<std::pair<DynamicSparsityPattern::size_type,
+                          DynamicSparsityPattern::size_type>>
+      dofs_by_coordination;
+
     // now do as many steps as needed to renumber all dofs
     while (true)
       {
-        // store the indices of the dofs to be renumbered in the next round
-        std::vector<DynamicSparsityPattern::size_type> next_round_dofs;
+        next_round_dofs.clear();
 
-        // find all neighbors of the dofs numbered in the last round
+        // find all neighbors of the dofs numbered in the last round that do
+        // not have a number yet. each dof is only entered once, which avoids
+        // sorting the (much longer) list of all neighbors with duplicates
         for (const auto dof : last_round_dofs)
           for (DynamicSparsityPattern::iterator j = sparsity.begin(dof);
                j < sparsity.end(dof);
                ++j)
-            next_round_dofs.push_back(j->column());
+            {
+              const DynamicSparsityPattern::size_type column = j->column();
+              if (new_indices[column] == numbers::invalid_size_type &&
+                  is_in_next_round[column] == false)
+                {
+                  is_in_next_round[column] = true;
+                  next_round_dofs.push_back(column);
+                }
+            }
+
+        for (const auto dof : next_round_dofs)
+          is_in_next_round[dof] = false;
 
         // sort dof numbers
         std::sort(next_round_dofs.begin(), next_round_dofs.end());
 
-        // delete multiple entries
-        std::vector<DynamicSparsityPattern::size_type>::iterator end_sorted;
-        end_sorted =
-          std::unique(next_round_dofs.begin(), next_round_dofs.end());
-        next_round_dofs.erase(end_sorted, next_round_dofs.end());
-
-        // eliminate dofs which are already numbered
-        for (int s = next_round_dofs.size() - 1; s >= 0; --s)
-          if (new_indices[next_round_dofs[s]] != numbers::invalid_size_type)
-            next_round_dofs.erase(next_round_dofs.begin() + s);
-
         // check whether there are any new dofs in the list. if there are
         // none, then we have completely numbered the current component of the
         // graph. check if there are as yet unnumbered components of the graph
         // that we would then have to do next
         if (next_round_dofs.empty())
           {
-            if (std::find(new_indices.begin(),
-                          new_indices.end(),
-                          numbers::invalid_size_type) == new_indices.end())
+            if (next_free_number == sparsity.n_rows())
               // no unnumbered indices, so we can leave now
               break;
 
@@ -684,31 +702,29 @@ namespace SparsityTools
 
 
 
-        // store for each coordination number the dofs with these coordination
-        // number
-        std::multimap<DynamicSparsityPattern::size_type, int>
-          dofs_by_coordination;
-
-        // find coordination number for each of these dofs
+        // find coordination number for each of these dofs and sort the dofs
+        // by it. the sort is stable, so dofs with the same coordination
+        // number stay in the order of their index
+        dofs_by_coordination.clear();
         for (const types::global_dof_index next_round_dof : next_round_dofs)
-          {
-            const DynamicSparsityPattern::size_type coordination =
-              sparsity.row_length(next_round_dof);
-
-            // insert this dof at its coordination number
-            const std::pair<const DynamicSparsityPattern::size_type, int>
-              new_entry(coordination, next_round_dof);
-            dofs_by_coordination.insert(new_entry);
-          }
+          dofs_by_coordination.emplace_back(sparsity.row_length(next_round_dof),
+                                            next_round_dof);
+        std::stable_sort(
+          dofs_by_coordination.begin(),
+          dofs_by_coordination.end(),
+          [](const std::pair<DynamicSparsityPattern::size_type,
+                             DynamicSparsityPattern::size_type> &a,
+             const std::pair<DynamicSparsityPattern::size_type,
+                             DynamicSparsityPattern::size_type> &b) {
+            return a.first < b.first;
+          });
 
         // assign new DoF numbers to the elements of the present front:
-        std::multimap<DynamicSparsityPattern::size_type, int>::iterator i;
-        for (i = dofs_by_coordination.begin(); i != dofs_by_coordination.end();
-             ++i)
-          new_indices[i->second] = next_free_number++;
+        for (const auto &dof : dofs_by_coordination)
+          new_indices[dof.second] = next_free_number++;
 
         // after that: copy this round's dofs for the next round
-        last_round_dofs = next_round_dofs;
+        last_round_dofs.swap(next_round_dofs);
       }
 
     // test for all indices numbered. this mostly tests whether the
@@ -48,7 +48,8 @@ namespace TrilinosWrappers
     const unsigned int                    smoother_overlap,
     const bool                            output_details,
     const char *                          smoother_type,
-    const char *                          coarse_type)
+    const char *                          coarse_type,
+    const unsigned int                    max_hierarchy_reuses)
     : elliptic(elliptic)
     , higher_order_elements(higher_order_elements)
     , n_cycles(n_cycles)
@@ -60,6 +61,7 @@ namespace TrilinosWrappers
     , output_details(output_details)
     , smoother_type(smoother_type)
     , coarse_type(coarse_type)
+    , max_hierarchy_reuses(max_hierarchy_reuses)
   {}
 
 
@@ -241,6 +243,8 @@ namespace TrilinosWrappers
 
     initialize(matrix, ml_parameters);
 
+    hierarchy_data = std::make_shared<AdditionalData>(additional_data);
+
     if (additional_data.output_details)
       {
         ML_Epetra::MultiLevelPreconditioner *multilevel_operator =
@@ -269,6 +273,9 @@ namespace TrilinosWrappers
   {
     preconditioner.reset(
       new ML_Epetra::MultiLevelPreconditioner(matrix, ml_parameters));
+
+    hierarchy_data.reset();
+    n_hierarchy_reuses = 0;
   }
 
 
@@ -316,11 +323,39 @@ namespace TrilinosWrappers
 
 
 
+  void
+  PreconditionAMG::reinit_values(const SparseMatrix &matrix)
+  {
+    ML_Epetra::MultiLevelPreconditioner *multilevel_operator =
+      dynamic_cast<ML_Epetra::MultiLevelPreconditioner *>(preconditioner.get());
+    Assert(multilevel_operator != nullptr,
+           ExcMessage("The preconditioner has not been initialized."));
+    Assert(&multilevel_operator->RowMatrix() == &matrix.trilinos_matrix(),
+           ExcMessage("The aggregates can only be reused for the matrix "
+                      "the preconditioner has been initialized with."));
+
+    if (hierarchy_data != nullptr &&
+        n_hierarchy_reuses >= hierarchy_data->max_hierarchy_reuses)
+      {
+        // take a copy because initialize() resets the stored settings
+        const AdditionalData additional_data = *hierarchy_data;
+        initialize(matrix, additional_data);
+      }
+    else
+      {
+        multilevel_operator->ReComputePreconditioner();
+        ++n_hierarchy_reuses;
+      }
+  }
+
+
+
   void
   PreconditionAMG::clear()
   {
     PreconditionBase::clear();
     trilinos_matrix.reset();
+    hierarchy_data.reset();
   }
 
 
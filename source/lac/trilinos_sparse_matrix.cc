@@ -39,6 +39,7 @@
 #  include <ml_epetra_utils.h>
 #  include <ml_struct.h>
 
+#  include <algorithm>
 #  include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -1903,6 +1904,149 @@ namespace TrilinosWrappers
 
 
 
+  void
+  SparseMatrix::compute_entry_positions(
+    const std::vector<size_type> &row_indices,
+    const std::vector<size_type> &col_indices,
+    std::vector<std::size_t> &    entry_positions) const
+  {
+    Assert(matrix->Filled() && matrix->StorageOptimized(),
+           ExcMessage("The matrix must be compressed before the positions of "
+                      "its entries can be computed."));
+
+    // the values of the locally owned rows and of the writable nonlocal rows
+    // are addressed as if they were stored one after the other
+    int *           index_offsets;
+    int *           local_columns;
+    TrilinosScalar *values;
+
+    int ierr =
+      matrix->ExtractCrsDataPointers(index_offsets, local_columns, values);
+    AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+    const std::size_t n_local_entries = matrix->NumMyNonzeros();
+
+    int *           nonlocal_index_offsets = nullptr;
+    int *           nonlocal_columns       = nullptr;
+    TrilinosScalar *nonlocal_values        = nullptr;
+    if (nonlocal_matrix.get() != nullptr)
+      {
+        Assert(nonlocal_matrix->Filled(),
+               ExcMessage("The matrix must be compressed with "
+                          "VectorOperation::add before the positions of its "
+                          "nonlocal entries can be computed."));
+        ierr = nonlocal_matrix->ExtractCrsDataPointers(nonlocal_index_offsets,
+                                                       nonlocal_columns,
+                                                       nonlocal_values);
+        AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+      }
+
+    const size_type n_cols = col_indices.size();
+    entry_positions.resize(row_indices.size() * n_cols);
+    for (size_type i = 0; i < row_indices.size(); ++i)
+      {
+        const TrilinosWrappers::types::int_type row = row_indices[i];
+
+        const Epetra_CrsMatrix *row_matrix = matrix.get();
+        const int *             offsets    = index_offsets;
+        const int *             columns    = local_columns;
+        std::size_t             shift      = 0;
+        int                     local_row  = matrix->LRID(row);
+        if (local_row == -1)
+          {
+            Assert(nonlocal_matrix.get() != nullptr,
+                   ExcMessage("The positions of entries in off-processor "
+                              "rows can only be computed if these rows have "
+                              "been specified as being writable upon "
+                              "initialization."));
+            row_matrix = nonlocal_matrix.get();
+            offsets    = nonlocal_index_offsets;
+            columns    = nonlocal_columns;
+            shift      = n_local_entries;
+            local_row  = nonlocal_matrix->LRID(row);
+            Assert(local_row != -1,
+                   ExcMessage("Attempted to write into off-processor matrix "
+                              "row that has not be specified as being "
+                              "writable upon initialization"));
+          }
+
+        const int *const row_begin = columns + offsets[local_row];
+        const int *const row_end   = columns + offsets[local_row + 1];
+        for (size_type j = 0; j < n_cols; ++j)
+          {
+            const int local_col = row_matrix->LCID(
+              static_cast<TrilinosWrappers::types::int_type>(col_indices[j]));
+            const int *const position =
+              std::find(row_begin, row_end, local_col);
+            Assert(local_col != -1 && position != row_end,
+                   ExcAccessToNonPresentElement(row_indices[i],
+                                                col_indices[j]));
+            entry_positions[i * n_cols + j] = shift + (position - columns);
+          }
+      }
+  }
+
+
+
+  void
+  SparseMatrix::add_at_positions(
+    const std::vector<std::size_t> &  entry_positions,
+    const FullMatrix<TrilinosScalar> &full_matrix)
+  {
+    AssertDimension(entry_positions.size(), full_matrix.m() * full_matrix.n());
+
+    if (last_action == Insert)
+      {
+        const int ierr =
+          matrix->GlobalAssemble(*column_space_map, matrix->RowMap(), false);
+        AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+      }
+    last_action = Add;
+
+    int *           index_offsets;
+    int *           local_columns;
+    TrilinosScalar *values;
+
+    int ierr =
+      matrix->ExtractCrsDataPointers(index_offsets, local_columns, values);
+    AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+    const std::size_t n_local_entries = matrix->NumMyNonzeros();
+
+    TrilinosScalar *nonlocal_values = nullptr;
+    if (nonlocal_matrix.get() != nullptr)
+      {
+        ierr = nonlocal_matrix->ExtractCrsDataPointers(index_offsets,
+                                                       local_columns,
+                                                       nonlocal_values);
+        AssertThrow(ierr == 0, ExcTrilinosError(ierr));
+      }
+
+    const size_type n_cols = full_matrix.n();
+    for (size_type i = 0; i < full_matrix.m(); ++i)
+      for (size_type j = 0; j < n_cols; ++j)
+        {
+          const TrilinosScalar value = full_matrix(i, j);
+          AssertIsFinite(value);
+
+          const std::size_t position = entry_positions[i * n_cols + j];
+          if (position < n_local_entries)
+            values[position] += value;
+          else
+            {
+              Assert(nonlocal_values != nullptr &&
+                       position - n_local_entries <
+                         static_cast<std::size_t>(
+                           nonlocal_matrix->NumMyNonzeros()),
+                     ExcMessage("The entry positions do not match the "
+                                "storage of this matrix. Were they computed "
+                                "before the matrix was reinitialized?"));
+              nonlocal_values[position - n_local_entries] += value;
+              compressed = false;
+            }
+        }
+  }
+
+
+
   SparseMatrix &
   SparseMatrix::operator=(const double d)
   {
@@ -20,4 +20,9 @@ DEAL_II_NAMESPACE_OPEN
 
 #include "evaluation_selector.inst"
 
+// The kernels for fixed polynomial degrees selected by the CMake variables
+// DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_DEGREE and
+// DEAL_II_MATRIX_FREE_PRECOMPILED_MAX_COMPONENTS, see evaluation_selector.h
+DEAL_II_MATRIX_FREE_PRECOMPILED_ALL_KERNELS()
+
 DEAL_II_NAMESPACE_CLOSE
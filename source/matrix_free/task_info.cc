@@ -19,6 +19,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/multithread_info.h>
 #include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/matrix_free/task_info.h>
@@ -26,6 +27,7 @@
 
 #ifdef DEAL_II_WITH_THREADS
 #  include <tbb/blocked_range.h>
+#  include <tbb/flow_graph.h>
 #  include <tbb/parallel_for.h>
 #  include <tbb/task.h>
 #  include <tbb/task_scheduler_init.h>
@@ -336,6 +338,17 @@ namespace internal
     void
     TaskInfo::loop(MFWorkerInterface &funct) const
     {
+      // The operations before/after the cell loop on the entries that are
+      // exchanged with other processes must happen before the ghost exchange
+      // starts and after the compress has finished, respectively. They are
+      // collected in the range with index 'n_partitions' in DoFInfo. With
+      // threads, we do not schedule the operations within the loop but
+      // rather run them on the whole range before and after the loop.
+      const unsigned int n_partitions =
+        partition_row_index[partition_row_index.size() - 2];
+      funct.cell_loop_pre_range(
+        scheme != none ? numbers::invalid_unsigned_int : n_partitions);
+
       funct.vector_update_ghosts_start();
 
 #ifdef DEAL_II_WITH_THREADS
@@ -544,25 +557,71 @@ namespace internal
                   root->destroy(*root);
                 }
               // case when we only have one partition: this is the usual
-              // coloring scheme, and we just schedule a parallel for loop for
-              // each color
+              // coloring scheme, and we either schedule the blocks according
+              // to their dependencies or a parallel for loop for each color
               else
                 {
                   Assert(evens <= 1, ExcInternalError());
                   funct.vector_update_ghosts_finish();
 
-                  for (unsigned int color = 0; color < partition_row_index[1];
-                       ++color)
+                  // if the dependencies between the blocks of cells are
+                  // known, run each block as soon as the blocks of earlier
+                  // colors it is connected to are done, rather than waiting
+                  // for all blocks of the previous color
+                  if (!block_predecessor_row_index.empty())
                     {
-                      tbb::empty_task *root =
-                        new (tbb::task::allocate_root()) tbb::empty_task;
-                      root->set_ref_count(2);
-                      color::PartitionWork *worker =
-                        new (root->allocate_child())
-                          color::PartitionWork(funct, color, *this, false);
-                      tbb::empty_task::spawn(*worker);
-                      root->wait_for_all();
-                      root->destroy(*root);
+                      AssertThrow(face_partition_data.empty(),
+                                  ExcNotImplemented());
+
+                      using Node =
+                        tbb::flow::continue_node<tbb::flow::continue_msg>;
+                      const unsigned int n_blocks_colored =
+                        block_partition_data.size() - 1;
+                      tbb::flow::graph                   graph;
+                      std::vector<std::unique_ptr<Node>> nodes(
+                        n_blocks_colored);
+                      for (unsigned int block = 0; block < n_blocks_colored;
+                           ++block)
+                        nodes[block] = std_cxx14::make_unique<Node>(
+                          graph,
+                          [&funct, this, block](
+                            const tbb::flow::continue_msg &) {
+                            funct.cell(
+                              std::make_pair(block_partition_data[block],
+                                             block_partition_data[block + 1]));
+                            return tbb::flow::continue_msg();
+                          });
+                      for (unsigned int block = 0; block < n_blocks_colored;
+                           ++block)
+                        for (unsigned int i =
+                               block_predecessor_row_index[block];
+                             i < block_predecessor_row_index[block + 1];
+                             ++i)
+                          tbb::flow::make_edge(*nodes[block_predecessors[i]],
+                                               *nodes[block]);
+                      for (unsigned int block = 0; block < n_blocks_colored;
+                           ++block)
+                        if (block_predecessor_row_index[block] ==
+                            block_predecessor_row_index[block + 1])
+                          nodes[block]->try_put(tbb::flow::continue_msg());
+                      graph.wait_for_all();
+                    }
+                  else
+                    {
+                      for (unsigned int color = 0;
+                           color < partition_row_index[1];
+                           ++color)
+                        {
+                          tbb::empty_task *root =
+                            new (tbb::task::allocate_root()) tbb::empty_task;
+                          root->set_ref_count(2);
+                          color::PartitionWork *worker =
+                            new (root->allocate_child()) color::PartitionWork(
+                              funct, color, *this, false);
+                          tbb::empty_task::spawn(*worker);
+                          root->wait_for_all();
+                          root->destroy(*root);
+                        }
                     }
 
                   funct.vector_compress_start();
@@ -587,9 +646,11 @@ namespace internal
                   AssertIndexRange(i + 1, cell_partition_data.size());
                   if (cell_partition_data[i + 1] > cell_partition_data[i])
                     {
+                      funct.cell_loop_pre_range(i);
                       funct.zero_dst_vector_range(i);
                       funct.cell(std::make_pair(cell_partition_data[i],
                                                 cell_partition_data[i + 1]));
+                      funct.cell_loop_post_range(i);
                     }
 
                   if (face_partition_data.empty() == false)
@@ -610,6 +671,9 @@ namespace internal
             }
         }
       funct.vector_compress_finish();
+
+      funct.cell_loop_post_range(
+        scheme != none ? numbers::invalid_unsigned_int : n_partitions);
     }
 
 
@@ -643,6 +707,9 @@ namespace internal
       partition_odds.clear();
       partition_n_blocked_workers.clear();
       partition_n_workers.clear();
+      block_partition_data.clear();
+      block_predecessor_row_index.clear();
+      block_predecessors.clear();
       communicator = MPI_COMM_SELF;
       my_pid       = 0;
       n_procs      = 1;
@@ -678,7 +745,10 @@ namespace internal
         MemoryConsumption::memory_consumption(partition_evens) +
         MemoryConsumption::memory_consumption(partition_odds) +
         MemoryConsumption::memory_consumption(partition_n_blocked_workers) +
-        MemoryConsumption::memory_consumption(partition_n_workers));
+        MemoryConsumption::memory_consumption(partition_n_workers) +
+        MemoryConsumption::memory_consumption(block_partition_data) +
+        MemoryConsumption::memory_consumption(block_predecessor_row_index) +
+        MemoryConsumption::memory_consumption(block_predecessors));
     }
 
 
@@ -1354,6 +1424,18 @@ namespace internal
           if (block_size_last == 0)
             block_size_last = block_size;
 
+          // with a single partition, the loop can schedule the blocks
+          // individually according to their dependencies, for which we
+          // record the new position and color of each block
+          const bool schedule_blocks = (partition <= 1);
+          std::vector<unsigned int> new_block_index, block_color;
+          if (schedule_blocks)
+            {
+              new_block_index.resize(n_blocks);
+              block_color.resize(n_blocks);
+              block_partition_data.resize(n_blocks + 1);
+            }
+
           unsigned int tick = 0;
           for (unsigned int block = 0; block < n_blocks; block++)
             {
@@ -1370,6 +1452,13 @@ namespace internal
               if (cell_partition_data[tick] == block)
                 cell_partition_data[tick++] = counter_macro;
 
+              if (schedule_blocks)
+                {
+                  new_block_index[present_block] = block;
+                  block_color[block]             = tick - 1;
+                  block_partition_data[block]    = counter_macro;
+                }
+
               for (unsigned int j = 0; j < this_block_size; j++)
                 irregular[counter_macro++] =
                   irregular_cells[present_block * block_size + j];
@@ -1377,6 +1466,31 @@ namespace internal
           AssertDimension(tick + 1, cell_partition_data.size());
           cell_partition_data.back() = counter_macro;
 
+          if (schedule_blocks)
+            {
+              block_partition_data.back() = counter_macro;
+              block_predecessor_row_index.resize(n_blocks + 1);
+              block_predecessors.clear();
+              for (unsigned int block = 0; block < n_blocks; ++block)
+                {
+                  block_predecessor_row_index[block] =
+                    block_predecessors.size();
+                  const unsigned int old_block = partition_2layers_list[block];
+                  for (DynamicSparsityPattern::iterator
+                         neighbor = connectivity_blocks.begin(old_block),
+                         end      = connectivity_blocks.end(old_block);
+                       neighbor != end;
+                       ++neighbor)
+                    {
+                      const unsigned int neighbor_block =
+                        new_block_index[neighbor->column()];
+                      if (block_color[neighbor_block] < block_color[block])
+                        block_predecessors.push_back(neighbor_block);
+                    }
+                }
+              block_predecessor_row_index.back() = block_predecessors.size();
+            }
+
           irregular_cells.swap(irregular);
           AssertDimension(counter, n_active_cells);
           AssertDimension(counter_macro, n_macro_cells);
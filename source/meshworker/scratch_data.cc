@@ -241,6 +241,54 @@ namespace MeshWorker
 
 
 
+  template <int dim, int spacedim>
+  const FEInterfaceValues<dim, spacedim> &
+  ScratchData<dim, spacedim>::reinit(
+    const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int                                              face_no,
+    const unsigned int sub_face_no,
+    const typename DoFHandler<dim, spacedim>::active_cell_iterator
+      &                cell_neighbor,
+    const unsigned int face_no_neighbor,
+    const unsigned int sub_face_no_neighbor)
+  {
+    if (!interface_fe_values)
+      interface_fe_values =
+        std_cxx14::make_unique<FEInterfaceValues<dim, spacedim>>(
+          *mapping, *fe, face_quadrature, face_update_flags);
+
+    interface_fe_values->reinit(cell,
+                                face_no,
+                                sub_face_no,
+                                cell_neighbor,
+                                face_no_neighbor,
+                                sub_face_no_neighbor);
+    return *interface_fe_values;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const FEInterfaceValues<dim, spacedim> &
+  ScratchData<dim, spacedim>::get_current_interface_values() const
+  {
+    Assert(interface_fe_values != nullptr,
+           ExcMessage("You have to initialize the cache using the reinit "
+                      "function for interfaces first!"));
+    return *interface_fe_values;
+  }
+
+
+
+  template <int dim, int spacedim>
+  const std::vector<types::global_dof_index> &
+  ScratchData<dim, spacedim>::get_interface_dof_indices() const
+  {
+    return get_current_interface_values().get_interface_dof_indices();
+  }
+
+
+
   template <int dim, int spacedim>
   const FEValuesBase<dim, spacedim> &
   ScratchData<dim, spacedim>::get_current_fe_values() const
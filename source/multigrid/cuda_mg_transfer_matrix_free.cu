@@ -0,0 +1,828 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/cuda_size.h>
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/lac/cuda_atomic.h>
+
+#include <deal.II/multigrid/cuda_mg_transfer_matrix_free.h>
+#include <deal.II/multigrid/mg_transfer_internal.h>
+
+#ifdef DEAL_II_WITH_CUDA
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace CUDAWrappers
+{
+  namespace
+  {
+    /**
+     * Allocate device memory for the entries of @p host_data and copy them
+     * to the device.
+     */
+    template <typename T>
+    std::unique_ptr<T[], void (*)(T *)>
+    copy_to_device(const std::vector<T> &host_data)
+    {
+      std::unique_ptr<T[], void (*)(T *)> device_data(
+        Utilities::CUDA::allocate_device_data<T>(host_data.size()),
+        Utilities::CUDA::delete_device_data<T>);
+      Utilities::CUDA::copy_to_dev(host_data, device_data.get());
+      return device_data;
+    }
+
+
+
+    /**
+     * Apply the one-dimensional prolongation matrix, which has @p n_coarse
+     * rows and @p n_fine columns, or its transpose for the restriction, in
+     * direction @p direction to the tensor @p in and write the result to
+     * @p out. The directions before @p direction have already been
+     * transformed. All threads of the block work on the entries of @p out.
+     */
+    template <int dim, bool prolongate, typename Number>
+    __device__ void
+    apply_1d_matrix(const Number *     prolongation_matrix,
+                    const unsigned int direction,
+                    const unsigned int n_coarse,
+                    const unsigned int n_fine,
+                    const Number *     in,
+                    Number *           out)
+    {
+      const unsigned int n_before = prolongate ? n_fine : n_coarse;
+      const unsigned int n_after  = prolongate ? n_coarse : n_fine;
+
+      unsigned int extent_in[3]  = {1, 1, 1};
+      unsigned int extent_out[3] = {1, 1, 1};
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          extent_in[d]  = d < direction ? n_before : n_after;
+          extent_out[d] = d <= direction ? n_before : n_after;
+        }
+
+      const unsigned int stride =
+        direction == 0 ? 1 :
+                         (direction == 1 ? extent_in[0] :
+                                           extent_in[0] * extent_in[1]);
+      const unsigned int n_out = extent_out[0] * extent_out[1] * extent_out[2];
+
+      for (unsigned int index = threadIdx.x; index < n_out;
+           index += blockDim.x)
+        {
+          const unsigned int i[3] = {index % extent_out[0],
+                                     (index / extent_out[0]) % extent_out[1],
+                                     index / (extent_out[0] * extent_out[1])};
+
+          // the position in the input with index zero in the current
+          // direction
+          unsigned int shift = 0;
+          for (int d = dim - 1; d >= 0; --d)
+            shift = shift * extent_in[d] + (d == direction ? 0 : i[d]);
+
+          Number sum = 0;
+          for (unsigned int k = 0; k < extent_in[direction]; ++k)
+            sum += (prolongate ?
+                      prolongation_matrix[k * n_fine + i[direction]] :
+                      prolongation_matrix[i[direction] * n_fine + k]) *
+                   in[shift + k * stride];
+          out[index] = sum;
+        }
+    }
+
+
+
+    /**
+     * Return the index of the weight of the degree of freedom @p index on
+     * the children of a cell, with @p n_fine degrees of freedom per
+     * direction. The weights are stored for the 3<sup>dim</sup> groups of
+     * the first, the interior, and the last degrees of freedom in each
+     * direction.
+     */
+    template <int dim>
+    __device__ unsigned int
+    weight_index(const unsigned int index, const unsigned int n_fine)
+    {
+      unsigned int result = 0;
+      unsigned int factor = 1;
+      unsigned int tmp    = index;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          const unsigned int i = tmp % n_fine;
+          tmp /= n_fine;
+          result += factor * (i == 0 ? 0 : (i == n_fine - 1 ? 2 : 1));
+          factor *= 3;
+        }
+      return result;
+    }
+
+
+
+    /**
+     * Prolongate the values of @p src on the cells with children and add
+     * them to @p dst. Each block works on one cell at a time and holds two
+     * arrays of the size of the scalar degrees of freedom on all children
+     * in shared memory. The components are processed one after the other.
+     */
+    template <int dim, typename Number>
+    __global__ void
+    prolongate_kernel(const unsigned int  n_cells,
+                      const unsigned int  n_components,
+                      const unsigned int  n_coarse,
+                      const unsigned int  n_fine,
+                      const bool          element_is_continuous,
+                      const unsigned int *parent_dof_indices,
+                      const unsigned int *child_dof_indices,
+                      const Number *      weights,
+                      const Number *      prolongation_matrix,
+                      const Number *      src,
+                      Number *            dst)
+    {
+      extern __shared__ __align__(sizeof(double)) unsigned char shared_data[];
+
+      unsigned int n_scalar_coarse = 1;
+      unsigned int n_scalar_fine   = 1;
+      unsigned int n_weights       = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          n_scalar_coarse *= n_coarse;
+          n_scalar_fine *= n_fine;
+          n_weights *= 3;
+        }
+      Number *values[2] = {reinterpret_cast<Number *>(shared_data),
+                           reinterpret_cast<Number *>(shared_data) +
+                             n_scalar_fine};
+
+      for (unsigned int cell = blockIdx.x; cell < n_cells; cell += gridDim.x)
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            const unsigned int *parent_indices =
+              parent_dof_indices + (cell * n_components + c) * n_scalar_coarse;
+            for (unsigned int i = threadIdx.x; i < n_scalar_coarse;
+                 i += blockDim.x)
+              values[0][i] =
+                parent_indices[i] == numbers::invalid_unsigned_int ?
+                  Number(0) :
+                  src[parent_indices[i]];
+            __syncthreads();
+
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                apply_1d_matrix<dim, true>(prolongation_matrix,
+                                           d,
+                                           n_coarse,
+                                           n_fine,
+                                           values[d % 2],
+                                           values[(d + 1) % 2]);
+                __syncthreads();
+              }
+
+            const unsigned int *child_indices =
+              child_dof_indices + (cell * n_components + c) * n_scalar_fine;
+            for (unsigned int i = threadIdx.x; i < n_scalar_fine;
+                 i += blockDim.x)
+              {
+                Number value = values[dim % 2][i];
+                if (element_is_continuous)
+                  value *=
+                    weights[cell * n_weights + weight_index<dim>(i, n_fine)];
+                LinearAlgebra::CUDAWrappers::atomicAdd_wrapper(
+                  &dst[child_indices[i]], value);
+              }
+            __syncthreads();
+          }
+    }
+
+
+
+    /**
+     * Restrict the values of @p src on the children of the cells and add
+     * them to @p dst, with the same arrangement of the work as in
+     * prolongate_kernel().
+     */
+    template <int dim, typename Number>
+    __global__ void
+    restrict_kernel(const unsigned int  n_cells,
+                    const unsigned int  n_components,
+                    const unsigned int  n_coarse,
+                    const unsigned int  n_fine,
+                    const bool          element_is_continuous,
+                    const unsigned int *parent_dof_indices,
+                    const unsigned int *child_dof_indices,
+                    const Number *      weights,
+                    const Number *      prolongation_matrix,
+                    const Number *      src,
+                    Number *            dst)
+    {
+      extern __shared__ __align__(sizeof(double)) unsigned char shared_data[];
+
+      unsigned int n_scalar_coarse = 1;
+      unsigned int n_scalar_fine   = 1;
+      unsigned int n_weights       = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          n_scalar_coarse *= n_coarse;
+          n_scalar_fine *= n_fine;
+          n_weights *= 3;
+        }
+      Number *values[2] = {reinterpret_cast<Number *>(shared_data),
+                           reinterpret_cast<Number *>(shared_data) +
+                             n_scalar_fine};
+
+      for (unsigned int cell = blockIdx.x; cell < n_cells; cell += gridDim.x)
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            const unsigned int *child_indices =
+              child_dof_indices + (cell * n_components + c) * n_scalar_fine;
+            for (unsigned int i = threadIdx.x; i < n_scalar_fine;
+                 i += blockDim.x)
+              {
+                Number value = src[child_indices[i]];
+                if (element_is_continuous)
+                  value *=
+                    weights[cell * n_weights + weight_index<dim>(i, n_fine)];
+                values[0][i] = value;
+              }
+            __syncthreads();
+
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                apply_1d_matrix<dim, false>(prolongation_matrix,
+                                            d,
+                                            n_coarse,
+                                            n_fine,
+                                            values[d % 2],
+                                            values[(d + 1) % 2]);
+                __syncthreads();
+              }
+
+            const unsigned int *parent_indices =
+              parent_dof_indices + (cell * n_components + c) * n_scalar_coarse;
+            for (unsigned int i = threadIdx.x; i < n_scalar_coarse;
+                 i += blockDim.x)
+              if (parent_indices[i] != numbers::invalid_unsigned_int)
+                LinearAlgebra::CUDAWrappers::atomicAdd_wrapper(
+                  &dst[parent_indices[i]], values[dim % 2][i]);
+            __syncthreads();
+          }
+    }
+
+
+
+    /**
+     * Set <tt>dst[dst_indices[i]] = src[src_indices[i]]</tt>, or add the
+     * value if @p add is true, for all @p n entries of the index arrays.
+     */
+    template <typename Number>
+    __global__ void
+    copy_permuted(const unsigned int  n,
+                  const bool          add,
+                  const unsigned int *src_indices,
+                  const Number *      src,
+                  const unsigned int *dst_indices,
+                  Number *            dst)
+    {
+      const unsigned int i = threadIdx.x + blockDim.x * blockIdx.x;
+      if (i < n)
+        {
+          if (add)
+            dst[dst_indices[i]] += src[src_indices[i]];
+          else
+            dst[dst_indices[i]] = src[src_indices[i]];
+        }
+    }
+
+
+
+    /**
+     * Return the number of threads used by the transfer kernels for a
+     * scalar cell with @p n_dofs degrees of freedom on all children: The
+     * number of degrees of freedom rounded up to the next multiple of the
+     * warp size, but not more than 256.
+     */
+    unsigned int
+    transfer_block_size(const unsigned int n_dofs)
+    {
+      return std::min(256u, 32 * ((n_dofs + 31) / 32));
+    }
+  } // namespace
+
+
+
+  template <int dim, typename Number>
+  MGTransferMatrixFree<dim, Number>::MGTransferMatrixFree()
+    : fe_degree(0)
+    , element_is_continuous(false)
+    , n_components(0)
+    , n_child_cell_dofs(0)
+    , n_parent_cell_dofs(0)
+    , prolongation_matrix_1d(nullptr, Utilities::CUDA::delete_device_data)
+    , perform_plain_copy(false)
+    , perform_renumbered_plain_copy(false)
+    , copy_indices_global(nullptr, Utilities::CUDA::delete_device_data)
+    , copy_indices_level(nullptr, Utilities::CUDA::delete_device_data)
+    , n_copy_indices(0)
+  {}
+
+
+
+  template <int dim, typename Number>
+  MGTransferMatrixFree<dim, Number>::MGTransferMatrixFree(
+    const MGConstrainedDoFs &mg_constrained_dofs)
+    : MGTransferMatrixFree()
+  {
+    initialize_constraints(mg_constrained_dofs);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferMatrixFree<dim, Number>::initialize_constraints(
+    const MGConstrainedDoFs &mg_constrained_dofs)
+  {
+    host_transfer.initialize_constraints(mg_constrained_dofs);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferMatrixFree<dim, Number>::clear()
+  {
+    host_transfer.clear();
+    fe_degree             = 0;
+    element_is_continuous = false;
+    n_components          = 0;
+    n_child_cell_dofs     = 0;
+    n_parent_cell_dofs    = 0;
+    n_owned_level_cells.clear();
+    child_dof_indices.clear();
+    parent_dof_indices.clear();
+    weights.clear();
+    prolongation_matrix_1d.reset();
+    ghosted_level_vector.resize(0, 0);
+    perform_plain_copy            = false;
+    perform_renumbered_plain_copy = false;
+    copy_indices_global.reset();
+    copy_indices_level.reset();
+    n_copy_indices = 0;
+    host_level_vectors.resize(0, 0);
+    host_global_vector.reinit(0);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferMatrixFree<dim, Number>::build(const DoFHandler<dim, dim> &mg_dof)
+  {
+    host_transfer.build(mg_dof);
+
+    fe_degree             = host_transfer.fe_degree;
+    element_is_continuous = host_transfer.element_is_continuous;
+    n_components          = host_transfer.n_components;
+    n_child_cell_dofs     = host_transfer.n_child_cell_dofs;
+    n_owned_level_cells   = host_transfer.n_owned_level_cells;
+
+    const unsigned int n_coarse = fe_degree + 1;
+    const unsigned int n_fine   = 2 * n_coarse - element_is_continuous;
+    const unsigned int n_scalar_fine = Utilities::fixed_power<dim>(n_fine);
+    n_parent_cell_dofs = n_components * Utilities::fixed_power<dim>(n_coarse);
+
+    AssertThrow(2 * n_scalar_fine * sizeof(Number) <= 48 * 1024,
+                ExcMessage("The polynomial degree of the element is too high "
+                           "for the shared memory used by the transfer "
+                           "kernels."));
+
+    // the one-dimensional prolongation matrix is the same in all lanes of
+    // the vectorized array
+    {
+      std::vector<Number> matrix(host_transfer.prolongation_matrix_1d.size());
+      for (unsigned int i = 0; i < matrix.size(); ++i)
+        matrix[i] = host_transfer.prolongation_matrix_1d[i][0];
+      prolongation_matrix_1d = copy_to_device(matrix);
+    }
+
+    // the data for the transfer between the levels l and l+1 is stored in
+    // entry l
+    const unsigned int n_levels = mg_dof.get_triangulation().n_global_levels();
+    const unsigned int vec_size = VectorizedArray<Number>::n_array_elements;
+    const unsigned int n_weights_per_cell = Utilities::fixed_power<dim>(3);
+    child_dof_indices.clear();
+    parent_dof_indices.clear();
+    weights.clear();
+    for (unsigned int level = 0; level + 1 < n_levels; ++level)
+      {
+        const unsigned int n_cells = n_owned_level_cells[level];
+
+        // the degrees of freedom on the parent in lexicographic order, as
+        // read by MGTransferMatrixFree::do_prolongate_add()
+        std::vector<unsigned int> parent_indices(n_cells * n_parent_cell_dofs);
+        for (unsigned int cell = 0; cell < n_cells; ++cell)
+          {
+            const std::pair<unsigned int, unsigned int> &parent_child =
+              host_transfer.parent_child_connect[level][cell];
+            const unsigned int shift =
+              dealii::internal::MGTransfer::compute_shift_within_children<dim>(
+                parent_child.second,
+                fe_degree + 1 - element_is_continuous,
+                fe_degree);
+            const unsigned int *indices =
+              &host_transfer.level_dof_indices[level][parent_child.first *
+                                                        n_child_cell_dofs +
+                                                      shift];
+            unsigned int *cell_indices =
+              &parent_indices[cell * n_parent_cell_dofs];
+            for (unsigned int c = 0, m = 0; c < n_components; ++c)
+              for (unsigned int k = 0; k < (dim > 2 ? n_coarse : 1); ++k)
+                for (unsigned int j = 0; j < (dim > 1 ? n_coarse : 1); ++j)
+                  for (unsigned int i = 0; i < n_coarse; ++i, ++m)
+                    cell_indices[m] =
+                      indices[c * n_scalar_fine + k * n_fine * n_fine +
+                              j * n_fine + i];
+
+            for (const unsigned short i :
+                 host_transfer.dirichlet_indices[level][cell])
+              cell_indices[i] = numbers::invalid_unsigned_int;
+          }
+        parent_dof_indices.push_back(copy_to_device(parent_indices));
+
+        child_dof_indices.push_back(copy_to_device(std::vector<unsigned int>(
+          host_transfer.level_dof_indices[level + 1].begin(),
+          host_transfer.level_dof_indices[level + 1].begin() +
+            n_cells * n_child_cell_dofs)));
+
+        std::vector<Number> cell_weights;
+        if (element_is_continuous)
+          {
+            cell_weights.resize(n_cells * n_weights_per_cell);
+            for (unsigned int cell = 0; cell < n_cells; ++cell)
+              for (unsigned int i = 0; i < n_weights_per_cell; ++i)
+                cell_weights[cell * n_weights_per_cell + i] =
+                  host_transfer.weights_on_refined
+                    [level][(cell / vec_size) * n_weights_per_cell + i]
+                    [cell % vec_size];
+          }
+        weights.push_back(copy_to_device(cell_weights));
+      }
+
+    ghosted_level_vector.resize(0, n_levels - 1);
+    for (unsigned int level = 0; level < n_levels; ++level)
+      ghosted_level_vector[level].reinit(
+        host_transfer.ghosted_level_vector[level].get_partitioner());
+
+    perform_plain_copy = host_transfer.perform_plain_copy;
+    perform_renumbered_plain_copy =
+      host_transfer.perform_renumbered_plain_copy;
+    n_copy_indices = 0;
+    if (perform_renumbered_plain_copy && !perform_plain_copy)
+      {
+        const std::vector<std::pair<unsigned int, unsigned int>>
+          &copy_indices = host_transfer.copy_indices.back();
+        std::vector<unsigned int> global_indices(copy_indices.size());
+        std::vector<unsigned int> level_indices(copy_indices.size());
+        for (unsigned int i = 0; i < copy_indices.size(); ++i)
+          {
+            global_indices[i] = copy_indices[i].first;
+            level_indices[i]  = copy_indices[i].second;
+          }
+        copy_indices_global = copy_to_device(global_indices);
+        copy_indices_level  = copy_to_device(level_indices);
+        n_copy_indices      = copy_indices.size();
+      }
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferMatrixFree<dim, Number>::prolongate(const unsigned int to_level,
+                                                VectorType &       dst,
+                                                const VectorType & src) const
+  {
+    Assert((to_level >= 1) && (to_level <= child_dof_indices.size()),
+           ExcIndexRange(to_level, 1, child_dof_indices.size() + 1));
+
+    AssertDimension(ghosted_level_vector[to_level].local_size(),
+                    dst.local_size());
+    AssertDimension(ghosted_level_vector[to_level - 1].local_size(),
+                    src.local_size());
+
+    ghosted_level_vector[to_level - 1].copy_locally_owned_data_from(src);
+    ghosted_level_vector[to_level - 1].update_ghost_values();
+    ghosted_level_vector[to_level] = 0.;
+
+    const unsigned int n_cells = n_owned_level_cells[to_level - 1];
+    if (n_cells > 0)
+      {
+        const unsigned int n_coarse = fe_degree + 1;
+        const unsigned int n_fine   = 2 * n_coarse - element_is_continuous;
+        const unsigned int n_scalar_fine = Utilities::fixed_power<dim>(n_fine);
+        prolongate_kernel<dim, Number>
+          <<<std::min(n_cells, 65535u),
+             transfer_block_size(n_scalar_fine),
+             2 * n_scalar_fine * sizeof(Number)>>>(
+            n_cells,
+            n_components,
+            n_coarse,
+            n_fine,
+            element_is_continuous,
+            parent_dof_indices[to_level - 1].get(),
+            child_dof_indices[to_level - 1].get(),
+            weights[to_level - 1].get(),
+            prolongation_matrix_1d.get(),
+            ghosted_level_vector[to_level - 1].get_values(),
+            ghosted_level_vector[to_level].get_values());
+        AssertCuda(cudaGetLastError());
+      }
+
+    ghosted_level_vector[to_level].compress(VectorOperation::add);
+    dst.copy_locally_owned_data_from(ghosted_level_vector[to_level]);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferMatrixFree<dim, Number>::restrict_and_add(
+    const unsigned int from_level,
+    VectorType &       dst,
+    const VectorType & src) const
+  {
+    Assert((from_level >= 1) && (from_level <= child_dof_indices.size()),
+           ExcIndexRange(from_level, 1, child_dof_indices.size() + 1));
+
+    AssertDimension(ghosted_level_vector[from_level].local_size(),
+                    src.local_size());
+    AssertDimension(ghosted_level_vector[from_level - 1].local_size(),
+                    dst.local_size());
+
+    ghosted_level_vector[from_level].copy_locally_owned_data_from(src);
+    ghosted_level_vector[from_level].update_ghost_values();
+    ghosted_level_vector[from_level - 1] = 0.;
+
+    const unsigned int n_cells = n_owned_level_cells[from_level - 1];
+    if (n_cells > 0)
+      {
+        const unsigned int n_coarse = fe_degree + 1;
+        const unsigned int n_fine   = 2 * n_coarse - element_is_continuous;
+        const unsigned int n_scalar_fine = Utilities::fixed_power<dim>(n_fine);
+        restrict_kernel<dim, Number>
+          <<<std::min(n_cells, 65535u),
+             transfer_block_size(n_scalar_fine),
+             2 * n_scalar_fine * sizeof(Number)>>>(
+            n_cells,
+            n_components,
+            n_coarse,
+            n_fine,
+            element_is_continuous,
+            parent_dof_indices[from_level - 1].get(),
+            child_dof_indices[from_level - 1].get(),
+            weights[from_level - 1].get(),
+            prolongation_matrix_1d.get(),
+            ghosted_level_vector[from_level].get_values(),
+            ghosted_level_vector[from_level - 1].get_values());
+        AssertCuda(cudaGetLastError());
+      }
+
+    ghosted_level_vector[from_level - 1].compress(VectorOperation::add);
+    dst += ghosted_level_vector[from_level - 1];
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferMatrixFree<dim, Number>::copy_to_mg(
+    const DoFHandler<dim, dim> &mg_dof,
+    MGLevelObject<VectorType> & dst,
+    const VectorType &          src) const
+  {
+    AssertIndexRange(dst.max_level(),
+                     mg_dof.get_triangulation().n_global_levels());
+    AssertIndexRange(dst.min_level(), dst.max_level() + 1);
+
+    if (perform_plain_copy == false && perform_renumbered_plain_copy == false)
+      {
+        // locally refined meshes: go through the transfer on the host with
+        // vectors of the same layout as the device vectors
+        for (unsigned int level = dst.min_level(); level <= dst.max_level();
+             ++level)
+          if (dst[level].size() != mg_dof.n_dofs(level) ||
+              dst[level].local_size() !=
+                mg_dof.locally_owned_mg_dofs(level).n_elements())
+            dst[level].reinit(ghosted_level_vector[level], false);
+
+        host_level_vectors.resize(dst.min_level(), dst.max_level());
+        for (unsigned int level = dst.min_level(); level <= dst.max_level();
+             ++level)
+          host_level_vectors[level].reinit(dst[level].get_partitioner());
+        host_global_vector.reinit(src.get_partitioner());
+        host_global_vector.import(src, VectorOperation::insert);
+
+        host_transfer.copy_to_mg(mg_dof,
+                                 host_level_vectors,
+                                 host_global_vector);
+
+        for (unsigned int level = dst.min_level(); level <= dst.max_level();
+             ++level)
+          dst[level].import(host_level_vectors[level], VectorOperation::insert);
+        return;
+      }
+
+    for (unsigned int level = dst.min_level(); level <= dst.max_level();
+         ++level)
+      if (dst[level].size() != mg_dof.n_dofs(level) ||
+          dst[level].local_size() !=
+            mg_dof.locally_owned_mg_dofs(level).n_elements())
+        dst[level].reinit(ghosted_level_vector[level], false);
+      else if (level != dst.max_level())
+        dst[level] = 0;
+
+    VectorType &dst_level = dst[dst.max_level()];
+    AssertDimension(dst_level.local_size(), src.local_size());
+    if (perform_plain_copy)
+      dst_level.copy_locally_owned_data_from(src);
+    else if (n_copy_indices > 0)
+      {
+        const unsigned int n_blocks =
+          (n_copy_indices + ::dealii::CUDAWrappers::block_size - 1) /
+          ::dealii::CUDAWrappers::block_size;
+        copy_permuted<Number>
+          <<<n_blocks, ::dealii::CUDAWrappers::block_size>>>(
+            n_copy_indices,
+            false,
+            copy_indices_global.get(),
+            src.get_values(),
+            copy_indices_level.get(),
+            dst_level.get_values());
+        AssertCuda(cudaGetLastError());
+      }
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferMatrixFree<dim, Number>::copy_from_mg(
+    const DoFHandler<dim, dim> &     mg_dof,
+    VectorType &                     dst,
+    const MGLevelObject<VectorType> &src) const
+  {
+    AssertIndexRange(src.max_level(),
+                     mg_dof.get_triangulation().n_global_levels());
+    AssertIndexRange(src.min_level(), src.max_level() + 1);
+
+    if (perform_plain_copy == false && perform_renumbered_plain_copy == false)
+      {
+        host_level_vectors.resize(src.min_level(), src.max_level());
+        for (unsigned int level = src.min_level(); level <= src.max_level();
+             ++level)
+          {
+            host_level_vectors[level].reinit(src[level].get_partitioner());
+            host_level_vectors[level].import(src[level],
+                                             VectorOperation::insert);
+          }
+        host_global_vector.reinit(dst.get_partitioner());
+
+        host_transfer.copy_from_mg(mg_dof,
+                                   host_global_vector,
+                                   host_level_vectors);
+
+        dst.import(host_global_vector, VectorOperation::insert);
+        return;
+      }
+
+    const VectorType &src_level = src[src.max_level()];
+    AssertDimension(src_level.local_size(), dst.local_size());
+    dst.zero_out_ghosts();
+    if (perform_plain_copy)
+      dst.copy_locally_owned_data_from(src_level);
+    else if (n_copy_indices > 0)
+      {
+        const unsigned int n_blocks =
+          (n_copy_indices + ::dealii::CUDAWrappers::block_size - 1) /
+          ::dealii::CUDAWrappers::block_size;
+        copy_permuted<Number>
+          <<<n_blocks, ::dealii::CUDAWrappers::block_size>>>(
+            n_copy_indices,
+            false,
+            copy_indices_level.get(),
+            src_level.get_values(),
+            copy_indices_global.get(),
+            dst.get_values());
+        AssertCuda(cudaGetLastError());
+      }
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferMatrixFree<dim, Number>::copy_from_mg_add(
+    const DoFHandler<dim, dim> &     mg_dof,
+    VectorType &                     dst,
+    const MGLevelObject<VectorType> &src) const
+  {
+    AssertIndexRange(src.max_level(),
+                     mg_dof.get_triangulation().n_global_levels());
+    AssertIndexRange(src.min_level(), src.max_level() + 1);
+
+    if (perform_plain_copy == false && perform_renumbered_plain_copy == false)
+      {
+        host_level_vectors.resize(src.min_level(), src.max_level());
+        for (unsigned int level = src.min_level(); level <= src.max_level();
+             ++level)
+          {
+            host_level_vectors[level].reinit(src[level].get_partitioner());
+            host_level_vectors[level].import(src[level],
+                                             VectorOperation::insert);
+          }
+        host_global_vector.reinit(dst.get_partitioner());
+        host_global_vector.import(dst, VectorOperation::insert);
+
+        host_transfer.copy_from_mg_add(mg_dof,
+                                       host_global_vector,
+                                       host_level_vectors);
+
+        dst.import(host_global_vector, VectorOperation::insert);
+        return;
+      }
+
+    const VectorType &src_level = src[src.max_level()];
+    AssertDimension(src_level.local_size(), dst.local_size());
+    if (perform_plain_copy)
+      {
+        // the level vector may have a different set of ghost entries, so
+        // only the locally owned range can be added
+        VectorType tmp;
+        tmp.reinit(dst, true);
+        tmp.copy_locally_owned_data_from(src_level);
+        dst += tmp;
+      }
+    else if (n_copy_indices > 0)
+      {
+        const unsigned int n_blocks =
+          (n_copy_indices + ::dealii::CUDAWrappers::block_size - 1) /
+          ::dealii::CUDAWrappers::block_size;
+        copy_permuted<Number>
+          <<<n_blocks, ::dealii::CUDAWrappers::block_size>>>(
+            n_copy_indices,
+            true,
+            copy_indices_level.get(),
+            src_level.get_values(),
+            copy_indices_global.get(),
+            dst.get_values());
+        AssertCuda(cudaGetLastError());
+      }
+  }
+
+
+
+  template <int dim, typename Number>
+  std::size_t
+  MGTransferMatrixFree<dim, Number>::memory_consumption() const
+  {
+    std::size_t memory = host_transfer.memory_consumption();
+    memory += MemoryConsumption::memory_consumption(n_owned_level_cells);
+    for (unsigned int level = 0; level < child_dof_indices.size(); ++level)
+      {
+        const unsigned int n_cells = n_owned_level_cells[level];
+        memory += n_cells * (n_child_cell_dofs + n_parent_cell_dofs) *
+                  sizeof(unsigned int);
+        if (element_is_continuous)
+          memory += n_cells * Utilities::fixed_power<dim>(3) * sizeof(Number);
+      }
+    memory += host_transfer.prolongation_matrix_1d.size() * sizeof(Number);
+    memory += 2 * n_copy_indices * sizeof(unsigned int);
+    for (unsigned int level = ghosted_level_vector.min_level();
+         level <= ghosted_level_vector.max_level();
+         ++level)
+      memory += ghosted_level_vector[level].memory_consumption();
+    return memory;
+  }
+
+
+
+  template class MGTransferMatrixFree<2, float>;
+  template class MGTransferMatrixFree<2, double>;
+  template class MGTransferMatrixFree<3, float>;
+  template class MGTransferMatrixFree<3, double>;
+} // namespace CUDAWrappers
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
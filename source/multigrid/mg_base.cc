@@ -41,6 +41,26 @@ MGSmootherBase<VectorType>::apply(const unsigned int level,
 }
 
 
+
+template <typename VectorType>
+void
+MGTransferBase<VectorType>::restrict_and_add_start(
+  const unsigned int from_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  restrict_and_add(from_level, dst, src);
+}
+
+
+
+template <typename VectorType>
+void
+MGTransferBase<VectorType>::restrict_and_add_finish(const unsigned int,
+                                                    VectorType &) const
+{}
+
+
 // Explicit instantiations
 
 #include "mg_base.inst"
@@ -0,0 +1,913 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <deal.II/matrix_free/evaluation_kernels.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+#include <deal.II/multigrid/mg_transfer_internal.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace MGTwoLevelTransferImplementation
+  {
+    // Compute an integer identifying the given cell in all triangulations
+    // derived from the same coarse mesh. The integer consists of the index
+    // of the coarse cell and one digit per level in a number system with base
+    // 2^dim+1, where the digit zero is used for the levels below the cell
+    // such that a cell and its first child get different numbers.
+    template <int dim, typename CellIteratorType>
+    std::uint64_t
+    cell_key(const CellIteratorType &cell, const unsigned int n_levels)
+    {
+      constexpr std::uint64_t base =
+        GeometryInfo<dim>::max_children_per_cell + 1;
+
+      // the ancestors are in general not active, so walk up the tree with
+      // a non-active iterator
+      using IteratorType =
+        TriaIterator<typename CellIteratorType::AccessorType>;
+
+      std::vector<unsigned int> child_indices;
+      IteratorType              ancestor = cell;
+      while (ancestor->level() > 0)
+        {
+          const IteratorType parent = ancestor->parent();
+          unsigned int       c      = 0;
+          while (parent->child(c) != ancestor)
+            ++c;
+          child_indices.push_back(c);
+          ancestor = parent;
+        }
+
+      std::uint64_t key = ancestor->index();
+      for (auto c = child_indices.rbegin(); c != child_indices.rend(); ++c)
+        key = key * base + *c + 1;
+      for (int level = cell->level(); level < static_cast<int>(n_levels) - 1;
+           ++level)
+        key *= base;
+      return key;
+    }
+
+
+
+    // Exchange the given data between the processes and clear the send
+    // buffers. Data sent to the own process is passed on directly.
+    std::map<unsigned int, std::vector<std::uint64_t>>
+    exchange_data(
+      const MPI_Comm &                                    comm,
+      std::map<unsigned int, std::vector<std::uint64_t>> &send_data)
+    {
+      const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+      std::map<unsigned int, std::vector<std::uint64_t>> received_data;
+      const auto own_data = send_data.find(my_rank);
+      if (own_data != send_data.end())
+        {
+          received_data[my_rank].swap(own_data->second);
+          send_data.erase(own_data);
+        }
+      if (Utilities::MPI::n_mpi_processes(comm) > 1)
+        {
+          const auto other_data = Utilities::MPI::some_to_some(comm, send_data);
+          received_data.insert(other_data.begin(), other_data.end());
+        }
+      else
+        Assert(send_data.empty(), ExcInternalError());
+      send_data.clear();
+      return received_data;
+    }
+
+
+
+    // Create a one-dimensional version of the base element of the given
+    // finite element
+    template <int dim>
+    std::unique_ptr<FiniteElement<1>>
+    get_fe_1d(const FiniteElement<dim> &fe)
+    {
+      AssertThrow(fe.n_base_elements() == 1,
+                  ExcMessage("Only finite elements with a single base element "
+                             "are supported"));
+      std::string fe_name = fe.base_element(0).get_name();
+      {
+        const std::size_t template_starts = fe_name.find_first_of('<');
+        Assert(fe_name[template_starts + 1] ==
+                 (dim == 1 ? '1' : (dim == 2 ? '2' : '3')),
+               ExcInternalError());
+        fe_name[template_starts + 1] = '1';
+      }
+      std::unique_ptr<FiniteElement<1>> fe_1d =
+        FETools::get_fe_by_name<1, 1>(fe_name);
+      AssertThrow(fe_1d->dofs_per_vertex < 2 &&
+                    Utilities::fixed_power<dim>(fe_1d->dofs_per_cell) *
+                        fe.element_multiplicity(0) ==
+                      fe.dofs_per_cell,
+                  ExcNotImplemented());
+      return fe_1d;
+    }
+
+
+
+    // Get the renumbering of the one-dimensional basis functions to
+    // lexicographic numbers, supporting both continuous and discontinuous
+    // bases
+    std::vector<unsigned int>
+    get_renumbering_1d(const FiniteElement<1> &fe)
+    {
+      std::vector<unsigned int> renumbering(fe.dofs_per_cell);
+      renumbering[0] = 0;
+      for (unsigned int i = 0; i < fe.dofs_per_line; ++i)
+        renumbering[i + fe.dofs_per_vertex] =
+          GeometryInfo<1>::vertices_per_cell * fe.dofs_per_vertex + i;
+      if (fe.dofs_per_vertex > 0)
+        renumbering[fe.dofs_per_cell - fe.dofs_per_vertex] =
+          fe.dofs_per_vertex;
+      return renumbering;
+    }
+
+
+
+    // Get the lexicographic numbering of the degrees of freedom of the given
+    // finite element, including all its components
+    template <int dim, typename Number>
+    std::vector<unsigned int>
+    get_lexicographic_numbering(const FiniteElement<dim> &fe)
+    {
+      const Quadrature<1> dummy_quadrature(
+        std::vector<Point<1>>(1, Point<1>()));
+      internal::MatrixFreeFunctions::ShapeInfo<Number> shape_info;
+      shape_info.reinit(dummy_quadrature, fe, 0);
+      return shape_info.lexicographic_numbering;
+    }
+  } // namespace MGTwoLevelTransferImplementation
+} // namespace internal
+
+
+
+template <int dim, typename Number>
+MGTwoLevelTransfer<dim, Number>::MGTwoLevelTransfer()
+  : n_components(0)
+{
+  for (auto &transfer : transfers)
+    {
+      transfer.n_cells          = 0;
+      transfer.n_dofs_1d_coarse = 0;
+      transfer.n_dofs_1d_fine   = 0;
+    }
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::reinit(
+  const DoFHandler<dim> &          dof_handler_fine,
+  const DoFHandler<dim> &          dof_handler_coarse,
+  const AffineConstraints<Number> &constraint_fine,
+  const AffineConstraints<Number> &constraint_coarse)
+{
+  using namespace internal::MGTwoLevelTransferImplementation;
+
+  const Triangulation<dim> &tria_fine = dof_handler_fine.get_triangulation();
+  const Triangulation<dim> &tria_coarse =
+    dof_handler_coarse.get_triangulation();
+  AssertThrow(tria_fine.n_cells(0) == tria_coarse.n_cells(0),
+              ExcMessage("The two triangulations must be derived from the "
+                         "same coarse mesh."));
+
+  MPI_Comm comm = MPI_COMM_SELF;
+  if (const auto tria = dynamic_cast<const parallel::TriangulationBase<dim> *>(
+        &tria_fine))
+    comm = tria->get_communicator();
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+  // ---------------- 1. Extract information about the finite elements
+  const FiniteElement<dim> &fe_fine   = dof_handler_fine.get_fe();
+  const FiniteElement<dim> &fe_coarse = dof_handler_coarse.get_fe();
+  const std::unique_ptr<FiniteElement<1>> fe_1d_fine   = get_fe_1d(fe_fine);
+  const std::unique_ptr<FiniteElement<1>> fe_1d_coarse = get_fe_1d(fe_coarse);
+  n_components = fe_fine.element_multiplicity(0);
+  AssertThrow(fe_coarse.element_multiplicity(0) == n_components,
+              ExcMessage("The finite elements must have the same number of "
+                         "components."));
+  const bool element_is_continuous = fe_1d_fine->dofs_per_vertex > 0;
+  AssertThrow(element_is_continuous == (fe_1d_coarse->dofs_per_vertex > 0),
+              ExcMessage("Both finite elements must be either continuous or "
+                         "discontinuous."));
+
+  const std::vector<unsigned int> lexicographic_fine =
+    get_lexicographic_numbering<dim, Number>(fe_fine);
+  const std::vector<unsigned int> lexicographic_coarse =
+    get_lexicographic_numbering<dim, Number>(fe_coarse);
+  const unsigned int degree_fine    = fe_1d_fine->degree;
+  const unsigned int degree_coarse  = fe_1d_coarse->degree;
+  const unsigned int fe_shift_1d    = degree_fine + 1 - element_is_continuous;
+  const unsigned int n_children     = GeometryInfo<dim>::max_children_per_cell;
+  const unsigned int n_dofs_fine    = fe_fine.dofs_per_cell;
+  const unsigned int n_dofs_coarse  = fe_coarse.dofs_per_cell;
+
+  // index 0 describes the refined cells, index 1 the cells present in both
+  // triangulations
+  transfers[0].n_dofs_1d_coarse = degree_fine + 1;
+  transfers[0].n_dofs_1d_fine   = degree_fine + 1 + fe_shift_1d;
+  transfers[1].n_dofs_1d_coarse = degree_coarse + 1;
+  transfers[1].n_dofs_1d_fine   = degree_fine + 1;
+
+  // ---------------- 2. Find the fine degrees of freedom of the coarse cells
+  // The degrees of freedom of the locally owned fine cells are sent to a
+  // process determined by the key of the cell and the key of its parent,
+  // from where the owners of the coarse cells collect them.
+  const unsigned int n_levels =
+    std::max(tria_fine.n_global_levels(), tria_coarse.n_global_levels());
+  std::uint64_t n_keys = tria_fine.n_cells(0);
+  for (unsigned int level = 1; level < n_levels; ++level)
+    {
+      AssertThrow(n_keys < std::numeric_limits<std::uint64_t>::max() /
+                             (n_children + 1),
+                  ExcMessage("Too many levels in the triangulation."));
+      n_keys *= n_children + 1;
+    }
+  const std::uint64_t keys_per_process = n_keys / n_procs + 1;
+
+  std::map<unsigned int, std::vector<std::uint64_t>> send_data;
+  {
+    std::vector<types::global_dof_index> dof_indices(n_dofs_fine);
+    for (const auto &cell : dof_handler_fine.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          cell->get_dof_indices(dof_indices);
+          const std::uint64_t key = cell_key<dim>(cell, n_levels);
+          std::vector<std::uint64_t> &data = send_data[key / keys_per_process];
+          data.push_back(key);
+          data.push_back(0);
+          data.insert(data.end(), dof_indices.begin(), dof_indices.end());
+          if (cell->level() > 0)
+            {
+              const auto         parent = cell->parent();
+              const std::uint64_t parent_key =
+                cell_key<dim>(parent, n_levels);
+              unsigned int c = 0;
+              while (parent->child(c) != cell)
+                ++c;
+              std::vector<std::uint64_t> &parent_data =
+                send_data[parent_key / keys_per_process];
+              parent_data.push_back(parent_key);
+              parent_data.push_back(c + 1);
+              parent_data.insert(parent_data.end(),
+                                 dof_indices.begin(),
+                                 dof_indices.end());
+            }
+        }
+  }
+
+  // collect the data for the keys this process is responsible for: either
+  // the degrees of freedom of the fine cell with that key, or of all the
+  // children of the cell with that key
+  std::map<std::uint64_t, std::pair<unsigned int, std::vector<std::uint64_t>>>
+    fine_cells;
+  for (const auto &data : exchange_data(comm, send_data))
+    {
+      const std::vector<std::uint64_t> &buffer = data.second;
+      for (std::size_t pos = 0; pos < buffer.size(); pos += 2 + n_dofs_fine)
+        {
+          auto &entry = fine_cells[buffer[pos]];
+          if (buffer[pos + 1] == 0)
+            {
+              entry.first = n_children + 1;
+              entry.second.assign(buffer.begin() + pos + 2,
+                                  buffer.begin() + pos + 2 + n_dofs_fine);
+            }
+          else if (entry.first <= n_children)
+            {
+              entry.second.resize(n_children * n_dofs_fine);
+              std::copy(buffer.begin() + pos + 2,
+                        buffer.begin() + pos + 2 + n_dofs_fine,
+                        entry.second.begin() +
+                          (buffer[pos + 1] - 1) * n_dofs_fine);
+              ++entry.first;
+            }
+        }
+    }
+
+  // ask for the fine degrees of freedom of the locally owned coarse cells
+  std::vector<typename DoFHandler<dim>::active_cell_iterator> coarse_cells;
+  std::map<unsigned int, std::vector<unsigned int>> coarse_cells_of_process;
+  for (const auto &cell : dof_handler_coarse.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const std::uint64_t key = cell_key<dim>(cell, n_levels);
+        send_data[key / keys_per_process].push_back(key);
+        coarse_cells_of_process[key / keys_per_process].push_back(
+          coarse_cells.size());
+        coarse_cells.push_back(cell);
+      }
+
+  for (const auto &data : exchange_data(comm, send_data))
+    {
+      std::vector<std::uint64_t> &answer = send_data[data.first];
+      for (const std::uint64_t key : data.second)
+        {
+          const auto entry = fine_cells.find(key);
+          AssertThrow(entry != fine_cells.end() &&
+                        (entry->second.first == n_children ||
+                         entry->second.first == n_children + 1),
+                      ExcMessage("The cells of the coarse triangulation must "
+                                 "either be present in the fine triangulation "
+                                 "or be refined exactly once."));
+          answer.push_back(entry->second.first == n_children ? 0 : 1);
+          answer.insert(answer.end(),
+                        entry->second.second.begin(),
+                        entry->second.second.end());
+        }
+    }
+  fine_cells.clear();
+
+  // ---------------- 3. Arrange the indices lexicographically
+  std::vector<types::global_dof_index> dof_indices_fine[2];
+  std::vector<types::global_dof_index> dof_indices_coarse[2];
+  const unsigned int n_patch_dofs[2] = {
+    n_components *
+      Utilities::fixed_power<dim>(transfers[0].n_dofs_1d_fine),
+    n_dofs_fine};
+  {
+    std::vector<types::global_dof_index> local_dof_indices(n_dofs_coarse);
+    for (const auto &data : exchange_data(comm, send_data))
+      {
+        const std::vector<unsigned int> &cells =
+          coarse_cells_of_process[data.first];
+        std::size_t pos = 0;
+        for (const unsigned int index : cells)
+          {
+            AssertIndexRange(pos, data.second.size());
+            const unsigned int type = data.second[pos++];
+            const std::uint64_t *fine_indices = data.second.data() + pos;
+
+            if (type == 0)
+              {
+                AssertThrow(fe_fine.get_name() == fe_coarse.get_name(),
+                            ExcMessage("The transfer on refined cells "
+                                       "requires the same finite element on "
+                                       "both triangulations."));
+                const unsigned int n_child_dofs_1d =
+                  transfers[0].n_dofs_1d_fine;
+                const unsigned int n_scalar_dofs =
+                  Utilities::fixed_power<dim>(n_child_dofs_1d);
+                const std::size_t start = dof_indices_fine[0].size();
+                dof_indices_fine[0].resize(start + n_patch_dofs[0],
+                                           numbers::invalid_dof_index);
+                for (unsigned int child = 0; child < n_children; ++child)
+                  {
+                    types::global_dof_index *indices =
+                      &dof_indices_fine[0][start] +
+                      internal::MGTransfer::compute_shift_within_children<dim>(
+                        child, fe_shift_1d, degree_fine);
+                    const std::uint64_t *child_indices =
+                      fine_indices + child * n_dofs_fine;
+                    for (unsigned int c = 0, m = 0; c < n_components; ++c)
+                      for (unsigned int k = 0;
+                           k < (dim > 2 ? (degree_fine + 1) : 1);
+                           ++k)
+                        for (unsigned int j = 0;
+                             j < (dim > 1 ? (degree_fine + 1) : 1);
+                             ++j)
+                          for (unsigned int i = 0; i < degree_fine + 1;
+                               ++i, ++m)
+                            indices[c * n_scalar_dofs +
+                                    k * n_child_dofs_1d * n_child_dofs_1d +
+                                    j * n_child_dofs_1d + i] =
+                              child_indices[lexicographic_fine[m]];
+                  }
+                pos += n_children * n_dofs_fine;
+              }
+            else
+              {
+                for (unsigned int i = 0; i < n_dofs_fine; ++i)
+                  dof_indices_fine[1].push_back(
+                    fine_indices[lexicographic_fine[i]]);
+                pos += n_dofs_fine;
+              }
+
+            coarse_cells[index]->get_dof_indices(local_dof_indices);
+            for (unsigned int i = 0; i < n_dofs_coarse; ++i)
+              dof_indices_coarse[type].push_back(
+                local_dof_indices[lexicographic_coarse[i]]);
+          }
+        AssertDimension(pos, data.second.size());
+      }
+  }
+
+  // ---------------- 4. Set up the vectors and translate the indices
+  {
+    std::vector<types::global_dof_index> ghosts(dof_indices_fine[0]);
+    ghosts.insert(ghosts.end(),
+                  dof_indices_fine[1].begin(),
+                  dof_indices_fine[1].end());
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+    IndexSet ghost_set(dof_handler_fine.n_dofs());
+    ghost_set.add_indices(ghosts.begin(), ghosts.end());
+    ghost_set.subtract_set(dof_handler_fine.locally_owned_dofs());
+    vec_fine.reinit(dof_handler_fine.locally_owned_dofs(), ghost_set, comm);
+    partitioner_fine = std::make_shared<Utilities::MPI::Partitioner>(
+      dof_handler_fine.locally_owned_dofs(), comm);
+  }
+  {
+    std::vector<types::global_dof_index> ghosts(dof_indices_coarse[0]);
+    ghosts.insert(ghosts.end(),
+                  dof_indices_coarse[1].begin(),
+                  dof_indices_coarse[1].end());
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+    const std::size_t n_cell_indices = ghosts.size();
+    for (std::size_t i = 0; i < n_cell_indices; ++i)
+      if (constraint_coarse.is_constrained(ghosts[i]))
+        for (const auto &entry :
+             *constraint_coarse.get_constraint_entries(ghosts[i]))
+          ghosts.push_back(entry.first);
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+    IndexSet ghost_set(dof_handler_coarse.n_dofs());
+    ghost_set.add_indices(ghosts.begin(), ghosts.end());
+    ghost_set.subtract_set(dof_handler_coarse.locally_owned_dofs());
+    vec_coarse.reinit(dof_handler_coarse.locally_owned_dofs(), ghost_set, comm);
+    partitioner_coarse = std::make_shared<Utilities::MPI::Partitioner>(
+      dof_handler_coarse.locally_owned_dofs(), comm);
+  }
+
+  const Utilities::MPI::Partitioner &part_fine = *vec_fine.get_partitioner();
+  const Utilities::MPI::Partitioner &part_coarse =
+    *vec_coarse.get_partitioner();
+  for (unsigned int t = 0; t < 2; ++t)
+    {
+      AssertDimension(dof_indices_fine[t].size() % n_patch_dofs[t], 0);
+      transfers[t].n_cells = dof_indices_fine[t].size() / n_patch_dofs[t];
+      AssertDimension(dof_indices_coarse[t].size(),
+                      transfers[t].n_cells * n_components *
+                        Utilities::fixed_power<dim>(
+                          transfers[t].n_dofs_1d_coarse));
+      transfers[t].dof_indices_fine.resize(dof_indices_fine[t].size());
+      for (std::size_t i = 0; i < dof_indices_fine[t].size(); ++i)
+        transfers[t].dof_indices_fine[i] =
+          part_fine.global_to_local(dof_indices_fine[t][i]);
+      transfers[t].dof_indices_coarse.resize(dof_indices_coarse[t].size());
+      for (std::size_t i = 0; i < dof_indices_coarse[t].size(); ++i)
+        transfers[t].dof_indices_coarse[i] =
+          part_coarse.global_to_local(dof_indices_coarse[t][i]);
+    }
+
+  // ---------------- 5. Compute the one-dimensional matrices
+  {
+    const std::vector<unsigned int> renumbering_fine =
+      get_renumbering_1d(*fe_1d_fine);
+    const std::vector<unsigned int> renumbering_coarse =
+      get_renumbering_1d(*fe_1d_coarse);
+
+    // embedding from the coarse cell into both children
+    CellTransfer &     refined   = transfers[0];
+    const unsigned int n_child_1d = refined.n_dofs_1d_fine;
+    refined.prolongation_matrix_1d.resize(refined.n_dofs_1d_coarse *
+                                          n_child_1d);
+    for (unsigned int c = 0; c < GeometryInfo<1>::max_children_per_cell; ++c)
+      for (unsigned int i = 0; i < refined.n_dofs_1d_coarse; ++i)
+        for (unsigned int j = 0; j < refined.n_dofs_1d_coarse; ++j)
+          refined
+            .prolongation_matrix_1d[i * n_child_1d + j + c * fe_shift_1d] =
+            fe_1d_fine->get_prolongation_matrix(c)(renumbering_fine[j],
+                                                   renumbering_fine[i]);
+
+    // interpolation between the two elements on the same cell
+    CellTransfer &same = transfers[1];
+    if (same.n_cells > 0)
+      {
+        AssertThrow(degree_coarse <= degree_fine,
+                    ExcMessage("The degree of the coarse element must not "
+                               "exceed the degree of the fine element."));
+        FullMatrix<double> interpolation_matrix(same.n_dofs_1d_fine,
+                                                same.n_dofs_1d_coarse);
+        fe_1d_fine->get_interpolation_matrix(*fe_1d_coarse,
+                                             interpolation_matrix);
+        same.prolongation_matrix_1d.resize(same.n_dofs_1d_coarse *
+                                           same.n_dofs_1d_fine);
+        for (unsigned int i = 0; i < same.n_dofs_1d_coarse; ++i)
+          for (unsigned int j = 0; j < same.n_dofs_1d_fine; ++j)
+            same.prolongation_matrix_1d[i * same.n_dofs_1d_fine + j] =
+              interpolation_matrix(renumbering_fine[j],
+                                   renumbering_coarse[i]);
+      }
+  }
+
+  unsigned int n_max_dofs = 0;
+  for (const auto &transfer : transfers)
+    n_max_dofs =
+      std::max(n_max_dofs,
+               n_components *
+                 Utilities::fixed_power<dim>(transfer.n_dofs_1d_fine));
+  evaluation_data.resize(n_max_dofs);
+
+  // ---------------- 6. Set up the constraints
+  constrained_indices_fine.clear();
+  for (unsigned int i = 0; i < part_fine.local_size(); ++i)
+    if (constraint_fine.is_constrained(part_fine.local_to_global(i)))
+      constrained_indices_fine.push_back(i);
+
+  constraint_index_coarse.clear();
+  constraint_start_coarse.clear();
+  constraint_entries_coarse.clear();
+  const unsigned int n_coarse_entries =
+    part_coarse.local_size() + part_coarse.n_ghost_indices();
+  for (unsigned int i = 0; i < n_coarse_entries; ++i)
+    {
+      const types::global_dof_index index = part_coarse.local_to_global(i);
+      if (constraint_coarse.is_constrained(index))
+        {
+          if (constraint_index_coarse.empty())
+            constraint_index_coarse.resize(n_coarse_entries,
+                                           numbers::invalid_unsigned_int);
+          constraint_index_coarse[i] = constraint_start_coarse.size();
+          constraint_start_coarse.push_back(constraint_entries_coarse.size());
+          for (const auto &entry :
+               *constraint_coarse.get_constraint_entries(index))
+            constraint_entries_coarse.emplace_back(
+              part_coarse.global_to_local(entry.first), entry.second);
+        }
+    }
+  constraint_start_coarse.push_back(constraint_entries_coarse.size());
+
+  // ---------------- 7. Compute the weights for continuous elements: a fine
+  // degree of freedom gets contributions from all coarse cells it is part of
+  weights_fine.clear();
+  if (element_is_continuous)
+    {
+      vec_fine = 0.;
+      for (const auto &transfer : transfers)
+        for (const unsigned int index : transfer.dof_indices_fine)
+          vec_fine.local_element(index) += Number(1.);
+      vec_fine.compress(VectorOperation::add);
+      for (unsigned int i = 0; i < vec_fine.local_size(); ++i)
+        if (vec_fine.local_element(i) > Number(0.))
+          vec_fine.local_element(i) = Number(1.) / vec_fine.local_element(i);
+      vec_fine.update_ghost_values();
+      weights_fine.resize(part_fine.local_size() +
+                          part_fine.n_ghost_indices());
+      for (unsigned int i = 0; i < weights_fine.size(); ++i)
+        weights_fine[i] = vec_fine.local_element(i);
+      vec_fine = 0.;
+    }
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::prolongate(VectorType &      dst,
+                                            const VectorType &src) const
+{
+  vec_coarse.copy_locally_owned_data_from(src);
+  vec_coarse.update_ghost_values();
+  vec_fine = 0.;
+
+  for (const auto &transfer : transfers)
+    if (transfer.n_cells > 0)
+      do_prolongate_add(transfer);
+
+  vec_fine.compress(VectorOperation::add);
+  vec_coarse.zero_out_ghosts();
+
+  dst.copy_locally_owned_data_from(vec_fine);
+  for (const unsigned int index : constrained_indices_fine)
+    dst.local_element(index) = 0.;
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::restrict_and_add(VectorType &      dst,
+                                                  const VectorType &src) const
+{
+  vec_fine.copy_locally_owned_data_from(src);
+  for (const unsigned int index : constrained_indices_fine)
+    vec_fine.local_element(index) = 0.;
+  vec_fine.update_ghost_values();
+  vec_coarse = 0.;
+
+  for (const auto &transfer : transfers)
+    if (transfer.n_cells > 0)
+      do_restrict_add(transfer);
+
+  vec_coarse.compress(VectorOperation::add);
+  vec_fine.zero_out_ghosts();
+
+  AssertDimension(dst.local_size(), vec_coarse.local_size());
+  for (unsigned int i = 0; i < vec_coarse.local_size(); ++i)
+    dst.local_element(i) += vec_coarse.local_element(i);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::do_prolongate_add(
+  const CellTransfer &transfer) const
+{
+  const unsigned int vec_size = VectorizedArray<Number>::n_array_elements;
+  const unsigned int n_scalar_dofs_coarse =
+    Utilities::fixed_power<dim>(transfer.n_dofs_1d_coarse);
+  const unsigned int n_scalar_dofs_fine =
+    Utilities::fixed_power<dim>(transfer.n_dofs_1d_fine);
+  const unsigned int n_dofs_coarse = n_components * n_scalar_dofs_coarse;
+  const unsigned int n_dofs_fine   = n_components * n_scalar_dofs_fine;
+
+  for (unsigned int cell = 0; cell < transfer.n_cells; cell += vec_size)
+    {
+      const unsigned int n_lanes =
+        std::min(vec_size, transfer.n_cells - cell);
+
+      // read from the coarse vector, resolving the constraints
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int *indices =
+            &transfer.dof_indices_coarse[(cell + v) * n_dofs_coarse];
+          for (unsigned int i = 0; i < n_dofs_coarse; ++i)
+            {
+              const unsigned int row = constraint_index_coarse.empty() ?
+                                         numbers::invalid_unsigned_int :
+                                         constraint_index_coarse[indices[i]];
+              if (row == numbers::invalid_unsigned_int)
+                evaluation_data[i][v] = vec_coarse.local_element(indices[i]);
+              else
+                {
+                  Number value = 0.;
+                  for (unsigned int e = constraint_start_coarse[row];
+                       e < constraint_start_coarse[row + 1];
+                       ++e)
+                    value += constraint_entries_coarse[e].second *
+                             vec_coarse.local_element(
+                               constraint_entries_coarse[e].first);
+                  evaluation_data[i][v] = value;
+                }
+            }
+        }
+
+      // perform tensorized operation, going through the components backwards
+      // because the output is written to the same array as the input
+      for (int c = n_components - 1; c >= 0; --c)
+        internal::FEEvaluationImplBasisChange<
+          internal::evaluate_general,
+          dim,
+          0,
+          0,
+          1,
+          VectorizedArray<Number>,
+          VectorizedArray<Number>>::do_forward(transfer.prolongation_matrix_1d,
+                                               evaluation_data.begin() +
+                                                 c * n_scalar_dofs_coarse,
+                                               evaluation_data.begin() +
+                                                 c * n_scalar_dofs_fine,
+                                               transfer.n_dofs_1d_coarse,
+                                               transfer.n_dofs_1d_fine);
+
+      // write into the fine vector
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int *indices =
+            &transfer.dof_indices_fine[(cell + v) * n_dofs_fine];
+          if (weights_fine.empty())
+            for (unsigned int i = 0; i < n_dofs_fine; ++i)
+              vec_fine.local_element(indices[i]) += evaluation_data[i][v];
+          else
+            for (unsigned int i = 0; i < n_dofs_fine; ++i)
+              vec_fine.local_element(indices[i]) +=
+                weights_fine[indices[i]] * evaluation_data[i][v];
+        }
+    }
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::do_restrict_add(
+  const CellTransfer &transfer) const
+{
+  const unsigned int vec_size = VectorizedArray<Number>::n_array_elements;
+  const unsigned int n_scalar_dofs_coarse =
+    Utilities::fixed_power<dim>(transfer.n_dofs_1d_coarse);
+  const unsigned int n_scalar_dofs_fine =
+    Utilities::fixed_power<dim>(transfer.n_dofs_1d_fine);
+  const unsigned int n_dofs_coarse = n_components * n_scalar_dofs_coarse;
+  const unsigned int n_dofs_fine   = n_components * n_scalar_dofs_fine;
+
+  for (unsigned int cell = 0; cell < transfer.n_cells; cell += vec_size)
+    {
+      const unsigned int n_lanes =
+        std::min(vec_size, transfer.n_cells - cell);
+
+      // read from the fine vector
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int *indices =
+            &transfer.dof_indices_fine[(cell + v) * n_dofs_fine];
+          if (weights_fine.empty())
+            for (unsigned int i = 0; i < n_dofs_fine; ++i)
+              evaluation_data[i][v] = vec_fine.local_element(indices[i]);
+          else
+            for (unsigned int i = 0; i < n_dofs_fine; ++i)
+              evaluation_data[i][v] = weights_fine[indices[i]] *
+                                      vec_fine.local_element(indices[i]);
+        }
+
+      // perform tensorized operation
+      for (unsigned int c = 0; c < n_components; ++c)
+        internal::FEEvaluationImplBasisChange<
+          internal::evaluate_general,
+          dim,
+          0,
+          0,
+          1,
+          VectorizedArray<Number>,
+          VectorizedArray<Number>>::do_backward(transfer.prolongation_matrix_1d,
+                                                false,
+                                                evaluation_data.begin() +
+                                                  c * n_scalar_dofs_fine,
+                                                evaluation_data.begin() +
+                                                  c * n_scalar_dofs_coarse,
+                                                transfer.n_dofs_1d_coarse,
+                                                transfer.n_dofs_1d_fine);
+
+      // write into the coarse vector, applying the transpose of the
+      // constraints
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int *indices =
+            &transfer.dof_indices_coarse[(cell + v) * n_dofs_coarse];
+          for (unsigned int i = 0; i < n_dofs_coarse; ++i)
+            {
+              const unsigned int row = constraint_index_coarse.empty() ?
+                                         numbers::invalid_unsigned_int :
+                                         constraint_index_coarse[indices[i]];
+              if (row == numbers::invalid_unsigned_int)
+                vec_coarse.local_element(indices[i]) += evaluation_data[i][v];
+              else
+                for (unsigned int e = constraint_start_coarse[row];
+                     e < constraint_start_coarse[row + 1];
+                     ++e)
+                  vec_coarse.local_element(
+                    constraint_entries_coarse[e].first) +=
+                    constraint_entries_coarse[e].second *
+                    evaluation_data[i][v];
+            }
+        }
+    }
+}
+
+
+
+template <int dim, typename Number>
+const std::shared_ptr<const Utilities::MPI::Partitioner> &
+MGTwoLevelTransfer<dim, Number>::get_partitioner_fine() const
+{
+  return partitioner_fine;
+}
+
+
+
+template <int dim, typename Number>
+const std::shared_ptr<const Utilities::MPI::Partitioner> &
+MGTwoLevelTransfer<dim, Number>::get_partitioner_coarse() const
+{
+  return partitioner_coarse;
+}
+
+
+
+template <int dim, typename Number>
+std::size_t
+MGTwoLevelTransfer<dim, Number>::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this);
+  for (const auto &transfer : transfers)
+    memory +=
+      MemoryConsumption::memory_consumption(transfer.prolongation_matrix_1d) +
+      MemoryConsumption::memory_consumption(transfer.dof_indices_coarse) +
+      MemoryConsumption::memory_consumption(transfer.dof_indices_fine);
+  memory += vec_fine.memory_consumption() + vec_coarse.memory_consumption();
+  memory += MemoryConsumption::memory_consumption(weights_fine) +
+            MemoryConsumption::memory_consumption(constrained_indices_fine) +
+            MemoryConsumption::memory_consumption(constraint_index_coarse) +
+            MemoryConsumption::memory_consumption(constraint_start_coarse) +
+            MemoryConsumption::memory_consumption(constraint_entries_coarse) +
+            MemoryConsumption::memory_consumption(evaluation_data);
+  return memory;
+}
+
+
+
+template <int dim, typename Number>
+MGTransferGlobalCoarsening<dim, Number>::MGTransferGlobalCoarsening(
+  const MGLevelObject<MGTwoLevelTransfer<dim, Number>> &transfer,
+  const std::function<void(const unsigned int, VectorType &)>
+    &initialize_dof_vector)
+  : transfer(&transfer, typeid(*this).name())
+  , initialize_function(initialize_dof_vector)
+{}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferGlobalCoarsening<dim, Number>::prolongate(
+  const unsigned int to_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  (*transfer)[to_level].prolongate(dst, src);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferGlobalCoarsening<dim, Number>::restrict_and_add(
+  const unsigned int from_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  (*transfer)[from_level].restrict_and_add(dst, src);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferGlobalCoarsening<dim, Number>::initialize_dof_vector(
+  const unsigned int level,
+  VectorType &       vector) const
+{
+  if (initialize_function)
+    initialize_function(level, vector);
+  else if (level > transfer->min_level())
+    vector.reinit((*transfer)[level].get_partitioner_fine());
+  else
+    vector.reinit((*transfer)[level + 1].get_partitioner_coarse());
+}
+
+
+
+template <int dim, typename Number>
+std::size_t
+MGTransferGlobalCoarsening<dim, Number>::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this);
+  for (unsigned int level = transfer->min_level() + 1;
+       level <= transfer->max_level();
+       ++level)
+    memory += (*transfer)[level].memory_consumption();
+  return memory;
+}
+
+
+
+// explicit instantiation
+#include "mg_transfer_global_coarsening.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
@@ -236,6 +236,19 @@ MGTransferMatrixFree<dim, Number>::restrict_and_add(
   const unsigned int                                from_level,
   LinearAlgebra::distributed::Vector<Number> &      dst,
   const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  restrict_and_add_start(from_level, dst, src);
+  restrict_and_add_finish(from_level, dst);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferMatrixFree<dim, Number>::restrict_and_add_start(
+  const unsigned int                                from_level,
+  LinearAlgebra::distributed::Vector<Number> &      dst,
+  const LinearAlgebra::distributed::Vector<Number> &src) const
 {
   Assert((from_level >= 1) && (from_level <= level_dof_indices.size()),
          ExcIndexRange(from_level, 1, level_dof_indices.size() + 1));
@@ -299,7 +312,26 @@ MGTransferMatrixFree<dim, Number>::restrict_and_add(
                         this->ghosted_level_vector[from_level - 1],
                         this->ghosted_level_vector[from_level]);
 
-  this->ghosted_level_vector[from_level - 1].compress(VectorOperation::add);
+  // use a separate communication channel such that the caller can exchange
+  // data of other vectors on the same level before calling
+  // restrict_and_add_finish()
+  this->ghosted_level_vector[from_level - 1].compress_start(
+    1, VectorOperation::add);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferMatrixFree<dim, Number>::restrict_and_add_finish(
+  const unsigned int                          from_level,
+  LinearAlgebra::distributed::Vector<Number> &dst) const
+{
+  Assert((from_level >= 1) && (from_level <= level_dof_indices.size()),
+         ExcIndexRange(from_level, 1, level_dof_indices.size() + 1));
+
+  this->ghosted_level_vector[from_level - 1].compress_finish(
+    VectorOperation::add);
   dst += this->ghosted_level_vector[from_level - 1];
 }
 
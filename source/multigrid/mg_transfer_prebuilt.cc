@@ -16,6 +16,9 @@
 
 #include <deal.II/base/function.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_tools.h>
@@ -403,8 +406,373 @@ MGTransferPrebuilt<VectorType>::memory_consumption() const
 }
 
 
+
+namespace
+{
+  /**
+   * Helper function for MGTransferCellwise. Copies the locally owned entries
+   * of @p src into the ghosted vector @p dst.
+   */
+  template <typename VectorType, typename Number>
+  void
+  copy_locally_owned(const VectorType &                          src,
+                     LinearAlgebra::distributed::Vector<Number> &dst)
+  {
+    unsigned int i = 0;
+    for (const auto index : dst.get_partitioner()->locally_owned_range())
+      dst.local_element(i++) = src(index);
+  }
+
+
+
+  /**
+   * Helper function for MGTransferCellwise. Sets (or adds) the locally owned
+   * entries of @p src into @p dst.
+   */
+  template <typename VectorType, typename Number>
+  void
+  write_locally_owned(const LinearAlgebra::distributed::Vector<Number> &src,
+                      VectorType &                                      dst,
+                      const VectorOperation::values operation)
+  {
+    unsigned int i = 0;
+    if (operation == VectorOperation::insert)
+      for (const auto index : src.get_partitioner()->locally_owned_range())
+        dst(index) = src.local_element(i++);
+    else
+      for (const auto index : src.get_partitioner()->locally_owned_range())
+        dst(index) += src.local_element(i++);
+    dst.compress(operation);
+  }
+
+
+
+  /**
+   * Helper function for MGTransferCellwise. Sets up a partitioner with the
+   * locally owned entries @p locally_owned and all other entries of
+   * @p indices as ghosts, and translates @p indices into local indices of
+   * that partitioner. The entries numbers::invalid_dof_index of @p indices
+   * become numbers::invalid_unsigned_int.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner>
+  make_partitioner(const IndexSet &                            locally_owned,
+                   const std::vector<types::global_dof_index> &indices,
+                   const MPI_Comm                              communicator,
+                   std::vector<unsigned int> &                 local_indices)
+  {
+    std::vector<types::global_dof_index> ghost_indices;
+    for (const types::global_dof_index index : indices)
+      if (index != numbers::invalid_dof_index &&
+          !locally_owned.is_element(index))
+        ghost_indices.push_back(index);
+    std::sort(ghost_indices.begin(), ghost_indices.end());
+    ghost_indices.erase(std::unique(ghost_indices.begin(),
+                                    ghost_indices.end()),
+                        ghost_indices.end());
+
+    IndexSet ghosts(locally_owned.size());
+    ghosts.add_indices(ghost_indices.begin(), ghost_indices.end());
+    const auto partitioner =
+      std::make_shared<const Utilities::MPI::Partitioner>(locally_owned,
+                                                          ghosts,
+                                                          communicator);
+
+    local_indices.resize(indices.size());
+    for (unsigned int i = 0; i < indices.size(); ++i)
+      local_indices[i] = indices[i] == numbers::invalid_dof_index ?
+                           numbers::invalid_unsigned_int :
+                           partitioner->global_to_local(indices[i]);
+    return partitioner;
+  }
+} // namespace
+
+
+
+template <typename VectorType>
+MGTransferCellwise<VectorType>::MGTransferCellwise(
+  const MGConstrainedDoFs &mg_c)
+{
+  this->mg_constrained_dofs = &mg_c;
+}
+
+
+
+template <typename VectorType>
+void
+MGTransferCellwise<VectorType>::initialize_constraints(
+  const MGConstrainedDoFs &mg_c)
+{
+  this->mg_constrained_dofs = &mg_c;
+}
+
+
+
+template <typename VectorType>
+void
+MGTransferCellwise<VectorType>::clear()
+{
+  MGLevelGlobalTransfer<VectorType>::clear();
+  prolongation_matrices.clear();
+  parent_dof_indices.clear();
+  child_dof_indices.clear();
+  weights.clear();
+  coarse_vectors.clear();
+  fine_vectors.clear();
+}
+
+
+
+template <typename VectorType>
+template <int dim, int spacedim>
+void
+MGTransferCellwise<VectorType>::build(const DoFHandler<dim, spacedim> &mg_dof)
+{
+  const Triangulation<dim, spacedim> &tria     = mg_dof.get_triangulation();
+  const unsigned int                  n_levels = tria.n_global_levels();
+  const unsigned int n_children = GeometryInfo<dim>::max_children_per_cell;
+  dofs_per_cell                 = mg_dof.get_fe().dofs_per_cell;
+
+  this->sizes.resize(n_levels);
+  for (unsigned int l = 0; l < n_levels; ++l)
+    this->sizes[l] = mg_dof.n_dofs(l);
+
+  prolongation_matrices.resize(n_children);
+  for (unsigned int child = 0; child < n_children; ++child)
+    {
+      const FullMatrix<double> &prolongation =
+        mg_dof.get_fe().get_prolongation_matrix(
+          child, RefinementCase<dim>::isotropic_refinement);
+      Assert(prolongation.n() != 0, ExcNoProlongation());
+      prolongation_matrices[child] = prolongation;
+    }
+
+  // collect the multigrid indices of the locally owned parent cells and
+  // their children. the levels are independent of each other, so run them
+  // in parallel; the communication for setting up the ghosted vectors
+  // happens afterwards
+  std::vector<std::vector<types::global_dof_index>> parent_indices(n_levels -
+                                                                   1);
+  std::vector<std::vector<types::global_dof_index>> child_indices(n_levels -
+                                                                  1);
+  Threads::TaskGroup<void> tasks;
+  for (unsigned int level = 0; level + 1 < n_levels; ++level)
+    tasks += Threads::new_task([&, level]() {
+      std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+      for (const auto &cell : mg_dof.mg_cell_iterators_on_level(level))
+        if (cell->has_children() &&
+            (tria.locally_owned_subdomain() == numbers::invalid_subdomain_id ||
+             cell->level_subdomain_id() == tria.locally_owned_subdomain()))
+          {
+            Assert(cell->n_children() == n_children, ExcNotImplemented());
+
+            cell->get_mg_dof_indices(dof_indices);
+            replace(this->mg_constrained_dofs, level, dof_indices);
+            if (this->mg_constrained_dofs != nullptr &&
+                this->mg_constrained_dofs->have_boundary_indices())
+              for (auto &index : dof_indices)
+                if (this->mg_constrained_dofs->is_boundary_index(level, index))
+                  index = numbers::invalid_dof_index;
+            parent_indices[level].insert(parent_indices[level].end(),
+                                         dof_indices.begin(),
+                                         dof_indices.end());
+
+            for (unsigned int child = 0; child < n_children; ++child)
+              {
+                cell->child(child)->get_mg_dof_indices(dof_indices);
+                replace(this->mg_constrained_dofs, level + 1, dof_indices);
+                child_indices[level].insert(child_indices[level].end(),
+                                            dof_indices.begin(),
+                                            dof_indices.end());
+              }
+          }
+    });
+  tasks.join_all();
+
+  MPI_Comm communicator = MPI_COMM_SELF;
+  if (const parallel::TriangulationBase<dim, spacedim> *dist_tria =
+        dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+          &tria))
+    communicator = dist_tria->get_communicator();
+
+  parent_dof_indices.resize(n_levels - 1);
+  child_dof_indices.resize(n_levels - 1);
+  weights.resize(n_levels - 1);
+  coarse_vectors.resize(n_levels - 1);
+  fine_vectors.resize(n_levels - 1);
+  for (unsigned int level = 0; level + 1 < n_levels; ++level)
+    {
+      coarse_vectors[level].reinit(
+        make_partitioner(mg_dof.locally_owned_mg_dofs(level),
+                         parent_indices[level],
+                         communicator,
+                         parent_dof_indices[level]));
+      fine_vectors[level].reinit(
+        make_partitioner(mg_dof.locally_owned_mg_dofs(level + 1),
+                         child_indices[level],
+                         communicator,
+                         child_dof_indices[level]));
+      parent_indices[level].clear();
+      child_indices[level].clear();
+
+      // count how many children share each of the degrees of freedom on the
+      // finer level, including the children of the cells of other processors
+      LinearAlgebra::distributed::Vector<Number> &fine = fine_vectors[level];
+      for (const unsigned int index : child_dof_indices[level])
+        fine.local_element(index) += Number(1.);
+      fine.compress(VectorOperation::add);
+      for (unsigned int i = 0; i < fine.local_size(); ++i)
+        {
+          Assert(fine.local_element(i) != Number(),
+                 ExcMessage("A degree of freedom on level " +
+                            Utilities::to_string(level + 1) +
+                            " is not located on any child cell."));
+          fine.local_element(i) = Number(1.) / fine.local_element(i);
+        }
+      fine.update_ghost_values();
+      weights[level].assign(fine.begin(),
+                            fine.begin() + fine.local_size() +
+                              fine.n_ghost_entries());
+      fine = Number();
+    }
+
+  this->fill_and_communicate_copy_indices(mg_dof);
+}
+
+
+
+template <typename VectorType>
+void
+MGTransferCellwise<VectorType>::prolongate(const unsigned int to_level,
+                                           VectorType &       dst,
+                                           const VectorType & src) const
+{
+  Assert((to_level >= 1) && (to_level <= coarse_vectors.size()),
+         ExcIndexRange(to_level, 1, coarse_vectors.size() + 1));
+
+  LinearAlgebra::distributed::Vector<Number> &coarse =
+    coarse_vectors[to_level - 1];
+  LinearAlgebra::distributed::Vector<Number> &fine =
+    fine_vectors[to_level - 1];
+  const std::vector<unsigned int> &parent_indices =
+    parent_dof_indices[to_level - 1];
+  const std::vector<unsigned int> &child_indices =
+    child_dof_indices[to_level - 1];
+  const std::vector<Number> &level_weights = weights[to_level - 1];
+
+  copy_locally_owned(src, coarse);
+  coarse.update_ghost_values();
+  fine = Number();
+
+  Vector<Number>     parent_values(dofs_per_cell);
+  Vector<Number>     child_values(dofs_per_cell);
+  const unsigned int n_children = prolongation_matrices.size();
+  const unsigned int n_cells    = parent_indices.size() / dofs_per_cell;
+  for (unsigned int cell = 0; cell < n_cells; ++cell)
+    {
+      const unsigned int *indices = &parent_indices[cell * dofs_per_cell];
+      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+        parent_values(j) = indices[j] == numbers::invalid_unsigned_int ?
+                             Number() :
+                             coarse.local_element(indices[j]);
+
+      for (unsigned int child = 0; child < n_children; ++child)
+        {
+          prolongation_matrices[child].vmult(child_values, parent_values);
+          indices = &child_indices[(cell * n_children + child) * dofs_per_cell];
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            fine.local_element(indices[i]) +=
+              level_weights[indices[i]] * child_values(i);
+        }
+    }
+
+  fine.compress(VectorOperation::add);
+  coarse.zero_out_ghosts();
+  write_locally_owned(fine, dst, VectorOperation::insert);
+}
+
+
+
+template <typename VectorType>
+void
+MGTransferCellwise<VectorType>::restrict_and_add(const unsigned int from_level,
+                                                 VectorType &       dst,
+                                                 const VectorType & src) const
+{
+  Assert((from_level >= 1) && (from_level <= coarse_vectors.size()),
+         ExcIndexRange(from_level, 1, coarse_vectors.size() + 1));
+
+  LinearAlgebra::distributed::Vector<Number> &coarse =
+    coarse_vectors[from_level - 1];
+  LinearAlgebra::distributed::Vector<Number> &fine =
+    fine_vectors[from_level - 1];
+  const std::vector<unsigned int> &parent_indices =
+    parent_dof_indices[from_level - 1];
+  const std::vector<unsigned int> &child_indices =
+    child_dof_indices[from_level - 1];
+  const std::vector<Number> &level_weights = weights[from_level - 1];
+
+  copy_locally_owned(src, fine);
+  fine.update_ghost_values();
+  coarse = Number();
+
+  Vector<Number>     parent_values(dofs_per_cell);
+  Vector<Number>     child_values(dofs_per_cell);
+  const unsigned int n_children = prolongation_matrices.size();
+  const unsigned int n_cells    = parent_indices.size() / dofs_per_cell;
+  for (unsigned int cell = 0; cell < n_cells; ++cell)
+    {
+      parent_values = Number();
+      for (unsigned int child = 0; child < n_children; ++child)
+        {
+          const unsigned int *indices =
+            &child_indices[(cell * n_children + child) * dofs_per_cell];
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            child_values(i) =
+              level_weights[indices[i]] * fine.local_element(indices[i]);
+          prolongation_matrices[child].Tvmult_add(parent_values, child_values);
+        }
+
+      const unsigned int *indices = &parent_indices[cell * dofs_per_cell];
+      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+        if (indices[j] != numbers::invalid_unsigned_int)
+          coarse.local_element(indices[j]) += parent_values(j);
+    }
+
+  coarse.compress(VectorOperation::add);
+  fine.zero_out_ghosts();
+  write_locally_owned(coarse, dst, VectorOperation::add);
+}
+
+
+
+template <typename VectorType>
+std::size_t
+MGTransferCellwise<VectorType>::memory_consumption() const
+{
+  std::size_t result = MGLevelGlobalTransfer<VectorType>::memory_consumption();
+  result += MemoryConsumption::memory_consumption(prolongation_matrices) +
+            MemoryConsumption::memory_consumption(parent_dof_indices) +
+            MemoryConsumption::memory_consumption(child_dof_indices) +
+            MemoryConsumption::memory_consumption(weights);
+  for (unsigned int i = 0; i < coarse_vectors.size(); ++i)
+    result += coarse_vectors[i].memory_consumption() +
+              fine_vectors[i].memory_consumption();
+
+  return result;
+}
+
+
 // explicit instantiation
 #include "mg_transfer_prebuilt.inst"
 
+template class MGTransferCellwise<LinearAlgebra::distributed::Vector<double>>;
+template class MGTransferCellwise<LinearAlgebra::distributed::Vector<float>>;
+#ifdef DEAL_II_WITH_TRILINOS
+template class MGTransferCellwise<TrilinosWrappers::MPI::Vector>;
+#endif
+#if defined(DEAL_II_WITH_PETSC) && !defined(DEAL_II_PETSC_WITH_COMPLEX)
+template class MGTransferCellwise<PETScWrappers::MPI::Vector>;
+#endif
+
 
 DEAL_II_NAMESPACE_CLOSE
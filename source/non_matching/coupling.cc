@@ -16,6 +16,7 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -124,6 +125,50 @@ namespace NonMatching
       }
       return {std::move(points_over_local_cells), std::move(used_cells_ids)};
     }
+
+
+
+    /**
+     * Scratch data for the assembly of the coupling mass matrix: The
+     * FEValues object of the immersed cells, and the values of the shape
+     * functions of an embedding cell at the quadrature points it contains.
+     */
+    template <int dim1, int spacedim>
+    struct CouplingScratchData
+    {
+      CouplingScratchData(const Mapping<dim1, spacedim> &       mapping,
+                          const FiniteElement<dim1, spacedim> &fe,
+                          const Quadrature<dim1> &             quad)
+        : fe_values(mapping, fe, quad, update_JxW_values | update_values)
+      {}
+
+      CouplingScratchData(const CouplingScratchData &data)
+        : fe_values(data.fe_values.get_mapping(),
+                    data.fe_values.get_fe(),
+                    data.fe_values.get_quadrature(),
+                    data.fe_values.get_update_flags())
+      {}
+
+      FEValues<dim1, spacedim> fe_values;
+      FullMatrix<double>       space_values;
+    };
+
+
+
+    /**
+     * Copy data for the assembly of the coupling mass matrix: The local
+     * matrices of one immersed cell with each of the locally owned embedding
+     * cells it overlaps. The vectors are only ever grown, and only the first
+     * @p n_cell_matrices entries are valid.
+     */
+    template <typename number>
+    struct CouplingCopyData
+    {
+      unsigned int                                      n_cell_matrices = 0;
+      std::vector<types::global_dof_index>              dofs;
+      std::vector<std::vector<types::global_dof_index>> odofs;
+      std::vector<FullMatrix<number>>                   cell_matrices;
+    };
   } // namespace internal
 
   template <int dim0,
@@ -373,10 +418,6 @@ namespace NonMatching
     const auto &space_fe    = space_dh.get_fe();
     const auto &immersed_fe = immersed_dh.get_fe();
 
-    // Dof indices
-    std::vector<types::global_dof_index> dofs(immersed_fe.dofs_per_cell);
-    std::vector<types::global_dof_index> odofs(space_fe.dofs_per_cell);
-
     // Take care of components
     const ComponentMask space_c =
       (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
@@ -403,15 +444,6 @@ namespace NonMatching
       if (immersed_c[i])
         immersed_gtl[i] = j++;
 
-    FullMatrix<typename Matrix::value_type> cell_matrix(
-      space_dh.get_fe().dofs_per_cell, immersed_dh.get_fe().dofs_per_cell);
-
-    FEValues<dim1, spacedim> fe_v(immersed_mapping,
-                                  immersed_dh.get_fe(),
-                                  quad,
-                                  update_JxW_values | update_quadrature_points |
-                                    update_values);
-
     const unsigned int n_q_points = quad.size();
     const unsigned int n_active_c =
       immersed_dh.get_triangulation().n_active_cells();
@@ -498,78 +530,133 @@ namespace NonMatching
           }
       }
 
-    typename DoFHandler<dim1, spacedim>::active_cell_iterator
-      cell = immersed_dh.begin_active(),
-      endc = immersed_dh.end();
-
-    for (unsigned int j = 0; cell != endc; ++cell, ++j)
-      {
-        // Reinitialize the cell and the fe_values
-        fe_v.reinit(cell);
-        cell->get_dof_indices(dofs);
-
-        // Get a list of outer cells, qpoints and maps.
-        const auto &cells   = cell_container[j];
-        const auto &qpoints = qpoints_container[j];
-        const auto &maps    = maps_container[j];
-
-        for (unsigned int c = 0; c < cells.size(); ++c)
-          {
-            // Get the ones in the current outer cell
-            typename DoFHandler<dim0, spacedim>::active_cell_iterator ocell(
-              *cells[c], &space_dh);
-            // Make sure we act only on locally_owned cells
-            if (ocell->is_locally_owned())
-              {
-                const std::vector<Point<dim0>> & qps = qpoints[c];
-                const std::vector<unsigned int> &ids = maps[c];
-
-                FEValues<dim0, spacedim> o_fe_v(cache.get_mapping(),
-                                                space_dh.get_fe(),
-                                                qps,
-                                                update_values);
-                o_fe_v.reinit(ocell);
-                ocell->get_dof_indices(odofs);
-
-                // Reset the matrices.
-                cell_matrix = typename Matrix::value_type();
-
-                for (unsigned int i = 0; i < space_dh.get_fe().dofs_per_cell;
-                     ++i)
-                  {
-                    const auto comp_i =
-                      space_dh.get_fe().system_to_component_index(i).first;
-                    if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
-                      for (unsigned int j = 0;
-                           j < immersed_dh.get_fe().dofs_per_cell;
-                           ++j)
-                        {
-                          const auto comp_j = immersed_dh.get_fe()
-                                                .system_to_component_index(j)
-                                                .first;
-                          if (space_gtl[comp_i] == immersed_gtl[comp_j])
-                            for (unsigned int oq = 0;
-                                 oq < o_fe_v.n_quadrature_points;
-                                 ++oq)
-                              {
-                                // Get the corresponding q point
-                                const unsigned int q = ids[oq];
-
-                                cell_matrix(i, j) +=
-                                  (fe_v.shape_value(j, q) *
-                                   o_fe_v.shape_value(i, oq) * fe_v.JxW(q));
-                              }
-                        }
-                  }
-
-                // Now assemble the matrices
-                constraints.distribute_local_to_global(cell_matrix,
-                                                       odofs,
-                                                       dofs,
-                                                       matrix);
-              }
-          }
-      }
+    // If the values of the shape functions of the space finite element do
+    // not depend on the geometry of the cell, as is the case for all
+    // elements whose shape functions are defined on the reference cell and
+    // are not transformed (FE_Q, FE_DGQ, and systems thereof), we can
+    // evaluate them at the reference points directly rather than setting up
+    // an FEValues object for each pair of overlapping cells. Whether this is
+    // the case can be read off the update flags an FEValues object
+    // determines for the computation of values only.
+    const bool space_values_on_reference_cell =
+      (FEValues<dim0, spacedim>(cache.get_mapping(),
+                                space_fe,
+                                Quadrature<dim0>(Point<dim0>()),
+                                update_values)
+         .get_update_flags() == update_values);
+
+    using CellIterator =
+      typename DoFHandler<dim1, spacedim>::active_cell_iterator;
+    using ScratchData = internal::CouplingScratchData<dim1, spacedim>;
+    using CopyData = internal::CouplingCopyData<typename Matrix::value_type>;
+
+    auto worker = [&](const CellIterator &cell,
+                      ScratchData &       scratch,
+                      CopyData &          copy) {
+      copy.n_cell_matrices = 0;
+
+      // Get a list of outer cells, qpoints and maps.
+      const unsigned int j       = cell->active_cell_index();
+      const auto &       cells   = cell_container[j];
+      const auto &       qpoints = qpoints_container[j];
+      const auto &       maps    = maps_container[j];
+
+      if (cells.empty())
+        return;
+
+      // Reinitialize the cell and the fe_values
+      FEValues<dim1, spacedim> &fe_v = scratch.fe_values;
+      fe_v.reinit(cell);
+      copy.dofs.resize(immersed_fe.dofs_per_cell);
+      cell->get_dof_indices(copy.dofs);
+
+      for (unsigned int c = 0; c < cells.size(); ++c)
+        {
+          // Get the ones in the current outer cell
+          typename DoFHandler<dim0, spacedim>::active_cell_iterator ocell(
+            *cells[c], &space_dh);
+          // Make sure we act only on locally_owned cells
+          if (ocell->is_locally_owned())
+            {
+              const std::vector<Point<dim0>> & qps = qpoints[c];
+              const std::vector<unsigned int> &ids = maps[c];
+
+              // Evaluate the shape functions of the outer cell at the
+              // quadrature points located in it
+              FullMatrix<double> &o_values = scratch.space_values;
+              o_values.reinit(space_fe.dofs_per_cell, qps.size());
+              if (space_values_on_reference_cell)
+                {
+                  for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+                    for (unsigned int oq = 0; oq < qps.size(); ++oq)
+                      o_values(i, oq) = space_fe.shape_value(i, qps[oq]);
+                }
+              else
+                {
+                  FEValues<dim0, spacedim> o_fe_v(cache.get_mapping(),
+                                                  space_fe,
+                                                  qps,
+                                                  update_values);
+                  o_fe_v.reinit(ocell);
+                  for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+                    for (unsigned int oq = 0; oq < qps.size(); ++oq)
+                      o_values(i, oq) = o_fe_v.shape_value(i, oq);
+                }
+
+              if (copy.n_cell_matrices == copy.cell_matrices.size())
+                {
+                  copy.cell_matrices.emplace_back(space_fe.dofs_per_cell,
+                                                  immersed_fe.dofs_per_cell);
+                  copy.odofs.emplace_back(space_fe.dofs_per_cell);
+                }
+              auto &cell_matrix = copy.cell_matrices[copy.n_cell_matrices];
+              ocell->get_dof_indices(copy.odofs[copy.n_cell_matrices]);
+              ++copy.n_cell_matrices;
+
+              // Reset the matrices.
+              cell_matrix = typename Matrix::value_type();
+
+              for (unsigned int i = 0; i < space_fe.dofs_per_cell; ++i)
+                {
+                  const auto comp_i =
+                    space_fe.system_to_component_index(i).first;
+                  if (space_gtl[comp_i] != numbers::invalid_unsigned_int)
+                    for (unsigned int j = 0; j < immersed_fe.dofs_per_cell;
+                         ++j)
+                      {
+                        const auto comp_j =
+                          immersed_fe.system_to_component_index(j).first;
+                        if (space_gtl[comp_i] == immersed_gtl[comp_j])
+                          for (unsigned int oq = 0; oq < qps.size(); ++oq)
+                            {
+                              // Get the corresponding q point
+                              const unsigned int q = ids[oq];
+
+                              cell_matrix(i, j) +=
+                                (fe_v.shape_value(j, q) * o_values(i, oq) *
+                                 fe_v.JxW(q));
+                            }
+                      }
+                }
+            }
+        }
+    };
+
+    auto copier = [&](const CopyData &copy) {
+      // Now assemble the matrices
+      for (unsigned int c = 0; c < copy.n_cell_matrices; ++c)
+        constraints.distribute_local_to_global(copy.cell_matrices[c],
+                                               copy.odofs[c],
+                                               copy.dofs,
+                                               matrix);
+    };
+
+    WorkStream::run(immersed_dh.begin_active(),
+                    CellIterator(immersed_dh.end()),
+                    worker,
+                    copier,
+                    ScratchData(immersed_mapping, immersed_fe, quad),
+                    CopyData());
   }
 
 #include "coupling.inst"
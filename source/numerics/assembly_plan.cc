@@ -0,0 +1,192 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/assembly_plan.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, int spacedim, typename number>
+AssemblyPlan<dim, spacedim, number>::AssemblyPlan()
+  : dof_handler(nullptr, typeid(*this).name())
+  , constraints(nullptr, typeid(*this).name())
+{}
+
+
+
+template <int dim, int spacedim, typename number>
+AssemblyPlan<dim, spacedim, number>::AssemblyPlan(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const AffineConstraints<number> &constraints,
+  const SparsityPattern &          sparsity_pattern)
+  : AssemblyPlan()
+{
+  reinit(dof_handler, constraints, sparsity_pattern);
+}
+
+
+
+template <int dim, int spacedim, typename number>
+void
+AssemblyPlan<dim, spacedim, number>::reinit(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const AffineConstraints<number> &constraints,
+  const SparsityPattern &          sparsity_pattern)
+{
+  Assert(sparsity_pattern.n_rows() == dof_handler.n_dofs(),
+         ExcDimensionMismatch(sparsity_pattern.n_rows(), dof_handler.n_dofs()));
+  Assert(sparsity_pattern.n_cols() == dof_handler.n_dofs(),
+         ExcDimensionMismatch(sparsity_pattern.n_cols(), dof_handler.n_dofs()));
+
+  clear();
+
+  this->dof_handler = &dof_handler;
+  this->constraints = &constraints;
+
+  cell_indices.resize(dof_handler.get_triangulation().n_active_cells(),
+                      numbers::invalid_unsigned_int);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        cell_indices[cell->active_cell_index()] = cells.size();
+        cells.push_back(cell);
+
+        dof_indices.emplace_back(cell->get_fe().dofs_per_cell);
+        cell->get_dof_indices(dof_indices.back());
+      }
+
+  constraints.compute_sparse_matrix_offsets(dof_indices,
+                                            sparsity_pattern,
+                                            matrix_offsets);
+}
+
+
+
+template <int dim, int spacedim, typename number>
+void
+AssemblyPlan<dim, spacedim, number>::clear()
+{
+  dof_handler = nullptr;
+  constraints = nullptr;
+
+  std::vector<active_cell_iterator>().swap(cells);
+  std::vector<unsigned int>().swap(cell_indices);
+  std::vector<std::vector<size_type>>().swap(dof_indices);
+  matrix_offsets = typename AffineConstraints<number>::SparseMatrixOffsets();
+}
+
+
+
+template <int dim, int spacedim, typename number>
+const DoFHandler<dim, spacedim> &
+AssemblyPlan<dim, spacedim, number>::get_dof_handler() const
+{
+  Assert(dof_handler != nullptr, ExcNotInitialized());
+  return *dof_handler;
+}
+
+
+
+template <int dim, int spacedim, typename number>
+const AffineConstraints<number> &
+AssemblyPlan<dim, spacedim, number>::get_affine_constraints() const
+{
+  Assert(constraints != nullptr, ExcNotInitialized());
+  return *constraints;
+}
+
+
+
+template <int dim, int spacedim, typename number>
+void
+AssemblyPlan<dim, spacedim, number>::distribute_local_to_global(
+  const unsigned int        cell_index,
+  const FullMatrix<number> &local_matrix,
+  SparseMatrix<number> &    global_matrix) const
+{
+  AssertIndexRange(cell_index, cells.size());
+
+  constraints->distribute_local_to_global(local_matrix,
+                                          dof_indices[cell_index],
+                                          matrix_offsets,
+                                          cell_index,
+                                          global_matrix);
+}
+
+
+
+template <int dim, int spacedim, typename number>
+void
+AssemblyPlan<dim, spacedim, number>::distribute_local_to_global(
+  const unsigned int        cell_index,
+  const FullMatrix<number> &local_matrix,
+  const Vector<number> &    local_vector,
+  SparseMatrix<number> &    global_matrix,
+  Vector<number> &          global_vector) const
+{
+  AssertIndexRange(cell_index, cells.size());
+
+  const std::vector<size_type> &cell_dof_indices = dof_indices[cell_index];
+  AssertDimension(local_vector.size(), cell_dof_indices.size());
+
+  // cells without constraints can simply add their vector entry by entry,
+  // whereas the others need the general function that also takes care of
+  // the inhomogeneities
+  if (matrix_offsets.use_offsets[cell_index])
+    {
+      constraints->distribute_local_to_global(local_matrix,
+                                              cell_dof_indices,
+                                              matrix_offsets,
+                                              cell_index,
+                                              global_matrix);
+      for (unsigned int i = 0; i < cell_dof_indices.size(); ++i)
+        global_vector(cell_dof_indices[i]) += local_vector(i);
+    }
+  else
+    constraints->distribute_local_to_global(local_matrix,
+                                            local_vector,
+                                            cell_dof_indices,
+                                            global_matrix,
+                                            global_vector);
+}
+
+
+
+template <int dim, int spacedim, typename number>
+std::size_t
+AssemblyPlan<dim, spacedim, number>::memory_consumption() const
+{
+  return (MemoryConsumption::memory_consumption(cells) +
+          MemoryConsumption::memory_consumption(cell_indices) +
+          MemoryConsumption::memory_consumption(dof_indices) +
+          matrix_offsets.memory_consumption());
+}
+
+
+// explicit instantiations
+#include "assembly_plan.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -73,27 +73,42 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                                                 DoFHandlerType::space_dimension>
     &                    scratch_data,
   const unsigned int     n_subdivisions,
-  const CurvedCellRegion curved_cell_region)
+  const CurvedCellRegion curved_cell_region,
+  const bool             reuse_geometry)
 {
-  // first create the output object that we will write into
+  const unsigned int patch_idx =
+    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
+                                           [cell_and_index->first->index()];
+  // did we mess up the indices?
+  Assert(patch_idx < this->patches.size(), ExcInternalError());
+
+  // first create the output object that we will write into, or take the
+  // existing patch if we only update its data
   ::dealii::DataOutBase::Patch<DoFHandlerType::dimension,
                                DoFHandlerType::space_dimension>
     patch;
-  patch.n_subdivisions = n_subdivisions;
-
-  // set the vertices of the patch. if the mapping does not preserve locations
-  // (e.g. MappingQEulerian), we need to compute the offset of the vertex for
-  // the graphical output. Otherwise, we can just use the vertex info.
-  for (unsigned int vertex = 0;
-       vertex < GeometryInfo<DoFHandlerType::dimension>::vertices_per_cell;
-       ++vertex)
-    if (scratch_data.mapping_collection[0].preserves_vertex_locations())
-      patch.vertices[vertex] = cell_and_index->first->vertex(vertex);
-    else
-      patch.vertices[vertex] =
-        scratch_data.mapping_collection[0].transform_unit_to_real_cell(
-          cell_and_index->first,
-          GeometryInfo<DoFHandlerType::dimension>::unit_cell_vertex(vertex));
+  if (reuse_geometry)
+    patch.swap(this->patches[patch_idx]);
+  else
+    {
+      patch.n_subdivisions = n_subdivisions;
+
+      // set the vertices of the patch. if the mapping does not preserve
+      // locations (e.g. MappingQEulerian), we need to compute the offset of
+      // the vertex for the graphical output. Otherwise, we can just use the
+      // vertex info.
+      for (unsigned int vertex = 0;
+           vertex < GeometryInfo<DoFHandlerType::dimension>::vertices_per_cell;
+           ++vertex)
+        if (scratch_data.mapping_collection[0].preserves_vertex_locations())
+          patch.vertices[vertex] = cell_and_index->first->vertex(vertex);
+        else
+          patch.vertices[vertex] =
+            scratch_data.mapping_collection[0].transform_unit_to_real_cell(
+              cell_and_index->first,
+              GeometryInfo<DoFHandlerType::dimension>::unit_cell_vertex(
+                vertex));
+    }
 
   // create DoFHandlerType::active_cell_iterator and initialize FEValues
   scratch_data.reinit_all_fe_values(this->dof_data, cell_and_index->first);
@@ -110,10 +125,23 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
   // want to produce curved cells everywhere
   //
   // note: a cell is *always* at the boundary if dim<spacedim
-  if (curved_cell_region == curved_inner_cells ||
-      (curved_cell_region == curved_boundary &&
-       (cell_and_index->first->at_boundary() ||
-        (DoFHandlerType::dimension != DoFHandlerType::space_dimension))))
+  //
+  // if we reuse the geometry, the points are already stored in the patch
+  if (reuse_geometry)
+    {
+      Assert(patch.data.size(0) ==
+                 scratch_data.n_datasets +
+                   (patch.points_are_available ?
+                      DoFHandlerType::space_dimension :
+                      0) &&
+               patch.data.size(1) == n_q_points,
+             ExcMessage("The data vectors do not match the patches built by "
+                        "the last call to build_patches()."));
+    }
+  else if (curved_cell_region == curved_inner_cells ||
+           (curved_cell_region == curved_boundary &&
+            (cell_and_index->first->at_boundary() ||
+             (DoFHandlerType::dimension != DoFHandlerType::space_dimension))))
     {
       Assert(patch.space_dim == DoFHandlerType::space_dimension,
              ExcInternalError());
@@ -165,6 +193,16 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
               // have to be updated
               const UpdateFlags update_flags =
                 postprocessor->get_needed_update_flags();
+
+              // postprocessors that support it write directly into the rows
+              // of the patch that belong to this data set
+              const bool contiguous_evaluation =
+                postprocessor->supports_contiguous_evaluation();
+              const ArrayView<float> patch_values(
+                contiguous_evaluation ? &patch.data(offset, 0) : nullptr,
+                contiguous_evaluation ?
+                  this->dof_data[dataset]->n_output_variables * n_q_points :
+                  0);
               if (n_components == 1)
                 {
                   // at each point there is only one component of value,
@@ -200,9 +238,13 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                   scratch_data.patch_values_scalar
                     .template set_cell<DoFHandlerType>(dh_cell);
 
-                  postprocessor->evaluate_scalar_field(
-                    scratch_data.patch_values_scalar,
-                    scratch_data.postprocessed_values[dataset]);
+                  if (contiguous_evaluation)
+                    postprocessor->evaluate_scalar_field_contiguous(
+                      scratch_data.patch_values_scalar, patch_values);
+                  else
+                    postprocessor->evaluate_scalar_field(
+                      scratch_data.patch_values_scalar,
+                      scratch_data.postprocessed_values[dataset]);
                 }
               else
                 {
@@ -241,17 +283,22 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                   scratch_data.patch_values_system
                     .template set_cell<DoFHandlerType>(dh_cell);
 
-                  postprocessor->evaluate_vector_field(
-                    scratch_data.patch_values_system,
-                    scratch_data.postprocessed_values[dataset]);
+                  if (contiguous_evaluation)
+                    postprocessor->evaluate_vector_field_contiguous(
+                      scratch_data.patch_values_system, patch_values);
+                  else
+                    postprocessor->evaluate_vector_field(
+                      scratch_data.patch_values_system,
+                      scratch_data.postprocessed_values[dataset]);
                 }
 
-              for (unsigned int q = 0; q < n_q_points; ++q)
-                for (unsigned int component = 0;
-                     component < this->dof_data[dataset]->n_output_variables;
-                     ++component)
-                  patch.data(offset + component, q) =
-                    scratch_data.postprocessed_values[dataset][q](component);
+              if (contiguous_evaluation == false)
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  for (unsigned int component = 0;
+                       component < this->dof_data[dataset]->n_output_variables;
+                       ++component)
+                    patch.data(offset + component, q) =
+                      scratch_data.postprocessed_values[dataset][q](component);
             }
           else
             {
@@ -364,54 +411,54 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
     }
 
 
-  for (unsigned int f = 0;
-       f < GeometryInfo<DoFHandlerType::dimension>::faces_per_cell;
-       ++f)
-    {
-      // let's look up whether the neighbor behind that face is noted in the
-      // table of cells which we treat. this can only happen if the neighbor
-      // exists, and is on the same level as this cell, but it may also happen
-      // that the neighbor is not a member of the range of cells over which we
-      // loop, in which case the respective entry in the
-      // cell_to_patch_index_map will have the value no_neighbor. (note that
-      // since we allocated only as much space in this array as the maximum
-      // index of the cells we loop over, not every neighbor may have its
-      // space in it, so we have to assume that it is extended by values
-      // no_neighbor)
-      if (cell_and_index->first->at_boundary(f) ||
-          (cell_and_index->first->neighbor(f)->level() !=
-           cell_and_index->first->level()))
-        {
-          patch.neighbors[f] = numbers::invalid_unsigned_int;
-          continue;
-        }
+  // the neighbors of the patch are part of its geometry, so we only need to
+  // set them up if we have created a new patch
+  if (reuse_geometry == false)
+    for (unsigned int f = 0;
+         f < GeometryInfo<DoFHandlerType::dimension>::faces_per_cell;
+         ++f)
+      {
+        // let's look up whether the neighbor behind that face is noted in
+        // the table of cells which we treat. this can only happen if the
+        // neighbor exists, and is on the same level as this cell, but it may
+        // also happen that the neighbor is not a member of the range of cells
+        // over which we loop, in which case the respective entry in the
+        // cell_to_patch_index_map will have the value no_neighbor. (note that
+        // since we allocated only as much space in this array as the maximum
+        // index of the cells we loop over, not every neighbor may have its
+        // space in it, so we have to assume that it is extended by values
+        // no_neighbor)
+        if (cell_and_index->first->at_boundary(f) ||
+            (cell_and_index->first->neighbor(f)->level() !=
+             cell_and_index->first->level()))
+          {
+            patch.neighbors[f] = numbers::invalid_unsigned_int;
+            continue;
+          }
 
-      const cell_iterator neighbor = cell_and_index->first->neighbor(f);
-      Assert(static_cast<unsigned int>(neighbor->level()) <
-               scratch_data.cell_to_patch_index_map->size(),
-             ExcInternalError());
-      if ((static_cast<unsigned int>(neighbor->index()) >=
-           (*scratch_data.cell_to_patch_index_map)[neighbor->level()].size()) ||
-          ((*scratch_data.cell_to_patch_index_map)[neighbor->level()]
-                                                  [neighbor->index()] ==
-           dealii::DataOutBase::Patch<DoFHandlerType::dimension>::no_neighbor))
-        {
-          patch.neighbors[f] = numbers::invalid_unsigned_int;
-          continue;
-        }
+        const cell_iterator neighbor = cell_and_index->first->neighbor(f);
+        Assert(static_cast<unsigned int>(neighbor->level()) <
+                 scratch_data.cell_to_patch_index_map->size(),
+               ExcInternalError());
+        if ((static_cast<unsigned int>(neighbor->index()) >=
+             (*scratch_data.cell_to_patch_index_map)[neighbor->level()]
+               .size()) ||
+            ((*scratch_data.cell_to_patch_index_map)[neighbor->level()]
+                                                    [neighbor->index()] ==
+             dealii::DataOutBase::Patch<
+               DoFHandlerType::dimension>::no_neighbor))
+          {
+            patch.neighbors[f] = numbers::invalid_unsigned_int;
+            continue;
+          }
 
-      // now, there is a neighbor, so get its patch number and set it for the
-      // neighbor index
-      patch.neighbors[f] =
-        (*scratch_data
-            .cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
-    }
+        // now, there is a neighbor, so get its patch number and set it for
+        // the neighbor index
+        patch.neighbors[f] =
+          (*scratch_data
+              .cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
+      }
 
-  const unsigned int patch_idx =
-    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
-                                           [cell_and_index->first->index()];
-  // did we mess up the indices?
-  Assert(patch_idx < this->patches.size(), ExcInternalError());
   patch.patch_index = patch_idx;
 
   // Put the patch into the patches vector. instead of copying the data,
@@ -473,7 +520,7 @@ DataOut<dim, DoFHandlerType>::build_patches(
   //
   // Now construct the map such that
   // cell_to_patch_index_map[cell->level][cell->index] = patch_index
-  std::vector<std::vector<unsigned int>> cell_to_patch_index_map;
+  cell_to_patch_index_map.clear();
   cell_to_patch_index_map.resize(this->triangulation->n_levels());
   for (unsigned int l = 0; l < this->triangulation->n_levels(); ++l)
     {
@@ -494,7 +541,7 @@ DataOut<dim, DoFHandlerType>::build_patches(
     }
 
   // will be all_cells[patch_index] = pair(cell, active_index)
-  std::vector<std::pair<cell_iterator, unsigned int>> all_cells;
+  all_cells.clear();
   {
     // important: we need to compute the active_index of the cell in the range
     // 0..n_active_cells() because this is where we need to look up cell
@@ -534,6 +581,59 @@ DataOut<dim, DoFHandlerType>::build_patches(
   this->patches.clear();
   this->patches.resize(all_cells.size());
 
+  // remember the parameters of the patches for update_patch_data()
+  last_n_subdivisions       = n_subdivisions;
+  n_active_cells_of_patches = this->triangulation->n_active_cells();
+  last_curved_cell_region =
+    (n_subdivisions < 2 ? no_curved_cells : curved_region);
+
+  build_patches_on_cells(mapping, false);
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::update_patch_data()
+{
+  update_patch_data(StaticMappingQ1<DoFHandlerType::dimension,
+                                    DoFHandlerType::space_dimension>::mapping);
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::update_patch_data(
+  const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+    &mapping)
+{
+  Assert(this->triangulation != nullptr,
+         Exceptions::DataOutImplementation::ExcNoTriangulationSelected());
+  Assert(this->patches.size() == all_cells.size() && last_n_subdivisions > 0,
+         ExcMessage("You need to call build_patches() before you can update "
+                    "the data of the patches."));
+  Assert(this->triangulation->n_active_cells() == n_active_cells_of_patches,
+         ExcMessage("The triangulation has changed since the last call to "
+                    "build_patches(), so the patches can not be reused."));
+
+  this->validate_dataset_names();
+
+  build_patches_on_cells(mapping, true);
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::build_patches_on_cells(
+  const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+    &        mapping,
+  const bool reuse_geometry)
+{
+  const unsigned int     n_subdivisions     = last_n_subdivisions;
+  const CurvedCellRegion curved_cell_region = last_curved_cell_region;
+
   // now create a default object for the WorkStream object to work with
   unsigned int n_datasets = 0;
   for (unsigned int i = 0; i < this->cell_data.size(); ++i)
@@ -550,11 +650,9 @@ DataOut<dim, DoFHandlerType>::build_patches(
     else
       n_postprocessor_outputs[dataset] = 0;
 
-  const CurvedCellRegion curved_cell_region =
-    (n_subdivisions < 2 ? no_curved_cells : curved_region);
-
+  // the points of curved cells are only needed when we create the geometry
   UpdateFlags update_flags = update_values;
-  if (curved_cell_region != no_curved_cells)
+  if (curved_cell_region != no_curved_cells && reuse_geometry == false)
     update_flags |= update_quadrature_points;
 
   for (unsigned int i = 0; i < this->dof_data.size(); ++i)
@@ -592,7 +690,8 @@ DataOut<dim, DoFHandlerType>::build_patches(
                    actually need a copy data object -- it just writes everything
                    right into the output array */
                 n_subdivisions,
-                curved_cell_region),
+                curved_cell_region,
+                reuse_geometry),
       // no copy-local-to-global function needed here
       std::function<void(const int)>(),
       thread_data,
@@ -613,7 +712,14 @@ template <int dim, typename DoFHandlerType>
 typename DataOut<dim, DoFHandlerType>::cell_iterator
 DataOut<dim, DoFHandlerType>::first_cell()
 {
-  return this->triangulation->begin_active();
+  typename Triangulation<DoFHandlerType::dimension,
+                         DoFHandlerType::space_dimension>::active_cell_iterator
+    active_cell = this->triangulation->begin_active();
+  if (cell_filter)
+    while (active_cell != this->triangulation->end() &&
+           !cell_filter(active_cell))
+      ++active_cell;
+  return active_cell;
 }
 
 
@@ -629,11 +735,25 @@ DataOut<dim, DoFHandlerType>::next_cell(
                          DoFHandlerType::space_dimension>::active_cell_iterator
     active_cell = cell;
   ++active_cell;
+  if (cell_filter)
+    while (active_cell != this->triangulation->end() &&
+           !cell_filter(active_cell))
+      ++active_cell;
   return active_cell;
 }
 
 
 
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::set_cell_selection(
+  const std::function<bool(const cell_iterator &)> &cell_filter)
+{
+  this->cell_filter = cell_filter;
+}
+
+
+
 template <int dim, typename DoFHandlerType>
 typename DataOut<dim, DoFHandlerType>::cell_iterator
 DataOut<dim, DoFHandlerType>::first_locally_owned_cell()
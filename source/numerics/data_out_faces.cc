@@ -161,6 +161,16 @@ DataOutFaces<dim, DoFHandlerType>::build_one_patch(
               const UpdateFlags update_flags =
                 postprocessor->get_needed_update_flags();
 
+              // postprocessors that support it write directly into the rows
+              // of the patch that belong to this data set
+              const bool contiguous_evaluation =
+                postprocessor->supports_contiguous_evaluation();
+              const ArrayView<float> patch_values(
+                contiguous_evaluation ? &patch.data(offset, 0) : nullptr,
+                contiguous_evaluation ?
+                  this->dof_data[dataset]->n_output_variables * n_q_points :
+                  0);
+
               if (n_components == 1)
                 {
                   // at each point there is only one component of value,
@@ -200,9 +210,13 @@ DataOutFaces<dim, DoFHandlerType>::build_one_patch(
                   data.patch_values_scalar.template set_cell<DoFHandlerType>(
                     dh_cell);
 
-                  postprocessor->evaluate_scalar_field(
-                    data.patch_values_scalar,
-                    data.postprocessed_values[dataset]);
+                  if (contiguous_evaluation)
+                    postprocessor->evaluate_scalar_field_contiguous(
+                      data.patch_values_scalar, patch_values);
+                  else
+                    postprocessor->evaluate_scalar_field(
+                      data.patch_values_scalar,
+                      data.postprocessed_values[dataset]);
                 }
               else
                 {
@@ -244,17 +258,22 @@ DataOutFaces<dim, DoFHandlerType>::build_one_patch(
                   data.patch_values_system.template set_cell<DoFHandlerType>(
                     dh_cell);
 
-                  postprocessor->evaluate_vector_field(
-                    data.patch_values_system,
-                    data.postprocessed_values[dataset]);
+                  if (contiguous_evaluation)
+                    postprocessor->evaluate_vector_field_contiguous(
+                      data.patch_values_system, patch_values);
+                  else
+                    postprocessor->evaluate_vector_field(
+                      data.patch_values_system,
+                      data.postprocessed_values[dataset]);
                 }
 
-              for (unsigned int q = 0; q < n_q_points; ++q)
-                for (unsigned int component = 0;
-                     component < this->dof_data[dataset]->n_output_variables;
-                     ++component)
-                  patch.data(offset + component, q) =
-                    data.postprocessed_values[dataset][q](component);
+              if (contiguous_evaluation == false)
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  for (unsigned int component = 0;
+                       component < this->dof_data[dataset]->n_output_variables;
+                       ++component)
+                    patch.data(offset + component, q) =
+                      data.postprocessed_values[dataset][q](component);
             }
           else
             // now we use the given data vector without modifications. again,
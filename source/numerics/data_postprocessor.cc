@@ -21,11 +21,69 @@ DEAL_II_NAMESPACE_OPEN
 
 // -------------------------- DataPostprocessor ---------------------------
 
+namespace
+{
+  // copy the quantities stored one after the other for all points by the
+  // contiguous evaluation functions to one vector per point
+  void
+  copy_contiguous_quantities(const std::vector<float> &   contiguous,
+                             std::vector<Vector<double>> &computed_quantities)
+  {
+    const unsigned int n_points = computed_quantities.size();
+    for (unsigned int q = 0; q < n_points; ++q)
+      for (unsigned int c = 0; c < computed_quantities[q].size(); ++c)
+        computed_quantities[q](c) = contiguous[c * n_points + q];
+  }
+} // namespace
+
+
+
 template <int dim>
 void
 DataPostprocessor<dim>::evaluate_scalar_field(
+  const DataPostprocessorInputs::Scalar<dim> &input_data,
+  std::vector<Vector<double>> &               computed_quantities) const
+{
+  AssertThrow(supports_contiguous_evaluation(), ExcPureFunctionCalled());
+
+  std::vector<float> contiguous(computed_quantities.size() *
+                                get_names().size());
+  evaluate_scalar_field_contiguous(input_data, make_array_view(contiguous));
+  copy_contiguous_quantities(contiguous, computed_quantities);
+}
+
+
+
+template <int dim>
+void
+DataPostprocessor<dim>::evaluate_vector_field(
+  const DataPostprocessorInputs::Vector<dim> &input_data,
+  std::vector<Vector<double>> &               computed_quantities) const
+{
+  AssertThrow(supports_contiguous_evaluation(), ExcPureFunctionCalled());
+
+  std::vector<float> contiguous(computed_quantities.size() *
+                                get_names().size());
+  evaluate_vector_field_contiguous(input_data, make_array_view(contiguous));
+  copy_contiguous_quantities(contiguous, computed_quantities);
+}
+
+
+
+template <int dim>
+bool
+DataPostprocessor<dim>::supports_contiguous_evaluation() const
+{
+  return false;
+}
+
+
+
+template <int dim>
+void
+DataPostprocessor<dim>::evaluate_scalar_field_contiguous(
   const DataPostprocessorInputs::Scalar<dim> &,
-  std::vector<Vector<double>> &) const
+  const ArrayView<float> &) const
 {
   AssertThrow(false, ExcPureFunctionCalled());
 }
@@ -34,9 +92,9 @@ DataPostprocessor<dim>::evaluate_scalar_field(
 
 template <int dim>
 void
-DataPostprocessor<dim>::evaluate_vector_field(
+DataPostprocessor<dim>::evaluate_vector_field_contiguous(
   const DataPostprocessorInputs::Vector<dim> &,
-  std::vector<Vector<double>> &) const
+  const ArrayView<float> &) const
 {
   AssertThrow(false, ExcPureFunctionCalled());
 }
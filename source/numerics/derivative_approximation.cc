@@ -708,21 +708,65 @@ namespace DerivativeApproximation
   } // namespace internal
 } // namespace DerivativeApproximation
 
-// Dummy structures and dummy function used for WorkStream
+// Scratch and dummy copy data structures used for WorkStream
 namespace DerivativeApproximation
 {
   namespace internal
   {
     namespace Assembler
     {
-      struct Scratch
+      struct CopyData
       {
-        Scratch() = default;
+        CopyData() = default;
       };
 
-      struct CopyData
+      /**
+       * Scratch object for the evaluation of the finite element field at the
+       * cell centers. The hp::FEValues object is set up once per thread
+       * rather than once per cell.
+       */
+      template <int dim, int spacedim>
+      struct MidpointScratch
       {
-        CopyData() = default;
+        MidpointScratch(const hp::MappingCollection<dim, spacedim> &mapping,
+                        const hp::FECollection<dim, spacedim> &     fe,
+                        const hp::QCollection<dim> &                quadrature,
+                        const UpdateFlags                           flags)
+          : fe_midpoint_value(mapping, fe, quadrature, flags)
+        {}
+
+        MidpointScratch(const MidpointScratch &scratch)
+          : fe_midpoint_value(
+              scratch.fe_midpoint_value.get_mapping_collection(),
+              scratch.fe_midpoint_value.get_fe_collection(),
+              scratch.fe_midpoint_value.get_quadrature_collection(),
+              scratch.fe_midpoint_value.get_update_flags())
+        {}
+
+        hp::FEValues<dim, spacedim> fe_midpoint_value;
+      };
+
+      /**
+       * Scratch object for the loop over the cells, holding the list of
+       * active neighbors. The list is reused for all cells of a thread.
+       */
+      template <typename CellIterator>
+      struct NeighborScratch
+      {
+        NeighborScratch()
+        {
+          active_neighbors.reserve(
+            GeometryInfo<CellIterator::AccessorType::dimension>::
+              faces_per_cell *
+            GeometryInfo<
+              CellIterator::AccessorType::dimension>::max_children_per_face);
+        }
+
+        NeighborScratch(const NeighborScratch &)
+          : NeighborScratch()
+        {}
+
+        std::vector<CellIterator> active_neighbors;
       };
     } // namespace Assembler
   }   // namespace internal
@@ -911,53 +955,71 @@ namespace DerivativeApproximation
 
 
     /**
-     * Compute the derivative approximation on a given cell.  Fill the @p
-     * derivative_norm vector with the norm of the computed derivative tensors
-     * on the cell.
+     * Compute the derivative approximation on one cell from the projected
+     * derivatives and the centers of all cells that have been computed
+     * beforehand and are stored in @p midpoint_values and
+     * @p midpoint_centers, indexed by the active cell index. This is the
+     * same algorithm as in approximate_cell(), but does not evaluate the
+     * finite element field again on each neighbor.
      */
-    template <class DerivativeDescription,
-              int dim,
-              template <int, int> class DoFHandlerType,
-              class InputVector,
-              int spacedim>
+    template <class DerivativeDescription, int dim, typename CellIterator>
     void
-    approximate(
-      SynchronousIterators<std::tuple<
-        TriaActiveIterator<
-          dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>,
-        Vector<float>::iterator>> const &  cell,
-      const Mapping<dim, spacedim> &       mapping,
-      const DoFHandlerType<dim, spacedim> &dof_handler,
-      const InputVector &                  solution,
-      const unsigned int                   component)
+    approximate_cell_from_midpoints(
+      const CellIterator &cell,
+      const std::vector<typename DerivativeDescription::ProjectedDerivative>
+        &                            midpoint_values,
+      const std::vector<Point<dim>> &midpoint_centers,
+      std::vector<CellIterator> &    active_neighbors,
+      typename DerivativeDescription::Derivative &derivative)
     {
-      // if the cell is not locally owned, then there is nothing to do
-      if (std::get<0>(*cell)->is_locally_owned() == false)
-        *std::get<1>(*cell) = 0;
-      else
+      // matrix Y=sum_i y_i y_i^T
+      Tensor<2, dim> Y;
+
+      // vector g=sum_i y_i (f(x+y_i)-f(x))/|y_i| or related type for higher
+      // derivatives
+      typename DerivativeDescription::Derivative projected_derivative;
+
+      const typename DerivativeDescription::ProjectedDerivative
+        &this_midpoint_value = midpoint_values[cell->active_cell_index()];
+      const Point<dim> &this_center =
+        midpoint_centers[cell->active_cell_index()];
+
+      GridTools::get_active_neighbors<
+        typename CellIterator::AccessorType::Container>(cell,
+                                                        active_neighbors);
+      for (const auto &neighbor : active_neighbors)
         {
-          typename DerivativeDescription::Derivative derivative;
-          // call the function doing the actual
-          // work on this cell
-          approximate_cell<DerivativeDescription,
-                           dim,
-                           DoFHandlerType,
-                           InputVector,
-                           spacedim>(mapping,
-                                     dof_handler,
-                                     solution,
-                                     component,
-                                     std::get<0>(*cell),
-                                     derivative);
-
-          // evaluate the norm and fill the vector
-          //*derivative_norm_on_this_cell
-          *std::get<1>(*cell) =
-            DerivativeDescription::derivative_norm(derivative);
+          const unsigned int index = neighbor->active_cell_index();
+
+          // vector for the normalized direction between the centers of two
+          // cells
+          Tensor<1, dim> y        = midpoint_centers[index] - this_center;
+          const double   distance = y.norm();
+          y /= distance;
+
+          for (unsigned int i = 0; i < dim; ++i)
+            for (unsigned int j = 0; j < dim; ++j)
+              Y[i][j] += y[i] * y[j];
+
+          typename DerivativeDescription::ProjectedDerivative
+            projected_finite_difference =
+              (midpoint_values[index] - this_midpoint_value);
+          projected_finite_difference /= distance;
+
+          projected_derivative += outer_product(y, projected_finite_difference);
         }
+
+      AssertThrow(determinant(Y) != 0, ExcInsufficientDirections());
+
+      const Tensor<2, dim> Y_inverse = invert(Y);
+
+      derivative = Y_inverse * projected_derivative;
+
+      DerivativeDescription::symmetrize(derivative);
     }
 
 
+
     /**
      * Kind of the main function of this class. It is called by the public entry
      * points to this class with the correct template first argument and then
@@ -988,35 +1050,85 @@ namespace DerivativeApproximation
       Assert(component < dof_handler.get_fe(0).n_components(),
              ExcIndexRange(component, 0, dof_handler.get_fe(0).n_components()));
 
-      using Iterators = std::tuple<
-        TriaActiveIterator<
-          dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>,
-        Vector<float>::iterator>;
+      using CellIterator = TriaActiveIterator<
+        dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>;
+
+      // every cell enters the difference quotients of all its neighbors, so
+      // we first evaluate the projected derivative and the center on each
+      // locally owned and ghost cell only once and store the result by the
+      // active cell index. the neighbors of locally owned cells are all in
+      // this set of cells
+      const unsigned int n_active_cells =
+        dof_handler.get_triangulation().n_active_cells();
+      std::vector<typename DerivativeDescription::ProjectedDerivative>
+                              midpoint_values(n_active_cells);
+      std::vector<Point<dim>> midpoint_centers(n_active_cells);
+
+      const QMidpoint<dim>                       midpoint_rule;
+      const hp::QCollection<dim>                 q_collection(midpoint_rule);
+      const hp::MappingCollection<dim, spacedim> mapping_collection(mapping);
+
+      // There is no need for a copier in both loops because there is no
+      // conflict between threads to write into the arrays indexed by the
+      // cells.
+      WorkStream::run(
+        dof_handler.begin_active(),
+        static_cast<CellIterator>(dof_handler.end()),
+        [&](const CellIterator &cell,
+            Assembler::MidpointScratch<dim, spacedim> &scratch,
+            Assembler::CopyData &) {
+          if (cell->is_artificial())
+            return;
+
+          scratch.fe_midpoint_value.reinit(cell);
+          const FEValues<dim, spacedim> &fe_midpoint_value =
+            scratch.fe_midpoint_value.get_present_fe_values();
+          midpoint_values[cell->active_cell_index()] =
+            DerivativeDescription::get_projected_derivative(fe_midpoint_value,
+                                                            solution,
+                                                            component);
+          midpoint_centers[cell->active_cell_index()] =
+            fe_midpoint_value.quadrature_point(0);
+        },
+        std::function<void(internal::Assembler::CopyData const &)>(),
+        Assembler::MidpointScratch<dim, spacedim>(
+          mapping_collection,
+          dof_handler.get_fe_collection(),
+          q_collection,
+          DerivativeDescription::update_flags | update_quadrature_points),
+        internal::Assembler::CopyData());
+
+      // then the derivatives on the locally owned cells only combine the
+      // stored values of the cell and its neighbors
+      using Iterators = std::tuple<CellIterator, Vector<float>::iterator>;
       SynchronousIterators<Iterators> begin(
         Iterators(dof_handler.begin_active(), derivative_norm.begin())),
         end(Iterators(dof_handler.end(), derivative_norm.end()));
 
-      // There is no need for a copier because there is no conflict between
-      // threads to write in derivative_norm. Scratch and CopyData are also
-      // useless.
       WorkStream::run(
         begin,
         end,
-        static_cast<std::function<void(SynchronousIterators<Iterators> const &,
-                                       Assembler::Scratch const &,
-                                       Assembler::CopyData &)>>(
-          std::bind(&approximate<DerivativeDescription,
-                                 dim,
-                                 DoFHandlerType,
-                                 InputVector,
-                                 spacedim>,
-                    std::placeholders::_1,
-                    std::cref(mapping),
-                    std::cref(dof_handler),
-                    std::cref(solution),
-                    component)),
+        [&](const SynchronousIterators<Iterators> &     cell,
+            Assembler::NeighborScratch<CellIterator> &scratch,
+            Assembler::CopyData &) {
+          const CellIterator &this_cell = std::get<0>(*cell);
+          if (this_cell->is_locally_owned() == false)
+            *std::get<1>(*cell) = 0;
+          else
+            {
+              typename DerivativeDescription::Derivative derivative;
+              approximate_cell_from_midpoints<DerivativeDescription, dim>(
+                this_cell,
+                midpoint_values,
+                midpoint_centers,
+                scratch.active_neighbors,
+                derivative);
+              *std::get<1>(*cell) =
+                DerivativeDescription::derivative_norm(derivative);
+            }
+        },
         std::function<void(internal::Assembler::CopyData const &)>(),
-        internal::Assembler::Scratch(),
+        Assembler::NeighborScratch<CellIterator>(),
         internal::Assembler::CopyData());
     }
 
@@ -17,8 +17,11 @@
 
 #ifdef DEAL_II_WITH_NANOFLANN
 
+#  include <deal.II/base/parallel.h>
 #  include <deal.II/base/std_cxx14/memory.h>
 
+#  include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -26,6 +29,7 @@ template <int dim>
 KDTree<dim>::KDTree(const unsigned int             max_leaf_size,
                     const std::vector<Point<dim>> &pts)
   : max_leaf_size(max_leaf_size)
+  , max_displacement(0.)
 {
   if (pts.size() > 0)
     set_points(pts);
@@ -47,17 +51,37 @@ KDTree<dim>::get_points_within_ball(const Point<dim> &center,
   nanoflann::SearchParams params;
   params.sorted = sorted;
 
+  // if the points have moved since the tree was built, the bounds stored in
+  // the tree refer to the old locations, whereas the distances are computed
+  // from the current locations. every point within the radius is then
+  // within the enlarged radius of its old location and thus found
+  const double search_radius = radius + max_displacement;
+
   std::vector<std::pair<unsigned int, double>> matches;
 #  if NANOFLANN_VERSION < 0x130
-  kdtree->radiusSearch(center.begin_raw(), radius, matches, params);
+  kdtree->radiusSearch(center.begin_raw(), search_radius, matches, params);
 #  else
   // nanoflann 1.3 performs distance comparisons with squared distances, so
   // square the radius before we query and square root after:
-  kdtree->radiusSearch(center.begin_raw(), radius * radius, matches, params);
+  kdtree->radiusSearch(center.begin_raw(),
+                       search_radius * search_radius,
+                       matches,
+                       params);
   for (std::pair<unsigned int, double> &match : matches)
     match.second = std::sqrt(match.second);
 #  endif
 
+  if (max_displacement > 0.)
+    {
+      const auto outside_ball =
+        [radius](const std::pair<unsigned int, double> &match) {
+          return match.second > radius;
+        };
+      matches.erase(
+        std::remove_if(matches.begin(), matches.end(), outside_ball),
+        matches.end());
+    }
+
   return matches;
 }
 
@@ -91,6 +115,65 @@ KDTree<dim>::get_closest_points(const Point<dim> & target,
     matches[i] = std::make_pair(indices[i], std::sqrt(distances[i]));
 #  endif
 
+  // after the points have moved, the search above may miss closer points
+  // since the tree prunes with the old locations. the points found are at
+  // most as far away as the most distant of them, so a ball search with
+  // this radius, which accounts for the displacement, gives all candidates.
+  // if all points found coincide with the target, no point can be closer
+  if (max_displacement > 0.)
+    {
+      double radius = 0.;
+      for (const std::pair<unsigned int, double> &match : matches)
+        radius = std::max(radius, match.second);
+      if (radius > 0.)
+        {
+          matches = get_points_within_ball(target, radius, true);
+          if (matches.size() > n_points)
+            matches.resize(n_points);
+        }
+    }
+
+  return matches;
+}
+
+
+
+template <int dim>
+std::vector<std::vector<std::pair<unsigned int, double>>>
+KDTree<dim>::get_points_within_ball(const std::vector<Point<dim>> &targets,
+                                    const double                   radius,
+                                    const bool                     sorted) const
+{
+  std::vector<std::vector<std::pair<unsigned int, double>>> matches(
+    targets.size());
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(targets.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        matches[i] = get_points_within_ball(targets[i], radius, sorted);
+    },
+    64);
+  return matches;
+}
+
+
+
+template <int dim>
+std::vector<std::vector<std::pair<unsigned int, double>>>
+KDTree<dim>::get_closest_points(const std::vector<Point<dim>> &targets,
+                                const unsigned int             n_points) const
+{
+  std::vector<std::vector<std::pair<unsigned int, double>>> matches(
+    targets.size());
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(targets.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        matches[i] = get_closest_points(targets[i], n_points);
+    },
+    64);
   return matches;
 }
 
@@ -105,6 +188,22 @@ KDTree<dim>::set_points(const std::vector<Point<dim>> &pts)
   kdtree  = std_cxx14::make_unique<NanoFlannKDTree>(
     dim, *adaptor, nanoflann::KDTreeSingleIndexAdaptorParams(max_leaf_size));
   kdtree->buildIndex();
+  max_displacement = 0.;
+}
+
+
+
+template <int dim>
+void
+KDTree<dim>::update_points(const double max_displacement)
+{
+  Assert(adaptor, ExcNotInitialized());
+  Assert(max_displacement >= 0.,
+         ExcMessage("The displacement is expected to be non-negative."));
+  Assert(kdtree->size() == adaptor->points.size(),
+         ExcMessage("The number of points has changed since the tree was "
+                    "built. Call set_points() instead."));
+  this->max_displacement = max_displacement;
 }
 
 
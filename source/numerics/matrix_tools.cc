@@ -15,6 +15,7 @@
 
 #include <deal.II/base/function.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/work_stream.h>
 
@@ -237,6 +238,162 @@ namespace MatrixTools
 
 
 
+  void
+  BoundaryValueEliminator::reinit(
+    const SparsityPattern &                     sparsity_pattern,
+    const std::vector<types::global_dof_index> &boundary_dofs)
+  {
+    Assert(sparsity_pattern.is_compressed(),
+           SparsityPatternBase::ExcNotCompressed());
+    Assert(sparsity_pattern.n_rows() == sparsity_pattern.n_cols(),
+           ExcNotQuadratic());
+    Assert(std::is_sorted(boundary_dofs.begin(), boundary_dofs.end()),
+           ExcMessage("The constrained degrees of freedom need to be sorted."));
+
+    this->sparsity_pattern = &sparsity_pattern;
+    this->boundary_dofs    = boundary_dofs;
+
+    const types::global_dof_index n_dofs = sparsity_pattern.n_rows();
+    std::vector<unsigned int>     boundary_index(n_dofs,
+                                             numbers::invalid_unsigned_int);
+    for (unsigned int i = 0; i < boundary_dofs.size(); ++i)
+      {
+        AssertIndexRange(boundary_dofs[i], n_dofs);
+        boundary_index[boundary_dofs[i]] = i;
+      }
+
+    // go through the rows of the unconstrained degrees of freedom and
+    // record their entries in the columns of the constrained ones, in the
+    // order of the columns in which apply_boundary_values() visits them
+    coupled_rows.clear();
+    coupled_row_starts.assign(1, 0);
+    coupled_entries.clear();
+    coupled_entry_boundary_indices.clear();
+    for (types::global_dof_index row = 0; row < n_dofs; ++row)
+      if (boundary_index[row] == numbers::invalid_unsigned_int)
+        {
+          const std::size_t n_entries_before = coupled_entries.size();
+          for (auto entry = sparsity_pattern.begin(row);
+               entry != sparsity_pattern.end(row);
+               ++entry)
+            if (boundary_index[entry->column()] !=
+                numbers::invalid_unsigned_int)
+              {
+                coupled_entries.push_back(entry->global_index());
+                coupled_entry_boundary_indices.push_back(
+                  boundary_index[entry->column()]);
+              }
+          if (coupled_entries.size() > n_entries_before)
+            {
+              coupled_rows.push_back(row);
+              coupled_row_starts.push_back(coupled_entries.size());
+            }
+        }
+  }
+
+
+
+  template <typename number>
+  void
+  BoundaryValueEliminator::apply(
+    const std::map<types::global_dof_index, number> &boundary_values,
+    SparseMatrix<number> &                           matrix,
+    Vector<number> &                                 solution,
+    Vector<number> &                                 right_hand_side,
+    const bool                                       eliminate_columns) const
+  {
+    Assert(sparsity_pattern != nullptr,
+           ExcMessage("You need to call reinit() before apply()."));
+    Assert(&matrix.get_sparsity_pattern() == sparsity_pattern,
+           ExcMessage("The matrix needs to be based on the sparsity pattern "
+                      "given to reinit()."));
+    Assert(matrix.n() == right_hand_side.size(),
+           ExcDimensionMismatch(matrix.n(), right_hand_side.size()));
+    Assert(matrix.n() == solution.size(),
+           ExcDimensionMismatch(matrix.n(), solution.size()));
+    AssertDimension(boundary_values.size(), boundary_dofs.size());
+
+    if (boundary_dofs.size() == 0)
+      return;
+
+    // as in apply_boundary_values(), replace zero diagonal entries by the
+    // first nonzero diagonal entry of the matrix, or 1 if there is none
+    number first_nonzero_diagonal_entry = 1;
+    for (unsigned int i = 0; i < matrix.m(); ++i)
+      if (matrix.diag_element(i) != number())
+        {
+          first_nonzero_diagonal_entry = matrix.diag_element(i);
+          break;
+        }
+
+    std::vector<number> values;
+    values.reserve(boundary_dofs.size());
+    for (const auto &boundary_value : boundary_values)
+      {
+        Assert(boundary_value.first == boundary_dofs[values.size()],
+               ExcMessage("The boundary values need to be given for the "
+                          "degrees of freedom given to reinit()."));
+        values.push_back(boundary_value.second);
+      }
+
+    // first treat the rows of the constrained degrees of freedom, storing
+    // the new right hand side entries and diagonal entries for the
+    // elimination of the columns
+    std::vector<number> new_rhs(boundary_dofs.size());
+    std::vector<number> diagonal_entries(boundary_dofs.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(boundary_dofs.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            const types::global_dof_index dof_number = boundary_dofs[i];
+            for (typename SparseMatrix<number>::iterator p =
+                   matrix.begin(dof_number);
+                 p != matrix.end(dof_number);
+                 ++p)
+              if (p->column() != dof_number)
+                p->value() = 0.;
+
+            if (matrix.diag_element(dof_number) == number())
+              matrix.diag_element(dof_number) = first_nonzero_diagonal_entry;
+            diagonal_entries[i]         = matrix.diag_element(dof_number);
+            new_rhs[i]                  = values[i] * diagonal_entries[i];
+            right_hand_side(dof_number) = new_rhs[i];
+            solution(dof_number)        = values[i];
+          }
+      },
+      64);
+
+    // then eliminate the columns row by row, so that every row of the
+    // matrix and every entry of the right hand side is only modified by one
+    // thread
+    if (eliminate_columns)
+      parallel::apply_to_subranges(
+        0U,
+        static_cast<unsigned int>(coupled_rows.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int r = begin; r < end; ++r)
+            {
+              const types::global_dof_index row = coupled_rows[r];
+              for (std::size_t e = coupled_row_starts[r];
+                   e < coupled_row_starts[r + 1];
+                   ++e)
+                {
+                  const unsigned int i = coupled_entry_boundary_indices[e];
+                  const typename SparseMatrix<number>::iterator p(
+                    &matrix, coupled_entries[e]);
+                  right_hand_side(row) -= static_cast<number>(p->value()) /
+                                          diagonal_entries[i] * new_rhs[i];
+                  p->value() = 0.;
+                }
+            }
+        },
+        64);
+  }
+
+
+
   template <typename number>
   void
   apply_boundary_values(
@@ -14,6 +14,8 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/std_cxx14/memory.h>
+
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/la_parallel_vector.h>
@@ -156,6 +158,9 @@ PointValueHistory<dim>::operator=(const PointValueHistory &point_value_history)
   have_dof_handler      = point_value_history.have_dof_handler;
   n_indep               = point_value_history.n_indep;
 
+  // the cache refers to the old triangulation, create it again when needed
+  requested_location_cache.reset();
+
   // What to do with tria_listener?
   // Presume subscribe new instance?
   if (have_dof_handler)
@@ -174,6 +179,8 @@ PointValueHistory<dim>::operator=(const PointValueHistory &point_value_history)
 template <int dim>
 PointValueHistory<dim>::~PointValueHistory()
 {
+  wait_for_background_write();
+
   if (have_dof_handler)
     {
       tria_listener.disconnect();
@@ -217,6 +224,12 @@ PointValueHistory<dim>::add_point(const Point<dim> &location)
     dof_handler->begin_active();
   typename DoFHandler<dim>::active_cell_iterator endc = dof_handler->end();
 
+  // on distributed triangulations, the dof indices are only known on the
+  // locally owned and ghost cells
+  while (cell != endc && cell->is_artificial())
+    ++cell;
+  Assert(cell != endc, ExcInternalError());
+
   // default values to be replaced as closer
   // points are found however they need to be
   // consistent in case they are actually
@@ -249,6 +262,8 @@ PointValueHistory<dim>::add_point(const Point<dim> &location)
 
   for (; cell != endc; cell++)
     {
+      if (cell->is_artificial())
+        continue;
       fe_values.reinit(cell);
 
       for (unsigned int support_point = 0; support_point < n_support_points;
@@ -362,6 +377,12 @@ PointValueHistory<dim>::add_points(const std::vector<Point<dim>> &locations)
     dof_handler->begin_active();
   typename DoFHandler<dim>::active_cell_iterator endc = dof_handler->end();
 
+  // on distributed triangulations, the dof indices are only known on the
+  // locally owned and ghost cells
+  while (cell != endc && cell->is_artificial())
+    ++cell;
+  Assert(cell != endc, ExcInternalError());
+
   // default values to be replaced as closer
   // points are found however they need to be
   // consistent in case they are actually
@@ -401,6 +422,8 @@ PointValueHistory<dim>::add_points(const std::vector<Point<dim>> &locations)
   // because it operates on a set of points.
   for (; cell != endc; cell++)
     {
+      if (cell->is_artificial())
+        continue;
       fe_values.reinit(cell);
       for (unsigned int support_point = 0; support_point < n_support_points;
            support_point++)
@@ -570,6 +593,7 @@ PointValueHistory<dim>::clear()
   cleared          = true;
   dof_handler      = nullptr;
   have_dof_handler = false;
+  requested_location_cache.reset();
 }
 
 // Need to test that the internal data has a full and complete dataset for
@@ -933,34 +957,91 @@ PointValueHistory<dim>::evaluate_field_at_requested_location(
   unsigned int n_stored =
     mask->second.n_selected_components(dof_handler->get_fe(0).n_components());
 
-  typename std::vector<
-    internal::PointValueHistoryImplementation::PointGeometryData<dim>>::iterator
-                 point = point_geometry_data.begin();
-  Vector<number> value(dof_handler->get_fe(0).n_components());
-  for (unsigned int data_store_index = 0; point != point_geometry_data.end();
-       ++point, ++data_store_index)
+  // locate all requested points on the mesh, which only needs to be done
+  // again after the triangulation has changed
+  if (requested_location_cache == nullptr)
     {
-      // Make a Vector <double> for the value
-      // at the point. It will have as many
-      // components as there are in the fe.
-      VectorTools::point_value(*dof_handler,
-                               solution,
-                               point->requested_location,
-                               value);
-
-      // Look up the component_mask and add
-      // in components according to that mask
-      for (unsigned int store_index = 0, comp = 0; comp < mask->second.size();
-           comp++)
+      std::vector<Point<dim>> locations;
+      locations.reserve(point_geometry_data.size());
+      for (const auto &point : point_geometry_data)
+        locations.push_back(point.requested_location);
+
+      requested_location_cache =
+        std_cxx14::make_unique<Utilities::MPI::RemotePointEvaluation<dim>>();
+      requested_location_cache->reinit(locations,
+                                       dof_handler->get_triangulation(),
+                                       StaticMappingQ1<dim>::mapping);
+      AssertThrow(requested_location_cache->all_points_found(),
+                  ExcMessage("Not all requested locations lie within the "
+                             "mesh."));
+    }
+  const Utilities::MPI::RemotePointEvaluation<dim> &cache =
+    *requested_location_cache;
+
+  // evaluate the selected components at all points on the locally owned
+  // cells, with one FEValues object for all points of a cell
+  const auto evaluation_function =
+    [&](const ArrayView<std::vector<double>> &values,
+        const typename Utilities::MPI::RemotePointEvaluation<dim>::CellData
+          &cell_data) {
+      for (unsigned int i = 0; i < cell_data.cells.size(); ++i)
         {
-          if (mask->second[comp])
+          const typename DoFHandler<dim>::active_cell_iterator cell(
+            &cache.get_triangulation(),
+            cell_data.cells[i].first,
+            cell_data.cells[i].second,
+            dof_handler);
+
+          const unsigned int begin = cell_data.reference_point_ptrs[i];
+          const unsigned int end   = cell_data.reference_point_ptrs[i + 1];
+
+          const Quadrature<dim> quadrature(std::vector<Point<dim>>(
+            cell_data.reference_point_values.begin() + begin,
+            cell_data.reference_point_values.begin() + end));
+          FEValues<dim> fe_values(cache.get_mapping(),
+                                  cell->get_fe(),
+                                  quadrature,
+                                  update_values);
+          fe_values.reinit(cell);
+
+          std::vector<Vector<number>> point_values(
+            end - begin, Vector<number>(cell->get_fe().n_components()));
+          fe_values.get_function_values(solution, point_values);
+
+          for (unsigned int q = 0; q < end - begin; ++q)
             {
-              data_store_field
-                ->second[data_store_index * n_stored + store_index]
-                .push_back(value(comp));
-              store_index++;
+              values[begin + q].clear();
+              for (unsigned int comp = 0; comp < mask->second.size(); comp++)
+                if (mask->second[comp])
+                  values[begin + q].push_back(point_values[q](comp));
             }
         }
+    };
+
+  std::vector<std::vector<double>> evaluation_results, buffer;
+  cache.template evaluate_and_process<std::vector<double>>(evaluation_results,
+                                                           buffer,
+                                                           evaluation_function);
+
+  // add the values in the order of the points, averaging the values of
+  // points that have been found on several cells
+  const std::vector<unsigned int> &point_ptrs = cache.get_point_ptrs();
+  for (unsigned int data_store_index = 0;
+       data_store_index < point_geometry_data.size();
+       ++data_store_index)
+    {
+      const unsigned int n_values =
+        point_ptrs[data_store_index + 1] - point_ptrs[data_store_index];
+      for (unsigned int store_index = 0; store_index < n_stored; store_index++)
+        {
+          double value = 0;
+          for (unsigned int j = point_ptrs[data_store_index];
+               j < point_ptrs[data_store_index + 1];
+               ++j)
+            value += evaluation_results[j][store_index];
+          data_store_field->second[data_store_index * n_stored + store_index]
+            .push_back(value / n_values);
+        }
     }
 }
 
@@ -1214,6 +1295,48 @@ PointValueHistory<dim>::write_gnuplot(
 
 
 
+template <int dim>
+void
+PointValueHistory<dim>::write_gnuplot_in_background(
+  const std::string &            base_name,
+  const std::vector<Point<dim>> &postprocessor_locations)
+{
+  AssertThrow(closed, ExcInvalidState());
+  AssertThrow(!cleared, ExcInvalidState());
+  AssertThrow(deep_check(true), ExcDataLostSync());
+
+  // only one write at a time, the files might have the same names
+  wait_for_background_write();
+
+  // the copy is written on the task, while the data of the current object
+  // may be changed. the copy does not need to listen to the triangulation,
+  // its data does not change any more
+  const std::shared_ptr<PointValueHistory<dim>> snapshot =
+    std::make_shared<PointValueHistory<dim>>(*this);
+  if (snapshot->have_dof_handler)
+    snapshot->tria_listener.disconnect();
+
+  write_task =
+    Threads::new_task([snapshot, base_name, postprocessor_locations]() {
+      snapshot->write_gnuplot(base_name, postprocessor_locations);
+    });
+}
+
+
+
+template <int dim>
+void
+PointValueHistory<dim>::wait_for_background_write()
+{
+  if (write_task.joinable())
+    {
+      write_task.join();
+      write_task = Threads::Task<>();
+    }
+}
+
+
+
 template <int dim>
 Vector<double>
 PointValueHistory<dim>::mark_support_locations()
@@ -1526,6 +1649,9 @@ PointValueHistory<dim>::tria_change_listener()
   // this into account next time we
   // evaluate the solution
   triangulation_changed = true;
+
+  // the cells of the requested locations need to be found again
+  requested_location_cache.reset();
 }
 
 
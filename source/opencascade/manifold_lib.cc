@@ -23,17 +23,24 @@
 #  include <BRepAdaptor_Curve.hxx>
 #  include <BRepAdaptor_HCompCurve.hxx>
 #  include <BRepAdaptor_HCurve.hxx>
+#  include <BRepBndLib.hxx>
 #  include <BRepTools.hxx>
+#  include <BRep_Builder.hxx>
 #  include <BRep_Tool.hxx>
+#  include <Bnd_Box.hxx>
 #  include <GCPnts_AbscissaPoint.hxx>
 #  include <ShapeAnalysis_Curve.hxx>
 #  include <ShapeAnalysis_Surface.hxx>
 #  include <Standard_Version.hxx>
+#  include <TopExp_Explorer.hxx>
 #  include <TopoDS.hxx>
+#  include <TopoDS_Compound.hxx>
 #  if (OCC_VERSION_MAJOR < 7)
 #    include <Handle_Adaptor3d_HCurve.hxx>
 #  endif
 
+#  include <limits>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -73,6 +80,36 @@ namespace OpenCASCADE
       Handle_Adaptor3d_HCurve adapt = curve_adaptor(sh);
       return GCPnts_AbscissaPoint::Length(adapt->GetCurve());
     }
+
+
+
+    /**
+     * Fill @p faces with the faces of the given shape, and return an RTree
+     * of their bounding boxes, each one paired with the index of the face in
+     * @p faces. Faces without a bounding box are skipped.
+     */
+    template <int spacedim>
+    RTree<std::pair<BoundingBox<spacedim>, unsigned int>>
+    build_face_tree(const TopoDS_Shape &sh, std::vector<TopoDS_Face> &faces)
+    {
+      std::vector<std::pair<BoundingBox<spacedim>, unsigned int>> boxes;
+      for (TopExp_Explorer exp(sh, TopAbs_FACE); exp.More(); exp.Next())
+        {
+          const TopoDS_Face face = TopoDS::Face(exp.Current());
+
+          Bnd_Box box;
+          BRepBndLib::Add(face, box);
+          if (box.IsVoid())
+            continue;
+
+          const BoundingBox<spacedim> face_box(
+            std::make_pair(point<spacedim>(box.CornerMin()),
+                           point<spacedim>(box.CornerMax())));
+          boxes.emplace_back(face_box, faces.size());
+          faces.push_back(face);
+        }
+      return pack_rtree(boxes);
+    }
   } // namespace
 
   /*============================== NormalProjectionManifold
@@ -83,6 +120,8 @@ namespace OpenCASCADE
     const double        tolerance)
     : sh(sh)
     , tolerance(tolerance)
+    , face_tree(build_face_tree<spacedim>(sh, faces))
+    , last_face(numbers::invalid_unsigned_int)
   {
     Assert(spacedim == 3, ExcNotImplemented());
   }
@@ -113,7 +152,48 @@ namespace OpenCASCADE
                std::max(tolerance * surrounding_points[i].norm(), tolerance),
              ExcPointNotOnManifold<spacedim>(surrounding_points[i]));
 #  endif
-    return closest_point(sh, candidate, tolerance);
+    // Shapes without faces, such as collections of edges, are projected
+    // onto as a whole
+    if (faces.empty())
+      return closest_point(sh, candidate, tolerance);
+
+    // Start with the face that received the last point, which in all
+    // likelihood is close to the current one...
+    unsigned int &  last = last_face.get();
+    Point<spacedim> projection;
+    double          min_distance = std::numeric_limits<double>::max();
+    if (last < faces.size())
+      {
+        projection   = closest_point(faces[last], candidate, tolerance);
+        min_distance = projection.distance(candidate);
+      }
+
+    // ...and then visit the faces in the order of the distance of their
+    // bounding boxes from the candidate point. Once a bounding box is
+    // farther away than the closest projection found so far, none of the
+    // remaining faces can contain a closer point.
+    namespace bgi = boost::geometry::index;
+    for (auto it = face_tree.qbegin(bgi::nearest(candidate, faces.size()));
+         it != face_tree.qend();
+         ++it)
+      {
+        if (boost::geometry::distance(candidate, it->first) > min_distance)
+          break;
+        if (it->second == last)
+          continue;
+
+        const Point<spacedim> face_projection =
+          closest_point(faces[it->second], candidate, tolerance);
+        const double distance = face_projection.distance(candidate);
+        if (distance < min_distance)
+          {
+            projection   = face_projection;
+            min_distance = distance;
+            last         = it->second;
+          }
+      }
+
+    return projection;
   }
 
 
@@ -127,8 +207,19 @@ namespace OpenCASCADE
     : sh(sh)
     , direction(direction)
     , tolerance(tolerance)
+    , face_tree(build_face_tree<spacedim>(sh, faces))
   {
     Assert(spacedim == 3, ExcNotImplemented());
+
+    bool first_box = true;
+    for (const auto &entry : face_tree)
+      if (first_box)
+        {
+          shape_box = entry.first;
+          first_box = false;
+        }
+      else
+        shape_box.merge_with(entry.first);
   }
 
 
@@ -157,7 +248,34 @@ namespace OpenCASCADE
                std::max(tolerance * surrounding_points[i].norm(), tolerance),
              ExcPointNotOnManifold<spacedim>(surrounding_points[i]));
 #  endif
-    return line_intersection(sh, candidate, direction, tolerance);
+    if (faces.empty())
+      return line_intersection(sh, candidate, direction, tolerance);
+
+    // Represent the line through the candidate point by a segment that is
+    // long enough to cross the bounding box of the whole shape, and collect
+    // the faces whose bounding boxes the segment intersects
+    const std::pair<Point<spacedim>, Point<spacedim>> &corners =
+      shape_box.get_boundary_points();
+    const double length =
+      corners.first.distance(corners.second) +
+      candidate.distance(0.5 * (corners.first + corners.second));
+    const Tensor<1, spacedim> offset = length / direction.norm() * direction;
+    const Segment<spacedim>   line(candidate - offset, candidate + offset);
+
+    namespace bgi = boost::geometry::index;
+    std::vector<std::pair<BoundingBox<spacedim>, unsigned int>> candidates;
+    face_tree.query(bgi::intersects(line), std::back_inserter(candidates));
+
+    if (candidates.empty())
+      return line_intersection(sh, candidate, direction, tolerance);
+
+    TopoDS_Compound candidate_faces;
+    BRep_Builder    builder;
+    builder.MakeCompound(candidate_faces);
+    for (const auto &entry : candidates)
+      builder.Add(candidate_faces, faces[entry.second]);
+
+    return line_intersection(candidate_faces, candidate, direction, tolerance);
   }
 
 
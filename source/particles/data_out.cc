@@ -0,0 +1,313 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/particles/data_out.h>
+
+#include <sstream>
+
+DEAL_II_NAMESPACE_OPEN
+
+#ifdef DEAL_II_WITH_P4EST
+
+namespace Particles
+{
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::build_output(
+    const ParticleHandler<dim, spacedim> &particle_handler,
+    const std::vector<std::string> &      data_component_names,
+    const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+      &data_component_interpretations)
+  {
+    Assert(data_component_names.size() == 0 ||
+             data_component_names.size() ==
+               particle_handler.n_properties_per_particle(),
+           ExcMessage("The number of data component names has to be zero "
+                      "or equal to the number of properties per particle."));
+    Assert(data_component_interpretations.size() == 0 ||
+             data_component_interpretations.size() ==
+               data_component_names.size(),
+           ExcDimensionMismatch(data_component_interpretations.size(),
+                                data_component_names.size()));
+
+    this->particle_handler = &particle_handler;
+
+    // group the properties into fields: a vector field consists of the
+    // consecutive properties with the same name that are marked as part of
+    // a vector
+    fields.clear();
+    const auto is_part_of_vector = [&](const unsigned int i) {
+      return data_component_interpretations.size() > 0 &&
+             data_component_interpretations[i] ==
+               DataComponentInterpretation::component_is_part_of_vector;
+    };
+    for (unsigned int i = 0; i < data_component_names.size();)
+      {
+        unsigned int n_components = 1;
+        if (is_part_of_vector(i))
+          while (i + n_components < data_component_names.size() &&
+                 is_part_of_vector(i + n_components) &&
+                 data_component_names[i + n_components] ==
+                   data_component_names[i])
+            ++n_components;
+        AssertThrow(n_components <= 3,
+                    ExcMessage("Can't declare a vector with more than 3 "
+                               "components in VTK"));
+
+        if (!data_component_names[i].empty())
+          fields.emplace_back(data_component_names[i], i, n_components);
+        i += n_components;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::set_flags(const DataOutBase::VtkFlags &flags)
+  {
+    vtk_flags = flags;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::write_vtu(std::ostream &out) const
+  {
+    DataOutBase::write_vtu_header(out, vtk_flags);
+    write_vtu_piece(out);
+    DataOutBase::write_vtu_footer(out);
+
+    out << std::flush;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::write_vtu_in_parallel(const std::string &filename,
+                                                const MPI_Comm &   comm) const
+  {
+    const int myrank = Utilities::MPI::this_mpi_process(comm);
+
+    MPI_Info info;
+    int      ierr = MPI_Info_create(&info);
+    AssertThrowMPI(ierr);
+    MPI_File fh;
+    ierr = MPI_File_open(comm,
+                         DEAL_II_MPI_CONST_CAST(filename.c_str()),
+                         MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                         info,
+                         &fh);
+    AssertThrowMPI(ierr);
+
+    ierr = MPI_File_set_size(fh, 0); // delete the file contents
+    AssertThrowMPI(ierr);
+    // this barrier is necessary, because otherwise others might already
+    // write while one core is still setting the size to zero.
+    ierr = MPI_Barrier(comm);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Info_free(&info);
+    AssertThrowMPI(ierr);
+
+    unsigned int header_size;
+
+    // write header
+    if (myrank == 0)
+      {
+        std::stringstream ss;
+        DataOutBase::write_vtu_header(ss, vtk_flags);
+        header_size = ss.str().size();
+        ierr        = MPI_File_write(fh,
+                              DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
+                              header_size,
+                              MPI_CHAR,
+                              MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+    ierr = MPI_Bcast(&header_size, 1, MPI_UNSIGNED, 0, comm);
+    AssertThrowMPI(ierr);
+
+    ierr = MPI_File_seek_shared(fh, header_size, MPI_SEEK_SET);
+    AssertThrowMPI(ierr);
+    {
+      std::stringstream ss;
+      write_vtu_piece(ss);
+      const std::string piece = ss.str();
+      ierr = MPI_File_write_ordered(fh,
+                                    DEAL_II_MPI_CONST_CAST(piece.c_str()),
+                                    piece.size(),
+                                    MPI_CHAR,
+                                    MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+
+    // write footer
+    if (myrank == 0)
+      {
+        std::stringstream ss;
+        DataOutBase::write_vtu_footer(ss);
+        const unsigned int footer_size = ss.str().size();
+        ierr = MPI_File_write_shared(fh,
+                                     DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
+                                     footer_size,
+                                     MPI_CHAR,
+                                     MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+    ierr = MPI_File_close(&fh);
+    AssertThrowMPI(ierr);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DataOut<dim, spacedim>::write_vtu_piece(std::ostream &out) const
+  {
+    Assert(particle_handler != nullptr,
+           ExcMessage("You need to call build_output() first."));
+    AssertThrow(out, ExcIO());
+
+#  ifdef DEAL_II_WITH_ZLIB
+    const char *ascii_or_binary = "binary";
+#  else
+    const char *ascii_or_binary = "ascii";
+#  endif
+
+    const unsigned int n_particles =
+      particle_handler->n_locally_owned_particles();
+
+    // every array below is only kept while it is written
+    out << "<Piece NumberOfPoints=\"" << n_particles << "\" NumberOfCells=\""
+        << n_particles << "\" >\n";
+    out << "  <Points>\n";
+    out << "    <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\""
+        << ascii_or_binary << "\">\n";
+    {
+      // VTK always wants three coordinates, regardless of the dimension
+      std::vector<float> coordinates;
+      coordinates.reserve(3 * n_particles);
+      for (const auto &particle : *particle_handler)
+        {
+          const Point<spacedim> location = particle.get_location();
+          for (unsigned int d = 0; d < 3; ++d)
+            coordinates.push_back(d < spacedim ? location[d] : 0.f);
+        }
+      DataOutBase::write_vtu_data_array(coordinates, vtk_flags, out);
+    }
+    out << "\n";
+    out << "    </DataArray>\n";
+    out << "  </Points>\n\n";
+
+    // every particle is a cell of type VTK_VERTEX with a single point
+    out << "  <Cells>\n";
+    out << "    <DataArray type=\"Int32\" Name=\"connectivity\" format=\""
+        << ascii_or_binary << "\">\n";
+    {
+      std::vector<int> connectivity(n_particles);
+      for (unsigned int i = 0; i < n_particles; ++i)
+        connectivity[i] = i;
+      DataOutBase::write_vtu_data_array(connectivity, vtk_flags, out);
+    }
+    out << "\n";
+    out << "    </DataArray>\n";
+    out << "    <DataArray type=\"Int32\" Name=\"offsets\" format=\""
+        << ascii_or_binary << "\">\n";
+    {
+      std::vector<int> offsets(n_particles);
+      for (unsigned int i = 0; i < n_particles; ++i)
+        offsets[i] = i + 1;
+      DataOutBase::write_vtu_data_array(offsets, vtk_flags, out);
+    }
+    out << "\n";
+    out << "    </DataArray>\n";
+    out << "    <DataArray type=\"UInt8\" Name=\"types\" format=\""
+        << ascii_or_binary << "\">\n";
+    {
+      // unsigned char would be printed as a character rather than as an
+      // integer in ascii format
+#  ifdef DEAL_II_WITH_ZLIB
+      const std::vector<unsigned char> cell_types(n_particles, 1);
+#  else
+      const std::vector<unsigned int> cell_types(n_particles, 1);
+#  endif
+      DataOutBase::write_vtu_data_array(cell_types, vtk_flags, out);
+    }
+    out << "\n";
+    out << "    </DataArray>\n";
+    out << "  </Cells>\n";
+
+    out << "  <PointData Scalars=\"scalars\">\n";
+    out << "    <DataArray type=\""
+        << (sizeof(types::particle_index) == 8 ? "UInt64" : "UInt32")
+        << "\" Name=\"id\" format=\"" << ascii_or_binary << "\">\n";
+    {
+      std::vector<types::particle_index> ids;
+      ids.reserve(n_particles);
+      for (const auto &particle : *particle_handler)
+        ids.push_back(particle.get_id());
+      DataOutBase::write_vtu_data_array(ids, vtk_flags, out);
+    }
+    out << "\n";
+    out << "    </DataArray>\n";
+
+    for (const auto &field : fields)
+      {
+        const unsigned int first_property = std::get<1>(field);
+        const unsigned int n_components   = std::get<2>(field);
+        // VTK wants vectors to have three components
+        const unsigned int n_vtk_components = (n_components == 1 ? 1 : 3);
+
+        out << "    <DataArray type=\"Float32\" Name=\"" << std::get<0>(field)
+            << "\" NumberOfComponents=\"" << n_vtk_components << "\" format=\""
+            << ascii_or_binary << "\">\n";
+        {
+          std::vector<float> data;
+          data.reserve(n_vtk_components * n_particles);
+          for (const auto &particle : *particle_handler)
+            {
+              const ArrayView<const double> properties =
+                particle.get_properties();
+              for (unsigned int c = 0; c < n_vtk_components; ++c)
+                data.push_back(c < n_components ?
+                                 properties[first_property + c] :
+                                 0.f);
+            }
+          DataOutBase::write_vtu_data_array(data, vtk_flags, out);
+        }
+        out << "\n";
+        out << "    </DataArray>\n";
+      }
+    out << "  </PointData>\n";
+    out << "</Piece>\n";
+
+    out << std::flush;
+  }
+} // namespace Particles
+
+#endif // DEAL_II_WITH_P4EST
+
+DEAL_II_NAMESPACE_CLOSE
+
+DEAL_II_NAMESPACE_OPEN
+
+#ifdef DEAL_II_WITH_P4EST
+#  include "data_out.inst"
+#endif
+
+DEAL_II_NAMESPACE_CLOSE
@@ -13,10 +13,16 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/signaling_nan.h>
 
 #include <deal.II/particles/generators.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
 DEAL_II_NAMESPACE_OPEN
 
 #ifdef DEAL_II_WITH_P4EST
@@ -25,6 +31,60 @@ namespace Particles
 {
   namespace Generators
   {
+    namespace
+    {
+      /**
+       * Return the sum of @p local_value over all processes with a lower
+       * rank than the present one in the communicator of @p triangulation,
+       * or zero for a serial triangulation.
+       */
+      template <int dim, int spacedim, typename Number>
+      Number
+      exclusive_prefix_sum(const Triangulation<dim, spacedim> &triangulation,
+                           const Number                        local_value,
+                           const MPI_Datatype                  datatype)
+      {
+        Number prefix = 0;
+        if (const auto tria =
+              dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+                &triangulation))
+          {
+            const int ierr = MPI_Exscan(&local_value,
+                                        &prefix,
+                                        1,
+                                        datatype,
+                                        MPI_SUM,
+                                        tria->get_communicator());
+            AssertThrowMPI(ierr);
+
+            // the result of MPI_Exscan is undefined on the first process
+            if (Utilities::MPI::this_mpi_process(tria->get_communicator()) ==
+                0)
+              prefix = 0;
+          }
+        return prefix;
+      }
+
+
+
+      /**
+       * Collect the locally owned active cells of @p triangulation.
+       */
+      template <int dim, int spacedim>
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      locally_owned_cells(const Triangulation<dim, spacedim> &triangulation)
+      {
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          cells;
+        for (const auto &cell : triangulation.active_cell_iterators())
+          if (cell->is_locally_owned())
+            cells.push_back(cell);
+        return cells;
+      }
+    } // namespace
+
+
+
     template <int dim, int spacedim>
     void
     regular_reference_locations(
@@ -33,47 +93,203 @@ namespace Particles
       ParticleHandler<dim, spacedim> &    particle_handler,
       const Mapping<dim, spacedim> &      mapping)
     {
-      types::particle_index particle_index = 0;
+      const auto cells = locally_owned_cells(triangulation);
+      const unsigned int n_locations = particle_reference_locations.size();
+
+      // The local particle start index is the number of all particles
+      // generated on lower MPI ranks.
+      const types::particle_index particle_index =
+        exclusive_prefix_sum(triangulation,
+                             static_cast<types::particle_index>(cells.size()) *
+                               n_locations,
+                             DEAL_II_PARTICLE_INDEX_MPI_TYPE);
+
+      std::vector<unsigned int> cell_start(cells.size() + 1);
+      for (unsigned int c = 0; c <= cells.size(); ++c)
+        cell_start[c] = c * n_locations;
+
+      // compute the real locations of the particles on the available
+      // threads, the cells are independent of each other
+      std::vector<Point<dim>>      reference_locations(cell_start.back());
+      std::vector<Point<spacedim>> positions(cell_start.back());
+      parallel::apply_to_subranges(
+        0u,
+        static_cast<unsigned int>(cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int c = begin; c < end; ++c)
+            for (unsigned int i = 0; i < n_locations; ++i)
+              {
+                reference_locations[cell_start[c] + i] =
+                  particle_reference_locations[i];
+                positions[cell_start[c] + i] =
+                  mapping.transform_unit_to_real_cell(
+                    cells[c], particle_reference_locations[i]);
+              }
+        },
+        16);
+
+      particle_handler.insert_particles(
+        cells, cell_start, positions, reference_locations, particle_index);
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    probabilistic_locations(
+      const Triangulation<dim, spacedim> &triangulation,
+      const Function<spacedim> &          probability_density_function,
+      const bool                          random_cell_selection,
+      const types::particle_index         n_particles_to_create,
+      ParticleHandler<dim, spacedim> &    particle_handler,
+      const Mapping<dim, spacedim> &      mapping,
+      const unsigned int                  random_number_seed)
+    {
+      const auto cells = locally_owned_cells(triangulation);
+
+      // the weight of a cell is the integral of the density over the cell,
+      // approximated by the midpoint rule
+      std::vector<double> cumulative_weights(cells.size());
+      double              local_weight = 0;
+      for (unsigned int c = 0; c < cells.size(); ++c)
+        {
+          const double density =
+            probability_density_function.value(cells[c]->center());
+          Assert(density >= 0,
+                 ExcMessage("The probability density function must not be "
+                            "negative."));
+          local_weight += density * cells[c]->measure();
+          cumulative_weights[c] = local_weight;
+        }
+
+      const double weight_before =
+        exclusive_prefix_sum(triangulation, local_weight, MPI_DOUBLE);
+      double global_weight = local_weight;
+      if (const auto tria =
+            dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+              &triangulation))
+        global_weight =
+          Utilities::MPI::sum(local_weight, tria->get_communicator());
+      AssertThrow(global_weight > 0,
+                  ExcMessage("The probability density function must be "
+                             "positive in a part of the domain."));
+
+      // The particles are numbered in the order of the cumulative weight
+      // over all cells of all processes. The cells of all particles up to
+      // the weight w are the first round(w/W*n_particles_to_create) ones,
+      // so both the ids of the particles and the number of particles per
+      // process follow from the exclusive prefix sum of the weights and
+      // the particles add up to n_particles_to_create exactly.
+      const auto n_particles_up_to = [&](const double weight) {
+        return std::min(static_cast<types::particle_index>(std::round(
+                          weight / global_weight * n_particles_to_create)),
+                        n_particles_to_create);
+      };
 
-      if (const auto tria = dynamic_cast<
-            const parallel::distributed::Triangulation<dim, spacedim> *>(
-            &triangulation))
+      // The end of the range of the present process is the start of the
+      // next one, which is exchanged rather than recomputed to avoid
+      // differences by round-off.
+      const types::particle_index local_start_index =
+        n_particles_up_to(weight_before);
+      types::particle_index local_end_index = n_particles_to_create;
+      if (const auto tria =
+            dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+              &triangulation))
         {
-          const types::particle_index n_particles_to_generate =
-            tria->n_locally_owned_active_cells() *
-            particle_reference_locations.size();
-
-          // The local particle start index is the number of all particles
-          // generated on lower MPI ranks.
-          MPI_Exscan(&n_particles_to_generate,
-                     &particle_index,
-                     1,
-                     DEAL_II_PARTICLE_INDEX_MPI_TYPE,
-                     MPI_SUM,
-                     tria->get_communicator());
+          const MPI_Comm comm    = tria->get_communicator();
+          const int      rank    = Utilities::MPI::this_mpi_process(comm);
+          const int      n_ranks = Utilities::MPI::n_mpi_processes(comm);
+          const int      ierr =
+            MPI_Sendrecv(&local_start_index,
+                         1,
+                         DEAL_II_PARTICLE_INDEX_MPI_TYPE,
+                         rank > 0 ? rank - 1 : MPI_PROC_NULL,
+                         791,
+                         &local_end_index,
+                         1,
+                         DEAL_II_PARTICLE_INDEX_MPI_TYPE,
+                         rank + 1 < n_ranks ? rank + 1 : MPI_PROC_NULL,
+                         791,
+                         comm,
+                         MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
         }
+      Assert(local_end_index >= local_start_index, ExcInternalError());
+      AssertThrow(local_end_index - local_start_index <
+                    std::numeric_limits<unsigned int>::max(),
+                  ExcMessage("Too many particles for a single process."));
+      const unsigned int n_local_particles =
+        local_end_index - local_start_index;
 
-      for (const auto &cell : triangulation.active_cell_iterators())
+      std::vector<unsigned int> cell_start(cells.size() + 1, 0);
+      if (random_cell_selection == false)
         {
-          if (cell->is_locally_owned())
+          for (unsigned int c = 0; c < cells.size(); ++c)
+            cell_start[c + 1] =
+              std::max(std::min(n_particles_up_to(weight_before +
+                                                  cumulative_weights[c]),
+                                local_end_index),
+                       local_start_index + cell_start[c]) -
+              local_start_index;
+          cell_start.back() = n_local_particles;
+        }
+      else if (n_local_particles > 0)
+        {
+          // The seeds of the generators of the locations within the cells
+          // below are the seed plus the id of the first particle of the
+          // cell, so add the number of all particles for the generator that
+          // selects the cells.
+          std::mt19937 random_number_generator(
+            random_number_seed + n_particles_to_create + local_start_index);
+          std::uniform_real_distribution<double> uniform_distribution(
+            0., local_weight);
+          for (unsigned int i = 0; i < n_local_particles; ++i)
             {
-              for (const auto &reference_location :
-                   particle_reference_locations)
-                {
-                  const Point<spacedim> position_real =
-                    mapping.transform_unit_to_real_cell(cell,
-                                                        reference_location);
-
-                  const Particle<dim, spacedim> particle(position_real,
-                                                         reference_location,
-                                                         particle_index);
-                  particle_handler.insert_particle(particle, cell);
-                  ++particle_index;
-                }
+              const auto selected_cell =
+                std::upper_bound(cumulative_weights.begin(),
+                                 cumulative_weights.end(),
+                                 uniform_distribution(random_number_generator));
+              const unsigned int c =
+                std::min<std::size_t>(selected_cell -
+                                        cumulative_weights.begin(),
+                                      cells.size() - 1);
+              ++cell_start[c + 1];
             }
+          for (unsigned int c = 0; c < cells.size(); ++c)
+            cell_start[c + 1] += cell_start[c];
         }
 
-      particle_handler.update_cached_numbers();
+      // create the particles of the cells on the available threads, with
+      // independent random number generators for every cell
+      std::vector<Point<dim>>      reference_locations(n_local_particles);
+      std::vector<Point<spacedim>> positions(n_local_particles);
+      parallel::apply_to_subranges(
+        0u,
+        static_cast<unsigned int>(cells.size()),
+        [&](const unsigned int begin, const unsigned int end) {
+          std::uniform_real_distribution<double> uniform_distribution(0., 1.);
+          for (unsigned int c = begin; c < end; ++c)
+            if (cell_start[c + 1] > cell_start[c])
+              {
+                std::mt19937 random_number_generator(random_number_seed +
+                                                     local_start_index +
+                                                     cell_start[c]);
+                for (unsigned int i = cell_start[c]; i < cell_start[c + 1];
+                     ++i)
+                  {
+                    for (unsigned int d = 0; d < dim; ++d)
+                      reference_locations[i][d] =
+                        uniform_distribution(random_number_generator);
+                    positions[i] =
+                      mapping.transform_unit_to_real_cell(
+                        cells[c], reference_locations[i]);
+                  }
+              }
+        },
+        16);
+
+      particle_handler.insert_particles(
+        cells, cell_start, positions, reference_locations, local_start_index);
     }
   } // namespace Generators
 } // namespace Particles
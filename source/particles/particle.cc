@@ -128,7 +128,11 @@ namespace Particles
         location           = particle.location;
         reference_location = particle.reference_location;
         id                 = particle.id;
-        property_pool      = particle.property_pool;
+
+        // Release the old properties before the handle is overwritten
+        if (has_properties())
+          property_pool->deallocate_properties_array(properties);
+        property_pool = particle.property_pool;
 
         if (particle.has_properties())
           {
@@ -157,9 +161,11 @@ namespace Particles
   {
     if (this != &particle)
       {
-        location            = particle.location;
-        reference_location  = particle.reference_location;
-        id                  = particle.id;
+        location           = particle.location;
+        reference_location = particle.reference_location;
+        id                 = particle.id;
+        if (has_properties())
+          property_pool->deallocate_properties_array(properties);
         property_pool       = particle.property_pool;
         properties          = particle.properties;
         particle.properties = PropertyPool::invalid_handle;
@@ -21,31 +21,69 @@ namespace Particles
 {
   template <int dim, int spacedim>
   ParticleAccessor<dim, spacedim>::ParticleAccessor()
-    : map(nullptr)
-    , particle()
+    : storage(nullptr)
+    , cell()
+    , index(0)
   {}
 
 
 
   template <int dim, int spacedim>
   ParticleAccessor<dim, spacedim>::ParticleAccessor(
-    const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-    const typename std::multimap<internal::LevelInd,
-                                 Particle<dim, spacedim>>::iterator & particle)
-    : map(const_cast<
-          std::multimap<internal::LevelInd, Particle<dim, spacedim>> *>(&map))
-    , particle(particle)
+    const internal::ParticleStorage<dim, spacedim> &storage,
+    const typename internal::ParticleStorage<dim, spacedim>::cell_map_iterator
+      &                cell,
+    const unsigned int index)
+    : storage(const_cast<internal::ParticleStorage<dim, spacedim> *>(&storage))
+    , cell(cell)
+    , index(index)
   {}
 
 
 
+  template <int dim, int spacedim>
+  typename internal::ParticleStorage<dim, spacedim>::Handle
+  ParticleAccessor<dim, spacedim>::get_handle() const
+  {
+    Assert(storage != nullptr, ExcInternalError());
+    Assert(cell != storage->end_cells(), ExcInternalError());
+
+    return storage->get_handle(cell, index);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   ParticleAccessor<dim, spacedim>::write_data(void *&data) const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.write_data(data);
+    const typename internal::ParticleStorage<dim, spacedim>::Handle handle =
+      get_handle();
+
+    types::particle_index *id_data = static_cast<types::particle_index *>(data);
+    *id_data                       = storage->get_id(handle);
+    ++id_data;
+    double *pdata = reinterpret_cast<double *>(id_data);
+
+    // Write location data
+    const Point<spacedim> &location = storage->get_location(handle);
+    for (unsigned int i = 0; i < spacedim; ++i, ++pdata)
+      *pdata = location(i);
+
+    // Write reference location data
+    const Point<dim> &reference_location =
+      storage->get_reference_location(handle);
+    for (unsigned int i = 0; i < dim; ++i, ++pdata)
+      *pdata = reference_location(i);
+
+    // Write property data
+    const ArrayView<const double> particle_properties =
+      const_cast<const internal::ParticleStorage<dim, spacedim> *>(storage)
+        ->get_properties(handle);
+    for (unsigned int i = 0; i < particle_properties.size(); ++i, ++pdata)
+      *pdata = particle_properties[i];
+
+    data = static_cast<void *>(pdata);
   }
 
 
@@ -54,9 +92,7 @@ namespace Particles
   void
   ParticleAccessor<dim, spacedim>::set_location(const Point<spacedim> &new_loc)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_location(new_loc);
+    storage->get_location(get_handle()) = new_loc;
   }
 
 
@@ -65,9 +101,7 @@ namespace Particles
   const Point<spacedim> &
   ParticleAccessor<dim, spacedim>::get_location() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.get_location();
+    return storage->get_location(get_handle());
   }
 
 
@@ -77,9 +111,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_reference_location(
     const Point<dim> &new_loc)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_reference_location(new_loc);
+    storage->get_reference_location(get_handle()) = new_loc;
   }
 
 
@@ -88,9 +120,7 @@ namespace Particles
   const Point<dim> &
   ParticleAccessor<dim, spacedim>::get_reference_location() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.get_reference_location();
+    return storage->get_reference_location(get_handle());
   }
 
 
@@ -99,9 +129,7 @@ namespace Particles
   types::particle_index
   ParticleAccessor<dim, spacedim>::get_id() const
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.get_id();
+    return storage->get_id(get_handle());
   }
 
 
@@ -111,9 +139,10 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_property_pool(
     PropertyPool &new_property_pool)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_property_pool(new_property_pool);
+    Assert(cell != storage->end_cells(), ExcInternalError());
+    AssertDimension(new_property_pool.n_properties_per_slot(),
+                    storage->n_properties_per_particle());
+    (void)new_property_pool;
   }
 
 
@@ -122,9 +151,9 @@ namespace Particles
   bool
   ParticleAccessor<dim, spacedim>::has_properties() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(cell != storage->end_cells(), ExcInternalError());
 
-    return particle->second.has_properties();
+    return storage->n_properties_per_particle() > 0;
   }
 
 
@@ -134,10 +163,23 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::set_properties(
     const std::vector<double> &new_properties)
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    particle->second.set_properties(new_properties);
-    return;
+    const ArrayView<double> old_properties =
+      storage->get_properties(get_handle());
+
+    Assert(
+      new_properties.size() == old_properties.size(),
+      ExcMessage(
+        std::string(
+          "You are trying to assign properties with an incompatible length. ") +
+        "The particle has space to store " +
+        Utilities::to_string(old_properties.size()) + " properties, " +
+        "and this function tries to assign" +
+        Utilities::to_string(new_properties.size()) + " properties. " +
+        "This is not allowed."));
+
+    std::copy(new_properties.begin(),
+              new_properties.end(),
+              old_properties.begin());
   }
 
 
@@ -146,9 +188,11 @@ namespace Particles
   const ArrayView<const double>
   ParticleAccessor<dim, spacedim>::get_properties() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(has_properties(), ExcInternalError());
 
-    return particle->second.get_properties();
+    return const_cast<const internal::ParticleStorage<dim, spacedim> *>(
+             storage)
+      ->get_properties(get_handle());
   }
 
 
@@ -158,11 +202,11 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::get_surrounding_cell(
     const Triangulation<dim, spacedim> &triangulation) const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(cell != storage->end_cells(), ExcInternalError());
 
-    const typename Triangulation<dim, spacedim>::cell_iterator cell(
-      &triangulation, particle->first.first, particle->first.second);
-    return cell;
+    const typename Triangulation<dim, spacedim>::cell_iterator
+      surrounding_cell(&triangulation, cell->first.first, cell->first.second);
+    return surrounding_cell;
   }
 
 
@@ -171,9 +215,7 @@ namespace Particles
   const ArrayView<double>
   ParticleAccessor<dim, spacedim>::get_properties()
   {
-    Assert(particle != map->end(), ExcInternalError());
-
-    return particle->second.get_properties();
+    return storage->get_properties(get_handle());
   }
 
 
@@ -182,9 +224,11 @@ namespace Particles
   std::size_t
   ParticleAccessor<dim, spacedim>::serialized_size_in_bytes() const
   {
-    Assert(particle != map->end(), ExcInternalError());
+    Assert(cell != storage->end_cells(), ExcInternalError());
 
-    return particle->second.serialized_size_in_bytes();
+    return sizeof(types::particle_index) + sizeof(Point<spacedim>) +
+           sizeof(Point<dim>) +
+           sizeof(double) * storage->n_properties_per_particle();
   }
 
 
@@ -193,8 +237,14 @@ namespace Particles
   void
   ParticleAccessor<dim, spacedim>::next()
   {
-    Assert(particle != map->end(), ExcInternalError());
-    ++particle;
+    Assert(cell != storage->end_cells(), ExcInternalError());
+
+    ++index;
+    if (index == cell->second.size())
+      {
+        ++cell;
+        index = 0;
+      }
   }
 
 
@@ -203,8 +253,15 @@ namespace Particles
   void
   ParticleAccessor<dim, spacedim>::prev()
   {
-    Assert(particle != map->begin(), ExcInternalError());
-    --particle;
+    if (index > 0)
+      --index;
+    else
+      {
+        Assert(cell != storage->begin_cells(), ExcInternalError());
+
+        --cell;
+        index = cell->second.size() - 1;
+      }
   }
 
 
@@ -214,7 +271,7 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::
   operator!=(const ParticleAccessor<dim, spacedim> &other) const
   {
-    return (map != other.map) || (particle != other.particle);
+    return !(*this == other);
   }
 
 
@@ -224,7 +281,8 @@ namespace Particles
   ParticleAccessor<dim, spacedim>::
   operator==(const ParticleAccessor<dim, spacedim> &other) const
   {
-    return (map == other.map) && (particle == other.particle);
+    return (storage == other.storage) && (cell == other.cell) &&
+           (index == other.index);
   }
 } // namespace Particles
 
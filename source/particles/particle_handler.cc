@@ -13,6 +13,8 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/memory_report.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/grid/grid_tools.h>
@@ -32,7 +34,8 @@ namespace Particles
   {
     template <int dim, int spacedim>
     std::vector<char>
-    pack_particles(std::vector<Particle<dim, spacedim>> &particles)
+    pack_particles(
+      const std::vector<ParticleIterator<dim, spacedim>> &particles)
     {
       std::vector<char> buffer;
 
@@ -40,12 +43,12 @@ namespace Particles
         return buffer;
 
       buffer.resize(particles.size() *
-                    particles.front().serialized_size_in_bytes());
+                    particles.front()->serialized_size_in_bytes());
       void *current_data = buffer.data();
 
       for (const auto &particle : particles)
         {
-          particle.write_data(current_data);
+          particle->write_data(current_data);
         }
 
       return buffer;
@@ -85,11 +88,30 @@ namespace Particles
 
       return particles;
     }
+
+    template <int dim, int spacedim>
+    void
+    repartition_triangulation(
+      parallel::distributed::Triangulation<dim, spacedim> &triangulation)
+    {
+      triangulation.repartition();
+    }
+
+    // The one-dimensional parallel::distributed::Triangulation is only a
+    // placeholder that can not be repartitioned.
+    template <int spacedim>
+    void
+    repartition_triangulation(
+      parallel::distributed::Triangulation<1, spacedim> &)
+    {
+      Assert(false, ExcNotImplemented());
+    }
   } // namespace
 
   template <int dim, int spacedim>
   ParticleHandler<dim, spacedim>::ParticleHandler()
     : triangulation()
+    , triangulation_cache()
     , particles()
     , ghost_particles()
     , global_number_of_particles(0)
@@ -100,6 +122,9 @@ namespace Particles
     , store_callback()
     , load_callback()
     , handle(numbers::invalid_unsigned_int)
+    , particle_weight(0)
+    , additional_cell_weight(0)
+    , cell_weight_connection()
   {}
 
 
@@ -111,8 +136,11 @@ namespace Particles
     const unsigned int                                         n_properties)
     : triangulation(&triangulation, typeid(*this).name())
     , mapping(&mapping, typeid(*this).name())
-    , particles()
-    , ghost_particles()
+    , triangulation_cache(
+        std_cxx14::make_unique<GridTools::Cache<dim, spacedim>>(triangulation,
+                                                                mapping))
+    , particles(n_properties)
+    , ghost_particles(n_properties)
     , global_number_of_particles(0)
     , global_max_particles_per_cell(0)
     , next_free_particle_index(0)
@@ -121,6 +149,9 @@ namespace Particles
     , store_callback()
     , load_callback()
     , handle(numbers::invalid_unsigned_int)
+    , particle_weight(0)
+    , additional_cell_weight(0)
+    , cell_weight_connection()
   {}
 
 
@@ -135,9 +166,18 @@ namespace Particles
   {
     triangulation = &new_triangulation;
     mapping       = &new_mapping;
+    triangulation_cache =
+      std_cxx14::make_unique<GridTools::Cache<dim, spacedim>>(new_triangulation,
+                                                              new_mapping);
 
     // Create the memory pool that will store all particle properties
     property_pool = std_cxx14::make_unique<PropertyPool>(n_properties);
+    particles.reinit(n_properties);
+    ghost_particles.reinit(n_properties);
+    ghost_particles_cache.valid = false;
+
+    // The weight function refers to the previous triangulation
+    disconnect_particle_weights();
   }
 
 
@@ -159,6 +199,7 @@ namespace Particles
   ParticleHandler<dim, spacedim>::clear_particles()
   {
     particles.clear();
+    ghost_particles_cache.valid = false;
   }
 
 
@@ -167,30 +208,16 @@ namespace Particles
   void
   ParticleHandler<dim, spacedim>::update_cached_numbers()
   {
-    types::particle_index locally_highest_index        = 0;
-    unsigned int          local_max_particles_per_cell = 0;
-    unsigned int          current_particles_per_cell   = 0;
-    typename Triangulation<dim, spacedim>::active_cell_iterator current_cell =
-      triangulation->begin_active();
+    types::particle_index locally_highest_index = 0;
+    const unsigned int    local_max_particles_per_cell =
+      particles.max_n_particles_per_cell();
 
     for (particle_iterator particle = begin(); particle != end(); ++particle)
-      {
-        locally_highest_index =
-          std::max(locally_highest_index, particle->get_id());
-
-        if (particle->get_surrounding_cell(*triangulation) != current_cell)
-          {
-            current_particles_per_cell = 0;
-            current_cell = particle->get_surrounding_cell(*triangulation);
-          }
-
-        ++current_particles_per_cell;
-        local_max_particles_per_cell =
-          std::max(local_max_particles_per_cell, current_particles_per_cell);
-      }
+      locally_highest_index =
+        std::max(locally_highest_index, particle->get_id());
 
     global_number_of_particles =
-      dealii::Utilities::MPI::sum(particles.size(),
+      dealii::Utilities::MPI::sum(particles.n_particles(),
                                   triangulation->get_communicator());
     next_free_particle_index =
       dealii::Utilities::MPI::max(locally_highest_index,
@@ -216,7 +243,7 @@ namespace Particles
   typename ParticleHandler<dim, spacedim>::particle_iterator
   ParticleHandler<dim, spacedim>::begin()
   {
-    return particle_iterator(particles, particles.begin());
+    return particle_iterator(particles, particles.begin_cells(), 0);
   }
 
 
@@ -234,7 +261,7 @@ namespace Particles
   typename ParticleHandler<dim, spacedim>::particle_iterator
   ParticleHandler<dim, spacedim>::end()
   {
-    return particle_iterator(particles, particles.end());
+    return particle_iterator(particles, particles.end_cells(), 0);
   }
 
 
@@ -252,7 +279,9 @@ namespace Particles
   typename ParticleHandler<dim, spacedim>::particle_iterator
   ParticleHandler<dim, spacedim>::begin_ghost()
   {
-    return particle_iterator(ghost_particles, ghost_particles.begin());
+    return particle_iterator(ghost_particles,
+                             ghost_particles.begin_cells(),
+                             0);
   }
 
 
@@ -270,7 +299,7 @@ namespace Particles
   typename ParticleHandler<dim, spacedim>::particle_iterator
   ParticleHandler<dim, spacedim>::end_ghost()
   {
-    return particle_iterator(ghost_particles, ghost_particles.end());
+    return particle_iterator(ghost_particles, ghost_particles.end_cells(), 0);
   }
 
 
@@ -295,18 +324,22 @@ namespace Particles
     const internal::LevelInd level_index =
       std::make_pair(cell->level(), cell->index());
 
-    if (cell->is_ghost())
-      {
-        const auto particles_in_cell = ghost_particles.equal_range(level_index);
-        return boost::make_iterator_range(
-          particle_iterator(ghost_particles, particles_in_cell.first),
-          particle_iterator(ghost_particles, particles_in_cell.second));
-      }
+    internal::ParticleStorage<dim, spacedim> &storage =
+      (cell->is_ghost() ? ghost_particles : particles);
+
+    // The particles of the cell end where the particles of the next cell
+    // that contains particles begin. If the cell contains no particles, both
+    // iterators point to the first particle of that next cell.
+    const auto cell_particles = storage.lower_bound(level_index);
+    if (cell_particles == storage.end_cells() ||
+        cell_particles->first != level_index)
+      return boost::make_iterator_range(
+        particle_iterator(storage, cell_particles, 0),
+        particle_iterator(storage, cell_particles, 0));
 
-    const auto particles_in_cell = particles.equal_range(level_index);
     return boost::make_iterator_range(
-      particle_iterator(particles, particles_in_cell.first),
-      particle_iterator(particles, particles_in_cell.second));
+      particle_iterator(storage, cell_particles, 0),
+      particle_iterator(storage, std::next(cell_particles), 0));
   }
 
 
@@ -316,7 +349,28 @@ namespace Particles
   ParticleHandler<dim, spacedim>::remove_particle(
     const ParticleHandler<dim, spacedim>::particle_iterator &particle)
   {
-    particles.erase(particle->particle);
+    particles.erase(particle->cell, particle->index);
+    ghost_particles_cache.valid = false;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::remove_particles(
+    const std::vector<particle_iterator> &particles_to_remove)
+  {
+    std::vector<
+      std::pair<typename internal::ParticleStorage<dim, spacedim>::
+                  cell_map_iterator,
+                unsigned int>>
+      positions;
+    positions.reserve(particles_to_remove.size());
+    for (const auto &particle : particles_to_remove)
+      positions.emplace_back(particle->cell, particle->index);
+
+    particles.remove(positions);
+    ghost_particles_cache.valid = false;
   }
 
 
@@ -327,20 +381,12 @@ namespace Particles
     const Particle<dim, spacedim> &                                    particle,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
   {
-    typename std::multimap<internal::LevelInd,
-                           Particle<dim, spacedim>>::iterator it =
-      particles.insert(
-        std::make_pair(internal::LevelInd(cell->level(), cell->index()),
-                       particle));
-
-    particle_iterator particle_it(particles, it);
-    particle_it->set_property_pool(*property_pool);
-
-    if (particle.has_properties())
-      for (unsigned int n = 0; n < particle.get_properties().size(); ++n)
-        particle_it->get_properties()[n] = particle.get_properties()[n];
+    const auto cell_particles =
+      particles.get_cell(internal::LevelInd(cell->level(), cell->index()));
+    const unsigned int index = particles.insert(cell_particles, particle);
+    ghost_particles_cache.valid = false;
 
-    return particle_it;
+    return particle_iterator(particles, cell_particles, index);
   }
 
 
@@ -352,14 +398,16 @@ namespace Particles
       typename Triangulation<dim, spacedim>::active_cell_iterator,
       Particle<dim, spacedim>> &new_particles)
   {
+    particles.reserve(particles.n_particles() + new_particles.size());
+
     for (auto particle = new_particles.begin(); particle != new_particles.end();
          ++particle)
-      particles.insert(
-        particles.end(),
-        std::make_pair(internal::LevelInd(particle->first->level(),
-                                          particle->first->index()),
-                       particle->second));
+      particles.insert(particles.get_cell(internal::LevelInd(
+                         particle->first->level(), particle->first->index())),
+                       particle->second);
 
+    particles.reorder_by_cell();
+    ghost_particles_cache.valid = false;
     update_cached_numbers();
   }
 
@@ -394,8 +442,8 @@ namespace Particles
 
     local_start_index += local_next_particle_index;
 
-    GridTools::Cache<dim, spacedim> cache(*triangulation, *mapping);
-    auto point_locations = GridTools::compute_point_locations(cache, positions);
+    auto point_locations =
+      GridTools::compute_point_locations(*triangulation_cache, positions);
 
     auto &cells           = std::get<0>(point_locations);
     auto &local_positions = std::get<1>(point_locations);
@@ -404,23 +452,60 @@ namespace Particles
     if (cells.size() == 0)
       return;
 
-    auto hint =
-      particles.find(std::make_pair(cells[0]->level(), cells[0]->index()));
+    particles.reserve(particles.n_particles() + positions.size());
+
     for (unsigned int i = 0; i < cells.size(); ++i)
-      {
-        internal::LevelInd current_cell(cells[i]->level(), cells[i]->index());
-        for (unsigned int p = 0; p < local_positions[i].size(); ++p)
-          {
-            hint = particles.insert(
-              hint,
-              std::make_pair(current_cell,
-                             Particle<dim, spacedim>(positions[index_map[i][p]],
-                                                     local_positions[i][p],
-                                                     local_start_index +
-                                                       index_map[i][p])));
-          }
-      }
+      if (local_positions[i].size() > 0)
+        {
+          const auto cell_particles = particles.get_cell(
+            internal::LevelInd(cells[i]->level(), cells[i]->index()));
+          for (unsigned int p = 0; p < local_positions[i].size(); ++p)
+            particles.insert(cell_particles,
+                             positions[index_map[i][p]],
+                             local_positions[i][p],
+                             local_start_index + index_map[i][p]);
+        }
 
+    particles.reorder_by_cell();
+    ghost_particles_cache.valid = false;
+    update_cached_numbers();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::insert_particles(
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator> &cells,
+    const std::vector<unsigned int> &                              cell_start,
+    const std::vector<Point<spacedim>> &                           positions,
+    const std::vector<Point<dim>> &                   reference_locations,
+    const types::particle_index                       first_particle_index)
+  {
+    AssertDimension(cell_start.size(), cells.size() + 1);
+    AssertDimension(cell_start.back(), positions.size());
+    AssertDimension(reference_locations.size(), positions.size());
+
+    particles.reserve(particles.n_particles() + positions.size());
+
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      if (cell_start[c + 1] > cell_start[c])
+        {
+          Assert(cells[c]->is_locally_owned(),
+                 ExcMessage("Particles can only be inserted into locally "
+                            "owned cells."));
+          const auto cell_particles = particles.get_cell(
+            internal::LevelInd(cells[c]->level(), cells[c]->index()));
+          for (unsigned int i = cell_start[c]; i < cell_start[c + 1]; ++i)
+            particles.insert(cell_particles,
+                             positions[i],
+                             reference_locations[i],
+                             first_particle_index + i);
+        }
+
+    particles.reorder_by_cell();
+    ghost_particles_cache.valid = false;
     update_cached_numbers();
   }
 
@@ -448,7 +533,7 @@ namespace Particles
   types::particle_index
   ParticleHandler<dim, spacedim>::n_locally_owned_particles() const
   {
-    return particles.size();
+    return particles.n_particles();
   }
 
 
@@ -472,9 +557,9 @@ namespace Particles
       std::make_pair(cell->level(), cell->index());
 
     if (cell->is_locally_owned())
-      return particles.count(found_cell);
+      return particles.n_particles_in_cell(found_cell);
     else if (cell->is_ghost())
-      return ghost_particles.count(found_cell);
+      return ghost_particles.n_particles_in_cell(found_cell);
     else if (cell->is_artificial())
       AssertThrow(false, ExcInternalError());
 
@@ -501,34 +586,45 @@ namespace Particles
 
 
 
-  namespace
+  template <int dim, int spacedim>
+  std::size_t
+  ParticleHandler<dim, spacedim>::memory_consumption() const
   {
-    /**
-     * This function is used as comparison argument to std::sort to sort the
-     * vector of tensors @p center_directions by its scalar product with the
-     * @p particle_direction tensor. The sorted indices allow to
-     * loop over @p center_directions with increasing angle between
-     * @p particle_direction and @p center_directions. This function assumes
-     * that @p particle_direction and @p center_directions are normalized
-     * to length one before calling this function.
-     */
-    template <int dim>
-    bool
-    compare_particle_association(
-      const unsigned int                 a,
-      const unsigned int                 b,
-      const Tensor<1, dim> &             particle_direction,
-      const std::vector<Tensor<1, dim>> &center_directions)
-    {
-      const double scalar_product_a = center_directions[a] * particle_direction;
-      const double scalar_product_b = center_directions[b] * particle_direction;
+    MemoryReport report;
+    add_memory_consumption(report);
+    return report.local_data_memory();
+  }
 
-      // The function is supposed to return if a is before b. We are looking
-      // for the alignment of particle direction and center direction,
-      // therefore return if the scalar product of a is larger.
-      return (scalar_product_a > scalar_product_b);
-    }
-  } // namespace
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::add_memory_consumption(
+    MemoryReport &     report,
+    const std::string &name) const
+  {
+    report.add(name + "/particles", particles.memory_consumption());
+    report.add(name + "/ghost particles",
+               ghost_particles.memory_consumption());
+    report.add(name + "/property pool",
+               property_pool ? property_pool->memory_consumption() : 0);
+
+    const internal::GhostParticlePartitioner<dim, spacedim> &cache =
+      ghost_particles_cache;
+    std::size_t cache_memory =
+      MemoryConsumption::memory_consumption(cache.neighbors) +
+      MemoryConsumption::memory_consumption(cache.n_send_particles) +
+      MemoryConsumption::memory_consumption(cache.n_recv_particles) +
+      MemoryConsumption::memory_consumption(cache.send_data) +
+      MemoryConsumption::memory_consumption(cache.recv_data) +
+      cache.ghost_particles_iterators.capacity() *
+        sizeof(ParticleIterator<dim, spacedim>);
+    for (const auto &domain : cache.ghost_particles_by_domain)
+      cache_memory += sizeof(domain) +
+                      domain.second.capacity() *
+                        sizeof(ParticleIterator<dim, spacedim>);
+    report.add(name + "/ghost exchange", cache_memory);
+  }
 
 
 
@@ -544,35 +640,69 @@ namespace Particles
     // TODO: Extend this function to allow keeping particles on other
     // processes around (with an invalid cell).
 
-    std::vector<particle_iterator> particles_out_of_cell;
-    particles_out_of_cell.reserve(n_locally_owned_particles());
-
-    // Now update the reference locations of the moved particles
-    for (particle_iterator it = begin(); it != end(); ++it)
-      {
-        const typename Triangulation<dim, spacedim>::cell_iterator cell =
-          it->get_surrounding_cell(*triangulation);
-
-        try
+    using cell_map_iterator =
+      typename internal::ParticleStorage<dim, spacedim>::cell_map_iterator;
+
+    // Collect the cells that contain particles, such that they can be
+    // processed in parallel.
+    std::vector<cell_map_iterator> cells_with_particles;
+    for (auto cell = particles.begin_cells(); cell != particles.end_cells();
+         ++cell)
+      cells_with_particles.push_back(cell);
+
+    // Update the reference locations of all particles and collect the
+    // particles that have left their cell. Since the particles are grouped
+    // by cell, the reference locations of all particles of a cell are
+    // computed by a single call to the mapping, which can process the points
+    // of one cell in a batch.
+    std::vector<std::vector<particle_iterator>> particles_out_of_cell_by_cell(
+      cells_with_particles.size());
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells_with_particles.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<Point<spacedim>> real_points;
+        std::vector<Point<dim>>      unit_points;
+
+        for (unsigned int c = begin; c < end; ++c)
           {
-            const Point<dim> p_unit =
-              mapping->transform_real_to_unit_cell(cell, it->get_location());
-            if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
-              {
-                it->set_reference_location(p_unit);
-              }
-            else
-              {
+            const cell_map_iterator &cell_particles = cells_with_particles[c];
+            const typename Triangulation<dim, spacedim>::cell_iterator cell(
+              &*triangulation,
+              cell_particles->first.first,
+              cell_particles->first.second);
+
+            const unsigned int n_particles = cell_particles->second.size();
+            real_points.resize(n_particles);
+            unit_points.resize(n_particles);
+            for (unsigned int i = 0; i < n_particles; ++i)
+              real_points[i] =
+                particles.get_location(cell_particles->second[i]);
+
+            // Points for which the transformation fails are returned with
+            // an infinite first coordinate, and are therefore not inside
+            // the unit cell.
+            mapping->transform_points_real_to_unit_cell(
+              cell, make_array_view(real_points), make_array_view(unit_points));
+
+            for (unsigned int i = 0; i < n_particles; ++i)
+              if (GeometryInfo<dim>::is_inside_unit_cell(unit_points[i]))
+                particles.get_reference_location(cell_particles->second[i]) =
+                  unit_points[i];
+              else
                 // The particle has left the cell
-                particles_out_of_cell.push_back(it);
-              }
+                particles_out_of_cell_by_cell[c].push_back(
+                  particle_iterator(particles, cell_particles, i));
           }
-        catch (typename Mapping<dim>::ExcTransformationFailed &)
-          {
-            // The particle has left the cell
-            particles_out_of_cell.push_back(it);
-          }
-      }
+      },
+      16);
+
+    std::vector<particle_iterator> particles_out_of_cell;
+    for (const auto &cell_particles_out_of_cell :
+         particles_out_of_cell_by_cell)
+      particles_out_of_cell.insert(particles_out_of_cell.end(),
+                                   cell_particles_out_of_cell.begin(),
+                                   cell_particles_out_of_cell.end());
 
     // There are three reasons why a particle is not in its old cell:
     // It moved to another cell, to another subdomain or it left the mesh.
@@ -580,7 +710,9 @@ namespace Particles
     // sorted_particles vector, particles that moved to another domain are
     // collected in the moved_particles_domain vector. Particles that left
     // the mesh completely are ignored and removed.
-    std::vector<std::pair<internal::LevelInd, Particle<dim, spacedim>>>
+    std::vector<
+      std::pair<internal::LevelInd,
+                typename internal::ParticleStorage<dim, spacedim>::Handle>>
       sorted_particles;
     std::map<types::subdomain_id, std::vector<particle_iterator>>
       moved_particles;
@@ -608,151 +740,100 @@ namespace Particles
       moved_cells[ghost_owner].reserve(
         static_cast<vector_size>(particles_out_of_cell.size() * 0.25));
 
-    {
-      // Create a map from vertices to adjacent cells
-      const std::vector<
-        std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>>
-        vertex_to_cells(GridTools::vertex_to_cell_map(*triangulation));
-
-      // Create a corresponding map of vectors from vertex to cell center
-      const std::vector<std::vector<Tensor<1, spacedim>>>
-        vertex_to_cell_centers(
-          GridTools::vertex_to_cell_centers_directions(*triangulation,
-                                                       vertex_to_cells));
-
-      std::vector<unsigned int> neighbor_permutation;
+    if (particles_out_of_cell.size() > 0)
+      {
+        // The data of the cache is computed on first access. Compute it
+        // before the parallel search below, such that the worker threads only
+        // read from the cache.
+        triangulation_cache->get_vertex_to_cell_map();
+        triangulation_cache->get_vertex_to_cell_centers_directions();
+        triangulation_cache->get_used_vertices_rtree();
+
+        // Find the cells that the particles moved to. The search starts at
+        // the cells adjacent to the vertex of the old cell that is closest
+        // to the particle, where most particles are found, and only uses the
+        // R-tree of the cache to search the whole local domain otherwise.
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                new_cells(particles_out_of_cell.size());
+        std::vector<Point<dim>> new_reference_locations(
+          particles_out_of_cell.size());
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(particles_out_of_cell.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              {
+                const particle_iterator &it = particles_out_of_cell[i];
+                const typename Triangulation<dim,
+                                             spacedim>::active_cell_iterator
+                  old_cell = it->get_surrounding_cell(*triangulation);
+                try
+                  {
+                    const auto cell_and_reference_location =
+                      GridTools::find_active_cell_around_point(
+                        *triangulation_cache, it->get_location(), old_cell);
+                    new_cells[i] = cell_and_reference_location.first;
+                    new_reference_locations[i] =
+                      cell_and_reference_location.second;
+                  }
+                catch (GridTools::ExcPointNotFound<spacedim> &)
+                  {
+                    // We can find no cell for this particle. It has left the
+                    // domain due to an integration error or an open boundary.
+                    // Its entry in new_cells remains invalid.
+                  }
+              }
+          },
+          16);
 
-      // Find the cells that the particles moved to.
-      typename std::vector<particle_iterator>::iterator
-        it           = particles_out_of_cell.begin(),
-        end_particle = particles_out_of_cell.end();
+        for (unsigned int i = 0; i < particles_out_of_cell.size(); ++i)
+          {
+            if (new_cells[i].state() != IteratorState::valid)
+              continue;
 
-      for (; it != end_particle; ++it)
-        {
-          // The cell the particle is in
-          Point<dim> current_reference_position;
-          bool       found_cell = false;
-
-          // Check if the particle is in one of the old cell's neighbors
-          // that are adjacent to the closest vertex
-          typename Triangulation<dim, spacedim>::active_cell_iterator
-            current_cell = (*it)->get_surrounding_cell(*triangulation);
-
-          const unsigned int closest_vertex =
-            GridTools::find_closest_vertex_of_cell<dim, spacedim>(
-              current_cell, (*it)->get_location());
-          Tensor<1, spacedim> vertex_to_particle =
-            (*it)->get_location() - current_cell->vertex(closest_vertex);
-          vertex_to_particle /= vertex_to_particle.norm();
-
-          const unsigned int closest_vertex_index =
-            current_cell->vertex_index(closest_vertex);
-          const unsigned int n_neighbor_cells =
-            vertex_to_cells[closest_vertex_index].size();
-
-          neighbor_permutation.resize(n_neighbor_cells);
-          for (unsigned int i = 0; i < n_neighbor_cells; ++i)
-            neighbor_permutation[i] = i;
-
-          std::sort(neighbor_permutation.begin(),
-                    neighbor_permutation.end(),
-                    std::bind(&compare_particle_association<spacedim>,
-                              std::placeholders::_1,
-                              std::placeholders::_2,
-                              std::cref(vertex_to_particle),
-                              std::cref(
-                                vertex_to_cell_centers[closest_vertex_index])));
-
-          // Search all of the cells adjacent to the closest vertex of the
-          // previous cell Most likely we will find the particle in them.
-          for (unsigned int i = 0; i < n_neighbor_cells; ++i)
-            {
-              try
-                {
-                  typename std::set<typename Triangulation<dim, spacedim>::
-                                      active_cell_iterator>::const_iterator
-                    cell = vertex_to_cells[closest_vertex_index].begin();
-
-                  std::advance(cell, neighbor_permutation[i]);
-                  const Point<dim> p_unit =
-                    mapping->transform_real_to_unit_cell(*cell,
-                                                         (*it)->get_location());
-                  if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
-                    {
-                      current_cell               = *cell;
-                      current_reference_position = p_unit;
-                      found_cell                 = true;
-                      break;
-                    }
-                }
-              catch (typename Mapping<dim>::ExcTransformationFailed &)
-                {}
-            }
-
-          if (!found_cell)
-            {
-              // The particle is not in a neighbor of the old cell.
-              // Look for the new cell in the whole local domain.
-              // This case is rare.
-              try
-                {
-                  const std::pair<const typename Triangulation<dim, spacedim>::
-                                    active_cell_iterator,
-                                  Point<dim>>
-                    current_cell_and_position =
-                      GridTools::find_active_cell_around_point<>(
-                        *mapping, *triangulation, (*it)->get_location());
-                  current_cell               = current_cell_and_position.first;
-                  current_reference_position = current_cell_and_position.second;
-                }
-              catch (GridTools::ExcPointNotFound<spacedim> &)
-                {
-                  // We can find no cell for this particle. It has left the
-                  // domain due to an integration error or an open boundary.
-                  continue;
-                }
-            }
-
-          // If we are here, we found a cell and reference position for this
-          // particle
-          (*it)->set_reference_location(current_reference_position);
-
-          // Reinsert the particle into our domain if we own its cell.
-          // Mark it for MPI transfer otherwise
-          if (current_cell->is_locally_owned())
-            {
-              sorted_particles.push_back(
-                std::make_pair(internal::LevelInd(current_cell->level(),
-                                                  current_cell->index()),
-                               (*it)->particle->second));
-            }
-          else
-            {
-              moved_particles[current_cell->subdomain_id()].push_back(*it);
-              moved_cells[current_cell->subdomain_id()].push_back(current_cell);
-            }
-        }
-    }
+            particle_iterator &it           = particles_out_of_cell[i];
+            const auto &       current_cell = new_cells[i];
+            it->set_reference_location(new_reference_locations[i]);
 
-    // Sort the updated particles. This pre-sort speeds up inserting
-    // them into particles to O(N) complexity.
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-      sorted_particles_map;
+            // Reinsert the particle into our domain if we own its cell.
+            // Mark it for MPI transfer otherwise
+            if (current_cell->is_locally_owned())
+              {
+                sorted_particles.push_back(
+                  std::make_pair(internal::LevelInd(current_cell->level(),
+                                                    current_cell->index()),
+                                 it->get_handle()));
+              }
+            else
+              {
+                moved_particles[current_cell->subdomain_id()].push_back(it);
+                moved_cells[current_cell->subdomain_id()].push_back(
+                  current_cell);
+              }
+          }
+      }
 
-    // Exchange particles between processors if we have more than one process
+    // Exchange particles between processors if we have more than one process.
+    // Inserting the received particles does not invalidate the iterators
+    // in particles_out_of_cell, because new particles are always appended to
+    // the particles of a cell.
 #  ifdef DEAL_II_WITH_MPI
     if (dealii::Utilities::MPI::n_mpi_processes(
           triangulation->get_communicator()) > 1)
-      send_recv_particles(moved_particles, sorted_particles_map, moved_cells);
+      send_recv_particles(moved_particles, particles, moved_cells);
 #  endif
 
-    sorted_particles_map.insert(sorted_particles.begin(),
-                                sorted_particles.end());
+    // Copy the particles that stay on this process into their new cells,
+    // then remove all particles from their old cells in one sweep, and
+    // finally restore the cell-wise contiguous storage of the particle data.
+    for (const auto &sorted_particle : sorted_particles)
+      particles.insert_copy(particles.get_cell(sorted_particle.first),
+                            sorted_particle.second);
 
-    for (unsigned int i = 0; i < particles_out_of_cell.size(); ++i)
-      remove_particle(particles_out_of_cell[i]);
+    remove_particles(particles_out_of_cell);
 
-    particles.insert(sorted_particles_map.begin(), sorted_particles_map.end());
+    particles.reorder_by_cell();
+    ghost_particles_cache.valid = false;
     update_cached_numbers();
   }
 
@@ -760,8 +841,11 @@ namespace Particles
 
   template <int dim, int spacedim>
   void
-  ParticleHandler<dim, spacedim>::exchange_ghost_particles()
+  ParticleHandler<dim, spacedim>::exchange_ghost_particles(
+    const bool enable_ghost_cache)
   {
+    ghost_particles_cache.valid = false;
+
     // Nothing to do in serial computations
     if (dealii::Utilities::MPI::n_mpi_processes(
           triangulation->get_communicator()) == 1)
@@ -779,7 +863,7 @@ namespace Particles
     for (const auto ghost_owner : ghost_owners)
       ghost_particles_by_domain[ghost_owner].reserve(
         static_cast<typename std::vector<particle_iterator>::size_type>(
-          particles.size() * 0.25));
+          particles.n_particles() * 0.25));
 
     std::vector<std::set<unsigned int>> vertex_to_neighbor_subdomain(
       triangulation->n_vertices());
@@ -823,24 +907,159 @@ namespace Particles
           }
       }
 
-    send_recv_particles(ghost_particles_by_domain, ghost_particles);
+    send_recv_particles(
+      ghost_particles_by_domain,
+      ghost_particles,
+      std::map<
+        types::subdomain_id,
+        std::vector<
+          typename Triangulation<dim, spacedim>::active_cell_iterator>>(),
+      enable_ghost_cache);
+    ghost_particles.reorder_by_cell();
+
+    if (enable_ghost_cache)
+      {
+        ghost_particles_cache.ghost_particles_by_domain =
+          std::move(ghost_particles_by_domain);
+        ghost_particles_cache.valid = true;
+      }
 #  endif
   }
 
 
 
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::update_ghost_particles()
+  {
+    // Nothing to do in serial computations
+    if (dealii::Utilities::MPI::n_mpi_processes(
+          triangulation->get_communicator()) == 1)
+      return;
+
+#  ifdef DEAL_II_WITH_MPI
+    Assert(ghost_particles_cache.valid,
+           ExcMessage("The ghost particles can only be updated after "
+                      "exchange_ghost_particles() has been called with "
+                      "enable_ghost_cache == true, and as long as no "
+                      "particle has been inserted, removed, or sorted into "
+                      "a new cell since."));
+
+    const std::size_t  particle_size = ghost_particle_update_size();
+    const unsigned int n_neighbors   = ghost_particles_cache.neighbors.size();
+
+    // The sizes of all messages are known from the last exchange
+    std::vector<std::size_t> send_offsets(n_neighbors + 1, 0);
+    std::vector<std::size_t> recv_offsets(n_neighbors + 1, 0);
+    for (unsigned int i = 0; i < n_neighbors; ++i)
+      {
+        send_offsets[i + 1] =
+          send_offsets[i] +
+          ghost_particles_cache.n_send_particles[i] * particle_size;
+        recv_offsets[i + 1] =
+          recv_offsets[i] +
+          ghost_particles_cache.n_recv_particles[i] * particle_size;
+      }
+
+    std::vector<char> &send_data = ghost_particles_cache.send_data;
+    std::vector<char> &recv_data = ghost_particles_cache.recv_data;
+    send_data.resize(send_offsets.back());
+    recv_data.resize(recv_offsets.back());
+
+    // Serialize the particles in the same order as in the last exchange
+    void *data = static_cast<void *>(send_data.data());
+    for (unsigned int i = 0; i < n_neighbors; ++i)
+      if (ghost_particles_cache.n_send_particles[i] > 0)
+        for (const auto &particle :
+             ghost_particles_cache.ghost_particles_by_domain.at(
+               ghost_particles_cache.neighbors[i]))
+          {
+            particle->write_data(data);
+            if (store_callback)
+              data = store_callback(particle, data);
+          }
+    Assert(data == send_data.data() + send_data.size(), ExcInternalError());
+
+    {
+      std::vector<MPI_Request> requests(2 * n_neighbors);
+      unsigned int             n_requests = 0;
+
+      for (unsigned int i = 0; i < n_neighbors; ++i)
+        if (recv_offsets[i + 1] > recv_offsets[i])
+          {
+            const int ierr =
+              MPI_Irecv(&(recv_data[recv_offsets[i]]),
+                        static_cast<int>(recv_offsets[i + 1] - recv_offsets[i]),
+                        MPI_CHAR,
+                        ghost_particles_cache.neighbors[i],
+                        2,
+                        triangulation->get_communicator(),
+                        &(requests[n_requests++]));
+            AssertThrowMPI(ierr);
+          }
+
+      for (unsigned int i = 0; i < n_neighbors; ++i)
+        if (send_offsets[i + 1] > send_offsets[i])
+          {
+            const int ierr =
+              MPI_Isend(&(send_data[send_offsets[i]]),
+                        static_cast<int>(send_offsets[i + 1] - send_offsets[i]),
+                        MPI_CHAR,
+                        ghost_particles_cache.neighbors[i],
+                        2,
+                        triangulation->get_communicator(),
+                        &(requests[n_requests++]));
+            AssertThrowMPI(ierr);
+          }
+
+      const int ierr =
+        MPI_Waitall(n_requests, requests.data(), MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+
+    // Overwrite the ghost particles in the order in which they were received
+    // in the last exchange
+    const void *recv_data_it = static_cast<const void *>(recv_data.data());
+    for (const auto &ghost_particle :
+         ghost_particles_cache.ghost_particles_iterators)
+      {
+        ghost_particles.read_data(ghost_particle->get_handle(), recv_data_it);
+        if (load_callback)
+          recv_data_it = load_callback(ghost_particle, recv_data_it);
+      }
+
+    AssertThrow(recv_data_it == recv_data.data() + recv_data.size(),
+                ExcMessage(
+                  "The amount of data that was read into the ghost particles "
+                  "does not match the amount of data sent around."));
+#  endif
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  ParticleHandler<dim, spacedim>::ghost_particle_update_size() const
+  {
+    return sizeof(types::particle_index) + sizeof(Point<spacedim>) +
+           sizeof(Point<dim>) + sizeof(double) * n_properties_per_particle() +
+           (size_callback ? size_callback() : 0);
+  }
+
+
+
 #  ifdef DEAL_II_WITH_MPI
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::send_recv_particles(
     const std::map<types::subdomain_id, std::vector<particle_iterator>>
       &particles_to_send,
-    std::multimap<internal::LevelInd, Particle<dim, spacedim>>
-      &received_particles,
+    internal::ParticleStorage<dim, spacedim> &received_particles,
     const std::map<
       types::subdomain_id,
       std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
-      &send_cells)
+      &        send_cells,
+    const bool build_cache)
   {
     // Determine the communication pattern
     const std::set<types::subdomain_id> ghost_owners =
@@ -890,41 +1109,83 @@ namespace Particles
           begin()->serialized_size_in_bytes() + cellid_size +
           (size_callback ? size_callback() : 0);
         send_data.resize(n_send_particles * particle_size);
-        void *data = static_cast<void *>(&send_data.front());
 
-        // Serialize the data sorted by receiving process
-        for (unsigned int i = 0; i < n_neighbors; ++i)
+        const auto get_cell = [&](const unsigned int i, const unsigned int j) {
+          // If no target cells are given, use the iterator information
+          if (send_cells.size() == 0)
+            return typename Triangulation<dim, spacedim>::active_cell_iterator(
+              particles_to_send.at(neighbors[i])[j]->get_surrounding_cell(
+                *triangulation));
+          else
+            return send_cells.at(neighbors[i])[j];
+        };
+
+        if (store_callback)
           {
-            send_offsets[i] = reinterpret_cast<std::size_t>(data) -
-                              reinterpret_cast<std::size_t>(&send_data.front());
+            void *data = static_cast<void *>(&send_data.front());
 
-            for (unsigned int j = 0;
-                 j < particles_to_send.at(neighbors[i]).size();
-                 ++j)
+            // Serialize the data sorted by receiving process. The store
+            // callback determines how much data is written for each
+            // particle, so the particles are written one after the other.
+            for (unsigned int i = 0; i < n_neighbors; ++i)
               {
-                // If no target cells are given, use the iterator information
-                typename Triangulation<dim, spacedim>::active_cell_iterator
-                  cell;
-                if (send_cells.size() == 0)
-                  cell =
-                    particles_to_send.at(neighbors[i])[j]->get_surrounding_cell(
-                      *triangulation);
-                else
-                  cell = send_cells.at(neighbors[i])[j];
-
-                const CellId::binary_type cellid =
-                  cell->id().template to_binary<dim>();
-                memcpy(data, &cellid, cellid_size);
-                data = static_cast<char *>(data) + cellid_size;
-
-                particles_to_send.at(neighbors[i])[j]->write_data(data);
-                if (store_callback)
-                  data =
-                    store_callback(particles_to_send.at(neighbors[i])[j], data);
+                send_offsets[i] =
+                  reinterpret_cast<std::size_t>(data) -
+                  reinterpret_cast<std::size_t>(&send_data.front());
+
+                for (unsigned int j = 0;
+                     j < particles_to_send.at(neighbors[i]).size();
+                     ++j)
+                  {
+                    const CellId::binary_type cellid =
+                      get_cell(i, j)->id().template to_binary<dim>();
+                    memcpy(data, &cellid, cellid_size);
+                    data = static_cast<char *>(data) + cellid_size;
+
+                    particles_to_send.at(neighbors[i])[j]->write_data(data);
+                    data = store_callback(particles_to_send.at(neighbors[i])[j],
+                                          data);
+                  }
+                n_send_data[i] =
+                  reinterpret_cast<std::size_t>(data) - send_offsets[i] -
+                  reinterpret_cast<std::size_t>(&send_data.front());
+              }
+          }
+        else
+          {
+            // Without a store callback, every particle occupies the same
+            // number of bytes, so the position of each particle in the send
+            // buffer is known in advance and the particles can be
+            // serialized in parallel.
+            unsigned int offset = 0;
+            for (unsigned int i = 0; i < n_neighbors; ++i)
+              {
+                send_offsets[i] = offset;
+                n_send_data[i] =
+                  particles_to_send.at(neighbors[i]).size() * particle_size;
+                offset += n_send_data[i];
               }
-            n_send_data[i] = reinterpret_cast<std::size_t>(data) -
-                             send_offsets[i] -
-                             reinterpret_cast<std::size_t>(&send_data.front());
+
+            for (unsigned int i = 0; i < n_neighbors; ++i)
+              parallel::apply_to_subranges(
+                0U,
+                static_cast<unsigned int>(
+                  particles_to_send.at(neighbors[i]).size()),
+                [&, i](const unsigned int begin, const unsigned int end) {
+                  for (unsigned int j = begin; j < end; ++j)
+                    {
+                      void *data = static_cast<void *>(
+                        &send_data[send_offsets[i] + j * particle_size]);
+
+                      const CellId::binary_type cellid =
+                        get_cell(i, j)->id().template to_binary<dim>();
+                      memcpy(data, &cellid, cellid_size);
+                      data = static_cast<char *>(data) + cellid_size;
+
+                      particles_to_send.at(neighbors[i])[j]->write_data(data);
+                    }
+                },
+                64);
           }
       }
 
@@ -962,6 +1223,28 @@ namespace Particles
       AssertThrowMPI(ierr);
     }
 
+    if (build_cache)
+      {
+        // Record the number of particles exchanged with every neighbor. The
+        // messages of update_ghost_particles() contain the same particles,
+        // but not their cells.
+        const std::size_t update_size = ghost_particle_update_size();
+
+        ghost_particles_cache.neighbors = neighbors;
+        ghost_particles_cache.n_send_particles.assign(n_neighbors, 0);
+        ghost_particles_cache.n_recv_particles.assign(n_neighbors, 0);
+        ghost_particles_cache.ghost_particles_iterators.clear();
+        for (unsigned int i = 0; i < n_neighbors; ++i)
+          {
+            const auto send_particles = particles_to_send.find(neighbors[i]);
+            if (send_particles != particles_to_send.end())
+              ghost_particles_cache.n_send_particles[i] =
+                send_particles->second.size();
+            ghost_particles_cache.n_recv_particles[i] =
+              n_recv_data[i] / (update_size + cellid_size);
+          }
+      }
+
     // Determine how many particles and data we will receive
     unsigned int total_recv_data = 0;
     for (unsigned int neighbor_id = 0; neighbor_id < n_neighbors; ++neighbor_id)
@@ -1027,16 +1310,20 @@ namespace Particles
         const typename Triangulation<dim, spacedim>::active_cell_iterator cell =
           id.to_cell(*triangulation);
 
-        typename std::multimap<internal::LevelInd,
-                               Particle<dim, spacedim>>::iterator
-          recv_particle = received_particles.insert(std::make_pair(
-            internal::LevelInd(cell->level(), cell->index()),
-            Particle<dim, spacedim>(recv_data_it, property_pool.get())));
+        const auto cell_particles = received_particles.get_cell(
+          internal::LevelInd(cell->level(), cell->index()));
+        const unsigned int index =
+          received_particles.insert(cell_particles, recv_data_it);
+
+        const particle_iterator received_particle(received_particles,
+                                                  cell_particles,
+                                                  index);
+        if (build_cache)
+          ghost_particles_cache.ghost_particles_iterators.push_back(
+            received_particle);
 
         if (load_callback)
-          recv_data_it =
-            load_callback(particle_iterator(received_particles, recv_particle),
-                          recv_data_it);
+          recv_data_it = load_callback(received_particle, recv_data_it);
       }
 
     AssertThrow(recv_data_it == recv_data.data() + recv_data.size(),
@@ -1143,6 +1430,8 @@ namespace Particles
 
         non_const_triangulation->notify_ready_to_unpack(handle,
                                                         callback_function);
+        particles.reorder_by_cell();
+        ghost_particles_cache.valid = false;
 
         // Reset handle and update global number of particles. The number
         // can change because of discarded or newly generated particles
@@ -1153,13 +1442,99 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::connect_particle_weights(
+    const unsigned int particle_weight,
+    const unsigned int cell_weight)
+  {
+    this->particle_weight  = particle_weight;
+    additional_cell_weight = cell_weight;
+
+    parallel::distributed::Triangulation<dim, spacedim>
+      *non_const_triangulation =
+        const_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+          &(*triangulation));
+
+    cell_weight_connection =
+      non_const_triangulation->signals.cell_weight.connect(
+        std::bind(&ParticleHandler<dim, spacedim>::cell_weight,
+                  std::cref(*this),
+                  std::placeholders::_1,
+                  std::placeholders::_2));
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::disconnect_particle_weights()
+  {
+    cell_weight_connection.disconnect();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::repartition()
+  {
+    parallel::distributed::Triangulation<dim, spacedim>
+      *non_const_triangulation =
+        const_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+          &(*triangulation));
+
+    register_store_callback_function();
+    repartition_triangulation(*non_const_triangulation);
+    register_load_callback_function(false);
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  ParticleHandler<dim, spacedim>::cell_weight(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const typename Triangulation<dim, spacedim>::CellStatus     status) const
+  {
+    unsigned int n_particles = 0;
+
+    switch (status)
+      {
+        case parallel::distributed::Triangulation<dim, spacedim>::CELL_PERSIST:
+        case parallel::distributed::Triangulation<dim, spacedim>::CELL_REFINE:
+          // The particles are still stored in the cell itself.
+          n_particles = particles.n_particles_in_cell(
+            internal::LevelInd(cell->level(), cell->index()));
+          break;
+
+        case parallel::distributed::Triangulation<dim, spacedim>::CELL_COARSEN:
+          // The particles are stored in the children that are going to be
+          // coarsened into this cell.
+          for (unsigned int child_index = 0; child_index < cell->n_children();
+               ++child_index)
+            n_particles += particles.n_particles_in_cell(
+              internal::LevelInd(cell->child(child_index)->level(),
+                                 cell->child(child_index)->index()));
+          break;
+
+        default:
+          Assert(false, ExcInternalError());
+          break;
+      }
+
+    return additional_cell_weight + particle_weight * n_particles;
+  }
+
+
+
   template <int dim, int spacedim>
   std::vector<char>
   ParticleHandler<dim, spacedim>::store_particles(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const typename Triangulation<dim, spacedim>::CellStatus     status) const
   {
-    std::vector<Particle<dim, spacedim>> stored_particles_on_cell;
+    std::vector<particle_iterator> stored_particles_on_cell;
 
     switch (status)
       {
@@ -1168,25 +1543,14 @@ namespace Particles
           // If the cell persist or is refined store all particles of the
           // current cell.
           {
-            unsigned int n_particles = 0;
-
-            const internal::LevelInd level_index = {cell->level(),
-                                                    cell->index()};
-            const auto               particles_in_cell =
-              (cell->is_ghost() ? ghost_particles.equal_range(level_index) :
-                                  particles.equal_range(level_index));
-
-            n_particles = n_particles_in_cell(cell);
+            const unsigned int n_particles = n_particles_in_cell(cell);
             stored_particles_on_cell.reserve(n_particles);
 
-            std::for_each(
-              particles_in_cell.first,
-              particles_in_cell.second,
-              [&stored_particles_on_cell](
-                const std::pair<internal::LevelInd, Particle<dim, spacedim>>
-                  &particle) {
-                stored_particles_on_cell.push_back(particle.second);
-              });
+            const particle_iterator_range range = particles_in_cell(cell);
+            for (particle_iterator particle = range.begin();
+                 particle != range.end();
+                 ++particle)
+              stored_particles_on_cell.push_back(particle);
 
             AssertDimension(n_particles, stored_particles_on_cell.size());
           }
@@ -1214,22 +1578,13 @@ namespace Particles
                  ++child_index)
               {
                 const typename Triangulation<dim, spacedim>::cell_iterator
-                                         child       = cell->child(child_index);
-                const internal::LevelInd level_index = {child->level(),
-                                                        child->index()};
-                const auto               particles_in_cell =
-                  (child->is_ghost() ?
-                     ghost_particles.equal_range(level_index) :
-                     particles.equal_range(level_index));
-
-                std::for_each(
-                  particles_in_cell.first,
-                  particles_in_cell.second,
-                  [&stored_particles_on_cell](
-                    const std::pair<internal::LevelInd, Particle<dim, spacedim>>
-                      &particle) {
-                    stored_particles_on_cell.push_back(particle.second);
-                  });
+                  child = cell->child(child_index);
+
+                const particle_iterator_range range = particles_in_cell(child);
+                for (particle_iterator particle = range.begin();
+                     particle != range.end();
+                     ++particle)
+                  stored_particles_on_cell.push_back(particle);
               }
 
             AssertDimension(n_particles, stored_particles_on_cell.size());
@@ -1251,8 +1606,6 @@ namespace Particles
     const typename Triangulation<dim, spacedim>::CellStatus         status,
     const boost::iterator_range<std::vector<char>::const_iterator> &data_range)
   {
-    // We leave this container non-const to be able to `std::move`
-    // its contents directly into the particles multimap later.
     std::vector<Particle<dim, spacedim>> loaded_particles_on_cell =
       unpack_particles<dim, spacedim>(data_range, *property_pool);
 
@@ -1262,90 +1615,38 @@ namespace Particles
     for (auto &particle : loaded_particles_on_cell)
       particle.set_property_pool(*property_pool);
 
+    // Do not create an entry for a cell without particles
+    if (loaded_particles_on_cell.empty())
+      return;
+
     switch (status)
       {
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_PERSIST:
           {
-            auto position_hint = particles.end();
+            const auto cell_particles = particles.get_cell(
+              internal::LevelInd(cell->level(), cell->index()));
             for (const auto &particle : loaded_particles_on_cell)
-              {
-                // Use std::multimap::emplace_hint to speed up insertion of
-                // particles. This is a C++11 function, but not all compilers
-                // that report a -std=c++11 (like gcc 4.6) implement it, so
-                // require C++14 instead.
-#  ifdef DEAL_II_WITH_CXX14
-                position_hint =
-                  particles.emplace_hint(position_hint,
-                                         std::make_pair(cell->level(),
-                                                        cell->index()),
-                                         std::move(particle));
-#  else
-                position_hint =
-                  particles.insert(position_hint,
-                                   std::make_pair(std::make_pair(cell->level(),
-                                                                 cell->index()),
-                                                  std::move(particle)));
-#  endif
-                // Move the hint position forward by one, i.e., for the next
-                // particle. The 'hint' position will thus be right after the
-                // one just inserted.
-                ++position_hint;
-              }
+              particles.insert(cell_particles, particle);
           }
           break;
 
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_COARSEN:
           {
-            typename std::multimap<internal::LevelInd,
-                                   Particle<dim, spacedim>>::iterator
-              position_hint = particles.end();
+            const auto cell_particles = particles.get_cell(
+              internal::LevelInd(cell->level(), cell->index()));
             for (auto &particle : loaded_particles_on_cell)
               {
                 const Point<dim> p_unit =
                   mapping->transform_real_to_unit_cell(cell,
                                                        particle.get_location());
                 particle.set_reference_location(p_unit);
-                // Use std::multimap::emplace_hint to speed up insertion of
-                // particles. This is a C++11 function, but not all compilers
-                // that report a -std=c++11 (like gcc 4.6) implement it, so
-                // require C++14 instead.
-#  ifdef DEAL_II_WITH_CXX14
-                position_hint =
-                  particles.emplace_hint(position_hint,
-                                         std::make_pair(cell->level(),
-                                                        cell->index()),
-                                         std::move(particle));
-#  else
-                position_hint =
-                  particles.insert(position_hint,
-                                   std::make_pair(std::make_pair(cell->level(),
-                                                                 cell->index()),
-                                                  std::move(particle)));
-#  endif
-                // Move the hint position forward by one, i.e., for the next
-                // particle. The 'hint' position will thus be right after the
-                // one just inserted.
-                ++position_hint;
+                particles.insert(cell_particles, particle);
               }
           }
           break;
 
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_REFINE:
           {
-            std::vector<
-              typename std::multimap<internal::LevelInd,
-                                     Particle<dim, spacedim>>::iterator>
-              position_hints(GeometryInfo<dim>::max_children_per_cell);
-            for (unsigned int child_index = 0;
-                 child_index < GeometryInfo<dim>::max_children_per_cell;
-                 ++child_index)
-              {
-                const typename Triangulation<dim, spacedim>::cell_iterator
-                  child                     = cell->child(child_index);
-                position_hints[child_index] = particles.upper_bound(
-                  std::make_pair(child->level(), child->index()));
-              }
-
             for (auto &particle : loaded_particles_on_cell)
               {
                 for (unsigned int child_index = 0;
@@ -1363,28 +1664,10 @@ namespace Particles
                         if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
                           {
                             particle.set_reference_location(p_unit);
-                            // Use std::multimap::emplace_hint to speed up
-                            // insertion of particles. This is a C++11 function,
-                            // but not all compilers that report a -std=c++11
-                            // (like gcc 4.6) implement it, so require C++14
-                            // instead.
-#  ifdef DEAL_II_WITH_CXX14
-                            position_hints[child_index] =
-                              particles.emplace_hint(
-                                position_hints[child_index],
-                                std::make_pair(child->level(), child->index()),
-                                std::move(particle));
-#  else
-                            position_hints[child_index] = particles.insert(
-                              position_hints[child_index],
-                              std::make_pair(std::make_pair(child->level(),
-                                                            child->index()),
-                                             std::move(particle)));
-#  endif
-                            // Move the hint position forward by one, i.e., for
-                            // the next particle. The 'hint' position will thus
-                            // be right after the one just inserted.
-                            ++position_hints[child_index];
+                            particles.insert(
+                              particles.get_cell(internal::LevelInd(
+                                child->level(), child->index())),
+                              particle);
                             break;
                           }
                       }
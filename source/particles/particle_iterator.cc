@@ -21,10 +21,11 @@ namespace Particles
 {
   template <int dim, int spacedim>
   ParticleIterator<dim, spacedim>::ParticleIterator(
-    const std::multimap<internal::LevelInd, Particle<dim, spacedim>> &map,
-    const typename std::multimap<internal::LevelInd,
-                                 Particle<dim, spacedim>>::iterator & particle)
-    : accessor(map, particle)
+    const internal::ParticleStorage<dim, spacedim> &storage,
+    const typename internal::ParticleStorage<dim, spacedim>::cell_map_iterator
+      &                cell,
+    const unsigned int index)
+    : accessor(storage, cell, index)
   {}
 
 
@@ -0,0 +1,418 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/particles/particle_storage.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  namespace internal
+  {
+    template <int dim, int spacedim>
+    ParticleStorage<dim, spacedim>::ParticleStorage(
+      const unsigned int n_properties)
+      : n_properties(n_properties)
+      , n_stored_particles(0)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    ParticleStorage<dim, spacedim>::reinit(const unsigned int n_properties)
+    {
+      clear();
+      this->n_properties = n_properties;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    ParticleStorage<dim, spacedim>::clear()
+    {
+      n_stored_particles = 0;
+      cells.clear();
+
+      // swap with empty vectors to actually release the memory
+      std::vector<Point<spacedim>>().swap(locations);
+      std::vector<Point<dim>>().swap(reference_locations);
+      std::vector<types::particle_index>().swap(ids);
+      std::vector<double>().swap(properties);
+      std::vector<Handle>().swap(free_handles);
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    ParticleStorage<dim, spacedim>::reserve(const std::size_t n_particles)
+    {
+      locations.reserve(n_particles);
+      reference_locations.reserve(n_particles);
+      ids.reserve(n_particles);
+      properties.reserve(n_particles * n_properties);
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    ParticleStorage<dim, spacedim>::n_particles_in_cell(
+      const LevelInd &cell) const
+    {
+      const auto entry = cells.find(cell);
+      return (entry == cells.end()) ? 0 : entry->second.size();
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    ParticleStorage<dim, spacedim>::max_n_particles_per_cell() const
+    {
+      std::size_t max_n_particles = 0;
+      for (const auto &cell : cells)
+        max_n_particles = std::max(max_n_particles, cell.second.size());
+
+      return max_n_particles;
+    }
+
+
+
+    template <int dim, int spacedim>
+    typename ParticleStorage<dim, spacedim>::cell_map_iterator
+    ParticleStorage<dim, spacedim>::lower_bound(const LevelInd &cell)
+    {
+      return cells.lower_bound(cell);
+    }
+
+
+
+    template <int dim, int spacedim>
+    typename ParticleStorage<dim, spacedim>::cell_map_iterator
+    ParticleStorage<dim, spacedim>::get_cell(const LevelInd &cell)
+    {
+      const cell_map_iterator entry = cells.lower_bound(cell);
+      if (entry != cells.end() && entry->first == cell)
+        return entry;
+
+      return cells.emplace_hint(entry, cell, std::vector<Handle>());
+    }
+
+
+
+    template <int dim, int spacedim>
+    typename ParticleStorage<dim, spacedim>::Handle
+    ParticleStorage<dim, spacedim>::allocate_handle()
+    {
+      Handle handle;
+      if (free_handles.size() > 0)
+        {
+          handle = free_handles.back();
+          free_handles.pop_back();
+
+          const ArrayView<double> slot_properties = get_properties(handle);
+          std::fill(slot_properties.begin(), slot_properties.end(), 0.0);
+        }
+      else
+        {
+          handle = locations.size();
+          locations.emplace_back();
+          reference_locations.emplace_back();
+          ids.emplace_back();
+          properties.resize(properties.size() + n_properties, 0.0);
+        }
+
+      ++n_stored_particles;
+      return handle;
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    ParticleStorage<dim, spacedim>::insert(
+      const cell_map_iterator &      cell,
+      const Particle<dim, spacedim> &particle)
+    {
+      const Handle handle = allocate_handle();
+
+      locations[handle]           = particle.get_location();
+      reference_locations[handle] = particle.get_reference_location();
+      ids[handle]                 = particle.get_id();
+
+      if (particle.has_properties())
+        {
+          const ArrayView<const double> particle_properties =
+            particle.get_properties();
+          AssertDimension(particle_properties.size(), n_properties);
+          std::copy(particle_properties.begin(),
+                    particle_properties.end(),
+                    get_properties(handle).begin());
+        }
+
+      cell->second.push_back(handle);
+      return cell->second.size() - 1;
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    ParticleStorage<dim, spacedim>::insert(
+      const cell_map_iterator &   cell,
+      const Point<spacedim> &     location,
+      const Point<dim> &          reference_location,
+      const types::particle_index id)
+    {
+      const Handle handle = allocate_handle();
+
+      locations[handle]           = location;
+      reference_locations[handle] = reference_location;
+      ids[handle]                 = id;
+
+      cell->second.push_back(handle);
+      return cell->second.size() - 1;
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    ParticleStorage<dim, spacedim>::insert(const cell_map_iterator &cell,
+                                           const void *&            data)
+    {
+      const Handle handle = allocate_handle();
+      read_data(handle, data);
+
+      cell->second.push_back(handle);
+      return cell->second.size() - 1;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    ParticleStorage<dim, spacedim>::read_data(const Handle handle,
+                                              const void *&data)
+    {
+      AssertIndexRange(handle, ids.size());
+
+      const types::particle_index *id_data =
+        static_cast<const types::particle_index *>(data);
+      ids[handle]         = *id_data++;
+      const double *pdata = reinterpret_cast<const double *>(id_data);
+
+      for (unsigned int i = 0; i < spacedim; ++i)
+        locations[handle](i) = *pdata++;
+
+      for (unsigned int i = 0; i < dim; ++i)
+        reference_locations[handle](i) = *pdata++;
+
+      const ArrayView<double> particle_properties = get_properties(handle);
+      for (unsigned int i = 0; i < n_properties; ++i)
+        particle_properties[i] = *pdata++;
+
+      data = static_cast<const void *>(pdata);
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    ParticleStorage<dim, spacedim>::insert_copy(const cell_map_iterator &cell,
+                                                const Handle source)
+    {
+      // allocate the new slot first, the arrays might be reallocated
+      const Handle handle = allocate_handle();
+
+      locations[handle]           = locations[source];
+      reference_locations[handle] = reference_locations[source];
+      ids[handle]                 = ids[source];
+      std::copy(properties.begin() +
+                  static_cast<std::size_t>(source) * n_properties,
+                properties.begin() +
+                  static_cast<std::size_t>(source + 1) * n_properties,
+                properties.begin() +
+                  static_cast<std::size_t>(handle) * n_properties);
+
+      cell->second.push_back(handle);
+      return cell->second.size() - 1;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    ParticleStorage<dim, spacedim>::erase(const cell_map_iterator &cell,
+                                          const unsigned int       index)
+    {
+      AssertIndexRange(index, cell->second.size());
+
+      free_handles.push_back(cell->second[index]);
+      --n_stored_particles;
+
+      cell->second.erase(cell->second.begin() + index);
+      if (cell->second.empty())
+        cells.erase(cell);
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    ParticleStorage<dim, spacedim>::remove(
+      const std::vector<std::pair<cell_map_iterator, unsigned int>> &positions)
+    {
+      if (positions.empty())
+        return;
+
+      // Sort the positions by cell and by index within the cell, such that
+      // the particles of each cell can be removed in a single pass over the
+      // list of particles of that cell.
+      std::vector<std::pair<cell_map_iterator, unsigned int>> sorted_positions(
+        positions);
+      std::sort(sorted_positions.begin(),
+                sorted_positions.end(),
+                [](const std::pair<cell_map_iterator, unsigned int> &a,
+                   const std::pair<cell_map_iterator, unsigned int> &b) {
+                  return (a.first->first < b.first->first) ||
+                         (a.first->first == b.first->first &&
+                          a.second < b.second);
+                });
+
+      auto position = sorted_positions.begin();
+      while (position != sorted_positions.end())
+        {
+          const cell_map_iterator cell           = position->first;
+          std::vector<Handle> &   cell_particles = cell->second;
+
+          unsigned int n_kept = 0;
+          for (unsigned int i = 0; i < cell_particles.size(); ++i)
+            if (position != sorted_positions.end() &&
+                position->first == cell && position->second == i)
+              {
+                free_handles.push_back(cell_particles[i]);
+                --n_stored_particles;
+                ++position;
+              }
+            else
+              cell_particles[n_kept++] = cell_particles[i];
+
+          Assert(position == sorted_positions.end() ||
+                   position->first != cell,
+                 ExcMessage("The list of particles to be removed contains "
+                            "invalid or duplicate positions."));
+          while (position != sorted_positions.end() &&
+                 position->first == cell)
+            ++position;
+
+          cell_particles.resize(n_kept);
+          if (cell_particles.empty())
+            cells.erase(cell);
+        }
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    ParticleStorage<dim, spacedim>::reorder_by_cell()
+    {
+      // Check whether the particles are already sorted and free of gaps, a
+      // common situation if nothing has changed since the last call.
+      {
+        Handle next_handle = 0;
+        bool   is_sorted   = (locations.size() == n_stored_particles);
+        for (auto cell = cells.begin(); is_sorted && cell != cells.end();
+             ++cell)
+          for (const Handle handle : cell->second)
+            if (handle != next_handle++)
+              {
+                is_sorted = false;
+                break;
+              }
+
+        if (is_sorted)
+          return;
+      }
+
+      std::vector<Point<spacedim>>       new_locations(n_stored_particles);
+      std::vector<Point<dim>>            new_reference_locations(
+        n_stored_particles);
+      std::vector<types::particle_index> new_ids(n_stored_particles);
+      std::vector<double> new_properties(n_stored_particles * n_properties);
+
+      Handle new_handle = 0;
+      for (auto &cell : cells)
+        for (Handle &handle : cell.second)
+          {
+            new_locations[new_handle]           = locations[handle];
+            new_reference_locations[new_handle] = reference_locations[handle];
+            new_ids[new_handle]                 = ids[handle];
+            std::copy(properties.begin() +
+                        static_cast<std::size_t>(handle) * n_properties,
+                      properties.begin() +
+                        static_cast<std::size_t>(handle + 1) * n_properties,
+                      new_properties.begin() +
+                        static_cast<std::size_t>(new_handle) * n_properties);
+
+            handle = new_handle++;
+          }
+      AssertDimension(new_handle, n_stored_particles);
+
+      locations.swap(new_locations);
+      reference_locations.swap(new_reference_locations);
+      ids.swap(new_ids);
+      properties.swap(new_properties);
+      free_handles.clear();
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::size_t
+    ParticleStorage<dim, spacedim>::memory_consumption() const
+    {
+      std::size_t memory = sizeof(*this);
+      memory += MemoryConsumption::memory_consumption(locations);
+      memory += MemoryConsumption::memory_consumption(reference_locations);
+      memory += MemoryConsumption::memory_consumption(ids);
+      memory += MemoryConsumption::memory_consumption(properties);
+      memory += MemoryConsumption::memory_consumption(free_handles);
+
+      // estimate the nodes of the map by the stored pair and three pointers
+      // for the tree structure
+      for (const auto &cell : cells)
+        memory += sizeof(cell) + 3 * sizeof(void *) +
+                  cell.second.capacity() * sizeof(Handle);
+      return memory;
+    }
+  } // namespace internal
+} // namespace Particles
+
+DEAL_II_NAMESPACE_CLOSE
+
+DEAL_II_NAMESPACE_OPEN
+
+#include "particle_storage.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -14,17 +14,40 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/std_cxx14/memory.h>
+
 #include <deal.II/particles/property_pool.h>
 
+#include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
 {
-  const PropertyPool::Handle PropertyPool::invalid_handle = nullptr;
+  namespace
+  {
+    /**
+     * The number of doubles in a block of memory of the pool, i.e.,
+     * 32 kilobytes per block.
+     */
+    const unsigned int doubles_per_block = 4096;
+  } // namespace
+
+
+
+  const PropertyPool::Handle PropertyPool::invalid_handle =
+    numbers::invalid_unsigned_int;
 
 
   PropertyPool::PropertyPool(const unsigned int n_properties_per_slot)
     : n_properties(n_properties_per_slot)
+    , slots_per_block(
+        n_properties_per_slot > 0 ?
+          std::max(1U, doubles_per_block / n_properties_per_slot) :
+          1U)
+    , n_touched_slots(0)
   {}
 
 
@@ -34,7 +57,21 @@ namespace Particles
   {
     PropertyPool::Handle handle = PropertyPool::invalid_handle;
     if (n_properties > 0)
-      handle = new double[n_properties];
+      {
+        if (currently_available_handles.size() > 0)
+          {
+            handle = currently_available_handles.back();
+            currently_available_handles.pop_back();
+          }
+        else
+          {
+            if (n_touched_slots == blocks.size() * slots_per_block)
+              blocks.push_back(std_cxx14::make_unique<double[]>(
+                static_cast<std::size_t>(slots_per_block) * n_properties));
+
+            handle = n_touched_slots++;
+          }
+      }
 
     return handle;
   }
@@ -44,7 +81,43 @@ namespace Particles
   void
   PropertyPool::deallocate_properties_array(Handle handle)
   {
-    delete[] handle;
+    Assert(handle != PropertyPool::invalid_handle, ExcInternalError());
+    Assert(handle < n_touched_slots, ExcInternalError());
+
+    currently_available_handles.push_back(handle);
+  }
+
+
+
+  std::vector<PropertyPool::Handle>
+  PropertyPool::allocate_properties_arrays(const std::size_t n_handles)
+  {
+    std::vector<Handle> handles(n_handles, PropertyPool::invalid_handle);
+    if (n_properties == 0)
+      return handles;
+
+    // Grow the pool once for all handles that can not be taken from the
+    // list of free slots
+    const std::size_t n_in_use =
+      n_touched_slots - currently_available_handles.size();
+    reserve(n_in_use + n_handles);
+
+    for (auto &handle : handles)
+      handle = allocate_properties_array();
+
+    return handles;
+  }
+
+
+
+  void
+  PropertyPool::deallocate_properties_arrays(const std::vector<Handle> &handles)
+  {
+    currently_available_handles.reserve(currently_available_handles.size() +
+                                        handles.size());
+    for (const Handle handle : handles)
+      if (handle != PropertyPool::invalid_handle)
+        deallocate_properties_array(handle);
   }
 
 
@@ -52,7 +125,17 @@ namespace Particles
   ArrayView<double>
   PropertyPool::get_properties(const Handle handle)
   {
-    return ArrayView<double>(handle, n_properties);
+    if (n_properties == 0)
+      return ArrayView<double>();
+
+    Assert(handle != PropertyPool::invalid_handle, ExcInternalError());
+    Assert(handle < n_touched_slots, ExcInternalError());
+
+    return ArrayView<double>(blocks[handle / slots_per_block].get() +
+                               static_cast<std::size_t>(handle %
+                                                        slots_per_block) *
+                                 n_properties,
+                             n_properties);
   }
 
 
@@ -60,7 +143,20 @@ namespace Particles
   void
   PropertyPool::reserve(const std::size_t size)
   {
-    (void)size;
+    if (n_properties == 0)
+      return;
+
+    // Every handle that is in use or in the list of free slots occupies a
+    // slot below n_touched_slots, so the pool can hold 'size' handles in use
+    // once it provides at least as many slots
+    const std::size_t n_blocks = (size + slots_per_block - 1) / slots_per_block;
+    if (n_blocks > blocks.size())
+      {
+        blocks.reserve(n_blocks);
+        while (blocks.size() < n_blocks)
+          blocks.push_back(std_cxx14::make_unique<double[]>(
+            static_cast<std::size_t>(slots_per_block) * n_properties));
+      }
   }
 
 
@@ -70,5 +166,17 @@ namespace Particles
   {
     return n_properties;
   }
+
+
+
+  std::size_t
+  PropertyPool::memory_consumption() const
+  {
+    return sizeof(*this) +
+           blocks.capacity() * sizeof(std::unique_ptr<double[]>) +
+           blocks.size() * static_cast<std::size_t>(slots_per_block) *
+             n_properties * sizeof(double) +
+           MemoryConsumption::memory_consumption(currently_available_handles);
+  }
 } // namespace Particles
 DEAL_II_NAMESPACE_CLOSE
@@ -23,6 +23,7 @@
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/la_parallel_vector.h>
 #  ifdef DEAL_II_WITH_TRILINOS
 #    include <deal.II/lac/trilinos_parallel_block_vector.h>
 #    include <deal.II/lac/trilinos_vector.h>
@@ -33,7 +34,7 @@
 #  endif
 #  include <deal.II/base/utilities.h>
 
-#  include <deal.II/sundials/copy.h>
+#  include <deal.II/sundials/n_vector.templates.h>
 
 #  include <arkode/arkode_impl.h>
 #  include <sundials/sundials_config.h>
@@ -61,20 +62,10 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer dst_yp(mem);
-      solver.reinit_vector(*dst_yp);
-
-      copy(*src_yy, yy);
-
-      int err = solver.explicit_function(tt, *src_yy, *dst_yp);
-
-      copy(yp, *dst_yp);
 
+      int err = solver.explicit_function(tt,
+                                         unwrap_nvector<VectorType>(yy),
+                                         unwrap_nvector<VectorType>(yp));
       return err;
     }
 
@@ -89,20 +80,10 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer dst_yp(mem);
-      solver.reinit_vector(*dst_yp);
-
-      copy(*src_yy, yy);
-
-      int err = solver.implicit_function(tt, *src_yy, *dst_yp);
-
-      copy(yp, *dst_yp);
 
+      int err = solver.implicit_function(tt,
+                                         unwrap_nvector<VectorType>(yy),
+                                         unwrap_nvector<VectorType>(yp));
       return err;
     }
 
@@ -121,24 +102,14 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_ypred(mem);
-      solver.reinit_vector(*src_ypred);
-
-      typename VectorMemory<VectorType>::Pointer src_fpred(mem);
-      solver.reinit_vector(*src_fpred);
-
-      copy(*src_ypred, ypred);
-      copy(*src_fpred, fpred);
 
       // avoid reinterpret_cast
       bool jcurPtr_tmp = false;
       int  err         = solver.setup_jacobian(convfail,
                                       arkode_mem->ark_tn,
                                       arkode_mem->ark_gamma,
-                                      *src_ypred,
-                                      *src_fpred,
+                                      unwrap_nvector<VectorType>(ypred),
+                                      unwrap_nvector<VectorType>(fpred),
                                       jcurPtr_tmp);
 #  if DEAL_II_SUNDIALS_VERSION_GTE(2, 0, 0)
       *jcurPtr = jcurPtr_tmp ? SUNTRUE : SUNFALSE;
@@ -165,29 +136,21 @@ namespace SUNDIALS
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
       GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
-
-      typename VectorMemory<VectorType>::Pointer src_ycur(mem);
-      solver.reinit_vector(*src_ycur);
-
-      typename VectorMemory<VectorType>::Pointer src_fcur(mem);
-      solver.reinit_vector(*src_fcur);
-
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-      copy(*src_ycur, ycur);
-      copy(*src_fcur, fcur);
+      VectorType &rhs = unwrap_nvector<VectorType>(b);
 
       int err = solver.solve_jacobian_system(arkode_mem->ark_tn,
                                              arkode_mem->ark_gamma,
-                                             *src_ycur,
-                                             *src_fcur,
-                                             *src,
+                                             unwrap_nvector<VectorType>(ycur),
+                                             unwrap_nvector<VectorType>(fcur),
+                                             rhs,
                                              *dst);
-      copy(b, *dst);
+
+      // the solution is returned in b, so exchange the vectors instead of
+      // copying the solution
+      rhs.swap(*dst);
 
       return err;
     }
@@ -221,16 +184,16 @@ namespace SUNDIALS
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
       GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
-
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
+      VectorType &rhs = unwrap_nvector<VectorType>(b);
 
-      int err = solver.solve_mass_system(*src, *dst);
-      copy(b, *dst);
+      int err = solver.solve_mass_system(rhs, *dst);
+
+      // the solution is returned in b, so exchange the vectors instead of
+      // copying the solution
+      rhs.swap(*dst);
 
       return err;
     }
@@ -271,8 +234,6 @@ namespace SUNDIALS
   unsigned int
   ARKode<VectorType>::solve_ode(VectorType &solution)
   {
-    unsigned int system_size = solution.size();
-
     double       t           = data.initial_time;
     double       h           = data.initial_step_size;
     unsigned int step_number = 0;
@@ -280,29 +241,6 @@ namespace SUNDIALS
     int status;
     (void)status;
 
-    // The solution is stored in
-    // solution. Here we take only a
-    // view of it.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        Assert(is_serial_vector<VectorType>::value,
-               ExcInternalError(
-                 "Trying to use a serial code with a parallel vector."));
-        yy        = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
     reset(data.initial_time, data.initial_step_size, solution);
 
     double next_time = data.initial_time;
@@ -321,7 +259,7 @@ namespace SUNDIALS
         status = ARKodeGetLastStep(arkode_mem, &h);
         AssertARKode(status);
 
-        copy(solution, yy);
+        solution = unwrap_nvector<VectorType>(yy);
 
         while (solver_should_restart(t, solution))
           reset(t, h, solution);
@@ -332,19 +270,11 @@ namespace SUNDIALS
           output_step(t, solution, step_number);
       }
 
-      // Free the vectors which are no longer used.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        N_VDestroy_Parallel(yy);
-        N_VDestroy_Parallel(abs_tolls);
-      }
-    else
-#  endif
-      {
-        N_VDestroy_Serial(yy);
-        N_VDestroy_Serial(abs_tolls);
-      }
+    // Free the vectors which are no longer used.
+    N_VDestroy(yy);
+    N_VDestroy(abs_tolls);
+    yy        = nullptr;
+    abs_tolls = nullptr;
 
     return step_number;
   }
@@ -355,8 +285,6 @@ namespace SUNDIALS
                             const double      current_time_step,
                             const VectorType &solution)
   {
-    unsigned int system_size;
-
     if (arkode_mem)
       ARKodeFree(&arkode_mem);
 
@@ -365,42 +293,18 @@ namespace SUNDIALS
     // Free the vectors which are no longer used.
     if (yy)
       {
-#  ifdef DEAL_II_WITH_MPI
-        if (is_serial_vector<VectorType>::value == false)
-          {
-            N_VDestroy_Parallel(yy);
-            N_VDestroy_Parallel(abs_tolls);
-          }
-        else
-#  endif
-          {
-            N_VDestroy_Serial(yy);
-            N_VDestroy_Serial(abs_tolls);
-          }
+        N_VDestroy(yy);
+        N_VDestroy(abs_tolls);
       }
 
     int status;
     (void)status;
-    system_size = solution.size();
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        yy        = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
 
-    copy(yy, solution);
+    // The N_Vector objects store their elements in vectors of type
+    // VectorType, such that the user functions can work on the vectors
+    // passed by ARKode without copying them
+    yy        = make_nvector(solution);
+    abs_tolls = make_nvector(solution);
 
     Assert(explicit_function || implicit_function,
            ExcFunctionNotProvided("explicit_function || implicit_function"));
@@ -415,7 +319,7 @@ namespace SUNDIALS
 
     if (get_local_tolerances)
       {
-        copy(abs_tolls, get_local_tolerances());
+        unwrap_nvector<VectorType>(abs_tolls) = get_local_tolerances();
         status =
           ARKodeSVtolerances(arkode_mem, data.relative_tolerance, abs_tolls);
         AssertARKode(status);
@@ -505,6 +409,7 @@ namespace SUNDIALS
 
   template class ARKode<Vector<double>>;
   template class ARKode<BlockVector<double>>;
+  template class ARKode<LinearAlgebra::distributed::Vector<double>>;
 
 #  ifdef DEAL_II_WITH_MPI
 
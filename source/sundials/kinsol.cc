@@ -38,10 +38,13 @@
 #  include <sundials/sundials_config.h>
 #  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
 #    include <kinsol/kinsol_direct.h>
+#    include <kinsol/kinsol_spils.h>
 #    include <sunlinsol/sunlinsol_dense.h>
+#    include <sunlinsol/sunlinsol_spgmr.h>
 #    include <sunmatrix/sunmatrix_dense.h>
 #  else
 #    include <kinsol/kinsol_dense.h>
+#    include <kinsol/kinsol_spgmr.h>
 #  endif
 
 #  include <iomanip>
@@ -148,6 +151,118 @@ namespace SUNDIALS
 
       return err;
     }
+
+
+
+    template <typename VectorType>
+    int
+    t_kinsol_jacobian_times_vector(N_Vector     v,
+                                   N_Vector     Jv,
+                                   N_Vector     u,
+                                   booleantype *new_u,
+                                   void *       user_data)
+    {
+      KINSOL<VectorType> &solver =
+        *static_cast<KINSOL<VectorType> *>(user_data);
+      GrowingVectorMemory<VectorType> mem;
+
+      typename VectorMemory<VectorType>::Pointer src_u(mem);
+      solver.reinit_vector(*src_u);
+
+      typename VectorMemory<VectorType>::Pointer src_v(mem);
+      solver.reinit_vector(*src_v);
+
+      typename VectorMemory<VectorType>::Pointer dst_Jv(mem);
+      solver.reinit_vector(*dst_Jv);
+
+      copy(*src_u, u);
+      copy(*src_v, v);
+
+      int err = solver.jacobian_times_vector(*src_u, *src_v, *dst_Jv);
+      copy(Jv, *dst_Jv);
+
+      // the product has been computed with the current u, so KINSOL does
+      // not need to signal a new u until the next Newton iteration
+      *new_u = false;
+
+      return err;
+    }
+
+
+
+    template <typename VectorType>
+    int
+    t_kinsol_setup_preconditioner(N_Vector uu,
+                                  N_Vector /*uscale*/,
+                                  N_Vector fval,
+                                  N_Vector /*fscale*/,
+                                  void *user_data
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+                                  ,
+                                  N_Vector /*tmp1*/,
+                                  N_Vector /*tmp2*/
+#  endif
+    )
+    {
+      KINSOL<VectorType> &solver =
+        *static_cast<KINSOL<VectorType> *>(user_data);
+      GrowingVectorMemory<VectorType> mem;
+
+      typename VectorMemory<VectorType>::Pointer src_uu(mem);
+      solver.reinit_vector(*src_uu);
+
+      typename VectorMemory<VectorType>::Pointer src_fval(mem);
+      solver.reinit_vector(*src_fval);
+
+      copy(*src_uu, uu);
+      copy(*src_fval, fval);
+
+      int err = solver.setup_preconditioner(*src_uu, *src_fval);
+      return err;
+    }
+
+
+
+    template <typename VectorType>
+    int
+    t_kinsol_solve_with_preconditioner(N_Vector uu,
+                                       N_Vector /*uscale*/,
+                                       N_Vector fval,
+                                       N_Vector /*fscale*/,
+                                       N_Vector vv,
+                                       void *   user_data
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+                                       ,
+                                       N_Vector /*tmp*/
+#  endif
+    )
+    {
+      KINSOL<VectorType> &solver =
+        *static_cast<KINSOL<VectorType> *>(user_data);
+      GrowingVectorMemory<VectorType> mem;
+
+      typename VectorMemory<VectorType>::Pointer src_uu(mem);
+      solver.reinit_vector(*src_uu);
+
+      typename VectorMemory<VectorType>::Pointer src_fval(mem);
+      solver.reinit_vector(*src_fval);
+
+      typename VectorMemory<VectorType>::Pointer src(mem);
+      solver.reinit_vector(*src);
+
+      typename VectorMemory<VectorType>::Pointer dst(mem);
+      solver.reinit_vector(*dst);
+
+      copy(*src_uu, uu);
+      copy(*src_fval, fval);
+      copy(*src, vv);
+
+      int err =
+        solver.solve_with_preconditioner(*src_uu, *src_fval, *src, *dst);
+      copy(vv, *dst);
+
+      return err;
+    }
   } // namespace
 
   template <typename VectorType>
@@ -285,6 +400,37 @@ namespace SUNDIALS
 #  endif
           }
       }
+    else if (data.use_gmres)
+      {
+        const int maximum_krylov_subspace_size =
+          static_cast<int>(data.maximum_krylov_subspace_size);
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+        LS     = SUNSPGMR(u_scale,
+                          solve_with_preconditioner ? PREC_RIGHT : PREC_NONE,
+                          maximum_krylov_subspace_size);
+        status = KINSpilsSetLinearSolver(kinsol_mem, LS);
+#  else
+        status = KINSpgmr(kinsol_mem, maximum_krylov_subspace_size);
+#  endif
+        AssertKINSOL(status);
+
+        if (jacobian_times_vector)
+          {
+            status = KINSpilsSetJacTimesVecFn(
+              kinsol_mem, t_kinsol_jacobian_times_vector<VectorType>);
+            AssertKINSOL(status);
+          }
+
+        if (solve_with_preconditioner)
+          {
+            status = KINSpilsSetPreconditioner(
+              kinsol_mem,
+              setup_preconditioner ? t_kinsol_setup_preconditioner<VectorType> :
+                                     nullptr,
+              t_kinsol_solve_with_preconditioner<VectorType>);
+            AssertKINSOL(status);
+          }
+      }
     else
       {
 #  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
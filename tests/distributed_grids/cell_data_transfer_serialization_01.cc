@@ -0,0 +1,184 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that several vectors of cell data are restored by
+// parallel::distributed::CellDataTransfer with fixed size data, both after
+// refinement and after serialization of the triangulation into a file and
+// loading it into another triangulation.
+
+#include <deal.II/distributed/cell_data_transfer.h>
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+// The value of the vector with the given index on a cell, which does not
+// depend on the numbering of the cells
+template <int dim>
+double
+cell_value(const Point<dim> &center, const unsigned int vector_index)
+{
+  double value = vector_index + 1.;
+  for (unsigned int d = 0; d < dim; ++d)
+    value = value * 3. + (d + 1.) * center[d];
+  return value;
+}
+
+
+
+template <int dim>
+void
+fill_vectors(const parallel::distributed::Triangulation<dim> &tria,
+             std::vector<Vector<double>> &                    vectors)
+{
+  for (unsigned int v = 0; v < vectors.size(); ++v)
+    {
+      vectors[v].reinit(tria.n_active_cells());
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->is_locally_owned())
+          vectors[v][cell->active_cell_index()] = cell_value(cell->center(), v);
+    }
+}
+
+
+
+// Check the values on all locally owned cells. Cells that were refined get
+// the value of their parent.
+template <int dim>
+bool
+check_vectors(const parallel::distributed::Triangulation<dim> &tria,
+              const std::vector<Vector<double>> &              vectors,
+              const bool                                       refined)
+{
+  bool correct = true;
+  for (unsigned int v = 0; v < vectors.size(); ++v)
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const Point<dim> center = (refined && cell->level() > 0) ?
+                                      cell->parent()->center() :
+                                      cell->center();
+          if (vectors[v][cell->active_cell_index()] != cell_value(center, v))
+            correct = false;
+        }
+  return Utilities::MPI::min(correct ? 1 : 0, tria.get_communicator()) == 1;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const MPI_Comm     comm      = MPI_COMM_WORLD;
+  const unsigned int n_vectors = 3;
+  deallog << "Dimension " << dim << std::endl;
+
+  const std::string filename = "save_" + std::to_string(dim) + "d";
+  {
+    parallel::distributed::Triangulation<dim> tria(comm);
+    GridGenerator::hyper_cube(tria);
+    tria.refine_global(dim == 2 ? 3 : 2);
+
+    std::vector<Vector<double>> vectors(n_vectors);
+    fill_vectors(tria, vectors);
+
+    // refine the cells in the lower left corner, which are the only ones
+    // whose value changes
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          bool refine = true;
+          for (unsigned int d = 0; d < dim; ++d)
+            if (cell->center()[d] > 0.5)
+              refine = false;
+          if (refine)
+            cell->set_refine_flag();
+          else
+            for (unsigned int v = 0; v < n_vectors; ++v)
+              vectors[v][cell->active_cell_index()] =
+                cell_value(cell->parent()->center(), v);
+        }
+
+    std::vector<const Vector<double> *> input(n_vectors);
+    for (unsigned int v = 0; v < n_vectors; ++v)
+      input[v] = &vectors[v];
+
+    parallel::distributed::CellDataTransfer<dim, dim, Vector<double>>
+      transfer(tria);
+    transfer.prepare_for_coarsening_and_refinement(input);
+    tria.execute_coarsening_and_refinement();
+
+    std::vector<Vector<double>>   refined_vectors(n_vectors);
+    std::vector<Vector<double> *> output(n_vectors);
+    for (unsigned int v = 0; v < n_vectors; ++v)
+      {
+        refined_vectors[v].reinit(tria.n_active_cells());
+        output[v] = &refined_vectors[v];
+      }
+    transfer.unpack(output);
+    deallog << "Active cells after refinement: "
+            << tria.n_global_active_cells() << ", values correct: "
+            << (check_vectors(tria, refined_vectors, true) ? "yes" : "no")
+            << std::endl;
+
+    // now store the values of the new mesh with the triangulation
+    fill_vectors(tria, refined_vectors);
+    for (unsigned int v = 0; v < n_vectors; ++v)
+      input[v] = &refined_vectors[v];
+    parallel::distributed::CellDataTransfer<dim, dim, Vector<double>>
+      serialization(tria);
+    serialization.prepare_for_serialization(input);
+    tria.save(filename);
+  }
+
+  parallel::distributed::Triangulation<dim> tria(comm);
+  GridGenerator::hyper_cube(tria);
+  tria.load(filename);
+
+  std::vector<Vector<double>>   vectors(n_vectors);
+  std::vector<Vector<double> *> output(n_vectors);
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    {
+      vectors[v].reinit(tria.n_active_cells());
+      output[v] = &vectors[v];
+    }
+  parallel::distributed::CellDataTransfer<dim, dim, Vector<double>>
+    deserialization(tria);
+  deserialization.deserialize(output);
+  deallog << "Active cells after loading: " << tria.n_global_active_cells()
+          << ", values correct: "
+          << (check_vectors(tria, vectors, false) ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+  mpi_initlog();
+
+  test<2>();
+  test<3>();
+}
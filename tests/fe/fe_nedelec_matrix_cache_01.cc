@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that FE_Nedelec elements created from a matrix cache that was
+// written by FETools::save_matrix_cache() and read by
+// FETools::load_matrix_cache() have the same interface constraint,
+// prolongation and restriction matrices as elements that compute them
+// anew.
+
+#include <deal.II/fe/fe_nedelec.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+std::vector<FullMatrix<double>>
+get_matrices(const FiniteElement<dim> &fe)
+{
+  std::vector<FullMatrix<double>> matrices;
+  matrices.push_back(fe.constraints());
+  for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_cell; ++c)
+    {
+      matrices.push_back(fe.get_prolongation_matrix(c));
+      matrices.push_back(fe.get_restriction_matrix(c));
+    }
+  return matrices;
+}
+
+
+
+bool
+identical(const std::vector<FullMatrix<double>> &matrices_1,
+          const std::vector<FullMatrix<double>> &matrices_2)
+{
+  if (matrices_1.size() != matrices_2.size())
+    return false;
+  for (unsigned int i = 0; i < matrices_1.size(); ++i)
+    {
+      if (matrices_1[i].m() != matrices_2[i].m() ||
+          matrices_1[i].n() != matrices_2[i].n())
+        return false;
+      for (unsigned int r = 0; r < matrices_1[i].m(); ++r)
+        for (unsigned int c = 0; c < matrices_1[i].n(); ++c)
+          if (matrices_1[i](r, c) != matrices_2[i](r, c))
+            return false;
+    }
+  return true;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  FETools::clear_matrix_cache();
+
+  std::vector<FullMatrix<double>> computed;
+  std::stringstream               cache;
+  {
+    const FE_Nedelec<dim> fe(degree);
+    computed = get_matrices(fe);
+    FETools::save_matrix_cache(cache);
+    deallog << fe.get_name() << ": " << computed.size() << " matrices, ";
+    double norm = 0.;
+    for (const auto &matrix : computed)
+      norm += matrix.frobenius_norm();
+    deallog << "sum of norms " << norm << std::endl;
+  }
+
+  // a second element uses the cache filled by the first one
+  {
+    const FE_Nedelec<dim> fe(degree);
+    deallog << "From the cache of this run: "
+            << (identical(get_matrices(fe), computed) ? "identical" :
+                                                        "different")
+            << std::endl;
+  }
+
+  // elements created after loading the saved cache into an empty one
+  FETools::clear_matrix_cache();
+  FETools::load_matrix_cache(cache);
+  {
+    const FE_Nedelec<dim> fe(degree);
+    deallog << "From the loaded cache: "
+            << (identical(get_matrices(fe), computed) ? "identical" :
+                                                        "different")
+            << std::endl;
+  }
+
+  // and after computing the matrices once more
+  FETools::clear_matrix_cache();
+  {
+    const FE_Nedelec<dim> fe(degree);
+    deallog << "Computed again: "
+            << (identical(get_matrices(fe), computed) ? "identical" :
+                                                        "different")
+            << std::endl;
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(0);
+  test<2>(1);
+  test<2>(2);
+  test<3>(0);
+  test<3>(1);
+}
@@ -0,0 +1,318 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Compare the interface degrees of freedom, the geometric data, and the
+// jumps and averages of the shape functions computed by FEInterfaceValues
+// with the ones computed from FEFaceValues and FESubfaceValues objects on
+// both cells of each face of a mesh with hanging nodes, for faces between
+// cells on the same level, from the coarse and from the fine side of faces
+// with hanging nodes, and on the boundary.
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_interface_values.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+// A continuous function that is contained in the finite element spaces
+// tested here
+template <int dim>
+class Bilinear : public Function<dim>
+{
+public:
+  Bilinear(const unsigned int n_components)
+    : Function<dim>(n_components)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    return p[0] * p[1] + 2. * p[1] + component;
+  }
+};
+
+
+
+template <int dim>
+void
+check(const FiniteElement<dim> &fe)
+{
+  deallog << fe.get_name() << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  // a function in the finite element space whose jumps must vanish for
+  // continuous elements
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler,
+                           Bilinear<dim>(fe.n_components()),
+                           solution);
+  constraints.distribute(solution);
+
+  const QGauss<dim - 1> quadrature(fe.degree + 1);
+  const UpdateFlags     flags = update_values | update_gradients |
+                            update_hessians | update_quadrature_points |
+                            update_JxW_values | update_normal_vectors;
+  FEInterfaceValues<dim> fe_interface(fe, quadrature, flags);
+  FEFaceValues<dim>      fe_face_values(fe, quadrature, flags);
+  FESubfaceValues<dim>   fe_subface_values(fe, quadrature, flags);
+  FEFaceValues<dim>      fe_face_values_neighbor(fe, quadrature, flags);
+  FESubfaceValues<dim>   fe_subface_values_neighbor(fe, quadrature, flags);
+
+  unsigned int n_faces[4] = {0, 0, 0, 0};
+  double       error_dofs = 0., error_geometry = 0., error_values = 0.,
+         error_gradients = 0., error_hessians = 0., solution_jump = 0.;
+
+  const auto check_interface = [&](const FEFaceValuesBase<dim> &fe_values_0,
+                                   const FEFaceValuesBase<dim> *fe_values_1,
+                                   const std::vector<types::global_dof_index>
+                                     &dofs_0,
+                                   const std::vector<types::global_dof_index>
+                                     &dofs_1) {
+    // the interface degrees of freedom are the ones of the first cell
+    // followed by the ones of the second cell not shared with the first
+    std::vector<types::global_dof_index> interface_dofs = dofs_0;
+    for (const auto dof : dofs_1)
+      if (std::find(dofs_0.begin(), dofs_0.end(), dof) == dofs_0.end())
+        interface_dofs.push_back(dof);
+    if (interface_dofs != fe_interface.get_interface_dof_indices() ||
+        interface_dofs.size() != fe_interface.n_current_interface_dofs())
+      error_dofs += 1.;
+    for (unsigned int i = 0; i < interface_dofs.size(); ++i)
+      {
+        const auto &local = fe_interface.interface_dof_to_dof_indices(i);
+        if ((local[0] != numbers::invalid_unsigned_int &&
+             dofs_0[local[0]] != interface_dofs[i]) ||
+            (local[1] != numbers::invalid_unsigned_int &&
+             dofs_1[local[1]] != interface_dofs[i]) ||
+            (local[0] == numbers::invalid_unsigned_int &&
+             local[1] == numbers::invalid_unsigned_int))
+          error_dofs += 1.;
+      }
+
+    for (unsigned int q = 0; q < quadrature.size(); ++q)
+      {
+        error_geometry =
+          std::max({error_geometry,
+                    fe_interface.get_quadrature_points()[q].distance(
+                      fe_values_0.quadrature_point(q)),
+                    std::abs(fe_interface.get_JxW_values()[q] -
+                             fe_values_0.JxW(q)),
+                    (fe_interface.normal(q) - fe_values_0.normal_vector(q))
+                      .norm()});
+        if (fe_values_1 != nullptr)
+          error_geometry = std::max(
+            {error_geometry,
+             fe_values_1->quadrature_point(q).distance(
+               fe_values_0.quadrature_point(q)),
+             (fe_values_1->normal_vector(q) + fe_values_0.normal_vector(q))
+               .norm()});
+      }
+
+    const unsigned int invalid = numbers::invalid_unsigned_int;
+    for (unsigned int i = 0; i < interface_dofs.size(); ++i)
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        for (unsigned int c = 0; c < fe.n_components(); ++c)
+          {
+            // the data of the shape function on both sides, zero if the
+            // shape function does not live on that side
+            const auto &local = fe_interface.interface_dof_to_dof_indices(i);
+            const bool  on_0  = (local[0] != invalid);
+            const bool  on_1  = (local[1] != invalid);
+
+            const double v0 =
+              on_0 ? fe_values_0.shape_value_component(local[0], q, c) : 0.;
+            const double v1 =
+              on_1 ? fe_values_1->shape_value_component(local[1], q, c) : 0.;
+            const Tensor<1, dim> g0 =
+              on_0 ? fe_values_0.shape_grad_component(local[0], q, c) :
+                     Tensor<1, dim>();
+            const Tensor<1, dim> g1 =
+              on_1 ? fe_values_1->shape_grad_component(local[1], q, c) :
+                     Tensor<1, dim>();
+            const Tensor<2, dim> h0 =
+              on_0 ? fe_values_0.shape_hessian_component(local[0], q, c) :
+                     Tensor<2, dim>();
+            const Tensor<2, dim> h1 =
+              on_1 ? fe_values_1->shape_hessian_component(local[1], q, c) :
+                     Tensor<2, dim>();
+
+            // on the boundary, the jump and the average are the values on
+            // the cell
+            const double weight = fe_values_1 ? 0.5 : 1.;
+            error_values =
+              std::max({error_values,
+                        std::abs(fe_interface.jump(i, q, c) - (v0 - v1)),
+                        std::abs(fe_interface.average(i, q, c) -
+                                 weight * (v0 + v1)),
+                        std::abs(fe_interface.shape_value(true, i, q, c) - v0),
+                        std::abs(fe_interface.shape_value(false, i, q, c) -
+                                 v1)});
+            error_gradients = std::max(
+              {error_gradients,
+               (fe_interface.jump_gradient(i, q, c) - (g0 - g1)).norm(),
+               (fe_interface.average_gradient(i, q, c) - weight * (g0 + g1))
+                 .norm()});
+            error_hessians = std::max(
+              {error_hessians,
+               (fe_interface.jump_hessian(i, q, c) - (h0 - h1)).norm(),
+               (fe_interface.average_hessian(i, q, c) - weight * (h0 + h1))
+                 .norm()});
+          }
+
+    if (fe_values_1 != nullptr)
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          double jump = 0.;
+          for (unsigned int i = 0; i < interface_dofs.size(); ++i)
+            jump += fe_interface.jump(i, q) * solution(interface_dofs[i]);
+          solution_jump = std::max(solution_jump, std::abs(jump));
+        }
+  };
+
+  std::vector<types::global_dof_index> dofs_0(fe.dofs_per_cell),
+    dofs_1(fe.dofs_per_cell);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      {
+        cell->get_dof_indices(dofs_0);
+        if (cell->at_boundary(f))
+          {
+            fe_interface.reinit(cell, f);
+            fe_face_values.reinit(cell, f);
+            AssertThrow(fe_interface.at_boundary(), ExcInternalError());
+            check_interface(fe_face_values, nullptr, dofs_0, dofs_0);
+            ++n_faces[0];
+          }
+        else if (cell->neighbor(f)->has_children())
+          {
+            // the coarse side of a face with hanging nodes
+            for (unsigned int sf = 0; sf < cell->face(f)->n_children(); ++sf)
+              {
+                const auto neighbor = cell->neighbor_child_on_subface(f, sf);
+                const unsigned int nf = cell->neighbor_face_no(f);
+                fe_interface.reinit(
+                  cell, f, sf, neighbor, nf, numbers::invalid_unsigned_int);
+                fe_subface_values.reinit(cell, f, sf);
+                fe_face_values_neighbor.reinit(neighbor, nf);
+                neighbor->get_dof_indices(dofs_1);
+                check_interface(fe_subface_values,
+                                &fe_face_values_neighbor,
+                                dofs_0,
+                                dofs_1);
+                ++n_faces[1];
+              }
+          }
+        else if (cell->neighbor_is_coarser(f))
+          {
+            // the fine side of a face with hanging nodes
+            const auto neighbor = cell->neighbor(f);
+            const std::pair<unsigned int, unsigned int> face_subface =
+              cell->neighbor_of_coarser_neighbor(f);
+            fe_interface.reinit(cell,
+                                f,
+                                numbers::invalid_unsigned_int,
+                                neighbor,
+                                face_subface.first,
+                                face_subface.second);
+            fe_face_values.reinit(cell, f);
+            fe_subface_values_neighbor.reinit(neighbor,
+                                              face_subface.first,
+                                              face_subface.second);
+            neighbor->get_dof_indices(dofs_1);
+            check_interface(fe_face_values,
+                            &fe_subface_values_neighbor,
+                            dofs_0,
+                            dofs_1);
+            ++n_faces[2];
+          }
+        else
+          {
+            const auto         neighbor = cell->neighbor(f);
+            const unsigned int nf       = cell->neighbor_of_neighbor(f);
+            fe_interface.reinit(cell,
+                                f,
+                                numbers::invalid_unsigned_int,
+                                neighbor,
+                                nf,
+                                numbers::invalid_unsigned_int);
+            fe_face_values.reinit(cell, f);
+            fe_face_values_neighbor.reinit(neighbor, nf);
+            neighbor->get_dof_indices(dofs_1);
+            check_interface(fe_face_values,
+                            &fe_face_values_neighbor,
+                            dofs_0,
+                            dofs_1);
+            ++n_faces[3];
+          }
+      }
+
+  deallog << "Boundary faces: " << n_faces[0]
+          << ", coarse sides of refined faces: " << n_faces[1]
+          << ", fine sides of refined faces: " << n_faces[2]
+          << ", regular interior faces: " << n_faces[3] << std::endl;
+  deallog << "Errors in dofs: " << error_dofs
+          << ", geometry: " << filter_out_small_numbers(error_geometry, 1e-12)
+          << ", values: " << filter_out_small_numbers(error_values, 1e-12)
+          << ", gradients: "
+          << filter_out_small_numbers(error_gradients, 1e-12)
+          << ", hessians: " << filter_out_small_numbers(error_hessians, 1e-10)
+          << std::endl;
+  deallog << "Largest jump of the interpolated function: "
+          << filter_out_small_numbers(solution_jump, 1e-12) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check(FE_DGQ<2>(1));
+  check(FE_Q<2>(2));
+  check(FESystem<2>(FE_Q<2>(1), 2));
+  check(FE_DGQ<3>(1));
+  check(FE_Q<3>(2));
+}
@@ -0,0 +1,195 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Create a parallel::fullydistributed::Triangulation by copy_triangulation()
+// from a parallel::shared::Triangulation and by
+// create_construction_data_on_root(), and compare the locally owned and
+// ghost cells with the ones of a parallel::shared::Triangulation with
+// artificial cells and the same partition. Also compare global quantities
+// integrated over the locally owned cells of both triangulations.
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <set>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+create_mesh(Triangulation<dim> &tria)
+{
+  GridGenerator::subdivided_hyper_cube(tria, 3);
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (cell->face(f)->at_boundary() && cell->face(f)->center()[0] < 1e-12)
+        cell->face(f)->set_boundary_id(1);
+  tria.refine_global(1);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.4)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim>
+void
+partition_zorder(Triangulation<dim> &tria,
+                 const MPI_Comm,
+                 const unsigned int n_partitions)
+{
+  GridTools::partition_triangulation_zorder(n_partitions, tria);
+}
+
+
+
+// Return whether the locally owned and the ghost cells of the two
+// triangulations are the same on all processes
+template <int dim>
+bool
+same_cells(const Triangulation<dim> &tria_1,
+           const Triangulation<dim> &tria_2,
+           const MPI_Comm            comm)
+{
+  std::set<CellId> owned_1, owned_2, ghost_1, ghost_2;
+  for (const auto &cell : tria_1.active_cell_iterators())
+    if (cell->is_locally_owned())
+      owned_1.insert(cell->id());
+    else if (cell->is_ghost())
+      ghost_1.insert(cell->id());
+  for (const auto &cell : tria_2.active_cell_iterators())
+    if (cell->is_locally_owned())
+      owned_2.insert(cell->id());
+    else if (cell->is_ghost())
+      ghost_2.insert(cell->id());
+
+  const bool same = (owned_1 == owned_2) && (ghost_1 == ghost_2);
+  return Utilities::MPI::min(same ? 1 : 0, comm) == 1;
+}
+
+
+
+// Print global quantities computed on the given triangulation
+template <int dim>
+void
+print_global_quantities(const Triangulation<dim> &tria, const MPI_Comm comm)
+{
+  const FE_Q<dim> fe(1);
+
+  // the integral of a function over the domain and the area of the
+  // boundary with id 1
+  const QGauss<dim>     quadrature(3);
+  const QGauss<dim - 1> face_quadrature(3);
+  FEValues<dim>         fe_values(fe,
+                          quadrature,
+                          update_quadrature_points | update_JxW_values);
+  FEFaceValues<dim>     fe_face_values(fe, face_quadrature, update_JxW_values);
+  const Functions::CosineFunction<dim> function;
+  double                               integral = 0., boundary_area = 0.;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        fe_values.reinit(cell);
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          integral +=
+            function.value(fe_values.quadrature_point(q)) * fe_values.JxW(q);
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->face(f)->at_boundary() &&
+              cell->face(f)->boundary_id() == 1)
+            {
+              fe_face_values.reinit(cell, f);
+              for (unsigned int q = 0; q < face_quadrature.size(); ++q)
+                boundary_area += fe_face_values.JxW(q);
+            }
+      }
+
+  deallog << "Active cells: " << tria.n_global_active_cells()
+          << ", levels: " << tria.n_global_levels() << std::endl;
+  deallog << "Integral: " << Utilities::MPI::sum(integral, comm)
+          << ", boundary area: " << Utilities::MPI::sum(boundary_area, comm)
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  deallog << "Dimension " << dim << std::endl;
+
+  using SharedTriangulation = parallel::shared::Triangulation<dim>;
+  SharedTriangulation tria_shared(comm,
+                                  Triangulation<dim>::none,
+                                  false,
+                                  SharedTriangulation::partition_zorder);
+  create_mesh(tria_shared);
+
+  // the reference with a layer of ghost cells around the owned cells
+  SharedTriangulation tria_reference(comm,
+                                     Triangulation<dim>::none,
+                                     true,
+                                     SharedTriangulation::partition_zorder);
+  create_mesh(tria_reference);
+
+  parallel::fullydistributed::Triangulation<dim> tria_copy(comm);
+  tria_copy.copy_triangulation(tria_shared);
+  deallog << "copy_triangulation(): same cells as shared triangulation: "
+          << (same_cells(tria_copy, tria_reference, comm) ? "yes" : "no")
+          << std::endl;
+
+  parallel::fullydistributed::Triangulation<dim> tria_root(comm);
+  tria_root.create_triangulation(
+    parallel::fullydistributed::create_construction_data_on_root<dim, dim>(
+      create_mesh<dim>, comm, partition_zorder<dim>));
+  deallog << "create_construction_data_on_root(): same cells as shared "
+          << "triangulation: "
+          << (same_cells(tria_root, tria_reference, comm) ? "yes" : "no")
+          << std::endl;
+
+  deallog.push("shared");
+  print_global_quantities(tria_reference, comm);
+  deallog.pop();
+  deallog.push("fullydistributed");
+  print_global_quantities(tria_copy, comm);
+  deallog.pop();
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+  mpi_initlog();
+
+  test<2>();
+  test<3>();
+}
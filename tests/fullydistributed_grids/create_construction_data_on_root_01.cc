@@ -0,0 +1,162 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Compare global quantities computed with a DoFHandler on a
+// parallel::fullydistributed::Triangulation created by
+// create_construction_data_on_root() with the ones computed on a
+// parallel::distributed::Triangulation of the same mesh.
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+create_mesh(Triangulation<dim> &tria)
+{
+  GridGenerator::subdivided_hyper_cube(tria, 3);
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (cell->face(f)->at_boundary() && cell->face(f)->center()[0] < 1e-12)
+        cell->face(f)->set_boundary_id(1);
+  tria.refine_global(1);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center().norm() < 0.4)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim>
+void
+partition_zorder(Triangulation<dim> &tria,
+                 const MPI_Comm,
+                 const unsigned int n_partitions)
+{
+  GridTools::partition_triangulation_zorder(n_partitions, tria);
+}
+
+
+
+// Print global quantities computed on the given triangulation
+template <int dim>
+void
+print_global_quantities(const Triangulation<dim> &tria, const MPI_Comm comm)
+{
+  const FE_Q<dim> fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  // the integral of a function over the domain and the area of the
+  // boundary with id 1
+  const QGauss<dim>     quadrature(3);
+  const QGauss<dim - 1> face_quadrature(3);
+  FEValues<dim>         fe_values(fe,
+                          quadrature,
+                          update_quadrature_points | update_JxW_values);
+  FEFaceValues<dim>     fe_face_values(fe, face_quadrature, update_JxW_values);
+  const Functions::CosineFunction<dim> function;
+  double                               integral = 0., boundary_area = 0.;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        fe_values.reinit(cell);
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          integral +=
+            function.value(fe_values.quadrature_point(q)) * fe_values.JxW(q);
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (cell->face(f)->at_boundary() &&
+              cell->face(f)->boundary_id() == 1)
+            {
+              fe_face_values.reinit(cell, f);
+              for (unsigned int q = 0; q < face_quadrature.size(); ++q)
+                boundary_area += fe_face_values.JxW(q);
+            }
+      }
+
+  // the norm of the interpolant of the function, which does not depend on
+  // the numbering of the degrees of freedom
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  LinearAlgebra::distributed::Vector<double> vector(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, comm);
+  VectorTools::interpolate(dof_handler, function, vector);
+
+  deallog << "Active cells: " << tria.n_global_active_cells()
+          << ", levels: " << tria.n_global_levels()
+          << ", dofs: " << dof_handler.n_dofs() << std::endl;
+  deallog << "Integral: " << Utilities::MPI::sum(integral, comm)
+          << ", boundary area: " << Utilities::MPI::sum(boundary_area, comm)
+          << ", norm of interpolant: " << vector.l2_norm() << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  deallog << "Dimension " << dim << std::endl;
+
+  parallel::distributed::Triangulation<dim> tria_distributed(comm);
+  create_mesh(tria_distributed);
+
+  parallel::fullydistributed::Triangulation<dim> tria_fully_distributed(comm);
+  tria_fully_distributed.create_triangulation(
+    parallel::fullydistributed::create_construction_data_on_root<dim, dim>(
+      create_mesh<dim>, comm, partition_zorder<dim>));
+
+  deallog.push("distributed");
+  print_global_quantities(tria_distributed, comm);
+  deallog.pop();
+  deallog.push("fullydistributed");
+  print_global_quantities(tria_fully_distributed, comm);
+  deallog.pop();
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+  mpi_initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,168 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that a mesh written by GridOut::write_ucd() with the preamble is
+// read back by GridIn::read_ucd() into the same mesh, both when the marker
+// of consistently oriented cells in the preamble is trusted and when the
+// cells are reordered as usual. Also check that the marker is ignored by
+// default for a file whose cells are not actually oriented consistently.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+std::string
+write_mesh(const Triangulation<dim> &tria, const bool write_preamble)
+{
+  GridOut grid_out;
+  grid_out.set_flags(GridOutFlags::Ucd(write_preamble, true));
+  std::ostringstream out;
+  grid_out.write_ucd(tria, out);
+  return out.str();
+}
+
+
+
+// Remove the comments of the preamble, which contain the date
+std::string
+strip_comments(const std::string &file)
+{
+  std::istringstream in(file);
+  std::string        result, line;
+  while (std::getline(in, line))
+    if (line.empty() || line[0] != '#')
+      result += line + "\n";
+  return result;
+}
+
+
+
+template <int dim>
+void
+check(const Triangulation<dim> &tria)
+{
+  const std::string file = write_mesh(tria, true);
+
+  for (const bool trust_orientation_marker : {false, true})
+    {
+      Triangulation<dim> tria_read;
+      GridIn<dim>        grid_in;
+      grid_in.attach_triangulation(tria_read);
+      std::istringstream in(file);
+      grid_in.read_ucd(in, false, trust_orientation_marker);
+
+      const bool same = strip_comments(write_mesh(tria_read, true)) ==
+                        strip_comments(file);
+      deallog << "Trust orientation marker: "
+              << (trust_orientation_marker ? "yes" : "no")
+              << ", cells: " << tria_read.n_active_cells()
+              << ", same mesh: " << (same ? "yes" : "no") << std::endl;
+    }
+}
+
+
+
+// A mesh of two quadrilaterals whose vertices are both listed in clockwise
+// order, i.e., whose cells would have a negative measure, that claims to be
+// consistently oriented. Since the marker is not trusted by default, the
+// cells are inverted as usual.
+void
+check_wrong_marker()
+{
+  std::istringstream in(
+    "# The cells of this mesh are consistently oriented.\n"
+    "6 2 0 0 0\n"
+    "1 0 0 0\n"
+    "2 1 0 0\n"
+    "3 2 0 0\n"
+    "4 0 1 0\n"
+    "5 1 1 0\n"
+    "6 2 1 0\n"
+    "1 0 quad 1 4 5 2\n"
+    "2 0 quad 2 5 6 3\n");
+
+  Triangulation<2> tria;
+  GridIn<2>        grid_in;
+  grid_in.attach_triangulation(tria);
+  grid_in.read_ucd(in);
+
+  double measure = 0.;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->measure() > 0.)
+      measure += cell->measure();
+  deallog << "Mesh with wrong marker: cells " << tria.n_active_cells()
+          << ", measure of positively oriented cells " << measure
+          << std::endl;
+  deallog << "Mesh as read:" << std::endl
+          << write_mesh(tria, false) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_shell(tria, Point<2>(), 0.5, 1., 6);
+    tria.refine_global(1);
+    deallog.push("hyper_shell 2d");
+    check(tria);
+    deallog.pop();
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(2);
+    tria.begin_active()->set_refine_flag();
+    tria.execute_coarsening_and_refinement();
+    deallog.push("hyper_ball 2d");
+    check(tria);
+    deallog.pop();
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_shell(tria, Point<3>(), 0.5, 1., 6);
+    tria.refine_global(1);
+    deallog.push("hyper_shell 3d");
+    check(tria);
+    deallog.pop();
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_rectangle(tria,
+                                              {2, 3, 1},
+                                              Point<3>(),
+                                              Point<3>(1., 2., 3.),
+                                              true);
+    deallog.push("hyper_rectangle 3d");
+    check(tria);
+    deallog.pop();
+  }
+
+  check_wrong_marker();
+}
@@ -0,0 +1,222 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check AffineConstraints::close() and AffineConstraints::distribute() for
+// chains of constraints of increasing depth, added in arbitrary order and
+// with inhomogeneities, on one thread and on several threads. The values
+// computed by distribute() are compared with a recursive evaluation of the
+// constraints as they were added.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <map>
+
+#include "../tests.h"
+
+
+struct Line
+{
+  std::vector<std::pair<types::global_dof_index, double>> entries;
+  double                                                  inhomogeneity;
+};
+
+
+
+// Evaluate the value of degree of freedom @p i recursively through the
+// constraint lines @p lines
+double
+evaluate(const std::map<types::global_dof_index, Line> &lines,
+         const Vector<double> &                         values,
+         const types::global_dof_index                  i)
+{
+  const auto line = lines.find(i);
+  if (line == lines.end())
+    return values(i);
+
+  double value = line->second.inhomogeneity;
+  for (const auto &entry : line->second.entries)
+    value += entry.second * evaluate(lines, values, entry.first);
+  return value;
+}
+
+
+
+void
+add_line(AffineConstraints<double> &                    constraints,
+         std::map<types::global_dof_index, Line> &      lines,
+         const types::global_dof_index                  index,
+         const std::vector<std::pair<types::global_dof_index, double>> &entries,
+         const double inhomogeneity = 0.)
+{
+  constraints.add_line(index);
+  constraints.add_entries(index, entries);
+  constraints.set_inhomogeneity(index, inhomogeneity);
+  lines[index] = Line{entries, inhomogeneity};
+}
+
+
+
+template <typename VectorType>
+void
+check_distribute(const AffineConstraints<double> &              constraints,
+                 const std::map<types::global_dof_index, Line> &lines,
+                 const unsigned int                             n_dofs)
+{
+  Vector<double> values(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    values(i) = random_value<double>();
+
+  VectorType vector(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    vector(i) = values(i);
+  constraints.distribute(vector);
+
+  double error = 0.;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    error = std::max(error, std::abs(vector(i) - evaluate(lines, values, i)));
+  deallog << "distribute() error: " << filter_out_small_numbers(error, 1e-12)
+          << std::endl;
+}
+
+
+
+void
+check_chains()
+{
+  AffineConstraints<double>               constraints;
+  std::map<types::global_dof_index, Line> lines;
+
+  // a chain that needs to be resolved from its end
+  add_line(constraints, lines, 3, {{4, 0.25}, {5, 0.75}}, 1.);
+  add_line(constraints, lines, 2, {{3, 0.5}, {6, 0.5}});
+  add_line(constraints, lines, 1, {{2, 1.}});
+  add_line(constraints, lines, 4, {{7, 2.}}, -0.5);
+
+  // two paths to the same degree of freedom, which need to be merged
+  add_line(constraints, lines, 10, {{11, 0.5}, {12, 0.5}});
+  add_line(constraints, lines, 11, {{13, 1.}});
+  add_line(constraints, lines, 12, {{13, 1.}, {14, 0.}});
+
+  // a degree of freedom fixed to an inhomogeneity, used by other lines
+  add_line(constraints, lines, 20, {}, 3.);
+  add_line(constraints, lines, 21, {{20, 0.5}, {22, 0.5}});
+  add_line(constraints, lines, 23, {{21, 2.}, {20, -1.}}, 0.25);
+  add_line(constraints, lines, 24, {});
+
+  constraints.close();
+  deallog << "Closed constraints:" << std::endl;
+  constraints.print(deallog.get_file_stream());
+
+  check_distribute<Vector<double>>(constraints, lines, 25);
+  check_distribute<LinearAlgebra::distributed::Vector<double>>(constraints,
+                                                               lines,
+                                                               25);
+}
+
+
+
+void
+check_many_lines()
+{
+  // blocks of chains of depth up to seven that are linked to the following
+  // block, with enough lines to be worked on by several threads
+  const unsigned int n_blocks = 2000;
+  const unsigned int n_dofs   = 10 * n_blocks;
+
+  AffineConstraints<double>               constraints;
+  std::map<types::global_dof_index, Line> lines;
+  for (unsigned int b = n_blocks; b-- > 0;)
+    {
+      const types::global_dof_index base = 10 * b;
+      if (b % 3 == 0)
+        add_line(constraints,
+                 lines,
+                 base + 9,
+                 {{base + 0, 0.5}, {(base + 16) % n_dofs, 0.5}});
+      add_line(constraints, lines, base + 4, {{(base + 15) % n_dofs, 1.}}, 0.2);
+      add_line(constraints,
+               lines,
+               base + 3,
+               {{base + 4, 0.25}, {base + 8, 0.75}});
+      if (b % 7 == 0)
+        add_line(constraints, lines, base + 8, {}, 1.5);
+      add_line(constraints,
+               lines,
+               base + 2,
+               {{base + 3, 0.5}, {base + 7, 0.5}});
+      add_line(constraints,
+               lines,
+               base + 0,
+               {{base + 1, 0.5}, {base + 5, 0.5}});
+      add_line(constraints,
+               lines,
+               base + 1,
+               {{base + 2, 0.5}, {base + 6, 0.5}},
+               0.1);
+    }
+
+  constraints.close();
+
+  std::size_t n_entries = 0;
+  double      checksum  = 0.;
+  bool        resolved  = true;
+  for (const auto &line : lines)
+    {
+      const auto &entries = *constraints.get_constraint_entries(line.first);
+      n_entries += entries.size();
+      for (unsigned int e = 0; e < entries.size(); ++e)
+        {
+          checksum += entries[e].second * (entries[e].first % 13);
+          if (constraints.is_constrained(entries[e].first) ||
+              (e > 0 && entries[e - 1].first >= entries[e].first))
+            resolved = false;
+        }
+      checksum += constraints.get_inhomogeneity(line.first);
+    }
+  deallog << "Number of constraints: " << constraints.n_constraints()
+          << std::endl;
+  deallog << "Number of entries: " << n_entries << std::endl;
+  deallog << "Checksum: " << checksum << std::endl;
+  deallog << "All lines resolved and sorted: " << (resolved ? "yes" : "no")
+          << std::endl;
+
+  check_distribute<Vector<double>>(constraints, lines, n_dofs);
+  check_distribute<LinearAlgebra::distributed::Vector<double>>(constraints,
+                                                               lines,
+                                                               n_dofs);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (const unsigned int n_threads : {1U, testing_max_num_threads()})
+    {
+      MultithreadInfo::set_thread_limit(n_threads);
+      deallog.push(n_threads == 1 ? "serial" : "parallel");
+      check_chains();
+      check_many_lines();
+      deallog.pop();
+    }
+}
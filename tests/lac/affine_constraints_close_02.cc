@@ -0,0 +1,74 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that AffineConstraints::close() detects a cycle in the constraints
+// on one thread and on several threads, also if the cycle is found while
+// other lines are resolved at the same time.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include "../tests.h"
+
+
+void
+check(const unsigned int n_lines)
+{
+  AffineConstraints<double> constraints;
+
+  // many independent chained lines and one cycle 0 -> 1 -> 2 -> 0
+  for (unsigned int i = 1; i < n_lines; ++i)
+    {
+      constraints.add_line(3 * i);
+      constraints.add_entry(3 * i, 3 * i + 1, 0.5);
+      constraints.add_entry(3 * i, 3 * i + 3, 0.5);
+    }
+  for (unsigned int i = 0; i < 3; ++i)
+    {
+      constraints.add_line(i);
+      constraints.add_entry(i, (i + 1) % 3, 1.);
+    }
+
+  try
+    {
+      constraints.close();
+      deallog << "No cycle detected" << std::endl;
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << e.get_exc_name() << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  deal_II_exceptions::disable_abort_on_exception();
+  initlog();
+
+  for (const unsigned int n_threads : {1U, testing_max_num_threads()})
+    {
+      MultithreadInfo::set_thread_limit(n_threads);
+      deallog.push(n_threads == 1 ? "serial" : "parallel");
+      check(3);
+      check(1000);
+      deallog.pop();
+    }
+}
@@ -0,0 +1,177 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Compare CompactDynamicSparsityPattern with DynamicSparsityPattern for
+// entries added in random order with many duplicates, with several calls to
+// compress() in between, for different segment sizes. Also compare the
+// SparsityPattern objects copied from both, and the patterns built by
+// DoFTools::make_sparsity_pattern() on a mesh with hanging nodes.
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/compact_dynamic_sparsity_pattern.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+
+bool
+same_entries(const CompactDynamicSparsityPattern &cdsp,
+             const DynamicSparsityPattern &       dsp)
+{
+  if (cdsp.n_rows() != dsp.n_rows() || cdsp.n_cols() != dsp.n_cols() ||
+      cdsp.n_nonzero_elements() != dsp.n_nonzero_elements() ||
+      cdsp.max_entries_per_row() != dsp.max_entries_per_row())
+    return false;
+
+  for (unsigned int row = 0; row < dsp.n_rows(); ++row)
+    {
+      if (cdsp.row_length(row) != dsp.row_length(row))
+        return false;
+      for (unsigned int index = 0; index < dsp.row_length(row); ++index)
+        if (cdsp.column_number(row, index) != dsp.column_number(row, index) ||
+            !cdsp.exists(row, dsp.column_number(row, index)))
+          return false;
+    }
+
+  std::ostringstream print_cdsp, print_dsp;
+  cdsp.print(print_cdsp);
+  dsp.print(print_dsp);
+  return print_cdsp.str() == print_dsp.str();
+}
+
+
+
+void
+check(const unsigned int rows_per_segment)
+{
+  const unsigned int m = 1000, n = 700;
+
+  CompactDynamicSparsityPattern cdsp(m, n, rows_per_segment);
+  DynamicSparsityPattern        dsp(m, n);
+
+  for (unsigned int round = 0; round < 3; ++round)
+    {
+      // single entries, with every entry added about three times, and
+      // blocks of entries for some rows
+      for (unsigned int k = 0; k < 6000; ++k)
+        {
+          const unsigned int i = Testing::rand() % m;
+          const unsigned int j = (i * 3 + Testing::rand() % 40) % n;
+          cdsp.add(i, j);
+          dsp.add(i, j);
+        }
+      for (unsigned int i = round; i < m; i += 37)
+        {
+          std::vector<types::global_dof_index> columns;
+          for (unsigned int k = 0; k < 20; ++k)
+            columns.push_back((i + 5 * k) % n);
+          std::sort(columns.begin(), columns.end());
+          cdsp.add_entries(i, columns.begin(), columns.end());
+          dsp.add_entries(i, columns.begin(), columns.end());
+        }
+
+      cdsp.compress();
+      deallog << "Round " << round << ": " << cdsp.n_nonzero_elements()
+              << " entries, same as DynamicSparsityPattern: "
+              << (same_entries(cdsp, dsp) ? "yes" : "no") << std::endl;
+    }
+
+  SparsityPattern sp_cdsp, sp_dsp;
+  sp_cdsp.copy_from(cdsp);
+  sp_dsp.copy_from(dsp);
+
+  bool same = sp_cdsp.n_nonzero_elements() == sp_dsp.n_nonzero_elements();
+  for (unsigned int row = 0; row < m && same; ++row)
+    {
+      same = sp_cdsp.row_length(row) == sp_dsp.row_length(row);
+      for (unsigned int index = 0; index < sp_dsp.row_length(row) && same;
+           ++index)
+        same = sp_cdsp.column_number(row, index) ==
+               sp_dsp.column_number(row, index);
+    }
+  deallog << "Same SparsityPattern: " << (same ? "yes" : "no") << std::endl;
+}
+
+
+
+template <int dim>
+void
+check_dof_tools()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(FE_Q<dim>(2));
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  for (const bool keep_constrained_dofs : {true, false})
+    {
+      CompactDynamicSparsityPattern cdsp(dof_handler.n_dofs(),
+                                         dof_handler.n_dofs(),
+                                         16);
+      DynamicSparsityPattern        dsp(dof_handler.n_dofs());
+      DoFTools::make_sparsity_pattern(dof_handler,
+                                      cdsp,
+                                      constraints,
+                                      keep_constrained_dofs);
+      DoFTools::make_sparsity_pattern(dof_handler,
+                                      dsp,
+                                      constraints,
+                                      keep_constrained_dofs);
+      cdsp.compress();
+      deallog << "DoFTools in " << dim << "d with"
+              << (keep_constrained_dofs ? "" : "out")
+              << " constrained entries: " << cdsp.n_nonzero_elements()
+              << " entries, same as DynamicSparsityPattern: "
+              << (same_entries(cdsp, dsp) ? "yes" : "no") << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (const unsigned int rows_per_segment : {1, 7, 256, 2000})
+    {
+      deallog.push("rows_per_segment=" + std::to_string(rows_per_segment));
+      check(rows_per_segment);
+      deallog.pop();
+    }
+
+  check_dof_tools<2>();
+  check_dof_tools<3>();
+}
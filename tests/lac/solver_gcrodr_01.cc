@@ -0,0 +1,151 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Solve a sequence of related linear systems with SolverGCRODR and compare
+// the number of iterations with SolverGMRES of the same basis size. The
+// basis is small enough that each solve needs several restarts, which update
+// the recycled space within one solve.
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gcrodr.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// Set up the five-point finite difference discretization of
+// -Laplace u + beta . grad u on an n x n grid with upwinding
+void
+make_matrix(const unsigned int      n,
+            SparsityPattern &       sparsity,
+            SparseMatrix<double> &  matrix)
+{
+  const double beta_x = 40., beta_y = 15.;
+  const double h      = 1. / (n + 1);
+
+  DynamicSparsityPattern dsp(n * n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      {
+        const unsigned int row = i * n + j;
+        dsp.add(row, row);
+        if (i > 0)
+          dsp.add(row, row - n);
+        if (i < n - 1)
+          dsp.add(row, row + n);
+        if (j > 0)
+          dsp.add(row, row - 1);
+        if (j < n - 1)
+          dsp.add(row, row + 1);
+      }
+  sparsity.copy_from(dsp);
+  matrix.reinit(sparsity);
+
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      {
+        const unsigned int row = i * n + j;
+        matrix.set(row, row, 4. + (beta_x + beta_y) * h);
+        if (i > 0)
+          matrix.set(row, row - n, -1. - beta_y * h);
+        if (i < n - 1)
+          matrix.set(row, row + n, -1.);
+        if (j > 0)
+          matrix.set(row, row - 1, -1. - beta_x * h);
+        if (j < n - 1)
+          matrix.set(row, row + 1, -1.);
+      }
+}
+
+
+
+void
+make_rhs(const unsigned int k, Vector<double> &rhs)
+{
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    rhs(i) = 1. + std::sin(0.1 * (k + 1) * i);
+}
+
+
+
+double
+residual_norm(const SparseMatrix<double> &matrix,
+              const Vector<double> &      solution,
+              const Vector<double> &      rhs)
+{
+  Vector<double> residual(rhs.size());
+  matrix.residual(residual, solution, rhs);
+  return residual.l2_norm() / rhs.l2_norm();
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  SparsityPattern      sparsity;
+  SparseMatrix<double> matrix;
+  make_matrix(20, sparsity, matrix);
+
+  SolverControl                  control_gcrodr(2000, 1e-8);
+  SolverGCRODR<Vector<double>>   solver_gcrodr(
+    control_gcrodr, SolverGCRODR<Vector<double>>::AdditionalData(20, 5));
+  SolverControl               control_gmres(2000, 1e-8);
+  SolverGMRES<Vector<double>> solver_gmres(
+    control_gmres, SolverGMRES<Vector<double>>::AdditionalData(20));
+
+  Vector<double> rhs(matrix.m()), solution(matrix.m());
+  for (unsigned int k = 0; k < 5; ++k)
+    {
+      // slightly change the matrix and the right hand side in each step
+      for (unsigned int i = 0; i < matrix.m(); ++i)
+        matrix.diag_element(i) += 0.01 * k;
+      make_rhs(k, rhs);
+      control_gcrodr.set_tolerance(1e-8 * rhs.l2_norm());
+      control_gmres.set_tolerance(1e-8 * rhs.l2_norm());
+
+      solution = 0.;
+      solver_gmres.solve(matrix, solution, rhs, PreconditionIdentity());
+      const unsigned int steps_gmres = control_gmres.last_step();
+
+      solution = 0.;
+      solver_gcrodr.solve(matrix, solution, rhs, PreconditionIdentity());
+      AssertThrow(residual_norm(matrix, solution, rhs) < 1e-7,
+                  ExcInternalError());
+
+      deallog << "System " << k << ": GMRES " << steps_gmres
+              << " steps, GCRODR " << control_gcrodr.last_step()
+              << " steps, recycled vectors "
+              << solver_gcrodr.get_recycled_space().size() << std::endl;
+    }
+
+  // without the recycled space, GCRODR starts like GMRES again
+  solver_gcrodr.clear_recycled_space();
+  solution = 0.;
+  solver_gcrodr.solve(matrix, solution, rhs, PreconditionIdentity());
+  AssertThrow(residual_norm(matrix, solution, rhs) < 1e-7, ExcInternalError());
+  deallog << "After clear_recycled_space(): GCRODR "
+          << control_gcrodr.last_step() << " steps" << std::endl;
+}
@@ -0,0 +1,186 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Compare the number of iterations of SolverGMRES and SolverFGMRES with
+// classical and modified Gram-Schmidt orthogonalization for a
+// convection-diffusion problem, for the deal.II vector classes with and
+// without a special implementation of classical Gram-Schmidt.
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// Set up the five-point finite difference discretization of
+// -Laplace u + beta . grad u on an n x n grid with upwinding
+void
+make_matrix(const unsigned int    n,
+            SparsityPattern &     sparsity,
+            SparseMatrix<double> &matrix)
+{
+  const double beta_x = 40., beta_y = 15.;
+  const double h      = 1. / (n + 1);
+
+  DynamicSparsityPattern dsp(n * n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      {
+        const unsigned int row = i * n + j;
+        dsp.add(row, row);
+        if (i > 0)
+          dsp.add(row, row - n);
+        if (i < n - 1)
+          dsp.add(row, row + n);
+        if (j > 0)
+          dsp.add(row, row - 1);
+        if (j < n - 1)
+          dsp.add(row, row + 1);
+      }
+  sparsity.copy_from(dsp);
+  matrix.reinit(sparsity);
+
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      {
+        const unsigned int row = i * n + j;
+        matrix.set(row, row, 4. + (beta_x + beta_y) * h);
+        if (i > 0)
+          matrix.set(row, row - n, -1. - beta_y * h);
+        if (i < n - 1)
+          matrix.set(row, row + n, -1.);
+        if (j > 0)
+          matrix.set(row, row - 1, -1. - beta_x * h);
+        if (j < n - 1)
+          matrix.set(row, row + 1, -1.);
+      }
+}
+
+
+
+template <typename SolverType, typename VectorType>
+unsigned int
+solve(const SparseMatrix<double> &                   matrix,
+      const typename SolverType::AdditionalData &    data,
+      const LinearAlgebra::OrthogonalizationStrategy strategy)
+{
+  VectorType rhs(matrix.m()), solution(matrix.m());
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    rhs(i) = 1. + (i % 7);
+
+  typename SolverType::AdditionalData solver_data(data);
+  solver_data.orthogonalization_strategy = strategy;
+
+  SolverControl control(1000, 1e-10 * rhs.l2_norm());
+  SolverType    solver(control, solver_data);
+
+  // a Jacobi preconditioner that works for all vector types
+  DiagonalMatrix<VectorType> preconditioner;
+  preconditioner.get_vector().reinit(matrix.m());
+  for (unsigned int i = 0; i < matrix.m(); ++i)
+    preconditioner.get_vector()(i) = 1. / matrix.diag_element(i);
+  solver.solve(matrix, solution, rhs, preconditioner);
+
+  // check the true residual
+  VectorType residual(rhs);
+  matrix.vmult(residual, solution);
+  residual -= rhs;
+  AssertThrow(residual.l2_norm() < 1e-8 * rhs.l2_norm(), ExcInternalError());
+
+  return control.last_step();
+}
+
+
+
+template <typename SolverType, typename VectorType>
+void
+compare(const std::string &                        name,
+        const SparseMatrix<double> &               matrix,
+        const typename SolverType::AdditionalData &data)
+{
+  const unsigned int steps_modified = solve<SolverType, VectorType>(
+    matrix,
+    data,
+    LinearAlgebra::OrthogonalizationStrategy::modified_gram_schmidt);
+  const unsigned int steps_classical = solve<SolverType, VectorType>(
+    matrix,
+    data,
+    LinearAlgebra::OrthogonalizationStrategy::classical_gram_schmidt);
+
+  deallog << name << ": modified Gram-Schmidt " << steps_modified
+          << " steps, classical Gram-Schmidt " << steps_classical << " steps"
+          << std::endl;
+}
+
+
+
+template <typename VectorType>
+void
+check(const SparseMatrix<double> &matrix)
+{
+  compare<SolverGMRES<VectorType>, VectorType>(
+    "GMRES(30)", matrix, typename SolverGMRES<VectorType>::AdditionalData(30));
+  compare<SolverGMRES<VectorType>, VectorType>(
+    "GMRES(10)", matrix, typename SolverGMRES<VectorType>::AdditionalData(10));
+  compare<SolverGMRES<VectorType>, VectorType>(
+    "GMRES(30), right preconditioning",
+    matrix,
+    typename SolverGMRES<VectorType>::AdditionalData(30, true));
+  compare<SolverGMRES<VectorType>, VectorType>(
+    "GMRES(300)",
+    matrix,
+    typename SolverGMRES<VectorType>::AdditionalData(300));
+  compare<SolverFGMRES<VectorType>, VectorType>(
+    "FGMRES(30)",
+    matrix,
+    typename SolverFGMRES<VectorType>::AdditionalData(30));
+  compare<SolverFGMRES<VectorType>, VectorType>(
+    "FGMRES(10)",
+    matrix,
+    typename SolverFGMRES<VectorType>::AdditionalData(10));
+  compare<SolverFGMRES<VectorType>, VectorType>(
+    "FGMRES(300)",
+    matrix,
+    typename SolverFGMRES<VectorType>::AdditionalData(300));
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(2);
+
+  SparsityPattern      sparsity;
+  SparseMatrix<double> matrix;
+  make_matrix(40, sparsity, matrix);
+
+  deallog.push("Vector");
+  check<Vector<double>>(matrix);
+  deallog.pop();
+
+  deallog.push("distributed::Vector");
+  check<LinearAlgebra::distributed::Vector<double>>(matrix);
+  deallog.pop();
+}
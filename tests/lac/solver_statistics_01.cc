@@ -0,0 +1,209 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that the statistics collected by the solvers count the same number
+// of matrix-vector products and preconditioner applications as wrappers
+// around the matrix and the preconditioner, that they are reset at the
+// beginning of each solve, and that they are not collected unless enabled.
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_bicgstab.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/solver_minres.h>
+#include <deal.II/lac/solver_richardson.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// Set up the five-point finite difference discretization of
+// -Laplace u + beta . grad u on an n x n grid with upwinding
+void
+make_matrix(const unsigned int    n,
+            const double          beta_x,
+            const double          beta_y,
+            SparsityPattern &     sparsity,
+            SparseMatrix<double> &matrix)
+{
+  const double h = 1. / (n + 1);
+
+  DynamicSparsityPattern dsp(n * n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      {
+        const unsigned int row = i * n + j;
+        dsp.add(row, row);
+        if (i > 0)
+          dsp.add(row, row - n);
+        if (i < n - 1)
+          dsp.add(row, row + n);
+        if (j > 0)
+          dsp.add(row, row - 1);
+        if (j < n - 1)
+          dsp.add(row, row + 1);
+      }
+  sparsity.copy_from(dsp);
+  matrix.reinit(sparsity);
+
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      {
+        const unsigned int row = i * n + j;
+        matrix.set(row, row, 4. + (beta_x + beta_y) * h);
+        if (i > 0)
+          matrix.set(row, row - n, -1. - beta_y * h);
+        if (i < n - 1)
+          matrix.set(row, row + n, -1.);
+        if (j > 0)
+          matrix.set(row, row - 1, -1. - beta_x * h);
+        if (j < n - 1)
+          matrix.set(row, row + 1, -1.);
+      }
+}
+
+
+
+// A matrix and a preconditioner that count their applications
+struct CountingMatrix
+{
+  CountingMatrix(const SparseMatrix<double> &matrix)
+    : matrix(matrix)
+    , n_calls(0)
+  {}
+
+  void
+  vmult(Vector<double> &dst, const Vector<double> &src) const
+  {
+    ++n_calls;
+    matrix.vmult(dst, src);
+  }
+
+  const SparseMatrix<double> &matrix;
+  mutable unsigned int        n_calls;
+};
+
+
+
+struct CountingPreconditioner
+{
+  CountingPreconditioner(const SparseMatrix<double> &matrix)
+    : n_calls(0)
+  {
+    jacobi.initialize(matrix);
+  }
+
+  void
+  vmult(Vector<double> &dst, const Vector<double> &src) const
+  {
+    ++n_calls;
+    jacobi.vmult(dst, src);
+  }
+
+  PreconditionJacobi<SparseMatrix<double>> jacobi;
+  mutable unsigned int                     n_calls;
+};
+
+
+
+template <typename SolverType>
+void
+check(const std::string &         name,
+      const SparseMatrix<double> &matrix,
+      const bool                  enable_statistics = true)
+{
+  Vector<double> rhs(matrix.m()), solution(matrix.m());
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    rhs(i) = 1. + (i % 5);
+
+  SolverControl control(1000, 1e-8 * rhs.l2_norm());
+  control.enable_statistics(enable_statistics);
+  SolverType solver(control);
+
+  // solve twice to check that the statistics of the first solve are
+  // discarded
+  for (unsigned int repetition = 0; repetition < 2; ++repetition)
+    {
+      const CountingMatrix         counting_matrix(matrix);
+      const CountingPreconditioner preconditioner(matrix);
+      solution = repetition;
+      try
+        {
+          solver.solve(counting_matrix, solution, rhs, preconditioner);
+        }
+      catch (const SolverControl::NoConvergence &)
+        {}
+
+      if (repetition == 1)
+        {
+          const SolverStatistics &statistics = control.get_statistics();
+          deallog << name << ": " << control.last_step() << " steps, "
+                  << statistics.n_calls(
+                       SolverStatistics::matrix_vector_product)
+                  << " (" << counting_matrix.n_calls
+                  << ") matrix-vector products, "
+                  << statistics.n_calls(
+                       SolverStatistics::preconditioner_application)
+                  << " (" << preconditioner.n_calls
+                  << ") preconditioner applications, "
+                  << statistics.n_calls(SolverStatistics::reduction)
+                  << " reductions, "
+                  << statistics.n_calls(SolverStatistics::vector_update)
+                  << " vector updates" << std::endl;
+
+          // all operations on the vectors are recorded with the size of
+          // the vectors
+          bool bytes_consistent = true;
+          for (const auto op :
+               {SolverStatistics::reduction, SolverStatistics::vector_update})
+            if (statistics.n_calls(op) > 0 &&
+                (statistics.bytes(op) <
+                 statistics.n_calls(op) * rhs.size() * sizeof(double)))
+              bytes_consistent = false;
+          AssertThrow(bytes_consistent, ExcInternalError());
+        }
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  SparsityPattern      sparsity_laplace, sparsity_convection;
+  SparseMatrix<double> laplace, convection;
+  make_matrix(20, 0., 0., sparsity_laplace, laplace);
+  make_matrix(20, 30., 10., sparsity_convection, convection);
+
+  check<SolverCG<Vector<double>>>("CG", laplace);
+  check<SolverMinRes<Vector<double>>>("MinRes", laplace);
+  check<SolverGMRES<Vector<double>>>("GMRES", convection);
+  check<SolverFGMRES<Vector<double>>>("FGMRES", convection);
+  check<SolverBicgstab<Vector<double>>>("Bicgstab", convection);
+
+  // statistics that are not enabled, and a solver that does not collect
+  // statistics
+  check<SolverCG<Vector<double>>>("CG without statistics", laplace, false);
+  check<SolverRichardson<Vector<double>>>("Richardson", laplace);
+}
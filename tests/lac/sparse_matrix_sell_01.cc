@@ -0,0 +1,181 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Compare the matrix-vector products of SparseMatrixSELL with the ones of
+// SparseMatrix for a rectangular matrix with empty rows and rows of very
+// different length, for several values of the sorting window sigma and for
+// matrices set up both by copy_from() and by set()/add().
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+make_sparsity(const unsigned int m,
+              const unsigned int n,
+              SparsityPattern &  sparsity)
+{
+  DynamicSparsityPattern dsp(m, n);
+  for (unsigned int i = 0; i < m; ++i)
+    {
+      // leave every eleventh row empty and make every 17th row long
+      if (i % 11 == 5)
+        continue;
+      const unsigned int length = (i % 17 == 0) ? n / 2 : 1 + (i * 7) % 9;
+      for (unsigned int k = 0; k < length; ++k)
+        dsp.add(i, (i * 13 + k * k * 3 + k) % n);
+    }
+  sparsity.copy_from(dsp);
+}
+
+
+
+template <typename MatrixType, typename VectorType>
+double
+compare(const SparseMatrix<double> &reference,
+        const MatrixType &          matrix,
+        const VectorType &          src_m,
+        const VectorType &          src_n)
+{
+  VectorType dst(src_m), dst_ref(src_m);
+  VectorType dst_t(src_n), dst_t_ref(src_n);
+  double     error = 0.;
+
+  matrix.vmult(dst, src_n);
+  reference.vmult(dst_ref, src_n);
+  dst -= dst_ref;
+  error = std::max(error, dst.linfty_norm());
+
+  dst = src_m;
+  dst_ref = src_m;
+  matrix.vmult_add(dst, src_n);
+  reference.vmult_add(dst_ref, src_n);
+  dst -= dst_ref;
+  error = std::max(error, dst.linfty_norm());
+
+  matrix.Tvmult(dst_t, src_m);
+  reference.Tvmult(dst_t_ref, src_m);
+  dst_t -= dst_t_ref;
+  error = std::max(error, dst_t.linfty_norm());
+
+  dst_t     = src_n;
+  dst_t_ref = src_n;
+  matrix.Tvmult_add(dst_t, src_m);
+  reference.Tvmult_add(dst_t_ref, src_m);
+  dst_t -= dst_t_ref;
+  error = std::max(error, dst_t.linfty_norm());
+
+  return error;
+}
+
+
+
+template <typename VectorType>
+void
+fill_random(VectorType &vector)
+{
+  for (unsigned int i = 0; i < vector.size(); ++i)
+    vector(i) = random_value<double>(-1., 1.);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int m = 301, n = 157;
+  SparsityPattern    sparsity;
+  make_sparsity(m, n, sparsity);
+
+  SparseMatrix<double> reference(sparsity);
+  for (unsigned int i = 0; i < m; ++i)
+    for (auto entry = sparsity.begin(i); entry != sparsity.end(i); ++entry)
+      reference.set(i, entry->column(), random_value<double>(-1., 1.));
+
+  Vector<double> src_m(m), src_n(n);
+  fill_random(src_m);
+  fill_random(src_n);
+  LinearAlgebra::distributed::Vector<double> src_m_dist(m), src_n_dist(n);
+  for (unsigned int i = 0; i < m; ++i)
+    src_m_dist(i) = src_m(i);
+  for (unsigned int i = 0; i < n; ++i)
+    src_n_dist(i) = src_n(i);
+
+  for (const unsigned int sigma : {1U, 8U, 128U, 1000U})
+    {
+      SparseMatrixSELL<double> matrix;
+      matrix.copy_from(reference, sigma);
+
+      deallog << "sigma = " << sigma << ": size " << matrix.m() << " x "
+              << matrix.n() << ", " << matrix.n_nonzero_elements() << " ("
+              << reference.n_nonzero_elements() << ") nonzero elements"
+              << std::endl;
+
+      double error = 0.;
+      for (unsigned int i = 0; i < m; ++i)
+        for (auto entry = reference.begin(i); entry != reference.end(i);
+             ++entry)
+          error = std::max(error,
+                           std::abs(matrix.el(i, entry->column()) -
+                                    entry->value()));
+      deallog << "el() error: " << error << std::endl;
+
+      deallog << "Vector<double> error: "
+              << filter_out_small_numbers(
+                   compare(reference, matrix, src_m, src_n), 1e-14)
+              << std::endl;
+      deallog << "distributed::Vector<double> error: "
+              << filter_out_small_numbers(
+                   compare(reference, matrix, src_m_dist, src_n_dist),
+                   1e-14)
+              << std::endl;
+
+      // a matrix with the same entries, set up by set() and add()
+      SparseMatrixSELL<double> matrix_set(sparsity, sigma);
+      for (unsigned int i = 0; i < m; ++i)
+        for (auto entry = reference.begin(i); entry != reference.end(i);
+             ++entry)
+          {
+            matrix_set.set(i, entry->column(), 0.25 * entry->value());
+            matrix_set.add(i, entry->column(), 0.75 * entry->value());
+          }
+      deallog << "set()/add() error: "
+              << filter_out_small_numbers(
+                   compare(reference, matrix_set, src_m, src_n), 1e-14)
+              << std::endl;
+    }
+
+  // a matrix of floats applied to vectors of doubles uses a scalar loop
+  SparseMatrix<float> reference_float(sparsity);
+  reference_float.copy_from(reference);
+  SparseMatrixSELL<float> matrix_float;
+  matrix_float.copy_from(reference_float);
+  Vector<double> dst(m), dst_ref(m);
+  matrix_float.vmult(dst, src_n);
+  reference_float.vmult(dst_ref, src_n);
+  dst -= dst_ref;
+  deallog << "float matrix error: "
+          << filter_out_small_numbers(dst.linfty_norm(), 1e-6) << std::endl;
+}
@@ -0,0 +1,237 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that LinearAlgebra::distributed::Vector gives the same results in
+// update_ghost_values() and compress() for all vector operations when the
+// data is exchanged through shared memory as when it goes through MPI
+// messages. Besides the communicator returned by MPI_Comm_split_type(), a
+// communicator that groups pairs of processes is tested, such that some
+// ghost entries are exchanged through shared memory and others through
+// messages.
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include "../tests.h"
+
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+
+// Check that the locally owned entries and, if the vectors have imported
+// them, the ghost entries of the two vectors are the same on all processes
+bool
+same_values(const VectorType &vector, const VectorType &reference)
+{
+  bool same = vector.has_ghost_elements() == reference.has_ghost_elements();
+  for (unsigned int i = 0; i < vector.local_size(); ++i)
+    if (vector.local_element(i) != reference.local_element(i))
+      same = false;
+  if (same && vector.has_ghost_elements())
+    for (unsigned int i = 0; i < vector.n_ghost_entries(); ++i)
+      if (vector.local_element(vector.local_size() + i) !=
+          reference.local_element(reference.local_size() + i))
+        same = false;
+  return Utilities::MPI::min(same ? 1 : 0, vector.get_mpi_communicator()) ==
+         1;
+}
+
+
+
+void
+set_owned_values(VectorType &vector)
+{
+  for (const auto index : vector.locally_owned_elements())
+    vector(index) = 2. * index + 1.;
+}
+
+
+
+// Write values into the ghost entries that differ between the processes,
+// such that the operations in compress() have an effect
+void
+set_ghost_values(VectorType &vector, const IndexSet &ghost_indices)
+{
+  const unsigned int my_rank =
+    Utilities::MPI::this_mpi_process(vector.get_mpi_communicator());
+  for (const auto index : ghost_indices)
+    vector(index) = (my_rank + 1.) * (index % 7) - 3.;
+}
+
+
+
+void
+check(const VectorType &reference_template, const MPI_Comm comm_sm)
+{
+  const IndexSet &ghost_indices =
+    reference_template.get_partitioner()->ghost_indices();
+
+  VectorType reference, vector;
+  reference.reinit(reference_template.get_partitioner());
+  vector.reinit(reference_template.get_partitioner(), comm_sm);
+  deallog << "Processes sharing memory: "
+          << Utilities::MPI::n_mpi_processes(vector.shared_mpi_communicator())
+          << std::endl;
+
+  // run all operations twice to check that the data structures can be
+  // reused
+  for (unsigned int round = 0; round < 2; ++round)
+    {
+      set_owned_values(reference);
+      set_owned_values(vector);
+      reference.update_ghost_values();
+      vector.update_ghost_values();
+      deallog << "update_ghost_values(): "
+              << (same_values(vector, reference) ? "same" : "different")
+              << std::endl;
+
+      // compress(insert) requires the ghost entries to agree with the
+      // values of the owner
+      reference.zero_out_ghosts();
+      vector.zero_out_ghosts();
+      for (const auto index : ghost_indices)
+        {
+          reference(index) = 2. * index + 1.;
+          vector(index)    = 2. * index + 1.;
+        }
+      reference.compress(VectorOperation::insert);
+      vector.compress(VectorOperation::insert);
+      deallog << "compress(insert): "
+              << (same_values(vector, reference) ? "same" : "different")
+              << std::endl;
+
+      for (const auto operation : {VectorOperation::add,
+                                   VectorOperation::min,
+                                   VectorOperation::max})
+        {
+          set_owned_values(reference);
+          set_owned_values(vector);
+          set_ghost_values(reference, ghost_indices);
+          set_ghost_values(vector, ghost_indices);
+          reference.compress(operation);
+          vector.compress(operation);
+          deallog << "compress("
+                  << (operation == VectorOperation::add ?
+                        "add" :
+                        (operation == VectorOperation::min ? "min" : "max"))
+                  << "): "
+                  << (same_values(vector, reference) ? "same" : "different")
+                  << ", norm " << vector.l2_norm() << std::endl;
+        }
+    }
+
+  // a copy keeps the shared-memory data exchange
+  set_owned_values(reference);
+  set_owned_values(vector);
+  VectorType copy(vector);
+  deallog << "Copy shares memory with: "
+          << Utilities::MPI::n_mpi_processes(copy.shared_mpi_communicator())
+          << " processes" << std::endl;
+  copy.update_ghost_values();
+  reference.update_ghost_values();
+  deallog << "update_ghost_values() on copy: "
+          << (same_values(copy, reference) ? "same" : "different")
+          << std::endl;
+
+  // as does swapping two vectors
+  VectorType other;
+  other.reinit(reference_template.get_partitioner(), comm_sm);
+  other.swap(copy);
+  other.zero_out_ghosts();
+  other.update_ghost_values();
+  deallog << "update_ghost_values() after swap: "
+          << (same_values(other, reference) ? "same" : "different")
+          << std::endl;
+}
+
+
+
+void
+test()
+{
+  const MPI_Comm     comm    = MPI_COMM_WORLD;
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+  // process p owns 5 + p entries
+  std::vector<types::global_dof_index> offsets(n_procs + 1, 0);
+  for (unsigned int p = 0; p < n_procs; ++p)
+    offsets[p + 1] = offsets[p] + 5 + p;
+
+  IndexSet locally_owned(offsets[n_procs]);
+  locally_owned.add_range(offsets[my_rank], offsets[my_rank + 1]);
+
+  // ghost the first, a middle, and the last entry of all other processes,
+  // and all entries of the next process
+  IndexSet ghost_indices(offsets[n_procs]);
+  for (unsigned int p = 0; p < n_procs; ++p)
+    if (p != my_rank)
+      {
+        ghost_indices.add_index(offsets[p]);
+        ghost_indices.add_index(offsets[p] + 2);
+        ghost_indices.add_index(offsets[p + 1] - 1);
+      }
+  if (n_procs > 1)
+    {
+      const unsigned int next = (my_rank + 1) % n_procs;
+      ghost_indices.add_range(offsets[next], offsets[next + 1]);
+    }
+
+  VectorType reference_template(locally_owned, ghost_indices, comm);
+
+  MPI_Comm comm_sm;
+  int      ierr = MPI_Comm_split_type(
+    comm, MPI_COMM_TYPE_SHARED, my_rank, MPI_INFO_NULL, &comm_sm);
+  AssertThrowMPI(ierr);
+
+  // pretend that pairs of processes run on the same node
+  MPI_Comm comm_pairs;
+  ierr = MPI_Comm_split(comm_sm, my_rank / 2, my_rank, &comm_pairs);
+  AssertThrowMPI(ierr);
+
+  deallog.push("self");
+  check(reference_template, MPI_COMM_SELF);
+  deallog.pop();
+
+  deallog.push("shared");
+  check(reference_template, comm_sm);
+  deallog.pop();
+
+  deallog.push("pairs");
+  check(reference_template, comm_pairs);
+  deallog.pop();
+
+  ierr = MPI_Comm_free(&comm_pairs);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Comm_free(&comm_sm);
+  AssertThrowMPI(ierr);
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  test();
+}
@@ -0,0 +1,173 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that MGTransferGlobalCoarsening, set up with MGTwoLevelTransfer
+// objects between a sequence of globally refined triangulations, gives the
+// same prolongation and restriction as MGTransferMatrixFree on the levels of
+// the finest triangulation.
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/multigrid/mg_constrained_dofs.h>
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+#include <deal.II/multigrid/mg_transfer_matrix_free.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// Return the mg degree of freedom on level @p level of @p dof_mg for every
+// active degree of freedom of @p dof, where the active cells of @p dof are
+// the cells on the given level of the triangulation of @p dof_mg.
+template <int dim>
+std::vector<types::global_dof_index>
+map_to_level_dofs(const DoFHandler<dim> &dof,
+                  const DoFHandler<dim> &dof_mg,
+                  const unsigned int     level)
+{
+  std::vector<types::global_dof_index> map(dof.n_dofs());
+  std::vector<types::global_dof_index> indices(dof.get_fe().dofs_per_cell);
+  std::vector<types::global_dof_index> mg_indices(dof.get_fe().dofs_per_cell);
+
+  auto cell_mg = dof_mg.begin_mg(level);
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      AssertThrow(cell->center().distance(cell_mg->center()) < 1e-12,
+                  ExcInternalError());
+      cell->get_dof_indices(indices);
+      cell_mg->get_mg_dof_indices(mg_indices);
+      for (unsigned int i = 0; i < indices.size(); ++i)
+        map[indices[i]] = mg_indices[i];
+      ++cell_mg;
+    }
+  return map;
+}
+
+
+
+template <int dim>
+void
+check(const FiniteElement<dim> &fe, const unsigned int n_levels)
+{
+  deallog << fe.get_name() << std::endl;
+
+  // the finest mesh with a level hierarchy for MGTransferMatrixFree
+  Triangulation<dim> tria_mg(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria_mg);
+  tria_mg.refine_global(n_levels - 1);
+
+  DoFHandler<dim> dof_mg(tria_mg);
+  dof_mg.distribute_dofs(fe);
+  dof_mg.distribute_mg_dofs();
+
+  MGConstrainedDoFs mg_constrained_dofs;
+  mg_constrained_dofs.initialize(dof_mg);
+  MGTransferMatrixFree<dim, double> transfer_mf(mg_constrained_dofs);
+  transfer_mf.build(dof_mg);
+
+  // one triangulation for each level for MGTransferGlobalCoarsening
+  std::vector<std::unique_ptr<Triangulation<dim>>> trias(n_levels);
+  std::vector<std::unique_ptr<DoFHandler<dim>>>    dofs(n_levels);
+  std::vector<std::vector<types::global_dof_index>> maps(n_levels);
+  for (unsigned int l = 0; l < n_levels; ++l)
+    {
+      trias[l] = std_cxx14::make_unique<Triangulation<dim>>();
+      GridGenerator::hyper_cube(*trias[l]);
+      trias[l]->refine_global(l);
+      dofs[l] = std_cxx14::make_unique<DoFHandler<dim>>(*trias[l]);
+      dofs[l]->distribute_dofs(fe);
+      maps[l] = map_to_level_dofs(*dofs[l], dof_mg, l);
+    }
+
+  MGLevelObject<MGTwoLevelTransfer<dim, double>> transfers(0, n_levels - 1);
+  for (unsigned int l = 1; l < n_levels; ++l)
+    transfers[l].reinit(*dofs[l], *dofs[l - 1]);
+  MGTransferGlobalCoarsening<dim, double> transfer_gc(transfers);
+
+  for (unsigned int l = 1; l < n_levels; ++l)
+    {
+      VectorType coarse_gc(dofs[l - 1]->n_dofs()), fine_gc(dofs[l]->n_dofs());
+      VectorType coarse_mf(dof_mg.n_dofs(l - 1)), fine_mf(dof_mg.n_dofs(l));
+
+      // prolongation of a random vector
+      for (unsigned int i = 0; i < coarse_gc.size(); ++i)
+        {
+          coarse_gc(i)               = random_value<double>();
+          coarse_mf(maps[l - 1][i]) = coarse_gc(i);
+        }
+      transfer_gc.prolongate(l, fine_gc, coarse_gc);
+      transfer_mf.prolongate(l, fine_mf, coarse_mf);
+
+      double error = 0.;
+      for (unsigned int i = 0; i < fine_gc.size(); ++i)
+        error = std::max(error, std::abs(fine_gc(i) - fine_mf(maps[l][i])));
+      deallog << "Level " << l << " prolongation: norm " << fine_gc.l2_norm()
+              << ", difference " << filter_out_small_numbers(error, 1e-12)
+              << std::endl;
+
+      // restriction of a random vector, added to a non-zero vector
+      for (unsigned int i = 0; i < fine_gc.size(); ++i)
+        {
+          fine_gc(i)            = random_value<double>();
+          fine_mf(maps[l][i]) = fine_gc(i);
+        }
+      for (unsigned int i = 0; i < coarse_gc.size(); ++i)
+        {
+          coarse_gc(i)               = 1.;
+          coarse_mf(maps[l - 1][i]) = 1.;
+        }
+      transfer_gc.restrict_and_add(l, coarse_gc, fine_gc);
+      transfer_mf.restrict_and_add(l, coarse_mf, fine_mf);
+
+      error = 0.;
+      for (unsigned int i = 0; i < coarse_gc.size(); ++i)
+        error = std::max(error,
+                         std::abs(coarse_gc(i) - coarse_mf(maps[l - 1][i])));
+      deallog << "Level " << l << " restriction: norm " << coarse_gc.l2_norm()
+              << ", difference " << filter_out_small_numbers(error, 1e-12)
+              << std::endl;
+    }
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+  initlog();
+
+  check(FE_Q<2>(1), 4);
+  check(FE_Q<2>(3), 3);
+  check(FE_DGQ<2>(2), 3);
+  check(FESystem<2>(FE_Q<2>(2), 2), 3);
+  check(FE_Q<3>(2), 3);
+  check(FE_DGQ<3>(1), 3);
+}
@@ -0,0 +1,192 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check MGTwoLevelTransfer for the transfer between two triangulations with
+// hanging nodes, where all cells of the fine triangulation are obtained by
+// refining the coarse one once (h-transfer). The prolongation of a
+// polynomial contained in the coarse space must give the interpolant of the
+// polynomial on the fine space, independent of the values stored for the
+// constrained degrees of freedom of the coarse space, and the restriction
+// must be the transpose of the prolongation.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// A polynomial of degree @p degree in each coordinate direction
+template <int dim>
+double
+polynomial(const Point<dim> &p, const unsigned int degree)
+{
+  double value = 1.;
+  for (unsigned int d = 0; d < dim; ++d)
+    value *= 0.5 + std::pow(p[d], degree) + (d + 1) * p[d];
+  return value;
+}
+
+
+
+template <int dim>
+void
+create_mesh(parallel::shared::Triangulation<dim> &tria)
+{
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim>
+void
+setup_dofs(DoFHandler<dim> &          dof,
+           const FiniteElement<dim> & fe,
+           AffineConstraints<double> &constraints,
+           VectorType &               vector)
+{
+  dof.distribute_dofs(fe);
+
+  IndexSet relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof, relevant_dofs);
+  constraints.reinit(relevant_dofs);
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+
+  vector.reinit(dof.locally_owned_dofs(), MPI_COMM_WORLD);
+}
+
+
+
+template <int dim>
+void
+check(const unsigned int degree)
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  const FE_Q<dim> fe(degree);
+  deallog << fe.get_name() << std::endl;
+
+  parallel::shared::Triangulation<dim> tria_coarse(comm), tria_fine(comm);
+  create_mesh(tria_coarse);
+  create_mesh(tria_fine);
+  tria_fine.refine_global(1);
+
+  DoFHandler<dim>           dof_coarse(tria_coarse), dof_fine(tria_fine);
+  AffineConstraints<double> constraints_coarse, constraints_fine;
+  VectorType                coarse, fine;
+  setup_dofs(dof_coarse, fe, constraints_coarse, coarse);
+  setup_dofs(dof_fine, fe, constraints_fine, fine);
+  deallog << "Number of degrees of freedom: " << dof_coarse.n_dofs() << " -> "
+          << dof_fine.n_dofs() << std::endl;
+
+  MGTwoLevelTransfer<dim, double> transfer;
+  transfer.reinit(dof_fine, dof_coarse, constraints_fine, constraints_coarse);
+
+  // interpolate the polynomial into the coarse space and overwrite the
+  // constrained entries, which must not be read by the transfer
+  std::map<types::global_dof_index, Point<dim>> points_coarse, points_fine;
+  DoFTools::map_dofs_to_support_points(MappingQ1<dim>(),
+                                       dof_coarse,
+                                       points_coarse);
+  DoFTools::map_dofs_to_support_points(MappingQ1<dim>(),
+                                       dof_fine,
+                                       points_fine);
+  for (const auto i : dof_coarse.locally_owned_dofs())
+    coarse(i) = constraints_coarse.is_constrained(i) ?
+                  1000. :
+                  polynomial(points_coarse[i], degree);
+
+  transfer.prolongate(fine, coarse);
+
+  double error = 0.;
+  for (const auto i : dof_fine.locally_owned_dofs())
+    {
+      const double reference = constraints_fine.is_constrained(i) ?
+                                 0. :
+                                 polynomial(points_fine[i], degree);
+      error = std::max(error, std::abs(fine(i) - reference));
+    }
+  error = Utilities::MPI::max(error, comm);
+  deallog << "Prolongation error: " << filter_out_small_numbers(error, 1e-12)
+          << std::endl;
+
+  // check that the restriction is the transpose of the prolongation with
+  // random vectors
+  for (const auto i : dof_coarse.locally_owned_dofs())
+    coarse(i) = random_value<double>();
+  VectorType fine_random(fine);
+  for (const auto i : dof_fine.locally_owned_dofs())
+    fine_random(i) = random_value<double>();
+
+  transfer.prolongate(fine, coarse);
+  VectorType restricted(coarse);
+  restricted = 0.;
+  transfer.restrict_and_add(restricted, fine_random);
+
+  const double product_fine   = fine * fine_random;
+  const double product_coarse = restricted * coarse;
+  deallog << "Transpose error: "
+          << filter_out_small_numbers(std::abs(product_fine - product_coarse) /
+                                        std::abs(product_fine),
+                                      1e-12)
+          << std::endl;
+
+  // the restriction must not write into the constrained degrees of freedom
+  // of the coarse space
+  double constrained_entries = 0.;
+  for (const auto i : dof_coarse.locally_owned_dofs())
+    if (constraints_coarse.is_constrained(i))
+      constrained_entries += std::abs(restricted(i));
+  deallog << "Restriction into constrained entries: "
+          << Utilities::MPI::sum(constrained_entries, comm) << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+  mpi_initlog();
+
+  check<2>(1);
+  check<2>(2);
+  check<2>(3);
+  check<3>(1);
+  check<3>(2);
+}
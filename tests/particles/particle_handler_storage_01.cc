@@ -0,0 +1,212 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that the ParticleHandler keeps the particles in the right cells and
+// their properties attached to the right particles when particles are
+// inserted, moved and sorted into other cells and processes, and removed,
+// and that the ghost particles are the ones located in the ghost cells. The
+// cells are compared with the ones found by
+// GridTools::find_active_cell_around_point().
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include "../tests.h"
+
+
+// The location of the particle with the given id, before and after moving
+template <int dim>
+Point<dim>
+particle_location(const types::particle_index id, const bool moved)
+{
+  Point<dim> p;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      p[d] = 0.05 + 0.9 * std::fmod(0.1234 * (id + 1) * (d + 3), 1.);
+      if (moved)
+        p[d] = p[d] * p[d];
+    }
+  return p;
+}
+
+
+
+template <int dim>
+bool
+check_particles(const parallel::distributed::Triangulation<dim> &tria,
+                const MappingQ1<dim> &                           mapping,
+                Particles::ParticleHandler<dim> &particle_handler,
+                const bool                       moved)
+{
+  bool correct = true;
+  for (auto particle = particle_handler.begin();
+       particle != particle_handler.end();
+       ++particle)
+    {
+      const auto cell = particle->get_surrounding_cell(tria);
+      const auto found =
+        GridTools::find_active_cell_around_point(mapping,
+                                                 tria,
+                                                 particle->get_location());
+      const Point<dim> expected =
+        particle_location<dim>(particle->get_id(), moved);
+      if (found.first != cell || !cell->is_locally_owned() ||
+          particle->get_location().distance(expected) > 1e-12 ||
+          particle->get_reference_location().distance(found.second) > 1e-10 ||
+          particle->get_properties()[0] != particle->get_id())
+        correct = false;
+    }
+
+  // the particles of each cell are visited in one go
+  unsigned int n_particles = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const auto particles = particle_handler.particles_in_cell(cell);
+        if (static_cast<unsigned int>(
+              std::distance(particles.begin(), particles.end())) !=
+            particle_handler.n_particles_in_cell(cell))
+          correct = false;
+        for (auto particle = particles.begin(); particle != particles.end();
+             ++particle, ++n_particles)
+          if (particle->get_surrounding_cell(tria) != cell)
+            correct = false;
+      }
+  if (n_particles != particle_handler.n_locally_owned_particles())
+    correct = false;
+
+  return Utilities::MPI::min(correct ? 1 : 0, tria.get_communicator()) == 1;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  parallel::distributed::Triangulation<dim> tria(comm);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned() && cell->center()[0] < 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const MappingQ1<dim>            mapping;
+  Particles::ParticleHandler<dim> particle_handler(tria, mapping, 1);
+
+  // insert the particles on the process that owns their cell
+  const unsigned int n_particles = 200;
+  for (types::particle_index id = 0; id < n_particles; ++id)
+    {
+      const Point<dim> location = particle_location<dim>(id, false);
+      const auto       cell =
+        GridTools::find_active_cell_around_point(mapping, tria, location);
+      if (cell.first->is_locally_owned())
+        {
+          Particles::Particle<dim> particle(location, cell.second, id);
+          const auto               inserted =
+            particle_handler.insert_particle(particle, cell.first);
+          inserted->get_properties()[0] = id;
+        }
+    }
+  particle_handler.update_cached_numbers();
+
+  deallog << "Dimension " << dim << std::endl;
+  deallog << "Inserted particles: " << particle_handler.n_global_particles()
+          << std::endl;
+  deallog << "Particles in the correct cells: "
+          << (check_particles(tria, mapping, particle_handler, false) ? "yes" :
+                                                                        "no")
+          << std::endl;
+
+  // move the particles, which moves many of them into other cells and to
+  // other processes
+  for (auto &particle : particle_handler)
+    particle.set_location(particle_location<dim>(particle.get_id(), true));
+  particle_handler.sort_particles_into_subdomains_and_cells();
+  deallog << "Particles after moving: "
+          << particle_handler.n_global_particles() << std::endl;
+  deallog << "Particles in the correct cells: "
+          << (check_particles(tria, mapping, particle_handler, true) ? "yes" :
+                                                                       "no")
+          << std::endl;
+
+  // the ghost particles are the ones in the ghost cells
+  particle_handler.exchange_ghost_particles();
+  unsigned int n_expected_ghosts = 0, n_ghosts = 0;
+  bool         ghosts_correct = true;
+  for (types::particle_index id = 0; id < n_particles; ++id)
+    if (GridTools::find_active_cell_around_point(
+          mapping, tria, particle_location<dim>(id, true))
+          .first->is_ghost())
+      ++n_expected_ghosts;
+  for (auto particle = particle_handler.begin_ghost();
+       particle != particle_handler.end_ghost();
+       ++particle, ++n_ghosts)
+    if (!particle->get_surrounding_cell(tria)->is_ghost() ||
+        particle->get_properties()[0] != particle->get_id())
+      ghosts_correct = false;
+  ghosts_correct = ghosts_correct && (n_ghosts == n_expected_ghosts);
+  deallog << "Ghost particles correct: "
+          << (Utilities::MPI::min(ghosts_correct ? 1 : 0, comm) == 1 ? "yes" :
+                                                                       "no")
+          << std::endl;
+
+  // remove every third particle at once
+  std::vector<Particles::ParticleIterator<dim>> to_remove;
+  for (auto particle = particle_handler.begin();
+       particle != particle_handler.end();
+       ++particle)
+    if (particle->get_id() % 3 == 0)
+      to_remove.push_back(particle);
+  particle_handler.remove_particles(to_remove);
+  particle_handler.update_cached_numbers();
+
+  bool none_left = true;
+  for (const auto &particle : particle_handler)
+    if (particle.get_id() % 3 == 0)
+      none_left = false;
+  deallog << "Particles after removal: "
+          << particle_handler.n_global_particles() << ", removed ones gone: "
+          << (Utilities::MPI::min(none_left ? 1 : 0, comm) == 1 ? "yes" : "no")
+          << std::endl;
+  deallog << "Particles in the correct cells: "
+          << (check_particles(tria, mapping, particle_handler, true) ? "yes" :
+                                                                       "no")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+  mpi_initlog();
+
+  test<2>();
+  test<3>();
+}
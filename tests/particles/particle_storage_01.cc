@@ -0,0 +1,220 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check the structure-of-arrays storage of the particles used by the
+// ParticleHandler against a std::multimap from the cells to the particles,
+// which the ParticleHandler used before: insertion, insertion of copies and
+// of serialized particles, removal of single particles and of many
+// particles at once, and the renumbering of the particles by cells.
+
+#include <deal.II/particles/particle.h>
+#include <deal.II/particles/particle_storage.h>
+#include <deal.II/particles/property_pool.h>
+
+#include <array>
+#include <map>
+
+#include "../tests.h"
+
+
+
+using Storage = Particles::internal::ParticleStorage<2>;
+
+struct ReferenceParticle
+{
+  Point<2>              location;
+  Point<2>              reference_location;
+  types::particle_index id;
+  std::array<double, 2> properties;
+};
+
+
+
+using Reference =
+  std::multimap<Particles::internal::LevelInd, ReferenceParticle>;
+
+
+
+// Compare the particles in the storage with the reference, visiting the
+// particles in the order of the cells
+bool
+same_particles(Storage &storage, const Reference &reference)
+{
+  if (storage.n_particles() != reference.size())
+    return false;
+
+  auto reference_particle = reference.begin();
+  for (auto cell = storage.begin_cells(); cell != storage.end_cells(); ++cell)
+    {
+      if (storage.n_particles_in_cell(cell->first) !=
+          reference.count(cell->first))
+        return false;
+
+      for (unsigned int i = 0; i < cell->second.size(); ++i)
+        {
+          const Storage::Handle handle = storage.get_handle(cell, i);
+          if (reference_particle->first != cell->first ||
+              storage.get_id(handle) != reference_particle->second.id ||
+              storage.get_location(handle) !=
+                reference_particle->second.location ||
+              storage.get_reference_location(handle) !=
+                reference_particle->second.reference_location ||
+              storage.get_properties(handle)[0] !=
+                reference_particle->second.properties[0] ||
+              storage.get_properties(handle)[1] !=
+                reference_particle->second.properties[1])
+            return false;
+          ++reference_particle;
+        }
+    }
+  return reference_particle == reference.end();
+}
+
+
+
+// Check that the particles of each cell occupy a contiguous range of the
+// data arrays, in the order of the cells
+bool
+is_contiguous(Storage &storage)
+{
+  Storage::Handle next_handle = 0;
+  for (auto cell = storage.begin_cells(); cell != storage.end_cells(); ++cell)
+    for (const Storage::Handle handle : cell->second)
+      if (handle != next_handle++)
+        return false;
+  return true;
+}
+
+
+
+void
+report(const std::string &operation,
+       Storage &          storage,
+       const Reference &  reference)
+{
+  deallog << operation << ": " << storage.n_particles() << " particles, "
+          << "max " << storage.max_n_particles_per_cell()
+          << " per cell, same as multimap: "
+          << (same_particles(storage, reference) ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  Storage   storage(2);
+  Reference reference;
+
+  // insert particles into random cells
+  for (types::particle_index id = 0; id < 300; ++id)
+    {
+      const Particles::internal::LevelInd cell(2, Testing::rand() % 16);
+      ReferenceParticle particle{random_point<2>(),
+                                 random_point<2>(),
+                                 id,
+                                 {{random_value<double>(), 1. * id}}};
+
+      const auto            entry = storage.get_cell(cell);
+      const unsigned int    index = storage.insert(entry,
+                                                particle.location,
+                                                particle.reference_location,
+                                                particle.id);
+      const Storage::Handle handle = storage.get_handle(entry, index);
+      storage.get_properties(handle)[0] = particle.properties[0];
+      storage.get_properties(handle)[1] = particle.properties[1];
+      reference.emplace(cell, particle);
+    }
+  report("Insertion", storage, reference);
+
+  // remove single particles
+  for (unsigned int k = 0; k < 30; ++k)
+    {
+      const Particles::internal::LevelInd cell(2, Testing::rand() % 16);
+      const unsigned int        n_in_cell = storage.n_particles_in_cell(cell);
+      if (n_in_cell == 0)
+        continue;
+      const unsigned int index = Testing::rand() % n_in_cell;
+      storage.erase(storage.lower_bound(cell), index);
+      reference.erase(std::next(reference.lower_bound(cell), index));
+    }
+  report("Single removal", storage, reference);
+
+  // move particles to other cells by copying them, then remove the
+  // originals at once
+  std::vector<std::pair<Storage::cell_map_iterator, unsigned int>> positions;
+  std::vector<Reference::iterator> reference_positions;
+  auto reference_particle = reference.begin();
+  for (auto cell = storage.begin_cells(); cell != storage.end_cells(); ++cell)
+    for (unsigned int i = 0; i < cell->second.size();
+         ++i, ++reference_particle)
+      if (reference_particle->second.id % 4 == 1)
+        {
+          positions.emplace_back(cell, i);
+          reference_positions.push_back(reference_particle);
+        }
+  for (unsigned int p = 0; p < positions.size(); ++p)
+    {
+      const Particles::internal::LevelInd new_cell(3, positions[p].second % 5);
+      storage.insert_copy(storage.get_cell(new_cell),
+                          storage.get_handle(positions[p].first,
+                                             positions[p].second));
+      reference.emplace(new_cell, reference_positions[p]->second);
+    }
+  storage.remove(positions);
+  for (const auto &position : reference_positions)
+    reference.erase(position);
+  report("Moving particles", storage, reference);
+
+  // insert serialized particles
+  Particles::PropertyPool                 pool(2);
+  std::vector<char>                       buffer;
+  std::vector<Particles::Particle<2>>     particles;
+  for (types::particle_index id = 1000; id < 1010; ++id)
+    {
+      particles.emplace_back(random_point<2>(), random_point<2>(), id);
+      particles.back().set_property_pool(pool);
+      const std::array<double, 2> properties{{-1. * id, 0.5}};
+      particles.back().set_properties(
+        ArrayView<const double>(properties.data(), 2));
+    }
+  buffer.resize(particles.size() * particles[0].serialized_size_in_bytes());
+  void *write_pointer = buffer.data();
+  for (const auto &particle : particles)
+    particle.write_data(write_pointer);
+  const void *read_pointer = buffer.data();
+  for (const auto &particle : particles)
+    {
+      const Particles::internal::LevelInd cell(2, particle.get_id() % 3);
+      storage.insert(storage.get_cell(cell), read_pointer);
+      reference.emplace(cell,
+                        ReferenceParticle{particle.get_location(),
+                                          particle.get_reference_location(),
+                                          particle.get_id(),
+                                          {{-1. * particle.get_id(), 0.5}}});
+    }
+  report("Serialized insertion", storage, reference);
+
+  deallog << "Contiguous before reordering: "
+          << (is_contiguous(storage) ? "yes" : "no") << std::endl;
+  storage.reorder_by_cell();
+  report("Reordering", storage, reference);
+  deallog << "Contiguous after reordering: "
+          << (is_contiguous(storage) ? "yes" : "no") << std::endl;
+}
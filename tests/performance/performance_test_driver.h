@@ -0,0 +1,247 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_tests_performance_test_driver_h
+#define dealii_tests_performance_test_driver_h
+
+// Common infrastructure of the micro-benchmarks in this directory: timing
+// of repeated runs of a kernel, comparison of the measured throughput with
+// the roofline of the machine, and output of the results in machine-readable
+// form. Each benchmark writes one line per measurement to the standard
+// output, which is a JSON object with the parameters of the benchmark and
+// the measured metrics. The lines can be collected by other tools to track
+// the performance over time.
+//
+// The peak numbers of the machine are read from the environment variables
+// DEAL_II_PEAK_BANDWIDTH (memory bandwidth in GB/s) and DEAL_II_PEAK_GFLOPS
+// (arithmetic throughput of all processes in GFLOP/s). If they are not set,
+// no comparison with the roofline is done.
+//
+// Benchmarks of complete applications instead record the time spent in each
+// phase of the program with a TimerOutput object, and print the minimum,
+// average, and maximum time over the MPI processes through
+// print_phase_timings().
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace Benchmark
+{
+  using namespace dealii;
+
+  /**
+   * A parameter of a benchmark, given by its name and its value formatted as
+   * a JSON value.
+   */
+  using Parameter = std::pair<std::string, std::string>;
+
+
+
+  /**
+   * Create a parameter of a benchmark with a numeric value.
+   */
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, Parameter>::type
+  parameter(const std::string &name, const T value)
+  {
+    std::ostringstream stream;
+    stream << value;
+    return Parameter(name, stream.str());
+  }
+
+
+
+  /**
+   * Create a parameter of a benchmark with a string value.
+   */
+  inline Parameter
+  parameter(const std::string &name, const std::string &value)
+  {
+    return Parameter(name, "\"" + value + "\"");
+  }
+
+
+
+  /**
+   * Return the name of the given number type.
+   */
+  template <typename Number>
+  std::string
+  number_name()
+  {
+    return std::is_same<Number, float>::value ? "float" : "double";
+  }
+
+
+
+  /**
+   * Return the peak number of the machine stored in the given environment
+   * variable, or zero if the variable is not set.
+   */
+  inline double
+  get_peak_value(const char *variable)
+  {
+    const char *value = std::getenv(variable);
+    return value != nullptr ? std::atof(value) : 0.;
+  }
+
+
+
+  /**
+   * Run the given function @p n_repetitions times after one warm-up run and
+   * return the minimum and the average wall time of a run in seconds. With
+   * MPI, the time of a run is the maximum over all processes.
+   */
+  template <typename Function>
+  std::pair<double, double>
+  time_function(const Function &function, const unsigned int n_repetitions)
+  {
+    function();
+
+    double min_time = std::numeric_limits<double>::max();
+    double sum_time = 0;
+    for (unsigned int i = 0; i < n_repetitions; ++i)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const double time =
+          Utilities::MPI::max(std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - start)
+                                .count(),
+                              MPI_COMM_WORLD);
+        min_time = std::min(min_time, time);
+        sum_time += time;
+      }
+    return std::make_pair(min_time, sum_time / n_repetitions);
+  }
+
+
+
+  /**
+   * Write the result of a measurement as a JSON object on a single line of
+   * the standard output. The throughput is computed from the minimal time
+   * @p times.first of one run that did work on @p n_dofs unknowns and
+   * is estimated to have transferred @p bytes from and to main memory and
+   * performed @p flops arithmetic operations, all summed over the MPI
+   * processes. For benchmarks where the operation count is not meaningful,
+   * @p flops can be set to zero.
+   *
+   * If the peak numbers of the machine are set, the output contains the
+   * fraction of the throughput predicted by the roofline model. It is based
+   * on the minimum of the arithmetic peak and the product of the arithmetic
+   * intensity and the memory bandwidth if the operation count is known, and
+   * on the memory bandwidth only otherwise.
+   */
+  inline void
+  print_result(const std::string &              benchmark,
+               const std::vector<Parameter> &   parameters,
+               const std::pair<double, double> &times,
+               const double                     n_dofs,
+               const double                     bytes,
+               const double                     flops)
+  {
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) != 0)
+      return;
+
+    const double time           = times.first;
+    const double gbytes_per_sec = 1e-9 * bytes / time;
+    const double gflops_per_sec = 1e-9 * flops / time;
+
+    std::ostringstream line;
+    line << std::setprecision(6) << "{\"benchmark\": \"" << benchmark << "\"";
+    for (const auto &p : parameters)
+      line << ", \"" << p.first << "\": " << p.second;
+    line << ", \"n_processes\": "
+         << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)
+         << ", \"n_dofs\": " << n_dofs << ", \"time_min\": " << time
+         << ", \"time_avg\": " << times.second
+         << ", \"dofs_per_second\": " << n_dofs / time
+         << ", \"gbytes_per_second\": " << gbytes_per_sec;
+    if (flops > 0)
+      line << ", \"gflops_per_second\": " << gflops_per_sec;
+
+    const double peak_bandwidth = get_peak_value("DEAL_II_PEAK_BANDWIDTH");
+    const double peak_gflops    = get_peak_value("DEAL_II_PEAK_GFLOPS");
+    if (flops > 0 && peak_bandwidth > 0 && peak_gflops > 0 && bytes > 0)
+      line << ", \"roofline_fraction\": "
+           << gflops_per_sec /
+                std::min(peak_gflops, flops / bytes * peak_bandwidth);
+    else if (flops > 0 && peak_gflops > 0 && bytes == 0)
+      line << ", \"roofline_fraction\": " << gflops_per_sec / peak_gflops;
+    else if (flops == 0 && peak_bandwidth > 0)
+      line << ", \"roofline_fraction\": " << gbytes_per_sec / peak_bandwidth;
+    line << "}";
+
+    std::cout << line.str() << std::endl;
+  }
+
+
+
+  /**
+   * Write the wall times of the sections of @p timer as a JSON object on a
+   * single line of the standard output, together with the given parameters.
+   * For each section, the minimum, the average, and the maximum time over
+   * the processes in MPI_COMM_WORLD are reported, which allows to identify
+   * load imbalance in addition to the scaling behavior of each phase.
+   *
+   * This function must be called on all processes.
+   */
+  inline void
+  print_phase_timings(const std::string &           benchmark,
+                      const std::vector<Parameter> &parameters,
+                      const TimerOutput &           timer)
+  {
+    const std::map<std::string, double> section_times =
+      timer.get_summary_data(TimerOutput::total_wall_time);
+
+    std::ostringstream line;
+    line << std::setprecision(6) << "{\"benchmark\": \"" << benchmark << "\"";
+    for (const auto &p : parameters)
+      line << ", \"" << p.first << "\": " << p.second;
+    line << ", \"n_processes\": "
+         << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)
+         << ", \"phases\": {";
+    for (const auto &section : section_times)
+      {
+        const Utilities::MPI::MinMaxAvg time =
+          Utilities::MPI::min_max_avg(section.second, MPI_COMM_WORLD);
+        line << (section.first == section_times.begin()->first ? "" : ", ")
+             << "\"" << section.first << "\": {\"min\": " << time.min
+             << ", \"avg\": " << time.avg << ", \"max\": " << time.max
+             << "}";
+      }
+    line << "}}";
+
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+      std::cout << line.str() << std::endl;
+  }
+} // namespace Benchmark
+
+#endif
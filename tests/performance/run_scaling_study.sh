@@ -0,0 +1,53 @@
+#!/bin/sh
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2019 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# This script runs a strong or weak scaling study of the program
+# timing_poisson_pipeline for all combinations of continuous and
+# discontinuous elements on uniform and adaptive meshes. It must be called
+# in the build directory of the benchmarks after "make
+# timing_poisson_pipeline", e.g. as
+#
+#   ../tests/performance/run_scaling_study.sh strong "1 2 4 8 16" size=4e6
+#
+# The first argument selects strong or weak scaling, the second argument
+# the list of numbers of MPI processes, and all further arguments are passed
+# on to the program (see there for the available parameters). For weak
+# scaling, the size given is the one for a single process. The results are
+# appended to the file scaling_results.json in JSON format, one line per run.
+# The MPI launcher can be set with the environment variable MPIEXEC.
+#
+
+if test $# -lt 2 ; then
+  echo "Usage: $0 strong|weak \"<list of process counts>\" [key=value ...]"
+  exit 1
+fi
+
+scaling="$1"
+processes="$2"
+shift 2
+
+MPIEXEC="${MPIEXEC:-mpirun}"
+
+for n in ${processes} ; do
+  for element in cg dg ; do
+    for mesh in uniform adaptive ; do
+      ${MPIEXEC} -np "${n}" ./timing_poisson_pipeline \
+        scaling="${scaling}" element="${element}" mesh="${mesh}" "$@" \
+        >> scaling_results.json || exit 1
+    done
+  done
+done
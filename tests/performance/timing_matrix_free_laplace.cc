@@ -0,0 +1,185 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Benchmark of the matrix-vector product of the Laplace operator with
+// FEEvaluation and MatrixFree::cell_loop() for FE_Q elements of degrees one
+// to six on Cartesian and on randomly distorted meshes, computed in double
+// and single precision. The memory transfer is estimated from the access to
+// the source and destination vectors (with write-allocate for the latter)
+// and the size of the index and geometry data of MatrixFree. The optional
+// command line argument sets the minimal number of unknowns.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <functional>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+local_apply(const MatrixFree<dim, Number> &                   data,
+            LinearAlgebra::distributed::Vector<Number> &      dst,
+            const LinearAlgebra::distributed::Vector<Number> &src,
+            const std::pair<unsigned int, unsigned int> &     cell_range)
+{
+  FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data);
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values(src);
+      phi.evaluate(false, true);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        phi.submit_gradient(phi.get_gradient(q), q);
+      phi.integrate(false, true);
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+run(const types::global_dof_index min_size, const bool distort)
+{
+#ifdef DEAL_II_WITH_P4EST
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+#else
+  Triangulation<dim> tria;
+#endif
+  GridGenerator::hyper_cube(tria);
+  unsigned int n_refinements = 0;
+  while (Utilities::fixed_power<dim>(
+           static_cast<types::global_dof_index>(fe_degree << n_refinements) +
+           1) < min_size)
+    ++n_refinements;
+  tria.refine_global(n_refinements);
+  if (distort)
+    GridTools::distort_random(0.2, tria);
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, Number>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, Number>::AdditionalData::none;
+  additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+
+  MatrixFree<dim, Number> matrix_free;
+  matrix_free.reinit(MappingQGeneric<dim>(1),
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     additional_data);
+
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+  VectorType src, dst;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  for (unsigned int i = 0; i < src.local_size(); ++i)
+    src.local_element(i) = 0.125 * (i % 7);
+
+  const std::function<void(const MatrixFree<dim, Number> &,
+                           VectorType &,
+                           const VectorType &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    cell_operation = local_apply<dim, fe_degree, Number>;
+
+  const auto times = Benchmark::time_function(
+    [&]() { matrix_free.cell_loop(cell_operation, dst, src, true); }, 20);
+
+  const double n_dofs = dof_handler.n_dofs();
+  const double bytes =
+    3. * n_dofs * sizeof(Number) +
+    Utilities::MPI::sum(
+      static_cast<double>(matrix_free.get_dof_info().memory_consumption() +
+                          matrix_free.get_mapping_info().memory_consumption()),
+      MPI_COMM_WORLD);
+
+  Benchmark::print_result(
+    "matrix_free_laplace",
+    {Benchmark::parameter("dim", dim),
+     Benchmark::parameter("degree", fe_degree),
+     Benchmark::parameter("number", Benchmark::number_name<Number>()),
+     Benchmark::parameter("vectorization_width",
+                          VectorizedArray<Number>::n_array_elements),
+     Benchmark::parameter("mesh",
+                          std::string(distort ? "distorted" : "cartesian"))},
+    times,
+    n_dofs,
+    bytes,
+    0.);
+}
+
+
+
+template <int dim, typename Number>
+void
+run_all_degrees(const types::global_dof_index min_size)
+{
+  for (const bool distort : {false, true})
+    {
+      run<dim, 1, Number>(min_size, distort);
+      run<dim, 2, Number>(min_size, distort);
+      run<dim, 3, Number>(min_size, distort);
+      run<dim, 4, Number>(min_size, distort);
+      run<dim, 5, Number>(min_size, distort);
+      run<dim, 6, Number>(min_size, distort);
+    }
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+
+  const types::global_dof_index min_size =
+    argc > 1 ? Utilities::string_to_int(argv[1]) : 2000000;
+
+  run_all_degrees<2, double>(min_size);
+  run_all_degrees<3, double>(min_size);
+  run_all_degrees<2, float>(min_size);
+  run_all_degrees<3, float>(min_size);
+
+  return 0;
+}
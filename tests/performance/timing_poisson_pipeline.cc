@@ -0,0 +1,1026 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Benchmark of the complete pipeline of a distributed matrix-free Poisson
+// solver as used in step-37 and step-59, intended for strong and weak
+// scaling studies: generation of the mesh, distribution of the degrees of
+// freedom, setup of MatrixFree, setup of the geometric multigrid
+// preconditioner, solution with the conjugate gradient method, and output
+// of the solution in the VTU format. The wall time of each phase is recorded
+// with TimerOutput and printed as one line in JSON format with the minimum,
+// average, and maximum over the MPI processes.
+//
+// The run is configured with command line arguments of the form key=value:
+//
+//   dim=2|3                  spatial dimension (default 3)
+//   degree=1..4              polynomial degree of the element (default 2)
+//   element=cg|dg            FE_Q with hanging node and Dirichlet
+//                            constraints, or FE_DGQ with the symmetric
+//                            interior penalty method (default cg)
+//   mesh=uniform|adaptive    globally refined cube, or a cube refined twice
+//                            more near the origin (default uniform)
+//   size=<n>                 minimal number of degrees of freedom of the
+//                            globally refined part of the mesh (default 1e6)
+//   scaling=strong|weak      for weak scaling, the size is multiplied by the
+//                            number of MPI processes (default strong)
+//   output=true|false        whether to write the solution (default true)
+//
+// Multigrid with local smoothing is not available for discontinuous elements
+// on adaptively refined meshes because the level operators would need to
+// include the fluxes over the refinement edges. In that case, the conjugate
+// gradient method is preconditioned by a Chebyshev iteration around the
+// point-Jacobi method on the active cells instead.
+//
+// The script run_scaling_study.sh in this directory runs this program for a
+// sequence of numbers of MPI processes.
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/multigrid/mg_coarse.h>
+#include <deal.II/multigrid/mg_constrained_dofs.h>
+#include <deal.II/multigrid/mg_matrix.h>
+#include <deal.II/multigrid/mg_smoother.h>
+#include <deal.II/multigrid/mg_tools.h>
+#include <deal.II/multigrid/mg_transfer_matrix_free.h>
+#include <deal.II/multigrid/multigrid.h>
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <memory>
+#include <type_traits>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+
+
+struct Settings
+{
+  Settings(int argc, char **argv);
+
+  unsigned int            dim;
+  unsigned int            degree;
+  bool                    is_dg;
+  bool                    adaptive;
+  bool                    weak_scaling;
+  types::global_dof_index size;
+  bool                    output;
+};
+
+
+
+Settings::Settings(int argc, char **argv)
+  : dim(3)
+  , degree(2)
+  , is_dg(false)
+  , adaptive(false)
+  , weak_scaling(false)
+  , size(1000000)
+  , output(true)
+{
+  for (int i = 1; i < argc; ++i)
+    {
+      const std::string argument(argv[i]);
+      const std::size_t position = argument.find('=');
+      AssertThrow(position != std::string::npos,
+                  ExcMessage("Arguments must be given in the form "
+                             "key=value, but got <" +
+                             argument + ">."));
+      const std::string key   = argument.substr(0, position);
+      const std::string value = argument.substr(position + 1);
+
+      if (key == "dim")
+        dim = Utilities::string_to_int(value);
+      else if (key == "degree")
+        degree = Utilities::string_to_int(value);
+      else if (key == "element")
+        {
+          AssertThrow(value == "cg" || value == "dg",
+                      ExcMessage("The element must be cg or dg."));
+          is_dg = (value == "dg");
+        }
+      else if (key == "mesh")
+        {
+          AssertThrow(value == "uniform" || value == "adaptive",
+                      ExcMessage("The mesh must be uniform or adaptive."));
+          adaptive = (value == "adaptive");
+        }
+      else if (key == "scaling")
+        {
+          AssertThrow(value == "strong" || value == "weak",
+                      ExcMessage("The scaling must be strong or weak."));
+          weak_scaling = (value == "weak");
+        }
+      else if (key == "size")
+        size = Utilities::string_to_double(value);
+      else if (key == "output")
+        output = (value == "true" || value == "1");
+      else
+        AssertThrow(false, ExcMessage("Unknown parameter <" + key + ">."));
+    }
+
+  if (weak_scaling)
+    size *= Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+}
+
+
+
+// The operator of the symmetric interior penalty discretization of the
+// Laplacian with homogeneous Dirichlet conditions on the whole boundary, as
+// in step-59 but derived from MatrixFreeOperators::Base such that the same
+// Chebyshev smoothers as for the continuous case can be used. The penalty
+// parameter assumes Cartesian cells.
+template <int dim, int fe_degree, typename Number>
+class LaplaceOperatorDG
+  : public MatrixFreeOperators::Base<dim,
+                                     LinearAlgebra::distributed::Vector<Number>>
+{
+public:
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  virtual void
+  compute_diagonal() override;
+
+private:
+  virtual void
+  apply_add(VectorType &dst, const VectorType &src) const override;
+
+  template <typename EvaluatorType>
+  void
+  do_cell_operation(EvaluatorType &phi) const;
+
+  template <typename EvaluatorType>
+  void
+  do_face_operation(EvaluatorType &phi_inner,
+                    EvaluatorType &phi_outer,
+                    const bool     compute_inner,
+                    const bool     compute_outer) const;
+
+  template <typename EvaluatorType>
+  void
+  do_boundary_operation(EvaluatorType &phi) const;
+
+  void
+  local_apply_cell(const MatrixFree<dim, Number> &              data,
+                   VectorType &                                 dst,
+                   const VectorType &                           src,
+                   const std::pair<unsigned int, unsigned int> &range) const;
+
+  void
+  local_apply_face(const MatrixFree<dim, Number> &              data,
+                   VectorType &                                 dst,
+                   const VectorType &                           src,
+                   const std::pair<unsigned int, unsigned int> &range) const;
+
+  void
+  local_apply_boundary(
+    const MatrixFree<dim, Number> &              data,
+    VectorType &                                 dst,
+    const VectorType &                           src,
+    const std::pair<unsigned int, unsigned int> &range) const;
+
+  void
+  local_diagonal_cell(const MatrixFree<dim, Number> &data,
+                      VectorType &                   dst,
+                      const unsigned int &,
+                      const std::pair<unsigned int, unsigned int> &range) const;
+
+  void
+  local_diagonal_face(const MatrixFree<dim, Number> &data,
+                      VectorType &                   dst,
+                      const unsigned int &,
+                      const std::pair<unsigned int, unsigned int> &range) const;
+
+  void
+  local_diagonal_boundary(
+    const MatrixFree<dim, Number> &data,
+    VectorType &                   dst,
+    const unsigned int &,
+    const std::pair<unsigned int, unsigned int> &range) const;
+
+  static constexpr Number penalty_factor = 1.0 * fe_degree * (fe_degree + 1);
+};
+
+
+
+template <int dim, int fe_degree, typename Number>
+constexpr Number LaplaceOperatorDG<dim, fe_degree, Number>::penalty_factor;
+
+
+
+template <int dim, int fe_degree, typename Number>
+template <typename EvaluatorType>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::do_cell_operation(
+  EvaluatorType &phi) const
+{
+  phi.evaluate(false, true);
+  for (unsigned int q = 0; q < phi.n_q_points; ++q)
+    phi.submit_gradient(phi.get_gradient(q), q);
+  phi.integrate(false, true);
+}
+
+
+
+// Compute the interior penalty flux on an interior face. For the diagonal,
+// the contributions of one side are computed with the unknowns of the other
+// side set to zero, which is controlled by the two flags.
+template <int dim, int fe_degree, typename Number>
+template <typename EvaluatorType>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::do_face_operation(
+  EvaluatorType &phi_inner,
+  EvaluatorType &phi_outer,
+  const bool     compute_inner,
+  const bool     compute_outer) const
+{
+  const VectorizedArray<Number> sigma =
+    0.5 * penalty_factor *
+    (std::abs((phi_inner.get_normal_vector(0) *
+               phi_inner.inverse_jacobian(0))[dim - 1]) +
+     std::abs((phi_outer.get_normal_vector(0) *
+               phi_outer.inverse_jacobian(0))[dim - 1]));
+
+  if (compute_inner)
+    phi_inner.evaluate(true, true);
+  if (compute_outer)
+    phi_outer.evaluate(true, true);
+
+  for (unsigned int q = 0; q < phi_inner.n_q_points; ++q)
+    {
+      VectorizedArray<Number> solution_jump             = Number();
+      VectorizedArray<Number> average_normal_derivative = Number();
+      if (compute_inner)
+        {
+          solution_jump += phi_inner.get_value(q);
+          average_normal_derivative += phi_inner.get_normal_derivative(q);
+        }
+      if (compute_outer)
+        {
+          solution_jump -= phi_outer.get_value(q);
+          average_normal_derivative += phi_outer.get_normal_derivative(q);
+        }
+      average_normal_derivative *= Number(0.5);
+      const VectorizedArray<Number> test_by_value =
+        solution_jump * sigma - average_normal_derivative;
+
+      if (compute_inner)
+        {
+          phi_inner.submit_value(test_by_value, q);
+          phi_inner.submit_normal_derivative(-solution_jump * Number(0.5), q);
+        }
+      if (compute_outer)
+        {
+          phi_outer.submit_value(-test_by_value, q);
+          phi_outer.submit_normal_derivative(-solution_jump * Number(0.5), q);
+        }
+    }
+
+  if (compute_inner)
+    phi_inner.integrate(true, true);
+  if (compute_outer)
+    phi_outer.integrate(true, true);
+}
+
+
+
+// On the boundary, the exterior value is the negative of the interior value
+// in order to impose homogeneous Dirichlet conditions weakly.
+template <int dim, int fe_degree, typename Number>
+template <typename EvaluatorType>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::do_boundary_operation(
+  EvaluatorType &phi) const
+{
+  const VectorizedArray<Number> sigma =
+    penalty_factor *
+    std::abs((phi.get_normal_vector(0) * phi.inverse_jacobian(0))[dim - 1]);
+
+  phi.evaluate(true, true);
+  for (unsigned int q = 0; q < phi.n_q_points; ++q)
+    {
+      const VectorizedArray<Number> solution_jump = 2. * phi.get_value(q);
+      const VectorizedArray<Number> test_by_value =
+        solution_jump * sigma - phi.get_normal_derivative(q);
+      phi.submit_value(test_by_value, q);
+      phi.submit_normal_derivative(-solution_jump * Number(0.5), q);
+    }
+  phi.integrate(true, true);
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::apply_add(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  this->data->loop(&LaplaceOperatorDG::local_apply_cell,
+                   &LaplaceOperatorDG::local_apply_face,
+                   &LaplaceOperatorDG::local_apply_boundary,
+                   this,
+                   dst,
+                   src,
+                   false,
+                   MatrixFree<dim, Number>::DataAccessOnFaces::gradients,
+                   MatrixFree<dim, Number>::DataAccessOnFaces::gradients);
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::local_apply_cell(
+  const MatrixFree<dim, Number> &              data,
+  VectorType &                                 dst,
+  const VectorType &                           src,
+  const std::pair<unsigned int, unsigned int> &range) const
+{
+  FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data);
+  for (unsigned int cell = range.first; cell < range.second; ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values(src);
+      do_cell_operation(phi);
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::local_apply_face(
+  const MatrixFree<dim, Number> &              data,
+  VectorType &                                 dst,
+  const VectorType &                           src,
+  const std::pair<unsigned int, unsigned int> &range) const
+{
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_inner(data,
+                                                                       true);
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_outer(data,
+                                                                       false);
+  for (unsigned int face = range.first; face < range.second; ++face)
+    {
+      phi_inner.reinit(face);
+      phi_inner.read_dof_values(src);
+      phi_outer.reinit(face);
+      phi_outer.read_dof_values(src);
+      do_face_operation(phi_inner, phi_outer, true, true);
+      phi_inner.distribute_local_to_global(dst);
+      phi_outer.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::local_apply_boundary(
+  const MatrixFree<dim, Number> &              data,
+  VectorType &                                 dst,
+  const VectorType &                           src,
+  const std::pair<unsigned int, unsigned int> &range) const
+{
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data, true);
+  for (unsigned int face = range.first; face < range.second; ++face)
+    {
+      phi.reinit(face);
+      phi.read_dof_values(src);
+      do_boundary_operation(phi);
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::local_diagonal_cell(
+  const MatrixFree<dim, Number> &data,
+  VectorType &                   dst,
+  const unsigned int &,
+  const std::pair<unsigned int, unsigned int> &range) const
+{
+  FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data);
+  AlignedVector<VectorizedArray<Number>> local_diagonal(phi.dofs_per_cell);
+  for (unsigned int cell = range.first; cell < range.second; ++cell)
+    {
+      phi.reinit(cell);
+      for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+        {
+          for (unsigned int j = 0; j < phi.dofs_per_cell; ++j)
+            phi.begin_dof_values()[j] = VectorizedArray<Number>();
+          phi.begin_dof_values()[i] = 1.;
+          do_cell_operation(phi);
+          local_diagonal[i] = phi.begin_dof_values()[i];
+        }
+      for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+        phi.begin_dof_values()[i] = local_diagonal[i];
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::local_diagonal_face(
+  const MatrixFree<dim, Number> &data,
+  VectorType &                   dst,
+  const unsigned int &,
+  const std::pair<unsigned int, unsigned int> &range) const
+{
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_inner(data,
+                                                                       true);
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi_outer(data,
+                                                                       false);
+  AlignedVector<VectorizedArray<Number>> local_diagonal(
+    phi_inner.dofs_per_cell);
+  for (unsigned int face = range.first; face < range.second; ++face)
+    {
+      phi_inner.reinit(face);
+      phi_outer.reinit(face);
+      for (const bool inner : {true, false})
+        {
+          auto &phi = inner ? phi_inner : phi_outer;
+          for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+            {
+              for (unsigned int j = 0; j < phi.dofs_per_cell; ++j)
+                phi.begin_dof_values()[j] = VectorizedArray<Number>();
+              phi.begin_dof_values()[i] = 1.;
+              do_face_operation(phi_inner, phi_outer, inner, !inner);
+              local_diagonal[i] = phi.begin_dof_values()[i];
+            }
+          for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+            phi.begin_dof_values()[i] = local_diagonal[i];
+          phi.distribute_local_to_global(dst);
+        }
+    }
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::local_diagonal_boundary(
+  const MatrixFree<dim, Number> &data,
+  VectorType &                   dst,
+  const unsigned int &,
+  const std::pair<unsigned int, unsigned int> &range) const
+{
+  FEFaceEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(data, true);
+  AlignedVector<VectorizedArray<Number>> local_diagonal(phi.dofs_per_cell);
+  for (unsigned int face = range.first; face < range.second; ++face)
+    {
+      phi.reinit(face);
+      for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+        {
+          for (unsigned int j = 0; j < phi.dofs_per_cell; ++j)
+            phi.begin_dof_values()[j] = VectorizedArray<Number>();
+          phi.begin_dof_values()[i] = 1.;
+          do_boundary_operation(phi);
+          local_diagonal[i] = phi.begin_dof_values()[i];
+        }
+      for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+        phi.begin_dof_values()[i] = local_diagonal[i];
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+LaplaceOperatorDG<dim, fe_degree, Number>::compute_diagonal()
+{
+  this->inverse_diagonal_entries.reset(new DiagonalMatrix<VectorType>());
+  this->diagonal_entries.reset(new DiagonalMatrix<VectorType>());
+  VectorType &inverse_diagonal_vector =
+    this->inverse_diagonal_entries->get_vector();
+  VectorType &diagonal_vector = this->diagonal_entries->get_vector();
+  this->initialize_dof_vector(inverse_diagonal_vector);
+  this->initialize_dof_vector(diagonal_vector);
+
+  const unsigned int dummy = 0;
+  this->data->loop(&LaplaceOperatorDG::local_diagonal_cell,
+                   &LaplaceOperatorDG::local_diagonal_face,
+                   &LaplaceOperatorDG::local_diagonal_boundary,
+                   this,
+                   diagonal_vector,
+                   dummy);
+
+  inverse_diagonal_vector = diagonal_vector;
+  for (unsigned int i = 0; i < inverse_diagonal_vector.local_size(); ++i)
+    inverse_diagonal_vector.local_element(i) =
+      1. / inverse_diagonal_vector.local_element(i);
+
+  inverse_diagonal_vector.update_ghost_values();
+  diagonal_vector.update_ghost_values();
+}
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+class PoissonPipeline
+{
+public:
+  PoissonPipeline(const Settings &settings);
+
+  void
+  run();
+
+private:
+  using VectorType      = LinearAlgebra::distributed::Vector<double>;
+  using LevelVectorType = LinearAlgebra::distributed::Vector<float>;
+
+  template <typename Number>
+  using OperatorType = typename std::conditional<
+    is_dg,
+    LaplaceOperatorDG<dim, fe_degree, Number>,
+    MatrixFreeOperators::LaplaceOperator<
+      dim,
+      fe_degree,
+      fe_degree + 1,
+      1,
+      LinearAlgebra::distributed::Vector<Number>>>::type;
+
+  using SystemMatrixType = OperatorType<double>;
+  using LevelMatrixType  = OperatorType<float>;
+
+  void
+  make_grid();
+
+  void
+  setup_dofs();
+
+  void
+  setup_matrix_free();
+
+  void
+  assemble_rhs();
+
+  void
+  setup_multigrid_and_solve();
+
+  void
+  output_results();
+
+  template <typename Number>
+  typename MatrixFree<dim, Number>::AdditionalData
+  get_additional_data(const unsigned int level) const;
+
+  bool
+  use_multigrid() const;
+
+  const Settings &settings;
+
+  TimerOutput timer;
+
+#ifdef DEAL_II_WITH_P4EST
+  parallel::distributed::Triangulation<dim> triangulation;
+#else
+  Triangulation<dim> triangulation;
+#endif
+
+  std::unique_ptr<FiniteElement<dim>> fe;
+  DoFHandler<dim>                     dof_handler;
+  AffineConstraints<double>           constraints;
+
+  SystemMatrixType system_matrix;
+  VectorType       solution;
+  VectorType       system_rhs;
+
+  MGConstrainedDoFs               mg_constrained_dofs;
+  MGLevelObject<LevelMatrixType>  mg_matrices;
+  MGTransferMatrixFree<dim, float> mg_transfer;
+
+  unsigned int n_iterations;
+};
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+PoissonPipeline<dim, fe_degree, is_dg>::PoissonPipeline(
+  const Settings &settings)
+  : settings(settings)
+  , timer(MPI_COMM_WORLD,
+          std::cout,
+          TimerOutput::never,
+          TimerOutput::wall_times)
+#ifdef DEAL_II_WITH_P4EST
+  , triangulation(
+      MPI_COMM_WORLD,
+      Triangulation<dim>::limit_level_difference_at_vertices,
+      parallel::distributed::Triangulation<dim>::construct_multigrid_hierarchy)
+#else
+  , triangulation(Triangulation<dim>::limit_level_difference_at_vertices)
+#endif
+  , fe(is_dg ? static_cast<FiniteElement<dim> *>(new FE_DGQ<dim>(fe_degree)) :
+               static_cast<FiniteElement<dim> *>(new FE_Q<dim>(fe_degree)))
+  , dof_handler(triangulation)
+  , n_iterations(0)
+{}
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+bool
+PoissonPipeline<dim, fe_degree, is_dg>::use_multigrid() const
+{
+  return !(is_dg && settings.adaptive);
+}
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+template <typename Number>
+typename MatrixFree<dim, Number>::AdditionalData
+PoissonPipeline<dim, fe_degree, is_dg>::get_additional_data(
+  const unsigned int level) const
+{
+  typename MatrixFree<dim, Number>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, Number>::AdditionalData::none;
+  additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+  if (is_dg)
+    {
+      additional_data.mapping_update_flags_inner_faces =
+        update_gradients | update_JxW_values | update_normal_vectors;
+      additional_data.mapping_update_flags_boundary_faces =
+        update_gradients | update_JxW_values | update_normal_vectors;
+    }
+  additional_data.level_mg_handler = level;
+  return additional_data;
+}
+
+
+
+// Refine the unit cube globally such that the mesh has at least the
+// requested number of unknowns. For the adaptive case, the cells close to
+// the origin are refined twice more.
+template <int dim, int fe_degree, bool is_dg>
+void
+PoissonPipeline<dim, fe_degree, is_dg>::make_grid()
+{
+  TimerOutput::Scope scope(timer, "mesh_generation");
+
+  const types::global_dof_index dofs_per_cell =
+    Utilities::pow(is_dg ? fe_degree + 1 : fe_degree, dim);
+  unsigned int n_refinements = 0;
+  while ((static_cast<types::global_dof_index>(1) << (dim * n_refinements)) *
+           dofs_per_cell <
+         settings.size)
+    ++n_refinements;
+
+  GridGenerator::hyper_cube(triangulation);
+  triangulation.refine_global(n_refinements);
+
+  if (settings.adaptive)
+    for (unsigned int cycle = 0; cycle < 2; ++cycle)
+      {
+        for (const auto &cell : triangulation.active_cell_iterators())
+          if (cell->is_locally_owned() && cell->center().norm() < 0.45)
+            cell->set_refine_flag();
+        triangulation.execute_coarsening_and_refinement();
+      }
+}
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+void
+PoissonPipeline<dim, fe_degree, is_dg>::setup_dofs()
+{
+  TimerOutput::Scope scope(timer, "distribute_dofs");
+
+  dof_handler.distribute_dofs(*fe);
+  if (use_multigrid())
+    dof_handler.distribute_mg_dofs();
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  constraints.clear();
+  constraints.reinit(locally_relevant_dofs);
+  if (!is_dg)
+    {
+      DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+      VectorTools::interpolate_boundary_values(dof_handler,
+                                               0,
+                                               Functions::ZeroFunction<dim>(),
+                                               constraints);
+    }
+  constraints.close();
+}
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+void
+PoissonPipeline<dim, fe_degree, is_dg>::setup_matrix_free()
+{
+  TimerOutput::Scope scope(timer, "matrix_free_reinit");
+
+  const auto matrix_free = std::make_shared<MatrixFree<dim, double>>();
+  matrix_free->reinit(
+    dof_handler,
+    constraints,
+    QGauss<1>(fe_degree + 1),
+    get_additional_data<double>(numbers::invalid_unsigned_int));
+  system_matrix.initialize(matrix_free);
+  system_matrix.initialize_dof_vector(solution);
+  system_matrix.initialize_dof_vector(system_rhs);
+}
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+void
+PoissonPipeline<dim, fe_degree, is_dg>::assemble_rhs()
+{
+  TimerOutput::Scope scope(timer, "assemble_rhs");
+
+  FEEvaluation<dim, fe_degree> phi(*system_matrix.get_matrix_free());
+  for (unsigned int cell = 0;
+       cell < system_matrix.get_matrix_free()->n_macro_cells();
+       ++cell)
+    {
+      phi.reinit(cell);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        phi.submit_value(make_vectorized_array<double>(1.0), q);
+      phi.integrate(true, false);
+      phi.distribute_local_to_global(system_rhs);
+    }
+  system_rhs.compress(VectorOperation::add);
+}
+
+
+
+// Set up the level operators, the transfer, and the Chebyshev smoothers of
+// the multigrid preconditioner as in step-37, followed by the solution with
+// the conjugate gradient method. The multigrid objects only live within this
+// function, so the two timer sections are entered and left explicitly.
+template <int dim, int fe_degree, bool is_dg>
+void
+PoissonPipeline<dim, fe_degree, is_dg>::setup_multigrid_and_solve()
+{
+  using SmootherType  = PreconditionChebyshev<LevelMatrixType, LevelVectorType>;
+  SolverControl solver_control(1000, 1e-10 * system_rhs.l2_norm());
+  SolverCG<VectorType> cg(solver_control);
+
+  if (!use_multigrid())
+    {
+      timer.enter_subsection("multigrid_setup");
+      system_matrix.compute_diagonal();
+      typename PreconditionChebyshev<SystemMatrixType, VectorType>::
+        AdditionalData chebyshev_data;
+      chebyshev_data.smoothing_range     = 20.;
+      chebyshev_data.degree              = 5;
+      chebyshev_data.eig_cg_n_iterations = 20;
+      chebyshev_data.preconditioner =
+        system_matrix.get_matrix_diagonal_inverse();
+      PreconditionChebyshev<SystemMatrixType, VectorType> preconditioner;
+      preconditioner.initialize(system_matrix, chebyshev_data);
+      timer.leave_subsection();
+
+      TimerOutput::Scope scope(timer, "solve");
+      cg.solve(system_matrix, solution, system_rhs, preconditioner);
+      n_iterations = solver_control.last_step();
+      return;
+    }
+
+  timer.enter_subsection("multigrid_setup");
+
+  const unsigned int n_levels = triangulation.n_global_levels();
+  mg_constrained_dofs.initialize(dof_handler);
+  if (!is_dg)
+    mg_constrained_dofs.make_zero_boundary_constraints(dof_handler, {0});
+
+  mg_matrices.resize(0, n_levels - 1);
+  for (unsigned int level = 0; level < n_levels; ++level)
+    {
+      IndexSet relevant_dofs;
+      DoFTools::extract_locally_relevant_level_dofs(dof_handler,
+                                                    level,
+                                                    relevant_dofs);
+      AffineConstraints<double> level_constraints;
+      level_constraints.reinit(relevant_dofs);
+      if (!is_dg)
+        level_constraints.add_lines(
+          mg_constrained_dofs.get_boundary_indices(level));
+      level_constraints.close();
+
+      const auto matrix_free = std::make_shared<MatrixFree<dim, float>>();
+      matrix_free->reinit(dof_handler,
+                          level_constraints,
+                          QGauss<1>(fe_degree + 1),
+                          get_additional_data<float>(level));
+      mg_matrices[level].initialize(matrix_free, mg_constrained_dofs, level);
+    }
+
+  if (!is_dg)
+    mg_transfer.initialize_constraints(mg_constrained_dofs);
+  mg_transfer.build(dof_handler);
+
+  MGLevelObject<typename SmootherType::AdditionalData> smoother_data;
+  smoother_data.resize(0, n_levels - 1);
+  for (unsigned int level = 0; level < n_levels; ++level)
+    {
+      if (level > 0)
+        {
+          smoother_data[level].smoothing_range     = 15.;
+          smoother_data[level].degree              = 5;
+          smoother_data[level].eig_cg_n_iterations = 10;
+        }
+      else
+        {
+          smoother_data[0].smoothing_range     = 1e-3;
+          smoother_data[0].degree              = numbers::invalid_unsigned_int;
+          smoother_data[0].eig_cg_n_iterations = mg_matrices[0].m();
+        }
+      mg_matrices[level].compute_diagonal();
+      smoother_data[level].preconditioner =
+        mg_matrices[level].get_matrix_diagonal_inverse();
+    }
+  mg::SmootherRelaxation<SmootherType, LevelVectorType> mg_smoother;
+  mg_smoother.initialize(mg_matrices, smoother_data);
+
+  MGCoarseGridApplySmoother<LevelVectorType> mg_coarse;
+  mg_coarse.initialize(mg_smoother);
+
+  mg::Matrix<LevelVectorType> mg_matrix(mg_matrices);
+
+  MGLevelObject<MatrixFreeOperators::MGInterfaceOperator<LevelMatrixType>>
+    mg_interface_matrices;
+  mg_interface_matrices.resize(0, n_levels - 1);
+  for (unsigned int level = 0; level < n_levels; ++level)
+    mg_interface_matrices[level].initialize(mg_matrices[level]);
+  mg::Matrix<LevelVectorType> mg_interface(mg_interface_matrices);
+
+  Multigrid<LevelVectorType> mg(
+    mg_matrix, mg_coarse, mg_transfer, mg_smoother, mg_smoother);
+  if (settings.adaptive)
+    mg.set_edge_matrices(mg_interface, mg_interface);
+
+  PreconditionMG<dim, LevelVectorType, MGTransferMatrixFree<dim, float>>
+    preconditioner(dof_handler, mg, mg_transfer);
+
+  timer.leave_subsection();
+
+  TimerOutput::Scope scope(timer, "solve");
+  cg.solve(system_matrix, solution, system_rhs, preconditioner);
+  constraints.distribute(solution);
+  n_iterations = solver_control.last_step();
+}
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+void
+PoissonPipeline<dim, fe_degree, is_dg>::output_results()
+{
+  TimerOutput::Scope scope(timer, "output");
+
+  solution.update_ghost_values();
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  data_out.build_patches();
+
+  DataOutBase::VtkFlags flags;
+  flags.compression_level = DataOutBase::VtkFlags::best_speed;
+  data_out.set_flags(flags);
+  data_out.write_vtu_in_parallel("poisson_pipeline.vtu", MPI_COMM_WORLD);
+}
+
+
+
+template <int dim, int fe_degree, bool is_dg>
+void
+PoissonPipeline<dim, fe_degree, is_dg>::run()
+{
+  make_grid();
+  setup_dofs();
+  setup_matrix_free();
+  assemble_rhs();
+  setup_multigrid_and_solve();
+  if (settings.output)
+    output_results();
+
+  Benchmark::print_phase_timings(
+    "poisson_pipeline",
+    {Benchmark::parameter("dim", dim),
+     Benchmark::parameter("degree", fe_degree),
+     Benchmark::parameter("element", std::string(is_dg ? "dg" : "cg")),
+     Benchmark::parameter("mesh",
+                          std::string(settings.adaptive ? "adaptive" :
+                                                          "uniform")),
+     Benchmark::parameter("scaling",
+                          std::string(settings.weak_scaling ? "weak" :
+                                                              "strong")),
+     Benchmark::parameter("preconditioner",
+                          std::string(use_multigrid() ? "gmg" : "chebyshev")),
+     Benchmark::parameter("n_cells", triangulation.n_global_active_cells()),
+     Benchmark::parameter("n_levels", triangulation.n_global_levels()),
+     Benchmark::parameter("n_dofs", dof_handler.n_dofs()),
+     Benchmark::parameter("n_iterations", n_iterations)},
+    timer);
+}
+
+
+
+template <int dim, int fe_degree>
+void
+run_element(const Settings &settings)
+{
+  if (settings.is_dg)
+    PoissonPipeline<dim, fe_degree, true>(settings).run();
+  else
+    PoissonPipeline<dim, fe_degree, false>(settings).run();
+}
+
+
+
+template <int dim>
+void
+run_degree(const Settings &settings)
+{
+  switch (settings.degree)
+    {
+      case 1:
+        run_element<dim, 1>(settings);
+        break;
+      case 2:
+        run_element<dim, 2>(settings);
+        break;
+      case 3:
+        run_element<dim, 3>(settings);
+        break;
+      case 4:
+        run_element<dim, 4>(settings);
+        break;
+      default:
+        AssertThrow(false,
+                    ExcMessage("Only degrees between 1 and 4 are supported."));
+    }
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+
+  const Settings settings(argc, argv);
+
+  if (settings.dim == 2)
+    run_degree<2>(settings);
+  else if (settings.dim == 3)
+    run_degree<3>(settings);
+  else
+    AssertThrow(false, ExcMessage("Only dimensions 2 and 3 are supported."));
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Benchmark of the sum factorization kernels of tensor_product_kernels.h:
+// interpolate the values of a batch of cells with n_points^dim entries in
+// all dim directions with the general and the even-odd variants of the
+// kernels, for a range of polynomial degrees, number types and widths of
+// vectorization. The operation count is the one of the general kernel, so
+// the even-odd variant reports an effective arithmetic throughput. The
+// optional command line argument sets the number of unknowns per batch.
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <type_traits>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+
+
+template <typename Evaluator, typename Number>
+void
+apply_all_directions(const Evaluator &eval,
+                     const Number *   in,
+                     Number *         tmp,
+                     Number *         out,
+                     std::integral_constant<int, 1>)
+{
+  (void)tmp;
+  eval.template values<0, true, false>(in, out);
+}
+
+
+
+template <typename Evaluator, typename Number>
+void
+apply_all_directions(const Evaluator &eval,
+                     const Number *   in,
+                     Number *         tmp,
+                     Number *         out,
+                     std::integral_constant<int, 2>)
+{
+  eval.template values<0, true, false>(in, tmp);
+  eval.template values<1, true, false>(tmp, out);
+}
+
+
+
+template <typename Evaluator, typename Number>
+void
+apply_all_directions(const Evaluator &eval,
+                     const Number *   in,
+                     Number *         tmp,
+                     Number *         out,
+                     std::integral_constant<int, 3>)
+{
+  eval.template values<0, true, false>(in, out);
+  eval.template values<1, true, false>(out, tmp);
+  eval.template values<2, true, false>(tmp, out);
+}
+
+
+
+template <internal::EvaluatorVariant variant,
+          int                        dim,
+          int                        n_points,
+          typename VectorizedArrayType>
+void
+run_kernel(const std::string &variant_name, const unsigned int target_size)
+{
+  using Number = typename VectorizedArrayType::value_type;
+
+  constexpr unsigned int n_lanes    = VectorizedArrayType::n_array_elements;
+  constexpr unsigned int n_per_cell = Utilities::pow(n_points, dim);
+
+  const unsigned int n_cells =
+    std::max(1U, target_size / (n_per_cell * n_lanes));
+  const unsigned int n_shape_entries =
+    variant == internal::evaluate_evenodd ? n_points * ((n_points + 1) / 2) :
+                                            n_points * n_points;
+
+  AlignedVector<VectorizedArrayType> shape_values(n_shape_entries);
+  for (unsigned int i = 0; i < n_shape_entries; ++i)
+    shape_values[i] = 0.1 + 0.01 * i;
+
+  AlignedVector<VectorizedArrayType> input(n_cells * n_per_cell);
+  AlignedVector<VectorizedArrayType> output(n_cells * n_per_cell);
+  AlignedVector<VectorizedArrayType> tmp(n_per_cell);
+  for (unsigned int i = 0; i < input.size(); ++i)
+    input[i] = 0.125 * (i % 7);
+
+  using Evaluator = internal::EvaluatorTensorProduct<variant,
+                                                     dim,
+                                                     n_points,
+                                                     n_points,
+                                                     VectorizedArrayType>;
+  const Evaluator eval(shape_values,
+                       AlignedVector<VectorizedArrayType>(),
+                       AlignedVector<VectorizedArrayType>());
+
+  const auto times = Benchmark::time_function(
+    [&]() {
+      for (unsigned int cell = 0; cell < n_cells; ++cell)
+        apply_all_directions(eval,
+                             input.begin() + cell * n_per_cell,
+                             tmp.begin(),
+                             output.begin() + cell * n_per_cell,
+                             std::integral_constant<int, dim>());
+    },
+    20);
+
+  const double n_dofs = static_cast<double>(n_cells) * n_per_cell * n_lanes;
+  Benchmark::print_result(
+    "tensor_product_kernels",
+    {Benchmark::parameter("variant", variant_name),
+     Benchmark::parameter("dim", dim),
+     Benchmark::parameter("degree", n_points - 1),
+     Benchmark::parameter("number", Benchmark::number_name<Number>()),
+     Benchmark::parameter("vectorization_width", n_lanes)},
+    times,
+    n_dofs * Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD),
+    2. * n_dofs * sizeof(Number) *
+      Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD),
+    2. * dim * n_points * n_dofs *
+      Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD));
+}
+
+
+
+template <int dim, int n_points, typename Number>
+void
+run_degree(const unsigned int target_size)
+{
+  run_kernel<internal::evaluate_general,
+             dim,
+             n_points,
+             VectorizedArray<Number, 1>>("general", target_size);
+  run_kernel<internal::evaluate_evenodd,
+             dim,
+             n_points,
+             VectorizedArray<Number, 1>>("evenodd", target_size);
+  if (VectorizedArray<Number>::n_array_elements > 1)
+    {
+      run_kernel<internal::evaluate_general,
+                 dim,
+                 n_points,
+                 VectorizedArray<Number>>("general", target_size);
+      run_kernel<internal::evaluate_evenodd,
+                 dim,
+                 n_points,
+                 VectorizedArray<Number>>("evenodd", target_size);
+    }
+}
+
+
+
+// run the benchmark for 1D polynomial degrees between 1 and 8
+template <int dim, typename Number>
+void
+run_all_degrees(const unsigned int, std::integral_constant<int, 10>)
+{}
+
+
+
+template <int dim, typename Number, int n_points>
+void
+run_all_degrees(const unsigned int target_size,
+                std::integral_constant<int, n_points>)
+{
+  run_degree<dim, n_points, Number>(target_size);
+  run_all_degrees<dim, Number>(target_size,
+                               std::integral_constant<int, n_points + 1>());
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+
+  const unsigned int target_size =
+    argc > 1 ? Utilities::string_to_int(argv[1]) : (1U << 22);
+
+  run_all_degrees<2, double>(target_size, std::integral_constant<int, 2>());
+  run_all_degrees<3, double>(target_size, std::integral_constant<int, 2>());
+  run_all_degrees<2, float>(target_size, std::integral_constant<int, 2>());
+  run_all_degrees<3, float>(target_size, std::integral_constant<int, 2>());
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Benchmark of the vector operations of LinearAlgebra::distributed::Vector
+// that dominate iterative solvers with matrix-free operators, and of the
+// exchange of ghost values through Utilities::MPI::Partitioner. Each process
+// owns a contiguous range of the vector and has the first entries of the
+// range of the next process as ghosts, which mimics the exchange over the
+// surface of a subdomain. The optional command line arguments set the local
+// size of the vectors and the number of ghost entries.
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/partitioner.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <memory>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+
+
+template <typename Number>
+void
+run(const types::global_dof_index local_size,
+    const types::global_dof_index n_ghosts)
+{
+  const unsigned int my_rank =
+    Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int n_ranks =
+    Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const types::global_dof_index global_size = local_size * n_ranks;
+
+  IndexSet locally_owned(global_size);
+  locally_owned.add_range(my_rank * local_size, (my_rank + 1) * local_size);
+  IndexSet ghosts(global_size);
+  if (n_ranks > 1)
+    {
+      const types::global_dof_index start =
+        ((my_rank + 1) % n_ranks) * local_size;
+      ghosts.add_range(start, start + std::min(n_ghosts, local_size));
+    }
+  const auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    locally_owned, ghosts, MPI_COMM_WORLD);
+
+  LinearAlgebra::distributed::Vector<Number> x(partitioner), y(partitioner),
+    z(partitioner);
+  for (unsigned int i = 0; i < local_size; ++i)
+    {
+      x.local_element(i) = 0.125 * (i % 7);
+      y.local_element(i) = 0.25 * (i % 5);
+      z.local_element(i) = 0.5 * (i % 3);
+    }
+
+  const double       n_dofs        = global_size;
+  const double       bytes         = n_dofs * sizeof(Number);
+  const unsigned int n_repetitions = 50;
+  const std::string  number        = Benchmark::number_name<Number>();
+  const Number       factor        = 1e-3;
+  volatile Number    result        = 0;
+
+  Benchmark::print_result("vector_add",
+                          {Benchmark::parameter("number", number)},
+                          Benchmark::time_function([&]() { y.add(factor, x); },
+                                                   n_repetitions),
+                          n_dofs,
+                          3. * bytes,
+                          2. * n_dofs);
+
+  Benchmark::print_result(
+    "vector_sadd",
+    {Benchmark::parameter("number", number)},
+    Benchmark::time_function([&]() { y.sadd(Number(0.5), factor, x); },
+                             n_repetitions),
+    n_dofs,
+    3. * bytes,
+    3. * n_dofs);
+
+  // the destination of equ() is only written, so the data transfer counts
+  // the streaming stores, without the write-allocate of normal stores
+  Benchmark::print_result("vector_equ",
+                          {Benchmark::parameter("number", number)},
+                          Benchmark::time_function([&]() { z.equ(factor, x); },
+                                                   n_repetitions),
+                          n_dofs,
+                          2. * bytes,
+                          n_dofs);
+
+  Benchmark::print_result("vector_dot",
+                          {Benchmark::parameter("number", number)},
+                          Benchmark::time_function([&]() { result = x * y; },
+                                                   n_repetitions),
+                          n_dofs,
+                          2. * bytes,
+                          2. * n_dofs);
+
+  Benchmark::print_result(
+    "vector_add_and_dot",
+    {Benchmark::parameter("number", number)},
+    Benchmark::time_function([&]() { result = y.add_and_dot(factor, x, x); },
+                             n_repetitions),
+    n_dofs,
+    3. * bytes,
+    4. * n_dofs);
+
+  Benchmark::print_result("vector_add_two_and_dot",
+                          {Benchmark::parameter("number", number)},
+                          Benchmark::time_function(
+                            [&]() {
+                              result = y.add_and_dot(factor, x, factor, z, y);
+                            },
+                            n_repetitions),
+                          n_dofs,
+                          4. * bytes,
+                          6. * n_dofs);
+
+  Benchmark::print_result(
+    "vector_sadd_and_norm_sqr",
+    {Benchmark::parameter("number", number)},
+    Benchmark::time_function(
+      [&]() { result = y.sadd_and_norm_sqr(Number(0.5), factor, x); },
+      n_repetitions),
+    n_dofs,
+    3. * bytes,
+    5. * n_dofs);
+
+  // for the ghost exchange, the unknowns are the ghost entries sent and
+  // received, and the transferred data is counted once on the sender and
+  // once on the receiver
+  const double n_ghost_dofs = Utilities::MPI::sum(
+    static_cast<double>(partitioner->n_ghost_indices()), MPI_COMM_WORLD);
+  Benchmark::print_result("partitioner_update_ghost_values",
+                          {Benchmark::parameter("number", number)},
+                          Benchmark::time_function(
+                            [&]() {
+                              x.update_ghost_values();
+                              x.zero_out_ghosts();
+                            },
+                            n_repetitions),
+                          n_ghost_dofs,
+                          2. * n_ghost_dofs * sizeof(Number),
+                          0.);
+
+  Benchmark::print_result("partitioner_compress_add",
+                          {Benchmark::parameter("number", number)},
+                          Benchmark::time_function(
+                            [&]() { x.compress(VectorOperation::add); },
+                            n_repetitions),
+                          n_ghost_dofs,
+                          2. * n_ghost_dofs * sizeof(Number),
+                          n_ghost_dofs);
+  (void)result;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+
+  const types::global_dof_index local_size =
+    argc > 1 ? Utilities::string_to_int(argv[1]) : 10000000;
+  const types::global_dof_index n_ghosts =
+    argc > 2 ? Utilities::string_to_int(argv[2]) : 100000;
+
+  run<double>(local_size, n_ghosts);
+  run<float>(local_size, n_ghosts);
+
+  return 0;
+}
@@ -0,0 +1,43 @@
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2019 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Common setup of the testsuite subprojects, i.e., of every directory of
+# tests/ that contains a CMakeLists.txt file. Such a CMakeLists.txt file
+# reads
+#
+#   CMAKE_MINIMUM_REQUIRED(VERSION 2.8.12)
+#   INCLUDE(../setup_testsubproject.cmake)
+#   PROJECT(testsuite CXX)
+#   DEAL_II_PICKUP_TESTS()
+#
+# and defines one test for every file with the extension .output in the
+# directory, see DEAL_II_PICKUP_TESTS.
+#
+
+SET_PROPERTY(GLOBAL PROPERTY TARGET_MESSAGES OFF)
+
+FIND_PACKAGE(deal.II 9.2.0 REQUIRED
+  HINTS ${deal.II_DIR} ${DEAL_II_DIR} ../../ ../../../ $ENV{DEAL_II_DIR}
+  )
+SET(CMAKE_CXX_COMPILER ${DEAL_II_CXX_COMPILER} CACHE STRING "CXX Compiler.")
+
+FILE(WRITE ${CMAKE_CURRENT_BINARY_DIR}/CTestTestfile.cmake "")
+
+#
+# Silence warnings about unused variables passed down by the setup_tests
+# target of the testsuite:
+#
+SET(_bogus "${DIFF_DIR}${NUMDIFF_DIR}${TEST_PICKUP_REGEX}${TEST_TIME_LIMIT}")